@@ -1,4 +1,7 @@
 {
+  "variables": {
+    "uplink_log_max_level%": "5"
+  },
   "targets": [
     {
       "target_name": "uplink_native",
@@ -6,13 +9,36 @@
         "native/src/addon.c",
         "native/src/common/logger.c",
         "native/src/common/handle_helpers.c",
+        "native/src/common/handle_reaper.c",
         "native/src/common/string_helpers.c",
         "native/src/common/buffer_helpers.c",
         "native/src/common/result_helpers.c",
         "native/src/common/type_converters.c",
         "native/src/common/library_loader.c",
+        "native/src/common/addon_instance.c",
         "native/src/common/error_registry.c",
         "native/src/common/object_converter.c",
+        "native/src/common/file_helpers.c",
+        "native/src/common/checksum.c",
+        "native/src/common/codec.c",
+        "native/src/common/buffer_pool.c",
+        "native/src/common/work_pool.c",
+        "native/src/common/stat_cache.c",
+        "native/src/common/object_cache.c",
+        "native/src/common/known_buckets.c",
+        "native/src/common/chunk_cache.c",
+        "native/src/common/access_cache.c",
+        "native/src/common/key_cache.c",
+        "native/src/common/thread_pool.c",
+        "native/src/common/op_metrics.c",
+        "native/src/common/hedge.c",
+        "native/src/common/retry.c",
+        "native/src/common/admission.c",
+        "native/src/common/cancel_token.c",
+        "native/src/common/progress.c",
+        "native/src/common/part_tuner.c",
+        "native/src/common/bandwidth.c",
+        "native/src/common/native_alloc.c",
         "native/src/access/access_ops.c",
         "native/src/access/access_execute.c",
         "native/src/access/access_complete.c",
@@ -27,19 +53,31 @@
         "native/src/object/object_complete.c",
         "native/src/upload/upload_ops.c",
         "native/src/upload/upload_execute.c",
+        "native/src/upload/upload_queue.c",
         "native/src/upload/upload_complete.c",
         "native/src/download/download_ops.c",
         "native/src/download/download_execute.c",
         "native/src/download/download_complete.c",
+        "native/src/download/download_tee.c",
+        "native/src/download/download_readahead.c",
+        "native/src/download/download_ranges.c",
         "native/src/encryption/encryption_ops.c",
         "native/src/encryption/encryption_execute.c",
         "native/src/encryption/encryption_complete.c",
         "native/src/multipart/multipart_ops.c",
         "native/src/multipart/multipart_execute.c",
         "native/src/multipart/multipart_complete.c",
+        "native/src/directory/directory_ops.c",
+        "native/src/directory/directory_execute.c",
+        "native/src/directory/directory_complete.c",
+        "native/src/archive/archive_ops.c",
+        "native/src/archive/archive_execute.c",
+        "native/src/archive/archive_complete.c",
+        "native/src/archive/archive_format.c",
         "native/src/edge/edge_ops.c",
         "native/src/edge/edge_execute.c",
         "native/src/edge/edge_complete.c",
+        "native/src/edge/edge_cache.c",
         "native/src/debug/debug_ops.c"
       ],
       "include_dirs": [
@@ -47,16 +85,19 @@
         "native/src",
         "native/src/common"
       ],
-      "cflags": ["-Wall", "-Wextra", "-std=c11"],
+      "defines": ["UPLINK_LOG_MAX_LEVEL=<(uplink_log_max_level)", "_DEFAULT_SOURCE"],
+      "cflags": ["-Wall", "-Wextra", "-std=c11", "-include", "<(module_root_dir)/native/src/common/native_alloc.h"],
       "cflags!": ["-fno-exceptions"],
       "xcode_settings": {
         "GCC_C_LANGUAGE_STANDARD": "c11",
         "MACOSX_DEPLOYMENT_TARGET": "10.15",
-        "WARNING_CFLAGS": ["-Wall", "-Wextra"]
+        "WARNING_CFLAGS": ["-Wall", "-Wextra"],
+        "OTHER_CFLAGS": ["-include", "<(module_root_dir)/native/src/common/native_alloc.h"]
       },
       "msvs_settings": {
         "VCCLCompilerTool": {
-          "ExceptionHandling": 0
+          "ExceptionHandling": 0,
+          "ForcedIncludeFiles": ["<(module_root_dir)/native/src/common/native_alloc.h"]
         },
         "VCLinkerTool": {
           "AdditionalLibraryDirectories": [
@@ -92,6 +133,9 @@
             "-luplink",
             "-Wl,-rpath,$ORIGIN/../../native/prebuilds/linux-<(target_arch)",
             "-Wl,-rpath,$ORIGIN"
+          ],
+          "ldflags": [
+            "-Wl,-z,nodelete"
           ]
         }],
         ["OS=='win'", {
@@ -0,0 +1,423 @@
+/**
+ * @file bench_marshal.c
+ * @brief Microbenchmarks for the N-API marshalling hot paths
+ *
+ * A small addon built from the same native/src/common sources as the
+ * real one (see native/bench/binding.gyp). It times one helper at a time
+ * on the main thread, with no libuplink call in the loop:
+ *
+ *   uplink_object_to_js               an object with 4 metadata entries
+ *   uplink_object_to_js_keys          the same, names fetched once as for a listing page
+ *   uplink_object_to_js_lazy          the listing page path, metadata left packed
+ *   extract_metadata_entries_from_js  the JS metadata passed as input
+ *   extract_metadata_entries_packed   the same metadata, packed into a Buffer
+ *   extract_handle                    a live Access handle
+ *   extract_string_required           the JS string passed as input
+ *   create_typed_error                BucketNotFoundError with a message
+ *
+ * The submission cases queue no-op jobs and time them from the first
+ * submission to the last completion, so they cover the round trip to a
+ * worker thread and back:
+ *
+ *   submit_napi_async_work            name string + napi_async_work on the libuv pool
+ *   submit_thread_pool_work           name string + napi_async_work on the addon pool
+ *   submit_thread_pool_job            thread_pool_queue_job(), as stream reads and writes
+ *
+ * Allocations are the addon's own, counted by native_alloc.h as in the
+ * real build; V8's heap shows up in ns/op only.
+ *
+ * Exports run(name, iterations, input?) returning
+ * { iterations, nsPerOp, allocsPerOp }, runAsync(name, iterations)
+ * resolving to the same for the submission cases, and initErrorClasses()
+ * as in the real addon. scripts/bench-marshal.js drives it.
+ */
+
+#include <node_api.h>
+#include <uv.h>
+
+#include "addon_instance.h"
+#include "error_registry.h"
+#include "handle_helpers.h"
+#include "object_converter.h"
+#include "string_helpers.h"
+#include "logger.h"
+#include "native_alloc.h"
+#include "thread_pool.h"
+#include "work_pool.h"
+
+#include "uplink.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Iterations per handle scope, so V8 can collect between batches */
+#define BENCH_SCOPE_BATCH 64
+
+/* uplink-c error code for a missing bucket */
+#define BENCH_ERROR_CODE 0x13
+
+typedef struct {
+    napi_value input;
+    napi_value handle;
+    ObjectKeys keys;
+    UplinkObject object;
+} BenchContext;
+
+typedef int (*BenchCase)(napi_env env, BenchContext* ctx);
+
+static UplinkCustomMetadataEntry bench_entries[] = {
+    { "content-type", 12, "image/jpeg", 10 },
+    { "cache-control", 13, "max-age=3600", 12 },
+    { "x-owner", 7, "photos-service", 14 },
+    { "x-checksum", 10, "9f86d081884c7d659a2feaa0c55ad015", 32 },
+};
+
+static int case_object_to_js(napi_env env, BenchContext* ctx) {
+    return uplink_object_to_js(env, &ctx->object) == NULL ? -1 : 0;
+}
+
+static int case_object_to_js_keys(napi_env env, BenchContext* ctx) {
+    return uplink_object_to_js_keys(env, &ctx->keys, &ctx->object, OBJECT_FIELDS_ALL) == NULL ? -1 : 0;
+}
+
+static int case_object_to_js_lazy(napi_env env, BenchContext* ctx) {
+    return uplink_object_to_js_keys(env, &ctx->keys, &ctx->object,
+                                    OBJECT_FIELDS_ALL | OBJECT_CONVERT_LAZY_CUSTOM) == NULL ? -1 : 0;
+}
+
+static int case_metadata_from_js(napi_env env, BenchContext* ctx) {
+    UplinkCustomMetadataEntry* entries = NULL;
+    size_t count = 0;
+    if (extract_metadata_entries_from_js(env, ctx->input, &entries, &count) != 0) {
+        return -1;
+    }
+    free_metadata_entries(entries, count);
+    return 0;
+}
+
+static int case_extract_handle(napi_env env, BenchContext* ctx) {
+    size_t handle = 0;
+    return extract_handle(env, ctx->handle, HANDLE_TYPE_ACCESS, &handle) == napi_ok ? 0 : -1;
+}
+
+static int case_string_required(napi_env env, BenchContext* ctx) {
+    char* str = NULL;
+    if (extract_string_required(env, ctx->input, "key", &str) != napi_ok) {
+        return -1;
+    }
+    free(str);
+    return 0;
+}
+
+static int case_typed_error(napi_env env, BenchContext* ctx) {
+    (void)ctx;
+    return create_typed_error(env, BENCH_ERROR_CODE, "bucket not found (\"photos\")") == NULL ? -1 : 0;
+}
+
+static const struct {
+    const char* name;
+    BenchCase fn;
+    bool needs_input;
+} bench_cases[] = {
+    { "uplink_object_to_js", case_object_to_js, false },
+    { "uplink_object_to_js_keys", case_object_to_js_keys, false },
+    { "uplink_object_to_js_lazy", case_object_to_js_lazy, false },
+    { "extract_metadata_entries_from_js", case_metadata_from_js, true },
+    { "extract_metadata_entries_packed", case_metadata_from_js, true },
+    { "extract_handle", case_extract_handle, false },
+    { "extract_string_required", case_string_required, true },
+    { "create_typed_error", case_typed_error, false },
+};
+
+static napi_value set_double(napi_env env, napi_value obj, const char* key, double value) {
+    napi_value js_value;
+    napi_create_double(env, value, &js_value);
+    napi_set_named_property(env, obj, key, js_value);
+    return obj;
+}
+
+static napi_value bench_result(napi_env env, int64_t iterations, uint64_t elapsed,
+                               const NativeAllocStats* before, const NativeAllocStats* after) {
+    napi_value result;
+    napi_create_object(env, &result);
+    set_double(env, result, "iterations", (double)iterations);
+    set_double(env, result, "nsPerOp", (double)elapsed / (double)iterations);
+    set_double(env, result, "allocsPerOp", (double)(after->allocations - before->allocations) / (double)iterations);
+    return result;
+}
+
+/* ========== submission cases ========== */
+
+typedef struct {
+    napi_deferred deferred;
+    int64_t iterations;             /* Jobs submitted */
+    int64_t completed;
+    bool failed;                    /* A submission failed; reject once the rest complete */
+    uint64_t start;
+    NativeAllocStats before;
+} AsyncBench;
+
+typedef struct {
+    AsyncBench* bench;
+    napi_async_work work;           /* NULL for thread_pool_queue_job() */
+} AsyncBenchOp;
+
+typedef int (*AsyncBenchCase)(napi_env env, AsyncBenchOp* op);
+
+static void noop_execute(napi_env env, void* data) {
+    (void)env;
+    (void)data;
+}
+
+static void noop_complete(napi_env env, napi_status status, void* data) {
+    (void)status;
+    AsyncBenchOp* op = (AsyncBenchOp*)data;
+    AsyncBench* bench = op->bench;
+    if (op->work != NULL) {
+        napi_delete_async_work(env, op->work);
+    }
+    work_pool_free(op);
+    if (++bench->completed < bench->iterations) {
+        return;
+    }
+
+    uint64_t elapsed = uv_hrtime() - bench->start;
+    NativeAllocStats after;
+    native_alloc_stats(&after);
+    if (bench->failed) {
+        napi_value message, error;
+        napi_create_string_utf8(env, "Benchmark submission failed", NAPI_AUTO_LENGTH, &message);
+        napi_create_error(env, NULL, message, &error);
+        napi_reject_deferred(env, bench->deferred, error);
+    } else {
+        napi_resolve_deferred(env, bench->deferred,
+                              bench_result(env, bench->iterations, elapsed, &bench->before, &after));
+    }
+    free(bench);
+}
+
+static int case_submit_napi_async_work(napi_env env, AsyncBenchOp* op) {
+    napi_value name;
+    napi_create_string_utf8(env, "benchNoop", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_async_work(env, NULL, name, noop_execute, noop_complete, op, &op->work) != napi_ok) {
+        return -1;
+    }
+    return napi_queue_async_work(env, op->work) == napi_ok ? 0 : -1;
+}
+
+static int case_submit_thread_pool_work(napi_env env, AsyncBenchOp* op) {
+    napi_value name;
+    napi_create_string_utf8(env, "benchNoop", NAPI_AUTO_LENGTH, &name);
+    return thread_pool_queue_work(env, THREAD_POOL_LANE_BULK, name, noop_execute, noop_complete,
+                                  op, &op->work) == napi_ok ? 0 : -1;
+}
+
+static int case_submit_thread_pool_job(napi_env env, AsyncBenchOp* op) {
+    return thread_pool_queue_job(env, THREAD_POOL_LANE_BULK, "benchNoop", noop_execute, noop_complete,
+                                 op) == napi_ok ? 0 : -1;
+}
+
+static const struct {
+    const char* name;
+    AsyncBenchCase fn;
+} async_cases[] = {
+    { "submit_napi_async_work", case_submit_napi_async_work },
+    { "submit_thread_pool_work", case_submit_thread_pool_work },
+    { "submit_thread_pool_job", case_submit_thread_pool_job },
+};
+
+/**
+ * run(name, iterations, input?) - time @p iterations calls of one case
+ */
+static napi_value bench_run(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "run(name, iterations, input?) expects at least 2 arguments");
+        return NULL;
+    }
+
+    char name[64];
+    size_t name_length = 0;
+    if (napi_get_value_string_utf8(env, argv[0], name, sizeof(name), &name_length) != napi_ok) {
+        napi_throw_type_error(env, NULL, "name must be a string");
+        return NULL;
+    }
+    int64_t iterations = 0;
+    if (napi_get_value_int64(env, argv[1], &iterations) != napi_ok || iterations <= 0) {
+        napi_throw_range_error(env, NULL, "iterations must be a positive integer");
+        return NULL;
+    }
+
+    BenchCase fn = NULL;
+    bool needs_input = false;
+    for (size_t i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++) {
+        if (strcmp(bench_cases[i].name, name) == 0) {
+            fn = bench_cases[i].fn;
+            needs_input = bench_cases[i].needs_input;
+            break;
+        }
+    }
+    if (fn == NULL) {
+        napi_throw_range_error(env, NULL, "Unknown benchmark case");
+        return NULL;
+    }
+    if (needs_input && argc < 3) {
+        napi_throw_type_error(env, NULL, "This benchmark case needs an input value");
+        return NULL;
+    }
+
+    BenchContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.input = argc >= 3 ? argv[2] : NULL;
+    ctx.object.key = "photos/2024/summer/IMG_0001.jpg";
+    ctx.object.system.created = 1718000000;
+    ctx.object.system.expires = 0;
+    ctx.object.system.content_length = 4194304;
+    ctx.object.custom.entries = bench_entries;
+    ctx.object.custom.count = sizeof(bench_entries) / sizeof(bench_entries[0]);
+    ctx.handle = create_handle_external(env, 1, HANDLE_TYPE_ACCESS, NULL, NULL);
+    if (ctx.handle == NULL || object_keys_get(env, &ctx.keys) != 0) {
+        return NULL;
+    }
+
+    NativeAllocStats before, after;
+    native_alloc_stats(&before);
+    uint64_t start = uv_hrtime();
+    for (int64_t done = 0; done < iterations;) {
+        napi_handle_scope scope;
+        napi_open_handle_scope(env, &scope);
+        for (int batch = 0; batch < BENCH_SCOPE_BATCH && done < iterations; batch++, done++) {
+            if (fn(env, &ctx) != 0) {
+                napi_close_handle_scope(env, scope);
+                bool pending = false;
+                napi_is_exception_pending(env, &pending);
+                if (!pending) {
+                    napi_throw_error(env, NULL, "Benchmark case failed");
+                }
+                return NULL;
+            }
+        }
+        napi_close_handle_scope(env, scope);
+    }
+    uint64_t elapsed = uv_hrtime() - start;
+    native_alloc_stats(&after);
+    return bench_result(env, iterations, elapsed, &before, &after);
+}
+
+/**
+ * runAsync(name, iterations) - submit @p iterations no-op jobs, resolving
+ * once the last one has completed
+ */
+static napi_value bench_run_async(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "runAsync(name, iterations) expects 2 arguments");
+        return NULL;
+    }
+
+    char name[64];
+    size_t name_length = 0;
+    if (napi_get_value_string_utf8(env, argv[0], name, sizeof(name), &name_length) != napi_ok) {
+        napi_throw_type_error(env, NULL, "name must be a string");
+        return NULL;
+    }
+    int64_t iterations = 0;
+    if (napi_get_value_int64(env, argv[1], &iterations) != napi_ok || iterations <= 0) {
+        napi_throw_range_error(env, NULL, "iterations must be a positive integer");
+        return NULL;
+    }
+
+    AsyncBenchCase fn = NULL;
+    for (size_t i = 0; i < sizeof(async_cases) / sizeof(async_cases[0]); i++) {
+        if (strcmp(async_cases[i].name, name) == 0) {
+            fn = async_cases[i].fn;
+            break;
+        }
+    }
+    if (fn == NULL) {
+        napi_throw_range_error(env, NULL, "Unknown benchmark case");
+        return NULL;
+    }
+
+    AsyncBench* bench = (AsyncBench*)calloc(1, sizeof(AsyncBench));
+    if (bench == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    napi_value promise;
+    napi_create_promise(env, &bench->deferred, &promise);
+    bench->iterations = iterations;
+    native_alloc_stats(&bench->before);
+    bench->start = uv_hrtime();
+
+    for (int64_t submitted = 0; submitted < iterations;) {
+        napi_handle_scope scope;
+        napi_open_handle_scope(env, &scope);
+        for (int batch = 0; batch < BENCH_SCOPE_BATCH && submitted < iterations; batch++, submitted++) {
+            AsyncBenchOp* op = (AsyncBenchOp*)work_pool_calloc(1, sizeof(AsyncBenchOp));
+            if (op != NULL) {
+                op->bench = bench;
+            }
+            if (op == NULL || fn(env, op) != 0) {
+                work_pool_free(op);
+                /* Settle once the jobs already submitted have completed */
+                bench->failed = true;
+                bench->iterations = submitted;
+                iterations = submitted;
+                break;
+            }
+        }
+        napi_close_handle_scope(env, scope);
+    }
+    if (bench->iterations == 0) {
+        napi_value message, error;
+        napi_create_string_utf8(env, "Benchmark submission failed", NAPI_AUTO_LENGTH, &message);
+        napi_create_error(env, NULL, message, &error);
+        napi_reject_deferred(env, bench->deferred, error);
+        free(bench);
+    }
+    return promise;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+    logger_init();
+    if (addon_instance_init(env) != 0) {
+        napi_throw_error(env, NULL, "Failed to initialize the benchmark addon");
+        return NULL;
+    }
+
+    napi_value cases;
+    size_t case_count = sizeof(bench_cases) / sizeof(bench_cases[0]);
+    napi_create_array_with_length(env, case_count, &cases);
+    for (size_t i = 0; i < case_count; i++) {
+        napi_value case_name;
+        napi_create_string_utf8(env, bench_cases[i].name, NAPI_AUTO_LENGTH, &case_name);
+        napi_set_element(env, cases, (uint32_t)i, case_name);
+    }
+
+    napi_value async_case_names;
+    size_t async_count = sizeof(async_cases) / sizeof(async_cases[0]);
+    napi_create_array_with_length(env, async_count, &async_case_names);
+    for (size_t i = 0; i < async_count; i++) {
+        napi_value case_name;
+        napi_create_string_utf8(env, async_cases[i].name, NAPI_AUTO_LENGTH, &case_name);
+        napi_set_element(env, async_case_names, (uint32_t)i, case_name);
+    }
+
+    napi_property_descriptor methods[] = {
+        { "run", NULL, bench_run, NULL, NULL, NULL, napi_default, NULL },
+        { "runAsync", NULL, bench_run_async, NULL, NULL, NULL, napi_default, NULL },
+        { "initErrorClasses", NULL, napi_init_error_classes, NULL, NULL, NULL, napi_default, NULL },
+        { "cases", NULL, NULL, NULL, NULL, cases, napi_enumerable, NULL },
+        { "asyncCases", NULL, NULL, NULL, NULL, async_case_names, napi_enumerable, NULL },
+    };
+    napi_define_properties(env, exports, sizeof(methods) / sizeof(methods[0]), methods);
+    return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,64 @@
+{
+  "targets": [
+    {
+      "target_name": "bench_marshal",
+      "sources": [
+        "bench_marshal.c",
+        "../src/common/logger.c",
+        "../src/common/handle_helpers.c",
+        "../src/common/handle_reaper.c",
+        "../src/common/string_helpers.c",
+        "../src/common/buffer_helpers.c",
+        "../src/common/result_helpers.c",
+        "../src/common/type_converters.c",
+        "../src/common/library_loader.c",
+        "../src/common/addon_instance.c",
+        "../src/common/error_registry.c",
+        "../src/common/object_converter.c",
+        "../src/common/file_helpers.c",
+        "../src/common/checksum.c",
+        "../src/common/buffer_pool.c",
+        "../src/common/work_pool.c",
+        "../src/common/stat_cache.c",
+        "../src/common/access_cache.c",
+        "../src/common/key_cache.c",
+        "../src/common/thread_pool.c",
+        "../src/common/op_metrics.c",
+        "../src/download/download_readahead.c",
+        "../src/common/admission.c",
+        "../src/common/cancel_token.c",
+        "../src/common/progress.c",
+        "../src/common/native_alloc.c"
+      ],
+      "include_dirs": [
+        "../include",
+        "../src",
+        "../src/common"
+      ],
+      "defines": ["UPLINK_LOG_MAX_LEVEL=5", "_DEFAULT_SOURCE"],
+      "cflags": ["-Wall", "-Wextra", "-std=c11", "-O2", "-include", "<(module_root_dir)/../src/common/native_alloc.h"],
+      "xcode_settings": {
+        "GCC_C_LANGUAGE_STANDARD": "c11",
+        "MACOSX_DEPLOYMENT_TARGET": "10.15",
+        "WARNING_CFLAGS": ["-Wall", "-Wextra"],
+        "OTHER_CFLAGS": ["-O2", "-include", "<(module_root_dir)/../src/common/native_alloc.h"]
+      },
+      "conditions": [
+        ["OS=='mac'", {
+          "libraries": [
+            "-L<(module_root_dir)/../../build/fake",
+            "-luplink",
+            "-Wl,-rpath,<(module_root_dir)/../../build/fake"
+          ]
+        }],
+        ["OS=='linux'", {
+          "libraries": [
+            "-L<(module_root_dir)/../../build/fake",
+            "-luplink",
+            "-Wl,-rpath,<(module_root_dir)/../../build/fake"
+          ]
+        }]
+      ]
+    }
+  ]
+}
@@ -0,0 +1,1594 @@
+/**
+ * @file fake_uplink.c
+ * @brief In-memory stand-in for libuplink, for offline benchmarks
+ *
+ * Built from the same uplink.h as the addon (make fake-uplink) and put in
+ * front of the real library with LD_PRELOAD / DYLD_LIBRARY_PATH; see
+ * scripts/bench.js. Buckets and objects live in one process-wide store
+ * behind a mutex, so every project sees the same "satellite".
+ *
+ * Behaviour that the binding depends on is kept: error codes, EOF at the
+ * end of a download, iterator item ownership (bucket and object items are
+ * the caller's, upload and part items the iterator's), upload-done checks
+ * and non-recursive listing with collapsed prefixes. Handles are the
+ * addresses of internal structs and are not validated.
+ *
+ * Cost is injected from the environment:
+ * - FAKE_UPLINK_LATENCY_MS: added to every satellite round trip (open,
+ *   stat, commit, delete, each listing page), default 0
+ * - FAKE_UPLINK_BANDWIDTH_MBPS: cap on read and write throughput in
+ *   MB/s per stream, default 0 (unlimited)
+ * - FAKE_UPLINK_PAGE_SIZE: listing items per round trip, default 1000
+ *
+ * POSIX only.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "uplink.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Mirrors the uplink-c codes in native/src/common/result_helpers.h */
+#define FAKE_ERROR_INTERNAL            0x02
+#define FAKE_ERROR_BUCKET_NAME_INVALID 0x10
+#define FAKE_ERROR_BUCKET_EXISTS       0x11
+#define FAKE_ERROR_BUCKET_NOT_EMPTY    0x12
+#define FAKE_ERROR_BUCKET_NOT_FOUND    0x13
+#define FAKE_ERROR_OBJECT_KEY_INVALID  0x20
+#define FAKE_ERROR_OBJECT_NOT_FOUND    0x21
+#define FAKE_ERROR_UPLOAD_DONE         0x22
+
+#define FAKE_SATELLITE "fake.satellite:7777"
+
+/* ========== store ========== */
+
+/** Immutable object contents, shared by the object and open downloads */
+typedef struct {
+    size_t refs;                    /* guarded by store_lock */
+    size_t length;
+    char bytes[];
+} Blob;
+
+typedef struct {
+    char* key;
+    Blob* blob;
+    int64_t created;
+    int64_t expires;
+    UplinkCustomMetadata custom;
+} FakeObject;
+
+typedef struct FakePart {
+    uint32_t number;
+    char* data;
+    size_t length;
+    size_t capacity;
+    char* etag;
+    int64_t modified;
+    bool done;
+    struct FakePart* next;
+} FakePart;
+
+typedef struct FakePending {
+    char* upload_id;
+    char* key;
+    int64_t created;
+    int64_t expires;
+    FakePart* parts;
+    struct FakePending* next;
+} FakePending;
+
+typedef struct FakeBucket {
+    char* name;
+    int64_t created;
+    FakeObject* objects;            /* sorted by key */
+    size_t count;
+    size_t capacity;
+    FakePending* pending;           /* multipart uploads */
+    struct FakeBucket* next;
+} FakeBucket;
+
+static pthread_mutex_t store_lock = PTHREAD_MUTEX_INITIALIZER;
+static FakeBucket* buckets = NULL;
+static uint64_t next_upload_id = 1;
+
+static pthread_once_t config_once = PTHREAD_ONCE_INIT;
+static double latency_ms = 0;
+static double bandwidth_mbps = 0;
+static size_t page_size = 1000;
+
+static void config_init(void) {
+    const char* value = getenv("FAKE_UPLINK_LATENCY_MS");
+    if (value != NULL) latency_ms = atof(value);
+    value = getenv("FAKE_UPLINK_BANDWIDTH_MBPS");
+    if (value != NULL) bandwidth_mbps = atof(value);
+    value = getenv("FAKE_UPLINK_PAGE_SIZE");
+    if (value != NULL && atol(value) > 0) page_size = (size_t)atol(value);
+}
+
+static void sleep_ms(double ms) {
+    if (ms <= 0) {
+        return;
+    }
+    struct timespec delay;
+    delay.tv_sec = (time_t)(ms / 1000);
+    delay.tv_nsec = (long)((ms - (double)delay.tv_sec * 1000) * 1e6);
+    while (nanosleep(&delay, &delay) != 0 && errno == EINTR) {
+    }
+}
+
+/** One satellite round trip */
+static void round_trip(void) {
+    pthread_once(&config_once, config_init);
+    sleep_ms(latency_ms);
+}
+
+/** Time on the wire for @p bytes */
+static void transfer(size_t bytes) {
+    pthread_once(&config_once, config_init);
+    if (bandwidth_mbps > 0) {
+        sleep_ms((double)bytes / (bandwidth_mbps * 1e6) * 1000);
+    }
+}
+
+static int64_t now_seconds(void) {
+    return (int64_t)time(NULL);
+}
+
+static char* copy_string(const char* value) {
+    return strdup(value != NULL ? value : "");
+}
+
+static UplinkError* make_error(int32_t code, const char* format, const char* arg) {
+    UplinkError* error = (UplinkError*)calloc(1, sizeof(UplinkError));
+    if (error == NULL) {
+        return NULL;
+    }
+    char message[512];
+    snprintf(message, sizeof(message), format, arg != NULL ? arg : "");
+    error->code = code;
+    error->message = strdup(message);
+    return error;
+}
+
+static UplinkError* make_eof(void) {
+    UplinkError* error = (UplinkError*)calloc(1, sizeof(UplinkError));
+    if (error != NULL) {
+        error->code = EOF;
+        error->message = strdup("EOF");
+    }
+    return error;
+}
+
+static void copy_custom(UplinkCustomMetadata* dst, const UplinkCustomMetadata* src) {
+    dst->count = 0;
+    dst->entries = NULL;
+    if (src == NULL || src->count == 0) {
+        return;
+    }
+    dst->entries = (UplinkCustomMetadataEntry*)calloc(src->count, sizeof(UplinkCustomMetadataEntry));
+    if (dst->entries == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < src->count; i++) {
+        UplinkCustomMetadataEntry* entry = &dst->entries[i];
+        entry->key = (char*)malloc(src->entries[i].key_length + 1);
+        entry->value = (char*)malloc(src->entries[i].value_length + 1);
+        if (entry->key == NULL || entry->value == NULL) {
+            free(entry->key);
+            free(entry->value);
+            break;
+        }
+        memcpy(entry->key, src->entries[i].key, src->entries[i].key_length);
+        entry->key[src->entries[i].key_length] = '\0';
+        entry->key_length = src->entries[i].key_length;
+        memcpy(entry->value, src->entries[i].value, src->entries[i].value_length);
+        entry->value[src->entries[i].value_length] = '\0';
+        entry->value_length = src->entries[i].value_length;
+        dst->count++;
+    }
+}
+
+static void free_custom(UplinkCustomMetadata* custom) {
+    for (size_t i = 0; i < custom->count; i++) {
+        free(custom->entries[i].key);
+        free(custom->entries[i].value);
+    }
+    free(custom->entries);
+    custom->entries = NULL;
+    custom->count = 0;
+}
+
+static void blob_release(Blob* blob) {
+    if (blob == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&store_lock);
+    size_t refs = --blob->refs;
+    pthread_mutex_unlock(&store_lock);
+    if (refs == 0) {
+        free(blob);
+    }
+}
+
+static FakeBucket* find_bucket(const char* name) {
+    for (FakeBucket* bucket = buckets; bucket != NULL; bucket = bucket->next) {
+        if (strcmp(bucket->name, name) == 0) {
+            return bucket;
+        }
+    }
+    return NULL;
+}
+
+/** Index of @p key, or of where it would go with *found false */
+static size_t find_object(const FakeBucket* bucket, const char* key, bool* found) {
+    size_t low = 0, high = bucket->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int cmp = strcmp(bucket->objects[mid].key, key);
+        if (cmp == 0) {
+            *found = true;
+            return mid;
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    *found = false;
+    return low;
+}
+
+static void remove_object(FakeBucket* bucket, size_t index) {
+    FakeObject* object = &bucket->objects[index];
+    free(object->key);
+    free_custom(&object->custom);
+    if (--object->blob->refs == 0) {
+        free(object->blob);
+    }
+    memmove(object, object + 1, (bucket->count - index - 1) * sizeof(FakeObject));
+    bucket->count--;
+}
+
+/** Store @p blob under @p key, replacing any previous version (store_lock held) */
+static FakeObject* put_object(FakeBucket* bucket, const char* key, Blob* blob, int64_t expires,
+                              const UplinkCustomMetadata* custom) {
+    bool found;
+    size_t index = find_object(bucket, key, &found);
+    if (found) {
+        remove_object(bucket, index);
+    }
+    if (bucket->count == bucket->capacity) {
+        size_t capacity = bucket->capacity ? bucket->capacity * 2 : 64;
+        FakeObject* objects = (FakeObject*)realloc(bucket->objects, capacity * sizeof(FakeObject));
+        if (objects == NULL) {
+            return NULL;
+        }
+        bucket->objects = objects;
+        bucket->capacity = capacity;
+    }
+    FakeObject* object = &bucket->objects[index];
+    memmove(object + 1, object, (bucket->count - index) * sizeof(FakeObject));
+    bucket->count++;
+    object->key = strdup(key);
+    object->blob = blob;
+    object->created = now_seconds();
+    object->expires = expires;
+    copy_custom(&object->custom, custom);
+    return object;
+}
+
+static UplinkObject* object_to_uplink(const FakeObject* object, bool custom) {
+    UplinkObject* result = (UplinkObject*)calloc(1, sizeof(UplinkObject));
+    if (result == NULL) {
+        return NULL;
+    }
+    result->key = strdup(object->key);
+    result->system.created = object->created;
+    result->system.expires = object->expires;
+    result->system.content_length = object->blob != NULL ? (int64_t)object->blob->length : 0;
+    if (custom) {
+        copy_custom(&result->custom, &object->custom);
+    }
+    return result;
+}
+
+static UplinkBucket* bucket_to_uplink(const FakeBucket* bucket) {
+    UplinkBucket* result = (UplinkBucket*)calloc(1, sizeof(UplinkBucket));
+    if (result != NULL) {
+        result->name = strdup(bucket->name);
+        result->created = bucket->created;
+    }
+    return result;
+}
+
+static bool bucket_name_valid(const char* name) {
+    size_t length = name != NULL ? strlen(name) : 0;
+    return length >= 3 && length <= 63;
+}
+
+/** Look up a bucket for an object call, or set *error (store_lock held) */
+static FakeBucket* object_bucket(const char* bucket_name, const char* key, UplinkError** error) {
+    if (!bucket_name_valid(bucket_name)) {
+        *error = make_error(FAKE_ERROR_BUCKET_NAME_INVALID, "bucket name invalid: \"%s\"", bucket_name);
+        return NULL;
+    }
+    if (key != NULL && key[0] == '\0') {
+        *error = make_error(FAKE_ERROR_OBJECT_KEY_INVALID, "object key invalid%s", "");
+        return NULL;
+    }
+    FakeBucket* bucket = find_bucket(bucket_name);
+    if (bucket == NULL) {
+        *error = make_error(FAKE_ERROR_BUCKET_NOT_FOUND, "bucket not found: \"%s\"", bucket_name);
+    }
+    return bucket;
+}
+
+/* ========== access ========== */
+
+typedef struct {
+    char* satellite;
+    char* serialized;
+} FakeAccess;
+
+static UplinkAccessResult make_access(const char* satellite, const char* serialized) {
+    UplinkAccessResult result = { NULL, NULL };
+    FakeAccess* access = (FakeAccess*)calloc(1, sizeof(FakeAccess));
+    result.access = (UplinkAccess*)calloc(1, sizeof(UplinkAccess));
+    if (access == NULL || result.access == NULL) {
+        free(access);
+        free(result.access);
+        result.access = NULL;
+        result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        return result;
+    }
+    access->satellite = copy_string(satellite);
+    if (serialized != NULL) {
+        access->serialized = copy_string(serialized);
+    } else {
+        size_t length = strlen(access->satellite) + 6;
+        access->serialized = (char*)malloc(length);
+        if (access->serialized != NULL) {
+            snprintf(access->serialized, length, "fake:%s", access->satellite);
+        }
+    }
+    result.access->_handle = (size_t)access;
+    return result;
+}
+
+UplinkAccessResult uplink_parse_access(const char* accessString) {
+    if (accessString == NULL || accessString[0] == '\0') {
+        UplinkAccessResult result = { NULL, make_error(FAKE_ERROR_INTERNAL, "access grant is empty%s", "") };
+        return result;
+    }
+    const char* satellite = strncmp(accessString, "fake:", 5) == 0 ? accessString + 5 : FAKE_SATELLITE;
+    return make_access(satellite, accessString);
+}
+
+UplinkAccessResult uplink_request_access_with_passphrase(const char* satellite_address,
+                                                         const char* api_key,
+                                                         const char* passphrase) {
+    (void)api_key;
+    (void)passphrase;
+    round_trip();
+    return make_access(satellite_address, NULL);
+}
+
+UplinkAccessResult uplink_config_request_access_with_passphrase(UplinkConfig config,
+                                                                const char* satellite_address,
+                                                                const char* api_key,
+                                                                const char* passphrase) {
+    (void)config;
+    return uplink_request_access_with_passphrase(satellite_address, api_key, passphrase);
+}
+
+UplinkStringResult uplink_access_satellite_address(UplinkAccess* access) {
+    UplinkStringResult result = { copy_string(((FakeAccess*)access->_handle)->satellite), NULL };
+    return result;
+}
+
+UplinkStringResult uplink_access_serialize(UplinkAccess* access) {
+    UplinkStringResult result = { copy_string(((FakeAccess*)access->_handle)->serialized), NULL };
+    return result;
+}
+
+UplinkAccessResult uplink_access_share(UplinkAccess* access, UplinkPermission permission,
+                                       UplinkSharePrefix* prefixes, int prefixes_count) {
+    (void)permission;
+    (void)prefixes;
+    (void)prefixes_count;
+    FakeAccess* fake = (FakeAccess*)access->_handle;
+    return make_access(fake->satellite, fake->serialized);
+}
+
+UplinkError* uplink_access_override_encryption_key(UplinkAccess* access, const char* bucket,
+                                                   const char* prefix, UplinkEncryptionKey* encryptionKey) {
+    (void)access;
+    (void)bucket;
+    (void)prefix;
+    (void)encryptionKey;
+    return NULL;
+}
+
+UplinkEncryptionKeyResult uplink_derive_encryption_key(const char* passphrase, void* salt, size_t length) {
+    (void)passphrase;
+    (void)salt;
+    (void)length;
+    UplinkEncryptionKeyResult result = { NULL, NULL };
+    result.encryption_key = (UplinkEncryptionKey*)calloc(1, sizeof(UplinkEncryptionKey));
+    if (result.encryption_key != NULL) {
+        result.encryption_key->_handle = 1;
+    }
+    return result;
+}
+
+void uplink_free_access_result(UplinkAccessResult result) {
+    if (result.access != NULL) {
+        /* The fake keeps the access itself alive; grants are tiny */
+        free(result.access);
+    }
+    uplink_free_error(result.error);
+}
+
+void uplink_free_encryption_key_result(UplinkEncryptionKeyResult result) {
+    free(result.encryption_key);
+    uplink_free_error(result.error);
+}
+
+void uplink_free_string_result(UplinkStringResult result) {
+    free(result.string);
+    uplink_free_error(result.error);
+}
+
+void uplink_free_error(UplinkError* error) {
+    if (error != NULL) {
+        free(error->message);
+        free(error);
+    }
+}
+
+/* ========== project ========== */
+
+UplinkProjectResult uplink_open_project(UplinkAccess* access) {
+    (void)access;
+    UplinkProjectResult result = { NULL, NULL };
+    result.project = (UplinkProject*)calloc(1, sizeof(UplinkProject));
+    if (result.project == NULL) {
+        result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        return result;
+    }
+    /* Projects carry no state: every project sees the one store */
+    result.project->_handle = 1;
+    return result;
+}
+
+UplinkProjectResult uplink_config_open_project(UplinkConfig config, UplinkAccess* access) {
+    (void)config;
+    return uplink_open_project(access);
+}
+
+UplinkError* uplink_close_project(UplinkProject* project) {
+    (void)project;
+    return NULL;
+}
+
+UplinkError* uplink_revoke_access(UplinkProject* project, UplinkAccess* access) {
+    (void)project;
+    (void)access;
+    round_trip();
+    return NULL;
+}
+
+void uplink_free_project_result(UplinkProjectResult result) {
+    free(result.project);
+    uplink_free_error(result.error);
+}
+
+/* ========== buckets ========== */
+
+static UplinkBucketResult bucket_result(FakeBucket* bucket, UplinkError* error) {
+    UplinkBucketResult result = { bucket != NULL ? bucket_to_uplink(bucket) : NULL, error };
+    return result;
+}
+
+UplinkBucketResult uplink_stat_bucket(UplinkProject* project, const char* bucket_name) {
+    (void)project;
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = find_bucket(bucket_name);
+    UplinkBucketResult result = bucket_result(bucket, bucket == NULL
+        ? make_error(FAKE_ERROR_BUCKET_NOT_FOUND, "bucket not found: \"%s\"", bucket_name)
+        : NULL);
+    pthread_mutex_unlock(&store_lock);
+    return result;
+}
+
+static UplinkBucketResult create_bucket(const char* bucket_name, bool ensure) {
+    round_trip();
+    if (!bucket_name_valid(bucket_name)) {
+        return bucket_result(NULL, make_error(FAKE_ERROR_BUCKET_NAME_INVALID, "bucket name invalid: \"%s\"",
+                                              bucket_name));
+    }
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = find_bucket(bucket_name);
+    UplinkError* error = NULL;
+    if (bucket != NULL) {
+        if (!ensure) {
+            error = make_error(FAKE_ERROR_BUCKET_EXISTS, "bucket already exists: \"%s\"", bucket_name);
+        }
+    } else {
+        bucket = (FakeBucket*)calloc(1, sizeof(FakeBucket));
+        if (bucket != NULL) {
+            bucket->name = strdup(bucket_name);
+            bucket->created = now_seconds();
+            bucket->next = buckets;
+            buckets = bucket;
+        } else {
+            error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        }
+    }
+    UplinkBucketResult result = bucket_result(bucket, error);
+    pthread_mutex_unlock(&store_lock);
+    return result;
+}
+
+UplinkBucketResult uplink_create_bucket(UplinkProject* project, const char* bucket_name) {
+    (void)project;
+    return create_bucket(bucket_name, false);
+}
+
+UplinkBucketResult uplink_ensure_bucket(UplinkProject* project, const char* bucket_name) {
+    (void)project;
+    return create_bucket(bucket_name, true);
+}
+
+static UplinkBucketResult delete_bucket(const char* bucket_name, bool with_objects) {
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket** link = &buckets;
+    while (*link != NULL && strcmp((*link)->name, bucket_name) != 0) {
+        link = &(*link)->next;
+    }
+    FakeBucket* bucket = *link;
+    UplinkBucketResult result = { NULL, NULL };
+    if (bucket == NULL) {
+        result.error = make_error(FAKE_ERROR_BUCKET_NOT_FOUND, "bucket not found: \"%s\"", bucket_name);
+    } else if (bucket->count > 0 && !with_objects) {
+        result.error = make_error(FAKE_ERROR_BUCKET_NOT_EMPTY, "bucket not empty: \"%s\"", bucket_name);
+    } else {
+        result.bucket = bucket_to_uplink(bucket);
+        *link = bucket->next;
+        while (bucket->count > 0) {
+            remove_object(bucket, bucket->count - 1);
+        }
+        free(bucket->objects);
+        free(bucket->name);
+        /* Pending uploads are leaked with the bucket; benchmarks don't abandon them */
+        free(bucket);
+    }
+    pthread_mutex_unlock(&store_lock);
+    return result;
+}
+
+UplinkBucketResult uplink_delete_bucket(UplinkProject* project, const char* bucket_name) {
+    (void)project;
+    return delete_bucket(bucket_name, false);
+}
+
+UplinkBucketResult uplink_delete_bucket_with_objects(UplinkProject* project, const char* bucket_name) {
+    (void)project;
+    return delete_bucket(bucket_name, true);
+}
+
+void uplink_free_bucket(UplinkBucket* bucket) {
+    if (bucket != NULL) {
+        free(bucket->name);
+        free(bucket);
+    }
+}
+
+void uplink_free_bucket_result(UplinkBucketResult result) {
+    uplink_free_bucket(result.bucket);
+    uplink_free_error(result.error);
+}
+
+/* ========== listing ========== */
+
+/** A snapshot of listing results, paid for one round trip per page on next() */
+typedef struct {
+    void** items;
+    size_t count;
+    size_t position;                /* 1-based index of the current item */
+    void (*free_item)(void* item);
+    bool owns_items;                /* false once handed to the caller */
+    UplinkError* error;
+} FakeIterator;
+
+static FakeIterator* iterator_new(void (*free_item)(void*), bool owns_items) {
+    FakeIterator* iterator = (FakeIterator*)calloc(1, sizeof(FakeIterator));
+    if (iterator != NULL) {
+        iterator->free_item = free_item;
+        iterator->owns_items = owns_items;
+    }
+    return iterator;
+}
+
+static void iterator_push(FakeIterator* iterator, void* item, size_t* capacity) {
+    if (item == NULL) {
+        return;
+    }
+    if (iterator->count == *capacity) {
+        size_t grown = *capacity ? *capacity * 2 : 64;
+        void** items = (void**)realloc(iterator->items, grown * sizeof(void*));
+        if (items == NULL) {
+            iterator->free_item(item);
+            return;
+        }
+        iterator->items = items;
+        *capacity = grown;
+    }
+    iterator->items[iterator->count++] = item;
+}
+
+static bool iterator_next(FakeIterator* iterator) {
+    if (iterator == NULL || iterator->error != NULL || iterator->position >= iterator->count + 1) {
+        return false;
+    }
+    pthread_once(&config_once, config_init);
+    if (iterator->position % page_size == 0 && iterator->position < iterator->count) {
+        round_trip();
+    }
+    if (iterator->owns_items && iterator->position > 0) {
+        iterator->free_item(iterator->items[iterator->position - 1]);
+        iterator->items[iterator->position - 1] = NULL;
+    }
+    iterator->position++;
+    return iterator->position <= iterator->count;
+}
+
+/** Current item; owned by the caller unless the iterator owns its items */
+static void* iterator_item(FakeIterator* iterator) {
+    if (iterator == NULL || iterator->position == 0 || iterator->position > iterator->count) {
+        return NULL;
+    }
+    void* item = iterator->items[iterator->position - 1];
+    if (!iterator->owns_items) {
+        iterator->items[iterator->position - 1] = NULL;
+    }
+    return item;
+}
+
+static UplinkError* iterator_err(FakeIterator* iterator) {
+    if (iterator == NULL || iterator->error == NULL) {
+        return NULL;
+    }
+    return make_error(iterator->error->code, "%s", iterator->error->message);
+}
+
+static void iterator_free(FakeIterator* iterator) {
+    if (iterator == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < iterator->count; i++) {
+        if (iterator->items[i] != NULL) {
+            iterator->free_item(iterator->items[i]);
+        }
+    }
+    free(iterator->items);
+    uplink_free_error(iterator->error);
+    free(iterator);
+}
+
+static void free_bucket_item(void* item) {
+    uplink_free_bucket((UplinkBucket*)item);
+}
+
+static void free_object_item(void* item) {
+    uplink_free_object((UplinkObject*)item);
+}
+
+static int compare_buckets(const void* a, const void* b) {
+    return strcmp((*(UplinkBucket* const*)a)->name, (*(UplinkBucket* const*)b)->name);
+}
+
+UplinkBucketIterator* uplink_list_buckets(UplinkProject* project, UplinkListBucketsOptions* options) {
+    (void)project;
+    FakeIterator* iterator = iterator_new(free_bucket_item, false);
+    if (iterator == NULL) {
+        return NULL;
+    }
+    size_t capacity = 0;
+    const char* cursor = options != NULL && options->cursor != NULL ? options->cursor : "";
+    pthread_mutex_lock(&store_lock);
+    for (FakeBucket* bucket = buckets; bucket != NULL; bucket = bucket->next) {
+        if (strcmp(bucket->name, cursor) > 0) {
+            iterator_push(iterator, bucket_to_uplink(bucket), &capacity);
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    if (iterator->count > 1) {
+        qsort(iterator->items, iterator->count, sizeof(void*), compare_buckets);
+    }
+    return (UplinkBucketIterator*)iterator;
+}
+
+bool uplink_bucket_iterator_next(UplinkBucketIterator* iterator) {
+    return iterator_next((FakeIterator*)iterator);
+}
+
+UplinkBucket* uplink_bucket_iterator_item(UplinkBucketIterator* iterator) {
+    return (UplinkBucket*)iterator_item((FakeIterator*)iterator);
+}
+
+UplinkError* uplink_bucket_iterator_err(UplinkBucketIterator* iterator) {
+    return iterator_err((FakeIterator*)iterator);
+}
+
+void uplink_free_bucket_iterator(UplinkBucketIterator* iterator) {
+    iterator_free((FakeIterator*)iterator);
+}
+
+UplinkObjectIterator* uplink_list_objects(UplinkProject* project, const char* bucket_name,
+                                          UplinkListObjectsOptions* options) {
+    (void)project;
+    FakeIterator* iterator = iterator_new(free_object_item, false);
+    if (iterator == NULL) {
+        return NULL;
+    }
+    const char* prefix = options != NULL && options->prefix != NULL ? options->prefix : "";
+    const char* cursor = options != NULL && options->cursor != NULL ? options->cursor : "";
+    bool recursive = options != NULL && options->recursive;
+    bool custom = options != NULL && options->custom;
+    size_t prefix_length = strlen(prefix);
+    size_t capacity = 0;
+
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, NULL, &iterator->error);
+    const char* last_prefix = NULL;
+    size_t last_prefix_length = 0;
+    if (bucket != NULL) {
+        bool found;
+        size_t start = find_object(bucket, prefix, &found);
+        for (size_t i = start; i < bucket->count; i++) {
+            const FakeObject* object = &bucket->objects[i];
+            if (strncmp(object->key, prefix, prefix_length) != 0) {
+                break;
+            }
+            if (cursor[0] != '\0' && strcmp(object->key, cursor) <= 0) {
+                continue;
+            }
+            const char* slash = recursive ? NULL : strchr(object->key + prefix_length, '/');
+            if (slash == NULL) {
+                iterator_push(iterator, object_to_uplink(object, custom), &capacity);
+                continue;
+            }
+            /* Collapse everything under the next "/" into one prefix entry */
+            size_t length = (size_t)(slash - object->key) + 1;
+            if (last_prefix != NULL && length == last_prefix_length &&
+                strncmp(object->key, last_prefix, length) == 0) {
+                continue;
+            }
+            UplinkObject* entry = (UplinkObject*)calloc(1, sizeof(UplinkObject));
+            if (entry != NULL) {
+                entry->key = strndup(object->key, length);
+                entry->is_prefix = true;
+            }
+            iterator_push(iterator, entry, &capacity);
+            last_prefix = object->key;
+            last_prefix_length = length;
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return (UplinkObjectIterator*)iterator;
+}
+
+bool uplink_object_iterator_next(UplinkObjectIterator* iterator) {
+    return iterator_next((FakeIterator*)iterator);
+}
+
+UplinkObject* uplink_object_iterator_item(UplinkObjectIterator* iterator) {
+    return (UplinkObject*)iterator_item((FakeIterator*)iterator);
+}
+
+UplinkError* uplink_object_iterator_err(UplinkObjectIterator* iterator) {
+    return iterator_err((FakeIterator*)iterator);
+}
+
+void uplink_free_object_iterator(UplinkObjectIterator* iterator) {
+    iterator_free((FakeIterator*)iterator);
+}
+
+/* ========== objects ========== */
+
+void uplink_free_object(UplinkObject* object) {
+    if (object != NULL) {
+        free(object->key);
+        free_custom(&object->custom);
+        free(object);
+    }
+}
+
+void uplink_free_object_result(UplinkObjectResult result) {
+    uplink_free_object(result.object);
+    uplink_free_error(result.error);
+}
+
+UplinkObjectResult uplink_stat_object(UplinkProject* project, const char* bucket_name, const char* object_key) {
+    (void)project;
+    UplinkObjectResult result = { NULL, NULL };
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &result.error);
+    if (bucket != NULL) {
+        bool found;
+        size_t index = find_object(bucket, object_key, &found);
+        if (found) {
+            result.object = object_to_uplink(&bucket->objects[index], true);
+        } else {
+            result.error = make_error(FAKE_ERROR_OBJECT_NOT_FOUND, "object not found: \"%s\"", object_key);
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return result;
+}
+
+UplinkObjectResult uplink_delete_object(UplinkProject* project, const char* bucket_name, const char* object_key) {
+    (void)project;
+    UplinkObjectResult result = { NULL, NULL };
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &result.error);
+    if (bucket != NULL) {
+        bool found;
+        size_t index = find_object(bucket, object_key, &found);
+        if (found) {
+            result.object = object_to_uplink(&bucket->objects[index], false);
+            remove_object(bucket, index);
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return result;
+}
+
+/** Copy, or move when @p remove is set (store_lock not held) */
+static UplinkObjectResult copy_object(const char* src_bucket, const char* src_key,
+                                      const char* dst_bucket, const char* dst_key, bool remove) {
+    UplinkObjectResult result = { NULL, NULL };
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* from = object_bucket(src_bucket, src_key, &result.error);
+    FakeBucket* to = from != NULL ? object_bucket(dst_bucket, dst_key, &result.error) : NULL;
+    if (to != NULL) {
+        bool found;
+        size_t index = find_object(from, src_key, &found);
+        if (!found) {
+            result.error = make_error(FAKE_ERROR_OBJECT_NOT_FOUND, "object not found: \"%s\"", src_key);
+        } else {
+            FakeObject source = from->objects[index];
+            source.blob->refs++;
+            UplinkCustomMetadata custom;
+            copy_custom(&custom, &source.custom);
+            FakeObject* copy = put_object(to, dst_key, source.blob, source.expires, &custom);
+            free_custom(&custom);
+            if (copy == NULL) {
+                source.blob->refs--;
+                result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+            } else {
+                result.object = object_to_uplink(copy, true);
+                if (remove && (from != to || strcmp(src_key, dst_key) != 0)) {
+                    index = find_object(from, src_key, &found);
+                    remove_object(from, index);
+                }
+            }
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return result;
+}
+
+UplinkObjectResult uplink_copy_object(UplinkProject* project, const char* old_bucket_name,
+                                      const char* old_object_key, const char* new_bucket_name,
+                                      const char* new_object_key, UplinkCopyObjectOptions* options) {
+    (void)project;
+    (void)options;
+    return copy_object(old_bucket_name, old_object_key, new_bucket_name, new_object_key, false);
+}
+
+UplinkError* uplink_move_object(UplinkProject* project, const char* old_bucket_name,
+                                const char* old_object_key, const char* new_bucket_name,
+                                const char* new_object_key, UplinkMoveObjectOptions* options) {
+    (void)project;
+    (void)options;
+    UplinkObjectResult result = copy_object(old_bucket_name, old_object_key, new_bucket_name,
+                                            new_object_key, true);
+    uplink_free_object(result.object);
+    return result.error;
+}
+
+UplinkError* uplink_update_object_metadata(UplinkProject* project, const char* bucket_name,
+                                           const char* object_key, UplinkCustomMetadata new_metadata,
+                                           UplinkUploadObjectMetadataOptions* options) {
+    (void)project;
+    (void)options;
+    UplinkError* error = NULL;
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &error);
+    if (bucket != NULL) {
+        bool found;
+        size_t index = find_object(bucket, object_key, &found);
+        if (found) {
+            free_custom(&bucket->objects[index].custom);
+            copy_custom(&bucket->objects[index].custom, &new_metadata);
+        } else {
+            error = make_error(FAKE_ERROR_OBJECT_NOT_FOUND, "object not found: \"%s\"", object_key);
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return error;
+}
+
+/* ========== upload ========== */
+
+typedef struct {
+    char* bucket;
+    char* key;
+    int64_t expires;
+    char* data;
+    size_t length;
+    size_t capacity;
+    UplinkCustomMetadata custom;
+    int64_t created;                /* set by commit */
+    bool done;
+} FakeUpload;
+
+static bool append(char** data, size_t* length, size_t* capacity, const void* bytes, size_t count) {
+    if (*length + count > *capacity) {
+        size_t grown = *capacity ? *capacity : 64 * 1024;
+        while (grown < *length + count) {
+            grown *= 2;
+        }
+        char* buffer = (char*)realloc(*data, grown);
+        if (buffer == NULL) {
+            return false;
+        }
+        *data = buffer;
+        *capacity = grown;
+    }
+    memcpy(*data + *length, bytes, count);
+    *length += count;
+    return true;
+}
+
+UplinkUploadResult uplink_upload_object(UplinkProject* project, const char* bucket_name,
+                                        const char* object_key, UplinkUploadOptions* options) {
+    (void)project;
+    UplinkUploadResult result = { NULL, NULL };
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &result.error);
+    pthread_mutex_unlock(&store_lock);
+    if (bucket == NULL) {
+        return result;
+    }
+    FakeUpload* upload = (FakeUpload*)calloc(1, sizeof(FakeUpload));
+    result.upload = (UplinkUpload*)calloc(1, sizeof(UplinkUpload));
+    if (upload == NULL || result.upload == NULL) {
+        free(upload);
+        free(result.upload);
+        result.upload = NULL;
+        result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        return result;
+    }
+    upload->bucket = strdup(bucket_name);
+    upload->key = strdup(object_key);
+    upload->expires = options != NULL ? options->expires : 0;
+    result.upload->_handle = (size_t)upload;
+    return result;
+}
+
+UplinkWriteResult uplink_upload_write(UplinkUpload* upload, void* bytes, size_t length) {
+    FakeUpload* fake = (FakeUpload*)upload->_handle;
+    UplinkWriteResult result = { 0, NULL };
+    if (fake->done) {
+        result.error = make_error(FAKE_ERROR_UPLOAD_DONE, "upload already committed or aborted%s", "");
+        return result;
+    }
+    transfer(length);
+    if (!append(&fake->data, &fake->length, &fake->capacity, bytes, length)) {
+        result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        return result;
+    }
+    result.bytes_written = length;
+    return result;
+}
+
+UplinkError* uplink_upload_set_custom_metadata(UplinkUpload* upload, UplinkCustomMetadata custom_metadata) {
+    FakeUpload* fake = (FakeUpload*)upload->_handle;
+    if (fake->done) {
+        return make_error(FAKE_ERROR_UPLOAD_DONE, "upload already committed or aborted%s", "");
+    }
+    free_custom(&fake->custom);
+    copy_custom(&fake->custom, &custom_metadata);
+    return NULL;
+}
+
+UplinkError* uplink_upload_commit(UplinkUpload* upload) {
+    FakeUpload* fake = (FakeUpload*)upload->_handle;
+    if (fake->done) {
+        return make_error(FAKE_ERROR_UPLOAD_DONE, "upload already committed or aborted%s", "");
+    }
+    round_trip();
+    Blob* blob = (Blob*)malloc(sizeof(Blob) + fake->length);
+    if (blob == NULL) {
+        return make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+    }
+    blob->refs = 1;
+    blob->length = fake->length;
+    if (fake->length > 0) {
+        memcpy(blob->bytes, fake->data, fake->length);
+    }
+    free(fake->data);
+    fake->data = NULL;
+    fake->capacity = 0;
+
+    UplinkError* error = NULL;
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(fake->bucket, fake->key, &error);
+    FakeObject* object = bucket != NULL ? put_object(bucket, fake->key, blob, fake->expires, &fake->custom) : NULL;
+    if (object != NULL) {
+        fake->created = object->created;
+        fake->length = blob->length;
+    } else {
+        free(blob);
+        if (error == NULL) {
+            error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    fake->done = error == NULL;
+    return error;
+}
+
+UplinkError* uplink_upload_abort(UplinkUpload* upload) {
+    FakeUpload* fake = (FakeUpload*)upload->_handle;
+    if (fake->done) {
+        return make_error(FAKE_ERROR_UPLOAD_DONE, "upload already committed or aborted%s", "");
+    }
+    fake->done = true;
+    free(fake->data);
+    fake->data = NULL;
+    fake->length = fake->capacity = 0;
+    return NULL;
+}
+
+UplinkObjectResult uplink_upload_info(UplinkUpload* upload) {
+    FakeUpload* fake = (FakeUpload*)upload->_handle;
+    UplinkObjectResult result = { (UplinkObject*)calloc(1, sizeof(UplinkObject)), NULL };
+    if (result.object == NULL) {
+        result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        return result;
+    }
+    result.object->key = strdup(fake->key);
+    result.object->system.created = fake->created;
+    result.object->system.expires = fake->expires;
+    result.object->system.content_length = (int64_t)fake->length;
+    copy_custom(&result.object->custom, &fake->custom);
+    return result;
+}
+
+void uplink_free_upload_result(UplinkUploadResult result) {
+    if (result.upload != NULL) {
+        FakeUpload* fake = (FakeUpload*)result.upload->_handle;
+        free(fake->bucket);
+        free(fake->key);
+        free(fake->data);
+        free_custom(&fake->custom);
+        free(fake);
+        free(result.upload);
+    }
+    uplink_free_error(result.error);
+}
+
+/* ========== download ========== */
+
+typedef struct {
+    Blob* blob;                     /* NULL once closed */
+    FakeObject object;              /* metadata snapshot, key and custom owned */
+    size_t length;
+    size_t offset;
+    size_t end;
+} FakeDownload;
+
+UplinkDownloadResult uplink_download_object(UplinkProject* project, const char* bucket_name,
+                                            const char* object_key, UplinkDownloadOptions* options) {
+    (void)project;
+    UplinkDownloadResult result = { NULL, NULL };
+    round_trip();
+    FakeDownload* download = (FakeDownload*)calloc(1, sizeof(FakeDownload));
+    result.download = (UplinkDownload*)calloc(1, sizeof(UplinkDownload));
+    if (download == NULL || result.download == NULL) {
+        free(download);
+        free(result.download);
+        result.download = NULL;
+        result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        return result;
+    }
+
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &result.error);
+    if (bucket != NULL) {
+        bool found;
+        size_t index = find_object(bucket, object_key, &found);
+        if (found) {
+            FakeObject* object = &bucket->objects[index];
+            download->blob = object->blob;
+            download->blob->refs++;
+            download->object = *object;
+            download->object.blob = NULL;
+            download->object.key = strdup(object->key);
+            copy_custom(&download->object.custom, &object->custom);
+        } else {
+            result.error = make_error(FAKE_ERROR_OBJECT_NOT_FOUND, "object not found: \"%s\"", object_key);
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+
+    if (result.error != NULL) {
+        free(download);
+        free(result.download);
+        result.download = NULL;
+        return result;
+    }
+    size_t length = download->length = download->blob->length;
+    int64_t offset = options != NULL ? options->offset : 0;
+    int64_t count = options != NULL ? options->length : -1;
+    download->offset = offset > 0 && (size_t)offset < length ? (size_t)offset : (offset > 0 ? length : 0);
+    download->end = count >= 0 && download->offset + (size_t)count < length
+        ? download->offset + (size_t)count : length;
+    result.download->_handle = (size_t)download;
+    return result;
+}
+
+UplinkReadResult uplink_download_read(UplinkDownload* download, void* bytes, size_t length) {
+    FakeDownload* fake = (FakeDownload*)download->_handle;
+    UplinkReadResult result = { 0, NULL };
+    if (fake->blob == NULL || fake->offset >= fake->end) {
+        result.error = make_eof();
+        return result;
+    }
+    size_t count = fake->end - fake->offset;
+    if (count > length) {
+        count = length;
+    }
+    transfer(count);
+    memcpy(bytes, fake->blob->bytes + fake->offset, count);
+    fake->offset += count;
+    result.bytes_read = count;
+    return result;
+}
+
+UplinkObjectResult uplink_download_info(UplinkDownload* download) {
+    FakeDownload* fake = (FakeDownload*)download->_handle;
+    UplinkObjectResult result = { NULL, NULL };
+    result.object = object_to_uplink(&fake->object, true);
+    if (result.object != NULL) {
+        result.object->system.content_length = (int64_t)fake->length;
+    }
+    return result;
+}
+
+UplinkError* uplink_close_download(UplinkDownload* download) {
+    FakeDownload* fake = (FakeDownload*)download->_handle;
+    blob_release(fake->blob);
+    fake->blob = NULL;
+    return NULL;
+}
+
+void uplink_free_download_result(UplinkDownloadResult result) {
+    if (result.download != NULL) {
+        FakeDownload* fake = (FakeDownload*)result.download->_handle;
+        blob_release(fake->blob);
+        free(fake->object.key);
+        free_custom(&fake->object.custom);
+        free(fake);
+        free(result.download);
+    }
+    uplink_free_error(result.error);
+}
+
+/* ========== multipart ========== */
+
+static FakePending* find_pending(FakeBucket* bucket, const char* key, const char* upload_id) {
+    for (FakePending* pending = bucket->pending; pending != NULL; pending = pending->next) {
+        if (strcmp(pending->upload_id, upload_id) == 0 && strcmp(pending->key, key) == 0) {
+            return pending;
+        }
+    }
+    return NULL;
+}
+
+static void free_pending(FakePending* pending) {
+    while (pending->parts != NULL) {
+        FakePart* part = pending->parts;
+        pending->parts = part->next;
+        free(part->data);
+        free(part->etag);
+        free(part);
+    }
+    free(pending->upload_id);
+    free(pending->key);
+    free(pending);
+}
+
+static UplinkUploadInfo* pending_to_info(const FakePending* pending) {
+    UplinkUploadInfo* info = (UplinkUploadInfo*)calloc(1, sizeof(UplinkUploadInfo));
+    if (info != NULL) {
+        info->upload_id = strdup(pending->upload_id);
+        info->key = strdup(pending->key);
+        info->system.created = pending->created;
+        info->system.expires = pending->expires;
+    }
+    return info;
+}
+
+static void free_upload_info(UplinkUploadInfo* info) {
+    if (info != NULL) {
+        free(info->upload_id);
+        free(info->key);
+        free_custom(&info->custom);
+        free(info);
+    }
+}
+
+UplinkUploadInfoResult uplink_begin_upload(UplinkProject* project, const char* bucket_name,
+                                           const char* object_key, UplinkUploadOptions* options) {
+    (void)project;
+    UplinkUploadInfoResult result = { NULL, NULL };
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &result.error);
+    FakePending* pending = bucket != NULL ? (FakePending*)calloc(1, sizeof(FakePending)) : NULL;
+    if (pending != NULL) {
+        char id[32];
+        snprintf(id, sizeof(id), "fake-%llu", (unsigned long long)next_upload_id++);
+        pending->upload_id = strdup(id);
+        pending->key = strdup(object_key);
+        pending->created = now_seconds();
+        pending->expires = options != NULL ? options->expires : 0;
+        pending->next = bucket->pending;
+        bucket->pending = pending;
+        result.info = pending_to_info(pending);
+    } else if (result.error == NULL) {
+        result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+    }
+    pthread_mutex_unlock(&store_lock);
+    return result;
+}
+
+UplinkCommitUploadResult uplink_commit_upload(UplinkProject* project, const char* bucket_name,
+                                              const char* object_key, const char* upload_id,
+                                              UplinkCommitUploadOptions* options) {
+    (void)project;
+    UplinkCommitUploadResult result = { NULL, NULL };
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &result.error);
+    FakePending* pending = bucket != NULL ? find_pending(bucket, object_key, upload_id) : NULL;
+    if (bucket != NULL && pending == NULL) {
+        result.error = make_error(FAKE_ERROR_OBJECT_NOT_FOUND, "upload not found: \"%s\"", upload_id);
+    }
+    if (pending != NULL) {
+        size_t total = 0;
+        for (FakePart* part = pending->parts; part != NULL; part = part->next) {
+            total += part->length;
+        }
+        Blob* blob = (Blob*)malloc(sizeof(Blob) + total);
+        if (blob == NULL) {
+            result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        } else {
+            /* Parts are kept sorted by number */
+            blob->refs = 1;
+            blob->length = 0;
+            for (FakePart* part = pending->parts; part != NULL; part = part->next) {
+                memcpy(blob->bytes + blob->length, part->data, part->length);
+                blob->length += part->length;
+            }
+            FakeObject* object = put_object(bucket, object_key, blob, pending->expires,
+                                            options != NULL ? &options->custom_metadata : NULL);
+            if (object == NULL) {
+                free(blob);
+                result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+            } else {
+                result.object = object_to_uplink(object, true);
+                FakePending** link = &bucket->pending;
+                while (*link != pending) {
+                    link = &(*link)->next;
+                }
+                *link = pending->next;
+                free_pending(pending);
+            }
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return result;
+}
+
+UplinkError* uplink_abort_upload(UplinkProject* project, const char* bucket_name,
+                                 const char* object_key, const char* upload_id) {
+    (void)project;
+    UplinkError* error = NULL;
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &error);
+    if (bucket != NULL) {
+        FakePending** link = &bucket->pending;
+        while (*link != NULL && !(strcmp((*link)->upload_id, upload_id) == 0 &&
+                                  strcmp((*link)->key, object_key) == 0)) {
+            link = &(*link)->next;
+        }
+        if (*link == NULL) {
+            error = make_error(FAKE_ERROR_OBJECT_NOT_FOUND, "upload not found: \"%s\"", upload_id);
+        } else {
+            FakePending* pending = *link;
+            *link = pending->next;
+            free_pending(pending);
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return error;
+}
+
+UplinkPartUploadResult uplink_upload_part(UplinkProject* project, const char* bucket_name,
+                                          const char* object_key, const char* upload_id,
+                                          uint32_t part_number) {
+    (void)project;
+    UplinkPartUploadResult result = { NULL, NULL };
+    round_trip();
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &result.error);
+    FakePending* pending = bucket != NULL ? find_pending(bucket, object_key, upload_id) : NULL;
+    if (bucket != NULL && pending == NULL) {
+        result.error = make_error(FAKE_ERROR_OBJECT_NOT_FOUND, "upload not found: \"%s\"", upload_id);
+    }
+    if (pending != NULL) {
+        FakePart** link = &pending->parts;
+        while (*link != NULL && (*link)->number < part_number) {
+            link = &(*link)->next;
+        }
+        FakePart* part = *link;
+        if (part == NULL || part->number != part_number) {
+            part = (FakePart*)calloc(1, sizeof(FakePart));
+            if (part != NULL) {
+                part->number = part_number;
+                part->next = *link;
+                *link = part;
+            }
+        } else {
+            /* Uploading a part number again replaces it */
+            free(part->data);
+            part->data = NULL;
+            part->length = part->capacity = 0;
+            part->done = false;
+        }
+        result.part_upload = part != NULL ? (UplinkPartUpload*)calloc(1, sizeof(UplinkPartUpload)) : NULL;
+        if (result.part_upload != NULL) {
+            result.part_upload->_handle = (size_t)part;
+        } else {
+            result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return result;
+}
+
+UplinkWriteResult uplink_part_upload_write(UplinkPartUpload* part_upload, void* bytes, size_t length) {
+    FakePart* part = (FakePart*)part_upload->_handle;
+    UplinkWriteResult result = { 0, NULL };
+    if (part->done) {
+        result.error = make_error(FAKE_ERROR_UPLOAD_DONE, "part already committed or aborted%s", "");
+        return result;
+    }
+    transfer(length);
+    if (!append(&part->data, &part->length, &part->capacity, bytes, length)) {
+        result.error = make_error(FAKE_ERROR_INTERNAL, "out of memory%s", "");
+        return result;
+    }
+    result.bytes_written = length;
+    return result;
+}
+
+UplinkError* uplink_part_upload_commit(UplinkPartUpload* part_upload) {
+    FakePart* part = (FakePart*)part_upload->_handle;
+    if (part->done) {
+        return make_error(FAKE_ERROR_UPLOAD_DONE, "part already committed or aborted%s", "");
+    }
+    round_trip();
+    part->done = true;
+    part->modified = now_seconds();
+    return NULL;
+}
+
+UplinkError* uplink_part_upload_abort(UplinkPartUpload* part_upload) {
+    FakePart* part = (FakePart*)part_upload->_handle;
+    if (part->done) {
+        return make_error(FAKE_ERROR_UPLOAD_DONE, "part already committed or aborted%s", "");
+    }
+    part->done = true;
+    free(part->data);
+    part->data = NULL;
+    part->length = part->capacity = 0;
+    return NULL;
+}
+
+UplinkError* uplink_part_upload_set_etag(UplinkPartUpload* part_upload, const char* etag) {
+    FakePart* part = (FakePart*)part_upload->_handle;
+    free(part->etag);
+    part->etag = copy_string(etag);
+    return NULL;
+}
+
+static UplinkPart* part_to_uplink(const FakePart* part) {
+    UplinkPart* result = (UplinkPart*)calloc(1, sizeof(UplinkPart));
+    if (result != NULL) {
+        result->part_number = part->number;
+        result->size = part->length;
+        result->modified = part->modified;
+        if (part->etag != NULL) {
+            result->etag = strdup(part->etag);
+            result->etag_length = strlen(part->etag);
+        }
+    }
+    return result;
+}
+
+static void free_part_item(void* item) {
+    UplinkPart* part = (UplinkPart*)item;
+    free((char*)part->etag);
+    free(part);
+}
+
+UplinkPartResult uplink_part_upload_info(UplinkPartUpload* part_upload) {
+    UplinkPartResult result = { part_to_uplink((FakePart*)part_upload->_handle), NULL };
+    return result;
+}
+
+void uplink_free_part_result(UplinkPartResult result) {
+    if (result.part != NULL) {
+        free_part_item(result.part);
+    }
+    uplink_free_error(result.error);
+}
+
+void uplink_free_part_upload_result(UplinkPartUploadResult result) {
+    /* The part itself belongs to its pending upload */
+    free(result.part_upload);
+    uplink_free_error(result.error);
+}
+
+void uplink_free_upload_info_result(UplinkUploadInfoResult result) {
+    free_upload_info(result.info);
+    uplink_free_error(result.error);
+}
+
+void uplink_free_commit_upload_result(UplinkCommitUploadResult result) {
+    uplink_free_object(result.object);
+    uplink_free_error(result.error);
+}
+
+UplinkPartIterator* uplink_list_upload_parts(UplinkProject* project, const char* bucket_name,
+                                             const char* object_key, const char* upload_id,
+                                             UplinkListUploadPartsOptions* options) {
+    (void)project;
+    FakeIterator* iterator = iterator_new(free_part_item, true);
+    if (iterator == NULL) {
+        return NULL;
+    }
+    uint32_t cursor = options != NULL ? options->cursor : 0;
+    size_t capacity = 0;
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, object_key, &iterator->error);
+    FakePending* pending = bucket != NULL ? find_pending(bucket, object_key, upload_id) : NULL;
+    if (bucket != NULL && pending == NULL) {
+        iterator->error = make_error(FAKE_ERROR_OBJECT_NOT_FOUND, "upload not found: \"%s\"", upload_id);
+    }
+    for (FakePart* part = pending != NULL ? pending->parts : NULL; part != NULL; part = part->next) {
+        if (part->done && part->number > cursor) {
+            iterator_push(iterator, part_to_uplink(part), &capacity);
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return (UplinkPartIterator*)iterator;
+}
+
+bool uplink_part_iterator_next(UplinkPartIterator* iterator) {
+    return iterator_next((FakeIterator*)iterator);
+}
+
+UplinkPart* uplink_part_iterator_item(UplinkPartIterator* iterator) {
+    return (UplinkPart*)iterator_item((FakeIterator*)iterator);
+}
+
+UplinkError* uplink_part_iterator_err(UplinkPartIterator* iterator) {
+    return iterator_err((FakeIterator*)iterator);
+}
+
+void uplink_free_part_iterator(UplinkPartIterator* iterator) {
+    iterator_free((FakeIterator*)iterator);
+}
+
+static void free_upload_info_item(void* item) {
+    free_upload_info((UplinkUploadInfo*)item);
+}
+
+UplinkUploadIterator* uplink_list_uploads(UplinkProject* project, const char* bucket_name,
+                                          UplinkListUploadsOptions* options) {
+    (void)project;
+    FakeIterator* iterator = iterator_new(free_upload_info_item, true);
+    if (iterator == NULL) {
+        return NULL;
+    }
+    const char* prefix = options != NULL && options->prefix != NULL ? options->prefix : "";
+    size_t prefix_length = strlen(prefix);
+    size_t capacity = 0;
+    pthread_mutex_lock(&store_lock);
+    FakeBucket* bucket = object_bucket(bucket_name, NULL, &iterator->error);
+    for (FakePending* pending = bucket != NULL ? bucket->pending : NULL; pending != NULL; pending = pending->next) {
+        if (strncmp(pending->key, prefix, prefix_length) == 0) {
+            iterator_push(iterator, pending_to_info(pending), &capacity);
+        }
+    }
+    pthread_mutex_unlock(&store_lock);
+    return (UplinkUploadIterator*)iterator;
+}
+
+bool uplink_upload_iterator_next(UplinkUploadIterator* iterator) {
+    return iterator_next((FakeIterator*)iterator);
+}
+
+UplinkUploadInfo* uplink_upload_iterator_item(UplinkUploadIterator* iterator) {
+    return (UplinkUploadInfo*)iterator_item((FakeIterator*)iterator);
+}
+
+UplinkError* uplink_upload_iterator_err(UplinkUploadIterator* iterator) {
+    return iterator_err((FakeIterator*)iterator);
+}
+
+void uplink_free_upload_iterator(UplinkUploadIterator* iterator) {
+    iterator_free((FakeIterator*)iterator);
+}
+
+/* ========== edge ========== */
+
+EdgeCredentialsResult edge_register_access(EdgeConfig config, UplinkAccess* access,
+                                           EdgeRegisterAccessOptions* options) {
+    (void)config;
+    (void)access;
+    (void)options;
+    EdgeCredentialsResult result = { NULL, make_error(FAKE_ERROR_INTERNAL,
+                                                      "edge services are not available offline%s", "") };
+    return result;
+}
+
+void edge_free_credentials_result(EdgeCredentialsResult result) {
+    uplink_free_error(result.error);
+}
+
+UplinkStringResult edge_join_share_url(const char* baseURL, const char* accessKeyID, const char* bucket,
+                                       const char* key, EdgeShareURLOptions* options) {
+    const char* kind = options != NULL && options->raw ? "raw" : "s";
+    size_t length = strlen(baseURL) + strlen(accessKeyID) + strlen(bucket) + strlen(key) + 8;
+    UplinkStringResult result = { (char*)malloc(length), NULL };
+    if (result.string != NULL) {
+        snprintf(result.string, length, "%s/%s/%s/%s/%s", baseURL, kind, accessKeyID, bucket, key);
+    }
+    return result;
+}
@@ -13,6 +13,7 @@
 #include "access_complete.h"
 #include "access_types.h"
 #include "../common/handle_helpers.h"
+#include "../common/access_cache.h"
 #include "../common/string_helpers.h"
 #include "../common/result_helpers.h"
 #include "../common/error_registry.h"
@@ -21,6 +22,39 @@
 
 #include <stdlib.h>
 
+/* ========== helpers ========== */
+
+/**
+ * Build what a request or share resolves to per @p mode: the access
+ * handle, the serialized grant, or { access, serialized }. Takes
+ * ownership of @p access and the string in @p serialized.
+ *
+ * @return The value, or NULL when the access handle could not be created
+ */
+static napi_value access_result_value(napi_env env, UplinkAccess* access,
+                                      AccessSerializeMode mode, UplinkStringResult* serialized) {
+    napi_value grant = NULL;
+    if (mode != ACCESS_SERIALIZE_NONE) {
+        grant = create_string(env, serialized->string);
+        uplink_free_string_result(*serialized);
+        serialized->string = NULL;
+        if (mode == ACCESS_SERIALIZE_ONLY) {
+            return grant;
+        }
+    }
+    
+    napi_value access_external = create_handle_external(env, access->_handle, HANDLE_TYPE_ACCESS, access, NULL);
+    if (access_external == NULL || mode == ACCESS_SERIALIZE_NONE) {
+        return access_external;
+    }
+    
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_set_named_property(env, result, "access", access_external);
+    napi_set_named_property(env, result, "serialized", grant);
+    return result;
+}
+
 /* ========== Complete Functions (Main Thread) ========== */
 
 void parse_access_complete(napi_env env, napi_status status, void* data) {
@@ -35,14 +69,17 @@ void parse_access_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
-    /* Create handle external for the access */
-    napi_value access_external = create_handle_external(
-        env,
-        work_data->result.access->_handle,
-        HANDLE_TYPE_ACCESS,
-        work_data->result.access,
-        NULL
-    );
+    /* Shared through the cache when enabled, else owned by the handle */
+    napi_value access_external = access_cache_insert(env, work_data->access_grant, work_data->result.access);
+    if (access_external == NULL) {
+        access_external = create_handle_external(
+            env,
+            work_data->result.access->_handle,
+            HANDLE_TYPE_ACCESS,
+            work_data->result.access,
+            NULL
+        );
+    }
     
     if (access_external == NULL) {
         LOG_ERROR("parseAccess: failed to create handle external");
@@ -75,15 +112,9 @@ void request_access_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
-    napi_value access_external = create_handle_external(
-        env,
-        work_data->result.access->_handle,
-        HANDLE_TYPE_ACCESS,
-        work_data->result.access,
-        NULL
-    );
-    
-    if (access_external == NULL) {
+    napi_value value = access_result_value(env, work_data->result.access,
+                                           work_data->serialize_mode, &work_data->serialized);
+    if (value == NULL) {
         LOG_ERROR("requestAccessWithPassphrase: failed to create handle external");
         napi_value error;
         napi_value msg;
@@ -93,8 +124,8 @@ void request_access_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
-    LOG_INFO("requestAccessWithPassphrase: success, handle=%zu", work_data->result.access->_handle);
-    napi_resolve_deferred(env, work_data->deferred, access_external);
+    LOG_INFO("requestAccessWithPassphrase: success, serialize mode=%d", (int)work_data->serialize_mode);
+    napi_resolve_deferred(env, work_data->deferred, value);
     
 cleanup:
     free(work_data->satellite_address);
@@ -116,15 +147,9 @@ void config_request_access_complete(napi_env env, napi_status status, void* data
         goto cleanup;
     }
     
-    napi_value access_external = create_handle_external(
-        env,
-        work_data->result.access->_handle,
-        HANDLE_TYPE_ACCESS,
-        work_data->result.access,
-        NULL
-    );
-    
-    if (access_external == NULL) {
+    napi_value value = access_result_value(env, work_data->result.access,
+                                           work_data->serialize_mode, &work_data->serialized);
+    if (value == NULL) {
         napi_value error;
         napi_value msg;
         napi_create_string_utf8(env, "Failed to create access handle", NAPI_AUTO_LENGTH, &msg);
@@ -134,7 +159,7 @@ void config_request_access_complete(napi_env env, napi_status status, void* data
     }
     
     LOG_INFO("configRequestAccessWithPassphrase: success");
-    napi_resolve_deferred(env, work_data->deferred, access_external);
+    napi_resolve_deferred(env, work_data->deferred, value);
     
 cleanup:
     free(work_data->satellite_address);
@@ -207,16 +232,11 @@ void access_share_complete(napi_env env, napi_status status, void* data) {
     }
     
     {
-        napi_value access_external = create_handle_external(
-            env,
-            work_data->result.access->_handle,
-            HANDLE_TYPE_ACCESS,
-            work_data->result.access,
-            NULL
-        );
+        napi_value value = access_result_value(env, work_data->result.access,
+                                               work_data->serialize_mode, &work_data->serialized);
         
-        LOG_INFO("accessShare: success, new handle=%zu", work_data->result.access->_handle);
-        napi_resolve_deferred(env, work_data->deferred, access_external);
+        LOG_INFO("accessShare: success, serialize mode=%d", (int)work_data->serialize_mode);
+        napi_resolve_deferred(env, work_data->deferred, value);
     }
     
 cleanup:
@@ -230,6 +250,50 @@ cleanup:
     free(work_data);
 }
 
+void access_share_many_complete(napi_env env, napi_status status, void* data) {
+    AccessShareManyData* work_data = (AccessShareManyData*)data;
+    REJECT_IF_CANCELLED(env, status, work_data->deferred, "accessShareMany");
+    
+    /* The first failed spec rejects the whole call */
+    for (size_t i = 0; i < work_data->spec_count; i++) {
+        UplinkError* error = work_data->specs[i].result.error;
+        if (error != NULL) {
+            LOG_ERROR("accessShareMany failed for spec %zu: %s", i, error->message);
+            napi_reject_deferred(env, work_data->deferred, create_typed_error(env, error->code, error->message));
+            goto cleanup;
+        }
+    }
+    
+    napi_value grants;
+    napi_create_array_with_length(env, work_data->spec_count, &grants);
+    for (size_t i = 0; i < work_data->spec_count; i++) {
+        napi_set_element(env, grants, (uint32_t)i, create_string(env, work_data->specs[i].result.string));
+    }
+    
+    LOG_INFO("accessShareMany: %zu grants ready", work_data->spec_count);
+    napi_resolve_deferred(env, work_data->deferred, grants);
+    
+cleanup:
+    access_share_many_free_specs(work_data->specs, work_data->spec_count);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+void access_share_many_free_specs(AccessShareSpec* specs, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        AccessShareSpec* spec = &specs[i];
+        for (size_t j = 0; j < spec->prefix_count; j++) {
+            free((char*)spec->prefixes[j].bucket);
+            free((char*)spec->prefixes[j].prefix);
+        }
+        free(spec->prefixes);
+        if (spec->result.string != NULL || spec->result.error != NULL) {
+            uplink_free_string_result(spec->result);
+        }
+    }
+    free(specs);
+}
+
 void override_encryption_complete(napi_env env, napi_status status, void* data) {
     OverrideEncryptionData* work_data = (OverrideEncryptionData*)data;
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "accessOverrideEncryptionKey");
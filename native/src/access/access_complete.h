@@ -10,6 +10,7 @@
 #define UPLINK_ACCESS_COMPLETE_H
 
 #include <node_api.h>
+#include "access_types.h"
 
 /**
  * @brief Complete parseAccess on main thread
@@ -41,6 +42,16 @@ void access_serialize_complete(napi_env env, napi_status status, void* data);
  */
 void access_share_complete(napi_env env, napi_status status, void* data);
 
+/**
+ * @brief Complete accessShareMany on main thread
+ */
+void access_share_many_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Free the specs of an accessShareMany call and their results
+ */
+void access_share_many_free_specs(AccessShareSpec* specs, size_t count);
+
 /**
  * @brief Complete accessOverrideEncryptionKey on main thread
  */
@@ -10,8 +10,30 @@
 #include "access_types.h"
 #include "../common/logger.h"
 
+#include <stdlib.h>
+#include <string.h>
+#include <uv.h>
+
 /* ========== Execute Functions (Worker Thread) ========== */
 
+/**
+ * Serialize a fresh access in the same execute call when asked to. A
+ * failed serialize fails the whole call; in ACCESS_SERIALIZE_ONLY mode
+ * the access is freed here, as no handle will own it.
+ */
+static void serialize_result(UplinkAccessResult* result, AccessSerializeMode mode, UplinkStringResult* serialized) {
+    if (mode == ACCESS_SERIALIZE_NONE || result->error != NULL) {
+        return;
+    }
+    *serialized = uplink_access_serialize(result->access);
+    if (serialized->error != NULL || mode == ACCESS_SERIALIZE_ONLY) {
+        uplink_free_access_result(*result);
+        result->access = NULL;
+        result->error = serialized->error;
+        serialized->error = NULL;
+    }
+}
+
 void parse_access_execute(napi_env env, void* data) {
     (void)env;
     ParseAccessData* work_data = (ParseAccessData*)data;
@@ -30,6 +52,7 @@ void request_access_execute(napi_env env, void* data) {
         work_data->api_key,
         work_data->passphrase
     );
+    serialize_result(&work_data->result, work_data->serialize_mode, &work_data->serialized);
 }
 
 void config_request_access_execute(napi_env env, void* data) {
@@ -50,6 +73,7 @@ void config_request_access_execute(napi_env env, void* data) {
         work_data->api_key,
         work_data->passphrase
     );
+    serialize_result(&work_data->result, work_data->serialize_mode, &work_data->serialized);
 }
 
 void access_satellite_execute(napi_env env, void* data) {
@@ -85,6 +109,75 @@ void access_share_execute(napi_env env, void* data) {
         work_data->prefixes,
         (int)work_data->prefix_count
     );
+    serialize_result(&work_data->result, work_data->serialize_mode, &work_data->serialized);
+}
+
+/* ========== access_share_many_execute ========== */
+
+typedef struct {
+    AccessShareManyData* work_data;
+    uv_mutex_t lock;                /* guards next_spec */
+    size_t next_spec;
+} AccessShareManyState;
+
+static void access_share_many_worker(void* arg) {
+    AccessShareManyState* state = (AccessShareManyState*)arg;
+    AccessShareManyData* work_data = state->work_data;
+    UplinkAccess access = { ._handle = work_data->access_handle };
+    
+    for (;;) {
+        uv_mutex_lock(&state->lock);
+        size_t index = state->next_spec++;
+        uv_mutex_unlock(&state->lock);
+        if (index >= work_data->spec_count) {
+            return;
+        }
+        
+        /* The restricted access only lives long enough to be serialized */
+        AccessShareSpec* spec = &work_data->specs[index];
+        UplinkAccessResult shared = uplink_access_share(
+            &access, spec->permission, spec->prefixes, (int)spec->prefix_count);
+        if (shared.error != NULL) {
+            spec->result.error = shared.error;
+            continue;
+        }
+        spec->result = uplink_access_serialize(shared.access);
+        uplink_free_access_result(shared);
+    }
+}
+
+void access_share_many_execute(napi_env env, void* data) {
+    (void)env;
+    AccessShareManyData* work_data = (AccessShareManyData*)data;
+    
+    LOG_DEBUG("access_share_many_execute: %zu specs, concurrency=%u",
+              work_data->spec_count, work_data->concurrency);
+    
+    AccessShareManyState state;
+    memset(&state, 0, sizeof(state));
+    state.work_data = work_data;
+    uv_mutex_init(&state.lock);
+    
+    /* This job counts once against the bulk lane; its own threads are bounded by concurrency */
+    size_t thread_count = work_data->concurrency < work_data->spec_count
+        ? work_data->concurrency : work_data->spec_count;
+    uv_thread_t* threads = thread_count > 1 ? (uv_thread_t*)calloc(thread_count - 1, sizeof(uv_thread_t)) : NULL;
+    size_t started = 0;
+    if (threads != NULL) {
+        for (size_t i = 0; i + 1 < thread_count; i++) {
+            if (uv_thread_create(&threads[i], access_share_many_worker, &state) != 0) {
+                LOG_WARN("accessShareMany: could only start %zu of %zu threads", started + 1, thread_count);
+                break;
+            }
+            started++;
+        }
+    }
+    access_share_many_worker(&state);
+    for (size_t i = 0; i < started; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    free(threads);
+    uv_mutex_destroy(&state.lock);
 }
 
 void override_encryption_execute(napi_env env, void* data) {
@@ -40,6 +40,11 @@ void access_serialize_execute(napi_env env, void* data);
  */
 void access_share_execute(napi_env env, void* data);
 
+/**
+ * @brief Execute accessShareMany on worker thread
+ */
+void access_share_many_execute(napi_env env, void* data);
+
 /**
  * @brief Execute accessOverrideEncryptionKey on worker thread
  */
@@ -19,6 +19,11 @@
 #include "access_complete.h"
 #include "../common/handle_helpers.h"
 #include "../common/string_helpers.h"
+#include "../common/access_cache.h"
+#include "../common/result_helpers.h"
+#include "../common/error_registry.h"
+#include "../common/type_converters.h"
+#include "../common/thread_pool.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
@@ -45,6 +50,13 @@ napi_value parse_access(napi_env env, napi_callback_info info) {
         return NULL;
     }
     
+    napi_value cached = access_cache_lookup(env, access_grant);
+    if (cached != NULL) {
+        LOG_DEBUG("parseAccess: served from cache");
+        free(access_grant);
+        return create_resolved_promise(env, cached);
+    }
+    
     ParseAccessData* work_data = (ParseAccessData*)calloc(1, sizeof(ParseAccessData));
     if (work_data == NULL) {
         free(access_grant);
@@ -74,11 +86,53 @@ napi_value parse_access(napi_env env, napi_callback_info info) {
     return promise;
 }
 
+/* ========== helpers for request/share options ========== */
+
+/**
+ * Read options.serialize: true resolves { access, serialized }, 'only'
+ * resolves just the serialized grant.
+ * Throws a TypeError and returns -1 for any other value.
+ */
+static int extract_serialize_mode(napi_env env, napi_value options, AccessSerializeMode* out) {
+    *out = ACCESS_SERIALIZE_NONE;
+    napi_valuetype type = napi_undefined;
+    if (options != NULL) {
+        napi_typeof(env, options, &type);
+    }
+    if (type != napi_object) {
+        return 0;
+    }
+    
+    napi_value value;
+    napi_get_named_property(env, options, "serialize", &value);
+    napi_typeof(env, value, &type);
+    if (type == napi_undefined || type == napi_null) {
+        return 0;
+    }
+    if (type == napi_boolean) {
+        bool serialize = false;
+        napi_get_value_bool(env, value, &serialize);
+        *out = serialize ? ACCESS_SERIALIZE_WITH_HANDLE : ACCESS_SERIALIZE_NONE;
+        return 0;
+    }
+    if (type == napi_string) {
+        char mode[8];
+        size_t length = 0;
+        napi_get_value_string_utf8(env, value, mode, sizeof(mode), &length);
+        if (strcmp(mode, "only") == 0) {
+            *out = ACCESS_SERIALIZE_ONLY;
+            return 0;
+        }
+    }
+    napi_throw_type_error(env, NULL, "options.serialize must be a boolean or 'only'");
+    return -1;
+}
+
 /* ========== requestAccessWithPassphrase ========== */
 
 napi_value request_access_with_passphrase(napi_env env, napi_callback_info info) {
-    size_t argc = 3;
-    napi_value argv[3];
+    size_t argc = 4;
+    napi_value argv[4] = { NULL, NULL, NULL, NULL };
     
     napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
     
@@ -87,6 +141,11 @@ napi_value request_access_with_passphrase(napi_env env, napi_callback_info info)
         return NULL;
     }
     
+    AccessSerializeMode serialize_mode;
+    if (extract_serialize_mode(env, argv[3], &serialize_mode) != 0) {
+        return NULL;
+    }
+    
     char* satellite = NULL;
     char* api_key = NULL;
     char* passphrase = NULL;
@@ -118,6 +177,7 @@ napi_value request_access_with_passphrase(napi_env env, napi_callback_info info)
     work_data->satellite_address = satellite;
     work_data->api_key = api_key;
     work_data->passphrase = passphrase;
+    work_data->serialize_mode = serialize_mode;
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
@@ -142,8 +202,8 @@ napi_value request_access_with_passphrase(napi_env env, napi_callback_info info)
 /* ========== configRequestAccessWithPassphrase ========== */
 
 napi_value config_request_access_with_passphrase(napi_env env, napi_callback_info info) {
-    size_t argc = 4;
-    napi_value argv[4];
+    size_t argc = 5;
+    napi_value argv[5] = { NULL, NULL, NULL, NULL, NULL };
     
     napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
     
@@ -152,6 +212,11 @@ napi_value config_request_access_with_passphrase(napi_env env, napi_callback_inf
         return NULL;
     }
     
+    AccessSerializeMode serialize_mode;
+    if (extract_serialize_mode(env, argv[4], &serialize_mode) != 0) {
+        return NULL;
+    }
+    
     /* Extract config object */
     napi_valuetype config_type;
     napi_typeof(env, argv[0], &config_type);
@@ -165,6 +230,7 @@ napi_value config_request_access_with_passphrase(napi_env env, napi_callback_inf
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
     }
+    work_data->serialize_mode = serialize_mode;
     
     /* Extract config properties */
     napi_value user_agent_val, dial_timeout_val, temp_dir_val;
@@ -306,6 +372,53 @@ napi_value access_serialize(napi_env env, napi_callback_info info) {
     return promise;
 }
 
+/* ========== accessSatelliteAddressSync / accessSerializeSync ========== */
+
+/**
+ * Run a string-returning access call inline. Neither call does network
+ * I/O, so a promise and a pool round trip would cost more than the call.
+ */
+static napi_value access_string_sync(napi_env env, napi_callback_info info, const char* name,
+                                     UplinkStringResult (*fn)(UplinkAccess*)) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "access handle is required");
+        return NULL;
+    }
+    
+    size_t access_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_ACCESS, &access_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid access handle");
+        return NULL;
+    }
+    
+    UplinkAccess access = { ._handle = access_handle };
+    UplinkStringResult result = fn(&access);
+    if (result.error != NULL) {
+        LOG_ERROR("%s: failed - %s", name, result.error->message);
+        napi_value error = create_typed_error(env, result.error->code, result.error->message);
+        uplink_free_error(result.error);
+        napi_throw(env, error);
+        return NULL;
+    }
+    
+    napi_value result_string = create_string(env, result.string);
+    uplink_free_string_result(result);
+    return result_string;
+}
+
+napi_value access_satellite_address_sync(napi_env env, napi_callback_info info) {
+    return access_string_sync(env, info, "accessSatelliteAddressSync", uplink_access_satellite_address);
+}
+
+napi_value access_serialize_sync(napi_env env, napi_callback_info info) {
+    return access_string_sync(env, info, "accessSerializeSync", uplink_access_serialize);
+}
+
 /* ========== helpers for accessShare ========== */
 
 /**
@@ -382,7 +495,7 @@ static const char* extract_permission(napi_env env, napi_value js_perm,
         const PermFieldDescriptor* f = &perm_fields[i];
         char* base = (char*)perm;
         int rc;
-
+    
         if (f->type == PERM_BOOL) {
             rc = validate_bool_property(env, js_perm, f->js_name,
                                         (bool*)(base + f->offset));
@@ -390,76 +503,85 @@ static const char* extract_permission(napi_env env, napi_value js_perm,
             rc = validate_int64_property(env, js_perm, f->js_name,
                                          (int64_t*)(base + f->offset));
         }
-
+    
         if (rc != 0) return f->error_msg;
     }
     return NULL;
 }
 
 /**
- * Extract share-prefix array from JS into the AccessShareData.
+ * Free the strings and array of extracted share prefixes.
+ */
+static void free_share_prefixes(UplinkSharePrefix* prefixes, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        free((char*)prefixes[i].bucket);
+        free((char*)prefixes[i].prefix);
+    }
+    free(prefixes);
+}
+
+/**
+ * Extract a share-prefix array from JS.
  * Strings are malloc'd copies stored directly in prefixes[].bucket/.prefix.
- * @return  0 on success, -1 if argv is not an array.
+ * @return  0 on success, -1 if argv is not an array of objects or on OOM.
  */
 static int extract_share_prefixes(napi_env env, napi_value js_array,
-                                  AccessShareData* work_data) {
+                                  UplinkSharePrefix** out_prefixes, size_t* out_count) {
+    *out_prefixes = NULL;
+    *out_count = 0;
+    
     bool is_array;
     napi_is_array(env, js_array, &is_array);
     if (!is_array) return -1;
-
+    
     uint32_t prefix_count;
     napi_get_array_length(env, js_array, &prefix_count);
-    work_data->prefix_count = prefix_count;
-
+    
     if (prefix_count == 0) return 0;
-
-    work_data->prefixes = (UplinkSharePrefix*)calloc(prefix_count, sizeof(UplinkSharePrefix));
-    if (work_data->prefixes == NULL) {
+    
+    UplinkSharePrefix* prefixes = (UplinkSharePrefix*)calloc(prefix_count, sizeof(UplinkSharePrefix));
+    if (prefixes == NULL) {
         LOG_ERROR("extract_share_prefixes: calloc failed for %u prefixes", prefix_count);
         return -1;
     }
-
+    
     for (uint32_t i = 0; i < prefix_count; i++) {
         napi_value prefix_obj;
         napi_get_element(env, js_array, i, &prefix_obj);
-
+    
         /* Each element must be an object */
         napi_valuetype elem_type;
         napi_typeof(env, prefix_obj, &elem_type);
         if (elem_type != napi_object) {
             LOG_ERROR("extract_share_prefixes: element %u is not an object", i);
             /* Free already-extracted strings before returning */
-            for (uint32_t j = 0; j < i; j++) {
-                free((char*)work_data->prefixes[j].bucket);
-                free((char*)work_data->prefixes[j].prefix);
-            }
-            free(work_data->prefixes);
-            work_data->prefixes = NULL;
-            work_data->prefix_count = 0;
+            free_share_prefixes(prefixes, i);
             return -1;
         }
-
+    
         napi_value bucket_val, prefix_val;
         napi_get_named_property(env, prefix_obj, "bucket", &bucket_val);
         napi_get_named_property(env, prefix_obj, "prefix", &prefix_val);
-
+    
         char* bucket_str = NULL;
         char* prefix_str = NULL;
         extract_string_required(env, bucket_val, "bucket", &bucket_str);
         extract_string_optional(env, prefix_val, &prefix_str);
-
-        work_data->prefixes[i].bucket = bucket_str;
-        work_data->prefixes[i].prefix = prefix_str;
+    
+        prefixes[i].bucket = bucket_str;
+        prefixes[i].prefix = prefix_str;
     }
-
+    
+    *out_prefixes = prefixes;
+    *out_count = prefix_count;
     return 0;
 }
 
 /* ========== accessShare ========== */
 
 napi_value access_share(napi_env env, napi_callback_info info) {
-    size_t argc = 3;
-    napi_value argv[3];
+    size_t argc = 4;
+    napi_value argv[4] = { NULL, NULL, NULL, NULL };
     
     napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
     
@@ -468,6 +590,11 @@ napi_value access_share(napi_env env, napi_callback_info info) {
         return NULL;
     }
     
+    AccessSerializeMode serialize_mode;
+    if (extract_serialize_mode(env, argv[3], &serialize_mode) != 0) {
+        return NULL;
+    }
+    
     /* Extract access handle */
     size_t access_handle;
     if (extract_handle(env, argv[0], HANDLE_TYPE_ACCESS, &access_handle) != napi_ok) {
@@ -490,6 +617,7 @@ napi_value access_share(napi_env env, napi_callback_info info) {
     }
     
     work_data->access_handle = access_handle;
+    work_data->serialize_mode = serialize_mode;
     
     /* Extract permission via helper */
     const char* perm_error = extract_permission(env, argv[1], &work_data->permission);
@@ -500,7 +628,7 @@ napi_value access_share(napi_env env, napi_callback_info info) {
     }
     
     /* Extract prefixes via helper */
-    if (extract_share_prefixes(env, argv[2], work_data) != 0) {
+    if (extract_share_prefixes(env, argv[2], &work_data->prefixes, &work_data->prefix_count) != 0) {
         free(work_data);
         napi_throw_type_error(env, NULL, "prefixes must be an array");
         return NULL;
@@ -525,6 +653,109 @@ napi_value access_share(napi_env env, napi_callback_info info) {
     return promise;
 }
 
+/* ========== accessShareMany ========== */
+
+napi_value access_share_many(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3] = { NULL, NULL, NULL };
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "access and specs are required");
+        return NULL;
+    }
+    
+    size_t access_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_ACCESS, &access_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid access handle");
+        return NULL;
+    }
+    
+    bool is_array = false;
+    napi_is_array(env, argv[1], &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "specs must be an array of { permission, prefixes }");
+        return NULL;
+    }
+    
+    int64_t concurrency = ACCESS_SHARE_MANY_DEFAULT_CONCURRENCY;
+    if (argc >= 3) {
+        napi_valuetype type;
+        napi_typeof(env, argv[2], &type);
+        if (type == napi_object) {
+            concurrency = get_int64_property(env, argv[2], "concurrency", ACCESS_SHARE_MANY_DEFAULT_CONCURRENCY);
+        }
+    }
+    if (concurrency < 1) {
+        napi_throw_type_error(env, NULL, "concurrency must be a positive integer");
+        return NULL;
+    }
+    
+    uint32_t count = 0;
+    napi_get_array_length(env, argv[1], &count);
+    
+    AccessShareManyData* work_data = (AccessShareManyData*)calloc(1, sizeof(AccessShareManyData));
+    AccessShareSpec* specs = (AccessShareSpec*)calloc(count > 0 ? count : 1, sizeof(AccessShareSpec));
+    if (work_data == NULL || specs == NULL) {
+        free(work_data);
+        free(specs);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    /* Every spec is marshalled here, so the workers never touch JS values */
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value element, js_permission, js_prefixes;
+        napi_valuetype type = napi_undefined;
+        napi_get_element(env, argv[1], i, &element);
+        napi_typeof(env, element, &type);
+        if (type != napi_object) {
+            access_share_many_free_specs(specs, i);
+            free(work_data);
+            napi_throw_type_error(env, NULL, "specs must be an array of { permission, prefixes }");
+            return NULL;
+        }
+        napi_get_named_property(env, element, "permission", &js_permission);
+        napi_get_named_property(env, element, "prefixes", &js_prefixes);
+        
+        napi_typeof(env, js_permission, &type);
+        const char* perm_error = type == napi_object
+            ? extract_permission(env, js_permission, &specs[i].permission)
+            : "permission must be an object";
+        if (perm_error != NULL) {
+            access_share_many_free_specs(specs, i);
+            free(work_data);
+            napi_throw_type_error(env, NULL, perm_error);
+            return NULL;
+        }
+        if (extract_share_prefixes(env, js_prefixes, &specs[i].prefixes, &specs[i].prefix_count) != 0) {
+            access_share_many_free_specs(specs, i);
+            free(work_data);
+            napi_throw_type_error(env, NULL, "prefixes must be an array");
+            return NULL;
+        }
+    }
+    
+    work_data->access_handle = access_handle;
+    work_data->specs = specs;
+    work_data->spec_count = count;
+    work_data->concurrency = concurrency > ACCESS_SHARE_MANY_MAX_CONCURRENCY
+        ? ACCESS_SHARE_MANY_MAX_CONCURRENCY : (uint32_t)concurrency;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    LOG_DEBUG("accessShareMany: %u specs, concurrency=%u", count, work_data->concurrency);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "accessShareMany", NAPI_AUTO_LENGTH, &work_name);
+    thread_pool_queue_work(env, THREAD_POOL_LANE_BULK, work_name,
+        access_share_many_execute, access_share_many_complete,
+        work_data, &work_data->work);
+    return promise;
+}
+
 /* ========== accessOverrideEncryptionKey ========== */
 
 napi_value access_override_encryption_key(napi_env env, napi_callback_info info) {
@@ -544,6 +775,13 @@ napi_value access_override_encryption_key(napi_env env, napi_callback_info info)
         return NULL;
     }
     
+    /* Overriding mutates the access, which cached handles share */
+    if (access_cache_is_shared(get_handle_wrapper(env, argv[0], HANDLE_TYPE_ACCESS))) {
+        napi_throw_error(env, NULL,
+            "Access is shared through the parseAccess cache; parse it with the cache disabled to override encryption keys");
+        return NULL;
+    }
+    
     size_t encryption_key_handle;
     if (extract_handle(env, argv[3], HANDLE_TYPE_ENCRYPTION_KEY, &encryption_key_handle) != napi_ok) {
         napi_throw_type_error(env, NULL, "Invalid encryption key handle");
@@ -586,3 +824,72 @@ napi_value access_override_encryption_key(napi_env env, napi_callback_info info)
     
     return promise;
 }
+
+/* ========== enableAccessCache ========== */
+
+napi_value enable_access_cache(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    int64_t max_entries = ACCESS_CACHE_DEFAULT_MAX_ENTRIES;
+    if (argc >= 1) {
+        napi_valuetype type;
+        napi_typeof(env, argv[0], &type);
+        if (type == napi_object) {
+            max_entries = get_int64_property(env, argv[0], "maxEntries", ACCESS_CACHE_DEFAULT_MAX_ENTRIES);
+        }
+    }
+    if (max_entries <= 0) {
+        napi_throw_type_error(env, NULL, "maxEntries must be a positive number");
+        return NULL;
+    }
+    
+    if (access_cache_enable(env, (size_t)max_entries) != 0) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== disableAccessCache ========== */
+
+napi_value disable_access_cache(napi_env env, napi_callback_info info) {
+    (void)info;
+    access_cache_disable(env);
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== accessCacheStats ========== */
+
+napi_value get_access_cache_stats(napi_env env, napi_callback_info info) {
+    (void)info;
+    
+    AccessCacheStats stats;
+    if (access_cache_stats(env, &stats) != 0) {
+        napi_value null_value;
+        napi_get_null(env, &null_value);
+        return null_value;
+    }
+    
+    napi_value result, value;
+    napi_create_object(env, &result);
+    napi_create_double(env, (double)stats.hits, &value);
+    napi_set_named_property(env, result, "hits", value);
+    napi_create_double(env, (double)stats.misses, &value);
+    napi_set_named_property(env, result, "misses", value);
+    napi_create_double(env, (double)stats.evictions, &value);
+    napi_set_named_property(env, result, "evictions", value);
+    napi_create_double(env, (double)stats.entries, &value);
+    napi_set_named_property(env, result, "entries", value);
+    napi_create_double(env, (double)stats.max_entries, &value);
+    napi_set_named_property(env, result, "maxEntries", value);
+    return result;
+}
@@ -18,13 +18,15 @@ napi_value parse_access(napi_env env, napi_callback_info info);
 
 /**
  * Request access with passphrase
- * JS: requestAccessWithPassphrase(satellite, apiKey, passphrase) -> Promise<AccessHandle>
+ * JS: requestAccessWithPassphrase(satellite, apiKey, passphrase, options?: { serialize }) -> Promise<AccessHandle>
+ *     (serialize: true -> { access, serialized }; 'only' -> serialized string, no handle)
  */
 napi_value request_access_with_passphrase(napi_env env, napi_callback_info info);
 
 /**
  * Request access with passphrase and config
- * JS: configRequestAccessWithPassphrase(config, satellite, apiKey, passphrase) -> Promise<AccessHandle>
+ * JS: configRequestAccessWithPassphrase(config, satellite, apiKey, passphrase, options?: { serialize })
+ *     -> Promise<AccessHandle> (serialize as for requestAccessWithPassphrase)
  */
 napi_value config_request_access_with_passphrase(napi_env env, napi_callback_info info);
 
@@ -40,16 +42,59 @@ napi_value access_satellite_address(napi_env env, napi_callback_info info);
  */
 napi_value access_serialize(napi_env env, napi_callback_info info);
 
+/**
+ * Get satellite address from access, inline on the main thread
+ * JS: accessSatelliteAddressSync(access: AccessHandle) -> string
+ * Throws the same typed errors accessSatelliteAddress rejects with.
+ */
+napi_value access_satellite_address_sync(napi_env env, napi_callback_info info);
+
+/**
+ * Serialize access to string, inline on the main thread
+ * JS: accessSerializeSync(access: AccessHandle) -> string
+ * Throws the same typed errors accessSerialize rejects with.
+ */
+napi_value access_serialize_sync(napi_env env, napi_callback_info info);
+
 /**
  * Share access with restrictions
- * JS: accessShare(access, permission, prefixes) -> Promise<AccessHandle>
+ * JS: accessShare(access, permission, prefixes, options?: { serialize }) -> Promise<AccessHandle>
+ *     (serialize as for requestAccessWithPassphrase)
  */
 napi_value access_share(napi_env env, napi_callback_info info);
 
+/**
+ * Derive and serialize many restricted grants of one access
+ * JS: accessShareMany(access, specs: { permission, prefixes }[], options?: { concurrency })
+ *     -> Promise<string[]>
+ */
+napi_value access_share_many(napi_env env, napi_callback_info info);
+
 /**
  * Override encryption key for a bucket/prefix
  * JS: accessOverrideEncryptionKey(access, bucket, prefix, encryptionKey) -> Promise<void>
  */
 napi_value access_override_encryption_key(napi_env env, napi_callback_info info);
 
+/**
+ * Enable (or reconfigure) the parseAccess cache of this environment (synchronous)
+ * JS: enableAccessCache(options?: { maxEntries?: number }) -> void
+ *
+ * While enabled, parseAccess of a grant seen before resolves with a handle
+ * sharing the parsed access. Shared handles cannot override encryption keys.
+ */
+napi_value enable_access_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Disable the parseAccess cache; handles already handed out keep working (synchronous)
+ * JS: disableAccessCache() -> void
+ */
+napi_value disable_access_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Read the parseAccess cache counters (synchronous)
+ * JS: accessCacheStats() -> { hits, misses, evictions, entries, maxEntries } | null
+ */
+napi_value get_access_cache_stats(napi_env env, napi_callback_info info);
+
 #endif /* UPLINK_ACCESS_OPS_H */
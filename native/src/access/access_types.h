@@ -18,6 +18,21 @@
 #define UPLINK_DISABLE_NAMESPACE_COMPAT
 #include "uplink.h"
 
+/** Default number of grants accessShareMany derives at once */
+#define ACCESS_SHARE_MANY_DEFAULT_CONCURRENCY 4
+
+/** Upper bound accepted for accessShareMany concurrency */
+#define ACCESS_SHARE_MANY_MAX_CONCURRENCY 16
+
+/**
+ * What a request or share resolves to
+ */
+typedef enum {
+    ACCESS_SERIALIZE_NONE = 0,      /* the access handle */
+    ACCESS_SERIALIZE_WITH_HANDLE,   /* { access, serialized } */
+    ACCESS_SERIALIZE_ONLY           /* the serialized grant; no handle is created */
+} AccessSerializeMode;
+
 /* ========== Async Work Data Structures ========== */
 
 /**
@@ -38,6 +53,8 @@ typedef struct {
     char* api_key;
     char* passphrase;
     UplinkAccessResult result;
+    AccessSerializeMode serialize_mode;
+    UplinkStringResult serialized;  /* set in the execute function unless mode is NONE */
     napi_deferred deferred;
     napi_async_work work;
 } RequestAccessData;
@@ -53,6 +70,8 @@ typedef struct {
     int32_t dial_timeout_milliseconds;
     char* temp_directory;
     UplinkAccessResult result;
+    AccessSerializeMode serialize_mode;
+    UplinkStringResult serialized;  /* set in the execute function unless mode is NONE */
     napi_deferred deferred;
     napi_async_work work;
 } ConfigRequestAccessData;
@@ -76,10 +95,34 @@ typedef struct {
     UplinkSharePrefix* prefixes;
     size_t prefix_count;
     UplinkAccessResult result;
+    AccessSerializeMode serialize_mode;
+    UplinkStringResult serialized;  /* set in the execute function unless mode is NONE */
     napi_deferred deferred;
     napi_async_work work;
 } AccessShareData;
 
+/**
+ * @brief One permission/prefix set of an accessShareMany call
+ */
+typedef struct {
+    UplinkPermission permission;
+    UplinkSharePrefix* prefixes;
+    size_t prefix_count;
+    UplinkStringResult result;      /* serialized restricted grant */
+} AccessShareSpec;
+
+/**
+ * @brief Data for accessShareMany async operation
+ */
+typedef struct {
+    size_t access_handle;
+    AccessShareSpec* specs;
+    size_t spec_count;
+    uint32_t concurrency;
+    napi_deferred deferred;
+    napi_async_work work;
+} AccessShareManyData;
+
 /**
  * @brief Data for accessOverrideEncryptionKey async operation
  */
@@ -3,13 +3,21 @@
  * @brief Native module entry point for uplink-nodejs
  * 
  * Initializes the Node.js native addon and exports functions.
+ *
+ * Init runs once per environment, so the module is safe to load from
+ * several worker_threads; state tied to one environment lives in its
+ * AddonInstance (common/addon_instance.h).
  */
 
 #include <node_api.h>
 #include <stdio.h>
 #include "common/logger.h"
-#include "common/library_loader.h"
+#include "common/addon_instance.h"
 #include "common/error_registry.h"
+#include "common/thread_pool.h"
+#include "common/cancel_token.h"
+#include "common/bandwidth.h"
+#include "common/hedge.h"
 
 /* Include operation modules */
 #include "access/access_ops.h"
@@ -20,6 +28,8 @@
 #include "download/download_ops.h"
 #include "encryption/encryption_ops.h"
 #include "multipart/multipart_ops.h"
+#include "directory/directory_ops.h"
+#include "archive/archive_ops.h"
 #include "edge/edge_ops.h"
 #include "debug/debug_ops.h"
 
@@ -38,11 +48,10 @@ static napi_value Init(napi_env env, napi_value exports) {
     logger_init();
     LOG_INFO("Initializing uplink-nodejs native module");
     
-    /* Load the uplink-c library */
-    if (load_uplink_library() != 0) {
-        LOG_WARN("uplink library not found - module will work in stub mode");
-        /* Don't throw error here - allow module to load for testing */
-        /* The actual functions will throw if library is not loaded */
+    /* Per-environment state; also takes this env's uplink-c library reference */
+    if (addon_instance_init(env) != 0) {
+        napi_throw_error(env, NULL, "Failed to initialize uplink-nodejs native module");
+        return NULL;
     }
     
     /* Register access operations */
@@ -52,8 +61,14 @@ static napi_value Init(napi_env env, napi_value exports) {
         DECLARE_NAPI_METHOD("configRequestAccessWithPassphrase", config_request_access_with_passphrase),
         DECLARE_NAPI_METHOD("accessSatelliteAddress", access_satellite_address),
         DECLARE_NAPI_METHOD("accessSerialize", access_serialize),
+        DECLARE_NAPI_METHOD("accessSatelliteAddressSync", access_satellite_address_sync),
+        DECLARE_NAPI_METHOD("accessSerializeSync", access_serialize_sync),
         DECLARE_NAPI_METHOD("accessShare", access_share),
+        DECLARE_NAPI_METHOD("accessShareMany", access_share_many),
         DECLARE_NAPI_METHOD("accessOverrideEncryptionKey", access_override_encryption_key),
+        DECLARE_NAPI_METHOD("enableAccessCache", enable_access_cache),
+        DECLARE_NAPI_METHOD("disableAccessCache", disable_access_cache),
+        DECLARE_NAPI_METHOD("accessCacheStats", get_access_cache_stats),
     };
     
     napi_define_properties(env, exports, 
@@ -66,6 +81,16 @@ static napi_value Init(napi_env env, napi_value exports) {
         DECLARE_NAPI_METHOD("configOpenProject", config_open_project),
         DECLARE_NAPI_METHOD("closeProject", close_project),
         DECLARE_NAPI_METHOD("revokeAccess", revoke_access),
+        DECLARE_NAPI_METHOD("projectEnableStatCache", project_enable_stat_cache),
+        DECLARE_NAPI_METHOD("projectDisableStatCache", project_disable_stat_cache),
+        DECLARE_NAPI_METHOD("projectStatCacheStats", project_stat_cache_stats),
+        DECLARE_NAPI_METHOD("projectEnableObjectCache", project_enable_object_cache),
+        DECLARE_NAPI_METHOD("projectDisableObjectCache", project_disable_object_cache),
+        DECLARE_NAPI_METHOD("projectObjectCacheStats", project_object_cache_stats),
+        DECLARE_NAPI_METHOD("projectEnableKnownBuckets", project_enable_known_buckets),
+        DECLARE_NAPI_METHOD("projectDisableKnownBuckets", project_disable_known_buckets),
+        DECLARE_NAPI_METHOD("projectKnownBucketsStats", project_known_buckets_stats),
+        DECLARE_NAPI_METHOD("projectAdmissionStats", project_admission_stats),
     };
     
     napi_define_properties(env, exports,
@@ -83,6 +108,8 @@ static napi_value Init(napi_env env, napi_value exports) {
         DECLARE_NAPI_METHOD("bucketIteratorNext", bucket_iterator_next),
         DECLARE_NAPI_METHOD("bucketIteratorItem", bucket_iterator_item),
         DECLARE_NAPI_METHOD("bucketIteratorErr", bucket_iterator_err),
+        DECLARE_NAPI_METHOD("bucketIteratorNextBatch", bucket_iterator_next_batch),
+        DECLARE_NAPI_METHOD("collectBuckets", collect_buckets),
         DECLARE_NAPI_METHOD("freeBucketIterator", free_bucket_iterator),
     };
     
@@ -93,15 +120,25 @@ static napi_value Init(napi_env env, napi_value exports) {
     /* Register object operations */
     napi_property_descriptor object_methods[] = {
         DECLARE_NAPI_METHOD("statObject", stat_object),
+        DECLARE_NAPI_METHOD("statObjects", stat_objects),
         DECLARE_NAPI_METHOD("deleteObject", delete_object),
+        DECLARE_NAPI_METHOD("deleteObjects", delete_objects),
+        DECLARE_NAPI_METHOD("deletePrefix", delete_prefix),
+        DECLARE_NAPI_METHOD("exportListing", export_listing),
         DECLARE_NAPI_METHOD("listObjectsCreate", list_objects_create),
         DECLARE_NAPI_METHOD("objectIteratorNext", object_iterator_next),
+        DECLARE_NAPI_METHOD("objectIteratorNextBatch", object_iterator_next_batch),
+        DECLARE_NAPI_METHOD("objectIteratorNextColumns", object_iterator_next_columns),
         DECLARE_NAPI_METHOD("objectIteratorItem", object_iterator_item),
         DECLARE_NAPI_METHOD("objectIteratorErr", object_iterator_err),
+        DECLARE_NAPI_METHOD("objectIteratorCheckpoint", object_iterator_checkpoint),
         DECLARE_NAPI_METHOD("freeObjectIterator", free_object_iterator),
         DECLARE_NAPI_METHOD("copyObject", copy_object),
         DECLARE_NAPI_METHOD("moveObject", move_object),
+        DECLARE_NAPI_METHOD("copyObjects", copy_objects),
+        DECLARE_NAPI_METHOD("moveObjects", move_objects),
         DECLARE_NAPI_METHOD("updateObjectMetadata", update_object_metadata),
+        DECLARE_NAPI_METHOD("updateObjectsMetadata", update_objects_metadata),
     };
     
     napi_define_properties(env, exports,
@@ -112,10 +149,16 @@ static napi_value Init(napi_env env, napi_value exports) {
     napi_property_descriptor upload_methods[] = {
         DECLARE_NAPI_METHOD("uploadObject", upload_object),
         DECLARE_NAPI_METHOD("uploadWrite", upload_write),
+        DECLARE_NAPI_METHOD("uploadWritev", upload_writev),
+        DECLARE_NAPI_METHOD("uploadWritevCb", upload_writev_cb),
         DECLARE_NAPI_METHOD("uploadCommit", upload_commit),
         DECLARE_NAPI_METHOD("uploadAbort", upload_abort),
         DECLARE_NAPI_METHOD("uploadSetCustomMetadata", upload_set_custom_metadata),
         DECLARE_NAPI_METHOD("uploadInfo", upload_info),
+        DECLARE_NAPI_METHOD("uploadFile", upload_file),
+        DECLARE_NAPI_METHOD("putObject", put_object),
+        DECLARE_NAPI_METHOD("putObjectDedup", put_object_dedup),
+        DECLARE_NAPI_METHOD("uploadReplicated", upload_replicated),
     };
     
     napi_define_properties(env, exports,
@@ -126,8 +169,23 @@ static napi_value Init(napi_env env, napi_value exports) {
     napi_property_descriptor download_methods[] = {
         DECLARE_NAPI_METHOD("downloadObject", download_object),
         DECLARE_NAPI_METHOD("downloadRead", download_read),
+        DECLARE_NAPI_METHOD("downloadReadFull", download_read_full),
+        DECLARE_NAPI_METHOD("downloadReadInto", download_read_into),
+        DECLARE_NAPI_METHOD("downloadReadCb", download_read_cb),
+        DECLARE_NAPI_METHOD("downloadToFile", download_to_file),
+        DECLARE_NAPI_METHOD("downloadParallel", download_parallel),
+        DECLARE_NAPI_METHOD("downloadRanges", download_ranges),
+        DECLARE_NAPI_METHOD("getObject", get_object),
+        DECLARE_NAPI_METHOD("allocReadBuffer", alloc_read_buffer),
         DECLARE_NAPI_METHOD("downloadInfo", download_info),
         DECLARE_NAPI_METHOD("closeDownload", close_download),
+        DECLARE_NAPI_METHOD("downloadTeeResults", download_tee_results),
+        DECLARE_NAPI_METHOD("enableChunkCache", enable_chunk_cache),
+        DECLARE_NAPI_METHOD("disableChunkCache", disable_chunk_cache),
+        DECLARE_NAPI_METHOD("chunkCacheStats", get_chunk_cache_stats),
+        DECLARE_NAPI_METHOD("enableReadAhead", enable_read_ahead),
+        DECLARE_NAPI_METHOD("disableReadAhead", disable_read_ahead),
+        DECLARE_NAPI_METHOD("readAheadStats", get_read_ahead_stats),
     };
     
     napi_define_properties(env, exports,
@@ -137,6 +195,10 @@ static napi_value Init(napi_env env, napi_value exports) {
     /* Register encryption operations */
     napi_property_descriptor encryption_methods[] = {
         DECLARE_NAPI_METHOD("deriveEncryptionKey", derive_encryption_key),
+        DECLARE_NAPI_METHOD("deriveEncryptionKeys", derive_encryption_keys),
+        DECLARE_NAPI_METHOD("enableEncryptionKeyCache", enable_encryption_key_cache),
+        DECLARE_NAPI_METHOD("disableEncryptionKeyCache", disable_encryption_key_cache),
+        DECLARE_NAPI_METHOD("encryptionKeyCacheStats", get_encryption_key_cache_stats),
     };
     
     napi_define_properties(env, exports,
@@ -164,43 +226,100 @@ static napi_value Init(napi_env env, napi_value exports) {
         DECLARE_NAPI_METHOD("uploadIteratorItem", upload_iterator_item),
         DECLARE_NAPI_METHOD("uploadIteratorErr", upload_iterator_err),
         DECLARE_NAPI_METHOD("freeUploadIterator", free_upload_iterator),
+        DECLARE_NAPI_METHOD("collectUploadParts", collect_upload_parts),
+        DECLARE_NAPI_METHOD("collectUploads", collect_uploads),
+        DECLARE_NAPI_METHOD("uploadParallel", upload_parallel),
+        DECLARE_NAPI_METHOD("uploadPartFromFile", upload_part_from_file),
+        DECLARE_NAPI_METHOD("resumeUpload", resume_upload),
     };
     
     napi_define_properties(env, exports,
         sizeof(multipart_methods) / sizeof(multipart_methods[0]),
         multipart_methods);
     
+    /* Register directory operations */
+    napi_property_descriptor directory_methods[] = {
+        DECLARE_NAPI_METHOD("uploadDirectory", upload_directory),
+        DECLARE_NAPI_METHOD("diffDirectory", diff_directory),
+    };
+    
+    napi_define_properties(env, exports,
+        sizeof(directory_methods) / sizeof(directory_methods[0]),
+        directory_methods);
+    
+    /* Register archive operations */
+    napi_property_descriptor archive_methods[] = {
+        DECLARE_NAPI_METHOD("archiveOpen", archive_open),
+        DECLARE_NAPI_METHOD("archiveRead", archive_read),
+        DECLARE_NAPI_METHOD("archiveClose", archive_close),
+    };
+    
+    napi_define_properties(env, exports,
+        sizeof(archive_methods) / sizeof(archive_methods[0]),
+        archive_methods);
+    
     /* Register edge operations */
     napi_property_descriptor edge_methods[] = {
         DECLARE_NAPI_METHOD("edgeRegisterAccess", napi_edge_register_access),
         DECLARE_NAPI_METHOD("edgeJoinShareUrl", napi_edge_join_share_url),
+        DECLARE_NAPI_METHOD("edgeJoinShareUrlSync", napi_edge_join_share_url_sync),
+        DECLARE_NAPI_METHOD("edgeJoinShareUrls", napi_edge_join_share_urls),
+        DECLARE_NAPI_METHOD("enableEdgeCache", napi_enable_edge_cache),
+        DECLARE_NAPI_METHOD("disableEdgeCache", napi_disable_edge_cache),
+        DECLARE_NAPI_METHOD("edgeCacheStats", napi_edge_cache_stats),
     };
-
+    
     napi_define_properties(env, exports,
         sizeof(edge_methods) / sizeof(edge_methods[0]),
         edge_methods);
-
+    
     /* Register debug operations */
     napi_property_descriptor debug_methods[] = {
         DECLARE_NAPI_METHOD("internalUniverseIsEmpty", internal_universe_is_empty),
         DECLARE_NAPI_METHOD("testThrowTypedError", test_throw_typed_error),
+        DECLARE_NAPI_METHOD("handleStats", napi_handle_stats),
+        DECLARE_NAPI_METHOD("workPoolStats", napi_work_pool_stats),
+        DECLARE_NAPI_METHOD("nativeAllocStats", napi_native_alloc_stats),
     };
-
+    
     napi_define_properties(env, exports,
         sizeof(debug_methods) / sizeof(debug_methods[0]),
         debug_methods);
-
+    
     /* Register error registry operations */
     napi_property_descriptor error_methods[] = {
         DECLARE_NAPI_METHOD("initErrorClasses", napi_init_error_classes),
+        DECLARE_NAPI_METHOD("setStacklessErrors", napi_set_stackless_errors),
     };
-
+    
     napi_define_properties(env, exports,
         sizeof(error_methods) / sizeof(error_methods[0]),
         error_methods);
-
+    
+    /* Register thread pool operations */
+    napi_property_descriptor thread_pool_methods[] = {
+        DECLARE_NAPI_METHOD("configureThreadPool", napi_configure_thread_pool),
+        DECLARE_NAPI_METHOD("configureBandwidth", napi_configure_bandwidth),
+        DECLARE_NAPI_METHOD("getMetrics", napi_get_metrics),
+        DECLARE_NAPI_METHOD("hedgeStats", napi_hedge_stats),
+    };
+    
+    napi_define_properties(env, exports,
+        sizeof(thread_pool_methods) / sizeof(thread_pool_methods[0]),
+        thread_pool_methods);
+    
+    /* Register cancellation operations */
+    napi_property_descriptor cancel_methods[] = {
+        DECLARE_NAPI_METHOD("createCancelToken", napi_create_cancel_token),
+        DECLARE_NAPI_METHOD("cancelToken", napi_cancel_token),
+    };
+    
+    napi_define_properties(env, exports,
+        sizeof(cancel_methods) / sizeof(cancel_methods[0]),
+        cancel_methods);
+    
     LOG_INFO("uplink-nodejs native module initialized successfully");
-    LOG_INFO("Registered %d access, %d project, %d bucket, %d object, %d upload, %d download, %d encryption, %d multipart, %d edge, %d debug, %d error methods",
+    LOG_INFO("Registered %d access, %d project, %d bucket, %d object, %d upload, %d download, %d encryption, %d multipart, %d directory, %d archive, %d edge, %d debug, %d error, %d thread pool, %d cancel methods",
         (int)(sizeof(access_methods) / sizeof(access_methods[0])),
         (int)(sizeof(project_methods) / sizeof(project_methods[0])),
         (int)(sizeof(bucket_methods) / sizeof(bucket_methods[0])),
@@ -209,9 +328,13 @@ static napi_value Init(napi_env env, napi_value exports) {
         (int)(sizeof(download_methods) / sizeof(download_methods[0])),
         (int)(sizeof(encryption_methods) / sizeof(encryption_methods[0])),
         (int)(sizeof(multipart_methods) / sizeof(multipart_methods[0])),
+        (int)(sizeof(directory_methods) / sizeof(directory_methods[0])),
+        (int)(sizeof(archive_methods) / sizeof(archive_methods[0])),
         (int)(sizeof(edge_methods) / sizeof(edge_methods[0])),
         (int)(sizeof(debug_methods) / sizeof(debug_methods[0])),
-        (int)(sizeof(error_methods) / sizeof(error_methods[0])));
+        (int)(sizeof(error_methods) / sizeof(error_methods[0])),
+        (int)(sizeof(thread_pool_methods) / sizeof(thread_pool_methods[0])),
+        (int)(sizeof(cancel_methods) / sizeof(cancel_methods[0])));
     
     return exports;
 }
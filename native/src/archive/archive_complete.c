@@ -0,0 +1,348 @@
+/**
+ * @file archive_complete.c
+ * @brief Complete functions and scheduling for archive streams
+ *
+ * These functions run on the main thread. Every completion ends in
+ * archive_settle(), which either schedules more work or, once the stream
+ * is closed and no job is in flight, frees the state.
+ */
+
+#include "archive_complete.h"
+#include "archive_execute.h"
+#include "../common/handle_helpers.h"
+#include "../common/handle_reaper.h"
+#include "../common/string_helpers.h"
+#include "../common/buffer_helpers.h"
+#include "../common/thread_pool.h"
+#include "../common/result_helpers.h"
+#include "../common/error_registry.h"
+#include "../common/op_metrics.h"
+#include "../common/logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ========== state ========== */
+
+static bool archive_idle(const ArchiveState* state) {
+    return state->fetches == 0 && !state->listing && state->reading == NULL;
+}
+
+static void archive_dispose(ArchiveState* state) {
+    LOG_DEBUG("archive: freeing stream of %u entries", state->entry_count);
+    for (uint32_t i = 0; i < state->entry_count; i++) {
+        ArchiveEntry* entry = state->entries[i];
+        if (entry->download != NULL && !handle_reaper_defer(HANDLE_TYPE_DOWNLOAD, entry->download)) {
+            handle_free_native_resource(HANDLE_TYPE_DOWNLOAD, entry->download);
+        }
+        free(entry->key);
+        free(entry->data);
+        free(entry->error_message);
+        free(entry);
+    }
+    if (state->iterator != NULL) {
+        uplink_free_object_iterator(state->iterator);
+    }
+    free(state->cursor.scratch);
+    bucket_name_release(state->bucket_name);
+    free(state->prefix);
+    free(state->error_message);
+    free(state->entries);
+    free(state);
+}
+
+/** Fail the whole stream; later reads reject with this error */
+static void archive_fail(ArchiveState* state, int32_t code, const char* message) {
+    if (state->error_code != 0) {
+        return;
+    }
+    state->error_code = code != 0 ? code : UPLINK_ERROR_INTERNAL;
+    state->error_message = strdup(message != NULL ? message : "Archive stream failed");
+}
+
+static void archive_settle(napi_env env, ArchiveState* state) {
+    if (!state->closed) {
+        archive_schedule(env, state);
+    } else if (archive_idle(state)) {
+        archive_dispose(state);
+    }
+}
+
+static void archive_read_free(napi_env env, ArchiveReadData* read) {
+    unpin_buffer(env, read->buffer_ref, read->length);
+    free(read->ready);
+    free(read->error_message);
+    free(read);
+}
+
+static void archive_read_reject(napi_env env, ArchiveReadData* read, int32_t code, const char* message) {
+    napi_reject_deferred(env, read->deferred, create_typed_error(env, code, message));
+    archive_read_free(env, read);
+}
+
+/* ========== scheduling ========== */
+
+static bool archive_entry_ready(const ArchiveEntry* entry) {
+    return entry->state == ARCHIVE_ENTRY_BUFFERED || entry->state == ARCHIVE_ENTRY_STREAMED ||
+           entry->state == ARCHIVE_ENTRY_FAILED;
+}
+
+/** Whether a read would make progress: the cursor's entry is fetched, or the footer is due */
+static bool archive_head_ready(const ArchiveState* state) {
+    if (state->cursor.entry < state->entry_count) {
+        return archive_entry_ready(state->entries[state->cursor.entry]);
+    }
+    return state->listed;
+}
+
+static void archive_start_read(napi_env env, ArchiveState* state, ArchiveReadData* read) {
+    /* Every entry emits at least a 30-byte zip local header, so this many can be reached */
+    uint32_t first = state->cursor.entry;
+    size_t reachable = read->length / 30 + 2;
+    uint32_t count = 0;
+    while (first + count < state->entry_count && count < reachable &&
+           archive_entry_ready(state->entries[first + count])) {
+        count++;
+    }
+
+    read->ready = (ArchiveEntry**)malloc((count > 0 ? count : 1) * sizeof(ArchiveEntry*));
+    if (read->ready == NULL) {
+        archive_read_reject(env, read, UPLINK_ERROR_INTERNAL, "Out of memory");
+        return;
+    }
+    if (count > 0) {
+        memcpy(read->ready, state->entries + first, count * sizeof(ArchiveEntry*));
+    }
+    read->ready_count = count;
+    /* The entry list no longer grows once listed, so the footer may use it directly */
+    read->final = first + count == state->entry_count && state->listed;
+    if (read->final) {
+        read->all = state->entries;
+        read->all_count = state->entry_count;
+    }
+    read->cursor = state->cursor;
+    state->cursor.scratch = NULL;       /* Owned by the read until it completes */
+    state->reading = read;
+
+    if (thread_pool_queue_job(env, THREAD_POOL_LANE_BULK, "archiveRead", archive_read_execute,
+                              archive_read_complete, read) != napi_ok) {
+        state->cursor = read->cursor;
+        state->reading = NULL;
+        archive_read_reject(env, read, UPLINK_ERROR_INTERNAL, "Failed to queue archive read");
+    }
+}
+
+static void archive_start_list(napi_env env, ArchiveState* state) {
+    ArchiveListData* job = (ArchiveListData*)calloc(1, sizeof(ArchiveListData));
+    if (job == NULL) {
+        archive_fail(state, UPLINK_ERROR_INTERNAL, "Out of memory");
+        return;
+    }
+    job->state = state;
+    job->project_handle = state->project_handle;
+    job->bucket_name = state->bucket_name;
+    job->prefix = state->prefix;
+    state->listing = true;
+    if (thread_pool_queue_job(env, THREAD_POOL_LANE_BULK, "archiveList", archive_list_execute,
+                              archive_list_complete, job) != napi_ok) {
+        state->listing = false;
+        free(job);
+        archive_fail(state, UPLINK_ERROR_INTERNAL, "Failed to queue archive listing");
+    }
+}
+
+static bool archive_start_fetch(napi_env env, ArchiveState* state, ArchiveEntry* entry) {
+    ArchiveFetchData* job = (ArchiveFetchData*)calloc(1, sizeof(ArchiveFetchData));
+    if (job == NULL) {
+        return false;
+    }
+    job->state = state;
+    job->entry = entry;
+    job->project_handle = state->project_handle;
+    job->bucket_name = state->bucket_name;
+    job->stream_threshold = state->stream_threshold;
+    job->crc = state->format == ARCHIVE_FORMAT_ZIP;
+    entry->state = ARCHIVE_ENTRY_FETCHING;
+    state->fetches++;
+    if (thread_pool_queue_job(env, THREAD_POOL_LANE_BULK, "archiveFetch", archive_fetch_execute,
+                              archive_fetch_complete, job) != napi_ok) {
+        entry->state = ARCHIVE_ENTRY_PENDING;
+        state->fetches--;
+        free(job);
+        return false;
+    }
+    return true;
+}
+
+void archive_schedule(napi_env env, ArchiveState* state) {
+    if (state->closed) {
+        return;
+    }
+
+    if (state->parked != NULL && (state->error_code != 0 || archive_head_ready(state))) {
+        ArchiveReadData* read = state->parked;
+        state->parked = NULL;
+        if (state->error_code != 0) {
+            archive_read_reject(env, read, state->error_code, state->error_message);
+        } else {
+            archive_start_read(env, state, read);
+        }
+    }
+    if (state->error_code != 0) {
+        return;
+    }
+
+    /* Keep the listing a batch ahead of the fetches */
+    if (state->prefix != NULL && !state->listed && !state->listing &&
+        state->entry_count - state->next_fetch < ARCHIVE_LIST_BATCH) {
+        archive_start_list(env, state);
+    }
+
+    /*
+     * Each fetch in flight may buffer up to the stream threshold. The
+     * entry the reader waits for is fetched regardless, so the stream
+     * always moves.
+     */
+    while (state->next_fetch < state->entry_count && state->fetches < state->concurrency) {
+        if (state->next_fetch != state->cursor.entry) {
+            uint64_t reserved = state->buffered + (uint64_t)(state->fetches + 1) * state->stream_threshold;
+            if (reserved > state->max_buffered || state->streams >= state->concurrency) {
+                break;
+            }
+        }
+        if (!archive_start_fetch(env, state, state->entries[state->next_fetch])) {
+            break;
+        }
+        state->next_fetch++;
+    }
+}
+
+void archive_submit_read(napi_env env, ArchiveState* state, ArchiveReadData* read) {
+    if (archive_head_ready(state)) {
+        archive_start_read(env, state, read);
+    } else {
+        state->parked = read;
+    }
+}
+
+void archive_close_state(napi_env env, ArchiveState* state, bool can_settle) {
+    state->closed = true;
+    if (state->parked != NULL) {
+        ArchiveReadData* read = state->parked;
+        state->parked = NULL;
+        if (can_settle) {
+            archive_read_reject(env, read, UPLINK_ERROR_CANCELED, "Archive stream closed");
+        } else {
+            archive_read_free(env, read);
+        }
+    }
+    if (archive_idle(state)) {
+        archive_dispose(state);
+    }
+}
+
+/* ========== completions ========== */
+
+void archive_fetch_complete(napi_env env, napi_status status, void* data) {
+    ArchiveFetchData* job = (ArchiveFetchData*)data;
+    ArchiveState* state = job->state;
+    ArchiveEntry* entry = job->entry;
+
+    state->fetches--;
+    entry->state = status == napi_ok ? job->outcome : ARCHIVE_ENTRY_FAILED;
+    if (entry->state == ARCHIVE_ENTRY_BUFFERED) {
+        state->buffered += entry->size;
+    } else if (entry->state == ARCHIVE_ENTRY_STREAMED) {
+        state->streams++;
+    } else if (entry->error_message == NULL) {
+        entry->error_code = UPLINK_ERROR_INTERNAL;
+        entry->error_message = strdup("Fetch did not run");
+    }
+    LOG_TRACE("archive: fetched '%s' (%llu bytes, state %d)", entry->key,
+              (unsigned long long)entry->size, (int)entry->state);
+    free(job);
+    archive_settle(env, state);
+}
+
+void archive_list_complete(napi_env env, napi_status status, void* data) {
+    ArchiveListData* job = (ArchiveListData*)data;
+    ArchiveState* state = job->state;
+    state->listing = false;
+
+    size_t name_offset = strlen(state->prefix);
+    uint32_t added = 0;
+    if (job->key_count > 0 && state->entry_count + job->key_count > state->entry_capacity) {
+        uint32_t capacity = state->entry_capacity > 0 ? state->entry_capacity : ARCHIVE_LIST_BATCH;
+        while (capacity < state->entry_count + job->key_count) {
+            capacity *= 2;
+        }
+        ArchiveEntry** entries = (ArchiveEntry**)realloc(state->entries, capacity * sizeof(ArchiveEntry*));
+        if (entries == NULL) {
+            archive_fail(state, UPLINK_ERROR_INTERNAL, "Out of memory");
+        } else {
+            state->entries = entries;
+            state->entry_capacity = capacity;
+        }
+    }
+    for (uint32_t i = 0; i < job->key_count; i++) {
+        ArchiveEntry* entry = NULL;
+        if (state->entry_count < state->entry_capacity &&
+            (entry = (ArchiveEntry*)calloc(1, sizeof(ArchiveEntry))) != NULL) {
+            entry->key = job->keys[i];
+            entry->name_offset = name_offset;
+            state->entries[state->entry_count++] = entry;
+            added++;
+        } else {
+            free(job->keys[i]);
+        }
+    }
+    if (added < job->key_count) {
+        archive_fail(state, UPLINK_ERROR_INTERNAL, "Out of memory");
+    }
+
+    if (status != napi_ok) {
+        archive_fail(state, UPLINK_ERROR_INTERNAL, "Listing did not run");
+    } else if (job->error_code != 0) {
+        archive_fail(state, job->error_code, job->error_message);
+    }
+    state->listed = job->done || status != napi_ok;
+
+    free(job->keys);
+    free(job->error_message);
+    free(job);
+    archive_settle(env, state);
+}
+
+void archive_read_complete(napi_env env, napi_status status, void* data) {
+    ArchiveReadData* read = (ArchiveReadData*)data;
+    ArchiveState* state = read->state;
+
+    state->reading = NULL;
+    state->cursor = read->cursor;
+    state->buffered -= read->released;
+    state->streams -= read->streams_closed;
+    op_metrics_add_bytes(env, read->bytes_read);
+
+    if (status != napi_ok) {
+        archive_fail(state, UPLINK_ERROR_INTERNAL, "Archive read did not run");
+    } else if (read->error_code != 0) {
+        archive_fail(state, read->error_code, read->error_message);
+    }
+
+    if (state->error_code != 0) {
+        LOG_DEBUG("archiveRead: failed: %s", state->error_message);
+        archive_read_reject(env, read, state->error_code, state->error_message);
+    } else {
+        napi_value result;
+        napi_create_object(env, &result);
+        napi_value bytes_read;
+        napi_create_int64(env, (int64_t)read->bytes_read, &bytes_read);
+        napi_set_named_property(env, result, "bytesRead", bytes_read);
+        napi_value eof;
+        napi_get_boolean(env, read->eof, &eof);
+        napi_set_named_property(env, result, "eof", eof);
+        napi_resolve_deferred(env, read->deferred, result);
+        archive_read_free(env, read);
+    }
+    archive_settle(env, state);
+}
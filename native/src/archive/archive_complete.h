@@ -0,0 +1,45 @@
+/**
+ * @file archive_complete.h
+ * @brief Main thread side of archive streams: job completions and scheduling
+ */
+
+#ifndef ARCHIVE_COMPLETE_H
+#define ARCHIVE_COMPLETE_H
+
+#include <node_api.h>
+#include "archive_types.h"
+
+/**
+ * @brief Complete a fetch job and schedule more work (main thread)
+ */
+void archive_fetch_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Append listed keys as entries and schedule more work (main thread)
+ */
+void archive_list_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Commit a read's cursor and settle its promise (main thread)
+ */
+void archive_read_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * Start the list and fetch jobs the budget allows, and a parked read
+ * once the entry it waits for is ready
+ */
+void archive_schedule(napi_env env, ArchiveState* state);
+
+/**
+ * Queue @p read now if the next entry is ready, else park it
+ */
+void archive_submit_read(napi_env env, ArchiveState* state, ArchiveReadData* read);
+
+/**
+ * Close a stream: a parked read is rejected (left unsettled when
+ * @p can_settle is false, from a finalizer) and the state is freed once
+ * no job is in flight
+ */
+void archive_close_state(napi_env env, ArchiveState* state, bool can_settle);
+
+#endif /* ARCHIVE_COMPLETE_H */
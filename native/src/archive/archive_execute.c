@@ -0,0 +1,432 @@
+/**
+ * @file archive_execute.c
+ * @brief Worker thread functions for archive streams
+ *
+ * Fetch and list jobs own what they were handed (one FETCHING entry, the
+ * listing iterator). A read job owns its cursor copy and the entries from
+ * the cursor on; it frees buffered bodies and closes streamed downloads
+ * as they are emitted, and reports the bytes released for the completion
+ * to take off the budget.
+ */
+
+#include "archive_execute.h"
+#include "archive_types.h"
+#include "archive_format.h"
+#include "../common/bandwidth.h"
+#include "../common/object_converter.h"
+#include "../common/result_helpers.h"
+#include "../common/logger.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Record an error as code + malloc'd message, keeping the first one */
+static void archive_set_error(int32_t* code, char** message, int32_t error_code, const char* format, ...) {
+    if (*code != 0) {
+        return;
+    }
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    *code = error_code != 0 ? error_code : UPLINK_ERROR_INTERNAL;
+    *message = strdup(buffer);
+}
+
+static void archive_close_download(UplinkDownload* download) {
+    uplink_free_error(uplink_close_download(download));
+    UplinkDownloadResult result = { .download = download, .error = NULL };
+    uplink_free_download_result(result);
+}
+
+/**
+ * Read up to @p length bytes within the project's bandwidth limits
+ */
+static UplinkReadResult archive_read_limited(UplinkDownload* download, size_t project_handle,
+                                             uint8_t* buf, size_t length) {
+    UplinkReadResult read = { 0 };
+    size_t grant = bandwidth_acquire(project_handle, BANDWIDTH_DOWNLOAD, length, NULL);
+    if (grant > 0) {
+        read = uplink_download_read(download, buf, grant);
+        bandwidth_refund(project_handle, BANDWIDTH_DOWNLOAD, grant - read.bytes_read);
+    }
+    return read;
+}
+
+/* ========== fetch ========== */
+
+void archive_fetch_execute(napi_env env, void* data) {
+    (void)env;
+    ArchiveFetchData* job = (ArchiveFetchData*)data;
+    ArchiveEntry* entry = job->entry;
+    job->outcome = ARCHIVE_ENTRY_FAILED;
+
+    UplinkProject project = { ._handle = job->project_handle };
+    UplinkDownloadOptions options = { .offset = 0, .length = -1 };
+    UplinkDownloadResult download = uplink_download_object(&project, job->bucket_name, entry->key, &options);
+    if (download.error != NULL) {
+        archive_set_error(&entry->error_code, &entry->error_message, download.error->code, "%s",
+                          download.error->message != NULL ? download.error->message : "Download failed");
+        uplink_free_download_result(download);
+        return;
+    }
+
+    /* Info comes with the open download, so this costs no round trip */
+    UplinkObjectResult info = uplink_download_info(download.download);
+    if (info.error != NULL) {
+        archive_set_error(&entry->error_code, &entry->error_message, info.error->code, "%s",
+                          info.error->message != NULL ? info.error->message : "Download info failed");
+        uplink_free_object_result(info);
+        archive_close_download(download.download);
+        return;
+    }
+    if (object_is_compressed(info.object)) {
+        archive_set_error(&entry->error_code, &entry->error_message, UPLINK_ERROR_COMPRESSED_OBJECT,
+                          "%s", OBJECT_COMPRESSED_MESSAGE);
+        uplink_free_object_result(info);
+        archive_close_download(download.download);
+        return;
+    }
+    int64_t content_length = info.object->system.content_length;
+    entry->size = content_length > 0 ? (uint64_t)content_length : 0;
+    entry->mtime = info.object->system.created;
+    uplink_free_object_result(info);
+
+    if (entry->size > job->stream_threshold) {
+        entry->download = download.download;
+        job->outcome = ARCHIVE_ENTRY_STREAMED;
+        return;
+    }
+
+    entry->data = (uint8_t*)malloc(entry->size > 0 ? (size_t)entry->size : 1);
+    if (entry->data == NULL) {
+        archive_set_error(&entry->error_code, &entry->error_message, UPLINK_ERROR_INTERNAL, "Out of memory");
+        archive_close_download(download.download);
+        return;
+    }
+    uint64_t got = 0;
+    while (got < entry->size) {
+        size_t want = entry->size - got < ARCHIVE_READ_CHUNK ? (size_t)(entry->size - got) : ARCHIVE_READ_CHUNK;
+        UplinkReadResult read = archive_read_limited(download.download, job->project_handle, entry->data + got, want);
+        got += read.bytes_read;
+        if (read.error != NULL) {
+            if (got < entry->size) {
+                if (read.error->code == EOF) {
+                    archive_set_error(&entry->error_code, &entry->error_message, UPLINK_ERROR_INTERNAL,
+                                      "Object '%s' ended after %llu of %llu bytes", entry->key,
+                                      (unsigned long long)got, (unsigned long long)entry->size);
+                } else {
+                    archive_set_error(&entry->error_code, &entry->error_message, read.error->code, "%s",
+                                      read.error->message != NULL ? read.error->message : "Read failed");
+                }
+            }
+            uplink_free_error(read.error);
+            if (got < entry->size) {
+                break;
+            }
+        }
+    }
+    archive_close_download(download.download);
+    if (entry->error_code != 0) {
+        free(entry->data);
+        entry->data = NULL;
+        return;
+    }
+    if (job->crc) {
+        entry->crc = archive_crc32(0, entry->data, (size_t)entry->size);
+    }
+    job->outcome = ARCHIVE_ENTRY_BUFFERED;
+}
+
+/* ========== list ========== */
+
+void archive_list_execute(napi_env env, void* data) {
+    (void)env;
+    ArchiveListData* job = (ArchiveListData*)data;
+    ArchiveState* state = job->state;
+
+    if (state->iterator == NULL) {
+        UplinkProject project = { ._handle = job->project_handle };
+        UplinkListObjectsOptions options = { 0 };
+        options.prefix = job->prefix;
+        options.recursive = true;
+        state->iterator = uplink_list_objects(&project, job->bucket_name, &options);
+        if (state->iterator == NULL) {
+            archive_set_error(&job->error_code, &job->error_message, UPLINK_ERROR_INTERNAL, "Failed to list objects");
+            job->done = true;
+            return;
+        }
+    }
+
+    job->keys = (char**)malloc(ARCHIVE_LIST_BATCH * sizeof(char*));
+    if (job->keys == NULL) {
+        archive_set_error(&job->error_code, &job->error_message, UPLINK_ERROR_INTERNAL, "Out of memory");
+        job->done = true;
+        return;
+    }
+
+    size_t prefix_length = strlen(job->prefix);
+    while (job->key_count < ARCHIVE_LIST_BATCH && uplink_object_iterator_next(state->iterator)) {
+        UplinkObject* object = uplink_object_iterator_item(state->iterator);
+        if (object == NULL) continue;
+        /* A key equal to the prefix has no entry name */
+        if (!object->is_prefix && strlen(object->key) > prefix_length) {
+            char* key = strdup(object->key);
+            if (key == NULL) {
+                uplink_free_object(object);
+                archive_set_error(&job->error_code, &job->error_message, UPLINK_ERROR_INTERNAL, "Out of memory");
+                job->done = true;
+                return;
+            }
+            job->keys[job->key_count++] = key;
+        }
+        uplink_free_object(object);
+    }
+
+    if (job->key_count < ARCHIVE_LIST_BATCH) {
+        job->done = true;
+        UplinkError* error = uplink_object_iterator_err(state->iterator);
+        if (error != NULL) {
+            archive_set_error(&job->error_code, &job->error_message, error->code, "%s",
+                              error->message != NULL ? error->message : "Listing failed");
+            uplink_free_error(error);
+        }
+    }
+    LOG_DEBUG("archive: listed %u keys below '%s'%s", job->key_count, job->prefix, job->done ? " (done)" : "");
+}
+
+/* ========== read ========== */
+
+static const char* entry_name(const ArchiveEntry* entry) {
+    return entry->key + entry->name_offset;
+}
+
+static ArchiveZipEntry zip_entry(const ArchiveEntry* entry) {
+    ArchiveZipEntry zip;
+    zip.name = entry_name(entry);
+    zip.name_length = strlen(zip.name);
+    zip.size = entry->size;
+    zip.mtime = entry->mtime;
+    zip.crc = entry->crc;
+    zip.offset = entry->offset;
+    zip.descriptor = entry->state == ARCHIVE_ENTRY_STREAMED;
+    return zip;
+}
+
+/**
+ * Build the bytes of the cursor's phase into its scratch
+ *
+ * @return 0 on success, -1 when out of memory
+ */
+static int archive_build_scratch(ArchiveReadData* job, ArchiveEntry* entry) {
+    ArchiveCursor* cursor = &job->cursor;
+    size_t capacity = 0;
+    uint8_t* scratch = NULL;
+    size_t length = 0;
+
+    switch (cursor->phase) {
+        case ARCHIVE_PHASE_HEADER: {
+            const char* name = entry_name(entry);
+            size_t name_length = strlen(name);
+            if (job->format == ARCHIVE_FORMAT_TAR) {
+                capacity = archive_tar_header_capacity(name_length);
+                if ((scratch = (uint8_t*)malloc(capacity)) == NULL) return -1;
+                length = archive_tar_header(name, name_length, entry->size, entry->mtime, scratch);
+            } else {
+                entry->offset = cursor->archive_offset;
+                ArchiveZipEntry zip = zip_entry(entry);
+                capacity = archive_zip_header_capacity(name_length);
+                if ((scratch = (uint8_t*)malloc(capacity)) == NULL) return -1;
+                length = archive_zip_local_header(&zip, scratch);
+            }
+            break;
+        }
+        case ARCHIVE_PHASE_TRAILER:
+            if (job->format == ARCHIVE_FORMAT_TAR) {
+                length = archive_tar_padding(entry->size);
+                if (length > 0 && (scratch = (uint8_t*)calloc(1, length)) == NULL) return -1;
+            } else if (entry->state == ARCHIVE_ENTRY_STREAMED) {
+                ArchiveZipEntry zip = zip_entry(entry);
+                if ((scratch = (uint8_t*)malloc(ARCHIVE_ZIP_DESCRIPTOR_MAX)) == NULL) return -1;
+                length = archive_zip_descriptor(&zip, scratch);
+            }
+            break;
+        case ARCHIVE_PHASE_FOOTER:
+            if (job->format == ARCHIVE_FORMAT_TAR) {
+                length = ARCHIVE_TAR_TRAILER_SIZE;
+                if ((scratch = (uint8_t*)calloc(1, length)) == NULL) return -1;
+            } else {
+                capacity = ARCHIVE_ZIP_END_MAX;
+                for (uint32_t i = 0; i < job->all_count; i++) {
+                    capacity += archive_zip_header_capacity(strlen(entry_name(job->all[i])));
+                }
+                if ((scratch = (uint8_t*)malloc(capacity)) == NULL) return -1;
+                for (uint32_t i = 0; i < job->all_count; i++) {
+                    ArchiveZipEntry zip = zip_entry(job->all[i]);
+                    length += archive_zip_central_header(&zip, scratch + length);
+                }
+                length += archive_zip_end(job->all_count, cursor->archive_offset, length, scratch + length);
+            }
+            break;
+        default:
+            break;
+    }
+
+    cursor->scratch = scratch;
+    cursor->scratch_length = length;
+    return 0;
+}
+
+/** Move to the phase after the current one */
+static void archive_next_phase(ArchiveCursor* cursor) {
+    free(cursor->scratch);
+    cursor->scratch = NULL;
+    cursor->scratch_length = 0;
+    cursor->phase_offset = 0;
+    switch (cursor->phase) {
+        case ARCHIVE_PHASE_HEADER:
+            cursor->phase = ARCHIVE_PHASE_DATA;
+            break;
+        case ARCHIVE_PHASE_DATA:
+            cursor->phase = ARCHIVE_PHASE_TRAILER;
+            break;
+        case ARCHIVE_PHASE_TRAILER:
+            cursor->entry++;
+            cursor->phase = ARCHIVE_PHASE_HEADER;
+            break;
+        default:
+            cursor->phase = ARCHIVE_PHASE_DONE;
+            break;
+    }
+}
+
+/**
+ * Copy data bytes of @p entry into the buffer
+ *
+ * @return Bytes copied; 0 with job->error_code set on failure
+ */
+static size_t archive_emit_data(ArchiveReadData* job, ArchiveEntry* entry, uint8_t* out, size_t room) {
+    ArchiveCursor* cursor = &job->cursor;
+    uint64_t left = entry->size - cursor->phase_offset;
+    size_t want = left < room ? (size_t)left : room;
+
+    if (entry->state == ARCHIVE_ENTRY_BUFFERED) {
+        memcpy(out, entry->data + cursor->phase_offset, want);
+        return want;
+    }
+
+    if (want > ARCHIVE_READ_CHUNK) {
+        want = ARCHIVE_READ_CHUNK;
+    }
+    UplinkReadResult read = archive_read_limited(entry->download, job->project_handle, out, want);
+    if (read.bytes_read > want) {
+        read.bytes_read = want;
+    }
+    if (job->format == ARCHIVE_FORMAT_ZIP) {
+        entry->crc = archive_crc32(entry->crc, out, read.bytes_read);
+    }
+    if (read.error != NULL) {
+        if (cursor->phase_offset + read.bytes_read < entry->size) {
+            if (read.error->code == EOF) {
+                archive_set_error(&job->error_code, &job->error_message, UPLINK_ERROR_INTERNAL,
+                                  "Object '%s' ended after %llu of %llu bytes", entry->key,
+                                  (unsigned long long)(cursor->phase_offset + read.bytes_read),
+                                  (unsigned long long)entry->size);
+            } else {
+                archive_set_error(&job->error_code, &job->error_message, read.error->code, "%s",
+                                  read.error->message != NULL ? read.error->message : "Read failed");
+            }
+        }
+        uplink_free_error(read.error);
+    }
+    return read.bytes_read;
+}
+
+/** Release an entry's body once all of it is emitted */
+static void archive_release_entry(ArchiveReadData* job, ArchiveEntry* entry) {
+    if (entry->data != NULL) {
+        free(entry->data);
+        entry->data = NULL;
+        job->released += entry->size;
+    }
+    if (entry->download != NULL) {
+        archive_close_download(entry->download);
+        entry->download = NULL;
+        job->streams_closed++;
+    }
+}
+
+void archive_read_execute(napi_env env, void* data) {
+    (void)env;
+    ArchiveReadData* job = (ArchiveReadData*)data;
+    ArchiveCursor* cursor = &job->cursor;
+    uint32_t first = cursor->entry;
+
+    while (job->bytes_read < job->length && job->error_code == 0) {
+        if (cursor->phase == ARCHIVE_PHASE_DONE) {
+            job->eof = true;
+            break;
+        }
+
+        ArchiveEntry* entry = NULL;
+        if (cursor->phase != ARCHIVE_PHASE_FOOTER) {
+            uint32_t index = cursor->entry - first;
+            if (index >= job->ready_count) {
+                if (!job->final) {
+                    break;              /* The next entry is still being fetched */
+                }
+                cursor->phase = ARCHIVE_PHASE_FOOTER;
+                continue;
+            }
+            entry = job->ready[index];
+        }
+
+        if (cursor->phase == ARCHIVE_PHASE_DATA) {
+            if (cursor->phase_offset == entry->size) {
+                archive_release_entry(job, entry);
+                archive_next_phase(cursor);
+                continue;
+            }
+            size_t copied = archive_emit_data(job, entry, job->buffer + job->bytes_read,
+                                              job->length - job->bytes_read);
+            cursor->phase_offset += copied;
+            cursor->archive_offset += copied;
+            job->bytes_read += copied;
+            continue;
+        }
+
+        if (cursor->phase_offset == 0 && cursor->scratch == NULL) {
+            if (entry != NULL && cursor->phase == ARCHIVE_PHASE_HEADER && entry->state == ARCHIVE_ENTRY_FAILED) {
+                /* Hand out what precedes the failed entry first */
+                if (job->bytes_read == 0) {
+                    archive_set_error(&job->error_code, &job->error_message, entry->error_code, "%s: %s",
+                                      entry->key, entry->error_message != NULL ? entry->error_message : "failed");
+                }
+                break;
+            }
+            if (archive_build_scratch(job, entry) != 0) {
+                archive_set_error(&job->error_code, &job->error_message, UPLINK_ERROR_INTERNAL, "Out of memory");
+                break;
+            }
+        }
+
+        size_t left = cursor->scratch_length - (size_t)cursor->phase_offset;
+        size_t room = job->length - job->bytes_read;
+        size_t copied = left < room ? left : room;
+        memcpy(job->buffer + job->bytes_read, cursor->scratch + cursor->phase_offset, copied);
+        cursor->phase_offset += copied;
+        cursor->archive_offset += copied;
+        job->bytes_read += copied;
+        if (cursor->phase_offset == cursor->scratch_length) {
+            archive_next_phase(cursor);
+        }
+    }
+
+    /* Report the end with the last bytes, so the reader needs no extra call */
+    if (cursor->phase == ARCHIVE_PHASE_DONE) {
+        job->eof = true;
+    }
+}
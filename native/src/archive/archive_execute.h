@@ -0,0 +1,26 @@
+/**
+ * @file archive_execute.h
+ * @brief Execute function declarations for archive streams
+ */
+
+#ifndef ARCHIVE_EXECUTE_H
+#define ARCHIVE_EXECUTE_H
+
+#include <node_api.h>
+
+/**
+ * @brief Open one object and read it whole unless it is streamed (worker thread)
+ */
+void archive_fetch_execute(napi_env env, void* data);
+
+/**
+ * @brief Pull the next batch of keys below the prefix (worker thread)
+ */
+void archive_list_execute(napi_env env, void* data);
+
+/**
+ * @brief Emit archive bytes into the caller's buffer (worker thread)
+ */
+void archive_read_execute(napi_env env, void* data);
+
+#endif /* ARCHIVE_EXECUTE_H */
@@ -0,0 +1,381 @@
+/**
+ * @file archive_format.c
+ * @brief tar and zip encoding implementation
+ *
+ * CRC-32 uses a slice-by-8 table built once via uv_once, as checksum.c
+ * does for CRC32C. Zip timestamps are written as UTC DOS times, computed
+ * without gmtime so every platform encodes the same bytes.
+ */
+
+#include "archive_format.h"
+
+#include <uv.h>
+#include <stdio.h>
+#include <string.h>
+
+/* ========== CRC-32 ========== */
+
+static uint32_t crc32_table[8][256];
+static uv_once_t crc32_table_once = UV_ONCE_INIT;
+
+static void crc32_build_table(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+        crc32_table[0][i] = crc;
+    }
+    for (int t = 1; t < 8; t++) {
+        for (int i = 0; i < 256; i++) {
+            uint32_t prev = crc32_table[t - 1][i];
+            crc32_table[t][i] = (prev >> 8) ^ crc32_table[0][prev & 0xFF];
+        }
+    }
+}
+
+uint32_t archive_crc32(uint32_t crc, const uint8_t* p, size_t n) {
+    uv_once(&crc32_table_once, crc32_build_table);
+    crc = ~crc;
+    while (n >= 8) {
+        uint32_t lo = ((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24)) ^ crc;
+        uint32_t hi = (uint32_t)p[4] | ((uint32_t)p[5] << 8) | ((uint32_t)p[6] << 16) | ((uint32_t)p[7] << 24);
+        crc = crc32_table[7][lo & 0xFF] ^ crc32_table[6][(lo >> 8) & 0xFF] ^
+              crc32_table[5][(lo >> 16) & 0xFF] ^ crc32_table[4][lo >> 24] ^
+              crc32_table[3][hi & 0xFF] ^ crc32_table[2][(hi >> 8) & 0xFF] ^
+              crc32_table[1][(hi >> 16) & 0xFF] ^ crc32_table[0][hi >> 24];
+        p += 8;
+        n -= 8;
+    }
+    while (n-- > 0) {
+        crc = (crc >> 8) ^ crc32_table[0][(crc ^ *p++) & 0xFF];
+    }
+    return ~crc;
+}
+
+/* ========== tar ========== */
+
+/* Largest size an 11-digit octal field holds */
+#define TAR_OCTAL_SIZE_MAX 077777777777ULL
+
+/* ustar field offsets */
+#define TAR_NAME 0
+#define TAR_MODE 100
+#define TAR_UID 108
+#define TAR_GID 116
+#define TAR_SIZE 124
+#define TAR_MTIME 136
+#define TAR_CHKSUM 148
+#define TAR_TYPEFLAG 156
+#define TAR_MAGIC 257
+#define TAR_VERSION 263
+#define TAR_PREFIX 345
+
+static void tar_octal(uint8_t* field, size_t width, uint64_t value) {
+    /* width - 1 digits, then NUL */
+    char digits[24];
+    snprintf(digits, sizeof(digits), "%0*llo", (int)(width - 1), (unsigned long long)value);
+    memcpy(field, digits, width - 1);
+    field[width - 1] = '\0';
+}
+
+/** GNU base-256 size for sizes past the octal field; pax carries it too */
+static void tar_base256(uint8_t* field, size_t width, uint64_t value) {
+    memset(field, 0, width);
+    field[0] = 0x80;
+    for (size_t i = width - 1; i > 0 && value > 0; i--) {
+        field[i] = (uint8_t)(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+static void tar_fill_block(uint8_t* block, const char* name, size_t name_length, const char* prefix,
+                           size_t prefix_length, uint64_t size, int64_t mtime, char typeflag) {
+    memset(block, 0, ARCHIVE_TAR_BLOCK);
+    memcpy(block + TAR_NAME, name, name_length);
+    memcpy(block + TAR_PREFIX, prefix, prefix_length);
+    tar_octal(block + TAR_MODE, 8, 0644);
+    tar_octal(block + TAR_UID, 8, 0);
+    tar_octal(block + TAR_GID, 8, 0);
+    if (size <= TAR_OCTAL_SIZE_MAX) {
+        tar_octal(block + TAR_SIZE, 12, size);
+    } else {
+        tar_base256(block + TAR_SIZE, 12, size);
+    }
+    tar_octal(block + TAR_MTIME, 12, mtime > 0 ? (uint64_t)mtime : 0);
+    block[TAR_TYPEFLAG] = (uint8_t)typeflag;
+    memcpy(block + TAR_MAGIC, "ustar", 6);
+    memcpy(block + TAR_VERSION, "00", 2);
+
+    memset(block + TAR_CHKSUM, ' ', 8);
+    unsigned int sum = 0;
+    for (size_t i = 0; i < ARCHIVE_TAR_BLOCK; i++) {
+        sum += block[i];
+    }
+    char digits[8];
+    snprintf(digits, sizeof(digits), "%06o", sum & 0777777);
+    memcpy(block + TAR_CHKSUM, digits, 6);
+    block[TAR_CHKSUM + 6] = '\0';
+    block[TAR_CHKSUM + 7] = ' ';
+}
+
+/** Append one "<length> <key>=<value>\n" pax record; the length counts itself */
+static size_t pax_record(uint8_t* out, const char* key, const char* value, size_t value_length) {
+    size_t body = 1 + strlen(key) + 1 + value_length + 1;
+    size_t length = body + 1;
+    for (;;) {
+        char digits[24];
+        size_t total = body + (size_t)snprintf(digits, sizeof(digits), "%zu", length);
+        if (total == length) {
+            break;
+        }
+        length = total;
+    }
+    size_t written = (size_t)sprintf((char*)out, "%zu %s=", length, key);
+    memcpy(out + written, value, value_length);
+    written += value_length;
+    out[written++] = '\n';
+    return written;
+}
+
+size_t archive_tar_header_capacity(size_t name_length) {
+    /* pax header block, records (path and size, with their framing), ustar block */
+    size_t records = name_length + 64;
+    return 2 * ARCHIVE_TAR_BLOCK + records + ARCHIVE_TAR_BLOCK;
+}
+
+size_t archive_tar_header(const char* name, size_t name_length, uint64_t size, int64_t mtime, uint8_t* out) {
+    /* Fit ustar: the whole name, or a prefix/name split at a '/' */
+    size_t split = 0;
+    bool fits = name_length <= 100;
+    if (!fits && name_length <= 256) {
+        for (size_t i = name_length - 1; i > 0; i--) {
+            if (name[i] == '/' && i <= 155 && name_length - i - 1 <= 100 && name_length - i - 1 > 0) {
+                split = i;
+                fits = true;
+                break;
+            }
+        }
+    }
+    bool large = size > TAR_OCTAL_SIZE_MAX;
+
+    size_t written = 0;
+    if (!fits || large) {
+        uint8_t* records = out + ARCHIVE_TAR_BLOCK;
+        size_t records_length = 0;
+        if (!fits) {
+            records_length += pax_record(records, "path", name, name_length);
+        }
+        if (large) {
+            char digits[24];
+            int n = snprintf(digits, sizeof(digits), "%llu", (unsigned long long)size);
+            records_length += pax_record(records + records_length, "size", digits, (size_t)n);
+        }
+        tar_fill_block(out, "PaxHeader", 9, "", 0, records_length, mtime, 'x');
+        size_t padding = archive_tar_padding(records_length);
+        memset(records + records_length, 0, padding);
+        written = ARCHIVE_TAR_BLOCK + records_length + padding;
+    }
+
+    if (!fits) {
+        /* Readers without pax see the name cut to the ustar field */
+        tar_fill_block(out + written, name, 100, "", 0, size, mtime, '0');
+    } else if (split > 0) {
+        tar_fill_block(out + written, name + split + 1, name_length - split - 1, name, split, size, mtime, '0');
+    } else {
+        tar_fill_block(out + written, name, name_length, "", 0, size, mtime, '0');
+    }
+    return written + ARCHIVE_TAR_BLOCK;
+}
+
+size_t archive_tar_padding(uint64_t size) {
+    return (size_t)((ARCHIVE_TAR_BLOCK - size % ARCHIVE_TAR_BLOCK) % ARCHIVE_TAR_BLOCK);
+}
+
+/* ========== zip ========== */
+
+#define ZIP_LOCAL_SIGNATURE 0x04034b50u
+#define ZIP_CENTRAL_SIGNATURE 0x02014b50u
+#define ZIP_DESCRIPTOR_SIGNATURE 0x08074b50u
+#define ZIP_END_SIGNATURE 0x06054b50u
+#define ZIP64_END_SIGNATURE 0x06064b50u
+#define ZIP64_LOCATOR_SIGNATURE 0x07064b50u
+#define ZIP64_EXTRA_ID 0x0001
+
+#define ZIP_FLAG_DESCRIPTOR 0x0008
+#define ZIP_FLAG_UTF8 0x0800
+#define ZIP_VERSION_DEFAULT 20
+#define ZIP_VERSION_ZIP64 45
+#define ZIP_MAX32 0xFFFFFFFFu
+#define ZIP_MAX16 0xFFFFu
+
+static uint8_t* put16(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+static uint8_t* put32(uint8_t* p, uint32_t value) {
+    p = put16(p, value & 0xFFFF);
+    return put16(p, value >> 16);
+}
+
+static uint8_t* put64(uint8_t* p, uint64_t value) {
+    p = put32(p, (uint32_t)value);
+    return put32(p, (uint32_t)(value >> 32));
+}
+
+/** Unix seconds to DOS date (high 16 bits) and time (low 16 bits), UTC */
+static uint32_t dos_datetime(int64_t mtime) {
+    if (mtime < 315532800) {
+        /* DOS time starts in 1980 */
+        return (0u << 25) | (1u << 21) | (1u << 16);
+    }
+    int64_t days = mtime / 86400;
+    int64_t seconds = mtime % 86400;
+
+    /* Civil date from days since the epoch (Howard Hinnant's algorithm) */
+    int64_t z = days + 719468;
+    int64_t era = z / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t day = doy - (153 * mp + 2) / 5 + 1;
+    int64_t month = mp < 10 ? mp + 3 : mp - 9;
+    int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+    if (year > 2107) {
+        year = 2107;
+    }
+
+    uint32_t date = (uint32_t)(((year - 1980) << 9) | (month << 5) | day);
+    uint32_t time = (uint32_t)(((seconds / 3600) << 11) | (((seconds / 60) % 60) << 5) | ((seconds % 60) / 2));
+    return (date << 16) | time;
+}
+
+size_t archive_zip_header_capacity(size_t name_length) {
+    /* central header (46) + name + zip64 extra (4 + 3 * 8) */
+    return 46 + name_length + 28;
+}
+
+static bool zip_entry_needs_zip64(const ArchiveZipEntry* entry) {
+    return entry->size >= ZIP_MAX32;
+}
+
+size_t archive_zip_local_header(const ArchiveZipEntry* entry, uint8_t* out) {
+    bool zip64 = zip_entry_needs_zip64(entry);
+    uint32_t flags = ZIP_FLAG_UTF8 | (entry->descriptor ? ZIP_FLAG_DESCRIPTOR : 0);
+    uint32_t datetime = dos_datetime(entry->mtime);
+    uint32_t size32 = zip64 ? ZIP_MAX32 : (uint32_t)entry->size;
+
+    uint8_t* p = out;
+    p = put32(p, ZIP_LOCAL_SIGNATURE);
+    p = put16(p, zip64 ? ZIP_VERSION_ZIP64 : ZIP_VERSION_DEFAULT);
+    p = put16(p, flags);
+    p = put16(p, 0);                            /* stored */
+    p = put16(p, datetime & 0xFFFF);
+    p = put16(p, datetime >> 16);
+    p = put32(p, entry->descriptor ? 0 : entry->crc);
+    p = put32(p, size32);
+    p = put32(p, size32);
+    p = put16(p, (uint32_t)entry->name_length);
+    p = put16(p, zip64 ? 20 : 0);
+    memcpy(p, entry->name, entry->name_length);
+    p += entry->name_length;
+    if (zip64) {
+        p = put16(p, ZIP64_EXTRA_ID);
+        p = put16(p, 16);
+        p = put64(p, entry->size);
+        p = put64(p, entry->size);
+    }
+    return (size_t)(p - out);
+}
+
+size_t archive_zip_descriptor(const ArchiveZipEntry* entry, uint8_t* out) {
+    uint8_t* p = out;
+    p = put32(p, ZIP_DESCRIPTOR_SIGNATURE);
+    p = put32(p, entry->crc);
+    /* Sizes are 8 bytes exactly when the local header has a zip64 extra */
+    if (zip_entry_needs_zip64(entry)) {
+        p = put64(p, entry->size);
+        p = put64(p, entry->size);
+    } else {
+        p = put32(p, (uint32_t)entry->size);
+        p = put32(p, (uint32_t)entry->size);
+    }
+    return (size_t)(p - out);
+}
+
+size_t archive_zip_central_header(const ArchiveZipEntry* entry, uint8_t* out) {
+    bool large = zip_entry_needs_zip64(entry);
+    bool far = entry->offset >= ZIP_MAX32;
+    uint32_t flags = ZIP_FLAG_UTF8 | (entry->descriptor ? ZIP_FLAG_DESCRIPTOR : 0);
+    uint32_t datetime = dos_datetime(entry->mtime);
+    uint32_t extra = (large ? 16u : 0u) + (far ? 8u : 0u);
+    uint32_t version = large || far ? ZIP_VERSION_ZIP64 : ZIP_VERSION_DEFAULT;
+
+    uint8_t* p = out;
+    p = put32(p, ZIP_CENTRAL_SIGNATURE);
+    p = put16(p, (3u << 8) | version);         /* made by: Unix */
+    p = put16(p, version);
+    p = put16(p, flags);
+    p = put16(p, 0);
+    p = put16(p, datetime & 0xFFFF);
+    p = put16(p, datetime >> 16);
+    p = put32(p, entry->crc);
+    p = put32(p, large ? ZIP_MAX32 : (uint32_t)entry->size);
+    p = put32(p, large ? ZIP_MAX32 : (uint32_t)entry->size);
+    p = put16(p, (uint32_t)entry->name_length);
+    p = put16(p, extra > 0 ? extra + 4 : 0);
+    p = put16(p, 0);                            /* comment */
+    p = put16(p, 0);                            /* disk */
+    p = put16(p, 0);                            /* internal attributes */
+    p = put32(p, 0100644u << 16);               /* external attributes: regular file, 0644 */
+    p = put32(p, far ? ZIP_MAX32 : (uint32_t)entry->offset);
+    memcpy(p, entry->name, entry->name_length);
+    p += entry->name_length;
+    if (extra > 0) {
+        p = put16(p, ZIP64_EXTRA_ID);
+        p = put16(p, extra);
+        if (large) {
+            p = put64(p, entry->size);
+            p = put64(p, entry->size);
+        }
+        if (far) {
+            p = put64(p, entry->offset);
+        }
+    }
+    return (size_t)(p - out);
+}
+
+size_t archive_zip_end(uint64_t entries, uint64_t directory_offset, uint64_t directory_size, uint8_t* out) {
+    bool zip64 = entries >= ZIP_MAX16 || directory_offset >= ZIP_MAX32 || directory_size >= ZIP_MAX32;
+    uint8_t* p = out;
+    if (zip64) {
+        uint64_t end64_offset = directory_offset + directory_size;
+        p = put32(p, ZIP64_END_SIGNATURE);
+        p = put64(p, 44);                       /* record size after this field */
+        p = put16(p, (3u << 8) | ZIP_VERSION_ZIP64);
+        p = put16(p, ZIP_VERSION_ZIP64);
+        p = put32(p, 0);
+        p = put32(p, 0);
+        p = put64(p, entries);
+        p = put64(p, entries);
+        p = put64(p, directory_size);
+        p = put64(p, directory_offset);
+
+        p = put32(p, ZIP64_LOCATOR_SIGNATURE);
+        p = put32(p, 0);
+        p = put64(p, end64_offset);
+        p = put32(p, 1);
+    }
+    p = put32(p, ZIP_END_SIGNATURE);
+    p = put16(p, 0);
+    p = put16(p, 0);
+    p = put16(p, zip64 ? ZIP_MAX16 : (uint32_t)entries);
+    p = put16(p, zip64 ? ZIP_MAX16 : (uint32_t)entries);
+    p = put32(p, zip64 ? ZIP_MAX32 : (uint32_t)directory_size);
+    p = put32(p, zip64 ? ZIP_MAX32 : (uint32_t)directory_offset);
+    p = put16(p, 0);
+    return (size_t)(p - out);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file archive_format.h
+ * @brief tar (ustar + pax) and zip (stored, zip64 when needed) encoding
+ *
+ * Pure byte encoders for the archive stream: they know nothing about
+ * objects or threads. Entries are never compressed; zip entries whose
+ * CRC is not known before their data carry a data descriptor.
+ */
+
+#ifndef ARCHIVE_FORMAT_H
+#define ARCHIVE_FORMAT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** tar block size; headers and data are padded to it */
+#define ARCHIVE_TAR_BLOCK 512
+
+/** Bytes of the tar end-of-archive marker (two zero blocks) */
+#define ARCHIVE_TAR_TRAILER_SIZE (2 * ARCHIVE_TAR_BLOCK)
+
+/** Largest zip data descriptor (signature, CRC, 64-bit sizes) */
+#define ARCHIVE_ZIP_DESCRIPTOR_MAX 24
+
+/** Largest zip end records (zip64 end record, its locator, end record) */
+#define ARCHIVE_ZIP_END_MAX (56 + 20 + 22)
+
+/**
+ * One zip entry, as far as its headers need it
+ */
+typedef struct {
+    const char* name;
+    size_t name_length;
+    uint64_t size;
+    int64_t mtime;                  /* Unix seconds */
+    uint32_t crc;                   /* Known before the data unless descriptor */
+    uint64_t offset;                /* Archive offset of the local header */
+    bool descriptor;                /* CRC follows the data in a data descriptor */
+} ArchiveZipEntry;
+
+/**
+ * Update a CRC-32 (IEEE, as zip uses) over @p length bytes; start from 0
+ */
+uint32_t archive_crc32(uint32_t crc, const uint8_t* data, size_t length);
+
+/** Bytes archive_tar_header() may write for a name of @p name_length bytes */
+size_t archive_tar_header_capacity(size_t name_length);
+
+/**
+ * Write the header blocks of a regular file: a pax extended header first
+ * when the name does not fit ustar or the size needs more than 11 octal
+ * digits
+ *
+ * @return Bytes written, a multiple of ARCHIVE_TAR_BLOCK
+ */
+size_t archive_tar_header(const char* name, size_t name_length, uint64_t size, int64_t mtime, uint8_t* out);
+
+/** Zero bytes that pad @p size bytes of data to a whole block */
+size_t archive_tar_padding(uint64_t size);
+
+/** Bytes archive_zip_local_header() / archive_zip_central_header() may write */
+size_t archive_zip_header_capacity(size_t name_length);
+
+/** Write the local file header of @p entry; @return bytes written */
+size_t archive_zip_local_header(const ArchiveZipEntry* entry, uint8_t* out);
+
+/** Write the data descriptor of @p entry (after its data); @return bytes written */
+size_t archive_zip_descriptor(const ArchiveZipEntry* entry, uint8_t* out);
+
+/** Write the central directory header of @p entry; @return bytes written */
+size_t archive_zip_central_header(const ArchiveZipEntry* entry, uint8_t* out);
+
+/**
+ * Write the end of central directory records, with the zip64 ones when a
+ * count or offset does not fit the classic record
+ *
+ * @return Bytes written
+ */
+size_t archive_zip_end(uint64_t entries, uint64_t directory_offset, uint64_t directory_size, uint8_t* out);
+
+#endif /* ARCHIVE_FORMAT_H */
@@ -0,0 +1,237 @@
+/**
+ * @file archive_ops.c
+ * @brief N-API entry points for archive streams
+ *
+ * The actual work is done in:
+ * - archive_execute.c (worker thread functions)
+ * - archive_complete.c (main thread completions and scheduling)
+ */
+
+#include "archive_ops.h"
+#include "archive_types.h"
+#include "archive_complete.h"
+#include "../common/handle_helpers.h"
+#include "../common/string_helpers.h"
+#include "../common/type_converters.h"
+#include "../common/buffer_helpers.h"
+#include "../common/result_helpers.h"
+#include "../common/error_registry.h"
+#include "../common/logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/** Handle finalizer: a stream collected without archiveClose */
+static void archive_state_release(void* attachment) {
+    ArchiveState* state = (ArchiveState*)attachment;
+    archive_close_state(state->env, state, false);
+}
+
+static ArchiveState* get_archive_state(napi_env env, napi_value js_handle) {
+    HandleWrapper* wrapper = get_handle_wrapper(env, js_handle, HANDLE_TYPE_ARCHIVE);
+    return wrapper != NULL ? (ArchiveState*)wrapper->attachment : NULL;
+}
+
+/**
+ * Add the keys of a JS array as entries
+ *
+ * @return 0 on success, -1 with a JS exception pending
+ */
+static int archive_add_keys(napi_env env, ArchiveState* state, napi_value keys) {
+    uint32_t length = 0;
+    napi_get_array_length(env, keys, &length);
+    state->entries = (ArchiveEntry**)calloc(length > 0 ? length : 1, sizeof(ArchiveEntry*));
+    if (state->entries == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return -1;
+    }
+    state->entry_capacity = length;
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element;
+        napi_get_element(env, keys, i, &element);
+        ArchiveEntry* entry = (ArchiveEntry*)calloc(1, sizeof(ArchiveEntry));
+        if (entry == NULL) {
+            napi_throw_error(env, NULL, "Out of memory");
+            return -1;
+        }
+        state->entries[state->entry_count++] = entry;
+        if (extract_string_required(env, element, "keys[]", &entry->key) != napi_ok) {
+            return -1;
+        }
+    }
+    state->listed = true;
+    return 0;
+}
+
+/* ========== archive_open ========== */
+
+napi_value archive_open(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4] = { NULL, NULL, NULL, NULL };
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+
+    if (argc < 3) {
+        return throw_type_error(env, "projectHandle, bucket, and keys or prefix are required");
+    }
+
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        return throw_type_error(env, "Invalid project handle");
+    }
+
+    bool is_array = false;
+    napi_valuetype source_type;
+    napi_is_array(env, argv[2], &is_array);
+    napi_typeof(env, argv[2], &source_type);
+    if (!is_array && source_type != napi_string) {
+        return throw_type_error(env, "keys must be an array of object keys or a prefix string");
+    }
+
+    /* Extract optional options */
+    ArchiveFormat format = ARCHIVE_FORMAT_TAR;
+    int64_t concurrency = ARCHIVE_DEFAULT_CONCURRENCY;
+    int64_t max_buffered = ARCHIVE_DEFAULT_MAX_BUFFERED;
+    if (argc >= 4) {
+        napi_valuetype type;
+        napi_typeof(env, argv[3], &type);
+        if (type == napi_object) {
+            char* format_name = get_string_property(env, argv[3], "format");
+            if (format_name != NULL) {
+                bool known = strcmp(format_name, "tar") == 0 || strcmp(format_name, "zip") == 0;
+                format = strcmp(format_name, "zip") == 0 ? ARCHIVE_FORMAT_ZIP : ARCHIVE_FORMAT_TAR;
+                free(format_name);
+                if (!known) {
+                    return throw_type_error(env, "format must be 'tar' or 'zip'");
+                }
+            }
+            concurrency = get_int64_property(env, argv[3], "concurrency", ARCHIVE_DEFAULT_CONCURRENCY);
+            max_buffered = get_int64_property(env, argv[3], "maxBufferedBytes", ARCHIVE_DEFAULT_MAX_BUFFERED);
+            if (concurrency < 1 || concurrency > ARCHIVE_MAX_CONCURRENCY) {
+                napi_throw_range_error(env, NULL, "concurrency must be between 1 and 64");
+                return NULL;
+            }
+            if (max_buffered < ARCHIVE_MIN_MAX_BUFFERED) {
+                napi_throw_range_error(env, NULL, "maxBufferedBytes must be at least 1 MiB");
+                return NULL;
+            }
+        }
+    }
+
+    ArchiveState* state = (ArchiveState*)calloc(1, sizeof(ArchiveState));
+    if (state == NULL) {
+        return throw_error(env, "Out of memory");
+    }
+    state->env = env;
+    state->project_handle = project_handle;
+    state->format = format;
+    state->concurrency = (uint32_t)concurrency;
+    state->max_buffered = (uint64_t)max_buffered;
+    /* Half the budget covers the fetches in flight, each up to the threshold */
+    state->stream_threshold = state->max_buffered / (2 * state->concurrency);
+    if (state->stream_threshold < ARCHIVE_MIN_STREAM_THRESHOLD) {
+        state->stream_threshold = ARCHIVE_MIN_STREAM_THRESHOLD;
+    }
+
+    int failed = extract_bucket_name(env, argv[1], "bucket", &state->bucket_name) != napi_ok;
+    if (!failed && is_array) {
+        failed = archive_add_keys(env, state, argv[2]);
+    } else if (!failed && extract_string(env, argv[2], &state->prefix) != napi_ok) {
+        failed = 1;
+        throw_type_error(env, "prefix must be a string");
+    }
+    napi_value external = failed ? NULL : create_handle_external(env, (size_t)state, HANDLE_TYPE_ARCHIVE, NULL, NULL);
+    if (external == NULL) {
+        state->closed = true;
+        archive_close_state(env, state, false);
+        return NULL;
+    }
+    HandleWrapper* wrapper = get_handle_wrapper(env, external, HANDLE_TYPE_ARCHIVE);
+    wrapper->attachment = state;
+    wrapper->attachment_free = archive_state_release;
+
+    LOG_DEBUG("archiveOpen: %s of %s in '%s' (concurrency %u, budget %llu, streaming above %llu)",
+              format == ARCHIVE_FORMAT_ZIP ? "zip" : "tar", state->prefix != NULL ? "prefix" : "keys",
+              state->bucket_name, state->concurrency, (unsigned long long)state->max_buffered,
+              (unsigned long long)state->stream_threshold);
+    archive_schedule(env, state);
+    return external;
+}
+
+/* ========== archive_read ========== */
+
+napi_value archive_read(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+
+    if (argc < 2) {
+        return throw_type_error(env, "archive handle and buffer are required");
+    }
+    if (get_handle_wrapper(env, argv[0], HANDLE_TYPE_ARCHIVE) == NULL) {
+        return throw_type_error(env, "Invalid archive handle");
+    }
+    void* buffer;
+    size_t buffer_length;
+    if (extract_buffer(env, argv[1], &buffer, &buffer_length) != napi_ok) {
+        return throw_type_error(env, "Second argument must be a Buffer, TypedArray or ArrayBuffer");
+    }
+
+    ArchiveState* state = get_archive_state(env, argv[0]);
+    if (state == NULL) {
+        return throw_error(env, "Archive stream is closed");
+    }
+    if (state->reading != NULL || state->parked != NULL) {
+        return throw_error(env, "An archive read is already in progress");
+    }
+
+    ArchiveReadData* read = (ArchiveReadData*)calloc(1, sizeof(ArchiveReadData));
+    if (read == NULL) {
+        return throw_error(env, "Out of memory");
+    }
+    read->state = state;
+    read->buffer = (uint8_t*)buffer;
+    read->length = buffer_length;
+    read->format = state->format;
+    read->project_handle = state->project_handle;
+
+    napi_value promise;
+    napi_create_promise(env, &read->deferred, &promise);
+    if (state->error_code != 0) {
+        napi_reject_deferred(env, read->deferred, create_typed_error(env, state->error_code, state->error_message));
+        free(read);
+        return promise;
+    }
+
+    pin_buffer(env, argv[1], read->length, &read->buffer_ref);
+    archive_submit_read(env, state, read);
+    return promise;
+}
+
+/* ========== archive_close ========== */
+
+napi_value archive_close(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+
+    if (argc < 1) {
+        return throw_type_error(env, "archive handle is required");
+    }
+    HandleWrapper* wrapper = get_handle_wrapper(env, argv[0], HANDLE_TYPE_ARCHIVE);
+    if (wrapper == NULL) {
+        return throw_type_error(env, "Invalid archive handle");
+    }
+
+    /* Closing twice is a no-op */
+    ArchiveState* state = (ArchiveState*)wrapper->attachment;
+    if (state != NULL) {
+        wrapper->attachment = NULL;
+        wrapper->attachment_free = NULL;
+        mark_handle_closed(env, argv[0], HANDLE_TYPE_ARCHIVE);
+        archive_close_state(env, state, true);
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
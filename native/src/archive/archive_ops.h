@@ -0,0 +1,55 @@
+/**
+ * @file archive_ops.h
+ * @brief Archive stream operations for uplink-nodejs
+ *
+ * Declares N-API bindings that pack many objects into one tar or zip
+ * byte stream, fetching objects ahead concurrently within a memory budget.
+ */
+
+#ifndef UPLINK_ARCHIVE_OPS_H
+#define UPLINK_ARCHIVE_OPS_H
+
+#include <node_api.h>
+
+/**
+ * Open an archive stream over a list of keys or every object below a prefix
+ * JS: archiveOpen(projectHandle, bucket, keysOrPrefix, options?) -> ArchiveHandle
+ *
+ * keysOrPrefix is an array of object keys (entries named by key, in
+ * order) or a prefix string (entries named by key minus the prefix, in
+ * listing order). Options: { format?: 'tar' | 'zip', concurrency?,
+ * maxBufferedBytes? }. Fetching starts at once; objects larger than
+ * maxBufferedBytes / (2 * concurrency) are streamed instead of buffered.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [projectHandle, bucket, keysOrPrefix, options?]
+ * @return Archive handle
+ */
+napi_value archive_open(napi_env env, napi_callback_info info);
+
+/**
+ * Read the next archive bytes into a buffer
+ * JS: archiveRead(archiveHandle, buffer) -> Promise<{ bytesRead, eof }>
+ *
+ * Waits for the next entry when it is still being fetched. Rejects with
+ * the entry's error when an object cannot be read; the stream is failed
+ * from then on. One read at a time.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [archiveHandle, buffer]
+ * @return Promise resolving to the bytes read and whether the archive ended
+ */
+napi_value archive_read(napi_env env, napi_callback_info info);
+
+/**
+ * Close an archive stream, rejecting a waiting read; downloads still
+ * open are closed once no job is in flight
+ * JS: archiveClose(archiveHandle) -> void
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [archiveHandle]
+ * @return undefined
+ */
+napi_value archive_close(napi_env env, napi_callback_info info);
+
+#endif /* UPLINK_ARCHIVE_OPS_H */
@@ -0,0 +1,191 @@
+/**
+ * @file archive_types.h
+ * @brief Type definitions for archive streams
+ *
+ * An archive stream packs many objects into one tar or zip byte stream.
+ * Objects are fetched ahead by pooled jobs, several at a time, while the
+ * reader drains entries strictly in order:
+ *
+ * - Small objects are read whole into memory; the bytes held this way,
+ *   plus a reservation for each fetch in flight, stay within
+ *   maxBufferedBytes. The entry being emitted is always fetched.
+ * - Objects above the stream threshold keep their download open and are
+ *   read straight into the caller's buffer as they are emitted; zip
+ *   writes their CRC in a data descriptor after the data.
+ *
+ * All scheduling state lives on the main thread. A read job works on a
+ * copy of the cursor and on the entries it was handed at queue time, and
+ * its completion commits the cursor back, so workers never see the
+ * entry list grow. Only one read runs at a time.
+ */
+
+#ifndef UPLINK_ARCHIVE_TYPES_H
+#define UPLINK_ARCHIVE_TYPES_H
+
+#include <node_api.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Disable compat macros to avoid function name conflicts */
+#define UPLINK_DISABLE_NAMESPACE_COMPAT
+#include "uplink.h"
+
+/** Default objects fetched at once */
+#define ARCHIVE_DEFAULT_CONCURRENCY 8
+
+/** Largest options.concurrency */
+#define ARCHIVE_MAX_CONCURRENCY 64
+
+/** Default memory budget for objects fetched ahead (64 MiB) */
+#define ARCHIVE_DEFAULT_MAX_BUFFERED (64 * 1024 * 1024)
+
+/** Smallest options.maxBufferedBytes (1 MiB) */
+#define ARCHIVE_MIN_MAX_BUFFERED (1024 * 1024)
+
+/** Objects at or below this size are always buffered (64 KiB) */
+#define ARCHIVE_MIN_STREAM_THRESHOLD (64 * 1024)
+
+/** Keys pulled from the listing per list job, and how far it runs ahead */
+#define ARCHIVE_LIST_BATCH 1000
+
+/** Largest single read from a download */
+#define ARCHIVE_READ_CHUNK (256 * 1024)
+
+typedef enum {
+    ARCHIVE_FORMAT_TAR,
+    ARCHIVE_FORMAT_ZIP,
+} ArchiveFormat;
+
+typedef enum {
+    ARCHIVE_ENTRY_PENDING,          /* Not handed to a fetch job yet */
+    ARCHIVE_ENTRY_FETCHING,         /* A fetch job owns the entry */
+    ARCHIVE_ENTRY_BUFFERED,         /* Body in @c data */
+    ARCHIVE_ENTRY_STREAMED,         /* Download open in @c download */
+    ARCHIVE_ENTRY_FAILED,           /* @c error_code / @c error_message say why */
+} ArchiveEntryState;
+
+/**
+ * One object of the archive. Entries are allocated one by one so read
+ * jobs can hold pointers while the list grows.
+ */
+typedef struct {
+    char* key;
+    size_t name_offset;             /* Entry name is key + name_offset (the key minus the prefix) */
+    ArchiveEntryState state;
+    uint64_t size;
+    int64_t mtime;                  /* Object creation time, Unix seconds */
+    uint32_t crc;                   /* zip: CRC-32 of the body, final once emitted */
+    uint64_t offset;                /* zip: archive offset of the local header */
+    uint8_t* data;                  /* BUFFERED: body; freed by the read job that emits it */
+    UplinkDownload* download;       /* STREAMED: open download; closed by the read job */
+    int32_t error_code;
+    char* error_message;
+} ArchiveEntry;
+
+typedef enum {
+    ARCHIVE_PHASE_HEADER,
+    ARCHIVE_PHASE_DATA,
+    ARCHIVE_PHASE_TRAILER,          /* tar padding or zip data descriptor */
+    ARCHIVE_PHASE_FOOTER,           /* tar end blocks or zip central directory */
+    ARCHIVE_PHASE_DONE,
+} ArchivePhase;
+
+/**
+ * Position of the archive byte stream
+ */
+typedef struct {
+    uint32_t entry;                 /* Entry being emitted; entry_count once all are */
+    ArchivePhase phase;
+    uint64_t phase_offset;          /* Bytes of the phase already emitted */
+    uint64_t archive_offset;        /* Bytes emitted so far */
+    uint8_t* scratch;               /* Header, trailer or footer bytes of the phase */
+    size_t scratch_length;
+} ArchiveCursor;
+
+struct ArchiveReadData;
+
+/**
+ * State of one archive stream, attached to its handle (main thread)
+ */
+typedef struct {
+    napi_env env;
+    size_t project_handle;
+    char* bucket_name;              /* Interned */
+    char* prefix;                   /* Listed prefix; NULL for a key list */
+    ArchiveFormat format;
+    uint32_t concurrency;
+    uint64_t max_buffered;
+    uint64_t stream_threshold;      /* Larger objects are streamed */
+    ArchiveEntry** entries;
+    uint32_t entry_count;
+    uint32_t entry_capacity;
+    uint32_t next_fetch;            /* Entries are fetched in order from here */
+    UplinkObjectIterator* iterator; /* Prefix listing, touched only by list jobs */
+    bool listing;                   /* A list job is in flight */
+    bool listed;                    /* Every entry is known */
+    uint32_t fetches;               /* Fetch jobs in flight */
+    uint32_t streams;               /* STREAMED entries not yet emitted */
+    uint64_t buffered;              /* Bytes of BUFFERED entries not yet emitted */
+    ArchiveCursor cursor;           /* Committed position; a read job works on a copy */
+    struct ArchiveReadData* reading; /* Read job in flight */
+    struct ArchiveReadData* parked; /* Read waiting for the next entry */
+    int32_t error_code;             /* The stream failed; later reads reject */
+    char* error_message;
+    bool closed;
+} ArchiveState;
+
+/**
+ * Data structure for a fetch job: open one object and, below the stream
+ * threshold, read it whole
+ */
+typedef struct {
+    ArchiveState* state;
+    ArchiveEntry* entry;            /* FETCHING: owned by this job */
+    size_t project_handle;
+    const char* bucket_name;
+    uint64_t stream_threshold;
+    bool crc;                       /* zip: checksum buffered bodies */
+    ArchiveEntryState outcome;
+} ArchiveFetchData;
+
+/**
+ * Data structure for a list job: pull the next keys below the prefix
+ */
+typedef struct {
+    ArchiveState* state;
+    size_t project_handle;
+    const char* bucket_name;
+    const char* prefix;
+    char** keys;
+    uint32_t key_count;
+    bool done;                      /* The listing is exhausted */
+    int32_t error_code;
+    char* error_message;
+} ArchiveListData;
+
+/**
+ * Data structure for archive_read
+ */
+typedef struct ArchiveReadData {
+    ArchiveState* state;
+    uint8_t* buffer;                /* Direct pointer to JS buffer (no copy) */
+    size_t length;
+    napi_ref buffer_ref;
+    napi_deferred deferred;
+    ArchiveFormat format;
+    size_t project_handle;          /* Bandwidth limits of streamed reads */
+    ArchiveCursor cursor;           /* Copy of the committed cursor, committed back on completion */
+    ArchiveEntry** ready;           /* Entries from cursor.entry that may be emitted */
+    uint32_t ready_count;
+    bool final;                     /* ready reaches the last entry; the footer may follow */
+    ArchiveEntry** all;             /* zip footer: every entry (final only) */
+    uint32_t all_count;
+    size_t bytes_read;
+    bool eof;
+    uint64_t released;              /* Buffered bytes emitted and freed */
+    uint32_t streams_closed;        /* Streamed entries emitted and closed */
+    int32_t error_code;
+    char* error_message;
+} ArchiveReadData;
+
+#endif /* UPLINK_ARCHIVE_TYPES_H */
@@ -11,6 +11,7 @@
 #include "../common/result_helpers.h"
 #include "../common/error_registry.h"
 #include "../common/cancel_helpers.h"
+#include "../common/known_buckets.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
@@ -54,6 +55,10 @@ void create_bucket_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
+    if (work_data->result.bucket != NULL) {
+        known_buckets_add(work_data->project_handle, work_data->known_epoch,
+                          work_data->result.bucket->name, work_data->result.bucket->created);
+    }
     napi_value bucket_obj = uplink_bucket_to_js(env, work_data->result.bucket);
     uplink_free_bucket_result(work_data->result);
     
@@ -80,6 +85,10 @@ void ensure_bucket_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
+    if (work_data->result.bucket != NULL) {
+        known_buckets_add(work_data->project_handle, work_data->known_epoch,
+                          work_data->result.bucket->name, work_data->result.bucket->created);
+    }
     napi_value bucket_obj = uplink_bucket_to_js(env, work_data->result.bucket);
     uplink_free_bucket_result(work_data->result);
     
@@ -122,6 +131,8 @@ cleanup:
 
 void delete_bucket_complete(napi_env env, napi_status status, void* data) {
     BucketOpData* work_data = (BucketOpData*)data;
+    /* Whatever the outcome, the bucket may be gone now */
+    known_buckets_forget(work_data->project_handle, work_data->bucket_name);
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "deleteBucket");
     
     if (work_data->result.error != NULL) {
@@ -153,6 +164,8 @@ cleanup:
 
 void delete_bucket_with_objects_complete(napi_env env, napi_status status, void* data) {
     BucketOpData* work_data = (BucketOpData*)data;
+    /* Whatever the outcome, the bucket may be gone now */
+    known_buckets_forget(work_data->project_handle, work_data->bucket_name);
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "deleteBucketWithObjects");
     
     if (work_data->result.error != NULL) {
@@ -286,3 +299,65 @@ cleanup:
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
+
+/* ========== bucketIteratorNextBatch complete ========== */
+
+void bucket_iterator_next_batch_complete(napi_env env, napi_status status, void* data) {
+    BucketIteratorBatchData* work_data = (BucketIteratorBatchData*)data;
+    REJECT_IF_CANCELLED(env, status, work_data->deferred, "bucketIteratorNextBatch");
+    
+    {
+        napi_value array;
+        napi_create_array_with_length(env, work_data->count, &array);
+        for (size_t i = 0; i < work_data->count; i++) {
+            napi_set_element(env, array, (uint32_t)i, uplink_bucket_to_js(env, work_data->buckets[i]));
+        }
+        
+        LOG_DEBUG("bucketIteratorNextBatch: returned %zu items", work_data->count);
+        napi_resolve_deferred(env, work_data->deferred, array);
+    }
+    
+cleanup:
+    for (size_t i = 0; i < work_data->count; i++) {
+        uplink_free_bucket(work_data->buckets[i]);
+    }
+    free(work_data->buckets);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== collectBuckets complete ========== */
+
+void collect_buckets_complete(napi_env env, napi_status status, void* data) {
+    CollectBucketsData* work_data = (CollectBucketsData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "collectBuckets", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("collectBuckets: failed - %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    {
+        napi_value array;
+        napi_create_array_with_length(env, work_data->count, &array);
+        for (size_t i = 0; i < work_data->count; i++) {
+            napi_set_element(env, array, (uint32_t)i, uplink_bucket_to_js(env, work_data->buckets[i]));
+        }
+        
+        LOG_DEBUG("collectBuckets: returned %zu buckets", work_data->count);
+        napi_resolve_deferred(env, work_data->deferred, array);
+    }
+    
+cleanup:
+    for (size_t i = 0; i < work_data->count; i++) {
+        uplink_free_bucket(work_data->buckets[i]);
+    }
+    free(work_data->buckets);
+    free(work_data->cursor);
+    free(work_data->error_message);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
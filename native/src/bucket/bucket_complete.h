@@ -26,5 +26,7 @@ void bucket_iterator_next_complete(napi_env env, napi_status status, void* data)
 void bucket_iterator_item_complete(napi_env env, napi_status status, void* data);
 void bucket_iterator_err_complete(napi_env env, napi_status status, void* data);
 void free_bucket_iterator_complete(napi_env env, napi_status status, void* data);
+void bucket_iterator_next_batch_complete(napi_env env, napi_status status, void* data);
+void collect_buckets_complete(napi_env env, napi_status status, void* data);
 
 #endif /* BUCKET_COMPLETE_H */
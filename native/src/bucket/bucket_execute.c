@@ -7,6 +7,7 @@
 
 #include "bucket_execute.h"
 #include "bucket_types.h"
+#include "../common/result_helpers.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
@@ -144,3 +145,78 @@ void free_bucket_iterator_execute(napi_env env, void* data) {
     UplinkBucketIterator* iterator = (UplinkBucketIterator*)work_data->iterator_handle;
     uplink_free_bucket_iterator(iterator);
 }
+
+/* ========== bucketIteratorNextBatch execute ========== */
+
+void bucket_iterator_next_batch_execute(napi_env env, void* data) {
+    (void)env;
+    BucketIteratorBatchData* work_data = (BucketIteratorBatchData*)data;
+    
+    UplinkBucketIterator* iterator = (UplinkBucketIterator*)work_data->iterator_handle;
+    while (work_data->count < work_data->max_items && uplink_bucket_iterator_next(iterator)) {
+        UplinkBucket* bucket = uplink_bucket_iterator_item(iterator);
+        if (bucket != NULL) {
+            work_data->buckets[work_data->count++] = bucket;
+        }
+    }
+    
+    LOG_DEBUG("bucketIteratorNextBatch: collected %zu of %zu items (worker thread)",
+              work_data->count, work_data->max_items);
+}
+
+/* ========== collectBuckets execute ========== */
+
+void collect_buckets_execute(napi_env env, void* data) {
+    (void)env;
+    CollectBucketsData* work_data = (CollectBucketsData*)data;
+    
+    if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        return;
+    }
+    
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkListBucketsOptions options = { 0 };
+    options.cursor = work_data->cursor;
+    
+    UplinkBucketIterator* iterator = uplink_list_buckets(&project, &options);
+    if (iterator == NULL) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("Failed to create bucket iterator");
+        return;
+    }
+    
+    size_t capacity = 0;
+    while ((work_data->max_items == 0 || work_data->count < work_data->max_items) &&
+           uplink_bucket_iterator_next(iterator)) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+            break;
+        }
+        UplinkBucket* bucket = uplink_bucket_iterator_item(iterator);
+        if (bucket == NULL) {
+            continue;
+        }
+        if (work_data->count == capacity) {
+            size_t grown = capacity ? capacity * 2 : 64;
+            UplinkBucket** resized = (UplinkBucket**)realloc(work_data->buckets, grown * sizeof(UplinkBucket*));
+            if (resized == NULL) {
+                uplink_free_bucket(bucket);
+                work_data->error_code = UPLINK_ERROR_INTERNAL;
+                work_data->error_message = strdup("Out of memory");
+                break;
+            }
+            work_data->buckets = resized;
+            capacity = grown;
+        }
+        work_data->buckets[work_data->count++] = bucket;
+    }
+    
+    UplinkError* error = work_data->error_code == 0 ? uplink_bucket_iterator_err(iterator) : NULL;
+    if (error != NULL) {
+        work_data->error_code = error->code;
+        work_data->error_message = strdup(error->message ? error->message : "listBuckets failed");
+        uplink_free_error(error);
+    }
+    uplink_free_bucket_iterator(iterator);
+    
+    LOG_DEBUG("collectBuckets: collected %zu buckets (worker thread)", work_data->count);
+}
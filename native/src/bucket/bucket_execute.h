@@ -19,5 +19,7 @@ void bucket_iterator_next_execute(napi_env env, void* data);
 void bucket_iterator_item_execute(napi_env env, void* data);
 void bucket_iterator_err_execute(napi_env env, void* data);
 void free_bucket_iterator_execute(napi_env env, void* data);
+void bucket_iterator_next_batch_execute(napi_env env, void* data);
+void collect_buckets_execute(napi_env env, void* data);
 
 #endif /* BUCKET_EXECUTE_H */
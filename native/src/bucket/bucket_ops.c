@@ -15,6 +15,10 @@
 #include "bucket_complete.h"
 #include "../common/handle_helpers.h"
 #include "../common/string_helpers.h"
+#include "../common/type_converters.h"
+#include "../common/thread_pool.h"
+#include "../common/admission.h"
+#include "../common/known_buckets.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
@@ -59,6 +63,7 @@ napi_value create_bucket(napi_env env, napi_callback_info info) {
     
     work_data->project_handle = project_handle;
     work_data->bucket_name = bucket_name;
+    work_data->known_epoch = known_buckets_epoch(project_handle);
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
@@ -66,16 +71,14 @@ napi_value create_bucket(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "createBucket", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         create_bucket_execute,
         create_bucket_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -105,6 +108,18 @@ napi_value ensure_bucket(napi_env env, napi_callback_info info) {
         return NULL;
     }
     
+    int64_t created;
+    if (known_buckets_lookup(project_handle, bucket_name, &created)) {
+        LOG_DEBUG("ensureBucket: bucket '%s' already known", bucket_name);
+        UplinkBucket known = { .name = bucket_name, .created = created };
+        napi_value promise;
+        napi_deferred deferred;
+        napi_create_promise(env, &deferred, &promise);
+        napi_resolve_deferred(env, deferred, uplink_bucket_to_js(env, &known));
+        free(bucket_name);
+        return promise;
+    }
+    
     LOG_DEBUG("ensureBucket: queuing async work for bucket '%s'", bucket_name);
     
     BucketOpData* work_data = (BucketOpData*)calloc(1, sizeof(BucketOpData));
@@ -116,6 +131,7 @@ napi_value ensure_bucket(napi_env env, napi_callback_info info) {
     
     work_data->project_handle = project_handle;
     work_data->bucket_name = bucket_name;
+    work_data->known_epoch = known_buckets_epoch(project_handle);
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
@@ -123,16 +139,14 @@ napi_value ensure_bucket(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "ensureBucket", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         ensure_bucket_execute,
         ensure_bucket_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -180,16 +194,14 @@ napi_value stat_bucket(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "statBucket", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         stat_bucket_execute,
         stat_bucket_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -237,16 +249,14 @@ napi_value delete_bucket(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "deleteBucket", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         delete_bucket_execute,
         delete_bucket_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -294,16 +304,14 @@ napi_value delete_bucket_with_objects(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "deleteBucketWithObjects", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_BULK, work_name,
         delete_bucket_with_objects_execute,
         delete_bucket_with_objects_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -366,16 +374,14 @@ napi_value list_buckets_create(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "listBucketsCreate", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         list_buckets_create_execute,
         list_buckets_create_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -416,16 +422,14 @@ napi_value bucket_iterator_next(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "bucketIteratorNext", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         bucket_iterator_next_execute,
         bucket_iterator_next_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -466,16 +470,14 @@ napi_value bucket_iterator_item(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "bucketIteratorItem", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         bucket_iterator_item_execute,
         bucket_iterator_item_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -516,16 +518,14 @@ napi_value bucket_iterator_err(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "bucketIteratorErr", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         bucket_iterator_err_execute,
         bucket_iterator_err_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -548,6 +548,7 @@ napi_value free_bucket_iterator(napi_env env, napi_callback_info info) {
         napi_throw_type_error(env, NULL, "Invalid bucket iterator handle");
         return NULL;
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_BUCKET_ITERATOR);
     
     LOG_DEBUG("freeBucketIterator: queuing async work");
     
@@ -565,15 +566,143 @@ napi_value free_bucket_iterator(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "freeBucketIterator", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         free_bucket_iterator_execute,
         free_bucket_iterator_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
+    return promise;
+}
+
+/* ========== bucketIteratorNextBatch ========== */
+
+napi_value bucket_iterator_next_batch(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "iteratorHandle and maxItems are required");
+        return NULL;
+    }
+    
+    size_t iterator_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_BUCKET_ITERATOR, &iterator_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid bucket iterator handle");
+        return NULL;
+    }
+    
+    int64_t max_items = 0;
+    if (napi_get_value_int64(env, argv[1], &max_items) != napi_ok || max_items <= 0) {
+        napi_throw_type_error(env, NULL, "maxItems must be a positive number");
+        return NULL;
+    }
+    if (max_items > BUCKET_ITERATOR_MAX_BATCH) {
+        max_items = BUCKET_ITERATOR_MAX_BATCH;
+    }
+    
+    BucketIteratorBatchData* work_data = (BucketIteratorBatchData*)calloc(1, sizeof(BucketIteratorBatchData));
+    if (work_data == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->buckets = (UplinkBucket**)calloc((size_t)max_items, sizeof(UplinkBucket*));
+    if (work_data->buckets == NULL) {
+        free(work_data);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->iterator_handle = iterator_handle;
+    work_data->max_items = (size_t)max_items;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "bucketIteratorNextBatch", NAPI_AUTO_LENGTH, &work_name);
+    
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
+        bucket_iterator_next_batch_execute,
+        bucket_iterator_next_batch_complete,
+        work_data,
+        &work_data->work
+    );
+    
+    return promise;
+}
+
+/* ========== collectBuckets ========== */
+
+napi_value collect_buckets(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "projectHandle is required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    napi_value options = NULL;
+    if (argc >= 2) {
+        napi_valuetype type;
+        napi_typeof(env, argv[1], &type);
+        if (type == napi_object) {
+            options = argv[1];
+        }
+    }
+    
+    int64_t max_items = options != NULL ? get_int64_property(env, options, "maxItems", 0) : 0;
+    if (max_items < 0) {
+        napi_throw_range_error(env, NULL, "maxItems must not be negative");
+        return NULL;
+    }
+    
+    LOG_DEBUG("collectBuckets: queuing async work");
+    
+    CollectBucketsData* work_data = (CollectBucketsData*)calloc(1, sizeof(CollectBucketsData));
+    if (work_data == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->max_items = (size_t)max_items;
+    if (options != NULL) {
+        work_data->cursor = get_string_property(env, options, "cursor");
+    }
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "collectBuckets", NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, options);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
+        collect_buckets_execute,
+        collect_buckets_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
     
     return promise;
 }
@@ -90,4 +90,23 @@ napi_value bucket_iterator_err(napi_env env, napi_callback_info info);
  */
 napi_value free_bucket_iterator(napi_env env, napi_callback_info info);
 
+/**
+ * Advance a bucket iterator by up to maxItems items in one async call
+ * JS: bucketIteratorNextBatch(iteratorHandle, maxItems) -> Promise<BucketInfo[]>
+ *
+ * Resolves with fewer than maxItems items (possibly none) once the
+ * listing is exhausted; check bucketIteratorErr() then.
+ */
+napi_value bucket_iterator_next_batch(napi_env env, napi_callback_info info);
+
+/**
+ * List every bucket of a project in one async call
+ * JS: collectBuckets(projectHandle, options?) -> Promise<BucketInfo[]>
+ *
+ * Drains uplink_list_buckets on a worker thread and converts the items
+ * in a single complete callback. options: { cursor?, maxItems?, cancelToken? };
+ * rejects with the iterator's error.
+ */
+napi_value collect_buckets(napi_env env, napi_callback_info info);
+
 #endif /* UPLINK_BUCKET_OPS_H */
@@ -12,6 +12,7 @@
 /* Disable compat macros to avoid function name conflicts */
 #define UPLINK_DISABLE_NAMESPACE_COMPAT
 #include "uplink.h"
+#include "../common/cancel_token.h"
 
 /* ========== Async Work Data Structures ========== */
 
@@ -23,6 +24,7 @@ typedef struct {
     size_t project_handle;
     char* bucket_name;
     UplinkBucketResult result;
+    uint64_t known_epoch;           /* Known bucket set epoch at start (create/ensure) */
     napi_deferred deferred;
     napi_async_work work;
 } BucketOpData;
@@ -72,6 +74,39 @@ typedef struct {
     napi_async_work work;
 } BucketIteratorErrData;
 
+/** Upper bound on items collected by one bucketIteratorNextBatch call */
+#define BUCKET_ITERATOR_MAX_BATCH 10000
+
+/**
+ * Data structure for bucket iterator batch
+ * Used by: bucket_iterator_next_batch
+ */
+typedef struct {
+    size_t iterator_handle;
+    size_t max_items;
+    UplinkBucket** buckets;     /* max_items slots, count filled */
+    size_t count;
+    napi_deferred deferred;
+    napi_async_work work;
+} BucketIteratorBatchData;
+
+/**
+ * Data structure for draining a bucket listing in one call
+ * Used by: collect_buckets
+ */
+typedef struct {
+    size_t project_handle;
+    char* cursor;
+    size_t max_items;           /* 0 for no cap */
+    UplinkBucket** buckets;
+    size_t count;
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    int32_t error_code;
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} CollectBucketsData;
+
 /**
  * Data structure for freeing a bucket iterator
  * Used by: free_bucket_iterator
@@ -0,0 +1,239 @@
+/**
+ * @file access_cache.c
+ * @brief Opt-in per-environment parseAccess cache implementation
+ *
+ * Laid out like stat_cache.c: a chained hash table of entries threaded
+ * on an LRU list, most recent at the head. The cache lives in the
+ * environment's AddonInstance.
+ *
+ * A handle sharing an entry stores no native_ptr, so the generic handle
+ * finalizer never frees the access itself; the entry is the handle's
+ * attachment and its attachment_free drops one reference. The cache
+ * holds one more while the entry is listed, so the UplinkAccess is freed
+ * exactly once, by whichever of eviction or the last collected handle
+ * comes last.
+ */
+
+#include "access_cache.h"
+#include "addon_instance.h"
+#include "logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct AccessCacheEntry {
+    char* grant;
+    size_t grant_length;
+    uint64_t hash;
+    UplinkAccess* access;
+    uint32_t refs;                  /* sharing handles, plus one while listed */
+    struct AccessCacheEntry* chain; /* Next in hash bucket */
+    struct AccessCacheEntry* prev;  /* LRU neighbours */
+    struct AccessCacheEntry* next;
+} AccessCacheEntry;
+
+struct AccessCache {
+    AccessCacheEntry** buckets;
+    size_t bucket_count;            /* Power of two */
+    AccessCacheEntry* head;         /* Most recently used */
+    AccessCacheEntry* tail;
+    AccessCacheStats stats;
+};
+
+/* ========== helpers ========== */
+
+static AccessCache* cache_of(napi_env env) {
+    AddonInstance* instance = addon_instance(env);
+    return instance != NULL ? instance->access_cache : NULL;
+}
+
+/** FNV-1a, 64-bit */
+static uint64_t hash_grant(const char* grant, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)grant[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static AccessCacheEntry** find_slot(AccessCache* cache, uint64_t hash, const char* grant, size_t length) {
+    AccessCacheEntry** slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+    while (*slot != NULL &&
+           !((*slot)->hash == hash && (*slot)->grant_length == length && memcmp((*slot)->grant, grant, length) == 0)) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+static void lru_unlink(AccessCache* cache, AccessCacheEntry* entry) {
+    if (entry->prev != NULL) entry->prev->next = entry->next; else cache->head = entry->next;
+    if (entry->next != NULL) entry->next->prev = entry->prev; else cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void lru_push_front(AccessCache* cache, AccessCacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head != NULL) cache->head->prev = entry; else cache->tail = entry;
+    cache->head = entry;
+}
+
+static void entry_unref(void* arg) {
+    AccessCacheEntry* entry = (AccessCacheEntry*)arg;
+    if (--entry->refs > 0) {
+        return;
+    }
+    UplinkAccessResult result = { .access = entry->access, .error = NULL };
+    uplink_free_access_result(result);
+    free(entry->grant);
+    free(entry);
+}
+
+/** Unlist the entry in @p slot, dropping the cache's reference */
+static void remove_entry(AccessCache* cache, AccessCacheEntry** slot) {
+    AccessCacheEntry* entry = *slot;
+    *slot = entry->chain;
+    entry->chain = NULL;
+    lru_unlink(cache, entry);
+    cache->stats.entries--;
+    entry_unref(entry);
+}
+
+static void remove_lookup(AccessCache* cache, AccessCacheEntry* entry) {
+    remove_entry(cache, find_slot(cache, entry->hash, entry->grant, entry->grant_length));
+}
+
+/** Wrap @p entry in a new access handle holding a reference */
+static napi_value share_entry(napi_env env, AccessCacheEntry* entry) {
+    napi_value external = create_handle_external(env, entry->access->_handle, HANDLE_TYPE_ACCESS, NULL, NULL);
+    if (external == NULL) {
+        return NULL;
+    }
+    HandleWrapper* wrapper = get_handle_wrapper(env, external, HANDLE_TYPE_ACCESS);
+    wrapper->attachment = entry;
+    wrapper->attachment_free = entry_unref;
+    entry->refs++;
+    return external;
+}
+
+/* ========== public API ========== */
+
+int access_cache_enable(napi_env env, size_t max_entries) {
+    AddonInstance* instance = addon_instance(env);
+    if (instance == NULL) return -1;
+    access_cache_disable(env);
+
+    AccessCache* cache = (AccessCache*)calloc(1, sizeof(AccessCache));
+    if (cache == NULL) return -1;
+
+    cache->bucket_count = 16;
+    while (cache->bucket_count < max_entries) {
+        cache->bucket_count <<= 1;
+    }
+    cache->buckets = (AccessCacheEntry**)calloc(cache->bucket_count, sizeof(AccessCacheEntry*));
+    if (cache->buckets == NULL) {
+        free(cache);
+        return -1;
+    }
+    cache->stats.max_entries = max_entries;
+    instance->access_cache = cache;
+
+    LOG_INFO("access cache enabled (max %zu entries)", max_entries);
+    return 0;
+}
+
+void access_cache_disable(napi_env env) {
+    AddonInstance* instance = addon_instance(env);
+    if (instance == NULL || instance->access_cache == NULL) return;
+    access_cache_destroy(instance->access_cache);
+    instance->access_cache = NULL;
+    LOG_DEBUG("access cache disabled");
+}
+
+bool access_cache_enabled(napi_env env) {
+    return cache_of(env) != NULL;
+}
+
+napi_value access_cache_lookup(napi_env env, const char* grant) {
+    AccessCache* cache = cache_of(env);
+    if (cache == NULL) return NULL;
+
+    size_t length = strlen(grant);
+    AccessCacheEntry* entry = *find_slot(cache, hash_grant(grant, length), grant, length);
+    if (entry == NULL) {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    napi_value external = share_entry(env, entry);
+    if (external == NULL) {
+        return NULL;
+    }
+    lru_unlink(cache, entry);
+    lru_push_front(cache, entry);
+    cache->stats.hits++;
+    return external;
+}
+
+napi_value access_cache_insert(napi_env env, const char* grant, UplinkAccess* access) {
+    AccessCache* cache = cache_of(env);
+    if (cache == NULL || access == NULL) return NULL;
+
+    size_t length = strlen(grant);
+    uint64_t hash = hash_grant(grant, length);
+    AccessCacheEntry** slot = find_slot(cache, hash, grant, length);
+    if (*slot != NULL) {
+        /* Parsed twice concurrently; the newer parse replaces the listing */
+        remove_entry(cache, slot);
+        slot = find_slot(cache, hash, grant, length);
+    }
+
+    AccessCacheEntry* entry = (AccessCacheEntry*)calloc(1, sizeof(AccessCacheEntry));
+    if (entry == NULL) return NULL;
+    entry->grant = (char*)malloc(length + 1);
+    if (entry->grant == NULL) {
+        free(entry);
+        return NULL;
+    }
+    memcpy(entry->grant, grant, length + 1);
+    entry->grant_length = length;
+    entry->hash = hash;
+    entry->access = access;
+
+    /* The first handle's reference, before the cache's, so a failure frees nothing */
+    napi_value external = share_entry(env, entry);
+    if (external == NULL) {
+        free(entry->grant);
+        free(entry);
+        return NULL;
+    }
+    entry->refs++;
+    *slot = entry;
+    lru_push_front(cache, entry);
+    cache->stats.entries++;
+
+    while (cache->stats.entries > cache->stats.max_entries && cache->tail != NULL) {
+        remove_lookup(cache, cache->tail);
+        cache->stats.evictions++;
+    }
+    return external;
+}
+
+bool access_cache_is_shared(const HandleWrapper* wrapper) {
+    return wrapper != NULL && wrapper->attachment_free == entry_unref;
+}
+
+int access_cache_stats(napi_env env, AccessCacheStats* out) {
+    AccessCache* cache = cache_of(env);
+    if (cache == NULL) return -1;
+    *out = cache->stats;
+    return 0;
+}
+
+void access_cache_destroy(AccessCache* cache) {
+    while (cache->head != NULL) {
+        remove_lookup(cache, cache->head);
+    }
+    free(cache->buckets);
+    free(cache);
+}
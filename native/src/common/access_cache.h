@@ -0,0 +1,93 @@
+/**
+ * @file access_cache.h
+ * @brief Opt-in per-environment parseAccess cache for uplink-nodejs native module
+ *
+ * A bounded LRU of parsed access grants keyed by the serialized grant.
+ * A hit hands back a new access handle that shares the cached
+ * UplinkAccess instead of parsing again. Entries are reference-counted
+ * by the cache and by every handle sharing them: an evicted entry lives
+ * on until its last handle is collected, and only then is the access
+ * freed. Main thread only.
+ */
+
+#ifndef UPLINK_ACCESS_CACHE_H
+#define UPLINK_ACCESS_CACHE_H
+
+#include <node_api.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "handle_helpers.h"
+#include "uplink.h"
+
+/** Default entry limit for enableAccessCache */
+#define ACCESS_CACHE_DEFAULT_MAX_ENTRIES 4096
+
+typedef struct AccessCache AccessCache;
+
+/**
+ * Counters for one environment's cache
+ */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t entries;
+    size_t max_entries;
+} AccessCacheStats;
+
+/**
+ * Enable (or reconfigure, dropping all entries) the cache of @p env
+ *
+ * Handles already sharing a dropped entry keep working.
+ *
+ * @return 0 on success, -1 on OOM
+ */
+int access_cache_enable(napi_env env, size_t max_entries);
+
+/**
+ * Disable the cache of @p env (no-op when disabled)
+ */
+void access_cache_disable(napi_env env);
+
+/**
+ * Whether @p env has a cache
+ */
+bool access_cache_enabled(napi_env env);
+
+/**
+ * Look up @p grant, counting a hit or a miss
+ *
+ * @return A new access handle sharing the cached access, or NULL on a
+ *         miss or when the cache is disabled
+ */
+napi_value access_cache_lookup(napi_env env, const char* grant);
+
+/**
+ * Cache a freshly parsed access under @p grant and wrap it in a handle
+ *
+ * @param access Parsed access; owned by the cache on success
+ * @return The access handle, or NULL (the caller still owns @p access)
+ *         when the cache is disabled or out of memory
+ */
+napi_value access_cache_insert(napi_env env, const char* grant, UplinkAccess* access);
+
+/**
+ * Whether @p wrapper shares its access with other handles through the cache
+ */
+bool access_cache_is_shared(const HandleWrapper* wrapper);
+
+/**
+ * Read the counters of @p env's cache
+ *
+ * @return 0 on success, -1 when the cache is disabled
+ */
+int access_cache_stats(napi_env env, AccessCacheStats* out);
+
+/**
+ * Free a cache; entries still shared by handles outlive it. Called
+ * from access_cache_disable and the instance finalizer.
+ */
+void access_cache_destroy(AccessCache* cache);
+
+#endif /* UPLINK_ACCESS_CACHE_H */
@@ -0,0 +1,67 @@
+/**
+ * @file addon_instance.c
+ * @brief Per-environment state of the uplink-nodejs native module
+ */
+
+#include "addon_instance.h"
+#include "access_cache.h"
+#include "key_cache.h"
+#include "op_metrics.h"
+#include "object_converter.h"
+#include "library_loader.h"
+#include "logger.h"
+
+#include <stdlib.h>
+
+/** Instance data finalizer: runs when the environment is torn down */
+static void addon_instance_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    AddonInstance* instance = (AddonInstance*)data;
+    handle_slabs_destroy(env, instance->handle_slabs);
+    bucket_names_destroy(&instance->bucket_names);
+    if (instance->access_cache != NULL) {
+        access_cache_destroy(instance->access_cache);
+    }
+    if (instance->key_cache != NULL) {
+        key_cache_destroy(instance->key_cache);
+    }
+    if (instance->op_metrics != NULL) {
+        op_metrics_destroy(instance->op_metrics);
+    }
+    object_keys_cleanup(env, instance);
+    error_registry_cleanup(env, instance);
+    if (instance->holds_library) {
+        unload_uplink_library();
+    }
+    free(instance);
+    LOG_DEBUG("Native module instance released");
+}
+
+int addon_instance_init(napi_env env) {
+    AddonInstance* instance = (AddonInstance*)calloc(1, sizeof(AddonInstance));
+    if (instance == NULL) {
+        return -1;
+    }
+    if (napi_set_instance_data(env, instance, addon_instance_finalize, NULL) != napi_ok) {
+        free(instance);
+        return -1;
+    }
+    
+    /* Each instance holds a reference; the last one to go closes it */
+    if (load_uplink_library() == 0) {
+        instance->holds_library = 1;
+    } else {
+        LOG_WARN("uplink library not found - module will work in stub mode");
+        /* Don't throw error here - allow module to load for testing */
+        /* The actual functions will throw if library is not loaded */
+    }
+    return 0;
+}
+
+AddonInstance* addon_instance(napi_env env) {
+    void* data = NULL;
+    if (napi_get_instance_data(env, &data) != napi_ok) {
+        return NULL;
+    }
+    return (AddonInstance*)data;
+}
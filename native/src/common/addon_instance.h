@@ -0,0 +1,51 @@
+/**
+ * @file addon_instance.h
+ * @brief Per-environment state of the uplink-nodejs native module
+ *
+ * The addon can be loaded by the main thread and by any number of
+ * worker_threads at once. Everything tied to one JS environment lives in
+ * an AddonInstance stored with napi_set_instance_data and freed when that
+ * environment is torn down. Process-wide state is limited to the
+ * uplink-c library handle (reference-counted, see library_loader.h) and
+ * the native thread pool, which keeps a completion channel per env.
+ */
+
+#ifndef UPLINK_ADDON_INSTANCE_H
+#define UPLINK_ADDON_INSTANCE_H
+
+#include <node_api.h>
+#include "error_registry.h"
+#include "handle_helpers.h"
+#include "string_helpers.h"
+
+typedef struct AddonInstance {
+    napi_ref error_constructors[ERROR_CLASS_COUNT]; /* indexed like the error registry */
+    napi_ref error_base;                            /* Error of the realm the classes extend */
+    uint8_t stackless_errors[ERROR_CLASS_COUNT];    /* created without a stack trace */
+    int errors_registered;
+    int holds_library;                              /* took a library reference */
+    HandleSlab handle_slabs[HANDLE_TYPE_COUNT];
+    BucketNameTable bucket_names;                   /* interned by extract_bucket_name */
+    struct AccessCache* access_cache;               /* NULL unless enableAccessCache was called */
+    struct KeyCache* key_cache;                     /* NULL unless enableEncryptionKeyCache was called */
+    struct OpMetricsRegistry* op_metrics;           /* created by the first timed job */
+    struct PoolEnv* pool_env;                       /* thread pool completion channel, created by the first pooled job */
+    napi_ref object_keys;                           /* array of converted-object property names */
+} AddonInstance;
+
+/**
+ * Create the instance of @p env and take a reference on the uplink library.
+ * Called once from module init.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int addon_instance_init(napi_env env);
+
+/**
+ * Get the instance of @p env (main thread of that env only)
+ *
+ * @return The instance, or NULL if init failed
+ */
+AddonInstance* addon_instance(napi_env env);
+
+#endif /* UPLINK_ADDON_INSTANCE_H */
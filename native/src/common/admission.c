@@ -0,0 +1,268 @@
+/**
+ * @file admission.c
+ * @brief Per-project admission control implementation
+ *
+ * Projects with limits live on a small global list keyed by project
+ * handle. Each keeps, per class, a running count, a limit and a FIFO of
+ * slots whose async work is created but not yet submitted to the pool.
+ * A gated job's execute and complete callbacks are wrapped so the slot
+ * is released, and the next waiter submitted, once the real complete
+ * callback has run. Everything runs on the main thread.
+ */
+
+#include "admission.h"
+#include "logger.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+typedef struct {
+    AdmissionSlot* head;
+    AdmissionSlot* tail;
+    uint32_t queued;
+    uint32_t active;
+    uint32_t limit;                 /* 0 = unlimited */
+} AdmissionQueue;
+
+typedef struct AdmissionProject {
+    size_t project_handle;
+    AdmissionQueue classes[ADMISSION_CLASS_COUNT];
+    bool removed;                   /* closed; freed once drained */
+    struct AdmissionProject* next;
+} AdmissionProject;
+
+struct AdmissionSlot {
+    struct AdmissionSlot* next;     /* FIFO link while waiting */
+    AdmissionProject* project;
+    AdmissionClass cls;
+    napi_env env;
+    ThreadPoolLane lane;
+    napi_async_work work;
+    napi_async_execute_callback execute;
+    napi_async_complete_callback complete;
+    void* data;
+    OpTimer timer;                  /* started when queued, so admission wait counts as queued */
+    AdmissionSlot** hold;           /* session slot destination, or NULL */
+    bool kept;
+};
+
+static AdmissionProject* projects = NULL;
+
+static const char* const class_names[ADMISSION_CLASS_COUNT] = { "transfer", "metadata" };
+
+/* ========== helpers ========== */
+
+static AdmissionProject* find_project(size_t project_handle) {
+    for (AdmissionProject* project = projects; project != NULL; project = project->next) {
+        if (project->project_handle == project_handle) {
+            return project;
+        }
+    }
+    return NULL;
+}
+
+static void unlink_project(AdmissionProject* project) {
+    for (AdmissionProject** link = &projects; *link != NULL; link = &(*link)->next) {
+        if (*link == project) {
+            *link = project->next;
+            return;
+        }
+    }
+}
+
+/** Free a closed project once nothing refers to it */
+static void maybe_free_project(AdmissionProject* project) {
+    if (!project->removed) {
+        return;
+    }
+    for (int i = 0; i < ADMISSION_CLASS_COUNT; i++) {
+        if (project->classes[i].active > 0 || project->classes[i].queued > 0) {
+            return;
+        }
+    }
+    free(project);
+}
+
+static bool queue_has_room(const AdmissionQueue* queue) {
+    return queue->limit == 0 || queue->active < queue->limit;
+}
+
+static void admission_execute(napi_env env, void* data) {
+    AdmissionSlot* slot = (AdmissionSlot*)data;
+    slot->execute(env, slot->data);
+}
+
+static void admission_complete(napi_env env, napi_status status, void* data) {
+    AdmissionSlot* slot = (AdmissionSlot*)data;
+    if (slot->hold != NULL) {
+        *slot->hold = slot;
+    }
+    /* Deletes the async work and frees the job's data; the slot is ours */
+    slot->complete(env, status, slot->data);
+    if (!slot->kept) {
+        admission_release(slot);
+    }
+}
+
+static void start_slot(AdmissionSlot* slot) {
+    slot->project->classes[slot->cls].active++;
+    thread_pool_submit(slot->env, slot->lane, slot->work, admission_execute, admission_complete, slot,
+                       &slot->timer);
+}
+
+/** Start waiting slots of @p cls while there is room */
+static void pump_class(AdmissionProject* project, AdmissionClass cls) {
+    AdmissionQueue* queue = &project->classes[cls];
+    while (queue->head != NULL && queue_has_room(queue)) {
+        AdmissionSlot* slot = queue->head;
+        queue->head = slot->next;
+        if (queue->head == NULL) {
+            queue->tail = NULL;
+        }
+        queue->queued--;
+        slot->next = NULL;
+        start_slot(slot);
+    }
+}
+
+/* ========== public API ========== */
+
+int admission_configure(size_t project_handle, uint32_t max_transfers, uint32_t max_metadata) {
+    AdmissionProject* project = find_project(project_handle);
+    if (project == NULL) {
+        project = (AdmissionProject*)calloc(1, sizeof(AdmissionProject));
+        if (project == NULL) {
+            return -1;
+        }
+        project->project_handle = project_handle;
+        project->next = projects;
+        projects = project;
+    }
+    
+    project->classes[ADMISSION_TRANSFER].limit = max_transfers;
+    project->classes[ADMISSION_METADATA].limit = max_metadata;
+    for (int i = 0; i < ADMISSION_CLASS_COUNT; i++) {
+        pump_class(project, (AdmissionClass)i);
+    }
+    LOG_DEBUG("admission: project %zu maxConcurrentTransfers=%u maxConcurrentMetadataOps=%u",
+              project_handle, max_transfers, max_metadata);
+    return 0;
+}
+
+void admission_remove(size_t project_handle) {
+    AdmissionProject* project = find_project(project_handle);
+    if (project == NULL) {
+        return;
+    }
+    unlink_project(project);
+    project->removed = true;
+    maybe_free_project(project);
+}
+
+napi_status admission_queue_work(napi_env env, size_t project_handle, AdmissionClass cls,
+                                 ThreadPoolLane lane, napi_value name,
+                                 napi_async_execute_callback execute,
+                                 napi_async_complete_callback complete,
+                                 void* data, napi_async_work* result, AdmissionSlot** hold) {
+    AdmissionProject* project = find_project(project_handle);
+    AdmissionSlot* slot = project != NULL ? (AdmissionSlot*)calloc(1, sizeof(AdmissionSlot)) : NULL;
+    if (slot == NULL) {
+        /* No limits for this project (or OOM): run ungated */
+        return thread_pool_queue_work(env, lane, name, execute, complete, data, result);
+    }
+    
+    napi_status status = napi_create_async_work(env, NULL, name, admission_execute, admission_complete,
+                                                slot, result);
+    if (status != napi_ok) {
+        free(slot);
+        return status;
+    }
+    slot->project = project;
+    slot->cls = cls;
+    slot->env = env;
+    slot->lane = lane;
+    slot->work = *result;
+    slot->execute = execute;
+    slot->complete = complete;
+    slot->data = data;
+    slot->timer = op_metrics_start(env, name);
+    slot->hold = hold;
+    
+    AdmissionQueue* queue = &project->classes[cls];
+    if (queue->head == NULL && queue_has_room(queue)) {
+        start_slot(slot);
+        return napi_ok;
+    }
+    
+    if (queue->tail != NULL) {
+        queue->tail->next = slot;
+    } else {
+        queue->head = slot;
+    }
+    queue->tail = slot;
+    queue->queued++;
+    LOG_DEBUG("admission: project %zu %s call waiting (%u active, %u queued)",
+              project_handle, class_names[cls], queue->active, queue->queued);
+    return napi_ok;
+}
+
+int admission_cancel(napi_env env, napi_async_work work) {
+    for (AdmissionProject* project = projects; project != NULL; project = project->next) {
+        for (int i = 0; i < ADMISSION_CLASS_COUNT; i++) {
+            AdmissionQueue* queue = &project->classes[i];
+            AdmissionSlot* prev = NULL;
+            for (AdmissionSlot* slot = queue->head; slot != NULL; prev = slot, slot = slot->next) {
+                if (slot->work != work) {
+                    continue;
+                }
+                if (prev != NULL) {
+                    prev->next = slot->next;
+                } else {
+                    queue->head = slot->next;
+                }
+                if (queue->tail == slot) {
+                    queue->tail = prev;
+                }
+                queue->queued--;
+                /* Never started, so it holds no slot: no release, no hand-over */
+                slot->complete(env, napi_cancelled, slot->data);
+                free(slot);
+                return 0;
+            }
+        }
+    }
+    return -1;
+}
+
+AdmissionSlot* admission_keep(AdmissionSlot* slot) {
+    if (slot != NULL) {
+        slot->kept = true;
+    }
+    return slot;
+}
+
+void admission_release(AdmissionSlot* slot) {
+    if (slot == NULL) {
+        return;
+    }
+    AdmissionProject* project = slot->project;
+    AdmissionClass cls = slot->cls;
+    free(slot);
+    
+    project->classes[cls].active--;
+    pump_class(project, cls);
+    maybe_free_project(project);
+}
+
+int admission_stats(size_t project_handle, AdmissionStats* out) {
+    AdmissionProject* project = find_project(project_handle);
+    if (project == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < ADMISSION_CLASS_COUNT; i++) {
+        out->active[i] = project->classes[i].active;
+        out->queued[i] = project->classes[i].queued;
+        out->limit[i] = project->classes[i].limit;
+    }
+    return 0;
+}
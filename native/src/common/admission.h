@@ -0,0 +1,114 @@
+/**
+ * @file admission.h
+ * @brief Per-project admission control for uplink-nodejs native module
+ *
+ * Bounds how many transfers and metadata calls of one project run at a
+ * time. Calls over a limit wait in a FIFO inside the binding and start
+ * as earlier ones finish, so a burst of calls cannot pin an unbounded
+ * number of buffers or flood the satellite.
+ *
+ * Most calls hold their slot for the duration of one async job. A
+ * streaming upload or download holds a transfer slot from uploadObject
+ * or downloadObject until it is committed, aborted or closed (or its
+ * handle is garbage collected). Main thread only.
+ */
+
+#ifndef UPLINK_ADMISSION_H
+#define UPLINK_ADMISSION_H
+
+#include <node_api.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "thread_pool.h"
+
+/** Upper bound accepted for a limit */
+#define ADMISSION_MAX_LIMIT 65536
+
+/**
+ * Classes of calls with separate limits
+ */
+typedef enum {
+    ADMISSION_TRANSFER = 0,          /* uploads and downloads */
+    ADMISSION_METADATA,              /* stat, list, delete, bucket and multipart bookkeeping */
+    ADMISSION_CLASS_COUNT
+} AdmissionClass;
+
+/** A granted slot; opaque */
+typedef struct AdmissionSlot AdmissionSlot;
+
+/**
+ * Queue depth gauges of one project
+ */
+typedef struct {
+    uint32_t active[ADMISSION_CLASS_COUNT];
+    uint32_t queued[ADMISSION_CLASS_COUNT];
+    uint32_t limit[ADMISSION_CLASS_COUNT];   /* 0 = unlimited */
+} AdmissionStats;
+
+/**
+ * Set the limits of a project (0 = unlimited)
+ *
+ * Raising a limit starts waiting calls right away; lowering it lets
+ * running calls finish.
+ *
+ * @return 0 on success, -1 on OOM
+ */
+int admission_configure(size_t project_handle, uint32_t max_transfers, uint32_t max_metadata);
+
+/**
+ * Forget the limits of a project when it is closed
+ *
+ * Calls already waiting still run in order; the bookkeeping is freed
+ * once the last of them finishes.
+ */
+void admission_remove(size_t project_handle);
+
+/**
+ * Create async work that runs on the addon pool once admitted
+ *
+ * Same contract as thread_pool_queue_work(). Without limits for the
+ * project the work is queued right away.
+ *
+ * @param hold When non-NULL, the slot outlives the job: *hold receives
+ *             it just before @p complete runs, and @p complete takes it
+ *             over with admission_keep(). Left NULL when ungated.
+ * @return napi_ok on success
+ */
+napi_status admission_queue_work(napi_env env, size_t project_handle, AdmissionClass cls,
+                                 ThreadPoolLane lane, napi_value name,
+                                 napi_async_execute_callback execute,
+                                 napi_async_complete_callback complete,
+                                 void* data, napi_async_work* result, AdmissionSlot** hold);
+
+/**
+ * Drop a call that is still waiting for a slot
+ *
+ * Its complete callback runs right away with napi_cancelled.
+ *
+ * @param work Async work handle returned by admission_queue_work()
+ * @return 0 if the call was waiting, -1 otherwise
+ */
+int admission_cancel(napi_env env, napi_async_work work);
+
+/**
+ * Take over the slot handed to a complete callback through @p hold
+ *
+ * A slot that is not kept is released when the callback returns.
+ *
+ * @return @p slot (NULL stays NULL)
+ */
+AdmissionSlot* admission_keep(AdmissionSlot* slot);
+
+/**
+ * Release a kept slot and start the next waiting call (NULL is a no-op)
+ */
+void admission_release(AdmissionSlot* slot);
+
+/**
+ * Read the gauges of a project
+ *
+ * @return 0 on success, -1 when the project has no limits
+ */
+int admission_stats(size_t project_handle, AdmissionStats* out);
+
+#endif /* UPLINK_ADMISSION_H */
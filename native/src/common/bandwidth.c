@@ -0,0 +1,389 @@
+/**
+ * @file bandwidth.c
+ * @brief Token-bucket bandwidth limits with weighted fair sharing
+ *
+ * One lock guards every bucket. A grant first waits on its project's
+ * bucket, which no other project touches, then joins the direction's
+ * queue, ordered by virtual finish tag. Only the head of the queue may
+ * take tokens from the process-wide bucket; it sleeps for exactly the
+ * refill it needs, the others until the head leaves. Waits are capped at
+ * BANDWIDTH_POLL_NS so an aborted cancel token is noticed promptly.
+ */
+
+#include "bandwidth.h"
+#include "type_converters.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/** Tokens a bucket may bank, as a fraction of a second of traffic */
+#define BANDWIDTH_BURST_DIVISOR 4
+
+/** A grant is at most 1/BANDWIDTH_SLICE_DIVISOR of a second of traffic... */
+#define BANDWIDTH_SLICE_DIVISOR 16
+
+/** ...but never smaller or larger than these */
+#define BANDWIDTH_MIN_SLICE (4 * 1024)
+#define BANDWIDTH_MAX_SLICE (1024 * 1024)
+
+/** Longest single sleep, so cancellation and rate changes are seen */
+#define BANDWIDTH_POLL_NS (50ULL * 1000 * 1000)
+
+typedef struct {
+    uint64_t rate;              /* Bytes per second, 0 = unlimited */
+    double tokens;
+    uint64_t refilled;          /* uv_hrtime() of the last refill */
+} BandwidthBucket;
+
+typedef struct BandwidthWaiter {
+    struct BandwidthWaiter* next;
+    double tag;                 /* Virtual finish tag */
+} BandwidthWaiter;
+
+typedef struct BandwidthProject {
+    struct BandwidthProject* next;
+    size_t project_handle;
+    uint32_t weight;
+    uint32_t users;             /* bandwidth_acquire() calls holding a pointer */
+    bool removed;               /* Unlinked; freed when the last user leaves */
+    BandwidthBucket buckets[BANDWIDTH_DIRECTION_COUNT];
+    double finish[BANDWIDTH_DIRECTION_COUNT];   /* Tag of the project's latest grant */
+} BandwidthProject;
+
+typedef struct {
+    BandwidthBucket bucket;     /* Process-wide limit */
+    double vtime;               /* Start tag of the latest grant */
+    BandwidthWaiter* queue;     /* Sorted by tag, FIFO among equal tags */
+} BandwidthLink;
+
+static uv_once_t bandwidth_once = UV_ONCE_INIT;
+static uv_mutex_t bandwidth_lock;
+static uv_cond_t bandwidth_changed;
+static BandwidthLink links[BANDWIDTH_DIRECTION_COUNT];
+static BandwidthProject* projects;
+
+static void bandwidth_init(void) {
+    uv_mutex_init(&bandwidth_lock);
+    uv_cond_init(&bandwidth_changed);
+}
+
+/* ========== buckets (lock held) ========== */
+
+static size_t bucket_slice(const BandwidthBucket* bucket) {
+    uint64_t slice = bucket->rate / BANDWIDTH_SLICE_DIVISOR;
+    if (slice < BANDWIDTH_MIN_SLICE) {
+        return BANDWIDTH_MIN_SLICE;
+    }
+    return slice > BANDWIDTH_MAX_SLICE ? BANDWIDTH_MAX_SLICE : (size_t)slice;
+}
+
+static double bucket_capacity(const BandwidthBucket* bucket) {
+    double burst = (double)bucket->rate / BANDWIDTH_BURST_DIVISOR;
+    double slice = (double)bucket_slice(bucket);
+    return burst > slice ? burst : slice;
+}
+
+static void bucket_set_rate(BandwidthBucket* bucket, uint64_t rate) {
+    bucket->rate = rate;
+    bucket->tokens = rate > 0 ? bucket_capacity(bucket) : 0;
+    bucket->refilled = uv_hrtime();
+}
+
+static void bucket_refill(BandwidthBucket* bucket, uint64_t now) {
+    if (now > bucket->refilled) {
+        bucket->tokens += (double)bucket->rate * (double)(now - bucket->refilled) / 1e9;
+        double capacity = bucket_capacity(bucket);
+        if (bucket->tokens > capacity) {
+            bucket->tokens = capacity;
+        }
+    }
+    bucket->refilled = now;
+}
+
+/**
+ * Tokens to wait for before taking @p grant; a rate lowered mid-wait may
+ * leave the capacity below the grant, which is then taken into debt
+ */
+static double bucket_need(const BandwidthBucket* bucket, size_t grant) {
+    double capacity = bucket_capacity(bucket);
+    return (double)grant < capacity ? (double)grant : capacity;
+}
+
+/** Sleep until @p need tokens have accrued, capped at BANDWIDTH_POLL_NS */
+static uint64_t bucket_wait_ns(const BandwidthBucket* bucket, double need) {
+    double missing = need - bucket->tokens;
+    if (missing <= 0) {
+        return 1;
+    }
+    double ns = missing * 1e9 / (double)bucket->rate;
+    return ns < (double)BANDWIDTH_POLL_NS ? (uint64_t)ns + 1 : BANDWIDTH_POLL_NS;
+}
+
+static void bucket_give(BandwidthBucket* bucket, size_t bytes) {
+    if (bucket->rate == 0) {
+        return;
+    }
+    bucket->tokens += (double)bytes;
+    double capacity = bucket_capacity(bucket);
+    if (bucket->tokens > capacity) {
+        bucket->tokens = capacity;
+    }
+}
+
+/* ========== projects and queues (lock held) ========== */
+
+static BandwidthProject* bandwidth_find(size_t project_handle) {
+    if (project_handle == 0) {
+        return NULL;
+    }
+    for (BandwidthProject* project = projects; project != NULL; project = project->next) {
+        if (project->project_handle == project_handle) {
+            return project;
+        }
+    }
+    return NULL;
+}
+
+static void bandwidth_put(BandwidthProject* project) {
+    if (project != NULL && --project->users == 0 && project->removed) {
+        free(project);
+    }
+}
+
+static void queue_insert(BandwidthLink* link, BandwidthWaiter* waiter) {
+    BandwidthWaiter** at = &link->queue;
+    while (*at != NULL && (*at)->tag <= waiter->tag) {
+        at = &(*at)->next;
+    }
+    waiter->next = *at;
+    *at = waiter;
+}
+
+static void queue_remove(BandwidthLink* link, BandwidthWaiter* waiter) {
+    for (BandwidthWaiter** at = &link->queue; *at != NULL; at = &(*at)->next) {
+        if (*at == waiter) {
+            *at = waiter->next;
+            return;
+        }
+    }
+}
+
+/* ========== public API ========== */
+
+void bandwidth_set_global(uint64_t upload_rate, uint64_t download_rate) {
+    uv_once(&bandwidth_once, bandwidth_init);
+    uv_mutex_lock(&bandwidth_lock);
+    bucket_set_rate(&links[BANDWIDTH_UPLOAD].bucket, upload_rate);
+    bucket_set_rate(&links[BANDWIDTH_DOWNLOAD].bucket, download_rate);
+    uv_cond_broadcast(&bandwidth_changed);
+    uv_mutex_unlock(&bandwidth_lock);
+    LOG_INFO("bandwidth: process limits upload=%llu B/s, download=%llu B/s",
+             (unsigned long long)upload_rate, (unsigned long long)download_rate);
+}
+
+int bandwidth_configure(size_t project_handle, uint64_t upload_rate, uint64_t download_rate, uint32_t weight) {
+    uv_once(&bandwidth_once, bandwidth_init);
+    uv_mutex_lock(&bandwidth_lock);
+    BandwidthProject* project = bandwidth_find(project_handle);
+    if (project == NULL) {
+        project = (BandwidthProject*)calloc(1, sizeof(BandwidthProject));
+        if (project == NULL) {
+            uv_mutex_unlock(&bandwidth_lock);
+            return -1;
+        }
+        project->project_handle = project_handle;
+        project->next = projects;
+        projects = project;
+    }
+    project->weight = weight > 0 ? weight : 1;
+    bucket_set_rate(&project->buckets[BANDWIDTH_UPLOAD], upload_rate);
+    bucket_set_rate(&project->buckets[BANDWIDTH_DOWNLOAD], download_rate);
+    uv_cond_broadcast(&bandwidth_changed);
+    uv_mutex_unlock(&bandwidth_lock);
+    return 0;
+}
+
+void bandwidth_remove(size_t project_handle) {
+    uv_once(&bandwidth_once, bandwidth_init);
+    uv_mutex_lock(&bandwidth_lock);
+    for (BandwidthProject** at = &projects; *at != NULL; at = &(*at)->next) {
+        BandwidthProject* project = *at;
+        if (project->project_handle == project_handle) {
+            *at = project->next;
+            if (project->users == 0) {
+                free(project);
+            } else {
+                project->removed = true;
+            }
+            break;
+        }
+    }
+    uv_mutex_unlock(&bandwidth_lock);
+}
+
+/**
+ * Take @p grant from the project's own bucket
+ * @return false when @p cancel stopped the wait
+ */
+static bool bandwidth_wait_project(BandwidthProject* project, BandwidthDirection direction,
+                                   size_t* grant, CancelToken* cancel) {
+    BandwidthBucket* bucket = &project->buckets[direction];
+    for (;;) {
+        if (bucket->rate == 0) {
+            return true;
+        }
+        size_t slice = bucket_slice(bucket);
+        if (*grant > slice) {
+            *grant = slice;
+        }
+        bucket_refill(bucket, uv_hrtime());
+        double need = bucket_need(bucket, *grant);
+        if (bucket->tokens >= need) {
+            bucket->tokens -= (double)*grant;
+            return true;
+        }
+        if (cancel_token_is_cancelled(cancel)) {
+            return false;
+        }
+        uv_cond_timedwait(&bandwidth_changed, &bandwidth_lock, bucket_wait_ns(bucket, need));
+    }
+}
+
+/**
+ * Take @p grant from the process-wide bucket in fair-queueing order
+ * @return false when @p cancel stopped the wait
+ */
+static bool bandwidth_wait_link(BandwidthProject* project, BandwidthDirection direction,
+                                size_t grant, CancelToken* cancel) {
+    BandwidthLink* link = &links[direction];
+    if (link->bucket.rate == 0) {
+        return true;
+    }
+
+    double start = link->vtime;
+    if (project != NULL && project->finish[direction] > start) {
+        start = project->finish[direction];
+    }
+    BandwidthWaiter waiter = { NULL, start + (double)grant / (project != NULL ? project->weight : 1) };
+    if (project != NULL) {
+        project->finish[direction] = waiter.tag;
+    }
+    queue_insert(link, &waiter);
+
+    bool granted = true;
+    for (;;) {
+        if (link->bucket.rate == 0) {
+            break;
+        }
+        uint64_t timeout = BANDWIDTH_POLL_NS;
+        if (link->queue == &waiter) {
+            bucket_refill(&link->bucket, uv_hrtime());
+            double need = bucket_need(&link->bucket, grant);
+            if (link->bucket.tokens >= need) {
+                link->bucket.tokens -= (double)grant;
+                break;
+            }
+            timeout = bucket_wait_ns(&link->bucket, need);
+        }
+        if (cancel_token_is_cancelled(cancel)) {
+            granted = false;
+            break;
+        }
+        uv_cond_timedwait(&bandwidth_changed, &bandwidth_lock, timeout);
+    }
+
+    queue_remove(link, &waiter);
+    if (granted && start > link->vtime) {
+        link->vtime = start;
+    }
+    /* The next waiter may now be the head */
+    uv_cond_broadcast(&bandwidth_changed);
+    return granted;
+}
+
+size_t bandwidth_acquire(size_t project_handle, BandwidthDirection direction, size_t want, CancelToken* cancel) {
+    if (want == 0) {
+        return 0;
+    }
+    uv_once(&bandwidth_once, bandwidth_init);
+    uv_mutex_lock(&bandwidth_lock);
+
+    BandwidthProject* project = bandwidth_find(project_handle);
+    bool limited = links[direction].bucket.rate > 0 ||
+                   (project != NULL && project->buckets[direction].rate > 0);
+    if (!limited) {
+        uv_mutex_unlock(&bandwidth_lock);
+        return want;
+    }
+    if (project != NULL) {
+        project->users++;
+    }
+
+    size_t grant = want;
+    if (links[direction].bucket.rate > 0 && grant > bucket_slice(&links[direction].bucket)) {
+        grant = bucket_slice(&links[direction].bucket);
+    }
+    if (project != NULL && !bandwidth_wait_project(project, direction, &grant, cancel)) {
+        grant = 0;
+    } else if (!bandwidth_wait_link(project, direction, grant, cancel)) {
+        if (project != NULL) {
+            bucket_give(&project->buckets[direction], grant);
+        }
+        grant = 0;
+    }
+
+    bandwidth_put(project);
+    uv_mutex_unlock(&bandwidth_lock);
+    return grant;
+}
+
+void bandwidth_refund(size_t project_handle, BandwidthDirection direction, size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    uv_once(&bandwidth_once, bandwidth_init);
+    uv_mutex_lock(&bandwidth_lock);
+    BandwidthProject* project = bandwidth_find(project_handle);
+    if (project != NULL) {
+        bucket_give(&project->buckets[direction], bytes);
+    }
+    bucket_give(&links[direction].bucket, bytes);
+    uv_cond_broadcast(&bandwidth_changed);
+    uv_mutex_unlock(&bandwidth_lock);
+}
+
+/* ========== napi_configure_bandwidth ========== */
+
+napi_value napi_configure_bandwidth(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1] = { NULL };
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+
+    napi_valuetype type = napi_undefined;
+    if (argc >= 1) {
+        napi_typeof(env, argv[0], &type);
+    }
+    if (type != napi_object) {
+        napi_throw_type_error(env, NULL, "options must be an object");
+        return NULL;
+    }
+
+    int64_t upload_rate = get_int64_property(env, argv[0], "maxUploadBytesPerSecond", 0);
+    int64_t download_rate = get_int64_property(env, argv[0], "maxDownloadBytesPerSecond", 0);
+    if (upload_rate < 0 || upload_rate > BANDWIDTH_MAX_RATE) {
+        napi_throw_range_error(env, NULL, "maxUploadBytesPerSecond must be between 0 and 2^53");
+        return NULL;
+    }
+    if (download_rate < 0 || download_rate > BANDWIDTH_MAX_RATE) {
+        napi_throw_range_error(env, NULL, "maxDownloadBytesPerSecond must be between 0 and 2^53");
+        return NULL;
+    }
+
+    bandwidth_set_global((uint64_t)upload_rate, (uint64_t)download_rate);
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
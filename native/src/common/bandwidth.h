@@ -0,0 +1,87 @@
+/**
+ * @file bandwidth.h
+ * @brief Process-wide bandwidth limits for uplink-nodejs native module
+ *
+ * Every data path (stream writes and reads, part writes, file and buffer
+ * transfers, the parallel engines) asks for a grant before it moves
+ * bytes. A grant is drawn from up to two token buckets per direction:
+ * the project's own (maxUploadBytesPerSecond / maxDownloadBytesPerSecond
+ * in configOpenProject) and the process-wide one (configureBandwidth).
+ *
+ * Grants waiting on the process-wide bucket are served in start-time
+ * fair queueing order: each project's virtual clock advances by bytes
+ * divided by its bandwidthWeight, so under contention projects share
+ * the link in proportion to their weights however many transfers each
+ * has in flight, and a project that was idle gets no backlog credit.
+ *
+ * Grants are capped at a slice of the tightest rate involved (about
+ * 1/16 s of traffic), so callers loop and the rate holds even for one
+ * large write. Without limits a grant is the whole request and costs a
+ * mutex round trip. All functions are safe from any thread.
+ */
+
+#ifndef UPLINK_BANDWIDTH_H
+#define UPLINK_BANDWIDTH_H
+
+#include <node_api.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "cancel_token.h"
+
+/** Largest rate accepted from JS (2^53, the exact integer range of a double) */
+#define BANDWIDTH_MAX_RATE 9007199254740992LL
+
+/** Upper bound accepted for bandwidthWeight */
+#define BANDWIDTH_MAX_WEIGHT 1000
+
+/**
+ * Directions with separate limits
+ */
+typedef enum {
+    BANDWIDTH_UPLOAD = 0,            /* egress: uploads and part writes */
+    BANDWIDTH_DOWNLOAD,              /* ingress: download reads */
+    BANDWIDTH_DIRECTION_COUNT
+} BandwidthDirection;
+
+/**
+ * Set the process-wide limits in bytes per second (0 = unlimited)
+ *
+ * Waiting grants pick up the new rates right away.
+ */
+void bandwidth_set_global(uint64_t upload_rate, uint64_t download_rate);
+
+/**
+ * Set the limits and fair-share weight of a project (rates 0 = unlimited)
+ *
+ * @param weight Share of the process-wide limits relative to other projects (1 or more)
+ * @return 0 on success, -1 on OOM
+ */
+int bandwidth_configure(size_t project_handle, uint64_t upload_rate, uint64_t download_rate, uint32_t weight);
+
+/**
+ * Forget the limits of a project when it is closed
+ */
+void bandwidth_remove(size_t project_handle);
+
+/**
+ * Wait until up to @p want bytes may be moved
+ *
+ * @param project_handle Project the transfer belongs to, or 0 when unknown
+ *                       (only the process-wide limit applies, at weight 1)
+ * @param cancel Stops the wait when aborted, or NULL
+ * @return Bytes granted (1 to @p want), or 0 when @p want is 0 or @p cancel stopped
+ */
+size_t bandwidth_acquire(size_t project_handle, BandwidthDirection direction, size_t want, CancelToken* cancel);
+
+/**
+ * Give back the unused part of a grant (a short read or a failed write)
+ */
+void bandwidth_refund(size_t project_handle, BandwidthDirection direction, size_t bytes);
+
+/**
+ * N-API: set the process-wide limits from
+ * { maxUploadBytesPerSecond, maxDownloadBytesPerSecond }
+ */
+napi_value napi_configure_bandwidth(napi_env env, napi_callback_info info);
+
+#endif /* UPLINK_BANDWIDTH_H */
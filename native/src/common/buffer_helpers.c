@@ -6,6 +6,7 @@
  */
 
 #include "buffer_helpers.h"
+#include "op_metrics.h"
 #include "logger.h"
 #include <string.h>
 
@@ -43,6 +44,25 @@ static napi_status try_extract_arraybuffer(napi_env env, napi_value js_buffer,
     return napi_ok;
 }
 
+/** Bytes per element of a TypedArray type */
+static size_t typedarray_element_size(napi_typedarray_type type) {
+    switch (type) {
+        case napi_int16_array:
+        case napi_uint16_array:
+            return 2;
+        case napi_int32_array:
+        case napi_uint32_array:
+        case napi_float32_array:
+            return 4;
+        case napi_float64_array:
+        case napi_bigint64_array:
+        case napi_biguint64_array:
+            return 8;
+        default:
+            return 1;
+    }
+}
+
 /**
  * Try to extract data from a TypedArray (e.g. Uint8Array).
  * @return napi_ok on success, napi_invalid_arg if not a TypedArray.
@@ -56,10 +76,12 @@ static napi_status try_extract_typedarray(napi_env env, napi_value js_buffer,
     napi_typedarray_type type;
     napi_value arraybuffer;
     size_t byte_offset;
-    if (napi_get_typedarray_info(env, js_buffer, &type, out_length,
+    size_t element_count;
+    if (napi_get_typedarray_info(env, js_buffer, &type, &element_count,
                                  out_data, &arraybuffer, &byte_offset) != napi_ok) {
         return napi_invalid_arg;
     }
+    *out_length = element_count * typedarray_element_size(type);
     LOG_TRACE("Extracted TypedArray: %zu bytes", *out_length);
     return napi_ok;
 }
@@ -115,6 +137,22 @@ napi_value create_buffer_external(napi_env env, void* data, size_t length,
     return result;
 }
 
+napi_status pin_buffer(napi_env env, napi_value buffer, size_t length, napi_ref* out_ref) {
+    napi_status status = napi_create_reference(env, buffer, 1, out_ref);
+    if (status == napi_ok) {
+        op_metrics_pin(env, (int64_t)length);
+    }
+    return status;
+}
+
+void unpin_buffer(napi_env env, napi_ref ref, size_t length) {
+    if (ref == NULL) {
+        return;
+    }
+    napi_delete_reference(env, ref);
+    op_metrics_pin(env, -(int64_t)length);
+}
+
 int is_buffer_like(napi_env env, napi_value value) {
     bool result;
     
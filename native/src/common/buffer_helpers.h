@@ -49,6 +49,28 @@ napi_value create_buffer_copy(napi_env env, const void* data, size_t length);
 napi_value create_buffer_external(napi_env env, void* data, size_t length,
                                   napi_finalize destructor, void* hint);
 
+/**
+ * Keep a JS buffer alive while native work reads or writes it
+ * 
+ * Counts @p length towards the pinned-bytes gauge of getMetrics().
+ * 
+ * @param env N-API environment
+ * @param buffer JS buffer to pin
+ * @param length Bytes the work uses
+ * @param out_ref Receives the reference
+ * @return napi_ok on success
+ */
+napi_status pin_buffer(napi_env env, napi_value buffer, size_t length, napi_ref* out_ref);
+
+/**
+ * Drop a reference taken by pin_buffer (no-op for NULL)
+ * 
+ * @param env N-API environment
+ * @param ref The reference
+ * @param length Length passed to pin_buffer
+ */
+void unpin_buffer(napi_env env, napi_ref ref, size_t length);
+
 /**
  * Check if value is a buffer-like object
  * 
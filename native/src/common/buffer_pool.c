@@ -0,0 +1,157 @@
+/**
+ * @file buffer_pool.c
+ * @brief Size-classed native buffer pool implementation
+ * 
+ * Each slab carries a small header recording its size class, so callers
+ * release with just the pointer. Free slabs are kept on a per-class list
+ * (the list link lives in the slab itself) up to a per-class cap.
+ */
+
+#include "buffer_pool.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/** Class index stored for allocations too large for any slab class */
+#define POOL_UNPOOLED UINT32_MAX
+
+/** Header in front of every pooled allocation; keeps data 16-byte aligned */
+typedef union {
+    struct {
+        uint32_t size_class;
+    } info;
+    max_align_t align;
+    uint8_t pad[16];
+} PoolHeader;
+
+typedef struct PoolFree {
+    struct PoolFree* next;
+} PoolFree;
+
+typedef struct {
+    size_t slab_size;
+    uint32_t max_cached;
+    uint32_t cached;
+    PoolFree* free_list;
+} PoolClass;
+
+static PoolClass pool_classes[] = {
+    { 64 * 1024,       32, 0, NULL },
+    { 1024 * 1024,     16, 0, NULL },
+    { 4 * 1024 * 1024,  8, 0, NULL },
+};
+
+#define POOL_CLASS_COUNT (sizeof(pool_classes) / sizeof(pool_classes[0]))
+
+static uv_once_t pool_once = UV_ONCE_INIT;
+static uv_mutex_t pool_lock;
+
+static void pool_init(void) {
+    uv_mutex_init(&pool_lock);
+}
+
+void* buffer_pool_acquire(size_t size) {
+    uint32_t index = POOL_UNPOOLED;
+    for (uint32_t i = 0; i < POOL_CLASS_COUNT; i++) {
+        if (size <= pool_classes[i].slab_size) {
+            index = i;
+            break;
+        }
+    }
+    
+    if (index == POOL_UNPOOLED) {
+        if (size > SIZE_MAX - sizeof(PoolHeader)) {
+            return NULL;
+        }
+        PoolHeader* header = (PoolHeader*)malloc(sizeof(PoolHeader) + size);
+        if (header == NULL) {
+            return NULL;
+        }
+        header->info.size_class = POOL_UNPOOLED;
+        return header + 1;
+    }
+    
+    uv_once(&pool_once, pool_init);
+    PoolClass* cls = &pool_classes[index];
+    
+    uv_mutex_lock(&pool_lock);
+    PoolFree* slab = cls->free_list;
+    if (slab != NULL) {
+        cls->free_list = slab->next;
+        cls->cached--;
+    }
+    uv_mutex_unlock(&pool_lock);
+    
+    if (slab != NULL) {
+        return slab;
+    }
+    
+    PoolHeader* header = (PoolHeader*)malloc(sizeof(PoolHeader) + cls->slab_size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->info.size_class = index;
+    LOG_TRACE("buffer pool: new %zu-byte slab", cls->slab_size);
+    return header + 1;
+}
+
+void buffer_pool_release(void* data) {
+    if (data == NULL) {
+        return;
+    }
+    
+    PoolHeader* header = (PoolHeader*)data - 1;
+    uint32_t index = header->info.size_class;
+    if (index >= POOL_CLASS_COUNT) {
+        free(header);
+        return;
+    }
+    
+    uv_once(&pool_once, pool_init);
+    PoolClass* cls = &pool_classes[index];
+    
+    uv_mutex_lock(&pool_lock);
+    if (cls->cached < cls->max_cached) {
+        PoolFree* slab = (PoolFree*)data;
+        slab->next = cls->free_list;
+        cls->free_list = slab;
+        cls->cached++;
+        data = NULL;
+    }
+    uv_mutex_unlock(&pool_lock);
+    
+    if (data != NULL) {
+        free(header);
+    }
+}
+
+static void buffer_pool_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    buffer_pool_release(data);
+}
+
+napi_value buffer_pool_create_buffer(napi_env env, size_t length) {
+    napi_value result;
+    
+    void* data = buffer_pool_acquire(length);
+    if (data == NULL) {
+        LOG_ERROR("buffer pool: out of memory for %zu bytes", length);
+        return NULL;
+    }
+    
+    if (napi_create_external_buffer(env, length, data, buffer_pool_finalize, NULL, &result) == napi_ok) {
+        return result;
+    }
+    
+    /* Runtimes with a V8 sandbox reject external buffers */
+    buffer_pool_release(data);
+    void* copy_data;
+    if (napi_create_buffer(env, length, &copy_data, &result) != napi_ok) {
+        LOG_ERROR("Failed to create buffer");
+        return NULL;
+    }
+    return result;
+}
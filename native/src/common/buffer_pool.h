@@ -0,0 +1,47 @@
+/**
+ * @file buffer_pool.h
+ * @brief Size-classed native buffer pool for uplink-nodejs native module
+ * 
+ * Recycles the large scratch buffers used by download reads and upload
+ * staging instead of allocating them per operation. Requests are rounded
+ * up to a 64 KiB, 1 MiB or 4 MiB slab; larger requests fall through to
+ * malloc. Safe to call from worker threads.
+ */
+
+#ifndef UPLINK_BUFFER_POOL_H
+#define UPLINK_BUFFER_POOL_H
+
+#include <node_api.h>
+#include <stddef.h>
+
+/**
+ * Get a buffer of at least @p size bytes
+ * 
+ * @param size Requested size in bytes
+ * @return Buffer (contents undefined), or NULL on OOM
+ */
+void* buffer_pool_acquire(size_t size);
+
+/**
+ * Return a buffer obtained from buffer_pool_acquire (NULL is a no-op)
+ * 
+ * The slab is kept for reuse while its size class has room, and freed
+ * otherwise.
+ * 
+ * @param data Buffer to release
+ */
+void buffer_pool_release(void* data);
+
+/**
+ * Create a JS Buffer of @p length bytes backed by a pooled slab
+ * 
+ * The slab goes back to the pool when the Buffer is garbage collected.
+ * Falls back to a regular Buffer where external buffers are not allowed.
+ * 
+ * @param env N-API environment
+ * @param length Buffer length
+ * @return JS Buffer or NULL
+ */
+napi_value buffer_pool_create_buffer(napi_env env, size_t length);
+
+#endif /* UPLINK_BUFFER_POOL_H */
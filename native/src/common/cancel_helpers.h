@@ -5,6 +5,9 @@
  * Provides a standardized macro to handle napi_cancelled status in all
  * async complete functions. This eliminates ~60 copies of identical
  * cancellation boilerplate across all modules.
+ *
+ * napi_cancelled is reported for work that never started: work dequeued
+ * by an aborted cancel token (cancel_token.h), or by libuv at teardown.
  * 
  * Usage:
  *   void my_complete(napi_env env, napi_status status, void* data) {
@@ -20,6 +23,9 @@
 #define UPLINK_CANCEL_HELPERS_H
 
 #include <node_api.h>
+#include "error_registry.h"
+#include "result_helpers.h"
+#include "cancel_token.h"
 #include "logger.h"
 
 /**
@@ -32,18 +38,52 @@
  * @param status    napi_status from the complete callback
  * @param deferred  napi_deferred to reject on cancellation
  * @param func_name String literal for logging (e.g., "parseAccess")
+ *
+ * The promise is rejected with a CanceledError.
  */
 #define REJECT_IF_CANCELLED(env, status, deferred, func_name)           \
     do {                                                                 \
         if ((status) == napi_cancelled) {                               \
             LOG_WARN("%s: operation cancelled", (func_name));           \
-            napi_value _cancel_err, _cancel_msg;                        \
-            napi_create_string_utf8((env), "Operation cancelled",       \
-                                    NAPI_AUTO_LENGTH, &_cancel_msg);    \
-            napi_create_error((env), NULL, _cancel_msg, &_cancel_err);  \
+            napi_value _cancel_err = create_typed_error((env),          \
+                UPLINK_ERROR_CANCELED, "Operation cancelled");           \
             napi_reject_deferred((env), (deferred), _cancel_err);       \
             goto cleanup;                                                \
         }                                                                \
     } while (0)
 
+/**
+ * REJECT_IF_CANCELLED_BY - REJECT_IF_CANCELLED for work attached to a cancel token
+ *
+ * Work dequeued by a token whose deadline passed is rejected with a
+ * TimeoutError instead of a CanceledError.
+ *
+ * @param token     CancelToken* of the work (NULL behaves like REJECT_IF_CANCELLED)
+ */
+#define REJECT_IF_CANCELLED_BY(env, status, deferred, func_name, token) \
+    do {                                                                 \
+        if ((status) == napi_cancelled) {                               \
+            LOG_WARN("%s: operation cancelled", (func_name));           \
+            napi_reject_deferred((env), (deferred),                     \
+                                 cancel_token_error((env), (token)));   \
+            goto cleanup;                                                \
+        }                                                                \
+    } while (0)
+
+/**
+ * SETTLE_IF_CANCELLED_BY - REJECT_IF_CANCELLED_BY for ops that may settle
+ * through a callback instead of a promise (see settle_error())
+ *
+ * @param callback  napi_ref of the callback, or NULL to reject @p deferred
+ */
+#define SETTLE_IF_CANCELLED_BY(env, status, deferred, callback, func_name, token) \
+    do {                                                                 \
+        if ((status) == napi_cancelled) {                               \
+            LOG_WARN("%s: operation cancelled", (func_name));           \
+            settle_error((env), (deferred), (callback),                 \
+                         cancel_token_error((env), (token)));           \
+            goto cleanup;                                                \
+        }                                                                \
+    } while (0)
+
 #endif /* UPLINK_CANCEL_HELPERS_H */
@@ -0,0 +1,332 @@
+/**
+ * @file cancel_token.c
+ * @brief Cancellation token implementation
+ *
+ * A token keeps the list of queued operations attached to it. Aborting
+ * takes each one off whichever queue still holds it (admission first,
+ * then the addon pool); operations that already started notice the flag
+ * on their next check.
+ *
+ * A call with options.timeoutMs gets a token of its own whose timer
+ * aborts it at the deadline. When the call also carries a caller token,
+ * the new token wraps it: its work is attached to both, and aborting
+ * either stops it.
+ */
+
+#include "cancel_token.h"
+#include "handle_helpers.h"
+#include "admission.h"
+#include "thread_pool.h"
+#include "result_helpers.h"
+#include "error_registry.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef struct CancelWatch {
+    struct CancelWatch* next;
+    napi_env env;
+    napi_async_work work;
+} CancelWatch;
+
+struct CancelToken {
+    uv_mutex_t lock;                /* guards reason */
+    int32_t reason;                 /* 0 while live, else UPLINK_ERROR_CANCELED or UPLINK_ERROR_TIMEOUT */
+    uint64_t deadline;              /* uv_hrtime() value, 0 = none; set before first use */
+    CancelToken* parent;            /* caller's token when a deadline was added to it */
+    uv_timer_t timer;               /* fires at the deadline; main thread only */
+    bool has_timer;
+    uint32_t refs;                  /* JS external + attached operations; main thread only */
+    CancelWatch* watches;           /* main thread only */
+};
+
+static void cancel_token_free(uv_handle_t* handle) {
+    free(handle->data);
+}
+
+static void cancel_token_unref(void* arg) {
+    CancelToken* token = (CancelToken*)arg;
+    if (--token->refs > 0) {
+        return;
+    }
+    if (token->parent != NULL) {
+        cancel_token_unref(token->parent);
+    }
+    uv_mutex_destroy(&token->lock);
+    if (token->has_timer) {
+        /* The timer handle lives in the token, so free it once closed */
+        uv_timer_stop(&token->timer);
+        uv_close((uv_handle_t*)&token->timer, cancel_token_free);
+        return;
+    }
+    free(token);
+}
+
+static CancelToken* cancel_token_new(void) {
+    CancelToken* token = (CancelToken*)calloc(1, sizeof(CancelToken));
+    if (token == NULL) {
+        return NULL;
+    }
+    uv_mutex_init(&token->lock);
+    token->refs = 1;
+    return token;
+}
+
+static void watch_add(CancelToken* token, napi_env env, napi_async_work work) {
+    CancelWatch* watch = (CancelWatch*)malloc(sizeof(CancelWatch));
+    if (watch == NULL) {
+        /* Still stops at the next in-flight check */
+        return;
+    }
+    watch->env = env;
+    watch->work = work;
+    watch->next = token->watches;
+    token->watches = watch;
+}
+
+static void watch_remove(CancelToken* token, napi_async_work work) {
+    for (CancelWatch** link = &token->watches; *link != NULL; link = &(*link)->next) {
+        if ((*link)->work == work) {
+            CancelWatch* watch = *link;
+            *link = watch->next;
+            free(watch);
+            return;
+        }
+    }
+}
+
+/** Why the token stopped (0 while live); any thread */
+static int32_t cancel_token_reason(CancelToken* token) {
+    uv_mutex_lock(&token->lock);
+    int32_t reason = token->reason;
+    uv_mutex_unlock(&token->lock);
+    if (reason == 0 && token->deadline != 0 && uv_hrtime() >= token->deadline) {
+        /* Running work sees the deadline even while the main thread is busy */
+        reason = UPLINK_ERROR_TIMEOUT;
+    }
+    if (reason == 0 && token->parent != NULL) {
+        reason = cancel_token_reason(token->parent);
+    }
+    return reason;
+}
+
+/** Flag the token and dequeue its waiting operations; main thread only */
+static void cancel_token_abort(CancelToken* token, int32_t reason) {
+    uv_mutex_lock(&token->lock);
+    bool already = token->reason != 0;
+    if (!already) {
+        token->reason = reason;
+    }
+    uv_mutex_unlock(&token->lock);
+    if (already) {
+        return;
+    }
+    
+    /* Dequeued admission work completes synchronously and detaches, so
+     * keep the token alive and restart the scan after each removal */
+    token->refs++;
+    size_t dequeued = 0;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (CancelWatch* watch = token->watches; watch != NULL; watch = watch->next) {
+            if (admission_cancel(watch->env, watch->work) == 0) {
+                dequeued++;
+                progress = true;
+                break;
+            }
+        }
+    }
+    for (CancelWatch* watch = token->watches; watch != NULL; watch = watch->next) {
+        if (thread_pool_cancel(watch->work) == 0) {
+            dequeued++;
+        }
+    }
+    LOG_DEBUG("cancelToken: %s, %zu queued operations dequeued",
+              reason == UPLINK_ERROR_TIMEOUT ? "deadline passed" : "aborted", dequeued);
+    cancel_token_unref(token);
+}
+
+static void cancel_token_on_deadline(uv_timer_t* timer) {
+    cancel_token_abort((CancelToken*)timer->data, UPLINK_ERROR_TIMEOUT);
+}
+
+/** Reference the caller's token in options.cancelToken, or NULL */
+static CancelToken* caller_token(napi_env env, napi_value options) {
+    napi_value value;
+    napi_valuetype type = napi_undefined;
+    if (napi_get_named_property(env, options, "cancelToken", &value) != napi_ok) {
+        return NULL;
+    }
+    napi_typeof(env, value, &type);
+    if (type != napi_external) {
+        return NULL;
+    }
+    HandleWrapper* wrapper = get_handle_wrapper(env, value, HANDLE_TYPE_CANCEL_TOKEN);
+    if (wrapper == NULL) {
+        return NULL;
+    }
+    CancelToken* token = (CancelToken*)wrapper->attachment;
+    token->refs++;
+    return token;
+}
+
+/** options.timeoutMs, or 0 when absent or not a positive finite number */
+static double timeout_option(napi_env env, napi_value options) {
+    napi_value value;
+    napi_valuetype type = napi_undefined;
+    double timeout_ms = 0;
+    if (napi_get_named_property(env, options, "timeoutMs", &value) == napi_ok) {
+        napi_typeof(env, value, &type);
+    }
+    if (type == napi_number) {
+        napi_get_value_double(env, value, &timeout_ms);
+    }
+    return isfinite(timeout_ms) && timeout_ms > 0 ? timeout_ms : 0;
+}
+
+CancelToken* cancel_token_from_options(napi_env env, napi_value options) {
+    napi_valuetype type = napi_undefined;
+    if (options != NULL) {
+        napi_typeof(env, options, &type);
+    }
+    if (type != napi_object) {
+        return NULL;
+    }
+    
+    CancelToken* caller = caller_token(env, options);
+    double timeout_ms = timeout_option(env, options);
+    if (timeout_ms == 0) {
+        return caller;
+    }
+    
+    /* A deadline is per call: wrap the caller's token, which may be shared */
+    CancelToken* token = cancel_token_new();
+    uv_loop_t* loop = NULL;
+    napi_get_uv_event_loop(env, &loop);
+    if (token == NULL || loop == NULL) {
+        free(token);
+        return caller;
+    }
+    token->parent = caller;
+    token->deadline = uv_hrtime() + (uint64_t)(timeout_ms * 1e6);
+    uv_timer_init(loop, &token->timer);
+    token->timer.data = token;
+    token->has_timer = true;
+    uint64_t delay_ms = (uint64_t)timeout_ms;
+    uv_timer_start(&token->timer, cancel_token_on_deadline, delay_ms > 0 ? delay_ms : 1, 0);
+    return token;
+}
+
+void cancel_token_attach(CancelToken* token, napi_env env, napi_async_work work) {
+    if (token == NULL) {
+        return;
+    }
+    watch_add(token, env, work);
+    if (token->parent != NULL) {
+        watch_add(token->parent, env, work);
+    }
+}
+
+void cancel_token_detach(CancelToken* token, napi_async_work work) {
+    if (token == NULL) {
+        return;
+    }
+    watch_remove(token, work);
+    if (token->parent != NULL) {
+        watch_remove(token->parent, work);
+    }
+    cancel_token_unref(token);
+}
+
+void cancel_token_reattach(CancelToken* token, napi_env env, napi_async_work from, napi_async_work to) {
+    if (token == NULL) {
+        return;
+    }
+    watch_remove(token, from);
+    if (token->parent != NULL) {
+        watch_remove(token->parent, from);
+    }
+    cancel_token_attach(token, env, to);
+}
+
+bool cancel_token_is_cancelled(CancelToken* token) {
+    return token != NULL && cancel_token_reason(token) != 0;
+}
+
+int32_t cancel_token_code(CancelToken* token) {
+    if (token != NULL && cancel_token_reason(token) == UPLINK_ERROR_TIMEOUT) {
+        return UPLINK_ERROR_TIMEOUT;
+    }
+    return UPLINK_ERROR_CANCELED;
+}
+
+const char* cancel_token_message(CancelToken* token) {
+    return cancel_token_code(token) == UPLINK_ERROR_TIMEOUT ? CANCEL_TOKEN_TIMEOUT_MESSAGE : CANCEL_TOKEN_MESSAGE;
+}
+
+napi_value cancel_token_error(napi_env env, CancelToken* token) {
+    return create_typed_error(env, cancel_token_code(token), cancel_token_message(token));
+}
+
+bool cancel_token_check(CancelToken* token, int32_t* error_code, char** error_message) {
+    if (!cancel_token_is_cancelled(token)) {
+        return false;
+    }
+    if (*error_code == 0) {
+        *error_code = cancel_token_code(token);
+        *error_message = strdup(cancel_token_message(token));
+    }
+    return true;
+}
+
+size_t cancel_token_slice(CancelToken* token, size_t want) {
+    if (token == NULL || want <= CANCEL_TOKEN_SLICE_BYTES) {
+        return want;
+    }
+    return CANCEL_TOKEN_SLICE_BYTES;
+}
+
+/* ========== napi_create_cancel_token ========== */
+
+napi_value napi_create_cancel_token(napi_env env, napi_callback_info info) {
+    (void)info;
+    
+    CancelToken* token = cancel_token_new();
+    if (token == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    napi_value external = create_handle_external(env, (size_t)token, HANDLE_TYPE_CANCEL_TOKEN, NULL, NULL);
+    if (external == NULL) {
+        cancel_token_unref(token);
+        return NULL;
+    }
+    HandleWrapper* wrapper = get_handle_wrapper(env, external, HANDLE_TYPE_CANCEL_TOKEN);
+    wrapper->attachment = token;
+    wrapper->attachment_free = cancel_token_unref;
+    return external;
+}
+
+/* ========== napi_cancel_token ========== */
+
+napi_value napi_cancel_token(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    HandleWrapper* wrapper = argc >= 1 ? get_handle_wrapper(env, argv[0], HANDLE_TYPE_CANCEL_TOKEN) : NULL;
+    if (wrapper == NULL) {
+        napi_throw_type_error(env, NULL, "Invalid cancel token");
+        return NULL;
+    }
+    cancel_token_abort((CancelToken*)wrapper->attachment, UPLINK_ERROR_CANCELED);
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
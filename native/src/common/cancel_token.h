@@ -0,0 +1,122 @@
+/**
+ * @file cancel_token.h
+ * @brief Cancellation tokens behind AbortSignal support
+ *
+ * The TypeScript layer creates one token per call that was given an
+ * AbortSignal and passes it as options.cancelToken. Aborting it:
+ *   - completes work still waiting in the admission queue or the addon
+ *     pool right away with napi_cancelled, and
+ *   - raises a flag that execute loops check between chunks, parts and
+ *     batches, so in-flight transfers stop early and release their
+ *     uplink handles.
+ *
+ * A call given options.timeoutMs gets a per-call token that aborts itself
+ * at the deadline, so the bound covers time spent queued as well as
+ * running; its operations fail with a TimeoutError instead.
+ *
+ * Tokens are reference counted: the JS external holds one reference and
+ * each attached operation another. The flag may be read on any thread;
+ * everything else is main thread only.
+ */
+
+#ifndef UPLINK_CANCEL_TOKEN_H
+#define UPLINK_CANCEL_TOKEN_H
+
+#include <node_api.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Message of the CanceledError raised by an aborted operation */
+#define CANCEL_TOKEN_MESSAGE "Operation cancelled"
+
+/** Message of the TimeoutError raised once options.timeoutMs passes */
+#define CANCEL_TOKEN_TIMEOUT_MESSAGE "Deadline exceeded"
+
+/** Largest single read while a token is attached, so aborts are seen between slices */
+#define CANCEL_TOKEN_SLICE_BYTES (4 * 1024 * 1024)
+
+typedef struct CancelToken CancelToken;
+
+/**
+ * Take a reference on options.cancelToken, adding options.timeoutMs
+ *
+ * With a timeout a new token is returned that wraps the caller's (if
+ * any) and whose deadline timer starts now.
+ *
+ * @param env N-API environment
+ * @param options Options object (NULL or non-objects yield NULL)
+ * @return The token, or NULL when neither option was passed
+ */
+CancelToken* cancel_token_from_options(napi_env env, napi_value options);
+
+/**
+ * Register queued work so that aborting the token dequeues it
+ *
+ * Call right after queuing; the operation's complete callback must call
+ * cancel_token_detach() with the same work. NULL tokens are ignored.
+ */
+void cancel_token_attach(CancelToken* token, napi_env env, napi_async_work work);
+
+/**
+ * Unregister work and drop the reference taken by cancel_token_from_options()
+ *
+ * Call from the complete callback before deleting the work. NULL is a no-op.
+ */
+void cancel_token_detach(CancelToken* token, napi_async_work work);
+
+/**
+ * Move the registration of an operation to the follow-up work it queued
+ * from a complete callback, keeping the token's reference. NULL is a no-op.
+ */
+void cancel_token_reattach(CancelToken* token, napi_env env, napi_async_work from, napi_async_work to);
+
+/**
+ * Whether the token was aborted (any thread; NULL is never aborted)
+ */
+bool cancel_token_is_cancelled(CancelToken* token);
+
+/**
+ * Error code of a stopped token: UPLINK_ERROR_TIMEOUT once its deadline
+ * passed, UPLINK_ERROR_CANCELED otherwise (any thread)
+ */
+int32_t cancel_token_code(CancelToken* token);
+
+/**
+ * Error message matching cancel_token_code() (any thread)
+ */
+const char* cancel_token_message(CancelToken* token);
+
+/**
+ * CanceledError or TimeoutError for a stopped token (main thread)
+ */
+napi_value cancel_token_error(napi_env env, CancelToken* token);
+
+/**
+ * Record a CanceledError or TimeoutError if the token stopped (any thread)
+ *
+ * An error already in @p error_code / @p error_message is kept.
+ *
+ * @return true when the caller should stop
+ */
+bool cancel_token_check(CancelToken* token, int32_t* error_code, char** error_message);
+
+/**
+ * Clamp a read of @p want bytes to CANCEL_TOKEN_SLICE_BYTES when a token
+ * is attached; without one the read is left whole
+ */
+size_t cancel_token_slice(CancelToken* token, size_t want);
+
+/**
+ * N-API callback: create a token
+ * JS: createCancelToken() -> CancelToken
+ */
+napi_value napi_create_cancel_token(napi_env env, napi_callback_info info);
+
+/**
+ * N-API callback: abort a token
+ * JS: cancelToken(token: CancelToken) -> void
+ */
+napi_value napi_cancel_token(napi_env env, napi_callback_info info);
+
+#endif /* UPLINK_CANCEL_TOKEN_H */
@@ -0,0 +1,352 @@
+/**
+ * @file checksum.c
+ * @brief Incremental content checksums implementation
+ * 
+ * CRC32C uses the SSE4.2 / ARMv8 CRC32 instructions when available and a
+ * slice-by-8 table otherwise. SHA-256 uses the SHA-NI extensions when
+ * available and a portable compression function otherwise. Hardware
+ * functions are compiled with per-function target attributes so no
+ * global compiler flags are needed; CPU probing and table setup run
+ * once via uv_once so worker threads can hash concurrently.
+ */
+
+#include "checksum.h"
+
+#include <uv.h>
+#include <string.h>
+#include <stdio.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define CHECKSUM_X86 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define CHECKSUM_TARGET(t)
+    #else
+        #include <cpuid.h>
+        #define CHECKSUM_TARGET(t) __attribute__((target(t)))
+    #endif
+    #include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+    #define CHECKSUM_ARM_CRC 1
+    #include <arm_acle.h>
+#endif
+
+/* ========== CPU feature probe ========== */
+
+#ifdef CHECKSUM_X86
+static uv_once_t cpu_probe_once = UV_ONCE_INIT;
+static int cpu_has_sse42 = 0;
+static int cpu_has_sha = 0;
+
+static void probe_cpu_once(void) {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 1);
+    cpu_has_sse42 = (regs[2] >> 20) & 1;
+    __cpuidex(regs, 7, 0);
+    cpu_has_sha = (regs[1] >> 29) & 1;
+#else
+    unsigned int a, b, c, d;
+    if (__get_cpuid(1, &a, &b, &c, &d)) {
+        cpu_has_sse42 = (c >> 20) & 1;
+    }
+    if (__get_cpuid_count(7, 0, &a, &b, &c, &d)) {
+        cpu_has_sha = (b >> 29) & 1;
+    }
+#endif
+    /* SHA-NI path also uses SSSE3/SSE4.1 shuffles, implied by SSE4.2 */
+    cpu_has_sha = cpu_has_sha && cpu_has_sse42;
+}
+
+static void probe_cpu(void) {
+    uv_once(&cpu_probe_once, probe_cpu_once);
+}
+#endif
+
+/* ========== CRC32C ========== */
+
+#define CRC32C_POLY 0x82F63B78u
+
+static uint32_t crc32c_table[8][256];
+static uv_once_t crc32c_table_once = UV_ONCE_INIT;
+
+static void crc32c_build_table(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+        }
+        crc32c_table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int t = 1; t < 8; t++) {
+            uint32_t prev = crc32c_table[t - 1][i];
+            crc32c_table[t][i] = (prev >> 8) ^ crc32c_table[0][prev & 0xFF];
+        }
+    }
+}
+
+static uint32_t crc32c_sw(uint32_t crc, const uint8_t* p, size_t n) {
+    uv_once(&crc32c_table_once, crc32c_build_table);
+    while (n >= 8) {
+        uint32_t lo = crc ^ ((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+        uint32_t hi = (uint32_t)p[4] | (uint32_t)p[5] << 8 | (uint32_t)p[6] << 16 | (uint32_t)p[7] << 24;
+        crc = crc32c_table[7][lo & 0xFF] ^ crc32c_table[6][(lo >> 8) & 0xFF] ^
+              crc32c_table[5][(lo >> 16) & 0xFF] ^ crc32c_table[4][lo >> 24] ^
+              crc32c_table[3][hi & 0xFF] ^ crc32c_table[2][(hi >> 8) & 0xFF] ^
+              crc32c_table[1][(hi >> 16) & 0xFF] ^ crc32c_table[0][hi >> 24];
+        p += 8;
+        n -= 8;
+    }
+    while (n--) {
+        crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+#ifdef CHECKSUM_X86
+CHECKSUM_TARGET("sse4.2")
+static uint32_t crc32c_hw(uint32_t crc, const uint8_t* p, size_t n) {
+    uint64_t crc64 = crc;
+    while (n >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        n -= 8;
+    }
+    crc = (uint32_t)crc64;
+    while (n--) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+#elif defined(CHECKSUM_ARM_CRC)
+static uint32_t crc32c_hw(uint32_t crc, const uint8_t* p, size_t n) {
+    while (n >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        crc = __crc32cd(crc, word);
+        p += 8;
+        n -= 8;
+    }
+    while (n--) {
+        crc = __crc32cb(crc, *p++);
+    }
+    return crc;
+}
+#endif
+
+static uint32_t crc32c_update(uint32_t crc, const uint8_t* p, size_t n) {
+#ifdef CHECKSUM_X86
+    probe_cpu();
+    if (cpu_has_sse42) return crc32c_hw(crc, p, n);
+#elif defined(CHECKSUM_ARM_CRC)
+    return crc32c_hw(crc, p, n);
+#endif
+    return crc32c_sw(crc, p, n);
+}
+
+/* ========== SHA-256 ========== */
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_compress_sw(uint32_t h[8], const uint8_t* data, size_t blocks) {
+    while (blocks--) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = (uint32_t)data[i * 4] << 24 | (uint32_t)data[i * 4 + 1] << 16 |
+                   (uint32_t)data[i * 4 + 2] << 8 | (uint32_t)data[i * 4 + 3];
+        }
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t s1 = ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = hh + s1 + ch + sha256_k[i] + w[i];
+            uint32_t s0 = ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + maj;
+            hh = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+        data += 64;
+    }
+}
+
+#ifdef CHECKSUM_X86
+CHECKSUM_TARGET("sha,sse4.1,ssse3")
+static void sha256_compress_shani(uint32_t h[8], const uint8_t* data, size_t blocks) {
+    const __m128i byteswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    
+    __m128i tmp = _mm_loadu_si128((const __m128i*)&h[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i*)&h[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);              /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);        /* EFGH */
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8); /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);     /* CDGH */
+    
+    while (blocks--) {
+        __m128i abef_save = state0;
+        __m128i cdgh_save = state1;
+        __m128i w[4];
+        
+        for (int i = 0; i < 16; i++) {
+            __m128i msg;
+            if (i < 4) {
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + i * 16)), byteswap);
+            } else {
+                /* W[i] = msg2(msg1(W[i-4], W[i-3]) + alignr(W[i-1], W[i-2]), W[i-1]) */
+                __m128i m = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+                m = _mm_add_epi32(m, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+                w[i & 3] = _mm_sha256msg2_epu32(m, w[(i + 3) & 3]);
+            }
+            msg = _mm_add_epi32(w[i & 3], _mm_loadu_si128((const __m128i*)&sha256_k[i * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        }
+        
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        data += 64;
+    }
+    
+    tmp = _mm_shuffle_epi32(state0, 0x1B);           /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);        /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);     /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);        /* ABEF */
+    _mm_storeu_si128((__m128i*)&h[0], state0);
+    _mm_storeu_si128((__m128i*)&h[4], state1);
+}
+#endif
+
+static void sha256_compress(uint32_t h[8], const uint8_t* data, size_t blocks) {
+#ifdef CHECKSUM_X86
+    probe_cpu();
+    if (cpu_has_sha) {
+        sha256_compress_shani(h, data, blocks);
+        return;
+    }
+#endif
+    sha256_compress_sw(h, data, blocks);
+}
+
+static void sha256_update(ChecksumState* state, const uint8_t* p, size_t n) {
+    if (state->block_length > 0) {
+        size_t take = 64 - state->block_length;
+        if (take > n) take = n;
+        memcpy(state->block + state->block_length, p, take);
+        state->block_length += take;
+        p += take;
+        n -= take;
+        if (state->block_length < 64) return;
+        sha256_compress(state->h, state->block, 1);
+        state->block_length = 0;
+    }
+    if (n >= 64) {
+        sha256_compress(state->h, p, n / 64);
+        p += n - (n % 64);
+        n %= 64;
+    }
+    if (n > 0) {
+        memcpy(state->block, p, n);
+        state->block_length = n;
+    }
+}
+
+/* ========== Public API ========== */
+
+ChecksumType checksum_type_from_name(const char* name) {
+    if (name == NULL) return CHECKSUM_NONE;
+    if (strcmp(name, "crc32c") == 0) return CHECKSUM_CRC32C;
+    if (strcmp(name, "sha256") == 0) return CHECKSUM_SHA256;
+    return CHECKSUM_NONE;
+}
+
+const char* checksum_type_name(ChecksumType type) {
+    switch (type) {
+        case CHECKSUM_CRC32C: return "crc32c";
+        case CHECKSUM_SHA256: return "sha256";
+        default: return "none";
+    }
+}
+
+size_t checksum_hex_length(ChecksumType type) {
+    switch (type) {
+        case CHECKSUM_CRC32C: return 8;
+        case CHECKSUM_SHA256: return 64;
+        default: return 0;
+    }
+}
+
+void checksum_init(ChecksumState* state, ChecksumType type) {
+    static const uint32_t sha256_iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    memset(state, 0, sizeof(*state));
+    state->type = type;
+    state->crc = 0xFFFFFFFFu;
+    memcpy(state->h, sha256_iv, sizeof(sha256_iv));
+}
+
+void checksum_update(ChecksumState* state, const void* data, size_t length) {
+    if (length == 0) return;
+    state->total += length;
+    switch (state->type) {
+        case CHECKSUM_CRC32C:
+            state->crc = crc32c_update(state->crc, (const uint8_t*)data, length);
+            break;
+        case CHECKSUM_SHA256:
+            sha256_update(state, (const uint8_t*)data, length);
+            break;
+        default:
+            break;
+    }
+}
+
+size_t checksum_hex(const ChecksumState* state, char* out, size_t out_size) {
+    if (out_size < CHECKSUM_HEX_MAX) {
+        return 0;
+    }
+    
+    if (state->type == CHECKSUM_CRC32C) {
+        return (size_t)snprintf(out, out_size, "%08x", state->crc ^ 0xFFFFFFFFu);
+    }
+    if (state->type != CHECKSUM_SHA256) {
+        out[0] = '\0';
+        return 0;
+    }
+    
+    /* Finalize a copy so the running state stays usable */
+    ChecksumState copy = *state;
+    uint64_t bit_length = copy.total * 8;
+    uint8_t pad[72] = { 0x80 };
+    size_t pad_length = (copy.block_length < 56 ? 56 : 120) - copy.block_length;
+    for (int i = 0; i < 8; i++) {
+        pad[pad_length + i] = (uint8_t)(bit_length >> (56 - 8 * i));
+    }
+    sha256_update(&copy, pad, pad_length + 8);
+    
+    for (int i = 0; i < 8; i++) {
+        snprintf(out + i * 8, out_size - (size_t)i * 8, "%08x", copy.h[i]);
+    }
+    return 64;
+}
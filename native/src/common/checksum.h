@@ -0,0 +1,79 @@
+/**
+ * @file checksum.h
+ * @brief Incremental content checksums for uplink-nodejs native module
+ * 
+ * CRC32C and SHA-256, updated as bytes stream through an upload or a
+ * verified download. Hardware
+ * paths (SSE4.2 / ARMv8 CRC32, SHA-NI) are selected at runtime when the
+ * CPU supports them, with portable fallbacks otherwise. Safe to use from
+ * worker threads (no shared state besides the one-time CPU probe).
+ */
+
+#ifndef UPLINK_CHECKSUM_H
+#define UPLINK_CHECKSUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Supported checksum algorithms
+ */
+typedef enum {
+    CHECKSUM_NONE = 0,
+    CHECKSUM_CRC32C,
+    CHECKSUM_SHA256
+} ChecksumType;
+
+/** Hex digest buffer size large enough for any algorithm (incl. NUL) */
+#define CHECKSUM_HEX_MAX 65
+
+/**
+ * Running checksum state
+ */
+typedef struct {
+    ChecksumType type;
+    uint32_t crc;
+    uint32_t h[8];
+    uint64_t total;
+    uint8_t block[64];
+    size_t block_length;
+} ChecksumState;
+
+/**
+ * Parse an algorithm name ("crc32c" or "sha256")
+ * @return The algorithm, or CHECKSUM_NONE if unknown
+ */
+ChecksumType checksum_type_from_name(const char* name);
+
+/**
+ * Get the canonical algorithm name
+ */
+const char* checksum_type_name(ChecksumType type);
+
+/**
+ * Length of the hex digest of @p type (0 for CHECKSUM_NONE)
+ */
+size_t checksum_hex_length(ChecksumType type);
+
+/**
+ * Reset @p state for @p type
+ */
+void checksum_init(ChecksumState* state, ChecksumType type);
+
+/**
+ * Feed @p length bytes into the checksum
+ */
+void checksum_update(ChecksumState* state, const void* data, size_t length);
+
+/**
+ * Write the lowercase hex digest of everything fed so far.
+ * Does not modify @p state, so hashing may continue afterwards.
+ * 
+ * @param state Checksum state
+ * @param out Output buffer (at least CHECKSUM_HEX_MAX bytes)
+ * @param out_size Output buffer size
+ * @return Length of the hex string, or 0 if @p state has no algorithm
+ */
+size_t checksum_hex(const ChecksumState* state, char* out, size_t out_size);
+
+#endif /* UPLINK_CHECKSUM_H */
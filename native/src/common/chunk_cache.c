@@ -0,0 +1,483 @@
+/**
+ * @file chunk_cache.c
+ * @brief Opt-in process-wide disk chunk cache implementation
+ *
+ * Files are created under a temporary name and hard-linked into place,
+ * so other processes only ever open complete headers. Eviction lists the
+ * directory and removes files by modification time, which every open and
+ * chunk write bumps; a file another process still has mapped stays
+ * readable after unlink on POSIX and is skipped on Windows. Disk usage is
+ * tracked from scans plus this process's writes, with a rescan whenever
+ * the budget is exceeded, so processes sharing a directory keep it near
+ * the budget without coordinating.
+ */
+
+#include "chunk_cache.h"
+#include "file_helpers.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_CACHE_MAGIC "UPLKCHK1"
+#define CHUNK_CACHE_VERSION 1
+#define CHUNK_CACHE_SUFFIX ".chunks"
+#define CHUNK_CACHE_PAGE 4096
+
+/** Eviction brings usage down to this share of the budget, so it does not run on every write */
+#define CHUNK_CACHE_EVICT_TARGET(max) ((max) / 10 * 9)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t id_length;             /* bucket '\0' key bytes after the header */
+    uint64_t chunk_size;
+    uint64_t content_length;
+    int64_t created;
+    uint64_t chunk_count;
+    uint64_t flags_offset;
+    uint64_t data_offset;
+} ChunkCacheHeader;
+
+struct ChunkCacheFile {
+    int fd;
+    FileMapping map;
+    const volatile uint8_t* flags;
+    uint64_t flags_offset;
+    uint64_t data_offset;
+    uint64_t chunk_count;
+    uint64_t content_length;
+    size_t chunk_size;
+};
+
+typedef struct {
+    char* directory;
+    ChunkCacheStats stats;
+    bool evicting;                  /* One eviction scan at a time */
+} ChunkCache;
+
+static uv_once_t chunk_cache_once = UV_ONCE_INIT;
+static uv_mutex_t chunk_cache_lock;
+static ChunkCache* cache;
+static uint64_t temp_counter;
+
+static void chunk_cache_init(void) {
+    uv_mutex_init(&chunk_cache_lock);
+}
+
+/* ========== helpers ========== */
+
+/** FNV-1a, 64-bit, over bucket '\0' key */
+static uint64_t hash_id(const char* bucket, const char* key) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char* p = bucket; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 1099511628211ull;
+    }
+    hash = (hash ^ 0) * 1099511628211ull;
+    for (const char* p = key; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static char* path_join(const char* directory, const char* name) {
+    size_t length = strlen(directory) + 1 + strlen(name) + 1;
+    char* path = (char*)malloc(length);
+    if (path != NULL) {
+        snprintf(path, length, "%s/%s", directory, name);
+    }
+    return path;
+}
+
+static uint64_t round_up(uint64_t value, uint64_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+/** Space a file takes on disk (allocated blocks where the platform reports them) */
+static uint64_t file_usage(const uv_stat_t* st) {
+    return st->st_blocks > 0 ? st->st_blocks * 512 : st->st_size;
+}
+
+static int ends_with(const char* name, const char* suffix) {
+    size_t name_length = strlen(name);
+    size_t suffix_length = strlen(suffix);
+    return name_length >= suffix_length && strcmp(name + name_length - suffix_length, suffix) == 0;
+}
+
+/** Mark a file as recently used for eviction */
+static void touch(int fd) {
+    uv_timeval64_t tv;
+    if (uv_gettimeofday(&tv) != 0) return;
+    double now = (double)tv.tv_sec + (double)tv.tv_usec / 1e6;
+    uv_fs_t req;
+    uv_fs_futime(NULL, &req, fd, now, now, NULL);
+    uv_fs_req_cleanup(&req);
+}
+
+/* ========== eviction ========== */
+
+typedef struct {
+    char* path;
+    double mtime;
+    uint64_t usage;
+} CacheListing;
+
+static int compare_mtime(const void* a, const void* b) {
+    double left = ((const CacheListing*)a)->mtime;
+    double right = ((const CacheListing*)b)->mtime;
+    return left < right ? -1 : left > right ? 1 : 0;
+}
+
+/**
+ * List the cache files of @p directory and, if they exceed @p max_bytes,
+ * remove the least recently used ones down to the eviction target.
+ * @param[out] evicted Files removed
+ * @return Disk usage left, or -1 if the directory cannot be listed
+ */
+static int64_t evict_scan(const char* directory, uint64_t max_bytes, uint64_t* evicted) {
+    *evicted = 0;
+    uv_fs_t req;
+    int count = uv_fs_scandir(NULL, &req, directory, 0, NULL);
+    if (count < 0) {
+        uv_fs_req_cleanup(&req);
+        return -1;
+    }
+
+    CacheListing* files = (CacheListing*)calloc((size_t)count + 1, sizeof(CacheListing));
+    size_t file_count = 0;
+    uint64_t total = 0;
+    uv_dirent_t entry;
+    while (uv_fs_scandir_next(&req, &entry) != UV_EOF) {
+        if (files == NULL || !ends_with(entry.name, CHUNK_CACHE_SUFFIX)) {
+            continue;
+        }
+        char* path = path_join(directory, entry.name);
+        if (path == NULL) {
+            continue;
+        }
+        uv_fs_t stat_req;
+        if (uv_fs_stat(NULL, &stat_req, path, NULL) != 0) {
+            uv_fs_req_cleanup(&stat_req);
+            free(path);
+            continue;
+        }
+        files[file_count].path = path;
+        files[file_count].mtime = (double)stat_req.statbuf.st_mtim.tv_sec + (double)stat_req.statbuf.st_mtim.tv_nsec / 1e9;
+        files[file_count].usage = file_usage(&stat_req.statbuf);
+        total += files[file_count].usage;
+        file_count++;
+        uv_fs_req_cleanup(&stat_req);
+    }
+    uv_fs_req_cleanup(&req);
+    if (files == NULL) {
+        return -1;
+    }
+
+    if (total > max_bytes) {
+        qsort(files, file_count, sizeof(CacheListing), compare_mtime);
+        for (size_t i = 0; i < file_count && total > CHUNK_CACHE_EVICT_TARGET(max_bytes); i++) {
+            uv_fs_t unlink_req;
+            if (uv_fs_unlink(NULL, &unlink_req, files[i].path, NULL) == 0) {
+                total -= files[i].usage;
+                (*evicted)++;
+            }
+            uv_fs_req_cleanup(&unlink_req);
+        }
+    }
+    for (size_t i = 0; i < file_count; i++) {
+        free(files[i].path);
+    }
+    free(files);
+    return (int64_t)total;
+}
+
+/** Run an eviction scan if this process's estimate is over budget and no other thread is scanning */
+static void evict_if_needed(void) {
+    uv_mutex_lock(&chunk_cache_lock);
+    if (cache == NULL || cache->evicting || cache->stats.bytes <= cache->stats.max_bytes) {
+        uv_mutex_unlock(&chunk_cache_lock);
+        return;
+    }
+    cache->evicting = true;
+    char* directory = strdup(cache->directory);
+    uint64_t max_bytes = cache->stats.max_bytes;
+    uv_mutex_unlock(&chunk_cache_lock);
+
+    uint64_t evicted = 0;
+    int64_t usage = directory != NULL ? evict_scan(directory, max_bytes, &evicted) : -1;
+    if (evicted > 0) {
+        LOG_DEBUG("chunk cache evicted %llu files", (unsigned long long)evicted);
+    }
+
+    uv_mutex_lock(&chunk_cache_lock);
+    if (cache != NULL) {
+        cache->evicting = false;
+    }
+    if (cache != NULL && directory != NULL && strcmp(cache->directory, directory) == 0) {
+        cache->stats.evictions += evicted;
+        if (usage >= 0) {
+            cache->stats.bytes = (uint64_t)usage;
+        }
+    }
+    uv_mutex_unlock(&chunk_cache_lock);
+    free(directory);
+}
+
+/* ========== files ========== */
+
+/** Write a new cache file under a temporary name and link it to @p path */
+static int create_file(const char* path, const ChunkCacheHeader* header, const char* id) {
+    uv_mutex_lock(&chunk_cache_lock);
+    uint64_t counter = ++temp_counter;
+    uv_mutex_unlock(&chunk_cache_lock);
+
+    size_t temp_length = strlen(path) + 64;
+    char* temp = (char*)malloc(temp_length);
+    if (temp == NULL) return -1;
+    snprintf(temp, temp_length, "%s.%d.%llu.tmp", path, (int)uv_os_getpid(), (unsigned long long)counter);
+
+    /* Decrypted object bytes: readable by this user only */
+    uv_fs_t req;
+    int fd = uv_fs_open(NULL, &req, temp, UV_FS_O_RDWR | UV_FS_O_CREAT | UV_FS_O_EXCL, 0600, NULL);
+    uv_fs_req_cleanup(&req);
+    if (fd < 0) {
+        free(temp);
+        return -1;
+    }
+
+    int rc = -1;
+    uint64_t size = header->data_offset + header->content_length;
+    if (file_write_at(fd, header, sizeof(*header), 0) == (int64_t)sizeof(*header) &&
+        file_write_at(fd, id, header->id_length, sizeof(*header)) == (int64_t)header->id_length &&
+        uv_fs_ftruncate(NULL, &req, fd, (int64_t)size, NULL) == 0) {
+        uv_fs_req_cleanup(&req);
+        /* Another process may have linked the same version first; either file will do */
+        int linked = uv_fs_link(NULL, &req, temp, path, NULL);
+        rc = linked == 0 || linked == UV_EEXIST ? 0 : -1;
+    }
+    uv_fs_req_cleanup(&req);
+    file_close(fd);
+    uv_fs_unlink(NULL, &req, temp, NULL);
+    uv_fs_req_cleanup(&req);
+    free(temp);
+    return rc;
+}
+
+/** Check that an opened file holds exactly the expected version */
+static int check_file(int fd, const ChunkCacheHeader* expected, const char* id) {
+    ChunkCacheHeader header;
+    if (file_read_at(fd, &header, sizeof(header), 0) != (int64_t)sizeof(header) ||
+        memcmp(&header, expected, sizeof(header)) != 0 ||
+        file_size(fd) != (int64_t)(expected->data_offset + expected->content_length)) {
+        return -1;
+    }
+    char* stored = (char*)malloc(expected->id_length);
+    if (stored == NULL) return -1;
+    int rc = file_read_at(fd, stored, expected->id_length, sizeof(header)) == (int64_t)expected->id_length &&
+             memcmp(stored, id, expected->id_length) == 0 ? 0 : -1;
+    free(stored);
+    return rc;
+}
+
+/* ========== public API ========== */
+
+int chunk_cache_enable(const char* directory, uint64_t max_bytes, size_t chunk_size) {
+    uv_once(&chunk_cache_once, chunk_cache_init);
+
+    uv_fs_t req;
+    int rc = uv_fs_mkdir(NULL, &req, directory, 0700, NULL);
+    uv_fs_req_cleanup(&req);
+    if (rc != 0 && rc != UV_EEXIST) {
+        return rc;
+    }
+
+    uint64_t evicted = 0;
+    int64_t usage = evict_scan(directory, max_bytes, &evicted);
+    if (usage < 0) {
+        return UV_EACCES;
+    }
+
+    ChunkCache* created = (ChunkCache*)calloc(1, sizeof(ChunkCache));
+    if (created == NULL || (created->directory = strdup(directory)) == NULL) {
+        free(created);
+        return UV_ENOMEM;
+    }
+    created->stats.max_bytes = max_bytes;
+    created->stats.chunk_size = chunk_size;
+    created->stats.bytes = (uint64_t)usage;
+    created->stats.evictions = evicted;
+
+    chunk_cache_disable();
+    uv_mutex_lock(&chunk_cache_lock);
+    cache = created;
+    uv_mutex_unlock(&chunk_cache_lock);
+
+    LOG_INFO("chunk cache enabled in %s (max %llu bytes, %zu byte chunks, %llu bytes in use)", directory,
+             (unsigned long long)max_bytes, chunk_size, (unsigned long long)usage);
+    return 0;
+}
+
+void chunk_cache_disable(void) {
+    uv_once(&chunk_cache_once, chunk_cache_init);
+
+    uv_mutex_lock(&chunk_cache_lock);
+    ChunkCache* old = cache;
+    cache = NULL;
+    uv_mutex_unlock(&chunk_cache_lock);
+    if (old != NULL) {
+        free(old->directory);
+        free(old);
+        LOG_DEBUG("chunk cache disabled");
+    }
+}
+
+size_t chunk_cache_chunk_size(void) {
+    uv_once(&chunk_cache_once, chunk_cache_init);
+
+    uv_mutex_lock(&chunk_cache_lock);
+    size_t chunk_size = cache != NULL ? cache->stats.chunk_size : 0;
+    uv_mutex_unlock(&chunk_cache_lock);
+    return chunk_size;
+}
+
+ChunkCacheFile* chunk_cache_open(const char* bucket, const char* key, int64_t created,
+                                 uint64_t content_length, size_t chunk_size) {
+    uv_once(&chunk_cache_once, chunk_cache_init);
+    if (content_length == 0 || chunk_size == 0) return NULL;
+
+    uv_mutex_lock(&chunk_cache_lock);
+    char* directory = cache != NULL ? strdup(cache->directory) : NULL;
+    uv_mutex_unlock(&chunk_cache_lock);
+    if (directory == NULL) return NULL;
+
+    size_t bucket_length = strlen(bucket);
+    size_t id_length = bucket_length + 1 + strlen(key);
+    char* id = (char*)malloc(id_length);
+    if (id == NULL) {
+        free(directory);
+        return NULL;
+    }
+    memcpy(id, bucket, bucket_length + 1);
+    memcpy(id + bucket_length + 1, key, id_length - bucket_length - 1);
+
+    ChunkCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHUNK_CACHE_MAGIC, sizeof(header.magic));
+    header.version = CHUNK_CACHE_VERSION;
+    header.id_length = (uint32_t)id_length;
+    header.chunk_size = chunk_size;
+    header.content_length = content_length;
+    header.created = created;
+    header.chunk_count = (content_length + chunk_size - 1) / chunk_size;
+    header.flags_offset = sizeof(header) + id_length;
+    header.data_offset = round_up(header.flags_offset + header.chunk_count, CHUNK_CACHE_PAGE);
+
+    char name[128];
+    snprintf(name, sizeof(name), "%016llx-%llx-%llx-%zx" CHUNK_CACHE_SUFFIX, (unsigned long long)hash_id(bucket, key),
+             (unsigned long long)created, (unsigned long long)content_length, chunk_size);
+    char* path = path_join(directory, name);
+    free(directory);
+    if (path == NULL) {
+        free(id);
+        return NULL;
+    }
+
+    uv_fs_t req;
+    int fd = uv_fs_open(NULL, &req, path, UV_FS_O_RDWR, 0, NULL);
+    uv_fs_req_cleanup(&req);
+    if (fd == UV_ENOENT && create_file(path, &header, id) == 0) {
+        fd = uv_fs_open(NULL, &req, path, UV_FS_O_RDWR, 0, NULL);
+        uv_fs_req_cleanup(&req);
+    }
+
+    ChunkCacheFile* file = NULL;
+    if (fd >= 0 && check_file(fd, &header, id) == 0 && (file = (ChunkCacheFile*)calloc(1, sizeof(*file))) != NULL &&
+        file_map_range(fd, 0, (size_t)(header.data_offset + content_length), &file->map) == 0) {
+        file->fd = fd;
+        file->flags = file->map.data + header.flags_offset;
+        file->flags_offset = header.flags_offset;
+        file->data_offset = header.data_offset;
+        file->chunk_count = header.chunk_count;
+        file->content_length = content_length;
+        file->chunk_size = chunk_size;
+        touch(fd);
+    } else {
+        LOG_DEBUG("chunk cache file %s unusable; reading %s/%s uncached", path, bucket, key);
+        free(file);
+        file = NULL;
+        if (fd >= 0) file_close(fd);
+    }
+    free(path);
+    free(id);
+    return file;
+}
+
+const uint8_t* chunk_cache_get(ChunkCacheFile* file, uint64_t index) {
+    if (file == NULL || index >= file->chunk_count || file->flags[index] != 1) {
+        return NULL;
+    }
+    return file->map.data + file->data_offset + index * file->chunk_size;
+}
+
+void chunk_cache_put(ChunkCacheFile* file, uint64_t index, const uint8_t* data, size_t length) {
+    if (file == NULL || index >= file->chunk_count) return;
+
+    /* The flag goes out only after the chunk, so readers never see a partial chunk */
+    static const uint8_t present = 1;
+    int64_t offset = (int64_t)(file->data_offset + index * file->chunk_size);
+    bool stored = file_write_at(file->fd, data, length, offset) == (int64_t)length &&
+                  file_write_at(file->fd, &present, 1, (int64_t)(file->flags_offset + index)) == 1;
+
+    uv_mutex_lock(&chunk_cache_lock);
+    bool over = false;
+    if (cache != NULL) {
+        if (stored) {
+            cache->stats.chunks_stored++;
+            cache->stats.bytes += length;
+            over = cache->stats.bytes > cache->stats.max_bytes;
+        } else {
+            cache->stats.write_errors++;
+        }
+    }
+    uv_mutex_unlock(&chunk_cache_lock);
+    if (over) {
+        evict_if_needed();
+    }
+}
+
+void chunk_cache_count(uint64_t hit_bytes, uint64_t miss_bytes) {
+    uv_once(&chunk_cache_once, chunk_cache_init);
+
+    uv_mutex_lock(&chunk_cache_lock);
+    if (cache != NULL) {
+        cache->stats.hit_bytes += hit_bytes;
+        cache->stats.miss_bytes += miss_bytes;
+    }
+    uv_mutex_unlock(&chunk_cache_lock);
+}
+
+void chunk_cache_close(ChunkCacheFile* file) {
+    if (file == NULL) return;
+    file_unmap(&file->map);
+    file_close(file->fd);
+    free(file);
+}
+
+int chunk_cache_stats(ChunkCacheStats* out, char** directory) {
+    uv_once(&chunk_cache_once, chunk_cache_init);
+
+    uv_mutex_lock(&chunk_cache_lock);
+    int rc = -1;
+    if (cache != NULL) {
+        *out = cache->stats;
+        if (directory != NULL) {
+            *directory = strdup(cache->directory);
+        }
+        rc = 0;
+    }
+    uv_mutex_unlock(&chunk_cache_lock);
+    return rc;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file chunk_cache.h
+ * @brief Opt-in process-wide disk cache of object chunks for ranged downloads
+ *
+ * Each object version gets one sparse cache file in the cache directory,
+ * named after a hash of bucket/key, its creation time, content length and
+ * the chunk size, so a replaced object never matches an old file:
+ *
+ *   header  = ChunkCacheHeader, then the bucket '\0' key bytes
+ *   flags   = one byte per chunk, 1 once the chunk is stored
+ *   data    = chunk i at data_offset + i * chunk_size (page aligned)
+ *
+ * Chunks and flags are written with positional writes, data before flag,
+ * and read through a shared read-only mapping, so several processes on a
+ * host can fill and read the same files. A size budget evicts the least
+ * recently used files. Safe to call from worker threads.
+ */
+
+#ifndef UPLINK_CHUNK_CACHE_H
+#define UPLINK_CHUNK_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Default chunk size for enableChunkCache (1 MiB) */
+#define CHUNK_CACHE_DEFAULT_CHUNK_SIZE (1024 * 1024)
+
+/** Default disk budget for enableChunkCache (1 GiB) */
+#define CHUNK_CACHE_DEFAULT_MAX_BYTES (1024LL * 1024 * 1024)
+
+/** Chunk sizes accepted by enableChunkCache: 64 KiB to 64 MiB, powers of two */
+#define CHUNK_CACHE_MIN_CHUNK_SIZE (64 * 1024)
+#define CHUNK_CACHE_MAX_CHUNK_SIZE (64 * 1024 * 1024)
+
+/**
+ * One object version's cache file, opened by a download
+ */
+typedef struct ChunkCacheFile ChunkCacheFile;
+
+/**
+ * Process counters
+ */
+typedef struct {
+    uint64_t hit_bytes;         /* Bytes handed out from cache files */
+    uint64_t miss_bytes;        /* Bytes fetched because their chunk was missing */
+    uint64_t chunks_stored;
+    uint64_t write_errors;
+    uint64_t evictions;         /* Files removed to stay under max_bytes */
+    uint64_t bytes;             /* Disk usage of the directory, as of the last scan plus writes since */
+    uint64_t max_bytes;
+    size_t chunk_size;
+} ChunkCacheStats;
+
+/**
+ * Enable (or reconfigure) the cache, creating @p directory (0700) if
+ * missing and evicting down to @p max_bytes. Files already there are
+ * reused; new ones are created 0600.
+ *
+ * @return 0 on success, or a negative libuv error code
+ */
+int chunk_cache_enable(const char* directory, uint64_t max_bytes, size_t chunk_size);
+
+/**
+ * Disable the cache; open files stay usable until closed, nothing is deleted
+ */
+void chunk_cache_disable(void);
+
+/**
+ * Chunk size of the enabled cache, or 0 when disabled
+ */
+size_t chunk_cache_chunk_size(void);
+
+/**
+ * Open (creating if needed) the cache file of an object version
+ *
+ * @param chunk_size Chunk size the download was aligned to
+ * @return The file, or NULL when the cache is disabled, the object is
+ *         empty, or the file cannot be used (downloads then fetch everything)
+ */
+ChunkCacheFile* chunk_cache_open(const char* bucket, const char* key, int64_t created,
+                                 uint64_t content_length, size_t chunk_size);
+
+/**
+ * Get a stored chunk
+ *
+ * @return Its bytes (valid until chunk_cache_close), or NULL if missing
+ *         or @p file is NULL
+ */
+const uint8_t* chunk_cache_get(ChunkCacheFile* file, uint64_t index);
+
+/**
+ * Store a fetched chunk (no-op for a NULL file; write errors are counted, not reported)
+ */
+void chunk_cache_put(ChunkCacheFile* file, uint64_t index, const uint8_t* data, size_t length);
+
+/**
+ * Count bytes handed out from the cache and fetched over the network
+ */
+void chunk_cache_count(uint64_t hit_bytes, uint64_t miss_bytes);
+
+/**
+ * Close a file opened by chunk_cache_open (NULL is a no-op)
+ */
+void chunk_cache_close(ChunkCacheFile* file);
+
+/**
+ * Read the process counters
+ *
+ * @param[out] directory Receives a copy of the directory (caller frees), may be NULL
+ * @return 0 on success, -1 when the cache is disabled
+ */
+int chunk_cache_stats(ChunkCacheStats* out, char** directory);
+
+#endif /* UPLINK_CHUNK_CACHE_H */
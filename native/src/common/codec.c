@@ -0,0 +1,232 @@
+/**
+ * @file codec.c
+ * @brief Chunked compression stage implementation
+ *
+ * LZ4 block format: sequences of a token (literal length high nibble,
+ * match length - 4 low nibble), length extension bytes of 255, literals,
+ * and a 16-bit little endian match offset. The last 5 bytes are always
+ * literals and the last match starts at least 12 bytes before the end,
+ * so any LZ4 decoder can read the output. The compressor is the greedy
+ * single-probe hash search of the reference fast mode.
+ */
+
+#include "codec.h"
+
+#include <string.h>
+
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MF_LIMIT 12
+#define LZ4_MAX_DISTANCE 65535
+#define LZ4_HASH_LOG 12
+#define LZ4_SKIP_TRIGGER 6
+
+/* ========== helpers ========== */
+
+static inline uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32_t lz4_hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ4_HASH_LOG);
+}
+
+/** Write the extension bytes of a length field that overflowed its nibble */
+static uint8_t* put_length(uint8_t* op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (uint8_t)length;
+    return op;
+}
+
+/** Worst-case bytes for a sequence of @p literals literals */
+static size_t sequence_bound(size_t literals) {
+    return 1 + literals / 255 + 1 + literals;
+}
+
+/* ========== LZ4 block ========== */
+
+static size_t lz4_compress(const uint8_t* src, size_t length, uint8_t* dst, size_t capacity) {
+    const uint8_t* ip = src;
+    const uint8_t* anchor = src;
+    const uint8_t* end = src + length;
+    uint8_t* op = dst;
+    uint8_t* op_end = dst + capacity;
+
+    if (length > LZ4_MF_LIMIT) {
+        uint32_t table[1 << LZ4_HASH_LOG];
+        const uint8_t* mf_limit = end - LZ4_MF_LIMIT;
+        const uint8_t* match_limit = end - LZ4_LAST_LITERALS;
+        memset(table, 0, sizeof(table));
+
+        size_t searches = 1u << LZ4_SKIP_TRIGGER;
+        ip++;
+        while (ip <= mf_limit) {
+            uint32_t hash = lz4_hash(read32(ip));
+            const uint8_t* ref = src + table[hash];
+            table[hash] = (uint32_t)(ip - src);
+            if ((size_t)(ip - ref) > LZ4_MAX_DISTANCE || read32(ref) != read32(ip)) {
+                /* Step further the longer nothing matches, so incompressible data stays fast */
+                ip += searches++ >> LZ4_SKIP_TRIGGER;
+                continue;
+            }
+            searches = 1u << LZ4_SKIP_TRIGGER;
+
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+            const uint8_t* match_end = ip + LZ4_MIN_MATCH;
+            const uint8_t* ref_end = ref + LZ4_MIN_MATCH;
+            while (match_end < match_limit && *match_end == *ref_end) {
+                match_end++;
+                ref_end++;
+            }
+
+            size_t literals = (size_t)(ip - anchor);
+            size_t match_length = (size_t)(match_end - ip) - LZ4_MIN_MATCH;
+            if (sequence_bound(literals) + 2 + match_length / 255 + 1 > (size_t)(op_end - op)) {
+                return 0;
+            }
+            uint8_t* token = op++;
+            if (literals >= 15) {
+                *token = 15 << 4;
+                op = put_length(op, literals - 15);
+            } else {
+                *token = (uint8_t)(literals << 4);
+            }
+            memcpy(op, anchor, literals);
+            op += literals;
+
+            uint16_t offset = (uint16_t)(ip - ref);
+            *op++ = (uint8_t)offset;
+            *op++ = (uint8_t)(offset >> 8);
+            if (match_length >= 15) {
+                *token |= 15;
+                op = put_length(op, match_length - 15);
+            } else {
+                *token |= (uint8_t)match_length;
+            }
+
+            ip = match_end;
+            anchor = ip;
+            if (ip <= mf_limit) {
+                table[lz4_hash(read32(ip - 2))] = (uint32_t)(ip - 2 - src);
+            }
+        }
+    }
+
+    size_t literals = (size_t)(end - anchor);
+    if (sequence_bound(literals) > (size_t)(op_end - op)) {
+        return 0;
+    }
+    uint8_t* token = op++;
+    if (literals >= 15) {
+        *token = 15 << 4;
+        op = put_length(op, literals - 15);
+    } else {
+        *token = (uint8_t)(literals << 4);
+    }
+    memcpy(op, anchor, literals);
+    op += literals;
+    return (size_t)(op - dst);
+}
+
+/** Read the extension bytes of a length field, or SIZE_MAX if truncated */
+static size_t get_length(const uint8_t** ip, const uint8_t* end, size_t length) {
+    uint8_t byte;
+    do {
+        if (*ip >= end) {
+            return SIZE_MAX;
+        }
+        byte = *(*ip)++;
+        length += byte;
+    } while (byte == 255);
+    return length;
+}
+
+static int lz4_decompress(const uint8_t* src, size_t length, uint8_t* dst, size_t raw_length) {
+    const uint8_t* ip = src;
+    const uint8_t* end = src + length;
+    uint8_t* op = dst;
+    uint8_t* op_end = dst + raw_length;
+
+    while (ip < end) {
+        uint8_t token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15 && (literals = get_length(&ip, end, literals)) == SIZE_MAX) {
+            return -1;
+        }
+        if (literals > (size_t)(end - ip) || literals > (size_t)(op_end - op)) {
+            return -1;
+        }
+        memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+        if (ip == end) {
+            break;  /* The last sequence has no match */
+        }
+
+        if (end - ip < 2) {
+            return -1;
+        }
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst)) {
+            return -1;
+        }
+        size_t match_length = token & 15;
+        if (match_length == 15 && (match_length = get_length(&ip, end, match_length)) == SIZE_MAX) {
+            return -1;
+        }
+        match_length += LZ4_MIN_MATCH;
+        if (match_length > (size_t)(op_end - op)) {
+            return -1;
+        }
+
+        const uint8_t* match = op - offset;
+        if (offset >= match_length) {
+            memcpy(op, match, match_length);
+        } else {
+            /* Overlapping copy repeats the last offset bytes */
+            for (size_t i = 0; i < match_length; i++) {
+                op[i] = match[i];
+            }
+        }
+        op += match_length;
+    }
+    return op == op_end ? 0 : -1;
+}
+
+/* ========== public API ========== */
+
+CodecType codec_type_from_name(const char* name) {
+    if (name == NULL) return CODEC_NONE;
+    if (strcmp(name, "lz4") == 0) return CODEC_LZ4;
+    return CODEC_NONE;
+}
+
+const char* codec_type_name(CodecType type) {
+    switch (type) {
+        case CODEC_LZ4: return "lz4";
+        default: return "none";
+    }
+}
+
+size_t codec_compress(CodecType type, const uint8_t* src, size_t length, uint8_t* dst, size_t capacity) {
+    switch (type) {
+        case CODEC_LZ4: return lz4_compress(src, length, dst, capacity);
+        default: return 0;
+    }
+}
+
+int codec_decompress(CodecType type, const uint8_t* src, size_t length, uint8_t* dst, size_t raw_length) {
+    switch (type) {
+        case CODEC_LZ4: return lz4_decompress(src, length, dst, raw_length);
+        default: return -1;
+    }
+}
@@ -0,0 +1,90 @@
+/**
+ * @file codec.h
+ * @brief Chunked compression stage for uplink-nodejs native module
+ *
+ * Objects uploaded with a codec are stored as a run of frames, one per
+ * fixed-size chunk of the original bytes, followed by an index of frame
+ * sizes so ranged reads can seek to the chunks they need:
+ *
+ *   frame*  = u32 LE header (bit 31 set = stored uncompressed, low bits =
+ *             payload length) + payload
+ *   index   = u32 LE frame size (header included) per chunk
+ *
+ * The codec, chunk size, original size and index offset are recorded in
+ * custom metadata (CODEC_KEY_*). Only LZ4 block compression is built in,
+ * implemented here without an external library. Safe to use from worker
+ * threads (no shared state).
+ */
+
+#ifndef UPLINK_CODEC_H
+#define UPLINK_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Supported codecs
+ */
+typedef enum {
+    CODEC_NONE = 0,
+    CODEC_LZ4
+} CodecType;
+
+/** Default chunk of original bytes compressed per frame (256 KiB) */
+#define CODEC_DEFAULT_CHUNK_SIZE (256 * 1024)
+
+/** Largest chunk size accepted from metadata (64 MiB) */
+#define CODEC_MAX_CHUNK_SIZE (64 * 1024 * 1024)
+
+/** Frame header size */
+#define CODEC_FRAME_HEADER_SIZE 4
+
+/** Frame header flag: payload is the chunk itself */
+#define CODEC_FRAME_STORED 0x80000000u
+
+/* Custom metadata keys describing a compressed object */
+#define CODEC_KEY_NAME         "codec"
+#define CODEC_KEY_CHUNK_SIZE   "codec-chunk-size"
+#define CODEC_KEY_RAW_SIZE     "codec-raw-size"
+#define CODEC_KEY_INDEX_OFFSET "codec-index-offset"
+
+/**
+ * Parse a codec name ("lz4")
+ * @return The codec, or CODEC_NONE if unknown
+ */
+CodecType codec_type_from_name(const char* name);
+
+/**
+ * Get the canonical codec name
+ */
+const char* codec_type_name(CodecType type);
+
+/**
+ * Compress @p length bytes of @p src into @p dst
+ *
+ * @return Compressed size, or 0 if it would not fit in @p capacity
+ *         (store the chunk uncompressed then)
+ */
+size_t codec_compress(CodecType type, const uint8_t* src, size_t length, uint8_t* dst, size_t capacity);
+
+/**
+ * Decompress @p length bytes of @p src into exactly @p raw_length bytes of @p dst
+ *
+ * @return 0 on success, -1 if the input is corrupt
+ */
+int codec_decompress(CodecType type, const uint8_t* src, size_t length, uint8_t* dst, size_t raw_length);
+
+/** Write a u32 little endian */
+static inline void codec_put_u32(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/** Read a u32 little endian */
+static inline uint32_t codec_get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#endif /* UPLINK_CODEC_H */
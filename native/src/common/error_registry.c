@@ -11,13 +11,17 @@
  *   1. init_error_classes() runs an inline JS string that defines:
  *        class StorjError extends Error { ... }
  *        class InternalError extends StorjError { ... }
- *        ... (17 subclasses)
+ *        ... (18 subclasses)
  *      and returns an object mapping class names to constructors.
  *
- *   2. The constructors are stored as persistent napi_ref values.
+ *   2. The constructors are stored as persistent napi_ref values in the
+ *      environment's AddonInstance, indexed like error_registry[].
  *
  *   3. create_typed_error(env, code, message) looks up the right constructor
- *      by error code and calls `new XxxError(details)` via napi_new_instance.
+ *      in a code-indexed table and calls `new XxxError(details)` via
+ *      napi_new_instance. Codes marked by setStacklessErrors() are
+ *      constructed with Error.stackTraceLimit at 0, skipping the stack
+ *      capture that dominates the cost of expected errors like not-found.
  *
  *   4. export_error_classes() attaches every constructor onto the native
  *      module's exports object so TypeScript can import them:
@@ -28,8 +32,10 @@
  */
 
 #include "error_registry.h"
+#include "addon_instance.h"
 #include "result_helpers.h"
 #include "logger.h"
+#include <uv.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -135,6 +141,17 @@ static const char ERROR_CLASSES_JS[] =
     "    constructor(details) { super('Edge register access failed', 0x31, details); }\n"
     "  }\n"
     "\n"
+    "  /* --- Binding errors --- */\n"
+    "  class TimeoutError extends StorjError {\n"
+    "    constructor(details) { super('Operation timed out', 0x40, details); }\n"
+    "  }\n"
+    "  class IntegrityError extends StorjError {\n"
+    "    constructor(details) { super('Integrity check failed', 0x41, details); }\n"
+    "  }\n"
+    "  class CompressedObjectError extends StorjError {\n"
+    "    constructor(details) { super('Object is compressed', 0x42, details); }\n"
+    "  }\n"
+    "\n"
     "  return {\n"
     "    StorjError: StorjError,\n"
     "    InternalError: InternalError,\n"
@@ -153,56 +170,96 @@ static const char ERROR_CLASSES_JS[] =
     "    ObjectNotFoundError: ObjectNotFoundError,\n"
     "    UploadDoneError: UploadDoneError,\n"
     "    EdgeAuthDialFailedError: EdgeAuthDialFailedError,\n"
-    "    EdgeRegisterAccessFailedError: EdgeRegisterAccessFailedError\n"
+    "    EdgeRegisterAccessFailedError: EdgeRegisterAccessFailedError,\n"
+    "    TimeoutError: TimeoutError,\n"
+    "    IntegrityError: IntegrityError,\n"
+    "    CompressedObjectError: CompressedObjectError\n"
     "  };\n"
     "});\n";
 
 /* ========== Error Registry Storage ========== */
 
 /**
- * Entry mapping an uplink-c error code to its JS constructor reference.
+ * Entry mapping an uplink-c error code to its JS class name.
  */
 typedef struct {
     int32_t code;
     const char* name;
-    napi_ref constructor_ref;
 } ErrorClassEntry;
 
 /**
- * Static registry of error classes.
+ * Static registry of error classes; constructor references are per
+ * environment, at the same index in AddonInstance.
  * Order matches uplink_definitions.h.
  * StorjError (base) is stored at index 0 (code 0 — not a real uplink code).
  */
-static ErrorClassEntry error_registry[] = {
-    { 0,                                     "StorjError",                    NULL },
-    { UPLINK_ERROR_INTERNAL,                 "InternalError",                 NULL },
-    { UPLINK_ERROR_CANCELED,                 "CanceledError",                 NULL },
-    { UPLINK_ERROR_INVALID_HANDLE,           "InvalidHandleError",            NULL },
-    { UPLINK_ERROR_TOO_MANY_REQUESTS,        "TooManyRequestsError",          NULL },
-    { UPLINK_ERROR_BANDWIDTH_LIMIT_EXCEEDED, "BandwidthLimitExceededError",   NULL },
-    { UPLINK_ERROR_STORAGE_LIMIT_EXCEEDED,   "StorageLimitExceededError",     NULL },
-    { UPLINK_ERROR_SEGMENTS_LIMIT_EXCEEDED,  "SegmentsLimitExceededError",    NULL },
-    { UPLINK_ERROR_PERMISSION_DENIED,        "PermissionDeniedError",         NULL },
-    { UPLINK_ERROR_BUCKET_NAME_INVALID,      "BucketNameInvalidError",        NULL },
-    { UPLINK_ERROR_BUCKET_ALREADY_EXISTS,    "BucketAlreadyExistsError",      NULL },
-    { UPLINK_ERROR_BUCKET_NOT_EMPTY,         "BucketNotEmptyError",           NULL },
-    { UPLINK_ERROR_BUCKET_NOT_FOUND,         "BucketNotFoundError",           NULL },
-    { UPLINK_ERROR_OBJECT_KEY_INVALID,       "ObjectKeyInvalidError",         NULL },
-    { UPLINK_ERROR_OBJECT_NOT_FOUND,         "ObjectNotFoundError",           NULL },
-    { UPLINK_ERROR_UPLOAD_DONE,              "UploadDoneError",               NULL },
-    { 0x30,                                  "EdgeAuthDialFailedError",       NULL },
-    { 0x31,                                  "EdgeRegisterAccessFailedError", NULL },
+static const ErrorClassEntry error_registry[] = {
+    { 0,                                     "StorjError" },
+    { UPLINK_ERROR_INTERNAL,                 "InternalError" },
+    { UPLINK_ERROR_CANCELED,                 "CanceledError" },
+    { UPLINK_ERROR_INVALID_HANDLE,           "InvalidHandleError" },
+    { UPLINK_ERROR_TOO_MANY_REQUESTS,        "TooManyRequestsError" },
+    { UPLINK_ERROR_BANDWIDTH_LIMIT_EXCEEDED, "BandwidthLimitExceededError" },
+    { UPLINK_ERROR_STORAGE_LIMIT_EXCEEDED,   "StorageLimitExceededError" },
+    { UPLINK_ERROR_SEGMENTS_LIMIT_EXCEEDED,  "SegmentsLimitExceededError" },
+    { UPLINK_ERROR_PERMISSION_DENIED,        "PermissionDeniedError" },
+    { UPLINK_ERROR_BUCKET_NAME_INVALID,      "BucketNameInvalidError" },
+    { UPLINK_ERROR_BUCKET_ALREADY_EXISTS,    "BucketAlreadyExistsError" },
+    { UPLINK_ERROR_BUCKET_NOT_EMPTY,         "BucketNotEmptyError" },
+    { UPLINK_ERROR_BUCKET_NOT_FOUND,         "BucketNotFoundError" },
+    { UPLINK_ERROR_OBJECT_KEY_INVALID,       "ObjectKeyInvalidError" },
+    { UPLINK_ERROR_OBJECT_NOT_FOUND,         "ObjectNotFoundError" },
+    { UPLINK_ERROR_UPLOAD_DONE,              "UploadDoneError" },
+    { 0x30,                                  "EdgeAuthDialFailedError" },
+    { 0x31,                                  "EdgeRegisterAccessFailedError" },
+    { UPLINK_ERROR_TIMEOUT,                  "TimeoutError" },
+    { UPLINK_ERROR_INTEGRITY,                "IntegrityError" },
+    { UPLINK_ERROR_COMPRESSED_OBJECT,        "CompressedObjectError" },
 };
 
 #define ERROR_REGISTRY_SIZE (sizeof(error_registry) / sizeof(error_registry[0]))
 
-/** Whether init_error_classes has been called successfully */
-static int g_registered = 0;
+_Static_assert(ERROR_REGISTRY_SIZE == ERROR_CLASS_COUNT, "ERROR_CLASS_COUNT must match error_registry[]");
+
+/** Codes below this have a slot in error_class_by_code */
+#define ERROR_CODE_LIMIT 0x100
+
+/** error_registry[] index + 1 by code, 0 = no class; filled once per process */
+static uint8_t error_class_by_code[ERROR_CODE_LIMIT];
+static uv_once_t error_class_once = UV_ONCE_INIT;
+
+static void error_class_index_init(void) {
+    for (size_t i = 0; i < ERROR_REGISTRY_SIZE; i++) {
+        int32_t code = error_registry[i].code;
+        if (code >= 0 && code < ERROR_CODE_LIMIT && error_class_by_code[code] == 0) {
+            error_class_by_code[code] = (uint8_t)(i + 1);
+        }
+    }
+}
+
+/** Registry index of @p code, or -1 when no class has it */
+static int error_class_index(int32_t code) {
+    uv_once(&error_class_once, error_class_index_init);
+    if (code < 0 || code >= ERROR_CODE_LIMIT) {
+        return -1;
+    }
+    return (int)error_class_by_code[code] - 1;
+}
 
 /* ========== Public API ========== */
 
-int error_classes_registered(void) {
-    return g_registered;
+int32_t error_code_by_class_name(const char* name) {
+    for (size_t i = 0; i < ERROR_REGISTRY_SIZE; i++) {
+        if (strcmp(error_registry[i].name, name) == 0) {
+            return error_registry[i].code;
+        }
+    }
+    return -1;
+}
+
+int error_classes_registered(napi_env env) {
+    AddonInstance* instance = addon_instance(env);
+    return instance != NULL && instance->errors_registered;
 }
 
 /**
@@ -210,7 +267,7 @@ int error_classes_registered(void) {
  * Returns 1 on success, 0 if the property was missing or not a function.
  */
 static int register_one_error_class(napi_env env, napi_value classes_obj,
-                                    ErrorClassEntry* entry) {
+                                    const ErrorClassEntry* entry, napi_ref* out_ref) {
     napi_value constructor;
     napi_status status = napi_get_named_property(
         env, classes_obj, entry->name, &constructor);
@@ -218,20 +275,20 @@ static int register_one_error_class(napi_env env, napi_value classes_obj,
         LOG_WARN("Failed to get constructor for '%s'", entry->name);
         return 0;
     }
-
+    
     napi_valuetype ctor_type;
     napi_typeof(env, constructor, &ctor_type);
     if (ctor_type != napi_function) {
         LOG_WARN("'%s' is not a function, skipping", entry->name);
         return 0;
     }
-
-    status = napi_create_reference(env, constructor, 1, &entry->constructor_ref);
+    
+    status = napi_create_reference(env, constructor, 1, out_ref);
     if (status != napi_ok) {
         LOG_ERROR("Failed to create reference for '%s'", entry->name);
         return 0;
     }
-
+    
     LOG_DEBUG("Registered error class '%s' for code 0x%02x", entry->name, entry->code);
     return 1;
 }
@@ -253,7 +310,7 @@ static napi_status get_error_base_constructor(napi_env env, size_t argc,
         }
         LOG_WARN("initErrorClasses argument is not a function, falling back to globalThis.Error");
     }
-
+    
     napi_value global;
     napi_status gs = napi_get_global(env, &global);
     if (gs != napi_ok) {
@@ -271,22 +328,28 @@ static napi_status get_error_base_constructor(napi_env env, size_t argc,
 
 napi_value napi_init_error_classes(napi_env env, napi_callback_info info) {
     LOG_INFO("initErrorClasses called from JS — creating error class hierarchy");
-
+    
+    AddonInstance* instance = addon_instance(env);
+    if (instance == NULL) {
+        napi_throw_error(env, NULL, "Native module instance not initialised");
+        return NULL;
+    }
+    
     /* If already initialised, clean up first */
-    if (g_registered) {
-        error_registry_cleanup(env);
+    if (instance->errors_registered) {
+        error_registry_cleanup(env, instance);
     }
-
+    
     size_t argc = 1;
     napi_value argv[1];
     napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
-
+    
     napi_value error_ctor;
     if (get_error_base_constructor(env, argc, argv, &error_ctor) != napi_ok) {
         napi_throw_error(env, NULL, "Failed to get Error constructor");
         return NULL;
     }
-
+    
     /* Create the JS source string (factory function) */
     napi_value script;
     napi_status status = napi_create_string_utf8(
@@ -296,7 +359,7 @@ napi_value napi_init_error_classes(napi_env env, napi_callback_info info) {
         napi_throw_error(env, NULL, "Failed to create error classes JS string");
         return NULL;
     }
-
+    
     /* Execute the factory function */
     napi_value factory_fn;
     status = napi_run_script(env, script, &factory_fn);
@@ -305,11 +368,11 @@ napi_value napi_init_error_classes(napi_env env, napi_callback_info info) {
         napi_throw_error(env, NULL, "Failed to execute error classes factory script");
         return NULL;
     }
-
+    
     /* Call factory(Error) to produce the classes object */
     napi_value undefined_this;
     napi_get_undefined(env, &undefined_this);
-
+    
     napi_value call_args[1] = { error_ctor };
     napi_value classes_obj;
     status = napi_call_function(env, undefined_this, factory_fn, 1, call_args, &classes_obj);
@@ -318,71 +381,83 @@ napi_value napi_init_error_classes(napi_env env, napi_callback_info info) {
         napi_throw_error(env, NULL, "Failed to call error classes factory function");
         return NULL;
     }
-
+    
+    /* Kept to switch off stack capture for stackless codes */
+    napi_create_reference(env, error_ctor, 1, &instance->error_base);
+    
     /* Extract each constructor and store a persistent reference */
     int count = 0;
     for (size_t i = 0; i < ERROR_REGISTRY_SIZE; i++) {
-        count += register_one_error_class(env, classes_obj, &error_registry[i]);
+        count += register_one_error_class(env, classes_obj, &error_registry[i],
+                                          &instance->error_constructors[i]);
     }
-
-    g_registered = 1;
+    
+    instance->errors_registered = 1;
     LOG_INFO("Initialised %d/%d error classes from embedded JS", count, (int)ERROR_REGISTRY_SIZE);
-
+    
     /* Return the classes object so TS can destructure the constructors */
     return classes_obj;
 }
 
 /**
- * Look up a constructor ref by error code.
- * Returns the napi_ref or NULL if not found.
+ * Construct @p constructor with Error.stackTraceLimit at 0, so neither
+ * the Error constructor nor captureStackTrace collects frames.
  */
-static napi_ref find_error_constructor_ref(int32_t code) {
-    for (size_t i = 0; i < ERROR_REGISTRY_SIZE; i++) {
-        if (error_registry[i].code == code &&
-            error_registry[i].constructor_ref != NULL) {
-            return error_registry[i].constructor_ref;
-        }
+static napi_status new_stackless_instance(napi_env env, const AddonInstance* instance, napi_value constructor,
+                                          napi_value* args, napi_value* result) {
+    napi_value error_base, saved_limit, zero;
+    if (napi_get_reference_value(env, instance->error_base, &error_base) != napi_ok || error_base == NULL ||
+        napi_get_named_property(env, error_base, "stackTraceLimit", &saved_limit) != napi_ok) {
+        return napi_new_instance(env, constructor, 1, args, result);
     }
-    return NULL;
+    napi_create_int32(env, 0, &zero);
+    napi_set_named_property(env, error_base, "stackTraceLimit", zero);
+    napi_status status = napi_new_instance(env, constructor, 1, args, result);
+    napi_set_named_property(env, error_base, "stackTraceLimit", saved_limit);
+    return status;
 }
 
 napi_value create_typed_error(napi_env env, int32_t code, const char* message) {
     LOG_DEBUG("create_typed_error: code=0x%02x, message=%s", code,
               message ? message : "(null)");
-
-    if (g_registered) {
-        napi_ref ref = find_error_constructor_ref(code);
-        if (ref != NULL) {
-            napi_value constructor;
-            napi_status status = napi_get_reference_value(env, ref, &constructor);
-
-            if (status == napi_ok) {
-                napi_value args[1];
-                if (message != NULL) {
-                    napi_create_string_utf8(env, message, NAPI_AUTO_LENGTH, &args[0]);
-                } else {
-                    napi_get_undefined(env, &args[0]);
-                }
-
-                napi_value instance;
-                status = napi_new_instance(env, constructor, 1, args, &instance);
-                if (status == napi_ok) {
-                    LOG_DEBUG("Created typed error instance for code 0x%02x", code);
-                    return instance;
-                }
-                LOG_WARN("Failed to instantiate error for code 0x%02x, falling back", code);
+    
+    AddonInstance* instance = addon_instance(env);
+    int index = error_class_index(code);
+    if (instance != NULL && instance->errors_registered && index >= 0 &&
+        instance->error_constructors[index] != NULL) {
+        napi_value constructor;
+        napi_status status = napi_get_reference_value(env, instance->error_constructors[index], &constructor);
+        
+        if (status == napi_ok) {
+            napi_value args[1];
+            if (message != NULL) {
+                napi_create_string_utf8(env, message, NAPI_AUTO_LENGTH, &args[0]);
+            } else {
+                napi_get_undefined(env, &args[0]);
+            }
+            
+            napi_value error;
+            if (instance->stackless_errors[index]) {
+                status = new_stackless_instance(env, instance, constructor, args, &error);
             } else {
-                LOG_WARN("Failed to get reference for code 0x%02x, falling back", code);
+                status = napi_new_instance(env, constructor, 1, args, &error);
+            }
+            if (status == napi_ok) {
+                LOG_DEBUG("Created typed error instance for code 0x%02x", code);
+                return error;
             }
+            LOG_WARN("Failed to instantiate error for code 0x%02x, falling back", code);
+        } else {
+            LOG_WARN("Failed to get reference for code 0x%02x, falling back", code);
         }
     }
-
+    
     /*
      * Fallback: classes not initialised or lookup failed.
      * Create a plain Error with code and name properties.
      */
     LOG_DEBUG("Falling back to plain Error for code 0x%02x", code);
-
+    
     UplinkErrorSimple simple_err = {
         .code = code,
         .message = (char*)(message ? message : "Unknown error")
@@ -390,16 +465,59 @@ napi_value create_typed_error(napi_env env, int32_t code, const char* message) {
     return uplink_error_to_js(env, &simple_err);
 }
 
-void error_registry_cleanup(napi_env env) {
-    LOG_DEBUG("Cleaning up error registry");
+napi_value napi_set_stackless_errors(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    bool is_array = false;
+    if (argc >= 1) {
+        napi_is_array(env, argv[0], &is_array);
+    }
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "codes must be an array of error codes");
+        return NULL;
+    }
+    AddonInstance* instance = addon_instance(env);
+    if (instance == NULL) {
+        napi_throw_error(env, NULL, "Native module instance not initialised");
+        return NULL;
+    }
+    
+    uint8_t stackless[ERROR_CLASS_COUNT] = { 0 };
+    uint32_t length = 0;
+    napi_get_array_length(env, argv[0], &length);
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element;
+        int32_t code = -1;
+        napi_get_element(env, argv[0], i, &element);
+        if (napi_get_value_int32(env, element, &code) != napi_ok || error_class_index(code) < 0) {
+            napi_throw_range_error(env, NULL, "codes must be error codes of StorjError classes");
+            return NULL;
+        }
+        stackless[error_class_index(code)] = 1;
+    }
+    memcpy(instance->stackless_errors, stackless, sizeof(stackless));
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
 
+void error_registry_cleanup(napi_env env, AddonInstance* instance) {
+    LOG_DEBUG("Cleaning up error registry");
+    
     for (size_t i = 0; i < ERROR_REGISTRY_SIZE; i++) {
-        if (error_registry[i].constructor_ref != NULL) {
-            napi_delete_reference(env, error_registry[i].constructor_ref);
-            error_registry[i].constructor_ref = NULL;
+        if (instance->error_constructors[i] != NULL) {
+            napi_delete_reference(env, instance->error_constructors[i]);
+            instance->error_constructors[i] = NULL;
         }
     }
-
-    g_registered = 0;
+    if (instance->error_base != NULL) {
+        napi_delete_reference(env, instance->error_base);
+        instance->error_base = NULL;
+    }
+    
+    instance->errors_registered = 0;
     LOG_INFO("Error registry cleaned up");
 }
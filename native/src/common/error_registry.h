@@ -14,7 +14,9 @@
  *      time, so the classes extend the **caller's realm** Error — which
  *      makes `instanceof Error` work even inside Jest VM sandboxes.
  *
- *   2. The constructors are stored as persistent napi_ref values.
+ *   2. The constructors are stored as persistent napi_ref values in the
+ *      calling environment's AddonInstance, so each worker thread that
+ *      loads the module has its own classes.
  *
  *   3. create_typed_error(env, code, message) looks up the right constructor
  *      by error code and calls `new XxxError(message)` via napi_new_instance.
@@ -39,6 +41,11 @@
 #include <node_api.h>
 #include <stdint.h>
 
+/** Number of error classes: StorjError and its subclasses */
+#define ERROR_CLASS_COUNT 21
+
+struct AddonInstance;
+
 /**
  * N-API callback: initialize error classes from the caller's realm.
  *
@@ -69,15 +76,35 @@ napi_value napi_init_error_classes(napi_env env, napi_callback_info info);
 napi_value create_typed_error(napi_env env, int32_t code, const char* message);
 
 /**
- * Check whether error classes have been initialised.
+ * N-API callback: choose the error codes created without a stack trace.
+ *
+ * Exported as native.setStacklessErrors(codes). Replaces the previous
+ * choice; an empty array restores stacks for all codes.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [codes: number[]]
+ * @return undefined; throws RangeError for a code without a class
+ */
+napi_value napi_set_stackless_errors(napi_env env, napi_callback_info info);
+
+/**
+ * Look up the error code of a class by name (e.g. "TooManyRequestsError").
+ * @return The code, or -1 when no class has that name
+ */
+int32_t error_code_by_class_name(const char* name);
+
+/**
+ * Check whether error classes have been initialised in @p env.
  * @return 1 if initialised, 0 otherwise
  */
-int error_classes_registered(void);
+int error_classes_registered(napi_env env);
 
 /**
- * Clean up persistent references. Call at module teardown.
+ * Clean up the persistent references of one instance. Called when the
+ * classes are re-created and from the instance finalizer.
  * @param env N-API environment
+ * @param instance Instance holding the references
  */
-void error_registry_cleanup(napi_env env);
+void error_registry_cleanup(napi_env env, struct AddonInstance* instance);
 
 #endif /* UPLINK_ERROR_REGISTRY_H */
@@ -0,0 +1,459 @@
+/**
+ * @file file_helpers.c
+ * @brief Positional file I/O utilities implementation
+ * 
+ * POSIX builds use pread/pwrite. Windows builds use ReadFile/WriteFile
+ * with an OVERLAPPED offset, which likewise leaves no shared file
+ * position between threads.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "file_helpers.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <dirent.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int file_open_read(const char* path) {
+#ifdef _WIN32
+    return _open(path, _O_RDONLY | _O_BINARY);
+#else
+    return open(path, O_RDONLY);
+#endif
+}
+
+int file_open_write(const char* path, int truncate) {
+#ifdef _WIN32
+    int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : 0);
+    return _open(path, flags, _S_IREAD | _S_IWRITE);
+#else
+    int flags = O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0);
+    return open(path, flags, 0644);
+#endif
+}
+
+int64_t file_size(int fd) {
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_fstat64(fd, &st) != 0) return -1;
+#else
+    struct stat st;
+    if (fstat(fd, &st) != 0) return -1;
+#endif
+    return (int64_t)st.st_size;
+}
+
+int64_t file_read_at(int fd, void* buffer, size_t length, int64_t offset) {
+    size_t total = 0;
+    while (total < length) {
+#ifdef _WIN32
+        OVERLAPPED ov = {0};
+        uint64_t pos = (uint64_t)(offset + (int64_t)total);
+        ov.Offset = (DWORD)(pos & 0xFFFFFFFFu);
+        ov.OffsetHigh = (DWORD)(pos >> 32);
+        DWORD chunk = (DWORD)((length - total) > 0x40000000u ? 0x40000000u : (length - total));
+        DWORD n = 0;
+        if (!ReadFile((HANDLE)_get_osfhandle(fd), (char*)buffer + total, chunk, &n, &ov)) {
+            if (GetLastError() == ERROR_HANDLE_EOF) break;
+            errno = EIO;
+            return -1;
+        }
+#else
+        ssize_t n = pread(fd, (char*)buffer + total, length - total, (off_t)(offset + (int64_t)total));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+#endif
+        if (n == 0) break;
+        total += (size_t)n;
+    }
+    return (int64_t)total;
+}
+
+int64_t file_write_at(int fd, const void* buffer, size_t length, int64_t offset) {
+    size_t total = 0;
+    while (total < length) {
+#ifdef _WIN32
+        OVERLAPPED ov = {0};
+        uint64_t pos = (uint64_t)(offset + (int64_t)total);
+        ov.Offset = (DWORD)(pos & 0xFFFFFFFFu);
+        ov.OffsetHigh = (DWORD)(pos >> 32);
+        DWORD chunk = (DWORD)((length - total) > 0x40000000u ? 0x40000000u : (length - total));
+        DWORD n = 0;
+        if (!WriteFile((HANDLE)_get_osfhandle(fd), (const char*)buffer + total, chunk, &n, &ov)) {
+            errno = EIO;
+            return -1;
+        }
+#else
+        ssize_t n = pwrite(fd, (const char*)buffer + total, length - total, (off_t)(offset + (int64_t)total));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+#endif
+        total += (size_t)n;
+    }
+    return (int64_t)total;
+}
+
+int file_sync(int fd) {
+#ifdef _WIN32
+    if (!FlushFileBuffers((HANDLE)_get_osfhandle(fd))) {
+        errno = EIO;
+        return -1;
+    }
+    return 0;
+#else
+    int rc;
+    do {
+        rc = fsync(fd);
+    } while (rc != 0 && errno == EINTR);
+    return rc;
+#endif
+}
+
+void file_close(int fd) {
+    if (fd < 0) return;
+#ifdef _WIN32
+    _close(fd);
+#else
+    close(fd);
+#endif
+}
+
+int file_map_range(int fd, int64_t offset, size_t length, FileMapping* out) {
+    memset(out, 0, sizeof(*out));
+    if (fd < 0 || length == 0 || offset < 0) {
+        return -1;
+    }
+    
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    uint64_t granularity = info.dwAllocationGranularity;
+#else
+    long page = sysconf(_SC_PAGESIZE);
+    uint64_t granularity = page > 0 ? (uint64_t)page : 4096;
+#endif
+    uint64_t aligned = (uint64_t)offset - ((uint64_t)offset % granularity);
+    size_t delta = (size_t)((uint64_t)offset - aligned);
+    size_t map_length = length + delta;
+    
+#ifdef _WIN32
+    HANDLE mapping = CreateFileMappingA((HANDLE)_get_osfhandle(fd), NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        return -1;
+    }
+    void* base = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(aligned >> 32),
+                               (DWORD)(aligned & 0xFFFFFFFFu), map_length);
+    /* The view keeps the section alive; the handle is no longer needed */
+    CloseHandle(mapping);
+    if (base == NULL) {
+        return -1;
+    }
+#else
+    void* base = mmap(NULL, map_length, PROT_READ, MAP_SHARED, fd, (off_t)aligned);
+    if (base == MAP_FAILED) {
+        return -1;
+    }
+    posix_madvise(base, map_length, POSIX_MADV_SEQUENTIAL);
+#endif
+    
+    out->map_base = base;
+    out->map_length = map_length;
+    out->data = (const uint8_t*)base + delta;
+    out->length = length;
+    return 0;
+}
+
+void file_unmap(FileMapping* mapping) {
+    if (mapping == NULL || mapping->map_base == NULL) return;
+#ifdef _WIN32
+    UnmapViewOfFile(mapping->map_base);
+#else
+    munmap(mapping->map_base, mapping->map_length);
+#endif
+    memset(mapping, 0, sizeof(*mapping));
+}
+
+/* ========== directory walk ========== */
+
+/** Join @p base and @p name with @p separator into a new string */
+static char* path_join(const char* base, const char* name, char separator) {
+    size_t base_length = strlen(base);
+    size_t length = base_length + 1 + strlen(name) + 1;
+    char* path = (char*)malloc(length);
+    if (path == NULL) return NULL;
+    if (base_length == 0) {
+        snprintf(path, length, "%s", name);
+    } else {
+        snprintf(path, length, "%s%c%s", base, separator, name);
+    }
+    return path;
+}
+
+#ifdef _WIN32
+#define PATH_SEPARATOR '\\'
+#else
+#define PATH_SEPARATOR '/'
+#endif
+
+static int walk_directory(const char* full_dir, const char* relative_dir, FileWalkCallback callback,
+                          void* ctx, int is_root) {
+    int result = 0;
+#ifdef _WIN32
+    char* pattern = path_join(full_dir, "*", PATH_SEPARATOR);
+    if (pattern == NULL) return is_root ? -1 : 0;
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA(pattern, &entry);
+    free(pattern);
+    if (find == INVALID_HANDLE_VALUE) {
+        errno = ENOENT;
+        return is_root ? -1 : 0;
+    }
+    do {
+        const char* name = entry.cFileName;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0 ||
+            (entry.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
+            continue;
+        }
+        int is_dir = (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        int64_t size = ((int64_t)entry.nFileSizeHigh << 32) | entry.nFileSizeLow;
+#else
+    DIR* dir = opendir(full_dir);
+    if (dir == NULL) return is_root ? -1 : 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        const char* name = entry->d_name;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
+            continue;
+        }
+#endif
+        char* full_path = path_join(full_dir, name, PATH_SEPARATOR);
+        char* relative_path = path_join(relative_dir, name, '/');
+        if (full_path == NULL || relative_path == NULL) {
+            free(full_path);
+            free(relative_path);
+            continue;
+        }
+#ifndef _WIN32
+        struct stat st;
+        int is_dir = 0;
+        int is_file = 0;
+        int64_t size = 0;
+        if (lstat(full_path, &st) == 0) {
+            is_dir = S_ISDIR(st.st_mode);
+            is_file = S_ISREG(st.st_mode);
+            size = (int64_t)st.st_size;
+        }
+#else
+        int is_file = !is_dir;
+#endif
+        if (is_dir) {
+            result = walk_directory(full_path, relative_path, callback, ctx, 0);
+        } else if (is_file) {
+            result = callback(relative_path, full_path, size, ctx);
+        }
+        free(full_path);
+        free(relative_path);
+        if (result != 0) {
+            break;
+        }
+#ifdef _WIN32
+    } while (FindNextFileA(find, &entry));
+    FindClose(find);
+#else
+    }
+    closedir(dir);
+#endif
+    return result;
+}
+
+int file_walk_tree(const char* root, FileWalkCallback callback, void* ctx) {
+    return walk_directory(root, "", callback, ctx, 1);
+}
+
+/* ========== sorted directory walk ========== */
+
+typedef struct {
+    char* name;
+    int is_dir;
+    int64_t size;
+    int64_t mtime;
+} SortedEntry;
+
+/** Byte order of the entries' paths; a directory name sorts as if followed by '/' */
+static int compare_sorted_entries(const void* a, const void* b) {
+    const SortedEntry* x = (const SortedEntry*)a;
+    const SortedEntry* y = (const SortedEntry*)b;
+    const unsigned char* p = (const unsigned char*)x->name;
+    const unsigned char* q = (const unsigned char*)y->name;
+    while (*p != '\0' && *p == *q) {
+        p++;
+        q++;
+    }
+    int cx = *p != '\0' ? *p : (x->is_dir ? '/' : 0);
+    int cy = *q != '\0' ? *q : (y->is_dir ? '/' : 0);
+    return cx - cy;
+}
+
+static void free_sorted_entries(SortedEntry* entries, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        free(entries[i].name);
+    }
+    free(entries);
+}
+
+/** Append an entry, taking @p name; -1 with errno = ENOMEM on failure */
+static int add_sorted_entry(SortedEntry** entries, size_t* count, size_t* capacity, char* name,
+                            int is_dir, int64_t size, int64_t mtime) {
+    if (name == NULL) {
+        errno = ENOMEM;
+        return -1;
+    }
+    if (*count == *capacity) {
+        size_t grown = *capacity > 0 ? *capacity * 2 : 64;
+        SortedEntry* resized = (SortedEntry*)realloc(*entries, grown * sizeof(SortedEntry));
+        if (resized == NULL) {
+            free(name);
+            errno = ENOMEM;
+            return -1;
+        }
+        *entries = resized;
+        *capacity = grown;
+    }
+    SortedEntry* entry = &(*entries)[(*count)++];
+    entry->name = name;
+    entry->is_dir = is_dir;
+    entry->size = size;
+    entry->mtime = mtime;
+    return 0;
+}
+
+/** Read the directories and regular files of @p full_dir; -1 with errno set on failure */
+static int read_sorted_entries(const char* full_dir, SortedEntry** out, size_t* out_count) {
+    SortedEntry* entries = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    int failed = 0;
+#ifdef _WIN32
+    char* pattern = path_join(full_dir, "*", PATH_SEPARATOR);
+    if (pattern == NULL) {
+        errno = ENOMEM;
+        return -1;
+    }
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA(pattern, &entry);
+    free(pattern);
+    if (find == INVALID_HANDLE_VALUE) {
+        errno = ENOENT;
+        return -1;
+    }
+    do {
+        const char* name = entry.cFileName;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0 ||
+            (entry.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
+            continue;
+        }
+        uint64_t ticks = ((uint64_t)entry.ftLastWriteTime.dwHighDateTime << 32) | entry.ftLastWriteTime.dwLowDateTime;
+        int64_t mtime = (int64_t)(ticks / 10000000u) - 11644473600LL;  /* 100 ns ticks since 1601 */
+        int64_t size = ((int64_t)entry.nFileSizeHigh << 32) | entry.nFileSizeLow;
+        if (add_sorted_entry(&entries, &count, &capacity, strdup(name),
+                             (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0, size, mtime) != 0) {
+            failed = 1;
+            break;
+        }
+    } while (FindNextFileA(find, &entry));
+    FindClose(find);
+#else
+    DIR* dir = opendir(full_dir);
+    if (dir == NULL) return -1;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        const char* name = entry->d_name;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
+            continue;
+        }
+        char* full_path = path_join(full_dir, name, PATH_SEPARATOR);
+        if (full_path == NULL) {
+            errno = ENOMEM;
+            failed = 1;
+            break;
+        }
+        struct stat st;
+        int stat_result = lstat(full_path, &st);
+        free(full_path);
+        if (stat_result != 0) {
+            if (errno == ENOENT) continue;  /* Removed since readdir */
+            failed = 1;
+            break;
+        }
+        if (!S_ISDIR(st.st_mode) && !S_ISREG(st.st_mode)) {
+            continue;
+        }
+        if (add_sorted_entry(&entries, &count, &capacity, strdup(name), S_ISDIR(st.st_mode),
+                             (int64_t)st.st_size, (int64_t)st.st_mtime) != 0) {
+            failed = 1;
+            break;
+        }
+    }
+    int saved_errno = errno;
+    closedir(dir);
+    errno = saved_errno;
+#endif
+    if (failed) {
+        free_sorted_entries(entries, count);
+        return -1;
+    }
+    qsort(entries, count, sizeof(SortedEntry), compare_sorted_entries);
+    *out = entries;
+    *out_count = count;
+    return 0;
+}
+
+static int walk_directory_sorted(const char* full_dir, const char* relative_dir,
+                                 FileWalkSortedCallback callback, void* ctx) {
+    SortedEntry* entries = NULL;
+    size_t count = 0;
+    if (read_sorted_entries(full_dir, &entries, &count) != 0) {
+        return -1;
+    }
+    int result = 0;
+    for (size_t i = 0; i < count && result == 0; i++) {
+        char* full_path = path_join(full_dir, entries[i].name, PATH_SEPARATOR);
+        char* relative_path = path_join(relative_dir, entries[i].name, '/');
+        if (full_path == NULL || relative_path == NULL) {
+            errno = ENOMEM;
+            result = -1;
+        } else if (entries[i].is_dir) {
+            result = walk_directory_sorted(full_path, relative_path, callback, ctx);
+        } else {
+            result = callback(relative_path, full_path, entries[i].size, entries[i].mtime, ctx);
+        }
+        free(full_path);
+        free(relative_path);
+    }
+    free_sorted_entries(entries, count);
+    return result;
+}
+
+int file_walk_tree_sorted(const char* root, FileWalkSortedCallback callback, void* ctx) {
+    return walk_directory_sorted(root, "", callback, ctx);
+}
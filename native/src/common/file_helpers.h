@@ -0,0 +1,159 @@
+/**
+ * @file file_helpers.h
+ * @brief Positional file I/O utilities for uplink-nodejs native module
+ * 
+ * Thin portable wrappers over pread/pwrite so that several worker
+ * threads can read or write the same file at independent offsets
+ * without sharing a file position. Safe to call from worker threads.
+ */
+
+#ifndef UPLINK_FILE_HELPERS_H
+#define UPLINK_FILE_HELPERS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Open a file for reading
+ * 
+ * @param path File path
+ * @return File descriptor, or -1 on failure (errno set)
+ */
+int file_open_read(const char* path);
+
+/**
+ * Open (create if missing) a file for writing
+ * 
+ * @param path File path
+ * @param truncate Non-zero to truncate an existing file
+ * @return File descriptor, or -1 on failure (errno set)
+ */
+int file_open_write(const char* path, int truncate);
+
+/**
+ * Get the size of an open file
+ * 
+ * @param fd File descriptor
+ * @return Size in bytes, or -1 on failure (errno set)
+ */
+int64_t file_size(int fd);
+
+/**
+ * Read up to @p length bytes at @p offset, retrying short reads
+ * 
+ * @param fd File descriptor
+ * @param buffer Destination buffer
+ * @param length Bytes to read
+ * @param offset Absolute file offset
+ * @return Bytes read (less than length only at EOF), or -1 on failure
+ */
+int64_t file_read_at(int fd, void* buffer, size_t length, int64_t offset);
+
+/**
+ * Write exactly @p length bytes at @p offset, retrying short writes
+ * 
+ * @param fd File descriptor
+ * @param buffer Source buffer
+ * @param length Bytes to write
+ * @param offset Absolute file offset
+ * @return Bytes written, or -1 on failure
+ */
+int64_t file_write_at(int fd, const void* buffer, size_t length, int64_t offset);
+
+/**
+ * Flush file data to stable storage (fsync / FlushFileBuffers)
+ * 
+ * @param fd File descriptor
+ * @return 0 on success, -1 on failure (errno set)
+ */
+int file_sync(int fd);
+
+/**
+ * Close a file descriptor (no-op for negative values)
+ */
+void file_close(int fd);
+
+/**
+ * A read-only memory mapping of a file range
+ * 
+ * @field data        First byte of the requested range
+ * @field length      Length of the requested range
+ * @field map_base    Start of the actual (alignment-rounded) mapping
+ * @field map_length  Length of the actual mapping
+ */
+typedef struct {
+    const uint8_t* data;
+    size_t length;
+    void* map_base;
+    size_t map_length;
+} FileMapping;
+
+/**
+ * Map a file range read-only with a sequential-access hint
+ * 
+ * Uses mmap + madvise(MADV_SEQUENTIAL) on POSIX and
+ * CreateFileMapping + MapViewOfFile on Windows. The offset need not be
+ * aligned; the mapping is widened to the platform granularity internally.
+ * 
+ * @param fd File descriptor opened for reading
+ * @param offset Absolute file offset of the range
+ * @param length Length of the range (must be > 0)
+ * @param out Receives the mapping
+ * @return 0 on success, -1 if mapping is unsupported or failed
+ *         (callers should fall back to file_read_at)
+ */
+int file_map_range(int fd, int64_t offset, size_t length, FileMapping* out);
+
+/**
+ * Release a mapping created by file_map_range (no-op if not mapped)
+ */
+void file_unmap(FileMapping* mapping);
+
+/**
+ * Called by file_walk_tree for each regular file
+ * 
+ * @param relative_path Path below the walk root, '/'-separated
+ * @param full_path Path usable with file_open_read
+ * @param size File size in bytes
+ * @param ctx Caller context
+ * @return 0 to continue, non-zero to stop the walk
+ */
+typedef int (*FileWalkCallback)(const char* relative_path, const char* full_path, int64_t size, void* ctx);
+
+/**
+ * Recursively visit the regular files below a directory
+ * 
+ * Symbolic links are not followed. Subdirectories that cannot be opened
+ * are skipped.
+ * 
+ * @param root Directory to walk
+ * @param callback Called for each regular file
+ * @param ctx Passed to @p callback
+ * @return 0 when the walk completes, the callback's value if it stopped
+ *         the walk, or -1 if @p root cannot be opened (errno set)
+ */
+int file_walk_tree(const char* root, FileWalkCallback callback, void* ctx);
+
+/**
+ * Called by file_walk_tree_sorted for each regular file
+ * 
+ * @param mtime Last modification time, seconds since the Unix epoch
+ */
+typedef int (*FileWalkSortedCallback)(const char* relative_path, const char* full_path, int64_t size,
+                                      int64_t mtime, void* ctx);
+
+/**
+ * Visit the regular files below a directory in byte order of their
+ * relative paths, the order object keys are listed in
+ * 
+ * Only the entries of the directories on the current path are held in
+ * memory. Unlike file_walk_tree, a subdirectory that cannot be read (or
+ * running out of memory) fails the walk, since callers comparing trees
+ * would otherwise take its files as missing.
+ * 
+ * @return 0 when the walk completes, the callback's value if it stopped
+ *         the walk, or -1 if a directory cannot be read (errno set)
+ */
+int file_walk_tree_sorted(const char* root, FileWalkSortedCallback callback, void* ctx);
+
+#endif /* UPLINK_FILE_HELPERS_H */
@@ -5,9 +5,16 @@
  * Provides type-safe handle creation and extraction for native handles.
  * Includes destructors that properly free uplink-c resources when
  * JavaScript externals are garbage collected.
+ *
+ * Each environment keeps one slab per handle type (see HandleSlab). Free
+ * slots form an intrusive list, so creating and collecting a handle is
+ * O(1) with an allocation only when a slab grows by a chunk.
  */
 
 #include "handle_helpers.h"
+#include "handle_reaper.h"
+#include "addon_instance.h"
+#include "admission.h"
 #include "logger.h"
 
 /* Disable compat macros to avoid function name conflicts */
@@ -15,6 +22,7 @@
 #include "uplink.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 static const char* handle_type_names[] = {
     "Access",
@@ -26,7 +34,24 @@ static const char* handle_type_names[] = {
     "ObjectIterator",
     "BucketIterator",
     "UploadIterator",
-    "PartIterator"
+    "PartIterator",
+    "CancelToken",
+    "Archive"
+};
+
+static const char* const handle_type_keys[HANDLE_TYPE_COUNT] = {
+    "access",
+    "project",
+    "download",
+    "upload",
+    "encryptionKey",
+    "partUpload",
+    "objectIterator",
+    "bucketIterator",
+    "uploadIterator",
+    "partIterator",
+    "cancelToken",
+    "archive"
 };
 
 const char* get_handle_type_name(HandleType type) {
@@ -36,6 +61,13 @@ const char* get_handle_type_name(HandleType type) {
     return "Unknown";
 }
 
+const char* get_handle_type_key(HandleType type) {
+    if (type >= 0 && type < HANDLE_TYPE_COUNT) {
+        return handle_type_keys[type];
+    }
+    return "unknown";
+}
+
 /**
  * Free uplink-c resources associated with the handle's native pointer.
  * 
@@ -44,9 +76,11 @@ const char* get_handle_type_name(HandleType type) {
  * For types with explicit close operations (project, download, upload),
  * the free function also closes if not already closed.
  */
-static void free_native_resource(HandleType type, void* native_ptr) {
+void handle_free_native_resource(HandleType type, void* native_ptr) {
     switch (type) {
         case HANDLE_TYPE_ACCESS: {
+            /* Accesses shared through the parseAccess cache have no
+             * native_ptr here; their cache entry frees them (access_cache.c) */
             UplinkAccessResult result = {
                 .access = (UplinkAccess*)native_ptr, .error = NULL
             };
@@ -96,53 +130,191 @@ static void free_native_resource(HandleType type, void* native_ptr) {
     }
 }
 
+/* ========== Slabs ========== */
+
+/*
+ * Token layout: generation in the high bits, then the slot index, then
+ * the type in the low 4 bits. Generations are never 0, so neither is a
+ * token.
+ */
+#if UINTPTR_MAX > 0xFFFFFFFFu
+#define TOKEN_GENERATION_SHIFT 32
+#else
+#define TOKEN_GENERATION_SHIFT 24
+#endif
+#define TOKEN_TYPE_BITS 4
+#define TOKEN_INDEX_LIMIT ((uintptr_t)1 << (TOKEN_GENERATION_SHIFT - TOKEN_TYPE_BITS))
+#define TOKEN_GENERATION_MASK ((uint32_t)(UINTPTR_MAX >> TOKEN_GENERATION_SHIFT))
+
+_Static_assert(HANDLE_TYPE_COUNT <= (1 << TOKEN_TYPE_BITS), "handle types must fit the token");
+
+static void* token_encode(HandleType type, uint32_t index, uint32_t generation) {
+    return (void*)(((uintptr_t)generation << TOKEN_GENERATION_SHIFT) |
+                   ((uintptr_t)index << TOKEN_TYPE_BITS) | (uintptr_t)type);
+}
+
+static HandleSlab* slabs_of(napi_env env) {
+    AddonInstance* instance = addon_instance(env);
+    return instance != NULL ? instance->handle_slabs : NULL;
+}
+
+static HandleSlot* slab_slot(HandleSlab* slab, uint32_t index) {
+    return &slab->chunks[index / HANDLE_SLAB_CHUNK][index % HANDLE_SLAB_CHUNK];
+}
+
+/** Add a chunk of free slots; the only allocation on the create path */
+static int slab_grow(HandleSlab* slab) {
+    uint32_t base = slab->chunk_count * HANDLE_SLAB_CHUNK;
+    if ((uintptr_t)base + HANDLE_SLAB_CHUNK > TOKEN_INDEX_LIMIT) {
+        return -1;
+    }
+    HandleSlot** chunks = (HandleSlot**)realloc(slab->chunks, (slab->chunk_count + 1) * sizeof(HandleSlot*));
+    if (chunks == NULL) {
+        return -1;
+    }
+    slab->chunks = chunks;
+    HandleSlot* chunk = (HandleSlot*)calloc(HANDLE_SLAB_CHUNK, sizeof(HandleSlot));
+    if (chunk == NULL) {
+        return -1;
+    }
+    slab->chunks[slab->chunk_count++] = chunk;
+    
+    /* Thread the new slots onto the free list in index order */
+    for (uint32_t i = HANDLE_SLAB_CHUNK; i-- > 0;) {
+        chunk[i].generation = 1;
+        chunk[i].next_free = slab->free_head;
+        slab->free_head = base + i + 1;
+    }
+    return 0;
+}
+
+/** Look up the live slot named by @p token, or NULL */
+static HandleSlot* slot_from_token(HandleSlab* slabs, void* token, HandleType* out_type, uint32_t* out_index) {
+    uintptr_t bits = (uintptr_t)token;
+    HandleType type = (HandleType)(bits & ((1u << TOKEN_TYPE_BITS) - 1));
+    uint32_t index = (uint32_t)((bits >> TOKEN_TYPE_BITS) & (TOKEN_INDEX_LIMIT - 1));
+    uint32_t generation = (uint32_t)(bits >> TOKEN_GENERATION_SHIFT);
+    if (slabs == NULL || type >= HANDLE_TYPE_COUNT) {
+        return NULL;
+    }
+    HandleSlab* slab = &slabs[type];
+    if (index >= slab->chunk_count * HANDLE_SLAB_CHUNK) {
+        return NULL;
+    }
+    HandleSlot* slot = slab_slot(slab, index);
+    if (!slot->live || slot->generation != generation) {
+        return NULL;
+    }
+    *out_type = type;
+    *out_index = index;
+    return slot;
+}
+
 /**
- * Default destructor: frees wrapper and, if a native pointer is stored,
- * releases the corresponding uplink-c resource via the appropriate
- * uplink_free_*_result function.
+ * Release a wrapper's resources; its slot is returned separately
+ *
+ * @param defer Hand the uplink-c resource to the reaper thread instead of
+ *              freeing it here (finalizers)
  */
-static void handle_destructor(napi_env env, void* data, void* hint) {
-    (void)env;
-    (void)hint;
+static void wrapper_release(HandleWrapper* wrapper, bool defer) {
+    LOG_TRACE("Destroying %s handle wrapper: %zu",
+              get_handle_type_name(wrapper->type), wrapper->handle);
     
-    HandleWrapper* wrapper = (HandleWrapper*)data;
-    if (wrapper != NULL) {
-        LOG_TRACE("Destroying %s handle wrapper: %zu", 
-                  get_handle_type_name(wrapper->type), wrapper->handle);
-        
-        if (wrapper->native_ptr != NULL) {
-            free_native_resource(wrapper->type, wrapper->native_ptr);
-            LOG_DEBUG("Freed uplink-c %s resources for handle: %zu",
-                      get_handle_type_name(wrapper->type), wrapper->handle);
+    if (wrapper->attachment_free != NULL && wrapper->attachment != NULL) {
+        wrapper->attachment_free(wrapper->attachment);
+    }
+    
+    /* Collected without commit, abort or close */
+    admission_release(wrapper->admission);
+    
+    if (wrapper->native_ptr != NULL) {
+        if (defer && handle_reaper_defer(wrapper->type, wrapper->native_ptr)) {
+            return;
         }
-        
-        free(wrapper);
+        handle_free_native_resource(wrapper->type, wrapper->native_ptr);
+        LOG_DEBUG("Freed uplink-c %s resources for handle: %zu",
+                  get_handle_type_name(wrapper->type), wrapper->handle);
     }
 }
 
+static void slot_free(HandleSlab* slab, HandleSlot* slot, uint32_t index) {
+    slot->live = false;
+    slot->generation = (slot->generation + 1) & TOKEN_GENERATION_MASK;
+    if (slot->generation == 0) {
+        slot->generation = 1;
+    }
+    slot->next_free = slab->free_head;
+    slab->free_head = index + 1;
+    slab->live--;
+}
+
+/**
+ * External finalizer: runs the custom destructor passed as @p hint, or
+ * releases the wrapper's resources, then returns the slot. The uplink-c
+ * resource goes to the reaper thread (see handle_reaper.h).
+ */
+static void handle_finalize(napi_env env, void* data, void* hint) {
+    HandleSlab* slabs = slabs_of(env);
+    HandleType type;
+    uint32_t index;
+    HandleSlot* slot = slot_from_token(slabs, data, &type, &index);
+    if (slot == NULL) {
+        /* Already released with the environment's slabs */
+        return;
+    }
+    
+    if (!slot->wrapper.closed) {
+        slabs[type].finalizer_frees++;
+    }
+    if (hint != NULL) {
+        ((napi_finalize)hint)(env, &slot->wrapper, NULL);
+    } else {
+        wrapper_release(&slot->wrapper, true);
+    }
+    slot_free(&slabs[type], slot, index);
+}
+
 napi_value create_handle_external(napi_env env, size_t handle, 
                                   HandleType type, void* native_ptr,
                                   napi_finalize destructor) {
-    /* Allocate wrapper */
-    HandleWrapper* wrapper = (HandleWrapper*)malloc(sizeof(HandleWrapper));
-    if (wrapper == NULL) {
-        LOG_ERROR("Failed to allocate handle wrapper for %s", get_handle_type_name(type));
+    HandleSlab* slabs = slabs_of(env);
+    if (slabs == NULL || type < 0 || type >= HANDLE_TYPE_COUNT) {
+        LOG_ERROR("Cannot create %s handle: no slab", get_handle_type_name(type));
+        napi_throw_error(env, NULL, "Native module instance not initialised");
+        return NULL;
+    }
+    
+    /* Pop a free slot */
+    HandleSlab* slab = &slabs[type];
+    if (slab->free_head == 0 && slab_grow(slab) != 0) {
+        LOG_ERROR("Failed to allocate handle slot for %s", get_handle_type_name(type));
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
     }
+    uint32_t index = slab->free_head - 1;
+    HandleSlot* slot = slab_slot(slab, index);
+    slab->free_head = slot->next_free;
+    slot->next_free = 0;
+    slot->live = true;
+    slab->live++;
     
+    HandleWrapper* wrapper = &slot->wrapper;
     wrapper->type = type;
     wrapper->handle = handle;
     wrapper->native_ptr = native_ptr;
+    wrapper->attachment = NULL;
+    wrapper->attachment_free = NULL;
+    wrapper->admission = NULL;
+    wrapper->project_handle = 0;
+    wrapper->closed = false;
     
     /* Create external */
     napi_value external;
-    napi_finalize final_destructor = destructor ? destructor : handle_destructor;
-    
-    napi_status status = napi_create_external(env, wrapper, final_destructor, NULL, &external);
+    napi_status status = napi_create_external(env, token_encode(type, index, slot->generation),
+                                              handle_finalize, (void*)destructor, &external);
     if (status != napi_ok) {
         LOG_ERROR("Failed to create external for %s handle", get_handle_type_name(type));
-        free(wrapper);
+        slot_free(slab, slot, index);
         return NULL;
     }
     
@@ -150,28 +322,104 @@ napi_value create_handle_external(napi_env env, size_t handle,
     return external;
 }
 
-napi_status extract_handle(napi_env env, napi_value js_value,
-                          HandleType type, size_t* out_handle) {
+HandleWrapper* get_handle_wrapper(napi_env env, napi_value js_value, HandleType type) {
     void* data = NULL;
     
     napi_status status = napi_get_value_external(env, js_value, &data);
     if (status != napi_ok || data == NULL) {
         LOG_ERROR("Failed to extract %s handle - invalid external", get_handle_type_name(type));
-        return napi_invalid_arg;
+        return NULL;
     }
-
-    const HandleWrapper* wrapper = (const HandleWrapper*)data;
-
+    
+    HandleType actual;
+    uint32_t index;
+    HandleSlot* slot = slot_from_token(slabs_of(env), data, &actual, &index);
+    if (slot == NULL) {
+        LOG_ERROR("Stale or foreign %s handle", get_handle_type_name(type));
+        return NULL;
+    }
+    HandleWrapper* wrapper = &slot->wrapper;
+    
     /* Type check */
-    if (wrapper->type != type) {
+    if (actual != type) {
         LOG_ERROR("Handle type mismatch: expected %s, got %s",
-                  get_handle_type_name(type), get_handle_type_name(wrapper->type));
-        return napi_invalid_arg;
+                  get_handle_type_name(type), get_handle_type_name(actual));
+        return NULL;
     }
     
     /* Validate handle */
     if (wrapper->handle == 0) {
         LOG_ERROR("Invalid %s handle (zero)", get_handle_type_name(type));
+        return NULL;
+    }
+    
+    return wrapper;
+}
+
+uint32_t handle_live_count(napi_env env, HandleType type) {
+    HandleSlab* slabs = slabs_of(env);
+    if (slabs == NULL || type < 0 || type >= HANDLE_TYPE_COUNT) {
+        return 0;
+    }
+    return slabs[type].live;
+}
+
+const HandleSlab* handle_slab(napi_env env, HandleType type) {
+    HandleSlab* slabs = slabs_of(env);
+    if (slabs == NULL || type < 0 || type >= HANDLE_TYPE_COUNT) {
+        return NULL;
+    }
+    return &slabs[type];
+}
+
+void mark_handle_closed(napi_env env, napi_value js_value, HandleType type) {
+    HandleWrapper* wrapper = get_handle_wrapper(env, js_value, type);
+    if (wrapper == NULL || wrapper->closed) {
+        return;
+    }
+    wrapper->closed = true;
+    slabs_of(env)[type].explicit_closes++;
+}
+
+void handle_slabs_destroy(napi_env env, HandleSlab* slabs) {
+    (void)env;
+    for (int type = 0; type < HANDLE_TYPE_COUNT; type++) {
+        HandleSlab* slab = &slabs[type];
+        if (slab->live > 0) {
+            LOG_DEBUG("Releasing %u %s handles left at teardown", slab->live, get_handle_type_name((HandleType)type));
+        }
+        for (uint32_t c = 0; c < slab->chunk_count; c++) {
+            for (uint32_t i = 0; i < HANDLE_SLAB_CHUNK; i++) {
+                if (slab->chunks[c][i].live) {
+                    wrapper_release(&slab->chunks[c][i].wrapper, false);
+                }
+            }
+            free(slab->chunks[c]);
+        }
+        free(slab->chunks);
+        memset(slab, 0, sizeof(*slab));
+    }
+}
+
+struct AdmissionSlot* take_handle_admission(napi_env env, napi_value js_value, HandleType type) {
+    HandleWrapper* wrapper = get_handle_wrapper(env, js_value, type);
+    if (wrapper == NULL) {
+        return NULL;
+    }
+    struct AdmissionSlot* slot = wrapper->admission;
+    wrapper->admission = NULL;
+    return slot;
+}
+
+size_t get_handle_project(napi_env env, napi_value js_value, HandleType type) {
+    const HandleWrapper* wrapper = get_handle_wrapper(env, js_value, type);
+    return wrapper != NULL ? wrapper->project_handle : 0;
+}
+
+napi_status extract_handle(napi_env env, napi_value js_value,
+                          HandleType type, size_t* out_handle) {
+    const HandleWrapper* wrapper = get_handle_wrapper(env, js_value, type);
+    if (wrapper == NULL) {
         return napi_invalid_arg;
     }
     
@@ -3,13 +3,21 @@
  * @brief Handle management utilities for uplink-nodejs
  * 
  * Provides type-safe handle creation and extraction for native handles.
+ *
+ * Wrappers live in per-type slabs owned by the environment's
+ * AddonInstance. A JS external carries a token (slot index, generation
+ * and type) rather than a pointer, so a stale or foreign external is
+ * rejected by comparing generations without touching freed memory, and
+ * allocation is a free-list pop. Main thread only.
  */
 
 #ifndef UPLINK_HANDLE_HELPERS_H
 #define UPLINK_HANDLE_HELPERS_H
 
 #include <node_api.h>
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * Handle types for type-safe handle management
@@ -24,7 +32,10 @@ typedef enum {
     HANDLE_TYPE_OBJECT_ITERATOR,
     HANDLE_TYPE_BUCKET_ITERATOR,
     HANDLE_TYPE_UPLOAD_ITERATOR,
-    HANDLE_TYPE_PART_ITERATOR
+    HANDLE_TYPE_PART_ITERATOR,
+    HANDLE_TYPE_CANCEL_TOKEN,
+    HANDLE_TYPE_ARCHIVE,
+    HANDLE_TYPE_COUNT
 } HandleType;
 
 /**
@@ -36,13 +47,48 @@ typedef enum {
  *                    Stored so the destructor can call uplink_free_*_result to properly
  *                    release both the C struct and the Go-side universe handle.
  *                    NULL for iterator handles (which store the pointer as the handle itself).
+ * @field attachment  Optional per-handle native state owned by the wrapper
+ *                    (e.g., an upload's write-coalescing buffer). Main thread only.
+ * @field attachment_free  Releases @c attachment when the wrapper is destroyed, or NULL.
+ * @field admission  Transfer slot held by a streaming upload or download until it is
+ *                   committed, aborted or closed (see admission.h), or NULL.
+ * @field project_handle  Project a streaming upload, download or part upload was
+ *                   opened on, for its bandwidth limits (see bandwidth.h), or 0.
+ * @field closed     The close, commit, abort or free call for this handle was made.
  */
 typedef struct {
     HandleType type;
     size_t handle;
     void* native_ptr;
+    void* attachment;
+    void (*attachment_free)(void* attachment);
+    struct AdmissionSlot* admission;
+    size_t project_handle;
+    bool closed;
 } HandleWrapper;
 
+/** Slots added to a slab at a time; chunks never move, so wrappers stay put */
+#define HANDLE_SLAB_CHUNK 256
+
+typedef struct {
+    HandleWrapper wrapper;
+    uint32_t generation;            /* bumped on release, never 0 */
+    uint32_t next_free;             /* index + 1 of the next free slot, 0 = end */
+    bool live;
+} HandleSlot;
+
+/**
+ * Wrapper slots of one handle type in one environment.
+ */
+typedef struct {
+    HandleSlot** chunks;
+    uint32_t chunk_count;
+    uint32_t free_head;             /* index + 1 of the first free slot, 0 = none */
+    uint32_t live;                  /* slots in use */
+    uint64_t explicit_closes;       /* handles closed, committed, aborted or freed by call */
+    uint64_t finalizer_frees;       /* handles collected without such a call */
+} HandleSlab;
+
 /**
  * Create a JS external from a handle
  * @param env N-API environment
@@ -67,6 +113,68 @@ napi_value create_handle_external(napi_env env, size_t handle,
 napi_status extract_handle(napi_env env, napi_value js_value,
                           HandleType type, size_t* out_handle);
 
+/**
+ * Get the wrapper behind a JS external, with the same validation as extract_handle
+ * @param env N-API environment
+ * @param js_value The JS external value
+ * @param type Expected handle type (for validation)
+ * @return The wrapper, or NULL if the value is not a valid handle of @p type
+ */
+HandleWrapper* get_handle_wrapper(napi_env env, napi_value js_value, HandleType type);
+
+/**
+ * Detach the admission slot held by a handle, for the call that ends its stream
+ * @param env N-API environment
+ * @param js_value The JS external value
+ * @param type Expected handle type (for validation)
+ * @return The slot, now owned by the caller, or NULL if the handle holds none
+ */
+struct AdmissionSlot* take_handle_admission(napi_env env, napi_value js_value, HandleType type);
+
+/**
+ * Get the project a streaming handle was opened on
+ * @param env N-API environment
+ * @param js_value The JS external value
+ * @param type Expected handle type (for validation)
+ * @return The project handle, or 0 if unknown
+ */
+size_t get_handle_project(napi_env env, napi_value js_value, HandleType type);
+
+/**
+ * Record that the call ending a handle's life was made, so its eventual
+ * collection is not counted as a finalizer-driven free
+ * @param env N-API environment
+ * @param js_value The JS external value
+ * @param type Expected handle type (for validation)
+ */
+void mark_handle_closed(napi_env env, napi_value js_value, HandleType type);
+
+/**
+ * Number of live handles of @p type in @p env
+ */
+uint32_t handle_live_count(napi_env env, HandleType type);
+
+/**
+ * Slab of @p type in @p env, for its counters, or NULL
+ */
+const HandleSlab* handle_slab(napi_env env, HandleType type);
+
+/**
+ * Release every live handle and the slabs of one environment; called
+ * from the instance finalizer
+ * @param env N-API environment
+ * @param slabs The environment's HANDLE_TYPE_COUNT slabs
+ */
+void handle_slabs_destroy(napi_env env, HandleSlab* slabs);
+
+/**
+ * Free the uplink-c resource behind a handle of @p type with its
+ * uplink_free_*_result function (any thread)
+ * @param type The handle type
+ * @param native_ptr The wrapper's native_ptr
+ */
+void handle_free_native_resource(HandleType type, void* native_ptr);
+
 /**
  * Validate that a handle is non-zero
  * @param handle The handle to validate
@@ -81,4 +189,11 @@ int validate_handle(size_t handle);
  */
 const char* get_handle_type_name(HandleType type);
 
+/**
+ * Get the camelCase key used for handle type @p type in JS stats objects
+ * @param type The handle type
+ * @return Key such as "objectIterator"
+ */
+const char* get_handle_type_key(HandleType type);
+
 #endif /* UPLINK_HANDLE_HELPERS_H */
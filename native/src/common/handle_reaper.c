@@ -0,0 +1,119 @@
+/**
+ * @file handle_reaper.c
+ * @brief Background release of collected handles' uplink-c resources
+ *
+ * Finalizers append to a pending array under a lock and only the append
+ * that finds it empty wakes the reaper, so a GC cycle costs one wake-up.
+ * The reaper swaps the pending array with its own spare and frees the
+ * batch outside the lock; both arrays keep their capacity, so a steady
+ * state allocates nothing. The thread is started on first use and lives
+ * for the rest of the process.
+ */
+
+#include "handle_reaper.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdlib.h>
+
+/** Entries the pending array starts with */
+#define REAPER_INITIAL_CAPACITY 64
+
+typedef struct {
+    HandleType type;
+    void* native_ptr;
+} ReapEntry;
+
+typedef struct {
+    ReapEntry* entries;
+    size_t count;
+    size_t capacity;
+} ReapBatch;
+
+static uv_once_t reaper_once = UV_ONCE_INIT;
+static uv_mutex_t reaper_lock;
+static uv_cond_t reaper_wake;
+static uv_thread_t reaper_thread;
+static bool reaper_started;
+static bool reaper_failed;
+static ReapBatch pending;           /* Filled by finalizers; under reaper_lock */
+static uint64_t in_flight;          /* Taken by the reaper, not yet freed; under reaper_lock */
+
+static void reaper_main(void* arg) {
+    (void)arg;
+    ReapBatch batch = { NULL, 0, 0 };
+    uv_mutex_lock(&reaper_lock);
+    for (;;) {
+        while (pending.count == 0) {
+            uv_cond_wait(&reaper_wake, &reaper_lock);
+        }
+        ReapBatch taken = pending;
+        pending = batch;
+        batch = taken;
+        in_flight = batch.count;
+        uv_mutex_unlock(&reaper_lock);
+
+        for (size_t i = 0; i < batch.count; i++) {
+            handle_free_native_resource(batch.entries[i].type, batch.entries[i].native_ptr);
+        }
+        LOG_DEBUG("handle reaper: freed %zu collected handles", batch.count);
+        batch.count = 0;
+
+        uv_mutex_lock(&reaper_lock);
+        in_flight = 0;
+    }
+}
+
+static void reaper_init(void) {
+    uv_mutex_init(&reaper_lock);
+    uv_cond_init(&reaper_wake);
+}
+
+/** Start the reaper thread if needed; call with reaper_lock held */
+static bool start_reaper(void) {
+    if (!reaper_started && !reaper_failed) {
+        if (uv_thread_create(&reaper_thread, reaper_main, NULL) != 0) {
+            LOG_WARN("handle reaper: could not start the thread; collected handles are freed inline");
+            reaper_failed = true;
+        } else {
+            reaper_started = true;
+        }
+    }
+    return reaper_started;
+}
+
+/* ========== public API ========== */
+
+bool handle_reaper_defer(HandleType type, void* native_ptr) {
+    uv_once(&reaper_once, reaper_init);
+    uv_mutex_lock(&reaper_lock);
+    if (!start_reaper()) {
+        uv_mutex_unlock(&reaper_lock);
+        return false;
+    }
+    if (pending.count == pending.capacity) {
+        size_t capacity = pending.capacity != 0 ? pending.capacity * 2 : REAPER_INITIAL_CAPACITY;
+        ReapEntry* entries = (ReapEntry*)realloc(pending.entries, capacity * sizeof(ReapEntry));
+        if (entries == NULL) {
+            uv_mutex_unlock(&reaper_lock);
+            return false;
+        }
+        pending.entries = entries;
+        pending.capacity = capacity;
+    }
+    pending.entries[pending.count].type = type;
+    pending.entries[pending.count].native_ptr = native_ptr;
+    if (pending.count++ == 0) {
+        uv_cond_signal(&reaper_wake);
+    }
+    uv_mutex_unlock(&reaper_lock);
+    return true;
+}
+
+uint64_t handle_reaper_pending(void) {
+    uv_once(&reaper_once, reaper_init);
+    uv_mutex_lock(&reaper_lock);
+    uint64_t count = pending.count + in_flight;
+    uv_mutex_unlock(&reaper_lock);
+    return count;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file handle_reaper.h
+ * @brief Background release of collected handles' uplink-c resources
+ *
+ * Freeing a project, download or upload calls into Go and may close
+ * network connections, which is too slow for a GC finalizer on the main
+ * thread: a cycle that collects many handles stalls the event loop. The
+ * finalizer instead queues the native pointer here, and one reaper thread
+ * frees everything queued since its last pass as a batch.
+ */
+
+#ifndef UPLINK_HANDLE_REAPER_H
+#define UPLINK_HANDLE_REAPER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "handle_helpers.h"
+
+/**
+ * Queue @p native_ptr of a collected handle for handle_free_native_resource()
+ * on the reaper thread (any thread)
+ *
+ * @return false when the reaper cannot take it (no thread, out of memory);
+ *         the caller then frees it inline
+ */
+bool handle_reaper_defer(HandleType type, void* native_ptr);
+
+/**
+ * Number of resources queued and not yet freed
+ */
+uint64_t handle_reaper_pending(void);
+
+#endif /* UPLINK_HANDLE_REAPER_H */
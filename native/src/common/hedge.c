@@ -0,0 +1,295 @@
+/**
+ * @file hedge.c
+ * @brief Hedged request implementation
+ *
+ * Both attempts of a race run on threads created for it and share a
+ * reference-counted race record; whichever of the caller and the two
+ * threads leaves last frees it. libuv threads cannot be detached, so a
+ * finished thread puts itself on a reap list and the next hedge_run()
+ * joins it, which returns at once because the thread is already exiting.
+ */
+
+#include "hedge.h"
+#include "op_metrics.h"
+#include "result_helpers.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdlib.h>
+
+#define HEDGE_RUNNING INT32_MIN
+
+typedef struct {
+    uv_mutex_t lock;
+    uv_cond_t finished;
+    HedgeRunFn run;
+    HedgeFreeFn free_fn;
+    void* attempts[2];              /* primary, backup */
+    int status[2];                  /* HEDGE_RUNNING or the result of run */
+    bool decided;                   /* The caller has taken its attempt */
+    int refs;                       /* Caller + threads still running */
+} HedgeRace;
+
+typedef struct HedgeThread {
+    uv_thread_t thread;
+    HedgeRace* race;
+    int index;
+    struct HedgeThread* next;       /* On the reap list */
+} HedgeThread;
+
+static uv_once_t hedge_once = UV_ONCE_INIT;
+static uv_mutex_t hedge_lock;       /* Reap list and counters */
+static HedgeThread* reap_list;
+static uint64_t hedged_count;
+static uint64_t backup_wins;
+
+static void hedge_init(void) {
+    uv_mutex_init(&hedge_lock);
+}
+
+/* ========== helpers ========== */
+
+static void race_release(HedgeRace* race) {
+    uv_mutex_lock(&race->lock);
+    bool last = --race->refs == 0;
+    uv_mutex_unlock(&race->lock);
+    if (last) {
+        uv_cond_destroy(&race->finished);
+        uv_mutex_destroy(&race->lock);
+        free(race);
+    }
+}
+
+/** Join threads that have finished their attempt */
+static void reap_threads(void) {
+    uv_mutex_lock(&hedge_lock);
+    HedgeThread* list = reap_list;
+    reap_list = NULL;
+    uv_mutex_unlock(&hedge_lock);
+    while (list != NULL) {
+        HedgeThread* next = list->next;
+        uv_thread_join(&list->thread);
+        free(list);
+        list = next;
+    }
+}
+
+static void hedge_thread_main(void* arg) {
+    HedgeThread* self = (HedgeThread*)arg;
+    HedgeRace* race = self->race;
+    int status = race->run(race->attempts[self->index]);
+
+    uv_mutex_lock(&race->lock);
+    race->status[self->index] = status;
+    bool abandoned = race->decided;  /* The caller took the other attempt */
+    uv_cond_signal(&race->finished);
+    uv_mutex_unlock(&race->lock);
+    if (abandoned) {
+        race->free_fn(race->attempts[self->index]);
+    }
+    race_release(race);
+
+    /* Holding the lock also waits out the creator's store of self->thread */
+    uv_mutex_lock(&hedge_lock);
+    self->next = reap_list;
+    reap_list = self;
+    uv_mutex_unlock(&hedge_lock);
+}
+
+/** Start attempt @p index on its own thread; takes a race reference */
+static bool start_attempt(HedgeRace* race, int index) {
+    HedgeThread* thread = (HedgeThread*)calloc(1, sizeof(HedgeThread));
+    if (thread == NULL) {
+        return false;
+    }
+    thread->race = race;
+    thread->index = index;
+    uv_mutex_lock(&race->lock);
+    race->status[index] = HEDGE_RUNNING;
+    race->refs++;
+    uv_mutex_unlock(&race->lock);
+
+    uv_mutex_lock(&hedge_lock);
+    int rc = uv_thread_create(&thread->thread, hedge_thread_main, thread);
+    uv_mutex_unlock(&hedge_lock);
+    if (rc != 0) {
+        LOG_WARN("hedge: cannot start attempt thread: %s", uv_strerror(rc));
+        uv_mutex_lock(&race->lock);
+        race->refs--;
+        uv_mutex_unlock(&race->lock);
+        free(thread);
+        return false;
+    }
+    return true;
+}
+
+/* ========== public API ========== */
+
+void* hedge_run(HedgeRunFn run, HedgeFreeFn free_fn, void* primary, void* backup,
+                uint64_t delay_ns, bool* hedged) {
+    uv_once(&hedge_once, hedge_init);
+    reap_threads();
+    if (hedged != NULL) {
+        *hedged = false;
+    }
+
+    HedgeRace* race = (HedgeRace*)calloc(1, sizeof(HedgeRace));
+    if (race == NULL || uv_mutex_init(&race->lock) != 0) {
+        free(race);
+        run(primary);
+        free_fn(backup);
+        return primary;
+    }
+    uv_cond_init(&race->finished);
+    race->run = run;
+    race->free_fn = free_fn;
+    race->attempts[0] = primary;
+    race->attempts[1] = backup;
+    race->refs = 1;
+
+    if (!start_attempt(race, 0)) {
+        race_release(race);
+        run(primary);
+        free_fn(backup);
+        return primary;
+    }
+
+    uv_mutex_lock(&race->lock);
+    uint64_t deadline = uv_hrtime() + delay_ns;
+    while (race->status[0] == HEDGE_RUNNING) {
+        uint64_t now = uv_hrtime();
+        if (now >= deadline || uv_cond_timedwait(&race->finished, &race->lock, deadline - now) == UV_ETIMEDOUT) {
+            break;
+        }
+    }
+    bool backup_started = false;
+    if (race->status[0] == HEDGE_RUNNING) {
+        uv_mutex_unlock(&race->lock);
+        backup_started = start_attempt(race, 1);
+        uv_mutex_lock(&race->lock);
+    }
+
+    int winner;
+    for (;;) {
+        if (race->status[0] == 0) {
+            winner = 0;
+            break;
+        }
+        if (backup_started && race->status[1] == 0) {
+            winner = 1;
+            break;
+        }
+        if (race->status[0] != HEDGE_RUNNING && (!backup_started || race->status[1] != HEDGE_RUNNING)) {
+            winner = 0;  /* Both failed */
+            break;
+        }
+        uv_cond_wait(&race->finished, &race->lock);
+    }
+    race->decided = true;
+    int loser = 1 - winner;
+    bool loser_done = loser == 1 ? !backup_started || race->status[1] != HEDGE_RUNNING
+                                 : race->status[0] != HEDGE_RUNNING;
+    uv_mutex_unlock(&race->lock);
+
+    if (loser_done) {
+        free_fn(race->attempts[loser]);
+    }
+    void* result = race->attempts[winner];
+    race_release(race);
+
+    if (backup_started) {
+        uv_mutex_lock(&hedge_lock);
+        hedged_count++;
+        backup_wins += winner == 1;
+        uv_mutex_unlock(&hedge_lock);
+        LOG_DEBUG("hedge: backup started after %llu ms, %s won",
+                  (unsigned long long)(delay_ns / 1000000), winner == 1 ? "backup" : "primary");
+    }
+    if (hedged != NULL) {
+        *hedged = backup_started;
+    }
+    return result;
+}
+
+/** Read a non-negative number property, keeping @p value when absent */
+static int get_number(napi_env env, napi_value object, const char* name, double* value) {
+    napi_value property;
+    napi_valuetype type;
+    if (napi_get_named_property(env, object, name, &property) != napi_ok ||
+        napi_typeof(env, property, &type) != napi_ok || type == napi_undefined) {
+        return 0;
+    }
+    double number;
+    if (type != napi_number || napi_get_value_double(env, property, &number) != napi_ok || !(number >= 0)) {
+        return -1;
+    }
+    *value = number;
+    return 0;
+}
+
+int hedge_delay_option(napi_env env, napi_value options, const char* metric, uint64_t* delay_ns) {
+    *delay_ns = 0;
+    if (options == NULL) {
+        return 0;
+    }
+    napi_value hedge;
+    napi_valuetype type;
+    if (napi_get_named_property(env, options, "hedge", &hedge) != napi_ok ||
+        napi_typeof(env, hedge, &type) != napi_ok || type == napi_undefined || type == napi_null) {
+        return 0;
+    }
+
+    double percentile = HEDGE_DEFAULT_PERCENTILE;
+    double min_delay_ms = HEDGE_DEFAULT_MIN_DELAY_MS;
+    double max_delay_ms = HEDGE_DEFAULT_MAX_DELAY_MS;
+    if (type == napi_boolean) {
+        bool enabled = false;
+        napi_get_value_bool(env, hedge, &enabled);
+        if (!enabled) {
+            return 0;
+        }
+    } else if (type == napi_object) {
+        if (get_number(env, hedge, "percentile", &percentile) != 0 || percentile <= 0 || percentile >= 100) {
+            throw_type_error(env, "hedge.percentile must be a number between 0 and 100");
+            return -1;
+        }
+        if (get_number(env, hedge, "minDelayMs", &min_delay_ms) != 0 ||
+            get_number(env, hedge, "maxDelayMs", &max_delay_ms) != 0 || min_delay_ms > max_delay_ms) {
+            throw_type_error(env, "hedge.minDelayMs and hedge.maxDelayMs must be non-negative with min <= max");
+            return -1;
+        }
+    } else {
+        throw_type_error(env, "hedge must be a boolean or an object");
+        return -1;
+    }
+
+    uint64_t samples = 0;
+    double delay_ms = (double)op_metrics_quantile(env, metric, percentile / 100.0, &samples) / 1e6;
+    if (samples < HEDGE_MIN_SAMPLES) {
+        delay_ms = max_delay_ms;
+    }
+    if (delay_ms < min_delay_ms) delay_ms = min_delay_ms;
+    if (delay_ms > max_delay_ms) delay_ms = max_delay_ms;
+    *delay_ns = (uint64_t)(delay_ms * 1e6);
+    if (*delay_ns == 0) {
+        *delay_ns = 1;  /* 0 means not hedging; a zero delay starts both at once */
+    }
+    return 0;
+}
+
+napi_value napi_hedge_stats(napi_env env, napi_callback_info info) {
+    (void)info;
+    uv_once(&hedge_once, hedge_init);
+    uv_mutex_lock(&hedge_lock);
+    double hedged = (double)hedged_count;
+    double wins = (double)backup_wins;
+    uv_mutex_unlock(&hedge_lock);
+    
+    napi_value result, value;
+    napi_create_object(env, &result);
+    napi_create_double(env, hedged, &value);
+    napi_set_named_property(env, result, "hedged", value);
+    napi_create_double(env, wins, &value);
+    napi_set_named_property(env, result, "backupWins", value);
+    return result;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file hedge.h
+ * @brief Hedged requests: race a duplicate attempt against a slow one
+ *
+ * An attempt runs on a native thread while the calling worker waits. If
+ * it has not finished after a delay taken from a latency percentile of
+ * recent calls (see op_metrics.h), an identical backup attempt starts on
+ * a second thread and the first to succeed wins. Uplink calls cannot be
+ * interrupted, so the loser is abandoned rather than stopped: it runs to
+ * completion on its own thread and then releases whatever it opened.
+ */
+
+#ifndef UPLINK_HEDGE_H
+#define UPLINK_HEDGE_H
+
+#include <node_api.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Default percentile of recent latency after which the backup starts */
+#define HEDGE_DEFAULT_PERCENTILE 95.0
+
+/** Default lower bound of the delay (ms) */
+#define HEDGE_DEFAULT_MIN_DELAY_MS 10
+
+/** Default upper bound of the delay (ms), also used until enough samples exist */
+#define HEDGE_DEFAULT_MAX_DELAY_MS 1000
+
+/** Samples needed before the percentile is trusted */
+#define HEDGE_MIN_SAMPLES 20
+
+/**
+ * Body of one attempt, run on a hedge thread
+ * @return 0 on success
+ */
+typedef int (*HedgeRunFn)(void* attempt);
+
+/**
+ * Release an attempt and everything it opened (any thread)
+ */
+typedef void (*HedgeFreeFn)(void* attempt);
+
+/**
+ * Run @p primary, starting @p backup if @p primary has not finished after
+ * @p delay_ns, and wait for the outcome (worker thread)
+ *
+ * A primary that fails before the delay is not hedged. When both fail,
+ * or a thread cannot be started, the primary's outcome is used.
+ *
+ * @param[out] hedged Whether the backup was started, may be NULL
+ * @return The attempt to use, owned by the caller; the other one is
+ *         released through @p free_fn, now or once it finishes
+ */
+void* hedge_run(HedgeRunFn run, HedgeFreeFn free_fn, void* primary, void* backup,
+                uint64_t delay_ns, bool* hedged);
+
+/**
+ * Read options.hedge and turn it into a delay (main thread)
+ *
+ * options.hedge is true or { percentile?, minDelayMs?, maxDelayMs? }; the
+ * delay is the percentile of the execute phase recorded under @p metric,
+ * clamped to the bounds, or maxDelayMs until HEDGE_MIN_SAMPLES exist.
+ *
+ * @param[out] delay_ns Receives the delay, 0 when not hedging
+ * @return 0 on success, -1 with an exception pending
+ */
+int hedge_delay_option(napi_env env, napi_value options, const char* metric, uint64_t* delay_ns);
+
+/**
+ * N-API callback: read the process-wide hedging counters
+ *
+ * Exported as native.hedgeStats() returning { hedged, backupWins }: races
+ * in which the backup was started, and those the backup won.
+ *
+ * @param env N-API environment
+ * @param info Callback info (no arguments)
+ * @return The counters
+ */
+napi_value napi_hedge_stats(napi_env env, napi_callback_info info);
+
+#endif /* UPLINK_HEDGE_H */
@@ -0,0 +1,297 @@
+/**
+ * @file key_cache.c
+ * @brief Opt-in per-environment deriveEncryptionKey cache implementation
+ *
+ * Laid out like access_cache.c: a chained hash table of entries threaded
+ * on an LRU list, most recent at the head, living in the environment's
+ * AddonInstance. The table is indexed by the first bytes of the tag,
+ * which is already uniformly distributed.
+ *
+ * The HMAC key is drawn once per process from the OS CSPRNG, so tags
+ * cannot be precomputed for guessed passphrases and differ between runs.
+ * Only tags are held here; the derived key material itself lives in
+ * uplink-c and is released with uplink_free_encryption_key_result.
+ */
+
+#include "key_cache.h"
+#include "addon_instance.h"
+#include "handle_helpers.h"
+#include "checksum.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HMAC_BLOCK_SIZE 64
+
+struct KeyCacheEntry {
+    uint8_t tag[KEY_CACHE_TAG_SIZE];
+    UplinkEncryptionKey* key;
+    uint32_t refs;                  /* callers and sharing handles, plus one while listed */
+    uint64_t expires_at;            /* uv_hrtime() value, 0 = never */
+    struct KeyCacheEntry* chain;    /* Next in hash bucket */
+    struct KeyCacheEntry* prev;     /* LRU neighbours */
+    struct KeyCacheEntry* next;
+};
+
+struct KeyCache {
+    KeyCacheEntry** buckets;
+    size_t bucket_count;            /* Power of two */
+    KeyCacheEntry* head;            /* Most recently used */
+    KeyCacheEntry* tail;
+    uint64_t ttl_ns;
+    KeyCacheStats stats;
+};
+
+static uv_once_t hmac_key_once = UV_ONCE_INIT;
+static uint8_t hmac_key[HMAC_BLOCK_SIZE];   /* 32 random bytes, zero padded */
+static int hmac_key_ready;
+
+/* ========== helpers ========== */
+
+void secure_zero(void* data, size_t length) {
+    volatile uint8_t* bytes = (volatile uint8_t*)data;
+    while (length-- > 0) {
+        *bytes++ = 0;
+    }
+}
+
+static void hmac_key_init(void) {
+    hmac_key_ready = uv_random(NULL, NULL, hmac_key, KEY_CACHE_TAG_SIZE, 0, NULL) == 0;
+    if (!hmac_key_ready) {
+        LOG_WARN("encryption key cache: no random source, caching disabled");
+    }
+}
+
+/** Finish @p state into @p digest as raw bytes */
+static void sha256_final(ChecksumState* state, uint8_t* digest) {
+    char hex[CHECKSUM_HEX_MAX];
+    checksum_hex(state, hex, sizeof(hex));
+    for (size_t i = 0; i < KEY_CACHE_TAG_SIZE; i++) {
+        char pair[3] = { hex[2 * i], hex[2 * i + 1], '\0' };
+        digest[i] = (uint8_t)strtoul(pair, NULL, 16);
+    }
+    secure_zero(hex, sizeof(hex));
+    secure_zero(state, sizeof(*state));
+}
+
+static bool tag_equal(const uint8_t* a, const uint8_t* b) {
+    uint8_t diff = 0;
+    for (size_t i = 0; i < KEY_CACHE_TAG_SIZE; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+static KeyCache* cache_of(napi_env env) {
+    AddonInstance* instance = addon_instance(env);
+    return instance != NULL ? instance->key_cache : NULL;
+}
+
+static KeyCacheEntry** find_slot(KeyCache* cache, const uint8_t* tag) {
+    uint64_t hash;
+    memcpy(&hash, tag, sizeof(hash));
+    KeyCacheEntry** slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+    while (*slot != NULL && !tag_equal((*slot)->tag, tag)) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+static void lru_unlink(KeyCache* cache, KeyCacheEntry* entry) {
+    if (entry->prev != NULL) entry->prev->next = entry->next; else cache->head = entry->next;
+    if (entry->next != NULL) entry->next->prev = entry->prev; else cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void lru_push_front(KeyCache* cache, KeyCacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head != NULL) cache->head->prev = entry; else cache->tail = entry;
+    cache->head = entry;
+}
+
+static void entry_unref(void* arg) {
+    KeyCacheEntry* entry = (KeyCacheEntry*)arg;
+    if (--entry->refs > 0) {
+        return;
+    }
+    UplinkEncryptionKeyResult result = { .encryption_key = entry->key, .error = NULL };
+    uplink_free_encryption_key_result(result);
+    secure_zero(entry, sizeof(*entry));
+    free(entry);
+}
+
+/** Unlist the entry in @p slot, dropping the cache's reference */
+static void remove_entry(KeyCache* cache, KeyCacheEntry** slot) {
+    KeyCacheEntry* entry = *slot;
+    *slot = entry->chain;
+    entry->chain = NULL;
+    lru_unlink(cache, entry);
+    cache->stats.entries--;
+    entry_unref(entry);
+}
+
+/* ========== public API ========== */
+
+int key_cache_tag(const char* passphrase, const void* salt, size_t salt_length, uint8_t* tag) {
+    uv_once(&hmac_key_once, hmac_key_init);
+    if (!hmac_key_ready) return -1;
+
+    uint8_t pad[HMAC_BLOCK_SIZE];
+    uint8_t inner[KEY_CACHE_TAG_SIZE];
+    ChecksumState state;
+
+    /* The passphrase length prefix keeps (p, s) and (p + s[0], s[1..]) apart */
+    uint64_t passphrase_length = (uint64_t)strlen(passphrase);
+    uint8_t prefix[8];
+    for (size_t i = 0; i < sizeof(prefix); i++) {
+        prefix[i] = (uint8_t)(passphrase_length >> (8 * i));
+    }
+
+    for (size_t i = 0; i < HMAC_BLOCK_SIZE; i++) pad[i] = hmac_key[i] ^ 0x36;
+    checksum_init(&state, CHECKSUM_SHA256);
+    checksum_update(&state, pad, sizeof(pad));
+    checksum_update(&state, prefix, sizeof(prefix));
+    checksum_update(&state, passphrase, (size_t)passphrase_length);
+    checksum_update(&state, salt, salt_length);
+    sha256_final(&state, inner);
+
+    for (size_t i = 0; i < HMAC_BLOCK_SIZE; i++) pad[i] = hmac_key[i] ^ 0x5c;
+    checksum_init(&state, CHECKSUM_SHA256);
+    checksum_update(&state, pad, sizeof(pad));
+    checksum_update(&state, inner, sizeof(inner));
+    sha256_final(&state, tag);
+
+    secure_zero(pad, sizeof(pad));
+    secure_zero(inner, sizeof(inner));
+    return 0;
+}
+
+int key_cache_enable(napi_env env, size_t max_entries, uint64_t ttl_ms) {
+    AddonInstance* instance = addon_instance(env);
+    if (instance == NULL) return -1;
+    uv_once(&hmac_key_once, hmac_key_init);
+    if (!hmac_key_ready) return -1;
+    key_cache_disable(env);
+
+    KeyCache* cache = (KeyCache*)calloc(1, sizeof(KeyCache));
+    if (cache == NULL) return -1;
+
+    cache->bucket_count = 16;
+    while (cache->bucket_count < max_entries) {
+        cache->bucket_count <<= 1;
+    }
+    cache->buckets = (KeyCacheEntry**)calloc(cache->bucket_count, sizeof(KeyCacheEntry*));
+    if (cache->buckets == NULL) {
+        free(cache);
+        return -1;
+    }
+    cache->ttl_ns = ttl_ms * 1000000u;
+    cache->stats.max_entries = max_entries;
+    cache->stats.ttl_ms = ttl_ms;
+    instance->key_cache = cache;
+
+    LOG_INFO("encryption key cache enabled (max %zu entries, ttl %llu ms)",
+             max_entries, (unsigned long long)ttl_ms);
+    return 0;
+}
+
+void key_cache_disable(napi_env env) {
+    AddonInstance* instance = addon_instance(env);
+    if (instance == NULL || instance->key_cache == NULL) return;
+    key_cache_destroy(instance->key_cache);
+    instance->key_cache = NULL;
+    LOG_DEBUG("encryption key cache disabled");
+}
+
+bool key_cache_enabled(napi_env env) {
+    return cache_of(env) != NULL;
+}
+
+KeyCacheEntry* key_cache_acquire(napi_env env, const uint8_t* tag) {
+    KeyCache* cache = cache_of(env);
+    if (cache == NULL) return NULL;
+
+    KeyCacheEntry** slot = find_slot(cache, tag);
+    KeyCacheEntry* entry = *slot;
+    if (entry != NULL && entry->expires_at != 0 && uv_hrtime() >= entry->expires_at) {
+        remove_entry(cache, slot);
+        cache->stats.expirations++;
+        entry = NULL;
+    }
+    if (entry == NULL) {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    lru_unlink(cache, entry);
+    lru_push_front(cache, entry);
+    cache->stats.hits++;
+    entry->refs++;
+    return entry;
+}
+
+KeyCacheEntry* key_cache_adopt(napi_env env, const uint8_t* tag, UplinkEncryptionKey* key) {
+    KeyCacheEntry* entry = (KeyCacheEntry*)calloc(1, sizeof(KeyCacheEntry));
+    if (entry == NULL) return NULL;
+    memcpy(entry->tag, tag, KEY_CACHE_TAG_SIZE);
+    entry->key = key;
+    entry->refs = 1;
+
+    KeyCache* cache = cache_of(env);
+    if (cache == NULL) {
+        return entry;
+    }
+    KeyCacheEntry** slot = find_slot(cache, tag);
+    if (*slot != NULL) {
+        /* Derived twice concurrently; the newer key replaces the listing */
+        remove_entry(cache, slot);
+        slot = find_slot(cache, tag);
+    }
+    entry->expires_at = cache->ttl_ns != 0 ? uv_hrtime() + cache->ttl_ns : 0;
+    entry->refs++;
+    *slot = entry;
+    lru_push_front(cache, entry);
+    cache->stats.entries++;
+
+    while (cache->stats.entries > cache->stats.max_entries && cache->tail != NULL) {
+        remove_entry(cache, find_slot(cache, cache->tail->tag));
+        cache->stats.evictions++;
+    }
+    return entry;
+}
+
+napi_value key_cache_share(napi_env env, KeyCacheEntry* entry) {
+    napi_value external = create_handle_external(env, entry->key->_handle, HANDLE_TYPE_ENCRYPTION_KEY, NULL, NULL);
+    if (external == NULL) {
+        return NULL;
+    }
+    HandleWrapper* wrapper = get_handle_wrapper(env, external, HANDLE_TYPE_ENCRYPTION_KEY);
+    wrapper->attachment = entry;
+    wrapper->attachment_free = entry_unref;
+    entry->refs++;
+    return external;
+}
+
+void key_cache_release(KeyCacheEntry* entry) {
+    if (entry != NULL) {
+        entry_unref(entry);
+    }
+}
+
+int key_cache_stats(napi_env env, KeyCacheStats* out) {
+    KeyCache* cache = cache_of(env);
+    if (cache == NULL) return -1;
+    *out = cache->stats;
+    return 0;
+}
+
+void key_cache_destroy(KeyCache* cache) {
+    while (cache->head != NULL) {
+        remove_entry(cache, find_slot(cache, cache->head->tag));
+    }
+    free(cache->buckets);
+    free(cache);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file key_cache.h
+ * @brief Opt-in per-environment deriveEncryptionKey cache for uplink-nodejs native module
+ *
+ * Key derivation is deliberately slow, so services that override
+ * per-prefix keys for many tenants can keep derived keys around. The
+ * cache never stores a passphrase or salt: entries are keyed by an
+ * HMAC-SHA256 tag of the pair under a random per-process key, compared
+ * in constant time. Entries expire after a TTL, and tags are zeroized
+ * when an entry is freed.
+ *
+ * Like access_cache.h, entries are reference-counted by the cache and
+ * by every handle sharing them, so an evicted or expired key is freed
+ * only once its last handle is collected. Tagging is safe from any
+ * thread; everything else is main thread only.
+ */
+
+#ifndef UPLINK_KEY_CACHE_H
+#define UPLINK_KEY_CACHE_H
+
+#include <node_api.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "uplink.h"
+
+/** Size of a passphrase+salt tag */
+#define KEY_CACHE_TAG_SIZE 32
+
+/** Default entry limit for enableEncryptionKeyCache */
+#define KEY_CACHE_DEFAULT_MAX_ENTRIES 1024
+
+/** Default time to live for enableEncryptionKeyCache (0 = no expiry) */
+#define KEY_CACHE_DEFAULT_TTL_MS (15 * 60 * 1000)
+
+typedef struct KeyCache KeyCache;
+typedef struct KeyCacheEntry KeyCacheEntry;
+
+/**
+ * Counters for one environment's cache
+ */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;             /* dropped for the entry limit */
+    uint64_t expirations;           /* dropped for the TTL */
+    size_t entries;
+    size_t max_entries;
+    uint64_t ttl_ms;
+} KeyCacheStats;
+
+/**
+ * Overwrite @p length bytes at @p data with zeros in a way the compiler
+ * does not elide
+ */
+void secure_zero(void* data, size_t length);
+
+/**
+ * Compute the cache tag of a passphrase and salt (any thread)
+ *
+ * @param tag Receives KEY_CACHE_TAG_SIZE bytes
+ * @return 0 on success, -1 if no process key could be generated
+ */
+int key_cache_tag(const char* passphrase, const void* salt, size_t salt_length, uint8_t* tag);
+
+/**
+ * Enable (or reconfigure, dropping all entries) the cache of @p env
+ *
+ * @param ttl_ms Time an entry stays listed, 0 for no expiry
+ * @return 0 on success, -1 on OOM or without a process key
+ */
+int key_cache_enable(napi_env env, size_t max_entries, uint64_t ttl_ms);
+
+/**
+ * Disable the cache of @p env (no-op when disabled)
+ */
+void key_cache_disable(napi_env env);
+
+/**
+ * Whether @p env has a cache
+ */
+bool key_cache_enabled(napi_env env);
+
+/**
+ * Look up @p tag, counting a hit or a miss; an expired entry is dropped
+ *
+ * @return The entry with a reference for the caller, or NULL on a miss
+ *         or when the cache is disabled
+ */
+KeyCacheEntry* key_cache_acquire(napi_env env, const uint8_t* tag);
+
+/**
+ * Take ownership of a freshly derived key, listing it under @p tag when
+ * the cache is enabled
+ *
+ * @return The entry with a reference for the caller, or NULL on OOM
+ *         (the caller still owns @p key)
+ */
+KeyCacheEntry* key_cache_adopt(napi_env env, const uint8_t* tag, UplinkEncryptionKey* key);
+
+/**
+ * Wrap @p entry in a new encryption key handle holding its own reference
+ *
+ * @return The handle, or NULL with a JS exception pending
+ */
+napi_value key_cache_share(napi_env env, KeyCacheEntry* entry);
+
+/**
+ * Drop a reference taken by key_cache_acquire or key_cache_adopt
+ */
+void key_cache_release(KeyCacheEntry* entry);
+
+/**
+ * Read the counters of @p env's cache
+ *
+ * @return 0 on success, -1 when the cache is disabled
+ */
+int key_cache_stats(napi_env env, KeyCacheStats* out);
+
+/**
+ * Free a cache; entries still shared by handles outlive it. Called
+ * from key_cache_disable and the instance finalizer.
+ */
+void key_cache_destroy(KeyCache* cache);
+
+#endif /* UPLINK_KEY_CACHE_H */
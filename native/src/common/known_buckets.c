@@ -0,0 +1,212 @@
+/**
+ * @file known_buckets.c
+ * @brief Opt-in per-project known bucket set implementation
+ *
+ * Each enabled project owns a chained hash table of names that doubles
+ * when it fills up. Sets live on a small global list keyed by project
+ * handle, like the stat cache, so completions that only know the
+ * project handle can record and invalidate. Everything runs on the main
+ * thread.
+ */
+
+#include "known_buckets.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct KnownBucket {
+    char* name;
+    uint32_t hash;
+    int64_t created;
+    uint64_t expires_at;            /* uv_hrtime() deadline, ns */
+    struct KnownBucket* chain;
+} KnownBucket;
+
+typedef struct KnownBuckets {
+    size_t project_handle;
+    KnownBucket** slots;
+    size_t slot_count;              /* Power of two */
+    uint64_t epoch;
+    KnownBucketsStats stats;
+    struct KnownBuckets* next;
+} KnownBuckets;
+
+static KnownBuckets* known_sets = NULL;
+
+/* ========== helpers ========== */
+
+static KnownBuckets* find_set(size_t project_handle) {
+    for (KnownBuckets* set = known_sets; set != NULL; set = set->next) {
+        if (set->project_handle == project_handle) {
+            return set;
+        }
+    }
+    return NULL;
+}
+
+/** FNV-1a */
+static uint32_t hash_name(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const char* p = name; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    return hash;
+}
+
+static KnownBucket** find_slot(KnownBuckets* set, uint32_t hash, const char* name) {
+    KnownBucket** slot = &set->slots[hash & (set->slot_count - 1)];
+    while (*slot != NULL && ((*slot)->hash != hash || strcmp((*slot)->name, name) != 0)) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+static void remove_entry(KnownBuckets* set, KnownBucket** slot) {
+    KnownBucket* entry = *slot;
+    *slot = entry->chain;
+    free(entry->name);
+    free(entry);
+    set->stats.entries--;
+}
+
+/** Double the table; keeps the old one when memory is short */
+static void grow(KnownBuckets* set) {
+    size_t count = set->slot_count * 2;
+    KnownBucket** slots = (KnownBucket**)calloc(count, sizeof(KnownBucket*));
+    if (slots == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < set->slot_count; i++) {
+        KnownBucket* entry = set->slots[i];
+        while (entry != NULL) {
+            KnownBucket* chain = entry->chain;
+            entry->chain = slots[entry->hash & (count - 1)];
+            slots[entry->hash & (count - 1)] = entry;
+            entry = chain;
+        }
+    }
+    free(set->slots);
+    set->slots = slots;
+    set->slot_count = count;
+}
+
+static void free_set(KnownBuckets* set) {
+    for (size_t i = 0; i < set->slot_count; i++) {
+        while (set->slots[i] != NULL) {
+            remove_entry(set, &set->slots[i]);
+        }
+    }
+    free(set->slots);
+    free(set);
+}
+
+/* ========== public API ========== */
+
+int known_buckets_enable(size_t project_handle, int64_t ttl_ms) {
+    known_buckets_disable(project_handle);
+
+    KnownBuckets* set = (KnownBuckets*)calloc(1, sizeof(KnownBuckets));
+    if (set == NULL) return -1;
+
+    set->slot_count = 16;
+    set->slots = (KnownBucket**)calloc(set->slot_count, sizeof(KnownBucket*));
+    if (set->slots == NULL) {
+        free(set);
+        return -1;
+    }
+
+    set->project_handle = project_handle;
+    set->epoch = 1;
+    set->stats.ttl_ms = ttl_ms;
+    set->next = known_sets;
+    known_sets = set;
+
+    LOG_INFO("known bucket set enabled for project %zu (ttl %lld ms)", project_handle, (long long)ttl_ms);
+    return 0;
+}
+
+void known_buckets_disable(size_t project_handle) {
+    for (KnownBuckets** link = &known_sets; *link != NULL; link = &(*link)->next) {
+        if ((*link)->project_handle == project_handle) {
+            KnownBuckets* set = *link;
+            *link = set->next;
+            free_set(set);
+            LOG_DEBUG("known bucket set disabled for project %zu", project_handle);
+            return;
+        }
+    }
+}
+
+bool known_buckets_lookup(size_t project_handle, const char* name, int64_t* created) {
+    KnownBuckets* set = find_set(project_handle);
+    if (set == NULL) return false;
+
+    KnownBucket** slot = find_slot(set, hash_name(name), name);
+    if (*slot == NULL) {
+        set->stats.misses++;
+        return false;
+    }
+    if ((*slot)->expires_at <= uv_hrtime()) {
+        remove_entry(set, slot);
+        set->stats.misses++;
+        return false;
+    }
+    *created = (*slot)->created;
+    set->stats.hits++;
+    return true;
+}
+
+uint64_t known_buckets_epoch(size_t project_handle) {
+    KnownBuckets* set = find_set(project_handle);
+    return set != NULL ? set->epoch : 0;
+}
+
+void known_buckets_add(size_t project_handle, uint64_t epoch, const char* name, int64_t created) {
+    KnownBuckets* set = find_set(project_handle);
+    if (set == NULL || set->epoch != epoch || name == NULL) return;
+
+    uint64_t expires_at = uv_hrtime() + (uint64_t)set->stats.ttl_ms * 1000000ULL;
+    uint32_t hash = hash_name(name);
+    KnownBucket** slot = find_slot(set, hash, name);
+    if (*slot != NULL) {
+        (*slot)->created = created;
+        (*slot)->expires_at = expires_at;
+        return;
+    }
+
+    KnownBucket* entry = (KnownBucket*)calloc(1, sizeof(KnownBucket));
+    if (entry == NULL || (entry->name = strdup(name)) == NULL) {
+        free(entry);
+        return;
+    }
+    entry->hash = hash;
+    entry->created = created;
+    entry->expires_at = expires_at;
+    *slot = entry;
+    set->stats.entries++;
+    if (set->stats.entries > set->slot_count) {
+        grow(set);
+    }
+}
+
+void known_buckets_forget(size_t project_handle, const char* name) {
+    KnownBuckets* set = find_set(project_handle);
+    if (set == NULL) return;
+
+    /* Bump the epoch even when absent, so an ensure racing the delete is not recorded */
+    set->epoch++;
+    KnownBucket** slot = find_slot(set, hash_name(name), name);
+    if (*slot != NULL) {
+        remove_entry(set, slot);
+        set->stats.invalidations++;
+    }
+}
+
+int known_buckets_stats(size_t project_handle, KnownBucketsStats* out) {
+    KnownBuckets* set = find_set(project_handle);
+    if (set == NULL) return -1;
+    *out = set->stats;
+    return 0;
+}
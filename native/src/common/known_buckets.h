@@ -0,0 +1,80 @@
+/**
+ * @file known_buckets.h
+ * @brief Opt-in per-project set of buckets known to exist
+ *
+ * ensureBucket costs a satellite round trip even when the bucket was
+ * ensured a moment ago. With the set enabled, ensureBucket and
+ * createBucket record the buckets they return, and a repeat ensureBucket
+ * resolves on the main thread from the set. deleteBucket and
+ * deleteBucketWithObjects drop the name; deletions by other clients are
+ * seen once the entry expires. Main thread only.
+ */
+
+#ifndef UPLINK_KNOWN_BUCKETS_H
+#define UPLINK_KNOWN_BUCKETS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Default entry lifetime for projectEnableKnownBuckets (5 min) */
+#define KNOWN_BUCKETS_DEFAULT_TTL_MS (5 * 60 * 1000)
+
+/**
+ * Counters for one project's set
+ */
+typedef struct {
+    uint64_t hits;                  /* ensureBucket calls answered from the set */
+    uint64_t misses;
+    uint64_t invalidations;         /* Names dropped by bucket deletes */
+    size_t entries;
+    int64_t ttl_ms;
+} KnownBucketsStats;
+
+/**
+ * Enable (or reconfigure, dropping all names) the set of a project
+ *
+ * @param ttl_ms How long a name stays known
+ * @return 0 on success, -1 on OOM
+ */
+int known_buckets_enable(size_t project_handle, int64_t ttl_ms);
+
+/**
+ * Disable the set of a project and free its names (no-op when disabled)
+ */
+void known_buckets_disable(size_t project_handle);
+
+/**
+ * Look up a live name, counting a hit or a miss
+ *
+ * @param[out] created Receives the bucket's creation time on a hit
+ * @return true when the bucket is known to exist
+ */
+bool known_buckets_lookup(size_t project_handle, const char* name, int64_t* created);
+
+/**
+ * Current invalidation epoch of a project's set (0 when disabled)
+ *
+ * An ensure records the epoch before it starts and passes it to
+ * known_buckets_add(), so a result that raced a delete is not recorded.
+ */
+uint64_t known_buckets_epoch(size_t project_handle);
+
+/**
+ * Record a bucket that exists if the epoch is still @p epoch
+ */
+void known_buckets_add(size_t project_handle, uint64_t epoch, const char* name, int64_t created);
+
+/**
+ * Drop a name after the bucket was deleted, or a delete was attempted
+ */
+void known_buckets_forget(size_t project_handle, const char* name);
+
+/**
+ * Read the counters of a project's set
+ *
+ * @return 0 on success, -1 when the project has no set
+ */
+int known_buckets_stats(size_t project_handle, KnownBucketsStats* out);
+
+#endif /* UPLINK_KNOWN_BUCKETS_H */
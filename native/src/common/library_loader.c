@@ -3,10 +3,22 @@
  * @brief Implementation of dynamic library loader
  * 
  * Provides cross-platform dynamic library loading for uplink-c.
+ *
+ * The handle is the one piece of process-wide state: every environment
+ * that loads the addon (main thread or worker) takes a reference, and the
+ * library is closed when the last one is released.
+ *
+ * The addon links libuplink directly, so the dynamic linker has already
+ * mapped it and bound the uplink_* calls by the time module init runs;
+ * the handle here only serves name lookups. Taking a reference is
+ * therefore cheap and the search runs on the first lookup, attaching to
+ * the mapped copy before trying any path. UPLINK_LIBRARY_EAGER=1 restores
+ * the search at module init, e.g. to see load errors at startup.
  */
 
 #include "library_loader.h"
 #include "logger.h"
+#include <uv.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,12 +26,14 @@
 #ifdef _WIN32
     #include <windows.h>
     #define LOAD_LIBRARY(path) LoadLibraryA(path)
+    #define ATTACH_LIBRARY(name) attach_loaded_module(name)
     #define GET_SYMBOL(handle, name) GetProcAddress((HMODULE)handle, name)
     #define CLOSE_LIBRARY(handle) FreeLibrary((HMODULE)handle)
     #define LIB_EXT ".dll"
 #else
     #include <dlfcn.h>
     #define LOAD_LIBRARY(path) dlopen(path, RTLD_NOW | RTLD_LOCAL)
+    #define ATTACH_LIBRARY(name) dlopen(name, RTLD_NOW | RTLD_LOCAL | RTLD_NOLOAD)
     #define GET_SYMBOL(handle, name) dlsym(handle, name)
     #define CLOSE_LIBRARY(handle) dlclose(handle)
     #ifdef __APPLE__
@@ -29,8 +43,24 @@
     #endif
 #endif
 
-void* uplink_lib_handle = NULL;
+static void* uplink_lib_handle = NULL;
 static char loaded_path[1024] = {0};
+static unsigned int lib_refs = 0;   /* environments holding a reference */
+static int lib_searched = 0;        /* the search ran since the last close */
+static uv_once_t lib_once = UV_ONCE_INIT;
+static uv_mutex_t lib_lock;         /* guards the four above */
+
+#ifdef _WIN32
+/** Reference an already loaded module like LoadLibrary would, or NULL */
+static void* attach_loaded_module(const char* name) {
+    HMODULE module = NULL;
+    return GetModuleHandleExA(0, name, &module) ? (void*)module : NULL;
+}
+#endif
+
+static void lib_lock_init(void) {
+    uv_mutex_init(&lib_lock);
+}
 
 /**
  * Get the platform-specific directory name.
@@ -85,16 +115,22 @@ static int try_load_library(const char* path) {
     return -1;
 }
 
-int load_uplink_library(void) {
-    if (uplink_lib_handle != NULL) {
-        LOG_DEBUG("Library already loaded");
-        return 0;
-    }
-    
+/**
+ * Search the known locations; call with lib_lock held.
+ */
+static int find_and_load_library(void) {
     char path[1024];
     const char* platform_dir = get_platform_dir();
     const char* lib_name = "libuplink" LIB_EXT;
     
+    /* Try 0: the copy the addon was linked against, already mapped */
+    uplink_lib_handle = ATTACH_LIBRARY(lib_name);
+    if (uplink_lib_handle != NULL) {
+        snprintf(loaded_path, sizeof(loaded_path), "%s", lib_name);
+        LOG_DEBUG("Attached to linked library: %s", lib_name);
+        return 0;
+    }
+    
     /* Try 1: Environment variable path — validate before use to prevent path injection */
     const char* env_path = getenv("UPLINK_LIBRARY_PATH");
     if (env_path != NULL && env_path[0] != '\0') {
@@ -121,32 +157,75 @@ int load_uplink_library(void) {
     return -1;
 }
 
-void unload_uplink_library(void) {
+/**
+ * Run the search once per open/close cycle; call with lib_lock held.
+ */
+static int ensure_loaded_locked(void) {
     if (uplink_lib_handle != NULL) {
-        CLOSE_LIBRARY(uplink_lib_handle);
-        uplink_lib_handle = NULL;
-        loaded_path[0] = '\0';
-        LOG_INFO("Unloaded uplink library");
+        return 0;
+    }
+    if (lib_searched) {
+        return -1;
+    }
+    lib_searched = 1;
+    return find_and_load_library();
+}
+
+int load_uplink_library(void) {
+    uv_once(&lib_once, lib_lock_init);
+    const char* eager = getenv("UPLINK_LIBRARY_EAGER");
+    uv_mutex_lock(&lib_lock);
+    int rc = 0;
+    if (eager != NULL && strcmp(eager, "1") == 0) {
+        rc = ensure_loaded_locked();
     }
+    if (rc == 0) {
+        lib_refs++;
+    }
+    uv_mutex_unlock(&lib_lock);
+    return rc;
+}
+
+void unload_uplink_library(void) {
+    uv_once(&lib_once, lib_lock_init);
+    uv_mutex_lock(&lib_lock);
+    if (lib_refs > 0 && --lib_refs == 0) {
+        if (uplink_lib_handle != NULL) {
+            CLOSE_LIBRARY(uplink_lib_handle);
+            uplink_lib_handle = NULL;
+            loaded_path[0] = '\0';
+            LOG_INFO("Unloaded uplink library");
+        }
+        lib_searched = 0;
+    }
+    uv_mutex_unlock(&lib_lock);
 }
 
 void* get_uplink_function(const char* name) {
-    if (uplink_lib_handle == NULL) {
+    uv_once(&lib_once, lib_lock_init);
+    uv_mutex_lock(&lib_lock);
+    void* fn = NULL;
+    if (ensure_loaded_locked() != 0) {
         LOG_ERROR("Library not loaded, cannot get function: %s", name);
-        return NULL;
-    }
-    
-    void* fn = GET_SYMBOL(uplink_lib_handle, name);
-    if (fn == NULL) {
-        LOG_ERROR("Function not found: %s", name);
+    } else {
+        fn = GET_SYMBOL(uplink_lib_handle, name);
+        if (fn == NULL) {
+            LOG_ERROR("Function not found: %s", name);
+        }
     }
+    uv_mutex_unlock(&lib_lock);
     return fn;
 }
 
 int is_library_loaded(void) {
-    return uplink_lib_handle != NULL;
+    uv_once(&lib_once, lib_lock_init);
+    uv_mutex_lock(&lib_lock);
+    int loaded = ensure_loaded_locked() == 0;
+    uv_mutex_unlock(&lib_lock);
+    return loaded;
 }
 
 const char* get_loaded_library_path(void) {
+    is_library_loaded();
     return loaded_path;
 }
@@ -4,6 +4,10 @@
  * 
  * Handles loading the uplink-c shared library at runtime.
  * Supports multiple platforms (Windows, macOS, Linux).
+ *
+ * Loads are reference-counted so every environment that loads the addon
+ * (the main thread and each worker_thread) can load and unload it
+ * independently.
  */
 
 #ifndef UPLINK_LIBRARY_LOADER_H
@@ -12,30 +16,28 @@
 #include <stddef.h>
 
 /**
- * Global library handle.
- * Set after successful library load.
- */
-extern void* uplink_lib_handle;
-
-/**
- * Load the uplink-c shared library.
- * Searches in multiple locations:
+ * Take a reference on the uplink-c shared library.
+ *
+ * The library is found on the first lookup rather than here, unless
+ * UPLINK_LIBRARY_EAGER=1 is set. The search tries, in order:
+ * 0. The copy the addon was linked against, if already mapped
  * 1. UPLINK_LIBRARY_PATH environment variable
  * 2. native/prebuilds/<platform>/
  * 3. ./prebuilds/<platform>/
  * 4. System library path
  * 
- * @return 0 on success, -1 on failure
+ * @return 0 on success, -1 if an eager search failed
  */
 int load_uplink_library(void);
 
 /**
- * Unload the uplink-c shared library.
+ * Release a reference taken by load_uplink_library(); the last one
+ * closes the library.
  */
 void unload_uplink_library(void);
 
 /**
- * Get a function pointer from the loaded library.
+ * Get a function pointer from the library, searching for it first if needed.
  * 
  * @param name Function name to look up
  * @return Function pointer, or NULL if not found
@@ -43,7 +45,7 @@ void unload_uplink_library(void);
 void* get_uplink_function(const char* name);
 
 /**
- * Check if the library is currently loaded.
+ * Check if the library is loaded, searching for it first if needed.
  * 
  * @return 1 if loaded, 0 if not
  */
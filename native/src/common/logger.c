@@ -4,6 +4,14 @@
  * 
  * Provides thread-safe logging with timestamps, colors for console,
  * and optional file output.
+ *
+ * The ring is Vyukov's bounded queue: producers claim a slot with a CAS
+ * on the enqueue position and publish it through the slot's sequence
+ * number, and the single writer thread drains published slots in order.
+ * A full ring drops the message and counts it rather than blocking the
+ * caller. The writer sleeps on a semaphore that producers post only
+ * when it has announced it is going to sleep, formats each timestamp
+ * once per second, and flushes once per drained batch.
  */
 
 #include "logger.h"
@@ -11,14 +19,19 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <stdint.h>
+#include <uv.h>
 #ifndef _WIN32
 #include <fcntl.h>
 #include <sys/stat.h>
 #endif
 
-static LogLevel current_level = LOG_LEVEL_INFO;
+LogLevel logger_current_level = LOG_LEVEL_INFO;
 static FILE* log_file = NULL;
 static int initialized = 0;
+static int sync_mode = 0;
+static uv_once_t init_once = UV_ONCE_INIT;
+static uv_mutex_t write_lock;       /* guards log_file, the timestamp cache and writes */
 
 static const char* level_strings[] = {
     "NONE", "ERROR", "WARN", "INFO", "DEBUG", "TRACE"
@@ -35,6 +48,79 @@ static const char* level_colors[] = {
 
 #define COLOR_RESET "\x1b[0m"
 
+/* Slots in the ring (power of two) and bytes kept per message */
+#define LOG_RING_SIZE 1024
+#define LOG_MESSAGE_MAX 480
+
+/* ========== atomics ========== */
+
+#if defined(_MSC_VER)
+/* uv.h pulls in windows.h; Interlocked* are full barriers */
+static int64_t ring_load(volatile int64_t* p) {
+    return InterlockedCompareExchange64((volatile LONG64*)p, 0, 0);
+}
+static void ring_store(volatile int64_t* p, int64_t value) {
+    InterlockedExchange64((volatile LONG64*)p, value);
+}
+static int64_t ring_exchange(volatile int64_t* p, int64_t value) {
+    return InterlockedExchange64((volatile LONG64*)p, value);
+}
+static int ring_cas(volatile int64_t* p, int64_t* expected, int64_t desired) {
+    int64_t seen = InterlockedCompareExchange64((volatile LONG64*)p, desired, *expected);
+    if (seen == *expected) return 1;
+    *expected = seen;
+    return 0;
+}
+static void ring_add(volatile int64_t* p, int64_t value) {
+    InterlockedExchangeAdd64((volatile LONG64*)p, value);
+}
+#define ring_fence() MemoryBarrier()
+#else
+static int64_t ring_load(volatile int64_t* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+static void ring_store(volatile int64_t* p, int64_t value) {
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+static int64_t ring_exchange(volatile int64_t* p, int64_t value) {
+    return __atomic_exchange_n(p, value, __ATOMIC_SEQ_CST);
+}
+static int ring_cas(volatile int64_t* p, int64_t* expected, int64_t desired) {
+    return __atomic_compare_exchange_n(p, expected, desired, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+static void ring_add(volatile int64_t* p, int64_t value) {
+    __atomic_fetch_add(p, value, __ATOMIC_RELAXED);
+}
+#define ring_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+/* ========== ring ========== */
+
+typedef struct {
+    volatile int64_t seq;           /* == position when free, position + 1 when published */
+    LogLevel level;
+    int line;
+    time_t when;
+    const char* file;               /* __FILE__ basename and __func__ have static storage */
+    const char* func;
+    char message[LOG_MESSAGE_MAX];
+} LogSlot;
+
+static LogSlot* ring = NULL;
+static volatile int64_t enqueue_pos = 0;
+static int64_t dequeue_pos = 0;                 /* writer thread only */
+static volatile int64_t dropped = 0;
+static volatile int64_t writer_sleeping = 0;
+static volatile int64_t writer_stop = 0;
+static uv_sem_t writer_wake;
+static uv_thread_t writer_thread;
+static uv_once_t writer_once = UV_ONCE_INIT;
+static int writer_running = 0;
+
+/* Formatted timestamp of stamp_second; under write_lock */
+static time_t stamp_second = (time_t)-1;
+static char stamp[20];
+
 /* Log level name → value lookup table */
 typedef struct {
     const char* name;
@@ -52,15 +138,17 @@ static const LogLevelEntry LOG_LEVEL_MAP[] = {
 
 static const size_t LOG_LEVEL_MAP_SIZE = sizeof(LOG_LEVEL_MAP) / sizeof(LOG_LEVEL_MAP[0]);
 
-void logger_init(void) {
-    if (initialized) return;
+/* Every environment that loads the addon calls logger_init(); read the
+ * environment variables only once per process */
+static void logger_init_once(void) {
+    uv_mutex_init(&write_lock);
     
     /* Check environment variable for log level */
     const char* env_level = getenv("UPLINK_LOG_LEVEL");
     if (env_level != NULL) {
         for (size_t i = 0; i < LOG_LEVEL_MAP_SIZE; i++) {
             if (strcmp(env_level, LOG_LEVEL_MAP[i].name) == 0) {
-                current_level = LOG_LEVEL_MAP[i].level;
+                logger_current_level = LOG_LEVEL_MAP[i].level;
                 break;
             }
         }
@@ -82,23 +170,199 @@ void logger_init(void) {
 #endif
     }
     
+    const char* env_sync = getenv("UPLINK_LOG_SYNC");
+    sync_mode = env_sync != NULL && strcmp(env_sync, "1") == 0;
+    
     initialized = 1;
 }
 
+/* ========== output ========== */
+
+/** Timestamp of @p when, formatted once per second; under write_lock */
+static const char* format_timestamp(time_t when) {
+    if (when == stamp_second) {
+        return stamp;
+    }
+#ifdef _WIN32
+    struct tm* tm_info = localtime(&when); /* serialized by write_lock */
+#else
+    struct tm tm_buf;
+    struct tm* tm_info = localtime_r(&when, &tm_buf);
+#endif
+    if (tm_info == NULL) {
+        return "0000-00-00 00:00:00";
+    }
+    strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", tm_info);
+    stamp_second = when;
+    return stamp;
+}
+
+/** Write one line to stderr and the log file; under write_lock, unflushed */
+static void write_line(LogLevel level, time_t when, const char* file, int line,
+                       const char* func, const char* message) {
+    const char* timestamp = format_timestamp(when);
+    
+    /* Print to stderr with colors */
+    fprintf(stderr, "%s[%s] %s [%s:%d %s()] %s%s\n",
+            level_colors[level], timestamp, level_strings[level],
+            file, line, func, message, COLOR_RESET);
+    
+    /* Print to file without colors */
+    if (log_file != NULL) {
+        fprintf(log_file, "[%s] %s [%s:%d %s()] %s\n",
+                timestamp, level_strings[level], file, line, func, message);
+    }
+}
+
+static void flush_output(void) {
+    fflush(stderr);
+    if (log_file != NULL) {
+        fflush(log_file);
+    }
+}
+
+/** Format and write one message on the calling thread */
+static void write_inline(LogLevel level, const char* file, int line,
+                         const char* func, const char* fmt, va_list args) {
+    char message[LOG_MESSAGE_MAX];
+    vsnprintf(message, sizeof(message), fmt, args);
+    uv_mutex_lock(&write_lock);
+    write_line(level, time(NULL), file, line, func, message);
+    flush_output();
+    uv_mutex_unlock(&write_lock);
+}
+
+/* ========== writer thread ========== */
+
+/** Write out every published slot, then any drop count */
+static void writer_drain(void) {
+    int wrote = 0;
+    uv_mutex_lock(&write_lock);
+    for (;;) {
+        LogSlot* slot = &ring[dequeue_pos & (LOG_RING_SIZE - 1)];
+        if (ring_load(&slot->seq) != dequeue_pos + 1) {
+            break;
+        }
+        write_line(slot->level, slot->when, slot->file, slot->line, slot->func, slot->message);
+        ring_store(&slot->seq, dequeue_pos + LOG_RING_SIZE);
+        dequeue_pos++;
+        wrote = 1;
+    }
+    int64_t lost = ring_exchange(&dropped, 0);
+    if (lost > 0) {
+        char message[64];
+        snprintf(message, sizeof(message), "%lld messages dropped, log ring full", (long long)lost);
+        write_line(LOG_LEVEL_WARN, time(NULL), "logger.c", __LINE__, __func__, message);
+        wrote = 1;
+    }
+    if (wrote) {
+        flush_output();
+    }
+    uv_mutex_unlock(&write_lock);
+}
+
+/** Whether the next slot is published or a stop was requested */
+static int writer_has_work(void) {
+    LogSlot* slot = &ring[dequeue_pos & (LOG_RING_SIZE - 1)];
+    return ring_load(&slot->seq) == dequeue_pos + 1 ||
+           ring_load(&dropped) > 0 || ring_load(&writer_stop);
+}
+
+static void writer_main(void* arg) {
+    (void)arg;
+    for (;;) {
+        writer_drain();
+        if (ring_load(&writer_stop)) {
+            break;
+        }
+        /* Announce the sleep before the last look, so a producer that
+         * publishes after it is sure to see the flag and post */
+        ring_exchange(&writer_sleeping, 1);
+        ring_fence();
+        if (writer_has_work()) {
+            if (ring_exchange(&writer_sleeping, 0) == 0) {
+                /* A producer cleared the flag first and posted; consume it */
+                uv_sem_wait(&writer_wake);
+            }
+            continue;
+        }
+        uv_sem_wait(&writer_wake);
+    }
+    /* Messages published between the last drain and the stop */
+    writer_drain();
+}
+
+static void wake_writer(void) {
+    ring_fence();
+    if (ring_load(&writer_sleeping) && ring_exchange(&writer_sleeping, 0) == 1) {
+        uv_sem_post(&writer_wake);
+    }
+}
+
+static void writer_start_once(void) {
+    ring = (LogSlot*)malloc(sizeof(LogSlot) * LOG_RING_SIZE);
+    if (ring == NULL) {
+        return;
+    }
+    for (int64_t i = 0; i < LOG_RING_SIZE; i++) {
+        ring[i].seq = i;
+    }
+    if (uv_sem_init(&writer_wake, 0) != 0) {
+        free(ring);
+        ring = NULL;
+        return;
+    }
+    if (uv_thread_create(&writer_thread, writer_main, NULL) != 0) {
+        uv_sem_destroy(&writer_wake);
+        free(ring);
+        ring = NULL;
+        return;
+    }
+    writer_running = 1;
+    /* Write out what is still queued when the process exits */
+    atexit(logger_shutdown);
+}
+
+/** Start the writer on first use; 0 when messages must be written inline */
+static int writer_ready(void) {
+    uv_once(&writer_once, writer_start_once);
+    return writer_running && !ring_load(&writer_stop);
+}
+
+/* ========== public API ========== */
+
+void logger_init(void) {
+    uv_once(&init_once, logger_init_once);
+}
+
 void logger_shutdown(void) {
+    if (writer_running) {
+        ring_store(&writer_stop, 1);
+        ring_fence();
+        if (ring_exchange(&writer_sleeping, 0) == 1) {
+            uv_sem_post(&writer_wake);
+        }
+        uv_thread_join(&writer_thread);
+        writer_running = 0;
+        uv_sem_destroy(&writer_wake);
+    }
+    if (!initialized) return;
+    uv_mutex_lock(&write_lock);
     if (log_file != NULL) {
         fclose(log_file);
         log_file = NULL;
     }
-    initialized = 0;
+    uv_mutex_unlock(&write_lock);
 }
 
 void logger_set_level(LogLevel level) {
-    current_level = level;
+    logger_current_level = level;
 }
 
 void logger_set_file(const char* path) {
     if (path == NULL) return;
+    logger_init();
+    uv_mutex_lock(&write_lock);
     if (log_file != NULL) {
         fclose(log_file);
         log_file = NULL;
@@ -112,51 +376,60 @@ void logger_set_file(const char* path) {
         log_file = fdopen(fd, "a");
     }
 #endif
+    uv_mutex_unlock(&write_lock);
 }
 
 void logger_log(LogLevel level, const char* file, int line, 
                 const char* func, const char* fmt, ...) {
     if (!initialized) logger_init();
-    if (level > current_level) return;
-    
-    /* Get timestamp — use localtime_r (thread-safe, POSIX) on POSIX systems */
-    time_t now = time(NULL);
-    struct tm tm_buf;
-#ifdef _WIN32
-    struct tm* tm_info = localtime(&now); /* Windows: single-threaded addon, acceptable */
-    if (tm_info == NULL) return;
-#else
-    struct tm* tm_info = localtime_r(&now, &tm_buf);
-    if (tm_info == NULL) return;
-#endif
-    char timestamp[20];
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", tm_info);
+    if (level > logger_current_level) return;
     
     /* Extract filename from path */
     const char* filename = strrchr(file, '/');
     filename = filename ? filename + 1 : file;
     
-    /* Format message */
     va_list args;
     va_start(args, fmt);
     
-    /* Print to stderr with colors */
-    fprintf(stderr, "%s[%s] %s [%s:%d %s()] ", 
-            level_colors[level], timestamp, level_strings[level],
-            filename, line, func);
-    vfprintf(stderr, fmt, args);
-    fprintf(stderr, "%s\n", COLOR_RESET);
-    
-    /* Print to file without colors */
-    if (log_file != NULL) {
-        fprintf(log_file, "[%s] %s [%s:%d %s()] ", 
-                timestamp, level_strings[level], filename, line, func);
+    if (sync_mode || !writer_ready()) {
+        write_inline(level, filename, line, func, fmt, args);
         va_end(args);
-        va_start(args, fmt);
-        vfprintf(log_file, fmt, args);
-        fprintf(log_file, "\n");
-        fflush(log_file);
+        return;
+    }
+    
+    /* Claim the slot at the enqueue position; a slot still holding the
+     * message from one lap ago means the ring is full */
+    int64_t pos = ring_load(&enqueue_pos);
+    LogSlot* slot;
+    for (;;) {
+        slot = &ring[pos & (LOG_RING_SIZE - 1)];
+        int64_t diff = ring_load(&slot->seq) - pos;
+        if (diff == 0) {
+            if (ring_cas(&enqueue_pos, &pos, pos + 1)) break;
+        } else if (diff < 0) {
+            if (level <= LOG_LEVEL_WARN) {
+                /* Never drop warnings and errors; write them out of order */
+                write_inline(level, filename, line, func, fmt, args);
+                va_end(args);
+                return;
+            }
+            va_end(args);
+            ring_add(&dropped, 1);
+            wake_writer();
+            return;
+        } else {
+            pos = ring_load(&enqueue_pos);
+        }
     }
     
+    slot->level = level;
+    slot->line = line;
+    slot->when = time(NULL);
+    slot->file = filename;
+    slot->func = func;
+    vsnprintf(slot->message, sizeof(slot->message), fmt, args);
     va_end(args);
+    
+    ring_store(&slot->seq, pos + 1);
+    wake_writer();
 }
@@ -4,6 +4,14 @@
  * 
  * Provides structured logging with different severity levels.
  * Supports console and file output with timestamps and colors.
+ *
+ * Messages are formatted on the calling thread into a lock-free ring
+ * and written by a background thread, so a log call never blocks on
+ * stderr or the log file. Set UPLINK_LOG_SYNC=1 to write on the calling
+ * thread instead, e.g. when chasing a crash that would lose the ring.
+ *
+ * Calls above UPLINK_LOG_MAX_LEVEL are compiled out, arguments and all;
+ * calls above the runtime level skip argument evaluation too.
  */
 
 #ifndef UPLINK_LOGGER_H
@@ -23,6 +31,24 @@ typedef enum {
     LOG_LEVEL_TRACE = 5   /**< All messages including trace */
 } LogLevel;
 
+/**
+ * Most verbose level compiled in; build with e.g.
+ * `node-gyp rebuild -- -Duplink_log_max_level=3` to drop DEBUG and TRACE.
+ */
+#ifndef UPLINK_LOG_MAX_LEVEL
+#define UPLINK_LOG_MAX_LEVEL LOG_LEVEL_TRACE
+#endif
+
+/** Current runtime level; read through logger_enabled() */
+extern LogLevel logger_current_level;
+
+/**
+ * Whether a message at @p level would be written
+ */
+static inline int logger_enabled(LogLevel level) {
+    return level <= logger_current_level;
+}
+
 /**
  * Initialize the logger.
  * Reads UPLINK_LOG_LEVEL and UPLINK_LOG_FILE from environment.
@@ -30,7 +56,8 @@ typedef enum {
 void logger_init(void);
 
 /**
- * Shutdown the logger and close any open file handles.
+ * Shutdown the logger: write out queued messages, stop the writer
+ * thread and close any open file handles.
  */
 void logger_shutdown(void);
 
@@ -47,7 +74,8 @@ void logger_set_level(LogLevel level);
 void logger_set_file(const char* path);
 
 /**
- * Core logging function.
+ * Core logging function; normally reached through the LOG_* macros,
+ * which check the level first.
  * @param level Log level for this message
  * @param file Source file name
  * @param line Source line number
@@ -58,20 +86,23 @@ void logger_set_file(const char* path);
 void logger_log(LogLevel level, const char* file, int line, 
                 const char* func, const char* fmt, ...);
 
-/* Convenience macros for logging at different levels */
-#define LOG_ERROR(fmt, ...) \
-    logger_log(LOG_LEVEL_ERROR, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+/* Convenience macros for logging at different levels. The compile-time
+ * bound folds to a constant, so a compiled-out call still type-checks
+ * its arguments but emits no code. */
+#define LOG_AT(level, fmt, ...) \
+    do { \
+        if ((level) <= UPLINK_LOG_MAX_LEVEL && logger_enabled(level)) \
+            logger_log(level, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__); \
+    } while (0)
+
+#define LOG_ERROR(fmt, ...) LOG_AT(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
 
-#define LOG_WARN(fmt, ...) \
-    logger_log(LOG_LEVEL_WARN, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...) LOG_AT(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
 
-#define LOG_INFO(fmt, ...) \
-    logger_log(LOG_LEVEL_INFO, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...) LOG_AT(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
 
-#define LOG_DEBUG(fmt, ...) \
-    logger_log(LOG_LEVEL_DEBUG, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
 
-#define LOG_TRACE(fmt, ...) \
-    logger_log(LOG_LEVEL_TRACE, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+#define LOG_TRACE(fmt, ...) LOG_AT(LOG_LEVEL_TRACE, fmt, ##__VA_ARGS__)
 
 #endif /* UPLINK_LOGGER_H */
@@ -0,0 +1,122 @@
+/**
+ * @file native_alloc.c
+ * @brief Native heap accounting implementation
+ *
+ * Each wrapper forwards to the C library and adjusts relaxed atomic
+ * counters by the block's usable size, so a snapshot costs nothing and
+ * an allocation a few uncontended atomic adds.
+ */
+
+#include "native_alloc.h"
+
+/* This file calls the real functions */
+#undef malloc
+#undef calloc
+#undef realloc
+#undef strdup
+#undef free
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#define block_size(ptr) _msize(ptr)
+static int64_t counter_load(volatile int64_t* p) {
+    return InterlockedCompareExchange64((volatile LONG64*)p, 0, 0);
+}
+static int64_t counter_add(volatile int64_t* p, int64_t value) {
+    return InterlockedExchangeAdd64((volatile LONG64*)p, value) + value;
+}
+static int counter_cas(volatile int64_t* p, int64_t* expected, int64_t desired) {
+    int64_t seen = InterlockedCompareExchange64((volatile LONG64*)p, desired, *expected);
+    if (seen == *expected) return 1;
+    *expected = seen;
+    return 0;
+}
+#else
+#if defined(__APPLE__)
+#define block_size(ptr) malloc_size(ptr)
+#else
+#define block_size(ptr) malloc_usable_size(ptr)
+#endif
+static int64_t counter_load(volatile int64_t* p) {
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+static int64_t counter_add(volatile int64_t* p, int64_t value) {
+    return __atomic_add_fetch(p, value, __ATOMIC_RELAXED);
+}
+static int counter_cas(volatile int64_t* p, int64_t* expected, int64_t desired) {
+    return __atomic_compare_exchange_n(p, expected, desired, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+#endif
+
+static volatile int64_t alloc_count;
+static volatile int64_t free_count;
+static volatile int64_t live_bytes;
+static volatile int64_t peak_bytes;
+
+static void account_alloc(void* ptr) {
+    counter_add(&alloc_count, 1);
+    int64_t live = counter_add(&live_bytes, (int64_t)block_size(ptr));
+    int64_t peak = counter_load(&peak_bytes);
+    while (live > peak && !counter_cas(&peak_bytes, &peak, live)) {
+    }
+}
+
+void* native_malloc(size_t size) {
+    void* ptr = malloc(size);
+    if (ptr != NULL) {
+        account_alloc(ptr);
+    }
+    return ptr;
+}
+
+void* native_calloc(size_t count, size_t size) {
+    void* ptr = calloc(count, size);
+    if (ptr != NULL) {
+        account_alloc(ptr);
+    }
+    return ptr;
+}
+
+void* native_realloc(void* ptr, size_t size) {
+    int64_t old_size = ptr != NULL ? (int64_t)block_size(ptr) : 0;
+    void* moved = realloc(ptr, size);
+    if (moved == NULL) {
+        /* Failed (the old block is untouched), or realloc(ptr, 0) freed it */
+        if (ptr != NULL && size == 0) {
+            counter_add(&free_count, 1);
+            counter_add(&live_bytes, -old_size);
+        }
+        return NULL;
+    }
+    counter_add(&live_bytes, -old_size);
+    if (ptr != NULL) {
+        counter_add(&free_count, 1);
+    }
+    account_alloc(moved);
+    return moved;
+}
+
+char* native_strdup(const char* str) {
+    size_t length = strlen(str) + 1;
+    char* copy = (char*)native_malloc(length);
+    if (copy != NULL) {
+        memcpy(copy, str, length);
+    }
+    return copy;
+}
+
+void native_free(void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    counter_add(&free_count, 1);
+    counter_add(&live_bytes, -(int64_t)block_size(ptr));
+    free(ptr);
+}
+
+void native_alloc_stats(NativeAllocStats* stats) {
+    stats->allocations = (uint64_t)counter_load(&alloc_count);
+    stats->frees = (uint64_t)counter_load(&free_count);
+    stats->live_bytes = counter_load(&live_bytes);
+    stats->peak_bytes = counter_load(&peak_bytes);
+}
@@ -0,0 +1,56 @@
+/**
+ * @file native_alloc.h
+ * @brief Native heap accounting for uplink-nodejs native module
+ *
+ * binding.gyp force-includes this header into every addon source, so
+ * malloc, calloc, realloc, strdup and free in native/src go through the
+ * counting wrappers below: HandleWrappers, strdup'd keys, metadata entry
+ * arrays, work structs and pools alike. Sizes come from the allocator
+ * (malloc_usable_size and friends), so blocks carry no header and memory
+ * may still cross to or from code that uses the C library directly.
+ *
+ * Memory the addon frees but did not allocate (strings uplink-c hands
+ * over to free()) must be released with (free)(ptr), which bypasses the
+ * macro, or live bytes drift low. Counters are process-wide and safe on
+ * any thread.
+ */
+
+#ifndef UPLINK_NATIVE_ALLOC_H
+#define UPLINK_NATIVE_ALLOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+/** Allocation counters since process start */
+typedef struct {
+    uint64_t allocations;           /**< Calls that returned a block, realloc included */
+    uint64_t frees;                 /**< Blocks freed */
+    int64_t live_bytes;             /**< Bytes in blocks not yet freed */
+    int64_t peak_bytes;             /**< Highest live_bytes seen */
+} NativeAllocStats;
+
+void* native_malloc(size_t size);
+void* native_calloc(size_t count, size_t size);
+void* native_realloc(void* ptr, size_t size);
+char* native_strdup(const char* str);
+void native_free(void* ptr);
+
+/**
+ * Snapshot the allocation counters
+ */
+void native_alloc_stats(NativeAllocStats* stats);
+
+#define malloc(size) native_malloc(size)
+#define calloc(count, size) native_calloc(count, size)
+#define realloc(ptr, size) native_realloc(ptr, size)
+#define strdup(str) native_strdup(str)
+#define free(ptr) native_free(ptr)
+
+#endif /* UPLINK_NATIVE_ALLOC_H */
@@ -0,0 +1,321 @@
+/**
+ * @file object_cache.c
+ * @brief Opt-in per-project object contents cache implementation
+ *
+ * Laid out like stat_cache.c: each enabled project owns a chained hash
+ * table of entries threaded on an LRU list (most recent at the head), on
+ * a small global list keyed by project handle. Eviction is by total
+ * content bytes rather than entry count. Everything but blob allocation
+ * runs on the main thread, so blob reference counts need no atomics.
+ */
+
+#include "object_cache.h"
+#include "object_converter.h"
+#include "stat_cache.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ObjectCacheEntry {
+    char* id;                       /* bucket '\0' key */
+    size_t id_length;
+    uint32_t hash;
+    uint64_t expires_at;            /* uv_hrtime() deadline, ns */
+    ObjectCacheBlob* blob;          /* One reference */
+    UplinkObject info;              /* Deep copy */
+    struct ObjectCacheEntry* chain; /* Next in hash bucket */
+    struct ObjectCacheEntry* prev;  /* LRU neighbours */
+    struct ObjectCacheEntry* next;
+} ObjectCacheEntry;
+
+typedef struct ObjectCache {
+    size_t project_handle;
+    ObjectCacheEntry** buckets;
+    size_t bucket_count;            /* Power of two */
+    ObjectCacheEntry* head;         /* Most recently used */
+    ObjectCacheEntry* tail;
+    uint64_t epoch;
+    ObjectCacheStats stats;
+    struct ObjectCache* next;
+} ObjectCache;
+
+/** Expected average entry size, used to size the hash table */
+#define OBJECT_CACHE_TYPICAL_ENTRY (16 * 1024)
+
+/** Hash table size limit */
+#define OBJECT_CACHE_MAX_BUCKETS 65536
+
+static ObjectCache* object_caches = NULL;
+
+/* ========== helpers ========== */
+
+static ObjectCache* find_cache(size_t project_handle) {
+    for (ObjectCache* cache = object_caches; cache != NULL; cache = cache->next) {
+        if (cache->project_handle == project_handle) {
+            return cache;
+        }
+    }
+    return NULL;
+}
+
+/** FNV-1a over bucket '\0' key */
+static uint32_t hash_id(const char* bucket, const char* key) {
+    uint32_t hash = 2166136261u;
+    for (const char* p = bucket; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    hash = (hash ^ 0) * 16777619u;
+    for (const char* p = key; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    return hash;
+}
+
+static int entry_matches(const ObjectCacheEntry* entry, uint32_t hash, const char* bucket, const char* key) {
+    size_t bucket_length = strlen(bucket);
+    return entry->hash == hash &&
+           entry->id_length == bucket_length + 1 + strlen(key) &&
+           memcmp(entry->id, bucket, bucket_length + 1) == 0 &&
+           strcmp(entry->id + bucket_length + 1, key) == 0;
+}
+
+static ObjectCacheEntry** find_slot(ObjectCache* cache, uint32_t hash, const char* bucket, const char* key) {
+    ObjectCacheEntry** slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+    while (*slot != NULL && !entry_matches(*slot, hash, bucket, key)) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+static void lru_unlink(ObjectCache* cache, ObjectCacheEntry* entry) {
+    if (entry->prev != NULL) entry->prev->next = entry->next; else cache->head = entry->next;
+    if (entry->next != NULL) entry->next->prev = entry->prev; else cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void lru_push_front(ObjectCache* cache, ObjectCacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head != NULL) cache->head->prev = entry; else cache->tail = entry;
+    cache->head = entry;
+}
+
+/** Remove the entry in @p slot from the table and LRU, and free it */
+static void remove_entry(ObjectCache* cache, ObjectCacheEntry** slot) {
+    ObjectCacheEntry* entry = *slot;
+    *slot = entry->chain;
+    lru_unlink(cache, entry);
+    cache->stats.bytes -= entry->blob->length;
+    cache->stats.entries--;
+    object_cache_blob_release(entry->blob);
+    object_deep_free(&entry->info);
+    free(entry->id);
+    free(entry);
+}
+
+static void remove_lookup(ObjectCache* cache, ObjectCacheEntry* entry) {
+    const char* bucket = entry->id;
+    const char* key = entry->id + strlen(bucket) + 1;
+    remove_entry(cache, find_slot(cache, entry->hash, bucket, key));
+}
+
+static void free_cache(ObjectCache* cache) {
+    while (cache->head != NULL) {
+        remove_lookup(cache, cache->head);
+    }
+    free(cache->buckets);
+    free(cache);
+}
+
+/* ========== blobs ========== */
+
+ObjectCacheBlob* object_cache_blob_alloc(size_t length) {
+    if (length > SIZE_MAX - sizeof(ObjectCacheBlob)) return NULL;
+    ObjectCacheBlob* blob = (ObjectCacheBlob*)malloc(sizeof(ObjectCacheBlob) + (length > 0 ? length : 1));
+    if (blob == NULL) return NULL;
+    blob->refs = 1;
+    blob->length = length;
+    return blob;
+}
+
+void object_cache_blob_release(ObjectCacheBlob* blob) {
+    if (blob != NULL && --blob->refs == 0) {
+        free(blob);
+    }
+}
+
+/* ========== public API ========== */
+
+int object_cache_enable(size_t project_handle, size_t max_bytes, size_t max_object_size, int64_t ttl_ms) {
+    object_cache_disable(project_handle);
+
+    ObjectCache* cache = (ObjectCache*)calloc(1, sizeof(ObjectCache));
+    if (cache == NULL) return -1;
+
+    cache->bucket_count = 16;
+    while (cache->bucket_count < OBJECT_CACHE_MAX_BUCKETS &&
+           cache->bucket_count < max_bytes / OBJECT_CACHE_TYPICAL_ENTRY) {
+        cache->bucket_count <<= 1;
+    }
+    cache->buckets = (ObjectCacheEntry**)calloc(cache->bucket_count, sizeof(ObjectCacheEntry*));
+    if (cache->buckets == NULL) {
+        free(cache);
+        return -1;
+    }
+
+    cache->project_handle = project_handle;
+    cache->epoch = 1;
+    cache->stats.max_bytes = max_bytes;
+    cache->stats.max_object_size = max_object_size < max_bytes ? max_object_size : max_bytes;
+    cache->stats.ttl_ms = ttl_ms;
+    cache->next = object_caches;
+    object_caches = cache;
+
+    LOG_INFO("object cache enabled for project %zu (max %zu bytes, objects up to %zu bytes, ttl %lld ms)",
+             project_handle, max_bytes, cache->stats.max_object_size, (long long)ttl_ms);
+    return 0;
+}
+
+void object_cache_disable(size_t project_handle) {
+    for (ObjectCache** link = &object_caches; *link != NULL; link = &(*link)->next) {
+        if ((*link)->project_handle == project_handle) {
+            ObjectCache* cache = *link;
+            *link = cache->next;
+            free_cache(cache);
+            LOG_DEBUG("object cache disabled for project %zu", project_handle);
+            return;
+        }
+    }
+}
+
+size_t object_cache_max_object_size(size_t project_handle) {
+    ObjectCache* cache = find_cache(project_handle);
+    return cache != NULL ? cache->stats.max_object_size : 0;
+}
+
+uint64_t object_cache_epoch(size_t project_handle) {
+    ObjectCache* cache = find_cache(project_handle);
+    return cache != NULL ? cache->epoch : 0;
+}
+
+ObjectCacheBlob* object_cache_lookup(size_t project_handle, const char* bucket, const char* key,
+                                     const UplinkObject** out_info) {
+    ObjectCache* cache = find_cache(project_handle);
+    if (cache == NULL) return NULL;
+
+    ObjectCacheEntry** slot = find_slot(cache, hash_id(bucket, key), bucket, key);
+    if (*slot == NULL) {
+        cache->stats.misses++;
+        return NULL;
+    }
+    if ((*slot)->expires_at <= uv_hrtime()) {
+        remove_entry(cache, slot);
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    /* A fresher stat that saw another version means another client replaced the object */
+    const UplinkObject* current = stat_cache_peek(project_handle, bucket, key);
+    if (current != NULL && current->system.created != (*slot)->info.system.created) {
+        remove_entry(cache, slot);
+        cache->stats.invalidations++;
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    ObjectCacheEntry* entry = *slot;
+    lru_unlink(cache, entry);
+    lru_push_front(cache, entry);
+    cache->stats.hits++;
+    entry->blob->refs++;
+    *out_info = &entry->info;
+    return entry->blob;
+}
+
+void object_cache_store(size_t project_handle, uint64_t epoch, const char* bucket, const char* key,
+                        ObjectCacheBlob* blob, const UplinkObject* info) {
+    ObjectCache* cache = find_cache(project_handle);
+    if (cache == NULL || cache->epoch != epoch || blob == NULL || info == NULL ||
+        blob->length > cache->stats.max_object_size) {
+        return;
+    }
+
+    uint32_t hash = hash_id(bucket, key);
+    ObjectCacheEntry** slot = find_slot(cache, hash, bucket, key);
+    if (*slot != NULL) {
+        remove_entry(cache, slot);
+    }
+
+    ObjectCacheEntry* entry = (ObjectCacheEntry*)calloc(1, sizeof(ObjectCacheEntry));
+    if (entry == NULL) return;
+    size_t bucket_length = strlen(bucket);
+    entry->id_length = bucket_length + 1 + strlen(key);
+    entry->id = (char*)malloc(entry->id_length + 1);
+    if (entry->id == NULL || object_deep_copy(&entry->info, info) != 0) {
+        free(entry->id);
+        free(entry);
+        return;
+    }
+    memcpy(entry->id, bucket, bucket_length + 1);
+    strcpy(entry->id + bucket_length + 1, key);
+    entry->hash = hash;
+    entry->expires_at = uv_hrtime() + (uint64_t)cache->stats.ttl_ms * 1000000u;
+    entry->blob = blob;
+    blob->refs++;
+
+    while (cache->tail != NULL && cache->stats.bytes + blob->length > cache->stats.max_bytes) {
+        remove_lookup(cache, cache->tail);
+        cache->stats.evictions++;
+    }
+    slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+    entry->chain = *slot;
+    *slot = entry;
+    lru_push_front(cache, entry);
+    cache->stats.entries++;
+    cache->stats.bytes += blob->length;
+}
+
+void object_cache_invalidate(size_t project_handle, const char* bucket, const char* key) {
+    ObjectCache* cache = find_cache(project_handle);
+    if (cache == NULL || bucket == NULL || key == NULL) return;
+
+    cache->epoch++;
+    ObjectCacheEntry** slot = find_slot(cache, hash_id(bucket, key), bucket, key);
+    if (*slot != NULL) {
+        remove_entry(cache, slot);
+        cache->stats.invalidations++;
+    }
+}
+
+void object_cache_invalidate_prefix(size_t project_handle, const char* bucket, const char* prefix) {
+    ObjectCache* cache = find_cache(project_handle);
+    if (cache == NULL || bucket == NULL || prefix == NULL) return;
+
+    cache->epoch++;
+    size_t bucket_length = strlen(bucket);
+    size_t prefix_length = strlen(prefix);
+    ObjectCacheEntry* entry = cache->head;
+    while (entry != NULL) {
+        ObjectCacheEntry* next = entry->next;
+        if (entry->id_length >= bucket_length + 1 + prefix_length &&
+            memcmp(entry->id, bucket, bucket_length + 1) == 0 &&
+            memcmp(entry->id + bucket_length + 1, prefix, prefix_length) == 0) {
+            remove_lookup(cache, entry);
+            cache->stats.invalidations++;
+        }
+        entry = next;
+    }
+}
+
+int object_cache_enabled(size_t project_handle) {
+    return find_cache(project_handle) != NULL;
+}
+
+int object_cache_stats(size_t project_handle, ObjectCacheStats* out) {
+    ObjectCache* cache = find_cache(project_handle);
+    if (cache == NULL) return -1;
+    *out = cache->stats;
+    return 0;
+}
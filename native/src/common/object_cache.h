@@ -0,0 +1,136 @@
+/**
+ * @file object_cache.h
+ * @brief Opt-in per-project cache of small object contents for getObject
+ *
+ * A byte-capped LRU of getObject results keyed by bucket/key, with a TTL.
+ * Each entry remembers the object's creation time; when the project's
+ * stat cache holds a fresher view of the key with a different creation
+ * time, the entry is stale and dropped. Entries are also dropped by this
+ * binding's own writes to a key, through stat_cache_invalidate().
+ *
+ * Contents live in reference-counted blobs, so a hit hands JS an external
+ * Buffer over the cached bytes without copying. Main thread only, except
+ * object_cache_blob_alloc().
+ */
+
+#ifndef UPLINK_OBJECT_CACHE_H
+#define UPLINK_OBJECT_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "uplink.h"
+
+/** Default byte budget for projectEnableObjectCache (64 MiB) */
+#define OBJECT_CACHE_DEFAULT_MAX_BYTES (64 * 1024 * 1024)
+
+/** Default largest object kept by projectEnableObjectCache (1 MiB) */
+#define OBJECT_CACHE_DEFAULT_MAX_OBJECT_SIZE (1024 * 1024)
+
+/** Default entry lifetime for projectEnableObjectCache (60 s) */
+#define OBJECT_CACHE_DEFAULT_TTL_MS 60000
+
+/**
+ * Object contents shared by the cache and the Buffers handed to JS
+ */
+typedef struct {
+    size_t refs;
+    size_t length;
+    uint8_t data[];
+} ObjectCacheBlob;
+
+/**
+ * Counters for one project's cache
+ */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t invalidations;
+    uint64_t evictions;
+    size_t entries;
+    size_t bytes;
+    size_t max_bytes;
+    size_t max_object_size;
+    int64_t ttl_ms;
+} ObjectCacheStats;
+
+/**
+ * Allocate a blob of @p length bytes holding one reference (any thread)
+ * @return The blob, or NULL on OOM
+ */
+ObjectCacheBlob* object_cache_blob_alloc(size_t length);
+
+/**
+ * Drop a reference to @p blob, freeing it with the last one (NULL is a no-op)
+ */
+void object_cache_blob_release(ObjectCacheBlob* blob);
+
+/**
+ * Enable (or reconfigure, dropping all entries) the cache of a project
+ *
+ * @param max_bytes Total content bytes kept; least recently used entries are evicted
+ * @param max_object_size Larger objects are not cached
+ * @param ttl_ms How long an entry stays valid
+ * @return 0 on success, -1 on OOM
+ */
+int object_cache_enable(size_t project_handle, size_t max_bytes, size_t max_object_size, int64_t ttl_ms);
+
+/**
+ * Disable the cache of a project and release its entries (no-op when disabled)
+ */
+void object_cache_disable(size_t project_handle);
+
+/**
+ * Largest object a getObject should read into a blob for the cache
+ * @return The limit, or 0 when the project has no cache
+ */
+size_t object_cache_max_object_size(size_t project_handle);
+
+/**
+ * Current invalidation epoch of a project's cache (0 when disabled)
+ *
+ * A getObject records the epoch before it starts and passes it to
+ * object_cache_store(), so contents that raced a write are not cached.
+ */
+uint64_t object_cache_epoch(size_t project_handle);
+
+/**
+ * Look up live contents, counting a hit or a miss
+ *
+ * @param[out] out_info The cached object info (owned by the cache; valid
+ *                      until the next cache call)
+ * @return A new reference to the contents, or NULL on a miss or when the
+ *         project has no cache
+ */
+ObjectCacheBlob* object_cache_lookup(size_t project_handle, const char* bucket, const char* key,
+                                     const UplinkObject** out_info);
+
+/**
+ * Cache contents (taking a reference) and a deep copy of @p info if the
+ * epoch is still @p epoch and the object fits
+ */
+void object_cache_store(size_t project_handle, uint64_t epoch, const char* bucket, const char* key,
+                        ObjectCacheBlob* blob, const UplinkObject* info);
+
+/**
+ * Drop the entry for bucket/key after a write (no-op when disabled)
+ */
+void object_cache_invalidate(size_t project_handle, const char* bucket, const char* key);
+
+/**
+ * Drop every entry of @p bucket whose key starts with @p prefix (no-op when disabled)
+ */
+void object_cache_invalidate_prefix(size_t project_handle, const char* bucket, const char* prefix);
+
+/**
+ * Whether a project has a cache
+ */
+int object_cache_enabled(size_t project_handle);
+
+/**
+ * Read the counters of a project's cache
+ *
+ * @return 0 on success, -1 when the project has no cache
+ */
+int object_cache_stats(size_t project_handle, ObjectCacheStats* out);
+
+#endif /* UPLINK_OBJECT_CACHE_H */
@@ -8,85 +8,526 @@
  */
 
 #include "object_converter.h"
+#include "addon_instance.h"
 #include "logger.h"
+#include "codec.h"
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* ========== Property names ========== */
+
+/** Cached names, in ObjectKeys member order */
+static const char* const OBJECT_KEY_NAMES[] = {
+    "key", "isPrefix", "system", "created", "expires", "contentLength", "custom"
+};
+
+#define OBJECT_KEY_COUNT (sizeof(OBJECT_KEY_NAMES) / sizeof(OBJECT_KEY_NAMES[0]))
+
+_Static_assert(sizeof(ObjectKeys) == (OBJECT_KEY_COUNT + 1) * sizeof(napi_value),
+               "ObjectKeys must hold one napi_value per name, then make_lazy");
+
+/**
+ * Factory of lazy objects, given the native decoder. An object literal
+ * with a `custom` accessor keeps V8's fast literal path (defining the
+ * accessor on a finished object did not). The getter and setter both
+ * leave a plain data property behind, so an object looks exactly like
+ * an eager one once `custom` is touched.
+ */
+static const char LAZY_CUSTOM_JS[] =
+    "(function (decode) {\n"
+    "  'use strict';\n"
+    "  const defineProperty = Object.defineProperty;\n"
+    "  function settle(obj, value) {\n"
+    "    defineProperty(obj, 'custom', { value: value, writable: true, enumerable: true, configurable: true });\n"
+    "    return value;\n"
+    "  }\n"
+    "  return function makeObject(key, isPrefix, system, data) {\n"
+    "    return { key: key, isPrefix: isPrefix, system: system,\n"
+    "      get custom() { return settle(this, decode(data)); },\n"
+    "      set custom(value) { settle(this, value); } };\n"
+    "  };\n"
+    "})";
+
+/* ========== Packed metadata ========== */
+
+/* Packed metadata up to this size is built on the stack */
+#define CUSTOM_PACK_STACK 1024
+
+/*
+ * Layout of the one-byte string behind a lazy `custom`, native endian:
+ *   uint32 count, then count x { uint32 key_length, uint32 value_length },
+ *   then each key and value, unterminated, in entry order.
+ */
+
+static napi_value custom_to_js(napi_env env, const UplinkCustomMetadata* custom) {
+    napi_value obj, value;
+    napi_create_object(env, &obj);
+    if (custom->count > 0 && custom->entries != NULL) {
+        for (size_t i = 0; i < custom->count; i++) {
+            napi_create_string_utf8(env, custom->entries[i].value,
+                                    custom->entries[i].value_length, &value);
+            napi_set_named_property(env, obj, custom->entries[i].key, value);
+        }
+    }
+    return obj;
+}
+
+/** Pack @p custom into a one-byte string, or NULL if it does not fit the layout */
+static napi_value custom_pack(napi_env env, const UplinkCustomMetadata* custom) {
+    size_t total = sizeof(uint32_t) + custom->count * 2 * sizeof(uint32_t);
+    for (size_t i = 0; i < custom->count; i++) {
+        if (custom->entries[i].key_length > UINT32_MAX || custom->entries[i].value_length > UINT32_MAX) {
+            return NULL;
+        }
+        total += custom->entries[i].key_length + custom->entries[i].value_length;
+    }
+    if (custom->count > UINT32_MAX) {
+        return NULL;
+    }
+
+    uint8_t stack_buffer[CUSTOM_PACK_STACK];
+    uint8_t* data = total <= sizeof(stack_buffer) ? stack_buffer : (uint8_t*)malloc(total);
+    if (data == NULL) {
+        return NULL;
+    }
+    uint8_t* out = data;
+    uint32_t header[2];
+    header[0] = (uint32_t)custom->count;
+    memcpy(out, header, sizeof(uint32_t));
+    out += sizeof(uint32_t);
+    for (size_t i = 0; i < custom->count; i++) {
+        header[0] = (uint32_t)custom->entries[i].key_length;
+        header[1] = (uint32_t)custom->entries[i].value_length;
+        memcpy(out, header, sizeof(header));
+        out += sizeof(header);
+    }
+    for (size_t i = 0; i < custom->count; i++) {
+        memcpy(out, custom->entries[i].key, custom->entries[i].key_length);
+        out += custom->entries[i].key_length;
+        memcpy(out, custom->entries[i].value, custom->entries[i].value_length);
+        out += custom->entries[i].value_length;
+    }
+
+    napi_value packed;
+    napi_status status = napi_create_string_latin1(env, (const char*)data, total, &packed);
+    if (data != stack_buffer) {
+        free(data);
+    }
+    return status == napi_ok ? packed : NULL;
+}
+
+/** decode(packed): the accessor's call back into native, on first read */
+static napi_value custom_decode(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+
+    size_t length = 0;
+    if (argc < 1 || napi_get_value_string_latin1(env, argv[0], NULL, 0, &length) != napi_ok ||
+        length < sizeof(uint32_t)) {
+        napi_throw_type_error(env, NULL, "Corrupt lazy metadata");
+        return NULL;
+    }
+    uint8_t* in = (uint8_t*)malloc(length + 1);
+    if (in == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    napi_get_value_string_latin1(env, argv[0], (char*)in, length + 1, NULL);
+
+    uint32_t count;
+    memcpy(&count, in, sizeof(count));
+    size_t offset = sizeof(uint32_t);
+    size_t text = offset + (size_t)count * 2 * sizeof(uint32_t);
+    napi_value obj = NULL, key, value;
+    if (text <= length) {
+        napi_create_object(env, &obj);
+    }
+    for (uint32_t i = 0; obj != NULL && i < count; i++) {
+        uint32_t lengths[2];
+        memcpy(lengths, in + offset, sizeof(lengths));
+        offset += sizeof(lengths);
+        if ((size_t)lengths[0] + lengths[1] > length - text) {
+            obj = NULL;
+            break;
+        }
+        napi_create_string_utf8(env, (const char*)in + text, lengths[0], &key);
+        text += lengths[0];
+        napi_create_string_utf8(env, (const char*)in + text, lengths[1], &value);
+        text += lengths[1];
+        napi_set_property(env, obj, key, value);
+    }
+    free(in);
+    if (obj == NULL) {
+        napi_throw_type_error(env, NULL, "Corrupt lazy metadata");
+    }
+    return obj;
+}
+
+/** Build makeObject(key, isPrefix, system, data) around custom_decode, or NULL */
+static napi_value lazy_custom_create(napi_env env) {
+    napi_value script, factory, decode, make, undefined;
+    if (napi_create_string_utf8(env, LAZY_CUSTOM_JS, NAPI_AUTO_LENGTH, &script) != napi_ok ||
+        napi_run_script(env, script, &factory) != napi_ok ||
+        napi_create_function(env, "decodeCustomMetadata", NAPI_AUTO_LENGTH,
+                             custom_decode, NULL, &decode) != napi_ok) {
+        return NULL;
+    }
+    napi_get_undefined(env, &undefined);
+    if (napi_call_function(env, undefined, factory, 1, &decode, &make) != napi_ok) {
+        return NULL;
+    }
+    return make;
+}
+
+/**
+ * Create the names as V8 internalized strings, in an array. Strings from
+ * napi_create_string_utf8() are not internalized and V8 would look them
+ * up in its string table on every property store; the keys of an object
+ * are, so define the names on a scratch object and take its keys. The
+ * array is what the instance references: before Node-API 10 a reference
+ * cannot hold a string. The makeObject function follows the names.
+ */
+static napi_value object_keys_create(napi_env env) {
+    napi_value scratch, names, value;
+    napi_create_object(env, &scratch);
+    napi_get_null(env, &value);
+    for (size_t i = 0; i < OBJECT_KEY_COUNT; i++) {
+        if (napi_set_named_property(env, scratch, OBJECT_KEY_NAMES[i], value) != napi_ok) {
+            return NULL;
+        }
+    }
+
+    uint32_t count = 0;
+    if (napi_get_property_names(env, scratch, &names) != napi_ok ||
+        napi_get_array_length(env, names, &count) != napi_ok || count != OBJECT_KEY_COUNT) {
+        return NULL;
+    }
+
+    napi_value make = lazy_custom_create(env);
+    if (make == NULL) {
+        /* Conversions stay eager; don't leave the script's error behind */
+        LOG_WARN("Lazy custom metadata unavailable");
+        napi_value ignored;
+        napi_get_and_clear_last_exception(env, &ignored);
+    } else {
+        napi_set_element(env, names, OBJECT_KEY_COUNT, make);
+    }
+    return names;
+}
+
+int object_keys_get(napi_env env, ObjectKeys* keys) {
+    napi_value* out = (napi_value*)keys;
+    AddonInstance* instance = addon_instance(env);
+    napi_value names = NULL;
+
+    if (instance != NULL && instance->object_keys != NULL) {
+        napi_get_reference_value(env, instance->object_keys, &names);
+    }
+    if (names == NULL) {
+        names = object_keys_create(env);
+        if (names == NULL) {
+            return -1;
+        }
+        if (instance != NULL && instance->object_keys == NULL &&
+            napi_create_reference(env, names, 1, &instance->object_keys) != napi_ok) {
+            instance->object_keys = NULL;
+        }
+    }
+
+    for (uint32_t i = 0; i < OBJECT_KEY_COUNT; i++) {
+        if (napi_get_element(env, names, i, &out[i]) != napi_ok) {
+            return -1;
+        }
+    }
+
+    napi_valuetype type = napi_undefined;
+    keys->make_lazy = NULL;
+    if (napi_get_element(env, names, OBJECT_KEY_COUNT, &keys->make_lazy) == napi_ok) {
+        napi_typeof(env, keys->make_lazy, &type);
+    }
+    if (type != napi_function) {
+        keys->make_lazy = NULL;
+    }
+    return 0;
+}
+
+void object_keys_cleanup(napi_env env, AddonInstance* instance) {
+    if (instance->object_keys != NULL) {
+        napi_delete_reference(env, instance->object_keys);
+        instance->object_keys = NULL;
+    }
+}
+
+/* ========== Conversion ========== */
+
+/** A plain data property: writable, enumerable and configurable */
+static void object_property(napi_property_descriptor* desc, napi_value name, napi_value value) {
+    memset(desc, 0, sizeof(*desc));
+    desc->name = name;
+    desc->value = value;
+    desc->attributes = napi_default_jsproperty;
+}
 
 napi_value uplink_object_to_js(napi_env env, UplinkObject* object) {
+    return uplink_object_to_js_fields(env, object, OBJECT_FIELDS_ALL);
+}
+
+napi_value uplink_object_to_js_fields(napi_env env, UplinkObject* object, uint32_t fields) {
+    ObjectKeys keys;
+    if (object != NULL && (fields & OBJECT_FIELDS_ALL) != OBJECT_FIELD_KEY &&
+        object_keys_get(env, &keys) != 0) {
+        return NULL;
+    }
+    return uplink_object_to_js_keys(env, &keys, object, fields);
+}
+
+napi_value uplink_object_to_js_keys(napi_env env, const ObjectKeys* keys,
+                                    UplinkObject* object, uint32_t fields) {
     if (object == NULL) {
         napi_value undefined;
         napi_get_undefined(env, &undefined);
         return undefined;
     }
 
-    napi_value obj;
-    napi_create_object(env, &obj);
+    /* keys-only: a plain string, no wrapper object */
+    if ((fields & OBJECT_FIELDS_ALL) == OBJECT_FIELD_KEY) {
+        napi_value key;
+        napi_create_string_utf8(env, object->key, NAPI_AUTO_LENGTH, &key);
+        return key;
+    }
+
+    napi_property_descriptor props[4];
+    size_t prop_count = 0;
+    napi_value value;
 
     /* key */
-    napi_value key;
-    napi_create_string_utf8(env, object->key, NAPI_AUTO_LENGTH, &key);
-    napi_set_named_property(env, obj, "key", key);
+    if (fields & OBJECT_FIELD_KEY) {
+        napi_create_string_utf8(env, object->key, NAPI_AUTO_LENGTH, &value);
+        object_property(&props[prop_count++], keys->key, value);
+    }
 
     /* isPrefix */
-    napi_value is_prefix;
-    napi_get_boolean(env, object->is_prefix, &is_prefix);
-    napi_set_named_property(env, obj, "isPrefix", is_prefix);
-
-    /* system metadata */
-    napi_value system;
-    napi_create_object(env, &system);
-
-    /* system.created - Unix timestamp (seconds) */
-    napi_value created;
-    napi_create_int64(env, object->system.created, &created);
-    napi_set_named_property(env, system, "created", created);
-
-    /* system.expires - can be 0 if no expiration */
-    if (object->system.expires != 0) {
-        napi_value expires;
-        napi_create_int64(env, object->system.expires, &expires);
-        napi_set_named_property(env, system, "expires", expires);
-    } else {
-        napi_value null_val;
-        napi_get_null(env, &null_val);
-        napi_set_named_property(env, system, "expires", null_val);
+    if (fields & OBJECT_FIELD_IS_PREFIX) {
+        napi_get_boolean(env, object->is_prefix, &value);
+        object_property(&props[prop_count++], keys->is_prefix, value);
     }
 
-    /* system.contentLength */
-    napi_value content_length;
-    napi_create_int64(env, object->system.content_length, &content_length);
-    napi_set_named_property(env, system, "contentLength", content_length);
+    /* system metadata, holding only the requested system fields */
+    if (fields & OBJECT_FIELDS_SYSTEM) {
+        napi_property_descriptor system_props[3];
+        size_t system_count = 0;
 
-    napi_set_named_property(env, obj, "system", system);
+        /* system.created - Unix timestamp (seconds) */
+        if (fields & OBJECT_FIELD_CREATED) {
+            napi_create_int64(env, object->system.created, &value);
+            object_property(&system_props[system_count++], keys->created, value);
+        }
 
-    /* custom metadata */
-    napi_value custom;
-    napi_create_object(env, &custom);
+        /* system.expires - can be 0 if no expiration */
+        if (fields & OBJECT_FIELD_EXPIRES) {
+            if (object->system.expires != 0) {
+                napi_create_int64(env, object->system.expires, &value);
+            } else {
+                napi_get_null(env, &value);
+            }
+            object_property(&system_props[system_count++], keys->expires, value);
+        }
+
+        /* system.contentLength */
+        if (fields & OBJECT_FIELD_CONTENT_LENGTH) {
+            napi_create_int64(env, object->system.content_length, &value);
+            object_property(&system_props[system_count++], keys->content_length, value);
+        }
 
-    if (object->custom.count > 0 && object->custom.entries != NULL) {
-        for (size_t i = 0; i < object->custom.count; i++) {
-            napi_value value;
-            napi_create_string_utf8(env, object->custom.entries[i].value,
-                                    object->custom.entries[i].value_length, &value);
-            napi_set_named_property(env, custom, object->custom.entries[i].key, value);
+        napi_value system;
+        napi_create_object(env, &system);
+        napi_define_properties(env, system, system_count, system_props);
+        object_property(&props[prop_count++], keys->system, system);
+    }
+
+    /* custom metadata: packed for a lazy object, or converted now. Lazy
+     * objects come from makeObject, so only the full shape qualifies */
+    napi_value packed = NULL;
+    if (fields & OBJECT_FIELD_CUSTOM) {
+        if ((fields & OBJECT_CONVERT_LAZY_CUSTOM) && (fields & OBJECT_FIELDS_ALL) == OBJECT_FIELDS_ALL &&
+            keys->make_lazy != NULL && object->custom.count > 0 && object->custom.entries != NULL) {
+            packed = custom_pack(env, &object->custom);
+        }
+        if (packed == NULL) {
+            object_property(&props[prop_count++], keys->custom, custom_to_js(env, &object->custom));
         }
     }
 
-    napi_set_named_property(env, obj, "custom", custom);
+    napi_value obj;
+    if (packed != NULL) {
+        napi_value undefined, argv[4] = { props[0].value, props[1].value, props[2].value, packed };
+        napi_get_undefined(env, &undefined);
+        if (napi_call_function(env, undefined, keys->make_lazy, 4, argv, &obj) == napi_ok) {
+            return obj;
+        }
+        napi_value ignored;
+        napi_get_and_clear_last_exception(env, &ignored);
+        object_property(&props[prop_count++], keys->custom, custom_to_js(env, &object->custom));
+    }
 
+    napi_create_object(env, &obj);
+    napi_define_properties(env, obj, prop_count, props);
     return obj;
 }
 
+/* ========== Field projection ========== */
+
+/** JS field names, indexed by bit position in ObjectField */
+static const char* const OBJECT_FIELD_NAMES[] = {
+    "key", "isPrefix", "created", "expires", "contentLength", "custom"
+};
+
+int parse_object_fields(napi_env env, napi_value js_fields, uint32_t* out_fields) {
+    bool is_array = false;
+    napi_is_array(env, js_fields, &is_array);
+    if (!is_array) return -1;
+
+    uint32_t length = 0;
+    napi_get_array_length(env, js_fields, &length);
+
+    uint32_t fields = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element;
+        napi_get_element(env, js_fields, i, &element);
+
+        char name[32];
+        size_t name_len = 0;
+        if (napi_get_value_string_utf8(env, element, name, sizeof(name), &name_len) != napi_ok) {
+            return -1;
+        }
+
+        uint32_t bit = 0;
+        for (size_t f = 0; f < sizeof(OBJECT_FIELD_NAMES) / sizeof(OBJECT_FIELD_NAMES[0]); f++) {
+            if (strcmp(name, OBJECT_FIELD_NAMES[f]) == 0) {
+                bit = 1u << f;
+                break;
+            }
+        }
+        if (bit == 0) return -1;
+        fields |= bit;
+    }
+
+    if (fields == 0) return -1;
+    *out_fields = fields;
+    return 0;
+}
+
 /* ========== Metadata helpers ========== */
 
+/* Property handles of a metadata object up to this many entries stay on the stack */
+#define METADATA_STACK_ENTRIES 64
+
+typedef struct {
+    napi_value key;
+    napi_value value;
+    size_t key_length;
+    size_t value_length;
+} MetadataProperty;
+
+/*
+ * Entry arrays are one block: the entries, then each key and value
+ * NUL-terminated in entry order. One free() releases everything.
+ */
+static UplinkCustomMetadataEntry* metadata_block_alloc(size_t count, size_t text_length, char** out_text) {
+    if (count > (SIZE_MAX - text_length) / (sizeof(UplinkCustomMetadataEntry) + 2)) {
+        return NULL;
+    }
+    size_t entries_size = count * sizeof(UplinkCustomMetadataEntry);
+    UplinkCustomMetadataEntry* entries =
+        (UplinkCustomMetadataEntry*)malloc(entries_size + text_length + 2 * count);
+    if (entries != NULL) {
+        *out_text = (char*)entries + entries_size;
+    }
+    return entries;
+}
+
 void free_metadata_entries(UplinkCustomMetadataEntry* entries, size_t count) {
-    if (entries == NULL) return;
+    (void)count;
+    free(entries);
+}
+
+UplinkCustomMetadataEntry* copy_metadata_entries(const UplinkCustomMetadataEntry* entries, size_t count) {
+    size_t text_length = 0;
     for (size_t i = 0; i < count; i++) {
-        free(entries[i].key);
-        free(entries[i].value);
+        text_length += entries[i].key_length + entries[i].value_length;
     }
-    free(entries);
+    char* text = NULL;
+    UplinkCustomMetadataEntry* copy = metadata_block_alloc(count, text_length, &text);
+    if (copy == NULL) return NULL;
+
+    for (size_t i = 0; i < count; i++) {
+        copy[i].key = text;
+        copy[i].key_length = entries[i].key_length;
+        if (entries[i].key_length > 0) memcpy(text, entries[i].key, entries[i].key_length);
+        text += entries[i].key_length;
+        *text++ = '\0';
+        copy[i].value = text;
+        copy[i].value_length = entries[i].value_length;
+        if (entries[i].value_length > 0) memcpy(text, entries[i].value, entries[i].value_length);
+        text += entries[i].value_length;
+        *text++ = '\0';
+    }
+    return copy;
+}
+
+static uint32_t read_u32le(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+/** Parse packed metadata in one pass; -1 if malformed, -2 on OOM */
+static int metadata_entries_from_packed(const uint8_t* data, size_t length,
+                                        UplinkCustomMetadataEntry** out_entries,
+                                        size_t* out_count) {
+    if (length < sizeof(uint32_t)) return -1;
+    size_t count = read_u32le(data);
+    if (count > (length - sizeof(uint32_t)) / (2 * sizeof(uint32_t))) return -1;
+    if (count == 0) return length == sizeof(uint32_t) ? 0 : -1;
+
+    size_t table = sizeof(uint32_t);
+    size_t text_offset = table + count * 2 * sizeof(uint32_t);
+    size_t text_length = length - text_offset;
+    size_t used = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t pair = (size_t)read_u32le(data + table + i * 8) + read_u32le(data + table + i * 8 + 4);
+        if (pair > text_length - used) return -1;
+        used += pair;
+    }
+    if (used != text_length) return -1;
+
+    char* text = NULL;
+    UplinkCustomMetadataEntry* entries = metadata_block_alloc(count, text_length, &text);
+    if (entries == NULL) return -2;
+
+    const uint8_t* in = data + text_offset;
+    for (size_t i = 0; i < count; i++) {
+        size_t lengths[2] = { read_u32le(data + table + i * 8), read_u32le(data + table + i * 8 + 4) };
+        entries[i].key = text;
+        entries[i].key_length = lengths[0];
+        memcpy(text, in, lengths[0]);
+        in += lengths[0];
+        text += lengths[0];
+        *text++ = '\0';
+        entries[i].value = text;
+        entries[i].value_length = lengths[1];
+        memcpy(text, in, lengths[1]);
+        in += lengths[1];
+        text += lengths[1];
+        *text++ = '\0';
+    }
+
+    *out_entries = entries;
+    *out_count = count;
+    return 0;
 }
 
 int extract_metadata_entries_from_js(napi_env env, napi_value js_meta,
@@ -95,6 +536,14 @@ int extract_metadata_entries_from_js(napi_env env, napi_value js_meta,
     *out_entries = NULL;
     *out_count = 0;
 
+    bool is_buffer = false;
+    if (napi_is_buffer(env, js_meta, &is_buffer) == napi_ok && is_buffer) {
+        void* data = NULL;
+        size_t length = 0;
+        if (napi_get_buffer_info(env, js_meta, &data, &length) != napi_ok) return -1;
+        return metadata_entries_from_packed((const uint8_t*)data, length, out_entries, out_count);
+    }
+
     napi_value property_names;
     napi_get_property_names(env, js_meta, &property_names);
 
@@ -102,50 +551,111 @@ int extract_metadata_entries_from_js(napi_env env, napi_value js_meta,
     napi_get_array_length(env, property_names, &count);
     if (count == 0) return 0;
 
-    UplinkCustomMetadataEntry* entries =
-        (UplinkCustomMetadataEntry*)calloc(count, sizeof(UplinkCustomMetadataEntry));
-    if (entries == NULL) return -2;
+    /* Pass 1: keys, values and their lengths; pass 2: copy into one block */
+    MetadataProperty stack_properties[METADATA_STACK_ENTRIES];
+    MetadataProperty* properties = count <= METADATA_STACK_ENTRIES
+        ? stack_properties : (MetadataProperty*)malloc((size_t)count * sizeof(MetadataProperty));
+    if (properties == NULL) return -2;
 
+    int rc = 0;
+    size_t text_length = 0;
     for (uint32_t i = 0; i < count; i++) {
-        napi_value key_val;
-        napi_get_element(env, property_names, i, &key_val);
-
-        napi_value val;
-        napi_get_property(env, js_meta, key_val, &val);
+        MetadataProperty* property = &properties[i];
+        napi_get_element(env, property_names, i, &property->key);
+        napi_get_property(env, js_meta, property->key, &property->value);
 
         napi_valuetype val_type;
-        napi_typeof(env, val, &val_type);
+        napi_typeof(env, property->value, &val_type);
         if (val_type != napi_string) {
-            free_metadata_entries(entries, i);
-            return -1;
-        }
-
-        size_t key_len;
-        napi_get_value_string_utf8(env, key_val, NULL, 0, &key_len);
-        char* key_str = (char*)malloc(key_len + 1);
-        if (key_str == NULL) {
-            free_metadata_entries(entries, i);
-            return -2;
-        }
-        napi_get_value_string_utf8(env, key_val, key_str, key_len + 1, NULL);
-
-        size_t val_len;
-        napi_get_value_string_utf8(env, val, NULL, 0, &val_len);
-        char* val_str = (char*)malloc(val_len + 1);
-        if (val_str == NULL) {
-            free(key_str);
-            free_metadata_entries(entries, i);
-            return -2;
+            rc = -1;
+            break;
         }
-        napi_get_value_string_utf8(env, val, val_str, val_len + 1, NULL);
+        napi_get_value_string_utf8(env, property->key, NULL, 0, &property->key_length);
+        napi_get_value_string_utf8(env, property->value, NULL, 0, &property->value_length);
+        text_length += property->key_length + property->value_length;
+    }
 
-        entries[i].key = key_str;
-        entries[i].key_length = key_len;
-        entries[i].value = val_str;
-        entries[i].value_length = val_len;
+    char* text = NULL;
+    UplinkCustomMetadataEntry* entries = NULL;
+    if (rc == 0 && (entries = metadata_block_alloc(count, text_length, &text)) == NULL) {
+        rc = -2;
+    }
+    for (uint32_t i = 0; rc == 0 && i < count; i++) {
+        const MetadataProperty* property = &properties[i];
+        entries[i].key = text;
+        entries[i].key_length = property->key_length;
+        napi_get_value_string_utf8(env, property->key, text, property->key_length + 1, NULL);
+        text += property->key_length + 1;
+        entries[i].value = text;
+        entries[i].value_length = property->value_length;
+        napi_get_value_string_utf8(env, property->value, text, property->value_length + 1, NULL);
+        text += property->value_length + 1;
     }
 
+    if (properties != stack_properties) free(properties);
+    if (rc != 0) return rc;
+
     *out_entries = entries;
     *out_count = count;
     return 0;
 }
+
+/* ========== deep copies ========== */
+
+void object_deep_free(UplinkObject* object) {
+    free(object->key);
+    for (size_t i = 0; i < object->custom.count; i++) {
+        free(object->custom.entries[i].key);
+        free(object->custom.entries[i].value);
+    }
+    free(object->custom.entries);
+}
+
+static char* copy_object_bytes(const char* data, size_t length) {
+    char* copy = (char*)malloc(length + 1);
+    if (copy != NULL) {
+        memcpy(copy, data, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+int object_deep_copy(UplinkObject* dst, const UplinkObject* src) {
+    memset(dst, 0, sizeof(*dst));
+    dst->is_prefix = src->is_prefix;
+    dst->system = src->system;
+    dst->key = copy_object_bytes(src->key, strlen(src->key));
+    if (dst->key == NULL) return -1;
+    if (src->custom.count == 0 || src->custom.entries == NULL) return 0;
+
+    dst->custom.entries = (UplinkCustomMetadataEntry*)calloc(src->custom.count, sizeof(UplinkCustomMetadataEntry));
+    if (dst->custom.entries == NULL) {
+        object_deep_free(dst);
+        return -1;
+    }
+    for (size_t i = 0; i < src->custom.count; i++) {
+        const UplinkCustomMetadataEntry* entry = &src->custom.entries[i];
+        UplinkCustomMetadataEntry* copy = &dst->custom.entries[dst->custom.count++];
+        copy->key = copy_object_bytes(entry->key, entry->key_length);
+        copy->value = copy_object_bytes(entry->value, entry->value_length);
+        copy->key_length = entry->key_length;
+        copy->value_length = entry->value_length;
+        if (copy->key == NULL || copy->value == NULL) {
+            object_deep_free(dst);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+bool object_is_compressed(const UplinkObject* object) {
+    if (object == NULL) return false;
+    size_t key_length = strlen(CODEC_KEY_NAME);
+    for (size_t i = 0; i < object->custom.count; i++) {
+        const UplinkCustomMetadataEntry* entry = &object->custom.entries[i];
+        if (entry->key_length == key_length && memcmp(entry->key, CODEC_KEY_NAME, key_length) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -5,14 +5,84 @@
  * Single implementation of UplinkObject* → JS object conversion,
  * used by object_complete.c, upload_complete.c, download_complete.c,
  * and multipart_complete.c.
+ *
+ * Property names are created once per environment and kept as
+ * references, and each object's fixed properties are defined in one
+ * napi_define_properties call. Every converted object gets the same
+ * keys in the same order, so V8 gives them one hidden class.
  */
 
 #ifndef UPLINK_OBJECT_CONVERTER_H
 #define UPLINK_OBJECT_CONVERTER_H
 
 #include <node_api.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include "uplink.h"
 
+/**
+ * Fields of a converted object, as a bit mask. A listing's `fields`
+ * option selects a subset; unselected properties are not created.
+ */
+typedef enum {
+    OBJECT_FIELD_KEY            = 1u << 0,
+    OBJECT_FIELD_IS_PREFIX      = 1u << 1,
+    OBJECT_FIELD_CREATED        = 1u << 2,
+    OBJECT_FIELD_EXPIRES        = 1u << 3,
+    OBJECT_FIELD_CONTENT_LENGTH = 1u << 4,
+    OBJECT_FIELD_CUSTOM         = 1u << 5
+} ObjectField;
+
+/** Fields held in the nested `system` object */
+#define OBJECT_FIELDS_SYSTEM (OBJECT_FIELD_CREATED | OBJECT_FIELD_EXPIRES | OBJECT_FIELD_CONTENT_LENGTH)
+
+/** Every field; the full ObjectInfo shape */
+#define OBJECT_FIELDS_ALL 0x3Fu
+
+/**
+ * Conversion flag, combined with the field mask: `custom` becomes an
+ * accessor over a packed copy of the metadata, decoded into a plain
+ * object on first read (or replaced on first write). Applies to the full
+ * shape only; projections and objects without metadata convert `custom`
+ * eagerly as before. For listings and download info, where metadata is
+ * rarely read.
+ */
+#define OBJECT_CONVERT_LAZY_CUSTOM (1u << 6)
+
+struct AddonInstance;
+
+/**
+ * Property names of a converted object, valid in the current handle scope
+ */
+typedef struct {
+    napi_value key;
+    napi_value is_prefix;
+    napi_value system;
+    napi_value created;
+    napi_value expires;
+    napi_value content_length;
+    napi_value custom;
+    napi_value make_lazy;           /* builds an object with a lazy `custom`, or NULL */
+} ObjectKeys;
+
+/**
+ * Fetch the environment's cached property names, creating them on first
+ * use. If they cannot be cached, fresh strings are returned instead.
+ *
+ * Conversions of many objects should fetch the keys once and use
+ * uplink_object_to_js_keys().
+ *
+ * @param env       N-API environment
+ * @param[out] keys Receives the names
+ * @return 0 on success, -1 if the names could not be created at all
+ */
+int object_keys_get(napi_env env, ObjectKeys* keys);
+
+/**
+ * Release the cached property names; called from the instance finalizer
+ */
+void object_keys_cleanup(napi_env env, struct AddonInstance* instance);
+
 /**
  * Convert an UplinkObject to a JavaScript object.
  * 
@@ -32,26 +102,100 @@
 napi_value uplink_object_to_js(napi_env env, UplinkObject* object);
 
 /**
- * Free an array of UplinkCustomMetadataEntry up to @p count entries.
- * Frees each entry's key and value strings, then the array itself.
+ * Convert an UplinkObject to a JavaScript value holding only @p fields.
+ *
+ * Same shape as uplink_object_to_js(), minus unselected properties; the
+ * `system` object is omitted when no system field is selected. With
+ * fields == OBJECT_FIELD_KEY the result is the key as a plain string.
+ *
+ * @param env    N-API environment
+ * @param object Pointer to UplinkObject (may be NULL)
+ * @param fields Mask of ObjectField values, optionally with
+ *               OBJECT_CONVERT_LAZY_CUSTOM
+ * @return napi_value representing the projected object, or the key string
+ */
+napi_value uplink_object_to_js_fields(napi_env env, UplinkObject* object, uint32_t fields);
+
+/**
+ * uplink_object_to_js_fields() with names from object_keys_get()
+ *
+ * @param env    N-API environment
+ * @param keys   Property names fetched in the current handle scope
+ * @param object Pointer to UplinkObject (may be NULL)
+ * @param fields Mask of ObjectField values
+ * @return napi_value representing the projected object, or the key string
+ */
+napi_value uplink_object_to_js_keys(napi_env env, const ObjectKeys* keys,
+                                    UplinkObject* object, uint32_t fields);
+
+/**
+ * Parse a JS array of field names ('key', 'isPrefix', 'created',
+ * 'expires', 'contentLength', 'custom') into an ObjectField mask.
+ *
+ * @param env        N-API environment
+ * @param js_fields  JS array of strings
+ * @param[out] out_fields  Receives the mask
+ * @return 0 on success, -1 if not a non-empty array of known field names
+ */
+int parse_object_fields(napi_env env, napi_value js_fields, uint32_t* out_fields);
+
+/**
+ * Free an entry array built by extract_metadata_entries_from_js() or
+ * copy_metadata_entries(). The entries and their strings are one block.
  *
  * @param entries  Pointer to the entry array (may be NULL)
- * @param count    Number of entries to free
+ * @param count    Number of entries (unused, kept for the callers)
  */
 void free_metadata_entries(UplinkCustomMetadataEntry* entries, size_t count);
 
+/**
+ * Copy @p count metadata entries into a single block, with each key and
+ * value NUL-terminated.
+ *
+ * @return The copy, released with free_metadata_entries(), or NULL on OOM
+ */
+UplinkCustomMetadataEntry* copy_metadata_entries(const UplinkCustomMetadataEntry* entries, size_t count);
+
 /**
  * Extract an array of UplinkCustomMetadataEntry from a JS object whose
- * own-property values must all be strings.
+ * own-property values must all be strings, or from packed metadata.
+ *
+ * Packed metadata is a Buffer built by packMetadata() (src/native/metadata.ts):
+ * uint32 count, then count x { uint32 key_length, uint32 value_length },
+ * then each key and value in entry order, integers little-endian and
+ * strings UTF-8. It is parsed in one pass with no N-API call per entry.
  *
  * @param env           N-API environment
- * @param js_meta       JS object with string key-value pairs
- * @param[out] out_entries  Receives the malloc'd entry array (NULL when count is 0)
+ * @param js_meta       JS object with string key-value pairs, or a packed Buffer
+ * @param[out] out_entries  Receives the entry array (NULL when count is 0)
  * @param[out] out_count    Receives the number of entries
- * @return  0 on success, -1 if a value is not a string, -2 on OOM
+ * @return  0 on success, -1 if a value is not a string or the Buffer is
+ *          malformed, -2 on OOM
  */
 int extract_metadata_entries_from_js(napi_env env, napi_value js_meta,
                                      UplinkCustomMetadataEntry** out_entries,
                                      size_t* out_count);
 
+/**
+ * Deep-copy an UplinkObject (key and custom metadata) into memory owned
+ * by the caller, released with object_deep_free().
+ *
+ * @return 0 on success, -1 on OOM (@p dst is left empty)
+ */
+int object_deep_copy(UplinkObject* dst, const UplinkObject* src);
+
+/**
+ * Free the memory of a copy made by object_deep_copy() (not @p object itself)
+ */
+void object_deep_free(UplinkObject* object);
+
+/** Message for UPLINK_ERROR_COMPRESSED_OBJECT on paths that hand out raw bytes */
+#define OBJECT_COMPRESSED_MESSAGE "stored with a codec; read it with downloadObject()"
+
+/**
+ * Check whether @p object was uploaded with options.compress, i.e. its
+ * stored bytes are codec frames only downloadObject() knows how to decode
+ */
+bool object_is_compressed(const UplinkObject* object);
+
 #endif /* UPLINK_OBJECT_CONVERTER_H */
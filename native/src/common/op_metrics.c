@@ -0,0 +1,460 @@
+/**
+ * @file op_metrics.c
+ * @brief Per-operation latency histogram implementation
+ *
+ * Records are found by name through a small chained hash table and kept
+ * on a list in first-seen order for snapshots; they are never freed
+ * before the registry, so jobs in flight can hold on to their record.
+ * A reset only zeroes the counters. Gauges are read at snapshot time
+ * from the pool, the handle slabs and the pinned buffer counters, and
+ * the read-ahead decisions from the process-wide read-ahead totals.
+ */
+
+#include "op_metrics.h"
+#include "../download/download_readahead.h"
+#include "addon_instance.h"
+#include "handle_reaper.h"
+#include "thread_pool.h"
+#include "type_converters.h"
+
+#include <uv.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define NAME_MAX_LENGTH 48
+#define REGISTRY_BUCKETS 64         /* power of two */
+
+/* Exact buckets below 2^SUB_BITS, then 2^SUB_BITS per power of two up to 2^MAX_EXP ns (~2.4 h) */
+#define SUB_BITS 3
+#define SUB_COUNT (1 << SUB_BITS)
+#define MAX_EXP 43
+#define BUCKET_COUNT (SUB_COUNT + (MAX_EXP - SUB_BITS) * SUB_COUNT)
+
+typedef struct {
+    uint64_t count;
+    uint64_t sum_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t buckets[BUCKET_COUNT];
+} Histogram;
+
+struct OpMetrics {
+    char name[NAME_MAX_LENGTH];
+    uint32_t hash;
+    uint64_t calls;
+    uint64_t cancelled;             /* dequeued before they started */
+    uint64_t bytes;
+    Histogram queued;
+    Histogram execute;
+    Histogram complete;
+    struct OpMetrics* chain;        /* Next in hash bucket */
+    struct OpMetrics* next;         /* Next in first-seen order */
+};
+
+struct OpMetricsRegistry {
+    OpMetrics* buckets[REGISTRY_BUCKETS];
+    OpMetrics* head;
+    OpMetrics* tail;
+    OpMetrics* current;             /* record of the running complete callback */
+    uint64_t pinned_buffers;
+    uint64_t pinned_bytes;
+};
+
+/* ========== histogram ========== */
+
+static int floor_log2(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+static int bucket_index(uint64_t value) {
+    if (value < SUB_COUNT) {
+        return (int)value;
+    }
+    int exp = floor_log2(value);
+    if (exp >= MAX_EXP) {
+        return BUCKET_COUNT - 1;
+    }
+    int sub = (int)(value >> (exp - SUB_BITS)) - SUB_COUNT;
+    return SUB_COUNT + (exp - SUB_BITS) * SUB_COUNT + sub;
+}
+
+/** Exclusive upper bound of bucket @p index in ns */
+static uint64_t bucket_upper(int index) {
+    if (index < SUB_COUNT) {
+        return (uint64_t)index + 1;
+    }
+    int exp = (index - SUB_COUNT) / SUB_COUNT + SUB_BITS;
+    int sub = (index - SUB_COUNT) % SUB_COUNT;
+    return (uint64_t)(SUB_COUNT + sub + 1) << (exp - SUB_BITS);
+}
+
+static void histogram_record(Histogram* histogram, uint64_t value) {
+    if (histogram->count == 0 || value < histogram->min_ns) {
+        histogram->min_ns = value;
+    }
+    if (value > histogram->max_ns) {
+        histogram->max_ns = value;
+    }
+    histogram->count++;
+    histogram->sum_ns += value;
+    histogram->buckets[bucket_index(value)]++;
+}
+
+/** Value at quantile @p q, as the bound of its bucket clamped to [min, max] */
+static uint64_t histogram_quantile(const Histogram* histogram, double q) {
+    if (histogram->count == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(q * (double)histogram->count + 0.5);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            uint64_t value = bucket_upper(i) - 1;
+            if (value < histogram->min_ns) value = histogram->min_ns;
+            if (value > histogram->max_ns) value = histogram->max_ns;
+            return value;
+        }
+    }
+    return histogram->max_ns;
+}
+
+/* ========== registry ========== */
+
+static uint32_t name_hash(const char* name, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static OpMetricsRegistry* registry_of(napi_env env, int create) {
+    AddonInstance* instance = addon_instance(env);
+    if (instance == NULL) {
+        return NULL;
+    }
+    if (instance->op_metrics == NULL && create) {
+        instance->op_metrics = (OpMetricsRegistry*)calloc(1, sizeof(OpMetricsRegistry));
+    }
+    return instance->op_metrics;
+}
+
+static OpMetrics* find_or_add(OpMetricsRegistry* registry, const char* name, size_t length) {
+    uint32_t hash = name_hash(name, length);
+    OpMetrics** slot = &registry->buckets[hash & (REGISTRY_BUCKETS - 1)];
+    for (OpMetrics* metrics = *slot; metrics != NULL; metrics = metrics->chain) {
+        if (metrics->hash == hash && strcmp(metrics->name, name) == 0) {
+            return metrics;
+        }
+    }
+
+    OpMetrics* metrics = (OpMetrics*)calloc(1, sizeof(OpMetrics));
+    if (metrics == NULL) {
+        return NULL;
+    }
+    memcpy(metrics->name, name, length + 1);
+    metrics->hash = hash;
+    metrics->chain = *slot;
+    *slot = metrics;
+    if (registry->tail != NULL) {
+        registry->tail->next = metrics;
+    } else {
+        registry->head = metrics;
+    }
+    registry->tail = metrics;
+    return metrics;
+}
+
+/* ========== public API ========== */
+
+OpTimer op_metrics_start(napi_env env, napi_value name) {
+    OpTimer timer = { NULL, uv_hrtime() };
+    char buffer[NAME_MAX_LENGTH];
+    size_t length = 0;
+    if (name == NULL ||
+        napi_get_value_string_utf8(env, name, buffer, sizeof(buffer), &length) != napi_ok) {
+        return timer;
+    }
+    OpMetricsRegistry* registry = registry_of(env, 1);
+    if (registry != NULL) {
+        timer.metrics = find_or_add(registry, buffer, length);
+    }
+    return timer;
+}
+
+OpTimer op_metrics_start_named(napi_env env, const char* name) {
+    OpTimer timer = { NULL, uv_hrtime() };
+    size_t length = strlen(name);
+    OpMetricsRegistry* registry = length < NAME_MAX_LENGTH ? registry_of(env, 1) : NULL;
+    if (registry != NULL) {
+        timer.metrics = find_or_add(registry, name, length);
+    }
+    return timer;
+}
+
+void op_metrics_begin_complete(napi_env env, const OpTimer* timer) {
+    if (timer->metrics == NULL) {
+        return;
+    }
+    OpMetricsRegistry* registry = registry_of(env, 0);
+    if (registry != NULL) {
+        registry->current = timer->metrics;
+    }
+}
+
+void op_metrics_finish(napi_env env, const OpTimer* timer, uint64_t started_at,
+                       uint64_t finished_at, uint64_t complete_at) {
+    OpMetrics* metrics = timer->metrics;
+    if (metrics == NULL) {
+        return;
+    }
+    OpMetricsRegistry* registry = registry_of(env, 0);
+    if (registry != NULL) {
+        registry->current = NULL;
+    }
+
+    metrics->calls++;
+    if (started_at == 0) {
+        metrics->cancelled++;
+        histogram_record(&metrics->queued, complete_at - timer->queued_at);
+    } else {
+        histogram_record(&metrics->queued, started_at - timer->queued_at);
+        histogram_record(&metrics->execute, finished_at - started_at);
+    }
+    histogram_record(&metrics->complete, uv_hrtime() - complete_at);
+}
+
+void op_metrics_add_bytes(napi_env env, uint64_t bytes) {
+    OpMetricsRegistry* registry = registry_of(env, 0);
+    if (registry != NULL && registry->current != NULL) {
+        registry->current->bytes += bytes;
+    }
+}
+
+void op_metrics_record(napi_env env, const char* name, uint64_t ns) {
+    size_t length = strlen(name);
+    OpMetricsRegistry* registry = registry_of(env, 1);
+    if (registry == NULL || length >= NAME_MAX_LENGTH) {
+        return;
+    }
+    OpMetrics* metrics = find_or_add(registry, name, length);
+    if (metrics != NULL) {
+        metrics->calls++;
+        histogram_record(&metrics->execute, ns);
+    }
+}
+
+uint64_t op_metrics_quantile(napi_env env, const char* name, double q, uint64_t* count) {
+    *count = 0;
+    size_t length = strlen(name);
+    OpMetricsRegistry* registry = registry_of(env, 0);
+    if (registry == NULL || length >= NAME_MAX_LENGTH) {
+        return 0;
+    }
+    uint32_t hash = name_hash(name, length);
+    for (OpMetrics* metrics = registry->buckets[hash & (REGISTRY_BUCKETS - 1)]; metrics != NULL; metrics = metrics->chain) {
+        if (metrics->hash == hash && strcmp(metrics->name, name) == 0) {
+            *count = metrics->execute.count;
+            return histogram_quantile(&metrics->execute, q);
+        }
+    }
+    return 0;
+}
+
+void op_metrics_pin(napi_env env, int64_t bytes) {
+    OpMetricsRegistry* registry = registry_of(env, 1);
+    if (registry == NULL) {
+        return;
+    }
+    if (bytes >= 0) {
+        registry->pinned_buffers++;
+        registry->pinned_bytes += (uint64_t)bytes;
+    } else {
+        registry->pinned_buffers--;
+        registry->pinned_bytes -= (uint64_t)-bytes;
+    }
+}
+
+void op_metrics_destroy(OpMetricsRegistry* registry) {
+    OpMetrics* metrics = registry->head;
+    while (metrics != NULL) {
+        OpMetrics* next = metrics->next;
+        free(metrics);
+        metrics = next;
+    }
+    free(registry);
+}
+
+/* ========== napi_get_metrics ========== */
+
+static void set_double(napi_env env, napi_value object, const char* name, double number) {
+    napi_value value;
+    napi_create_double(env, number, &value);
+    napi_set_named_property(env, object, name, value);
+}
+
+static napi_value histogram_to_js(napi_env env, const Histogram* histogram, int with_buckets) {
+    napi_value result;
+    napi_create_object(env, &result);
+    set_double(env, result, "count", (double)histogram->count);
+    set_double(env, result, "sumMs", (double)histogram->sum_ns / 1e6);
+    set_double(env, result, "minMs", (double)histogram->min_ns / 1e6);
+    set_double(env, result, "maxMs", (double)histogram->max_ns / 1e6);
+    set_double(env, result, "p50Ms", (double)histogram_quantile(histogram, 0.5) / 1e6);
+    set_double(env, result, "p90Ms", (double)histogram_quantile(histogram, 0.9) / 1e6);
+    set_double(env, result, "p99Ms", (double)histogram_quantile(histogram, 0.99) / 1e6);
+    set_double(env, result, "p999Ms", (double)histogram_quantile(histogram, 0.999) / 1e6);
+    if (!with_buckets) {
+        return result;
+    }
+
+    /* Cumulative counts at each non-empty bucket, Prometheus "le" style */
+    napi_value buckets;
+    napi_create_array(env, &buckets);
+    uint32_t length = 0;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        if (histogram->buckets[i] == 0) {
+            continue;
+        }
+        seen += histogram->buckets[i];
+        napi_value pair, value;
+        napi_create_array_with_length(env, 2, &pair);
+        napi_create_double(env, (double)bucket_upper(i) / 1e6, &value);
+        napi_set_element(env, pair, 0, value);
+        napi_create_double(env, (double)seen, &value);
+        napi_set_element(env, pair, 1, value);
+        napi_set_element(env, buckets, length++, pair);
+    }
+    napi_set_named_property(env, result, "buckets", buckets);
+    return result;
+}
+
+static napi_value gauges_to_js(napi_env env, const OpMetricsRegistry* registry) {
+    static const char* const lane_keys[THREAD_POOL_LANE_COUNT] = {
+        [THREAD_POOL_LANE_METADATA] = "metadata",
+        [THREAD_POOL_LANE_BULK] = "bulk",
+    };
+    ThreadPoolGauges pool;
+    thread_pool_gauges(&pool);
+
+    napi_value result, lanes, handles;
+    napi_create_object(env, &result);
+    set_double(env, result, "threads", pool.threads);
+    set_double(env, result, "idleThreads", pool.idle_threads);
+    set_double(env, result, "completions", (double)pool.completions);
+    set_double(env, result, "completionWakeups", (double)pool.completion_wakeups);
+    napi_create_object(env, &lanes);
+    for (int i = 0; i < THREAD_POOL_LANE_COUNT; i++) {
+        napi_value lane;
+        napi_create_object(env, &lane);
+        set_double(env, lane, "queued", pool.lanes[i].queued);
+        set_double(env, lane, "running", pool.lanes[i].running);
+        set_double(env, lane, "budget", pool.lanes[i].budget);
+        napi_set_named_property(env, lanes, lane_keys[i], lane);
+    }
+    napi_set_named_property(env, result, "lanes", lanes);
+
+    set_double(env, result, "pinnedBuffers", registry != NULL ? (double)registry->pinned_buffers : 0);
+    set_double(env, result, "pinnedBytes", registry != NULL ? (double)registry->pinned_bytes : 0);
+
+    napi_create_object(env, &handles);
+    for (int type = 0; type < HANDLE_TYPE_COUNT; type++) {
+        const HandleSlab* slab = handle_slab(env, (HandleType)type);
+        napi_value entry;
+        napi_create_object(env, &entry);
+        set_double(env, entry, "open", slab != NULL ? slab->live : 0);
+        set_double(env, entry, "explicitCloses", slab != NULL ? (double)slab->explicit_closes : 0);
+        set_double(env, entry, "finalizerFrees", slab != NULL ? (double)slab->finalizer_frees : 0);
+        napi_set_named_property(env, handles, get_handle_type_key((HandleType)type), entry);
+    }
+    napi_set_named_property(env, result, "handles", handles);
+    set_double(env, result, "pendingFrees", (double)handle_reaper_pending());
+    return result;
+}
+
+napi_value read_ahead_stats_to_js(napi_env env) {
+    ReadAheadStats stats;
+    napi_value result;
+    if (read_ahead_stats(&stats) != 0) {
+        napi_get_null(env, &result);
+        return result;
+    }
+
+    napi_value value;
+    napi_create_object(env, &result);
+    napi_create_string_utf8(env, stats.policy, NAPI_AUTO_LENGTH, &value);
+    napi_set_named_property(env, result, "policy", value);
+    set_double(env, result, "sequentialOpens", (double)stats.sequential_opens);
+    set_double(env, result, "randomOpens", (double)stats.random_opens);
+    set_double(env, result, "seeks", (double)stats.seeks);
+    set_double(env, result, "readsServed", (double)stats.reads_served);
+    set_double(env, result, "bytesPrefetched", (double)stats.bytes_prefetched);
+    set_double(env, result, "windowGrowths", (double)stats.window_growths);
+    set_double(env, result, "objects", (double)stats.objects);
+    set_double(env, result, "initialWindow", (double)stats.initial_window);
+    set_double(env, result, "maxWindow", (double)stats.max_window);
+    return result;
+}
+
+napi_value napi_get_metrics(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1] = { NULL };
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+
+    napi_valuetype type = napi_undefined;
+    if (argc >= 1) {
+        napi_typeof(env, argv[0], &type);
+    }
+    if (type != napi_undefined && type != napi_object) {
+        napi_throw_type_error(env, NULL, "options must be an object");
+        return NULL;
+    }
+    int with_buckets = type == napi_object ? get_bool_property(env, argv[0], "buckets", 0) : 0;
+    int reset = type == napi_object ? get_bool_property(env, argv[0], "reset", 0) : 0;
+
+    napi_value result, operations;
+    napi_create_object(env, &result);
+    napi_create_object(env, &operations);
+    napi_set_named_property(env, result, "operations", operations);
+
+    OpMetricsRegistry* registry = registry_of(env, 0);
+    for (OpMetrics* metrics = registry != NULL ? registry->head : NULL; metrics != NULL; metrics = metrics->next) {
+        if (metrics->calls == 0) {
+            continue;
+        }
+        napi_value entry;
+        napi_create_object(env, &entry);
+        set_double(env, entry, "calls", (double)metrics->calls);
+        set_double(env, entry, "cancelled", (double)metrics->cancelled);
+        set_double(env, entry, "bytes", (double)metrics->bytes);
+        napi_set_named_property(env, entry, "queued", histogram_to_js(env, &metrics->queued, with_buckets));
+        napi_set_named_property(env, entry, "execute", histogram_to_js(env, &metrics->execute, with_buckets));
+        napi_set_named_property(env, entry, "complete", histogram_to_js(env, &metrics->complete, with_buckets));
+        napi_set_named_property(env, operations, metrics->name, entry);
+
+        if (reset) {
+            metrics->calls = 0;
+            metrics->cancelled = 0;
+            metrics->bytes = 0;
+            memset(&metrics->queued, 0, sizeof(Histogram));
+            memset(&metrics->execute, 0, sizeof(Histogram));
+            memset(&metrics->complete, 0, sizeof(Histogram));
+        }
+    }
+    napi_set_named_property(env, result, "gauges", gauges_to_js(env, registry));
+    napi_set_named_property(env, result, "readAhead", read_ahead_stats_to_js(env));
+    return result;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file op_metrics.h
+ * @brief Per-operation latency histograms for uplink-nodejs native module
+ *
+ * Every job run on the addon thread pool is timed under the async
+ * resource name it was queued with ("uploadWrite", "statObject", ...):
+ * time queued (including admission wait), time executing natively on a
+ * pool thread, and time spent in the complete callback on the main
+ * thread. Complete callbacks that move data report it with
+ * op_metrics_add_bytes().
+ *
+ * Histograms are HDR-style: exact below 8 ns, then 8 linear sub-buckets
+ * per power of two, so any recorded value is within 12.5% of its
+ * bucket's bound. Records live in the environment's AddonInstance and are
+ * only touched on its main thread; pool threads just stamp the job.
+ * Work on the libuv pool (a lane budget of 0, access and edge calls) is
+ * not timed.
+ *
+ * Snapshots also carry live gauges, so a saturated queue can be told
+ * apart from a slow satellite: pool threads and per-lane queued and
+ * running jobs, JS buffers pinned by work in flight, and open handles by
+ * type with counts of explicit closes versus finalizer-driven frees.
+ */
+
+#ifndef UPLINK_OP_METRICS_H
+#define UPLINK_OP_METRICS_H
+
+#include <node_api.h>
+#include <stdint.h>
+
+typedef struct OpMetrics OpMetrics;
+typedef struct OpMetricsRegistry OpMetricsRegistry;
+
+/**
+ * Start of one timed operation, taken when it is queued
+ */
+typedef struct {
+    OpMetrics* metrics;             /* NULL = not timed */
+    uint64_t queued_at;             /* uv_hrtime() value */
+} OpTimer;
+
+/**
+ * Begin timing an operation named by the JS string @p name (main thread)
+ *
+ * @return The timer; its metrics are NULL if @p name is not a string or
+ *         on OOM
+ */
+OpTimer op_metrics_start(napi_env env, napi_value name);
+
+/**
+ * Begin timing an operation named by the C string @p name (main thread)
+ *
+ * Same as op_metrics_start() without creating a JS string per call.
+ */
+OpTimer op_metrics_start_named(napi_env env, const char* name);
+
+/**
+ * Attribute op_metrics_add_bytes() calls to @p timer until
+ * op_metrics_finish() (main thread, before the complete callback)
+ */
+void op_metrics_begin_complete(napi_env env, const OpTimer* timer);
+
+/**
+ * Record a finished operation (main thread, after the complete callback)
+ *
+ * @param started_at When execution began, 0 if the job was cancelled
+ *                   before it started
+ * @param finished_at When execution ended
+ * @param complete_at When the complete callback began
+ */
+void op_metrics_finish(napi_env env, const OpTimer* timer, uint64_t started_at,
+                       uint64_t finished_at, uint64_t complete_at);
+
+/**
+ * Add @p bytes to the operation whose complete callback is running
+ * (no-op outside a timed complete callback)
+ */
+void op_metrics_add_bytes(napi_env env, uint64_t bytes);
+
+/**
+ * Record a latency sample that is not a queued job (main thread)
+ *
+ * The sample lands in the execute phase of the record named @p name, so
+ * it shows up in snapshots like an operation; used for the first-byte
+ * latencies that hedged downloads are timed against.
+ */
+void op_metrics_record(napi_env env, const char* name, uint64_t ns);
+
+/**
+ * Execute-phase latency of @p name at quantile @p q (main thread)
+ *
+ * @param[out] count Receives the number of samples behind the value
+ * @return The latency in ns, 0 when nothing was recorded
+ */
+uint64_t op_metrics_quantile(napi_env env, const char* name, double q, uint64_t* count);
+
+/**
+ * Adjust the pinned buffer gauge by @p bytes, positive when a work item
+ * pins a JS buffer and negative when it lets go (main thread)
+ */
+void op_metrics_pin(napi_env env, int64_t bytes);
+
+/**
+ * Free a registry; called from the instance finalizer
+ */
+void op_metrics_destroy(OpMetricsRegistry* registry);
+
+/**
+ * The read-ahead counters as { policy, sequentialOpens, randomOpens, seeks,
+ * readsServed, bytesPrefetched, windowGrowths, objects, initialWindow,
+ * maxWindow }, or null while read-ahead is disabled
+ */
+napi_value read_ahead_stats_to_js(napi_env env);
+
+/**
+ * N-API callback: snapshot the operation metrics of this environment
+ *
+ * Exported as native.getMetrics({ buckets?, reset? }) returning
+ * { operations: { [name]: { calls, cancelled, bytes, queued, execute, complete } },
+ *   gauges: { threads, idleThreads, lanes: { metadata, bulk }, pinnedBuffers,
+ *             pinnedBytes, handles: { [type]: { open, explicitCloses, finalizerFrees } } },
+ *   readAhead }
+ * where each phase is { count, sumMs, minMs, maxMs, p50Ms, p90Ms, p99Ms,
+ * p999Ms, buckets? }; buckets are cumulative [upperBoundMs, count] pairs,
+ * each lane is { queued, running, budget }, and readAhead is as from
+ * read_ahead_stats_to_js. reset clears the operation counters after the
+ * snapshot; gauges and read-ahead counters are never reset.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [options]
+ * @return The snapshot
+ */
+napi_value napi_get_metrics(napi_env env, napi_callback_info info);
+
+#endif /* UPLINK_OP_METRICS_H */
@@ -0,0 +1,134 @@
+/**
+ * @file part_tuner.c
+ * @brief Adaptive part size and concurrency implementation
+ *
+ * A window closes when as many parts have finished as are allowed in
+ * flight, so each window sees every slot turn over about once. A drop
+ * of more than PART_TUNER_NOISE against the previous window counts as
+ * worse; smaller changes keep the current direction, which lets the
+ * limit keep climbing on a link that is not yet saturated.
+ */
+
+#include "part_tuner.h"
+#include "logger.h"
+
+/** Relative goodput change treated as noise */
+#define PART_TUNER_NOISE 0.05
+
+/** Parts in flight before the first window */
+#define PART_TUNER_START_LIMIT 2
+
+int part_tuner_init(PartTuner* tuner, uint64_t start_size, uint32_t max_limit) {
+    uint64_t size = PART_TUNER_MIN_SIZE;
+    while (size * 2 <= start_size && size < PART_TUNER_MAX_SIZE) {
+        size *= 2;
+    }
+
+    tuner->part_size = size;
+    tuner->max_limit = max_limit > 0 ? max_limit : 1;
+    tuner->limit = tuner->max_limit < PART_TUNER_START_LIMIT ? tuner->max_limit : PART_TUNER_START_LIMIT;
+    tuner->in_flight = 0;
+    tuner->step = 1;
+    tuner->window_start = uv_hrtime();
+    tuner->window_bytes = 0;
+    tuner->window_busy_ns = 0;
+    tuner->window_parts = 0;
+    tuner->goodput = 0;
+
+    if (uv_mutex_init(&tuner->lock) != 0) {
+        return -1;
+    }
+    if (uv_cond_init(&tuner->slot_freed) != 0) {
+        uv_mutex_destroy(&tuner->lock);
+        return -1;
+    }
+    return 0;
+}
+
+void part_tuner_destroy(PartTuner* tuner) {
+    if (tuner == NULL) {
+        return;
+    }
+    uv_cond_destroy(&tuner->slot_freed);
+    uv_mutex_destroy(&tuner->lock);
+}
+
+uint64_t part_tuner_acquire(PartTuner* tuner) {
+    if (tuner == NULL) {
+        return 0;
+    }
+    uv_mutex_lock(&tuner->lock);
+    while (tuner->in_flight >= tuner->limit) {
+        uv_cond_wait(&tuner->slot_freed, &tuner->lock);
+    }
+    tuner->in_flight++;
+    uint64_t size = tuner->part_size;
+    uv_mutex_unlock(&tuner->lock);
+    return size;
+}
+
+/**
+ * Close the current window and pick the next limit and part size
+ * (called with the lock held)
+ */
+static void part_tuner_adjust(PartTuner* tuner, uint64_t now) {
+    uint64_t elapsed = now - tuner->window_start;
+    double goodput = elapsed > 0 ? (double)tuner->window_bytes * 1e9 / (double)elapsed : 0;
+    uint64_t mean_latency = tuner->window_busy_ns / tuner->window_parts;
+
+    if (tuner->goodput > 0 && goodput < tuner->goodput * (1.0 - PART_TUNER_NOISE)) {
+        tuner->step = -tuner->step;
+    }
+    int64_t limit = (int64_t)tuner->limit + tuner->step;
+    if (limit < 1 || limit > (int64_t)tuner->max_limit) {
+        tuner->step = -tuner->step;
+    } else {
+        tuner->limit = (uint32_t)limit;
+    }
+
+    if (mean_latency < PART_TUNER_FAST_NS && tuner->part_size < PART_TUNER_MAX_SIZE) {
+        tuner->part_size *= 2;
+    } else if (mean_latency > PART_TUNER_SLOW_NS && tuner->part_size > PART_TUNER_MIN_SIZE) {
+        tuner->part_size /= 2;
+    }
+
+    LOG_DEBUG("part_tuner: %.1f MiB/s over %u parts (mean %llu ms) -> limit=%u, partSize=%llu",
+              goodput / (1024 * 1024), tuner->window_parts,
+              (unsigned long long)(mean_latency / 1000000), tuner->limit,
+              (unsigned long long)tuner->part_size);
+
+    tuner->goodput = goodput;
+    tuner->window_start = now;
+    tuner->window_bytes = 0;
+    tuner->window_busy_ns = 0;
+    tuner->window_parts = 0;
+}
+
+void part_tuner_finish(PartTuner* tuner, uint64_t bytes, uint64_t elapsed_ns) {
+    if (tuner == NULL) {
+        return;
+    }
+    uv_mutex_lock(&tuner->lock);
+    tuner->in_flight--;
+    if (bytes > 0) {
+        tuner->window_bytes += bytes;
+        tuner->window_busy_ns += elapsed_ns;
+        tuner->window_parts++;
+        if (tuner->window_parts >= tuner->limit) {
+            part_tuner_adjust(tuner, uv_hrtime());
+        }
+    }
+    uv_cond_broadcast(&tuner->slot_freed);
+    uv_mutex_unlock(&tuner->lock);
+}
+
+void part_tuner_result(PartTuner* tuner, uint64_t* part_size, uint32_t* concurrency, double* goodput) {
+    if (tuner == NULL) {
+        return;
+    }
+    uv_mutex_lock(&tuner->lock);
+    *part_size = tuner->part_size;
+    *concurrency = tuner->limit;
+    *goodput = tuner->goodput;
+    uv_mutex_unlock(&tuner->lock);
+}
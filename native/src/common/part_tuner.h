@@ -0,0 +1,95 @@
+/**
+ * @file part_tuner.h
+ * @brief Adaptive part size and concurrency for the parallel transfer engines
+ *
+ * With `auto` set, uploadParallel and downloadParallel stop splitting the
+ * transfer into equal parts up front. Each worker instead asks the tuner
+ * for a slot before claiming its next part and reports the part's bytes
+ * and latency when it is done. Once per window (as many parts as are
+ * allowed in flight) the tuner compares goodput with the previous window
+ * and hill-climbs the in-flight limit: keep stepping while goodput
+ * improves, reverse when it drops. Part size follows part latency:
+ * doubled while parts finish faster than PART_TUNER_FAST_NS (per-part
+ * overhead dominates), halved while they take longer than
+ * PART_TUNER_SLOW_NS (a retry would cost too much). Sizes stay powers of
+ * two between 8 and 256 MiB, so every part is a whole number of Storj
+ * segments or an even fraction of one.
+ *
+ * All functions are safe from any thread and are no-ops on a NULL tuner,
+ * for which part_tuner_acquire() returns 0.
+ */
+
+#ifndef UPLINK_PART_TUNER_H
+#define UPLINK_PART_TUNER_H
+
+#include <uv.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Smallest part size the tuner will choose */
+#define PART_TUNER_MIN_SIZE (8ULL * 1024 * 1024)
+
+/** Largest part size the tuner will choose */
+#define PART_TUNER_MAX_SIZE (256ULL * 1024 * 1024)
+
+/** Ceiling on parts in flight when auto mode is on and no concurrency is given */
+#define PART_TUNER_DEFAULT_MAX_ACTIVE 16
+
+/** Mean part latency below which the part size is doubled */
+#define PART_TUNER_FAST_NS (2ULL * 1000 * 1000 * 1000)
+
+/** Mean part latency above which the part size is halved */
+#define PART_TUNER_SLOW_NS (30ULL * 1000 * 1000 * 1000)
+
+typedef struct {
+    uv_mutex_t lock;
+    uv_cond_t slot_freed;
+    uint64_t part_size;         /* Size handed out with the next slot */
+    uint32_t limit;             /* Parts allowed in flight */
+    uint32_t max_limit;
+    uint32_t in_flight;
+    int32_t step;               /* Direction of the last limit change, +1 or -1 */
+    uint64_t window_start;      /* uv_hrtime() when the window opened */
+    uint64_t window_bytes;
+    uint64_t window_busy_ns;    /* Summed part latency in the window */
+    uint32_t window_parts;
+    double goodput;             /* Bytes per second of the last closed window, 0 before one */
+} PartTuner;
+
+/**
+ * Start tuning from @p start_size (clamped to the tuner's bounds) with up
+ * to @p max_limit parts in flight
+ *
+ * @return 0 on success, -1 if the lock could not be created
+ */
+int part_tuner_init(PartTuner* tuner, uint64_t start_size, uint32_t max_limit);
+
+/**
+ * Release the tuner's lock (after every worker has finished)
+ */
+void part_tuner_destroy(PartTuner* tuner);
+
+/**
+ * Wait for an in-flight slot
+ *
+ * Every call must be paired with part_tuner_finish(), also when the
+ * worker then finds no part left to claim.
+ *
+ * @return The part size to use for the part claimed with this slot
+ */
+uint64_t part_tuner_acquire(PartTuner* tuner);
+
+/**
+ * Give back a slot, reporting the part it carried
+ *
+ * @param bytes Bytes moved by the part, 0 when it failed or was never claimed
+ * @param elapsed_ns Time from claim to commit, including retries
+ */
+void part_tuner_finish(PartTuner* tuner, uint64_t bytes, uint64_t elapsed_ns);
+
+/**
+ * Read the parameters the tuner settled on
+ */
+void part_tuner_result(PartTuner* tuner, uint64_t* part_size, uint32_t* concurrency, double* goodput);
+
+#endif /* UPLINK_PART_TUNER_H */
@@ -0,0 +1,218 @@
+/**
+ * @file progress.c
+ * @brief Coalesced transfer progress callbacks implementation
+ *
+ * Counts are kept under a mutex and an update is posted, still under
+ * it, whenever the interval or byte step has passed; posting under the
+ * lock keeps updates from several worker threads in order. Each update
+ * is a heap snapshot owned by the threadsafe function call.
+ *
+ * The reporter is the threadsafe function's context and is freed by its
+ * finalizer, so calls still queued after release find it closed and
+ * drop their snapshot instead of reporting after the final state.
+ */
+
+#include "progress.h"
+#include "type_converters.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+typedef struct {
+    int64_t bytes;
+    int64_t total;
+    double rate;
+} ProgressSnapshot;
+
+struct ProgressReporter {
+    napi_threadsafe_function tsfn;
+    napi_ref callback;              /* for the final call from the completion */
+    const char* name;
+    uv_mutex_t lock;                /* guards the counters below */
+    uint64_t interval_ns;
+    uint64_t step_bytes;            /* 0 = by time only */
+    int64_t total;                  /* -1 until known */
+    int64_t bytes;
+    int64_t posted_bytes;           /* bytes at the last update */
+    uint64_t posted_at;             /* uv_hrtime() of the last update, or of creation */
+    bool closed;                    /* main thread only, like the two below */
+    bool delivered;
+    int64_t delivered_bytes;
+};
+
+/** Snapshot the counters; call with the lock held */
+static void snapshot_locked(ProgressReporter* reporter, uint64_t now, ProgressSnapshot* snapshot) {
+    uint64_t elapsed = now - reporter->posted_at;
+    snapshot->bytes = reporter->bytes;
+    snapshot->total = reporter->total;
+    snapshot->rate = elapsed > 0 ? (double)(reporter->bytes - reporter->posted_bytes) * 1e9 / (double)elapsed : 0;
+}
+
+static void progress_call(napi_env env, ProgressReporter* reporter, napi_value callback,
+                          const ProgressSnapshot* snapshot) {
+    napi_value obj, value, undefined;
+    napi_create_object(env, &obj);
+    napi_create_double(env, (double)snapshot->bytes, &value);
+    napi_set_named_property(env, obj, "bytesTransferred", value);
+    napi_create_double(env, (double)snapshot->total, &value);
+    napi_set_named_property(env, obj, "totalBytes", value);
+    napi_create_double(env, snapshot->rate, &value);
+    napi_set_named_property(env, obj, "bytesPerSecond", value);
+    napi_get_undefined(env, &undefined);
+    if (napi_call_function(env, undefined, callback, 1, &obj, NULL) != napi_ok) {
+        /* A throwing listener must not fail the transfer */
+        napi_value exception;
+        napi_get_and_clear_last_exception(env, &exception);
+        LOG_WARN("%s: onProgress threw", reporter->name);
+    }
+    reporter->delivered = true;
+    reporter->delivered_bytes = snapshot->bytes;
+}
+
+static void progress_js(napi_env env, napi_value js_callback, void* context, void* data) {
+    ProgressReporter* reporter = (ProgressReporter*)context;
+    ProgressSnapshot* snapshot = (ProgressSnapshot*)data;
+    
+    /* env is NULL when the function is being torn down */
+    if (env != NULL && js_callback != NULL && !reporter->closed) {
+        progress_call(env, reporter, js_callback, snapshot);
+    }
+    free(snapshot);
+}
+
+static void progress_finalize(napi_env env, void* finalize_data, void* hint) {
+    (void)hint;
+    ProgressReporter* reporter = (ProgressReporter*)finalize_data;
+    napi_delete_reference(env, reporter->callback);
+    uv_mutex_destroy(&reporter->lock);
+    free(reporter);
+}
+
+/** Post the current state; call with the lock held */
+static void post_locked(ProgressReporter* reporter, uint64_t now) {
+    ProgressSnapshot* snapshot = (ProgressSnapshot*)malloc(sizeof(ProgressSnapshot));
+    if (snapshot == NULL) return;
+    
+    snapshot_locked(reporter, now, snapshot);
+    if (napi_call_threadsafe_function(reporter->tsfn, snapshot, napi_tsfn_nonblocking) != napi_ok) {
+        free(snapshot);
+        return;
+    }
+    reporter->posted_bytes = reporter->bytes;
+    reporter->posted_at = now;
+}
+
+int progress_reporter_from_options(napi_env env, napi_value options, const char* name, ProgressReporter** out) {
+    *out = NULL;
+    napi_valuetype type = napi_undefined;
+    if (options != NULL) {
+        napi_typeof(env, options, &type);
+    }
+    if (type != napi_object) {
+        return 0;
+    }
+    
+    napi_value callback;
+    if (napi_get_named_property(env, options, "onProgress", &callback) != napi_ok) {
+        return 0;
+    }
+    napi_typeof(env, callback, &type);
+    if (type == napi_undefined) {
+        return 0;
+    }
+    if (type != napi_function) {
+        napi_throw_type_error(env, NULL, "onProgress must be a function");
+        return -1;
+    }
+    
+    int64_t interval_ms = get_int64_property(env, options, "progressIntervalMs", PROGRESS_DEFAULT_INTERVAL_MS);
+    int64_t step_bytes = get_int64_property(env, options, "progressBytes", 0);
+    if (interval_ms < 0 || step_bytes < 0) {
+        napi_throw_range_error(env, NULL, "progressIntervalMs and progressBytes must not be negative");
+        return -1;
+    }
+    
+    ProgressReporter* reporter = (ProgressReporter*)calloc(1, sizeof(ProgressReporter));
+    if (reporter == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return -1;
+    }
+    napi_value resource_name;
+    napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &resource_name);
+    if (napi_create_reference(env, callback, 1, &reporter->callback) != napi_ok) {
+        free(reporter);
+        napi_throw_error(env, NULL, "Failed to create progress callback");
+        return -1;
+    }
+    if (napi_create_threadsafe_function(env, callback, NULL, resource_name, 0, 1, reporter, progress_finalize,
+                                        reporter, progress_js, &reporter->tsfn) != napi_ok) {
+        napi_delete_reference(env, reporter->callback);
+        free(reporter);
+        napi_throw_error(env, NULL, "Failed to create progress callback");
+        return -1;
+    }
+    uv_mutex_init(&reporter->lock);
+    reporter->name = name;
+    reporter->interval_ns = (uint64_t)interval_ms * 1000000u;
+    reporter->step_bytes = (uint64_t)step_bytes;
+    reporter->total = -1;
+    reporter->posted_at = uv_hrtime();
+    *out = reporter;
+    return 0;
+}
+
+void progress_set_total(ProgressReporter* reporter, uint64_t total) {
+    if (reporter == NULL) return;
+    uv_mutex_lock(&reporter->lock);
+    reporter->total = (int64_t)total;
+    uv_mutex_unlock(&reporter->lock);
+}
+
+void progress_add(ProgressReporter* reporter, int64_t delta) {
+    if (reporter == NULL || delta == 0) return;
+    
+    uv_mutex_lock(&reporter->lock);
+    reporter->bytes += delta;
+    uint64_t now = uv_hrtime();
+    int64_t moved = reporter->bytes - reporter->posted_bytes;
+    bool due = now - reporter->posted_at >= reporter->interval_ns ||
+               (reporter->step_bytes > 0 && moved >= (int64_t)reporter->step_bytes);
+    if (due) {
+        post_locked(reporter, now);
+    }
+    uv_mutex_unlock(&reporter->lock);
+}
+
+size_t progress_slice(ProgressReporter* reporter, size_t want) {
+    if (reporter == NULL || want <= PROGRESS_SLICE_BYTES) {
+        return want;
+    }
+    return PROGRESS_SLICE_BYTES;
+}
+
+void progress_reporter_discard(ProgressReporter* reporter) {
+    if (reporter == NULL) return;
+    reporter->closed = true;
+    napi_release_threadsafe_function(reporter->tsfn, napi_tsfn_release);
+}
+
+void progress_reporter_release(napi_env env, ProgressReporter* reporter) {
+    if (reporter == NULL) return;
+    
+    /* Workers are done by now; the lock only pairs with their last writes */
+    ProgressSnapshot snapshot;
+    uv_mutex_lock(&reporter->lock);
+    snapshot_locked(reporter, uv_hrtime(), &snapshot);
+    uv_mutex_unlock(&reporter->lock);
+    
+    reporter->closed = true;
+    if (!reporter->delivered || reporter->delivered_bytes != snapshot.bytes) {
+        napi_value callback;
+        if (napi_get_reference_value(env, reporter->callback, &callback) == napi_ok && callback != NULL) {
+            progress_call(env, reporter, callback, &snapshot);
+        }
+    }
+    napi_release_threadsafe_function(reporter->tsfn, napi_tsfn_release);
+}
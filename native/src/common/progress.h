@@ -0,0 +1,77 @@
+/**
+ * @file progress.h
+ * @brief Coalesced transfer progress callbacks for uplink-nodejs native module
+ *
+ * Transfer engines count bytes as they move them; the reporter turns
+ * those counts into at most one onProgress call every progressIntervalMs
+ * (or every progressBytes bytes, when set) through a threadsafe
+ * function, so a large transfer costs a handful of JS calls rather than
+ * one per chunk. The end state is delivered by progress_reporter_release()
+ * from the completion, so the last call always lands before the promise
+ * settles; updates still queued at that point are dropped.
+ *
+ * JS receives { bytesTransferred, totalBytes, bytesPerSecond }, where
+ * totalBytes is -1 until known and bytesPerSecond is the rate since the
+ * previous call. Counting is safe from any thread; creation and release
+ * are main thread only.
+ */
+
+#ifndef UPLINK_PROGRESS_H
+#define UPLINK_PROGRESS_H
+
+#include <node_api.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Default minimum time between two onProgress calls */
+#define PROGRESS_DEFAULT_INTERVAL_MS 100
+
+/** Largest single read or write while a reporter is attached */
+#define PROGRESS_SLICE_BYTES (1024 * 1024)
+
+typedef struct ProgressReporter ProgressReporter;
+
+/**
+ * Create a reporter from options.onProgress, progressIntervalMs and progressBytes
+ *
+ * @param env N-API environment
+ * @param options Options object (NULL or non-objects yield no reporter)
+ * @param name Operation name (a string literal), used for the threadsafe function and logs
+ * @param out Receives the reporter, or NULL when no onProgress was given
+ * @return 0 on success, -1 with a JS exception pending
+ */
+int progress_reporter_from_options(napi_env env, napi_value options, const char* name, ProgressReporter** out);
+
+/**
+ * Set the number of bytes the transfer will move (any thread; NULL is a no-op)
+ */
+void progress_set_total(ProgressReporter* reporter, uint64_t total);
+
+/**
+ * Count @p delta bytes, posting an update when one is due (any thread)
+ *
+ * A negative delta takes back bytes of an attempt that is retried.
+ */
+void progress_add(ProgressReporter* reporter, int64_t delta);
+
+/**
+ * Clamp a read or write of @p want bytes to PROGRESS_SLICE_BYTES when a
+ * reporter is attached; without one the size is left as is
+ */
+size_t progress_slice(ProgressReporter* reporter, size_t want);
+
+/**
+ * Release a reporter whose call failed before it was queued, without a
+ * final call (main thread). NULL is a no-op.
+ */
+void progress_reporter_discard(ProgressReporter* reporter);
+
+/**
+ * Deliver the end state and release the reporter (main thread)
+ *
+ * Call from the completion before the promise is settled. The reporter
+ * is freed once the threadsafe function drains. NULL is a no-op.
+ */
+void progress_reporter_release(napi_env env, ProgressReporter* reporter);
+
+#endif /* UPLINK_PROGRESS_H */
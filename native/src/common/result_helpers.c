@@ -34,6 +34,8 @@ static const ErrorNameEntry ERROR_NAMES[] = {
     { UPLINK_ERROR_OBJECT_KEY_INVALID,    "ObjectKeyInvalidError" },
     { UPLINK_ERROR_OBJECT_NOT_FOUND,      "ObjectNotFoundError" },
     { UPLINK_ERROR_UPLOAD_DONE,           "UploadDoneError" },
+    { UPLINK_ERROR_TIMEOUT,               "TimeoutError" },
+    { UPLINK_ERROR_INTEGRITY,             "IntegrityError" },
 };
 
 static const size_t ERROR_NAMES_COUNT = sizeof(ERROR_NAMES) / sizeof(ERROR_NAMES[0]);
@@ -118,6 +120,34 @@ napi_value create_resolved_promise(napi_env env, napi_value value) {
     return promise;
 }
 
+napi_status extract_callback(napi_env env, napi_value value, napi_ref* callback) {
+    napi_valuetype type;
+    napi_status status = napi_typeof(env, value, &type);
+    if (status != napi_ok) {
+        return status;
+    }
+    if (type != napi_function) {
+        return napi_function_expected;
+    }
+    return napi_create_reference(env, value, 1, callback);
+}
+
+void invoke_callback(napi_env env, napi_ref callback, size_t argc, const napi_value* argv) {
+    napi_value function, receiver;
+    napi_get_reference_value(env, callback, &function);
+    napi_delete_reference(env, callback);
+    napi_get_undefined(env, &receiver);
+    napi_call_function(env, receiver, function, argc, argv, NULL);
+}
+
+void settle_error(napi_env env, napi_deferred deferred, napi_ref callback, napi_value error) {
+    if (callback != NULL) {
+        invoke_callback(env, callback, 1, &error);
+    } else if (deferred != NULL) {
+        napi_reject_deferred(env, deferred, error);
+    }
+}
+
 napi_value throw_error(napi_env env, const char* message) {
     LOG_ERROR("Throwing error: %s", message);
     napi_throw_error(env, NULL, message);
@@ -29,6 +29,11 @@
 #define UPLINK_ERROR_OBJECT_NOT_FOUND       0x21
 #define UPLINK_ERROR_UPLOAD_DONE            0x22
 
+/* Error codes raised by the binding itself */
+#define UPLINK_ERROR_TIMEOUT                0x40
+#define UPLINK_ERROR_INTEGRITY              0x41
+#define UPLINK_ERROR_COMPRESSED_OBJECT      0x42
+
 /**
  * Simplified UplinkError structure for use in helpers
  */
@@ -74,6 +79,30 @@ napi_value create_rejected_promise(napi_env env, const char* message);
  */
 napi_value create_resolved_promise(napi_env env, napi_value value);
 
+/**
+ * Extract a callback argument for a callback-style call
+ *
+ * @param[out] callback Receives a reference released by invoke_callback()
+ * @return napi_ok, or napi_function_expected when @p value is not a function
+ */
+napi_status extract_callback(napi_env env, napi_value value, napi_ref* callback);
+
+/**
+ * Call a callback-style op's callback with @p argc arguments and release
+ * it (main thread)
+ *
+ * The callback gets no receiver. When it throws, the exception is left
+ * pending for the caller's environment to report as uncaught.
+ */
+void invoke_callback(napi_env env, napi_ref callback, size_t argc, const napi_value* argv);
+
+/**
+ * Settle an op that failed, by rejecting @p deferred or, when @p callback
+ * is set, calling it with (error); a no-op when both are NULL because
+ * the op was already settled
+ */
+void settle_error(napi_env env, napi_deferred deferred, napi_ref callback, napi_value error);
+
 /**
  * Get error code name
  * 
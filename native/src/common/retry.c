@@ -0,0 +1,172 @@
+/**
+ * @file retry.c
+ * @brief Per-call retry policy implementation
+ *
+ * Backoff sleeps in short slices so an aborted cancel token ends the wait
+ * promptly. Jitter comes from a per-thread xorshift generator seeded from
+ * the clock and the thread's stack, which is plenty for spreading retries.
+ */
+
+#include "retry.h"
+#include "error_registry.h"
+#include "result_helpers.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <string.h>
+
+/** Longest single sleep, so cancellation is seen */
+#define RETRY_POLL_MS 50
+
+/** Longest error class name read from options.retry.retryOn */
+#define RETRY_CLASS_NAME_MAX 64
+
+#if defined(_MSC_VER)
+#define RETRY_THREAD_LOCAL __declspec(thread)
+#else
+#define RETRY_THREAD_LOCAL _Thread_local
+#endif
+
+static RETRY_THREAD_LOCAL uint64_t jitter_state;
+
+static void policy_add_code(RetryPolicy* policy, int32_t code) {
+    if (code >= 0 && code < 256) {
+        policy->codes[code >> 6] |= 1ULL << (code & 63);
+    }
+}
+
+static bool policy_has_code(const RetryPolicy* policy, int32_t code) {
+    return code >= 0 && code < 256 && (policy->codes[code >> 6] & (1ULL << (code & 63))) != 0;
+}
+
+/** Uniform value in [0, bound] */
+static uint64_t jitter(uint64_t bound) {
+    if (jitter_state == 0) {
+        jitter_state = uv_hrtime() ^ (uint64_t)(uintptr_t)&bound ^ 0x9e3779b97f4a7c15ULL;
+    }
+    jitter_state ^= jitter_state << 13;
+    jitter_state ^= jitter_state >> 7;
+    jitter_state ^= jitter_state << 17;
+    return jitter_state % (bound + 1);
+}
+
+/** Longest wait (ms) after attempt @p attempt (1-based): base doubled per attempt, up to the max */
+static uint64_t backoff_cap(const RetryPolicy* policy, uint32_t attempt) {
+    uint64_t cap = (uint64_t)policy->base_delay_ms << (attempt - 1 < 20 ? attempt - 1 : 20);
+    return cap < policy->max_delay_ms ? cap : policy->max_delay_ms;
+}
+
+/** Read a non-negative integer property, keeping @p value when absent */
+static int get_count(napi_env env, napi_value object, const char* name, uint32_t limit, uint32_t* value) {
+    napi_value property;
+    napi_valuetype type;
+    if (napi_get_named_property(env, object, name, &property) != napi_ok ||
+        napi_typeof(env, property, &type) != napi_ok || type == napi_undefined) {
+        return 0;
+    }
+    double number;
+    if (type != napi_number || napi_get_value_double(env, property, &number) != napi_ok ||
+        !(number >= 0 && number <= limit) || number != (double)(uint32_t)number) {
+        return -1;
+    }
+    *value = (uint32_t)number;
+    return 0;
+}
+
+/** Read options.retry.retryOn into @p policy */
+static int read_retry_on(napi_env env, napi_value retry_on, RetryPolicy* policy) {
+    bool is_array = false;
+    uint32_t length = 0;
+    if (napi_is_array(env, retry_on, &is_array) != napi_ok || !is_array ||
+        napi_get_array_length(env, retry_on, &length) != napi_ok) {
+        throw_type_error(env, "retry.retryOn must be an array of error class names");
+        return -1;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element;
+        char name[RETRY_CLASS_NAME_MAX];
+        size_t name_length = 0;
+        int32_t code = -1;
+        if (napi_get_element(env, retry_on, i, &element) == napi_ok &&
+            napi_get_value_string_utf8(env, element, name, sizeof(name), &name_length) == napi_ok) {
+            code = error_code_by_class_name(name);
+        }
+        if (code < 0) {
+            throw_type_error(env, "retry.retryOn must be an array of error class names");
+            return -1;
+        }
+        policy_add_code(policy, code);
+    }
+    return 0;
+}
+
+/* ========== public API ========== */
+
+int retry_policy_option(napi_env env, napi_value options, RetryPolicy* policy) {
+    memset(policy, 0, sizeof(*policy));
+    if (options == NULL) {
+        return 0;
+    }
+    napi_value retry;
+    napi_valuetype type;
+    if (napi_get_named_property(env, options, "retry", &retry) != napi_ok ||
+        napi_typeof(env, retry, &type) != napi_ok || type == napi_undefined || type == napi_null) {
+        return 0;
+    }
+    if (type == napi_boolean) {
+        bool enabled = false;
+        napi_get_value_bool(env, retry, &enabled);
+        if (!enabled) {
+            return 0;
+        }
+    } else if (type != napi_object) {
+        throw_type_error(env, "retry must be a boolean or an object");
+        return -1;
+    }
+
+    policy->max_attempts = RETRY_DEFAULT_ATTEMPTS;
+    policy->base_delay_ms = RETRY_DEFAULT_BASE_DELAY_MS;
+    policy->max_delay_ms = RETRY_DEFAULT_MAX_DELAY_MS;
+    napi_value retry_on = NULL;
+    napi_valuetype retry_on_type = napi_undefined;
+    if (type == napi_object) {
+        if (get_count(env, retry, "attempts", RETRY_MAX_ATTEMPTS, &policy->max_attempts) != 0 ||
+            policy->max_attempts == 0) {
+            throw_type_error(env, "retry.attempts must be an integer from 1 to 20");
+            return -1;
+        }
+        if (get_count(env, retry, "baseDelayMs", UINT32_MAX, &policy->base_delay_ms) != 0 ||
+            get_count(env, retry, "maxDelayMs", UINT32_MAX, &policy->max_delay_ms) != 0) {
+            throw_type_error(env, "retry.baseDelayMs and retry.maxDelayMs must be non-negative integers");
+            return -1;
+        }
+        napi_get_named_property(env, retry, "retryOn", &retry_on);
+        napi_typeof(env, retry_on, &retry_on_type);
+    }
+    if (retry_on_type != napi_undefined) {
+        return read_retry_on(env, retry_on, policy);
+    }
+    policy_add_code(policy, UPLINK_ERROR_INTERNAL);
+    policy_add_code(policy, UPLINK_ERROR_TOO_MANY_REQUESTS);
+    return 0;
+}
+
+bool retry_backoff(const RetryPolicy* policy, uint32_t attempt, int32_t code, CancelToken* cancel, const char* name) {
+    if (attempt >= policy->max_attempts || !policy_has_code(policy, code) || cancel_token_is_cancelled(cancel)) {
+        return false;
+    }
+
+    uint64_t delay_ms = jitter(backoff_cap(policy, attempt));
+    LOG_WARN("%s: retrying (attempt %u/%u) in %llu ms after error 0x%02x",
+             name, attempt + 1, policy->max_attempts, (unsigned long long)delay_ms, code);
+
+    while (delay_ms > 0) {
+        if (cancel_token_is_cancelled(cancel)) {
+            return false;
+        }
+        uint64_t slice = delay_ms < RETRY_POLL_MS ? delay_ms : RETRY_POLL_MS;
+        uv_sleep((unsigned int)slice);
+        delay_ms -= slice;
+    }
+    return !cancel_token_is_cancelled(cancel);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file retry.h
+ * @brief Per-call retry policy for idempotent operations
+ *
+ * Idempotent operations (stats, download opens, getObject, part uploads)
+ * take options.retry and retry transient failures inside their execute
+ * callback, so a dial timeout or a node error does not cost a round trip
+ * through JS with the arguments marshalled again. Attempts are spaced by
+ * exponential backoff with full jitter, so callers that failed together
+ * do not retry together.
+ */
+
+#ifndef UPLINK_RETRY_H
+#define UPLINK_RETRY_H
+
+#include <node_api.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "cancel_token.h"
+
+/** Default attempts, including the first, when options.retry is given */
+#define RETRY_DEFAULT_ATTEMPTS 3
+
+/** Default delay cap of the first retry (ms), doubled per attempt */
+#define RETRY_DEFAULT_BASE_DELAY_MS 100
+
+/** Default delay cap of any retry (ms) */
+#define RETRY_DEFAULT_MAX_DELAY_MS 2000
+
+/** Upper bound accepted for options.retry.attempts */
+#define RETRY_MAX_ATTEMPTS 20
+
+/**
+ * Retry policy of one call; zeroed = no retries
+ */
+typedef struct {
+    uint32_t max_attempts;          /* Attempts including the first; 0 or 1 = no retries */
+    uint32_t base_delay_ms;
+    uint32_t max_delay_ms;
+    uint64_t codes[4];              /* Bit set of retryable error codes below 256 */
+} RetryPolicy;
+
+/**
+ * Read options.retry (main thread)
+ *
+ * options.retry is true or { attempts?, baseDelayMs?, maxDelayMs?, retryOn? }
+ * where retryOn lists error class names; by default InternalError (dial
+ * and node failures surface as internal errors) and TooManyRequestsError
+ * are retried.
+ *
+ * @param[out] policy Receives the policy, zeroed when options.retry is absent
+ * @return 0 on success, -1 with an exception pending
+ */
+int retry_policy_option(napi_env env, napi_value options, RetryPolicy* policy);
+
+/**
+ * After attempt number @p attempt (1-based) failed with @p code, decide
+ * whether to try again and sleep out the backoff if so (worker thread)
+ *
+ * @param name Operation name for the log
+ * @param cancel Stops the wait when aborted, or NULL
+ * @return true to make another attempt
+ */
+bool retry_backoff(const RetryPolicy* policy, uint32_t attempt, int32_t code, CancelToken* cancel, const char* name);
+
+#endif /* UPLINK_RETRY_H */
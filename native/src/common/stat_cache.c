@@ -0,0 +1,283 @@
+/**
+ * @file stat_cache.c
+ * @brief Opt-in per-project object metadata cache implementation
+ *
+ * Each enabled project owns a chained hash table of entries threaded on
+ * an LRU list (most recent at the head). Caches live on a small global
+ * list keyed by project handle, so completions that only know the
+ * project handle can invalidate. Everything runs on the main thread.
+ */
+
+#include "stat_cache.h"
+#include "object_converter.h"
+#include "object_cache.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct StatCacheEntry {
+    char* id;                       /* bucket '\0' key */
+    size_t id_length;
+    uint32_t hash;
+    uint64_t expires_at;            /* uv_hrtime() deadline, ns */
+    UplinkObject object;            /* Deep copy */
+    struct StatCacheEntry* chain;   /* Next in hash bucket */
+    struct StatCacheEntry* prev;    /* LRU neighbours */
+    struct StatCacheEntry* next;
+} StatCacheEntry;
+
+typedef struct StatCache {
+    size_t project_handle;
+    StatCacheEntry** buckets;
+    size_t bucket_count;            /* Power of two */
+    StatCacheEntry* head;           /* Most recently used */
+    StatCacheEntry* tail;
+    uint64_t epoch;
+    StatCacheStats stats;
+    struct StatCache* next;
+} StatCache;
+
+static StatCache* stat_caches = NULL;
+
+/* ========== helpers ========== */
+
+static StatCache* find_cache(size_t project_handle) {
+    for (StatCache* cache = stat_caches; cache != NULL; cache = cache->next) {
+        if (cache->project_handle == project_handle) {
+            return cache;
+        }
+    }
+    return NULL;
+}
+
+/** FNV-1a over bucket '\0' key */
+static uint32_t hash_id(const char* bucket, const char* key) {
+    uint32_t hash = 2166136261u;
+    for (const char* p = bucket; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    hash = (hash ^ 0) * 16777619u;
+    for (const char* p = key; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    return hash;
+}
+
+static int entry_matches(const StatCacheEntry* entry, uint32_t hash, const char* bucket, const char* key) {
+    size_t bucket_length = strlen(bucket);
+    return entry->hash == hash &&
+           entry->id_length == bucket_length + 1 + strlen(key) &&
+           memcmp(entry->id, bucket, bucket_length + 1) == 0 &&
+           strcmp(entry->id + bucket_length + 1, key) == 0;
+}
+
+static StatCacheEntry** find_slot(StatCache* cache, uint32_t hash, const char* bucket, const char* key) {
+    StatCacheEntry** slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+    while (*slot != NULL && !entry_matches(*slot, hash, bucket, key)) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+static void lru_unlink(StatCache* cache, StatCacheEntry* entry) {
+    if (entry->prev != NULL) entry->prev->next = entry->next; else cache->head = entry->next;
+    if (entry->next != NULL) entry->next->prev = entry->prev; else cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void lru_push_front(StatCache* cache, StatCacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head != NULL) cache->head->prev = entry; else cache->tail = entry;
+    cache->head = entry;
+}
+
+/** Remove the entry in @p slot from the table and LRU, and free it */
+static void remove_entry(StatCache* cache, StatCacheEntry** slot) {
+    StatCacheEntry* entry = *slot;
+    *slot = entry->chain;
+    lru_unlink(cache, entry);
+    object_deep_free(&entry->object);
+    free(entry->id);
+    free(entry);
+    cache->stats.entries--;
+}
+
+static void remove_lookup(StatCache* cache, StatCacheEntry* entry) {
+    const char* bucket = entry->id;
+    const char* key = entry->id + strlen(bucket) + 1;
+    remove_entry(cache, find_slot(cache, entry->hash, bucket, key));
+}
+
+static void free_cache(StatCache* cache) {
+    while (cache->head != NULL) {
+        remove_lookup(cache, cache->head);
+    }
+    free(cache->buckets);
+    free(cache);
+}
+
+/* ========== public API ========== */
+
+int stat_cache_enable(size_t project_handle, size_t max_entries, int64_t ttl_ms) {
+    stat_cache_disable(project_handle);
+
+    StatCache* cache = (StatCache*)calloc(1, sizeof(StatCache));
+    if (cache == NULL) return -1;
+
+    cache->bucket_count = 16;
+    while (cache->bucket_count < max_entries) {
+        cache->bucket_count <<= 1;
+    }
+    cache->buckets = (StatCacheEntry**)calloc(cache->bucket_count, sizeof(StatCacheEntry*));
+    if (cache->buckets == NULL) {
+        free(cache);
+        return -1;
+    }
+
+    cache->project_handle = project_handle;
+    cache->epoch = 1;
+    cache->stats.max_entries = max_entries;
+    cache->stats.ttl_ms = ttl_ms;
+    cache->next = stat_caches;
+    stat_caches = cache;
+
+    LOG_INFO("stat cache enabled for project %zu (max %zu entries, ttl %lld ms)",
+             project_handle, max_entries, (long long)ttl_ms);
+    return 0;
+}
+
+void stat_cache_disable(size_t project_handle) {
+    for (StatCache** link = &stat_caches; *link != NULL; link = &(*link)->next) {
+        if ((*link)->project_handle == project_handle) {
+            StatCache* cache = *link;
+            *link = cache->next;
+            free_cache(cache);
+            LOG_DEBUG("stat cache disabled for project %zu", project_handle);
+            return;
+        }
+    }
+}
+
+const UplinkObject* stat_cache_lookup(size_t project_handle, const char* bucket, const char* key) {
+    StatCache* cache = find_cache(project_handle);
+    if (cache == NULL) return NULL;
+
+    StatCacheEntry** slot = find_slot(cache, hash_id(bucket, key), bucket, key);
+    if (*slot == NULL) {
+        cache->stats.misses++;
+        return NULL;
+    }
+    if ((*slot)->expires_at <= uv_hrtime()) {
+        remove_entry(cache, slot);
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    StatCacheEntry* entry = *slot;
+    lru_unlink(cache, entry);
+    lru_push_front(cache, entry);
+    cache->stats.hits++;
+    return &entry->object;
+}
+
+const UplinkObject* stat_cache_peek(size_t project_handle, const char* bucket, const char* key) {
+    StatCache* cache = find_cache(project_handle);
+    if (cache == NULL) return NULL;
+
+    StatCacheEntry* entry = *find_slot(cache, hash_id(bucket, key), bucket, key);
+    if (entry == NULL || entry->expires_at <= uv_hrtime()) return NULL;
+    return &entry->object;
+}
+
+uint64_t stat_cache_epoch(size_t project_handle) {
+    StatCache* cache = find_cache(project_handle);
+    return cache != NULL ? cache->epoch : 0;
+}
+
+void stat_cache_store(size_t project_handle, uint64_t epoch, const char* bucket, const char* key,
+                      const UplinkObject* object) {
+    StatCache* cache = find_cache(project_handle);
+    if (cache == NULL || cache->epoch != epoch || object == NULL || cache->stats.max_entries == 0) {
+        return;
+    }
+
+    uint32_t hash = hash_id(bucket, key);
+    StatCacheEntry** slot = find_slot(cache, hash, bucket, key);
+    if (*slot != NULL) {
+        remove_entry(cache, slot);
+    }
+
+    StatCacheEntry* entry = (StatCacheEntry*)calloc(1, sizeof(StatCacheEntry));
+    if (entry == NULL) return;
+    size_t bucket_length = strlen(bucket);
+    entry->id_length = bucket_length + 1 + strlen(key);
+    entry->id = (char*)malloc(entry->id_length + 1);
+    if (entry->id == NULL || object_deep_copy(&entry->object, object) != 0) {
+        free(entry->id);
+        free(entry);
+        return;
+    }
+    memcpy(entry->id, bucket, bucket_length + 1);
+    strcpy(entry->id + bucket_length + 1, key);
+    entry->hash = hash;
+    entry->expires_at = uv_hrtime() + (uint64_t)cache->stats.ttl_ms * 1000000u;
+
+    if (cache->stats.entries >= cache->stats.max_entries) {
+        remove_lookup(cache, cache->tail);
+    }
+    slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+    entry->chain = *slot;
+    *slot = entry;
+    lru_push_front(cache, entry);
+    cache->stats.entries++;
+}
+
+void stat_cache_invalidate(size_t project_handle, const char* bucket, const char* key) {
+    object_cache_invalidate(project_handle, bucket, key);
+
+    StatCache* cache = find_cache(project_handle);
+    if (cache == NULL || bucket == NULL || key == NULL) return;
+
+    cache->epoch++;
+    StatCacheEntry** slot = find_slot(cache, hash_id(bucket, key), bucket, key);
+    if (*slot != NULL) {
+        remove_entry(cache, slot);
+        cache->stats.invalidations++;
+    }
+}
+
+void stat_cache_invalidate_prefix(size_t project_handle, const char* bucket, const char* prefix) {
+    object_cache_invalidate_prefix(project_handle, bucket, prefix);
+
+    StatCache* cache = find_cache(project_handle);
+    if (cache == NULL || bucket == NULL || prefix == NULL) return;
+
+    cache->epoch++;
+    size_t bucket_length = strlen(bucket);
+    size_t prefix_length = strlen(prefix);
+    StatCacheEntry* entry = cache->head;
+    while (entry != NULL) {
+        StatCacheEntry* next = entry->next;
+        if (entry->id_length >= bucket_length + 1 + prefix_length &&
+            memcmp(entry->id, bucket, bucket_length + 1) == 0 &&
+            memcmp(entry->id + bucket_length + 1, prefix, prefix_length) == 0) {
+            remove_lookup(cache, entry);
+            cache->stats.invalidations++;
+        }
+        entry = next;
+    }
+}
+
+int stat_cache_enabled(size_t project_handle) {
+    return find_cache(project_handle) != NULL;
+}
+
+int stat_cache_stats(size_t project_handle, StatCacheStats* out) {
+    StatCache* cache = find_cache(project_handle);
+    if (cache == NULL) return -1;
+    *out = cache->stats;
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file stat_cache.h
+ * @brief Opt-in per-project object metadata cache for uplink-nodejs native module
+ *
+ * A bounded LRU of statObject results keyed by bucket/key, with a TTL.
+ * Entries are dropped by this binding's own writes to a key (upload
+ * commit, putObject, uploadFile, multipart commit, delete, copy, move,
+ * metadata update, prefix delete). Invalidation also reaches the
+ * project's object cache (object_cache.h). Main thread only.
+ */
+
+#ifndef UPLINK_STAT_CACHE_H
+#define UPLINK_STAT_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "uplink.h"
+
+/** Default entry limit for projectEnableStatCache */
+#define STAT_CACHE_DEFAULT_MAX_ENTRIES 1024
+
+/** Default entry lifetime for projectEnableStatCache (5 s) */
+#define STAT_CACHE_DEFAULT_TTL_MS 5000
+
+/**
+ * Counters for one project's cache
+ */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t invalidations;
+    size_t entries;
+    size_t max_entries;
+    int64_t ttl_ms;
+} StatCacheStats;
+
+/**
+ * Enable (or reconfigure, dropping all entries) the cache of a project
+ *
+ * @param project_handle Project handle
+ * @param max_entries Entry limit; least recently used entries are evicted
+ * @param ttl_ms How long an entry stays valid
+ * @return 0 on success, -1 on OOM
+ */
+int stat_cache_enable(size_t project_handle, size_t max_entries, int64_t ttl_ms);
+
+/**
+ * Disable the cache of a project and free its entries (no-op when disabled)
+ */
+void stat_cache_disable(size_t project_handle);
+
+/**
+ * Look up a live entry, counting a hit or a miss
+ *
+ * @return The cached object (owned by the cache; valid until the next cache
+ *         call), or NULL on a miss or when the project has no cache
+ */
+const UplinkObject* stat_cache_lookup(size_t project_handle, const char* bucket, const char* key);
+
+/**
+ * Look up a live entry without counting it or touching the LRU order
+ *
+ * @return The cached object (owned by the cache; valid until the next cache
+ *         call), or NULL if absent, expired or the project has no cache
+ */
+const UplinkObject* stat_cache_peek(size_t project_handle, const char* bucket, const char* key);
+
+/**
+ * Current invalidation epoch of a project's cache (0 when disabled)
+ *
+ * A stat records the epoch before it starts and passes it to
+ * stat_cache_store(), so a result that raced a write is not cached.
+ */
+uint64_t stat_cache_epoch(size_t project_handle);
+
+/**
+ * Store a stat result (deep-copied) if the epoch is still @p epoch
+ */
+void stat_cache_store(size_t project_handle, uint64_t epoch, const char* bucket, const char* key,
+                      const UplinkObject* object);
+
+/**
+ * Drop the entry for bucket/key after a write, here and in the object
+ * cache (no-op when both are disabled)
+ */
+void stat_cache_invalidate(size_t project_handle, const char* bucket, const char* key);
+
+/**
+ * Drop every entry of @p bucket whose key starts with @p prefix, here and in
+ * the object cache (no-op when both are disabled)
+ */
+void stat_cache_invalidate_prefix(size_t project_handle, const char* bucket, const char* prefix);
+
+/**
+ * Whether a project has a cache
+ */
+int stat_cache_enabled(size_t project_handle);
+
+/**
+ * Read the counters of a project's cache
+ *
+ * @return 0 on success, -1 when the project has no cache
+ */
+int stat_cache_stats(size_t project_handle, StatCacheStats* out);
+
+#endif /* UPLINK_STAT_CACHE_H */
@@ -3,18 +3,63 @@
  * @brief String utilities implementation
  * 
  * Provides string extraction, validation, and conversion utilities.
+ * 
+ * Strings are first copied into a stack scratch buffer, which settles
+ * short keys in one N-API call; only longer strings pay for a separate
+ * length query. Bucket names are interned per env: each entry is
+ * reference-counted by the operations using it and stays cached after
+ * its last release while the table is under BUCKET_NAME_CACHE_MAX.
  */
 
 #include "string_helpers.h"
+#include "addon_instance.h"
 #include "logger.h"
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
+/** Stack scratch size for the one-call fast path */
+#define STRING_SCRATCH_BYTES 256
+
+struct InternedName {
+    InternedName* next;
+    BucketNameTable* table;         /* NULL once the table is gone */
+    uint32_t refs;
+    uint32_t hash;
+    size_t length;
+    char name[];
+};
+
+/**
+ * Copy a JS string into @p scratch
+ * 
+ * @return 1 if it fit, 0 if it may have been cut short, -1 on failure
+ */
+static int read_string_scratch(napi_env env, napi_value js_string, char* scratch, size_t* length) {
+    if (napi_get_value_string_utf8(env, js_string, scratch, STRING_SCRATCH_BYTES, length) != napi_ok) {
+        return -1;
+    }
+    /* A cut never splits a UTF-8 sequence, so it can stop up to 4 bytes short */
+    return *length + 4 < STRING_SCRATCH_BYTES ? 1 : 0;
+}
+
 napi_status extract_string(napi_env env, napi_value js_string, char** out_str) {
     size_t str_len;
     napi_status status;
     
+    char scratch[STRING_SCRATCH_BYTES];
+    int fit = read_string_scratch(env, js_string, scratch, &str_len);
+    if (fit == 1) {
+        *out_str = (char*)malloc(str_len + 1);
+        if (*out_str == NULL) {
+            LOG_ERROR("Failed to allocate string buffer");
+            return napi_generic_failure;
+        }
+        memcpy(*out_str, scratch, str_len + 1);
+        LOG_TRACE("Extracted string: %s", *out_str);
+        return napi_ok;
+    }
+    
     /* Get string length */
     status = napi_get_value_string_utf8(env, js_string, NULL, 0, &str_len);
     if (status != napi_ok) {
@@ -43,8 +88,8 @@ napi_status extract_string(napi_env env, napi_value js_string, char** out_str) {
     return napi_ok;
 }
 
-napi_status extract_string_required(napi_env env, napi_value js_string, 
-                                   const char* param_name, char** out_str) {
+/** Throw unless @p js_string is a string; 0 if it is */
+static int require_string_type(napi_env env, napi_value js_string, const char* param_name) {
     napi_valuetype type;
     napi_typeof(env, js_string, &type);
     
@@ -54,8 +99,7 @@ napi_status extract_string_required(napi_env env, napi_value js_string,
         char error_msg[256];
         snprintf(error_msg, sizeof(error_msg), "Parameter '%s' is required", param_name);
         napi_throw_type_error(env, NULL, error_msg);
-        *out_str = NULL;
-        return napi_invalid_arg;
+        return -1;
     }
     
     /* Check type */
@@ -64,6 +108,21 @@ napi_status extract_string_required(napi_env env, napi_value js_string,
         char error_msg[256];
         snprintf(error_msg, sizeof(error_msg), "Parameter '%s' must be a string", param_name);
         napi_throw_type_error(env, NULL, error_msg);
+        return -1;
+    }
+    return 0;
+}
+
+static void throw_empty_string(napi_env env, const char* param_name) {
+    LOG_ERROR("Parameter '%s' cannot be empty", param_name);
+    char error_msg[256];
+    snprintf(error_msg, sizeof(error_msg), "Parameter '%s' cannot be empty", param_name);
+    napi_throw_type_error(env, NULL, error_msg);
+}
+
+napi_status extract_string_required(napi_env env, napi_value js_string, 
+                                   const char* param_name, char** out_str) {
+    if (require_string_type(env, js_string, param_name) != 0) {
         *out_str = NULL;
         return napi_invalid_arg;
     }
@@ -76,10 +135,7 @@ napi_status extract_string_required(napi_env env, napi_value js_string,
     
     /* Check empty */
     if (*out_str == NULL || strlen(*out_str) == 0) {
-        LOG_ERROR("Parameter '%s' cannot be empty", param_name);
-        char error_msg[256];
-        snprintf(error_msg, sizeof(error_msg), "Parameter '%s' cannot be empty", param_name);
-        napi_throw_type_error(env, NULL, error_msg);
+        throw_empty_string(env, param_name);
         free(*out_str);
         *out_str = NULL;
         return napi_invalid_arg;
@@ -89,6 +145,139 @@ napi_status extract_string_required(napi_env env, napi_value js_string,
     return napi_ok;
 }
 
+static uint32_t name_hash(const char* name, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static InternedName* interned_from_name(char* name) {
+    return (InternedName*)(name - offsetof(InternedName, name));
+}
+
+/** Find or add @p name in @p table (NULL: an unshared entry) */
+static char* intern_name(BucketNameTable* table, const char* name, size_t length) {
+    uint32_t hash = name_hash(name, length);
+    if (table != NULL) {
+        for (InternedName* entry = table->slots[hash % BUCKET_NAME_SLOTS]; entry != NULL; entry = entry->next) {
+            if (entry->hash == hash && entry->length == length && memcmp(entry->name, name, length) == 0) {
+                entry->refs++;
+                return entry->name;
+            }
+        }
+    }
+    
+    InternedName* entry = (InternedName*)malloc(sizeof(InternedName) + length + 1);
+    if (entry == NULL) {
+        return NULL;
+    }
+    memcpy(entry->name, name, length);
+    entry->name[length] = '\0';
+    entry->table = table;
+    entry->refs = 1;
+    entry->hash = hash;
+    entry->length = length;
+    entry->next = NULL;
+    if (table != NULL) {
+        InternedName** slot = &table->slots[hash % BUCKET_NAME_SLOTS];
+        entry->next = *slot;
+        *slot = entry;
+        table->count++;
+    }
+    return entry->name;
+}
+
+napi_status extract_bucket_name(napi_env env, napi_value js_string,
+                                const char* param_name, char** out_str) {
+    *out_str = NULL;
+    if (require_string_type(env, js_string, param_name) != 0) {
+        return napi_invalid_arg;
+    }
+    
+    char scratch[STRING_SCRATCH_BYTES];
+    char* heap = NULL;
+    const char* name = scratch;
+    size_t length;
+    int fit = read_string_scratch(env, js_string, scratch, &length);
+    if (fit < 0) {
+        LOG_ERROR("Failed to copy string");
+        return napi_generic_failure;
+    }
+    if (fit == 0) {
+        /* Too long to be a valid bucket; let uplink-c report it */
+        napi_status status = extract_string(env, js_string, &heap);
+        if (status != napi_ok) {
+            return status;
+        }
+        name = heap;
+        length = strlen(heap);
+    }
+    if (length == 0) {
+        throw_empty_string(env, param_name);
+        return napi_invalid_arg;
+    }
+    
+    AddonInstance* instance = addon_instance(env);
+    *out_str = intern_name(instance != NULL ? &instance->bucket_names : NULL, name, length);
+    free(heap);
+    if (*out_str == NULL) {
+        LOG_ERROR("Failed to allocate string buffer");
+        return napi_generic_failure;
+    }
+    return napi_ok;
+}
+
+char* bucket_name_retain(char* name) {
+    if (name != NULL) {
+        interned_from_name(name)->refs++;
+    }
+    return name;
+}
+
+void bucket_name_release(char* name) {
+    if (name == NULL) return;
+    
+    InternedName* entry = interned_from_name(name);
+    if (--entry->refs > 0) {
+        return;
+    }
+    BucketNameTable* table = entry->table;
+    if (table != NULL && table->count <= BUCKET_NAME_CACHE_MAX) {
+        /* Keep it for the next operation on this bucket */
+        return;
+    }
+    if (table != NULL) {
+        for (InternedName** link = &table->slots[entry->hash % BUCKET_NAME_SLOTS]; *link != NULL; link = &(*link)->next) {
+            if (*link == entry) {
+                *link = entry->next;
+                break;
+            }
+        }
+        table->count--;
+    }
+    free(entry);
+}
+
+void bucket_names_destroy(BucketNameTable* table) {
+    for (size_t i = 0; i < BUCKET_NAME_SLOTS; i++) {
+        InternedName* entry = table->slots[i];
+        while (entry != NULL) {
+            InternedName* next = entry->next;
+            if (entry->refs == 0) {
+                free(entry);
+            } else {
+                entry->table = NULL;
+                entry->next = NULL;
+            }
+            entry = next;
+        }
+        table->slots[i] = NULL;
+    }
+    table->count = 0;
+}
+
 napi_status extract_string_optional(napi_env env, napi_value js_string, char** out_str) {
     napi_valuetype type;
     napi_typeof(env, js_string, &type);
@@ -10,6 +10,23 @@
 
 #include <node_api.h>
 #include <stddef.h>
+#include <stdint.h>
+
+/** Chains in a per-env bucket name table */
+#define BUCKET_NAME_SLOTS 64
+
+/** Unreferenced names kept per env before they are freed on release */
+#define BUCKET_NAME_CACHE_MAX 256
+
+typedef struct InternedName InternedName;
+
+/**
+ * Per-env table of interned bucket names (lives in AddonInstance)
+ */
+typedef struct {
+    InternedName* slots[BUCKET_NAME_SLOTS];
+    uint32_t count;
+} BucketNameTable;
 
 /**
  * Extract C string from JS string
@@ -35,6 +52,40 @@ napi_status extract_string(napi_env env, napi_value js_string, char** out_str);
 napi_status extract_string_required(napi_env env, napi_value js_string, 
                                    const char* param_name, char** out_str);
 
+/**
+ * Extract a required bucket name, interned in the env's table
+ * 
+ * Same validation and errors as extract_string_required. Operations on
+ * the same bucket share one reference-counted copy, so the common case
+ * allocates nothing. Release with bucket_name_release(), never free();
+ * the string must not be modified. Main thread only.
+ * 
+ * @param env N-API environment
+ * @param js_string JS string value
+ * @param param_name Name of parameter (for error messages)
+ * @param out_str Output for the interned name
+ * @return napi_ok on success
+ */
+napi_status extract_bucket_name(napi_env env, napi_value js_string,
+                                const char* param_name, char** out_str);
+
+/**
+ * Take another reference on an interned bucket name (NULL passes through)
+ */
+char* bucket_name_retain(char* name);
+
+/**
+ * Drop a reference taken by extract_bucket_name or bucket_name_retain
+ * (main thread; NULL is a no-op)
+ */
+void bucket_name_release(char* name);
+
+/**
+ * Free an env's bucket name table. Names still referenced outlive it and
+ * are freed by their last release.
+ */
+void bucket_names_destroy(BucketNameTable* table);
+
 /**
  * Extract optional C string (returns NULL if undefined/null)
  * 
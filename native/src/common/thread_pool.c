@@ -0,0 +1,849 @@
+/**
+ * @file thread_pool.c
+ * @brief Addon-owned worker pool implementation
+ *
+ * Each lane is a FIFO with a running count and a budget, all under one
+ * lock. A thread takes the oldest job of the first lane that is below
+ * its budget, so pool threads are shared between lanes while each lane's
+ * concurrency stays bounded.
+ *
+ * A finished job is pushed onto its environment's completion list, a
+ * lock-free stack the main thread takes whole. Only the push that finds
+ * the list empty calls the environment's threadsafe function, so a burst
+ * of completions costs one wake-up of the event loop rather than one
+ * queued call each. The function is only ref'd while jobs are in flight,
+ * so an idle pool does not keep the event loop alive.
+ *
+ * With a completion delay configured, that first push arms a deadline
+ * instead, and a flusher thread wakes the environment when it passes;
+ * a list that reaches the completion batch size wakes it at once.
+ */
+
+#include "thread_pool.h"
+#include "addon_instance.h"
+#include "type_converters.h"
+#include "work_pool.h"
+#include "logger.h"
+
+#include <uv.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Per-environment completion channel */
+typedef struct PoolEnv {
+    struct PoolEnv* next;
+    napi_env env;
+    napi_threadsafe_function tsfn;
+    struct PoolJob* volatile done;  /* finished jobs, newest first; see done_push() */
+    uint32_t pending;               /* jobs queued, running or done; main thread only */
+    uint32_t running;               /* jobs on pool threads; guarded by pool_lock */
+    uint64_t flush_at;              /* delayed wake-up deadline, 0 = none; guarded by pool_lock */
+    uint32_t batched;               /* jobs pushed since the list was found empty; guarded by pool_lock */
+    bool closed;                    /* env torn down; guarded by pool_lock */
+} PoolEnv;
+
+typedef struct PoolJob {
+    struct PoolJob* next;
+    PoolEnv* owner;
+    ThreadPoolLane lane;
+    napi_async_work work;
+    napi_async_execute_callback execute;
+    napi_async_complete_callback complete;
+    void* data;
+    napi_status status;             /* passed to complete: napi_ok, or napi_cancelled */
+    OpTimer timer;
+    uint64_t started_at;            /* uv_hrtime() around execute, 0 = never started */
+    uint64_t finished_at;
+} PoolJob;
+
+/**
+ * libuv fallback of a job queued without an async work handle
+ */
+typedef struct {
+    napi_async_work work;
+    napi_async_execute_callback execute;
+    napi_async_complete_callback complete;
+    void* data;
+} PoolFallback;
+
+#if defined(_MSC_VER)
+#include <windows.h>
+/** Push @p job onto @p list; returns the previous head */
+static PoolJob* done_push(PoolJob* volatile* list, PoolJob* job) {
+    PoolJob* head;
+    do {
+        head = *list;
+        job->next = head;
+    } while (InterlockedCompareExchangePointer((PVOID volatile*)list, job, head) != head);
+    return head;
+}
+/** Take the whole of @p list */
+static PoolJob* done_take(PoolJob* volatile* list) {
+    return (PoolJob*)InterlockedExchangePointer((PVOID volatile*)list, NULL);
+}
+#else
+static PoolJob* done_push(PoolJob* volatile* list, PoolJob* job) {
+    PoolJob* head = __atomic_load_n(list, __ATOMIC_RELAXED);
+    do {
+        job->next = head;
+    } while (!__atomic_compare_exchange_n(list, &head, job, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    return head;
+}
+static PoolJob* done_take(PoolJob* volatile* list) {
+    return __atomic_exchange_n(list, NULL, __ATOMIC_ACQUIRE);
+}
+#endif
+
+typedef struct PoolThread {
+    struct PoolThread* next;
+    uv_thread_t thread;
+} PoolThread;
+
+static uv_once_t pool_once = UV_ONCE_INIT;
+static uv_mutex_t pool_lock;
+static uv_cond_t pool_wake;
+static uv_cond_t pool_delivered;    /* the last job of a closed environment finished */
+
+typedef struct {
+    PoolJob* head;
+    PoolJob* tail;
+    uint32_t queued;
+    uint32_t running;
+    uint32_t budget;
+} PoolLane;
+
+static PoolLane lanes[THREAD_POOL_LANE_COUNT] = {
+    [THREAD_POOL_LANE_METADATA] = { NULL, NULL, 0, 0, THREAD_POOL_DEFAULT_METADATA_SIZE },
+    [THREAD_POOL_LANE_BULK]     = { NULL, NULL, 0, 0, THREAD_POOL_DEFAULT_SIZE },
+};
+
+static uint64_t idle_timeout_ms = THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS;
+static uint64_t completion_delay_ns = 0;
+static uint32_t completion_batch = THREAD_POOL_DEFAULT_COMPLETION_BATCH;
+static uint64_t completions = 0;
+static uint64_t completion_wakeups = 0;
+static uv_cond_t flush_wake;
+static uv_thread_t flusher;
+static bool flusher_started = false;
+static uint32_t thread_count = 0;
+static uint32_t idle_count = 0;
+static uint32_t wakeups_pending = 0;    /* 1 while a signalled idle thread is yet to run */
+static PoolThread* exited_threads = NULL;    /* waiting to be joined */
+
+static PoolEnv* envs = NULL;
+
+/** Apply a count from an environment variable, if set and within @p min-@p max */
+static void read_count_env(const char* name, long min, long max, uint32_t* out) {
+    const char* value = getenv(name);
+    if (value == NULL || *value == '\0') {
+        return;
+    }
+    char* end = NULL;
+    long count = strtol(value, &end, 10);
+    if (*end == '\0' && count >= min && count <= max) {
+        *out = (uint32_t)count;
+    } else {
+        LOG_WARN("%s='%s' ignored (expected %ld-%ld)", name, value, min, max);
+    }
+}
+
+static void pool_init(void) {
+    uv_mutex_init(&pool_lock);
+    uv_cond_init(&pool_wake);
+    uv_cond_init(&pool_delivered);
+    uv_cond_init(&flush_wake);
+    
+    read_count_env("UPLINK_METADATA_THREAD_POOL_SIZE", 0, THREAD_POOL_MAX_SIZE,
+                   &lanes[THREAD_POOL_LANE_METADATA].budget);
+    read_count_env("UPLINK_THREAD_POOL_SIZE", 0, THREAD_POOL_MAX_SIZE, &lanes[THREAD_POOL_LANE_BULK].budget);
+    uint32_t delay_us = 0;
+    read_count_env("UPLINK_COMPLETION_DELAY_US", 0, THREAD_POOL_MAX_COMPLETION_DELAY_US, &delay_us);
+    completion_delay_ns = (uint64_t)delay_us * 1000u;
+    read_count_env("UPLINK_COMPLETION_BATCH", 1, THREAD_POOL_MAX_COMPLETION_BATCH, &completion_batch);
+    LOG_DEBUG("thread pool: metadata=%u bulk=%u idleTimeoutMs=%llu completionDelayUs=%u",
+              lanes[THREAD_POOL_LANE_METADATA].budget, lanes[THREAD_POOL_LANE_BULK].budget,
+              (unsigned long long)idle_timeout_ms, delay_us);
+}
+
+/** Threads the pool may run: one per unit of lane budget; call with pool_lock held */
+static uint32_t pool_capacity(void) {
+    uint32_t capacity = 0;
+    for (int i = 0; i < THREAD_POOL_LANE_COUNT; i++) {
+        capacity += lanes[i].budget;
+    }
+    return capacity;
+}
+
+/** Whether @p lane has a job it may start now; call with pool_lock held */
+static bool lane_can_start(const PoolLane* lane) {
+    /* A lane resized to 0 still drains what was queued before */
+    uint32_t budget = lane->budget > 0 ? lane->budget : 1;
+    return lane->head != NULL && lane->running < budget;
+}
+
+/** The highest-priority lane with a startable job, or NULL; call with pool_lock held */
+static PoolLane* next_lane(void) {
+    for (int i = 0; i < THREAD_POOL_LANE_COUNT; i++) {
+        if (lane_can_start(&lanes[i])) {
+            return &lanes[i];
+        }
+    }
+    return NULL;
+}
+
+/** Jobs that could start right now across all lanes; call with pool_lock held */
+static uint32_t startable_jobs(void) {
+    uint32_t count = 0;
+    for (int i = 0; i < THREAD_POOL_LANE_COUNT; i++) {
+        uint32_t budget = lanes[i].budget > 0 ? lanes[i].budget : 1;
+        uint32_t free_slots = lanes[i].running < budget ? budget - lanes[i].running : 0;
+        count += lanes[i].queued < free_slots ? lanes[i].queued : free_slots;
+    }
+    return count;
+}
+
+/**
+ * Wake one idle thread if there is work left for it; call with pool_lock held.
+ * At most one wake-up is in flight: the woken thread wakes the next once it
+ * has taken a job, so a burst ramps up without every submit waking a thread.
+ */
+static void wake_idle_thread(void) {
+    if (wakeups_pending == 0 && idle_count > 0 && startable_jobs() > 0) {
+        wakeups_pending = 1;
+        uv_cond_signal(&pool_wake);
+    }
+}
+
+/** Join threads that exited on idle; call with pool_lock held */
+static void reap_exited_threads(void) {
+    while (exited_threads != NULL) {
+        PoolThread* exited = exited_threads;
+        exited_threads = exited->next;
+        /* It pushed itself under the lock, so all that is left is its return */
+        uv_thread_join(&exited->thread);
+        free(exited);
+    }
+}
+
+/** Have the main thread of @p owner drain its list */
+static void notify_env(PoolEnv* owner) {
+    /* Fails only once the env is closing; pool_env_cleanup() then takes the list */
+    napi_call_threadsafe_function(owner->tsfn, NULL, napi_tsfn_nonblocking);
+}
+
+/** Wake @p owner now; call with pool_lock held */
+static void wake_env(PoolEnv* owner) {
+    owner->flush_at = 0;
+    completion_wakeups++;
+    notify_env(owner);
+}
+
+/** Wake environments whose delay has passed, until the process exits */
+static void flusher_main(void* arg) {
+    (void)arg;
+    uv_mutex_lock(&pool_lock);
+    for (;;) {
+        uint64_t now = uv_hrtime();
+        uint64_t next = 0;
+        for (PoolEnv* owner = envs; owner != NULL; owner = owner->next) {
+            if (owner->flush_at == 0) {
+                continue;
+            }
+            if (owner->flush_at <= now) {
+                wake_env(owner);
+            } else if (next == 0 || owner->flush_at < next) {
+                next = owner->flush_at;
+            }
+        }
+        if (next == 0) {
+            uv_cond_wait(&flush_wake, &pool_lock);
+        } else {
+            uv_cond_timedwait(&flush_wake, &pool_lock, next - now);
+        }
+    }
+}
+
+/** Start the flusher thread if needed; call with pool_lock held */
+static bool start_flusher(void) {
+    if (!flusher_started) {
+        if (uv_thread_create(&flusher, flusher_main, NULL) != 0) {
+            LOG_WARN("thread pool: could not start the completion flusher");
+            return false;
+        }
+        flusher_started = true;
+    }
+    return true;
+}
+
+/**
+ * Hand a finished job to its environment; call with pool_lock held.
+ * Returns true when the caller must notify_env() the owner once it drops the lock.
+ */
+static bool deliver_job(PoolJob* job) {
+    PoolEnv* owner = job->owner;
+    if (owner->closed) {
+        /* pool_env_cleanup() completes it once owner->running drops to 0 */
+        done_push(&owner->done, job);
+        return false;
+    }
+    completions++;
+    if (done_push(&owner->done, job) == NULL) {
+        owner->batched = 1;
+        if (completion_delay_ns == 0 || !start_flusher()) {
+            owner->flush_at = 0;
+            completion_wakeups++;
+            return true;
+        }
+        owner->flush_at = uv_hrtime() + completion_delay_ns;
+        uv_cond_signal(&flush_wake);
+    } else if (owner->flush_at != 0 && ++owner->batched >= completion_batch) {
+        wake_env(owner);
+    }
+    /* Otherwise a wake-up is already on its way or scheduled */
+    return false;
+}
+
+static void pool_worker(void* arg) {
+    PoolThread* self = (PoolThread*)arg;
+    
+    uv_mutex_lock(&pool_lock);
+    for (;;) {
+        PoolLane* lane = next_lane();
+        /* Surplus after a resize; with every budget 0, drain what is queued first */
+        uint32_t capacity = pool_capacity();
+        if (thread_count > capacity && (capacity > 0 || lane == NULL)) {
+            break;
+        }
+        if (lane != NULL) {
+            PoolJob* job = lane->head;
+            lane->head = job->next;
+            if (lane->head == NULL) {
+                lane->tail = NULL;
+            }
+            lane->queued--;
+            lane->running++;
+            job->owner->running++;
+            wake_idle_thread();
+            uv_mutex_unlock(&pool_lock);
+    
+            job->started_at = uv_hrtime();
+            job->execute(job->owner->env, job->data);
+            job->finished_at = uv_hrtime();
+    
+            /* The job may be completed and freed once delivered */
+            PoolEnv* owner = job->owner;
+            uv_mutex_lock(&pool_lock);
+            lanes[job->lane].running--;
+            if (deliver_job(job)) {
+                /* Still counted in owner->running, so cleanup waits for this call */
+                uv_mutex_unlock(&pool_lock);
+                notify_env(owner);
+                uv_mutex_lock(&pool_lock);
+            }
+            if (--owner->running == 0 && owner->closed) {
+                uv_cond_broadcast(&pool_delivered);
+            }
+            continue;
+        }
+    
+        idle_count++;
+        int rc = uv_cond_timedwait(&pool_wake, &pool_lock, idle_timeout_ms * 1000000u);
+        idle_count--;
+        wakeups_pending = 0;
+        if (rc == UV_ETIMEDOUT && next_lane() == NULL) {
+            break;
+        }
+    }
+    thread_count--;
+    /* Hand over anything startable this thread leaves behind */
+    wake_idle_thread();
+    self->next = exited_threads;
+    exited_threads = self;
+    uv_mutex_unlock(&pool_lock);
+}
+
+/** Start one more thread; call with pool_lock held */
+static void spawn_thread(void) {
+    PoolThread* created = (PoolThread*)malloc(sizeof(PoolThread));
+    if (created == NULL) {
+        return;
+    }
+    if (uv_thread_create(&created->thread, pool_worker, created) != 0) {
+        LOG_WARN("thread pool: could not start a thread (%u running)", thread_count);
+        free(created);
+        return;
+    }
+    thread_count++;
+}
+
+/* ========== main thread side ========== */
+
+/** Reverse a job list, so jobs pushed newest first come out in push order */
+static PoolJob* reverse_jobs(PoolJob* list) {
+    PoolJob* ordered = NULL;
+    while (list != NULL) {
+        PoolJob* next = list->next;
+        list->next = ordered;
+        ordered = list;
+        list = next;
+    }
+    return ordered;
+}
+
+/** Run the complete callbacks of @p list, newest first (main thread) */
+static void complete_jobs(napi_env env, PoolEnv* owner, PoolJob* list) {
+    /* Pushed newest first: reverse so completions run in the order jobs finished */
+    PoolJob* ordered = reverse_jobs(list);
+    while (ordered != NULL) {
+        PoolJob* job = ordered;
+        ordered = job->next;
+        napi_handle_scope scope;
+        napi_open_handle_scope(env, &scope);
+        uint64_t complete_at = uv_hrtime();
+        op_metrics_begin_complete(env, &job->timer);
+        job->complete(env, job->status, job->data);
+        op_metrics_finish(env, &job->timer, job->started_at, job->finished_at, complete_at);
+        /* A throwing callback must not fail the napi calls of later jobs in the batch */
+        bool thrown = false;
+        if (napi_is_exception_pending(env, &thrown) == napi_ok && thrown) {
+            napi_value exception;
+            napi_get_and_clear_last_exception(env, &exception);
+            napi_fatal_exception(env, exception);
+        }
+        napi_close_handle_scope(env, scope);
+        if (--owner->pending == 0) {
+            napi_unref_threadsafe_function(env, owner->tsfn);
+        }
+        work_pool_free(job);
+    }
+}
+
+/** Threadsafe-function callback: run the complete callbacks of the finished jobs */
+static void pool_complete_js(napi_env env, napi_value js_callback, void* context, void* data) {
+    (void)js_callback;
+    (void)data;
+    /* env is NULL when the environment is being torn down; pool_env_cleanup() took the list */
+    if (env == NULL) {
+        return;
+    }
+    PoolEnv* owner = (PoolEnv*)context;
+    complete_jobs(env, owner, done_take(&owner->done));
+}
+
+/** Take the jobs of @p owner that have not started off the lanes, newest first; call with pool_lock held */
+static PoolJob* take_queued_jobs(PoolEnv* owner) {
+    PoolJob* taken = NULL;
+    for (int i = 0; i < THREAD_POOL_LANE_COUNT; i++) {
+        PoolLane* lane = &lanes[i];
+        PoolJob* prev = NULL;
+        for (PoolJob* job = lane->head; job != NULL;) {
+            PoolJob* next = job->next;
+            if (job->owner != owner) {
+                prev = job;
+                job = next;
+                continue;
+            }
+            if (prev != NULL) {
+                prev->next = next;
+            } else {
+                lane->head = next;
+            }
+            if (lane->tail == job) {
+                lane->tail = prev;
+            }
+            lane->queued--;
+            job->status = napi_cancelled;
+            job->next = taken;
+            taken = job;
+            job = next;
+        }
+    }
+    return taken;
+}
+
+/**
+ * Environment teardown: settle every job of the environment here, while
+ * N-API calls are still allowed, so each complete callback frees its
+ * data. Jobs that have not started complete with napi_cancelled; jobs on
+ * pool threads are waited for, as Node waits for its own async work.
+ */
+static void pool_env_cleanup(void* arg) {
+    PoolEnv* owner = (PoolEnv*)arg;
+    
+    uv_mutex_lock(&pool_lock);
+    owner->closed = true;
+    for (PoolEnv** link = &envs; *link != NULL; link = &(*link)->next) {
+        if (*link == owner) {
+            *link = owner->next;
+            break;
+        }
+    }
+    owner->flush_at = 0;
+    PoolJob* cancelled = take_queued_jobs(owner);
+    while (owner->running > 0) {
+        uv_cond_wait(&pool_delivered, &pool_lock);
+    }
+    PoolJob* done = done_take(&owner->done);
+    uv_mutex_unlock(&pool_lock);
+    
+    /* Completions may queue follow-up work; closed sends it to libuv */
+    complete_jobs(owner->env, owner, done);
+    complete_jobs(owner->env, owner, cancelled);
+    
+    AddonInstance* instance = addon_instance(owner->env);
+    if (instance != NULL && instance->pool_env == owner) {
+        instance->pool_env = NULL;
+    }
+    free(owner);
+}
+
+/** Find or create the completion channel of @p env (main thread) */
+static PoolEnv* pool_env_get(napi_env env) {
+    AddonInstance* instance = addon_instance(env);
+    if (instance != NULL && instance->pool_env != NULL) {
+        return instance->pool_env;
+    }
+    uv_mutex_lock(&pool_lock);
+    PoolEnv* owner = envs;
+    while (owner != NULL && owner->env != env) {
+        owner = owner->next;
+    }
+    uv_mutex_unlock(&pool_lock);
+    if (owner != NULL) {
+        if (instance != NULL) {
+            instance->pool_env = owner;
+        }
+        return owner;
+    }
+    
+    owner = (PoolEnv*)calloc(1, sizeof(PoolEnv));
+    if (owner == NULL) {
+        return NULL;
+    }
+    owner->env = env;
+    
+    napi_value name;
+    napi_create_string_utf8(env, "uplinkThreadPool", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_threadsafe_function(env, NULL, NULL, name, 0, 1, NULL, NULL, owner,
+                                        pool_complete_js, &owner->tsfn) != napi_ok) {
+        free(owner);
+        return NULL;
+    }
+    napi_unref_threadsafe_function(env, owner->tsfn);
+    napi_add_env_cleanup_hook(env, pool_env_cleanup, owner);
+    
+    uv_mutex_lock(&pool_lock);
+    owner->next = envs;
+    envs = owner;
+    uv_mutex_unlock(&pool_lock);
+    if (instance != NULL) {
+        instance->pool_env = owner;
+    }
+    return owner;
+}
+
+/**
+ * Queue a job on the pool
+ *
+ * @return 0 when queued, -1 when the lane is disabled or the pool is
+ *         unavailable and the caller must fall back to libuv
+ */
+static int pool_submit(napi_env env, ThreadPoolLane lane, napi_async_work work,
+                       napi_async_execute_callback execute,
+                       napi_async_complete_callback complete,
+                       void* data, const OpTimer* timer) {
+    uv_once(&pool_once, pool_init);
+    uv_mutex_lock(&pool_lock);
+    uint32_t budget = lanes[lane].budget;
+    uv_mutex_unlock(&pool_lock);
+    
+    PoolEnv* owner = budget > 0 ? pool_env_get(env) : NULL;
+    /* A closed env is past its teardown; owner->closed was set on this thread */
+    PoolJob* job = owner != NULL && !owner->closed ? (PoolJob*)work_pool_calloc(1, sizeof(PoolJob)) : NULL;
+    if (job == NULL) {
+        return -1;
+    }
+    job->owner = owner;
+    job->lane = lane;
+    job->work = work;
+    job->execute = execute;
+    job->complete = complete;
+    job->data = data;
+    job->status = napi_ok;
+    job->timer = timer != NULL ? *timer : (OpTimer){ NULL, 0 };
+    
+    if (owner->pending++ == 0) {
+        napi_ref_threadsafe_function(env, owner->tsfn);
+    }
+    
+    uv_mutex_lock(&pool_lock);
+    PoolLane* target = &lanes[lane];
+    PoolJob* prev = target->tail;
+    if (prev != NULL) {
+        prev->next = job;
+    } else {
+        target->head = job;
+    }
+    target->tail = job;
+    target->queued++;
+    
+    reap_exited_threads();
+    if (startable_jobs() > idle_count && thread_count < pool_capacity()) {
+        spawn_thread();
+    }
+    if (thread_count == 0) {
+        /* Could not start any thread: this job would never run, so take it back */
+        if (prev != NULL) {
+            prev->next = NULL;
+        } else {
+            target->head = NULL;
+        }
+        target->tail = prev;
+        target->queued--;
+        uv_mutex_unlock(&pool_lock);
+        work_pool_free(job);
+        if (--owner->pending == 0) {
+            napi_unref_threadsafe_function(env, owner->tsfn);
+        }
+        return -1;
+    }
+    wake_idle_thread();
+    uv_mutex_unlock(&pool_lock);
+    return 0;
+}
+
+static void fallback_execute(napi_env env, void* arg) {
+    PoolFallback* fallback = (PoolFallback*)arg;
+    fallback->execute(env, fallback->data);
+}
+
+static void fallback_complete(napi_env env, napi_status status, void* arg) {
+    PoolFallback* fallback = (PoolFallback*)arg;
+    fallback->complete(env, status, fallback->data);
+    napi_delete_async_work(env, fallback->work);
+    work_pool_free(fallback);
+}
+
+napi_status thread_pool_queue_work(napi_env env, ThreadPoolLane lane, napi_value name,
+                                   napi_async_execute_callback execute,
+                                   napi_async_complete_callback complete,
+                                   void* data, napi_async_work* result) {
+    napi_status status = napi_create_async_work(env, NULL, name, execute, complete, data, result);
+    if (status != napi_ok) {
+        return status;
+    }
+    OpTimer timer = op_metrics_start(env, name);
+    return thread_pool_submit(env, lane, *result, execute, complete, data, &timer);
+}
+
+napi_status thread_pool_submit(napi_env env, ThreadPoolLane lane, napi_async_work work,
+                               napi_async_execute_callback execute,
+                               napi_async_complete_callback complete,
+                               void* data, const OpTimer* timer) {
+    if (pool_submit(env, lane, work, execute, complete, data, timer) != 0) {
+        /* Lane disabled or pool unavailable: fall back to libuv */
+        return napi_queue_async_work(env, work);
+    }
+    return napi_ok;
+}
+
+napi_status thread_pool_queue_job(napi_env env, ThreadPoolLane lane, const char* name,
+                                  napi_async_execute_callback execute,
+                                  napi_async_complete_callback complete, void* data) {
+    OpTimer timer = op_metrics_start_named(env, name);
+    if (pool_submit(env, lane, NULL, execute, complete, data, &timer) == 0) {
+        return napi_ok;
+    }
+    
+    PoolFallback* fallback = (PoolFallback*)work_pool_calloc(1, sizeof(PoolFallback));
+    if (fallback == NULL) {
+        return napi_generic_failure;
+    }
+    fallback->execute = execute;
+    fallback->complete = complete;
+    fallback->data = data;
+    napi_value work_name;
+    napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &work_name);
+    napi_status status = napi_create_async_work(env, NULL, work_name, fallback_execute, fallback_complete,
+                                                fallback, &fallback->work);
+    if (status == napi_ok) {
+        status = napi_queue_async_work(env, fallback->work);
+        if (status != napi_ok) {
+            napi_delete_async_work(env, fallback->work);
+        }
+    }
+    if (status != napi_ok) {
+        work_pool_free(fallback);
+    }
+    return status;
+}
+
+int thread_pool_cancel(napi_async_work work) {
+    uv_once(&pool_once, pool_init);
+    if (work == NULL) {
+        return -1;  /* Jobs without a handle cannot be taken back */
+    }
+    
+    uv_mutex_lock(&pool_lock);
+    for (int i = 0; i < THREAD_POOL_LANE_COUNT; i++) {
+        PoolLane* lane = &lanes[i];
+        PoolJob* prev = NULL;
+        for (PoolJob* job = lane->head; job != NULL; prev = job, job = job->next) {
+            if (job->work != work) {
+                continue;
+            }
+            if (prev != NULL) {
+                prev->next = job->next;
+            } else {
+                lane->head = job->next;
+            }
+            if (lane->tail == job) {
+                lane->tail = prev;
+            }
+            lane->queued--;
+            job->status = napi_cancelled;
+            PoolEnv* owner = job->owner;
+            bool notify = deliver_job(job);
+            uv_mutex_unlock(&pool_lock);
+            if (notify) {
+                notify_env(owner);
+            }
+            return 0;
+        }
+    }
+    uv_mutex_unlock(&pool_lock);
+    return -1;
+}
+
+void thread_pool_gauges(ThreadPoolGauges* out) {
+    uv_once(&pool_once, pool_init);
+    
+    uv_mutex_lock(&pool_lock);
+    out->threads = thread_count;
+    out->idle_threads = idle_count;
+    out->completions = completions;
+    out->completion_wakeups = completion_wakeups;
+    for (int i = 0; i < THREAD_POOL_LANE_COUNT; i++) {
+        out->lanes[i].queued = lanes[i].queued;
+        out->lanes[i].running = lanes[i].running;
+        out->lanes[i].budget = lanes[i].budget;
+    }
+    uv_mutex_unlock(&pool_lock);
+}
+
+ThreadPoolLane thread_pool_lane_option(napi_env env, napi_value options, ThreadPoolLane fallback) {
+    napi_valuetype type = napi_undefined;
+    if (options != NULL) {
+        napi_typeof(env, options, &type);
+    }
+    if (type != napi_object) {
+        return fallback;
+    }
+    
+    char* lane = get_string_property(env, options, "lane");
+    ThreadPoolLane result = fallback;
+    if (lane != NULL && strcmp(lane, "metadata") == 0) {
+        result = THREAD_POOL_LANE_METADATA;
+    } else if (lane != NULL && strcmp(lane, "bulk") == 0) {
+        result = THREAD_POOL_LANE_BULK;
+    }
+    free(lane);
+    return result;
+}
+
+void thread_pool_configure(uint32_t metadata_size, uint32_t bulk_size, uint64_t idle_ms) {
+    uv_once(&pool_once, pool_init);
+    
+    uv_mutex_lock(&pool_lock);
+    lanes[THREAD_POOL_LANE_METADATA].budget = metadata_size;
+    lanes[THREAD_POOL_LANE_BULK].budget = bulk_size;
+    idle_timeout_ms = idle_ms;
+    reap_exited_threads();
+    /* Wake idle threads so surplus ones exit and the rest pick up the timeout */
+    uv_cond_broadcast(&pool_wake);
+    uv_mutex_unlock(&pool_lock);
+    
+    LOG_INFO("thread pool: metadata=%u bulk=%u idleTimeoutMs=%llu",
+             metadata_size, bulk_size, (unsigned long long)idle_ms);
+}
+
+void thread_pool_configure_completions(uint32_t delay_us, uint32_t batch) {
+    uv_once(&pool_once, pool_init);
+    
+    uv_mutex_lock(&pool_lock);
+    completion_delay_ns = (uint64_t)delay_us * 1000u;
+    completion_batch = batch;
+    if (delay_us == 0) {
+        /* Send the wake-ups still waiting on the old delay */
+        for (PoolEnv* owner = envs; owner != NULL; owner = owner->next) {
+            if (owner->flush_at != 0) {
+                wake_env(owner);
+            }
+        }
+    }
+    uv_cond_signal(&flush_wake);
+    uv_mutex_unlock(&pool_lock);
+    
+    LOG_INFO("thread pool: completionDelayUs=%u completionBatch=%u", delay_us, batch);
+}
+
+/* ========== napi_configure_thread_pool ========== */
+
+napi_value napi_configure_thread_pool(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1] = { NULL };
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    napi_valuetype type = napi_undefined;
+    if (argc >= 1) {
+        napi_typeof(env, argv[0], &type);
+    }
+    if (type != napi_object) {
+        napi_throw_type_error(env, NULL, "options must be an object");
+        return NULL;
+    }
+    
+    uv_once(&pool_once, pool_init);
+    uv_mutex_lock(&pool_lock);
+    int64_t size = lanes[THREAD_POOL_LANE_BULK].budget;
+    int64_t metadata_size = lanes[THREAD_POOL_LANE_METADATA].budget;
+    int64_t idle_ms = (int64_t)idle_timeout_ms;
+    int64_t delay_us = (int64_t)(completion_delay_ns / 1000u);
+    int64_t batch = completion_batch;
+    uv_mutex_unlock(&pool_lock);
+    
+    size = get_int64_property(env, argv[0], "size", size);
+    metadata_size = get_int64_property(env, argv[0], "metadataSize", metadata_size);
+    idle_ms = get_int64_property(env, argv[0], "idleTimeoutMs", idle_ms);
+    delay_us = get_int64_property(env, argv[0], "completionDelayUs", delay_us);
+    batch = get_int64_property(env, argv[0], "completionBatch", batch);
+    
+    if (size < 0 || size > THREAD_POOL_MAX_SIZE) {
+        napi_throw_range_error(env, NULL, "size must be between 0 and 1024");
+        return NULL;
+    }
+    if (metadata_size < 0 || metadata_size > THREAD_POOL_MAX_SIZE) {
+        napi_throw_range_error(env, NULL, "metadataSize must be between 0 and 1024");
+        return NULL;
+    }
+    if (idle_ms < 0) {
+        napi_throw_range_error(env, NULL, "idleTimeoutMs must not be negative");
+        return NULL;
+    }
+    if (delay_us < 0 || delay_us > THREAD_POOL_MAX_COMPLETION_DELAY_US) {
+        napi_throw_range_error(env, NULL, "completionDelayUs must be between 0 and 1000000");
+        return NULL;
+    }
+    if (batch < 1 || batch > THREAD_POOL_MAX_COMPLETION_BATCH) {
+        napi_throw_range_error(env, NULL, "completionBatch must be between 1 and 65536");
+        return NULL;
+    }
+    
+    thread_pool_configure((uint32_t)metadata_size, (uint32_t)size, (uint64_t)idle_ms);
+    thread_pool_configure_completions((uint32_t)delay_us, (uint32_t)batch);
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file thread_pool.h
+ * @brief Addon-owned worker pool for blocking uplink calls
+ *
+ * Uplink reads, writes and commits park their thread inside Go for as
+ * long as the network takes. On libuv's shared pool (4 threads by
+ * default) that starves fs, dns.lookup and zlib in the same process, so
+ * uplink work is queued here instead. The pool starts threads on demand
+ * and a thread exits after sitting idle for the idle timeout.
+ *
+ * Work is split into priority lanes, each with its own queue and its own
+ * budget of concurrently running jobs. Free threads serve the metadata
+ * lane first, so a stat or listing call never queues behind transfer
+ * reads and writes; a lane at its budget does not hold up the other.
+ *
+ * Lane budgets come from UPLINK_THREAD_POOL_SIZE (bulk),
+ * UPLINK_METADATA_THREAD_POOL_SIZE (metadata) or thread_pool_configure();
+ * a budget of 0 sends that lane's work back to the libuv pool.
+ *
+ * Completions are settled in batches: one main-thread wake-up runs the
+ * complete callbacks of every job that finished since the last one. A
+ * completion delay (thread_pool_configure_completions()) holds the
+ * wake-up back so that more jobs join the batch, at the cost of that
+ * much added latency per call. It comes from UPLINK_COMPLETION_DELAY_US
+ * and UPLINK_COMPLETION_BATCH, or thread_pool_configure_completions().
+ */
+
+#ifndef UPLINK_THREAD_POOL_H
+#define UPLINK_THREAD_POOL_H
+
+#include <node_api.h>
+#include <stdint.h>
+#include "op_metrics.h"
+
+/**
+ * Priority lanes, served in this order
+ */
+typedef enum {
+    THREAD_POOL_LANE_METADATA = 0,   /* short interactive calls: stat, list, open, info */
+    THREAD_POOL_LANE_BULK,           /* transfers and long-running batch operations */
+    THREAD_POOL_LANE_COUNT
+} ThreadPoolLane;
+
+/** Default budget of the bulk lane */
+#define THREAD_POOL_DEFAULT_SIZE 16
+
+/** Default budget of the metadata lane */
+#define THREAD_POOL_DEFAULT_METADATA_SIZE 8
+
+/** Upper bound accepted for a lane budget */
+#define THREAD_POOL_MAX_SIZE 1024
+
+/** Idle time after which a pool thread exits */
+#define THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS 30000
+
+/** Default number of finished jobs that wakes the main thread before the delay passes */
+#define THREAD_POOL_DEFAULT_COMPLETION_BATCH 256
+
+/** Upper bound accepted for the completion delay (us) */
+#define THREAD_POOL_MAX_COMPLETION_DELAY_US 1000000
+
+/** Upper bound accepted for the completion batch size */
+#define THREAD_POOL_MAX_COMPLETION_BATCH 65536
+
+/**
+ * Live counts of one lane
+ */
+typedef struct {
+    uint32_t queued;
+    uint32_t running;
+    uint32_t budget;
+} ThreadPoolLaneGauges;
+
+/**
+ * Live counts of the pool (process-wide)
+ */
+typedef struct {
+    uint32_t threads;
+    uint32_t idle_threads;
+    uint64_t completions;           /* Jobs handed back to the main thread since start */
+    uint64_t completion_wakeups;    /* Main-thread wake-ups that settled them */
+    ThreadPoolLaneGauges lanes[THREAD_POOL_LANE_COUNT];
+} ThreadPoolGauges;
+
+/**
+ * Set the lane budgets and the idle timeout
+ *
+ * Surplus threads exit once they finish their current job; growth
+ * happens on the next queued job.
+ *
+ * @param metadata_size Concurrent metadata jobs (0 = use the libuv pool)
+ * @param bulk_size Concurrent bulk jobs (0 = use the libuv pool)
+ * @param idle_timeout_ms Idle time after which a thread exits
+ */
+void thread_pool_configure(uint32_t metadata_size, uint32_t bulk_size, uint64_t idle_timeout_ms);
+
+/**
+ * Set how finished jobs are batched into main-thread wake-ups
+ *
+ * The first job to finish after a wake-up starts a delay of @p delay_us;
+ * the main thread is woken when it passes or when @p batch jobs are
+ * waiting, whichever comes first. A delay of 0 (the default) wakes it
+ * at once, still settling everything that finished in the meantime.
+ * A delay starts one flusher thread that lives until the process exits.
+ *
+ * @param delay_us Longest time a finished job waits for company (us)
+ * @param batch Waiting jobs that end the delay early (at least 1)
+ */
+void thread_pool_configure_completions(uint32_t delay_us, uint32_t batch);
+
+/**
+ * Create async work whose execute callback runs on the addon pool
+ *
+ * Drop-in replacement for napi_create_async_work + napi_queue_async_work.
+ * The handle stored in @p result is never queued with libuv but is still
+ * valid for napi_delete_async_work, so complete callbacks stay unchanged;
+ * they are called on the main thread with napi_ok. The job is timed
+ * under @p name (see op_metrics.h).
+ *
+ * @param env N-API environment
+ * @param lane Lane to queue on
+ * @param name Async resource name
+ * @param execute Worker thread callback
+ * @param complete Main thread callback
+ * @param data Passed to both callbacks
+ * @param result Receives the async work handle
+ * @return napi_ok on success
+ */
+napi_status thread_pool_queue_work(napi_env env, ThreadPoolLane lane, napi_value name,
+                                   napi_async_execute_callback execute,
+                                   napi_async_complete_callback complete,
+                                   void* data, napi_async_work* result);
+
+/**
+ * Queue a job on the addon pool without an async work handle
+ *
+ * Lighter variant of thread_pool_queue_work() for calls made at high
+ * rates, such as stream reads and writes: no napi_async_work and no JS
+ * name string are created per call, and the job is timed under the C
+ * string @p name. @p complete runs on the main thread with napi_ok and
+ * has no async work to delete. The job cannot be taken back with
+ * thread_pool_cancel(), so calls that attach a cancel token use
+ * thread_pool_queue_work(). When the lane's budget is 0 the job runs on
+ * the libuv pool through async work the pool creates and deletes itself.
+ *
+ * @param env N-API environment
+ * @param lane Lane to queue on
+ * @param name Operation name for metrics
+ * @param execute Worker thread callback
+ * @param complete Main thread callback
+ * @param data Passed to both callbacks
+ * @return napi_ok on success
+ */
+napi_status thread_pool_queue_job(napi_env env, ThreadPoolLane lane, const char* name,
+                                  napi_async_execute_callback execute,
+                                  napi_async_complete_callback complete, void* data);
+
+/**
+ * Run async work created elsewhere on the addon pool
+ *
+ * For callers that create the work up front and start it later (see
+ * admission.h). @p execute, @p complete and @p data must be the ones the
+ * work was created with; the work must not have been queued yet.
+ *
+ * @param env N-API environment
+ * @param lane Lane to queue on
+ * @param work Async work handle, not yet queued
+ * @param execute Worker thread callback of @p work
+ * @param complete Main thread callback of @p work
+ * @param data Data of @p work
+ * @param timer Started when the work was created, or NULL to not time it
+ * @return napi_ok on success
+ */
+napi_status thread_pool_submit(napi_env env, ThreadPoolLane lane, napi_async_work work,
+                               napi_async_execute_callback execute,
+                               napi_async_complete_callback complete,
+                               void* data, const OpTimer* timer);
+
+/**
+ * Take a job that has not started off its lane queue
+ *
+ * Its complete callback still runs on the main thread, later, with
+ * napi_cancelled (so REJECT_IF_CANCELLED applies). Work that is running
+ * or that went to the libuv pool is not affected.
+ *
+ * @param work Async work handle passed to thread_pool_queue_work() or thread_pool_submit()
+ * @return 0 if the job was dequeued, -1 if it was not waiting in the pool
+ */
+int thread_pool_cancel(napi_async_work work);
+
+/**
+ * Read the pool's thread and per-lane job counts (any thread)
+ */
+void thread_pool_gauges(ThreadPoolGauges* out);
+
+/**
+ * Read the per-call lane override from options.lane
+ *
+ * @param env N-API environment
+ * @param options Options object (NULL or non-objects yield @p fallback)
+ * @param fallback Lane used when options.lane is absent or not recognised
+ * @return THREAD_POOL_LANE_METADATA for 'metadata', THREAD_POOL_LANE_BULK for 'bulk'
+ */
+ThreadPoolLane thread_pool_lane_option(napi_env env, napi_value options, ThreadPoolLane fallback);
+
+/**
+ * N-API callback: configure the addon thread pool
+ *
+ * Exported as native.configureThreadPool({ size?, metadataSize?, idleTimeoutMs?,
+ * completionDelayUs?, completionBatch? }). size is the bulk lane budget.
+ * Omitted fields keep their current value.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [options]
+ * @return undefined
+ */
+napi_value napi_configure_thread_pool(napi_env env, napi_callback_info info);
+
+#endif /* UPLINK_THREAD_POOL_H */
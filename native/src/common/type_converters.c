@@ -72,3 +72,13 @@ int64_t get_date_property(napi_env env, napi_value obj, const char* name, int64_
     /* Convert milliseconds to seconds */
     return (int64_t)(date_value / 1000);
 }
+
+bool has_defined_property(napi_env env, napi_value obj, const char* name) {
+    napi_value js_val;
+    napi_status status = napi_get_named_property(env, obj, name, &js_val);
+    if (status != napi_ok) return false;
+    
+    napi_valuetype type;
+    napi_typeof(env, js_val, &type);
+    return type != napi_undefined && type != napi_null;
+}
@@ -11,6 +11,7 @@
 #include <node_api.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 /* ==================== Property Helpers ==================== */
 
@@ -35,4 +36,9 @@ int get_bool_property(napi_env env, napi_value obj, const char* name, int defaul
  */
 int64_t get_date_property(napi_env env, napi_value obj, const char* name, int64_t default_val);
 
+/**
+ * Check whether a property is set to anything other than undefined or null
+ */
+bool has_defined_property(napi_env env, napi_value obj, const char* name);
+
 #endif /* UPLINK_TYPE_CONVERTERS_H */
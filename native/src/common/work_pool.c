@@ -0,0 +1,149 @@
+/**
+ * @file work_pool.c
+ * @brief Small-object pool for async work data implementation
+ * 
+ * Laid out like buffer_pool.c: each block carries a header recording its
+ * size class, and free blocks are kept on a per-class intrusive list up
+ * to a per-class cap. Blocks are zeroed on the way out, so callers can
+ * treat the pool as a drop-in calloc.
+ */
+
+#include "work_pool.h"
+
+#include <uv.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Class index stored for allocations too large for any class */
+#define WORK_POOL_UNPOOLED UINT32_MAX
+
+/** Header in front of every allocation; keeps data 16-byte aligned */
+typedef union {
+    struct {
+        uint32_t size_class;
+    } info;
+    max_align_t align;
+    uint8_t pad[16];
+} WorkHeader;
+
+typedef struct WorkFree {
+    struct WorkFree* next;
+} WorkFree;
+
+typedef struct {
+    size_t block_size;
+    uint32_t max_cached;
+    uint32_t cached;
+    WorkFree* free_list;
+} WorkClass;
+
+static WorkClass work_classes[] = {
+    { 64,   64, 0, NULL },
+    { 128,  64, 0, NULL },
+    { 256,  64, 0, NULL },
+    { 512,  32, 0, NULL },
+    { 1024, 16, 0, NULL },
+};
+
+#define WORK_CLASS_COUNT (sizeof(work_classes) / sizeof(work_classes[0]))
+
+static uv_once_t work_once = UV_ONCE_INIT;
+static uv_mutex_t work_lock;
+static WorkPoolStats work_stats;
+
+static void work_pool_init(void) {
+    uv_mutex_init(&work_lock);
+}
+
+void* work_pool_calloc(size_t count, size_t size) {
+    if (size != 0 && count > (SIZE_MAX - sizeof(WorkHeader)) / size) {
+        return NULL;
+    }
+    size_t bytes = count * size;
+    
+    uint32_t index = WORK_POOL_UNPOOLED;
+    for (uint32_t i = 0; i < WORK_CLASS_COUNT; i++) {
+        if (bytes <= work_classes[i].block_size) {
+            index = i;
+            break;
+        }
+    }
+    
+    uv_once(&work_once, work_pool_init);
+    
+    if (index == WORK_POOL_UNPOOLED) {
+        uv_mutex_lock(&work_lock);
+        work_stats.oversize++;
+        uv_mutex_unlock(&work_lock);
+        WorkHeader* header = (WorkHeader*)calloc(1, sizeof(WorkHeader) + bytes);
+        if (header == NULL) {
+            return NULL;
+        }
+        header->info.size_class = WORK_POOL_UNPOOLED;
+        return header + 1;
+    }
+    
+    WorkClass* cls = &work_classes[index];
+    
+    uv_mutex_lock(&work_lock);
+    WorkFree* block = cls->free_list;
+    if (block != NULL) {
+        cls->free_list = block->next;
+        cls->cached--;
+        work_stats.cached--;
+        work_stats.hits++;
+    } else {
+        work_stats.misses++;
+    }
+    uv_mutex_unlock(&work_lock);
+    
+    if (block != NULL) {
+        memset(block, 0, cls->block_size);
+        return block;
+    }
+    
+    WorkHeader* header = (WorkHeader*)calloc(1, sizeof(WorkHeader) + cls->block_size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->info.size_class = index;
+    return header + 1;
+}
+
+void work_pool_free(void* data) {
+    if (data == NULL) {
+        return;
+    }
+    
+    WorkHeader* header = (WorkHeader*)data - 1;
+    uint32_t index = header->info.size_class;
+    if (index >= WORK_CLASS_COUNT) {
+        free(header);
+        return;
+    }
+    
+    uv_once(&work_once, work_pool_init);
+    WorkClass* cls = &work_classes[index];
+    
+    uv_mutex_lock(&work_lock);
+    if (cls->cached < cls->max_cached) {
+        WorkFree* block = (WorkFree*)data;
+        block->next = cls->free_list;
+        cls->free_list = block;
+        cls->cached++;
+        work_stats.cached++;
+        data = NULL;
+    }
+    uv_mutex_unlock(&work_lock);
+    
+    if (data != NULL) {
+        free(header);
+    }
+}
+
+void work_pool_stats(WorkPoolStats* stats) {
+    uv_once(&work_once, work_pool_init);
+    uv_mutex_lock(&work_lock);
+    *stats = work_stats;
+    uv_mutex_unlock(&work_lock);
+}
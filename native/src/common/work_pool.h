@@ -0,0 +1,43 @@
+/**
+ * @file work_pool.h
+ * @brief Small-object pool for async work data in uplink-nodejs native module
+ * 
+ * The stream read and write calls allocate a work struct (and, for
+ * writev, its per-buffer arrays) on every call. These come from a
+ * size-classed free list instead, so a steady stream of reads or writes
+ * allocates nothing natively once the pool is warm. Requests above the
+ * largest class fall through to calloc. Safe to call from worker threads.
+ */
+
+#ifndef UPLINK_WORK_POOL_H
+#define UPLINK_WORK_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Pool counters since process start */
+typedef struct {
+    uint64_t hits;                  /**< Allocations served from a free list */
+    uint64_t misses;                /**< Allocations that needed a fresh block */
+    uint64_t oversize;              /**< Allocations too large for any class */
+    uint32_t cached;                /**< Blocks currently on free lists */
+} WorkPoolStats;
+
+/**
+ * Get @p count zeroed elements of @p size bytes, like calloc
+ * 
+ * @return Zeroed memory, or NULL on OOM or overflow
+ */
+void* work_pool_calloc(size_t count, size_t size);
+
+/**
+ * Return memory obtained from work_pool_calloc (NULL is a no-op)
+ */
+void work_pool_free(void* data);
+
+/**
+ * Snapshot the pool counters
+ */
+void work_pool_stats(WorkPoolStats* stats);
+
+#endif /* UPLINK_WORK_POOL_H */
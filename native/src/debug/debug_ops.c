@@ -9,6 +9,9 @@
 #include "../common/logger.h"
 #include "../common/error_registry.h"
 #include "../common/string_helpers.h"
+#include "../common/handle_helpers.h"
+#include "../common/work_pool.h"
+#include "../common/native_alloc.h"
 
 /* Disable compat macros to avoid function name conflicts */
 #define UPLINK_DISABLE_NAMESPACE_COMPAT
@@ -201,3 +204,64 @@ napi_value test_throw_typed_error(napi_env env, napi_callback_info info) {
 
     return promise;
 }
+
+/* ========== handleStats ========== */
+
+napi_value napi_handle_stats(napi_env env, napi_callback_info info) {
+    (void)info;
+
+    napi_value result, value;
+    uint32_t total = 0;
+    napi_create_object(env, &result);
+    for (int type = 0; type < HANDLE_TYPE_COUNT; type++) {
+        uint32_t live = handle_live_count(env, (HandleType)type);
+        total += live;
+        napi_create_uint32(env, live, &value);
+        napi_set_named_property(env, result, get_handle_type_key((HandleType)type), value);
+    }
+    napi_create_uint32(env, total, &value);
+    napi_set_named_property(env, result, "total", value);
+    return result;
+}
+
+/* ========== workPoolStats ========== */
+
+napi_value napi_work_pool_stats(napi_env env, napi_callback_info info) {
+    (void)info;
+
+    WorkPoolStats stats;
+    work_pool_stats(&stats);
+
+    napi_value result, value;
+    napi_create_object(env, &result);
+    napi_create_double(env, (double)stats.hits, &value);
+    napi_set_named_property(env, result, "hits", value);
+    napi_create_double(env, (double)stats.misses, &value);
+    napi_set_named_property(env, result, "misses", value);
+    napi_create_double(env, (double)stats.oversize, &value);
+    napi_set_named_property(env, result, "oversize", value);
+    napi_create_uint32(env, stats.cached, &value);
+    napi_set_named_property(env, result, "cached", value);
+    return result;
+}
+
+/* ========== nativeAllocStats ========== */
+
+napi_value napi_native_alloc_stats(napi_env env, napi_callback_info info) {
+    (void)info;
+
+    NativeAllocStats stats;
+    native_alloc_stats(&stats);
+
+    napi_value result, value;
+    napi_create_object(env, &result);
+    napi_create_double(env, (double)stats.allocations, &value);
+    napi_set_named_property(env, result, "allocations", value);
+    napi_create_double(env, (double)stats.frees, &value);
+    napi_set_named_property(env, result, "frees", value);
+    napi_create_double(env, (double)stats.live_bytes, &value);
+    napi_set_named_property(env, result, "liveBytes", value);
+    napi_create_double(env, (double)stats.peak_bytes, &value);
+    napi_set_named_property(env, result, "peakBytes", value);
+    return result;
+}
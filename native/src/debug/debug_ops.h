@@ -31,4 +31,30 @@ napi_value internal_universe_is_empty(napi_env env, napi_callback_info info);
  */
 napi_value test_throw_typed_error(napi_env env, napi_callback_info info);
 
+/**
+ * Count live native handles in this environment, by type.
+ * JS: handleStats() -> { access, project, download, upload, ..., total }
+ *
+ * Handles are counted from creation until their JS external is
+ * collected, so a count that keeps growing points at a leak.
+ */
+napi_value napi_handle_stats(napi_env env, napi_callback_info info);
+
+/**
+ * Counters of the process-wide work data pool.
+ * JS: workPoolStats() -> { hits, misses, oversize, cached }
+ *
+ * Once a stream has warmed up, reads and writes are all hits.
+ */
+napi_value napi_work_pool_stats(napi_env env, napi_callback_info info);
+
+/**
+ * Counters of the process-wide native heap accounting (native_alloc.h).
+ * JS: nativeAllocStats() -> { allocations, frees, liveBytes, peakBytes }
+ *
+ * liveBytes covers every malloc'd block of the addon; a value that keeps
+ * growing across repeated operations is a native leak.
+ */
+napi_value napi_native_alloc_stats(napi_env env, napi_callback_info info);
+
 #endif /* UPLINK_DEBUG_OPS_H */
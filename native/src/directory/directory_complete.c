@@ -0,0 +1,191 @@
+/**
+ * @file directory_complete.c
+ * @brief Main thread completion handlers for directory transfer operations
+ */
+
+#include "directory_complete.h"
+#include "directory_types.h"
+#include "../common/result_helpers.h"
+#include "../common/error_registry.h"
+#include "../common/cancel_helpers.h"
+#include "../common/string_helpers.h"
+#include "../common/stat_cache.h"
+#include "../common/logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static void set_count_property(napi_env env, napi_value obj, const char* name, uint64_t count) {
+    napi_value value;
+    napi_create_double(env, (double)count, &value);
+    napi_set_named_property(env, obj, name, value);
+}
+
+/* ========== upload_directory progress ========== */
+
+void upload_directory_progress_js(napi_env env, napi_value js_callback, void* context, void* data) {
+    (void)context;
+    UploadDirectoryProgress* progress = (UploadDirectoryProgress*)data;
+    
+    /* env is NULL when the function is being torn down */
+    if (env != NULL && js_callback != NULL) {
+        napi_value obj, undefined;
+        napi_create_object(env, &obj);
+        set_count_property(env, obj, "filesDone", progress->files_done);
+        set_count_property(env, obj, "filesTotal", progress->files_total);
+        set_count_property(env, obj, "bytesDone", progress->bytes_done);
+        set_count_property(env, obj, "bytesTotal", progress->bytes_total);
+        set_count_property(env, obj, "failed", progress->failed);
+        napi_get_undefined(env, &undefined);
+        if (napi_call_function(env, undefined, js_callback, 1, &obj, NULL) != napi_ok) {
+            LOG_WARN("uploadDirectory: onProgress threw");
+        }
+    }
+    free(progress);
+}
+
+/* ========== upload_directory_complete ========== */
+
+void upload_directory_complete(napi_env env, napi_status status, void* data) {
+    UploadDirectoryData* work_data = (UploadDirectoryData*)data;
+    
+    /* Queued progress calls are still delivered before the function is finalized */
+    if (work_data->progress != NULL) {
+        napi_release_threadsafe_function(work_data->progress, napi_tsfn_release);
+    }
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "uploadDirectory", work_data->cancel);
+    stat_cache_invalidate_prefix(work_data->project_handle, work_data->bucket_name, work_data->prefix);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("uploadDirectory: failed - %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    napi_value result, failures;
+    napi_create_object(env, &result);
+    set_count_property(env, result, "files", work_data->totals.files_total);
+    set_count_property(env, result, "bytes", work_data->totals.bytes_done);
+    set_count_property(env, result, "uploaded", work_data->totals.files_done - work_data->totals.failed);
+    set_count_property(env, result, "failed", work_data->totals.failed);
+    
+    napi_create_array_with_length(env, work_data->failure_count, &failures);
+    for (size_t i = 0; i < work_data->failure_count; i++) {
+        UploadDirectoryFailure* failure = &work_data->failures[i];
+        napi_value entry, path_value, code_value, message_value;
+        napi_create_object(env, &entry);
+        napi_create_string_utf8(env, failure->relative_path ? failure->relative_path : "",
+                                NAPI_AUTO_LENGTH, &path_value);
+        napi_create_int32(env, failure->code, &code_value);
+        napi_create_string_utf8(env, failure->message ? failure->message : "", NAPI_AUTO_LENGTH, &message_value);
+        napi_set_named_property(env, entry, "path", path_value);
+        napi_set_named_property(env, entry, "code", code_value);
+        napi_set_named_property(env, entry, "message", message_value);
+        napi_set_element(env, failures, (uint32_t)i, entry);
+    }
+    napi_set_named_property(env, result, "failures", failures);
+    
+    LOG_INFO("uploadDirectory: '%s' -> '%s/%s' %llu files, %llu bytes, %llu failed",
+             work_data->local_dir, work_data->bucket_name, work_data->prefix,
+             (unsigned long long)work_data->totals.files_total,
+             (unsigned long long)work_data->totals.bytes_done,
+             (unsigned long long)work_data->totals.failed);
+    napi_resolve_deferred(env, work_data->deferred, result);
+    
+cleanup:
+    for (size_t i = 0; i < work_data->file_count; i++) {
+        free(work_data->files[i].relative_path);
+        free(work_data->files[i].full_path);
+    }
+    free(work_data->files);
+    if (work_data->failures != NULL) {
+        for (size_t i = 0; i < work_data->failure_count; i++) {
+            free(work_data->failures[i].relative_path);
+            free(work_data->failures[i].message);
+        }
+        free(work_data->failures);
+    }
+    free_string_array(work_data->include, work_data->include_count);
+    free(work_data->error_message);
+    free(work_data->local_dir);
+    free(work_data->bucket_name);
+    free(work_data->prefix);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== diff_directory_complete ========== */
+
+static napi_value diff_entries_to_js(napi_env env, const DiffEntryList* list, size_t prefix_length, bool uploads) {
+    napi_value array;
+    napi_create_array_with_length(env, list->count, &array);
+    for (size_t i = 0; i < list->count; i++) {
+        const DiffEntry* item = &list->items[i];
+        napi_value entry, value;
+        napi_create_object(env, &entry);
+        napi_create_string_utf8(env, item->key, NAPI_AUTO_LENGTH, &value);
+        napi_set_named_property(env, entry, "key", value);
+        if (uploads) {
+            napi_create_string_utf8(env, item->key + prefix_length, NAPI_AUTO_LENGTH, &value);
+            napi_set_named_property(env, entry, "path", value);
+        }
+        set_count_property(env, entry, "size", (uint64_t)(item->size > 0 ? item->size : 0));
+        if (uploads) {
+            napi_create_string_utf8(env, item->changed ? "changed" : "new", NAPI_AUTO_LENGTH, &value);
+            napi_set_named_property(env, entry, "reason", value);
+        }
+        napi_set_element(env, array, (uint32_t)i, entry);
+    }
+    return array;
+}
+
+static void diff_list_free(DiffEntryList* list) {
+    for (size_t i = 0; i < list->count; i++) {
+        free(list->items[i].key);
+    }
+    free(list->items);
+}
+
+void diff_directory_complete(napi_env env, napi_status status, void* data) {
+    DiffDirectoryData* work_data = (DiffDirectoryData*)data;
+    
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "diffDirectory", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("diffDirectory: failed - %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    size_t prefix_length = strlen(work_data->prefix);
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_set_named_property(env, result, "upload", diff_entries_to_js(env, &work_data->uploads, prefix_length, true));
+    napi_set_named_property(env, result, "delete", diff_entries_to_js(env, &work_data->deletes, prefix_length, false));
+    set_count_property(env, result, "unchanged", work_data->unchanged);
+    set_count_property(env, result, "uploadBytes", work_data->uploads.bytes);
+    set_count_property(env, result, "deleteBytes", work_data->deletes.bytes);
+    set_count_property(env, result, "localFiles", work_data->local_files);
+    set_count_property(env, result, "remoteObjects", work_data->remote_objects);
+    
+    LOG_INFO("diffDirectory: '%s' vs '%s/%s' %zu to upload, %zu to delete, %llu unchanged%s",
+             work_data->local_dir, work_data->bucket_name, work_data->prefix,
+             work_data->uploads.count, work_data->deletes.count, (unsigned long long)work_data->unchanged,
+             work_data->sorted_in_memory ? " (listing sorted in memory)" : "");
+    napi_resolve_deferred(env, work_data->deferred, result);
+    
+cleanup:
+    diff_list_free(&work_data->uploads);
+    diff_list_free(&work_data->deletes);
+    free_string_array(work_data->include, work_data->include_count);
+    free(work_data->error_message);
+    free(work_data->local_dir);
+    free(work_data->bucket_name);
+    free(work_data->prefix);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
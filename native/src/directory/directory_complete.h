@@ -0,0 +1,26 @@
+/**
+ * @file directory_complete.h
+ * @brief Completion handler declarations for directory transfer operations
+ */
+
+#ifndef DIRECTORY_COMPLETE_H
+#define DIRECTORY_COMPLETE_H
+
+#include <node_api.h>
+
+/**
+ * @brief Complete upload_directory on main thread
+ */
+void upload_directory_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Threadsafe-function callback that delivers an UploadDirectoryProgress to onProgress
+ */
+void upload_directory_progress_js(napi_env env, napi_value js_callback, void* context, void* data);
+
+/**
+ * @brief Complete diff_directory on main thread
+ */
+void diff_directory_complete(napi_env env, napi_status status, void* data);
+
+#endif /* DIRECTORY_COMPLETE_H */
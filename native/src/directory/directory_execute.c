@@ -0,0 +1,726 @@
+/**
+ * @file directory_execute.c
+ * @brief Worker thread execute functions for directory transfer operations
+ *
+ * Each file is uploaded by running the existing single-object engines
+ * synchronously on a native thread: upload_file_execute for small files
+ * and upload_parallel_execute for files over the large-file threshold.
+ */
+
+#include "directory_execute.h"
+#include "directory_types.h"
+#include "../upload/upload_types.h"
+#include "../upload/upload_execute.h"
+#include "../multipart/multipart_types.h"
+#include "../multipart/multipart_execute.h"
+#include "../common/file_helpers.h"
+#include "../common/checksum.h"
+#include "../common/result_helpers.h"
+#include "../common/logger.h"
+
+#include <uv.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========== include filter ========== */
+
+/**
+ * Match @p text against a glob: `*` and `?` stay within one path segment,
+ * `**` crosses segments, and `**` followed by `/` also matches zero segments.
+ */
+static bool glob_match(const char* pattern, const char* text) {
+    while (*pattern != '\0') {
+        if (pattern[0] == '*' && pattern[1] == '*') {
+            const char* rest = pattern + 2;
+            if (*rest == '/' && glob_match(rest + 1, text)) {
+                return true;
+            }
+            for (const char* s = text; ; s++) {
+                if (glob_match(rest, s)) return true;
+                if (*s == '\0') return false;
+            }
+        }
+        if (*pattern == '*') {
+            for (const char* s = text; ; s++) {
+                if (glob_match(pattern + 1, s)) return true;
+                if (*s == '\0' || *s == '/') return false;
+            }
+        }
+        if (*text == '\0') return false;
+        if (*pattern == '?' ? *text == '/' : *pattern != *text) return false;
+        pattern++;
+        text++;
+    }
+    return *text == '\0';
+}
+
+/* ========== directory walk ========== */
+
+typedef struct {
+    UploadDirectoryData* job;
+    size_t capacity;
+    bool out_of_memory;
+} DirectoryWalk;
+
+static int collect_file(const char* relative_path, const char* full_path, int64_t size, void* ctx) {
+    DirectoryWalk* walk = (DirectoryWalk*)ctx;
+    UploadDirectoryData* job = walk->job;
+    
+    if (job->include_count > 0) {
+        bool included = false;
+        for (size_t i = 0; i < job->include_count && !included; i++) {
+            included = glob_match(job->include[i], relative_path);
+        }
+        if (!included) return 0;
+    }
+    
+    if (job->file_count == walk->capacity) {
+        size_t capacity = walk->capacity > 0 ? walk->capacity * 2 : 256;
+        DirectoryFile* files = (DirectoryFile*)realloc(job->files, capacity * sizeof(DirectoryFile));
+        if (files == NULL) {
+            walk->out_of_memory = true;
+            return 1;
+        }
+        job->files = files;
+        walk->capacity = capacity;
+    }
+    
+    DirectoryFile* file = &job->files[job->file_count];
+    file->relative_path = strdup(relative_path);
+    file->full_path = strdup(full_path);
+    file->size = size;
+    if (file->relative_path == NULL || file->full_path == NULL) {
+        free(file->relative_path);
+        free(file->full_path);
+        walk->out_of_memory = true;
+        return 1;
+    }
+    job->file_count++;
+    return 0;
+}
+
+/** Fill in the paths and sizes of the files given in options.files */
+static int stat_listed_files(UploadDirectoryData* job) {
+    for (size_t i = 0; i < job->file_count; i++) {
+        DirectoryFile* file = &job->files[i];
+        size_t length = strlen(job->local_dir) + 1 + strlen(file->relative_path) + 1;
+        file->full_path = (char*)malloc(length);
+        if (file->full_path == NULL) {
+            return -1;
+        }
+        snprintf(file->full_path, length, "%s/%s", job->local_dir, file->relative_path);
+    
+        /* One that cannot be opened stays with size 0; its upload records the failure */
+        int fd = file_open_read(file->full_path);
+        file->size = fd >= 0 ? file_size(fd) : 0;
+        if (file->size < 0) {
+            file->size = 0;
+        }
+        file_close(fd);
+    }
+    return 0;
+}
+
+/** Largest first, so big files start early and do not trail the batch */
+static int compare_size_desc(const void* a, const void* b) {
+    int64_t size_a = ((const DirectoryFile*)a)->size;
+    int64_t size_b = ((const DirectoryFile*)b)->size;
+    return size_a < size_b ? 1 : (size_a > size_b ? -1 : 0);
+}
+
+/* ========== file uploads ========== */
+
+/**
+ * Shared state of the file threads. Small files are claimed from
+ * next_small upwards under the lock; counters and progress are updated
+ * under the same lock.
+ */
+typedef struct {
+    UploadDirectoryData* job;
+    uv_mutex_t lock;
+    size_t next_small;
+    uint64_t last_progress;         /* uv_hrtime() of the last progress post */
+} UploadDirectoryState;
+
+/** Post the current totals to onProgress; call with the lock held */
+static void post_progress(UploadDirectoryState* state, bool force) {
+    UploadDirectoryData* job = state->job;
+    if (job->progress == NULL) return;
+    
+    uint64_t now = uv_hrtime();
+    if (!force && now - state->last_progress < (uint64_t)UPLOAD_DIRECTORY_PROGRESS_INTERVAL_MS * 1000000u) {
+        return;
+    }
+    UploadDirectoryProgress* snapshot = (UploadDirectoryProgress*)malloc(sizeof(UploadDirectoryProgress));
+    if (snapshot == NULL) return;
+    *snapshot = job->totals;
+    if (napi_call_threadsafe_function(job->progress, snapshot, napi_tsfn_nonblocking) != napi_ok) {
+        free(snapshot);
+        return;
+    }
+    state->last_progress = now;
+}
+
+static void record_result(UploadDirectoryState* state, const DirectoryFile* file, int32_t code, const char* message) {
+    UploadDirectoryData* job = state->job;
+    
+    uv_mutex_lock(&state->lock);
+    job->totals.files_done++;
+    if (code == 0) {
+        job->totals.bytes_done += (uint64_t)file->size;
+    } else {
+        job->totals.failed++;
+        LOG_WARN("uploadDirectory: '%s' failed: %s", file->relative_path, message ? message : "unknown error");
+        if (job->failure_count < UPLOAD_DIRECTORY_MAX_FAILURES) {
+            UploadDirectoryFailure* failure = &job->failures[job->failure_count++];
+            failure->relative_path = strdup(file->relative_path);
+            failure->code = code;
+            failure->message = strdup(message ? message : "unknown error");
+        }
+    }
+    post_progress(state, false);
+    uv_mutex_unlock(&state->lock);
+}
+
+static void upload_one_file(UploadDirectoryState* state, const DirectoryFile* file) {
+    UploadDirectoryData* job = state->job;
+    
+    size_t key_length = strlen(job->prefix) + strlen(file->relative_path) + 1;
+    char* key = (char*)malloc(key_length);
+    if (key == NULL) {
+        record_result(state, file, UPLINK_ERROR_INTERNAL, "Out of memory");
+        return;
+    }
+    snprintf(key, key_length, "%s%s", job->prefix, file->relative_path);
+    
+    if ((uint64_t)file->size >= job->large_file_threshold) {
+        UploadParallelData parallel;
+        memset(&parallel, 0, sizeof(parallel));
+        parallel.project_handle = job->project_handle;
+        parallel.bucket_name = job->bucket_name;
+        parallel.object_key = key;
+        parallel.file_path = file->full_path;
+        parallel.part_size = PARALLEL_UPLOAD_DEFAULT_PART_SIZE;
+        parallel.concurrency = job->part_concurrency;
+        parallel.max_retries = PARALLEL_UPLOAD_DEFAULT_RETRIES;
+        parallel.cancel = job->cancel;
+        upload_parallel_execute(NULL, &parallel);
+    
+        if (parallel.error_code != 0) {
+            record_result(state, file, parallel.error_code, parallel.error_message);
+        } else if (parallel.result.error != NULL) {
+            record_result(state, file, parallel.result.error->code, parallel.result.error->message);
+        } else {
+            record_result(state, file, 0, NULL);
+        }
+        if (parallel.error_code == 0) {
+            uplink_free_commit_upload_result(parallel.result);
+        }
+        free(parallel.error_message);
+    } else {
+        UploadFileData single;
+        memset(&single, 0, sizeof(single));
+        single.project_handle = job->project_handle;
+        single.bucket_name = job->bucket_name;
+        single.object_key = key;
+        single.file_path = file->full_path;
+        single.chunk_size = UPLOAD_FILE_DEFAULT_CHUNK_SIZE;
+        single.cancel = job->cancel;
+        upload_file_execute(NULL, &single);
+    
+        if (single.error_code != 0) {
+            record_result(state, file, single.error_code, single.error_message);
+        } else {
+            /* The object is committed; a failed info lookup does not undo that */
+            record_result(state, file, 0, NULL);
+            uplink_free_object_result(single.info);
+        }
+        free(single.error_message);
+    }
+    
+    free(key);
+}
+
+/**
+ * Native file thread: claims small files until none remain.
+ */
+static void upload_directory_worker(void* arg) {
+    UploadDirectoryState* state = (UploadDirectoryState*)arg;
+    UploadDirectoryData* job = state->job;
+    
+    for (;;) {
+        uv_mutex_lock(&state->lock);
+        if (state->next_small >= job->file_count || cancel_token_is_cancelled(job->cancel)) {
+            uv_mutex_unlock(&state->lock);
+            break;
+        }
+        size_t index = state->next_small++;
+        uv_mutex_unlock(&state->lock);
+    
+        upload_one_file(state, &job->files[index]);
+    }
+}
+
+void upload_directory_execute(napi_env env, void* data) {
+    (void)env;
+    UploadDirectoryData* work_data = (UploadDirectoryData*)data;
+    
+    LOG_DEBUG("uploadDirectory: walking '%s' for '%s/%s' (worker thread)",
+              work_data->local_dir, work_data->bucket_name, work_data->prefix);
+    
+    DirectoryWalk walk = { work_data, 0, false };
+    if (work_data->listed) {
+        walk.out_of_memory = stat_listed_files(work_data) != 0;
+    } else if (file_walk_tree(work_data->local_dir, collect_file, &walk) < 0) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup(strerror(errno));
+        return;
+    }
+    work_data->failures = (UploadDirectoryFailure*)calloc(UPLOAD_DIRECTORY_MAX_FAILURES, sizeof(UploadDirectoryFailure));
+    if (walk.out_of_memory || work_data->failures == NULL) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("Out of memory");
+        return;
+    }
+    
+    qsort(work_data->files, work_data->file_count, sizeof(DirectoryFile), compare_size_desc);
+    
+    size_t large_count = 0;
+    work_data->totals.files_total = work_data->file_count;
+    for (size_t i = 0; i < work_data->file_count; i++) {
+        work_data->totals.bytes_total += (uint64_t)work_data->files[i].size;
+        if ((uint64_t)work_data->files[i].size >= work_data->large_file_threshold) {
+            large_count++;
+        }
+    }
+    
+    LOG_DEBUG("uploadDirectory: %zu files (%zu large), %llu bytes, concurrency=%u",
+              work_data->file_count, large_count,
+              (unsigned long long)work_data->totals.bytes_total, work_data->concurrency);
+    
+    UploadDirectoryState state;
+    memset(&state, 0, sizeof(state));
+    state.job = work_data;
+    state.next_small = large_count;
+    uv_mutex_init(&state.lock);
+    
+    /* Small files on native threads, while this thread takes the large ones */
+    size_t small_count = work_data->file_count - large_count;
+    uint32_t thread_count = work_data->concurrency < small_count ? work_data->concurrency : (uint32_t)small_count;
+    uv_thread_t* threads = thread_count > 0 ? (uv_thread_t*)calloc(thread_count, sizeof(uv_thread_t)) : NULL;
+    uint32_t started = 0;
+    if (threads != NULL) {
+        for (uint32_t i = 0; i < thread_count; i++) {
+            if (uv_thread_create(&threads[i], upload_directory_worker, &state) != 0) {
+                LOG_WARN("uploadDirectory: could only start %u of %u threads", started, thread_count);
+                break;
+            }
+            started++;
+        }
+    }
+    
+    for (size_t i = 0; i < large_count && !cancel_token_is_cancelled(work_data->cancel); i++) {
+        upload_one_file(&state, &work_data->files[i]);
+    }
+    upload_directory_worker(&state);  /* Help with what is left of the small files */
+    
+    for (uint32_t i = 0; i < started; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    free(threads);
+    
+    /* Files already committed stay; the call itself reports the abort */
+    cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message);
+    
+    uv_mutex_lock(&state.lock);
+    post_progress(&state, true);
+    uv_mutex_unlock(&state.lock);
+    uv_mutex_destroy(&state.lock);
+}
+
+/* ========== diff_directory ========== */
+
+/**
+ * One object of the listing, copied out so the listing item can be freed
+ */
+typedef struct {
+    char* key;
+    int64_t size;
+    int64_t created;
+    ChecksumType digest_type;       /* CHECKSUM_NONE when the object has no checksum metadata */
+    char* digest;
+} DiffRemote;
+
+/**
+ * Merge state: the local walk pushes files, the remote side is pulled
+ * from the listing (or from the sorted copy of it) to catch up.
+ */
+typedef struct {
+    DiffDirectoryData* job;
+    size_t prefix_length;
+    UplinkObjectIterator* iterator; /* Streaming source, or NULL */
+    DiffRemote* sorted;             /* In-memory source once the listing was out of order */
+    size_t sorted_count;
+    size_t sorted_next;
+    DiffRemote current;
+    bool has_current;
+    char* last_key;                 /* Previous streamed key, to check the order */
+    bool unordered;
+    uint8_t* chunk;                 /* Hash read buffer, allocated on first use */
+} DiffMerge;
+
+static void diff_set_error(DiffDirectoryData* job, int32_t code, const char* message) {
+    if (job->error_code != 0) return;
+    job->error_code = code;
+    job->error_message = strdup(message);
+}
+
+static void diff_remote_free(DiffRemote* remote) {
+    free(remote->key);
+    free(remote->digest);
+    memset(remote, 0, sizeof(*remote));
+}
+
+static void diff_list_clear(DiffEntryList* list) {
+    for (size_t i = 0; i < list->count; i++) {
+        free(list->items[i].key);
+    }
+    free(list->items);
+    memset(list, 0, sizeof(*list));
+}
+
+/** Plan an entry, taking @p key */
+static bool diff_plan(DiffDirectoryData* job, DiffEntryList* list, char* key, int64_t size, bool changed) {
+    if (key != NULL && list->count == list->capacity) {
+        size_t capacity = list->capacity > 0 ? list->capacity * 2 : 64;
+        DiffEntry* items = (DiffEntry*)realloc(list->items, capacity * sizeof(DiffEntry));
+        if (items == NULL) {
+            free(key);
+            key = NULL;
+        } else {
+            list->items = items;
+            list->capacity = capacity;
+        }
+    }
+    if (key == NULL) {
+        diff_set_error(job, UPLINK_ERROR_INTERNAL, "Out of memory");
+        return false;
+    }
+    list->items[list->count].key = key;
+    list->items[list->count].size = size;
+    list->items[list->count].changed = changed;
+    list->count++;
+    list->bytes += (uint64_t)(size > 0 ? size : 0);
+    return true;
+}
+
+static bool diff_included(const DiffDirectoryData* job, const char* relative_path) {
+    if (job->include_count == 0) return true;
+    for (size_t i = 0; i < job->include_count; i++) {
+        if (glob_match(job->include[i], relative_path)) return true;
+    }
+    return false;
+}
+
+/** Copy a listed object, with its checksum metadata when comparing checksums */
+static bool diff_remote_from_object(const DiffDirectoryData* job, const UplinkObject* object, DiffRemote* out) {
+    memset(out, 0, sizeof(*out));
+    out->key = strdup(object->key);
+    out->size = object->system.content_length;
+    out->created = object->system.created;
+    if (out->key == NULL) return false;
+    if (job->compare != DIFF_COMPARE_CHECKSUM) return true;
+    
+    static const ChecksumType preferred[] = { CHECKSUM_SHA256, CHECKSUM_CRC32C };
+    for (size_t p = 0; p < sizeof(preferred) / sizeof(preferred[0]) && out->digest == NULL; p++) {
+        char name[32];
+        snprintf(name, sizeof(name), "%s%s", UPLOAD_CHECKSUM_KEY_PREFIX, checksum_type_name(preferred[p]));
+        for (size_t i = 0; i < object->custom.count; i++) {
+            const UplinkCustomMetadataEntry* entry = &object->custom.entries[i];
+            if (entry->key_length == strlen(name) && memcmp(entry->key, name, entry->key_length) == 0) {
+                out->digest = (char*)malloc(entry->value_length + 1);
+                if (out->digest == NULL) return false;
+                memcpy(out->digest, entry->value, entry->value_length);
+                out->digest[entry->value_length] = '\0';
+                out->digest_type = preferred[p];
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+/** Move to the next listed object below the include filter; has_current is false at the end */
+static void diff_advance(DiffMerge* merge) {
+    DiffDirectoryData* job = merge->job;
+    diff_remote_free(&merge->current);
+    merge->has_current = false;
+    
+    if (merge->iterator == NULL) {
+        if (merge->sorted_next < merge->sorted_count) {
+            merge->current = merge->sorted[merge->sorted_next];
+            memset(&merge->sorted[merge->sorted_next++], 0, sizeof(DiffRemote));
+            merge->has_current = true;
+        }
+        return;
+    }
+    
+    while (uplink_object_iterator_next(merge->iterator)) {
+        UplinkObject* object = uplink_object_iterator_item(merge->iterator);
+        if (object == NULL) continue;
+        bool skip = object->is_prefix || !diff_included(job, object->key + merge->prefix_length);
+        if (skip) {
+            uplink_free_object(object);
+            continue;
+        }
+        bool copied = diff_remote_from_object(job, object, &merge->current);
+        uplink_free_object(object);
+        if (!copied) {
+            diff_remote_free(&merge->current);
+            diff_set_error(job, UPLINK_ERROR_INTERNAL, "Out of memory");
+            return;
+        }
+        if (merge->last_key != NULL && strcmp(merge->current.key, merge->last_key) <= 0) {
+            merge->unordered = true;
+            diff_remote_free(&merge->current);
+            return;
+        }
+        free(merge->last_key);
+        merge->last_key = strdup(merge->current.key);
+        job->remote_objects++;
+        merge->has_current = true;
+        return;
+    }
+    
+    UplinkError* error = uplink_object_iterator_err(merge->iterator);
+    if (error != NULL) {
+        diff_set_error(job, error->code, error->message != NULL ? error->message : "Listing failed");
+        uplink_free_error(error);
+    }
+}
+
+/**
+ * Whether the local file matches the object
+ *
+ * @return 1 when unchanged, 0 when changed, -1 when the file cannot be read
+ */
+static int diff_same(DiffMerge* merge, const char* full_path, int64_t size, int64_t mtime) {
+    DiffDirectoryData* job = merge->job;
+    const DiffRemote* remote = &merge->current;
+    
+    if (size != remote->size) return 0;
+    if (job->compare == DIFF_COMPARE_SIZE) return 1;
+    if (job->compare == DIFF_COMPARE_SIZE_MTIME || remote->digest == NULL) {
+        return mtime <= remote->created ? 1 : 0;
+    }
+    
+    if (merge->chunk == NULL) {
+        merge->chunk = (uint8_t*)malloc(DIFF_DIRECTORY_HASH_CHUNK_SIZE);
+    }
+    int fd = merge->chunk != NULL ? file_open_read(full_path) : -1;
+    if (fd < 0) {
+        char message[512];
+        snprintf(message, sizeof(message), "cannot read file '%s': %s", full_path,
+                 strerror(merge->chunk == NULL ? ENOMEM : errno));
+        diff_set_error(job, UPLINK_ERROR_INTERNAL, message);
+        return -1;
+    }
+    
+    ChecksumState checksum;
+    checksum_init(&checksum, remote->digest_type);
+    int64_t offset = 0;
+    int64_t n;
+    while ((n = file_read_at(fd, merge->chunk, DIFF_DIRECTORY_HASH_CHUNK_SIZE, offset)) > 0) {
+        checksum_update(&checksum, merge->chunk, (size_t)n);
+        offset += n;
+    }
+    if (n < 0) {
+        char message[512];
+        snprintf(message, sizeof(message), "cannot read file '%s': %s", full_path, strerror(errno));
+        diff_set_error(job, UPLINK_ERROR_INTERNAL, message);
+        file_close(fd);
+        return -1;
+    }
+    file_close(fd);
+    
+    char digest[CHECKSUM_HEX_MAX];
+    checksum_hex(&checksum, digest, sizeof(digest));
+    return strcmp(digest, remote->digest) == 0 ? 1 : 0;
+}
+
+/** Plan a delete of the current object, which has no local file */
+static bool diff_plan_delete(DiffMerge* merge) {
+    char* key = merge->current.key;
+    merge->current.key = NULL;
+    return diff_plan(merge->job, &merge->job->deletes, key, merge->current.size, false);
+}
+
+/** Local side of the merge: plan deletes for the objects sorting before the file, then the file */
+static int diff_local_file(const char* relative_path, const char* full_path, int64_t size, int64_t mtime, void* ctx) {
+    DiffMerge* merge = (DiffMerge*)ctx;
+    DiffDirectoryData* job = merge->job;
+    
+    if (cancel_token_check(job->cancel, &job->error_code, &job->error_message)) return 1;
+    if (!diff_included(job, relative_path)) return 0;
+    job->local_files++;
+    
+    size_t key_length = merge->prefix_length + strlen(relative_path) + 1;
+    char* key = (char*)malloc(key_length);
+    if (key == NULL) {
+        diff_set_error(job, UPLINK_ERROR_INTERNAL, "Out of memory");
+        return 1;
+    }
+    snprintf(key, key_length, "%s%s", job->prefix, relative_path);
+    
+    while (merge->has_current && strcmp(merge->current.key, key) < 0 && diff_plan_delete(merge)) {
+        diff_advance(merge);
+    }
+    if (merge->unordered || job->error_code != 0) {
+        free(key);
+        return 1;
+    }
+    
+    if (merge->has_current && strcmp(merge->current.key, key) == 0) {
+        int same = diff_same(merge, full_path, size, mtime);
+        if (same < 0) {
+            free(key);
+            return 1;
+        }
+        if (same) {
+            job->unchanged++;
+            free(key);
+        } else if (!diff_plan(job, &job->uploads, key, size, true)) {
+            return 1;
+        }
+        diff_advance(merge);
+    } else if (!diff_plan(job, &job->uploads, key, size, false)) {
+        return 1;
+    }
+    return merge->unordered || job->error_code != 0 ? 1 : 0;
+}
+
+static int compare_remote_keys(const void* a, const void* b) {
+    return strcmp(((const DiffRemote*)a)->key, ((const DiffRemote*)b)->key);
+}
+
+/** Read the whole listing into merge->sorted, in key order */
+static void diff_load_sorted(DiffMerge* merge, UplinkObjectIterator* iterator) {
+    DiffDirectoryData* job = merge->job;
+    size_t capacity = 0;
+    while (uplink_object_iterator_next(iterator) && job->error_code == 0) {
+        UplinkObject* object = uplink_object_iterator_item(iterator);
+        if (object == NULL) continue;
+        if (object->is_prefix || !diff_included(job, object->key + merge->prefix_length)) {
+            uplink_free_object(object);
+            continue;
+        }
+        if (merge->sorted_count == capacity) {
+            size_t grown = capacity > 0 ? capacity * 2 : 256;
+            DiffRemote* sorted = (DiffRemote*)realloc(merge->sorted, grown * sizeof(DiffRemote));
+            if (sorted == NULL) {
+                uplink_free_object(object);
+                diff_set_error(job, UPLINK_ERROR_INTERNAL, "Out of memory");
+                break;
+            }
+            merge->sorted = sorted;
+            capacity = grown;
+        }
+        DiffRemote* remote = &merge->sorted[merge->sorted_count++];
+        bool copied = diff_remote_from_object(job, object, remote);
+        uplink_free_object(object);
+        if (!copied) {
+            diff_set_error(job, UPLINK_ERROR_INTERNAL, "Out of memory");
+        }
+    }
+    UplinkError* error = uplink_object_iterator_err(iterator);
+    if (error != NULL) {
+        diff_set_error(job, error->code, error->message != NULL ? error->message : "Listing failed");
+        uplink_free_error(error);
+    }
+    if (job->error_code == 0) {
+        qsort(merge->sorted, merge->sorted_count, sizeof(DiffRemote), compare_remote_keys);
+        job->remote_objects = merge->sorted_count;
+    }
+}
+
+/** Run the merge over the whole tree; false when the listing came out of order */
+static bool diff_merge(DiffMerge* merge) {
+    DiffDirectoryData* job = merge->job;
+    
+    diff_advance(merge);
+    if (job->error_code == 0 && !merge->unordered &&
+        file_walk_tree_sorted(job->local_dir, diff_local_file, merge) < 0) {
+        char message[512];
+        snprintf(message, sizeof(message), "cannot read directory below '%s': %s", job->local_dir, strerror(errno));
+        diff_set_error(job, UPLINK_ERROR_INTERNAL, message);
+    }
+    
+    /* Objects past the last file have no local counterpart */
+    while (job->error_code == 0 && !merge->unordered && merge->has_current && diff_plan_delete(merge)) {
+        diff_advance(merge);
+    }
+    cancel_token_check(job->cancel, &job->error_code, &job->error_message);
+    return !merge->unordered;
+}
+
+void diff_directory_execute(napi_env env, void* data) {
+    (void)env;
+    DiffDirectoryData* work_data = (DiffDirectoryData*)data;
+    
+    LOG_DEBUG("diffDirectory: '%s' against '%s/%s' (worker thread)",
+              work_data->local_dir, work_data->bucket_name, work_data->prefix);
+    
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkListObjectsOptions options = { 0 };
+    options.prefix = work_data->prefix;
+    options.recursive = true;
+    options.system = true;
+    options.custom = work_data->compare == DIFF_COMPARE_CHECKSUM;
+    
+    DiffMerge merge;
+    memset(&merge, 0, sizeof(merge));
+    merge.job = work_data;
+    merge.prefix_length = strlen(work_data->prefix);
+    merge.iterator = uplink_list_objects(&project, work_data->bucket_name, &options);
+    if (merge.iterator == NULL) {
+        diff_set_error(work_data, UPLINK_ERROR_INTERNAL, "Failed to list objects");
+        return;
+    }
+    
+    bool ordered = diff_merge(&merge);
+    uplink_free_object_iterator(merge.iterator);
+    merge.iterator = NULL;
+    
+    if (!ordered && work_data->error_code == 0) {
+        LOG_WARN("diffDirectory: listing of '%s/%s' is not in key order; sorting it in memory",
+                 work_data->bucket_name, work_data->prefix);
+        diff_remote_free(&merge.current);
+        merge.unordered = false;
+        diff_list_clear(&work_data->uploads);
+        diff_list_clear(&work_data->deletes);
+        work_data->unchanged = 0;
+        work_data->local_files = 0;
+        work_data->sorted_in_memory = true;
+    
+        UplinkObjectIterator* iterator = uplink_list_objects(&project, work_data->bucket_name, &options);
+        if (iterator == NULL) {
+            diff_set_error(work_data, UPLINK_ERROR_INTERNAL, "Failed to list objects");
+        } else {
+            diff_load_sorted(&merge, iterator);
+            uplink_free_object_iterator(iterator);
+        }
+        if (work_data->error_code == 0) {
+            diff_merge(&merge);
+        }
+    }
+    
+    diff_remote_free(&merge.current);
+    for (size_t i = 0; i < merge.sorted_count; i++) {
+        diff_remote_free(&merge.sorted[i]);
+    }
+    free(merge.sorted);
+    free(merge.last_key);
+    free(merge.chunk);
+}
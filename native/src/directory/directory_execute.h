@@ -0,0 +1,21 @@
+/**
+ * @file directory_execute.h
+ * @brief Execute function declarations for directory transfer operations
+ */
+
+#ifndef DIRECTORY_EXECUTE_H
+#define DIRECTORY_EXECUTE_H
+
+#include <node_api.h>
+
+/**
+ * @brief Execute upload_directory on worker thread (spawns file threads)
+ */
+void upload_directory_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute diff_directory on worker thread
+ */
+void diff_directory_execute(napi_env env, void* data);
+
+#endif /* DIRECTORY_EXECUTE_H */
@@ -0,0 +1,345 @@
+/**
+ * @file directory_ops.c
+ * @brief N-API entry points for directory transfer operations
+ *
+ * The actual work is done in:
+ * - directory_execute.c (worker thread functions)
+ * - directory_complete.c (main thread completion handlers)
+ */
+
+#include "directory_ops.h"
+#include "directory_types.h"
+#include "directory_execute.h"
+#include "directory_complete.h"
+#include "../multipart/multipart_types.h"
+#include "../common/handle_helpers.h"
+#include "../common/string_helpers.h"
+#include "../common/type_converters.h"
+#include "../common/thread_pool.h"
+#include "../common/admission.h"
+#include "../common/logger.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Copy options[name] (an array of strings) into a string array; @p out
+ * stays NULL when it is undefined. Throws a TypeError with @p type_message
+ * and returns -1 on a bad value.
+ */
+static int extract_string_list(napi_env env, napi_value options, const char* name, const char* type_message,
+                               char*** out, size_t* out_count) {
+    napi_value list;
+    napi_valuetype type;
+    if (napi_get_named_property(env, options, name, &list) != napi_ok) {
+        return 0;
+    }
+    napi_typeof(env, list, &type);
+    if (type == napi_undefined) {
+        return 0;
+    }
+    
+    bool is_array = false;
+    napi_is_array(env, list, &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, type_message);
+        return -1;
+    }
+    
+    uint32_t length = 0;
+    napi_get_array_length(env, list, &length);
+    char** items = (char**)calloc(length > 0 ? length : 1, sizeof(char*));
+    if (items == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return -1;
+    }
+    char element_name[64];
+    snprintf(element_name, sizeof(element_name), "%s[]", name);
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element;
+        napi_get_element(env, list, i, &element);
+        if (extract_string_required(env, element, element_name, &items[i]) != napi_ok) {
+            free_string_array(items, i);
+            return -1;
+        }
+    }
+    
+    *out = items;
+    *out_count = length;
+    return 0;
+}
+
+/* ========== upload_directory ========== */
+
+napi_value upload_directory(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5] = { NULL, NULL, NULL, NULL, NULL };
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 4) {
+        napi_throw_type_error(env, NULL, "projectHandle, localDir, bucket, and prefix are required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    /* Extract optional options */
+    int64_t concurrency = UPLOAD_DIRECTORY_DEFAULT_CONCURRENCY;
+    int64_t large_file_threshold = UPLOAD_DIRECTORY_DEFAULT_LARGE_FILE_THRESHOLD;
+    int64_t part_concurrency = PARALLEL_UPLOAD_DEFAULT_CONCURRENCY;
+    napi_value on_progress = NULL;
+    char** include = NULL;
+    size_t include_count = 0;
+    char** listed = NULL;
+    size_t listed_count = 0;
+    
+    if (argc >= 5) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            concurrency = get_int64_property(env, argv[4], "concurrency", UPLOAD_DIRECTORY_DEFAULT_CONCURRENCY);
+            large_file_threshold = get_int64_property(env, argv[4], "largeFileThreshold",
+                                                      UPLOAD_DIRECTORY_DEFAULT_LARGE_FILE_THRESHOLD);
+            part_concurrency = get_int64_property(env, argv[4], "partConcurrency", PARALLEL_UPLOAD_DEFAULT_CONCURRENCY);
+    
+            if (concurrency < 1 || concurrency > 256) {
+                napi_throw_range_error(env, NULL, "concurrency must be between 1 and 256");
+                return NULL;
+            }
+            if (large_file_threshold <= 0) {
+                napi_throw_range_error(env, NULL, "largeFileThreshold must be a positive number");
+                return NULL;
+            }
+            if (part_concurrency < 1 || part_concurrency > 256) {
+                napi_throw_range_error(env, NULL, "partConcurrency must be between 1 and 256");
+                return NULL;
+            }
+    
+            napi_value progress_val;
+            if (napi_get_named_property(env, argv[4], "onProgress", &progress_val) == napi_ok) {
+                napi_typeof(env, progress_val, &type);
+                if (type == napi_function) {
+                    on_progress = progress_val;
+                } else if (type != napi_undefined) {
+                    napi_throw_type_error(env, NULL, "onProgress must be a function");
+                    return NULL;
+                }
+            }
+    
+            if (extract_string_list(env, argv[4], "include", "include must be an array of glob strings",
+                                    &include, &include_count) != 0) {
+                return NULL;
+            }
+            if (extract_string_list(env, argv[4], "files", "files must be an array of relative paths",
+                                    &listed, &listed_count) != 0) {
+                free_string_array(include, include_count);
+                return NULL;
+            }
+        }
+    }
+    
+    /* Extract strings */
+    char* local_dir = NULL;
+    char* bucket_name = NULL;
+    char* prefix = NULL;
+    DirectoryFile* files = NULL;
+    
+    if (extract_string_required(env, argv[1], "localDir", &local_dir) != napi_ok ||
+        extract_string_required(env, argv[2], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[3], "prefix", &prefix) != napi_ok) {
+        free(local_dir);
+        free(bucket_name);
+        free(prefix);
+        free_string_array(include, include_count);
+        free_string_array(listed, listed_count);
+        return NULL;
+    }
+    if (listed != NULL && listed_count > 0 &&
+        (files = (DirectoryFile*)calloc(listed_count, sizeof(DirectoryFile))) == NULL) {
+        free(local_dir);
+        free(bucket_name);
+        free(prefix);
+        free_string_array(include, include_count);
+        free_string_array(listed, listed_count);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    LOG_DEBUG("uploadDirectory: queuing async work for '%s' -> '%s/%s'", local_dir, bucket_name, prefix);
+    
+    UploadDirectoryData* work_data = (UploadDirectoryData*)calloc(1, sizeof(UploadDirectoryData));
+    if (work_data == NULL) {
+        free(local_dir);
+        free(bucket_name);
+        free(prefix);
+        free_string_array(include, include_count);
+        free_string_array(listed, listed_count);
+        free(files);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    /* The relative paths move into the file list; the rest is filled in on the worker */
+    for (size_t i = 0; i < listed_count; i++) {
+        files[i].relative_path = listed[i];
+    }
+    work_data->listed = listed != NULL;
+    free(listed);
+    
+    work_data->project_handle = project_handle;
+    work_data->local_dir = local_dir;
+    work_data->bucket_name = bucket_name;
+    work_data->prefix = prefix;
+    work_data->include = include;
+    work_data->include_count = include_count;
+    work_data->concurrency = (uint32_t)concurrency;
+    work_data->large_file_threshold = (uint64_t)large_file_threshold;
+    work_data->part_concurrency = (uint32_t)part_concurrency;
+    work_data->files = files;
+    work_data->file_count = listed_count;
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "uploadDirectory", NAPI_AUTO_LENGTH, &work_name);
+    
+    if (on_progress != NULL &&
+        napi_create_threadsafe_function(env, on_progress, NULL, work_name, 0, 1, NULL, NULL, NULL,
+                                        upload_directory_progress_js, &work_data->progress) != napi_ok) {
+        free(local_dir);
+        free(bucket_name);
+        free(prefix);
+        free_string_array(include, include_count);
+        for (size_t i = 0; i < listed_count; i++) {
+            free(files[i].relative_path);
+        }
+        free(files);
+        free(work_data);
+        napi_throw_error(env, NULL, "Failed to create progress callback");
+        return NULL;
+    }
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_TRANSFER, lane, work_name,
+        upload_directory_execute,
+        upload_directory_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== diff_directory ========== */
+
+napi_value diff_directory(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5] = { NULL, NULL, NULL, NULL, NULL };
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 4) {
+        napi_throw_type_error(env, NULL, "projectHandle, localDir, bucket, and prefix are required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    DiffCompareMode compare = DIFF_COMPARE_SIZE_MTIME;
+    char** include = NULL;
+    size_t include_count = 0;
+    
+    if (argc >= 5) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            char* mode = get_string_property(env, argv[4], "compare");
+            if (mode != NULL) {
+                if (strcmp(mode, "size") == 0) {
+                    compare = DIFF_COMPARE_SIZE;
+                } else if (strcmp(mode, "size+mtime") == 0) {
+                    compare = DIFF_COMPARE_SIZE_MTIME;
+                } else if (strcmp(mode, "checksum") == 0) {
+                    compare = DIFF_COMPARE_CHECKSUM;
+                } else {
+                    free(mode);
+                    napi_throw_type_error(env, NULL, "compare must be 'size', 'size+mtime' or 'checksum'");
+                    return NULL;
+                }
+                free(mode);
+            }
+            if (extract_string_list(env, argv[4], "include", "include must be an array of glob strings",
+                                    &include, &include_count) != 0) {
+                return NULL;
+            }
+        }
+    }
+    
+    char* local_dir = NULL;
+    char* bucket_name = NULL;
+    char* prefix = NULL;
+    
+    if (extract_string_required(env, argv[1], "localDir", &local_dir) != napi_ok ||
+        extract_string_required(env, argv[2], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[3], "prefix", &prefix) != napi_ok) {
+        free(local_dir);
+        free(bucket_name);
+        free(prefix);
+        free_string_array(include, include_count);
+        return NULL;
+    }
+    
+    DiffDirectoryData* work_data = (DiffDirectoryData*)calloc(1, sizeof(DiffDirectoryData));
+    if (work_data == NULL) {
+        free(local_dir);
+        free(bucket_name);
+        free(prefix);
+        free_string_array(include, include_count);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->local_dir = local_dir;
+    work_data->bucket_name = bucket_name;
+    work_data->prefix = prefix;
+    work_data->include = include;
+    work_data->include_count = include_count;
+    work_data->compare = compare;
+    
+    LOG_DEBUG("diffDirectory: queuing async work for '%s' vs '%s/%s'", local_dir, bucket_name, prefix);
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "diffDirectory", NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
+        diff_directory_execute,
+        diff_directory_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file directory_ops.h
+ * @brief Directory transfer operations for uplink-nodejs
+ *
+ * Declares N-API bindings that move whole local directory trees.
+ */
+
+#ifndef UPLINK_DIRECTORY_OPS_H
+#define UPLINK_DIRECTORY_OPS_H
+
+#include <node_api.h>
+
+/**
+ * Upload every file below a local directory
+ * JS: uploadDirectory(projectHandle, localDir, bucket, prefix, options?) -> Promise<UploadDirectoryResult>
+ *
+ * Options: { concurrency?, include?: string[], files?: string[], largeFileThreshold?,
+ * partConcurrency?, onProgress?: (progress) => void }. `files` lists the
+ * relative paths to upload instead of walking localDir. Object keys are
+ * prefix + the '/'-separated path below localDir. Per-file failures are
+ * counted; only a local directory that cannot be read rejects.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [projectHandle, localDir, bucket, prefix, options?]
+ * @return Promise resolving to upload totals
+ */
+napi_value upload_directory(napi_env env, napi_callback_info info);
+
+/**
+ * Plan the uploads and deletes that make a bucket prefix mirror a local directory
+ * JS: diffDirectory(projectHandle, localDir, bucket, prefix, options?) -> Promise<DiffResult>
+ *
+ * Options: { compare?: 'size' | 'size+mtime' | 'checksum', include?: string[] }.
+ * Resolves { upload: [{ key, path, size, reason }], delete: [{ key, size }],
+ * unchanged, uploadBytes, deleteBytes, localFiles, remoteObjects }.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [projectHandle, localDir, bucket, prefix, options?]
+ * @return Promise resolving to the plan
+ */
+napi_value diff_directory(napi_env env, napi_callback_info info);
+
+#endif /* UPLINK_DIRECTORY_OPS_H */
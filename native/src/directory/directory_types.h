@@ -0,0 +1,151 @@
+/**
+ * @file directory_types.h
+ * @brief Data structures for directory transfer async operations
+ */
+
+#ifndef DIRECTORY_TYPES_H
+#define DIRECTORY_TYPES_H
+
+#include <node_api.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Disable compat macros to avoid function name conflicts */
+#define UPLINK_DISABLE_NAMESPACE_COMPAT
+#include "uplink.h"
+#include "../common/cancel_token.h"
+
+/** Default files uploaded at once by upload_directory */
+#define UPLOAD_DIRECTORY_DEFAULT_CONCURRENCY 8
+
+/** Files at least this large go through the parallel multipart engine (64 MiB) */
+#define UPLOAD_DIRECTORY_DEFAULT_LARGE_FILE_THRESHOLD (64 * 1024 * 1024)
+
+/** Minimum time between two progress callbacks */
+#define UPLOAD_DIRECTORY_PROGRESS_INTERVAL_MS 100
+
+/** Failures reported individually by upload_directory; the rest are only counted */
+#define UPLOAD_DIRECTORY_MAX_FAILURES 100
+
+/**
+ * @brief A regular file found by the directory walk
+ */
+typedef struct {
+    char* relative_path;        /* '/'-separated, below the local root */
+    char* full_path;
+    int64_t size;
+} DirectoryFile;
+
+/**
+ * @brief Running totals of an upload_directory call
+ */
+typedef struct {
+    uint64_t files_done;
+    uint64_t files_total;
+    uint64_t bytes_done;
+    uint64_t bytes_total;
+    uint64_t failed;
+} UploadDirectoryProgress;
+
+/**
+ * @brief One file that upload_directory could not upload
+ */
+typedef struct {
+    char* relative_path;
+    int32_t code;
+    char* message;
+} UploadDirectoryFailure;
+
+/**
+ * @brief Data for upload_directory async operation
+ *
+ * The worker walks local_dir, then uploads files below
+ * large_file_threshold through the single-call file path on
+ * `concurrency` native threads while it sends larger files, largest
+ * first, through the parallel multipart engine itself.
+ */
+typedef struct {
+    size_t project_handle;
+    char* local_dir;
+    char* bucket_name;
+    char* prefix;                   /* Prepended to each relative path; may be empty */
+    char** include;                 /* Glob patterns, or NULL to upload every file */
+    size_t include_count;
+    uint32_t concurrency;
+    uint64_t large_file_threshold;
+    uint32_t part_concurrency;
+    napi_threadsafe_function progress;  /* onProgress, or NULL */
+    DirectoryFile* files;           /* Prefilled from options.files (sizes unset), or found by the walk */
+    size_t file_count;
+    bool listed;                    /* options.files given: upload those instead of walking */
+    UploadDirectoryProgress totals;
+    UploadDirectoryFailure* failures;   /* First UPLOAD_DIRECTORY_MAX_FAILURES failures */
+    size_t failure_count;
+    CancelToken* cancel;            /* From options.cancelToken, or NULL */
+    int32_t error_code;             /* Walk or cancellation error, 0 if none */
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} UploadDirectoryData;
+
+/**
+ * @brief How diff_directory decides that a local file matches its object
+ */
+typedef enum {
+    DIFF_COMPARE_SIZE,
+    DIFF_COMPARE_SIZE_MTIME,        /* Same size, and the object is not older than the file */
+    DIFF_COMPARE_CHECKSUM,          /* Same size and checksum-<algorithm> digest; size+mtime without one */
+} DiffCompareMode;
+
+/** Read size used to hash local files for DIFF_COMPARE_CHECKSUM (1 MiB) */
+#define DIFF_DIRECTORY_HASH_CHUNK_SIZE (1024 * 1024)
+
+/**
+ * @brief One planned upload or delete
+ */
+typedef struct {
+    char* key;
+    int64_t size;                   /* Local size for uploads, object size for deletes */
+    bool changed;                   /* Uploads: an object with other content exists */
+} DiffEntry;
+
+/**
+ * @brief Growable list of planned entries
+ */
+typedef struct {
+    DiffEntry* items;
+    size_t count;
+    size_t capacity;
+    uint64_t bytes;
+} DiffEntryList;
+
+/**
+ * @brief Data for diff_directory async operation
+ *
+ * The worker merge-joins a walk of local_dir in key order with a
+ * recursive listing of prefix, so neither side is held in memory; only
+ * the planned uploads and deletes are. A listing that turns out not to
+ * be in key order is read whole and sorted, and the merge runs again.
+ */
+typedef struct {
+    size_t project_handle;
+    char* local_dir;
+    char* bucket_name;
+    char* prefix;                   /* Prepended to each relative path; may be empty */
+    char** include;                 /* Glob patterns, or NULL to compare every file */
+    size_t include_count;
+    DiffCompareMode compare;
+    DiffEntryList uploads;
+    DiffEntryList deletes;
+    uint64_t unchanged;
+    uint64_t local_files;
+    uint64_t remote_objects;
+    bool sorted_in_memory;          /* The listing was not in key order */
+    CancelToken* cancel;            /* From options.cancelToken, or NULL */
+    int32_t error_code;
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} DiffDirectoryData;
+
+#endif /* DIRECTORY_TYPES_H */
@@ -7,20 +7,43 @@
 
 #include "download_complete.h"
 #include "download_types.h"
+#include "download_execute.h"
 #include "../common/handle_helpers.h"
+#include "../common/string_helpers.h"
+#include "../common/admission.h"
+#include "../common/buffer_helpers.h"
+#include "../common/work_pool.h"
 #include "../common/result_helpers.h"
 #include "../common/error_registry.h"
 #include "../common/cancel_helpers.h"
 #include "../common/object_converter.h"
+#include "../common/op_metrics.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
 
+/* ========== per-handle state ========== */
+
+static void download_handle_state_free(void* attachment) {
+    DownloadHandleState* state = (DownloadHandleState*)attachment;
+    free(state->verify);
+    download_codec_stage_free(state->codec);
+    download_cache_stage_free(state->cache);
+    download_tee_free(state->tee);
+    read_ahead_stage_free(state->ahead);
+    free(state);
+}
+
 /* ========== download_object complete ========== */
 
 void download_object_complete(napi_env env, napi_status status, void* data) {
     DownloadObjectData* work_data = (DownloadObjectData*)data;
-    REJECT_IF_CANCELLED(env, status, work_data->deferred, "downloadObject");
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "downloadObject", work_data->cancel);
+    
+    if (work_data->cancelled) {
+        napi_reject_deferred(env, work_data->deferred, cancel_token_error(env, work_data->cancel));
+        goto cleanup;
+    }
     
     if (work_data->result.error != NULL) {
         LOG_ERROR("downloadObject failed: %s", work_data->result.error->message);
@@ -30,19 +53,62 @@ void download_object_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
+    /* Verification and decoding are correctness requirements, so do not silently drop them */
+    DownloadHandleState* state = NULL;
+    if (work_data->verify != NULL || work_data->codec != NULL || work_data->cache != NULL || work_data->tee != NULL ||
+        work_data->ahead != NULL) {
+        state = (DownloadHandleState*)calloc(1, sizeof(DownloadHandleState));
+        if (state == NULL) {
+            uplink_free_error(uplink_close_download(work_data->result.download));
+            uplink_free_download_result(work_data->result);
+            napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Out of memory"));
+            goto cleanup;
+        }
+    }
+    
     /* Create result object with download handle */
     napi_value result_obj;
     napi_create_object(env, &result_obj);
     
     napi_value download_handle = create_handle_external(env, work_data->result.download->_handle, HANDLE_TYPE_DOWNLOAD, work_data->result.download, NULL);
     napi_set_named_property(env, result_obj, "downloadHandle", download_handle);
+    if (download_handle != NULL) {
+        /* The transfer slot stays taken until closeDownload */
+        HandleWrapper* wrapper = get_handle_wrapper(env, download_handle, HANDLE_TYPE_DOWNLOAD);
+        wrapper->admission = admission_keep(work_data->admission);
+        wrapper->project_handle = work_data->project_handle;
+        if (state != NULL) {
+            state->verify = work_data->verify;
+            state->codec = work_data->codec;
+            state->cache = work_data->cache;
+            state->tee = work_data->tee;
+            state->ahead = work_data->ahead;
+            work_data->verify = NULL;
+            work_data->codec = NULL;
+            work_data->cache = NULL;
+            work_data->tee = NULL;
+            work_data->ahead = NULL;
+            wrapper->attachment = state;
+            wrapper->attachment_free = download_handle_state_free;
+        }
+    } else {
+        free(state);
+    }
     
     LOG_INFO("Download started: %s/%s", work_data->bucket_name, work_data->object_key);
     napi_resolve_deferred(env, work_data->deferred, result_obj);
     
 cleanup:
-    free(work_data->bucket_name);
+    bucket_name_release(work_data->bucket_name);
     free(work_data->object_key);
+    free(work_data->verify_expected);
+    free(work_data->verify_key);
+    free(work_data->verify);
+    download_codec_stage_free(work_data->codec);
+    download_cache_stage_free(work_data->cache);
+    download_tee_free(work_data->tee);
+    read_ahead_stage_free(work_data->ahead);
+    cancel_token_detach(work_data->cancel, work_data->work);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
@@ -51,7 +117,19 @@ cleanup:
 
 void download_read_complete(napi_env env, napi_status status, void* data) {
     DownloadReadData* work_data = (DownloadReadData*)data;
-    REJECT_IF_CANCELLED(env, status, work_data->deferred, "downloadRead");
+    /* Before settling, so a read issued from the callback cannot race the stage */
+    read_ahead_note(work_data->ahead);
+    SETTLE_IF_CANCELLED_BY(env, status, work_data->deferred, work_data->callback, "downloadRead", work_data->cancel);
+    
+    if (work_data->cancelled && work_data->result.error == NULL) {
+        /* Stopped between partial reads or in a bandwidth wait; bytesRead covers what landed */
+        napi_value error = cancel_token_error(env, work_data->cancel);
+        napi_value bytes_read_val;
+        napi_create_int64(env, (int64_t)work_data->result.bytes_read, &bytes_read_val);
+        napi_set_named_property(env, error, "bytesRead", bytes_read_val);
+        settle_error(env, work_data->deferred, work_data->callback, error);
+        goto cleanup;
+    }
     
     if (work_data->result.error != NULL) {
         /*
@@ -70,16 +148,30 @@ void download_read_complete(napi_env env, napi_status status, void* data) {
                                                work_data->result.error->message ? work_data->result.error->message : "EOF");
         
         /* Attach bytes_read to the error object so JS can recover partial data */
+        op_metrics_add_bytes(env, work_data->result.bytes_read);
         napi_value bytes_read_val;
         napi_create_int64(env, (int64_t)work_data->result.bytes_read, &bytes_read_val);
         napi_set_named_property(env, error, "bytesRead", bytes_read_val);
         
-        napi_reject_deferred(env, work_data->deferred, error);
+        settle_error(env, work_data->deferred, work_data->callback, error);
         uplink_free_error(work_data->result.error);
         goto cleanup;
     }
     
-    /* Success: resolve with { bytesRead: N } */
+    op_metrics_add_bytes(env, work_data->result.bytes_read);
+    LOG_DEBUG("downloadRead: success bytes_read=%zu", work_data->result.bytes_read);
+    
+    /* downloadReadCb: (null, bytesRead, eof) without a result object */
+    if (work_data->callback != NULL) {
+        napi_value argv[3];
+        napi_get_null(env, &argv[0]);
+        napi_create_int64(env, (int64_t)work_data->result.bytes_read, &argv[1]);
+        napi_get_boolean(env, work_data->eof, &argv[2]);
+        invoke_callback(env, work_data->callback, 3, argv);
+        goto cleanup;
+    }
+    
+    /* Success: resolve with { bytesRead: N }, plus { eof } when EOF is reported as a value */
     napi_value result_obj;
     napi_create_object(env, &result_obj);
     
@@ -87,14 +179,274 @@ void download_read_complete(napi_env env, napi_status status, void* data) {
     napi_create_int64(env, (int64_t)work_data->result.bytes_read, &bytes_read);
     napi_set_named_property(env, result_obj, "bytesRead", bytes_read);
     
-    LOG_DEBUG("downloadRead: success bytes_read=%zu", work_data->result.bytes_read);
+    if (work_data->eof_as_value) {
+        napi_value eof;
+        napi_get_boolean(env, work_data->eof, &eof);
+        napi_set_named_property(env, result_obj, "eof", eof);
+    }
+    
     napi_resolve_deferred(env, work_data->deferred, result_obj);
     
 cleanup:
     /* Release buffer reference */
-    if (work_data->buffer_ref) {
-        napi_delete_reference(env, work_data->buffer_ref);
+    unpin_buffer(env, work_data->buffer_ref, work_data->data_length);
+    if (work_data->work != NULL) {
+        cancel_token_detach(work_data->cancel, work_data->work);
+        napi_delete_async_work(env, work_data->work);
+    }
+    work_pool_free(work_data);
+}
+
+/* ========== download_to_file complete ========== */
+
+void download_to_file_complete(napi_env env, napi_status status, void* data) {
+    DownloadToFileData* work_data = (DownloadToFileData*)data;
+    progress_reporter_release(env, work_data->progress);
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "downloadToFile", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("downloadToFile failed for '%s': %s", work_data->file_path,
+                  work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        
+        /* Let JS know how much of the file is valid */
+        napi_value bytes_written_val;
+        napi_create_int64(env, (int64_t)work_data->bytes_written, &bytes_written_val);
+        napi_set_named_property(env, error, "bytesWritten", bytes_written_val);
+        
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    napi_value result_obj;
+    napi_create_object(env, &result_obj);
+    
+    napi_value bytes_written;
+    napi_create_int64(env, (int64_t)work_data->bytes_written, &bytes_written);
+    napi_set_named_property(env, result_obj, "bytesWritten", bytes_written);
+    
+    op_metrics_add_bytes(env, work_data->bytes_written);
+    LOG_INFO("Downloaded %s/%s to '%s' (%zu bytes)", work_data->bucket_name,
+             work_data->object_key, work_data->file_path, work_data->bytes_written);
+    napi_resolve_deferred(env, work_data->deferred, result_obj);
+    
+cleanup:
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->object_key);
+    free(work_data->file_path);
+    free(work_data->error_message);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== download_parallel complete ========== */
+
+void download_parallel_complete(napi_env env, napi_status status, void* data) {
+    DownloadParallelData* work_data = (DownloadParallelData*)data;
+    
+    /* Release sink buffer reference */
+    unpin_buffer(env, work_data->buffer_ref, work_data->buffer_length);
+    progress_reporter_release(env, work_data->progress);
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "downloadParallel", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("downloadParallel failed: %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    napi_value result_obj;
+    napi_create_object(env, &result_obj);
+    
+    napi_value bytes_written;
+    napi_create_int64(env, (int64_t)work_data->content_length, &bytes_written);
+    napi_set_named_property(env, result_obj, "bytesWritten", bytes_written);
+    if (work_data->auto_tune) {
+        napi_value tuning;
+        napi_value value;
+        napi_create_object(env, &tuning);
+        napi_create_int64(env, (int64_t)work_data->tuned_range_size, &value);
+        napi_set_named_property(env, tuning, "partSize", value);
+        napi_create_uint32(env, work_data->tuned_concurrency, &value);
+        napi_set_named_property(env, tuning, "concurrency", value);
+        napi_create_double(env, work_data->tuned_goodput, &value);
+        napi_set_named_property(env, tuning, "bytesPerSecond", value);
+        napi_set_named_property(env, result_obj, "tuning", tuning);
+    }
+    
+    op_metrics_add_bytes(env, work_data->content_length);
+    LOG_INFO("downloadParallel: '%s/%s' done in %u ranges",
+             work_data->bucket_name, work_data->object_key, work_data->range_count);
+    napi_resolve_deferred(env, work_data->deferred, result_obj);
+    
+cleanup:
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->object_key);
+    free(work_data->file_path);
+    free(work_data->error_message);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== get_object complete ========== */
+
+static void get_object_buffer_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    free(data);
+}
+
+static void get_object_blob_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)data;
+    object_cache_blob_release((ObjectCacheBlob*)hint);
+}
+
+/** Buffer over @p blob's bytes, consuming one reference */
+static napi_value get_object_blob_buffer(napi_env env, ObjectCacheBlob* blob) {
+    napi_value buffer;
+    if (napi_create_external_buffer(env, blob->length, blob->data,
+                                    get_object_blob_finalize, blob, &buffer) != napi_ok) {
+        buffer = create_buffer_copy(env, blob->data, blob->length);
+        object_cache_blob_release(blob);
+    }
+    return buffer;
+}
+
+static napi_value get_object_result(napi_env env, napi_value buffer, const UplinkObject* info) {
+    napi_value result_obj;
+    napi_create_object(env, &result_obj);
+    napi_set_named_property(env, result_obj, "data", buffer);
+    napi_set_named_property(env, result_obj, "info",
+                            uplink_object_to_js_fields(env, (UplinkObject*)info,
+                                                       OBJECT_FIELDS_ALL | OBJECT_CONVERT_LAZY_CUSTOM));
+    return result_obj;
+}
+
+napi_value get_object_cached_result(napi_env env, ObjectCacheBlob* blob, const UplinkObject* info) {
+    return create_resolved_promise(env, get_object_result(env, get_object_blob_buffer(env, blob), info));
+}
+
+void get_object_complete(napi_env env, napi_status status, void* data) {
+    GetObjectData* work_data = (GetObjectData*)data;
+    progress_reporter_release(env, work_data->progress);
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "getObject", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("getObject failed: %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    /* Hand the native buffer to JS without copying */
+    napi_value buffer;
+    if (work_data->blob != NULL) {
+        work_data->data = NULL;
+        if (work_data->length == work_data->blob->length) {
+            object_cache_store(work_data->project_handle, work_data->cache_epoch, work_data->bucket_name,
+                               work_data->object_key, work_data->blob, work_data->info.object);
+        }
+        work_data->blob->refs++;
+        buffer = get_object_blob_buffer(env, work_data->blob);
+    } else if (napi_create_external_buffer(env, work_data->length, work_data->data,
+                                           get_object_buffer_finalize, NULL, &buffer) == napi_ok) {
+        work_data->data = NULL;
+    } else {
+        buffer = create_buffer_copy(env, work_data->data, work_data->length);
+    }
+    
+    napi_value result_obj = get_object_result(env, buffer, work_data->info.object);
+    
+    op_metrics_add_bytes(env, work_data->length);
+    op_metrics_record(env, DOWNLOAD_FIRST_BYTE_METRIC, work_data->first_byte_ns);
+    LOG_DEBUG("getObject: %s/%s (%zu bytes)", work_data->bucket_name, work_data->object_key, work_data->length);
+    napi_resolve_deferred(env, work_data->deferred, result_obj);
+    
+cleanup:
+    if (work_data->info.object != NULL || work_data->info.error != NULL) {
+        uplink_free_object_result(work_data->info);
     }
+    if (work_data->blob != NULL) {
+        object_cache_blob_release(work_data->blob);
+    } else {
+        free(work_data->data);
+    }
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->object_key);
+    free(work_data->error_message);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== download_ranges complete ========== */
+
+void download_ranges_complete(napi_env env, napi_status status, void* data) {
+    DownloadRangesData* work_data = (DownloadRangesData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "downloadRanges", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("downloadRanges failed: %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    /* One buffer over the whole arena; each range is an offset and length into it */
+    napi_value buffer;
+    if (work_data->arena == NULL) {
+        buffer = create_buffer_copy(env, NULL, 0);
+    } else if (napi_create_external_buffer(env, (size_t)work_data->arena_length, work_data->arena,
+                                           get_object_buffer_finalize, NULL, &buffer) == napi_ok) {
+        work_data->arena = NULL;
+    } else {
+        buffer = create_buffer_copy(env, work_data->arena, (size_t)work_data->arena_length);
+    }
+    
+    napi_value offsets;
+    napi_value lengths;
+    napi_create_array_with_length(env, work_data->range_count, &offsets);
+    napi_create_array_with_length(env, work_data->range_count, &lengths);
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < work_data->range_count; i++) {
+        uint64_t at;
+        uint64_t length;
+        download_ranges_view(&work_data->ranges[i], work_data->spans, &at, &length);
+        napi_value value;
+        napi_create_int64(env, (int64_t)at, &value);
+        napi_set_element(env, offsets, i, value);
+        napi_create_int64(env, (int64_t)length, &value);
+        napi_set_element(env, lengths, i, value);
+        total += length;
+    }
+    
+    napi_value result_obj;
+    napi_create_object(env, &result_obj);
+    napi_set_named_property(env, result_obj, "data", buffer);
+    napi_set_named_property(env, result_obj, "offsets", offsets);
+    napi_set_named_property(env, result_obj, "lengths", lengths);
+    napi_value requests;
+    napi_create_uint32(env, work_data->span_count, &requests);
+    napi_set_named_property(env, result_obj, "requests", requests);
+    
+    op_metrics_add_bytes(env, work_data->arena_length);
+    LOG_DEBUG("downloadRanges: '%s/%s' %llu bytes for %u ranges in %u requests",
+              work_data->bucket_name, work_data->object_key, (unsigned long long)total,
+              work_data->range_count, work_data->span_count);
+    napi_resolve_deferred(env, work_data->deferred, result_obj);
+    
+cleanup:
+    free(work_data->arena);
+    free(work_data->spans);
+    free(work_data->ranges);
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->object_key);
+    free(work_data->error_message);
+    cancel_token_detach(work_data->cancel, work_data->work);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
@@ -113,7 +465,8 @@ void download_info_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
-    napi_value result = uplink_object_to_js(env, work_data->result.object);
+    napi_value result = uplink_object_to_js_fields(env, work_data->result.object,
+                                                   OBJECT_FIELDS_ALL | OBJECT_CONVERT_LAZY_CUSTOM);
     LOG_INFO("download_info complete: key=%s", work_data->result.object ? work_data->result.object->key : "(null)");
     napi_resolve_deferred(env, work_data->deferred, result);
     uplink_free_object_result(work_data->result);
@@ -127,6 +480,7 @@ cleanup:
 
 void close_download_complete(napi_env env, napi_status status, void* data) {
     CloseDownloadData* work_data = (CloseDownloadData*)data;
+    admission_release(work_data->admission);
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "closeDownload");
     
     if (work_data->error != NULL) {
@@ -137,12 +491,26 @@ void close_download_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
+    if (work_data->verify_error != NULL) {
+        /* Closed fine, but the content did not match */
+        napi_value error = create_typed_error(env, work_data->verify_error->code, work_data->verify_error->message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    if (work_data->tee_error != NULL) {
+        napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, work_data->tee_error));
+        goto cleanup;
+    }
+    
     napi_value undefined;
     napi_get_undefined(env, &undefined);
     LOG_INFO("close_download complete");
     napi_resolve_deferred(env, work_data->deferred, undefined);
     
 cleanup:
+    uplink_free_error(work_data->verify_error);
+    free(work_data->tee_error);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
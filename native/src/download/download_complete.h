@@ -11,10 +11,24 @@
 /* Disable compat macros to avoid function name conflicts */
 #define UPLINK_DISABLE_NAMESPACE_COMPAT
 #include "uplink.h"
+#include "../common/object_cache.h"
 
 /* Complete functions - run on main thread */
 void download_object_complete(napi_env env, napi_status status, void* data);
 void download_read_complete(napi_env env, napi_status status, void* data);
+void download_to_file_complete(napi_env env, napi_status status, void* data);
+void download_parallel_complete(napi_env env, napi_status status, void* data);
+void download_ranges_complete(napi_env env, napi_status status, void* data);
+void get_object_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * Build the getObject result for an object cache hit
+ *
+ * @param blob Reference from object_cache_lookup(), consumed
+ * @param info Cached object info
+ * @return { data, info } with data an external Buffer over the blob
+ */
+napi_value get_object_cached_result(napi_env env, ObjectCacheBlob* blob, const UplinkObject* info);
 void download_info_complete(napi_env env, napi_status status, void* data);
 void close_download_complete(napi_env env, napi_status status, void* data);
 
@@ -7,11 +7,849 @@
 
 #include "download_execute.h"
 #include "download_types.h"
+#include "../common/bandwidth.h"
+#include "../common/buffer_pool.h"
+#include "../common/file_helpers.h"
+#include "../common/hedge.h"
+#include "../common/retry.h"
+#include "../common/part_tuner.h"
+#include "../common/object_converter.h"
+#include "../common/result_helpers.h"
 #include "../common/logger.h"
 
+#include <uv.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * Read up to @p length bytes, drawing the read from the bandwidth limits
+ * of @p project_handle. A wait stopped by @p cancel reads nothing and
+ * reports no error; the caller's next cancel check ends its loop.
+ */
+static UplinkReadResult download_read_limited(UplinkDownload* download, size_t project_handle,
+                                              CancelToken* cancel, uint8_t* buf, size_t length) {
+    UplinkReadResult read = { 0 };
+    size_t grant = bandwidth_acquire(project_handle, BANDWIDTH_DOWNLOAD, length, cancel);
+    if (grant > 0) {
+        read = uplink_download_read(download, buf, grant);
+        bandwidth_refund(project_handle, BANDWIDTH_DOWNLOAD, grant - read.bytes_read);
+    }
+    return read;
+}
+
+/* ========== content verification ========== */
+
+/**
+ * Build an error for the verification paths. uplink_free_error releases
+ * with free(), so a libc-allocated error is safe.
+ */
+static UplinkError* download_verify_error(int32_t code, const char* format, ...) {
+    UplinkError* error = (UplinkError*)calloc(1, sizeof(UplinkError));
+    if (error == NULL) {
+        return NULL;
+    }
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    error->code = code;
+    error->message = strdup(message);
+    return error;
+}
+
+/**
+ * Find a custom metadata entry of @p object
+ * @return The entry, or NULL if absent
+ */
+static const UplinkCustomMetadataEntry* download_find_metadata(const UplinkObject* object, const char* key) {
+    size_t key_length = strlen(key);
+    for (size_t i = 0; i < object->custom.count; i++) {
+        const UplinkCustomMetadataEntry* entry = &object->custom.entries[i];
+        if (entry->key_length == key_length && memcmp(entry->key, key, key_length) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Look up the expected digest of a just-opened download with
+ * options.verify, and start the checksum over @p content_length bytes.
+ * @return NULL on success, or the error to fail downloadObject with
+ */
+static UplinkError* download_verify_prepare(DownloadObjectData* work_data, const UplinkObject* object,
+                                            uint64_t content_length) {
+    DownloadVerifyState* verify = (DownloadVerifyState*)calloc(1, sizeof(DownloadVerifyState));
+    if (verify == NULL) {
+        return download_verify_error(UPLINK_ERROR_INTERNAL, "Out of memory");
+    }
+    verify->content_length = content_length;
+    
+    const char* expected = work_data->verify_expected;
+    size_t expected_length = expected != NULL ? strlen(expected) : 0;
+    if (expected == NULL) {
+        const UplinkCustomMetadataEntry* entry = download_find_metadata(object, work_data->verify_key);
+        if (entry != NULL) {
+            expected = entry->value;
+            expected_length = entry->value_length;
+        }
+    }
+    if (expected == NULL || expected_length >= sizeof(verify->expected)) {
+        free(verify);
+        return download_verify_error(UPLINK_ERROR_INTEGRITY,
+                                     "Object has no usable '%s' metadata to verify against",
+                                     work_data->verify_key);
+    }
+    for (size_t i = 0; i < expected_length; i++) {
+        verify->expected[i] = (char)tolower((unsigned char)expected[i]);
+    }
+    verify->expected[expected_length] = '\0';
+    
+    checksum_init(&verify->checksum, work_data->verify_type);
+    work_data->verify = verify;
+    return NULL;
+}
+
+UplinkError* download_verify_finish(DownloadVerifyState* verify) {
+    verify->done = true;
+    char actual[CHECKSUM_HEX_MAX];
+    checksum_hex(&verify->checksum, actual, sizeof(actual));
+    if (strcmp(actual, verify->expected) == 0) {
+        LOG_DEBUG("Download verified: %s %s", checksum_type_name(verify->checksum.type), actual);
+        return NULL;
+    }
+    LOG_ERROR("Download %s mismatch: expected %s, got %s", checksum_type_name(verify->checksum.type),
+              verify->expected, actual);
+    return download_verify_error(UPLINK_ERROR_INTEGRITY, "%s mismatch: expected %s, got %s",
+                                 checksum_type_name(verify->checksum.type), verify->expected, actual);
+}
+
+/**
+ * Hash bytes just read from a verified download, comparing the digest
+ * once the object has been read in full (or EOF came early).
+ * @return An IntegrityError on mismatch, else NULL
+ */
+static UplinkError* download_verify_update(DownloadVerifyState* verify, const uint8_t* data, size_t length, bool eof) {
+    if (verify == NULL || verify->done) {
+        return NULL;
+    }
+    checksum_update(&verify->checksum, data, length);
+    if (!eof && verify->checksum.total < verify->content_length) {
+        return NULL;
+    }
+    return download_verify_finish(verify);
+}
+
+/**
+ * Replace a read's EOF (or absent) error with a digest mismatch. Other
+ * read errors take precedence.
+ */
+static void download_verify_report(UplinkError** error, UplinkError* mismatch) {
+    if (mismatch == NULL) {
+        return;
+    }
+    if (*error != NULL && (*error)->code != EOF) {
+        uplink_free_error(mismatch);
+        return;
+    }
+    uplink_free_error(*error);
+    *error = mismatch;
+}
+
+/**
+ * Hand bytes just read to the download's tee sinks. A failed required
+ * sink is reported like a digest mismatch.
+ */
+static void download_tee_update(DownloadTee* tee, const uint8_t* data, size_t length, UplinkError** error) {
+    if (tee == NULL) {
+        return;
+    }
+    const DownloadTeeSink* failed = download_tee_write(tee, data, length);
+    if (failed != NULL) {
+        download_verify_report(error, download_verify_error(UPLINK_ERROR_INTERNAL, "tee sink failed: %s",
+                                                            failed->error_message));
+    }
+}
+
+/* ========== decompression stage ========== */
+
+void download_codec_stage_free(DownloadCodecStage* codec) {
+    if (codec == NULL) {
+        return;
+    }
+    free(codec->chunk);
+    free(codec->frame);
+    free(codec);
+}
+
+/**
+ * Parse an unsigned decimal metadata value
+ * @return 0 on success, -1 if absent or malformed
+ */
+static int download_metadata_u64(const UplinkObject* object, const char* key, uint64_t* out) {
+    const UplinkCustomMetadataEntry* entry = download_find_metadata(object, key);
+    if (entry == NULL || entry->value_length == 0 || entry->value_length > 20) {
+        return -1;
+    }
+    uint64_t value = 0;
+    for (size_t i = 0; i < entry->value_length; i++) {
+        char c = entry->value[i];
+        if (c < '0' || c > '9') {
+            return -1;
+        }
+        value = value * 10 + (uint64_t)(c - '0');
+    }
+    *out = value;
+    return 0;
+}
+
+/**
+ * Read exactly @p length bytes of [@p offset, @p offset + @p length) of
+ * the stored object in one ranged download.
+ */
+static UplinkError* download_read_stored_range(DownloadObjectData* work_data, uint64_t offset, uint8_t* buf, size_t length) {
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkDownloadOptions options = { .offset = (int64_t)offset, .length = (int64_t)length };
+    UplinkDownloadResult range = uplink_download_object(&project, work_data->bucket_name, work_data->object_key, &options);
+    if (range.error != NULL) {
+        return range.error;
+    }
+    
+    UplinkError* error = NULL;
+    size_t total = 0;
+    while (total < length && error == NULL) {
+        UplinkReadResult read = uplink_download_read(range.download, buf + total, length - total);
+        total += read.bytes_read;
+        if (read.error != NULL && read.error->code == EOF && total == length) {
+            uplink_free_error(read.error);
+        } else if (read.error != NULL && read.error->code == EOF) {
+            uplink_free_error(read.error);
+            error = download_verify_error(UPLINK_ERROR_INTEGRITY, "Compressed object index is truncated");
+        } else {
+            error = read.error;
+        }
+    }
+    uplink_free_error(uplink_close_download(range.download));
+    uplink_free_download_result(range);
+    return error;
+}
+
+/**
+ * Set up decoding of a just-opened download of an object uploaded with a
+ * codec. Whole-object downloads read the frames from the start as
+ * opened; ranged ones read the frame index, then reopen the download at
+ * the first frame of the range.
+ * @return NULL on success (work_data->codec stays NULL for plain
+ *         objects), or the error to fail downloadObject with
+ */
+static UplinkError* download_codec_prepare(DownloadObjectData* work_data, const UplinkObject* object) {
+    const UplinkCustomMetadataEntry* name = download_find_metadata(object, CODEC_KEY_NAME);
+    if (name == NULL) {
+        return NULL;
+    }
+    
+    char codec_name[16];
+    snprintf(codec_name, sizeof(codec_name), "%.*s", (int)name->value_length, name->value);
+    CodecType type = codec_type_from_name(codec_name);
+    if (type == CODEC_NONE) {
+        return download_verify_error(UPLINK_ERROR_INTERNAL,
+                                     "Object uses unsupported codec '%s' (download with decompress: false)", codec_name);
+    }
+    uint64_t chunk_size, raw_size, index_offset;
+    if (download_metadata_u64(object, CODEC_KEY_CHUNK_SIZE, &chunk_size) != 0 ||
+        download_metadata_u64(object, CODEC_KEY_RAW_SIZE, &raw_size) != 0 ||
+        download_metadata_u64(object, CODEC_KEY_INDEX_OFFSET, &index_offset) != 0 ||
+        chunk_size == 0 || chunk_size > CODEC_MAX_CHUNK_SIZE) {
+        return download_verify_error(UPLINK_ERROR_INTEGRITY, "Object has malformed codec metadata");
+    }
+    
+    DownloadCodecStage* codec = (DownloadCodecStage*)calloc(1, sizeof(DownloadCodecStage));
+    if (codec == NULL) {
+        return download_verify_error(UPLINK_ERROR_INTERNAL, "Out of memory");
+    }
+    codec->type = type;
+    codec->chunk_size = (size_t)chunk_size;
+    codec->raw_size = raw_size;
+    codec->chunk = (uint8_t*)malloc(codec->chunk_size);
+    codec->frame = (uint8_t*)malloc(CODEC_FRAME_HEADER_SIZE + codec->chunk_size);
+    if (codec->chunk == NULL || codec->frame == NULL) {
+        download_codec_stage_free(codec);
+        return download_verify_error(UPLINK_ERROR_INTERNAL, "Out of memory");
+    }
+    
+    uint64_t start = (uint64_t)work_data->offset;
+    uint64_t end = work_data->length < 0 ? raw_size : start + (uint64_t)work_data->length;
+    if (start > raw_size) start = raw_size;
+    if (end > raw_size) end = raw_size;
+    codec->raw_position = start;
+    codec->raw_end = end;
+    if (work_data->offset == 0 && work_data->length < 0) {
+        work_data->codec = codec;
+        return NULL;
+    }
+    
+    /* The download was opened on stored offsets; reopen it at the frames of the range */
+    uint64_t first = start / chunk_size;
+    uint64_t last = end > start ? (end - 1) / chunk_size : first;
+    uint64_t stored_start = 0, stored_length = 0;
+    if (end > start) {
+        size_t count = (size_t)(last + 1);
+        uint8_t* index = (uint8_t*)malloc(count * sizeof(uint32_t));
+        if (index == NULL) {
+            download_codec_stage_free(codec);
+            return download_verify_error(UPLINK_ERROR_INTERNAL, "Out of memory");
+        }
+        UplinkError* error = download_read_stored_range(work_data, index_offset, index, count * sizeof(uint32_t));
+        if (error != NULL) {
+            free(index);
+            download_codec_stage_free(codec);
+            return error;
+        }
+        for (size_t i = 0; i < count; i++) {
+            uint32_t frame_length = codec_get_u32(index + i * sizeof(uint32_t));
+            if (i < first) stored_start += frame_length; else stored_length += frame_length;
+        }
+        free(index);
+    }
+    
+    uplink_free_error(uplink_close_download(work_data->result.download));
+    uplink_free_download_result(work_data->result);
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkDownloadOptions options = { .offset = (int64_t)stored_start, .length = (int64_t)stored_length };
+    work_data->result = uplink_download_object(&project, work_data->bucket_name, work_data->object_key, &options);
+    if (work_data->result.error != NULL) {
+        UplinkError* error = work_data->result.error;
+        work_data->result.error = NULL;
+        download_codec_stage_free(codec);
+        return error;
+    }
+    LOG_DEBUG("Compressed range [%llu, %llu) maps to stored [%llu, +%llu)", (unsigned long long)start,
+              (unsigned long long)end, (unsigned long long)stored_start, (unsigned long long)stored_length);
+    codec->next_chunk = first;
+    codec->skip = (size_t)(start - first * chunk_size);
+    work_data->codec = codec;
+    return NULL;
+}
+
+/**
+ * Decode the frame just read in full into the chunk buffer.
+ */
+static UplinkError* download_codec_decode(DownloadCodecStage* codec) {
+    uint32_t header = codec_get_u32(codec->frame);
+    size_t payload_length = header & ~CODEC_FRAME_STORED;
+    uint64_t chunk_start = codec->next_chunk * codec->chunk_size;
+    size_t raw_length = chunk_start < codec->raw_size && codec->raw_size - chunk_start < codec->chunk_size
+                        ? (size_t)(codec->raw_size - chunk_start) : codec->chunk_size;
+    const uint8_t* payload = codec->frame + CODEC_FRAME_HEADER_SIZE;
+    
+    if (header & CODEC_FRAME_STORED) {
+        if (payload_length != raw_length) {
+            return download_verify_error(UPLINK_ERROR_INTEGRITY, "Corrupt compressed frame %llu",
+                                         (unsigned long long)codec->next_chunk);
+        }
+        memcpy(codec->chunk, payload, raw_length);
+    } else if (codec_decompress(codec->type, payload, payload_length, codec->chunk, raw_length) != 0) {
+        return download_verify_error(UPLINK_ERROR_INTEGRITY, "Corrupt compressed frame %llu",
+                                     (unsigned long long)codec->next_chunk);
+    }
+    
+    /* Hand out only the part of the chunk inside the requested range */
+    uint64_t wanted = codec->raw_end - codec->raw_position;
+    codec->chunk_position = codec->skip;
+    codec->chunk_length = wanted < raw_length - codec->skip ? codec->skip + (size_t)wanted : raw_length;
+    codec->skip = 0;
+    codec->next_chunk++;
+    codec->frame_filled = 0;
+    return NULL;
+}
+
+/* ========== chunk cache stage ========== */
+
+/** Close the download the stage opened itself, if any */
+static void download_cache_release_network(DownloadCacheStage* cache) {
+    if (cache->reopened.download != NULL) {
+        uplink_free_error(uplink_close_download(cache->reopened.download));
+        uplink_free_download_result(cache->reopened);
+        memset(&cache->reopened, 0, sizeof(cache->reopened));
+        cache->network_position = UINT64_MAX;
+    }
+}
+
+void download_cache_stage_free(DownloadCacheStage* cache) {
+    if (cache == NULL) {
+        return;
+    }
+    download_cache_release_network(cache);
+    chunk_cache_close(cache->file);
+    free(cache->chunk);
+    free(cache->bucket_name);
+    free(cache->object_key);
+    free(cache);
+}
+
+/**
+ * Set up reading a just-opened download through the chunk cache. The
+ * download was opened at @p opened_at, the start of the chunk holding
+ * the first requested byte.
+ */
+static UplinkError* download_cache_prepare(DownloadObjectData* work_data, const UplinkObject* object,
+                                           size_t chunk_size, uint64_t opened_at) {
+    DownloadCacheStage* cache = (DownloadCacheStage*)calloc(1, sizeof(DownloadCacheStage));
+    if (cache == NULL) {
+        return download_verify_error(UPLINK_ERROR_INTERNAL, "Out of memory");
+    }
+    cache->chunk_size = chunk_size;
+    cache->content_length = object->system.content_length > 0 ? (uint64_t)object->system.content_length : 0;
+    cache->project_handle = work_data->project_handle;
+    cache->bucket_name = strdup(work_data->bucket_name);
+    cache->object_key = strdup(work_data->object_key);
+    cache->chunk = (uint8_t*)malloc(chunk_size);
+    if (cache->bucket_name == NULL || cache->object_key == NULL || cache->chunk == NULL) {
+        download_cache_stage_free(cache);
+        return download_verify_error(UPLINK_ERROR_INTERNAL, "Out of memory");
+    }
+    
+    uint64_t start = (uint64_t)work_data->offset;
+    uint64_t end = work_data->length < 0 ? cache->content_length : start + (uint64_t)work_data->length;
+    if (start > cache->content_length) start = cache->content_length;
+    if (end > cache->content_length) end = cache->content_length;
+    cache->position = start;
+    cache->end = end;
+    cache->base_download = work_data->result.download->_handle;
+    cache->network_position = opened_at;
+    cache->chunk_index = UINT64_MAX;
+    cache->file = chunk_cache_open(work_data->bucket_name, work_data->object_key, object->system.created,
+                                   cache->content_length, chunk_size);
+    work_data->cache = cache;
+    return NULL;
+}
+
+/**
+ * Read chunk @p index in full into the stage's buffer and store it. The
+ * network download is reopened at the chunk unless it is already there.
+ * Returns with the chunk partly filled when a bandwidth wait is stopped
+ * by the token.
+ */
+static UplinkError* download_cache_fetch(DownloadCacheStage* cache, size_t project_handle, CancelToken* cancel,
+                                         uint64_t index, size_t chunk_length) {
+    uint64_t chunk_start = index * cache->chunk_size;
+    if (cache->chunk_index != index) {
+        if (cache->network_position != chunk_start) {
+            download_cache_release_network(cache);
+            UplinkProject project = { ._handle = cache->project_handle };
+            UplinkDownloadOptions options = { .offset = (int64_t)chunk_start, .length = -1 };
+            cache->reopened = uplink_download_object(&project, cache->bucket_name, cache->object_key, &options);
+            if (cache->reopened.error != NULL) {
+                UplinkError* error = cache->reopened.error;
+                cache->reopened.error = NULL;
+                uplink_free_download_result(cache->reopened);
+                memset(&cache->reopened, 0, sizeof(cache->reopened));
+                return error;
+            }
+            cache->network_position = chunk_start;
+        }
+        cache->chunk_index = index;
+        cache->chunk_filled = 0;
+    }
+    
+    UplinkDownload download = { ._handle = cache->reopened.download != NULL ? cache->reopened.download->_handle
+                                                                            : cache->base_download };
+    while (cache->chunk_filled < chunk_length) {
+        UplinkReadResult read = download_read_limited(&download, project_handle, cancel,
+                                                      cache->chunk + cache->chunk_filled,
+                                                      chunk_length - cache->chunk_filled);
+        cache->chunk_filled += read.bytes_read;
+        cache->network_position += read.bytes_read;
+        if (read.error != NULL) {
+            if (read.error->code != EOF) {
+                return read.error;
+            }
+            uplink_free_error(read.error);
+            if (cache->chunk_filled < chunk_length) {
+                return download_verify_error(UPLINK_ERROR_INTEGRITY, "Object ended before its content length");
+            }
+            break;
+        }
+        if (read.bytes_read == 0) {
+            return NULL;  /* Bandwidth wait stopped by the token */
+        }
+    }
+    
+    chunk_cache_put(cache->file, index, cache->chunk, chunk_length);
+    chunk_cache_count(0, chunk_length);
+    return NULL;
+}
+
+/**
+ * Read up to @p length bytes through the chunk cache. Consecutive cached
+ * chunks are copied in one read; a read stops before a missing chunk
+ * once it has bytes to hand out.
+ */
+static UplinkReadResult download_cache_read(DownloadCacheStage* cache, size_t project_handle, CancelToken* cancel,
+                                            uint8_t* buf, size_t length) {
+    UplinkReadResult result = { 0 };
+    uint64_t hit_bytes = 0;
+    while (result.bytes_read < length && cache->position < cache->end) {
+        uint64_t index = cache->position / cache->chunk_size;
+        uint64_t chunk_start = index * cache->chunk_size;
+        size_t chunk_length = cache->content_length - chunk_start < cache->chunk_size
+                              ? (size_t)(cache->content_length - chunk_start) : cache->chunk_size;
+        
+        const uint8_t* source;
+        bool hit = false;
+        if (cache->chunk_index == index && cache->chunk_filled == chunk_length) {
+            source = cache->chunk;
+        } else if ((source = chunk_cache_get(cache->file, index)) != NULL) {
+            hit = true;
+        } else {
+            if (result.bytes_read > 0) {
+                break;
+            }
+            result.error = download_cache_fetch(cache, project_handle, cancel, index, chunk_length);
+            if (result.error != NULL || cache->chunk_filled < chunk_length) {
+                break;
+            }
+            source = cache->chunk;
+        }
+        
+        size_t within = (size_t)(cache->position - chunk_start);
+        size_t n = chunk_length - within;
+        if (n > length - result.bytes_read) n = length - result.bytes_read;
+        if (n > cache->end - cache->position) n = (size_t)(cache->end - cache->position);
+        memcpy(buf + result.bytes_read, source + within, n);
+        result.bytes_read += n;
+        cache->position += n;
+        if (hit) hit_bytes += n;
+    }
+    
+    if (hit_bytes > 0) {
+        chunk_cache_count(hit_bytes, 0);
+    }
+    if (cache->position >= cache->end) {
+        download_cache_release_network(cache);
+        if (result.bytes_read == 0 && result.error == NULL) {
+            result.error = download_verify_error(EOF, "EOF");
+        }
+    }
+    return result;
+}
+
+/**
+ * Read up to @p length original bytes through the decompression or chunk
+ * cache stage, or straight from the download without one. Follows
+ * uplink's read contract: short reads are normal and the end is an EOF
+ * error.
+ */
+static UplinkReadResult download_stage_read(UplinkDownload* download, size_t project_handle, CancelToken* cancel,
+                                            DownloadCodecStage* codec, DownloadCacheStage* cache,
+                                            uint8_t* buf, size_t length) {
+    if (cache != NULL) {
+        return download_cache_read(cache, project_handle, cancel, buf, length);
+    }
+    if (codec == NULL) {
+        return download_read_limited(download, project_handle, cancel, buf, length);
+    }
+    
+    UplinkReadResult result = { 0 };
+    while (codec->chunk_position == codec->chunk_length) {
+        if (codec->raw_position >= codec->raw_end) {
+            result.error = download_verify_error(EOF, "EOF");
+            return result;
+        }
+        
+        size_t needed = CODEC_FRAME_HEADER_SIZE;
+        if (codec->frame_filled >= CODEC_FRAME_HEADER_SIZE) {
+            needed += codec_get_u32(codec->frame) & ~CODEC_FRAME_STORED;
+        }
+        if (needed > CODEC_FRAME_HEADER_SIZE + codec->chunk_size) {
+            result.error = download_verify_error(UPLINK_ERROR_INTEGRITY, "Corrupt compressed frame %llu",
+                                                 (unsigned long long)codec->next_chunk);
+            return result;
+        }
+        if (codec->frame_filled < needed) {
+            UplinkReadResult read = download_read_limited(download, project_handle, cancel,
+                                                          codec->frame + codec->frame_filled, needed - codec->frame_filled);
+            codec->frame_filled += read.bytes_read;
+            if (read.error != NULL && (read.error->code != EOF || codec->frame_filled < needed)) {
+                if (read.error->code == EOF) {
+                    uplink_free_error(read.error);
+                    read.error = download_verify_error(UPLINK_ERROR_INTEGRITY, "Compressed object is truncated");
+                }
+                result.error = read.error;
+                return result;
+            }
+            uplink_free_error(read.error);
+            if (read.bytes_read == 0) {
+                return result;  /* Bandwidth wait stopped by the token */
+            }
+            continue;  /* The header may have just arrived */
+        }
+        
+        result.error = download_codec_decode(codec);
+        if (result.error != NULL) {
+            return result;
+        }
+    }
+    
+    size_t available = codec->chunk_length - codec->chunk_position;
+    size_t n = length < available ? length : available;
+    memcpy(buf, codec->chunk + codec->chunk_position, n);
+    codec->chunk_position += n;
+    codec->raw_position += n;
+    result.bytes_read = n;
+    return result;
+}
+
+/**
+ * Read through the read-ahead stage: hand out buffered bytes, refilling
+ * the window from the stages below when it is empty. Reads at least as
+ * large as the window, and all reads of random handles, go straight to
+ * the stages below; the stage then only tracks the offset.
+ */
+static UplinkReadResult download_ahead_read(UplinkDownload* download, size_t project_handle, CancelToken* cancel,
+                                            DownloadCodecStage* codec, DownloadCacheStage* cache,
+                                            ReadAheadStage* ahead, uint8_t* buf, size_t length) {
+    if (ahead == NULL) {
+        return download_stage_read(download, project_handle, cancel, codec, cache, buf, length);
+    }
+    
+    UplinkReadResult result = { 0 };
+    if (ahead->position < ahead->filled) {
+        ahead->served++;
+    } else if (ahead->eof) {
+        result.error = download_verify_error(EOF, "EOF");
+        return result;
+    } else if (ahead->mode == READ_AHEAD_RANDOM || length >= ahead->window) {
+        result = download_stage_read(download, project_handle, cancel, codec, cache, buf, length);
+        ahead->offset += result.bytes_read;
+        return result;
+    } else {
+        if (ahead->capacity < ahead->window) {
+            uint8_t* grown = (uint8_t*)realloc(ahead->buffer, ahead->window);
+            if (grown == NULL) {
+                result = download_stage_read(download, project_handle, cancel, codec, cache, buf, length);
+                ahead->offset += result.bytes_read;
+                return result;
+            }
+            ahead->buffer = grown;
+            ahead->capacity = ahead->window;
+        }
+        UplinkReadResult fill = download_stage_read(download, project_handle, cancel, codec, cache, ahead->buffer,
+                                                    cancel_token_slice(cancel, ahead->window));
+        ahead->position = 0;
+        ahead->filled = fill.bytes_read;
+        ahead->prefetched += fill.bytes_read;
+        if (fill.bytes_read == 0) {
+            return fill;    /* EOF, an error, or a bandwidth wait stopped by the token */
+        }
+        if (fill.error != NULL && fill.error->code == EOF) {
+            ahead->eof = true;
+            uplink_free_error(fill.error);
+        } else {
+            result.error = fill.error;
+        }
+        
+        /* A drained window means the pass goes on: read further ahead next time */
+        size_t next = ahead->policy->next_window(ahead->window, ahead->max_window);
+        if (next > ahead->window) {
+            ahead->window = next;
+            ahead->growths++;
+        }
+    }
+    
+    size_t available = ahead->filled - ahead->position;
+    size_t n = length < available ? length : available;
+    memcpy(buf, ahead->buffer + ahead->position, n);
+    ahead->position += n;
+    ahead->offset += n;
+    result.bytes_read = n;
+    return result;
+}
+
+/* ========== open attempts ========== */
+
+/**
+ * Allocate an attempt at opening bucket/key. Hedged attempts copy the
+ * names, since the loser may still run after the work data is gone.
+ * @return The attempt, or NULL on OOM
+ */
+static DownloadAttempt* download_attempt_new(size_t project_handle, char* bucket_name, char* object_key,
+                                             bool copy_names) {
+    DownloadAttempt* attempt = (DownloadAttempt*)calloc(1, sizeof(DownloadAttempt));
+    if (attempt == NULL) {
+        return NULL;
+    }
+    attempt->project_handle = project_handle;
+    attempt->bucket_name = copy_names ? strdup(bucket_name) : bucket_name;
+    attempt->object_key = copy_names ? strdup(object_key) : object_key;
+    attempt->owns_names = copy_names;
+    attempt->max_size = -1;
+    if (attempt->bucket_name == NULL || attempt->object_key == NULL) {
+        if (copy_names) {
+            free(attempt->bucket_name);
+            free(attempt->object_key);
+        }
+        free(attempt);
+        return NULL;
+    }
+    return attempt;
+}
+
+/**
+ * Release an attempt and whatever it still holds (any thread). A blob
+ * here was never shared, so dropping it off the main thread is safe.
+ */
+static void download_attempt_free(void* arg) {
+    DownloadAttempt* attempt = (DownloadAttempt*)arg;
+    if (attempt == NULL) {
+        return;
+    }
+    if (attempt->download.download != NULL) {
+        uplink_free_error(uplink_close_download(attempt->download.download));
+    }
+    if (attempt->download.download != NULL || attempt->download.error != NULL) {
+        uplink_free_download_result(attempt->download);
+    }
+    if (attempt->info.object != NULL || attempt->info.error != NULL) {
+        uplink_free_object_result(attempt->info);
+    }
+    if (attempt->blob != NULL) {
+        object_cache_blob_release(attempt->blob);
+    } else {
+        free(attempt->data);
+    }
+    uplink_free_error(attempt->error);
+    if (attempt->owns_names) {
+        free(attempt->bucket_name);
+        free(attempt->object_key);
+    }
+    free(attempt);
+}
+
+/** Open attempt of download_object: just the open */
+static int download_open_attempt(void* arg) {
+    DownloadAttempt* attempt = (DownloadAttempt*)arg;
+    UplinkProject project = { ._handle = attempt->project_handle };
+    attempt->download = uplink_download_object(&project, attempt->bucket_name, attempt->object_key, &attempt->options);
+    return attempt->download.error == NULL ? 0 : -1;
+}
+
+/**
+ * Open attempt of get_object: open, size the buffer from the info and
+ * make the first read, so a stall anywhere before the first byte can be
+ * hedged. Errors land in attempt->error; the download stays open either way.
+ */
+static int get_object_attempt(void* arg) {
+    DownloadAttempt* attempt = (DownloadAttempt*)arg;
+    UplinkProject project = { ._handle = attempt->project_handle };
+    attempt->download = uplink_download_object(&project, attempt->bucket_name, attempt->object_key, &attempt->options);
+    if (attempt->download.error != NULL) {
+        attempt->error = attempt->download.error;
+        attempt->download.error = NULL;
+        return -1;
+    }
+    
+    /* The content length sizes the one buffer the object is read into */
+    attempt->info = uplink_download_info(attempt->download.download);
+    if (attempt->info.error != NULL) {
+        attempt->error = attempt->info.error;
+        attempt->info.error = NULL;
+        return -1;
+    }
+    if (object_is_compressed(attempt->info.object)) {
+        attempt->error = download_verify_error(UPLINK_ERROR_COMPRESSED_OBJECT, OBJECT_COMPRESSED_MESSAGE);
+        return -1;
+    }
+    
+    int64_t content_length = attempt->info.object->system.content_length;
+    if (content_length < 0 || (attempt->max_size >= 0 && content_length > attempt->max_size)) {
+        attempt->error = download_verify_error(UPLINK_ERROR_INTERNAL, "Object is %lld bytes, larger than maxSize %lld",
+                                               (long long)content_length, (long long)attempt->max_size);
+        return -1;
+    }
+    
+    size_t size = (size_t)content_length;
+    if (attempt->cache_max_size > 0 && size <= attempt->cache_max_size) {
+        attempt->blob = object_cache_blob_alloc(size);
+        attempt->data = attempt->blob != NULL ? attempt->blob->data : NULL;
+    } else {
+        attempt->data = (uint8_t*)malloc(size > 0 ? size : 1);
+    }
+    if (attempt->data == NULL) {
+        attempt->error = download_verify_error(UPLINK_ERROR_INTERNAL, "Out of memory");
+        return -1;
+    }
+    
+    if (size > 0) {
+        UplinkReadResult read = download_read_limited(attempt->download.download, attempt->project_handle, attempt->cancel,
+                                                      attempt->data, size < DOWNLOAD_FIRST_READ_SIZE ? size : DOWNLOAD_FIRST_READ_SIZE);
+        attempt->length = read.bytes_read;
+        if (read.error != NULL && read.error->code == EOF) {
+            uplink_free_error(read.error);
+            attempt->eof = true;
+        } else if (read.error != NULL) {
+            attempt->error = read.error;
+            return -1;
+        }
+    }
+    attempt->first_byte_at = uv_hrtime();
+    return 0;
+}
+
+/**
+ * Run an open attempt, racing it against a duplicate when @p delay_ns is
+ * not 0, in which case @p primary must own its names. @p primary is
+ * consumed; the attempt to use is returned.
+ */
+static DownloadAttempt* download_attempt_run(HedgeRunFn run, DownloadAttempt* primary, uint64_t delay_ns) {
+    if (delay_ns == 0) {
+        run(primary);
+        return primary;
+    }
+    DownloadAttempt* backup = download_attempt_new(primary->project_handle, primary->bucket_name,
+                                                   primary->object_key, true);
+    if (backup == NULL) {
+        run(primary);
+        return primary;
+    }
+    backup->options = primary->options;
+    backup->max_size = primary->max_size;
+    backup->cache_max_size = primary->cache_max_size;
+    return (DownloadAttempt*)hedge_run(run, download_attempt_free, primary, backup, delay_ns, NULL);
+}
+
+/**
+ * Open the download of @p work_data into work_data->result, racing a
+ * second open when options.hedge was given
+ */
+static void download_object_open(DownloadObjectData* work_data, UplinkDownloadOptions* options) {
+    if (work_data->hedge_delay_ns == 0) {
+        UplinkProject project = { ._handle = work_data->project_handle };
+        work_data->result = uplink_download_object(&project, work_data->bucket_name, work_data->object_key, options);
+        return;
+    }
+    
+    DownloadAttempt* attempt = download_attempt_new(work_data->project_handle, work_data->bucket_name,
+                                                    work_data->object_key, true);
+    if (attempt != NULL) {
+        attempt->options = *options;
+        attempt = download_attempt_run(download_open_attempt, attempt, work_data->hedge_delay_ns);
+    }
+    if (attempt == NULL) {
+        work_data->result.error = download_verify_error(UPLINK_ERROR_INTERNAL, "Out of memory");
+        return;
+    }
+    work_data->result = attempt->download;
+    attempt->download.download = NULL;
+    attempt->download.error = NULL;
+    download_attempt_free(attempt);
+}
+
 /* ========== download_object execute ========== */
 
 void download_object_execute(napi_env env, void* data) {
@@ -22,17 +860,70 @@ void download_object_execute(napi_env env, void* data) {
               work_data->bucket_name, work_data->object_key, 
               (long long)work_data->offset, (long long)work_data->length);
     
-    /* Reconstruct project from handle */
-    UplinkProject project = { ._handle = work_data->project_handle };
-    
     /* Setup download options */
     UplinkDownloadOptions options = {
         .offset = work_data->offset,
         .length = work_data->length
     };
     
-    /* Call uplink-c */
-    work_data->result = uplink_download_object(&project, work_data->bucket_name, work_data->object_key, &options);
+    /* Through the chunk cache, reads start at a chunk boundary and may run past the range */
+    size_t cache_chunk_size = work_data->chunk_cache ? chunk_cache_chunk_size() : 0;
+    if (cache_chunk_size > 0) {
+        options.offset -= options.offset % (int64_t)cache_chunk_size;
+        options.length = -1;
+    }
+    
+    /* Call uplink-c, racing a second open if the first one stalls */
+    for (uint32_t attempt = 1;; attempt++) {
+        download_object_open(work_data, &options);
+        if (work_data->result.error == NULL ||
+            !retry_backoff(&work_data->retry, attempt, work_data->result.error->code, work_data->cancel, "downloadObject")) {
+            break;
+        }
+        uplink_free_download_result(work_data->result);
+        work_data->result.error = NULL;
+    }
+    if (work_data->result.error == NULL && cancel_token_is_cancelled(work_data->cancel)) {
+        /* Nobody will get the handle, so close the download right away */
+        uplink_free_error(uplink_close_download(work_data->result.download));
+        uplink_free_download_result(work_data->result);
+        work_data->result.download = NULL;
+        work_data->cancelled = true;
+        return;
+    }
+    
+    if (work_data->result.error == NULL &&
+        (work_data->verify_type != CHECKSUM_NONE || work_data->decompress || cache_chunk_size > 0)) {
+        /* Info comes with the open download, so this costs no round trip */
+        UplinkObjectResult info = uplink_download_info(work_data->result.download);
+        UplinkError* error = info.error;
+        info.error = NULL;
+        if (error == NULL && work_data->decompress) {
+            error = download_codec_prepare(work_data, info.object);
+        }
+        if (error == NULL && cache_chunk_size > 0 && work_data->codec == NULL) {
+            error = download_cache_prepare(work_data, info.object, cache_chunk_size, (uint64_t)options.offset);
+        }
+        if (error == NULL && work_data->verify_type != CHECKSUM_NONE) {
+            uint64_t content_length = work_data->codec != NULL ? work_data->codec->raw_size
+                                                               : (uint64_t)info.object->system.content_length;
+            error = download_verify_prepare(work_data, info.object, content_length);
+        }
+        uplink_free_object_result(info);
+        if (error != NULL) {
+            download_codec_stage_free(work_data->codec);
+            work_data->codec = NULL;
+            download_cache_stage_free(work_data->cache);
+            work_data->cache = NULL;
+            if (work_data->result.download != NULL) {
+                /* NULL when reopening at a compressed range failed */
+                uplink_free_error(uplink_close_download(work_data->result.download));
+            }
+            uplink_free_download_result(work_data->result);
+            work_data->result.download = NULL;
+            work_data->result.error = error;
+        }
+    }
     
     if (work_data->result.error) {
         LOG_ERROR("download_object_execute failed: %s", work_data->result.error->message);
@@ -58,15 +949,828 @@ void download_read_execute(napi_env env, void* data) {
      * The JavaScript caller is responsible for looping until all bytes are read.
      * EOF is returned as an error (error->code == EOF) which the complete handler
      * will reject, letting the JS caller catch it and break its read loop.
+     * With eof_as_value the EOF error is dropped here and reported as a flag,
+     * so the final read of every object skips building a JS Error.
      */
     uint8_t* buf = (uint8_t*)work_data->buffer_ptr;
-    work_data->result = uplink_download_read(&download, buf, work_data->data_length);
+    work_data->result = download_ahead_read(&download, work_data->bandwidth_project, work_data->cancel,
+                                            work_data->codec, work_data->cache, work_data->ahead,
+                                            buf, work_data->data_length);
+    if (work_data->result.bytes_read == 0 && work_data->result.error == NULL && work_data->data_length > 0) {
+        /* Only a bandwidth wait stopped by the token reads nothing without EOF */
+        work_data->cancelled = true;
+        return;
+    }
+    
+    if (work_data->verify != NULL) {
+        bool eof = work_data->result.error != NULL && work_data->result.error->code == EOF;
+        download_verify_report(&work_data->result.error,
+                               download_verify_update(work_data->verify, buf, work_data->result.bytes_read, eof));
+    }
+    download_tee_update(work_data->tee, buf, work_data->result.bytes_read, &work_data->result.error);
+    
+    if (work_data->eof_as_value && work_data->result.error != NULL && work_data->result.error->code == EOF) {
+        uplink_free_error(work_data->result.error);
+        work_data->result.error = NULL;
+        work_data->eof = true;
+    }
     
     LOG_DEBUG("download_read_execute: bytes_read=%zu, error=%s",
               work_data->result.bytes_read,
               work_data->result.error ? (work_data->result.error->message ? work_data->result.error->message : "(EOF)") : "none");
 }
 
+/* ========== download_read_full execute ========== */
+
+void download_read_full_execute(napi_env env, void* data) {
+    (void)env;
+    DownloadReadData* work_data = (DownloadReadData*)data;
+    
+    LOG_DEBUG("download_read_full_execute: handle=%zu, length=%zu", work_data->download_handle, work_data->data_length);
+    
+    UplinkDownload download = { ._handle = work_data->download_handle };
+    
+    /*
+     * Loop over partial reads here so filling the buffer costs one thread
+     * hop no matter how Go's reader splits the stream. EOF ends the loop
+     * and is reported through the eof flag rather than as an error.
+     */
+    uint8_t* buf = (uint8_t*)work_data->buffer_ptr;
+    size_t total = 0;
+    while (total < work_data->data_length) {
+        if (cancel_token_is_cancelled(work_data->cancel)) {
+            work_data->cancelled = true;
+            break;
+        }
+        UplinkReadResult read = download_ahead_read(&download, work_data->bandwidth_project, work_data->cancel,
+                                                    work_data->codec, work_data->cache, work_data->ahead, buf + total,
+                                                    cancel_token_slice(work_data->cancel, work_data->data_length - total));
+        total += read.bytes_read;
+        
+        if (read.error != NULL) {
+            if (read.error->code == EOF) {
+                work_data->eof = true;
+                uplink_free_error(read.error);
+            } else {
+                work_data->result.error = read.error;
+            }
+            break;
+        }
+    }
+    work_data->result.bytes_read = total;
+    
+    if (work_data->verify != NULL) {
+        download_verify_report(&work_data->result.error,
+                               download_verify_update(work_data->verify, buf, total, work_data->eof));
+    }
+    download_tee_update(work_data->tee, buf, total, &work_data->result.error);
+    
+    LOG_DEBUG("download_read_full_execute: bytes_read=%zu, eof=%d, error=%s",
+              total, work_data->eof,
+              work_data->result.error ? work_data->result.error->message : "none");
+}
+
+/* ========== download_to_file execute ========== */
+
+/**
+ * Record an error for download_to_file. Takes ownership of @p error when
+ * given, otherwise formats @p fallback with strerror(errno).
+ */
+static void download_to_file_set_error(DownloadToFileData* work_data, UplinkError* error, const char* fallback) {
+    if (error != NULL) {
+        work_data->error_code = error->code;
+        work_data->error_message = strdup(error->message ? error->message : "unknown error");
+        uplink_free_error(error);
+        return;
+    }
+    
+    const char* reason = strerror(errno);
+    size_t len = strlen(fallback) + strlen(work_data->file_path) + strlen(reason) + 8;
+    work_data->error_code = UPLINK_ERROR_INTERNAL;
+    work_data->error_message = (char*)malloc(len);
+    if (work_data->error_message != NULL) {
+        snprintf(work_data->error_message, len, "%s '%s': %s", fallback, work_data->file_path, reason);
+    }
+}
+
+void download_to_file_execute(napi_env env, void* data) {
+    (void)env;
+    DownloadToFileData* work_data = (DownloadToFileData*)data;
+    LOG_DEBUG("Downloading %s/%s to '%s' (offset=%lld, length=%lld, chunk=%zu)",
+              work_data->bucket_name, work_data->object_key, work_data->file_path,
+              (long long)work_data->offset, (long long)work_data->length, work_data->chunk_size);
+    
+    uint8_t* chunk = (uint8_t*)buffer_pool_acquire(work_data->chunk_size);
+    if (chunk == NULL) {
+        errno = ENOMEM;
+        download_to_file_set_error(work_data, NULL, "cannot allocate buffer for");
+        return;
+    }
+    
+    int fd = file_open_write(work_data->file_path, 1);
+    if (fd < 0) {
+        download_to_file_set_error(work_data, NULL, "cannot open file");
+        buffer_pool_release(chunk);
+        return;
+    }
+    
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkDownloadOptions options = {
+        .offset = work_data->offset,
+        .length = work_data->length
+    };
+    UplinkDownloadResult download_result = uplink_download_object(&project, work_data->bucket_name,
+                                                                  work_data->object_key, &options);
+    if (download_result.error != NULL) {
+        download_to_file_set_error(work_data, download_result.error, NULL);
+        download_result.error = NULL;
+        uplink_free_download_result(download_result);
+        file_close(fd);
+        buffer_pool_release(chunk);
+        return;
+    }
+    
+    /* Codec frames would land in the file as-is; only downloadObject() decodes them */
+    UplinkObjectResult info = uplink_download_info(download_result.download);
+    if (info.error == NULL && object_is_compressed(info.object)) {
+        uplink_free_object_result(info);
+        download_to_file_set_error(work_data, download_verify_error(UPLINK_ERROR_COMPRESSED_OBJECT,
+                                                                    OBJECT_COMPRESSED_MESSAGE), NULL);
+        uplink_free_error(uplink_close_download(download_result.download));
+        uplink_free_download_result(download_result);
+        file_close(fd);
+        buffer_pool_release(chunk);
+        return;
+    }
+    if (work_data->progress != NULL && info.error == NULL &&
+        info.object->system.content_length >= work_data->offset) {
+        /* The requested range, clipped to the object, is the total */
+        int64_t total = info.object->system.content_length - work_data->offset;
+        if (work_data->length >= 0 && work_data->length < total) {
+            total = work_data->length;
+        }
+        progress_set_total(work_data->progress, (uint64_t)total);
+    }
+    uplink_free_object_result(info);
+    
+    /* Read into one reusable native buffer and pwrite it out; the JS heap is never touched */
+    while (!cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        UplinkReadResult read = download_read_limited(download_result.download, work_data->project_handle,
+                                                      work_data->cancel, chunk,
+                                                      progress_slice(work_data->progress, work_data->chunk_size));
+        if (read.bytes_read > 0) {
+            if (file_write_at(fd, chunk, read.bytes_read, (int64_t)work_data->bytes_written) < 0) {
+                uplink_free_error(read.error);
+                download_to_file_set_error(work_data, NULL, "cannot write file");
+                break;
+            }
+            work_data->bytes_written += read.bytes_read;
+            progress_add(work_data->progress, (int64_t)read.bytes_read);
+        }
+        if (read.error != NULL) {
+            if (read.error->code == EOF) {
+                uplink_free_error(read.error);
+            } else {
+                download_to_file_set_error(work_data, read.error, NULL);
+            }
+            break;
+        }
+    }
+    
+    if (work_data->error_code == 0 && work_data->fsync && file_sync(fd) != 0) {
+        download_to_file_set_error(work_data, NULL, "cannot sync file");
+    }
+    
+    UplinkError* close_error = uplink_close_download(download_result.download);
+    if (close_error != NULL && work_data->error_code == 0) {
+        download_to_file_set_error(work_data, close_error, NULL);
+    } else {
+        uplink_free_error(close_error);
+    }
+    
+    uplink_free_download_result(download_result);
+    file_close(fd);
+    buffer_pool_release(chunk);
+    LOG_DEBUG("Downloaded %zu bytes to '%s'", work_data->bytes_written, work_data->file_path);
+}
+
+/* ========== download_parallel execute ========== */
+
+/** Read granularity for file sinks, bounds memory to concurrency * chunk */
+#define PARALLEL_DOWNLOAD_READ_CHUNK (1024 * 1024)
+
+/** Base delay before retrying a failed range, doubled per attempt */
+#define PARALLEL_DOWNLOAD_RETRY_BASE_MS 100
+
+/**
+ * Shared state for the native range workers of one downloadParallel call.
+ * Workers claim range indices under the lock until all ranges are done
+ * or one range has failed permanently.
+ */
+typedef struct {
+    DownloadParallelData* job;
+    UplinkProject project;
+    int fd;                     /* File sink, or -1 for buffer sinks */
+    PartTuner* tuner;           /* Sizes and paces ranges when auto_tune, else NULL */
+    uv_mutex_t lock;
+    uint32_t next_range;
+    uint64_t next_offset;       /* First byte not yet claimed */
+    bool failed;
+} ParallelDownloadState;
+
+/**
+ * Failure of a single range attempt, copied out of the uplink error
+ * so the error itself can be freed at the point of failure.
+ */
+typedef struct {
+    int32_t code;
+    char message[256];
+} ParallelRangeFailure;
+
+static void parallel_range_failure_set(ParallelRangeFailure* failure, UplinkError* error, const char* message) {
+    failure->code = error != NULL ? error->code : UPLINK_ERROR_INTERNAL;
+    const char* text = error != NULL && error->message != NULL ? error->message : message;
+    snprintf(failure->message, sizeof(failure->message), "%s", text != NULL ? text : "unknown error");
+    if (error != NULL) {
+        uplink_free_error(error);
+    }
+}
+
+/**
+ * Record the first permanent failure; later failures are dropped.
+ */
+static void parallel_download_fail(ParallelDownloadState* state, const ParallelRangeFailure* failure) {
+    uv_mutex_lock(&state->lock);
+    if (!state->failed) {
+        state->failed = true;
+        state->job->error_code = failure->code;
+        state->job->error_message = strdup(failure->message);
+    }
+    uv_mutex_unlock(&state->lock);
+}
+
+/**
+ * Download one range on its own stream into its slot of the sink.
+ * Buffer sinks are read into directly; file sinks go through @p chunk.
+ * @return true on success, false with @p failure filled in otherwise
+ */
+static bool parallel_download_range(ParallelDownloadState* state, uint8_t* chunk,
+                                    uint64_t offset, uint64_t length, ParallelRangeFailure* failure) {
+    DownloadParallelData* job = state->job;
+    UplinkDownloadOptions options = {
+        .offset = (int64_t)offset,
+        .length = (int64_t)length
+    };
+    
+    UplinkDownloadResult download_result = uplink_download_object(&state->project, job->bucket_name,
+                                                                  job->object_key, &options);
+    if (download_result.error != NULL) {
+        parallel_range_failure_set(failure, download_result.error, NULL);
+        download_result.error = NULL;
+        uplink_free_download_result(download_result);
+        return false;
+    }
+    
+    bool ok = true;
+    uint64_t done = 0;
+    while (ok && done < length && !state->failed) {
+        uint8_t* dest;
+        size_t want;
+        if (state->fd >= 0) {
+            dest = chunk;
+            want = (size_t)(length - done < PARALLEL_DOWNLOAD_READ_CHUNK ? length - done : PARALLEL_DOWNLOAD_READ_CHUNK);
+        } else {
+            dest = (uint8_t*)job->buffer_ptr + offset + done;
+            want = progress_slice(job->progress, cancel_token_slice(job->cancel, (size_t)(length - done)));
+        }
+        if (cancel_token_is_cancelled(job->cancel)) {
+            parallel_range_failure_set(failure, NULL, cancel_token_message(job->cancel));
+            failure->code = cancel_token_code(job->cancel);
+            ok = false;
+            break;
+        }
+        
+        UplinkReadResult read = download_read_limited(download_result.download, job->project_handle,
+                                                      job->cancel, dest, want);
+        if (read.bytes_read > 0 && state->fd >= 0 &&
+            file_write_at(state->fd, chunk, read.bytes_read, (int64_t)(offset + done)) < 0) {
+            uplink_free_error(read.error);
+            parallel_range_failure_set(failure, NULL, strerror(errno));
+            ok = false;
+            break;
+        }
+        done += read.bytes_read;
+        progress_add(job->progress, (int64_t)read.bytes_read);
+        
+        if (read.error != NULL) {
+            if (read.error->code == EOF && done == length) {
+                uplink_free_error(read.error);
+            } else if (read.error->code == EOF) {
+                uplink_free_error(read.error);
+                parallel_range_failure_set(failure, NULL, "object shrank during download");
+                ok = false;
+            } else {
+                parallel_range_failure_set(failure, read.error, NULL);
+                ok = false;
+            }
+            break;
+        }
+    }
+    
+    uplink_free_error(uplink_close_download(download_result.download));
+    uplink_free_download_result(download_result);
+    if (!(ok && done == length)) {
+        /* A retry reads the range again from its start */
+        progress_add(job->progress, -(int64_t)done);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Claim the next @p size bytes of the object.
+ * @return false when every byte is claimed or the download has failed
+ */
+static bool parallel_download_claim(ParallelDownloadState* state, uint64_t size, uint32_t* index,
+                                    uint64_t* offset, uint64_t* length) {
+    bool claimed = false;
+    uv_mutex_lock(&state->lock);
+    if (!state->failed && state->next_offset < state->job->content_length) {
+        uint64_t remaining = state->job->content_length - state->next_offset;
+        *index = state->next_range++;
+        *offset = state->next_offset;
+        *length = remaining < size ? remaining : size;
+        state->next_offset += *length;
+        claimed = true;
+    }
+    uv_mutex_unlock(&state->lock);
+    return claimed;
+}
+
+/**
+ * Native range worker: claims ranges until none remain.
+ */
+static void parallel_download_worker(void* arg) {
+    ParallelDownloadState* state = (ParallelDownloadState*)arg;
+    DownloadParallelData* job = state->job;
+    ParallelRangeFailure failure;
+    uint8_t* chunk = NULL;
+    
+    if (state->fd >= 0) {
+        chunk = (uint8_t*)buffer_pool_acquire(PARALLEL_DOWNLOAD_READ_CHUNK);
+        if (chunk == NULL) {
+            parallel_range_failure_set(&failure, NULL, "Out of memory");
+            parallel_download_fail(state, &failure);
+            return;
+        }
+    }
+    
+    for (;;) {
+        uint64_t size = state->tuner != NULL ? part_tuner_acquire(state->tuner) : job->range_size;
+        uint32_t index;
+        uint64_t offset;
+        uint64_t length;
+        if (!parallel_download_claim(state, size, &index, &offset, &length)) {
+            part_tuner_finish(state->tuner, 0, 0);
+            break;
+        }
+        
+        uint64_t started_at = uv_hrtime();
+        bool ok = false;
+        for (uint32_t attempt = 0; attempt <= job->max_retries; attempt++) {
+            if (attempt > 0) {
+                if (cancel_token_is_cancelled(job->cancel)) {
+                    break;
+                }
+                LOG_WARN("downloadParallel: retrying range %u (attempt %u/%u) after: %s",
+                         index, attempt + 1, job->max_retries + 1, failure.message);
+                uv_sleep(PARALLEL_DOWNLOAD_RETRY_BASE_MS << (attempt < 6 ? attempt - 1 : 5));
+            }
+            ok = parallel_download_range(state, chunk, offset, length, &failure);
+            if (ok || state->failed) {
+                break;
+            }
+        }
+        part_tuner_finish(state->tuner, ok ? length : 0, uv_hrtime() - started_at);
+        
+        if (!ok) {
+            if (!state->failed) {
+                LOG_ERROR("downloadParallel: range %u failed permanently: %s", index, failure.message);
+                parallel_download_fail(state, &failure);
+            }
+            break;
+        }
+        LOG_DEBUG("downloadParallel: range %u done (%llu bytes)", index, (unsigned long long)length);
+    }
+    
+    buffer_pool_release(chunk);
+}
+
+void download_parallel_execute(napi_env env, void* data) {
+    (void)env;
+    DownloadParallelData* work_data = (DownloadParallelData*)data;
+    
+    ParallelDownloadState state;
+    memset(&state, 0, sizeof(state));
+    state.job = work_data;
+    state.project._handle = work_data->project_handle;
+    state.fd = -1;
+    
+    if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        return;
+    }
+    
+    /* Stat the object to learn its size */
+    UplinkObjectResult stat = uplink_stat_object(&state.project, work_data->bucket_name, work_data->object_key);
+    if (stat.error != NULL) {
+        work_data->error_code = stat.error->code;
+        work_data->error_message = strdup(stat.error->message ? stat.error->message : "statObject failed");
+        uplink_free_object_result(stat);
+        return;
+    }
+    if (object_is_compressed(stat.object)) {
+        work_data->error_code = UPLINK_ERROR_COMPRESSED_OBJECT;
+        work_data->error_message = strdup(OBJECT_COMPRESSED_MESSAGE);
+        uplink_free_object_result(stat);
+        return;
+    }
+    work_data->content_length = stat.object->system.content_length > 0
+                                ? (uint64_t)stat.object->system.content_length : 0;
+    uplink_free_object_result(stat);
+    progress_set_total(work_data->progress, work_data->content_length);
+    
+    if (work_data->file_path != NULL) {
+        state.fd = file_open_write(work_data->file_path, 1);
+        if (state.fd < 0) {
+            work_data->error_code = UPLINK_ERROR_INTERNAL;
+            work_data->error_message = strdup(strerror(errno));
+            return;
+        }
+    } else if (work_data->content_length > work_data->buffer_length) {
+        char message[128];
+        snprintf(message, sizeof(message), "Buffer too small: object is %llu bytes",
+                 (unsigned long long)work_data->content_length);
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup(message);
+        return;
+    }
+    
+    /* With auto_tune ranges are cut as they are claimed; plan for the smallest size */
+    uint64_t plan_size = work_data->auto_tune ? PART_TUNER_MIN_SIZE : work_data->range_size;
+    work_data->range_count = (uint32_t)((work_data->content_length + plan_size - 1) / plan_size);
+    
+    LOG_DEBUG("downloadParallel: '%s/%s' %llu bytes in %u ranges, concurrency=%u (worker thread)",
+              work_data->bucket_name, work_data->object_key,
+              (unsigned long long)work_data->content_length, work_data->range_count, work_data->concurrency);
+    
+    /* Run range workers on native threads */
+    uv_mutex_init(&state.lock);
+    
+    PartTuner tuner;
+    if (work_data->auto_tune) {
+        if (part_tuner_init(&tuner, work_data->range_size, work_data->concurrency) != 0) {
+            uv_mutex_destroy(&state.lock);
+            file_close(state.fd);
+            work_data->error_code = UPLINK_ERROR_INTERNAL;
+            work_data->error_message = strdup("Failed to start the part tuner");
+            return;
+        }
+        state.tuner = &tuner;
+    }
+    
+    uint32_t thread_count = work_data->concurrency < work_data->range_count
+                            ? work_data->concurrency : work_data->range_count;
+    uv_thread_t* threads = thread_count > 0 ? (uv_thread_t*)calloc(thread_count, sizeof(uv_thread_t)) : NULL;
+    uint32_t started = 0;
+    if (threads != NULL) {
+        for (uint32_t i = 0; i < thread_count; i++) {
+            if (uv_thread_create(&threads[i], parallel_download_worker, &state) != 0) {
+                LOG_WARN("downloadParallel: could only start %u of %u threads", started, thread_count);
+                break;
+            }
+            started++;
+        }
+    }
+    if (started == 0 && work_data->range_count > 0) {
+        parallel_download_worker(&state);  /* Degrade to sequential on this thread */
+    }
+    for (uint32_t i = 0; i < started; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    free(threads);
+    uv_mutex_destroy(&state.lock);
+    
+    work_data->range_count = state.next_range;
+    if (state.tuner != NULL) {
+        part_tuner_result(state.tuner, &work_data->tuned_range_size, &work_data->tuned_concurrency,
+                          &work_data->tuned_goodput);
+        part_tuner_destroy(state.tuner);
+        LOG_DEBUG("downloadParallel: tuned to rangeSize=%llu, concurrency=%u",
+                  (unsigned long long)work_data->tuned_range_size, work_data->tuned_concurrency);
+    }
+    
+    if (state.fd >= 0) {
+        if (!state.failed && work_data->fsync && file_sync(state.fd) != 0) {
+            work_data->error_code = UPLINK_ERROR_INTERNAL;
+            work_data->error_message = strdup(strerror(errno));
+        }
+        file_close(state.fd);
+    }
+}
+
+/* ========== download_ranges execute ========== */
+
+/**
+ * Shared state of the span workers of one downloadRanges call
+ */
+typedef struct {
+    DownloadRangesData* job;
+    UplinkProject project;
+    uv_mutex_t lock;
+    uint32_t next_span;
+    bool failed;
+} DownloadRangesState;
+
+/**
+ * Download one span on its own stream into its slot of the arena
+ * @return true on success (possibly short at the end of the object)
+ */
+static bool download_ranges_span(DownloadRangesState* state, DownloadSpan* span, ParallelRangeFailure* failure) {
+    DownloadRangesData* job = state->job;
+    UplinkDownloadOptions options = {
+        .offset = (int64_t)span->offset,
+        .length = (int64_t)span->length
+    };
+    
+    UplinkDownloadResult download_result = uplink_download_object(&state->project, job->bucket_name,
+                                                                  job->object_key, &options);
+    if (download_result.error != NULL) {
+        parallel_range_failure_set(failure, download_result.error, NULL);
+        download_result.error = NULL;
+        uplink_free_download_result(download_result);
+        return false;
+    }
+    
+    /* Codec frames cannot be sliced by offset; fail the call rather than retry the span */
+    UplinkObjectResult info = uplink_download_info(download_result.download);
+    bool compressed = info.error == NULL && object_is_compressed(info.object);
+    uplink_free_object_result(info);
+    if (compressed) {
+        uv_mutex_lock(&state->lock);
+        if (!state->failed) {
+            state->failed = true;
+            job->error_code = UPLINK_ERROR_COMPRESSED_OBJECT;
+            job->error_message = strdup(OBJECT_COMPRESSED_MESSAGE);
+        }
+        uv_mutex_unlock(&state->lock);
+        uplink_free_error(uplink_close_download(download_result.download));
+        uplink_free_download_result(download_result);
+        return false;
+    }
+    
+    bool ok = true;
+    uint64_t done = 0;
+    while (done < span->length && !state->failed) {
+        if (cancel_token_is_cancelled(job->cancel)) {
+            parallel_range_failure_set(failure, NULL, cancel_token_message(job->cancel));
+            failure->code = cancel_token_code(job->cancel);
+            ok = false;
+            break;
+        }
+        UplinkReadResult read = download_read_limited(download_result.download, job->project_handle, job->cancel,
+                                                      job->arena + span->arena_offset + done,
+                                                      cancel_token_slice(job->cancel, (size_t)(span->length - done)));
+        done += read.bytes_read;
+        if (read.error != NULL) {
+            if (read.error->code == EOF) {
+                uplink_free_error(read.error);
+            } else {
+                parallel_range_failure_set(failure, read.error, NULL);
+                ok = false;
+            }
+            break;
+        }
+    }
+    
+    uplink_free_error(uplink_close_download(download_result.download));
+    uplink_free_download_result(download_result);
+    span->bytes_read = done;
+    return ok && !state->failed;
+}
+
+/**
+ * Span worker: claims spans until none remain or one failed permanently.
+ */
+static void download_ranges_worker(void* arg) {
+    DownloadRangesState* state = (DownloadRangesState*)arg;
+    DownloadRangesData* job = state->job;
+    ParallelRangeFailure failure;
+    
+    for (;;) {
+        uv_mutex_lock(&state->lock);
+        uint32_t index = state->next_span;
+        bool claimed = !state->failed && index < job->span_count;
+        if (claimed) {
+            state->next_span++;
+        }
+        uv_mutex_unlock(&state->lock);
+        if (!claimed) {
+            break;
+        }
+    
+        bool ok = false;
+        for (uint32_t attempt = 0; attempt <= job->max_retries; attempt++) {
+            if (attempt > 0) {
+                if (cancel_token_is_cancelled(job->cancel)) {
+                    break;
+                }
+                LOG_WARN("downloadRanges: retrying span %u (attempt %u/%u) after: %s",
+                         index, attempt + 1, job->max_retries + 1, failure.message);
+                uv_sleep(PARALLEL_DOWNLOAD_RETRY_BASE_MS << (attempt < 6 ? attempt - 1 : 5));
+            }
+            ok = download_ranges_span(state, &job->spans[index], &failure);
+            if (ok || state->failed) {
+                break;
+            }
+        }
+        if (!ok) {
+            uv_mutex_lock(&state->lock);
+            if (!state->failed) {
+                state->failed = true;
+                job->error_code = failure.code;
+                job->error_message = strdup(failure.message);
+                LOG_ERROR("downloadRanges: span %u failed permanently: %s", index, failure.message);
+            }
+            uv_mutex_unlock(&state->lock);
+            break;
+        }
+    }
+}
+
+void download_ranges_execute(napi_env env, void* data) {
+    (void)env;
+    DownloadRangesData* work_data = (DownloadRangesData*)data;
+    
+    DownloadRangesState state;
+    memset(&state, 0, sizeof(state));
+    state.job = work_data;
+    state.project._handle = work_data->project_handle;
+    
+    if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        return;
+    }
+    
+    /* Offsets from the end need the size; otherwise skip the stat round trip */
+    bool sized = false;
+    uint64_t content_length = 0;
+    for (uint32_t i = 0; i < work_data->range_count && !sized; i++) {
+        sized = work_data->ranges[i].offset < 0;
+    }
+    if (sized) {
+        UplinkObjectResult stat = uplink_stat_object(&state.project, work_data->bucket_name, work_data->object_key);
+        if (stat.error != NULL) {
+            work_data->error_code = stat.error->code;
+            work_data->error_message = strdup(stat.error->message ? stat.error->message : "statObject failed");
+            uplink_free_object_result(stat);
+            return;
+        }
+        content_length = stat.object->system.content_length > 0 ? (uint64_t)stat.object->system.content_length : 0;
+        uplink_free_object_result(stat);
+    }
+    
+    if (!download_ranges_plan(work_data->ranges, work_data->range_count, work_data->coalesce_gap, sized,
+                              content_length, &work_data->spans, &work_data->span_count,
+                              &work_data->arena_length) ||
+        (work_data->arena_length > 0 && (work_data->arena = (uint8_t*)malloc(work_data->arena_length)) == NULL)) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("Out of memory");
+        return;
+    }
+    
+    LOG_DEBUG("downloadRanges: '%s/%s' %u ranges in %u requests, %llu bytes (worker thread)",
+              work_data->bucket_name, work_data->object_key, work_data->range_count, work_data->span_count,
+              (unsigned long long)work_data->arena_length);
+    
+    /* This thread takes spans too, so a single span needs no extra thread */
+    uv_mutex_init(&state.lock);
+    uint32_t extra = (work_data->concurrency < work_data->span_count ? work_data->concurrency : work_data->span_count);
+    extra = extra > 0 ? extra - 1 : 0;
+    uv_thread_t* threads = extra > 0 ? (uv_thread_t*)calloc(extra, sizeof(uv_thread_t)) : NULL;
+    uint32_t started = 0;
+    if (threads != NULL) {
+        for (uint32_t i = 0; i < extra; i++) {
+            if (uv_thread_create(&threads[i], download_ranges_worker, &state) != 0) {
+                LOG_WARN("downloadRanges: could only start %u of %u threads", started, extra);
+                break;
+            }
+            started++;
+        }
+    }
+    download_ranges_worker(&state);
+    for (uint32_t i = 0; i < started; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    free(threads);
+    uv_mutex_destroy(&state.lock);
+}
+
+/* ========== get_object execute ========== */
+
+/**
+ * Record an error for get_object. Takes ownership of @p error when given.
+ */
+static void get_object_set_error(GetObjectData* work_data, UplinkError* error, const char* message) {
+    if (error != NULL) {
+        work_data->error_code = error->code;
+        work_data->error_message = strdup(error->message ? error->message : "unknown error");
+        uplink_free_error(error);
+        return;
+    }
+    work_data->error_code = UPLINK_ERROR_INTERNAL;
+    work_data->error_message = strdup(message);
+}
+
+void get_object_execute(napi_env env, void* data) {
+    (void)env;
+    GetObjectData* work_data = (GetObjectData*)data;
+    LOG_DEBUG("get_object_execute: bucket=%s, key=%s", work_data->bucket_name, work_data->object_key);
+    
+    uint64_t started_at = uv_hrtime();
+    DownloadAttempt* attempt;
+    for (uint32_t attempts = 1;; attempts++) {
+        attempt = download_attempt_new(work_data->project_handle, work_data->bucket_name,
+                                       work_data->object_key, work_data->hedge_delay_ns > 0);
+        if (attempt == NULL) {
+            get_object_set_error(work_data, NULL, "Out of memory");
+            return;
+        }
+        attempt->options.offset = 0;
+        attempt->options.length = -1;
+        attempt->max_size = work_data->max_size;
+        attempt->cache_max_size = work_data->cache_max_size;
+        attempt->cancel = work_data->hedge_delay_ns > 0 ? NULL : work_data->cancel;
+        attempt = download_attempt_run(get_object_attempt, attempt, work_data->hedge_delay_ns);
+        if (attempt->error == NULL ||
+            !retry_backoff(&work_data->retry, attempts, attempt->error->code, work_data->cancel, "getObject")) {
+            break;
+        }
+        download_attempt_free(attempt);
+    }
+    
+    /* Take over what the winning attempt opened and read */
+    UplinkDownload* download = attempt->download.download;
+    work_data->info = attempt->info;
+    attempt->info.object = NULL;
+    work_data->blob = attempt->blob;
+    work_data->data = attempt->data;
+    attempt->blob = NULL;
+    attempt->data = NULL;
+    work_data->length = attempt->length;
+    if (attempt->error != NULL) {
+        get_object_set_error(work_data, attempt->error, NULL);
+        attempt->error = NULL;
+        goto close;
+    }
+    work_data->first_byte_ns = attempt->first_byte_at - started_at;
+    
+    size_t size = (size_t)work_data->info.object->system.content_length;
+    progress_set_total(work_data->progress, size);
+    progress_add(work_data->progress, (int64_t)work_data->length);
+    
+    while (!attempt->eof && work_data->length < size &&
+           !cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        size_t want = progress_slice(work_data->progress, cancel_token_slice(work_data->cancel, size - work_data->length));
+        UplinkReadResult read = download_read_limited(download, work_data->project_handle, work_data->cancel,
+                                                      work_data->data + work_data->length, want);
+        work_data->length += read.bytes_read;
+        progress_add(work_data->progress, (int64_t)read.bytes_read);
+        if (read.error != NULL) {
+            if (read.error->code == EOF) {
+                uplink_free_error(read.error);
+            } else {
+                get_object_set_error(work_data, read.error, NULL);
+            }
+            break;
+        }
+    }
+    
+close:
+    if (download != NULL) {
+        UplinkError* close_error = uplink_close_download(download);
+        if (close_error != NULL && work_data->error_code == 0) {
+            get_object_set_error(work_data, close_error, NULL);
+        } else {
+            uplink_free_error(close_error);
+        }
+        uplink_free_download_result(attempt->download);
+        attempt->download.download = NULL;
+    }
+    download_attempt_free(attempt);
+    
+    LOG_DEBUG("get_object_execute: read %zu bytes, error=%s", work_data->length,
+              work_data->error_message ? work_data->error_message : "none");
+}
+
 /* ========== download_info execute ========== */
 
 void download_info_execute(napi_env env, void* data) {
@@ -99,6 +1803,13 @@ void close_download_execute(napi_env env, void* data) {
     /* Reconstruct download from handle */
     UplinkDownload download = { ._handle = work_data->download_handle };
     
+    if (work_data->tee != NULL) {
+        const DownloadTeeSink* failed = download_tee_finish(work_data->tee);
+        if (failed != NULL) {
+            work_data->tee_error = strdup(failed->error_message);
+        }
+    }
+    
     /* Call uplink-c */
     work_data->error = uplink_close_download(&download);
     
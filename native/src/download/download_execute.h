@@ -7,11 +7,34 @@
 #define DOWNLOAD_EXECUTE_H
 
 #include <node_api.h>
+#include "download_types.h"
 
 /* Execute functions - run on worker thread */
 void download_object_execute(napi_env env, void* data);
 void download_read_execute(napi_env env, void* data);
+void download_read_full_execute(napi_env env, void* data);
+void download_to_file_execute(napi_env env, void* data);
+void download_parallel_execute(napi_env env, void* data);
+void download_ranges_execute(napi_env env, void* data);
+void get_object_execute(napi_env env, void* data);
 void download_info_execute(napi_env env, void* data);
 void close_download_execute(napi_env env, void* data);
 
+/**
+ * Compare the digest of a verified download with the expected one and
+ * mark it done (any thread)
+ * @return An IntegrityError on mismatch, else NULL
+ */
+UplinkError* download_verify_finish(DownloadVerifyState* verify);
+
+/**
+ * Free the decompression stage of a download (NULL is a no-op)
+ */
+void download_codec_stage_free(DownloadCodecStage* codec);
+
+/**
+ * Free a chunk cache stage, closing its cache file and any download it opened (NULL is a no-op)
+ */
+void download_cache_stage_free(DownloadCacheStage* cache);
+
 #endif /* DOWNLOAD_EXECUTE_H */
@@ -13,16 +13,161 @@
 #include "download_types.h"
 #include "download_execute.h"
 #include "download_complete.h"
+#include "../common/addon_instance.h"
 #include "../common/handle_helpers.h"
 #include "../common/string_helpers.h"
 #include "../common/buffer_helpers.h"
+#include "../common/buffer_pool.h"
+#include "../common/work_pool.h"
 #include "../common/result_helpers.h"
 #include "../common/type_converters.h"
+#include "../common/thread_pool.h"
+#include "../common/admission.h"
+#include "../common/part_tuner.h"
+#include "../common/cancel_token.h"
+#include "../common/chunk_cache.h"
+#include "../common/hedge.h"
+#include "../common/op_metrics.h"
+#include "../common/retry.h"
 #include "../common/logger.h"
 
+#include <uv.h>
+#include <ctype.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/* ========== helper: content verification ========== */
+
+/**
+ * Parse options.verify: { algorithm, expected? | fromMetadataKey? }.
+ * Without either source the digest is read from the metadata written by
+ * an inline upload checksum ("checksum-<algorithm>"). Verification covers
+ * the whole object, so it cannot be combined with a range.
+ * @return 0 on success (type CHECKSUM_NONE when absent), -1 with an exception pending
+ */
+static int extract_verify_option(napi_env env, napi_value options, int64_t offset, int64_t length,
+                                 ChecksumType* out_type, char** out_expected, char** out_key) {
+    *out_type = CHECKSUM_NONE;
+    *out_expected = NULL;
+    *out_key = NULL;
+    
+    bool has_verify = false;
+    napi_has_named_property(env, options, "verify", &has_verify);
+    if (!has_verify) {
+        return 0;
+    }
+    napi_value verify;
+    napi_valuetype type;
+    napi_get_named_property(env, options, "verify", &verify);
+    napi_typeof(env, verify, &type);
+    if (type == napi_undefined) {
+        return 0;
+    }
+    if (type != napi_object) {
+        throw_type_error(env, "verify must be an object");
+        return -1;
+    }
+    if (offset != 0 || length >= 0) {
+        throw_type_error(env, "verify checks the whole object and cannot be combined with offset or length");
+        return -1;
+    }
+    
+    char* algorithm = get_string_property(env, verify, "algorithm");
+    ChecksumType checksum_type = algorithm != NULL ? checksum_type_from_name(algorithm) : CHECKSUM_NONE;
+    free(algorithm);
+    if (checksum_type == CHECKSUM_NONE) {
+        throw_type_error(env, "verify.algorithm must be 'crc32c' or 'sha256'");
+        return -1;
+    }
+    
+    char* expected = get_string_property(env, verify, "expected");
+    char* key = get_string_property(env, verify, "fromMetadataKey");
+    if (expected != NULL && key != NULL) {
+        free(expected);
+        free(key);
+        throw_type_error(env, "verify takes expected or fromMetadataKey, not both");
+        return -1;
+    }
+    if (expected != NULL) {
+        size_t expected_length = strlen(expected);
+        bool valid = expected_length == checksum_hex_length(checksum_type);
+        for (size_t i = 0; valid && i < expected_length; i++) {
+            valid = isxdigit((unsigned char)expected[i]) != 0;
+            expected[i] = (char)tolower((unsigned char)expected[i]);
+        }
+        if (!valid) {
+            free(expected);
+            throw_type_error(env, "verify.expected must be a hex digest of the algorithm");
+            return -1;
+        }
+    }
+    if (key == NULL) {
+        const char* name = checksum_type_name(checksum_type);
+        key = (char*)malloc(strlen(DOWNLOAD_VERIFY_KEY_PREFIX) + strlen(name) + 1);
+        if (key == NULL) {
+            free(expected);
+            throw_error(env, "Out of memory");
+            return -1;
+        }
+        strcpy(key, DOWNLOAD_VERIFY_KEY_PREFIX);
+        strcat(key, name);
+    }
+    
+    *out_type = checksum_type;
+    *out_expected = expected;
+    *out_key = key;
+    return 0;
+}
+
+/**
+ * Get the verification/decompression state attached to a download handle, if any.
+ */
+static DownloadHandleState* get_download_state(napi_env env, napi_value js_handle) {
+    HandleWrapper* wrapper = get_handle_wrapper(env, js_handle, HANDLE_TYPE_DOWNLOAD);
+    if (wrapper == NULL) {
+        return NULL;
+    }
+    return (DownloadHandleState*)wrapper->attachment;
+}
+
+/**
+ * Get the verification state of a download handle, or NULL.
+ */
+static DownloadVerifyState* get_download_verify(napi_env env, napi_value js_handle) {
+    DownloadHandleState* state = get_download_state(env, js_handle);
+    return state != NULL ? state->verify : NULL;
+}
+
+/**
+ * Get the decompression stage of a download handle, or NULL.
+ */
+static DownloadCodecStage* get_download_codec(napi_env env, napi_value js_handle) {
+    DownloadHandleState* state = get_download_state(env, js_handle);
+    return state != NULL ? state->codec : NULL;
+}
+
+/**
+ * Get the chunk cache stage of a download handle, or NULL.
+ */
+static DownloadCacheStage* get_download_cache(napi_env env, napi_value js_handle) {
+    DownloadHandleState* state = get_download_state(env, js_handle);
+    return state != NULL ? state->cache : NULL;
+}
+
+/**
+ * Get the tee sinks of a download handle, or NULL.
+ */
+static DownloadTee* get_download_tee(napi_env env, napi_value js_handle) {
+    DownloadHandleState* state = get_download_state(env, js_handle);
+    return state != NULL ? state->tee : NULL;
+}
+
+static ReadAheadStage* get_download_ahead(napi_env env, napi_value js_handle) {
+    DownloadHandleState* state = get_download_state(env, js_handle);
+    return state != NULL ? state->ahead : NULL;
+}
+
 /* ========== download_object ========== */
 
 napi_value download_object(napi_env env, napi_callback_info info) {
@@ -44,9 +189,9 @@ napi_value download_object(napi_env env, napi_callback_info info) {
     
     /* Extract bucket name and object key */
     char *bucket_name = NULL, *object_key = NULL;
-    if (extract_string_required(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
         extract_string_required(env, argv[2], "key", &object_key) != napi_ok) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
         return NULL;
     }
@@ -54,6 +199,14 @@ napi_value download_object(napi_env env, napi_callback_info info) {
     /* Extract options (optional) */
     int64_t offset = 0;
     int64_t length = -1; /* -1 means read to end */
+    ChecksumType verify_type = CHECKSUM_NONE;
+    char *verify_expected = NULL, *verify_key = NULL;
+    bool decompress = true;
+    bool chunk_cache = true;
+    bool read_ahead = true;
+    uint64_t hedge_delay_ns = 0;
+    RetryPolicy retry = { 0 };
+    DownloadTee* tee = NULL;
     
     if (argc > 3) {
         napi_valuetype type;
@@ -61,14 +214,36 @@ napi_value download_object(napi_env env, napi_callback_info info) {
         if (type == napi_object) {
             offset = get_int64_property(env, argv[3], "offset", 0);
             length = get_int64_property(env, argv[3], "length", -1);
+            decompress = get_bool_property(env, argv[3], "decompress", 1) != 0;
+            chunk_cache = get_bool_property(env, argv[3], "chunkCache", 1) != 0;
+            read_ahead = get_bool_property(env, argv[3], "nativeReadAhead", 1) != 0;
+            if (hedge_delay_option(env, argv[3], "downloadObject", &hedge_delay_ns) != 0 ||
+                retry_policy_option(env, argv[3], &retry) != 0 ||
+                extract_verify_option(env, argv[3], offset, length, &verify_type, &verify_expected, &verify_key) != 0) {
+                bucket_name_release(bucket_name);
+                free(object_key);
+                return NULL;
+            }
+            napi_value js_tee;
+            napi_get_named_property(env, argv[3], "tee", &js_tee);
+            if (download_tee_from_js(env, js_tee, &tee) != 0) {
+                bucket_name_release(bucket_name);
+                free(object_key);
+                free(verify_expected);
+                free(verify_key);
+                return NULL;
+            }
         }
     }
     
     /* Allocate work data */
     DownloadObjectData* work_data = (DownloadObjectData*)calloc(1, sizeof(DownloadObjectData));
     if (!work_data) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
+        free(verify_expected);
+        free(verify_key);
+        download_tee_free(tee);
         return throw_error(env, "Out of memory");
     }
     
@@ -77,6 +252,17 @@ napi_value download_object(napi_env env, napi_callback_info info) {
     work_data->object_key = object_key;
     work_data->offset = offset;
     work_data->length = length;
+    work_data->verify_type = verify_type;
+    work_data->verify_expected = verify_expected;
+    work_data->verify_key = verify_key;
+    work_data->decompress = decompress;
+    work_data->chunk_cache = chunk_cache && offset >= 0;
+    work_data->hedge_delay_ns = hedge_delay_ns;
+    work_data->retry = retry;
+    work_data->tee = tee;
+    if (read_ahead && offset >= 0) {
+        work_data->ahead = read_ahead_open(addon_instance(env), project_handle, bucket_name, object_key, (uint64_t)offset);
+    }
     
     /* Create promise */
     napi_value promise;
@@ -85,23 +271,46 @@ napi_value download_object(napi_env env, napi_callback_info info) {
     /* Create async work */
     napi_value work_name;
     napi_create_string_utf8(env, "downloadObject", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, download_object_execute, download_object_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    work_data->cancel = cancel_token_from_options(env, argc > 3 ? argv[3] : NULL);
+    admission_queue_work(env, work_data->project_handle, ADMISSION_TRANSFER, THREAD_POOL_LANE_METADATA, work_name, download_object_execute, download_object_complete, work_data, &work_data->work, &work_data->admission);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
     
     return promise;
 }
 
 /* ========== download_read ========== */
 
-napi_value download_read(napi_env env, napi_callback_info info) {
-    size_t argc = 3;
-    napi_value argv[3];
+/**
+ * Shared argument handling for downloadRead, downloadReadFull,
+ * downloadReadInto and downloadReadCb. downloadReadInto takes an offset
+ * before the length, accepts any Buffer, TypedArray or ArrayBuffer, and
+ * reports EOF as a value. downloadReadCb takes a callback after the length
+ * and settles through it instead of a promise.
+ */
+static napi_value queue_download_read(napi_env env, napi_callback_info info, bool fill, bool into,
+                                      bool with_callback) {
+    size_t argc = 5;
+    napi_value argv[5];
     napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
     
-    LOG_DEBUG("download_read called with %zu args", argc);
+    const char* name = with_callback ? "downloadReadCb"
+                     : into ? "downloadReadInto" : (fill ? "downloadReadFull" : "downloadRead");
+    LOG_DEBUG("%s called with %zu args", name, argc);
     
-    if (argc < 3) {
-        return throw_type_error(env, "download handle, buffer, and length are required");
+    size_t length_arg = into ? 3 : 2;
+    size_t options_arg = length_arg + (with_callback ? 2 : 1);
+    if (argc < options_arg) {
+        return throw_type_error(env, with_callback
+            ? "download handle, buffer, length, and callback are required"
+            : into ? "download handle, buffer, offset, and length are required"
+                   : "download handle, buffer, and length are required");
+    }
+    if (with_callback) {
+        napi_valuetype callback_type;
+        napi_typeof(env, argv[length_arg + 1], &callback_type);
+        if (callback_type != napi_function) {
+            return throw_type_error(env, "callback must be a function");
+        }
     }
     
     /* Extract download handle */
@@ -111,42 +320,577 @@ napi_value download_read(napi_env env, napi_callback_info info) {
     }
     
     /* Extract buffer */
-    bool is_buffer;
-    napi_is_buffer(env, argv[1], &is_buffer);
-    if (!is_buffer) {
-        return throw_type_error(env, "Second argument must be a Buffer");
-    }
-    
     void* buffer;
     size_t buffer_length;
-    napi_get_buffer_info(env, argv[1], &buffer, &buffer_length);
+    if (into) {
+        if (extract_buffer(env, argv[1], &buffer, &buffer_length) != napi_ok) {
+            return throw_type_error(env, "Second argument must be a Buffer, TypedArray or ArrayBuffer");
+        }
+    } else {
+        bool is_buffer;
+        napi_is_buffer(env, argv[1], &is_buffer);
+        if (!is_buffer) {
+            return throw_type_error(env, "Second argument must be a Buffer");
+        }
+        napi_get_buffer_info(env, argv[1], &buffer, &buffer_length);
+    }
+    
+    /* Extract offset into the buffer (downloadReadInto only) */
+    int64_t offset = 0;
+    if (into) {
+        napi_valuetype offset_type;
+        napi_typeof(env, argv[2], &offset_type);
+        if (offset_type != napi_number) {
+            return throw_type_error(env, "offset must be a number");
+        }
+        napi_get_value_int64(env, argv[2], &offset);
+        if (offset < 0 || (size_t)offset > buffer_length) {
+            return throw_error(env, "Offset exceeds buffer size");
+        }
+    }
     
     /* Extract length to read */
     napi_valuetype length_type;
-    napi_typeof(env, argv[2], &length_type);
+    napi_typeof(env, argv[length_arg], &length_type);
     if (length_type != napi_number) {
         return throw_type_error(env, "length must be a number");
     }
     
     int64_t length;
-    napi_get_value_int64(env, argv[2], &length);
+    napi_get_value_int64(env, argv[length_arg], &length);
     
-    if (length < 0 || (size_t)length > buffer_length) {
+    if (length < 0 || (size_t)length > buffer_length - (size_t)offset) {
         return throw_error(env, "Length exceeds buffer size");
     }
     
     /* Allocate work data */
-    DownloadReadData* work_data = (DownloadReadData*)calloc(1, sizeof(DownloadReadData));
+    DownloadReadData* work_data = (DownloadReadData*)work_pool_calloc(1, sizeof(DownloadReadData));
     if (!work_data) {
         return throw_error(env, "Out of memory");
     }
     
     work_data->download_handle = download_handle;
-    work_data->buffer_ptr = buffer;  /* Point to the JS buffer directly */
+    work_data->bandwidth_project = get_handle_project(env, argv[0], HANDLE_TYPE_DOWNLOAD);
+    work_data->verify = get_download_verify(env, argv[0]);
+    work_data->codec = get_download_codec(env, argv[0]);
+    work_data->cache = get_download_cache(env, argv[0]);
+    work_data->tee = get_download_tee(env, argv[0]);
+    work_data->ahead = get_download_ahead(env, argv[0]);
+    work_data->buffer_ptr = (char*)buffer + offset;  /* Point to the JS buffer directly */
     work_data->data_length = (size_t)length;
+    work_data->fill = fill;
+    work_data->eof_as_value = fill || into || with_callback;
+    
+    /* downloadRead options: { eofAsValue?: boolean } */
+    if (!fill && !into && argc > options_arg) {
+        napi_valuetype type;
+        napi_typeof(env, argv[options_arg], &type);
+        if (type == napi_object) {
+            work_data->eof_as_value = get_bool_property(env, argv[options_arg], "eofAsValue", 0) != 0;
+        }
+    }
     
     /* Create reference to keep buffer alive during async work */
-    napi_create_reference(env, argv[1], 1, &work_data->buffer_ref);
+    pin_buffer(env, argv[1], work_data->data_length, &work_data->buffer_ref);
+    
+    /* Create promise, or hold the callback that replaces it */
+    napi_value promise;
+    if (with_callback) {
+        extract_callback(env, argv[length_arg + 1], &work_data->callback);
+        napi_get_undefined(env, &promise);
+    } else {
+        napi_create_promise(env, &work_data->deferred, &promise);
+    }
+    
+    /* A cancel token needs an async work handle to take a queued read back */
+    napi_async_execute_callback execute = fill ? download_read_full_execute : download_read_execute;
+    work_data->cancel = cancel_token_from_options(env, argc > options_arg ? argv[options_arg] : NULL);
+    if (work_data->cancel == NULL) {
+        thread_pool_queue_job(env, THREAD_POOL_LANE_BULK, name, execute, download_read_complete, work_data);
+        return promise;
+    }
+    napi_value work_name;
+    napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &work_name);
+    thread_pool_queue_work(env, THREAD_POOL_LANE_BULK, work_name, execute,
+                           download_read_complete, work_data, &work_data->work);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+napi_value download_read(napi_env env, napi_callback_info info) {
+    return queue_download_read(env, info, false, false, false);
+}
+
+/* ========== download_read_full ========== */
+
+napi_value download_read_full(napi_env env, napi_callback_info info) {
+    return queue_download_read(env, info, true, false, false);
+}
+
+/* ========== download_read_into ========== */
+
+napi_value download_read_into(napi_env env, napi_callback_info info) {
+    /* options.fill picks the looping execute function */
+    size_t argc = 5;
+    napi_value argv[5];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    bool fill = false;
+    if (argc > 4) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            fill = get_bool_property(env, argv[4], "fill", 0) != 0;
+        }
+    }
+    return queue_download_read(env, info, fill, true, false);
+}
+
+/* ========== download_read_cb ========== */
+
+napi_value download_read_cb(napi_env env, napi_callback_info info) {
+    /* options.fill picks the looping execute function, as for downloadReadInto */
+    size_t argc = 5;
+    napi_value argv[5];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    bool fill = false;
+    if (argc > 4) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            fill = get_bool_property(env, argv[4], "fill", 0) != 0;
+        }
+    }
+    return queue_download_read(env, info, fill, false, true);
+}
+
+/* ========== download_to_file ========== */
+
+napi_value download_to_file(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    LOG_DEBUG("download_to_file called with %zu args", argc);
+    
+    if (argc < 4) {
+        return throw_type_error(env, "project, bucket, key, and path are required");
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        return throw_type_error(env, "Invalid project handle");
+    }
+    
+    /* Extract options (optional) */
+    int64_t offset = 0;
+    int64_t length = -1; /* -1 means read to end */
+    int64_t chunk_size = DOWNLOAD_FILE_DEFAULT_CHUNK_SIZE;
+    bool fsync = false;
+    
+    if (argc > 4) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            offset = get_int64_property(env, argv[4], "offset", 0);
+            length = get_int64_property(env, argv[4], "length", -1);
+            chunk_size = get_int64_property(env, argv[4], "chunkSize", DOWNLOAD_FILE_DEFAULT_CHUNK_SIZE);
+            if (chunk_size <= 0) {
+                return throw_type_error(env, "chunkSize must be a positive number");
+            }
+            fsync = get_bool_property(env, argv[4], "fsync", 0) != 0;
+        }
+    }
+    
+    ProgressReporter* progress = NULL;
+    if (progress_reporter_from_options(env, argc > 4 ? argv[4] : NULL, "downloadToFile", &progress) != 0) {
+        return NULL;
+    }
+    
+    char *bucket_name = NULL, *object_key = NULL, *file_path = NULL;
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "key", &object_key) != napi_ok ||
+        extract_string_required(env, argv[3], "path", &file_path) != napi_ok) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free(file_path);
+        progress_reporter_discard(progress);
+        return NULL;
+    }
+    
+    /* Allocate work data */
+    DownloadToFileData* work_data = (DownloadToFileData*)calloc(1, sizeof(DownloadToFileData));
+    if (!work_data) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free(file_path);
+        progress_reporter_discard(progress);
+        return throw_error(env, "Out of memory");
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->progress = progress;
+    work_data->bucket_name = bucket_name;
+    work_data->object_key = object_key;
+    work_data->file_path = file_path;
+    work_data->offset = offset;
+    work_data->length = length;
+    work_data->chunk_size = (size_t)chunk_size;
+    work_data->fsync = fsync;
+    
+    /* Create promise */
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    /* Create async work */
+    napi_value work_name;
+    napi_create_string_utf8(env, "downloadToFile", NAPI_AUTO_LENGTH, &work_name);
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(env, work_data->project_handle, ADMISSION_TRANSFER, lane, work_name, download_to_file_execute, download_to_file_complete, work_data, &work_data->work, NULL);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== download_parallel ========== */
+
+napi_value download_parallel(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    LOG_DEBUG("download_parallel called with %zu args", argc);
+    
+    if (argc < 4) {
+        return throw_type_error(env, "project, bucket, key, and sink are required");
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        return throw_type_error(env, "Invalid project handle");
+    }
+    
+    /* Sink is either a Buffer or a file path */
+    void* buffer_data = NULL;
+    size_t buffer_length = 0;
+    bool is_path = false;
+    napi_valuetype sink_type;
+    napi_typeof(env, argv[3], &sink_type);
+    if (sink_type == napi_string) {
+        is_path = true;
+    } else if (extract_buffer(env, argv[3], &buffer_data, &buffer_length) != napi_ok) {
+        return throw_type_error(env, "sink must be a Buffer or a file path");
+    }
+    
+    /* Extract options (optional) */
+    int64_t range_size = PARALLEL_DOWNLOAD_DEFAULT_RANGE_SIZE;
+    int64_t concurrency = PARALLEL_DOWNLOAD_DEFAULT_CONCURRENCY;
+    int64_t retries = PARALLEL_DOWNLOAD_DEFAULT_RETRIES;
+    bool fsync = false;
+    bool auto_tune = false;
+    
+    if (argc > 4) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            auto_tune = get_bool_property(env, argv[4], "auto", 0) != 0;
+            range_size = get_int64_property(env, argv[4], "rangeSize", PARALLEL_DOWNLOAD_DEFAULT_RANGE_SIZE);
+            concurrency = get_int64_property(env, argv[4], "concurrency",
+                                             auto_tune ? PART_TUNER_DEFAULT_MAX_ACTIVE : PARALLEL_DOWNLOAD_DEFAULT_CONCURRENCY);
+            retries = get_int64_property(env, argv[4], "retries", PARALLEL_DOWNLOAD_DEFAULT_RETRIES);
+            fsync = get_bool_property(env, argv[4], "fsync", 0) != 0;
+            
+            if (range_size <= 0) {
+                return throw_type_error(env, "rangeSize must be a positive number");
+            }
+            if (concurrency < 1 || concurrency > 256) {
+                return throw_type_error(env, "concurrency must be between 1 and 256");
+            }
+            if (retries < 0 || retries > 100) {
+                return throw_type_error(env, "retries must be between 0 and 100");
+            }
+        }
+    }
+    
+    ProgressReporter* progress = NULL;
+    if (progress_reporter_from_options(env, argc > 4 ? argv[4] : NULL, "downloadParallel", &progress) != 0) {
+        return NULL;
+    }
+    
+    char *bucket_name = NULL, *object_key = NULL, *file_path = NULL;
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "key", &object_key) != napi_ok ||
+        (is_path && extract_string_required(env, argv[3], "sink", &file_path) != napi_ok)) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free(file_path);
+        progress_reporter_discard(progress);
+        return NULL;
+    }
+    
+    /* Allocate work data */
+    DownloadParallelData* work_data = (DownloadParallelData*)calloc(1, sizeof(DownloadParallelData));
+    if (!work_data) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free(file_path);
+        progress_reporter_discard(progress);
+        return throw_error(env, "Out of memory");
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->progress = progress;
+    work_data->bucket_name = bucket_name;
+    work_data->object_key = object_key;
+    work_data->file_path = file_path;
+    work_data->buffer_ptr = buffer_data;  /* Ranges are read straight into the JS buffer */
+    work_data->buffer_length = buffer_length;
+    work_data->auto_tune = auto_tune;
+    work_data->range_size = (uint64_t)range_size;
+    work_data->concurrency = (uint32_t)concurrency;
+    work_data->max_retries = (uint32_t)retries;
+    work_data->fsync = fsync;
+    
+    /* Pin the sink buffer for the lifetime of the async work */
+    if (!is_path) {
+        pin_buffer(env, argv[3], buffer_length, &work_data->buffer_ref);
+    }
+    
+    /* Create promise */
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    /* Create async work */
+    napi_value work_name;
+    napi_create_string_utf8(env, "downloadParallel", NAPI_AUTO_LENGTH, &work_name);
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(env, work_data->project_handle, ADMISSION_TRANSFER, lane, work_name, download_parallel_execute, download_parallel_complete, work_data, &work_data->work, NULL);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== download_ranges ========== */
+
+/**
+ * Read a {offset, length}[] into a newly allocated DownloadRange array
+ * @return 0 on success, -1 with a JS exception pending
+ */
+static int extract_download_ranges(napi_env env, napi_value value, DownloadRange** out, uint32_t* count) {
+    bool is_array = false;
+    uint32_t length = 0;
+    napi_is_array(env, value, &is_array);
+    if (is_array) {
+        napi_get_array_length(env, value, &length);
+    }
+    if (!is_array || length == 0 || length > DOWNLOAD_RANGES_MAX_RANGES) {
+        throw_type_error(env, "ranges must be an array of 1 to 100000 {offset, length} objects");
+        return -1;
+    }
+    
+    DownloadRange* ranges = (DownloadRange*)calloc(length, sizeof(DownloadRange));
+    if (ranges == NULL) {
+        throw_error(env, "Out of memory");
+        return -1;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value entry, offset, size;
+        napi_valuetype offset_type = napi_undefined, size_type = napi_undefined;
+        napi_get_element(env, value, i, &entry);
+        if (napi_get_named_property(env, entry, "offset", &offset) == napi_ok &&
+            napi_get_named_property(env, entry, "length", &size) == napi_ok) {
+            napi_typeof(env, offset, &offset_type);
+            napi_typeof(env, size, &size_type);
+        }
+        int64_t range_length = -1;
+        if (offset_type == napi_number && size_type == napi_number) {
+            napi_get_value_int64(env, offset, &ranges[i].offset);
+            napi_get_value_int64(env, size, &range_length);
+        }
+        if (range_length < 0) {
+            free(ranges);
+            throw_type_error(env, "each range needs a numeric offset and a non-negative length");
+            return -1;
+        }
+        ranges[i].length = (uint64_t)range_length;
+    }
+    *out = ranges;
+    *count = length;
+    return 0;
+}
+
+napi_value download_ranges(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    LOG_DEBUG("download_ranges called with %zu args", argc);
+    
+    if (argc < 4) {
+        return throw_type_error(env, "project, bucket, key, and ranges are required");
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        return throw_type_error(env, "Invalid project handle");
+    }
+    
+    /* Extract options (optional) */
+    int64_t coalesce_gap = DOWNLOAD_RANGES_DEFAULT_COALESCE_GAP;
+    int64_t concurrency = PARALLEL_DOWNLOAD_DEFAULT_CONCURRENCY;
+    int64_t retries = PARALLEL_DOWNLOAD_DEFAULT_RETRIES;
+    
+    if (argc > 4) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            coalesce_gap = get_int64_property(env, argv[4], "coalesceGap", DOWNLOAD_RANGES_DEFAULT_COALESCE_GAP);
+            concurrency = get_int64_property(env, argv[4], "concurrency", PARALLEL_DOWNLOAD_DEFAULT_CONCURRENCY);
+            retries = get_int64_property(env, argv[4], "retries", PARALLEL_DOWNLOAD_DEFAULT_RETRIES);
+            
+            if (coalesce_gap < 0) {
+                return throw_type_error(env, "coalesceGap must be a non-negative number");
+            }
+            if (concurrency < 1 || concurrency > 256) {
+                return throw_type_error(env, "concurrency must be between 1 and 256");
+            }
+            if (retries < 0 || retries > 100) {
+                return throw_type_error(env, "retries must be between 0 and 100");
+            }
+        }
+    }
+    
+    DownloadRange* ranges = NULL;
+    uint32_t range_count = 0;
+    if (extract_download_ranges(env, argv[3], &ranges, &range_count) != 0) {
+        return NULL;
+    }
+    
+    char *bucket_name = NULL, *object_key = NULL;
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "key", &object_key) != napi_ok) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free(ranges);
+        return NULL;
+    }
+    
+    /* Allocate work data */
+    DownloadRangesData* work_data = (DownloadRangesData*)calloc(1, sizeof(DownloadRangesData));
+    if (!work_data) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free(ranges);
+        return throw_error(env, "Out of memory");
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->bucket_name = bucket_name;
+    work_data->object_key = object_key;
+    work_data->ranges = ranges;
+    work_data->range_count = range_count;
+    work_data->coalesce_gap = (uint64_t)coalesce_gap;
+    work_data->concurrency = (uint32_t)concurrency;
+    work_data->max_retries = (uint32_t)retries;
+    
+    /* Create promise */
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    /* Create async work */
+    napi_value work_name;
+    napi_create_string_utf8(env, "downloadRanges", NAPI_AUTO_LENGTH, &work_name);
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(env, work_data->project_handle, ADMISSION_TRANSFER, lane, work_name, download_ranges_execute, download_ranges_complete, work_data, &work_data->work, NULL);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== get_object ========== */
+
+napi_value get_object(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    LOG_DEBUG("get_object called with %zu args", argc);
+    
+    if (argc < 3) {
+        return throw_type_error(env, "project, bucket, and key are required");
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        return throw_type_error(env, "Invalid project handle");
+    }
+    
+    int64_t max_size = -1;
+    uint64_t hedge_delay_ns = 0;
+    RetryPolicy retry = { 0 };
+    if (argc > 3) {
+        napi_valuetype type;
+        napi_typeof(env, argv[3], &type);
+        if (type == napi_object) {
+            max_size = get_int64_property(env, argv[3], "maxSize", -1);
+            if (hedge_delay_option(env, argv[3], DOWNLOAD_FIRST_BYTE_METRIC, &hedge_delay_ns) != 0 ||
+                retry_policy_option(env, argv[3], &retry) != 0) {
+                return NULL;
+            }
+        }
+    }
+    
+    ProgressReporter* progress = NULL;
+    if (progress_reporter_from_options(env, argc > 3 ? argv[3] : NULL, "getObject", &progress) != 0) {
+        return NULL;
+    }
+    
+    char *bucket_name = NULL, *object_key = NULL;
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "key", &object_key) != napi_ok) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        progress_reporter_discard(progress);
+        return NULL;
+    }
+    
+    /* Served from the project's object cache when enabled and fresh */
+    const UplinkObject* cached_info = NULL;
+    ObjectCacheBlob* cached = object_cache_lookup(project_handle, bucket_name, object_key, &cached_info);
+    if (cached != NULL && max_size >= 0 && (int64_t)cached->length > max_size) {
+        object_cache_blob_release(cached);
+        cached = NULL;
+    }
+    if (cached != NULL) {
+        LOG_DEBUG("getObject: cache hit for '%s/%s' (%zu bytes)", bucket_name, object_key, cached->length);
+        bucket_name_release(bucket_name);
+        free(object_key);
+        progress_reporter_discard(progress);
+        return get_object_cached_result(env, cached, cached_info);
+    }
+    
+    GetObjectData* work_data = (GetObjectData*)calloc(1, sizeof(GetObjectData));
+    if (!work_data) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        progress_reporter_discard(progress);
+        return throw_error(env, "Out of memory");
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->progress = progress;
+    work_data->bucket_name = bucket_name;
+    work_data->object_key = object_key;
+    work_data->max_size = max_size;
+    work_data->cache_max_size = object_cache_max_object_size(project_handle);
+    work_data->cache_epoch = object_cache_epoch(project_handle);
+    work_data->hedge_delay_ns = hedge_delay_ns;
+    work_data->retry = retry;
     
     /* Create promise */
     napi_value promise;
@@ -154,13 +898,45 @@ napi_value download_read(napi_env env, napi_callback_info info) {
     
     /* Create async work */
     napi_value work_name;
-    napi_create_string_utf8(env, "downloadRead", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, download_read_execute, download_read_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    napi_create_string_utf8(env, "getObject", NAPI_AUTO_LENGTH, &work_name);
+    work_data->cancel = cancel_token_from_options(env, argc > 3 ? argv[3] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 3 ? argv[3] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(env, work_data->project_handle, ADMISSION_TRANSFER, lane, work_name, get_object_execute, get_object_complete, work_data, &work_data->work, NULL);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
     
     return promise;
 }
 
+/* ========== alloc_read_buffer ========== */
+
+napi_value alloc_read_buffer(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 1) {
+        return throw_type_error(env, "size is required");
+    }
+    
+    napi_valuetype type;
+    napi_typeof(env, argv[0], &type);
+    if (type != napi_number) {
+        return throw_type_error(env, "size must be a number");
+    }
+    
+    int64_t size;
+    napi_get_value_int64(env, argv[0], &size);
+    if (size < 0) {
+        return throw_type_error(env, "size must be non-negative");
+    }
+    
+    napi_value buffer = buffer_pool_create_buffer(env, (size_t)size);
+    if (buffer == NULL) {
+        return throw_error(env, "Out of memory");
+    }
+    return buffer;
+}
+
 /* ========== download_info ========== */
 
 napi_value download_info(napi_env env, napi_callback_info info) {
@@ -195,8 +971,7 @@ napi_value download_info(napi_env env, napi_callback_info info) {
     /* Create async work */
     napi_value work_name;
     napi_create_string_utf8(env, "downloadInfo", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, download_info_execute, download_info_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    thread_pool_queue_work(env, THREAD_POOL_LANE_METADATA, work_name, download_info_execute, download_info_complete, work_data, &work_data->work);
     
     return promise;
 }
@@ -219,6 +994,7 @@ napi_value close_download(napi_env env, napi_callback_info info) {
     if (extract_handle(env, argv[0], HANDLE_TYPE_DOWNLOAD, &download_handle) != napi_ok) {
         return throw_type_error(env, "Invalid download handle");
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_DOWNLOAD);
     
     /* Allocate work data */
     CloseDownloadData* work_data = (CloseDownloadData*)calloc(1, sizeof(CloseDownloadData));
@@ -227,6 +1003,14 @@ napi_value close_download(napi_env env, napi_callback_info info) {
     }
     
     work_data->download_handle = download_handle;
+    work_data->admission = take_handle_admission(env, argv[0], HANDLE_TYPE_DOWNLOAD);
+    
+    /* Every byte was read without reaching EOF; the digest is due now */
+    DownloadVerifyState* verify = get_download_verify(env, argv[0]);
+    if (verify != NULL && !verify->done && verify->checksum.total == verify->content_length) {
+        work_data->verify_error = download_verify_finish(verify);
+    }
+    work_data->tee = get_download_tee(env, argv[0]);
     
     /* Create promise */
     napi_value promise;
@@ -235,8 +1019,171 @@ napi_value close_download(napi_env env, napi_callback_info info) {
     /* Create async work */
     napi_value work_name;
     napi_create_string_utf8(env, "closeDownload", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, close_download_execute, close_download_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    thread_pool_queue_work(env, THREAD_POOL_LANE_METADATA, work_name, close_download_execute, close_download_complete, work_data, &work_data->work);
     
     return promise;
 }
+
+/* ========== downloadTeeResults ========== */
+
+napi_value download_tee_results(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 1 || get_handle_wrapper(env, argv[0], HANDLE_TYPE_DOWNLOAD) == NULL) {
+        return throw_type_error(env, "Invalid download handle");
+    }
+    
+    DownloadTee* tee = get_download_tee(env, argv[0]);
+    return download_tee_results_to_js(env, tee);
+}
+
+/* ========== enableChunkCache ========== */
+
+napi_value enable_chunk_cache(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    napi_valuetype type = napi_undefined;
+    if (argc >= 1) {
+        napi_typeof(env, argv[0], &type);
+    }
+    if (type != napi_object) {
+        return throw_type_error(env, "options with a directory are required");
+    }
+    
+    char* directory = get_string_property(env, argv[0], "directory");
+    if (directory == NULL || directory[0] == '\0') {
+        free(directory);
+        return throw_type_error(env, "directory must be a non-empty string");
+    }
+    int64_t max_bytes = get_int64_property(env, argv[0], "maxBytes", CHUNK_CACHE_DEFAULT_MAX_BYTES);
+    int64_t chunk_size = get_int64_property(env, argv[0], "chunkSize", CHUNK_CACHE_DEFAULT_CHUNK_SIZE);
+    if (max_bytes <= 0) {
+        free(directory);
+        return throw_type_error(env, "maxBytes must be a positive number");
+    }
+    if (chunk_size < CHUNK_CACHE_MIN_CHUNK_SIZE || chunk_size > CHUNK_CACHE_MAX_CHUNK_SIZE ||
+        (chunk_size & (chunk_size - 1)) != 0) {
+        free(directory);
+        return throw_type_error(env, "chunkSize must be a power of two from 64 KiB to 64 MiB");
+    }
+    
+    int rc = chunk_cache_enable(directory, (uint64_t)max_bytes, (size_t)chunk_size);
+    if (rc != 0) {
+        char message[512];
+        snprintf(message, sizeof(message), "Cannot use chunk cache directory '%s': %s", directory, uv_strerror(rc));
+        free(directory);
+        return throw_error(env, message);
+    }
+    free(directory);
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== disableChunkCache ========== */
+
+napi_value disable_chunk_cache(napi_env env, napi_callback_info info) {
+    (void)info;
+    chunk_cache_disable();
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== chunkCacheStats ========== */
+
+napi_value get_chunk_cache_stats(napi_env env, napi_callback_info info) {
+    (void)info;
+    
+    ChunkCacheStats stats;
+    char* directory = NULL;
+    napi_value result;
+    if (chunk_cache_stats(&stats, &directory) != 0) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    
+    napi_value value;
+    napi_create_object(env, &result);
+    napi_create_string_utf8(env, directory != NULL ? directory : "", NAPI_AUTO_LENGTH, &value);
+    napi_set_named_property(env, result, "directory", value);
+    free(directory);
+    napi_create_double(env, (double)stats.hit_bytes, &value);
+    napi_set_named_property(env, result, "hitBytes", value);
+    napi_create_double(env, (double)stats.miss_bytes, &value);
+    napi_set_named_property(env, result, "missBytes", value);
+    napi_create_double(env, (double)stats.chunks_stored, &value);
+    napi_set_named_property(env, result, "chunksStored", value);
+    napi_create_double(env, (double)stats.write_errors, &value);
+    napi_set_named_property(env, result, "writeErrors", value);
+    napi_create_double(env, (double)stats.evictions, &value);
+    napi_set_named_property(env, result, "evictions", value);
+    napi_create_double(env, (double)stats.bytes, &value);
+    napi_set_named_property(env, result, "bytes", value);
+    napi_create_double(env, (double)stats.max_bytes, &value);
+    napi_set_named_property(env, result, "maxBytes", value);
+    napi_create_double(env, (double)stats.chunk_size, &value);
+    napi_set_named_property(env, result, "chunkSize", value);
+    return result;
+}
+
+/* ========== enableReadAhead ========== */
+
+napi_value enable_read_ahead(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    char* policy = NULL;
+    int64_t initial_window = READ_AHEAD_DEFAULT_INITIAL_WINDOW;
+    int64_t max_window = READ_AHEAD_DEFAULT_MAX_WINDOW;
+    if (argc >= 1) {
+        napi_valuetype type;
+        napi_typeof(env, argv[0], &type);
+        if (type == napi_object) {
+            policy = get_string_property(env, argv[0], "policy");
+            initial_window = get_int64_property(env, argv[0], "initialWindow", READ_AHEAD_DEFAULT_INITIAL_WINDOW);
+            max_window = get_int64_property(env, argv[0], "maxWindow",
+                                            initial_window > READ_AHEAD_DEFAULT_MAX_WINDOW ? initial_window
+                                                                                           : READ_AHEAD_DEFAULT_MAX_WINDOW);
+        }
+    }
+    if (initial_window < READ_AHEAD_MIN_WINDOW || max_window > READ_AHEAD_MAX_WINDOW || initial_window > max_window) {
+        free(policy);
+        return throw_type_error(env, "initialWindow and maxWindow must satisfy 4 KiB <= initialWindow <= maxWindow <= 64 MiB");
+    }
+    
+    int rc = read_ahead_enable(policy != NULL ? policy : "adaptive", (size_t)initial_window, (size_t)max_window);
+    free(policy);
+    if (rc != 0) {
+        return throw_type_error(env, "policy must be 'adaptive' or 'sequential'");
+    }
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== disableReadAhead ========== */
+
+napi_value disable_read_ahead(napi_env env, napi_callback_info info) {
+    (void)info;
+    read_ahead_disable();
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== readAheadStats ========== */
+
+napi_value get_read_ahead_stats(napi_env env, napi_callback_info info) {
+    (void)info;
+    return read_ahead_stats_to_js(env);
+}
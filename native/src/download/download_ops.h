@@ -5,6 +5,14 @@
  * Declares N-API bindings for uplink-c download operations:
  * - download_object: Start a download from a bucket
  * - download_read: Read data from a download
+ * - download_read_full: Fill a buffer from a download, looping natively
+ * - download_read_into: Read into a caller-owned buffer at an offset
+ * - download_read_cb: Read with a completion callback instead of a promise
+ * - download_to_file: Download an object straight into a local file
+ * - download_parallel: Download an object as concurrent ranges
+ * - download_ranges: Read many byte ranges of an object in coalesced requests
+ * - get_object: Download a whole object into one Buffer in a single call
+ * - alloc_read_buffer: Allocate a read buffer from the native buffer pool
  * - download_info: Get info about the downloaded object
  * - close_download: Close the download stream
  */
@@ -22,7 +30,14 @@
  *   - arg[0]: project handle (external)
  *   - arg[1]: bucket name (string)
  *   - arg[2]: object key (string)
- *   - arg[3]: options object (optional) { offset?: number, length?: number }
+ *   - arg[3]: options object (optional) { offset?: number, length?: number,
+ *             verify?: { algorithm, expected?, fromMetadataKey? },
+ *             decompress?: boolean, chunkCache?: boolean, nativeReadAhead?: boolean }; verify
+ *             hashes reads on the worker and fails the completing read (or
+ *             closeDownload) with an IntegrityError on mismatch; with the
+ *             chunk cache enabled, reads go through it unless chunkCache is false;
+ *             with read-ahead enabled, the open is classified and small
+ *             sequential reads share windows unless nativeReadAhead is false
  * @returns Promise<{ downloadHandle: external }>
  */
 napi_value download_object(napi_env env, napi_callback_info info);
@@ -35,10 +50,147 @@ napi_value download_object(napi_env env, napi_callback_info info);
  *   - arg[0]: download handle (external)
  *   - arg[1]: buffer to read into (Buffer)
  *   - arg[2]: length to read (number)
- * @returns Promise<{ bytesRead: number }>
+ *   - arg[3]: options object (optional) { eofAsValue?: boolean }
+ * @returns Promise<{ bytesRead: number }>, or Promise<{ bytesRead: number, eof: boolean }>
+ *          with eofAsValue, which resolves instead of rejecting on EOF
  */
 napi_value download_read(napi_env env, napi_callback_info info);
 
+/**
+ * Read from a download until the requested length is filled or EOF is
+ * reached, looping over partial reads on the worker thread
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: download handle (external)
+ *   - arg[1]: buffer to read into (Buffer)
+ *   - arg[2]: length to read (number)
+ * @returns Promise<{ bytesRead: number, eof: boolean }>
+ */
+napi_value download_read_full(napi_env env, napi_callback_info info);
+
+/**
+ * Read from a download into @p length bytes of a caller-owned buffer
+ * starting at @p offset, without a view per read. EOF is reported as a
+ * value, as with downloadReadFull.
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: download handle (external)
+ *   - arg[1]: buffer to read into (Buffer, TypedArray or ArrayBuffer)
+ *   - arg[2]: byte offset into the buffer (number)
+ *   - arg[3]: length to read (number)
+ *   - arg[4]: options object (optional) { fill?: boolean, cancelToken?, timeoutMs? };
+ *             fill loops over partial reads like downloadReadFull
+ * @returns Promise<{ bytesRead: number, eof: boolean }>
+ */
+napi_value download_read_into(napi_env env, napi_callback_info info);
+
+/**
+ * Read from a download and report through a Node-style callback instead
+ * of a promise, for the stream adapters' read loops: the success path
+ * allocates no promise, result object or error.
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: download handle (external)
+ *   - arg[1]: buffer to read into (Buffer)
+ *   - arg[2]: length to read (number)
+ *   - arg[3]: callback (error: Error | null, bytesRead: number, eof: boolean) => void,
+ *             always called asynchronously; errors carry bytesRead
+ *   - arg[4]: options object (optional) { fill?: boolean, cancelToken?, timeoutMs? }
+ * @returns undefined
+ */
+napi_value download_read_cb(napi_env env, napi_callback_info info);
+
+/**
+ * Download an object into a local file
+ * 
+ * Runs download, read loop, positional writes and close inside a single
+ * async work using one native scratch buffer.
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: project handle (external)
+ *   - arg[1]: bucket name (string)
+ *   - arg[2]: object key (string)
+ *   - arg[3]: destination file path (string, created or truncated)
+ *   - arg[4]: options object (optional)
+ *             { offset?: number, length?: number, chunkSize?: number, fsync?: boolean }
+ * @returns Promise<{ bytesWritten: number }>
+ */
+napi_value download_to_file(napi_env env, napi_callback_info info);
+
+/**
+ * Download an object as concurrent ranged streams on native threads
+ * 
+ * Stats the object, splits it into ranges, and writes each range into
+ * its slot of a file (positional writes) or a preallocated Buffer.
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: project handle (external)
+ *   - arg[1]: bucket name (string)
+ *   - arg[2]: object key (string)
+ *   - arg[3]: sink (Buffer at least as large as the object, or file path)
+ *   - arg[4]: options object (optional)
+ *             { rangeSize?: number, concurrency?: number, auto?: boolean,
+ *               retries?: number, fsync?: boolean }
+ * @returns Promise<{ bytesWritten: number, tuning?: { partSize, concurrency, bytesPerSecond } }>
+ */
+napi_value download_parallel(napi_env env, napi_callback_info info);
+
+/**
+ * Read many byte ranges of one object on native threads
+ * 
+ * Sorts the ranges and merges those at most coalesceGap bytes apart into
+ * one ranged request each. Requests run concurrently into one arena that
+ * becomes a single Buffer; a negative offset counts from the end (the
+ * object is stat'ed only then). Ranges past the end come back short.
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: project handle (external)
+ *   - arg[1]: bucket name (string)
+ *   - arg[2]: object key (string)
+ *   - arg[3]: ranges ({ offset: number, length: number }[])
+ *   - arg[4]: options object (optional)
+ *             { coalesceGap?: number, concurrency?: number, retries?: number }
+ * @returns Promise<{ data: Buffer, offsets: number[], lengths: number[], requests: number }>
+ *          where range i is data[offsets[i], offsets[i] + lengths[i])
+ */
+napi_value download_ranges(napi_env env, napi_callback_info info);
+
+/**
+ * Download a whole object into a single exactly-sized Buffer
+ * 
+ * Opens the download, reads the content length from its info, reads to
+ * EOF and closes, all inside one async work.
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: project handle (external)
+ *   - arg[1]: bucket name (string)
+ *   - arg[2]: object key (string)
+ *   - arg[3]: options object (optional) { maxSize?: number }
+ * @returns Promise<{ data: Buffer, info: ObjectInfo }>
+ */
+napi_value get_object(napi_env env, napi_callback_info info);
+
+/**
+ * Allocate a Buffer backed by a pooled native slab (synchronous)
+ * 
+ * Sizes are rounded up to 64 KiB / 1 MiB / 4 MiB slabs that return to the
+ * pool when the Buffer is garbage collected, so read loops stop churning
+ * fresh multi-MiB allocations.
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: buffer length in bytes (number)
+ * @returns Buffer
+ */
+napi_value alloc_read_buffer(napi_env env, napi_callback_info info);
+
 /**
  * Get info about the downloaded object
  * 
@@ -59,4 +211,51 @@ napi_value download_info(napi_env env, napi_callback_info info);
  */
 napi_value close_download(napi_env env, napi_callback_info info);
 
+/**
+ * Read the per-sink outcome of a download opened with options.tee (synchronous);
+ * digests cover the bytes read so far
+ * JS: downloadTeeResults(download) -> [{ bytes, path | algorithm, digest?, error? }]
+ */
+napi_value download_tee_results(napi_env env, napi_callback_info info);
+
+/**
+ * Enable (or reconfigure) the process-wide disk chunk cache (synchronous)
+ * JS: enableChunkCache(options: { directory: string, maxBytes?: number, chunkSize?: number }) -> void
+ */
+napi_value enable_chunk_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Disable the disk chunk cache; cache files stay on disk (synchronous)
+ * JS: disableChunkCache() -> void
+ */
+napi_value disable_chunk_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Read the disk chunk cache counters (synchronous)
+ * JS: chunkCacheStats() -> { directory, hitBytes, missBytes, chunksStored, writeErrors, evictions, bytes,
+ *     maxBytes, chunkSize } | null
+ */
+napi_value get_chunk_cache_stats(napi_env env, napi_callback_info info);
+
+/**
+ * Enable (or reconfigure, dropping all history) access-pattern-aware
+ * read-ahead for downloads opened from now on (synchronous)
+ * JS: enableReadAhead(options?: { policy?: 'adaptive' | 'sequential', initialWindow?: number,
+ *     maxWindow?: number }) -> void
+ */
+napi_value enable_read_ahead(napi_env env, napi_callback_info info);
+
+/**
+ * Disable read-ahead; open downloads keep their windows (synchronous)
+ * JS: disableReadAhead() -> void
+ */
+napi_value disable_read_ahead(napi_env env, napi_callback_info info);
+
+/**
+ * Read the read-ahead counters (synchronous)
+ * JS: readAheadStats() -> { policy, sequentialOpens, randomOpens, seeks, readsServed, bytesPrefetched,
+ *     windowGrowths, objects, initialWindow, maxWindow } | null
+ */
+napi_value get_read_ahead_stats(napi_env env, napi_callback_info info);
+
 #endif /* DOWNLOAD_OPS_H */
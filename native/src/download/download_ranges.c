@@ -0,0 +1,86 @@
+/**
+ * @file download_ranges.c
+ * @brief Request planning for downloadRanges
+ */
+
+#include "download_ranges.h"
+
+#include <stdlib.h>
+
+static int compare_range_offsets(const void* a, const void* b) {
+    int64_t offset_a = (*(const DownloadRange* const*)a)->offset;
+    int64_t offset_b = (*(const DownloadRange* const*)b)->offset;
+    return offset_a < offset_b ? -1 : (offset_a > offset_b ? 1 : 0);
+}
+
+bool download_ranges_plan(DownloadRange* ranges, uint32_t range_count, uint64_t coalesce_gap, bool sized,
+                          uint64_t content_length, DownloadSpan** spans, uint32_t* span_count,
+                          uint64_t* arena_length) {
+    DownloadRange** order = (DownloadRange**)malloc(range_count * sizeof(DownloadRange*));
+    DownloadSpan* planned = (DownloadSpan*)calloc(range_count, sizeof(DownloadSpan));
+    if (order == NULL || planned == NULL) {
+        free(order);
+        free(planned);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < range_count; i++) {
+        DownloadRange* range = &ranges[i];
+        if (range->offset < 0) {
+            uint64_t back = (uint64_t)(-range->offset);
+            range->offset = back < content_length ? (int64_t)(content_length - back) : 0;
+        }
+        if (sized) {
+            uint64_t left = (uint64_t)range->offset < content_length ? content_length - (uint64_t)range->offset : 0;
+            range->length = range->length < left ? range->length : left;
+        }
+        order[i] = range;
+    }
+    qsort(order, range_count, sizeof(DownloadRange*), compare_range_offsets);
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < range_count; i++) {
+        DownloadRange* range = order[i];
+        if (range->length == 0) {
+            range->span = DOWNLOAD_RANGES_NO_SPAN;  /* Nothing to read; must not stretch a span */
+            continue;
+        }
+        uint64_t start = (uint64_t)range->offset;
+        uint64_t end = start + range->length;
+        DownloadSpan* last = count > 0 ? &planned[count - 1] : NULL;
+        if (last != NULL && start <= last->offset + last->length + coalesce_gap) {
+            if (end > last->offset + last->length) {
+                last->length = end - last->offset;
+            }
+        } else {
+            last = &planned[count++];
+            last->offset = start;
+            last->length = range->length;
+        }
+        range->span = count - 1;
+    }
+    free(order);
+
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        planned[i].arena_offset = total;
+        total += planned[i].length;
+    }
+    *spans = planned;
+    *span_count = count;
+    *arena_length = total;
+    return true;
+}
+
+void download_ranges_view(const DownloadRange* range, const DownloadSpan* spans, uint64_t* at, uint64_t* length) {
+    *at = 0;
+    *length = 0;
+    if (range->span == DOWNLOAD_RANGES_NO_SPAN) {
+        return;
+    }
+    const DownloadSpan* span = &spans[range->span];
+    uint64_t skip = (uint64_t)range->offset - span->offset;
+    uint64_t read = span->bytes_read > skip ? span->bytes_read - skip : 0;
+    *at = span->arena_offset + skip;
+    *length = read < range->length ? read : range->length;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file download_ranges.h
+ * @brief Request planning for downloadRanges
+ *
+ * Ranges are resolved against the object size, sorted and merged into
+ * spans when the gap between them is at most the coalesce gap. Spans are
+ * laid out back to back in one arena; each range is then a view of the
+ * arena, cut short where the object ended inside its span. Pure
+ * functions, run on the worker thread of the call and its completion.
+ */
+
+#ifndef DOWNLOAD_RANGES_H
+#define DOWNLOAD_RANGES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Default gap up to which download_ranges merges neighbouring ranges into one request (1 MiB) */
+#define DOWNLOAD_RANGES_DEFAULT_COALESCE_GAP (1024 * 1024)
+
+/** Most ranges one download_ranges call accepts */
+#define DOWNLOAD_RANGES_MAX_RANGES 100000
+
+/** Span of a range with nothing to read */
+#define DOWNLOAD_RANGES_NO_SPAN UINT32_MAX
+
+/**
+ * One requested range of download_ranges
+ */
+typedef struct {
+    int64_t offset;             /* Negative: from the end of the object */
+    uint64_t length;
+    uint32_t span;              /* Merged request that covers it */
+} DownloadRange;
+
+/**
+ * One merged request of download_ranges, read into its slot of the arena
+ */
+typedef struct {
+    uint64_t offset;
+    uint64_t length;
+    uint64_t arena_offset;
+    uint64_t bytes_read;        /* Short when the object ends inside the span */
+} DownloadSpan;
+
+/**
+ * Resolve offsets from the end, clip to @p content_length when @p sized,
+ * and merge the ranges into spans laid out back to back in the arena.
+ * Offsets and lengths of @p ranges are rewritten in place and each gets
+ * its span, or DOWNLOAD_RANGES_NO_SPAN when empty.
+ *
+ * @param[out] spans Receives at most @p range_count spans (caller frees)
+ * @param[out] span_count Receives the number of spans
+ * @param[out] arena_length Receives the bytes all spans take
+ * @return false when memory is short
+ */
+bool download_ranges_plan(DownloadRange* ranges, uint32_t range_count, uint64_t coalesce_gap, bool sized,
+                          uint64_t content_length, DownloadSpan** spans, uint32_t* span_count,
+                          uint64_t* arena_length);
+
+/**
+ * Where a planned range sits in the arena once its span was read
+ *
+ * @param[out] at Offset of the range's first byte in the arena
+ * @param[out] length Bytes of the range that were read
+ */
+void download_ranges_view(const DownloadRange* range, const DownloadSpan* spans, uint64_t* at, uint64_t* length);
+
+#endif /* DOWNLOAD_RANGES_H */
@@ -0,0 +1,287 @@
+/**
+ * @file download_readahead.c
+ * @brief Access-pattern-aware read-ahead implementation
+ *
+ * Object histories sit on a most-recently-opened-first list capped at
+ * READ_AHEAD_MAX_OBJECTS. Stages hold a reference to their history, so an
+ * entry in use is never dropped; disabling detaches entries still in use
+ * and the last stage frees them. Every env calls in from its own main
+ * thread, so one lock guards the list, the refcounts and the totals, and
+ * entries are keyed by the opening env as well as the project.
+ */
+
+#include "download_readahead.h"
+#include "../common/logger.h"
+
+#include <uv.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ReadAheadObject {
+    const void* owner;
+    size_t project_handle;
+    uint32_t hash;
+    char* name;                     /* bucket '\0' key */
+    size_t bucket_length;
+    ReadAheadHistory history;
+    uint32_t refs;                  /* Stages using the entry */
+    bool detached;                  /* No longer on the list; freed with the last stage */
+    struct ReadAheadObject* next;
+} ReadAheadObject;
+
+static uv_once_t read_ahead_once = UV_ONCE_INIT;
+static uv_mutex_t read_ahead_lock;
+static bool enabled = false;
+static const ReadAheadPolicy* current_policy = NULL;
+static ReadAheadObject* objects = NULL;
+static ReadAheadStats totals;
+
+static void read_ahead_init(void) {
+    uv_mutex_init(&read_ahead_lock);
+}
+
+/* ========== built-in policies ========== */
+
+static ReadAheadMode adaptive_classify(const ReadAheadHistory* history) {
+    return history->seeks >= READ_AHEAD_RANDOM_AFTER_SEEKS ? READ_AHEAD_RANDOM : READ_AHEAD_SEQUENTIAL;
+}
+
+static ReadAheadMode sequential_classify(const ReadAheadHistory* history) {
+    (void)history;
+    return READ_AHEAD_SEQUENTIAL;
+}
+
+static size_t double_window(size_t window, size_t max_window) {
+    return window < max_window / 2 ? window * 2 : max_window;
+}
+
+static const ReadAheadPolicy policies[] = {
+    { "adaptive", adaptive_classify, double_window },
+    { "sequential", sequential_classify, double_window },
+};
+
+/* ========== helpers (lock held) ========== */
+
+/** FNV-1a over bucket and key */
+static uint32_t hash_object(const char* bucket, const char* key) {
+    uint32_t hash = 2166136261u;
+    for (const char* p = bucket; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    hash = (hash ^ '/') * 16777619u;
+    for (const char* p = key; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    return hash;
+}
+
+static void object_free(ReadAheadObject* object) {
+    free(object->name);
+    free(object);
+}
+
+/** Drop the least recently opened entry no stage uses */
+static void evict_one(void) {
+    ReadAheadObject** victim = NULL;
+    for (ReadAheadObject** link = &objects; *link != NULL; link = &(*link)->next) {
+        if ((*link)->refs == 0) {
+            victim = link;
+        }
+    }
+    if (victim != NULL) {
+        ReadAheadObject* object = *victim;
+        *victim = object->next;
+        object_free(object);
+        totals.objects--;
+    }
+}
+
+/** Find or create the entry of bucket/key, moved to the front */
+static ReadAheadObject* find_object(const void* owner, size_t project_handle, const char* bucket, const char* key) {
+    uint32_t hash = hash_object(bucket, key);
+    size_t bucket_length = strlen(bucket);
+    for (ReadAheadObject** link = &objects; *link != NULL; link = &(*link)->next) {
+        ReadAheadObject* object = *link;
+        if (object->hash == hash && object->owner == owner && object->project_handle == project_handle &&
+            object->bucket_length == bucket_length && strcmp(object->name, bucket) == 0 &&
+            strcmp(object->name + bucket_length + 1, key) == 0) {
+            *link = object->next;
+            object->next = objects;
+            objects = object;
+            return object;
+        }
+    }
+
+    if (totals.objects >= READ_AHEAD_MAX_OBJECTS) {
+        evict_one();
+    }
+    size_t key_length = strlen(key);
+    ReadAheadObject* object = (ReadAheadObject*)calloc(1, sizeof(ReadAheadObject));
+    if (object == NULL || (object->name = (char*)malloc(bucket_length + key_length + 2)) == NULL) {
+        free(object);
+        return NULL;
+    }
+    memcpy(object->name, bucket, bucket_length + 1);
+    memcpy(object->name + bucket_length + 1, key, key_length + 1);
+    object->owner = owner;
+    object->project_handle = project_handle;
+    object->hash = hash;
+    object->bucket_length = bucket_length;
+    object->next = objects;
+    objects = object;
+    totals.objects++;
+    return object;
+}
+
+/** Drop every history; entries still in use are freed with their last stage */
+static void drop_objects(void) {
+    while (objects != NULL) {
+        ReadAheadObject* object = objects;
+        objects = object->next;
+        if (object->refs > 0) {
+            object->detached = true;
+        } else {
+            object_free(object);
+        }
+    }
+    totals.objects = 0;
+}
+
+/** Fold a stage's counters into the totals (lock held) */
+static void note_locked(ReadAheadStage* stage) {
+    stage->object->history.next_offset = stage->offset;
+    if (!stage->object->detached) {
+        totals.reads_served += stage->served;
+        totals.bytes_prefetched += stage->prefetched;
+        totals.window_growths += stage->growths;
+    }
+    stage->served = 0;
+    stage->prefetched = 0;
+    stage->growths = 0;
+}
+
+/* ========== public API ========== */
+
+int read_ahead_enable(const char* policy, size_t initial_window, size_t max_window) {
+    const ReadAheadPolicy* chosen = NULL;
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        if (strcmp(policies[i].name, policy) == 0) {
+            chosen = &policies[i];
+        }
+    }
+    if (chosen == NULL) {
+        return -1;
+    }
+
+    uv_once(&read_ahead_once, read_ahead_init);
+    uv_mutex_lock(&read_ahead_lock);
+    drop_objects();
+    memset(&totals, 0, sizeof(totals));
+    totals.policy = chosen->name;
+    totals.initial_window = initial_window;
+    totals.max_window = max_window;
+    current_policy = chosen;
+    enabled = true;
+    uv_mutex_unlock(&read_ahead_lock);
+
+    LOG_INFO("read-ahead enabled: policy %s, window %zu to %zu bytes", chosen->name, initial_window, max_window);
+    return 0;
+}
+
+void read_ahead_disable(void) {
+    uv_once(&read_ahead_once, read_ahead_init);
+    uv_mutex_lock(&read_ahead_lock);
+    drop_objects();
+    bool was_enabled = enabled;
+    enabled = false;
+    uv_mutex_unlock(&read_ahead_lock);
+    if (was_enabled) {
+        LOG_DEBUG("read-ahead disabled");
+    }
+}
+
+ReadAheadStage* read_ahead_open(const void* owner, size_t project_handle, const char* bucket, const char* key,
+                                uint64_t offset) {
+    uv_once(&read_ahead_once, read_ahead_init);
+    uv_mutex_lock(&read_ahead_lock);
+    if (!enabled) {
+        uv_mutex_unlock(&read_ahead_lock);
+        return NULL;
+    }
+    ReadAheadStage* stage = (ReadAheadStage*)calloc(1, sizeof(ReadAheadStage));
+    ReadAheadObject* object = stage != NULL ? find_object(owner, project_handle, bucket, key) : NULL;
+    if (object == NULL) {
+        uv_mutex_unlock(&read_ahead_lock);
+        free(stage);
+        return NULL;
+    }
+
+    /* A short skip forward still counts as continuing the pass */
+    ReadAheadHistory* history = &object->history;
+    bool continues = history->opens == 0 ||
+                     (offset >= history->next_offset && offset - history->next_offset <= totals.initial_window);
+    if (continues) {
+        history->seeks = 0;
+    } else {
+        history->seeks++;
+        totals.seeks++;
+    }
+
+    stage->object = object;
+    stage->policy = current_policy;
+    stage->mode = current_policy->classify(history);
+    stage->window = totals.initial_window;
+    stage->max_window = totals.max_window;
+    stage->offset = offset;
+    history->opens++;
+    history->next_offset = offset;
+    object->refs++;
+
+    if (stage->mode == READ_AHEAD_SEQUENTIAL) {
+        totals.sequential_opens++;
+    } else {
+        totals.random_opens++;
+    }
+    uint32_t seeks = history->seeks;
+    uv_mutex_unlock(&read_ahead_lock);
+
+    LOG_DEBUG("read-ahead: %s/%s at %llu is %s (%u seeks)", bucket, key, (unsigned long long)offset,
+              stage->mode == READ_AHEAD_SEQUENTIAL ? "sequential" : "random", seeks);
+    return stage;
+}
+
+void read_ahead_note(ReadAheadStage* stage) {
+    if (stage == NULL) {
+        return;
+    }
+    uv_mutex_lock(&read_ahead_lock);
+    note_locked(stage);
+    uv_mutex_unlock(&read_ahead_lock);
+}
+
+void read_ahead_stage_free(ReadAheadStage* stage) {
+    if (stage == NULL) {
+        return;
+    }
+    uv_mutex_lock(&read_ahead_lock);
+    note_locked(stage);
+    ReadAheadObject* object = stage->object;
+    if (--object->refs == 0 && object->detached) {
+        object_free(object);
+    }
+    uv_mutex_unlock(&read_ahead_lock);
+    free(stage->buffer);
+    free(stage);
+}
+
+int read_ahead_stats(ReadAheadStats* out) {
+    uv_once(&read_ahead_once, read_ahead_init);
+    uv_mutex_lock(&read_ahead_lock);
+    int rc = -1;
+    if (enabled) {
+        *out = totals;
+        rc = 0;
+    }
+    uv_mutex_unlock(&read_ahead_lock);
+    return rc;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file download_readahead.h
+ * @brief Access-pattern-aware read-ahead for download handles
+ *
+ * With read-ahead enabled, each downloadObject open is classified against
+ * the recent history of the same object. An open where the last read of
+ * the object stopped continues a sequential pass; an open elsewhere is a
+ * seek. Sequential handles read through a window that starts small and
+ * doubles each time a read drains it, up to a ceiling, as in kernel
+ * readahead, so many small reads share one read from the stages below.
+ * After repeated seeks the object is read randomly: reads go straight
+ * to the stages below (the chunk cache, when enabled) with no window.
+ *
+ * The classification and window growth come from a policy table, so
+ * policies can be added beside the built-in ones. History and counters
+ * are process-wide and locked, as every env opens and frees stages on its
+ * own main thread; histories are kept per env, so projects of different
+ * envs never share one. A handle's stage is touched on worker threads,
+ * one read at a time, and its counters are folded in as reads complete.
+ */
+
+#ifndef DOWNLOAD_READAHEAD_H
+#define DOWNLOAD_READAHEAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Default first window of a sequential handle (128 KiB) */
+#define READ_AHEAD_DEFAULT_INITIAL_WINDOW (128 * 1024)
+
+/** Default window ceiling (8 MiB) */
+#define READ_AHEAD_DEFAULT_MAX_WINDOW (8 * 1024 * 1024)
+
+/** Window bounds accepted by read_ahead_enable */
+#define READ_AHEAD_MIN_WINDOW (4 * 1024)
+#define READ_AHEAD_MAX_WINDOW (64 * 1024 * 1024)
+
+/** Consecutive seeks after which the adaptive policy reads an object randomly */
+#define READ_AHEAD_RANDOM_AFTER_SEEKS 2
+
+/** Objects whose history is kept; the least recently opened idle one is dropped */
+#define READ_AHEAD_MAX_OBJECTS 256
+
+typedef enum {
+    READ_AHEAD_SEQUENTIAL,
+    READ_AHEAD_RANDOM,
+} ReadAheadMode;
+
+/**
+ * Access history of one object, as seen by a policy
+ */
+typedef struct {
+    uint64_t next_offset;           /* Where the last read of the object stopped */
+    uint32_t opens;                 /* Opens before this one */
+    uint32_t seeks;                 /* Consecutive opens away from next_offset, this one included */
+} ReadAheadHistory;
+
+/**
+ * A read-ahead policy. Both callbacks must be pure: classify runs on the
+ * main thread, next_window on worker threads.
+ */
+typedef struct {
+    const char* name;
+    ReadAheadMode (*classify)(const ReadAheadHistory* history);
+    size_t (*next_window)(size_t window, size_t max_window);
+} ReadAheadPolicy;
+
+/**
+ * Read-ahead stage of one download handle
+ */
+typedef struct {
+    struct ReadAheadObject* object;     /* History entry, one reference */
+    const ReadAheadPolicy* policy;
+    ReadAheadMode mode;
+    size_t window;                      /* Next refill size */
+    size_t max_window;
+    uint8_t* buffer;
+    size_t capacity;
+    size_t position;                    /* Next buffered byte handed out */
+    size_t filled;
+    bool eof;                           /* The stages below reached the end */
+    uint64_t offset;                    /* Object offset of the next byte handed out */
+    uint64_t served;                    /* Counters not yet folded into the totals */
+    uint64_t prefetched;
+    uint64_t growths;
+} ReadAheadStage;
+
+/**
+ * Process-wide counters
+ */
+typedef struct {
+    const char* policy;
+    uint64_t sequential_opens;
+    uint64_t random_opens;
+    uint64_t seeks;                     /* Opens away from where the object was last read */
+    uint64_t reads_served;              /* Reads answered from a window without a refill */
+    uint64_t bytes_prefetched;          /* Bytes read into windows */
+    uint64_t window_growths;
+    size_t objects;                     /* Objects with history */
+    size_t initial_window;
+    size_t max_window;
+} ReadAheadStats;
+
+/**
+ * Enable (or reconfigure, dropping all history) read-ahead
+ *
+ * @param policy Built-in policy name ("adaptive" or "sequential")
+ * @return 0 on success, -1 for an unknown policy
+ */
+int read_ahead_enable(const char* policy, size_t initial_window, size_t max_window);
+
+/**
+ * Disable read-ahead; open handles keep their stages
+ */
+void read_ahead_disable(void);
+
+/**
+ * Classify an open of bucket/key at @p offset and build its stage
+ *
+ * @param owner Identity of the opening env (its AddonInstance); histories
+ *              of different owners are kept apart
+ * @return The stage, or NULL when read-ahead is disabled or memory is short
+ */
+ReadAheadStage* read_ahead_open(const void* owner, size_t project_handle, const char* bucket, const char* key,
+                                uint64_t offset);
+
+/**
+ * Record where a handle's reads stopped and fold in its counters (the
+ * opening env's main thread, after each read completes)
+ */
+void read_ahead_note(ReadAheadStage* stage);
+
+/**
+ * Free a stage (the opening env's main thread); NULL is a no-op
+ */
+void read_ahead_stage_free(ReadAheadStage* stage);
+
+/**
+ * Read the counters
+ *
+ * @return 0 on success, -1 when read-ahead is disabled
+ */
+int read_ahead_stats(ReadAheadStats* out);
+
+#endif /* DOWNLOAD_READAHEAD_H */
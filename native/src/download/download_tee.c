@@ -0,0 +1,219 @@
+/**
+ * @file download_tee.c
+ * @brief Download tee sink implementation
+ */
+
+#include "download_tee.h"
+#include "../common/file_helpers.h"
+#include "../common/type_converters.h"
+#include "../common/result_helpers.h"
+#include "../common/error_registry.h"
+#include "../common/logger.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========== helpers ========== */
+
+/** Mark @p sink failed with "<what> '<path>': <strerror(errno)>" and close its file */
+static void sink_fail(DownloadTeeSink* sink, const char* what) {
+    char message[512];
+    snprintf(message, sizeof(message), "%s '%s': %s", what, sink->path, strerror(errno));
+    sink->error_message = strdup(message);
+    if (sink->error_message == NULL) {
+        sink->error_message = strdup("Out of memory");
+    }
+    file_close(sink->fd);
+    sink->fd = -1;
+    if (sink->required) {
+        LOG_ERROR("download tee: %s", message);
+    } else {
+        LOG_WARN("download tee: dropping optional sink, %s", message);
+    }
+}
+
+static bool sink_write_file(DownloadTeeSink* sink, const uint8_t* data, size_t length) {
+    if (sink->fd < 0) {
+        sink->fd = file_open_write(sink->path, 1);
+        if (sink->fd < 0) {
+            sink_fail(sink, "cannot open file");
+            return false;
+        }
+    }
+    size_t done = 0;
+    while (done < length) {
+        int64_t n = file_write_at(sink->fd, data + done, length - done, (int64_t)(sink->bytes + done));
+        if (n <= 0) {
+            if (n == 0) errno = EIO;
+            sink_fail(sink, "cannot write file");
+            return false;
+        }
+        done += (size_t)n;
+    }
+    return true;
+}
+
+static int sink_from_js(napi_env env, napi_value value, DownloadTeeSink* sink) {
+    napi_valuetype type;
+    napi_typeof(env, value, &type);
+    if (type != napi_object) {
+        throw_type_error(env, "each tee sink must be { path, fsync?, required? } or { hash }");
+        return -1;
+    }
+    sink->fd = -1;
+    sink->required = get_bool_property(env, value, "required", 1) != 0;
+    sink->path = get_string_property(env, value, "path");
+    char* hash = get_string_property(env, value, "hash");
+    if ((sink->path != NULL) == (hash != NULL) || (sink->path != NULL && sink->path[0] == '\0')) {
+        free(hash);
+        throw_type_error(env, "each tee sink must be { path, fsync?, required? } or { hash }");
+        return -1;
+    }
+    if (sink->path != NULL) {
+        sink->type = DOWNLOAD_TEE_FILE;
+        sink->fsync = get_bool_property(env, value, "fsync", 0) != 0;
+        return 0;
+    }
+    ChecksumType algorithm = checksum_type_from_name(hash);
+    free(hash);
+    if (algorithm == CHECKSUM_NONE) {
+        throw_type_error(env, "tee hash must be 'crc32c' or 'sha256'");
+        return -1;
+    }
+    sink->type = DOWNLOAD_TEE_HASH;
+    checksum_init(&sink->checksum, algorithm);
+    return 0;
+}
+
+/* ========== public API ========== */
+
+int download_tee_from_js(napi_env env, napi_value value, DownloadTee** out) {
+    *out = NULL;
+    napi_valuetype type;
+    napi_typeof(env, value, &type);
+    if (type == napi_undefined || type == napi_null) {
+        return 0;
+    }
+    bool is_array = false;
+    uint32_t count = 0;
+    napi_is_array(env, value, &is_array);
+    if (is_array) {
+        napi_get_array_length(env, value, &count);
+    }
+    if (!is_array || count > DOWNLOAD_TEE_MAX_SINKS) {
+        throw_type_error(env, "tee must be an array of at most 8 sinks");
+        return -1;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    DownloadTee* tee = (DownloadTee*)calloc(1, sizeof(DownloadTee));
+    if (tee != NULL) {
+        tee->sinks = (DownloadTeeSink*)calloc(count, sizeof(DownloadTeeSink));
+    }
+    if (tee == NULL || tee->sinks == NULL) {
+        free(tee);
+        throw_error(env, "Out of memory");
+        return -1;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value element;
+        napi_get_element(env, value, i, &element);
+        tee->count++;
+        if (sink_from_js(env, element, &tee->sinks[i]) != 0) {
+            download_tee_free(tee);
+            return -1;
+        }
+    }
+    *out = tee;
+    return 0;
+}
+
+void download_tee_free(DownloadTee* tee) {
+    if (tee == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < tee->count; i++) {
+        file_close(tee->sinks[i].fd);
+        free(tee->sinks[i].path);
+        free(tee->sinks[i].error_message);
+    }
+    free(tee->sinks);
+    free(tee);
+}
+
+const DownloadTeeSink* download_tee_write(DownloadTee* tee, const uint8_t* data, size_t length) {
+    const DownloadTeeSink* failed = NULL;
+    for (size_t i = 0; i < tee->count; i++) {
+        DownloadTeeSink* sink = &tee->sinks[i];
+        if (sink->error_message == NULL && length > 0) {
+            if (sink->type == DOWNLOAD_TEE_HASH) {
+                checksum_update(&sink->checksum, data, length);
+                sink->bytes += length;
+            } else if (sink_write_file(sink, data, length)) {
+                sink->bytes += length;
+            }
+        }
+        /* Once a required sink has failed, every later read fails too */
+        if (sink->error_message != NULL && sink->required && failed == NULL) {
+            failed = sink;
+        }
+    }
+    return failed;
+}
+
+const DownloadTeeSink* download_tee_finish(DownloadTee* tee) {
+    const DownloadTeeSink* failed = NULL;
+    for (size_t i = 0; i < tee->count; i++) {
+        DownloadTeeSink* sink = &tee->sinks[i];
+        if (sink->type != DOWNLOAD_TEE_FILE || sink->error_message != NULL) {
+            continue;
+        }
+        /* A sink that never saw a byte still leaves an empty file, like an empty object would */
+        if (sink->fd < 0 && (sink->fd = file_open_write(sink->path, 1)) < 0) {
+            sink_fail(sink, "cannot open file");
+        } else if (sink->fsync && file_sync(sink->fd) != 0) {
+            sink_fail(sink, "cannot sync file");
+        } else {
+            file_close(sink->fd);
+            sink->fd = -1;
+            continue;
+        }
+        if (sink->required && failed == NULL) {
+            failed = sink;
+        }
+    }
+    return failed;
+}
+
+napi_value download_tee_results_to_js(napi_env env, const DownloadTee* tee) {
+    napi_value results;
+    napi_create_array_with_length(env, tee != NULL ? tee->count : 0, &results);
+    for (size_t i = 0; tee != NULL && i < tee->count; i++) {
+        const DownloadTeeSink* sink = &tee->sinks[i];
+        napi_value result, bytes, value;
+        napi_create_object(env, &result);
+        napi_create_double(env, (double)sink->bytes, &bytes);
+        napi_set_named_property(env, result, "bytes", bytes);
+        if (sink->type == DOWNLOAD_TEE_FILE) {
+            napi_create_string_utf8(env, sink->path, NAPI_AUTO_LENGTH, &value);
+            napi_set_named_property(env, result, "path", value);
+        } else {
+            char digest[CHECKSUM_HEX_MAX];
+            checksum_hex(&sink->checksum, digest, sizeof(digest));
+            napi_create_string_utf8(env, checksum_type_name(sink->checksum.type), NAPI_AUTO_LENGTH, &value);
+            napi_set_named_property(env, result, "algorithm", value);
+            napi_create_string_utf8(env, digest, NAPI_AUTO_LENGTH, &value);
+            napi_set_named_property(env, result, "digest", value);
+        }
+        if (sink->error_message != NULL) {
+            napi_set_named_property(env, result, "error",
+                                    create_typed_error(env, UPLINK_ERROR_INTERNAL, sink->error_message));
+        }
+        napi_set_element(env, results, (uint32_t)i, result);
+    }
+    return results;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file download_tee.h
+ * @brief Native sinks fed by every read of a download
+ *
+ * A download opened with options.tee hands each chunk it reads into the
+ * caller's buffer to its sinks as well: files written in read order and
+ * running digests. Every sink reads the same bytes, so nothing is copied
+ * per sink, and a read settles only after all sinks took its bytes, which
+ * paces the reader to the slowest sink. A required sink that fails fails
+ * the read; an optional one is dropped and the download goes on.
+ *
+ * Reads on one download run one at a time, so sinks are touched on
+ * worker threads without a lock.
+ */
+
+#ifndef DOWNLOAD_TEE_H
+#define DOWNLOAD_TEE_H
+
+#include <node_api.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../common/checksum.h"
+
+/** Most sinks one download may tee to */
+#define DOWNLOAD_TEE_MAX_SINKS 8
+
+typedef enum {
+    DOWNLOAD_TEE_FILE,
+    DOWNLOAD_TEE_HASH,
+} DownloadTeeSinkType;
+
+/**
+ * One sink of a download tee
+ */
+typedef struct {
+    DownloadTeeSinkType type;
+    bool required;          /* A failure fails the read; otherwise the sink is dropped */
+    char* path;             /* File sinks: created or truncated on the first read */
+    bool fsync;             /* File sinks: flushed to disk at close */
+    int fd;                 /* -1 = not open */
+    ChecksumState checksum; /* Hash sinks */
+    uint64_t bytes;         /* Bytes the sink took */
+    char* error_message;    /* Set once the sink failed */
+} DownloadTeeSink;
+
+/**
+ * Sinks of one download (owned by the download handle's state)
+ */
+typedef struct {
+    DownloadTeeSink* sinks;
+    size_t count;
+} DownloadTee;
+
+/**
+ * Parse options.tee, an array of { path, fsync?, required? } and
+ * { hash: 'crc32c' | 'sha256' } sinks (main thread)
+ *
+ * @param[out] out Receives the tee, or NULL when @p value is undefined
+ * @return 0 on success, -1 with a pending exception
+ */
+int download_tee_from_js(napi_env env, napi_value value, DownloadTee** out);
+
+/**
+ * Free a tee, closing its files (NULL is a no-op)
+ */
+void download_tee_free(DownloadTee* tee);
+
+/**
+ * Hand @p length bytes just read to every live sink (worker thread)
+ *
+ * @return The first required sink that failed, or NULL
+ */
+const DownloadTeeSink* download_tee_write(DownloadTee* tee, const uint8_t* data, size_t length);
+
+/**
+ * Flush and close the file sinks when the download is closed (worker thread)
+ *
+ * @return The first required sink that failed while closing, or NULL
+ */
+const DownloadTeeSink* download_tee_finish(DownloadTee* tee);
+
+/**
+ * Per-sink outcome: [{ bytes, path | algorithm, digest?, error? }] (main thread)
+ */
+napi_value download_tee_results_to_js(napi_env env, const DownloadTee* tee);
+
+#endif /* DOWNLOAD_TEE_H */
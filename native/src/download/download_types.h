@@ -8,13 +8,135 @@
 
 #include <node_api.h>
 #include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 /* Disable compat macros to avoid function name conflicts */
 #define UPLINK_DISABLE_NAMESPACE_COMPAT
 #include "uplink.h"
+#include "../common/cancel_token.h"
+#include "../common/progress.h"
+#include "../common/checksum.h"
+#include "../common/codec.h"
+#include "../common/object_cache.h"
+#include "../common/chunk_cache.h"
+#include "../common/retry.h"
+#include "download_tee.h"
+#include "download_readahead.h"
+#include "download_ranges.h"
 
 /* ========== Async Work Data Structures ========== */
 
+/** Custom metadata key prefix searched by options.verify, as written by inline upload checksums */
+#define DOWNLOAD_VERIFY_KEY_PREFIX "checksum-"
+
+/**
+ * Content verification attached to a download handle opened with
+ * options.verify. Reads on one download run one at a time, so the
+ * checksum is updated on worker threads without a lock.
+ */
+typedef struct {
+    ChecksumState checksum;
+    char expected[CHECKSUM_HEX_MAX];    /* Lowercase hex digest */
+    uint64_t content_length;            /* Digest is compared once this many bytes are hashed */
+    bool done;                          /* Digest compared */
+} DownloadVerifyState;
+
+/**
+ * Decompression stage of a download of an object uploaded with a codec.
+ *
+ * The download is positioned at the first frame holding the requested
+ * range; each frame is read into @c frame (resuming across reads when a
+ * read stops early), decoded into @c chunk, and handed out from there.
+ * Touched only on worker threads, one read at a time.
+ */
+typedef struct {
+    CodecType type;
+    size_t chunk_size;
+    uint64_t raw_size;          /* Original object size */
+    uint64_t raw_position;      /* Original offset of the next byte handed out */
+    uint64_t raw_end;           /* Original offset reads stop at */
+    uint64_t next_chunk;        /* Index of the frame read next */
+    uint8_t* chunk;             /* Decoded chunk */
+    size_t chunk_position;
+    size_t chunk_length;
+    size_t skip;                /* Leading bytes of the next decoded chunk outside the range */
+    uint8_t* frame;             /* Header + payload being read */
+    size_t frame_filled;
+} DownloadCodecStage;
+
+/**
+ * Disk chunk cache stage of a download (see chunk_cache.h).
+ *
+ * The handle's download is opened at the first chunk of the requested
+ * range. Reads are served chunk by chunk from the cache file; a missing
+ * chunk is read in full from the network download into @c chunk
+ * (resuming across reads when a read stops early), stored, and handed
+ * out from there. After cached chunks were skipped, the network download
+ * is reopened at the next missing one. Touched only on worker threads,
+ * one read at a time.
+ */
+typedef struct {
+    ChunkCacheFile* file;       /* NULL = object not cacheable; every chunk is fetched */
+    size_t chunk_size;
+    uint64_t content_length;
+    uint64_t position;          /* Object offset of the next byte handed out */
+    uint64_t end;               /* Object offset reads stop at */
+    size_t project_handle;
+    char* bucket_name;          /* Owned copies, to reopen at another chunk */
+    char* object_key;
+    size_t base_download;       /* Handle's download (owned by the handle) */
+    UplinkDownloadResult reopened; /* Download opened by the stage, or none */
+    uint64_t network_position;  /* Object offset the network download reads next */
+    uint8_t* chunk;             /* Chunk being fetched */
+    uint64_t chunk_index;       /* Chunk held in @c chunk; UINT64_MAX = none */
+    size_t chunk_filled;
+} DownloadCacheStage;
+
+/**
+ * Native state attached to a download's HandleWrapper when it was opened
+ * with options.verify or options.tee, reads a compressed object, reads
+ * through the chunk cache, or tracks its access pattern for read-ahead.
+ */
+typedef struct {
+    DownloadVerifyState* verify;        /* NULL = not verified */
+    DownloadCodecStage* codec;          /* NULL = bytes read as stored */
+    DownloadCacheStage* cache;          /* NULL = chunk cache not used */
+    DownloadTee* tee;                   /* NULL = no sinks besides the reader */
+    ReadAheadStage* ahead;              /* NULL = read-ahead disabled for the handle */
+} DownloadHandleState;
+
+/** Bytes of the first read made by a get_object open attempt (64 KiB) */
+#define DOWNLOAD_FIRST_READ_SIZE (64 * 1024)
+
+/** Metric the first-byte latency of get_object is recorded under, and hedged against */
+#define DOWNLOAD_FIRST_BYTE_METRIC "getObjectFirstByte"
+
+/**
+ * One attempt at opening an object (and, for get_object, reading its
+ * first bytes). With options.hedge two of these race (see hedge.h); the
+ * loser may outlive the call, so hedged attempts own copies of the names
+ * and touch neither the cancel token nor the progress reporter.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    bool owns_names;                    /* Names are copies freed with the attempt */
+    UplinkDownloadOptions options;
+    int64_t max_size;                   /* get_object: maxSize, -1 = no limit */
+    size_t cache_max_size;              /* get_object: read into a blob up to this size */
+    CancelToken* cancel;                /* Stops bandwidth waits; NULL when hedged */
+    UplinkDownloadResult download;      /* Open download, or none */
+    UplinkObjectResult info;            /* get_object: the object, or none */
+    ObjectCacheBlob* blob;              /* get_object: one reference, or NULL */
+    uint8_t* data;                      /* get_object: malloc'd (or blob->data) */
+    size_t length;                      /* get_object: bytes of the first read */
+    bool eof;                           /* get_object: the first read hit the end */
+    uint64_t first_byte_at;             /* uv_hrtime() when the first read returned */
+    UplinkError* error;
+} DownloadAttempt;
+
 /**
  * Data structure for download_object operation
  */
@@ -24,6 +146,21 @@ typedef struct {
     char* object_key;
     int64_t offset;
     int64_t length;
+    ChecksumType verify_type;           /* CHECKSUM_NONE = options.verify not given */
+    char* verify_expected;              /* options.verify.expected, lowercase, or NULL */
+    char* verify_key;                   /* Metadata key holding the digest when no expected */
+    DownloadVerifyState* verify;        /* Set up on the worker, moved to the handle on success */
+    bool decompress;                    /* Decode objects uploaded with a codec (default) */
+    DownloadCodecStage* codec;          /* Set up on the worker, moved to the handle on success */
+    bool chunk_cache;                   /* Read through the chunk cache when enabled (default) */
+    DownloadCacheStage* cache;          /* Set up on the worker, moved to the handle on success */
+    DownloadTee* tee;                   /* From options.tee, moved to the handle on success */
+    ReadAheadStage* ahead;              /* Classified at the call, moved to the handle on success */
+    uint64_t hedge_delay_ns;            /* Race a second open after this long; 0 = options.hedge not given */
+    RetryPolicy retry;                  /* From options.retry, applied to the open */
+    struct AdmissionSlot* admission;    /* Transfer slot, moved to the handle on success */
+    CancelToken* cancel;                /* From options.cancelToken, or NULL */
+    bool cancelled;                     /* Opened after the token stopped; already closed */
     UplinkDownloadResult result;
     napi_deferred deferred;
     napi_async_work work;
@@ -37,10 +174,148 @@ typedef struct {
     void* buffer_ptr;       /* Direct pointer to JS buffer (no copy) */
     size_t data_length;
     napi_ref buffer_ref;    /* Reference to keep JS buffer alive during async work */
+    bool fill;              /* readFull: loop until data_length bytes or EOF */
+    bool eof_as_value;      /* Resolve { bytesRead, eof } instead of rejecting on EOF */
+    bool eof;
+    size_t bandwidth_project; /* Project whose bandwidth limits apply, or 0 */
+    DownloadVerifyState* verify; /* Owned by the handle; NULL = not verified */
+    DownloadCodecStage* codec;   /* Owned by the handle; NULL = bytes read as stored */
+    DownloadCacheStage* cache;   /* Owned by the handle; NULL = chunk cache not used */
+    DownloadTee* tee;            /* Owned by the handle; NULL = no tee */
+    ReadAheadStage* ahead;       /* Owned by the handle; NULL = no read-ahead */
+    CancelToken* cancel;    /* From options.cancelToken, or NULL */
+    bool cancelled;         /* Stopped early by @c cancel */
     UplinkReadResult result;
+    napi_deferred deferred; /* NULL when settled through @c callback */
+    napi_ref callback;      /* downloadReadCb: called (error, bytesRead, eof) */
+    napi_async_work work;   /* Only with a cancel token; NULL for a pooled job */
+} DownloadReadData;
+
+/**
+ * Data structure for download_to_file operation
+ *
+ * The whole download (open, read/pwrite loop, close) runs inside one
+ * async work, so the error is captured as code + message on the worker thread.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    char* file_path;
+    int64_t offset;
+    int64_t length;
+    size_t chunk_size;
+    bool fsync;             /* Flush the file to disk before resolving */
+    size_t bytes_written;
+    CancelToken* cancel;    /* From options.cancelToken, or NULL */
+    ProgressReporter* progress; /* From options.onProgress, or NULL */
+    int32_t error_code;
+    char* error_message;
     napi_deferred deferred;
     napi_async_work work;
-} DownloadReadData;
+} DownloadToFileData;
+
+/** Default chunk size for download_to_file reads (1 MiB) */
+#define DOWNLOAD_FILE_DEFAULT_CHUNK_SIZE (1024 * 1024)
+
+/**
+ * Data structure for get_object operation
+ *
+ * Download, info, read-to-EOF and close run inside one async work; the
+ * object lands in a single buffer sized from the content length, which is
+ * handed to JS without a copy. With the project's object cache enabled,
+ * objects small enough to cache are read into a shareable blob instead.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    int64_t max_size;           /* Reject objects larger than this; -1 = no limit */
+    uint8_t* data;              /* malloc'd (or blob->data), owned until handed to JS */
+    size_t length;
+    size_t cache_max_size;      /* Read objects up to this size into a blob; 0 = no cache */
+    uint64_t cache_epoch;       /* object_cache_epoch() when queued */
+    ObjectCacheBlob* blob;      /* One reference, or NULL */
+    uint64_t hedge_delay_ns;    /* Race a second attempt after this long; 0 = options.hedge not given */
+    RetryPolicy retry;          /* From options.retry, applied up to the first bytes */
+    uint64_t first_byte_ns;     /* Open to first bytes as the caller saw it; 0 = not reached */
+    UplinkObjectResult info;
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    ProgressReporter* progress; /* From options.onProgress, or NULL */
+    int32_t error_code;
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} GetObjectData;
+
+/** Default range size for download_parallel (64 MiB, one Storj segment) */
+#define PARALLEL_DOWNLOAD_DEFAULT_RANGE_SIZE (64 * 1024 * 1024)
+
+/** Default number of ranges downloaded concurrently by download_parallel */
+#define PARALLEL_DOWNLOAD_DEFAULT_CONCURRENCY 4
+
+/** Default number of retries per failed range */
+#define PARALLEL_DOWNLOAD_DEFAULT_RETRIES 3
+
+/**
+ * Data structure for download_parallel operation
+ *
+ * The sink is either a pinned JS buffer or a file path. The object is
+ * stat'ed and split into ranges, each downloaded on its own stream by a
+ * native thread and written into its slot of the sink.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    char* file_path;            /* NULL when downloading into a buffer */
+    void* buffer_ptr;           /* Direct pointer to JS buffer (no copy) */
+    size_t buffer_length;
+    napi_ref buffer_ref;        /* Keeps JS buffer alive during async work */
+    bool auto_tune;             /* Adapt range size and in-flight ranges as ranges finish */
+    uint64_t range_size;        /* Fixed range size, or the starting size when auto_tune */
+    uint32_t concurrency;       /* Ranges in flight, or the ceiling when auto_tune */
+    uint32_t max_retries;
+    bool fsync;                 /* Flush file sinks to disk before resolving */
+    uint64_t content_length;
+    uint32_t range_count;
+    uint64_t tuned_range_size;  /* Settled range size when auto_tune */
+    uint32_t tuned_concurrency; /* Settled in-flight ranges when auto_tune */
+    double tuned_goodput;       /* Bytes per second of the tuner's last window */
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    ProgressReporter* progress; /* From options.onProgress, or NULL */
+    int32_t error_code;
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} DownloadParallelData;
+
+/**
+ * Data structure for download_ranges operation
+ *
+ * Ranges are sorted and merged into spans when the gap between them is
+ * at most coalesce_gap. Spans are downloaded on native threads into one
+ * arena that becomes a single JS buffer; each range is a view of it.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    DownloadRange* ranges;
+    uint32_t range_count;
+    DownloadSpan* spans;
+    uint32_t span_count;
+    uint64_t coalesce_gap;
+    uint32_t concurrency;
+    uint32_t max_retries;
+    uint8_t* arena;
+    uint64_t arena_length;
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    int32_t error_code;
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} DownloadRangesData;
 
 /**
  * Data structure for download_info operation
@@ -57,7 +332,11 @@ typedef struct {
  */
 typedef struct {
     size_t download_handle;
+    struct AdmissionSlot* admission;    /* Transfer slot taken from the handle, released on completion */
     UplinkError* error;
+    UplinkError* verify_error;          /* Digest mismatch found at close, reported after closing */
+    DownloadTee* tee;                   /* Owned by the handle; file sinks are closed with the download */
+    char* tee_error;                    /* Required sink that failed to close, reported after closing */
     napi_deferred deferred;
     napi_async_work work;
 } CloseDownloadData;
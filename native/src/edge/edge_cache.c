@@ -0,0 +1,263 @@
+/**
+ * @file edge_cache.c
+ * @brief Opt-in process-wide edgeRegisterAccess credential cache implementation
+ *
+ * Laid out like access_cache.c: a chained hash table of entries threaded
+ * on an LRU list, most recent at the head. Lookups and inserts run on
+ * the worker threads executing edgeRegisterAccess, so the table sits
+ * behind one mutex; hits hand out copies, never entry pointers.
+ */
+
+#include "edge_cache.h"
+#include "../common/logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <uv.h>
+
+typedef struct EdgeCacheEntry {
+    char* key;
+    size_t key_length;
+    uint64_t hash;
+    char* access_key_id;
+    char* secret_key;
+    char* endpoint;
+    uint64_t expires_at;            /* uv_hrtime() deadline, ns */
+    struct EdgeCacheEntry* chain;   /* Next in hash bucket */
+    struct EdgeCacheEntry* prev;    /* LRU neighbours */
+    struct EdgeCacheEntry* next;
+} EdgeCacheEntry;
+
+typedef struct {
+    EdgeCacheEntry** buckets;
+    size_t bucket_count;            /* Power of two */
+    EdgeCacheEntry* head;           /* Most recently used */
+    EdgeCacheEntry* tail;
+    EdgeCacheStats stats;
+} EdgeCache;
+
+static uv_once_t edge_cache_once = UV_ONCE_INIT;
+static uv_mutex_t edge_cache_lock;
+static EdgeCache* cache;
+
+static void edge_cache_init(void) {
+    uv_mutex_init(&edge_cache_lock);
+}
+
+/* ========== helpers ========== */
+
+/** FNV-1a, 64-bit */
+static uint64_t hash_key(const char* key, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)key[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static EdgeCacheEntry** find_slot(uint64_t hash, const char* key, size_t length) {
+    EdgeCacheEntry** slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+    while (*slot != NULL &&
+           !((*slot)->hash == hash && (*slot)->key_length == length && memcmp((*slot)->key, key, length) == 0)) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+static void lru_unlink(EdgeCacheEntry* entry) {
+    if (entry->prev != NULL) entry->prev->next = entry->next; else cache->head = entry->next;
+    if (entry->next != NULL) entry->next->prev = entry->prev; else cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void lru_push_front(EdgeCacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head != NULL) cache->head->prev = entry; else cache->tail = entry;
+    cache->head = entry;
+}
+
+static void entry_free(EdgeCacheEntry* entry) {
+    free(entry->key);
+    free(entry->access_key_id);
+    free(entry->secret_key);
+    free(entry->endpoint);
+    free(entry);
+}
+
+/** Unlist and free the entry in @p slot */
+static void remove_entry(EdgeCacheEntry** slot) {
+    EdgeCacheEntry* entry = *slot;
+    *slot = entry->chain;
+    lru_unlink(entry);
+    cache->stats.entries--;
+    entry_free(entry);
+}
+
+static void remove_lookup(EdgeCacheEntry* entry) {
+    remove_entry(find_slot(entry->hash, entry->key, entry->key_length));
+}
+
+static char* copy_field(const char* value) {
+    return strdup(value != NULL ? value : "");
+}
+
+/* ========== public API ========== */
+
+int edge_cache_enable(size_t max_entries, int64_t ttl_ms) {
+    edge_cache_disable();
+
+    EdgeCache* created = (EdgeCache*)calloc(1, sizeof(EdgeCache));
+    if (created == NULL) return -1;
+
+    created->bucket_count = 16;
+    while (created->bucket_count < max_entries) {
+        created->bucket_count <<= 1;
+    }
+    created->buckets = (EdgeCacheEntry**)calloc(created->bucket_count, sizeof(EdgeCacheEntry*));
+    if (created->buckets == NULL) {
+        free(created);
+        return -1;
+    }
+    created->stats.max_entries = max_entries;
+    created->stats.ttl_ms = ttl_ms;
+
+    uv_mutex_lock(&edge_cache_lock);
+    cache = created;
+    uv_mutex_unlock(&edge_cache_lock);
+
+    LOG_INFO("edge cache enabled (max %zu entries, ttl %lld ms)", max_entries, (long long)ttl_ms);
+    return 0;
+}
+
+void edge_cache_disable(void) {
+    uv_once(&edge_cache_once, edge_cache_init);
+
+    uv_mutex_lock(&edge_cache_lock);
+    if (cache == NULL) {
+        uv_mutex_unlock(&edge_cache_lock);
+        return;
+    }
+    while (cache->head != NULL) {
+        remove_lookup(cache->head);
+    }
+    free(cache->buckets);
+    free(cache);
+    cache = NULL;
+    uv_mutex_unlock(&edge_cache_lock);
+    LOG_DEBUG("edge cache disabled");
+}
+
+bool edge_cache_enabled(void) {
+    uv_once(&edge_cache_once, edge_cache_init);
+
+    uv_mutex_lock(&edge_cache_lock);
+    bool enabled = cache != NULL;
+    uv_mutex_unlock(&edge_cache_lock);
+    return enabled;
+}
+
+char* edge_cache_key(const char* auth_service_address, bool is_public, const char* serialized_access) {
+    size_t address_length = strlen(auth_service_address);
+    size_t access_length = strlen(serialized_access);
+
+    /* address \n public-flag \n access */
+    char* key = (char*)malloc(address_length + access_length + 4);
+    if (key == NULL) return NULL;
+    memcpy(key, auth_service_address, address_length);
+    key[address_length] = '\n';
+    key[address_length + 1] = is_public ? '1' : '0';
+    key[address_length + 2] = '\n';
+    memcpy(key + address_length + 3, serialized_access, access_length + 1);
+    return key;
+}
+
+bool edge_cache_lookup(const char* key, EdgeCredentials* out) {
+    uv_once(&edge_cache_once, edge_cache_init);
+
+    size_t length = strlen(key);
+    uint64_t hash = hash_key(key, length);
+    bool hit = false;
+
+    uv_mutex_lock(&edge_cache_lock);
+    if (cache != NULL) {
+        EdgeCacheEntry** slot = find_slot(hash, key, length);
+        if (*slot != NULL && (*slot)->expires_at <= uv_hrtime()) {
+            remove_entry(slot);
+        }
+        EdgeCacheEntry* entry = *find_slot(hash, key, length);
+        if (entry != NULL) {
+            out->access_key_id = strdup(entry->access_key_id);
+            out->secret_key = strdup(entry->secret_key);
+            out->endpoint = strdup(entry->endpoint);
+            hit = out->access_key_id != NULL && out->secret_key != NULL && out->endpoint != NULL;
+            if (!hit) {
+                free(out->access_key_id);
+                free(out->secret_key);
+                free(out->endpoint);
+            } else {
+                lru_unlink(entry);
+                lru_push_front(entry);
+            }
+        }
+        if (hit) cache->stats.hits++; else cache->stats.misses++;
+    }
+    uv_mutex_unlock(&edge_cache_lock);
+    return hit;
+}
+
+void edge_cache_insert(const char* key, const EdgeCredentials* credentials) {
+    uv_once(&edge_cache_once, edge_cache_init);
+    if (credentials == NULL) return;
+
+    size_t length = strlen(key);
+    EdgeCacheEntry* entry = (EdgeCacheEntry*)calloc(1, sizeof(EdgeCacheEntry));
+    if (entry == NULL) return;
+    entry->key = strdup(key);
+    entry->access_key_id = copy_field(credentials->access_key_id);
+    entry->secret_key = copy_field(credentials->secret_key);
+    entry->endpoint = copy_field(credentials->endpoint);
+    if (entry->key == NULL || entry->access_key_id == NULL || entry->secret_key == NULL || entry->endpoint == NULL) {
+        entry_free(entry);
+        return;
+    }
+    entry->key_length = length;
+    entry->hash = hash_key(key, length);
+
+    uv_mutex_lock(&edge_cache_lock);
+    if (cache == NULL) {
+        uv_mutex_unlock(&edge_cache_lock);
+        entry_free(entry);
+        return;
+    }
+
+    EdgeCacheEntry** slot = find_slot(entry->hash, key, length);
+    if (*slot != NULL) {
+        /* Registered twice concurrently; the newer credentials win */
+        remove_entry(slot);
+        slot = find_slot(entry->hash, key, length);
+    }
+    entry->expires_at = uv_hrtime() + (uint64_t)cache->stats.ttl_ms * 1000000u;
+    *slot = entry;
+    lru_push_front(entry);
+    cache->stats.entries++;
+
+    while (cache->stats.entries > cache->stats.max_entries && cache->tail != NULL) {
+        remove_lookup(cache->tail);
+        cache->stats.evictions++;
+    }
+    uv_mutex_unlock(&edge_cache_lock);
+}
+
+int edge_cache_stats(EdgeCacheStats* out) {
+    uv_once(&edge_cache_once, edge_cache_init);
+
+    uv_mutex_lock(&edge_cache_lock);
+    int rc = -1;
+    if (cache != NULL) {
+        *out = cache->stats;
+        rc = 0;
+    }
+    uv_mutex_unlock(&edge_cache_lock);
+    return rc;
+}
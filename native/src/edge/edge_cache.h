@@ -0,0 +1,89 @@
+/**
+ * @file edge_cache.h
+ * @brief Opt-in process-wide cache of edgeRegisterAccess credentials
+ *
+ * A bounded LRU of registered credentials keyed by the auth service
+ * address, the isPublic option and the serialized access, with a TTL.
+ * A hit skips the round trip to the auth service. Registering the same
+ * access again yields equivalent credentials, so the TTL only bounds how
+ * long a revoked or expiring access keeps being served from the cache.
+ * All functions are safe from any thread.
+ */
+
+#ifndef UPLINK_EDGE_CACHE_H
+#define UPLINK_EDGE_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Disable compat macros to avoid function name conflicts */
+#define UPLINK_DISABLE_NAMESPACE_COMPAT
+#include "uplink.h"
+
+/** Default entry limit for enableEdgeCache */
+#define EDGE_CACHE_DEFAULT_MAX_ENTRIES 256
+
+/** Default entry lifetime for enableEdgeCache (1 h) */
+#define EDGE_CACHE_DEFAULT_TTL_MS 3600000
+
+/**
+ * Counters for the cache
+ */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t entries;
+    size_t max_entries;
+    int64_t ttl_ms;
+} EdgeCacheStats;
+
+/**
+ * Enable (or reconfigure, dropping all entries) the cache
+ *
+ * @param max_entries Entry limit; least recently used entries are evicted
+ * @param ttl_ms How long registered credentials are reused
+ * @return 0 on success, -1 on OOM
+ */
+int edge_cache_enable(size_t max_entries, int64_t ttl_ms);
+
+/**
+ * Disable the cache and free its entries (no-op when disabled)
+ */
+void edge_cache_disable(void);
+
+/**
+ * Whether the cache is enabled
+ */
+bool edge_cache_enabled(void);
+
+/**
+ * Build the cache key of a registration
+ *
+ * @return Heap key for edge_cache_lookup / edge_cache_insert, or NULL on OOM
+ */
+char* edge_cache_key(const char* auth_service_address, bool is_public, const char* serialized_access);
+
+/**
+ * Look up live credentials, counting a hit or a miss
+ *
+ * @param out Filled with heap copies of the fields on a hit (caller frees)
+ * @return true on a hit, false on a miss, when disabled, or on OOM
+ */
+bool edge_cache_lookup(const char* key, EdgeCredentials* out);
+
+/**
+ * Cache freshly registered credentials under @p key (copied; no-op when
+ * disabled or out of memory)
+ */
+void edge_cache_insert(const char* key, const EdgeCredentials* credentials);
+
+/**
+ * Read the counters of the cache
+ *
+ * @return 0 on success, -1 when the cache is disabled
+ */
+int edge_cache_stats(EdgeCacheStats* out);
+
+#endif /* UPLINK_EDGE_CACHE_H */
@@ -24,6 +24,22 @@ void register_access_complete(napi_env env, napi_status status, void* data) {
     RegisterAccessData* work_data = (RegisterAccessData*)data;
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "edgeRegisterAccess");
     
+    if (work_data->from_cache) {
+        napi_value creds_obj;
+        napi_create_object(env, &creds_obj);
+        
+        napi_value value;
+        napi_create_string_utf8(env, work_data->cached.access_key_id, NAPI_AUTO_LENGTH, &value);
+        napi_set_named_property(env, creds_obj, "accessKeyId", value);
+        napi_create_string_utf8(env, work_data->cached.secret_key, NAPI_AUTO_LENGTH, &value);
+        napi_set_named_property(env, creds_obj, "secretKey", value);
+        napi_create_string_utf8(env, work_data->cached.endpoint, NAPI_AUTO_LENGTH, &value);
+        napi_set_named_property(env, creds_obj, "endpoint", value);
+        
+        napi_resolve_deferred(env, work_data->deferred, creds_obj);
+        goto cleanup;
+    }
+    
     if (work_data->result.error != NULL) {
         LOG_ERROR("edgeRegisterAccess: failed - %s", work_data->result.error->message);
         napi_value error = create_typed_error(env, work_data->result.error->code, work_data->result.error->message);
@@ -57,6 +73,9 @@ void register_access_complete(napi_env env, napi_status status, void* data) {
     napi_resolve_deferred(env, work_data->deferred, creds_obj);
     
 cleanup:
+    free(work_data->cached.access_key_id);
+    free(work_data->cached.secret_key);
+    free(work_data->cached.endpoint);
     free(work_data->auth_service_address);
     free(work_data->certificate_pem);
     napi_delete_async_work(env, work_data->work);
@@ -80,9 +99,10 @@ void join_share_url_complete(napi_env env, napi_status status, void* data) {
     
     LOG_INFO("edgeJoinShareUrl: created URL=%s", work_data->result.string ? work_data->result.string : "");
     
-    /* Free the string from the result */
+    /* Free the string from the result; uplink-c allocated it, so it
+     * bypasses the native_alloc accounting */
     if (work_data->result.string != NULL) {
-        free(work_data->result.string);
+        (free)(work_data->result.string);
     }
     
     napi_resolve_deferred(env, work_data->deferred, url);
@@ -8,8 +8,10 @@
 
 #include "edge_execute.h"
 #include "edge_types.h"
+#include "edge_cache.h"
 #include "../common/logger.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 /* ========== Execute Functions (Worker Thread) ========== */
@@ -27,10 +29,33 @@ void register_access_execute(napi_env env, void* data) {
     
     UplinkAccess access = { ._handle = work_data->access_handle };
     
+    /* With the cache enabled, the serialized access keys the credentials;
+     * a failed serialize just registers without caching */
+    char* cache_key = NULL;
+    if (edge_cache_enabled()) {
+        UplinkStringResult serialized = uplink_access_serialize(&access);
+        if (serialized.error == NULL) {
+            cache_key = edge_cache_key(work_data->auth_service_address, work_data->is_public, serialized.string);
+        }
+        uplink_free_string_result(serialized);
+        
+        if (cache_key != NULL && edge_cache_lookup(cache_key, &work_data->cached)) {
+            LOG_DEBUG("edgeRegisterAccess: served from cache");
+            work_data->from_cache = true;
+            free(cache_key);
+            return;
+        }
+    }
+    
     EdgeRegisterAccessOptions opts = {0};
     opts.is_public = work_data->is_public;
     
     work_data->result = edge_register_access(config, &access, &opts);
+    
+    if (cache_key != NULL && work_data->result.error == NULL) {
+        edge_cache_insert(cache_key, work_data->result.credentials);
+    }
+    free(cache_key);
 }
 
 void join_share_url_execute(napi_env env, void* data) {
@@ -17,11 +17,14 @@
 #include "edge_types.h"
 #include "edge_execute.h"
 #include "edge_complete.h"
+#include "edge_cache.h"
 #include "../common/handle_helpers.h"
 #include "../common/string_helpers.h"
 #include "../common/type_converters.h"
+#include "../common/error_registry.h"
 #include "../common/logger.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -116,7 +119,15 @@ napi_value napi_edge_register_access(napi_env env, napi_callback_info info) {
 
 /* ========== edgeJoinShareUrl ========== */
 
-napi_value napi_edge_join_share_url(napi_env env, napi_callback_info info) {
+/**
+ * Extract [baseUrl, accessKeyId, bucket?, key?, options?]. Bucket and key
+ * default to "" so every output is set on success.
+ *
+ * @return 0 on success, -1 with a JS exception pending
+ */
+static int extract_join_share_url_args(napi_env env, napi_callback_info info, char** base_url_out,
+                                       char** access_key_id_out, char** bucket_out, char** key_out,
+                                       bool* raw_out) {
     size_t argc = 5;
     napi_value argv[5];
     
@@ -124,20 +135,20 @@ napi_value napi_edge_join_share_url(napi_env env, napi_callback_info info) {
     
     if (argc < 2) {
         napi_throw_type_error(env, NULL, "baseUrl and accessKeyId are required");
-        return NULL;
+        return -1;
     }
     
     /* Extract baseUrl */
     char* base_url = NULL;
     napi_status status = extract_string_required(env, argv[0], "baseUrl", &base_url);
-    if (status != napi_ok) return NULL;
+    if (status != napi_ok) return -1;
     
     /* Extract accessKeyId */
     char* access_key_id = NULL;
     status = extract_string_required(env, argv[1], "accessKeyId", &access_key_id);
     if (status != napi_ok) {
         free(base_url);
-        return NULL;
+        return -1;
     }
     
     /* Extract optional bucket */
@@ -162,8 +173,26 @@ napi_value napi_edge_join_share_url(napi_env env, napi_callback_info info) {
         }
     }
     
+    *base_url_out = base_url;
+    *access_key_id_out = access_key_id;
+    *bucket_out = bucket ? bucket : strdup("");
+    *key_out = key ? key : strdup("");
+    *raw_out = raw;
+    return 0;
+}
+
+napi_value napi_edge_join_share_url(napi_env env, napi_callback_info info) {
+    char* base_url;
+    char* access_key_id;
+    char* bucket;
+    char* key;
+    bool raw;
+    if (extract_join_share_url_args(env, info, &base_url, &access_key_id, &bucket, &key, &raw) != 0) {
+        return NULL;
+    }
+    
     LOG_DEBUG("edgeJoinShareUrl: queuing async work, baseUrl=%s, bucket=%s, key=%s", 
-              base_url, bucket ? bucket : "", key ? key : "");
+              base_url, bucket, key);
     
     JoinShareUrlData* work_data = (JoinShareUrlData*)calloc(1, sizeof(JoinShareUrlData));
     if (work_data == NULL) {
@@ -177,8 +206,8 @@ napi_value napi_edge_join_share_url(napi_env env, napi_callback_info info) {
     
     work_data->base_url = base_url;
     work_data->access_key_id = access_key_id;
-    work_data->bucket = bucket ? bucket : strdup("");
-    work_data->key = key ? key : strdup("");
+    work_data->bucket = bucket;
+    work_data->key = key;
     work_data->raw = raw;
     
     napi_value promise;
@@ -199,3 +228,215 @@ napi_value napi_edge_join_share_url(napi_env env, napi_callback_info info) {
     
     return promise;
 }
+
+/* ========== edgeJoinShareUrlSync ========== */
+
+napi_value napi_edge_join_share_url_sync(napi_env env, napi_callback_info info) {
+    char* base_url;
+    char* access_key_id;
+    char* bucket;
+    char* key;
+    bool raw;
+    if (extract_join_share_url_args(env, info, &base_url, &access_key_id, &bucket, &key, &raw) != 0) {
+        return NULL;
+    }
+    
+    /* String formatting inside uplink-c with no I/O, as for edgeJoinShareUrls */
+    EdgeShareURLOptions options = {0};
+    options.raw = raw;
+    UplinkStringResult result = edge_join_share_url(base_url, access_key_id, bucket, key,
+                                                    raw ? &options : NULL);
+    free(base_url);
+    free(access_key_id);
+    free(bucket);
+    free(key);
+    
+    if (result.error != NULL) {
+        LOG_ERROR("edgeJoinShareUrlSync: failed - %s", result.error->message);
+        napi_value error = create_typed_error(env, result.error->code, result.error->message);
+        uplink_free_error(result.error);
+        napi_throw(env, error);
+        return NULL;
+    }
+    
+    napi_value url;
+    napi_create_string_utf8(env, result.string ? result.string : "", NAPI_AUTO_LENGTH, &url);
+    
+    /* uplink-c allocated the string, so it bypasses native_alloc */
+    if (result.string != NULL) {
+        (free)(result.string);
+    }
+    return url;
+}
+
+/* ========== edgeJoinShareUrls ========== */
+
+napi_value napi_edge_join_share_urls(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 3) {
+        napi_throw_type_error(env, NULL, "baseUrl, accessKeyId and entries are required");
+        return NULL;
+    }
+    
+    bool is_array = false;
+    napi_is_array(env, argv[2], &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "entries must be an array");
+        return NULL;
+    }
+    
+    char* base_url = NULL;
+    napi_status status = extract_string_required(env, argv[0], "baseUrl", &base_url);
+    if (status != napi_ok) return NULL;
+    
+    char* access_key_id = NULL;
+    status = extract_string_required(env, argv[1], "accessKeyId", &access_key_id);
+    if (status != napi_ok) {
+        free(base_url);
+        return NULL;
+    }
+    
+    uint32_t count = 0;
+    napi_get_array_length(env, argv[2], &count);
+    
+    LOG_DEBUG("edgeJoinShareUrls: joining %u URLs, baseUrl=%s", count, base_url);
+    
+    napi_value urls;
+    napi_create_array_with_length(env, count, &urls);
+    
+    /* Joining is string formatting inside uplink-c with no I/O, so the
+     * whole batch runs here instead of paying a promise and a pool
+     * round trip per URL */
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value entry;
+        napi_valuetype type;
+        napi_get_element(env, argv[2], i, &entry);
+        napi_typeof(env, entry, &type);
+        if (type != napi_object) {
+            free(base_url);
+            free(access_key_id);
+            napi_throw_type_error(env, NULL, "entries must contain objects");
+            return NULL;
+        }
+        
+        char* bucket = get_string_property(env, entry, "bucket");
+        char* key = get_string_property(env, entry, "key");
+        
+        EdgeShareURLOptions options = {0};
+        options.raw = (bool)get_bool_property(env, entry, "raw", 0);
+        
+        UplinkStringResult result = edge_join_share_url(
+            base_url,
+            access_key_id,
+            bucket ? bucket : "",
+            key ? key : "",
+            options.raw ? &options : NULL
+        );
+        free(bucket);
+        free(key);
+        
+        if (result.error != NULL) {
+            LOG_ERROR("edgeJoinShareUrls: entry %u failed - %s", i, result.error->message);
+            napi_value error = create_typed_error(env, result.error->code, result.error->message);
+            uplink_free_error(result.error);
+            free(base_url);
+            free(access_key_id);
+            napi_throw(env, error);
+            return NULL;
+        }
+        
+        napi_value url;
+        napi_create_string_utf8(env, result.string ? result.string : "", NAPI_AUTO_LENGTH, &url);
+        napi_set_element(env, urls, i, url);
+        
+        /* uplink-c allocated the string, so it bypasses native_alloc */
+        if (result.string != NULL) {
+            (free)(result.string);
+        }
+    }
+    
+    free(base_url);
+    free(access_key_id);
+    return urls;
+}
+
+/* ========== enableEdgeCache ========== */
+
+napi_value napi_enable_edge_cache(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    int64_t max_entries = EDGE_CACHE_DEFAULT_MAX_ENTRIES;
+    int64_t ttl_ms = EDGE_CACHE_DEFAULT_TTL_MS;
+    if (argc >= 1) {
+        napi_valuetype type;
+        napi_typeof(env, argv[0], &type);
+        if (type == napi_object) {
+            max_entries = get_int64_property(env, argv[0], "maxEntries", EDGE_CACHE_DEFAULT_MAX_ENTRIES);
+            ttl_ms = get_int64_property(env, argv[0], "ttlMs", EDGE_CACHE_DEFAULT_TTL_MS);
+        }
+    }
+    if (max_entries <= 0) {
+        napi_throw_type_error(env, NULL, "maxEntries must be a positive number");
+        return NULL;
+    }
+    if (ttl_ms <= 0) {
+        napi_throw_type_error(env, NULL, "ttlMs must be a positive number");
+        return NULL;
+    }
+    
+    if (edge_cache_enable((size_t)max_entries, ttl_ms) != 0) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== disableEdgeCache ========== */
+
+napi_value napi_disable_edge_cache(napi_env env, napi_callback_info info) {
+    (void)info;
+    edge_cache_disable();
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== edgeCacheStats ========== */
+
+napi_value napi_edge_cache_stats(napi_env env, napi_callback_info info) {
+    (void)info;
+    
+    EdgeCacheStats stats;
+    if (edge_cache_stats(&stats) != 0) {
+        napi_value null_value;
+        napi_get_null(env, &null_value);
+        return null_value;
+    }
+    
+    napi_value result, value;
+    napi_create_object(env, &result);
+    napi_create_double(env, (double)stats.hits, &value);
+    napi_set_named_property(env, result, "hits", value);
+    napi_create_double(env, (double)stats.misses, &value);
+    napi_set_named_property(env, result, "misses", value);
+    napi_create_double(env, (double)stats.evictions, &value);
+    napi_set_named_property(env, result, "evictions", value);
+    napi_create_double(env, (double)stats.entries, &value);
+    napi_set_named_property(env, result, "entries", value);
+    napi_create_double(env, (double)stats.max_entries, &value);
+    napi_set_named_property(env, result, "maxEntries", value);
+    napi_create_double(env, (double)stats.ttl_ms, &value);
+    napi_set_named_property(env, result, "ttlMs", value);
+    return result;
+}
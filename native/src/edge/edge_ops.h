@@ -5,6 +5,10 @@
  * Declares N-API functions for edge/linkshare operations:
  * - napi_edge_register_access - Get S3 credentials from Storj edge services
  * - napi_edge_join_share_url - Create a shareable linkshare URL
+ * - napi_edge_join_share_url_sync - The same, inline on the main thread
+ * - napi_edge_join_share_urls - Create many linkshare URLs in one call
+ * - napi_enable_edge_cache / napi_disable_edge_cache / napi_edge_cache_stats -
+ *   Opt-in cache of registered credentials
  */
 
 #ifndef EDGE_OPS_H
@@ -36,4 +40,47 @@ napi_value napi_edge_register_access(napi_env env, napi_callback_info info);
  */
 napi_value napi_edge_join_share_url(napi_env env, napi_callback_info info);
 
+/**
+ * @brief Create a shareable linkshare URL synchronously
+ * @param env N-API environment
+ * @param info Callback info with the arguments of napi_edge_join_share_url
+ * @return Share URL string; throws the typed errors napi_edge_join_share_url
+ *         rejects with
+ */
+napi_value napi_edge_join_share_url_sync(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Create many shareable linkshare URLs synchronously
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - argv[0]: baseUrl (string) - linkshare service URL
+ *   - argv[1]: accessKeyId (string) - from edge_register_access, must be public
+ *   - argv[2]: entries (array) - { bucket?, key?, raw? } per URL
+ * @return Array of share URL strings in entry order; throws a typed error
+ *         for the first entry that fails
+ */
+napi_value napi_edge_join_share_urls(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Enable (or reconfigure, dropping all entries) the process-wide
+ *        edgeRegisterAccess credential cache
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - argv[0]: options (object, optional) - { maxEntries?, ttlMs? }
+ * @return undefined
+ */
+napi_value napi_enable_edge_cache(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Disable the credential cache and drop its entries
+ * @return undefined
+ */
+napi_value napi_disable_edge_cache(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Read the credential cache counters
+ * @return { hits, misses, evictions, entries, maxEntries, ttlMs }, or null when disabled
+ */
+napi_value napi_edge_cache_stats(napi_env env, napi_callback_info info);
+
 #endif /* EDGE_OPS_H */
@@ -30,6 +30,8 @@ typedef struct {
     size_t access_handle;
     bool is_public;
     EdgeCredentialsResult result;
+    bool from_cache;                /* cached holds heap copies instead of result */
+    EdgeCredentials cached;
     napi_deferred deferred;
     napi_async_work work;
 } RegisterAccessData;
@@ -15,9 +15,12 @@
 #include "../common/handle_helpers.h"
 #include "../common/error_registry.h"
 #include "../common/cancel_helpers.h"
+#include "../common/result_helpers.h"
+#include "../common/key_cache.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 /* ========== Complete Functions (Main Thread) ========== */
 
@@ -33,21 +36,106 @@ void derive_key_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
-    /* Create encryption key handle external */
-    napi_value key_handle = create_handle_external(
-        env, 
-        work_data->result.encryption_key->_handle, 
-        HANDLE_TYPE_ENCRYPTION_KEY, 
-        work_data->result.encryption_key,
-        NULL
-    );
+    /* With the cache on, the key is shared through a cache entry */
+    KeyCacheEntry* entry = work_data->tagged
+        ? key_cache_adopt(env, work_data->tag, work_data->result.encryption_key)
+        : NULL;
+    napi_value key_handle;
+    if (entry != NULL) {
+        key_handle = key_cache_share(env, entry);
+        key_cache_release(entry);
+    } else {
+        /* Create encryption key handle external */
+        key_handle = create_handle_external(
+            env, 
+            work_data->result.encryption_key->_handle, 
+            HANDLE_TYPE_ENCRYPTION_KEY, 
+            work_data->result.encryption_key,
+            NULL
+        );
+    }
     
     LOG_INFO("Encryption key derived successfully");
     napi_resolve_deferred(env, work_data->deferred, key_handle);
     
 cleanup:
+    secure_zero(work_data->passphrase, strlen(work_data->passphrase));
+    secure_zero(work_data->salt, work_data->salt_length);
+    secure_zero(work_data->tag, sizeof(work_data->tag));
     free(work_data->passphrase);
     free(work_data->salt);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
+
+void derive_keys_free_items(DeriveKeysItem* items, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        DeriveKeysItem* item = &items[i];
+        key_cache_release(item->entry);
+        if (item->result.encryption_key != NULL || item->result.error != NULL) {
+            uplink_free_encryption_key_result(item->result);
+        }
+        if (item->passphrase != NULL) {
+            secure_zero(item->passphrase, strlen(item->passphrase));
+            free(item->passphrase);
+        }
+        if (item->salt != NULL) {
+            secure_zero(item->salt, item->salt_length);
+            free(item->salt);
+        }
+    }
+    if (items != NULL) {
+        secure_zero(items, count * sizeof(DeriveKeysItem));
+    }
+    free(items);
+}
+
+void derive_keys_complete(napi_env env, napi_status status, void* data) {
+    DeriveKeysData* work_data = (DeriveKeysData*)data;
+    REJECT_IF_CANCELLED(env, status, work_data->deferred, "deriveEncryptionKeys");
+    
+    /* The first failed derivation rejects the whole call */
+    for (size_t i = 0; i < work_data->item_count; i++) {
+        UplinkError* error = work_data->items[i].result.error;
+        if (error != NULL) {
+            LOG_ERROR("deriveEncryptionKeys failed for item %zu: %s", i, error->message);
+            napi_reject_deferred(env, work_data->deferred, create_typed_error(env, error->code, error->message));
+            goto cleanup;
+        }
+    }
+    
+    napi_value keys;
+    napi_create_array_with_length(env, work_data->item_count, &keys);
+    for (size_t i = 0; i < work_data->item_count; i++) {
+        DeriveKeysItem* item = &work_data->items[i];
+        napi_value key_handle = NULL;
+        
+        if (item->derive && item->tagged) {
+            item->entry = key_cache_adopt(env, item->tag, item->result.encryption_key);
+            if (item->entry == NULL) {
+                napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Out of memory"));
+                goto cleanup;
+            }
+            item->result.encryption_key = NULL;
+        } else if (item->derive) {
+            key_handle = create_handle_external(env, item->result.encryption_key->_handle,
+                                                HANDLE_TYPE_ENCRYPTION_KEY, item->result.encryption_key, NULL);
+            item->result.encryption_key = NULL;
+        }
+        
+        /* Duplicates share the key of their first occurrence */
+        KeyCacheEntry* entry = work_data->items[item->source].entry;
+        if (key_handle == NULL && entry != NULL) {
+            key_handle = key_cache_share(env, entry);
+        }
+        napi_set_element(env, keys, (uint32_t)i, key_handle);
+    }
+    
+    LOG_INFO("deriveEncryptionKeys: %zu keys ready", work_data->item_count);
+    napi_resolve_deferred(env, work_data->deferred, keys);
+    
+cleanup:
+    derive_keys_free_items(work_data->items, work_data->item_count);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
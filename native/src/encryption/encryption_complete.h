@@ -10,10 +10,21 @@
 #define UPLINK_ENCRYPTION_COMPLETE_H
 
 #include <node_api.h>
+#include "encryption_types.h"
 
 /**
  * @brief Complete deriveEncryptionKey on main thread
  */
 void derive_key_complete(napi_env env, napi_status status, void* data);
 
+/**
+ * @brief Complete deriveEncryptionKeys on main thread
+ */
+void derive_keys_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Free the items of a deriveEncryptionKeys call, zeroizing their inputs
+ */
+void derive_keys_free_items(DeriveKeysItem* items, size_t count);
+
 #endif /* UPLINK_ENCRYPTION_COMPLETE_H */
@@ -10,6 +10,8 @@
 #include "encryption_types.h"
 #include "../common/logger.h"
 
+#include <uv.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* ========== Execute Functions (Worker Thread) ========== */
@@ -34,3 +36,68 @@ void derive_key_execute(napi_env env, void* data) {
         LOG_DEBUG("derive_key_execute success: handle=%zu", work_data->result.encryption_key->_handle);
     }
 }
+
+/* ========== derive_keys_execute ========== */
+
+typedef struct {
+    DeriveKeysData* work_data;
+    uv_mutex_t lock;                /* guards next_item */
+    size_t next_item;
+} DeriveKeysState;
+
+static void derive_keys_worker(void* arg) {
+    DeriveKeysState* state = (DeriveKeysState*)arg;
+    DeriveKeysData* work_data = state->work_data;
+    
+    for (;;) {
+        uv_mutex_lock(&state->lock);
+        while (state->next_item < work_data->item_count && !work_data->items[state->next_item].derive) {
+            state->next_item++;
+        }
+        size_t index = state->next_item++;
+        uv_mutex_unlock(&state->lock);
+        if (index >= work_data->item_count) {
+            return;
+        }
+        
+        DeriveKeysItem* item = &work_data->items[index];
+        item->result = uplink_derive_encryption_key(item->passphrase, item->salt, item->salt_length);
+    }
+}
+
+void derive_keys_execute(napi_env env, void* data) {
+    (void)env;
+    DeriveKeysData* work_data = (DeriveKeysData*)data;
+    
+    size_t pending = 0;
+    for (size_t i = 0; i < work_data->item_count; i++) {
+        pending += work_data->items[i].derive ? 1 : 0;
+    }
+    LOG_DEBUG("derive_keys_execute: %zu items, %zu to derive, concurrency=%u",
+              work_data->item_count, pending, work_data->concurrency);
+    
+    DeriveKeysState state;
+    memset(&state, 0, sizeof(state));
+    state.work_data = work_data;
+    uv_mutex_init(&state.lock);
+    
+    /* This job counts once against the bulk lane; its own threads are bounded by concurrency */
+    size_t thread_count = work_data->concurrency < pending ? work_data->concurrency : pending;
+    uv_thread_t* threads = thread_count > 1 ? (uv_thread_t*)calloc(thread_count - 1, sizeof(uv_thread_t)) : NULL;
+    size_t started = 0;
+    if (threads != NULL) {
+        for (size_t i = 0; i + 1 < thread_count; i++) {
+            if (uv_thread_create(&threads[i], derive_keys_worker, &state) != 0) {
+                LOG_WARN("deriveEncryptionKeys: could only start %zu of %zu threads", started + 1, thread_count);
+                break;
+            }
+            started++;
+        }
+    }
+    derive_keys_worker(&state);
+    for (size_t i = 0; i < started; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    free(threads);
+    uv_mutex_destroy(&state.lock);
+}
@@ -15,4 +15,12 @@
  */
 void derive_key_execute(napi_env env, void* data);
 
+/**
+ * @brief Execute deriveEncryptionKeys on worker thread
+ *
+ * Derives the items marked for derivation on up to the call's
+ * concurrency threads, this one included.
+ */
+void derive_keys_execute(napi_env env, void* data);
+
 #endif /* UPLINK_ENCRYPTION_EXECUTE_H */
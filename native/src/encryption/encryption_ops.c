@@ -20,11 +20,59 @@
 #include "../common/string_helpers.h"
 #include "../common/buffer_helpers.h"
 #include "../common/result_helpers.h"
+#include "../common/type_converters.h"
+#include "../common/thread_pool.h"
+#include "../common/key_cache.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+/* ========== helpers ========== */
+
+/**
+ * Copy a passphrase string and salt Buffer for async use.
+ * Throws and returns -1 when either is invalid.
+ */
+static int copy_key_input(napi_env env, napi_value js_passphrase, napi_value js_salt,
+                          char** passphrase_out, void** salt_out, size_t* salt_length_out) {
+    /* Extract passphrase */
+    char* passphrase = NULL;
+    if (extract_string_required(env, js_passphrase, "passphrase", &passphrase) != napi_ok) {
+        return -1;
+    }
+    
+    /* Extract salt buffer */
+    void* salt_data = NULL;
+    size_t salt_length = 0;
+    if (extract_buffer(env, js_salt, &salt_data, &salt_length) != napi_ok) {
+        free(passphrase);
+        throw_type_error(env, "salt must be a Buffer");
+        return -1;
+    }
+    
+    /* Copy salt data (to keep it alive during async execution) */
+    void* salt_copy = malloc(salt_length > 0 ? salt_length : 1);
+    if (salt_copy == NULL) {
+        free(passphrase);
+        throw_error(env, "Out of memory");
+        return -1;
+    }
+    safe_memcpy(salt_copy, salt_length, salt_data, salt_length);
+    
+    *passphrase_out = passphrase;
+    *salt_out = salt_copy;
+    *salt_length_out = salt_length;
+    return 0;
+}
+
+static void free_key_input(char* passphrase, void* salt, size_t salt_length) {
+    secure_zero(passphrase, strlen(passphrase));
+    secure_zero(salt, salt_length);
+    free(passphrase);
+    free(salt);
+}
+
 /* ========== deriveEncryptionKey ========== */
 
 napi_value derive_encryption_key(napi_env env, napi_callback_info info) {
@@ -38,39 +86,42 @@ napi_value derive_encryption_key(napi_env env, napi_callback_info info) {
         return throw_type_error(env, "passphrase and salt are required");
     }
     
-    /* Extract passphrase */
     char* passphrase = NULL;
-    if (extract_string_required(env, argv[0], "passphrase", &passphrase) != napi_ok) {
-        return NULL;
-    }
-    
-    /* Extract salt buffer */
-    void* salt_data = NULL;
+    void* salt_copy = NULL;
     size_t salt_length = 0;
-    if (extract_buffer(env, argv[1], &salt_data, &salt_length) != napi_ok) {
-        free(passphrase);
-        return throw_type_error(env, "salt must be a Buffer");
+    if (copy_key_input(env, argv[0], argv[1], &passphrase, &salt_copy, &salt_length) != 0) {
+        return NULL;
     }
     
-    /* Copy salt data (to keep it alive during async execution) */
-    void* salt_copy = malloc(salt_length);
-    if (salt_copy == NULL) {
-        free(passphrase);
-        return throw_error(env, "Out of memory");
+    /* A cached key skips the worker entirely */
+    uint8_t tag[KEY_CACHE_TAG_SIZE];
+    bool tagged = key_cache_enabled(env) && key_cache_tag(passphrase, salt_copy, salt_length, tag) == 0;
+    if (tagged) {
+        KeyCacheEntry* entry = key_cache_acquire(env, tag);
+        if (entry != NULL) {
+            free_key_input(passphrase, salt_copy, salt_length);
+            secure_zero(tag, sizeof(tag));
+            napi_value key_handle = key_cache_share(env, entry);
+            key_cache_release(entry);
+            return key_handle != NULL ? create_resolved_promise(env, key_handle) : NULL;
+        }
     }
-    safe_memcpy(salt_copy, salt_length, salt_data, salt_length);
     
     /* Allocate work data */
     DeriveKeyData* work_data = (DeriveKeyData*)calloc(1, sizeof(DeriveKeyData));
     if (!work_data) {
-        free(passphrase);
-        free(salt_copy);
+        free_key_input(passphrase, salt_copy, salt_length);
         return throw_error(env, "Out of memory");
     }
     
     work_data->passphrase = passphrase;
     work_data->salt = salt_copy;
     work_data->salt_length = salt_length;
+    if (tagged) {
+        memcpy(work_data->tag, tag, sizeof(tag));
+        secure_zero(tag, sizeof(tag));
+        work_data->tagged = true;
+    }
     
     /* Create promise */
     napi_value promise;
@@ -84,3 +135,212 @@ napi_value derive_encryption_key(napi_env env, napi_callback_info info) {
     
     return promise;
 }
+
+/* ========== deriveEncryptionKeys ========== */
+
+/**
+ * Read options.concurrency, clamped to DERIVE_KEYS_MAX_CONCURRENCY.
+ * Throws a TypeError and returns -1 when it is not a positive integer.
+ */
+static int get_derive_concurrency(napi_env env, napi_value options, uint32_t* out) {
+    int64_t concurrency = DERIVE_KEYS_DEFAULT_CONCURRENCY;
+    napi_valuetype type = napi_undefined;
+    if (options != NULL) {
+        napi_typeof(env, options, &type);
+    }
+    if (type == napi_object) {
+        concurrency = get_int64_property(env, options, "concurrency", DERIVE_KEYS_DEFAULT_CONCURRENCY);
+    }
+    if (concurrency < 1) {
+        napi_throw_type_error(env, NULL, "concurrency must be a positive integer");
+        return -1;
+    }
+    *out = concurrency > DERIVE_KEYS_MAX_CONCURRENCY ? DERIVE_KEYS_MAX_CONCURRENCY : (uint32_t)concurrency;
+    return 0;
+}
+
+/**
+ * Index of the first item with the tag of items[@p index], or @p index
+ * when it is the first, recorded in the open-addressing @p table
+ * (entries are index + 1, 0 = empty; size @p mask + 1).
+ */
+static size_t first_with_tag(size_t* table, size_t mask, const DeriveKeysItem* items, size_t index) {
+    uint64_t hash;
+    memcpy(&hash, items[index].tag, sizeof(hash));
+    for (size_t slot = (size_t)hash & mask;; slot = (slot + 1) & mask) {
+        if (table[slot] == 0) {
+            table[slot] = index + 1;
+            return index;
+        }
+        if (memcmp(items[table[slot] - 1].tag, items[index].tag, KEY_CACHE_TAG_SIZE) == 0) {
+            return table[slot] - 1;
+        }
+    }
+}
+
+napi_value derive_encryption_keys(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2] = { NULL, NULL };
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    bool is_array = false;
+    if (argc >= 1) {
+        napi_is_array(env, argv[0], &is_array);
+    }
+    if (!is_array) {
+        return throw_type_error(env, "items must be an array of { passphrase, salt }");
+    }
+    
+    uint32_t concurrency;
+    if (get_derive_concurrency(env, argc > 1 ? argv[1] : NULL, &concurrency) != 0) {
+        return NULL;
+    }
+    
+    uint32_t count = 0;
+    napi_get_array_length(env, argv[0], &count);
+    DeriveKeysData* work_data = (DeriveKeysData*)calloc(1, sizeof(DeriveKeysData));
+    DeriveKeysItem* items = (DeriveKeysItem*)calloc(count > 0 ? count : 1, sizeof(DeriveKeysItem));
+    if (work_data == NULL || items == NULL) {
+        free(work_data);
+        free(items);
+        return throw_error(env, "Out of memory");
+    }
+    
+    /* Lookups are only worth it with the cache on; the table stays at most half full */
+    size_t table_mask = 15;
+    while (table_mask + 1 < (size_t)count * 2) {
+        table_mask = (table_mask << 1) | 1;
+    }
+    size_t* tag_table = key_cache_enabled(env) ? (size_t*)calloc(table_mask + 1, sizeof(size_t)) : NULL;
+    size_t pending = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        DeriveKeysItem* item = &items[i];
+        napi_value element, js_passphrase, js_salt;
+        napi_valuetype type = napi_undefined;
+        napi_get_element(env, argv[0], i, &element);
+        napi_typeof(env, element, &type);
+        if (type != napi_object) {
+            derive_keys_free_items(items, i);
+            free(tag_table);
+            free(work_data);
+            return throw_type_error(env, "items must be an array of { passphrase, salt }");
+        }
+        napi_get_named_property(env, element, "passphrase", &js_passphrase);
+        napi_get_named_property(env, element, "salt", &js_salt);
+        if (copy_key_input(env, js_passphrase, js_salt, &item->passphrase, &item->salt, &item->salt_length) != 0) {
+            derive_keys_free_items(items, i);
+            free(tag_table);
+            free(work_data);
+            return NULL;
+        }
+        
+        /* Served from the cache, or by an earlier item of this call */
+        item->source = i;
+        item->tagged = tag_table != NULL &&
+                       key_cache_tag(item->passphrase, item->salt, item->salt_length, item->tag) == 0;
+        if (item->tagged) {
+            item->source = first_with_tag(tag_table, table_mask, items, i);
+            if (item->source == i) {
+                item->entry = key_cache_acquire(env, item->tag);
+            }
+        }
+        item->derive = item->source == i && item->entry == NULL;
+        pending += item->derive ? 1 : 0;
+    }
+    free(tag_table);
+    
+    work_data->items = items;
+    work_data->item_count = count;
+    work_data->concurrency = concurrency;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    LOG_DEBUG("deriveEncryptionKeys: %u items, %zu to derive", count, pending);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "deriveEncryptionKeys", NAPI_AUTO_LENGTH, &work_name);
+    thread_pool_queue_work(env, THREAD_POOL_LANE_BULK, work_name,
+        derive_keys_execute, derive_keys_complete,
+        work_data, &work_data->work);
+    return promise;
+}
+
+/* ========== enableEncryptionKeyCache ========== */
+
+napi_value enable_encryption_key_cache(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    int64_t max_entries = KEY_CACHE_DEFAULT_MAX_ENTRIES;
+    int64_t ttl_ms = KEY_CACHE_DEFAULT_TTL_MS;
+    if (argc >= 1) {
+        napi_valuetype type;
+        napi_typeof(env, argv[0], &type);
+        if (type == napi_object) {
+            max_entries = get_int64_property(env, argv[0], "maxEntries", KEY_CACHE_DEFAULT_MAX_ENTRIES);
+            ttl_ms = get_int64_property(env, argv[0], "ttlMs", KEY_CACHE_DEFAULT_TTL_MS);
+        }
+    }
+    if (max_entries <= 0) {
+        napi_throw_type_error(env, NULL, "maxEntries must be a positive number");
+        return NULL;
+    }
+    if (ttl_ms < 0) {
+        napi_throw_type_error(env, NULL, "ttlMs must not be negative");
+        return NULL;
+    }
+    
+    if (key_cache_enable(env, (size_t)max_entries, (uint64_t)ttl_ms) != 0) {
+        napi_throw_error(env, NULL, "Failed to enable the encryption key cache");
+        return NULL;
+    }
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== disableEncryptionKeyCache ========== */
+
+napi_value disable_encryption_key_cache(napi_env env, napi_callback_info info) {
+    (void)info;
+    key_cache_disable(env);
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== encryptionKeyCacheStats ========== */
+
+napi_value get_encryption_key_cache_stats(napi_env env, napi_callback_info info) {
+    (void)info;
+    
+    KeyCacheStats stats;
+    if (key_cache_stats(env, &stats) != 0) {
+        napi_value null_value;
+        napi_get_null(env, &null_value);
+        return null_value;
+    }
+    
+    napi_value result, value;
+    napi_create_object(env, &result);
+    napi_create_double(env, (double)stats.hits, &value);
+    napi_set_named_property(env, result, "hits", value);
+    napi_create_double(env, (double)stats.misses, &value);
+    napi_set_named_property(env, result, "misses", value);
+    napi_create_double(env, (double)stats.evictions, &value);
+    napi_set_named_property(env, result, "evictions", value);
+    napi_create_double(env, (double)stats.expirations, &value);
+    napi_set_named_property(env, result, "expirations", value);
+    napi_create_double(env, (double)stats.entries, &value);
+    napi_set_named_property(env, result, "entries", value);
+    napi_create_double(env, (double)stats.max_entries, &value);
+    napi_set_named_property(env, result, "maxEntries", value);
+    napi_create_double(env, (double)stats.ttl_ms, &value);
+    napi_set_named_property(env, result, "ttlMs", value);
+    return result;
+}
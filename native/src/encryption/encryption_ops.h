@@ -4,6 +4,8 @@
  * 
  * Declares N-API bindings for uplink-c encryption operations:
  * - derive_encryption_key: Derive key from passphrase and salt
+ * - derive_encryption_keys: Derive many keys in one call
+ * - enable/disable_encryption_key_cache, get_encryption_key_cache_stats
  */
 
 #ifndef ENCRYPTION_OPS_H
@@ -23,4 +25,42 @@
  */
 napi_value derive_encryption_key(napi_env env, napi_callback_info info);
 
+/**
+ * Derive several encryption keys on up to options.concurrency threads
+ * 
+ * Pairs found in the key cache, and repeats of a pair within the call
+ * when the cache is enabled, are not derived again.
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: items (Array<{ passphrase: string, salt: Buffer }>)
+ *   - arg[1]: options ({ concurrency?: number }, optional)
+ * @returns Promise<external[]> - key handles in item order
+ */
+napi_value derive_encryption_keys(napi_env env, napi_callback_info info);
+
+/**
+ * Enable the derived key cache of this environment
+ * 
+ * @param env N-API environment
+ * @param info Callback info containing:
+ *   - arg[0]: options ({ maxEntries?: number, ttlMs?: number }, optional)
+ * @returns undefined
+ */
+napi_value enable_encryption_key_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Disable the derived key cache, dropping its entries
+ * 
+ * @returns undefined
+ */
+napi_value disable_encryption_key_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Get the derived key cache counters
+ * 
+ * @returns { hits, misses, evictions, expirations, entries, maxEntries, ttlMs }, or null when disabled
+ */
+napi_value get_encryption_key_cache_stats(napi_env env, napi_callback_info info);
+
 #endif /* ENCRYPTION_OPS_H */
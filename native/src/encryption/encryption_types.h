@@ -11,11 +11,20 @@
 #define UPLINK_ENCRYPTION_TYPES_H
 
 #include <node_api.h>
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /* Disable compat macros to avoid function name conflicts */
 #define UPLINK_DISABLE_NAMESPACE_COMPAT
 #include "uplink.h"
+#include "../common/key_cache.h"
+
+/** Default number of keys deriveEncryptionKeys derives at once */
+#define DERIVE_KEYS_DEFAULT_CONCURRENCY 4
+
+/** Upper bound accepted for deriveEncryptionKeys concurrency */
+#define DERIVE_KEYS_MAX_CONCURRENCY 16
 
 /* ========== Async Work Data Structures ========== */
 
@@ -26,9 +35,37 @@ typedef struct {
     char* passphrase;
     void* salt;
     size_t salt_length;
+    uint8_t tag[KEY_CACHE_TAG_SIZE];
+    bool tagged;                    /* tag is set: adopt the key into the cache */
     UplinkEncryptionKeyResult result;
     napi_deferred deferred;
     napi_async_work work;
 } DeriveKeyData;
 
+/**
+ * @brief One passphrase/salt pair of deriveEncryptionKeys
+ */
+typedef struct {
+    char* passphrase;
+    void* salt;
+    size_t salt_length;
+    uint8_t tag[KEY_CACHE_TAG_SIZE];
+    bool tagged;
+    size_t source;                  /* index of the first item with the same tag, else its own */
+    KeyCacheEntry* entry;           /* cache hit, or the adopted key after derivation */
+    bool derive;                    /* derived by the worker */
+    UplinkEncryptionKeyResult result;
+} DeriveKeysItem;
+
+/**
+ * @brief Data for deriveEncryptionKeys async operation
+ */
+typedef struct {
+    DeriveKeysItem* items;
+    size_t item_count;
+    uint32_t concurrency;
+    napi_deferred deferred;
+    napi_async_work work;
+} DeriveKeysData;
+
 #endif /* UPLINK_ENCRYPTION_TYPES_H */
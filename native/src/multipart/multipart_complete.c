@@ -10,10 +10,14 @@
 #include "multipart_complete.h"
 #include "multipart_types.h"
 #include "../common/handle_helpers.h"
+#include "../common/buffer_helpers.h"
+#include "../common/admission.h"
+#include "../common/work_pool.h"
 #include "../common/result_helpers.h"
 #include "../common/error_registry.h"
 #include "../common/cancel_helpers.h"
 #include "../common/object_converter.h"
+#include "../common/stat_cache.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
@@ -27,33 +31,33 @@ static napi_value upload_info_to_js(napi_env env, UplinkUploadInfo* info) {
         napi_get_undefined(env, &undefined);
         return undefined;
     }
-
+    
     napi_value obj;
     napi_create_object(env, &obj);
-
+    
     /* uploadId */
     napi_value upload_id;
     napi_create_string_utf8(env, info->upload_id ? info->upload_id : "", NAPI_AUTO_LENGTH, &upload_id);
     napi_set_named_property(env, obj, "uploadId", upload_id);
-
+    
     /* key */
     napi_value key;
     napi_create_string_utf8(env, info->key ? info->key : "", NAPI_AUTO_LENGTH, &key);
     napi_set_named_property(env, obj, "key", key);
-
+    
     /* isPrefix */
     napi_value is_prefix;
     napi_get_boolean(env, info->is_prefix, &is_prefix);
     napi_set_named_property(env, obj, "isPrefix", is_prefix);
-
+    
     /* system metadata */
     napi_value system;
     napi_create_object(env, &system);
-
+    
     napi_value created;
     napi_create_int64(env, info->system.created, &created);
     napi_set_named_property(env, system, "created", created);
-
+    
     if (info->system.expires != 0) {
         napi_value expires;
         napi_create_int64(env, info->system.expires, &expires);
@@ -63,17 +67,17 @@ static napi_value upload_info_to_js(napi_env env, UplinkUploadInfo* info) {
         napi_get_null(env, &null_val);
         napi_set_named_property(env, system, "expires", null_val);
     }
-
+    
     napi_value content_length;
     napi_create_int64(env, info->system.content_length, &content_length);
     napi_set_named_property(env, system, "contentLength", content_length);
-
+    
     napi_set_named_property(env, obj, "system", system);
-
+    
     /* custom metadata */
     napi_value custom;
     napi_create_object(env, &custom);
-
+    
     if (info->custom.count > 0 && info->custom.entries != NULL) {
         for (size_t i = 0; i < info->custom.count; i++) {
             napi_value value;
@@ -82,9 +86,9 @@ static napi_value upload_info_to_js(napi_env env, UplinkUploadInfo* info) {
             napi_set_named_property(env, custom, info->custom.entries[i].key, value);
         }
     }
-
+    
     napi_set_named_property(env, obj, "custom", custom);
-
+    
     return obj;
 }
 
@@ -96,25 +100,25 @@ static napi_value part_to_js(napi_env env, UplinkPart* part) {
         napi_get_undefined(env, &undefined);
         return undefined;
     }
-
+    
     napi_value obj;
     napi_create_object(env, &obj);
-
+    
     /* partNumber */
     napi_value part_number;
     napi_create_uint32(env, part->part_number, &part_number);
     napi_set_named_property(env, obj, "partNumber", part_number);
-
+    
     /* size */
     napi_value size;
     napi_create_int64(env, (int64_t)part->size, &size);
     napi_set_named_property(env, obj, "size", size);
-
+    
     /* modified */
     napi_value modified;
     napi_create_int64(env, part->modified, &modified);
     napi_set_named_property(env, obj, "modified", modified);
-
+    
     /* etag */
     napi_value etag;
     if (part->etag != NULL && part->etag_length > 0) {
@@ -123,7 +127,7 @@ static napi_value part_to_js(napi_env env, UplinkPart* part) {
         napi_create_string_utf8(env, "", 0, &etag);
     }
     napi_set_named_property(env, obj, "etag", etag);
-
+    
     return obj;
 }
 
@@ -162,6 +166,7 @@ cleanup:
 void commit_upload_complete(napi_env env, napi_status status, void* data) {
     CommitUploadData* work_data = (CommitUploadData*)data;
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "commitUpload");
+    stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->object_key);
     
     if (work_data->result.error != NULL) {
         LOG_ERROR("commitUpload: failed - %s", work_data->result.error->message);
@@ -184,14 +189,7 @@ cleanup:
     free(work_data->object_key);
     free(work_data->upload_id);
     
-    /* Free metadata entries */
-    if (work_data->metadata_entries != NULL) {
-        for (size_t i = 0; i < work_data->metadata_count; i++) {
-            free(work_data->metadata_entries[i].key);
-            free(work_data->metadata_entries[i].value);
-        }
-        free(work_data->metadata_entries);
-    }
+    free_metadata_entries(work_data->metadata_entries, work_data->metadata_count);
     
     napi_delete_async_work(env, work_data->work);
     free(work_data);
@@ -243,6 +241,12 @@ void upload_part_complete(napi_env env, napi_status status, void* data) {
     /* Create handle for part upload */
     size_t handle = work_data->result.part_upload->_handle;
     napi_value handle_obj = create_handle_external(env, handle, HANDLE_TYPE_PART_UPLOAD, work_data->result.part_upload, NULL);
+    if (handle_obj != NULL) {
+        /* The transfer slot stays taken until the part is committed or aborted */
+        HandleWrapper* wrapper = get_handle_wrapper(env, handle_obj, HANDLE_TYPE_PART_UPLOAD);
+        wrapper->admission = admission_keep(work_data->admission);
+        wrapper->project_handle = work_data->project_handle;
+    }
     
     LOG_INFO("uploadPart: part %u started for '%s/%s', handle=%zu", 
              work_data->part_number, work_data->bucket_name, work_data->object_key, handle);
@@ -264,9 +268,7 @@ void part_upload_write_complete(napi_env env, napi_status status, void* data) {
     PartUploadWriteData* work_data = (PartUploadWriteData*)data;
     
     /* Release buffer reference */
-    if (work_data->buffer_ref != NULL) {
-        napi_delete_reference(env, work_data->buffer_ref);
-    }
+    unpin_buffer(env, work_data->buffer_ref, work_data->length);
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "partUploadWrite");
     
     if (work_data->result.error != NULL) {
@@ -284,14 +286,14 @@ void part_upload_write_complete(napi_env env, napi_status status, void* data) {
     napi_resolve_deferred(env, work_data->deferred, bytes_written);
     
 cleanup:
-    napi_delete_async_work(env, work_data->work);
-    free(work_data);
+    work_pool_free(work_data);
 }
 
 /* ========== part_upload_commit_complete ========== */
 
 void part_upload_commit_complete(napi_env env, napi_status status, void* data) {
     PartUploadOpData* work_data = (PartUploadOpData*)data;
+    admission_release(work_data->admission);
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "partUploadCommit");
     
     if (work_data->error != NULL) {
@@ -317,6 +319,7 @@ cleanup:
 
 void part_upload_abort_complete(napi_env env, napi_status status, void* data) {
     PartUploadOpData* work_data = (PartUploadOpData*)data;
+    admission_release(work_data->admission);
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "partUploadAbort");
     
     if (work_data->error != NULL) {
@@ -628,3 +631,183 @@ cleanup:
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
+
+/* ========== collect_upload_parts_complete ========== */
+
+void collect_upload_parts_complete(napi_env env, napi_status status, void* data) {
+    CollectUploadPartsData* work_data = (CollectUploadPartsData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "collectUploadParts", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("collectUploadParts: failed - %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    {
+        /* Convert straight from the iterator's items, no intermediate copy */
+        napi_value array;
+        napi_create_array_with_length(env, work_data->count, &array);
+        for (size_t i = 0; i < work_data->count; i++) {
+            napi_set_element(env, array, (uint32_t)i, part_to_js(env, work_data->parts[i]));
+        }
+        
+        LOG_DEBUG("collectUploadParts: returned %zu parts", work_data->count);
+        napi_resolve_deferred(env, work_data->deferred, array);
+    }
+    
+cleanup:
+    free(work_data->parts);
+    if (work_data->iterator != NULL) {
+        uplink_free_part_iterator(work_data->iterator);
+    }
+    free(work_data->bucket_name);
+    free(work_data->object_key);
+    free(work_data->upload_id);
+    free(work_data->error_message);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== collect_uploads_complete ========== */
+
+void collect_uploads_complete(napi_env env, napi_status status, void* data) {
+    CollectUploadsData* work_data = (CollectUploadsData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "collectUploads", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("collectUploads: failed - %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    {
+        /* Convert straight from the iterator's items, no intermediate copy */
+        napi_value array;
+        napi_create_array_with_length(env, work_data->count, &array);
+        for (size_t i = 0; i < work_data->count; i++) {
+            napi_set_element(env, array, (uint32_t)i, upload_info_to_js(env, work_data->uploads[i]));
+        }
+        
+        LOG_DEBUG("collectUploads: returned %zu uploads", work_data->count);
+        napi_resolve_deferred(env, work_data->deferred, array);
+    }
+    
+cleanup:
+    free(work_data->uploads);
+    if (work_data->iterator != NULL) {
+        uplink_free_upload_iterator(work_data->iterator);
+    }
+    free(work_data->bucket_name);
+    free(work_data->prefix);
+    free(work_data->cursor);
+    free(work_data->error_message);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== upload_parallel_complete ========== */
+
+void upload_parallel_complete(napi_env env, napi_status status, void* data) {
+    UploadParallelData* work_data = (UploadParallelData*)data;
+    
+    /* Release source buffer reference */
+    unpin_buffer(env, work_data->buffer_ref, work_data->buffer_length);
+    progress_reporter_release(env, work_data->progress);
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "uploadParallel", work_data->cancel);
+    stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->object_key);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("uploadParallel: failed - %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    if (work_data->result.error != NULL) {
+        LOG_ERROR("uploadParallel: commit failed - %s", work_data->result.error->message);
+        napi_value error = create_typed_error(env, work_data->result.error->code, work_data->result.error->message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        uplink_free_commit_upload_result(work_data->result);
+        goto cleanup;
+    }
+    
+    napi_value obj = uplink_object_to_js(env, work_data->result.object);
+    if (work_data->auto_tune) {
+        napi_value tuning;
+        napi_value value;
+        napi_create_object(env, &tuning);
+        napi_create_int64(env, (int64_t)work_data->tuned_part_size, &value);
+        napi_set_named_property(env, tuning, "partSize", value);
+        napi_create_uint32(env, work_data->tuned_concurrency, &value);
+        napi_set_named_property(env, tuning, "concurrency", value);
+        napi_create_double(env, work_data->tuned_goodput, &value);
+        napi_set_named_property(env, tuning, "bytesPerSecond", value);
+        napi_set_named_property(env, obj, "tuning", tuning);
+    }
+    
+    LOG_INFO("uploadParallel: committed '%s/%s' in %u parts (%u resumed)",
+             work_data->bucket_name, work_data->object_key, work_data->part_count, work_data->resumed_parts);
+    
+    uplink_free_commit_upload_result(work_data->result);
+    napi_resolve_deferred(env, work_data->deferred, obj);
+    
+cleanup:
+    free(work_data->bucket_name);
+    free(work_data->object_key);
+    free(work_data->file_path);
+    free(work_data->upload_id);
+    free(work_data->error_message);
+    free_metadata_entries(work_data->metadata_entries, work_data->metadata_count);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== upload_part_from_file_complete ========== */
+
+void upload_part_from_file_complete(napi_env env, napi_status status, void* data) {
+    UploadPartFromFileData* work_data = (UploadPartFromFileData*)data;
+    
+    progress_reporter_release(env, work_data->progress);
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "uploadPartFromFile", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("uploadPartFromFile: part %u failed - %s", work_data->part_number,
+                  work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    if (work_data->result.error != NULL) {
+        LOG_ERROR("uploadPartFromFile: part info failed - %s", work_data->result.error->message);
+        napi_value error = create_typed_error(env, work_data->result.error->code, work_data->result.error->message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        uplink_free_part_result(work_data->result);
+        goto cleanup;
+    }
+    
+    napi_value part_obj = part_to_js(env, work_data->result.part);
+    
+    LOG_INFO("uploadPartFromFile: committed part %u (%llu bytes)",
+             work_data->part_number, (unsigned long long)work_data->length);
+    
+    uplink_free_part_result(work_data->result);
+    napi_resolve_deferred(env, work_data->deferred, part_obj);
+    
+cleanup:
+    free(work_data->bucket_name);
+    free(work_data->object_key);
+    free(work_data->upload_id);
+    free(work_data->file_path);
+    free(work_data->etag);
+    free(work_data->error_message);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
@@ -74,4 +74,24 @@ void upload_iterator_item_complete(napi_env env, napi_status status, void* data)
 void upload_iterator_err_complete(napi_env env, napi_status status, void* data);
 void free_upload_iterator_complete(napi_env env, napi_status status, void* data);
 
+/**
+ * @brief Complete collect_upload_parts on main thread
+ */
+void collect_upload_parts_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Complete collect_uploads on main thread
+ */
+void collect_uploads_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Complete upload_parallel on main thread
+ */
+void upload_parallel_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Complete upload_part_from_file on main thread
+ */
+void upload_part_from_file_complete(napi_env env, napi_status status, void* data);
+
 #endif /* MULTIPART_COMPLETE_H */
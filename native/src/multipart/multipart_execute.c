@@ -8,9 +8,17 @@
 
 #include "multipart_execute.h"
 #include "multipart_types.h"
+#include "../common/bandwidth.h"
 #include "../common/buffer_helpers.h"
+#include "../common/file_helpers.h"
+#include "../common/part_tuner.h"
+#include "../common/result_helpers.h"
+#include "../common/retry.h"
 #include "../common/logger.h"
 
+#include <uv.h>
+#include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -98,7 +106,29 @@ void part_upload_write_execute(napi_env env, void* data) {
     LOG_DEBUG("partUploadWrite: writing %zu bytes (worker thread)", work_data->length);
     
     UplinkPartUpload part_upload = { ._handle = work_data->part_upload_handle };
-    work_data->result = uplink_part_upload_write(&part_upload, work_data->buffer, work_data->length);
+    
+    /* One write, as before, unless a bandwidth limit splits it into grants */
+    size_t written = 0;
+    while (written < work_data->length) {
+        size_t grant = bandwidth_acquire(work_data->bandwidth_project, BANDWIDTH_UPLOAD,
+                                         work_data->length - written, NULL);
+        UplinkWriteResult result = uplink_part_upload_write(&part_upload, (uint8_t*)work_data->buffer + written, grant);
+        bandwidth_refund(work_data->bandwidth_project, BANDWIDTH_UPLOAD, grant - result.bytes_written);
+        written += result.bytes_written;
+        if (result.error == NULL && result.bytes_written == 0) {
+            /* No progress is an error, not a short count resolved to JS */
+            result.error = (UplinkError*)calloc(1, sizeof(UplinkError));
+            if (result.error != NULL) {
+                result.error->code = UPLINK_ERROR_INTERNAL;
+                result.error->message = strdup("part upload write made no progress");
+            }
+        }
+        if (result.error != NULL || result.bytes_written == 0) {
+            work_data->result.error = result.error;
+            break;
+        }
+    }
+    work_data->result.bytes_written = written;
 }
 
 /* ========== part_upload_commit_execute ========== */
@@ -309,23 +339,23 @@ void upload_iterator_item_execute(napi_env env, void* data) {
         work_data->upload_info = NULL;
         return;
     }
-
+    
     /* Deep copy since iterator items are only valid until next iteration */
     work_data->upload_info = (UplinkUploadInfo*)calloc(1, sizeof(UplinkUploadInfo));
     if (work_data->upload_info == NULL) {
         return;
     }
-
+    
     work_data->upload_info->is_prefix = upload->is_prefix;
     work_data->upload_info->system = upload->system;
-
+    
     if (upload->upload_id != NULL) {
         work_data->upload_info->upload_id = strdup(upload->upload_id);
     }
     if (upload->key != NULL) {
         work_data->upload_info->key = strdup(upload->key);
     }
-
+    
     deep_copy_upload_custom_metadata(&work_data->upload_info->custom, &upload->custom);
 }
 
@@ -348,3 +378,697 @@ void free_upload_iterator_execute(napi_env env, void* data) {
     UplinkUploadIterator* iterator = (UplinkUploadIterator*)work_data->iterator_handle;
     uplink_free_upload_iterator(iterator);
 }
+
+/* ========== collect execute ========== */
+
+/**
+ * Append @p item to a growable pointer array.
+ * @return false when the array could not grow
+ */
+static bool collect_push(void*** items, size_t* count, size_t* capacity, void* item) {
+    if (*count == *capacity) {
+        size_t grown = *capacity ? *capacity * 2 : 64;
+        void** resized = (void**)realloc(*items, grown * sizeof(void*));
+        if (resized == NULL) {
+            return false;
+        }
+        *items = resized;
+        *capacity = grown;
+    }
+    (*items)[(*count)++] = item;
+    return true;
+}
+
+void collect_upload_parts_execute(napi_env env, void* data) {
+    (void)env;
+    CollectUploadPartsData* work_data = (CollectUploadPartsData*)data;
+    
+    if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        return;
+    }
+    
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkListUploadPartsOptions opts = {0};
+    opts.cursor = work_data->cursor;
+    
+    work_data->iterator = uplink_list_upload_parts(&project, work_data->bucket_name,
+                                                   work_data->object_key, work_data->upload_id, &opts);
+    if (work_data->iterator == NULL) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("Failed to create part iterator");
+        return;
+    }
+    
+    size_t capacity = 0;
+    while ((work_data->max_items == 0 || work_data->count < work_data->max_items) &&
+           uplink_part_iterator_next(work_data->iterator)) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+            return;
+        }
+        UplinkPart* part = uplink_part_iterator_item(work_data->iterator);
+        if (part != NULL && !collect_push((void***)&work_data->parts, &work_data->count, &capacity, part)) {
+            work_data->error_code = UPLINK_ERROR_INTERNAL;
+            work_data->error_message = strdup("Out of memory");
+            return;
+        }
+    }
+    
+    UplinkError* error = uplink_part_iterator_err(work_data->iterator);
+    if (error != NULL) {
+        work_data->error_code = error->code;
+        work_data->error_message = strdup(error->message ? error->message : "listUploadParts failed");
+        uplink_free_error(error);
+    }
+    
+    LOG_DEBUG("collectUploadParts: collected %zu parts (worker thread)", work_data->count);
+}
+
+void collect_uploads_execute(napi_env env, void* data) {
+    (void)env;
+    CollectUploadsData* work_data = (CollectUploadsData*)data;
+    
+    if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        return;
+    }
+    
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkListUploadsOptions opts = {0};
+    opts.prefix = work_data->prefix;
+    opts.cursor = work_data->cursor;
+    opts.recursive = work_data->recursive;
+    opts.system = work_data->include_system;
+    opts.custom = work_data->include_custom;
+    
+    work_data->iterator = uplink_list_uploads(&project, work_data->bucket_name, &opts);
+    if (work_data->iterator == NULL) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("Failed to create upload iterator");
+        return;
+    }
+    
+    size_t capacity = 0;
+    while ((work_data->max_items == 0 || work_data->count < work_data->max_items) &&
+           uplink_upload_iterator_next(work_data->iterator)) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+            return;
+        }
+        UplinkUploadInfo* upload = uplink_upload_iterator_item(work_data->iterator);
+        if (upload != NULL && !collect_push((void***)&work_data->uploads, &work_data->count, &capacity, upload)) {
+            work_data->error_code = UPLINK_ERROR_INTERNAL;
+            work_data->error_message = strdup("Out of memory");
+            return;
+        }
+    }
+    
+    UplinkError* error = uplink_upload_iterator_err(work_data->iterator);
+    if (error != NULL) {
+        work_data->error_code = error->code;
+        work_data->error_message = strdup(error->message ? error->message : "listUploads failed");
+        uplink_free_error(error);
+    }
+    
+    LOG_DEBUG("collectUploads: collected %zu uploads (worker thread)", work_data->count);
+}
+
+/* ========== uploadParallel execute ========== */
+
+/** Read granularity for file sources, bounds memory to concurrency * chunk */
+#define PARALLEL_UPLOAD_READ_CHUNK (1024 * 1024)
+
+/** Base delay before retrying a failed part, doubled per attempt */
+#define PARALLEL_UPLOAD_RETRY_BASE_MS 100
+
+/**
+ * Shared state for the native part workers of one uploadParallel call.
+ * Workers claim part indices under the lock until all parts are done
+ * or one part has failed permanently.
+ */
+typedef struct {
+    UploadParallelData* job;
+    UplinkProject project;
+    char* upload_id;
+    uint64_t total_size;
+    uint8_t* committed;         /* Per-part flags from the resume manifest, or NULL */
+    PartTuner* tuner;           /* Sizes and paces parts when auto_tune, else NULL */
+    uv_mutex_t lock;
+    uint32_t next_part;
+    uint64_t next_offset;       /* First byte not yet claimed (auto_tune only) */
+    bool failed;
+} ParallelUploadState;
+
+/**
+ * Failure of a single part attempt, copied out of the uplink error
+ * so the error itself can be freed at the point of failure.
+ */
+typedef struct {
+    int32_t code;
+    char message[256];
+} ParallelPartFailure;
+
+static void parallel_part_failure_set(ParallelPartFailure* failure, UplinkError* error, const char* message) {
+    failure->code = error != NULL ? error->code : UPLINK_ERROR_INTERNAL;
+    const char* text = error != NULL && error->message != NULL ? error->message : message;
+    snprintf(failure->message, sizeof(failure->message), "%s", text != NULL ? text : "unknown error");
+    if (error != NULL) {
+        uplink_free_error(error);
+    }
+}
+
+/**
+ * Record the first permanent failure; later failures are dropped.
+ */
+static void parallel_upload_fail(ParallelUploadState* state, const ParallelPartFailure* failure) {
+    uv_mutex_lock(&state->lock);
+    if (!state->failed) {
+        state->failed = true;
+        state->job->error_code = failure->code;
+        state->job->error_message = strdup(failure->message);
+    }
+    uv_mutex_unlock(&state->lock);
+}
+
+/**
+ * Write bytes [offset, offset + length) of a source into an open part:
+ * the mapped file range when @p use_mmap maps, else @p fd read through
+ * @p chunk, or @p buffer when @p fd is negative. Each write is drawn
+ * from the bandwidth limits of @p project_handle.
+ * @return true when every byte was written; @p out_done receives the
+ *         bytes written either way
+ */
+static bool part_write_range(UplinkPartUpload* part, int fd, bool use_mmap, uint8_t* chunk,
+                             const uint8_t* buffer, uint64_t offset, uint64_t length,
+                             size_t project_handle, CancelToken* cancel, ProgressReporter* progress,
+                             ParallelPartFailure* failure, uint64_t* out_done) {
+    bool ok = true;
+    uint64_t done = 0;
+    
+    /* mmap mode: hand the mapped part straight to uplink; on failure read instead */
+    FileMapping mapping = {0};
+    if (fd >= 0 && use_mmap && length > 0 &&
+        file_map_range(fd, (int64_t)offset, (size_t)length, &mapping) != 0) {
+        LOG_DEBUG("part upload: mmap unavailable at offset %llu, using buffered reads",
+                  (unsigned long long)offset);
+    }
+    
+    while (ok && done < length) {
+        if (cancel_token_is_cancelled(cancel)) {
+            parallel_part_failure_set(failure, NULL, cancel_token_message(cancel));
+            failure->code = cancel_token_code(cancel);
+            ok = false;
+            break;
+        }
+        uint8_t* data;
+        size_t n;
+        if (mapping.data != NULL) {
+            data = (uint8_t*)mapping.data + done;
+            n = progress_slice(progress, cancel_token_slice(cancel, (size_t)(length - done)));
+        } else if (fd >= 0) {
+            size_t want = (size_t)(length - done < PARALLEL_UPLOAD_READ_CHUNK ? length - done : PARALLEL_UPLOAD_READ_CHUNK);
+            int64_t got = file_read_at(fd, chunk, want, (int64_t)(offset + done));
+            if (got <= 0) {
+                parallel_part_failure_set(failure, NULL, got < 0 ? strerror(errno) : "file shrank during upload");
+                ok = false;
+                break;
+            }
+            data = chunk;
+            n = (size_t)got;
+        } else {
+            data = (uint8_t*)buffer + offset + done;
+            n = progress_slice(progress, cancel_token_slice(cancel, (size_t)(length - done)));
+        }
+        
+        size_t written = 0;
+        while (written < n) {
+            size_t grant = bandwidth_acquire(project_handle, BANDWIDTH_UPLOAD, n - written, cancel);
+            if (grant == 0) {
+                parallel_part_failure_set(failure, NULL, cancel_token_message(cancel));
+                failure->code = cancel_token_code(cancel);
+                ok = false;
+                break;
+            }
+            UplinkWriteResult write_result = uplink_part_upload_write(part, data + written, grant);
+            bandwidth_refund(project_handle, BANDWIDTH_UPLOAD, grant - write_result.bytes_written);
+            if (write_result.error != NULL) {
+                parallel_part_failure_set(failure, write_result.error, NULL);
+                ok = false;
+                break;
+            }
+            if (write_result.bytes_written == 0) {
+                parallel_part_failure_set(failure, NULL, "part upload accepted no bytes");
+                ok = false;
+                break;
+            }
+            written += write_result.bytes_written;
+        }
+        done += written;
+        progress_add(progress, (int64_t)written);
+    }
+    file_unmap(&mapping);
+    
+    *out_done = done;
+    return ok;
+}
+
+/**
+ * Upload one part from the job source.
+ * @return true on success, false with @p failure filled in otherwise
+ */
+static bool parallel_upload_part(ParallelUploadState* state, uint32_t part_number, int fd, uint8_t* chunk,
+                                 uint64_t offset, uint64_t length, ParallelPartFailure* failure) {
+    UploadParallelData* job = state->job;
+    
+    UplinkPartUploadResult part_result = uplink_upload_part(&state->project, job->bucket_name,
+                                                            job->object_key, state->upload_id, part_number);
+    if (part_result.error != NULL) {
+        parallel_part_failure_set(failure, part_result.error, NULL);
+        part_result.error = NULL;
+        uplink_free_part_upload_result(part_result);
+        return false;
+    }
+    
+    UplinkPartUpload* part = part_result.part_upload;
+    uint64_t done = 0;
+    bool ok = part_write_range(part, fd, job->use_mmap, chunk, (const uint8_t*)job->buffer_ptr,
+                               offset, length, job->project_handle, job->cancel, job->progress, failure, &done);
+    
+    if (ok) {
+        UplinkError* error = uplink_part_upload_commit(part);
+        if (error != NULL) {
+            parallel_part_failure_set(failure, error, NULL);
+            ok = false;
+        }
+    } else {
+        uplink_free_error(uplink_part_upload_abort(part));
+    }
+    if (!ok) {
+        /* A retry writes the part again from its start */
+        progress_add(job->progress, -(int64_t)done);
+    }
+    
+    uplink_free_part_upload_result(part_result);
+    return ok;
+}
+
+/** Bytes in part @p index (0-based); only the last part may be short. */
+static uint64_t parallel_part_length(const ParallelUploadState* state, uint32_t index) {
+    uint64_t remaining = state->total_size - (uint64_t)index * state->job->part_size;
+    return remaining < state->job->part_size ? remaining : state->job->part_size;
+}
+
+/**
+ * Build the resume manifest: walk the committed parts of the pending
+ * upload and flag every part whose number and size match the layout
+ * the source would be split into. Mismatched parts are sent again.
+ * @return true on success, false with the job error set otherwise
+ */
+static bool parallel_upload_load_manifest(ParallelUploadState* state) {
+    UploadParallelData* job = state->job;
+    
+    state->committed = (uint8_t*)calloc(job->part_count, sizeof(uint8_t));
+    if (state->committed == NULL) {
+        job->error_code = UPLINK_ERROR_INTERNAL;
+        job->error_message = strdup("Out of memory");
+        return false;
+    }
+    
+    UplinkPartIterator* iterator = uplink_list_upload_parts(&state->project, job->bucket_name,
+                                                            job->object_key, state->upload_id, NULL);
+    if (iterator == NULL) {
+        job->error_code = UPLINK_ERROR_INTERNAL;
+        job->error_message = strdup("listUploadParts failed");
+        return false;
+    }
+    
+    uint64_t resumed_bytes = 0;
+    while (uplink_part_iterator_next(iterator)) {
+        const UplinkPart* part = uplink_part_iterator_item(iterator);
+        if (part == NULL || part->part_number < 1 || part->part_number > job->part_count) {
+            continue;
+        }
+        uint32_t index = part->part_number - 1;
+        if (!state->committed[index] && (uint64_t)part->size == parallel_part_length(state, index)) {
+            state->committed[index] = 1;
+            job->resumed_parts++;
+            resumed_bytes += (uint64_t)part->size;
+        }
+    }
+    
+    UplinkError* error = uplink_part_iterator_err(iterator);
+    uplink_free_part_iterator(iterator);
+    if (error != NULL) {
+        job->error_code = error->code;
+        job->error_message = strdup(error->message ? error->message : "listUploadParts failed");
+        uplink_free_error(error);
+        return false;
+    }
+    
+    progress_add(job->progress, (int64_t)resumed_bytes);
+    LOG_DEBUG("uploadParallel: resuming '%s' with %u of %u parts already committed",
+              state->upload_id, job->resumed_parts, job->part_count);
+    return true;
+}
+
+/**
+ * Claim the next part to upload. Fixed layouts hand out part indices,
+ * skipping parts the resume manifest has; auto_tune layouts cut the next
+ * @p size_hint bytes, grown when needed to stay within the part limit.
+ * @return false when no part is left or the upload has failed
+ */
+static bool parallel_upload_claim(ParallelUploadState* state, uint64_t size_hint, uint32_t* part_number,
+                                  uint64_t* offset, uint64_t* length) {
+    UploadParallelData* job = state->job;
+    bool claimed = false;
+    
+    uv_mutex_lock(&state->lock);
+    if (state->failed) {
+        /* Nothing more to do */
+    } else if (state->tuner == NULL) {
+        while (!claimed && state->next_part < job->part_count) {
+            uint32_t index = state->next_part++;
+            if (state->committed == NULL || !state->committed[index]) {
+                *part_number = index + 1;
+                *offset = (uint64_t)index * job->part_size;
+                *length = parallel_part_length(state, index);
+                claimed = true;
+            }
+        }
+    } else if (state->next_offset < state->total_size || state->next_part == 0) {
+        uint64_t remaining = state->total_size - state->next_offset;
+        uint64_t parts_left = PARALLEL_UPLOAD_MAX_PARTS - state->next_part;
+        uint64_t floor = (remaining + parts_left - 1) / parts_left;
+        uint64_t size = size_hint > floor ? size_hint : floor;
+        *part_number = ++state->next_part;
+        *offset = state->next_offset;
+        *length = remaining < size ? remaining : size;
+        state->next_offset += *length;
+        claimed = true;
+    }
+    uv_mutex_unlock(&state->lock);
+    return claimed;
+}
+
+/**
+ * Native part worker: claims part indices until none remain.
+ */
+static void parallel_upload_worker(void* arg) {
+    ParallelUploadState* state = (ParallelUploadState*)arg;
+    UploadParallelData* job = state->job;
+    ParallelPartFailure failure;
+    int fd = -1;
+    uint8_t* chunk = NULL;
+    
+    if (job->file_path != NULL) {
+        fd = file_open_read(job->file_path);
+        chunk = (uint8_t*)malloc(PARALLEL_UPLOAD_READ_CHUNK);
+        if (fd < 0 || chunk == NULL) {
+            parallel_part_failure_set(&failure, NULL, fd < 0 ? strerror(errno) : "Out of memory");
+            parallel_upload_fail(state, &failure);
+            file_close(fd);
+            free(chunk);
+            return;
+        }
+    }
+    
+    for (;;) {
+        uint64_t size_hint = state->tuner != NULL ? part_tuner_acquire(state->tuner) : job->part_size;
+        uint32_t part_number;
+        uint64_t offset;
+        uint64_t length;
+        if (!parallel_upload_claim(state, size_hint, &part_number, &offset, &length)) {
+            part_tuner_finish(state->tuner, 0, 0);
+            break;
+        }
+        
+        uint64_t started_at = uv_hrtime();
+        bool ok = false;
+        for (uint32_t attempt = 0; attempt <= job->max_retries; attempt++) {
+            if (attempt > 0) {
+                if (cancel_token_is_cancelled(job->cancel)) {
+                    break;
+                }
+                LOG_WARN("uploadParallel: retrying part %u (attempt %u/%u) after: %s",
+                         part_number, attempt + 1, job->max_retries + 1, failure.message);
+                uv_sleep(PARALLEL_UPLOAD_RETRY_BASE_MS << (attempt < 6 ? attempt - 1 : 5));
+            }
+            ok = parallel_upload_part(state, part_number, fd, chunk, offset, length, &failure);
+            if (ok || state->failed) {
+                break;
+            }
+        }
+        part_tuner_finish(state->tuner, ok ? length : 0, uv_hrtime() - started_at);
+        
+        if (!ok) {
+            LOG_ERROR("uploadParallel: part %u failed permanently: %s", part_number, failure.message);
+            parallel_upload_fail(state, &failure);
+            break;
+        }
+        LOG_DEBUG("uploadParallel: part %u committed (%llu bytes)", part_number, (unsigned long long)length);
+    }
+    
+    file_close(fd);
+    free(chunk);
+}
+
+void upload_parallel_execute(napi_env env, void* data) {
+    (void)env;
+    UploadParallelData* work_data = (UploadParallelData*)data;
+    
+    ParallelUploadState state;
+    memset(&state, 0, sizeof(state));
+    state.job = work_data;
+    state.project._handle = work_data->project_handle;
+    
+    /* Determine source size */
+    if (work_data->file_path != NULL) {
+        int fd = file_open_read(work_data->file_path);
+        int64_t size = fd >= 0 ? file_size(fd) : -1;
+        file_close(fd);
+        if (size < 0) {
+            work_data->error_code = UPLINK_ERROR_INTERNAL;
+            work_data->error_message = strdup(strerror(errno));
+            return;
+        }
+        state.total_size = (uint64_t)size;
+    } else {
+        state.total_size = work_data->buffer_length;
+    }
+    
+    /* With auto_tune parts are cut as they are claimed; plan for the smallest size */
+    uint64_t plan_size = work_data->auto_tune ? PART_TUNER_MIN_SIZE : work_data->part_size;
+    uint64_t parts = (state.total_size + plan_size - 1) / plan_size;
+    if (parts == 0) {
+        parts = 1;  /* Empty objects still need one (empty) part */
+    }
+    if (work_data->auto_tune && parts > PARALLEL_UPLOAD_MAX_PARTS) {
+        parts = PARALLEL_UPLOAD_MAX_PARTS;
+    } else if (parts > PARALLEL_UPLOAD_MAX_PARTS) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("partSize too small: upload would exceed 10000 parts");
+        return;
+    }
+    work_data->part_count = (uint32_t)parts;
+    progress_set_total(work_data->progress, state.total_size);
+    
+    LOG_DEBUG("uploadParallel: '%s/%s' %llu bytes in %u parts, concurrency=%u (worker thread)",
+              work_data->bucket_name, work_data->object_key,
+              (unsigned long long)state.total_size, work_data->part_count, work_data->concurrency);
+    
+    if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        return;
+    }
+    
+    if (work_data->upload_id != NULL) {
+        /* Resume: reuse the pending upload and skip its committed parts */
+        state.upload_id = strdup(work_data->upload_id);
+        if (state.upload_id == NULL) {
+            work_data->error_code = UPLINK_ERROR_INTERNAL;
+            work_data->error_message = strdup("Out of memory");
+            return;
+        }
+        if (!parallel_upload_load_manifest(&state)) {
+            free(state.committed);
+            free(state.upload_id);
+            return;
+        }
+    } else {
+        /* Begin the multipart upload */
+        UplinkUploadOptions* options = NULL;
+        UplinkUploadOptions opts = {0};
+        if (work_data->expires > 0) {
+            opts.expires = work_data->expires;
+            options = &opts;
+        }
+        
+        UplinkUploadInfoResult begin = uplink_begin_upload(&state.project, work_data->bucket_name,
+                                                           work_data->object_key, options);
+        if (begin.error != NULL) {
+            work_data->error_code = begin.error->code;
+            work_data->error_message = strdup(begin.error->message ? begin.error->message : "beginUpload failed");
+            uplink_free_upload_info_result(begin);
+            return;
+        }
+        state.upload_id = strdup(begin.info->upload_id);
+        uplink_free_upload_info_result(begin);
+        if (state.upload_id == NULL) {
+            work_data->error_code = UPLINK_ERROR_INTERNAL;
+            work_data->error_message = strdup("Out of memory");
+            return;
+        }
+    }
+    
+    /* Run part workers on native threads */
+    uv_mutex_init(&state.lock);
+    
+    PartTuner tuner;
+    if (work_data->auto_tune) {
+        if (part_tuner_init(&tuner, work_data->part_size, work_data->concurrency) != 0) {
+            uv_mutex_destroy(&state.lock);
+            uplink_free_error(uplink_abort_upload(&state.project, work_data->bucket_name,
+                                                  work_data->object_key, state.upload_id));
+            work_data->error_code = UPLINK_ERROR_INTERNAL;
+            work_data->error_message = strdup("Failed to start the part tuner");
+            free(state.upload_id);
+            return;
+        }
+        state.tuner = &tuner;
+    }
+    
+    uint32_t thread_count = work_data->concurrency < work_data->part_count
+                            ? work_data->concurrency : work_data->part_count;
+    uv_thread_t* threads = (uv_thread_t*)calloc(thread_count, sizeof(uv_thread_t));
+    uint32_t started = 0;
+    if (threads != NULL) {
+        for (uint32_t i = 0; i < thread_count; i++) {
+            if (uv_thread_create(&threads[i], parallel_upload_worker, &state) != 0) {
+                LOG_WARN("uploadParallel: could only start %u of %u threads", started, thread_count);
+                break;
+            }
+            started++;
+        }
+    }
+    if (started == 0) {
+        parallel_upload_worker(&state);  /* Degrade to sequential on this thread */
+    }
+    for (uint32_t i = 0; i < started; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    free(threads);
+    uv_mutex_destroy(&state.lock);
+    
+    if (state.tuner != NULL) {
+        work_data->part_count = state.next_part;
+        part_tuner_result(state.tuner, &work_data->tuned_part_size, &work_data->tuned_concurrency,
+                          &work_data->tuned_goodput);
+        part_tuner_destroy(state.tuner);
+        LOG_DEBUG("uploadParallel: tuned to partSize=%llu, concurrency=%u",
+                  (unsigned long long)work_data->tuned_part_size, work_data->tuned_concurrency);
+    }
+    
+    /* Commit, or abort on failure; a resumed upload stays pending so it can be resumed again */
+    if (state.failed && work_data->upload_id == NULL) {
+        uplink_free_error(uplink_abort_upload(&state.project, work_data->bucket_name,
+                                              work_data->object_key, state.upload_id));
+    } else if (state.failed) {
+        LOG_WARN("uploadParallel: leaving upload '%s' pending for a later resume", state.upload_id);
+    } else {
+        UplinkCommitUploadOptions* commit_options = NULL;
+        UplinkCommitUploadOptions commit_opts = {0};
+        if (work_data->metadata_count > 0) {
+            commit_opts.custom_metadata.entries = work_data->metadata_entries;
+            commit_opts.custom_metadata.count = work_data->metadata_count;
+            commit_options = &commit_opts;
+        }
+        work_data->result = uplink_commit_upload(&state.project, work_data->bucket_name,
+                                                 work_data->object_key, state.upload_id, commit_options);
+    }
+    
+    free(state.committed);
+    free(state.upload_id);
+}
+
+/* ========== upload_part_from_file execute ========== */
+
+void upload_part_from_file_execute(napi_env env, void* data) {
+    (void)env;
+    UploadPartFromFileData* work_data = (UploadPartFromFileData*)data;
+    ParallelPartFailure failure = {0};
+    
+    LOG_DEBUG("uploadPartFromFile: part %u from '%s' [%llu, +%llu) (worker thread)",
+              work_data->part_number, work_data->file_path,
+              (unsigned long long)work_data->offset, (unsigned long long)work_data->length);
+    
+    if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        return;
+    }
+    
+    int fd = file_open_read(work_data->file_path);
+    int64_t size = fd >= 0 ? file_size(fd) : -1;
+    if (size < 0) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup(strerror(errno));
+        file_close(fd);
+        return;
+    }
+    if (work_data->offset > (uint64_t)size || work_data->length > (uint64_t)size - work_data->offset) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("offset and length exceed the file size");
+        file_close(fd);
+        return;
+    }
+    
+    size_t chunk_size = work_data->length < PARALLEL_UPLOAD_READ_CHUNK
+                        ? (size_t)work_data->length : PARALLEL_UPLOAD_READ_CHUNK;
+    uint8_t* chunk = (uint8_t*)malloc(chunk_size > 0 ? chunk_size : 1);
+    if (chunk == NULL) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("Out of memory");
+        file_close(fd);
+        return;
+    }
+    progress_set_total(work_data->progress, work_data->length);
+    
+    UplinkProject project = { ._handle = work_data->project_handle };
+    bool ok = false;
+    for (uint32_t attempt = 1;; attempt++) {
+        UplinkPartUploadResult part_result = uplink_upload_part(&project, work_data->bucket_name,
+                                                                work_data->object_key, work_data->upload_id,
+                                                                work_data->part_number);
+        uint64_t done = 0;
+        ok = part_result.error == NULL;
+        if (!ok) {
+            parallel_part_failure_set(&failure, part_result.error, NULL);
+            part_result.error = NULL;
+        } else {
+            UplinkPartUpload* part = part_result.part_upload;
+            ok = part_write_range(part, fd, work_data->use_mmap, chunk, NULL, work_data->offset, work_data->length,
+                                  work_data->project_handle, work_data->cancel, work_data->progress, &failure, &done);
+            UplinkError* error = NULL;
+            if (ok && work_data->etag != NULL && (error = uplink_part_upload_set_etag(part, work_data->etag)) != NULL) {
+                parallel_part_failure_set(&failure, error, NULL);
+                ok = false;
+            }
+            if (ok && (error = uplink_part_upload_commit(part)) != NULL) {
+                parallel_part_failure_set(&failure, error, NULL);
+                ok = false;
+            }
+            if (ok) {
+                work_data->result = uplink_part_upload_info(part);
+            } else {
+                uplink_free_error(uplink_part_upload_abort(part));
+            }
+        }
+        uplink_free_part_upload_result(part_result);
+        if (ok || !retry_backoff(&work_data->retry, attempt, failure.code, work_data->cancel, "uploadPartFromFile")) {
+            break;
+        }
+        /* A retry writes the part again from its start */
+        progress_add(work_data->progress, -(int64_t)done);
+    }
+    file_close(fd);
+    free(chunk);
+    
+    if (!ok) {
+        work_data->error_code = failure.code;
+        work_data->error_message = strdup(failure.message);
+    }
+}
@@ -75,4 +75,24 @@ void upload_iterator_item_execute(napi_env env, void* data);
 void upload_iterator_err_execute(napi_env env, void* data);
 void free_upload_iterator_execute(napi_env env, void* data);
 
+/**
+ * @brief Execute collect_upload_parts on worker thread (drain part iterator)
+ */
+void collect_upload_parts_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute collect_uploads on worker thread (drain upload iterator)
+ */
+void collect_uploads_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute upload_parallel on worker thread (spawns part threads)
+ */
+void upload_parallel_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute upload_part_from_file on worker thread (part, writes, ETag, commit)
+ */
+void upload_part_from_file_execute(napi_env env, void* data);
+
 #endif /* MULTIPART_EXECUTE_H */
@@ -19,8 +19,14 @@
 #include "multipart_complete.h"
 #include "../common/handle_helpers.h"
 #include "../common/string_helpers.h"
+#include "../common/buffer_helpers.h"
+#include "../common/work_pool.h"
 #include "../common/type_converters.h"
 #include "../common/object_converter.h"
+#include "../common/thread_pool.h"
+#include "../common/admission.h"
+#include "../common/part_tuner.h"
+#include "../common/retry.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
@@ -93,16 +99,14 @@ napi_value begin_upload(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "beginUpload", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         begin_upload_execute,
         begin_upload_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -207,16 +211,14 @@ napi_value commit_upload(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "commitUpload", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         commit_upload_execute,
         commit_upload_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -285,16 +287,14 @@ napi_value abort_upload(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "abortUpload", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         abort_upload_execute,
         abort_upload_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -378,16 +378,14 @@ napi_value upload_part(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "uploadPart", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_TRANSFER, THREAD_POOL_LANE_METADATA, work_name,
         upload_part_execute,
         upload_part_complete,
         work_data,
-        &work_data->work
+        &work_data->work, &work_data->admission
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -442,34 +440,25 @@ napi_value part_upload_write(napi_env env, napi_callback_info info) {
     
     LOG_DEBUG("partUploadWrite: queuing async work to write %lld bytes", (long long)length);
     
-    PartUploadWriteData* work_data = (PartUploadWriteData*)calloc(1, sizeof(PartUploadWriteData));
+    PartUploadWriteData* work_data = (PartUploadWriteData*)work_pool_calloc(1, sizeof(PartUploadWriteData));
     if (work_data == NULL) {
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
     }
     
     work_data->part_upload_handle = part_upload_handle;
+    work_data->bandwidth_project = get_handle_project(env, argv[0], HANDLE_TYPE_PART_UPLOAD);
     work_data->buffer = buffer;
     work_data->length = (size_t)length;
     
     /* Keep buffer alive during async operation */
-    napi_create_reference(env, argv[1], 1, &work_data->buffer_ref);
+    pin_buffer(env, argv[1], work_data->length, &work_data->buffer_ref);
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
     
-    napi_value work_name;
-    napi_create_string_utf8(env, "partUploadWrite", NAPI_AUTO_LENGTH, &work_name);
-    
-    napi_create_async_work(
-        env, NULL, work_name,
-        part_upload_write_execute,
-        part_upload_write_complete,
-        work_data,
-        &work_data->work
-    );
-    
-    napi_queue_async_work(env, work_data->work);
+    thread_pool_queue_job(env, THREAD_POOL_LANE_BULK, "partUploadWrite",
+                          part_upload_write_execute, part_upload_write_complete, work_data);
     
     return promise;
 }
@@ -494,6 +483,7 @@ napi_value part_upload_commit(napi_env env, napi_callback_info info) {
         napi_throw_type_error(env, NULL, "Invalid part upload handle");
         return NULL;
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_PART_UPLOAD);
     
     LOG_DEBUG("partUploadCommit: queuing async work");
     
@@ -504,6 +494,7 @@ napi_value part_upload_commit(napi_env env, napi_callback_info info) {
     }
     
     work_data->part_upload_handle = part_upload_handle;
+    work_data->admission = take_handle_admission(env, argv[0], HANDLE_TYPE_PART_UPLOAD);
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
@@ -511,16 +502,14 @@ napi_value part_upload_commit(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "partUploadCommit", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_BULK, work_name,
         part_upload_commit_execute,
         part_upload_commit_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -544,6 +533,7 @@ napi_value part_upload_abort(napi_env env, napi_callback_info info) {
         napi_throw_type_error(env, NULL, "Invalid part upload handle");
         return NULL;
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_PART_UPLOAD);
     
     LOG_DEBUG("partUploadAbort: queuing async work");
     
@@ -554,6 +544,7 @@ napi_value part_upload_abort(napi_env env, napi_callback_info info) {
     }
     
     work_data->part_upload_handle = part_upload_handle;
+    work_data->admission = take_handle_admission(env, argv[0], HANDLE_TYPE_PART_UPLOAD);
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
@@ -561,16 +552,14 @@ napi_value part_upload_abort(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "partUploadAbort", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         part_upload_abort_execute,
         part_upload_abort_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -620,16 +609,14 @@ napi_value part_upload_set_etag(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "partUploadSetEtag", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         part_upload_set_etag_execute,
         part_upload_set_etag_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -670,16 +657,14 @@ napi_value part_upload_info(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "partUploadInfo", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         part_upload_info_execute,
         part_upload_info_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -759,16 +744,14 @@ napi_value list_upload_parts_create(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "listUploadPartsCreate", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         list_upload_parts_create_execute,
         list_upload_parts_create_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -806,16 +789,14 @@ napi_value part_iterator_next(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "partIteratorNext", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         part_iterator_next_execute,
         part_iterator_next_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -853,16 +834,14 @@ napi_value part_iterator_item(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "partIteratorItem", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         part_iterator_item_execute,
         part_iterator_item_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -900,16 +879,14 @@ napi_value part_iterator_err(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "partIteratorErr", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         part_iterator_err_execute,
         part_iterator_err_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -932,6 +909,7 @@ napi_value free_part_iterator(napi_env env, napi_callback_info info) {
         napi_throw_type_error(env, NULL, "Invalid part iterator handle");
         return NULL;
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_PART_ITERATOR);
     
     FreePartIteratorData* work_data = (FreePartIteratorData*)calloc(1, sizeof(FreePartIteratorData));
     if (work_data == NULL) {
@@ -947,16 +925,14 @@ napi_value free_part_iterator(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "freePartIterator", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         free_part_iterator_execute,
         free_part_iterator_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -1030,16 +1006,14 @@ napi_value list_uploads_create(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "listUploadsCreate", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         list_uploads_create_execute,
         list_uploads_create_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -1077,16 +1051,14 @@ napi_value upload_iterator_next(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "uploadIteratorNext", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         upload_iterator_next_execute,
         upload_iterator_next_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -1124,16 +1096,14 @@ napi_value upload_iterator_item(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "uploadIteratorItem", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         upload_iterator_item_execute,
         upload_iterator_item_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -1171,16 +1141,14 @@ napi_value upload_iterator_err(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "uploadIteratorErr", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         upload_iterator_err_execute,
         upload_iterator_err_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -1203,6 +1171,7 @@ napi_value free_upload_iterator(napi_env env, napi_callback_info info) {
         napi_throw_type_error(env, NULL, "Invalid upload iterator handle");
         return NULL;
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_UPLOAD_ITERATOR);
     
     FreeUploadIteratorData* work_data = (FreeUploadIteratorData*)calloc(1, sizeof(FreeUploadIteratorData));
     if (work_data == NULL) {
@@ -1218,15 +1187,537 @@ napi_value free_upload_iterator(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "freeUploadIterator", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         free_upload_iterator_execute,
         free_upload_iterator_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
+    return promise;
+}
+
+/* ========== collect_upload_parts ========== */
+
+napi_value collect_upload_parts(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 4) {
+        napi_throw_type_error(env, NULL, "projectHandle, bucket, key, and uploadId are required");
+        return NULL;
+    }
+    
+    /* Extract project handle */
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    /* Extract optional cursor and cap */
+    uint32_t cursor = 0;
+    int64_t max_items = 0;
+    if (argc >= 5) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            cursor = (uint32_t)get_int64_property(env, argv[4], "cursor", 0);
+            max_items = get_int64_property(env, argv[4], "maxItems", 0);
+            if (max_items < 0) {
+                napi_throw_range_error(env, NULL, "maxItems must not be negative");
+                return NULL;
+            }
+        }
+    }
+    
+    /* Extract strings */
+    char* bucket_name = NULL;
+    char* object_key = NULL;
+    char* upload_id = NULL;
+    
+    if (extract_string_required(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "key", &object_key) != napi_ok ||
+        extract_string_required(env, argv[3], "uploadId", &upload_id) != napi_ok) {
+        free(bucket_name);
+        free(object_key);
+        free(upload_id);
+        return NULL;
+    }
+    
+    LOG_DEBUG("collectUploadParts: queuing async work for '%s/%s' uploadId='%s'",
+              bucket_name, object_key, upload_id);
+    
+    CollectUploadPartsData* work_data = (CollectUploadPartsData*)calloc(1, sizeof(CollectUploadPartsData));
+    if (work_data == NULL) {
+        free(bucket_name);
+        free(object_key);
+        free(upload_id);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->bucket_name = bucket_name;
+    work_data->object_key = object_key;
+    work_data->upload_id = upload_id;
+    work_data->cursor = cursor;
+    work_data->max_items = (size_t)max_items;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "collectUploadParts", NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_METADATA);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
+        collect_upload_parts_execute,
+        collect_upload_parts_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== collect_uploads ========== */
+
+napi_value collect_uploads(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "projectHandle and bucket are required");
+        return NULL;
+    }
+    
+    /* Extract project handle */
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    /* Extract optional options */
+    int64_t max_items = 0;
+    bool has_options = false;
+    if (argc >= 3) {
+        napi_valuetype type;
+        napi_typeof(env, argv[2], &type);
+        if (type == napi_object) {
+            has_options = true;
+            max_items = get_int64_property(env, argv[2], "maxItems", 0);
+            if (max_items < 0) {
+                napi_throw_range_error(env, NULL, "maxItems must not be negative");
+                return NULL;
+            }
+        }
+    }
+    
+    /* Extract bucket name */
+    char* bucket_name = NULL;
+    status = extract_string_required(env, argv[1], "bucket", &bucket_name);
+    if (status != napi_ok) return NULL;
+    
+    LOG_DEBUG("collectUploads: queuing async work for '%s'", bucket_name);
+    
+    CollectUploadsData* work_data = (CollectUploadsData*)calloc(1, sizeof(CollectUploadsData));
+    if (work_data == NULL) {
+        free(bucket_name);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->bucket_name = bucket_name;
+    work_data->include_system = true;
+    work_data->max_items = (size_t)max_items;
+    if (has_options) {
+        work_data->prefix = get_string_property(env, argv[2], "prefix");
+        work_data->cursor = get_string_property(env, argv[2], "cursor");
+        work_data->recursive = get_bool_property(env, argv[2], "recursive", 0);
+        work_data->include_system = get_bool_property(env, argv[2], "system", 1);
+        work_data->include_custom = get_bool_property(env, argv[2], "custom", 0);
+    }
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "collectUploads", NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, argc > 2 ? argv[2] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 2 ? argv[2] : NULL, THREAD_POOL_LANE_METADATA);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
+        collect_uploads_execute,
+        collect_uploads_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== upload_parallel ========== */
+
+/**
+ * Parse (projectHandle, bucket, key, source, options?) and queue the
+ * parallel engine. Takes ownership of @p upload_id (NULL to begin a new
+ * upload) on every path.
+ */
+static napi_value queue_upload_parallel(napi_env env, size_t argc, napi_value* argv,
+                                        char* upload_id, const char* name) {
+    /* Extract project handle */
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        free(upload_id);
+        return NULL;
+    }
+    
+    /* Source is either a Buffer or a file path */
+    void* buffer_data = NULL;
+    size_t buffer_length = 0;
+    bool is_path = false;
+    napi_valuetype source_type;
+    napi_typeof(env, argv[3], &source_type);
+    if (source_type == napi_string) {
+        is_path = true;
+    } else if (extract_buffer(env, argv[3], &buffer_data, &buffer_length) != napi_ok) {
+        napi_throw_type_error(env, NULL, "source must be a Buffer or a file path");
+        free(upload_id);
+        return NULL;
+    }
+    
+    /* Extract optional options */
+    int64_t part_size = PARALLEL_UPLOAD_DEFAULT_PART_SIZE;
+    int64_t concurrency = PARALLEL_UPLOAD_DEFAULT_CONCURRENCY;
+    int64_t retries = PARALLEL_UPLOAD_DEFAULT_RETRIES;
+    int64_t expires = 0;
+    bool use_mmap = false;
+    bool auto_tune = false;
+    UplinkCustomMetadataEntry* metadata_entries = NULL;
+    size_t metadata_count = 0;
+    
+    if (argc >= 5) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            if (has_defined_property(env, argv[4], "compress")) {
+                napi_throw_type_error(env, NULL, "compress is only supported by uploadObject()");
+                free(upload_id);
+                return NULL;
+            }
+            /* A resumed upload keeps the fixed layout its manifest is matched against */
+            auto_tune = upload_id == NULL && get_bool_property(env, argv[4], "auto", 0) != 0;
+            part_size = get_int64_property(env, argv[4], "partSize", PARALLEL_UPLOAD_DEFAULT_PART_SIZE);
+            concurrency = get_int64_property(env, argv[4], "concurrency",
+                                             auto_tune ? PART_TUNER_DEFAULT_MAX_ACTIVE : PARALLEL_UPLOAD_DEFAULT_CONCURRENCY);
+            retries = get_int64_property(env, argv[4], "retries", PARALLEL_UPLOAD_DEFAULT_RETRIES);
+            expires = get_date_property(env, argv[4], "expires", 0);
+            use_mmap = get_bool_property(env, argv[4], "mmap", 0) != 0;
+            
+            if (part_size <= 0) {
+                napi_throw_range_error(env, NULL, "partSize must be a positive number");
+                free(upload_id);
+                return NULL;
+            }
+            if (concurrency < 1 || concurrency > 256) {
+                napi_throw_range_error(env, NULL, "concurrency must be between 1 and 256");
+                free(upload_id);
+                return NULL;
+            }
+            if (retries < 0 || retries > 100) {
+                napi_throw_range_error(env, NULL, "retries must be between 0 and 100");
+                free(upload_id);
+                return NULL;
+            }
+            
+            napi_value custom_metadata_val;
+            if (napi_get_named_property(env, argv[4], "customMetadata", &custom_metadata_val) == napi_ok) {
+                napi_typeof(env, custom_metadata_val, &type);
+                if (type == napi_object) {
+                    int meta_rc = extract_metadata_entries_from_js(
+                        env, custom_metadata_val, &metadata_entries, &metadata_count);
+                    if (meta_rc == -1) {
+                        napi_throw_type_error(env, NULL, "metadata values must be strings");
+                        free(upload_id);
+                        return NULL;
+                    }
+                    if (meta_rc == -2) {
+                        napi_throw_error(env, NULL, "Out of memory allocating metadata entries");
+                        free(upload_id);
+                        return NULL;
+                    }
+                }
+            }
+        }
+    }
+    
+    ProgressReporter* progress = NULL;
+    if (progress_reporter_from_options(env, argc > 4 ? argv[4] : NULL, name, &progress) != 0) {
+        free_metadata_entries(metadata_entries, metadata_count);
+        free(upload_id);
+        return NULL;
+    }
+    
+    /* Extract strings */
+    char* bucket_name = NULL;
+    char* object_key = NULL;
+    char* file_path = NULL;
+    
+    if (extract_string_required(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "key", &object_key) != napi_ok ||
+        (is_path && extract_string_required(env, argv[3], "source", &file_path) != napi_ok)) {
+        free(bucket_name);
+        free(object_key);
+        free(file_path);
+        free_metadata_entries(metadata_entries, metadata_count);
+        progress_reporter_discard(progress);
+        free(upload_id);
+        return NULL;
+    }
+    
+    LOG_DEBUG("%s: queuing async work for '%s/%s' (partSize=%lld, concurrency=%lld)",
+              name, bucket_name, object_key, (long long)part_size, (long long)concurrency);
+    
+    UploadParallelData* work_data = (UploadParallelData*)calloc(1, sizeof(UploadParallelData));
+    if (work_data == NULL) {
+        free(bucket_name);
+        free(object_key);
+        free(file_path);
+        free_metadata_entries(metadata_entries, metadata_count);
+        progress_reporter_discard(progress);
+        napi_throw_error(env, NULL, "Out of memory");
+        free(upload_id);
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->progress = progress;
+    work_data->bucket_name = bucket_name;
+    work_data->object_key = object_key;
+    work_data->file_path = file_path;
+    work_data->upload_id = upload_id;
+    work_data->buffer_ptr = buffer_data;  /* Point to JS buffer directly, no copy */
+    work_data->buffer_length = buffer_length;
+    work_data->use_mmap = use_mmap && is_path;
+    work_data->auto_tune = auto_tune;
+    work_data->part_size = (uint64_t)part_size;
+    work_data->concurrency = (uint32_t)concurrency;
+    work_data->max_retries = (uint32_t)retries;
+    work_data->expires = expires;
+    work_data->metadata_entries = metadata_entries;
+    work_data->metadata_count = metadata_count;
+    
+    /* Keep the source buffer alive while part threads read from it */
+    if (!is_path) {
+        pin_buffer(env, argv[3], buffer_length, &work_data->buffer_ref);
+    }
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_TRANSFER, lane, work_name,
+        upload_parallel_execute,
+        upload_parallel_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+napi_value upload_parallel(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 4) {
+        napi_throw_type_error(env, NULL, "projectHandle, bucket, key, and source are required");
+        return NULL;
+    }
+    
+    return queue_upload_parallel(env, argc, argv, NULL, "uploadParallel");
+}
+
+/* ========== resume_upload ========== */
+
+napi_value resume_upload(napi_env env, napi_callback_info info) {
+    size_t argc = 6;
+    napi_value argv[6];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 5) {
+        napi_throw_type_error(env, NULL, "projectHandle, bucket, key, uploadId, and source are required");
+        return NULL;
+    }
+    
+    char* upload_id = NULL;
+    if (extract_string_required(env, argv[3], "uploadId", &upload_id) != napi_ok) {
+        return NULL;
+    }
+    
+    /* Drop uploadId so the remaining arguments line up with uploadParallel */
+    napi_value args[5] = { argv[0], argv[1], argv[2], argv[4], argc > 5 ? argv[5] : NULL };
+    return queue_upload_parallel(env, argc - 1, args, upload_id, "resumeUpload");
+}
+
+/* ========== upload_part_from_file ========== */
+
+napi_value upload_part_from_file(napi_env env, napi_callback_info info) {
+    size_t argc = 9;
+    napi_value argv[9];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 8) {
+        napi_throw_type_error(env, NULL,
+            "projectHandle, bucket, key, uploadId, partNumber, path, offset, and length are required");
+        return NULL;
+    }
+    
+    /* Extract project handle */
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    /* Extract part number and range */
+    napi_valuetype types[3];
+    napi_typeof(env, argv[4], &types[0]);
+    napi_typeof(env, argv[6], &types[1]);
+    napi_typeof(env, argv[7], &types[2]);
+    if (types[0] != napi_number || types[1] != napi_number || types[2] != napi_number) {
+        napi_throw_type_error(env, NULL, "partNumber, offset, and length must be numbers");
+        return NULL;
+    }
+    
+    uint32_t part_number;
+    int64_t offset;
+    int64_t length;
+    napi_get_value_uint32(env, argv[4], &part_number);
+    napi_get_value_int64(env, argv[6], &offset);
+    napi_get_value_int64(env, argv[7], &length);
+    if (part_number < 1 || part_number > PARALLEL_UPLOAD_MAX_PARTS) {
+        napi_throw_range_error(env, NULL, "partNumber must be between 1 and 10000");
+        return NULL;
+    }
+    if (offset < 0 || length < 0) {
+        napi_throw_range_error(env, NULL, "offset and length must not be negative");
+        return NULL;
+    }
+    
+    /* Extract optional options */
+    bool use_mmap = false;
+    char* etag = NULL;
+    RetryPolicy retry = { 0 };
+    if (argc >= 9) {
+        napi_valuetype type;
+        napi_typeof(env, argv[8], &type);
+        if (type == napi_object) {
+            if (retry_policy_option(env, argv[8], &retry) != 0) {
+                return NULL;
+            }
+            use_mmap = get_bool_property(env, argv[8], "mmap", 0) != 0;
+            etag = get_string_property(env, argv[8], "etag");
+        }
+    }
+    
+    ProgressReporter* progress = NULL;
+    if (progress_reporter_from_options(env, argc > 8 ? argv[8] : NULL, "uploadPartFromFile", &progress) != 0) {
+        free(etag);
+        return NULL;
+    }
+    
+    /* Extract strings */
+    char* bucket_name = NULL;
+    char* object_key = NULL;
+    char* upload_id = NULL;
+    char* file_path = NULL;
+    
+    if (extract_string_required(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "key", &object_key) != napi_ok ||
+        extract_string_required(env, argv[3], "uploadId", &upload_id) != napi_ok ||
+        extract_string_required(env, argv[5], "path", &file_path) != napi_ok) {
+        free(bucket_name);
+        free(object_key);
+        free(upload_id);
+        free(file_path);
+        free(etag);
+        progress_reporter_discard(progress);
+        return NULL;
+    }
+    
+    LOG_DEBUG("uploadPartFromFile: queuing async work for part %u of '%s/%s' from '%s' [%lld, +%lld)",
+              part_number, bucket_name, object_key, file_path, (long long)offset, (long long)length);
+    
+    UploadPartFromFileData* work_data = (UploadPartFromFileData*)calloc(1, sizeof(UploadPartFromFileData));
+    if (work_data == NULL) {
+        free(bucket_name);
+        free(object_key);
+        free(upload_id);
+        free(file_path);
+        free(etag);
+        progress_reporter_discard(progress);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->bucket_name = bucket_name;
+    work_data->object_key = object_key;
+    work_data->upload_id = upload_id;
+    work_data->part_number = part_number;
+    work_data->file_path = file_path;
+    work_data->offset = (uint64_t)offset;
+    work_data->length = (uint64_t)length;
+    work_data->etag = etag;
+    work_data->use_mmap = use_mmap;
+    work_data->retry = retry;
+    work_data->progress = progress;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "uploadPartFromFile", NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, argc > 8 ? argv[8] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 8 ? argv[8] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_TRANSFER, lane, work_name,
+        upload_part_from_file_execute,
+        upload_part_from_file_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
     
     return promise;
 }
@@ -153,4 +153,56 @@ napi_value upload_iterator_err(napi_env env, napi_callback_info info);
 /** @brief Free an upload iterator */
 napi_value free_upload_iterator(napi_env env, napi_callback_info info);
 
+/**
+ * @brief Drain a part iterator natively and return every part at once
+ * 
+ * JS: collectUploadParts(projectHandle, bucket, key, uploadId,
+ *                        options?: { cursor?, maxItems?, cancelToken? })
+ *     → Promise<PartInfo[]>
+ * A result of maxItems entries may be truncated; continue from the last
+ * part number as cursor.
+ */
+napi_value collect_upload_parts(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Drain a pending-upload iterator natively and return every upload at once
+ * 
+ * JS: collectUploads(projectHandle, bucket,
+ *                    options?: { prefix?, cursor?, recursive?, system?, custom?, maxItems?, cancelToken? })
+ *     → Promise<UploadInfo[]>
+ * A result of maxItems entries may be truncated; continue from the last
+ * key as cursor.
+ */
+napi_value collect_uploads(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Upload a Buffer or file as a multipart upload with parallel parts
+ * 
+ * JS: uploadParallel(projectHandle, bucket, key, source: Buffer | string,
+ *                    options?: { partSize?, concurrency?, auto?, retries?, expires?, customMetadata? })
+ *     → Promise<ObjectInfo & { tuning? }>
+ */
+napi_value upload_parallel(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Finish a pending multipart upload, sending only its missing parts
+ * 
+ * Walks the upload's committed parts natively, then runs the parallel
+ * engine over the parts that are absent or whose size does not match.
+ * 
+ * JS: resumeUpload(projectHandle, bucket, key, uploadId, source: Buffer | string,
+ *                  options?: { partSize?, concurrency?, retries?, mmap?, customMetadata? })
+ *     → Promise<ObjectInfo>
+ */
+napi_value resume_upload(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Upload a byte range of a local file as one part, in one async work
+ * 
+ * JS: uploadPartFromFile(projectHandle, bucket, key, uploadId, partNumber, path,
+ *                        offset, length, options?: { etag?, mmap?, onProgress?, cancelToken? })
+ *     → Promise<PartInfo>
+ */
+napi_value upload_part_from_file(napi_env env, napi_callback_info info);
+
 #endif /* MULTIPART_OPS_H */
@@ -18,6 +18,9 @@
 
 /* Include uplink-c header - contains all type definitions */
 #include "uplink.h"
+#include "../common/cancel_token.h"
+#include "../common/progress.h"
+#include "../common/retry.h"
 
 /**
  * @brief Data for begin_upload async operation
@@ -69,6 +72,7 @@ typedef struct {
     char* object_key;
     char* upload_id;
     uint32_t part_number;
+    struct AdmissionSlot* admission;    /* Transfer slot, moved to the handle on success */
     UplinkPartUploadResult result;
     napi_deferred deferred;
     napi_async_work work;
@@ -81,10 +85,10 @@ typedef struct {
     size_t part_upload_handle;
     void* buffer;
     size_t length;
+    size_t bandwidth_project;   /* Project whose bandwidth limits apply, or 0 */
     UplinkWriteResult result;
     napi_ref buffer_ref;
     napi_deferred deferred;
-    napi_async_work work;
 } PartUploadWriteData;
 
 /**
@@ -92,6 +96,7 @@ typedef struct {
  */
 typedef struct {
     size_t part_upload_handle;
+    struct AdmissionSlot* admission;    /* Transfer slot taken from the handle (commit/abort), or NULL */
     UplinkError* error;
     napi_deferred deferred;
     napi_async_work work;
@@ -226,4 +231,132 @@ typedef struct {
     napi_async_work work;
 } FreeUploadIteratorData;
 
+/**
+ * @brief Data for collect_upload_parts async operation
+ * 
+ * The worker drains the part iterator up to max_items entries and keeps
+ * the items it returned; they are owned by the iterator, which is freed
+ * in the complete callback once they have been converted.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    char* upload_id;
+    uint32_t cursor;
+    size_t max_items;           /* 0 for no cap */
+    UplinkPartIterator* iterator;
+    UplinkPart** parts;         /* Borrowed from iterator */
+    size_t count;
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    int32_t error_code;
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} CollectUploadPartsData;
+
+/**
+ * @brief Data for collect_uploads async operation
+ * 
+ * Same shape as CollectUploadPartsData, over the pending-upload iterator.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* prefix;
+    char* cursor;
+    bool recursive;
+    bool include_system;
+    bool include_custom;
+    size_t max_items;           /* 0 for no cap */
+    UplinkUploadIterator* iterator;
+    UplinkUploadInfo** uploads; /* Borrowed from iterator */
+    size_t count;
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    int32_t error_code;
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} CollectUploadsData;
+
+/** Default part size for upload_parallel (64 MiB, one Storj segment) */
+#define PARALLEL_UPLOAD_DEFAULT_PART_SIZE (64 * 1024 * 1024)
+
+/** Default number of parts uploaded concurrently by upload_parallel */
+#define PARALLEL_UPLOAD_DEFAULT_CONCURRENCY 4
+
+/** Default number of retries per failed part */
+#define PARALLEL_UPLOAD_DEFAULT_RETRIES 3
+
+/** Maximum number of parts in one multipart upload */
+#define PARALLEL_UPLOAD_MAX_PARTS 10000
+
+/**
+ * @brief Data for upload_parallel async operation
+ * 
+ * The source is either a pinned JS buffer or a file path. The whole
+ * begin → parts → commit sequence runs inside one async work, with parts
+ * distributed over native threads. When upload_id is set the begin step
+ * is replaced by a walk of the upload's committed parts, and only the
+ * missing parts are sent.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    char* file_path;            /* NULL when uploading from buffer */
+    char* upload_id;            /* Pending upload to resume, NULL to begin one */
+    void* buffer_ptr;           /* Direct pointer to JS buffer (no copy) */
+    size_t buffer_length;
+    napi_ref buffer_ref;        /* Keeps JS buffer alive during async work */
+    bool use_mmap;              /* Map file parts instead of reading them */
+    bool auto_tune;             /* Adapt part size and in-flight parts as parts finish */
+    uint64_t part_size;         /* Fixed part size, or the starting size when auto_tune */
+    uint32_t concurrency;       /* Parts in flight, or the ceiling when auto_tune */
+    uint32_t max_retries;
+    int64_t expires;
+    UplinkCustomMetadataEntry* metadata_entries;
+    size_t metadata_count;
+    uint32_t part_count;
+    uint32_t resumed_parts;     /* Parts found already committed when resuming */
+    uint64_t tuned_part_size;   /* Settled part size when auto_tune */
+    uint32_t tuned_concurrency; /* Settled in-flight parts when auto_tune */
+    double tuned_goodput;       /* Bytes per second of the tuner's last window */
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    ProgressReporter* progress; /* From options.onProgress, or NULL */
+    int32_t error_code;
+    char* error_message;
+    UplinkCommitUploadResult result;
+    napi_deferred deferred;
+    napi_async_work work;
+} UploadParallelData;
+
+/**
+ * @brief Data for upload_part_from_file async operation
+ * 
+ * One async work opens the part, writes a byte range of a local file
+ * into it (read on the worker thread, or mapped), optionally sets the
+ * ETag, and commits.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    char* upload_id;
+    uint32_t part_number;
+    char* file_path;
+    uint64_t offset;
+    uint64_t length;
+    char* etag;                 /* NULL to leave the ETag unset */
+    bool use_mmap;              /* Map the range instead of reading it */
+    RetryPolicy retry;          /* From options.retry; a retry uploads the whole part again */
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    ProgressReporter* progress; /* From options.onProgress, or NULL */
+    int32_t error_code;
+    char* error_message;
+    UplinkPartResult result;    /* Part info after commit */
+    napi_deferred deferred;
+    napi_async_work work;
+} UploadPartFromFileData;
+
 #endif /* MULTIPART_TYPES_H */
@@ -10,15 +10,18 @@
 #include "../common/error_registry.h"
 #include "../common/cancel_helpers.h"
 #include "../common/object_converter.h"
+#include "../common/stat_cache.h"
+#include "../common/string_helpers.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 /* ========== stat_object_complete ========== */
 
 void stat_object_complete(napi_env env, napi_status status, void* data) {
     ObjectOpData* work_data = (ObjectOpData*)data;
-    REJECT_IF_CANCELLED(env, status, work_data->deferred, "statObject");
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "statObject", work_data->cancel);
     
     if (work_data->result.error != NULL) {
         LOG_ERROR("statObject: failed - %s", work_data->result.error->message);
@@ -28,6 +31,8 @@ void stat_object_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
+    stat_cache_store(work_data->project_handle, work_data->cache_epoch,
+                     work_data->bucket_name, work_data->object_key, work_data->result.object);
     napi_value object_obj = uplink_object_to_js(env, work_data->result.object);
     uplink_free_object_result(work_data->result);
     
@@ -35,8 +40,326 @@ void stat_object_complete(napi_env env, napi_status status, void* data) {
     napi_resolve_deferred(env, work_data->deferred, object_obj);
     
 cleanup:
-    free(work_data->bucket_name);
+    bucket_name_release(work_data->bucket_name);
     free(work_data->object_key);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== stat_objects_complete ========== */
+
+void stat_objects_complete(napi_env env, napi_status status, void* data) {
+    ObjectBatchData* work_data = (ObjectBatchData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "statObjects", work_data->cancel);
+    
+    napi_value result, objects, errors;
+    napi_create_object(env, &result);
+    napi_create_array_with_length(env, work_data->key_count, &objects);
+    napi_create_array(env, &errors);
+    
+    napi_value null_value;
+    napi_get_null(env, &null_value);
+    
+    uint32_t error_count = 0;
+    for (size_t i = 0; i < work_data->key_count; i++) {
+        UplinkObjectResult* item = &work_data->results[i];
+        if (i >= work_data->attempted) {
+            /* Aborted before this key was tried */
+            napi_value entry, index_value, key_value;
+            napi_create_object(env, &entry);
+            napi_create_uint32(env, (uint32_t)i, &index_value);
+            napi_create_string_utf8(env, work_data->keys[i], NAPI_AUTO_LENGTH, &key_value);
+            napi_set_named_property(env, entry, "index", index_value);
+            napi_set_named_property(env, entry, "key", key_value);
+            napi_set_named_property(env, entry, "error",
+                                    cancel_token_error(env, work_data->cancel));
+            napi_set_element(env, objects, (uint32_t)i, null_value);
+            napi_set_element(env, errors, error_count++, entry);
+            continue;
+        }
+        if (item->error == NULL) {
+            stat_cache_store(work_data->project_handle, work_data->cache_epoch,
+                             work_data->bucket_name, work_data->keys[i], item->object);
+            napi_set_element(env, objects, (uint32_t)i, uplink_object_to_js(env, item->object));
+            continue;
+        }
+        
+        /* Missing keys are just null; anything else is also reported */
+        napi_set_element(env, objects, (uint32_t)i, null_value);
+        if (item->error->code != UPLINK_ERROR_OBJECT_NOT_FOUND) {
+            napi_value entry, index_value, key_value;
+            napi_create_object(env, &entry);
+            napi_create_uint32(env, (uint32_t)i, &index_value);
+            napi_create_string_utf8(env, work_data->keys[i], NAPI_AUTO_LENGTH, &key_value);
+            napi_set_named_property(env, entry, "index", index_value);
+            napi_set_named_property(env, entry, "key", key_value);
+            napi_set_named_property(env, entry, "error",
+                                    create_typed_error(env, item->error->code, item->error->message));
+            napi_set_element(env, errors, error_count++, entry);
+        }
+    }
+    napi_set_named_property(env, result, "objects", objects);
+    napi_set_named_property(env, result, "errors", errors);
+    
+    LOG_INFO("statObjects: %zu keys in '%s', %u failed",
+             work_data->key_count, work_data->bucket_name, error_count);
+    napi_resolve_deferred(env, work_data->deferred, result);
+    
+cleanup:
+    for (size_t i = 0; i < work_data->key_count; i++) {
+        uplink_free_object_result(work_data->results[i]);
+    }
+    free(work_data->results);
+    free_string_array(work_data->keys, work_data->key_count);
+    bucket_name_release(work_data->bucket_name);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== delete_objects_complete ========== */
+
+void delete_objects_complete(napi_env env, napi_status status, void* data) {
+    ObjectBatchData* work_data = (ObjectBatchData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "deleteObjects", work_data->cancel);
+    
+    napi_value result, failed;
+    napi_create_object(env, &result);
+    napi_create_array(env, &failed);
+    
+    uint32_t deleted = 0, missing = 0, failed_count = 0;
+    for (size_t i = 0; i < work_data->key_count; i++) {
+        UplinkObjectResult* item = &work_data->results[i];
+        bool attempted = i < work_data->attempted;
+        if (attempted) {
+            stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->keys[i]);
+        }
+        
+        if (attempted && item->error == NULL) {
+            /* uplink reports a key that did not exist as no error and no object */
+            if (item->object != NULL) deleted++; else missing++;
+            continue;
+        }
+        if (attempted && item->error->code == UPLINK_ERROR_OBJECT_NOT_FOUND) {
+            missing++;
+            continue;
+        }
+        
+        /* Keys never tried because the call was aborted fail with CanceledError or TimeoutError */
+        napi_value entry, index_value, key_value, code_value, message_value;
+        napi_create_object(env, &entry);
+        napi_create_uint32(env, (uint32_t)i, &index_value);
+        napi_create_string_utf8(env, work_data->keys[i], NAPI_AUTO_LENGTH, &key_value);
+        napi_create_int32(env, attempted ? item->error->code : cancel_token_code(work_data->cancel), &code_value);
+        napi_create_string_utf8(env, !attempted ? cancel_token_message(work_data->cancel) : (item->error->message ? item->error->message : ""),
+                                NAPI_AUTO_LENGTH, &message_value);
+        napi_set_named_property(env, entry, "index", index_value);
+        napi_set_named_property(env, entry, "key", key_value);
+        napi_set_named_property(env, entry, "code", code_value);
+        napi_set_named_property(env, entry, "message", message_value);
+        napi_set_element(env, failed, failed_count++, entry);
+    }
+    
+    napi_value deleted_value, missing_value;
+    napi_create_uint32(env, deleted, &deleted_value);
+    napi_create_uint32(env, missing, &missing_value);
+    napi_set_named_property(env, result, "deleted", deleted_value);
+    napi_set_named_property(env, result, "missing", missing_value);
+    napi_set_named_property(env, result, "failed", failed);
+    
+    LOG_INFO("deleteObjects: '%s' deleted=%u missing=%u failed=%u",
+             work_data->bucket_name, deleted, missing, failed_count);
+    napi_resolve_deferred(env, work_data->deferred, result);
+    
+cleanup:
+    for (size_t i = 0; i < work_data->key_count; i++) {
+        uplink_free_object_result(work_data->results[i]);
+    }
+    free(work_data->results);
+    free_string_array(work_data->keys, work_data->key_count);
+    bucket_name_release(work_data->bucket_name);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== object_pairs_complete ========== */
+
+/**
+ * Build { succeeded, status, errors } for a batch of @p count items:
+ * status is an Int32Array of @p codes and errors lists
+ * { index, code, message } for each nonzero code.
+ */
+static napi_value create_batch_status(napi_env env, size_t count, const int32_t* codes, char** messages,
+                                      uint32_t* out_succeeded) {
+    napi_value result, errors, buffer, status_array;
+    napi_create_object(env, &result);
+    napi_create_array(env, &errors);
+    
+    void* status_data = NULL;
+    napi_create_arraybuffer(env, count * sizeof(int32_t), &status_data, &buffer);
+    if (count > 0) {
+        memcpy(status_data, codes, count * sizeof(int32_t));
+    }
+    napi_create_typedarray(env, napi_int32_array, count, buffer, 0, &status_array);
+    
+    uint32_t succeeded = 0, error_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (codes[i] == 0) {
+            succeeded++;
+            continue;
+        }
+        napi_value entry, index_value, code_value, message_value;
+        napi_create_object(env, &entry);
+        napi_create_uint32(env, (uint32_t)i, &index_value);
+        napi_create_int32(env, codes[i], &code_value);
+        napi_create_string_utf8(env, messages[i] ? messages[i] : "", NAPI_AUTO_LENGTH, &message_value);
+        napi_set_named_property(env, entry, "index", index_value);
+        napi_set_named_property(env, entry, "code", code_value);
+        napi_set_named_property(env, entry, "message", message_value);
+        napi_set_element(env, errors, error_count++, entry);
+    }
+    
+    napi_value succeeded_value;
+    napi_create_uint32(env, succeeded, &succeeded_value);
+    napi_set_named_property(env, result, "succeeded", succeeded_value);
+    napi_set_named_property(env, result, "status", status_array);
+    napi_set_named_property(env, result, "errors", errors);
+    *out_succeeded = succeeded;
+    return result;
+}
+
+void object_pairs_complete(napi_env env, napi_status status, void* data) {
+    ObjectPairBatchData* work_data = (ObjectPairBatchData*)data;
+    const char* name = work_data->move ? "moveObjects" : "copyObjects";
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, name, work_data->cancel);
+    
+    for (size_t i = 0; i < work_data->pair_count; i++) {
+        char** pair = &work_data->pairs[i * 4];
+        if (work_data->move) {
+            stat_cache_invalidate(work_data->project_handle, pair[0], pair[1]);
+        }
+        stat_cache_invalidate(work_data->project_handle, pair[2], pair[3]);
+    }
+    
+    uint32_t succeeded;
+    napi_value result = create_batch_status(env, work_data->pair_count, work_data->codes, work_data->messages,
+                                            &succeeded);
+    
+    LOG_INFO("%s: %zu pairs, %u succeeded, %zu failed", name, work_data->pair_count, succeeded,
+             work_data->pair_count - succeeded);
+    napi_resolve_deferred(env, work_data->deferred, result);
+    
+cleanup:
+    free_string_array(work_data->pairs, work_data->pair_count * 4);
+    free_string_array(work_data->messages, work_data->pair_count);
+    free(work_data->codes);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== delete_prefix_complete ========== */
+
+static void set_count_property(napi_env env, napi_value obj, const char* name, uint64_t count) {
+    napi_value value;
+    napi_create_double(env, (double)count, &value);
+    napi_set_named_property(env, obj, name, value);
+}
+
+void delete_prefix_complete(napi_env env, napi_status status, void* data) {
+    DeletePrefixData* work_data = (DeletePrefixData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "deletePrefix", work_data->cancel);
+    if (!work_data->dry_run) {
+        stat_cache_invalidate_prefix(work_data->project_handle, work_data->bucket_name, work_data->prefix);
+    }
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("deletePrefix: failed after %llu deletions - %s",
+                  (unsigned long long)work_data->deleted, work_data->error_message);
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    napi_value result, failures;
+    napi_create_object(env, &result);
+    set_count_property(env, result, "listed", work_data->listed);
+    set_count_property(env, result, "deleted", work_data->deleted);
+    set_count_property(env, result, "missing", work_data->missing);
+    set_count_property(env, result, "failed", work_data->failed);
+    
+    napi_create_array_with_length(env, work_data->failure_count, &failures);
+    for (size_t i = 0; i < work_data->failure_count; i++) {
+        DeletePrefixFailure* failure = &work_data->failures[i];
+        napi_value entry, key_value, code_value, message_value;
+        napi_create_object(env, &entry);
+        napi_create_string_utf8(env, failure->key, NAPI_AUTO_LENGTH, &key_value);
+        napi_create_int32(env, failure->code, &code_value);
+        napi_create_string_utf8(env, failure->message ? failure->message : "", NAPI_AUTO_LENGTH, &message_value);
+        napi_set_named_property(env, entry, "key", key_value);
+        napi_set_named_property(env, entry, "code", code_value);
+        napi_set_named_property(env, entry, "message", message_value);
+        napi_set_element(env, failures, (uint32_t)i, entry);
+    }
+    napi_set_named_property(env, result, "failures", failures);
+    
+    LOG_INFO("deletePrefix: '%s/%s' listed=%llu deleted=%llu missing=%llu failed=%llu%s",
+             work_data->bucket_name, work_data->prefix,
+             (unsigned long long)work_data->listed, (unsigned long long)work_data->deleted,
+             (unsigned long long)work_data->missing, (unsigned long long)work_data->failed,
+             work_data->dry_run ? " (dry run)" : "");
+    napi_resolve_deferred(env, work_data->deferred, result);
+    
+cleanup:
+    if (work_data->failures != NULL) {
+        for (size_t i = 0; i < work_data->failure_count; i++) {
+            free(work_data->failures[i].key);
+            free(work_data->failures[i].message);
+        }
+        free(work_data->failures);
+    }
+    free(work_data->error_message);
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->prefix);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== export_listing_complete ========== */
+
+void export_listing_complete(napi_env env, napi_status status, void* data) {
+    ExportListingData* work_data = (ExportListingData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "exportListing", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("exportListing: failed after %llu records - %s",
+                  (unsigned long long)(work_data->objects + work_data->prefixes), work_data->error_message);
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    napi_value result;
+    napi_create_object(env, &result);
+    set_count_property(env, result, "objects", work_data->objects);
+    set_count_property(env, result, "prefixes", work_data->prefixes);
+    set_count_property(env, result, "contentLength", work_data->content_length);
+    set_count_property(env, result, "bytesWritten", work_data->bytes_written);
+    
+    LOG_INFO("exportListing: '%s' objects=%llu prefixes=%llu bytes=%llu",
+             work_data->file_path, (unsigned long long)work_data->objects,
+             (unsigned long long)work_data->prefixes, (unsigned long long)work_data->bytes_written);
+    napi_resolve_deferred(env, work_data->deferred, result);
+    
+cleanup:
+    free(work_data->error_message);
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->file_path);
+    free(work_data->prefix);
+    cancel_token_detach(work_data->cancel, work_data->work);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
@@ -46,6 +369,7 @@ cleanup:
 void delete_object_complete(napi_env env, napi_status status, void* data) {
     ObjectOpData* work_data = (ObjectOpData*)data;
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "deleteObject");
+    stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->object_key);
     
     if (work_data->result.error != NULL) {
         LOG_ERROR("deleteObject: failed - %s", work_data->result.error->message);
@@ -67,17 +391,37 @@ void delete_object_complete(napi_env env, napi_status status, void* data) {
     napi_resolve_deferred(env, work_data->deferred, undefined);
     
 cleanup:
-    free(work_data->bucket_name);
+    bucket_name_release(work_data->bucket_name);
     free(work_data->object_key);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
 
+/* ========== object iterator checkpoints ========== */
+
+static void object_iterator_state_free(void* attachment) {
+    ObjectIteratorState* state = (ObjectIteratorState*)attachment;
+    uplink_free_object(state->peeked);
+    free(state->last_key);
+    free(state->end_key);
+    free(state);
+}
+
+/** Move the checkpoint to @p key (owned); a NULL key keeps the old one */
+static void object_iterator_state_advance(ObjectIteratorState* state, char* key) {
+    if (state == NULL || key == NULL) {
+        free(key);
+        return;
+    }
+    free(state->last_key);
+    state->last_key = key;
+}
+
 /* ========== listObjectsCreate complete ========== */
 
 void list_objects_create_complete(napi_env env, napi_status status, void* data) {
     ListObjectsCreateData* work_data = (ListObjectsCreateData*)data;
-    REJECT_IF_CANCELLED(env, status, work_data->deferred, "listObjectsCreate");
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "listObjectsCreate", work_data->cancel);
     
     if (work_data->iterator_handle == 0) {
         LOG_ERROR("listObjectsCreate: failed to create iterator");
@@ -92,15 +436,36 @@ void list_objects_create_complete(napi_env env, napi_status status, void* data)
     {
         napi_value handle_obj = create_handle_external(env, work_data->iterator_handle, 
                                                         HANDLE_TYPE_OBJECT_ITERATOR, NULL, NULL);
+        HandleWrapper* wrapper = get_handle_wrapper(env, handle_obj, HANDLE_TYPE_OBJECT_ITERATOR);
+        ObjectIteratorState* state = (ObjectIteratorState*)calloc(1, sizeof(ObjectIteratorState));
+        if (wrapper == NULL || state == NULL) {
+            /* A projected listing must not silently fall back to full objects */
+            free(state);
+            uplink_free_object_iterator((UplinkObjectIterator*)work_data->iterator_handle);
+            if (wrapper != NULL) {
+                wrapper->handle = 0;
+            }
+            napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Out of memory"));
+            goto cleanup;
+        }
+        state->fields = work_data->fields;
+        state->last_key = work_data->cursor;
+        state->end_key = work_data->end_key;
+        work_data->cursor = NULL;
+        work_data->end_key = NULL;
+        wrapper->attachment = state;
+        wrapper->attachment_free = object_iterator_state_free;
         
         LOG_INFO("listObjectsCreate: iterator created, handle=%zu", work_data->iterator_handle);
         napi_resolve_deferred(env, work_data->deferred, handle_obj);
     }
     
 cleanup:
-    free(work_data->bucket_name);
+    bucket_name_release(work_data->bucket_name);
     free(work_data->prefix);
     free(work_data->cursor);
+    free(work_data->end_key);
+    cancel_token_detach(work_data->cancel, work_data->work);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
@@ -122,6 +487,104 @@ cleanup:
     free(work_data);
 }
 
+/* ========== objectIteratorNextBatch complete ========== */
+
+void object_iterator_next_batch_complete(napi_env env, napi_status status, void* data) {
+    ObjectIteratorBatchData* work_data = (ObjectIteratorBatchData*)data;
+    REJECT_IF_CANCELLED(env, status, work_data->deferred, "objectIteratorNextBatch");
+    
+    {
+        napi_value array;
+        napi_create_array_with_length(env, work_data->count, &array);
+        
+        /* One lookup of the property names for the whole page; metadata
+         * is decoded only for the items whose `custom` is read */
+        uint32_t fields = work_data->fields | OBJECT_CONVERT_LAZY_CUSTOM;
+        ObjectKeys keys;
+        int have_keys = object_keys_get(env, &keys) == 0;
+        if (work_data->count > 0) {
+            object_iterator_state_advance(work_data->state, strdup(work_data->objects[work_data->count - 1]->key));
+        }
+        for (size_t i = 0; i < work_data->count; i++) {
+            napi_value item = have_keys
+                ? uplink_object_to_js_keys(env, &keys, work_data->objects[i], fields)
+                : uplink_object_to_js_fields(env, work_data->objects[i], fields);
+            napi_set_element(env, array, (uint32_t)i, item);
+            uplink_free_object(work_data->objects[i]);
+        }
+        
+        LOG_DEBUG("objectIteratorNextBatch: returned %zu items", work_data->count);
+        napi_resolve_deferred(env, work_data->deferred, array);
+    }
+    
+cleanup:
+    free(work_data->objects);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== objectIteratorNextColumns complete ========== */
+
+/** Create a typed array view over @p buffer and set it as @p name on @p obj */
+static void set_column(napi_env env, napi_value obj, const char* name, napi_typedarray_type type,
+                       size_t length, napi_value buffer, size_t byte_offset) {
+    napi_value column;
+    napi_create_typedarray(env, type, length, buffer, byte_offset, &column);
+    napi_set_named_property(env, obj, name, column);
+}
+
+void object_iterator_next_columns_complete(napi_env env, napi_status status, void* data) {
+    ObjectIteratorColumnsData* work_data = (ObjectIteratorColumnsData*)data;
+    REJECT_IF_CANCELLED(env, status, work_data->deferred, "objectIteratorNextColumns");
+    
+    if (work_data->out_of_memory) {
+        LOG_ERROR("objectIteratorNextColumns: out of memory");
+        napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Out of memory"));
+        goto cleanup;
+    }
+    
+    {
+        size_t count = work_data->count;
+        void* js_data = NULL;
+        napi_value buffer;
+        if (napi_create_arraybuffer(env, work_data->block_size, &js_data, &buffer) != napi_ok) {
+            napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Out of memory"));
+            goto cleanup;
+        }
+        memcpy(js_data, work_data->block, work_data->block_size);
+        
+        size_t offset = 0;
+        napi_value page, count_val;
+        napi_create_object(env, &page);
+        napi_create_uint32(env, (uint32_t)count, &count_val);
+        napi_set_named_property(env, page, "count", count_val);
+        
+        set_column(env, page, "contentLength", napi_bigint64_array, count, buffer, offset);
+        offset += count * sizeof(int64_t);
+        set_column(env, page, "created", napi_float64_array, count, buffer, offset);
+        offset += count * sizeof(double);
+        set_column(env, page, "expires", napi_float64_array, count, buffer, offset);
+        offset += count * sizeof(double);
+        set_column(env, page, "keyOffsets", napi_uint32_array, count + 1, buffer, offset);
+        offset += (count + 1) * sizeof(uint32_t);
+        set_column(env, page, "isPrefix", napi_uint8_array, (count + 7) / 8, buffer, offset);
+        offset += (count + 7) / 8;
+        set_column(env, page, "keyBytes", napi_uint8_array, work_data->key_bytes, buffer, offset);
+        
+        object_iterator_state_advance(work_data->state, work_data->last_key);
+        work_data->last_key = NULL;
+        
+        LOG_DEBUG("objectIteratorNextColumns: returned %zu items", count);
+        napi_resolve_deferred(env, work_data->deferred, page);
+    }
+    
+cleanup:
+    free(work_data->last_key);
+    free(work_data->block);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
 /* ========== objectIteratorItem complete ========== */
 
 void object_iterator_item_complete(napi_env env, napi_status status, void* data) {
@@ -129,9 +592,11 @@ void object_iterator_item_complete(napi_env env, napi_status status, void* data)
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "objectIteratorItem");
     
     {
-        napi_value object_obj = uplink_object_to_js(env, work_data->object);
+        napi_value object_obj = uplink_object_to_js_fields(env, work_data->object,
+                                                           work_data->fields | OBJECT_CONVERT_LAZY_CUSTOM);
         
         if (work_data->object != NULL) {
+            object_iterator_state_advance(work_data->state, strdup(work_data->object->key));
             uplink_free_object(work_data->object);
         }
         
@@ -193,6 +658,7 @@ cleanup:
 void copy_object_complete(napi_env env, napi_status status, void* data) {
     CopyMoveObjectData* work_data = (CopyMoveObjectData*)data;
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "copyObject");
+    stat_cache_invalidate(work_data->project_handle, work_data->dst_bucket, work_data->dst_key);
     
     if (work_data->result.error != NULL) {
         LOG_ERROR("copyObject: failed - %s", work_data->result.error->message);
@@ -211,9 +677,9 @@ void copy_object_complete(napi_env env, napi_status status, void* data) {
     napi_resolve_deferred(env, work_data->deferred, object_obj);
     
 cleanup:
-    free(work_data->src_bucket);
+    bucket_name_release(work_data->src_bucket);
     free(work_data->src_key);
-    free(work_data->dst_bucket);
+    bucket_name_release(work_data->dst_bucket);
     free(work_data->dst_key);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
@@ -224,6 +690,8 @@ cleanup:
 void move_object_complete(napi_env env, napi_status status, void* data) {
     CopyMoveObjectData* work_data = (CopyMoveObjectData*)data;
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "moveObject");
+    stat_cache_invalidate(work_data->project_handle, work_data->src_bucket, work_data->src_key);
+    stat_cache_invalidate(work_data->project_handle, work_data->dst_bucket, work_data->dst_key);
     
     if (work_data->move_error != NULL) {
         LOG_ERROR("moveObject: failed - %s", work_data->move_error->message);
@@ -242,9 +710,9 @@ void move_object_complete(napi_env env, napi_status status, void* data) {
     napi_resolve_deferred(env, work_data->deferred, undefined);
     
 cleanup:
-    free(work_data->src_bucket);
+    bucket_name_release(work_data->src_bucket);
     free(work_data->src_key);
-    free(work_data->dst_bucket);
+    bucket_name_release(work_data->dst_bucket);
     free(work_data->dst_key);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
@@ -255,6 +723,7 @@ cleanup:
 void update_object_metadata_complete(napi_env env, napi_status status, void* data) {
     UpdateMetadataData* work_data = (UpdateMetadataData*)data;
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "updateObjectMetadata");
+    stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->object_key);
     
     if (work_data->error != NULL) {
         LOG_ERROR("updateObjectMetadata: failed - %s", work_data->error->message);
@@ -272,18 +741,51 @@ void update_object_metadata_complete(napi_env env, napi_status status, void* dat
     napi_resolve_deferred(env, work_data->deferred, undefined);
     
 cleanup:
-    free(work_data->bucket_name);
+    bucket_name_release(work_data->bucket_name);
     free(work_data->object_key);
     
-    /* Free metadata entries */
-    if (work_data->metadata_entries != NULL) {
-        for (size_t i = 0; i < work_data->metadata_count; i++) {
-            free(work_data->metadata_entries[i].key);
-            free(work_data->metadata_entries[i].value);
+    free_metadata_entries(work_data->metadata_entries, work_data->metadata_count);
+    
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== update_objects_metadata_complete ========== */
+
+void update_metadata_batch_free(UpdateMetadataBatchData* work_data) {
+    if (work_data->sets != NULL) {
+        for (size_t i = 0; i < work_data->set_count; i++) {
+            free_metadata_entries(work_data->sets[i].entries, work_data->sets[i].count);
         }
-        free(work_data->metadata_entries);
+        free(work_data->sets);
+    }
+    free_string_array(work_data->keys, work_data->key_count);
+    free_string_array(work_data->messages, work_data->key_count);
+    free(work_data->set_index);
+    free(work_data->codes);
+    bucket_name_release(work_data->bucket_name);
+}
+
+void update_objects_metadata_complete(napi_env env, napi_status status, void* data) {
+    UpdateMetadataBatchData* work_data = (UpdateMetadataBatchData*)data;
+    
+    /* Keys attempted before an abort may have changed, so invalidate all of them */
+    for (size_t i = 0; i < work_data->key_count; i++) {
+        stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->keys[i]);
     }
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "updateObjectsMetadata", work_data->cancel);
+    
+    uint32_t succeeded;
+    napi_value result = create_batch_status(env, work_data->key_count, work_data->codes, work_data->messages,
+                                            &succeeded);
     
+    LOG_INFO("updateObjectsMetadata: %zu keys in '%s', %u succeeded, %zu failed", work_data->key_count,
+             work_data->bucket_name, succeeded, work_data->key_count - succeeded);
+    napi_resolve_deferred(env, work_data->deferred, result);
+    
+cleanup:
+    update_metadata_batch_free(work_data);
+    cancel_token_detach(work_data->cancel, work_data->work);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
@@ -7,12 +7,38 @@
 #define OBJECT_COMPLETE_H
 
 #include <node_api.h>
+#include "object_types.h"
 
 /**
  * @brief Complete stat_object on main thread
  */
 void stat_object_complete(napi_env env, napi_status status, void* data);
 
+/**
+ * @brief Complete stat_objects on main thread
+ */
+void stat_objects_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Complete delete_objects on main thread
+ */
+void delete_objects_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Complete copy_objects and move_objects on main thread
+ */
+void object_pairs_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Complete delete_prefix on main thread
+ */
+void delete_prefix_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Complete export_listing on main thread
+ */
+void export_listing_complete(napi_env env, napi_status status, void* data);
+
 /**
  * @brief Complete delete_object on main thread
  */
@@ -28,6 +54,16 @@ void list_objects_create_complete(napi_env env, napi_status status, void* data);
  */
 void object_iterator_next_complete(napi_env env, napi_status status, void* data);
 
+/**
+ * @brief Complete object_iterator_next_batch on main thread
+ */
+void object_iterator_next_batch_complete(napi_env env, napi_status status, void* data);
+
+/**
+ * @brief Complete object_iterator_next_columns on main thread
+ */
+void object_iterator_next_columns_complete(napi_env env, napi_status status, void* data);
+
 /**
  * @brief Complete object_iterator_item on main thread
  */
@@ -58,4 +94,17 @@ void move_object_complete(napi_env env, napi_status status, void* data);
  */
 void update_object_metadata_complete(napi_env env, napi_status status, void* data);
 
+/**
+ * @brief Free the keys, sets and status slots of an UpdateMetadataBatchData
+ *
+ * The struct itself, its cancel token and its async work are left to
+ * the caller. Safe on a partly filled struct from calloc.
+ */
+void update_metadata_batch_free(UpdateMetadataBatchData* work_data);
+
+/**
+ * @brief Complete update_objects_metadata on main thread
+ */
+void update_objects_metadata_complete(napi_env env, napi_status status, void* data);
+
 #endif /* OBJECT_COMPLETE_H */
@@ -5,8 +5,15 @@
 
 #include "object_execute.h"
 #include "object_types.h"
+#include "../common/result_helpers.h"
+#include "../common/retry.h"
+#include "../common/buffer_pool.h"
+#include "../common/file_helpers.h"
 #include "../common/logger.h"
 
+#include <uv.h>
+#include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -20,7 +27,668 @@ void stat_object_execute(napi_env env, void* data) {
               work_data->bucket_name, work_data->object_key);
     
     UplinkProject project = { ._handle = work_data->project_handle };
-    work_data->result = uplink_stat_object(&project, work_data->bucket_name, work_data->object_key);
+    for (uint32_t attempt = 1;; attempt++) {
+        work_data->result = uplink_stat_object(&project, work_data->bucket_name, work_data->object_key);
+        if (work_data->result.error == NULL ||
+            !retry_backoff(&work_data->retry, attempt, work_data->result.error->code, work_data->cancel, "statObject")) {
+            break;
+        }
+        uplink_free_object_result(work_data->result);
+    }
+}
+
+/* ========== batched operations ========== */
+
+/** Runs item @p index of a batch job on a worker thread */
+typedef void (*ObjectBatchItemFn)(void* job, UplinkProject* project, size_t index);
+
+/**
+ * Shared state for the native workers of one batched call. Workers claim
+ * item indices under the lock until none remain or the call is aborted.
+ */
+typedef struct {
+    void* job;
+    ObjectBatchItemFn run_item;
+    CancelToken* cancel;
+    size_t count;
+    UplinkProject project;
+    uv_mutex_t lock;
+    size_t next_item;
+} ObjectBatchState;
+
+static void object_batch_worker(void* arg) {
+    ObjectBatchState* state = (ObjectBatchState*)arg;
+    
+    for (;;) {
+        uv_mutex_lock(&state->lock);
+        if (state->next_item >= state->count || cancel_token_is_cancelled(state->cancel)) {
+            uv_mutex_unlock(&state->lock);
+            break;
+        }
+        size_t index = state->next_item++;
+        uv_mutex_unlock(&state->lock);
+        
+        state->run_item(state->job, &state->project, index);
+    }
+}
+
+/**
+ * Run @p run_item for items [0, count) of @p job on up to @p concurrency
+ * native threads, degrading to this thread if none can be started.
+ * @return Items attempted: a prefix of [0, count), shorter only if @p cancel was aborted
+ */
+static size_t object_batch_run(void* job, ObjectBatchItemFn run_item, CancelToken* cancel, size_t project_handle,
+                               size_t count, uint32_t concurrency, const char* name) {
+    ObjectBatchState state;
+    memset(&state, 0, sizeof(state));
+    state.job = job;
+    state.run_item = run_item;
+    state.cancel = cancel;
+    state.count = count;
+    state.project._handle = project_handle;
+    uv_mutex_init(&state.lock);
+    
+    size_t thread_count = concurrency < count ? concurrency : count;
+    uv_thread_t* threads = thread_count > 0 ? (uv_thread_t*)calloc(thread_count, sizeof(uv_thread_t)) : NULL;
+    size_t started = 0;
+    if (threads != NULL) {
+        for (size_t i = 0; i < thread_count; i++) {
+            if (uv_thread_create(&threads[i], object_batch_worker, &state) != 0) {
+                LOG_WARN("%s: could only start %zu of %zu threads", name, started, thread_count);
+                break;
+            }
+            started++;
+        }
+    }
+    if (started == 0 && count > 0) {
+        object_batch_worker(&state);  /* Degrade to sequential on this thread */
+    }
+    for (size_t i = 0; i < started; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    free(threads);
+    uv_mutex_destroy(&state.lock);
+    return state.next_item;
+}
+
+/* ========== stat_objects_execute ========== */
+
+static void stat_objects_item(void* job, UplinkProject* project, size_t index) {
+    ObjectBatchData* work_data = (ObjectBatchData*)job;
+    for (uint32_t attempt = 1;; attempt++) {
+        work_data->results[index] = uplink_stat_object(project, work_data->bucket_name, work_data->keys[index]);
+        if (work_data->results[index].error == NULL ||
+            !retry_backoff(&work_data->retry, attempt, work_data->results[index].error->code, work_data->cancel, "statObjects")) {
+            break;
+        }
+        uplink_free_object_result(work_data->results[index]);
+    }
+}
+
+void stat_objects_execute(napi_env env, void* data) {
+    (void)env;
+    ObjectBatchData* work_data = (ObjectBatchData*)data;
+    
+    LOG_DEBUG("statObjects: %zu keys in '%s', concurrency=%u (worker thread)",
+              work_data->key_count, work_data->bucket_name, work_data->concurrency);
+    
+    work_data->attempted = object_batch_run(work_data, stat_objects_item, work_data->cancel, work_data->project_handle,
+                                            work_data->key_count, work_data->concurrency, "statObjects");
+}
+
+/* ========== delete_objects_execute ========== */
+
+static void delete_objects_item(void* job, UplinkProject* project, size_t index) {
+    ObjectBatchData* work_data = (ObjectBatchData*)job;
+    for (uint32_t attempt = 1;; attempt++) {
+        work_data->results[index] = uplink_delete_object(project, work_data->bucket_name, work_data->keys[index]);
+        if (work_data->results[index].error == NULL ||
+            !retry_backoff(&work_data->retry, attempt, work_data->results[index].error->code, work_data->cancel, "deleteObjects")) {
+            break;
+        }
+        uplink_free_object_result(work_data->results[index]);
+    }
+}
+
+void delete_objects_execute(napi_env env, void* data) {
+    (void)env;
+    ObjectBatchData* work_data = (ObjectBatchData*)data;
+    
+    LOG_DEBUG("deleteObjects: %zu keys in '%s', concurrency=%u (worker thread)",
+              work_data->key_count, work_data->bucket_name, work_data->concurrency);
+    
+    work_data->attempted = object_batch_run(work_data, delete_objects_item, work_data->cancel, work_data->project_handle,
+                                            work_data->key_count, work_data->concurrency, "deleteObjects");
+}
+
+/* ========== copy_objects_execute / move_objects_execute ========== */
+
+static void object_pairs_set_result(ObjectPairBatchData* work_data, size_t index, UplinkError* error) {
+    if (error != NULL) {
+        work_data->codes[index] = error->code != 0 ? error->code : UPLINK_ERROR_INTERNAL;
+        work_data->messages[index] = strdup(error->message ? error->message : "operation failed");
+    }
+}
+
+/** Mark pairs never attempted because the call was aborted */
+static void object_pairs_set_cancelled(ObjectPairBatchData* work_data, size_t attempted) {
+    for (size_t i = attempted; i < work_data->pair_count; i++) {
+        work_data->codes[i] = cancel_token_code(work_data->cancel);
+        work_data->messages[i] = strdup(cancel_token_message(work_data->cancel));
+    }
+}
+
+static void copy_objects_item(void* job, UplinkProject* project, size_t index) {
+    ObjectPairBatchData* work_data = (ObjectPairBatchData*)job;
+    char** pair = &work_data->pairs[index * 4];
+    UplinkObjectResult result = uplink_copy_object(project, pair[0], pair[1], pair[2], pair[3], NULL);
+    object_pairs_set_result(work_data, index, result.error);
+    uplink_free_object_result(result);
+}
+
+static void move_objects_item(void* job, UplinkProject* project, size_t index) {
+    ObjectPairBatchData* work_data = (ObjectPairBatchData*)job;
+    char** pair = &work_data->pairs[index * 4];
+    UplinkError* error = uplink_move_object(project, pair[0], pair[1], pair[2], pair[3], NULL);
+    object_pairs_set_result(work_data, index, error);
+    uplink_free_error(error);
+}
+
+void copy_objects_execute(napi_env env, void* data) {
+    (void)env;
+    ObjectPairBatchData* work_data = (ObjectPairBatchData*)data;
+    
+    LOG_DEBUG("copyObjects: %zu pairs, concurrency=%u (worker thread)",
+              work_data->pair_count, work_data->concurrency);
+    
+    size_t attempted = object_batch_run(work_data, copy_objects_item, work_data->cancel, work_data->project_handle,
+                                        work_data->pair_count, work_data->concurrency, "copyObjects");
+    object_pairs_set_cancelled(work_data, attempted);
+}
+
+void move_objects_execute(napi_env env, void* data) {
+    (void)env;
+    ObjectPairBatchData* work_data = (ObjectPairBatchData*)data;
+    
+    LOG_DEBUG("moveObjects: %zu pairs, concurrency=%u (worker thread)",
+              work_data->pair_count, work_data->concurrency);
+    
+    size_t attempted = object_batch_run(work_data, move_objects_item, work_data->cancel, work_data->project_handle,
+                                        work_data->pair_count, work_data->concurrency, "moveObjects");
+    object_pairs_set_cancelled(work_data, attempted);
+}
+
+/* ========== update_objects_metadata_execute ========== */
+
+static void update_objects_metadata_item(void* job, UplinkProject* project, size_t index) {
+    UpdateMetadataBatchData* work_data = (UpdateMetadataBatchData*)job;
+    UplinkCustomMetadata metadata = work_data->sets[work_data->set_index != NULL ? work_data->set_index[index] : 0];
+    UplinkError* error;
+    for (uint32_t attempt = 1;; attempt++) {
+        error = uplink_update_object_metadata(project, work_data->bucket_name, work_data->keys[index], metadata, NULL);
+        if (error == NULL ||
+            !retry_backoff(&work_data->retry, attempt, error->code, work_data->cancel, "updateObjectsMetadata")) {
+            break;
+        }
+        uplink_free_error(error);
+    }
+    if (error != NULL) {
+        work_data->codes[index] = error->code != 0 ? error->code : UPLINK_ERROR_INTERNAL;
+        work_data->messages[index] = strdup(error->message ? error->message : "operation failed");
+        uplink_free_error(error);
+    }
+}
+
+void update_objects_metadata_execute(napi_env env, void* data) {
+    (void)env;
+    UpdateMetadataBatchData* work_data = (UpdateMetadataBatchData*)data;
+    
+    LOG_DEBUG("updateObjectsMetadata: %zu keys in '%s' with %zu metadata sets, concurrency=%u (worker thread)",
+              work_data->key_count, work_data->bucket_name, work_data->set_count, work_data->concurrency);
+    
+    size_t attempted = object_batch_run(work_data, update_objects_metadata_item, work_data->cancel,
+                                        work_data->project_handle, work_data->key_count, work_data->concurrency,
+                                        "updateObjectsMetadata");
+    for (size_t i = attempted; i < work_data->key_count; i++) {
+        work_data->codes[i] = cancel_token_code(work_data->cancel);
+        work_data->messages[i] = strdup(cancel_token_message(work_data->cancel));
+    }
+}
+
+/* ========== delete_prefix_execute ========== */
+
+/**
+ * Bounded key queue between the lister (the async work thread) and the
+ * deletion threads. Keys are owned by the queue until a worker pops them.
+ */
+typedef struct {
+    DeletePrefixData* job;
+    UplinkProject project;
+    uv_mutex_t lock;
+    uv_cond_t not_empty;
+    uv_cond_t not_full;
+    char** ring;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    bool done;                  /* Lister finished; workers drain and exit */
+} DeletePrefixQueue;
+
+/** Delete one key and account for the outcome (takes the lock for counters) */
+static void delete_prefix_one(DeletePrefixQueue* queue, char* key) {
+    DeletePrefixData* job = queue->job;
+    if (cancel_token_is_cancelled(job->cancel)) {
+        free(key);          /* Aborted: drop what is still queued */
+        return;
+    }
+    UplinkObjectResult result = uplink_delete_object(&queue->project, job->bucket_name, key);
+    
+    uv_mutex_lock(&queue->lock);
+    if (result.error == NULL) {
+        if (result.object != NULL) job->deleted++; else job->missing++;
+    } else if (result.error->code == UPLINK_ERROR_OBJECT_NOT_FOUND) {
+        job->missing++;
+    } else {
+        job->failed++;
+        if (job->failure_count < DELETE_PREFIX_MAX_FAILURES) {
+            DeletePrefixFailure* failure = &job->failures[job->failure_count++];
+            failure->key = key;
+            failure->code = result.error->code;
+            failure->message = strdup(result.error->message ? result.error->message : "deleteObject failed");
+            key = NULL;         /* Owned by the failure record */
+        }
+    }
+    uv_mutex_unlock(&queue->lock);
+    
+    uplink_free_object_result(result);
+    free(key);
+}
+
+static void delete_prefix_worker(void* arg) {
+    DeletePrefixQueue* queue = (DeletePrefixQueue*)arg;
+    
+    for (;;) {
+        uv_mutex_lock(&queue->lock);
+        while (queue->count == 0 && !queue->done) {
+            uv_cond_wait(&queue->not_empty, &queue->lock);
+        }
+        if (queue->count == 0) {
+            uv_mutex_unlock(&queue->lock);
+            break;
+        }
+        char* key = queue->ring[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->count--;
+        uv_cond_signal(&queue->not_full);
+        uv_mutex_unlock(&queue->lock);
+        
+        delete_prefix_one(queue, key);
+    }
+}
+
+static void delete_prefix_push(DeletePrefixQueue* queue, char* key) {
+    uv_mutex_lock(&queue->lock);
+    while (queue->count == queue->capacity) {
+        uv_cond_wait(&queue->not_full, &queue->lock);
+    }
+    queue->ring[(queue->head + queue->count) % queue->capacity] = key;
+    queue->count++;
+    uv_cond_signal(&queue->not_empty);
+    uv_mutex_unlock(&queue->lock);
+}
+
+static void delete_prefix_set_error(DeletePrefixData* work_data, int32_t code, const char* message) {
+    work_data->error_code = code;
+    work_data->error_message = strdup(message ? message : "deletePrefix failed");
+}
+
+void delete_prefix_execute(napi_env env, void* data) {
+    (void)env;
+    DeletePrefixData* work_data = (DeletePrefixData*)data;
+    
+    LOG_DEBUG("deletePrefix: '%s/%s' concurrency=%u dryRun=%d (worker thread)",
+              work_data->bucket_name, work_data->prefix, work_data->concurrency, work_data->dry_run);
+    
+    DeletePrefixQueue queue;
+    memset(&queue, 0, sizeof(queue));
+    queue.job = work_data;
+    queue.project._handle = work_data->project_handle;
+    queue.capacity = (size_t)work_data->concurrency * DELETE_PREFIX_QUEUE_PER_WORKER;
+    queue.ring = (char**)malloc(queue.capacity * sizeof(char*));
+    work_data->failures = (DeletePrefixFailure*)calloc(DELETE_PREFIX_MAX_FAILURES, sizeof(DeletePrefixFailure));
+    if (queue.ring == NULL || work_data->failures == NULL) {
+        free(queue.ring);
+        delete_prefix_set_error(work_data, UPLINK_ERROR_INTERNAL, "Out of memory");
+        return;
+    }
+    uv_mutex_init(&queue.lock);
+    uv_cond_init(&queue.not_empty);
+    uv_cond_init(&queue.not_full);
+    
+    /* Start deletion threads; with none, this thread deletes inline */
+    uv_thread_t* threads = NULL;
+    uint32_t started = 0;
+    if (!work_data->dry_run) {
+        threads = (uv_thread_t*)calloc(work_data->concurrency, sizeof(uv_thread_t));
+        for (uint32_t i = 0; threads != NULL && i < work_data->concurrency; i++) {
+            if (uv_thread_create(&threads[i], delete_prefix_worker, &queue) != 0) {
+                LOG_WARN("deletePrefix: could only start %u of %u threads", started, work_data->concurrency);
+                break;
+            }
+            started++;
+        }
+    }
+    
+    UplinkListObjectsOptions options = { 0 };
+    options.prefix = work_data->prefix;
+    options.recursive = true;
+    
+    UplinkObjectIterator* iterator = uplink_list_objects(&queue.project, work_data->bucket_name, &options);
+    while (iterator != NULL && uplink_object_iterator_next(iterator)) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+            break;
+        }
+        UplinkObject* object = uplink_object_iterator_item(iterator);
+        if (object == NULL) {
+            continue;
+        }
+        char* key = object->is_prefix ? NULL : strdup(object->key);
+        bool skip = object->is_prefix;
+        uplink_free_object(object);
+        if (skip) {
+            continue;
+        }
+        if (key == NULL) {
+            delete_prefix_set_error(work_data, UPLINK_ERROR_INTERNAL, "Out of memory");
+            break;
+        }
+        
+        work_data->listed++;
+        if (work_data->dry_run) {
+            free(key);
+        } else if (started > 0) {
+            delete_prefix_push(&queue, key);
+        } else {
+            delete_prefix_one(&queue, key);
+        }
+    }
+    
+    if (iterator != NULL) {
+        UplinkError* error = uplink_object_iterator_err(iterator);
+        if (error != NULL) {
+            if (work_data->error_code == 0) {
+                delete_prefix_set_error(work_data, error->code, error->message);
+            }
+            uplink_free_error(error);
+        }
+        uplink_free_object_iterator(iterator);
+    } else if (work_data->error_code == 0) {
+        delete_prefix_set_error(work_data, UPLINK_ERROR_INTERNAL, "Failed to list objects");
+    }
+    
+    /* Let the workers drain the queue, then stop */
+    uv_mutex_lock(&queue.lock);
+    queue.done = true;
+    uv_cond_broadcast(&queue.not_empty);
+    uv_mutex_unlock(&queue.lock);
+    for (uint32_t i = 0; i < started; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    free(threads);
+    
+    uv_cond_destroy(&queue.not_full);
+    uv_cond_destroy(&queue.not_empty);
+    uv_mutex_destroy(&queue.lock);
+    free(queue.ring);
+}
+
+/* ========== export_listing_execute ========== */
+
+/** Buffered sequential writer over file_write_at */
+typedef struct {
+    int fd;
+    uint8_t* buffer;
+    size_t used;
+    int64_t offset;
+    bool failed;                    /* A write failed; errno is set */
+} ListingWriter;
+
+static void writer_flush(ListingWriter* writer) {
+    if (writer->used == 0 || writer->failed) {
+        return;
+    }
+    if (file_write_at(writer->fd, writer->buffer, writer->used, writer->offset) < 0) {
+        writer->failed = true;
+        return;
+    }
+    writer->offset += (int64_t)writer->used;
+    writer->used = 0;
+}
+
+static void writer_put(ListingWriter* writer, const void* data, size_t length) {
+    if (writer->used + length > EXPORT_LISTING_BUFFER_SIZE) {
+        writer_flush(writer);
+        if (length > EXPORT_LISTING_BUFFER_SIZE && !writer->failed) {
+            if (file_write_at(writer->fd, data, length, writer->offset) < 0) {
+                writer->failed = true;
+            } else {
+                writer->offset += (int64_t)length;
+            }
+            return;
+        }
+    }
+    if (!writer->failed) {
+        memcpy(writer->buffer + writer->used, data, length);
+        writer->used += length;
+    }
+}
+
+static void writer_puts(ListingWriter* writer, const char* text) {
+    writer_put(writer, text, strlen(text));
+}
+
+static void writer_u32(ListingWriter* writer, uint32_t value) {
+    uint8_t bytes[4];
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (uint8_t)(value >> (8 * i));
+    }
+    writer_put(writer, bytes, sizeof(bytes));
+}
+
+static void writer_i64(ListingWriter* writer, int64_t value) {
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (uint8_t)((uint64_t)value >> (8 * i));
+    }
+    writer_put(writer, bytes, sizeof(bytes));
+}
+
+/** Write a JSON string literal; bytes >= 0x80 pass through as UTF-8 */
+static void writer_json_string(ListingWriter* writer, const char* text, size_t length) {
+    static const char hex[] = "0123456789abcdef";
+    writer_put(writer, "\"", 1);
+    size_t start = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t c = (uint8_t)text[i];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        writer_put(writer, text + start, i - start);
+        char escape[6] = { '\\', (char)c, 0, 0, 0, 0 };
+        size_t escape_length = 2;
+        if (c == '\n') {
+            escape[1] = 'n';
+        } else if (c == '\r') {
+            escape[1] = 'r';
+        } else if (c == '\t') {
+            escape[1] = 't';
+        } else if (c < 0x20) {
+            escape[1] = 'u';
+            escape[2] = '0';
+            escape[3] = '0';
+            escape[4] = hex[c >> 4];
+            escape[5] = hex[c & 15];
+            escape_length = 6;
+        }
+        writer_put(writer, escape, escape_length);
+        start = i + 1;
+    }
+    writer_put(writer, text + start, length - start);
+    writer_put(writer, "\"", 1);
+}
+
+static void write_ndjson_record(ListingWriter* writer, const ExportListingData* work_data,
+                                const UplinkObject* object) {
+    char number[96];
+    writer_puts(writer, "{\"key\":");
+    writer_json_string(writer, object->key, strlen(object->key));
+    writer_puts(writer, object->is_prefix ? ",\"isPrefix\":true" : ",\"isPrefix\":false");
+    if (work_data->include_system) {
+        char expires[24] = "null";
+        if (object->system.expires != 0) {
+            snprintf(expires, sizeof(expires), "%lld", (long long)object->system.expires);
+        }
+        snprintf(number, sizeof(number), ",\"system\":{\"created\":%lld,\"expires\":%s,\"contentLength\":%lld}",
+                 (long long)object->system.created, expires, (long long)object->system.content_length);
+        writer_puts(writer, number);
+    }
+    if (work_data->include_custom) {
+        writer_puts(writer, ",\"custom\":{");
+        for (size_t i = 0; i < object->custom.count; i++) {
+            const UplinkCustomMetadataEntry* entry = &object->custom.entries[i];
+            if (i > 0) {
+                writer_put(writer, ",", 1);
+            }
+            writer_json_string(writer, entry->key, entry->key_length);
+            writer_put(writer, ":", 1);
+            writer_json_string(writer, entry->value, entry->value_length);
+        }
+        writer_put(writer, "}", 1);
+    }
+    writer_puts(writer, "}\n");
+}
+
+static void write_binary_record(ListingWriter* writer, const ExportListingData* work_data,
+                                const UplinkObject* object) {
+    uint8_t flags = (uint8_t)((object->is_prefix ? 1u : 0u) | (work_data->include_custom ? 2u : 0u));
+    writer_put(writer, &flags, 1);
+    writer_i64(writer, object->system.created);
+    writer_i64(writer, object->system.expires);
+    writer_i64(writer, object->system.content_length);
+    size_t key_length = strlen(object->key);
+    writer_u32(writer, (uint32_t)key_length);
+    writer_put(writer, object->key, key_length);
+    if (work_data->include_custom) {
+        writer_u32(writer, (uint32_t)object->custom.count);
+        for (size_t i = 0; i < object->custom.count; i++) {
+            const UplinkCustomMetadataEntry* entry = &object->custom.entries[i];
+            writer_u32(writer, (uint32_t)entry->key_length);
+            writer_put(writer, entry->key, entry->key_length);
+            writer_u32(writer, (uint32_t)entry->value_length);
+            writer_put(writer, entry->value, entry->value_length);
+        }
+    }
+}
+
+/**
+ * Record an error for export_listing unless one is set. Takes ownership
+ * of @p error when given, otherwise formats @p fallback with strerror(errno).
+ */
+static void export_listing_set_error(ExportListingData* work_data, UplinkError* error, const char* fallback) {
+    if (work_data->error_code != 0) {
+        uplink_free_error(error);
+        return;
+    }
+    if (error != NULL) {
+        work_data->error_code = error->code;
+        work_data->error_message = strdup(error->message ? error->message : "unknown error");
+        uplink_free_error(error);
+        return;
+    }
+    
+    const char* reason = strerror(errno);
+    size_t len = strlen(fallback) + strlen(work_data->file_path) + strlen(reason) + 8;
+    work_data->error_code = UPLINK_ERROR_INTERNAL;
+    work_data->error_message = (char*)malloc(len);
+    if (work_data->error_message != NULL) {
+        snprintf(work_data->error_message, len, "%s '%s': %s", fallback, work_data->file_path, reason);
+    }
+}
+
+void export_listing_execute(napi_env env, void* data) {
+    (void)env;
+    ExportListingData* work_data = (ExportListingData*)data;
+    
+    LOG_DEBUG("exportListing: '%s/%s' to '%s' (worker thread)",
+              work_data->bucket_name, work_data->prefix ? work_data->prefix : "", work_data->file_path);
+    
+    ListingWriter writer = { .fd = -1 };
+    writer.buffer = (uint8_t*)buffer_pool_acquire(EXPORT_LISTING_BUFFER_SIZE);
+    if (writer.buffer == NULL) {
+        errno = ENOMEM;
+        export_listing_set_error(work_data, NULL, "cannot allocate buffer for");
+        return;
+    }
+    writer.fd = file_open_write(work_data->file_path, 1);
+    if (writer.fd < 0) {
+        export_listing_set_error(work_data, NULL, "cannot open file");
+        buffer_pool_release(writer.buffer);
+        return;
+    }
+    if (work_data->format == EXPORT_LISTING_BINARY) {
+        writer_put(&writer, "ULX1", 4);
+    }
+    
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkListObjectsOptions options = { 0 };
+    options.prefix = work_data->prefix;
+    options.recursive = work_data->recursive;
+    options.system = work_data->include_system;
+    options.custom = work_data->include_custom;
+    
+    UplinkObjectIterator* iterator = uplink_list_objects(&project, work_data->bucket_name, &options);
+    while (iterator != NULL && !writer.failed && uplink_object_iterator_next(iterator)) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+            break;
+        }
+        UplinkObject* object = uplink_object_iterator_item(iterator);
+        if (object == NULL) {
+            continue;
+        }
+        if (work_data->format == EXPORT_LISTING_BINARY) {
+            write_binary_record(&writer, work_data, object);
+        } else {
+            write_ndjson_record(&writer, work_data, object);
+        }
+        if (object->is_prefix) {
+            work_data->prefixes++;
+        } else {
+            work_data->objects++;
+            work_data->content_length += (uint64_t)object->system.content_length;
+        }
+        uplink_free_object(object);
+    }
+    
+    if (iterator != NULL) {
+        UplinkError* error = uplink_object_iterator_err(iterator);
+        if (error != NULL) {
+            export_listing_set_error(work_data, error, NULL);
+        }
+        uplink_free_object_iterator(iterator);
+    } else if (work_data->error_code == 0) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("Failed to list objects");
+    }
+    
+    writer_flush(&writer);
+    if (writer.failed) {
+        export_listing_set_error(work_data, NULL, "cannot write file");
+    } else if (work_data->error_code == 0 && work_data->fsync && file_sync(writer.fd) != 0) {
+        export_listing_set_error(work_data, NULL, "cannot sync file");
+    }
+    work_data->bytes_written = (uint64_t)writer.offset;
+    file_close(writer.fd);
+    buffer_pool_release(writer.buffer);
 }
 
 /* ========== delete_object_execute ========== */
@@ -63,6 +731,22 @@ void list_objects_create_execute(napi_env env, void* data) {
 
 /* ========== objectIteratorNext execute ========== */
 
+/**
+ * Whether @p object lies past the iterator's end key; marks the listing
+ * ended when it does
+ */
+static bool object_past_end(ObjectIteratorState* state, const UplinkObject* object) {
+    if (state == NULL || state->end_key == NULL || strcmp(object->key, state->end_key) <= 0) {
+        return false;
+    }
+    state->ended = true;
+    return true;
+}
+
+static bool object_iterator_ended(const ObjectIteratorState* state) {
+    return state != NULL && state->ended;
+}
+
 void object_iterator_next_execute(napi_env env, void* data) {
     (void)env;
     ObjectIteratorNextData* work_data = (ObjectIteratorNextData*)data;
@@ -70,11 +754,115 @@ void object_iterator_next_execute(napi_env env, void* data) {
     LOG_DEBUG("objectIteratorNext: advancing iterator (worker thread)");
     
     UplinkObjectIterator* iterator = (UplinkObjectIterator*)work_data->iterator_handle;
-    work_data->has_next = uplink_object_iterator_next(iterator);
+    work_data->has_next = !object_iterator_ended(work_data->state) && uplink_object_iterator_next(iterator);
+    if (work_data->has_next && work_data->state != NULL && work_data->state->end_key != NULL) {
+        /* Read the item now so the end key is honoured; objectIteratorItem hands it out */
+        ObjectIteratorState* state = work_data->state;
+        uplink_free_object(state->peeked);
+        state->peeked = uplink_object_iterator_item(iterator);
+        if (state->peeked != NULL && object_past_end(state, state->peeked)) {
+            uplink_free_object(state->peeked);
+            state->peeked = NULL;
+            work_data->has_next = false;
+        }
+    }
     
     LOG_DEBUG("objectIteratorNext: has_next=%d", work_data->has_next);
 }
 
+/* ========== objectIteratorNextBatch execute ========== */
+
+void object_iterator_next_batch_execute(napi_env env, void* data) {
+    (void)env;
+    ObjectIteratorBatchData* work_data = (ObjectIteratorBatchData*)data;
+    
+    UplinkObjectIterator* iterator = (UplinkObjectIterator*)work_data->iterator_handle;
+    while (work_data->count < work_data->max_items && !object_iterator_ended(work_data->state) &&
+           uplink_object_iterator_next(iterator)) {
+        UplinkObject* object = uplink_object_iterator_item(iterator);
+        if (object != NULL && object_past_end(work_data->state, object)) {
+            uplink_free_object(object);
+        } else if (object != NULL) {
+            work_data->objects[work_data->count++] = object;
+        }
+    }
+    
+    LOG_DEBUG("objectIteratorNextBatch: collected %zu of %zu items (worker thread)",
+              work_data->count, work_data->max_items);
+}
+
+/* ========== objectIteratorNextColumns execute ========== */
+
+void object_iterator_next_columns_execute(napi_env env, void* data) {
+    (void)env;
+    ObjectIteratorColumnsData* work_data = (ObjectIteratorColumnsData*)data;
+    
+    UplinkObject** objects = (UplinkObject**)calloc(work_data->max_items, sizeof(UplinkObject*));
+    if (objects == NULL) {
+        work_data->out_of_memory = true;
+        return;
+    }
+    
+    UplinkObjectIterator* iterator = (UplinkObjectIterator*)work_data->iterator_handle;
+    size_t count = 0;
+    size_t key_bytes = 0;
+    while (count < work_data->max_items && !object_iterator_ended(work_data->state) &&
+           uplink_object_iterator_next(iterator)) {
+        UplinkObject* object = uplink_object_iterator_item(iterator);
+        if (object != NULL && object_past_end(work_data->state, object)) {
+            uplink_free_object(object);
+        } else if (object != NULL) {
+            key_bytes += strlen(object->key);
+            objects[count++] = object;
+        }
+    }
+    if (count > 0) {
+        work_data->last_key = strdup(objects[count - 1]->key);
+    }
+    
+    size_t block_size = count * (sizeof(int64_t) + 2 * sizeof(double))
+                      + (count + 1) * sizeof(uint32_t) + (count + 7) / 8 + key_bytes;
+    uint8_t* block = (uint8_t*)calloc(1, block_size > 0 ? block_size : 1);
+    if (block == NULL) {
+        work_data->out_of_memory = true;
+    } else {
+        int64_t* content_length = (int64_t*)block;
+        double* created = (double*)(content_length + count);
+        double* expires = created + count;
+        uint32_t* key_offsets = (uint32_t*)(expires + count);
+        uint8_t* is_prefix = (uint8_t*)(key_offsets + count + 1);
+        uint8_t* keys = is_prefix + (count + 7) / 8;
+        
+        uint32_t offset = 0;
+        for (size_t i = 0; i < count; i++) {
+            const UplinkObject* object = objects[i];
+            size_t key_len = strlen(object->key);
+            content_length[i] = object->system.content_length;
+            created[i] = (double)object->system.created;
+            expires[i] = (double)object->system.expires;
+            if (object->is_prefix) {
+                is_prefix[i / 8] |= (uint8_t)(1u << (i % 8));
+            }
+            key_offsets[i] = offset;
+            memcpy(keys + offset, object->key, key_len);
+            offset += (uint32_t)key_len;
+        }
+        key_offsets[count] = offset;
+        
+        work_data->block = block;
+        work_data->block_size = block_size;
+        work_data->key_bytes = key_bytes;
+    }
+    work_data->count = count;
+    
+    for (size_t i = 0; i < count; i++) {
+        uplink_free_object(objects[i]);
+    }
+    free(objects);
+    
+    LOG_DEBUG("objectIteratorNextColumns: packed %zu items, %zu key bytes (worker thread)", count, key_bytes);
+}
+
 /* ========== objectIteratorItem execute ========== */
 
 void object_iterator_item_execute(napi_env env, void* data) {
@@ -84,6 +872,11 @@ void object_iterator_item_execute(napi_env env, void* data) {
     LOG_DEBUG("objectIteratorItem: getting current item (worker thread)");
     
     UplinkObjectIterator* iterator = (UplinkObjectIterator*)work_data->iterator_handle;
+    if (work_data->state != NULL && work_data->state->peeked != NULL) {
+        work_data->object = work_data->state->peeked;
+        work_data->state->peeked = NULL;
+        return;
+    }
     work_data->object = uplink_object_iterator_item(iterator);
 }
 
@@ -13,6 +13,36 @@
  */
 void stat_object_execute(napi_env env, void* data);
 
+/**
+ * @brief Execute stat_objects on worker thread (fans out to native threads)
+ */
+void stat_objects_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute delete_objects on worker thread (fans out to native threads)
+ */
+void delete_objects_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute copy_objects on worker thread (fans out to native threads)
+ */
+void copy_objects_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute move_objects on worker thread (fans out to native threads)
+ */
+void move_objects_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute delete_prefix on worker thread (lists and feeds native deletion threads)
+ */
+void delete_prefix_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute export_listing on worker thread (lists into a buffered file writer)
+ */
+void export_listing_execute(napi_env env, void* data);
+
 /**
  * @brief Execute delete_object on worker thread
  */
@@ -28,6 +58,16 @@ void list_objects_create_execute(napi_env env, void* data);
  */
 void object_iterator_next_execute(napi_env env, void* data);
 
+/**
+ * @brief Execute object_iterator_next_batch on worker thread
+ */
+void object_iterator_next_batch_execute(napi_env env, void* data);
+
+/**
+ * @brief Execute object_iterator_next_columns on worker thread
+ */
+void object_iterator_next_columns_execute(napi_env env, void* data);
+
 /**
  * @brief Execute object_iterator_item on worker thread
  */
@@ -58,4 +98,9 @@ void move_object_execute(napi_env env, void* data);
  */
 void update_object_metadata_execute(napi_env env, void* data);
 
+/**
+ * @brief Execute update_objects_metadata on worker thread (fans out to native threads)
+ */
+void update_objects_metadata_execute(napi_env env, void* data);
+
 #endif /* OBJECT_EXECUTE_H */
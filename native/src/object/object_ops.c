@@ -16,16 +16,37 @@
 #include "../common/string_helpers.h"
 #include "../common/type_converters.h"
 #include "../common/object_converter.h"
+#include "../common/result_helpers.h"
+#include "../common/stat_cache.h"
+#include "../common/thread_pool.h"
+#include "../common/admission.h"
+#include "../common/cancel_token.h"
+#include "../common/retry.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * Field mask of an object iterator, from the state attached by listObjectsCreate
+ */
+static uint32_t get_iterator_fields(const HandleWrapper* wrapper) {
+    const ObjectIteratorState* state = (const ObjectIteratorState*)wrapper->attachment;
+    return state != NULL ? state->fields : OBJECT_FIELDS_ALL;
+}
+
+/**
+ * Checkpoint and end key state of an object iterator, or NULL
+ */
+static ObjectIteratorState* get_iterator_state(const HandleWrapper* wrapper) {
+    return (ObjectIteratorState*)wrapper->attachment;
+}
+
 /* ========== stat_object ========== */
 
 napi_value stat_object(napi_env env, napi_callback_info info) {
-    size_t argc = 3;
-    napi_value argv[3];
+    size_t argc = 4;
+    napi_value argv[4];
     
     napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
     
@@ -46,22 +67,38 @@ napi_value stat_object(napi_env env, napi_callback_info info) {
     char* bucket_name = NULL;
     char* object_key = NULL;
     
-    status = extract_string_required(env, argv[1], "bucket", &bucket_name);
+    status = extract_bucket_name(env, argv[1], "bucket", &bucket_name);
     if (status != napi_ok) {
         return NULL;
     }
     
     status = extract_string_required(env, argv[2], "key", &object_key);
     if (status != napi_ok) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
+        return NULL;
+    }
+    
+    RetryPolicy retry;
+    if (retry_policy_option(env, argc > 3 ? argv[3] : NULL, &retry) != 0) {
+        bucket_name_release(bucket_name);
+        free(object_key);
         return NULL;
     }
     
+    /* Served from the project's metadata cache when enabled and fresh */
+    const UplinkObject* cached = stat_cache_lookup(project_handle, bucket_name, object_key);
+    if (cached != NULL) {
+        LOG_DEBUG("statObject: cache hit for '%s/%s'", bucket_name, object_key);
+        bucket_name_release(bucket_name);
+        free(object_key);
+        return create_resolved_promise(env, uplink_object_to_js(env, (UplinkObject*)cached));
+    }
+    
     LOG_DEBUG("statObject: queuing async work for '%s/%s'", bucket_name, object_key);
     
     ObjectOpData* work_data = (ObjectOpData*)calloc(1, sizeof(ObjectOpData));
     if (work_data == NULL) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
@@ -70,6 +107,8 @@ napi_value stat_object(napi_env env, napi_callback_info info) {
     work_data->project_handle = project_handle;
     work_data->bucket_name = bucket_name;
     work_data->object_key = object_key;
+    work_data->cache_epoch = stat_cache_epoch(project_handle);
+    work_data->retry = retry;
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
@@ -77,15 +116,463 @@ napi_value stat_object(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "statObject", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    work_data->cancel = cancel_token_from_options(env, argc > 3 ? argv[3] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 3 ? argv[3] : NULL, THREAD_POOL_LANE_METADATA);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
         stat_object_execute,
         stat_object_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/**
+ * Copy a JS array of object keys into a malloc'd string array.
+ * Throws a TypeError and returns -1 on a non-array or non-string element.
+ */
+static int extract_key_array(napi_env env, napi_value js_keys, char*** out_keys, size_t* out_count) {
+    bool is_array = false;
+    napi_is_array(env, js_keys, &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "keys must be an array of strings");
+        return -1;
+    }
+    
+    uint32_t length = 0;
+    napi_get_array_length(env, js_keys, &length);
+    char** keys = (char**)calloc(length > 0 ? length : 1, sizeof(char*));
+    if (keys == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return -1;
+    }
+    
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element;
+        napi_get_element(env, js_keys, i, &element);
+        if (extract_string_required(env, element, "keys[]", &keys[i]) != napi_ok) {
+            free_string_array(keys, i);
+            return -1;
+        }
+    }
+    
+    *out_keys = keys;
+    *out_count = length;
+    return 0;
+}
+
+/**
+ * Read options.concurrency for a batched call, clamped to the native limit.
+ * Throws a TypeError and returns -1 when it is not a positive integer.
+ */
+static int get_batch_concurrency(napi_env env, napi_value options, uint32_t* out) {
+    int64_t concurrency = OBJECT_BATCH_DEFAULT_CONCURRENCY;
+    napi_valuetype type = napi_undefined;
+    if (options != NULL) {
+        napi_typeof(env, options, &type);
+    }
+    if (type == napi_object) {
+        concurrency = get_int64_property(env, options, "concurrency", OBJECT_BATCH_DEFAULT_CONCURRENCY);
+    }
+    if (concurrency < 1) {
+        napi_throw_type_error(env, NULL, "concurrency must be a positive integer");
+        return -1;
+    }
+    *out = concurrency > OBJECT_BATCH_MAX_CONCURRENCY ? OBJECT_BATCH_MAX_CONCURRENCY : (uint32_t)concurrency;
+    return 0;
+}
+
+/**
+ * Parse [projectHandle, bucket, keys, options?] and queue a batched
+ * per-key operation. Shared by statObjects and deleteObjects.
+ */
+static napi_value queue_object_batch(napi_env env, napi_callback_info info, const char* name,
+                                     napi_async_execute_callback execute,
+                                     napi_async_complete_callback complete) {
+    size_t argc = 4;
+    napi_value argv[4] = { NULL, NULL, NULL, NULL };
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 3) {
+        napi_throw_type_error(env, NULL, "projectHandle, bucket, and keys are required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    uint32_t concurrency;
+    RetryPolicy retry;
+    if (get_batch_concurrency(env, argc > 3 ? argv[3] : NULL, &concurrency) != 0 ||
+        retry_policy_option(env, argc > 3 ? argv[3] : NULL, &retry) != 0) {
+        return NULL;
+    }
+    
+    char* bucket_name = NULL;
+    status = extract_bucket_name(env, argv[1], "bucket", &bucket_name);
+    if (status != napi_ok) {
+        return NULL;
+    }
+    
+    char** keys = NULL;
+    size_t key_count = 0;
+    if (extract_key_array(env, argv[2], &keys, &key_count) != 0) {
+        bucket_name_release(bucket_name);
+        return NULL;
+    }
+    
+    LOG_DEBUG("%s: queuing async work for %zu keys in '%s'", name, key_count, bucket_name);
+    
+    ObjectBatchData* work_data = (ObjectBatchData*)calloc(1, sizeof(ObjectBatchData));
+    UplinkObjectResult* results = (UplinkObjectResult*)calloc(key_count > 0 ? key_count : 1,
+                                                              sizeof(UplinkObjectResult));
+    if (work_data == NULL || results == NULL) {
+        free(work_data);
+        free(results);
+        free_string_array(keys, key_count);
+        bucket_name_release(bucket_name);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->bucket_name = bucket_name;
+    work_data->keys = keys;
+    work_data->key_count = key_count;
+    work_data->concurrency = concurrency;
+    work_data->cache_epoch = stat_cache_epoch(project_handle);
+    work_data->retry = retry;
+    work_data->results = results;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, argc > 3 ? argv[3] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 3 ? argv[3] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
+        execute,
+        complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== stat_objects ========== */
+
+napi_value stat_objects(napi_env env, napi_callback_info info) {
+    return queue_object_batch(env, info, "statObjects", stat_objects_execute, stat_objects_complete);
+}
+
+/* ========== delete_objects ========== */
+
+napi_value delete_objects(napi_env env, napi_callback_info info) {
+    return queue_object_batch(env, info, "deleteObjects", delete_objects_execute, delete_objects_complete);
+}
+
+/* ========== copy_objects / move_objects ========== */
+
+/**
+ * Parse [projectHandle, pairs, options?] and queue a batched copy or move.
+ */
+static napi_value queue_object_pairs(napi_env env, napi_callback_info info, bool move) {
+    const char* name = move ? "moveObjects" : "copyObjects";
+    static const char* const fields[4] = { "oldBucket", "oldKey", "newBucket", "newKey" };
+    size_t argc = 3;
+    napi_value argv[3] = { NULL, NULL, NULL };
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "projectHandle and pairs are required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    uint32_t concurrency;
+    if (get_batch_concurrency(env, argc > 2 ? argv[2] : NULL, &concurrency) != 0) {
+        return NULL;
+    }
+    
+    bool is_array = false;
+    napi_is_array(env, argv[1], &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "pairs must be an array");
+        return NULL;
+    }
+    uint32_t pair_count = 0;
+    napi_get_array_length(env, argv[1], &pair_count);
+    
+    ObjectPairBatchData* work_data = (ObjectPairBatchData*)calloc(1, sizeof(ObjectPairBatchData));
+    size_t slots = pair_count > 0 ? pair_count : 1;
+    if (work_data != NULL) {
+        work_data->pairs = (char**)calloc(slots * 4, sizeof(char*));
+        work_data->codes = (int32_t*)calloc(slots, sizeof(int32_t));
+        work_data->messages = (char**)calloc(slots, sizeof(char*));
+    }
+    if (work_data == NULL || work_data->pairs == NULL || work_data->codes == NULL || work_data->messages == NULL) {
+        if (work_data != NULL) {
+            free(work_data->pairs);
+            free(work_data->codes);
+            free(work_data->messages);
+            free(work_data);
+        }
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    for (uint32_t i = 0; i < pair_count; i++) {
+        napi_value pair;
+        napi_valuetype type;
+        napi_get_element(env, argv[1], i, &pair);
+        napi_typeof(env, pair, &type);
+        bool valid = type == napi_object;
+        for (int f = 0; valid && f < 4; f++) {
+            char* value = get_string_property(env, pair, fields[f]);
+            work_data->pairs[i * 4 + f] = value;
+            valid = value != NULL && value[0] != '\0';
+        }
+        if (!valid) {
+            free_string_array(work_data->pairs, (size_t)pair_count * 4);
+            free(work_data->codes);
+            free(work_data->messages);
+            free(work_data);
+            napi_throw_type_error(env, NULL, "each pair needs non-empty oldBucket, oldKey, newBucket, and newKey strings");
+            return NULL;
+        }
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->pair_count = pair_count;
+    work_data->concurrency = concurrency;
+    work_data->move = move;
+    
+    LOG_DEBUG("%s: queuing async work for %u pairs", name, pair_count);
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, argc > 2 ? argv[2] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 2 ? argv[2] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
+        move ? move_objects_execute : copy_objects_execute,
+        object_pairs_complete,
+        work_data,
+        &work_data->work, NULL
     );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+napi_value copy_objects(napi_env env, napi_callback_info info) {
+    return queue_object_pairs(env, info, false);
+}
+
+napi_value move_objects(napi_env env, napi_callback_info info) {
+    return queue_object_pairs(env, info, true);
+}
+
+/* ========== delete_prefix ========== */
+
+napi_value delete_prefix(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4] = { NULL, NULL, NULL, NULL };
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 3) {
+        napi_throw_type_error(env, NULL, "projectHandle, bucket, and prefix are required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    uint32_t concurrency;
+    if (get_batch_concurrency(env, argc > 3 ? argv[3] : NULL, &concurrency) != 0) {
+        return NULL;
+    }
+    bool dry_run = false;
+    if (argc > 3) {
+        napi_valuetype type;
+        napi_typeof(env, argv[3], &type);
+        if (type == napi_object) {
+            dry_run = get_bool_property(env, argv[3], "dryRun", 0) != 0;
+        }
+    }
+    
+    char* bucket_name = NULL;
+    char* prefix = NULL;
+    
+    status = extract_bucket_name(env, argv[1], "bucket", &bucket_name);
+    if (status != napi_ok) {
+        return NULL;
+    }
+    
+    status = extract_string_required(env, argv[2], "prefix", &prefix);
+    if (status != napi_ok) {
+        bucket_name_release(bucket_name);
+        return NULL;
+    }
+    
+    LOG_DEBUG("deletePrefix: queuing async work for '%s/%s'", bucket_name, prefix);
+    
+    DeletePrefixData* work_data = (DeletePrefixData*)calloc(1, sizeof(DeletePrefixData));
+    if (work_data == NULL) {
+        bucket_name_release(bucket_name);
+        free(prefix);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->bucket_name = bucket_name;
+    work_data->prefix = prefix;
+    work_data->concurrency = concurrency;
+    work_data->dry_run = dry_run;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "deletePrefix", NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, argc > 3 ? argv[3] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 3 ? argv[3] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
+        delete_prefix_execute,
+        delete_prefix_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== export_listing ========== */
+
+napi_value export_listing(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4] = { NULL, NULL, NULL, NULL };
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 3) {
+        napi_throw_type_error(env, NULL, "projectHandle, bucket, and path are required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    napi_value options = NULL;
+    if (argc > 3) {
+        napi_valuetype type;
+        napi_typeof(env, argv[3], &type);
+        if (type == napi_object) {
+            options = argv[3];
+        }
+    }
     
-    napi_queue_async_work(env, work_data->work);
+    ExportListingFormat format = EXPORT_LISTING_NDJSON;
+    char* prefix = NULL;
+    if (options != NULL) {
+        char* format_name = get_string_property(env, options, "format");
+        if (format_name != NULL && strcmp(format_name, "binary") == 0) {
+            format = EXPORT_LISTING_BINARY;
+        } else if (format_name != NULL && strcmp(format_name, "ndjson") != 0) {
+            free(format_name);
+            napi_throw_type_error(env, NULL, "format must be 'ndjson' or 'binary'");
+            return NULL;
+        }
+        free(format_name);
+        prefix = get_string_property(env, options, "prefix");
+    }
+    
+    char* bucket_name = NULL;
+    char* file_path = NULL;
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "path", &file_path) != napi_ok) {
+        bucket_name_release(bucket_name);
+        free(prefix);
+        return NULL;
+    }
+    
+    ExportListingData* work_data = (ExportListingData*)calloc(1, sizeof(ExportListingData));
+    if (work_data == NULL) {
+        bucket_name_release(bucket_name);
+        free(file_path);
+        free(prefix);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->bucket_name = bucket_name;
+    work_data->file_path = file_path;
+    work_data->prefix = prefix;
+    work_data->format = format;
+    work_data->include_system = true;
+    if (options != NULL) {
+        work_data->recursive = get_bool_property(env, options, "recursive", 0) != 0;
+        work_data->include_system = get_bool_property(env, options, "includeSystem", 1) != 0;
+        work_data->include_custom = get_bool_property(env, options, "includeCustom", 0) != 0;
+        work_data->fsync = get_bool_property(env, options, "fsync", 0) != 0;
+    }
+    
+    LOG_DEBUG("exportListing: queuing async work for bucket '%s' to '%s'", bucket_name, file_path);
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "exportListing", NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, options);
+    ThreadPoolLane lane = thread_pool_lane_option(env, options, THREAD_POOL_LANE_BULK);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
+        export_listing_execute,
+        export_listing_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
     
     return promise;
 }
@@ -113,14 +600,14 @@ napi_value delete_object(napi_env env, napi_callback_info info) {
     char* bucket_name = NULL;
     char* object_key = NULL;
     
-    status = extract_string_required(env, argv[1], "bucket", &bucket_name);
+    status = extract_bucket_name(env, argv[1], "bucket", &bucket_name);
     if (status != napi_ok) {
         return NULL;
     }
     
     status = extract_string_required(env, argv[2], "key", &object_key);
     if (status != napi_ok) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         return NULL;
     }
     
@@ -128,7 +615,7 @@ napi_value delete_object(napi_env env, napi_callback_info info) {
     
     ObjectOpData* work_data = (ObjectOpData*)calloc(1, sizeof(ObjectOpData));
     if (work_data == NULL) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
@@ -144,16 +631,14 @@ napi_value delete_object(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "deleteObject", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         delete_object_execute,
         delete_object_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -178,7 +663,7 @@ napi_value list_objects_create(napi_env env, napi_callback_info info) {
     }
     
     char* bucket_name = NULL;
-    status = extract_string_required(env, argv[1], "bucket", &bucket_name);
+    status = extract_bucket_name(env, argv[1], "bucket", &bucket_name);
     if (status != napi_ok) {
         return NULL;
     }
@@ -187,7 +672,7 @@ napi_value list_objects_create(napi_env env, napi_callback_info info) {
     
     ListObjectsCreateData* work_data = (ListObjectsCreateData*)calloc(1, sizeof(ListObjectsCreateData));
     if (work_data == NULL) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
     }
@@ -199,6 +684,7 @@ napi_value list_objects_create(napi_env env, napi_callback_info info) {
     work_data->recursive = false;
     work_data->include_system = true;
     work_data->include_custom = false;
+    work_data->fields = OBJECT_FIELDS_ALL;
     work_data->iterator_handle = 0;
     
     /* Parse options if provided */
@@ -207,10 +693,36 @@ napi_value list_objects_create(napi_env env, napi_callback_info info) {
         napi_typeof(env, argv[2], &type);
         if (type == napi_object) {
             work_data->prefix = get_string_property(env, argv[2], "prefix");
-            work_data->cursor = get_string_property(env, argv[2], "cursor");
+            /* A checkpoint is the last key returned, so it resumes exactly like a cursor */
+            work_data->cursor = get_string_property(env, argv[2], "checkpoint");
+            if (work_data->cursor == NULL) {
+                work_data->cursor = get_string_property(env, argv[2], "cursor");
+            }
+            work_data->end_key = get_string_property(env, argv[2], "endKey");
             work_data->recursive = get_bool_property(env, argv[2], "recursive", 0);
             work_data->include_system = get_bool_property(env, argv[2], "system", 1);
             work_data->include_custom = get_bool_property(env, argv[2], "custom", 0);
+            
+            napi_value js_fields;
+            napi_valuetype fields_type = napi_undefined;
+            if (napi_get_named_property(env, argv[2], "fields", &js_fields) == napi_ok) {
+                napi_typeof(env, js_fields, &fields_type);
+            }
+            if (fields_type != napi_undefined && fields_type != napi_null) {
+                if (parse_object_fields(env, js_fields, &work_data->fields) != 0) {
+                    bucket_name_release(work_data->bucket_name);
+                    free(work_data->prefix);
+                    free(work_data->cursor);
+                    free(work_data->end_key);
+                    free(work_data);
+                    napi_throw_type_error(env, NULL,
+                        "fields must be a non-empty array of 'key', 'isPrefix', 'created', 'expires', 'contentLength', 'custom'");
+                    return NULL;
+                }
+                /* Only ask the satellite for the metadata that will be returned */
+                work_data->include_system = (work_data->fields & OBJECT_FIELDS_SYSTEM) != 0;
+                work_data->include_custom = (work_data->fields & OBJECT_FIELD_CUSTOM) != 0;
+            }
         }
     }
     
@@ -220,15 +732,16 @@ napi_value list_objects_create(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "listObjectsCreate", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    work_data->cancel = cancel_token_from_options(env, argc > 2 ? argv[2] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 2 ? argv[2] : NULL, THREAD_POOL_LANE_METADATA);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
         list_objects_create_execute,
         list_objects_create_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
-    
-    napi_queue_async_work(env, work_data->work);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
     
     return promise;
 }
@@ -246,9 +759,8 @@ napi_value object_iterator_next(napi_env env, napi_callback_info info) {
         return NULL;
     }
     
-    size_t iterator_handle;
-    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_OBJECT_ITERATOR, &iterator_handle);
-    if (status != napi_ok) {
+    const HandleWrapper* wrapper = get_handle_wrapper(env, argv[0], HANDLE_TYPE_OBJECT_ITERATOR);
+    if (wrapper == NULL) {
         napi_throw_type_error(env, NULL, "Invalid object iterator handle");
         return NULL;
     }
@@ -259,7 +771,8 @@ napi_value object_iterator_next(napi_env env, napi_callback_info info) {
         return NULL;
     }
     
-    work_data->iterator_handle = iterator_handle;
+    work_data->iterator_handle = wrapper->handle;
+    work_data->state = get_iterator_state(wrapper);
     work_data->has_next = false;
     
     napi_value promise;
@@ -268,11 +781,117 @@ napi_value object_iterator_next(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "objectIteratorNext", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(env, NULL, work_name,
+    thread_pool_queue_work(env, THREAD_POOL_LANE_METADATA, work_name,
         object_iterator_next_execute, object_iterator_next_complete,
         work_data, &work_data->work);
+    return promise;
+}
+
+/* ========== objectIteratorNextBatch ========== */
+
+napi_value object_iterator_next_batch(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "iteratorHandle and maxItems are required");
+        return NULL;
+    }
+    
+    const HandleWrapper* wrapper = get_handle_wrapper(env, argv[0], HANDLE_TYPE_OBJECT_ITERATOR);
+    if (wrapper == NULL) {
+        napi_throw_type_error(env, NULL, "Invalid object iterator handle");
+        return NULL;
+    }
+    
+    int64_t max_items = 0;
+    if (napi_get_value_int64(env, argv[1], &max_items) != napi_ok || max_items <= 0) {
+        napi_throw_type_error(env, NULL, "maxItems must be a positive number");
+        return NULL;
+    }
+    if (max_items > OBJECT_ITERATOR_MAX_BATCH) {
+        max_items = OBJECT_ITERATOR_MAX_BATCH;
+    }
+    
+    ObjectIteratorBatchData* work_data = (ObjectIteratorBatchData*)calloc(1, sizeof(ObjectIteratorBatchData));
+    if (work_data == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->objects = (UplinkObject**)calloc((size_t)max_items, sizeof(UplinkObject*));
+    if (work_data->objects == NULL) {
+        free(work_data);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    work_data->iterator_handle = wrapper->handle;
+    work_data->state = get_iterator_state(wrapper);
+    work_data->fields = get_iterator_fields(wrapper);
+    work_data->max_items = (size_t)max_items;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "objectIteratorNextBatch", NAPI_AUTO_LENGTH, &work_name);
+    
+    thread_pool_queue_work(env, THREAD_POOL_LANE_METADATA, work_name,
+        object_iterator_next_batch_execute, object_iterator_next_batch_complete,
+        work_data, &work_data->work);
+    return promise;
+}
+
+/* ========== objectIteratorNextColumns ========== */
+
+napi_value object_iterator_next_columns(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "iteratorHandle and maxItems are required");
+        return NULL;
+    }
+    
+    const HandleWrapper* wrapper = get_handle_wrapper(env, argv[0], HANDLE_TYPE_OBJECT_ITERATOR);
+    if (wrapper == NULL) {
+        napi_throw_type_error(env, NULL, "Invalid object iterator handle");
+        return NULL;
+    }
+    
+    int64_t max_items = 0;
+    if (napi_get_value_int64(env, argv[1], &max_items) != napi_ok || max_items <= 0) {
+        napi_throw_type_error(env, NULL, "maxItems must be a positive number");
+        return NULL;
+    }
+    if (max_items > OBJECT_ITERATOR_MAX_BATCH) {
+        max_items = OBJECT_ITERATOR_MAX_BATCH;
+    }
+    
+    ObjectIteratorColumnsData* work_data = (ObjectIteratorColumnsData*)calloc(1, sizeof(ObjectIteratorColumnsData));
+    if (work_data == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
     
-    napi_queue_async_work(env, work_data->work);
+    work_data->iterator_handle = wrapper->handle;
+    work_data->state = get_iterator_state(wrapper);
+    work_data->max_items = (size_t)max_items;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "objectIteratorNextColumns", NAPI_AUTO_LENGTH, &work_name);
+    
+    thread_pool_queue_work(env, THREAD_POOL_LANE_METADATA, work_name,
+        object_iterator_next_columns_execute, object_iterator_next_columns_complete,
+        work_data, &work_data->work);
     return promise;
 }
 
@@ -289,9 +908,8 @@ napi_value object_iterator_item(napi_env env, napi_callback_info info) {
         return NULL;
     }
     
-    size_t iterator_handle;
-    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_OBJECT_ITERATOR, &iterator_handle);
-    if (status != napi_ok) {
+    const HandleWrapper* wrapper = get_handle_wrapper(env, argv[0], HANDLE_TYPE_OBJECT_ITERATOR);
+    if (wrapper == NULL) {
         napi_throw_type_error(env, NULL, "Invalid object iterator handle");
         return NULL;
     }
@@ -302,7 +920,9 @@ napi_value object_iterator_item(napi_env env, napi_callback_info info) {
         return NULL;
     }
     
-    work_data->iterator_handle = iterator_handle;
+    work_data->iterator_handle = wrapper->handle;
+    work_data->state = get_iterator_state(wrapper);
+    work_data->fields = get_iterator_fields(wrapper);
     work_data->object = NULL;
     
     napi_value promise;
@@ -311,14 +931,36 @@ napi_value object_iterator_item(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "objectIteratorItem", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(env, NULL, work_name,
+    thread_pool_queue_work(env, THREAD_POOL_LANE_METADATA, work_name,
         object_iterator_item_execute, object_iterator_item_complete,
         work_data, &work_data->work);
-    
-    napi_queue_async_work(env, work_data->work);
     return promise;
 }
 
+/* ========== objectIteratorCheckpoint ========== */
+
+napi_value object_iterator_checkpoint(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    const HandleWrapper* wrapper = argc < 1 ? NULL : get_handle_wrapper(env, argv[0], HANDLE_TYPE_OBJECT_ITERATOR);
+    if (wrapper == NULL) {
+        napi_throw_type_error(env, NULL, "Invalid object iterator handle");
+        return NULL;
+    }
+    
+    const ObjectIteratorState* state = get_iterator_state(wrapper);
+    napi_value result;
+    if (state == NULL || state->last_key == NULL) {
+        napi_get_null(env, &result);
+    } else {
+        napi_create_string_utf8(env, state->last_key, NAPI_AUTO_LENGTH, &result);
+    }
+    return result;
+}
+
 /* ========== objectIteratorErr ========== */
 
 napi_value object_iterator_err(napi_env env, napi_callback_info info) {
@@ -354,11 +996,9 @@ napi_value object_iterator_err(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "objectIteratorErr", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(env, NULL, work_name,
+    thread_pool_queue_work(env, THREAD_POOL_LANE_METADATA, work_name,
         object_iterator_err_execute, object_iterator_err_complete,
         work_data, &work_data->work);
-    
-    napi_queue_async_work(env, work_data->work);
     return promise;
 }
 
@@ -381,6 +1021,7 @@ napi_value free_object_iterator(napi_env env, napi_callback_info info) {
         napi_throw_type_error(env, NULL, "Invalid object iterator handle");
         return NULL;
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_OBJECT_ITERATOR);
     
     FreeObjectIteratorData* work_data = (FreeObjectIteratorData*)calloc(1, sizeof(FreeObjectIteratorData));
     if (work_data == NULL) {
@@ -396,11 +1037,9 @@ napi_value free_object_iterator(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "freeObjectIterator", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(env, NULL, work_name,
+    thread_pool_queue_work(env, THREAD_POOL_LANE_METADATA, work_name,
         free_object_iterator_execute, free_object_iterator_complete,
         work_data, &work_data->work);
-    
-    napi_queue_async_work(env, work_data->work);
     return promise;
 }
 
@@ -429,25 +1068,25 @@ napi_value copy_object(napi_env env, napi_callback_info info) {
     char* dst_bucket = NULL;
     char* dst_key = NULL;
     
-    if (extract_string_required(env, argv[1], "srcBucket", &src_bucket) != napi_ok) {
+    if (extract_bucket_name(env, argv[1], "srcBucket", &src_bucket) != napi_ok) {
         return NULL;
     }
     
     if (extract_string_required(env, argv[2], "srcKey", &src_key) != napi_ok) {
-        free(src_bucket);
+        bucket_name_release(src_bucket);
         return NULL;
     }
     
-    if (extract_string_required(env, argv[3], "dstBucket", &dst_bucket) != napi_ok) {
-        free(src_bucket);
+    if (extract_bucket_name(env, argv[3], "dstBucket", &dst_bucket) != napi_ok) {
+        bucket_name_release(src_bucket);
         free(src_key);
         return NULL;
     }
     
     if (extract_string_required(env, argv[4], "dstKey", &dst_key) != napi_ok) {
-        free(src_bucket);
+        bucket_name_release(src_bucket);
         free(src_key);
-        free(dst_bucket);
+        bucket_name_release(dst_bucket);
         return NULL;
     }
     
@@ -456,9 +1095,9 @@ napi_value copy_object(napi_env env, napi_callback_info info) {
     
     CopyMoveObjectData* work_data = (CopyMoveObjectData*)calloc(1, sizeof(CopyMoveObjectData));
     if (work_data == NULL) {
-        free(src_bucket);
+        bucket_name_release(src_bucket);
         free(src_key);
-        free(dst_bucket);
+        bucket_name_release(dst_bucket);
         free(dst_key);
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
@@ -476,16 +1115,14 @@ napi_value copy_object(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "copyObject", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         copy_object_execute,
         copy_object_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -514,25 +1151,25 @@ napi_value move_object(napi_env env, napi_callback_info info) {
     char* dst_bucket = NULL;
     char* dst_key = NULL;
     
-    if (extract_string_required(env, argv[1], "srcBucket", &src_bucket) != napi_ok) {
+    if (extract_bucket_name(env, argv[1], "srcBucket", &src_bucket) != napi_ok) {
         return NULL;
     }
     
     if (extract_string_required(env, argv[2], "srcKey", &src_key) != napi_ok) {
-        free(src_bucket);
+        bucket_name_release(src_bucket);
         return NULL;
     }
     
-    if (extract_string_required(env, argv[3], "dstBucket", &dst_bucket) != napi_ok) {
-        free(src_bucket);
+    if (extract_bucket_name(env, argv[3], "dstBucket", &dst_bucket) != napi_ok) {
+        bucket_name_release(src_bucket);
         free(src_key);
         return NULL;
     }
     
     if (extract_string_required(env, argv[4], "dstKey", &dst_key) != napi_ok) {
-        free(src_bucket);
+        bucket_name_release(src_bucket);
         free(src_key);
-        free(dst_bucket);
+        bucket_name_release(dst_bucket);
         return NULL;
     }
     
@@ -541,9 +1178,9 @@ napi_value move_object(napi_env env, napi_callback_info info) {
     
     CopyMoveObjectData* work_data = (CopyMoveObjectData*)calloc(1, sizeof(CopyMoveObjectData));
     if (work_data == NULL) {
-        free(src_bucket);
+        bucket_name_release(src_bucket);
         free(src_key);
-        free(dst_bucket);
+        bucket_name_release(dst_bucket);
         free(dst_key);
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
@@ -562,16 +1199,14 @@ napi_value move_object(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "moveObject", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         move_object_execute,
         move_object_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -600,11 +1235,11 @@ napi_value update_object_metadata(napi_env env, napi_callback_info info) {
     char* bucket_name = NULL;
     char* object_key = NULL;
     
-    if (extract_string_required(env, argv[1], "bucket", &bucket_name) != napi_ok) {
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok) {
         return NULL;
     }
     if (extract_string_required(env, argv[2], "key", &object_key) != napi_ok) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         return NULL;
     }
     
@@ -612,7 +1247,7 @@ napi_value update_object_metadata(napi_env env, napi_callback_info info) {
     napi_valuetype type;
     napi_typeof(env, argv[3], &type);
     if (type != napi_object) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
         napi_throw_type_error(env, NULL, "metadata must be an object");
         return NULL;
@@ -623,13 +1258,13 @@ napi_value update_object_metadata(napi_env env, napi_callback_info info) {
     size_t metadata_count = 0;
     int meta_rc = extract_metadata_entries_from_js(env, argv[3], &metadata_entries, &metadata_count);
     if (meta_rc == -1) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
         napi_throw_type_error(env, NULL, "metadata values must be strings");
         return NULL;
     }
     if (meta_rc == -2) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
@@ -640,7 +1275,7 @@ napi_value update_object_metadata(napi_env env, napi_callback_info info) {
     
     UpdateMetadataData* work_data = (UpdateMetadataData*)calloc(1, sizeof(UpdateMetadataData));
     if (work_data == NULL) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
         free_metadata_entries(metadata_entries, metadata_count);
         napi_throw_error(env, NULL, "Out of memory");
@@ -659,15 +1294,183 @@ napi_value update_object_metadata(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "updateObjectMetadata", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         update_object_metadata_execute,
         update_object_metadata_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
     
-    napi_queue_async_work(env, work_data->work);
+    return promise;
+}
+
+/* ========== update_objects_metadata ========== */
+
+/**
+ * Encode each metadata set of the JS array @p js_sets once.
+ * Throws and returns -1 on a bad set or OOM.
+ */
+static int extract_metadata_sets(napi_env env, napi_value js_sets, UpdateMetadataBatchData* work_data) {
+    bool is_array = false;
+    uint32_t length = 0;
+    napi_is_array(env, js_sets, &is_array);
+    if (is_array) {
+        napi_get_array_length(env, js_sets, &length);
+    }
+    if (length == 0) {
+        napi_throw_type_error(env, NULL, "metadata sets must be a non-empty array");
+        return -1;
+    }
+    
+    work_data->sets = (UplinkCustomMetadata*)calloc(length, sizeof(UplinkCustomMetadata));
+    if (work_data->sets == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return -1;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element;
+        napi_valuetype type;
+        napi_get_element(env, js_sets, i, &element);
+        napi_typeof(env, element, &type);
+        if (type != napi_object) {
+            napi_throw_type_error(env, NULL, "metadata must be an object");
+            return -1;
+        }
+        int rc = extract_metadata_entries_from_js(env, element, &work_data->sets[i].entries, &work_data->sets[i].count);
+        if (rc != 0) {
+            if (rc == -2) {
+                napi_throw_error(env, NULL, "Out of memory");
+            } else {
+                napi_throw_type_error(env, NULL, "metadata values must be strings");
+            }
+            return -1;
+        }
+        work_data->set_count = i + 1;
+    }
+    return 0;
+}
+
+/**
+ * Copy the per-key set indices from a Uint32Array, or leave set_index
+ * NULL when @p js_index is null or undefined. Throws and returns -1 when
+ * the indices do not cover every key with a valid set.
+ */
+static int extract_set_index(napi_env env, napi_value js_index, UpdateMetadataBatchData* work_data) {
+    napi_valuetype type;
+    napi_typeof(env, js_index, &type);
+    if (type == napi_null || type == napi_undefined) {
+        if (work_data->set_count != 1) {
+            napi_throw_type_error(env, NULL, "setIndex is required with more than one metadata set");
+            return -1;
+        }
+        return 0;
+    }
+    
+    bool is_typedarray = false;
+    napi_typedarray_type array_type;
+    size_t length = 0;
+    void* indices = NULL;
+    napi_is_typedarray(env, js_index, &is_typedarray);
+    if (is_typedarray) {
+        napi_get_typedarray_info(env, js_index, &array_type, &length, &indices, NULL, NULL);
+    }
+    if (!is_typedarray || array_type != napi_uint32_array || length != work_data->key_count) {
+        napi_throw_type_error(env, NULL, "setIndex must be a Uint32Array with one entry per key");
+        return -1;
+    }
+    
+    work_data->set_index = (uint32_t*)malloc((length > 0 ? length : 1) * sizeof(uint32_t));
+    if (work_data->set_index == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return -1;
+    }
+    if (length > 0) {
+        memcpy(work_data->set_index, indices, length * sizeof(uint32_t));
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (work_data->set_index[i] >= work_data->set_count) {
+            napi_throw_range_error(env, NULL, "setIndex entry is out of range");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+napi_value update_objects_metadata(napi_env env, napi_callback_info info) {
+    size_t argc = 6;
+    napi_value argv[6] = { NULL, NULL, NULL, NULL, NULL, NULL };
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 4) {
+        napi_throw_type_error(env, NULL, "projectHandle, bucket, keys, and metadata sets are required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    napi_status status = extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    napi_value options = argc > 5 ? argv[5] : NULL;
+    uint32_t concurrency;
+    RetryPolicy retry;
+    if (get_batch_concurrency(env, options, &concurrency) != 0 ||
+        retry_policy_option(env, options, &retry) != 0) {
+        return NULL;
+    }
+    
+    UpdateMetadataBatchData* work_data = (UpdateMetadataBatchData*)calloc(1, sizeof(UpdateMetadataBatchData));
+    if (work_data == NULL) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    int failed = extract_bucket_name(env, argv[1], "bucket", &work_data->bucket_name) != napi_ok ||
+                 extract_key_array(env, argv[2], &work_data->keys, &work_data->key_count) != 0 ||
+                 extract_metadata_sets(env, argv[3], work_data) != 0 ||
+                 extract_set_index(env, argv[4], work_data) != 0;
+    if (!failed) {
+        size_t slots = work_data->key_count > 0 ? work_data->key_count : 1;
+        work_data->codes = (int32_t*)calloc(slots, sizeof(int32_t));
+        work_data->messages = (char**)calloc(slots, sizeof(char*));
+        if (work_data->codes == NULL || work_data->messages == NULL) {
+            napi_throw_error(env, NULL, "Out of memory");
+            failed = 1;
+        }
+    }
+    if (failed) {
+        update_metadata_batch_free(work_data);
+        free(work_data);
+        return NULL;
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->concurrency = concurrency;
+    work_data->retry = retry;
+    
+    LOG_DEBUG("updateObjectsMetadata: queuing async work for %zu keys in '%s' with %zu metadata sets",
+              work_data->key_count, work_data->bucket_name, work_data->set_count);
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "updateObjectsMetadata", NAPI_AUTO_LENGTH, &work_name);
+    
+    work_data->cancel = cancel_token_from_options(env, options);
+    ThreadPoolLane lane = thread_pool_lane_option(env, options, THREAD_POOL_LANE_BULK);
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, lane, work_name,
+        update_objects_metadata_execute,
+        update_objects_metadata_complete,
+        work_data,
+        &work_data->work, NULL
+    );
+    cancel_token_attach(work_data->cancel, env, work_data->work);
     
     return promise;
 }
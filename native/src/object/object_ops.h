@@ -12,14 +12,30 @@
 
 /**
  * Get object information/metadata
- * JS: statObject(projectHandle, bucket, key) -> Promise<ObjectInfo>
+ * JS: statObject(projectHandle, bucket, key, options?) -> Promise<ObjectInfo>
+ * 
+ * Options: { lane?: 'metadata' | 'bulk' } (default 'metadata').
  * 
  * @param env N-API environment
- * @param info Callback info containing [projectHandle, bucket, key]
+ * @param info Callback info containing [projectHandle, bucket, key, options?]
  * @return Promise resolving to ObjectInfo object
  */
 napi_value stat_object(napi_env env, napi_callback_info info);
 
+/**
+ * Get information for many objects of one bucket
+ * JS: statObjects(projectHandle, bucket, keys, options?) -> Promise<{objects, errors}>
+ *
+ * Options: { concurrency?: number }. objects[i] is the ObjectInfo for
+ * keys[i], or null when it is missing or failed; each failure other than
+ * "not found" is listed in errors as { index, key, error }.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [projectHandle, bucket, keys, options?]
+ * @return Promise resolving to the per-key results
+ */
+napi_value stat_objects(napi_env env, napi_callback_info info);
+
 /**
  * Delete an object
  * JS: deleteObject(projectHandle, bucket, key) -> Promise<void>
@@ -30,9 +46,82 @@ napi_value stat_object(napi_env env, napi_callback_info info);
  */
 napi_value delete_object(napi_env env, napi_callback_info info);
 
+/**
+ * Delete many objects of one bucket
+ * JS: deleteObjects(projectHandle, bucket, keys, options?) -> Promise<{deleted, missing, failed}>
+ *
+ * Options: { concurrency?: number }. deleted and missing are counts;
+ * failed lists { index, key, code, message } for each key that failed.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [projectHandle, bucket, keys, options?]
+ * @return Promise resolving to the deletion summary
+ */
+napi_value delete_objects(napi_env env, napi_callback_info info);
+
+/**
+ * Delete every object under a prefix, streaming the listing into deletion
+ * JS: deletePrefix(projectHandle, bucket, prefix, options?) -> Promise<DeletePrefixResult>
+ *
+ * Options: { concurrency?: number, dryRun?: boolean }. Resolves
+ * { listed, deleted, missing, failed, failures }; a dry run only lists.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [projectHandle, bucket, prefix, options?]
+ * @return Promise resolving to the deletion totals
+ */
+napi_value delete_prefix(napi_env env, napi_callback_info info);
+
+/**
+ * Write a bucket listing to a file without creating JS objects
+ * JS: exportListing(projectHandle, bucket, path, options?) -> Promise<ExportListingResult>
+ *
+ * Options: { prefix?, recursive?, format?: 'ndjson' | 'binary',
+ * includeSystem? (default true), includeCustom?, fsync? }. The file is
+ * truncated first and holds whatever was written if the export fails.
+ *
+ * NDJSON lines have the ObjectInfo shape ({ key, isPrefix, system?,
+ * custom? }, expires null when unset). Binary files start with "ULX1"
+ * followed by little-endian records: u8 flags (1 = prefix, 2 = custom
+ * follows), i64 created, i64 expires, i64 contentLength, u32 key length,
+ * key bytes, then with flag 2 a u32 entry count and per entry u32 key
+ * length, key, u32 value length, value.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [projectHandle, bucket, path, options?]
+ * @return Promise resolving to { objects, prefixes, contentLength, bytesWritten }
+ */
+napi_value export_listing(napi_env env, napi_callback_info info);
+
+/**
+ * Copy many objects
+ * JS: copyObjects(projectHandle, pairs, options?) -> Promise<{succeeded, status, errors}>
+ *
+ * pairs: Array<{ oldBucket, oldKey, newBucket, newKey }>; options:
+ * { concurrency?: number }. status is an Int32Array with 0 for each pair
+ * that succeeded and its error code otherwise; errors lists
+ * { index, code, message } for the failed pairs.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [projectHandle, pairs, options?]
+ * @return Promise resolving to the per-pair status
+ */
+napi_value copy_objects(napi_env env, napi_callback_info info);
+
+/**
+ * Move many objects
+ * JS: moveObjects(projectHandle, pairs, options?) -> Promise<{succeeded, status, errors}>
+ *
+ * Same arguments and result as copyObjects.
+ */
+napi_value move_objects(napi_env env, napi_callback_info info);
+
 /**
  * Create an object iterator
  * JS: listObjectsCreate(projectHandle, bucket, options?) -> Promise<iteratorHandle>
+ *
+ * Besides the listing options, endKey (inclusive) ends the listing early,
+ * so cursor and endKey together select one key range.
  */
 napi_value list_objects_create(napi_env env, napi_callback_info info);
 
@@ -42,6 +131,23 @@ napi_value list_objects_create(napi_env env, napi_callback_info info);
  */
 napi_value object_iterator_next(napi_env env, napi_callback_info info);
 
+/**
+ * Advance object iterator up to maxItems times, collecting each item
+ * JS: objectIteratorNextBatch(iteratorHandle, maxItems) -> Promise<ObjectInfo[]>
+ * A result shorter than maxItems means the iterator is exhausted.
+ */
+napi_value object_iterator_next_batch(napi_env env, napi_callback_info info);
+
+/**
+ * Advance object iterator up to maxItems times, packing the items into columns
+ * JS: objectIteratorNextColumns(iteratorHandle, maxItems) -> Promise<{ count, keyBytes: Uint8Array,
+ *     keyOffsets: Uint32Array, contentLength: BigInt64Array, created: Float64Array,
+ *     expires: Float64Array, isPrefix: Uint8Array }>
+ * All columns are views over one ArrayBuffer. A count below maxItems means the
+ * iterator is exhausted.
+ */
+napi_value object_iterator_next_columns(napi_env env, napi_callback_info info);
+
 /**
  * Get current item from object iterator
  * JS: objectIteratorItem(iteratorHandle) -> Promise<ObjectInfo>
@@ -54,6 +160,16 @@ napi_value object_iterator_item(napi_env env, napi_callback_info info);
  */
 napi_value object_iterator_err(napi_env env, napi_callback_info info);
 
+/**
+ * Get the iterator's resumable checkpoint (synchronous)
+ * JS: objectIteratorCheckpoint(iteratorHandle) -> string | null
+ *
+ * The key of the last item returned so far, or the starting cursor;
+ * passed back as the cursor, a new listing continues after it. null
+ * before anything was returned from a listing without a cursor.
+ */
+napi_value object_iterator_checkpoint(napi_env env, napi_callback_info info);
+
 /**
  * Free an object iterator
  * JS: freeObjectIterator(iteratorHandle) -> Promise<void>
@@ -91,4 +207,20 @@ napi_value move_object(napi_env env, napi_callback_info info);
  */
 napi_value update_object_metadata(napi_env env, napi_callback_info info);
 
+/**
+ * Update the custom metadata of many objects
+ * JS: updateObjectsMetadata(projectHandle, bucket, keys, sets, setIndex, options?)
+ *     -> Promise<{succeeded, status, errors}>
+ *
+ * sets is an array of metadata objects or packed metadata, each encoded
+ * once. setIndex is a Uint32Array giving the set of each key, or null to
+ * apply sets[0] to every key. Options: { concurrency?, retry?, lane?,
+ * cancelToken? }. The result is as for copyObjects, per key.
+ *
+ * @param env N-API environment
+ * @param info Callback info containing [projectHandle, bucket, keys, sets, setIndex, options?]
+ * @return Promise resolving to the per-key status
+ */
+napi_value update_objects_metadata(napi_env env, napi_callback_info info);
+
 #endif /* UPLINK_OBJECT_OPS_H */
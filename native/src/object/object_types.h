@@ -10,12 +10,15 @@
 
 #include <node_api.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /* Disable compat macros to avoid function name conflicts */
 #define UPLINK_DISABLE_NAMESPACE_COMPAT
 
 /* Include uplink-c header - contains all type definitions */
 #include "uplink.h"
+#include "../common/cancel_token.h"
+#include "../common/retry.h"
 
 /**
  * @brief Data for stat_object and delete_object async operations
@@ -24,11 +27,165 @@ typedef struct {
     size_t project_handle;
     char* bucket_name;
     char* object_key;
+    uint64_t cache_epoch;       /* stat_cache epoch when a stat was queued */
+    RetryPolicy retry;          /* From options.retry (statObject) */
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
     UplinkObjectResult result;
     napi_deferred deferred;
     napi_async_work work;
 } ObjectOpData;
 
+/**
+ * @brief Data for batched per-key object operations (statObjects, deleteObjects)
+ *
+ * The worker fans the keys out across up to `concurrency` native threads;
+ * results[i] holds the outcome for keys[i], so one key failing does not
+ * affect the others. After an abort, keys from `attempted` on were never
+ * tried and are reported as CanceledError.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char** keys;
+    size_t key_count;
+    uint32_t concurrency;
+    uint64_t cache_epoch;       /* stat_cache epoch when the batch was queued */
+    RetryPolicy retry;          /* From options.retry, applied per key */
+    UplinkObjectResult* results;   /* key_count slots, owned */
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    size_t attempted;           /* Keys tried; key_count unless aborted */
+    napi_deferred deferred;
+    napi_async_work work;
+} ObjectBatchData;
+
+/**
+ * @brief Data for batched copyObjects / moveObjects
+ *
+ * Pairs are flattened four strings at a time: old bucket, old key, new
+ * bucket, new key. codes[i] is 0 when pair i succeeded, else its uplink
+ * error code with the message in messages[i].
+ */
+typedef struct {
+    size_t project_handle;
+    char** pairs;               /* pair_count * 4 strings, owned */
+    size_t pair_count;
+    uint32_t concurrency;
+    bool move;
+    int32_t* codes;             /* pair_count slots */
+    char** messages;            /* pair_count slots, NULL on success */
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    napi_deferred deferred;
+    napi_async_work work;
+} ObjectPairBatchData;
+
+/**
+ * @brief Data for batched updateObjectsMetadata
+ *
+ * Each distinct metadata set is encoded once into sets[]; key i is
+ * updated with sets[set_index[i]], or sets[0] for every key when
+ * set_index is NULL. codes and messages are as for ObjectPairBatchData.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char** keys;
+    size_t key_count;
+    UplinkCustomMetadata* sets; /* set_count encoded sets, entries owned */
+    size_t set_count;
+    uint32_t* set_index;        /* key_count slots, or NULL for one shared set */
+    uint32_t concurrency;
+    RetryPolicy retry;          /* From options.retry, applied per key */
+    int32_t* codes;             /* key_count slots */
+    char** messages;            /* key_count slots, NULL on success */
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
+    napi_deferred deferred;
+    napi_async_work work;
+} UpdateMetadataBatchData;
+
+/** Default native threads for a batched object operation */
+#define OBJECT_BATCH_DEFAULT_CONCURRENCY 8
+
+/** Upper bound on native threads for a batched object operation */
+#define OBJECT_BATCH_MAX_CONCURRENCY 64
+
+/**
+ * @brief One failed deletion recorded by deletePrefix
+ */
+typedef struct {
+    char* key;
+    int32_t code;
+    char* message;
+} DeletePrefixFailure;
+
+/**
+ * @brief Data for delete_prefix async operation
+ *
+ * The worker lists the prefix recursively and hands keys through a
+ * bounded queue to `concurrency` native deletion threads, so listing and
+ * deleting overlap and at most the queue's worth of keys is held.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* prefix;
+    uint32_t concurrency;
+    bool dry_run;
+    uint64_t listed;
+    uint64_t deleted;
+    uint64_t missing;
+    uint64_t failed;
+    DeletePrefixFailure* failures;  /* First DELETE_PREFIX_MAX_FAILURES failures */
+    size_t failure_count;
+    CancelToken* cancel;            /* From options.cancelToken, or NULL */
+    int32_t error_code;             /* Listing or cancellation error, 0 if none */
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} DeletePrefixData;
+
+/** Listed keys queued per deletion thread in deletePrefix */
+#define DELETE_PREFIX_QUEUE_PER_WORKER 64
+
+/** Failures reported individually by deletePrefix; the rest are only counted */
+#define DELETE_PREFIX_MAX_FAILURES 100
+
+/** Record formats written by exportListing */
+typedef enum {
+    EXPORT_LISTING_NDJSON = 0,      /* One ObjectInfo-shaped JSON object per line */
+    EXPORT_LISTING_BINARY = 1       /* Length-prefixed little-endian records, see export_listing() */
+} ExportListingFormat;
+
+/** Write buffer of exportListing; records are flushed to the file in this size */
+#define EXPORT_LISTING_BUFFER_SIZE (256 * 1024)
+
+/**
+ * @brief Data for export_listing async operation
+ *
+ * The worker iterates the listing and serializes each item into a
+ * buffer that is written out when full, so memory stays constant and
+ * nothing reaches JS but the totals.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* file_path;
+    char* prefix;                   /* NULL lists the whole bucket */
+    bool recursive;
+    bool include_system;
+    bool include_custom;
+    bool fsync;
+    ExportListingFormat format;
+    uint64_t objects;
+    uint64_t prefixes;
+    uint64_t content_length;        /* Sum over objects, with system metadata */
+    uint64_t bytes_written;
+    CancelToken* cancel;            /* From options.cancelToken, or NULL */
+    int32_t error_code;             /* Listing, file or cancellation error, 0 if none */
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} ExportListingData;
+
 /**
  * @brief Data for creating an object iterator
  */
@@ -37,29 +194,94 @@ typedef struct {
     char* bucket_name;
     char* prefix;
     char* cursor;
+    char* end_key;              /* Inclusive upper bound of the listing, or NULL */
     bool recursive;
     bool include_system;
     bool include_custom;
+    uint32_t fields;            /* ObjectField mask applied to returned items */
+    CancelToken* cancel;        /* From options.cancelToken, or NULL */
     size_t iterator_handle;
     napi_deferred deferred;
     napi_async_work work;
 } ListObjectsCreateData;
 
+/**
+ * @brief Per-iterator state attached to the object iterator handle
+ *
+ * last_key is the resumable checkpoint: the key of the last item handed
+ * to JS (initially the cursor the listing started after). It is replaced
+ * on the main thread; end_key is fixed at creation and ended and peeked
+ * are only touched by the one call in flight, so workers need no lock.
+ */
+typedef struct {
+    uint32_t fields;            /* ObjectField mask applied to returned items */
+    char* last_key;             /* Listing resumes after this key, or NULL from the start */
+    char* end_key;              /* Items after this key are not returned, or NULL */
+    bool ended;                 /* An item past end_key was seen */
+    UplinkObject* peeked;       /* Item read by objectIteratorNext to check end_key, owned */
+} ObjectIteratorState;
+
 /**
  * @brief Data for object iterator next
  */
 typedef struct {
     size_t iterator_handle;
+    ObjectIteratorState* state;
     _Bool has_next;
     napi_deferred deferred;
     napi_async_work work;
 } ObjectIteratorNextData;
 
+/**
+ * @brief Data for object iterator batch advance
+ *
+ * The worker advances the iterator up to max_items times, collecting each
+ * item, so a whole page crosses the thread pool in one async work.
+ */
+typedef struct {
+    size_t iterator_handle;
+    ObjectIteratorState* state;
+    size_t max_items;
+    uint32_t fields;
+    UplinkObject** objects;     /* max_items slots, owned */
+    size_t count;
+    napi_deferred deferred;
+    napi_async_work work;
+} ObjectIteratorBatchData;
+
+/**
+ * @brief Data for object iterator columnar page
+ *
+ * The worker packs up to max_items objects into one block laid out as
+ * contentLength (int64[count]), created (double[count]), expires
+ * (double[count]), key offsets (uint32[count + 1]), the isPrefix bitmap
+ * ((count + 7) / 8 bytes), then the UTF-8 key bytes. Every column stays
+ * aligned to its element size.
+ */
+typedef struct {
+    size_t iterator_handle;
+    ObjectIteratorState* state;
+    size_t max_items;
+    size_t count;
+    char* last_key;             /* Key of the page's last item, moved to state */
+    uint8_t* block;             /* malloc'd packed page, or NULL */
+    size_t block_size;
+    size_t key_bytes;
+    bool out_of_memory;
+    napi_deferred deferred;
+    napi_async_work work;
+} ObjectIteratorColumnsData;
+
+/** Upper bound on items collected by one objectIteratorNextBatch call */
+#define OBJECT_ITERATOR_MAX_BATCH 10000
+
 /**
  * @brief Data for object iterator item
  */
 typedef struct {
     size_t iterator_handle;
+    ObjectIteratorState* state;
+    uint32_t fields;
     UplinkObject* object;
     napi_deferred deferred;
     napi_async_work work;
@@ -8,6 +8,8 @@
 #include "project_complete.h"
 #include "project_types.h"
 #include "../common/handle_helpers.h"
+#include "../common/admission.h"
+#include "../common/bandwidth.h"
 #include "../common/result_helpers.h"
 #include "../common/error_registry.h"
 #include "../common/cancel_helpers.h"
@@ -69,6 +71,25 @@ void config_open_project_complete(napi_env env, napi_status status, void* data)
         goto cleanup;
     }
     
+    if ((work_data->max_concurrent_transfers > 0 || work_data->max_concurrent_metadata_ops > 0) &&
+        admission_configure(work_data->result.project->_handle, work_data->max_concurrent_transfers,
+                            work_data->max_concurrent_metadata_ops) != 0) {
+        uplink_free_error(uplink_close_project(work_data->result.project));
+        uplink_free_project_result(work_data->result);
+        napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Out of memory"));
+        goto cleanup;
+    }
+    
+    if ((work_data->max_upload_rate > 0 || work_data->max_download_rate > 0 || work_data->bandwidth_weight > 0) &&
+        bandwidth_configure(work_data->result.project->_handle, work_data->max_upload_rate,
+                            work_data->max_download_rate, work_data->bandwidth_weight) != 0) {
+        admission_remove(work_data->result.project->_handle);
+        uplink_free_error(uplink_close_project(work_data->result.project));
+        uplink_free_project_result(work_data->result);
+        napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Out of memory"));
+        goto cleanup;
+    }
+    
     napi_value project_external = create_handle_external(
         env,
         work_data->result.project->_handle,
@@ -101,7 +122,7 @@ cleanup:
 void close_project_complete(napi_env env, napi_status status, void* data) {
     CloseProjectData* work_data = (CloseProjectData*)data;
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "closeProject");
-
+    
     if (work_data->error != NULL) {
         LOG_ERROR("closeProject: failed - %s", work_data->error->message);
         napi_value error = create_typed_error(env, work_data->error->code, work_data->error->message);
@@ -109,7 +130,7 @@ void close_project_complete(napi_env env, napi_status status, void* data) {
         uplink_free_error(work_data->error);
         goto cleanup;
     }
-
+    
     LOG_INFO("closeProject: success");
     napi_value undefined;
     napi_get_undefined(env, &undefined);
@@ -125,7 +146,7 @@ cleanup:
 void revoke_access_complete(napi_env env, napi_status status, void* data) {
     RevokeAccessData* work_data = (RevokeAccessData*)data;
     REJECT_IF_CANCELLED(env, status, work_data->deferred, "revokeAccess");
-
+    
     if (work_data->error != NULL) {
         LOG_ERROR("revokeAccess: failed - %s", work_data->error->message);
         napi_value error = create_typed_error(env, work_data->error->code, work_data->error->message);
@@ -133,7 +154,7 @@ void revoke_access_complete(napi_env env, napi_status status, void* data) {
         uplink_free_error(work_data->error);
         goto cleanup;
     }
-
+    
     LOG_INFO("revokeAccess: success");
     napi_value undefined;
     napi_get_undefined(env, &undefined);
@@ -15,6 +15,13 @@
 #include "project_complete.h"
 #include "../common/handle_helpers.h"
 #include "../common/string_helpers.h"
+#include "../common/type_converters.h"
+#include "../common/stat_cache.h"
+#include "../common/object_cache.h"
+#include "../common/known_buckets.h"
+#include "../common/thread_pool.h"
+#include "../common/admission.h"
+#include "../common/bandwidth.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
@@ -53,16 +60,14 @@ napi_value open_project(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "openProject", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         open_project_execute,
         open_project_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     LOG_DEBUG("openProject: queued async work");
     return promise;
 }
@@ -94,6 +99,32 @@ napi_value config_open_project(napi_env env, napi_callback_info info) {
         return NULL;
     }
     
+    int64_t max_transfers = get_int64_property(env, argv[0], "maxConcurrentTransfers", 0);
+    int64_t max_metadata = get_int64_property(env, argv[0], "maxConcurrentMetadataOps", 0);
+    if (max_transfers < 0 || max_transfers > ADMISSION_MAX_LIMIT) {
+        napi_throw_range_error(env, NULL, "maxConcurrentTransfers must be between 0 and 65536");
+        return NULL;
+    }
+    if (max_metadata < 0 || max_metadata > ADMISSION_MAX_LIMIT) {
+        napi_throw_range_error(env, NULL, "maxConcurrentMetadataOps must be between 0 and 65536");
+        return NULL;
+    }
+    int64_t max_upload_rate = get_int64_property(env, argv[0], "maxUploadBytesPerSecond", 0);
+    int64_t max_download_rate = get_int64_property(env, argv[0], "maxDownloadBytesPerSecond", 0);
+    int64_t bandwidth_weight = get_int64_property(env, argv[0], "bandwidthWeight", 0);
+    if (max_upload_rate < 0 || max_upload_rate > BANDWIDTH_MAX_RATE) {
+        napi_throw_range_error(env, NULL, "maxUploadBytesPerSecond must be between 0 and 2^53");
+        return NULL;
+    }
+    if (max_download_rate < 0 || max_download_rate > BANDWIDTH_MAX_RATE) {
+        napi_throw_range_error(env, NULL, "maxDownloadBytesPerSecond must be between 0 and 2^53");
+        return NULL;
+    }
+    if (bandwidth_weight < 0 || bandwidth_weight > BANDWIDTH_MAX_WEIGHT) {
+        napi_throw_range_error(env, NULL, "bandwidthWeight must be between 1 and 1000");
+        return NULL;
+    }
+    
     ConfigOpenProjectData* work_data = (ConfigOpenProjectData*)calloc(1, sizeof(ConfigOpenProjectData));
     if (work_data == NULL) {
         napi_throw_error(env, NULL, "Out of memory");
@@ -101,6 +132,11 @@ napi_value config_open_project(napi_env env, napi_callback_info info) {
     }
     
     work_data->access_handle = access_handle;
+    work_data->max_concurrent_transfers = (uint32_t)max_transfers;
+    work_data->max_concurrent_metadata_ops = (uint32_t)max_metadata;
+    work_data->max_upload_rate = (uint64_t)max_upload_rate;
+    work_data->max_download_rate = (uint64_t)max_download_rate;
+    work_data->bandwidth_weight = (uint32_t)bandwidth_weight;
     
     /* Extract config properties */
     napi_value user_agent_val, dial_timeout_val, temp_dir_val;
@@ -124,16 +160,14 @@ napi_value config_open_project(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "configOpenProject", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         config_open_project_execute,
         config_open_project_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     return promise;
 }
 
@@ -155,6 +189,7 @@ napi_value close_project(napi_env env, napi_callback_info info) {
         napi_throw_type_error(env, NULL, "Invalid project handle");
         return NULL;
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_PROJECT);
     
     CloseProjectData* work_data = (CloseProjectData*)calloc(1, sizeof(CloseProjectData));
     if (work_data == NULL) {
@@ -163,6 +198,11 @@ napi_value close_project(napi_env env, napi_callback_info info) {
     }
     
     work_data->project_handle = project_handle;
+    stat_cache_disable(project_handle);
+    object_cache_disable(project_handle);
+    known_buckets_disable(project_handle);
+    admission_remove(project_handle);
+    bandwidth_remove(project_handle);
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
@@ -170,16 +210,14 @@ napi_value close_project(napi_env env, napi_callback_info info) {
     napi_value work_name;
     napi_create_string_utf8(env, "closeProject", NAPI_AUTO_LENGTH, &work_name);
     
-    napi_create_async_work(
-        env, NULL, work_name,
+    thread_pool_queue_work(
+        env, THREAD_POOL_LANE_METADATA, work_name,
         close_project_execute,
         close_project_complete,
         work_data,
         &work_data->work
     );
     
-    napi_queue_async_work(env, work_data->work);
-    
     LOG_DEBUG("closeProject: queued async work");
     return promise;
 }
@@ -189,51 +227,412 @@ napi_value close_project(napi_env env, napi_callback_info info) {
 napi_value revoke_access(napi_env env, napi_callback_info info) {
     size_t argc = 2;
     napi_value argv[2];
-
+    
     napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
-
+    
     if (argc < 2) {
         napi_throw_type_error(env, NULL, "project and access handles are required");
         return NULL;
     }
-
+    
     size_t project_handle;
     if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
         napi_throw_type_error(env, NULL, "Invalid project handle");
         return NULL;
     }
-
+    
     size_t access_handle;
     if (extract_handle(env, argv[1], HANDLE_TYPE_ACCESS, &access_handle) != napi_ok) {
         napi_throw_type_error(env, NULL, "Invalid access handle");
         return NULL;
     }
-
+    
     RevokeAccessData* work_data = (RevokeAccessData*)calloc(1, sizeof(RevokeAccessData));
     if (work_data == NULL) {
         napi_throw_error(env, NULL, "Out of memory");
         return NULL;
     }
-
+    
     work_data->project_handle = project_handle;
     work_data->access_handle = access_handle;
-
+    
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
-
+    
     napi_value work_name;
     napi_create_string_utf8(env, "revokeAccess", NAPI_AUTO_LENGTH, &work_name);
-
-    napi_create_async_work(
-        env, NULL, work_name,
+    
+    admission_queue_work(
+        env, work_data->project_handle, ADMISSION_METADATA, THREAD_POOL_LANE_METADATA, work_name,
         revoke_access_execute,
         revoke_access_complete,
         work_data,
-        &work_data->work
+        &work_data->work, NULL
     );
-
-    napi_queue_async_work(env, work_data->work);
-
+    
     LOG_DEBUG("revokeAccess: queued async work");
     return promise;
 }
+
+/* ========== project_enable_stat_cache ========== */
+
+napi_value project_enable_stat_cache(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "project handle is required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    int64_t max_entries = STAT_CACHE_DEFAULT_MAX_ENTRIES;
+    int64_t ttl_ms = STAT_CACHE_DEFAULT_TTL_MS;
+    if (argc >= 2) {
+        napi_valuetype type;
+        napi_typeof(env, argv[1], &type);
+        if (type == napi_object) {
+            max_entries = get_int64_property(env, argv[1], "maxEntries", STAT_CACHE_DEFAULT_MAX_ENTRIES);
+            ttl_ms = get_int64_property(env, argv[1], "ttlMs", STAT_CACHE_DEFAULT_TTL_MS);
+        }
+    }
+    if (max_entries <= 0) {
+        napi_throw_type_error(env, NULL, "maxEntries must be a positive number");
+        return NULL;
+    }
+    if (ttl_ms <= 0) {
+        napi_throw_type_error(env, NULL, "ttlMs must be a positive number");
+        return NULL;
+    }
+    
+    if (stat_cache_enable(project_handle, (size_t)max_entries, ttl_ms) != 0) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== project_disable_stat_cache ========== */
+
+napi_value project_disable_stat_cache(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    size_t project_handle;
+    if (argc < 1 || extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    stat_cache_disable(project_handle);
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== project_stat_cache_stats ========== */
+
+napi_value project_stat_cache_stats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    size_t project_handle;
+    if (argc < 1 || extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    StatCacheStats stats;
+    napi_value result;
+    if (stat_cache_stats(project_handle, &stats) != 0) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    
+    napi_value value;
+    napi_create_object(env, &result);
+    napi_create_double(env, (double)stats.hits, &value);
+    napi_set_named_property(env, result, "hits", value);
+    napi_create_double(env, (double)stats.misses, &value);
+    napi_set_named_property(env, result, "misses", value);
+    napi_create_double(env, (double)stats.invalidations, &value);
+    napi_set_named_property(env, result, "invalidations", value);
+    napi_create_double(env, (double)stats.entries, &value);
+    napi_set_named_property(env, result, "entries", value);
+    napi_create_double(env, (double)stats.max_entries, &value);
+    napi_set_named_property(env, result, "maxEntries", value);
+    napi_create_int64(env, stats.ttl_ms, &value);
+    napi_set_named_property(env, result, "ttlMs", value);
+    return result;
+}
+
+/* ========== project_enable_object_cache ========== */
+
+napi_value project_enable_object_cache(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "project handle is required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    int64_t max_bytes = OBJECT_CACHE_DEFAULT_MAX_BYTES;
+    int64_t max_object_size = OBJECT_CACHE_DEFAULT_MAX_OBJECT_SIZE;
+    int64_t ttl_ms = OBJECT_CACHE_DEFAULT_TTL_MS;
+    if (argc >= 2) {
+        napi_valuetype type;
+        napi_typeof(env, argv[1], &type);
+        if (type == napi_object) {
+            max_bytes = get_int64_property(env, argv[1], "maxBytes", OBJECT_CACHE_DEFAULT_MAX_BYTES);
+            max_object_size = get_int64_property(env, argv[1], "maxObjectSize", OBJECT_CACHE_DEFAULT_MAX_OBJECT_SIZE);
+            ttl_ms = get_int64_property(env, argv[1], "ttlMs", OBJECT_CACHE_DEFAULT_TTL_MS);
+        }
+    }
+    if (max_bytes <= 0) {
+        napi_throw_type_error(env, NULL, "maxBytes must be a positive number");
+        return NULL;
+    }
+    if (max_object_size <= 0) {
+        napi_throw_type_error(env, NULL, "maxObjectSize must be a positive number");
+        return NULL;
+    }
+    if (ttl_ms <= 0) {
+        napi_throw_type_error(env, NULL, "ttlMs must be a positive number");
+        return NULL;
+    }
+    
+    if (object_cache_enable(project_handle, (size_t)max_bytes, (size_t)max_object_size, ttl_ms) != 0) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== project_disable_object_cache ========== */
+
+napi_value project_disable_object_cache(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    size_t project_handle;
+    if (argc < 1 || extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    object_cache_disable(project_handle);
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== project_object_cache_stats ========== */
+
+napi_value project_object_cache_stats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    size_t project_handle;
+    if (argc < 1 || extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    ObjectCacheStats stats;
+    napi_value result;
+    if (object_cache_stats(project_handle, &stats) != 0) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    
+    napi_value value;
+    napi_create_object(env, &result);
+    napi_create_double(env, (double)stats.hits, &value);
+    napi_set_named_property(env, result, "hits", value);
+    napi_create_double(env, (double)stats.misses, &value);
+    napi_set_named_property(env, result, "misses", value);
+    napi_create_double(env, (double)stats.invalidations, &value);
+    napi_set_named_property(env, result, "invalidations", value);
+    napi_create_double(env, (double)stats.evictions, &value);
+    napi_set_named_property(env, result, "evictions", value);
+    napi_create_double(env, (double)stats.entries, &value);
+    napi_set_named_property(env, result, "entries", value);
+    napi_create_double(env, (double)stats.bytes, &value);
+    napi_set_named_property(env, result, "bytes", value);
+    napi_create_double(env, (double)stats.max_bytes, &value);
+    napi_set_named_property(env, result, "maxBytes", value);
+    napi_create_double(env, (double)stats.max_object_size, &value);
+    napi_set_named_property(env, result, "maxObjectSize", value);
+    napi_create_int64(env, stats.ttl_ms, &value);
+    napi_set_named_property(env, result, "ttlMs", value);
+    return result;
+}
+
+/* ========== project_enable_known_buckets ========== */
+
+napi_value project_enable_known_buckets(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "project handle is required");
+        return NULL;
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    int64_t ttl_ms = KNOWN_BUCKETS_DEFAULT_TTL_MS;
+    if (argc >= 2) {
+        napi_valuetype type;
+        napi_typeof(env, argv[1], &type);
+        if (type == napi_object) {
+            ttl_ms = get_int64_property(env, argv[1], "ttlMs", KNOWN_BUCKETS_DEFAULT_TTL_MS);
+        }
+    }
+    if (ttl_ms <= 0) {
+        napi_throw_type_error(env, NULL, "ttlMs must be a positive number");
+        return NULL;
+    }
+    
+    if (known_buckets_enable(project_handle, ttl_ms) != 0) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== project_disable_known_buckets ========== */
+
+napi_value project_disable_known_buckets(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    size_t project_handle;
+    if (argc < 1 || extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    known_buckets_disable(project_handle);
+    
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ========== project_known_buckets_stats ========== */
+
+napi_value project_known_buckets_stats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    size_t project_handle;
+    if (argc < 1 || extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    KnownBucketsStats stats;
+    napi_value result;
+    if (known_buckets_stats(project_handle, &stats) != 0) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    
+    napi_value value;
+    napi_create_object(env, &result);
+    napi_create_double(env, (double)stats.hits, &value);
+    napi_set_named_property(env, result, "hits", value);
+    napi_create_double(env, (double)stats.misses, &value);
+    napi_set_named_property(env, result, "misses", value);
+    napi_create_double(env, (double)stats.invalidations, &value);
+    napi_set_named_property(env, result, "invalidations", value);
+    napi_create_double(env, (double)stats.entries, &value);
+    napi_set_named_property(env, result, "entries", value);
+    napi_create_int64(env, stats.ttl_ms, &value);
+    napi_set_named_property(env, result, "ttlMs", value);
+    return result;
+}
+
+/* ========== project_admission_stats ========== */
+
+napi_value project_admission_stats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    size_t project_handle;
+    if (argc < 1 || extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Invalid project handle");
+        return NULL;
+    }
+    
+    AdmissionStats stats;
+    napi_value result;
+    if (admission_stats(project_handle, &stats) != 0) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    
+    napi_value value;
+    napi_create_object(env, &result);
+    napi_create_uint32(env, stats.active[ADMISSION_TRANSFER], &value);
+    napi_set_named_property(env, result, "transfersActive", value);
+    napi_create_uint32(env, stats.queued[ADMISSION_TRANSFER], &value);
+    napi_set_named_property(env, result, "transfersQueued", value);
+    napi_create_uint32(env, stats.limit[ADMISSION_TRANSFER], &value);
+    napi_set_named_property(env, result, "maxConcurrentTransfers", value);
+    napi_create_uint32(env, stats.active[ADMISSION_METADATA], &value);
+    napi_set_named_property(env, result, "metadataActive", value);
+    napi_create_uint32(env, stats.queued[ADMISSION_METADATA], &value);
+    napi_set_named_property(env, result, "metadataQueued", value);
+    napi_create_uint32(env, stats.limit[ADMISSION_METADATA], &value);
+    napi_set_named_property(env, result, "maxConcurrentMetadataOps", value);
+    return result;
+}
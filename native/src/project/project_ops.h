@@ -37,4 +37,68 @@ napi_value close_project(napi_env env, napi_callback_info info);
  */
 napi_value revoke_access(napi_env env, napi_callback_info info);
 
+/**
+ * Enable (or reconfigure) the project's statObject cache (synchronous)
+ * JS: projectEnableStatCache(project: ProjectHandle, options?: { maxEntries?: number, ttlMs?: number }) -> void
+ */
+napi_value project_enable_stat_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Disable the project's statObject cache and drop its entries (synchronous)
+ * JS: projectDisableStatCache(project: ProjectHandle) -> void
+ */
+napi_value project_disable_stat_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Read the project's statObject cache counters (synchronous)
+ * JS: projectStatCacheStats(project: ProjectHandle) -> { hits, misses, invalidations, entries, maxEntries, ttlMs } | null
+ */
+napi_value project_stat_cache_stats(napi_env env, napi_callback_info info);
+
+/**
+ * Enable (or reconfigure) the project's getObject contents cache (synchronous)
+ * JS: projectEnableObjectCache(project: ProjectHandle, options?: { maxBytes?: number, maxObjectSize?: number, ttlMs?: number }) -> void
+ */
+napi_value project_enable_object_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Disable the project's getObject contents cache and drop its entries (synchronous)
+ * JS: projectDisableObjectCache(project: ProjectHandle) -> void
+ */
+napi_value project_disable_object_cache(napi_env env, napi_callback_info info);
+
+/**
+ * Read the project's getObject contents cache counters (synchronous)
+ * JS: projectObjectCacheStats(project: ProjectHandle) -> { hits, misses, invalidations, evictions, entries, bytes,
+ *     maxBytes, maxObjectSize, ttlMs } | null
+ */
+napi_value project_object_cache_stats(napi_env env, napi_callback_info info);
+
+/**
+ * Enable (or reconfigure) the project's set of buckets known to exist (synchronous)
+ * JS: projectEnableKnownBuckets(project: ProjectHandle, options?: { ttlMs?: number }) -> void
+ */
+napi_value project_enable_known_buckets(napi_env env, napi_callback_info info);
+
+/**
+ * Disable the project's known bucket set and drop its names (synchronous)
+ * JS: projectDisableKnownBuckets(project: ProjectHandle) -> void
+ */
+napi_value project_disable_known_buckets(napi_env env, napi_callback_info info);
+
+/**
+ * Read the project's known bucket set counters (synchronous)
+ * JS: projectKnownBucketsStats(project: ProjectHandle) -> { hits, misses, invalidations, entries, ttlMs } | null
+ */
+napi_value project_known_buckets_stats(napi_env env, napi_callback_info info);
+
+/**
+ * Read the project's admission gauges (synchronous)
+ * JS: projectAdmissionStats(project: ProjectHandle) -> { transfersActive, transfersQueued, maxConcurrentTransfers,
+ *     metadataActive, metadataQueued, maxConcurrentMetadataOps } | null
+ *
+ * Returns null when the project was opened without concurrency limits.
+ */
+napi_value project_admission_stats(napi_env env, napi_callback_info info);
+
 #endif /* UPLINK_PROJECT_OPS_H */
@@ -34,6 +34,11 @@ typedef struct {
     char* user_agent;
     int32_t dial_timeout_milliseconds;
     char* temp_directory;
+    uint32_t max_concurrent_transfers;      /* 0 = unlimited */
+    uint32_t max_concurrent_metadata_ops;   /* 0 = unlimited */
+    uint64_t max_upload_rate;               /* Bytes per second, 0 = unlimited */
+    uint64_t max_download_rate;             /* Bytes per second, 0 = unlimited */
+    uint32_t bandwidth_weight;              /* 0 = not set (weight 1) */
     UplinkProjectResult result;
     napi_deferred deferred;
     napi_async_work work;
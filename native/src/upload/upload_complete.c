@@ -7,21 +7,127 @@
 
 #include "upload_complete.h"
 #include "upload_types.h"
+#include "upload_execute.h"
 #include "../common/handle_helpers.h"
+#include "../common/string_helpers.h"
+#include "../common/admission.h"
+#include "../common/buffer_pool.h"
+#include "../common/buffer_helpers.h"
+#include "../common/work_pool.h"
 #include "../common/result_helpers.h"
 #include "../common/error_registry.h"
 #include "../common/cancel_helpers.h"
 #include "../common/type_converters.h"
 #include "../common/object_converter.h"
+#include "../common/stat_cache.h"
+#include "../common/object_cache.h"
+#include "../common/op_metrics.h"
 #include "../common/logger.h"
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* ========== per-handle state ========== */
+
+static void upload_codec_stage_free(UploadCodecStage* codec) {
+    if (codec == NULL) {
+        return;
+    }
+    free(codec->chunk);
+    free(codec->frame);
+    free(codec->index);
+    free(codec);
+}
+
+static UploadCodecStage* upload_codec_stage_create(CodecType type) {
+    UploadCodecStage* codec = (UploadCodecStage*)calloc(1, sizeof(UploadCodecStage));
+    if (codec == NULL) {
+        return NULL;
+    }
+    codec->type = type;
+    codec->chunk = (uint8_t*)malloc(CODEC_DEFAULT_CHUNK_SIZE);
+    codec->frame = (uint8_t*)malloc(CODEC_FRAME_HEADER_SIZE + CODEC_DEFAULT_CHUNK_SIZE);
+    if (codec->chunk == NULL || codec->frame == NULL) {
+        upload_codec_stage_free(codec);
+        return NULL;
+    }
+    return codec;
+}
+
+static void upload_handle_state_free(void* attachment) {
+    UploadHandleState* state = (UploadHandleState*)attachment;
+    /* Queued ops borrow the checksum and codec; free them once the queue drains */
+    if (!upload_queue_release(&state->queue, upload_handle_state_free, state)) {
+        return;
+    }
+    buffer_pool_release(state->staging.data);
+    free(state->checksum);
+    upload_codec_stage_free(state->codec);
+    free_metadata_entries(state->metadata_entries, state->metadata_count);
+    bucket_name_release(state->bucket_name);
+    free(state->object_key);
+    free(state);
+}
+
+/**
+ * Attach the serial queue and any write-coalescing, checksum, compression
+ * and stat cache identity state to a freshly created upload handle. The staging data area is allocated on
+ * first buffered write. Takes the bucket/key strings of @p work_data when
+ * the project has a stat cache, so the commit can invalidate the entry.
+ * @return 0 on success, -1 on OOM
+ */
+static int upload_handle_state_attach(napi_env env, napi_value upload_handle, UploadObjectData* work_data) {
+    size_t write_buffer_size = work_data->write_buffer_size;
+    ChecksumType checksum_type = work_data->checksum_type;
+    HandleWrapper* wrapper = get_handle_wrapper(env, upload_handle, HANDLE_TYPE_UPLOAD);
+    if (wrapper == NULL) {
+        return -1;
+    }
+    UploadHandleState* state = (UploadHandleState*)calloc(1, sizeof(UploadHandleState));
+    if (state == NULL) {
+        return -1;
+    }
+    upload_queue_init(&state->queue, work_data->max_queued_bytes);
+    state->staging.capacity = write_buffer_size;
+    if (checksum_type != CHECKSUM_NONE) {
+        state->checksum = (ChecksumState*)malloc(sizeof(ChecksumState));
+        if (state->checksum == NULL) {
+            free(state);
+            return -1;
+        }
+        checksum_init(state->checksum, checksum_type);
+    }
+    if (work_data->codec_type != CODEC_NONE) {
+        state->codec = upload_codec_stage_create(work_data->codec_type);
+        if (state->codec == NULL) {
+            free(state->checksum);
+            free(state);
+            return -1;
+        }
+    }
+    if (stat_cache_enabled(work_data->project_handle) || object_cache_enabled(work_data->project_handle)) {
+        state->project_handle = work_data->project_handle;
+        state->bucket_name = work_data->bucket_name;
+        state->object_key = work_data->object_key;
+        work_data->bucket_name = NULL;
+        work_data->object_key = NULL;
+    }
+    wrapper->attachment = state;
+    wrapper->attachment_free = upload_handle_state_free;
+    return 0;
+}
 
 /* ========== upload_object complete ========== */
 
 void upload_object_complete(napi_env env, napi_status status, void* data) {
     UploadObjectData* work_data = (UploadObjectData*)data;
-    REJECT_IF_CANCELLED(env, status, work_data->deferred, "uploadObject");
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "uploadObject", work_data->cancel);
+    
+    if (work_data->cancelled) {
+        napi_reject_deferred(env, work_data->deferred, cancel_token_error(env, work_data->cancel));
+        goto cleanup;
+    }
     
     if (work_data->result.error != NULL) {
         LOG_ERROR("uploadObject failed: %s", work_data->result.error->message);
@@ -31,13 +137,28 @@ void upload_object_complete(napi_env env, napi_status status, void* data) {
         goto cleanup;
     }
     
-    napi_value upload_handle = create_handle_external(env, work_data->result.upload->_handle, HANDLE_TYPE_UPLOAD, work_data->result.upload, NULL);
     LOG_INFO("Upload started: %s/%s", work_data->bucket_name, work_data->object_key);
+    napi_value upload_handle = create_handle_external(env, work_data->result.upload->_handle, HANDLE_TYPE_UPLOAD, work_data->result.upload, NULL);
+    if (upload_handle != NULL) {
+        if (upload_handle_state_attach(env, upload_handle, work_data) != 0) {
+            /* A checksum or codec is a correctness requirement, so do not silently drop it */
+            uplink_free_error(uplink_upload_abort(work_data->result.upload));
+            napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Out of memory"));
+            goto cleanup;
+        }
+    }
+    if (upload_handle != NULL) {
+        /* The transfer slot stays taken until commit or abort */
+        HandleWrapper* wrapper = get_handle_wrapper(env, upload_handle, HANDLE_TYPE_UPLOAD);
+        wrapper->admission = admission_keep(work_data->admission);
+        wrapper->project_handle = work_data->project_handle;
+    }
     napi_resolve_deferred(env, work_data->deferred, upload_handle);
     
 cleanup:
-    free(work_data->bucket_name);
+    bucket_name_release(work_data->bucket_name);
     free(work_data->object_key);
+    cancel_token_detach(work_data->cancel, work_data->work);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
@@ -46,34 +167,79 @@ cleanup:
 
 void upload_write_complete(napi_env env, napi_status status, void* data) {
     UploadWriteData* work_data = (UploadWriteData*)data;
-    REJECT_IF_CANCELLED(env, status, work_data->deferred, "uploadWrite");
+    SETTLE_IF_CANCELLED_BY(env, status, work_data->deferred, NULL, "uploadWrite", NULL);
     
     if (work_data->result.error != NULL) {
         LOG_ERROR("uploadWrite failed: %s", work_data->result.error->message);
+        upload_queue_fail(work_data->queue, work_data->result.error->code, work_data->result.error->message);
         napi_value error = create_typed_error(env, work_data->result.error->code, work_data->result.error->message);
-        napi_reject_deferred(env, work_data->deferred, error);
+        settle_error(env, work_data->deferred, NULL, error);
         uplink_free_error(work_data->result.error);
         goto cleanup;
     }
     
+    op_metrics_add_bytes(env, work_data->result.bytes_written);
+    if (work_data->deferred != NULL) {
+        napi_value bytes_written;
+        napi_create_int64(env, (int64_t)work_data->result.bytes_written, &bytes_written);
+        napi_resolve_deferred(env, work_data->deferred, bytes_written);
+    }
+    
+cleanup:
+    /* Release buffer reference, or the copy made when the write was accepted early */
+    unpin_buffer(env, work_data->buffer_ref, work_data->data_length);
+    buffer_pool_release(work_data->copy);
+    buffer_pool_release(work_data->pending);
+    work_pool_free(work_data);
+}
+
+/* ========== upload_writev complete ========== */
+
+void upload_writev_complete(napi_env env, napi_status status, void* data) {
+    UploadWritevData* work_data = (UploadWritevData*)data;
+    SETTLE_IF_CANCELLED_BY(env, status, work_data->deferred, work_data->callback, "uploadWritev", NULL);
+    
+    if (work_data->error != NULL) {
+        LOG_ERROR("uploadWritev failed after %zu bytes: %s", work_data->total_written, work_data->error->message);
+        upload_queue_fail(work_data->queue, work_data->error->code, work_data->error->message);
+        napi_value error = create_typed_error(env, work_data->error->code, work_data->error->message);
+        settle_error(env, work_data->deferred, work_data->callback, error);
+        uplink_free_error(work_data->error);
+        goto cleanup;
+    }
+    
+    op_metrics_add_bytes(env, work_data->total_written);
     napi_value bytes_written;
-    napi_create_int64(env, (int64_t)work_data->result.bytes_written, &bytes_written);
-    napi_resolve_deferred(env, work_data->deferred, bytes_written);
+    napi_create_int64(env, (int64_t)work_data->total_written, &bytes_written);
+    if (work_data->callback != NULL) {
+        napi_value argv[2];
+        napi_get_null(env, &argv[0]);
+        argv[1] = bytes_written;
+        invoke_callback(env, work_data->callback, 2, argv);
+    } else if (work_data->deferred != NULL) {
+        napi_resolve_deferred(env, work_data->deferred, bytes_written);
+    }
     
 cleanup:
-    /* Release buffer reference (no malloc'd copy to free) */
-    if (work_data->buffer_ref) {
-        napi_delete_reference(env, work_data->buffer_ref);
+    /* Release all buffer references, or the copy made when the write was accepted early */
+    for (uint32_t i = 0; i < work_data->buffer_count; i++) {
+        unpin_buffer(env, work_data->buffer_refs[i], work_data->buffer_lengths[i]);
     }
-    napi_delete_async_work(env, work_data->work);
-    free(work_data);
+    work_pool_free(work_data->buffer_ptrs);
+    work_pool_free(work_data->buffer_lengths);
+    work_pool_free(work_data->buffer_refs);
+    buffer_pool_release(work_data->copy);
+    buffer_pool_release(work_data->pending);
+    work_pool_free(work_data);
 }
 
 /* ========== upload_commit complete ========== */
 
 void upload_commit_complete(napi_env env, napi_status status, void* data) {
     UploadFinalizeData* work_data = (UploadFinalizeData*)data;
-    REJECT_IF_CANCELLED(env, status, work_data->deferred, "uploadCommit");
+    admission_release(work_data->admission);
+    SETTLE_IF_CANCELLED_BY(env, status, work_data->deferred, NULL, "uploadCommit", NULL);
+    stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->object_key);
     
     if (work_data->error != NULL) {
         LOG_ERROR("uploadCommit failed: %s", work_data->error->message);
@@ -88,7 +254,9 @@ void upload_commit_complete(napi_env env, napi_status status, void* data) {
     napi_resolve_deferred(env, work_data->deferred, undefined);
     
 cleanup:
-    napi_delete_async_work(env, work_data->work);
+    buffer_pool_release(work_data->pending);
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->object_key);
     free(work_data);
 }
 
@@ -96,7 +264,8 @@ cleanup:
 
 void upload_abort_complete(napi_env env, napi_status status, void* data) {
     UploadFinalizeData* work_data = (UploadFinalizeData*)data;
-    REJECT_IF_CANCELLED(env, status, work_data->deferred, "uploadAbort");
+    admission_release(work_data->admission);
+    SETTLE_IF_CANCELLED_BY(env, status, work_data->deferred, NULL, "uploadAbort", NULL);
     
     if (work_data->error != NULL) {
         LOG_ERROR("uploadAbort failed: %s", work_data->error->message);
@@ -111,7 +280,6 @@ void upload_abort_complete(napi_env env, napi_status status, void* data) {
     napi_resolve_deferred(env, work_data->deferred, undefined);
     
 cleanup:
-    napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
 
@@ -119,7 +287,7 @@ cleanup:
 
 void upload_set_metadata_complete(napi_env env, napi_status status, void* data) {
     UploadMetadataData* work_data = (UploadMetadataData*)data;
-    REJECT_IF_CANCELLED(env, status, work_data->deferred, "uploadSetCustomMetadata");
+    SETTLE_IF_CANCELLED_BY(env, status, work_data->deferred, NULL, "uploadSetCustomMetadata", NULL);
     
     if (work_data->error != NULL) {
         LOG_ERROR("uploadSetCustomMetadata failed: %s", work_data->error->message);
@@ -139,7 +307,6 @@ cleanup:
         free((void*)work_data->metadata.entries[i].value);
     }
     free(work_data->metadata.entries);
-    napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
 
@@ -159,9 +326,348 @@ void upload_info_complete(napi_env env, napi_status status, void* data) {
     
     napi_value object_obj = uplink_object_to_js(env, work_data->result.object);
     uplink_free_object_result(work_data->result);
+    
+    /* Running digest of everything written so far: { algorithm, value } */
+    if (work_data->has_checksum) {
+        char hex[CHECKSUM_HEX_MAX];
+        size_t hex_length = checksum_hex(&work_data->checksum, hex, sizeof(hex));
+        napi_value checksum_obj, algorithm, value;
+        napi_create_object(env, &checksum_obj);
+        napi_create_string_utf8(env, checksum_type_name(work_data->checksum.type), NAPI_AUTO_LENGTH, &algorithm);
+        napi_create_string_utf8(env, hex, hex_length, &value);
+        napi_set_named_property(env, checksum_obj, "algorithm", algorithm);
+        napi_set_named_property(env, checksum_obj, "value", value);
+        napi_set_named_property(env, object_obj, "checksum", checksum_obj);
+    }
+    
+    napi_resolve_deferred(env, work_data->deferred, object_obj);
+    
+cleanup:
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== upload_file complete ========== */
+
+void upload_file_complete(napi_env env, napi_status status, void* data) {
+    UploadFileData* work_data = (UploadFileData*)data;
+    progress_reporter_release(env, work_data->progress);
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "uploadFile", work_data->cancel);
+    stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->object_key);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("uploadFile failed for '%s': %s", work_data->file_path,
+                  work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    if (work_data->info.error != NULL) {
+        LOG_ERROR("uploadFile committed but info failed: %s", work_data->info.error->message);
+        napi_value error = create_typed_error(env, work_data->info.error->code, work_data->info.error->message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        uplink_free_object_result(work_data->info);
+        goto cleanup;
+    }
+    
+    napi_value object_obj = uplink_object_to_js(env, work_data->info.object);
+    uplink_free_object_result(work_data->info);
+    op_metrics_add_bytes(env, work_data->bytes_written);
+    LOG_INFO("Uploaded file '%s' to %s/%s (%zu bytes)", work_data->file_path,
+             work_data->bucket_name, work_data->object_key, work_data->bytes_written);
+    napi_resolve_deferred(env, work_data->deferred, object_obj);
+    
+cleanup:
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->object_key);
+    free(work_data->file_path);
+    free(work_data->error_message);
+    free_metadata_entries(work_data->metadata_entries, work_data->metadata_count);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== put_object complete ========== */
+
+void put_object_complete(napi_env env, napi_status status, void* data) {
+    PutObjectData* work_data = (PutObjectData*)data;
+    progress_reporter_release(env, work_data->progress);
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "putObject", work_data->cancel);
+    stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->object_key);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("putObject failed for %s/%s: %s", work_data->bucket_name, work_data->object_key,
+                  work_data->error_message ? work_data->error_message : "unknown error");
+        napi_value error = create_typed_error(env, work_data->error_code, work_data->error_message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        goto cleanup;
+    }
+    
+    if (work_data->info.error != NULL) {
+        LOG_ERROR("putObject committed but info failed: %s", work_data->info.error->message);
+        napi_value error = create_typed_error(env, work_data->info.error->code, work_data->info.error->message);
+        napi_reject_deferred(env, work_data->deferred, error);
+        uplink_free_object_result(work_data->info);
+        goto cleanup;
+    }
+    
+    napi_value object_obj = uplink_object_to_js(env, work_data->info.object);
+    uplink_free_object_result(work_data->info);
+    op_metrics_add_bytes(env, work_data->buffer_length);
+    LOG_INFO("Put %s/%s (%zu bytes)", work_data->bucket_name, work_data->object_key, work_data->buffer_length);
     napi_resolve_deferred(env, work_data->deferred, object_obj);
     
 cleanup:
+    unpin_buffer(env, work_data->buffer_ref, work_data->buffer_length);
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->object_key);
+    free(work_data->error_message);
+    free_metadata_entries(work_data->metadata_entries, work_data->metadata_count);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/* ========== put_object_dedup complete ========== */
+
+static void put_object_dedup_free(napi_env env, PutObjectDedupData* work_data) {
+    if (work_data->file_path == NULL) {
+        unpin_buffer(env, work_data->buffer_ref, work_data->buffer_length);
+    }
+    bucket_name_release(work_data->bucket_name);
+    free(work_data->key_template);
+    free(work_data->object_key);
+    free(work_data->file_path);
+    free(work_data->error_message);
+    free_metadata_entries(work_data->metadata_entries, work_data->metadata_count);
+    cancel_token_detach(work_data->cancel, work_data->work);
+    napi_delete_async_work(env, work_data->work);
+    free(work_data);
+}
+
+/**
+ * Replace each PUT_DEDUP_HASH_PLACEHOLDER of @p key_template with @p digest
+ * @return Heap key, or NULL on OOM
+ */
+static char* put_object_dedup_key(const char* key_template, const char* digest) {
+    size_t placeholder_length = strlen(PUT_DEDUP_HASH_PLACEHOLDER);
+    size_t digest_length = strlen(digest);
+    size_t count = 0;
+    for (const char* p = strstr(key_template, PUT_DEDUP_HASH_PLACEHOLDER); p != NULL;
+         p = strstr(p + placeholder_length, PUT_DEDUP_HASH_PLACEHOLDER)) {
+        count++;
+    }
+    
+    char* key = (char*)malloc(strlen(key_template) + count * digest_length + 1);
+    if (key == NULL) {
+        return NULL;
+    }
+    char* out = key;
+    const char* in = key_template;
+    for (const char* p = strstr(in, PUT_DEDUP_HASH_PLACEHOLDER); p != NULL;
+         p = strstr(in, PUT_DEDUP_HASH_PLACEHOLDER)) {
+        memcpy(out, in, (size_t)(p - in));
+        out += p - in;
+        memcpy(out, digest, digest_length);
+        out += digest_length;
+        in = p + placeholder_length;
+    }
+    strcpy(out, in);
+    return key;
+}
+
+/** Resolve with { key, uploaded, object } */
+static void put_object_dedup_resolve(napi_env env, PutObjectDedupData* work_data, const UplinkObject* object) {
+    napi_value result, key, uploaded;
+    napi_create_object(env, &result);
+    napi_create_string_utf8(env, work_data->object_key, NAPI_AUTO_LENGTH, &key);
+    napi_get_boolean(env, work_data->uploaded, &uploaded);
+    napi_set_named_property(env, result, "key", key);
+    napi_set_named_property(env, result, "uploaded", uploaded);
+    napi_set_named_property(env, result, "object", uplink_object_to_js(env, (UplinkObject*)object));
+    napi_resolve_deferred(env, work_data->deferred, result);
+}
+
+void put_object_dedup_hash_complete(napi_env env, napi_status status, void* data) {
+    PutObjectDedupData* work_data = (PutObjectDedupData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "putObjectDedup", work_data->cancel);
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("putObjectDedup hashing failed: %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_reject_deferred(env, work_data->deferred, create_typed_error(env, work_data->error_code, work_data->error_message));
+        goto cleanup;
+    }
+    
+    work_data->object_key = put_object_dedup_key(work_data->key_template, work_data->digest);
+    if (work_data->object_key == NULL) {
+        napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Out of memory"));
+        goto cleanup;
+    }
+    
+    /* A fresh cache entry answers without a transfer slot or a round trip */
+    const UplinkObject* cached = stat_cache_lookup(work_data->project_handle, work_data->bucket_name, work_data->object_key);
+    if (cached != NULL) {
+        LOG_DEBUG("putObjectDedup: cache hit for %s/%s", work_data->bucket_name, work_data->object_key);
+        put_object_dedup_resolve(env, work_data, cached);
+        goto cleanup;
+    }
+    
+    work_data->cache_epoch = stat_cache_epoch(work_data->project_handle);
+    napi_async_work hash_work = work_data->work;
+    napi_value work_name;
+    napi_create_string_utf8(env, "putObjectDedup", NAPI_AUTO_LENGTH, &work_name);
+    if (admission_queue_work(env, work_data->project_handle, ADMISSION_TRANSFER, work_data->lane, work_name,
+                             put_object_dedup_execute, put_object_dedup_complete, work_data,
+                             &work_data->work, NULL) != napi_ok) {
+        work_data->work = hash_work;
+        napi_reject_deferred(env, work_data->deferred, create_typed_error(env, UPLINK_ERROR_INTERNAL, "Failed to queue upload"));
+        goto cleanup;
+    }
+    cancel_token_reattach(work_data->cancel, env, hash_work, work_data->work);
+    napi_delete_async_work(env, hash_work);
+    return;
+    
+cleanup:
+    put_object_dedup_free(env, work_data);
+}
+
+void put_object_dedup_complete(napi_env env, napi_status status, void* data) {
+    PutObjectDedupData* work_data = (PutObjectDedupData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "putObjectDedup", work_data->cancel);
+    if (work_data->uploaded) {
+        stat_cache_invalidate(work_data->project_handle, work_data->bucket_name, work_data->object_key);
+    }
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("putObjectDedup failed for %s/%s: %s", work_data->bucket_name, work_data->object_key,
+                  work_data->error_message ? work_data->error_message : "unknown error");
+        napi_reject_deferred(env, work_data->deferred, create_typed_error(env, work_data->error_code, work_data->error_message));
+        goto cleanup;
+    }
+    
+    if (work_data->info.error != NULL) {
+        LOG_ERROR("putObjectDedup committed but info failed: %s", work_data->info.error->message);
+        napi_reject_deferred(env, work_data->deferred,
+                             create_typed_error(env, work_data->info.error->code, work_data->info.error->message));
+        uplink_free_object_result(work_data->info);
+        goto cleanup;
+    }
+    
+    if (!work_data->uploaded) {
+        stat_cache_store(work_data->project_handle, work_data->cache_epoch,
+                         work_data->bucket_name, work_data->object_key, work_data->info.object);
+    } else {
+        op_metrics_add_bytes(env, work_data->bytes_written);
+    }
+    LOG_INFO("putObjectDedup %s/%s: %s", work_data->bucket_name, work_data->object_key,
+             work_data->uploaded ? "uploaded" : "already present");
+    put_object_dedup_resolve(env, work_data, work_data->info.object);
+    uplink_free_object_result(work_data->info);
+    
+cleanup:
+    put_object_dedup_free(env, work_data);
+}
+
+/* ========== upload_replicated complete ========== */
+
+static void upload_replicated_free(napi_env env, UploadReplicatedData* work_data) {
+    if (work_data->file_path == NULL) {
+        unpin_buffer(env, work_data->buffer_ref, work_data->buffer_length);
+    }
+    for (size_t i = 0; i < work_data->replica_count; i++) {
+        UploadReplica* replica = &work_data->replicas[i];
+        if (replica->committed) {
+            uplink_free_object_result(replica->info);
+        }
+        free(replica->bucket_name);
+        free(replica->object_key);
+        free(replica->error_message);
+    }
+    free(work_data->replicas);
+    free(work_data->file_path);
+    free(work_data->error_message);
+    free_metadata_entries(work_data->metadata_entries, work_data->metadata_count);
+    cancel_token_detach(work_data->cancel, work_data->work);
     napi_delete_async_work(env, work_data->work);
     free(work_data);
 }
+
+/** Target result: { bucket, key, object } once committed, else { bucket, key, error } */
+static napi_value upload_replica_to_js(napi_env env, const UploadReplica* replica) {
+    napi_value result, bucket, key;
+    napi_create_object(env, &result);
+    napi_create_string_utf8(env, replica->bucket_name, NAPI_AUTO_LENGTH, &bucket);
+    napi_create_string_utf8(env, replica->object_key, NAPI_AUTO_LENGTH, &key);
+    napi_set_named_property(env, result, "bucket", bucket);
+    napi_set_named_property(env, result, "key", key);
+    if (replica->committed && replica->info.error == NULL) {
+        napi_set_named_property(env, result, "object", uplink_object_to_js(env, replica->info.object));
+    } else if (replica->committed) {
+        napi_set_named_property(env, result, "error",
+                                create_typed_error(env, replica->info.error->code, replica->info.error->message));
+    } else {
+        napi_set_named_property(env, result, "error",
+                                create_typed_error(env, replica->error_code != 0 ? replica->error_code : UPLINK_ERROR_CANCELED,
+                                                   replica->error_message != NULL ? replica->error_message : "Upload aborted"));
+    }
+    return result;
+}
+
+void upload_replicated_complete(napi_env env, napi_status status, void* data) {
+    UploadReplicatedData* work_data = (UploadReplicatedData*)data;
+    REJECT_IF_CANCELLED_BY(env, status, work_data->deferred, "uploadReplicated", work_data->cancel);
+    for (size_t i = 0; i < work_data->replica_count; i++) {
+        stat_cache_invalidate(work_data->replicas[i].project_handle, work_data->replicas[i].bucket_name,
+                              work_data->replicas[i].object_key);
+    }
+    
+    if (work_data->error_code != 0) {
+        LOG_ERROR("uploadReplicated failed: %s", work_data->error_message ? work_data->error_message : "unknown error");
+        napi_reject_deferred(env, work_data->deferred, create_typed_error(env, work_data->error_code, work_data->error_message));
+        goto cleanup;
+    }
+    
+    if (work_data->committed < work_data->quorum) {
+        /* Report the first target failure, with how far short the quorum fell */
+        const UploadReplica* failed = &work_data->replicas[0];
+        for (size_t i = 0; i < work_data->replica_count; i++) {
+            if (work_data->replicas[i].error_code != 0) {
+                failed = &work_data->replicas[i];
+                break;
+            }
+        }
+        char message[512];
+        snprintf(message, sizeof(message), "uploadReplicated: quorum of %zu not reached (%s/%s: %s)",
+                 work_data->quorum, failed->bucket_name, failed->object_key,
+                 failed->error_message != NULL ? failed->error_message : "aborted");
+        LOG_ERROR("%s", message);
+        napi_reject_deferred(env, work_data->deferred,
+                             create_typed_error(env, failed->error_code != 0 ? failed->error_code : UPLINK_ERROR_INTERNAL, message));
+        goto cleanup;
+    }
+    
+    size_t bytes_written = 0;
+    napi_value result, targets, bytes_read, committed;
+    napi_create_object(env, &result);
+    napi_create_array_with_length(env, work_data->replica_count, &targets);
+    for (size_t i = 0; i < work_data->replica_count; i++) {
+        napi_set_element(env, targets, (uint32_t)i, upload_replica_to_js(env, &work_data->replicas[i]));
+        if (work_data->replicas[i].committed) {
+            bytes_written += work_data->replicas[i].bytes_written;
+        }
+    }
+    napi_create_double(env, (double)work_data->bytes_read, &bytes_read);
+    napi_create_uint32(env, (uint32_t)work_data->committed, &committed);
+    napi_set_named_property(env, result, "bytesRead", bytes_read);
+    napi_set_named_property(env, result, "committed", committed);
+    napi_set_named_property(env, result, "targets", targets);
+    op_metrics_add_bytes(env, bytes_written);
+    LOG_INFO("uploadReplicated: %zu bytes to %zu of %zu targets", work_data->bytes_read,
+             work_data->committed, work_data->replica_count);
+    napi_resolve_deferred(env, work_data->deferred, result);
+    
+cleanup:
+    upload_replicated_free(env, work_data);
+}
@@ -15,9 +15,15 @@
 /* Complete functions - run on main thread */
 void upload_object_complete(napi_env env, napi_status status, void* data);
 void upload_write_complete(napi_env env, napi_status status, void* data);
+void upload_writev_complete(napi_env env, napi_status status, void* data);
 void upload_commit_complete(napi_env env, napi_status status, void* data);
 void upload_abort_complete(napi_env env, napi_status status, void* data);
 void upload_set_metadata_complete(napi_env env, napi_status status, void* data);
 void upload_info_complete(napi_env env, napi_status status, void* data);
+void upload_file_complete(napi_env env, napi_status status, void* data);
+void put_object_complete(napi_env env, napi_status status, void* data);
+void put_object_dedup_hash_complete(napi_env env, napi_status status, void* data);
+void put_object_dedup_complete(napi_env env, napi_status status, void* data);
+void upload_replicated_complete(napi_env env, napi_status status, void* data);
 
 #endif /* UPLOAD_COMPLETE_H */
@@ -7,10 +7,188 @@
 
 #include "upload_execute.h"
 #include "upload_types.h"
+#include "../common/result_helpers.h"
+#include "../common/file_helpers.h"
+#include "../common/buffer_pool.h"
+#include "../common/bandwidth.h"
 #include "../common/logger.h"
 
+#include <uv.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+
+static UplinkError* upload_internal_error(const char* message) {
+    /* uplink_free_error releases with free(), so a libc-allocated error is safe */
+    UplinkError* error = (UplinkError*)calloc(1, sizeof(UplinkError));
+    if (error != NULL) {
+        error->code = UPLINK_ERROR_INTERNAL;
+        error->message = strdup(message);
+    }
+    return error;
+}
+
+/**
+ * Write @p length bytes to an upload, retrying short writes and drawing
+ * each write from the bandwidth limits of @p project_handle. A wait
+ * stopped by @p cancel ends the write early with *out_written < length;
+ * a write that makes no progress is an error.
+ * @return NULL on success, or the uplink error (owned by the caller)
+ */
+static UplinkError* upload_write_fully(UplinkUpload* upload, size_t project_handle, CancelToken* cancel,
+                                       uint8_t* data, size_t length, size_t* out_written) {
+    size_t written = 0;
+    while (written < length) {
+        size_t grant = bandwidth_acquire(project_handle, BANDWIDTH_UPLOAD, length - written, cancel);
+        if (grant == 0) {
+            break;
+        }
+        UplinkWriteResult result = uplink_upload_write(upload, data + written, grant);
+        bandwidth_refund(project_handle, BANDWIDTH_UPLOAD, grant - result.bytes_written);
+        if (result.error != NULL) {
+            if (out_written != NULL) *out_written = written;
+            return result.error;
+        }
+        if (result.bytes_written == 0) {
+            /* Retrying would spin; a silent break would resolve a short count */
+            if (out_written != NULL) *out_written = written;
+            return upload_internal_error("upload write made no progress");
+        }
+        written += result.bytes_written;
+    }
+    if (out_written != NULL) *out_written = written;
+    return NULL;
+}
+
+/* ========== compression stage ========== */
+
+/**
+ * Compress one chunk and write it as a frame, stored as is when
+ * compression does not make it smaller.
+ */
+static UplinkError* upload_codec_write_frame(UplinkUpload* upload, size_t project_handle, UploadCodecStage* codec,
+                                             const uint8_t* chunk, size_t length) {
+    if (codec->index_count == codec->index_capacity) {
+        size_t capacity = codec->index_capacity > 0 ? codec->index_capacity * 2 : 64;
+        uint32_t* index = (uint32_t*)realloc(codec->index, capacity * sizeof(uint32_t));
+        if (index == NULL) {
+            return upload_internal_error("Out of memory growing the compression index");
+        }
+        codec->index = index;
+        codec->index_capacity = capacity;
+    }
+    
+    uint8_t* payload = codec->frame + CODEC_FRAME_HEADER_SIZE;
+    size_t payload_length = codec_compress(codec->type, chunk, length, payload, length - 1);
+    if (payload_length == 0) {
+        memcpy(payload, chunk, length);
+        payload_length = length;
+        codec_put_u32(codec->frame, CODEC_FRAME_STORED | (uint32_t)length);
+    } else {
+        codec_put_u32(codec->frame, (uint32_t)payload_length);
+    }
+    
+    /* A partial frame would leave the stored stream undecodable */
+    size_t frame_length = CODEC_FRAME_HEADER_SIZE + payload_length;
+    size_t written = 0;
+    UplinkError* error = upload_write_fully(upload, project_handle, NULL, codec->frame, frame_length, &written);
+    if (error != NULL) {
+        return error;
+    }
+    if (written < frame_length) {
+        return upload_internal_error("Short write of a compressed frame");
+    }
+    codec->index[codec->index_count++] = (uint32_t)frame_length;
+    codec->stored_size += frame_length;
+    return NULL;
+}
+
+/**
+ * Feed written bytes to the compression stage. Whole chunks are
+ * compressed straight from @p data; the rest is gathered first.
+ */
+static UplinkError* upload_codec_write(UplinkUpload* upload, size_t project_handle, UploadCodecStage* codec,
+                                       const uint8_t* data, size_t length) {
+    size_t consumed = 0;
+    while (consumed < length) {
+        size_t rest = length - consumed;
+        if (codec->chunk_length == 0 && rest >= CODEC_DEFAULT_CHUNK_SIZE) {
+            UplinkError* error = upload_codec_write_frame(upload, project_handle, codec, data + consumed, CODEC_DEFAULT_CHUNK_SIZE);
+            if (error != NULL) {
+                return error;
+            }
+            consumed += CODEC_DEFAULT_CHUNK_SIZE;
+            codec->raw_size += CODEC_DEFAULT_CHUNK_SIZE;
+            continue;
+        }
+        
+        size_t take = CODEC_DEFAULT_CHUNK_SIZE - codec->chunk_length;
+        if (take > rest) {
+            take = rest;
+        }
+        memcpy(codec->chunk + codec->chunk_length, data + consumed, take);
+        codec->chunk_length += take;
+        codec->raw_size += take;
+        consumed += take;
+        if (codec->chunk_length == CODEC_DEFAULT_CHUNK_SIZE) {
+            UplinkError* error = upload_codec_write_frame(upload, project_handle, codec, codec->chunk, codec->chunk_length);
+            if (error != NULL) {
+                return error;
+            }
+            codec->chunk_length = 0;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Write the last partial chunk and the frame size index before commit.
+ */
+static UplinkError* upload_codec_finish(UplinkUpload* upload, size_t project_handle, UploadCodecStage* codec) {
+    if (codec->chunk_length > 0) {
+        UplinkError* error = upload_codec_write_frame(upload, project_handle, codec, codec->chunk, codec->chunk_length);
+        if (error != NULL) {
+            return error;
+        }
+        codec->chunk_length = 0;
+    }
+    if (codec->index_count == 0) {
+        return NULL;
+    }
+    
+    uint8_t* index = (uint8_t*)malloc(codec->index_count * sizeof(uint32_t));
+    if (index == NULL) {
+        return upload_internal_error("Out of memory writing the compression index");
+    }
+    for (size_t i = 0; i < codec->index_count; i++) {
+        codec_put_u32(index + i * sizeof(uint32_t), codec->index[i]);
+    }
+    size_t index_length = codec->index_count * sizeof(uint32_t);
+    size_t written = 0;
+    UplinkError* error = upload_write_fully(upload, project_handle, NULL, index, index_length, &written);
+    free(index);
+    if (error == NULL && written < index_length) {
+        error = upload_internal_error("Short write of the compression index");
+    }
+    return error;
+}
+
+/**
+ * Write through the compression stage when the upload has one.
+ * @p out_written counts original bytes.
+ */
+static UplinkError* upload_stage_write(UplinkUpload* upload, size_t project_handle, UploadCodecStage* codec,
+                                       uint8_t* data, size_t length, size_t* out_written) {
+    if (codec == NULL) {
+        return upload_write_fully(upload, project_handle, NULL, data, length, out_written);
+    }
+    UplinkError* error = upload_codec_write(upload, project_handle, codec, data, length);
+    if (out_written != NULL) {
+        *out_written = error == NULL ? length : 0;
+    }
+    return error;
+}
 
 /* ========== upload_object execute ========== */
 
@@ -29,6 +207,13 @@ void upload_object_execute(napi_env env, void* data) {
     }
     
     work_data->result = uplink_upload_object(&project, work_data->bucket_name, work_data->object_key, options_ptr);
+    if (work_data->result.error == NULL && cancel_token_is_cancelled(work_data->cancel)) {
+        /* Nobody will get the handle, so give the upload back right away */
+        uplink_free_error(uplink_upload_abort(work_data->result.upload));
+        uplink_free_upload_result(work_data->result);
+        work_data->result.upload = NULL;
+        work_data->cancelled = true;
+    }
 }
 
 /* ========== upload_write execute ========== */
@@ -39,18 +224,167 @@ void upload_write_execute(napi_env env, void* data) {
     LOG_DEBUG("Writing %zu bytes to upload", work_data->data_length);
     
     UplinkUpload upload = { ._handle = work_data->upload_handle };
+    
+    /* Flush coalesced bytes first so ordering is preserved */
+    if (work_data->pending_length > 0) {
+        work_data->result.error = upload_stage_write(&upload, work_data->bandwidth_project, work_data->codec,
+                                                     work_data->pending, work_data->pending_length, NULL);
+        if (work_data->result.error != NULL) {
+            return;
+        }
+    }
+    
+    if (work_data->checksum != NULL) {
+        checksum_update(work_data->checksum, work_data->pending, work_data->pending_length);
+    }
+    
+    /* One write, as before, unless a bandwidth limit splits it into grants */
     uint8_t* buf = (uint8_t*)work_data->buffer_ptr;
-    work_data->result = uplink_upload_write(&upload, buf, work_data->data_length);
+    size_t written = 0;
+    work_data->result.error = upload_stage_write(&upload, work_data->bandwidth_project, work_data->codec,
+                                                 buf, work_data->data_length, &written);
+    work_data->result.bytes_written = written;
+    if (work_data->checksum != NULL && work_data->result.error == NULL) {
+        checksum_update(work_data->checksum, buf, written);
+    }
+}
+
+/* ========== upload_writev execute ========== */
+
+void upload_writev_execute(napi_env env, void* data) {
+    (void)env;
+    UploadWritevData* work_data = (UploadWritevData*)data;
+    LOG_DEBUG("Writing %u buffers to upload", work_data->buffer_count);
+    
+    UplinkUpload upload = { ._handle = work_data->upload_handle };
+    work_data->total_written = 0;
+    
+    /* Flush coalesced bytes first (already reported to JS when staged) */
+    if (work_data->pending_length > 0) {
+        work_data->error = upload_stage_write(&upload, work_data->bandwidth_project, work_data->codec,
+                                              work_data->pending, work_data->pending_length, NULL);
+        if (work_data->error != NULL) {
+            return;
+        }
+        if (work_data->checksum != NULL) {
+            checksum_update(work_data->checksum, work_data->pending, work_data->pending_length);
+        }
+    }
+    
+    for (uint32_t i = 0; i < work_data->buffer_count; i++) {
+        size_t written = 0;
+        work_data->error = upload_stage_write(&upload, work_data->bandwidth_project, work_data->codec,
+                                              (uint8_t*)work_data->buffer_ptrs[i], work_data->buffer_lengths[i], &written);
+        work_data->total_written += written;
+        if (work_data->checksum != NULL) {
+            checksum_update(work_data->checksum, work_data->buffer_ptrs[i], written);
+        }
+        if (work_data->error != NULL) {
+            return;
+        }
+    }
 }
 
 /* ========== upload_commit execute ========== */
 
+/** Entries the commit may add on top of the metadata set from JS */
+#define UPLOAD_STAGE_METADATA_MAX 5
+
+/**
+ * Record the final digest and/or the codec description as custom
+ * metadata, merged with any metadata previously set from JS (uplink
+ * replaces the whole set on each call).
+ */
+static UplinkError* upload_write_stage_metadata(UplinkUpload* upload, UploadFinalizeData* work_data) {
+    char keys[UPLOAD_STAGE_METADATA_MAX][32];
+    char values[UPLOAD_STAGE_METADATA_MAX][CHECKSUM_HEX_MAX];
+    size_t added = 0;
+    
+    if (work_data->checksum != NULL) {
+        snprintf(keys[added], sizeof(keys[added]), "%s%s", UPLOAD_CHECKSUM_KEY_PREFIX, checksum_type_name(work_data->checksum->type));
+        checksum_hex(work_data->checksum, values[added], sizeof(values[added]));
+        added++;
+    }
+    UploadCodecStage* codec = work_data->codec;
+    if (codec != NULL) {
+        snprintf(keys[added], sizeof(keys[added]), "%s", CODEC_KEY_NAME);
+        snprintf(values[added], sizeof(values[added]), "%s", codec_type_name(codec->type));
+        added++;
+        snprintf(keys[added], sizeof(keys[added]), "%s", CODEC_KEY_CHUNK_SIZE);
+        snprintf(values[added], sizeof(values[added]), "%u", (unsigned)CODEC_DEFAULT_CHUNK_SIZE);
+        added++;
+        snprintf(keys[added], sizeof(keys[added]), "%s", CODEC_KEY_RAW_SIZE);
+        snprintf(values[added], sizeof(values[added]), "%llu", (unsigned long long)codec->raw_size);
+        added++;
+        snprintf(keys[added], sizeof(keys[added]), "%s", CODEC_KEY_INDEX_OFFSET);
+        snprintf(values[added], sizeof(values[added]), "%llu", (unsigned long long)codec->stored_size);
+        added++;
+    }
+    
+    size_t count = work_data->metadata_count + added;
+    UplinkCustomMetadataEntry* entries = (UplinkCustomMetadataEntry*)calloc(count, sizeof(UplinkCustomMetadataEntry));
+    if (entries == NULL) {
+        return upload_internal_error("Out of memory building commit metadata");
+    }
+    
+    size_t n = 0;
+    for (size_t i = 0; i < work_data->metadata_count; i++) {
+        bool replaced = false;
+        for (size_t k = 0; k < added && !replaced; k++) {
+            replaced = strcmp(work_data->metadata_entries[i].key, keys[k]) == 0;
+        }
+        if (!replaced) {
+            entries[n++] = work_data->metadata_entries[i];
+        }
+    }
+    for (size_t k = 0; k < added; k++) {
+        entries[n].key = keys[k];
+        entries[n].key_length = strlen(keys[k]);
+        entries[n].value = values[k];
+        entries[n].value_length = strlen(values[k]);
+        n++;
+        LOG_DEBUG("Setting %s=%s before commit", keys[k], values[k]);
+    }
+    
+    UplinkCustomMetadata metadata = { entries, n };
+    UplinkError* error = uplink_upload_set_custom_metadata(upload, metadata);
+    free(entries);
+    return error;
+}
+
 void upload_commit_execute(napi_env env, void* data) {
     (void)env;
     UploadFinalizeData* work_data = (UploadFinalizeData*)data;
     LOG_DEBUG("Committing upload (handle=%zu)", work_data->upload_handle);
     
     UplinkUpload upload = { ._handle = work_data->upload_handle };
+    
+    if (work_data->pending_length > 0) {
+        LOG_DEBUG("Flushing %zu coalesced bytes before commit", work_data->pending_length);
+        work_data->error = upload_stage_write(&upload, work_data->bandwidth_project, work_data->codec,
+                                              work_data->pending, work_data->pending_length, NULL);
+        if (work_data->error != NULL) {
+            return;
+        }
+        if (work_data->checksum != NULL) {
+            checksum_update(work_data->checksum, work_data->pending, work_data->pending_length);
+        }
+    }
+    
+    if (work_data->codec != NULL) {
+        work_data->error = upload_codec_finish(&upload, work_data->bandwidth_project, work_data->codec);
+        if (work_data->error != NULL) {
+            return;
+        }
+    }
+    
+    if (work_data->checksum != NULL || work_data->codec != NULL) {
+        work_data->error = upload_write_stage_metadata(&upload, work_data);
+        if (work_data->error != NULL) {
+            return;
+        }
+    }
+    
     work_data->error = uplink_upload_commit(&upload);
 }
 
@@ -86,3 +420,748 @@ void upload_info_execute(napi_env env, void* data) {
     UplinkUpload upload = { ._handle = work_data->upload_handle };
     work_data->result = uplink_upload_info(&upload);
 }
+
+/* ========== upload_file execute ========== */
+
+/**
+ * Record an error for upload_file. Takes ownership of @p error when given,
+ * otherwise formats @p fallback with strerror(errno).
+ */
+static void upload_file_set_error(UploadFileData* work_data, UplinkError* error, const char* fallback) {
+    if (error != NULL) {
+        work_data->error_code = error->code;
+        work_data->error_message = strdup(error->message ? error->message : "unknown error");
+        uplink_free_error(error);
+        return;
+    }
+    
+    const char* reason = strerror(errno);
+    size_t len = strlen(fallback) + strlen(work_data->file_path) + strlen(reason) + 8;
+    work_data->error_code = UPLINK_ERROR_INTERNAL;
+    work_data->error_message = (char*)malloc(len);
+    if (work_data->error_message != NULL) {
+        snprintf(work_data->error_message, len, "%s '%s': %s", fallback, work_data->file_path, reason);
+    }
+}
+
+/**
+ * Write one window of the source file. With use_mmap the window is mapped
+ * and handed to uplink directly; if mapping fails (e.g., the filesystem
+ * does not support it) mmap is switched off and the window is read into
+ * the reusable chunk buffer instead.
+ * @return NULL on success, or the uplink error; file errors set *io_failed
+ */
+static UplinkError* upload_file_window(UploadFileData* work_data, UplinkUpload* upload, int fd,
+                                       uint8_t** chunk, int64_t offset, size_t length, bool* io_failed) {
+    if (work_data->use_mmap) {
+        FileMapping mapping;
+        if (file_map_range(fd, offset, length, &mapping) == 0) {
+            /* Sliced only when reporting progress; otherwise one write per window */
+            UplinkError* error = NULL;
+            size_t done = 0;
+            while (error == NULL && done < mapping.length) {
+                size_t slice = progress_slice(work_data->progress, mapping.length - done);
+                size_t written = 0;
+                error = upload_write_fully(upload, work_data->project_handle, work_data->cancel,
+                                           (uint8_t*)mapping.data + done, slice, &written);
+                work_data->bytes_written += written;
+                progress_add(work_data->progress, (int64_t)written);
+                done += written;
+                if (written < slice) {
+                    break;
+                }
+            }
+            file_unmap(&mapping);
+            return error;
+        }
+        LOG_WARN("uploadFile: mmap unavailable for '%s', falling back to buffered reads", work_data->file_path);
+        work_data->use_mmap = false;
+    }
+    
+    if (*chunk == NULL) {
+        *chunk = (uint8_t*)malloc(work_data->chunk_size);
+        if (*chunk == NULL) {
+            errno = ENOMEM;
+            *io_failed = true;
+            return NULL;
+        }
+    }
+    
+    /* Read into one reusable native buffer; the JS heap is never touched */
+    size_t done = 0;
+    while (done < length) {
+        size_t want = length - done < work_data->chunk_size ? length - done : work_data->chunk_size;
+        int64_t n = file_read_at(fd, *chunk, want, offset + (int64_t)done);
+        if (n <= 0) {
+            if (n == 0) errno = EIO;  /* File shrank while uploading */
+            *io_failed = true;
+            return NULL;
+        }
+        size_t written = 0;
+        UplinkError* error = upload_write_fully(upload, work_data->project_handle, work_data->cancel,
+                                                *chunk, (size_t)n, &written);
+        work_data->bytes_written += written;
+        progress_add(work_data->progress, (int64_t)written);
+        if (error != NULL || written < (size_t)n) {
+            return error;
+        }
+        done += (size_t)n;
+    }
+    return NULL;
+}
+
+void upload_file_execute(napi_env env, void* data) {
+    (void)env;
+    UploadFileData* work_data = (UploadFileData*)data;
+    LOG_DEBUG("Uploading file '%s' to %s/%s (chunk=%zu, mmap=%d)", work_data->file_path,
+              work_data->bucket_name, work_data->object_key, work_data->chunk_size, work_data->use_mmap);
+    
+    int fd = file_open_read(work_data->file_path);
+    if (fd < 0) {
+        upload_file_set_error(work_data, NULL, "cannot open file");
+        return;
+    }
+    
+    int64_t size = file_size(fd);
+    if (size < 0) {
+        upload_file_set_error(work_data, NULL, "cannot stat file");
+        file_close(fd);
+        return;
+    }
+    progress_set_total(work_data->progress, (uint64_t)size);
+    
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkUploadOptions options = {0};
+    UplinkUploadOptions* options_ptr = NULL;
+    if (work_data->expires > 0) {
+        options.expires = work_data->expires;
+        options_ptr = &options;
+    }
+    
+    UplinkUploadResult upload_result = uplink_upload_object(&project, work_data->bucket_name,
+                                                            work_data->object_key, options_ptr);
+    if (upload_result.error != NULL) {
+        upload_file_set_error(work_data, upload_result.error, NULL);
+        file_close(fd);
+        return;
+    }
+    
+    UplinkUpload* upload = upload_result.upload;
+    UplinkError* error = NULL;
+    uint8_t* chunk = NULL;
+    
+    if (work_data->metadata_count > 0) {
+        UplinkCustomMetadata metadata = { work_data->metadata_entries, work_data->metadata_count };
+        error = uplink_upload_set_custom_metadata(upload, metadata);
+        if (error != NULL) {
+            goto abort_upload;
+        }
+    }
+    
+    /* mmap windows are larger than read chunks to amortise map/unmap cost */
+    size_t window = work_data->use_mmap && work_data->chunk_size < UPLOAD_FILE_MMAP_WINDOW
+                    ? UPLOAD_FILE_MMAP_WINDOW : work_data->chunk_size;
+    
+    for (int64_t offset = 0; offset < size; offset += (int64_t)window) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+            uplink_free_error(uplink_upload_abort(upload));
+            goto done;
+        }
+        size_t length = (uint64_t)(size - offset) < window ? (size_t)(size - offset) : window;
+        bool io_failed = false;
+        error = upload_file_window(work_data, upload, fd, &chunk, offset, length, &io_failed);
+        if (error != NULL) {
+            goto abort_upload;
+        }
+        if (io_failed) {
+            upload_file_set_error(work_data, NULL, "cannot read file");
+            uplink_free_error(uplink_upload_abort(upload));
+            goto done;
+        }
+    }
+    /* A bandwidth wait stopped by the token leaves the file short */
+    if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+        uplink_free_error(uplink_upload_abort(upload));
+        goto done;
+    }
+    
+    error = uplink_upload_commit(upload);
+    if (error != NULL) {
+        upload_file_set_error(work_data, error, NULL);
+        goto done;
+    }
+    
+    work_data->info = uplink_upload_info(upload);
+    LOG_DEBUG("Uploaded %zu bytes from '%s'", work_data->bytes_written, work_data->file_path);
+    goto done;
+    
+abort_upload:
+    upload_file_set_error(work_data, error, NULL);
+    uplink_free_error(uplink_upload_abort(upload));
+    
+done:
+    uplink_free_upload_result(upload_result);
+    free(chunk);
+    file_close(fd);
+}
+
+/* ========== put_object execute ========== */
+
+/** Record an error for put_object, taking ownership of @p error when given. */
+static void put_object_set_error(PutObjectData* work_data, UplinkError* error, const char* fallback) {
+    work_data->error_code = error != NULL ? error->code : UPLINK_ERROR_INTERNAL;
+    work_data->error_message = strdup(error != NULL && error->message != NULL ? error->message : fallback);
+    uplink_free_error(error);
+}
+
+void put_object_execute(napi_env env, void* data) {
+    (void)env;
+    PutObjectData* work_data = (PutObjectData*)data;
+    LOG_DEBUG("Putting %zu bytes to %s/%s", work_data->buffer_length,
+              work_data->bucket_name, work_data->object_key);
+    
+    UplinkProject project = { ._handle = work_data->project_handle };
+    UplinkUploadOptions options = {0};
+    UplinkUploadOptions* options_ptr = NULL;
+    if (work_data->expires > 0) {
+        options.expires = work_data->expires;
+        options_ptr = &options;
+    }
+    
+    UplinkUploadResult upload_result = uplink_upload_object(&project, work_data->bucket_name,
+                                                            work_data->object_key, options_ptr);
+    if (upload_result.error != NULL) {
+        put_object_set_error(work_data, upload_result.error, "upload failed");
+        return;
+    }
+    
+    UplinkUpload* upload = upload_result.upload;
+    UplinkError* error = NULL;
+    
+    if (work_data->metadata_count > 0) {
+        UplinkCustomMetadata metadata = { work_data->metadata_entries, work_data->metadata_count };
+        error = uplink_upload_set_custom_metadata(upload, metadata);
+        if (error != NULL) {
+            goto abort_upload;
+        }
+    }
+    
+    /* Written in slices when cancellable or reporting progress, so an
+     * abort lands between them and progress moves with the data */
+    progress_set_total(work_data->progress, work_data->buffer_length);
+    size_t written = 0;
+    while (written < work_data->buffer_length) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+            uplink_free_error(uplink_upload_abort(upload));
+            goto done;
+        }
+        size_t slice = progress_slice(work_data->progress,
+                                      cancel_token_slice(work_data->cancel, work_data->buffer_length - written));
+        size_t slice_written = 0;
+        error = upload_write_fully(upload, work_data->project_handle, work_data->cancel,
+                                   (uint8_t*)work_data->buffer_ptr + written, slice, &slice_written);
+        written += slice_written;
+        progress_add(work_data->progress, (int64_t)slice_written);
+        if (error != NULL) {
+            goto abort_upload;
+        }
+        if (slice_written < slice) {
+            break;
+        }
+    }
+    if (written < work_data->buffer_length) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+            uplink_free_error(uplink_upload_abort(upload));
+            goto done;
+        }
+        put_object_set_error(work_data, NULL, "upload accepted fewer bytes than provided");
+        uplink_free_error(uplink_upload_abort(upload));
+        goto done;
+    }
+    
+    error = uplink_upload_commit(upload);
+    if (error != NULL) {
+        put_object_set_error(work_data, error, "commit failed");
+        goto done;
+    }
+    
+    work_data->info = uplink_upload_info(upload);
+    goto done;
+    
+abort_upload:
+    put_object_set_error(work_data, error, "upload failed");
+    uplink_free_error(uplink_upload_abort(upload));
+    
+done:
+    uplink_free_upload_result(upload_result);
+}
+
+/* ========== put_object_dedup execute ========== */
+
+/** Record an error for put_object_dedup, taking ownership of @p error when given. */
+static void put_object_dedup_set_error(PutObjectDedupData* work_data, UplinkError* error, const char* fallback) {
+    work_data->error_code = error != NULL ? error->code : UPLINK_ERROR_INTERNAL;
+    work_data->error_message = strdup(error != NULL && error->message != NULL ? error->message : fallback);
+    uplink_free_error(error);
+}
+
+void put_object_dedup_hash_execute(napi_env env, void* data) {
+    (void)env;
+    PutObjectDedupData* work_data = (PutObjectDedupData*)data;
+    ChecksumState checksum;
+    checksum_init(&checksum, work_data->algorithm);
+    
+    if (work_data->file_path == NULL) {
+        checksum_update(&checksum, work_data->buffer_ptr, work_data->buffer_length);
+        checksum_hex(&checksum, work_data->digest, sizeof(work_data->digest));
+        return;
+    }
+    
+    int fd = file_open_read(work_data->file_path);
+    uint8_t* chunk = fd >= 0 ? (uint8_t*)malloc(work_data->chunk_size) : NULL;
+    if (chunk == NULL) {
+        char message[512];
+        snprintf(message, sizeof(message), "cannot read file '%s': %s", work_data->file_path,
+                 strerror(fd < 0 ? errno : ENOMEM));
+        put_object_dedup_set_error(work_data, NULL, message);
+        if (fd >= 0) file_close(fd);
+        return;
+    }
+    
+    /* One streaming pass; the upload on a miss reads the file again */
+    int64_t offset = 0;
+    for (;;) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message)) {
+            break;
+        }
+        int64_t n = file_read_at(fd, chunk, work_data->chunk_size, offset);
+        if (n < 0) {
+            char message[512];
+            snprintf(message, sizeof(message), "cannot read file '%s': %s", work_data->file_path, strerror(errno));
+            put_object_dedup_set_error(work_data, NULL, message);
+            break;
+        }
+        if (n == 0) {
+            checksum_hex(&checksum, work_data->digest, sizeof(work_data->digest));
+            break;
+        }
+        checksum_update(&checksum, chunk, (size_t)n);
+        offset += n;
+    }
+    free(chunk);
+    file_close(fd);
+}
+
+void put_object_dedup_execute(napi_env env, void* data) {
+    PutObjectDedupData* work_data = (PutObjectDedupData*)data;
+    UplinkProject project = { ._handle = work_data->project_handle };
+    
+    UplinkObjectResult stat = uplink_stat_object(&project, work_data->bucket_name, work_data->object_key);
+    if (stat.error == NULL) {
+        LOG_DEBUG("putObjectDedup: %s/%s exists, skipping upload", work_data->bucket_name, work_data->object_key);
+        work_data->info = stat;
+        return;
+    }
+    if (stat.error->code != UPLINK_ERROR_OBJECT_NOT_FOUND) {
+        UplinkError* error = stat.error;
+        stat.error = NULL;
+        uplink_free_object_result(stat);
+        put_object_dedup_set_error(work_data, error, "stat failed");
+        return;
+    }
+    uplink_free_object_result(stat);
+    
+    /* Record the digest too, so downloads can verify against it */
+    char key[32];
+    snprintf(key, sizeof(key), "%s%s", UPLOAD_CHECKSUM_KEY_PREFIX, checksum_type_name(work_data->algorithm));
+    UplinkCustomMetadataEntry* entries = (UplinkCustomMetadataEntry*)calloc(work_data->metadata_count + 1,
+                                                                            sizeof(UplinkCustomMetadataEntry));
+    if (entries == NULL) {
+        put_object_dedup_set_error(work_data, NULL, "Out of memory");
+        return;
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < work_data->metadata_count; i++) {
+        if (strcmp(work_data->metadata_entries[i].key, key) != 0) {
+            entries[count++] = work_data->metadata_entries[i];
+        }
+    }
+    entries[count].key = key;
+    entries[count].key_length = strlen(key);
+    entries[count].value = work_data->digest;
+    entries[count].value_length = strlen(work_data->digest);
+    count++;
+    
+    work_data->uploaded = true;
+    if (work_data->file_path != NULL) {
+        UploadFileData upload = {
+            .project_handle = work_data->project_handle,
+            .bucket_name = work_data->bucket_name,
+            .object_key = work_data->object_key,
+            .file_path = work_data->file_path,
+            .chunk_size = work_data->chunk_size,
+            .expires = work_data->expires,
+            .metadata_entries = entries,
+            .metadata_count = count,
+            .cancel = work_data->cancel,
+        };
+        upload_file_execute(env, &upload);
+        work_data->bytes_written = upload.bytes_written;
+        work_data->info = upload.info;
+        work_data->error_code = upload.error_code;
+        work_data->error_message = upload.error_message;
+    } else {
+        PutObjectData put = {
+            .project_handle = work_data->project_handle,
+            .bucket_name = work_data->bucket_name,
+            .object_key = work_data->object_key,
+            .buffer_ptr = work_data->buffer_ptr,
+            .buffer_length = work_data->buffer_length,
+            .expires = work_data->expires,
+            .metadata_entries = entries,
+            .metadata_count = count,
+            .cancel = work_data->cancel,
+        };
+        put_object_execute(env, &put);
+        work_data->bytes_written = put.error_code == 0 ? put.buffer_length : 0;
+        work_data->info = put.info;
+        work_data->error_code = put.error_code;
+        work_data->error_message = put.error_message;
+    }
+    free(entries);
+}
+
+/* ========== upload_replicated execute ========== */
+
+typedef enum {
+    REPLICA_STEP_OPEN,
+    REPLICA_STEP_WRITE,
+    REPLICA_STEP_COMMIT,
+    REPLICA_STEP_ABORT,
+} ReplicaStep;
+
+/**
+ * Lockstep between the reading thread and one native thread per target.
+ * Each step is published under a new generation; the reader waits until
+ * every target thread has finished it.
+ */
+typedef struct {
+    UploadReplicatedData* work_data;
+    uv_mutex_t lock;
+    uv_cond_t step_ready;
+    uv_cond_t step_done;
+    uint64_t generation;
+    ReplicaStep step;
+    const uint8_t* data;
+    size_t length;
+    size_t pending;         /* Target threads still running the step */
+    bool* threaded;         /* Per target: runs on its own thread */
+    size_t thread_count;
+} ReplicaFanout;
+
+typedef struct {
+    ReplicaFanout* fanout;
+    UploadReplica* replica;
+} ReplicaWorker;
+
+/** Record a target failure, taking ownership of @p error when given */
+static void replica_set_error(UploadReplica* replica, UplinkError* error, const char* fallback) {
+    replica->error_code = error != NULL ? error->code : UPLINK_ERROR_INTERNAL;
+    replica->error_message = strdup(error != NULL && error->message != NULL ? error->message : fallback);
+    uplink_free_error(error);
+}
+
+static void replica_run_step(UploadReplicatedData* work_data, UploadReplica* replica, ReplicaStep step,
+                             const uint8_t* data, size_t length) {
+    UplinkError* error = NULL;
+    switch (step) {
+    case REPLICA_STEP_OPEN: {
+        UplinkProject project = { ._handle = replica->project_handle };
+        UplinkUploadOptions options = {0};
+        options.expires = work_data->expires;
+        replica->upload = uplink_upload_object(&project, replica->bucket_name, replica->object_key,
+                                               work_data->expires > 0 ? &options : NULL);
+        if (replica->upload.error != NULL) {
+            error = replica->upload.error;
+            replica->upload.error = NULL;
+            replica_set_error(replica, error, "upload failed");
+            return;
+        }
+        if (work_data->metadata_count > 0) {
+            UplinkCustomMetadata metadata = { work_data->metadata_entries, work_data->metadata_count };
+            error = uplink_upload_set_custom_metadata(replica->upload.upload, metadata);
+            if (error != NULL) {
+                replica_set_error(replica, error, "upload failed");
+                uplink_free_error(uplink_upload_abort(replica->upload.upload));
+                return;
+            }
+        }
+        replica->open = true;
+        return;
+    }
+    case REPLICA_STEP_WRITE: {
+        if (!replica->open) {
+            return;
+        }
+        size_t written = 0;
+        error = upload_write_fully(replica->upload.upload, replica->project_handle, work_data->cancel,
+                                   (uint8_t*)data, length, &written);
+        replica->bytes_written += written;
+        if (error == NULL && written == length) {
+            return;
+        }
+        /* A wait stopped by the token is reported once, by the reader */
+        if (error != NULL || !cancel_token_is_cancelled(work_data->cancel)) {
+            replica_set_error(replica, error, "upload accepted fewer bytes than provided");
+        }
+        uplink_free_error(uplink_upload_abort(replica->upload.upload));
+        replica->open = false;
+        return;
+    }
+    case REPLICA_STEP_COMMIT:
+        if (!replica->open) {
+            return;
+        }
+        replica->open = false;
+        error = uplink_upload_commit(replica->upload.upload);
+        if (error != NULL) {
+            replica_set_error(replica, error, "commit failed");
+            return;
+        }
+        replica->committed = true;
+        replica->info = uplink_upload_info(replica->upload.upload);
+        return;
+    case REPLICA_STEP_ABORT:
+        if (replica->open) {
+            uplink_free_error(uplink_upload_abort(replica->upload.upload));
+            replica->open = false;
+        }
+        return;
+    }
+}
+
+static bool replica_step_is_last(ReplicaStep step) {
+    return step == REPLICA_STEP_COMMIT || step == REPLICA_STEP_ABORT;
+}
+
+static void replica_worker(void* arg) {
+    ReplicaWorker* worker = (ReplicaWorker*)arg;
+    ReplicaFanout* fanout = worker->fanout;
+    uint64_t seen = 0;
+    for (;;) {
+        uv_mutex_lock(&fanout->lock);
+        while (fanout->generation == seen) {
+            uv_cond_wait(&fanout->step_ready, &fanout->lock);
+        }
+        seen = fanout->generation;
+        ReplicaStep step = fanout->step;
+        const uint8_t* data = fanout->data;
+        size_t length = fanout->length;
+        uv_mutex_unlock(&fanout->lock);
+        
+        replica_run_step(fanout->work_data, worker->replica, step, data, length);
+        
+        uv_mutex_lock(&fanout->lock);
+        if (--fanout->pending == 0) {
+            uv_cond_signal(&fanout->step_done);
+        }
+        uv_mutex_unlock(&fanout->lock);
+        if (replica_step_is_last(step)) {
+            return;
+        }
+    }
+}
+
+/** Publish a step to the target threads without waiting for it */
+static void replica_fanout_begin(ReplicaFanout* fanout, ReplicaStep step, const uint8_t* data, size_t length) {
+    uv_mutex_lock(&fanout->lock);
+    fanout->step = step;
+    fanout->data = data;
+    fanout->length = length;
+    fanout->pending = fanout->thread_count;
+    fanout->generation++;
+    uv_cond_broadcast(&fanout->step_ready);
+    uv_mutex_unlock(&fanout->lock);
+}
+
+/** Run the step for targets without a thread, then wait for the others */
+static void replica_fanout_finish(ReplicaFanout* fanout) {
+    UploadReplicatedData* work_data = fanout->work_data;
+    for (size_t i = 0; i < work_data->replica_count; i++) {
+        if (!fanout->threaded[i]) {
+            replica_run_step(work_data, &work_data->replicas[i], fanout->step, fanout->data, fanout->length);
+        }
+    }
+    uv_mutex_lock(&fanout->lock);
+    while (fanout->pending > 0) {
+        uv_cond_wait(&fanout->step_done, &fanout->lock);
+    }
+    uv_mutex_unlock(&fanout->lock);
+}
+
+static void replica_fanout_run(ReplicaFanout* fanout, ReplicaStep step, const uint8_t* data, size_t length) {
+    replica_fanout_begin(fanout, step, data, length);
+    replica_fanout_finish(fanout);
+}
+
+static size_t replicas_open(const UploadReplicatedData* work_data) {
+    size_t open = 0;
+    for (size_t i = 0; i < work_data->replica_count; i++) {
+        open += work_data->replicas[i].open ? 1 : 0;
+    }
+    return open;
+}
+
+/** Record a source read failure with strerror(errno) */
+static void upload_replicated_read_error(UploadReplicatedData* work_data, const char* what) {
+    char message[512];
+    snprintf(message, sizeof(message), "%s '%s': %s", what, work_data->file_path, strerror(errno));
+    work_data->error_code = UPLINK_ERROR_INTERNAL;
+    work_data->error_message = strdup(message);
+}
+
+/**
+ * Stream the source to the open targets. A file is read into two pooled
+ * buffers in turn, so chunk N+1 is read while chunk N is being written.
+ */
+static void upload_replicated_stream(UploadReplicatedData* work_data, ReplicaFanout* fanout, int fd) {
+    if (fd < 0) {
+        for (size_t offset = 0; offset < work_data->buffer_length; offset += work_data->chunk_size) {
+            if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message) ||
+                replicas_open(work_data) < work_data->quorum) {
+                return;
+            }
+            size_t left = work_data->buffer_length - offset;
+            size_t length = left < work_data->chunk_size ? left : work_data->chunk_size;
+            replica_fanout_run(fanout, REPLICA_STEP_WRITE, (uint8_t*)work_data->buffer_ptr + offset, length);
+            work_data->bytes_read += length;
+        }
+        return;
+    }
+    
+    uint8_t* chunks[2] = { buffer_pool_acquire(work_data->chunk_size), buffer_pool_acquire(work_data->chunk_size) };
+    if (chunks[0] == NULL || chunks[1] == NULL) {
+        errno = ENOMEM;
+        upload_replicated_read_error(work_data, "cannot read file");
+        goto done;
+    }
+    int current = 0;
+    int64_t n = file_read_at(fd, chunks[current], work_data->chunk_size, 0);
+    while (n > 0) {
+        if (cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message) ||
+            replicas_open(work_data) < work_data->quorum) {
+            goto done;
+        }
+        replica_fanout_begin(fanout, REPLICA_STEP_WRITE, chunks[current], (size_t)n);
+        work_data->bytes_read += (size_t)n;
+        int64_t next = file_read_at(fd, chunks[current ^ 1], work_data->chunk_size, (int64_t)work_data->bytes_read);
+        replica_fanout_finish(fanout);
+        current ^= 1;
+        n = next;
+    }
+    if (n < 0) {
+        upload_replicated_read_error(work_data, "cannot read file");
+    }
+    
+done:
+    buffer_pool_release(chunks[0]);
+    buffer_pool_release(chunks[1]);
+}
+
+/** Delete the committed targets after the quorum was missed */
+static void upload_replicated_rollback(UploadReplicatedData* work_data) {
+    for (size_t i = 0; i < work_data->replica_count; i++) {
+        UploadReplica* replica = &work_data->replicas[i];
+        if (!replica->committed) {
+            continue;
+        }
+        UplinkProject project = { ._handle = replica->project_handle };
+        UplinkObjectResult deleted = uplink_delete_object(&project, replica->bucket_name, replica->object_key);
+        if (deleted.error != NULL) {
+            LOG_WARN("uploadReplicated: cannot roll back %s/%s: %s", replica->bucket_name, replica->object_key,
+                     deleted.error->message ? deleted.error->message : "unknown error");
+        }
+        uplink_free_object_result(deleted);
+        uplink_free_object_result(replica->info);
+        memset(&replica->info, 0, sizeof(replica->info));
+        replica->committed = false;
+    }
+    work_data->committed = 0;
+}
+
+void upload_replicated_execute(napi_env env, void* data) {
+    (void)env;
+    UploadReplicatedData* work_data = (UploadReplicatedData*)data;
+    LOG_DEBUG("uploadReplicated: %zu targets, quorum %zu, chunk %zu (worker thread)",
+              work_data->replica_count, work_data->quorum, work_data->chunk_size);
+    
+    int fd = -1;
+    if (work_data->file_path != NULL) {
+        fd = file_open_read(work_data->file_path);
+        if (fd < 0) {
+            upload_replicated_read_error(work_data, "cannot open file");
+            return;
+        }
+    }
+    
+    ReplicaFanout fanout;
+    memset(&fanout, 0, sizeof(fanout));
+    fanout.work_data = work_data;
+    fanout.threaded = (bool*)calloc(work_data->replica_count, sizeof(bool));
+    ReplicaWorker* workers = (ReplicaWorker*)calloc(work_data->replica_count, sizeof(ReplicaWorker));
+    uv_thread_t* threads = (uv_thread_t*)calloc(work_data->replica_count, sizeof(uv_thread_t));
+    if (fanout.threaded == NULL || workers == NULL || threads == NULL) {
+        work_data->error_code = UPLINK_ERROR_INTERNAL;
+        work_data->error_message = strdup("Out of memory");
+        goto done;
+    }
+    uv_mutex_init(&fanout.lock);
+    uv_cond_init(&fanout.step_ready);
+    uv_cond_init(&fanout.step_done);
+    
+    /* Targets whose thread cannot start run their steps on this thread */
+    for (size_t i = 0; i < work_data->replica_count; i++) {
+        workers[i].fanout = &fanout;
+        workers[i].replica = &work_data->replicas[i];
+        if (uv_thread_create(&threads[fanout.thread_count], replica_worker, &workers[i]) != 0) {
+            LOG_WARN("uploadReplicated: no thread for target %zu, writing it sequentially", i);
+            continue;
+        }
+        fanout.threaded[i] = true;
+        fanout.thread_count++;
+    }
+    
+    replica_fanout_run(&fanout, REPLICA_STEP_OPEN, NULL, 0);
+    upload_replicated_stream(work_data, &fanout, fd);
+    
+    bool commit = work_data->error_code == 0 && replicas_open(work_data) >= work_data->quorum &&
+                  !cancel_token_check(work_data->cancel, &work_data->error_code, &work_data->error_message);
+    replica_fanout_run(&fanout, commit ? REPLICA_STEP_COMMIT : REPLICA_STEP_ABORT, NULL, 0);
+    for (size_t i = 0; i < fanout.thread_count; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    uv_cond_destroy(&fanout.step_done);
+    uv_cond_destroy(&fanout.step_ready);
+    uv_mutex_destroy(&fanout.lock);
+    
+    for (size_t i = 0; i < work_data->replica_count; i++) {
+        work_data->committed += work_data->replicas[i].committed ? 1 : 0;
+    }
+    if (work_data->committed < work_data->quorum && work_data->committed > 0) {
+        LOG_WARN("uploadReplicated: %zu of %zu targets committed, quorum %zu; rolling back",
+                 work_data->committed, work_data->replica_count, work_data->quorum);
+        upload_replicated_rollback(work_data);
+    }
+    
+done:
+    for (size_t i = 0; i < work_data->replica_count; i++) {
+        uplink_free_upload_result(work_data->replicas[i].upload);
+        memset(&work_data->replicas[i].upload, 0, sizeof(work_data->replicas[i].upload));
+    }
+    free(threads);
+    free(workers);
+    free(fanout.threaded);
+    if (fd >= 0) {
+        file_close(fd);
+    }
+}
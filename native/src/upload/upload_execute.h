@@ -11,9 +11,15 @@
 /* Execute functions - run on worker thread */
 void upload_object_execute(napi_env env, void* data);
 void upload_write_execute(napi_env env, void* data);
+void upload_writev_execute(napi_env env, void* data);
 void upload_commit_execute(napi_env env, void* data);
 void upload_abort_execute(napi_env env, void* data);
 void upload_set_metadata_execute(napi_env env, void* data);
 void upload_info_execute(napi_env env, void* data);
+void upload_file_execute(napi_env env, void* data);
+void put_object_execute(napi_env env, void* data);
+void put_object_dedup_hash_execute(napi_env env, void* data);
+void put_object_dedup_execute(napi_env env, void* data);
+void upload_replicated_execute(napi_env env, void* data);
 
 #endif /* UPLOAD_EXECUTE_H */
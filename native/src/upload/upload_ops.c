@@ -13,16 +13,87 @@
 #include "upload_types.h"
 #include "upload_execute.h"
 #include "upload_complete.h"
+#include "upload_queue.h"
 #include "../common/handle_helpers.h"
 #include "../common/string_helpers.h"
 #include "../common/buffer_helpers.h"
+#include "../common/buffer_pool.h"
+#include "../common/work_pool.h"
 #include "../common/result_helpers.h"
 #include "../common/type_converters.h"
+#include "../common/object_converter.h"
+#include "../common/thread_pool.h"
+#include "../common/admission.h"
 #include "../common/logger.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+/** Upper bound for writeBufferSize (64 MiB) */
+#define UPLOAD_MAX_WRITE_BUFFER_SIZE (64 * 1024 * 1024)
+
+/* ========== helper: per-handle state ========== */
+
+/**
+ * Get the state attached to an upload handle, or NULL if it could not be
+ * allocated.
+ */
+static UploadHandleState* get_upload_state(napi_env env, napi_value js_handle) {
+    HandleWrapper* wrapper = get_handle_wrapper(env, js_handle, HANDLE_TYPE_UPLOAD);
+    if (wrapper == NULL) {
+        return NULL;
+    }
+    return (UploadHandleState*)wrapper->attachment;
+}
+
+/**
+ * Get the serial queue of an upload handle, or NULL without state.
+ */
+static UploadSerialQueue* get_upload_queue(UploadHandleState* state) {
+    return state != NULL ? &state->queue : NULL;
+}
+
+/**
+ * Get the write-coalescing buffer of an upload handle, or NULL when
+ * writes are not coalesced.
+ */
+static UploadStagingBuffer* get_upload_staging(UploadHandleState* state) {
+    if (state == NULL || state->staging.capacity == 0) {
+        return NULL;
+    }
+    return &state->staging;
+}
+
+/**
+ * Get the running checksum of an upload handle, or NULL when disabled.
+ */
+static ChecksumState* get_upload_checksum(UploadHandleState* state) {
+    return state != NULL ? state->checksum : NULL;
+}
+
+/**
+ * Get the compression stage of an upload handle, or NULL when disabled.
+ */
+static UploadCodecStage* get_upload_codec(UploadHandleState* state) {
+    return state != NULL ? state->codec : NULL;
+}
+
+/**
+ * Hand the staged bytes over to an async operation. The caller owns
+ * the returned memory; the staging buffer reallocates on next use.
+ */
+static uint8_t* take_upload_staging(UploadStagingBuffer* staging, size_t* out_length) {
+    *out_length = 0;
+    if (staging == NULL || staging->length == 0) {
+        return NULL;
+    }
+    uint8_t* data = staging->data;
+    *out_length = staging->length;
+    staging->data = NULL;
+    staging->length = 0;
+    return data;
+}
+
 /* ========== upload_object ========== */
 
 napi_value upload_object(napi_env env, napi_callback_info info) {
@@ -40,16 +111,16 @@ napi_value upload_object(napi_env env, napi_callback_info info) {
     }
     
     char *bucket_name = NULL, *object_key = NULL;
-    if (extract_string_required(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
         extract_string_required(env, argv[2], "key", &object_key) != napi_ok) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
         return NULL;
     }
     
     UploadObjectData* work_data = (UploadObjectData*)calloc(1, sizeof(UploadObjectData));
     if (work_data == NULL) {
-        free(bucket_name);
+        bucket_name_release(bucket_name);
         free(object_key);
         return throw_error(env, "Out of memory");
     }
@@ -64,6 +135,48 @@ napi_value upload_object(napi_env env, napi_callback_info info) {
         napi_typeof(env, argv[3], &type);
         if (type == napi_object) {
             work_data->expires = get_date_property(env, argv[3], "expires", 0);
+            
+            int64_t write_buffer_size = get_int64_property(env, argv[3], "writeBufferSize", 0);
+            if (write_buffer_size < 0 || write_buffer_size > UPLOAD_MAX_WRITE_BUFFER_SIZE) {
+                bucket_name_release(bucket_name);
+                free(object_key);
+                free(work_data);
+                return throw_type_error(env, "writeBufferSize must be between 0 and 64 MiB");
+            }
+            work_data->write_buffer_size = (size_t)write_buffer_size;
+            
+            char* checksum_name = get_string_property(env, argv[3], "checksum");
+            if (checksum_name != NULL) {
+                work_data->checksum_type = checksum_type_from_name(checksum_name);
+                free(checksum_name);
+                if (work_data->checksum_type == CHECKSUM_NONE) {
+                    bucket_name_release(bucket_name);
+                    free(object_key);
+                    free(work_data);
+                    return throw_type_error(env, "checksum must be 'crc32c' or 'sha256'");
+                }
+            }
+            
+            char* codec_name = get_string_property(env, argv[3], "compress");
+            if (codec_name != NULL) {
+                work_data->codec_type = codec_type_from_name(codec_name);
+                free(codec_name);
+                if (work_data->codec_type == CODEC_NONE) {
+                    bucket_name_release(bucket_name);
+                    free(object_key);
+                    free(work_data);
+                    return throw_type_error(env, "compress must be 'lz4'");
+                }
+            }
+            
+            int64_t max_queued_bytes = get_int64_property(env, argv[3], "maxQueuedBytes", 0);
+            if (max_queued_bytes < 0 || max_queued_bytes > UPLOAD_QUEUE_MAX_BYTES) {
+                bucket_name_release(bucket_name);
+                free(object_key);
+                free(work_data);
+                return throw_type_error(env, "maxQueuedBytes must be between 0 and 1 GiB");
+            }
+            work_data->max_queued_bytes = (size_t)max_queued_bytes;
         }
     }
     
@@ -72,14 +185,29 @@ napi_value upload_object(napi_env env, napi_callback_info info) {
     
     napi_value work_name;
     napi_create_string_utf8(env, "uploadObject", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, upload_object_execute, upload_object_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    work_data->cancel = cancel_token_from_options(env, argc > 3 ? argv[3] : NULL);
+    admission_queue_work(env, work_data->project_handle, ADMISSION_TRANSFER, THREAD_POOL_LANE_METADATA, work_name, upload_object_execute, upload_object_complete, work_data, &work_data->work, &work_data->admission);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
     
     return promise;
 }
 
 /* ========== upload_write ========== */
 
+/** Queue copy hook: move an early-accepted write off the caller's buffer */
+static bool upload_write_copy(napi_env env, void* data) {
+    UploadWriteData* work_data = (UploadWriteData*)data;
+    work_data->copy = (uint8_t*)buffer_pool_acquire(work_data->data_length);
+    if (work_data->copy == NULL) {
+        return false;
+    }
+    memcpy(work_data->copy, work_data->buffer_ptr, work_data->data_length);
+    work_data->buffer_ptr = work_data->copy;
+    unpin_buffer(env, work_data->buffer_ref, work_data->data_length);
+    work_data->buffer_ref = NULL;
+    return true;
+}
+
 napi_value upload_write(napi_env env, napi_callback_info info) {
     size_t argc = 3;
     napi_value argv[3];
@@ -116,29 +244,195 @@ napi_value upload_write(napi_env env, napi_callback_info info) {
     
     size_t write_length = (size_t)requested_length;
     
-    UploadWriteData* work_data = (UploadWriteData*)calloc(1, sizeof(UploadWriteData));
+    /* Coalescing fast path: stage small writes and resolve without async work */
+    UploadHandleState* state = get_upload_state(env, argv[0]);
+    UploadStagingBuffer* staging = get_upload_staging(state);
+    if (staging != NULL && staging->length + write_length <= staging->capacity) {
+        /* Nothing is queued for staged bytes, so a failed or aborted upload is reported here */
+        napi_value queue_error = upload_queue_error(env, get_upload_queue(state));
+        if (queue_error != NULL) {
+            napi_deferred deferred;
+            napi_value promise;
+            napi_create_promise(env, &deferred, &promise);
+            napi_reject_deferred(env, deferred, queue_error);
+            return promise;
+        }
+        if (staging->data == NULL) {
+            staging->data = (uint8_t*)buffer_pool_acquire(staging->capacity);
+            if (staging->data == NULL) {
+                return throw_error(env, "Out of memory");
+            }
+        }
+        /* Staged bytes are hashed when they are flushed on the worker thread */
+        memcpy(staging->data + staging->length, buffer_data, write_length);
+        staging->length += write_length;
+        
+        napi_value bytes_written;
+        napi_create_int64(env, (int64_t)write_length, &bytes_written);
+        return create_resolved_promise(env, bytes_written);
+    }
+    
+    UploadWriteData* work_data = (UploadWriteData*)work_pool_calloc(1, sizeof(UploadWriteData));
     if (work_data == NULL) {
         return throw_error(env, "Out of memory");
     }
     
     work_data->upload_handle = upload_handle;
+    work_data->pending = take_upload_staging(staging, &work_data->pending_length);
+    work_data->checksum = get_upload_checksum(state);
+    work_data->codec = get_upload_codec(state);
+    work_data->bandwidth_project = get_handle_project(env, argv[0], HANDLE_TYPE_UPLOAD);
+    work_data->queue = get_upload_queue(state);
     work_data->buffer_ptr = buffer_data;  /* Point to JS buffer directly, no copy */
     work_data->data_length = write_length;
     
     /* Create reference to keep JS buffer alive during async work */
-    napi_create_reference(env, argv[1], 1, &work_data->buffer_ref);
+    pin_buffer(env, argv[1], write_length, &work_data->buffer_ref);
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
     
-    napi_value work_name;
-    napi_create_string_utf8(env, "uploadWrite", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, upload_write_execute, upload_write_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    UploadQueueSettle settle = { &work_data->deferred, NULL, write_length, true, upload_write_copy };
+    upload_queue_submit(env, work_data->queue, THREAD_POOL_LANE_BULK, "uploadWrite",
+                        upload_write_execute, upload_write_complete, work_data, settle);
     
     return promise;
 }
 
+/* ========== upload_writev ========== */
+
+/** Queue copy hook: move an early-accepted writev off the caller's buffers into one block */
+static bool upload_writev_copy(napi_env env, void* data) {
+    UploadWritevData* work_data = (UploadWritevData*)data;
+    size_t total = 0;
+    for (uint32_t i = 0; i < work_data->buffer_count; i++) {
+        total += work_data->buffer_lengths[i];
+    }
+    work_data->copy = (uint8_t*)buffer_pool_acquire(total > 0 ? total : 1);
+    if (work_data->copy == NULL) {
+        return false;
+    }
+    size_t offset = 0;
+    for (uint32_t i = 0; i < work_data->buffer_count; i++) {
+        memcpy(work_data->copy + offset, work_data->buffer_ptrs[i], work_data->buffer_lengths[i]);
+        work_data->buffer_ptrs[i] = work_data->copy + offset;
+        offset += work_data->buffer_lengths[i];
+        unpin_buffer(env, work_data->buffer_refs[i], work_data->buffer_lengths[i]);
+        work_data->buffer_refs[i] = NULL;
+    }
+    return true;
+}
+
+/**
+ * Shared argument handling for uploadWritev and uploadWritevCb, which
+ * takes a callback after the buffers and settles through it instead of a
+ * promise
+ */
+static napi_value queue_upload_writev(napi_env env, napi_callback_info info, bool with_callback) {
+    size_t argc = 3;
+    napi_value argv[3];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < (with_callback ? 3u : 2u)) {
+        return throw_type_error(env, with_callback ? "upload, buffers, and callback are required"
+                                                   : "upload and buffers are required");
+    }
+    if (with_callback) {
+        napi_valuetype callback_type;
+        napi_typeof(env, argv[2], &callback_type);
+        if (callback_type != napi_function) {
+            return throw_type_error(env, "callback must be a function");
+        }
+    }
+    
+    size_t upload_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_UPLOAD, &upload_handle) != napi_ok) {
+        return throw_type_error(env, "Invalid upload handle");
+    }
+    
+    bool is_array = false;
+    napi_is_array(env, argv[1], &is_array);
+    if (!is_array) {
+        return throw_type_error(env, "buffers must be an array of Buffers");
+    }
+    
+    uint32_t count = 0;
+    napi_get_array_length(env, argv[1], &count);
+    size_t total_length = 0;
+    
+    UploadWritevData* work_data = (UploadWritevData*)work_pool_calloc(1, sizeof(UploadWritevData));
+    if (work_data == NULL) {
+        return throw_error(env, "Out of memory");
+    }
+    
+    if (count > 0) {
+        work_data->buffer_ptrs = (void**)work_pool_calloc(count, sizeof(void*));
+        work_data->buffer_lengths = (size_t*)work_pool_calloc(count, sizeof(size_t));
+        work_data->buffer_refs = (napi_ref*)work_pool_calloc(count, sizeof(napi_ref));
+        if (work_data->buffer_ptrs == NULL || work_data->buffer_lengths == NULL || work_data->buffer_refs == NULL) {
+            work_pool_free(work_data->buffer_ptrs);
+            work_pool_free(work_data->buffer_lengths);
+            work_pool_free(work_data->buffer_refs);
+            work_pool_free(work_data);
+            return throw_error(env, "Out of memory");
+        }
+    }
+    
+    UploadHandleState* state = get_upload_state(env, argv[0]);
+    work_data->upload_handle = upload_handle;
+    work_data->pending = take_upload_staging(get_upload_staging(state), &work_data->pending_length);
+    work_data->checksum = get_upload_checksum(state);
+    work_data->codec = get_upload_codec(state);
+    work_data->bandwidth_project = get_handle_project(env, argv[0], HANDLE_TYPE_UPLOAD);
+    work_data->queue = get_upload_queue(state);
+    
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value element;
+        napi_get_element(env, argv[1], i, &element);
+        
+        if (extract_buffer(env, element, &work_data->buffer_ptrs[i], &work_data->buffer_lengths[i]) != napi_ok) {
+            for (uint32_t j = 0; j < work_data->buffer_count; j++) {
+                unpin_buffer(env, work_data->buffer_refs[j], work_data->buffer_lengths[j]);
+            }
+            work_pool_free(work_data->buffer_ptrs);
+            work_pool_free(work_data->buffer_lengths);
+            work_pool_free(work_data->buffer_refs);
+            buffer_pool_release(work_data->pending);
+            work_pool_free(work_data);
+            return throw_type_error(env, "buffers must be an array of Buffers");
+        }
+        
+        /* Pin each buffer for the lifetime of the async work */
+        pin_buffer(env, element, work_data->buffer_lengths[i], &work_data->buffer_refs[i]);
+        work_data->buffer_count = i + 1;
+        total_length += work_data->buffer_lengths[i];
+    }
+    
+    napi_value promise;
+    if (with_callback) {
+        extract_callback(env, argv[2], &work_data->callback);
+        napi_get_undefined(env, &promise);
+    } else {
+        napi_create_promise(env, &work_data->deferred, &promise);
+    }
+    
+    UploadQueueSettle settle = { &work_data->deferred, &work_data->callback, total_length, true, upload_writev_copy };
+    upload_queue_submit(env, work_data->queue, THREAD_POOL_LANE_BULK, with_callback ? "uploadWritevCb" : "uploadWritev",
+                        upload_writev_execute, upload_writev_complete, work_data, settle);
+    
+    return promise;
+}
+
+napi_value upload_writev(napi_env env, napi_callback_info info) {
+    return queue_upload_writev(env, info, false);
+}
+
+/* ========== upload_writev_cb ========== */
+
+napi_value upload_writev_cb(napi_env env, napi_callback_info info) {
+    return queue_upload_writev(env, info, true);
+}
+
 /* ========== upload_commit ========== */
 
 napi_value upload_commit(napi_env env, napi_callback_info info) {
@@ -154,21 +448,37 @@ napi_value upload_commit(napi_env env, napi_callback_info info) {
     if (extract_handle(env, argv[0], HANDLE_TYPE_UPLOAD, &upload_handle) != napi_ok) {
         return throw_type_error(env, "Invalid upload handle");
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_UPLOAD);
     
     UploadFinalizeData* work_data = (UploadFinalizeData*)calloc(1, sizeof(UploadFinalizeData));
     if (work_data == NULL) {
         return throw_error(env, "Out of memory");
     }
     
+    UploadHandleState* state = get_upload_state(env, argv[0]);
     work_data->upload_handle = upload_handle;
+    work_data->pending = take_upload_staging(get_upload_staging(state), &work_data->pending_length);
+    work_data->checksum = get_upload_checksum(state);
+    work_data->codec = get_upload_codec(state);
+    work_data->bandwidth_project = get_handle_project(env, argv[0], HANDLE_TYPE_UPLOAD);
+    if (work_data->checksum != NULL || work_data->codec != NULL) {
+        work_data->metadata_entries = state->metadata_entries;
+        work_data->metadata_count = state->metadata_count;
+    }
+    if (state != NULL && state->object_key != NULL) {
+        work_data->project_handle = state->project_handle;
+        work_data->bucket_name = bucket_name_retain(state->bucket_name);
+        work_data->object_key = strdup(state->object_key);
+    }
+    work_data->admission = take_handle_admission(env, argv[0], HANDLE_TYPE_UPLOAD);
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
     
-    napi_value work_name;
-    napi_create_string_utf8(env, "uploadCommit", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, upload_commit_execute, upload_commit_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    /* Runs after every write queued before it; skipped with their error if one failed */
+    UploadQueueSettle settle = { &work_data->deferred, NULL, 0, true, NULL };
+    upload_queue_submit(env, get_upload_queue(state), THREAD_POOL_LANE_BULK, "uploadCommit",
+                        upload_commit_execute, upload_commit_complete, work_data, settle);
     
     return promise;
 }
@@ -188,6 +498,7 @@ napi_value upload_abort(napi_env env, napi_callback_info info) {
     if (extract_handle(env, argv[0], HANDLE_TYPE_UPLOAD, &upload_handle) != napi_ok) {
         return throw_type_error(env, "Invalid upload handle");
     }
+    mark_handle_closed(env, argv[0], HANDLE_TYPE_UPLOAD);
     
     UploadFinalizeData* work_data = (UploadFinalizeData*)calloc(1, sizeof(UploadFinalizeData));
     if (work_data == NULL) {
@@ -195,85 +506,24 @@ napi_value upload_abort(napi_env env, napi_callback_info info) {
     }
     
     work_data->upload_handle = upload_handle;
+    work_data->admission = take_handle_admission(env, argv[0], HANDLE_TYPE_UPLOAD);
+    
+    /* Staged bytes are discarded along with the upload, and so are writes still waiting */
+    UploadHandleState* state = get_upload_state(env, argv[0]);
+    size_t discarded = 0;
+    buffer_pool_release(take_upload_staging(get_upload_staging(state), &discarded));
+    upload_queue_abort(get_upload_queue(state));
     
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
     
-    napi_value work_name;
-    napi_create_string_utf8(env, "uploadAbort", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, upload_abort_execute, upload_abort_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    UploadQueueSettle settle = { &work_data->deferred, NULL, 0, false, NULL };
+    upload_queue_submit(env, get_upload_queue(state), THREAD_POOL_LANE_METADATA, "uploadAbort",
+                        upload_abort_execute, upload_abort_complete, work_data, settle);
     
     return promise;
 }
 
-/* ========== helper: extract metadata entries from JS object ========== */
-
-/**
- * Free an array of UplinkCustomMetadataEntry up to @p count entries.
- */
-static void free_metadata_entries(UplinkCustomMetadataEntry* entries, uint32_t count) {
-    if (entries == NULL) return;
-    for (uint32_t i = 0; i < count; i++) {
-        free((void*)entries[i].key);
-        free((void*)entries[i].value);
-    }
-    free(entries);
-}
-
-/**
- * Extract UplinkCustomMetadataEntry array from a JS object.
- * All own-property values must be strings.
- *
- * @param[out] out_entries  Receives the malloc'd entry array (NULL when count is 0).
- * @param[out] out_count    Receives the number of entries.
- * @return  0 on success, -1 if a value is not a string, -2 on OOM.
- */
-static int extract_upload_metadata_from_js(napi_env env, napi_value js_meta,
-                                           UplinkCustomMetadataEntry** out_entries,
-                                           uint32_t* out_count) {
-    *out_entries = NULL;
-    *out_count = 0;
-
-    napi_value keys;
-    napi_get_property_names(env, js_meta, &keys);
-
-    uint32_t count;
-    napi_get_array_length(env, keys, &count);
-    if (count == 0) return 0;
-
-    UplinkCustomMetadataEntry* entries =
-        (UplinkCustomMetadataEntry*)calloc(count, sizeof(UplinkCustomMetadataEntry));
-    if (entries == NULL) return -2;
-
-    for (uint32_t i = 0; i < count; i++) {
-        napi_value key_val, value_val;
-        napi_get_element(env, keys, i, &key_val);
-        napi_get_property(env, js_meta, key_val, &value_val);
-
-        napi_valuetype val_type;
-        napi_typeof(env, value_val, &val_type);
-        if (val_type != napi_string) {
-            free_metadata_entries(entries, i);
-            return -1;
-        }
-
-        char* key = NULL;
-        char* value = NULL;
-        extract_string(env, key_val, &key);
-        extract_string(env, value_val, &value);
-
-        entries[i].key = key;
-        entries[i].key_length = key ? strlen(key) : 0;
-        entries[i].value = value;
-        entries[i].value_length = value ? strlen(value) : 0;
-    }
-
-    *out_entries = entries;
-    *out_count = count;
-    return 0;
-}
-
 /* ========== upload_set_custom_metadata ========== */
 
 napi_value upload_set_custom_metadata(napi_env env, napi_callback_info info) {
@@ -297,8 +547,8 @@ napi_value upload_set_custom_metadata(napi_env env, napi_callback_info info) {
     }
     
     UplinkCustomMetadataEntry* entries = NULL;
-    uint32_t count = 0;
-    int rc = extract_upload_metadata_from_js(env, argv[1], &entries, &count);
+    size_t count = 0;
+    int rc = extract_metadata_entries_from_js(env, argv[1], &entries, &count);
     if (rc == -1) {
         return throw_type_error(env, "metadata values must be strings");
     }
@@ -312,6 +562,20 @@ napi_value upload_set_custom_metadata(napi_env env, napi_callback_info info) {
         return throw_error(env, "Out of memory");
     }
     
+    /* With an inline checksum or codec, commit re-sends this metadata together with its own entries */
+    UploadHandleState* state = get_upload_state(env, argv[0]);
+    if (get_upload_checksum(state) != NULL || get_upload_codec(state) != NULL) {
+        UplinkCustomMetadataEntry* copy = NULL;
+        if (count > 0 && (copy = copy_metadata_entries(entries, count)) == NULL) {
+            free_metadata_entries(entries, count);
+            free(work_data);
+            return throw_error(env, "Out of memory");
+        }
+        free_metadata_entries(state->metadata_entries, state->metadata_count);
+        state->metadata_entries = copy;
+        state->metadata_count = count;
+    }
+    
     work_data->upload_handle = upload_handle;
     work_data->metadata.entries = entries;
     work_data->metadata.count = count;
@@ -319,10 +583,9 @@ napi_value upload_set_custom_metadata(napi_env env, napi_callback_info info) {
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
     
-    napi_value work_name;
-    napi_create_string_utf8(env, "uploadSetCustomMetadata", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, upload_set_metadata_execute, upload_set_metadata_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    UploadQueueSettle settle = { &work_data->deferred, NULL, 0, true, NULL };
+    upload_queue_submit(env, get_upload_queue(state), THREAD_POOL_LANE_METADATA, "uploadSetCustomMetadata",
+                        upload_set_metadata_execute, upload_set_metadata_complete, work_data, settle);
     
     return promise;
 }
@@ -350,13 +613,520 @@ napi_value upload_info(napi_env env, napi_callback_info info) {
     
     work_data->upload_handle = upload_handle;
     
+    /* Snapshot the running digest, folding in bytes still staged on this thread */
+    UploadHandleState* state = get_upload_state(env, argv[0]);
+    ChecksumState* checksum = get_upload_checksum(state);
+    if (checksum != NULL) {
+        work_data->has_checksum = true;
+        work_data->checksum = *checksum;
+        if (state->staging.length > 0) {
+            checksum_update(&work_data->checksum, state->staging.data, state->staging.length);
+        }
+    }
+    
     napi_value promise;
     napi_create_promise(env, &work_data->deferred, &promise);
     
     napi_value work_name;
     napi_create_string_utf8(env, "uploadInfo", NAPI_AUTO_LENGTH, &work_name);
-    napi_create_async_work(env, NULL, work_name, upload_info_execute, upload_info_complete, work_data, &work_data->work);
-    napi_queue_async_work(env, work_data->work);
+    thread_pool_queue_work(env, THREAD_POOL_LANE_METADATA, work_name, upload_info_execute, upload_info_complete, work_data, &work_data->work);
+    
+    return promise;
+}
+
+/* ========== upload_file ========== */
+
+napi_value upload_file(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 4) {
+        return throw_type_error(env, "project, bucket, key, and path are required");
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        return throw_type_error(env, "Invalid project handle");
+    }
+    
+    int64_t chunk_size = UPLOAD_FILE_DEFAULT_CHUNK_SIZE;
+    int64_t expires = 0;
+    bool use_mmap = false;
+    UplinkCustomMetadataEntry* entries = NULL;
+    size_t count = 0;
+    
+    if (argc >= 5) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            if (has_defined_property(env, argv[4], "compress")) {
+                return throw_type_error(env, "compress is only supported by uploadObject()");
+            }
+            chunk_size = get_int64_property(env, argv[4], "chunkSize", UPLOAD_FILE_DEFAULT_CHUNK_SIZE);
+            if (chunk_size <= 0) {
+                return throw_type_error(env, "chunkSize must be a positive number");
+            }
+            expires = get_date_property(env, argv[4], "expires", 0);
+            use_mmap = get_bool_property(env, argv[4], "mmap", 0) != 0;
+            
+            bool has_metadata = false;
+            napi_has_named_property(env, argv[4], "metadata", &has_metadata);
+            if (has_metadata) {
+                napi_value js_meta;
+                napi_valuetype meta_type;
+                napi_get_named_property(env, argv[4], "metadata", &js_meta);
+                napi_typeof(env, js_meta, &meta_type);
+                if (meta_type == napi_object) {
+                    int rc = extract_metadata_entries_from_js(env, js_meta, &entries, &count);
+                    if (rc == -1) {
+                        return throw_type_error(env, "All metadata values must be strings");
+                    }
+                    if (rc == -2) {
+                        return throw_error(env, "Out of memory");
+                    }
+                } else if (meta_type != napi_undefined && meta_type != napi_null) {
+                    return throw_type_error(env, "metadata must be an object");
+                }
+            }
+        }
+    }
+    
+    ProgressReporter* progress = NULL;
+    if (progress_reporter_from_options(env, argc > 4 ? argv[4] : NULL, "uploadFile", &progress) != 0) {
+        free_metadata_entries(entries, count);
+        return NULL;
+    }
+    
+    char *bucket_name = NULL, *object_key = NULL, *file_path = NULL;
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "key", &object_key) != napi_ok ||
+        extract_string_required(env, argv[3], "path", &file_path) != napi_ok) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free(file_path);
+        free_metadata_entries(entries, count);
+        progress_reporter_discard(progress);
+        return NULL;
+    }
+    
+    UploadFileData* work_data = (UploadFileData*)calloc(1, sizeof(UploadFileData));
+    if (work_data == NULL) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free(file_path);
+        free_metadata_entries(entries, count);
+        progress_reporter_discard(progress);
+        return throw_error(env, "Out of memory");
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->progress = progress;
+    work_data->bucket_name = bucket_name;
+    work_data->object_key = object_key;
+    work_data->file_path = file_path;
+    work_data->chunk_size = (size_t)chunk_size;
+    work_data->use_mmap = use_mmap;
+    work_data->expires = expires;
+    work_data->metadata_entries = entries;
+    work_data->metadata_count = count;
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "uploadFile", NAPI_AUTO_LENGTH, &work_name);
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(env, work_data->project_handle, ADMISSION_TRANSFER, lane, work_name, upload_file_execute, upload_file_complete, work_data, &work_data->work, NULL);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== put_object ========== */
+
+napi_value put_object(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 4) {
+        return throw_type_error(env, "project, bucket, key, and data are required");
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        return throw_type_error(env, "Invalid project handle");
+    }
+    
+    void* buffer_data;
+    size_t buffer_length;
+    if (extract_buffer(env, argv[3], &buffer_data, &buffer_length) != napi_ok) {
+        return throw_type_error(env, "data must be a Buffer");
+    }
+    
+    int64_t expires = 0;
+    UplinkCustomMetadataEntry* entries = NULL;
+    size_t count = 0;
+    
+    if (argc >= 5) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            if (has_defined_property(env, argv[4], "compress")) {
+                return throw_type_error(env, "compress is only supported by uploadObject()");
+            }
+            expires = get_date_property(env, argv[4], "expires", 0);
+            
+            bool has_metadata = false;
+            napi_has_named_property(env, argv[4], "metadata", &has_metadata);
+            if (has_metadata) {
+                napi_value js_meta;
+                napi_valuetype meta_type;
+                napi_get_named_property(env, argv[4], "metadata", &js_meta);
+                napi_typeof(env, js_meta, &meta_type);
+                if (meta_type == napi_object) {
+                    int rc = extract_metadata_entries_from_js(env, js_meta, &entries, &count);
+                    if (rc == -1) {
+                        return throw_type_error(env, "All metadata values must be strings");
+                    }
+                    if (rc == -2) {
+                        return throw_error(env, "Out of memory");
+                    }
+                } else if (meta_type != napi_undefined && meta_type != napi_null) {
+                    return throw_type_error(env, "metadata must be an object");
+                }
+            }
+        }
+    }
+    
+    ProgressReporter* progress = NULL;
+    if (progress_reporter_from_options(env, argc > 4 ? argv[4] : NULL, "putObject", &progress) != 0) {
+        free_metadata_entries(entries, count);
+        return NULL;
+    }
+    
+    char *bucket_name = NULL, *object_key = NULL;
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "key", &object_key) != napi_ok) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free_metadata_entries(entries, count);
+        progress_reporter_discard(progress);
+        return NULL;
+    }
+    
+    PutObjectData* work_data = (PutObjectData*)calloc(1, sizeof(PutObjectData));
+    if (work_data == NULL) {
+        bucket_name_release(bucket_name);
+        free(object_key);
+        free_metadata_entries(entries, count);
+        progress_reporter_discard(progress);
+        return throw_error(env, "Out of memory");
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->progress = progress;
+    work_data->bucket_name = bucket_name;
+    work_data->object_key = object_key;
+    work_data->buffer_ptr = buffer_data;
+    work_data->buffer_length = buffer_length;
+    work_data->expires = expires;
+    work_data->metadata_entries = entries;
+    work_data->metadata_count = count;
+    
+    /* Keep the JS buffer alive; the worker writes straight from it */
+    pin_buffer(env, argv[3], buffer_length, &work_data->buffer_ref);
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    napi_value work_name;
+    napi_create_string_utf8(env, "putObject", NAPI_AUTO_LENGTH, &work_name);
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(env, work_data->project_handle, ADMISSION_TRANSFER, lane, work_name, put_object_execute, put_object_complete, work_data, &work_data->work, NULL);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== put_object_dedup ========== */
+
+napi_value put_object_dedup(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 4) {
+        return throw_type_error(env, "project, bucket, keyTemplate, and source are required");
+    }
+    
+    size_t project_handle;
+    if (extract_handle(env, argv[0], HANDLE_TYPE_PROJECT, &project_handle) != napi_ok) {
+        return throw_type_error(env, "Invalid project handle");
+    }
+    
+    /* Source: a file path, or bytes written straight from the JS buffer */
+    napi_valuetype source_type;
+    napi_typeof(env, argv[3], &source_type);
+    void* buffer_data = NULL;
+    size_t buffer_length = 0;
+    if (source_type != napi_string && extract_buffer(env, argv[3], &buffer_data, &buffer_length) != napi_ok) {
+        return throw_type_error(env, "source must be a Buffer or a file path");
+    }
+    
+    ChecksumType algorithm = CHECKSUM_SHA256;
+    int64_t chunk_size = UPLOAD_FILE_DEFAULT_CHUNK_SIZE;
+    int64_t expires = 0;
+    UplinkCustomMetadataEntry* entries = NULL;
+    size_t count = 0;
+    
+    if (argc >= 5) {
+        napi_valuetype type;
+        napi_typeof(env, argv[4], &type);
+        if (type == napi_object) {
+            char* algorithm_name = get_string_property(env, argv[4], "algorithm");
+            if (algorithm_name != NULL) {
+                algorithm = checksum_type_from_name(algorithm_name);
+                free(algorithm_name);
+                if (algorithm == CHECKSUM_NONE) {
+                    return throw_type_error(env, "algorithm must be 'crc32c' or 'sha256'");
+                }
+            }
+            chunk_size = get_int64_property(env, argv[4], "chunkSize", UPLOAD_FILE_DEFAULT_CHUNK_SIZE);
+            if (chunk_size <= 0) {
+                return throw_type_error(env, "chunkSize must be a positive number");
+            }
+            expires = get_date_property(env, argv[4], "expires", 0);
+            
+            bool has_metadata = false;
+            napi_has_named_property(env, argv[4], "metadata", &has_metadata);
+            if (has_metadata) {
+                napi_value js_meta;
+                napi_valuetype meta_type;
+                napi_get_named_property(env, argv[4], "metadata", &js_meta);
+                napi_typeof(env, js_meta, &meta_type);
+                if (meta_type == napi_object) {
+                    int rc = extract_metadata_entries_from_js(env, js_meta, &entries, &count);
+                    if (rc == -1) {
+                        return throw_type_error(env, "All metadata values must be strings");
+                    }
+                    if (rc == -2) {
+                        return throw_error(env, "Out of memory");
+                    }
+                } else if (meta_type != napi_undefined && meta_type != napi_null) {
+                    return throw_type_error(env, "metadata must be an object");
+                }
+            }
+        }
+    }
+    
+    char *bucket_name = NULL, *key_template = NULL, *file_path = NULL;
+    if (extract_bucket_name(env, argv[1], "bucket", &bucket_name) != napi_ok ||
+        extract_string_required(env, argv[2], "keyTemplate", &key_template) != napi_ok ||
+        (source_type == napi_string && extract_string_required(env, argv[3], "source", &file_path) != napi_ok)) {
+        bucket_name_release(bucket_name);
+        free(key_template);
+        free(file_path);
+        free_metadata_entries(entries, count);
+        return NULL;
+    }
+    if (strstr(key_template, PUT_DEDUP_HASH_PLACEHOLDER) == NULL) {
+        bucket_name_release(bucket_name);
+        free(key_template);
+        free(file_path);
+        free_metadata_entries(entries, count);
+        return throw_type_error(env, "keyTemplate must contain " PUT_DEDUP_HASH_PLACEHOLDER);
+    }
+    
+    PutObjectDedupData* work_data = (PutObjectDedupData*)calloc(1, sizeof(PutObjectDedupData));
+    if (work_data == NULL) {
+        bucket_name_release(bucket_name);
+        free(key_template);
+        free(file_path);
+        free_metadata_entries(entries, count);
+        return throw_error(env, "Out of memory");
+    }
+    
+    work_data->project_handle = project_handle;
+    work_data->bucket_name = bucket_name;
+    work_data->key_template = key_template;
+    work_data->algorithm = algorithm;
+    work_data->file_path = file_path;
+    work_data->buffer_ptr = buffer_data;
+    work_data->buffer_length = buffer_length;
+    work_data->chunk_size = (size_t)chunk_size;
+    work_data->expires = expires;
+    work_data->metadata_entries = entries;
+    work_data->metadata_count = count;
+    if (file_path == NULL) {
+        /* Keep the JS buffer alive across both works */
+        pin_buffer(env, argv[3], buffer_length, &work_data->buffer_ref);
+    }
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    /* Hashing holds no transfer slot; only a miss queues for one */
+    napi_value work_name;
+    napi_create_string_utf8(env, "putObjectDedupHash", NAPI_AUTO_LENGTH, &work_name);
+    work_data->cancel = cancel_token_from_options(env, argc > 4 ? argv[4] : NULL);
+    work_data->lane = thread_pool_lane_option(env, argc > 4 ? argv[4] : NULL, THREAD_POOL_LANE_BULK);
+    thread_pool_queue_work(env, work_data->lane, work_name, put_object_dedup_hash_execute, put_object_dedup_hash_complete,
+                           work_data, &work_data->work);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
+    
+    return promise;
+}
+
+/* ========== upload_replicated ========== */
+
+static void upload_replicas_free(UploadReplica* replicas, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        free(replicas[i].bucket_name);
+        free(replicas[i].object_key);
+    }
+    free(replicas);
+}
+
+napi_value upload_replicated(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    
+    if (argc < 2) {
+        return throw_type_error(env, "source and targets are required");
+    }
+    
+    /* Source: a file path, or bytes written straight from the JS buffer */
+    napi_valuetype source_type;
+    napi_typeof(env, argv[0], &source_type);
+    void* buffer_data = NULL;
+    size_t buffer_length = 0;
+    if (source_type != napi_string && extract_buffer(env, argv[0], &buffer_data, &buffer_length) != napi_ok) {
+        return throw_type_error(env, "source must be a Buffer or a file path");
+    }
+    
+    bool is_array = false;
+    uint32_t target_count = 0;
+    napi_is_array(env, argv[1], &is_array);
+    if (is_array) {
+        napi_get_array_length(env, argv[1], &target_count);
+    }
+    if (!is_array || target_count == 0 || target_count > UPLOAD_REPLICATED_MAX_TARGETS) {
+        return throw_type_error(env, "targets must be an array of 1 to 16 { project, bucket, key } objects");
+    }
+    
+    int64_t quorum = target_count;
+    int64_t chunk_size = UPLOAD_FILE_DEFAULT_CHUNK_SIZE;
+    int64_t expires = 0;
+    UplinkCustomMetadataEntry* entries = NULL;
+    size_t count = 0;
+    
+    if (argc >= 3) {
+        napi_valuetype type;
+        napi_typeof(env, argv[2], &type);
+        if (type == napi_object) {
+            quorum = get_int64_property(env, argv[2], "quorum", target_count);
+            if (quorum < 1 || quorum > (int64_t)target_count) {
+                return throw_type_error(env, "quorum must be an integer from 1 to the number of targets");
+            }
+            chunk_size = get_int64_property(env, argv[2], "chunkSize", UPLOAD_FILE_DEFAULT_CHUNK_SIZE);
+            if (chunk_size <= 0) {
+                return throw_type_error(env, "chunkSize must be a positive number");
+            }
+            expires = get_date_property(env, argv[2], "expires", 0);
+            
+            bool has_metadata = false;
+            napi_has_named_property(env, argv[2], "metadata", &has_metadata);
+            if (has_metadata) {
+                napi_value js_meta;
+                napi_valuetype meta_type;
+                napi_get_named_property(env, argv[2], "metadata", &js_meta);
+                napi_typeof(env, js_meta, &meta_type);
+                if (meta_type == napi_object) {
+                    int rc = extract_metadata_entries_from_js(env, js_meta, &entries, &count);
+                    if (rc == -1) {
+                        return throw_type_error(env, "All metadata values must be strings");
+                    }
+                    if (rc == -2) {
+                        return throw_error(env, "Out of memory");
+                    }
+                } else if (meta_type != napi_undefined && meta_type != napi_null) {
+                    return throw_type_error(env, "metadata must be an object");
+                }
+            }
+        }
+    }
+    
+    UploadReplica* replicas = (UploadReplica*)calloc(target_count, sizeof(UploadReplica));
+    if (replicas == NULL) {
+        free_metadata_entries(entries, count);
+        return throw_error(env, "Out of memory");
+    }
+    for (uint32_t i = 0; i < target_count; i++) {
+        napi_value target, project;
+        napi_valuetype type;
+        napi_get_element(env, argv[1], i, &target);
+        napi_typeof(env, target, &type);
+        bool valid = type == napi_object &&
+                     napi_get_named_property(env, target, "project", &project) == napi_ok &&
+                     extract_handle(env, project, HANDLE_TYPE_PROJECT, &replicas[i].project_handle) == napi_ok;
+        if (valid) {
+            replicas[i].bucket_name = get_string_property(env, target, "bucket");
+            replicas[i].object_key = get_string_property(env, target, "key");
+            valid = replicas[i].bucket_name != NULL && replicas[i].bucket_name[0] != '\0' &&
+                    replicas[i].object_key != NULL && replicas[i].object_key[0] != '\0';
+        }
+        if (!valid) {
+            upload_replicas_free(replicas, target_count);
+            free_metadata_entries(entries, count);
+            return throw_type_error(env, "each target needs a project handle and non-empty bucket and key strings");
+        }
+    }
+    
+    char* file_path = NULL;
+    if (source_type == napi_string && extract_string_required(env, argv[0], "source", &file_path) != napi_ok) {
+        upload_replicas_free(replicas, target_count);
+        free_metadata_entries(entries, count);
+        return NULL;
+    }
+    
+    UploadReplicatedData* work_data = (UploadReplicatedData*)calloc(1, sizeof(UploadReplicatedData));
+    if (work_data == NULL) {
+        upload_replicas_free(replicas, target_count);
+        free(file_path);
+        free_metadata_entries(entries, count);
+        return throw_error(env, "Out of memory");
+    }
+    
+    work_data->file_path = file_path;
+    work_data->buffer_ptr = buffer_data;
+    work_data->buffer_length = buffer_length;
+    work_data->replicas = replicas;
+    work_data->replica_count = target_count;
+    work_data->quorum = (size_t)quorum;
+    work_data->chunk_size = (size_t)chunk_size;
+    work_data->expires = expires;
+    work_data->metadata_entries = entries;
+    work_data->metadata_count = count;
+    if (file_path == NULL) {
+        pin_buffer(env, argv[0], buffer_length, &work_data->buffer_ref);
+    }
+    
+    napi_value promise;
+    napi_create_promise(env, &work_data->deferred, &promise);
+    
+    /* One transfer slot, taken from the first target's project */
+    napi_value work_name;
+    napi_create_string_utf8(env, "uploadReplicated", NAPI_AUTO_LENGTH, &work_name);
+    work_data->cancel = cancel_token_from_options(env, argc > 2 ? argv[2] : NULL);
+    ThreadPoolLane lane = thread_pool_lane_option(env, argc > 2 ? argv[2] : NULL, THREAD_POOL_LANE_BULK);
+    admission_queue_work(env, replicas[0].project_handle, ADMISSION_TRANSFER, lane, work_name,
+                         upload_replicated_execute, upload_replicated_complete, work_data, &work_data->work, NULL);
+    cancel_token_attach(work_data->cancel, env, work_data->work);
     
     return promise;
 }
@@ -23,6 +23,20 @@ napi_value upload_object(napi_env env, napi_callback_info info);
  */
 napi_value upload_write(napi_env env, napi_callback_info info);
 
+/**
+ * Write several buffers to upload in a single async operation
+ * JS: uploadWritev(upload: UploadHandle, buffers: Buffer[]): Promise<number>
+ */
+napi_value upload_writev(napi_env env, napi_callback_info info);
+
+/**
+ * uploadWritev reporting through a Node-style callback instead of a promise,
+ * for the upload stream's write path
+ * JS: uploadWritevCb(upload: UploadHandle, buffers: Buffer[],
+ *                    callback: (error: Error | null, bytesWritten: number) => void): void
+ */
+napi_value upload_writev_cb(napi_env env, napi_callback_info info);
+
 /**
  * Commit/finalize upload
  * JS: uploadCommit(upload: UploadHandle): Promise<void>
@@ -47,4 +61,39 @@ napi_value upload_set_custom_metadata(napi_env env, napi_callback_info info);
  */
 napi_value upload_info(napi_env env, napi_callback_info info);
 
+/**
+ * Upload a local file in a single async operation
+ * JS: uploadFile(project: ProjectHandle, bucket: string, key: string, path: string,
+ *                options?: { chunkSize?: number, expires?: Date, metadata?: Record<string, string> }): Promise<ObjectInfo>
+ */
+napi_value upload_file(napi_env env, napi_callback_info info);
+
+/**
+ * Upload a buffer as a whole object in a single async operation
+ * JS: putObject(project: ProjectHandle, bucket: string, key: string, data: Buffer,
+ *               options?: { expires?: Date, metadata?: Record<string, string> }): Promise<ObjectInfo>
+ */
+napi_value put_object(napi_env env, napi_callback_info info);
+
+/**
+ * Upload content under a key derived from its digest, skipping the
+ * upload when that key already exists
+ * JS: putObjectDedup(project: ProjectHandle, bucket: string, keyTemplate: string,
+ *                    source: Buffer | string, options?: { algorithm?, expires?, metadata?,
+ *                    chunkSize? }): Promise<{ key, uploaded, object }>
+ */
+napi_value put_object_dedup(napi_env env, napi_callback_info info);
+
+/**
+ * Upload one source to several targets, reading it only once
+ * JS: uploadReplicated(source: Buffer | string, targets: Array<{ project, bucket, key }>,
+ *                      options?: { quorum?, chunkSize?, expires?, metadata? })
+ *     : Promise<{ bytesRead, committed, targets }>
+ *
+ * Targets are written concurrently and committed together once at least
+ * quorum (default: all) of them took every chunk. If fewer than quorum
+ * commits succeed, the committed ones are deleted again.
+ */
+napi_value upload_replicated(napi_env env, napi_callback_info info);
+
 #endif /* UPLINK_UPLOAD_OPS_H */
@@ -0,0 +1,233 @@
+/**
+ * @file upload_queue.c
+ * @brief Per-upload serial queue implementation
+ *
+ * Ops are queued on the pool as jobs through a trampoline that starts the
+ * next op from the complete of the previous one. Early acceptance walks a
+ * cursor forward over the queue, so each op is checked against the cap
+ * once however many are waiting.
+ */
+
+#include "upload_queue.h"
+#include "../common/work_pool.h"
+#include "../common/result_helpers.h"
+#include "../common/error_registry.h"
+#include "../common/logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct UploadQueuedOp {
+    struct UploadQueuedOp* next;
+    UploadSerialQueue* queue;
+    ThreadPoolLane lane;
+    const char* name;
+    napi_async_execute_callback execute;
+    napi_async_complete_callback complete;
+    void* data;
+    UploadQueueSettle settle;
+} UploadQueuedOp;
+
+/* ========== helpers ========== */
+
+static void queue_start_next(napi_env env, UploadSerialQueue* queue);
+
+static bool queue_stopped(const UploadSerialQueue* queue) {
+    return queue->error_code != 0 || queue->aborting;
+}
+
+/** Resolve waiting writes whose bytes fit under the cap, in order */
+static void queue_accept(napi_env env, UploadSerialQueue* queue) {
+    if (queue->max_queued_bytes == 0) {
+        return;
+    }
+    while (queue->accept != NULL) {
+        UploadQueuedOp* op = queue->accept;
+        bool first = op == queue->head;
+        if (!first && queue->accepted_bytes + op->settle.bytes > queue->max_queued_bytes) {
+            break;
+        }
+        if (op->settle.bytes > 0 && op->settle.deferred != NULL && *op->settle.deferred != NULL &&
+            !queue_stopped(queue)) {
+            /* The caller may refill its buffer once this resolves */
+            if (op->settle.copy == NULL || !op->settle.copy(env, op->data)) {
+                break;
+            }
+            napi_value bytes;
+            napi_create_int64(env, (int64_t)op->settle.bytes, &bytes);
+            napi_resolve_deferred(env, *op->settle.deferred, bytes);
+            *op->settle.deferred = NULL;
+        }
+        queue->accepted_bytes += op->settle.bytes;
+        queue->accept = op->next;
+    }
+}
+
+/** Unlink the head op once it has completed */
+static void queue_pop(UploadSerialQueue* queue) {
+    UploadQueuedOp* op = queue->head;
+    queue->head = op->next;
+    if (queue->head == NULL) {
+        queue->tail = NULL;
+    }
+    if (queue->accept == op) {
+        queue->accept = op->next;
+    } else {
+        queue->accepted_bytes -= op->settle.bytes;
+    }
+    queue->running = false;
+    work_pool_free(op);
+}
+
+static void queue_op_execute(napi_env env, void* data) {
+    UploadQueuedOp* op = (UploadQueuedOp*)data;
+    op->execute(env, op->data);
+}
+
+static void queue_op_complete(napi_env env, napi_status status, void* data) {
+    UploadQueuedOp* op = (UploadQueuedOp*)data;
+    UploadSerialQueue* queue = op->queue;
+    op->complete(env, status, op->data);
+    queue_pop(queue);
+    queue_start_next(env, queue);
+}
+
+/** Settle a skipped op with the queue's error and let it clean up */
+static void queue_skip(napi_env env, UploadSerialQueue* queue, UploadQueuedOp* op) {
+    napi_deferred deferred = op->settle.deferred != NULL ? *op->settle.deferred : NULL;
+    napi_ref callback = op->settle.callback != NULL ? *op->settle.callback : NULL;
+    if (deferred != NULL || callback != NULL) {
+        settle_error(env, deferred, callback, upload_queue_error(env, queue));
+    }
+    if (op->settle.deferred != NULL) {
+        *op->settle.deferred = NULL;
+    }
+    if (op->settle.callback != NULL) {
+        *op->settle.callback = NULL;
+    }
+    LOG_DEBUG("%s: skipped, upload %s", op->name, queue->aborting ? "aborted" : "failed");
+    op->complete(env, napi_cancelled, op->data);
+}
+
+static void queue_op_skipped_execute(napi_env env, void* data) {
+    (void)env;
+    (void)data;
+}
+
+static void queue_op_skipped_complete(napi_env env, napi_status status, void* data) {
+    (void)status;
+    UploadQueuedOp* op = (UploadQueuedOp*)data;
+    UploadSerialQueue* queue = op->queue;
+    queue_skip(env, queue, op);
+    queue_pop(queue);
+    queue_start_next(env, queue);
+}
+
+/**
+ * Start the head op. One that may no longer run still takes a trip
+ * through the pool, so its promise or callback never settles inside the
+ * call that queued it.
+ */
+static void queue_start_next(napi_env env, UploadSerialQueue* queue) {
+    while (queue->head != NULL && !queue->running) {
+        UploadQueuedOp* op = queue->head;
+        bool skip = op->settle.skippable && queue_stopped(queue);
+        queue->running = true;
+        queue_accept(env, queue);
+        napi_status status = skip
+            ? thread_pool_queue_job(env, op->lane, op->name, queue_op_skipped_execute, queue_op_skipped_complete, op)
+            : thread_pool_queue_job(env, op->lane, op->name, queue_op_execute, queue_op_complete, op);
+        if (status != napi_ok) {
+            LOG_ERROR("%s: cannot queue upload op", op->name);
+            upload_queue_fail(queue, UPLINK_ERROR_INTERNAL, "Cannot queue upload operation");
+            queue_skip(env, queue, op);
+            queue_pop(queue);
+        }
+    }
+    if (queue->head == NULL && queue->release != NULL) {
+        void (*release)(void*) = queue->release;
+        queue->release = NULL;
+        release(queue->owner);
+    }
+}
+
+/* ========== public API ========== */
+
+void upload_queue_init(UploadSerialQueue* queue, size_t max_queued_bytes) {
+    memset(queue, 0, sizeof(*queue));
+    queue->max_queued_bytes = max_queued_bytes;
+}
+
+void upload_queue_submit(napi_env env, UploadSerialQueue* queue, ThreadPoolLane lane, const char* name,
+                         napi_async_execute_callback execute, napi_async_complete_callback complete,
+                         void* data, UploadQueueSettle settle) {
+    UploadQueuedOp* op = queue != NULL ? (UploadQueuedOp*)work_pool_calloc(1, sizeof(UploadQueuedOp)) : NULL;
+    if (op == NULL) {
+        /* No queue (or no memory for the entry): run unordered, as before the queue existed */
+        thread_pool_queue_job(env, lane, name, execute, complete, data);
+        return;
+    }
+    op->queue = queue;
+    op->lane = lane;
+    op->name = name;
+    op->execute = execute;
+    op->complete = complete;
+    op->data = data;
+    op->settle = settle;
+
+    if (queue->tail != NULL) {
+        queue->tail->next = op;
+    } else {
+        queue->head = op;
+    }
+    queue->tail = op;
+    if (queue->accept == NULL) {
+        queue->accept = op;
+    }
+
+    if (queue->running) {
+        queue_accept(env, queue);
+    } else {
+        queue_start_next(env, queue);
+    }
+}
+
+void upload_queue_fail(UploadSerialQueue* queue, int32_t code, const char* message) {
+    if (queue == NULL || queue->error_code != 0) {
+        return;
+    }
+    queue->error_code = code != 0 ? code : UPLINK_ERROR_INTERNAL;
+    queue->error_message = strdup(message != NULL ? message : "Upload write failed");
+}
+
+void upload_queue_abort(UploadSerialQueue* queue) {
+    if (queue != NULL) {
+        queue->aborting = true;
+    }
+}
+
+napi_value upload_queue_error(napi_env env, const UploadSerialQueue* queue) {
+    if (queue == NULL) {
+        return NULL;
+    }
+    if (queue->error_code != 0) {
+        return create_typed_error(env, queue->error_code,
+                                  queue->error_message != NULL ? queue->error_message : "Upload write failed");
+    }
+    if (queue->aborting) {
+        return create_typed_error(env, UPLINK_ERROR_CANCELED, "Upload aborted");
+    }
+    return NULL;
+}
+
+bool upload_queue_release(UploadSerialQueue* queue, void (*release)(void* owner), void* owner) {
+    if (queue->head != NULL) {
+        queue->aborting = true;
+        queue->release = release;
+        queue->owner = owner;
+        return false;
+    }
+    free(queue->error_message);
+    queue->error_message = NULL;
+    return true;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file upload_queue.h
+ * @brief Per-upload serial queue of writes, metadata updates and commit
+ *
+ * Every operation that changes an upload goes through its handle's queue
+ * and is started on the addon pool only after the one before it has
+ * completed, so JS may call write() several times and then commit()
+ * without awaiting in between and the bytes still land in call order.
+ * The queue is driven from complete callbacks on the main thread and
+ * needs no lock.
+ *
+ * With a byte cap (uploadObject option maxQueuedBytes), write promises
+ * resolve as soon as their bytes fit under the cap instead of when they
+ * have been written, which gives fire-and-forget writers backpressure
+ * without a round trip per write. An accepted write's bytes are first
+ * copied out of the JS buffer, so the caller may reuse it at once; the
+ * cap bounds the memory those copies take. A write that fails afterwards poisons
+ * the queue: later writes and the commit reject with its error.
+ */
+
+#ifndef UPLOAD_QUEUE_H
+#define UPLOAD_QUEUE_H
+
+#include <node_api.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../common/thread_pool.h"
+
+/** Upper bound for maxQueuedBytes (1 GiB) */
+#define UPLOAD_QUEUE_MAX_BYTES (1024 * 1024 * 1024)
+
+struct UploadQueuedOp;
+
+/**
+ * Serial queue of one upload (main thread only)
+ */
+typedef struct {
+    struct UploadQueuedOp* head;        /* Running op, then those waiting */
+    struct UploadQueuedOp* tail;
+    struct UploadQueuedOp* accept;      /* First op not yet past the cap check */
+    bool running;                       /* head has been started */
+    size_t accepted_bytes;              /* Bytes of queued ops before @c accept */
+    size_t max_queued_bytes;            /* 0 = writes settle when written */
+    int32_t error_code;                 /* First write failure, 0 = none */
+    char* error_message;
+    bool aborting;                      /* Abort queued: skip what is still waiting */
+    void (*release)(void* owner);       /* Set when the owner went away while busy */
+    void* owner;
+} UploadSerialQueue;
+
+/**
+ * How a queued op is settled by the queue itself
+ */
+typedef struct {
+    napi_deferred* deferred;    /* Op's promise, settled early when accepted or skipped; NULL'd then */
+    napi_ref* callback;         /* Or its callback; never accepted early */
+    size_t bytes;               /* Payload counted against the cap; 0 for commit, abort and metadata */
+    bool skippable;             /* Skipped after a failed write or once aborting */
+    /**
+     * Copy the op's payload out of the JS buffers before it is accepted
+     * early (main thread, op not yet started); false leaves it to settle
+     * when written. NULL for ops without a payload.
+     */
+    bool (*copy)(napi_env env, void* data);
+} UploadQueueSettle;
+
+/**
+ * Initialise an empty queue
+ *
+ * @param max_queued_bytes Byte cap for early acceptance, 0 to disable
+ */
+void upload_queue_init(UploadSerialQueue* queue, size_t max_queued_bytes);
+
+/**
+ * Append an op and start it if the queue is idle (main thread)
+ *
+ * @p complete runs with napi_ok after @p execute, or with napi_cancelled
+ * when the op was skipped, after the queue has already settled it; it
+ * must then only clean up. Without a queue (@p queue NULL) the op is
+ * queued on the pool directly.
+ */
+void upload_queue_submit(napi_env env, UploadSerialQueue* queue, ThreadPoolLane lane, const char* name,
+                         napi_async_execute_callback execute, napi_async_complete_callback complete,
+                         void* data, UploadQueueSettle settle);
+
+/**
+ * Record a write failure so later ops reject with it (main thread)
+ */
+void upload_queue_fail(UploadSerialQueue* queue, int32_t code, const char* message);
+
+/**
+ * Mark the queue as aborting; ops still waiting are skipped
+ */
+void upload_queue_abort(UploadSerialQueue* queue);
+
+/**
+ * Error for an op submitted after a failure or an abort, or NULL when
+ * the queue still accepts work
+ */
+napi_value upload_queue_error(napi_env env, const UploadSerialQueue* queue);
+
+/**
+ * Release the queue along with its owner
+ *
+ * When ops are still queued, waiting ones are skipped and @p release is
+ * called with @p owner once the running one completes.
+ *
+ * @return true when the caller may free the owner now
+ */
+bool upload_queue_release(UploadSerialQueue* queue, void (*release)(void* owner), void* owner);
+
+#endif /* UPLOAD_QUEUE_H */
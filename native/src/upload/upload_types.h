@@ -8,10 +8,79 @@
 
 #include <node_api.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 /* Disable compat macros to avoid function name conflicts */
 #define UPLINK_DISABLE_NAMESPACE_COMPAT
 #include "uplink.h"
+#include "../common/checksum.h"
+#include "../common/codec.h"
+#include "../common/cancel_token.h"
+#include "../common/progress.h"
+#include "../common/thread_pool.h"
+#include "upload_queue.h"
+
+/* ========== Write Coalescing ========== */
+
+/**
+ * Native staging buffer for an upload opened with writeBufferSize.
+ *
+ * Attached to the upload's HandleWrapper and only touched on the main
+ * thread. Small writes are copied in and resolved immediately; when a
+ * write would overflow it, the staged bytes are handed to the next
+ * async operation (write, writev, or commit) and written first.
+ */
+typedef struct {
+    uint8_t* data;          /* Lazily taken from buffer_pool, capacity bytes */
+    size_t capacity;
+    size_t length;
+} UploadStagingBuffer;
+
+/* ========== Compression ========== */
+
+/**
+ * Compression stage of an upload opened with a codec.
+ *
+ * Bytes written are gathered into chunks of CODEC_DEFAULT_CHUNK_SIZE;
+ * each full chunk is compressed and written as one frame on the worker
+ * thread. Commit writes the last chunk, the frame size index, and the
+ * codec metadata. Touched only on worker threads, one write at a time.
+ */
+typedef struct {
+    CodecType type;
+    uint8_t* chunk;             /* Original bytes of the chunk being filled */
+    size_t chunk_length;
+    uint8_t* frame;             /* Header + compressed payload scratch */
+    uint32_t* index;            /* Frame size (header included) per chunk */
+    size_t index_count;
+    size_t index_capacity;
+    uint64_t raw_size;          /* Original bytes written */
+    uint64_t stored_size;       /* Frame bytes written */
+} UploadCodecStage;
+
+/* ========== Per-Handle State ========== */
+
+/** Custom metadata key prefix for inline checksums, e.g. "checksum-sha256" */
+#define UPLOAD_CHECKSUM_KEY_PREFIX "checksum-"
+
+/**
+ * Native state attached to an upload's HandleWrapper.
+ *
+ * Created for every upload to hold its serial queue. The checksum and
+ * codec stage are updated on worker threads as bytes are written; the
+ * queue runs one write at a time, so they need no lock.
+ */
+typedef struct {
+    UploadSerialQueue queue;                        /* Writes, metadata and commit, in call order */
+    UploadStagingBuffer staging;                    /* capacity 0 = no write coalescing */
+    ChecksumState* checksum;                        /* NULL = no inline checksum */
+    UploadCodecStage* codec;                        /* NULL = stored as written */
+    UplinkCustomMetadataEntry* metadata_entries;    /* Last metadata set from JS, re-sent with the digest/codec */
+    size_t metadata_count;
+    size_t project_handle;                          /* Object identity for stat cache invalidation */
+    char* bucket_name;                              /* NULL = project had no stat cache at upload start */
+    char* object_key;
+} UploadHandleState;
 
 /* ========== Async Work Data Structures ========== */
 
@@ -23,6 +92,13 @@ typedef struct {
     char* bucket_name;
     char* object_key;
     int64_t expires;
+    size_t write_buffer_size;   /* 0 = no write coalescing */
+    ChecksumType checksum_type; /* CHECKSUM_NONE = no inline checksum */
+    CodecType codec_type;       /* CODEC_NONE = no compression */
+    size_t max_queued_bytes;    /* 0 = queued writes settle when written */
+    struct AdmissionSlot* admission;    /* Transfer slot, moved to the handle on success */
+    CancelToken* cancel;                /* From options.cancelToken, or NULL */
+    bool cancelled;                     /* Opened after the token stopped; already aborted */
     UplinkUploadResult result;
     napi_deferred deferred;
     napi_async_work work;
@@ -33,22 +109,205 @@ typedef struct {
  */
 typedef struct {
     size_t upload_handle;
-    void* buffer_ptr;       /* Direct pointer to JS buffer (no copy) */
+    void* buffer_ptr;       /* Direct pointer to JS buffer, or into @c copy once accepted early */
     size_t data_length;
-    napi_ref buffer_ref;    /* Reference to keep JS buffer alive during async work */
+    napi_ref buffer_ref;    /* Reference to keep JS buffer alive during async work, NULL once copied */
+    uint8_t* copy;          /* Bytes copied for early acceptance (owned, from buffer_pool), or NULL */
+    uint8_t* pending;       /* Staged bytes to write first (owned, from buffer_pool), or NULL */
+    size_t pending_length;
+    ChecksumState* checksum; /* Handle's running checksum (borrowed), or NULL */
+    UploadCodecStage* codec; /* Handle's compression stage (borrowed), or NULL */
+    size_t bandwidth_project; /* Project whose bandwidth limits apply, or 0 */
+    UploadSerialQueue* queue; /* Handle's serial queue (borrowed), or NULL */
     UplinkWriteResult result;
+    napi_deferred deferred; /* NULL once resolved early by the queue */
+} UploadWriteData;
+
+/**
+ * Data structure for upload_writev operation
+ *
+ * Holds one pinned JS buffer per entry so a batch of chunks can be
+ * written back to back in a single worker hop.
+ */
+typedef struct {
+    size_t upload_handle;
+    uint32_t buffer_count;
+    void** buffer_ptrs;     /* Direct pointers to JS buffers, or into @c copy once accepted early */
+    size_t* buffer_lengths;
+    napi_ref* buffer_refs;  /* References keep JS buffers alive during async work, NULL once copied */
+    uint8_t* copy;          /* Bytes copied for early acceptance (owned, from buffer_pool), or NULL */
+    uint8_t* pending;       /* Staged bytes to write first (owned, from buffer_pool), or NULL */
+    size_t pending_length;
+    ChecksumState* checksum; /* Handle's running checksum (borrowed), or NULL */
+    UploadCodecStage* codec; /* Handle's compression stage (borrowed), or NULL */
+    size_t bandwidth_project; /* Project whose bandwidth limits apply, or 0 */
+    UploadSerialQueue* queue; /* Handle's serial queue (borrowed), or NULL */
+    size_t total_written;
+    UplinkError* error;
+    napi_deferred deferred; /* NULL when settled through @c callback or resolved early by the queue */
+    napi_ref callback;      /* uploadWritevCb: called (error, bytesWritten) */
+} UploadWritevData;
+
+/**
+ * Data structure for upload_file operation
+ *
+ * The whole upload (open, write loop, commit) runs inside one async work,
+ * so the error is captured as code + message on the worker thread.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    char* file_path;
+    size_t chunk_size;
+    bool use_mmap;          /* Map the file instead of reading it (falls back if unsupported) */
+    int64_t expires;
+    UplinkCustomMetadataEntry* metadata_entries;
+    size_t metadata_count;
+    size_t bytes_written;
+    UplinkObjectResult info;
+    CancelToken* cancel;    /* From options.cancelToken, or NULL */
+    ProgressReporter* progress; /* From options.onProgress, or NULL */
+    int32_t error_code;
+    char* error_message;
     napi_deferred deferred;
     napi_async_work work;
-} UploadWriteData;
+} UploadFileData;
+
+/**
+ * Data structure for put_object operation
+ *
+ * Like upload_file, the whole upload (open, metadata, write, commit, info)
+ * runs inside one async work, writing straight from the JS buffer.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    void* buffer_ptr;       /* Direct pointer to JS buffer (no copy) */
+    size_t buffer_length;
+    napi_ref buffer_ref;    /* Reference to keep JS buffer alive during async work */
+    int64_t expires;
+    UplinkCustomMetadataEntry* metadata_entries;
+    size_t metadata_count;
+    UplinkObjectResult info;
+    CancelToken* cancel;    /* From options.cancelToken, or NULL */
+    ProgressReporter* progress; /* From options.onProgress, or NULL */
+    int32_t error_code;
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} PutObjectData;
+
+/** Placeholder of putObjectDedup key templates replaced by the hex digest */
+#define PUT_DEDUP_HASH_PLACEHOLDER "{hash}"
+
+/**
+ * Data structure for put_object_dedup operation
+ *
+ * Runs as two async works: the source is hashed on a worker, the key is
+ * derived and looked up in the stat cache on the main thread, and only
+ * on a miss is the second work queued for a transfer slot to stat the
+ * key and upload the source when it is absent.
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* key_template;
+    char* object_key;       /* Derived from the digest after hashing */
+    ChecksumType algorithm;
+    char digest[CHECKSUM_HEX_MAX];
+    char* file_path;        /* Source file, or NULL for a buffer source */
+    void* buffer_ptr;       /* Direct pointer to JS buffer (no copy) */
+    size_t buffer_length;
+    napi_ref buffer_ref;    /* Reference to keep JS buffer alive during async work */
+    size_t chunk_size;      /* File read size */
+    int64_t expires;
+    UplinkCustomMetadataEntry* metadata_entries;
+    size_t metadata_count;
+    ThreadPoolLane lane;
+    uint64_t cache_epoch;
+    bool uploaded;          /* Absent, so the source was uploaded */
+    size_t bytes_written;
+    UplinkObjectResult info; /* Existing object, or the uploaded one */
+    CancelToken* cancel;    /* From options.cancelToken, or NULL */
+    int32_t error_code;
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} PutObjectDedupData;
+
+/** Most targets one upload_replicated call writes to */
+#define UPLOAD_REPLICATED_MAX_TARGETS 16
+
+/**
+ * One target of an upload_replicated operation
+ */
+typedef struct {
+    size_t project_handle;
+    char* bucket_name;
+    char* object_key;
+    UplinkUploadResult upload;  /* Stream, freed at the end of execute */
+    bool open;              /* Stream open and nothing failed yet */
+    bool committed;
+    size_t bytes_written;
+    UplinkObjectResult info;
+    int32_t error_code;
+    char* error_message;
+} UploadReplica;
+
+/**
+ * Data structure for upload_replicated operation
+ *
+ * The source is read once, a chunk at a time, into pooled native buffers
+ * and each chunk is written to every target's stream by its own native
+ * thread; the next chunk is read while the current one is being written.
+ */
+typedef struct {
+    char* file_path;        /* Source file, or NULL for a buffer source */
+    void* buffer_ptr;       /* Direct pointer to JS buffer (no copy) */
+    size_t buffer_length;
+    napi_ref buffer_ref;    /* Reference to keep JS buffer alive during async work */
+    UploadReplica* replicas;
+    size_t replica_count;
+    size_t quorum;          /* Commits needed; fewer rolls the committed ones back */
+    size_t chunk_size;
+    int64_t expires;
+    UplinkCustomMetadataEntry* metadata_entries;
+    size_t metadata_count;
+    size_t bytes_read;
+    size_t committed;
+    CancelToken* cancel;    /* From options.cancelToken, or NULL */
+    int32_t error_code;     /* Source failure or cancellation */
+    char* error_message;
+    napi_deferred deferred;
+    napi_async_work work;
+} UploadReplicatedData;
+
+/** Default chunk size for upload_file reads (1 MiB) */
+#define UPLOAD_FILE_DEFAULT_CHUNK_SIZE (1024 * 1024)
+
+/** Size of each mapped window when upload_file runs in mmap mode (64 MiB) */
+#define UPLOAD_FILE_MMAP_WINDOW (64 * 1024 * 1024)
 
 /**
  * Data structure for upload_commit and upload_abort operations
  */
 typedef struct {
     size_t upload_handle;
+    uint8_t* pending;       /* Staged bytes to write before commit (owned, from buffer_pool), or NULL */
+    size_t pending_length;
+    ChecksumState* checksum; /* Digest written as custom metadata before commit (borrowed), or NULL */
+    UploadCodecStage* codec; /* Compression stage finished before commit (borrowed), or NULL */
+    UplinkCustomMetadataEntry* metadata_entries;   /* Metadata to merge with the digest/codec (borrowed) */
+    size_t metadata_count;
+    size_t bandwidth_project; /* Project whose bandwidth limits apply to the flush, or 0 */
+    size_t project_handle;  /* Stat cache entry to invalidate after commit (bucket/key owned, or NULL) */
+    char* bucket_name;
+    char* object_key;
+    struct AdmissionSlot* admission;    /* Transfer slot taken from the handle, released on completion */
     UplinkError* error;
     napi_deferred deferred;
-    napi_async_work work;
 } UploadFinalizeData;
 
 /**
@@ -59,7 +318,6 @@ typedef struct {
     UplinkCustomMetadata metadata;
     UplinkError* error;
     napi_deferred deferred;
-    napi_async_work work;
 } UploadMetadataData;
 
 /**
@@ -67,6 +325,8 @@ typedef struct {
  */
 typedef struct {
     size_t upload_handle;
+    bool has_checksum;
+    ChecksumState checksum;     /* Snapshot including staged bytes */
     UplinkObjectResult result;
     napi_deferred deferred;
     napi_async_work work;
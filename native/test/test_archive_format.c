@@ -0,0 +1,311 @@
+/**
+ * @file native/test/test_archive_format.c
+ * @brief Unit tests for archive_format.c: CRC-32, ustar and pax headers,
+ *        and zip records with and without zip64
+ */
+
+#include "test_runtime.h"
+#include "../src/archive/archive_format.c"
+
+/* 2024-02-29 13:45:31 UTC */
+#define TEST_MTIME 1709214331
+#define TEST_DOS_DATE 0x585Du
+#define TEST_DOS_TIME 0x6DAFu
+
+static uint32_t get16(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t* p) {
+    return get16(p) | (get16(p + 2) << 16);
+}
+
+static uint64_t get64(const uint8_t* p) {
+    return (uint64_t)get32(p) | ((uint64_t)get32(p + 4) << 32);
+}
+
+static uint64_t octal(const uint8_t* field, size_t width) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < width && field[i] >= '0' && field[i] <= '7'; i++) {
+        value = value * 8 + (uint64_t)(field[i] - '0');
+    }
+    return value;
+}
+
+/** The stored checksum matches the block summed with its checksum field as spaces */
+static int tar_checksum_ok(const uint8_t* block) {
+    unsigned int sum = 0;
+    for (size_t i = 0; i < ARCHIVE_TAR_BLOCK; i++) {
+        sum += i >= TAR_CHKSUM && i < TAR_CHKSUM + 8 ? ' ' : block[i];
+    }
+    return octal(block + TAR_CHKSUM, 7) == sum;
+}
+
+static void make_name(char* name, size_t length, size_t slash_at) {
+    for (size_t i = 0; i < length; i++) {
+        name[i] = (char)('a' + i % 26);
+    }
+    if (slash_at > 0) {
+        name[slash_at] = '/';
+    }
+    name[length] = '\0';
+}
+
+/* ========== CRC-32 ========== */
+
+static int test_crc32(void) {
+    TEST_ASSERT(archive_crc32(0, (const uint8_t*)"", 0) == 0, "CRC-32 of nothing");
+    TEST_ASSERT(archive_crc32(0, (const uint8_t*)"123456789", 9) == 0xCBF43926u, "CRC-32 check value");
+    TEST_ASSERT(archive_crc32(0, (const uint8_t*)"hello zip", 9) == 0xAC95738Bu, "CRC-32 of a short string");
+
+    /* Split updates agree with one pass, across the 8-byte slices */
+    static uint8_t data[1000];
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 31 + 7);
+    uint32_t whole = archive_crc32(0, data, sizeof(data));
+    const size_t splits[] = { 1, 7, 8, 9, 500, 999 };
+    for (size_t s = 0; s < sizeof(splits) / sizeof(splits[0]); s++) {
+        uint32_t crc = archive_crc32(0, data, splits[s]);
+        crc = archive_crc32(crc, data + splits[s], sizeof(data) - splits[s]);
+        TEST_ASSERT(crc == whole, "split CRC-32 differs from one pass");
+    }
+    return 1;
+}
+
+/* ========== tar ========== */
+
+static int test_tar_short_name(void) {
+    uint8_t out[3 * ARCHIVE_TAR_BLOCK];
+    size_t written = archive_tar_header("dir/file.txt", 12, 11, TEST_MTIME, out);
+    TEST_ASSERT_EQ(written, ARCHIVE_TAR_BLOCK, "one ustar block");
+    TEST_ASSERT_STR_EQ((const char*)out + TAR_NAME, "dir/file.txt", "name");
+    TEST_ASSERT_STR_EQ((const char*)out + TAR_MODE, "0000644", "mode");
+    TEST_ASSERT_STR_EQ((const char*)out + TAR_SIZE, "00000000013", "size in octal");
+    TEST_ASSERT(octal(out + TAR_MTIME, 11) == TEST_MTIME, "mtime");
+    TEST_ASSERT_EQ(out[TAR_TYPEFLAG], '0', "regular file");
+    TEST_ASSERT(memcmp(out + TAR_MAGIC, "ustar\0" "00", 8) == 0, "ustar magic and version");
+    TEST_ASSERT_EQ(out[TAR_PREFIX], 0, "no prefix");
+    TEST_ASSERT(tar_checksum_ok(out), "header checksum");
+    return 1;
+}
+
+static int test_tar_prefix_split(void) {
+    char name[200];
+    make_name(name, 180, 120);
+    uint8_t out[3 * ARCHIVE_TAR_BLOCK];
+    size_t written = archive_tar_header(name, 180, 1, 0, out);
+    TEST_ASSERT_EQ(written, ARCHIVE_TAR_BLOCK, "a splittable name needs no pax header");
+    TEST_ASSERT(memcmp(out + TAR_PREFIX, name, 120) == 0 && out[TAR_PREFIX + 120] == 0, "prefix before the slash");
+    TEST_ASSERT(memcmp(out + TAR_NAME, name + 121, 59) == 0 && out[TAR_NAME + 59] == 0, "name after the slash");
+    TEST_ASSERT(tar_checksum_ok(out), "header checksum");
+    return 1;
+}
+
+static int test_tar_long_name_uses_pax(void) {
+    char name[400];
+    make_name(name, 300, 0);
+    static uint8_t out[4 * ARCHIVE_TAR_BLOCK];
+    size_t written = archive_tar_header(name, 300, 5, TEST_MTIME, out);
+    TEST_ASSERT(written <= archive_tar_header_capacity(300), "within the advertised capacity");
+    TEST_ASSERT_EQ(written % ARCHIVE_TAR_BLOCK, 0, "whole blocks");
+    TEST_ASSERT_EQ(out[TAR_TYPEFLAG], 'x', "pax extended header first");
+    TEST_ASSERT(tar_checksum_ok(out), "pax header checksum");
+
+    /* "<length> path=<name>\n", where length counts the whole record */
+    size_t records = (size_t)octal(out + TAR_SIZE, 11);
+    const char* record = (const char*)out + ARCHIVE_TAR_BLOCK;
+    TEST_ASSERT_EQ(records, strtoul(record, NULL, 10), "one record, its length self-consistent");
+    TEST_ASSERT(memcmp(strchr(record, ' ') + 1, "path=", 5) == 0, "path record");
+    TEST_ASSERT(memcmp(strchr(record, '=') + 1, name, 300) == 0, "full name in the record");
+    TEST_ASSERT_EQ(record[records - 1], '\n', "record ends in a newline");
+
+    const uint8_t* ustar = out + written - ARCHIVE_TAR_BLOCK;
+    TEST_ASSERT_EQ(ustar[TAR_TYPEFLAG], '0', "ustar header follows");
+    TEST_ASSERT(memcmp(ustar + TAR_NAME, name, 100) == 0, "ustar name is the cut-off name");
+    TEST_ASSERT(octal(ustar + TAR_SIZE, 11) == 5, "ustar size");
+    TEST_ASSERT(tar_checksum_ok(ustar), "ustar header checksum");
+    return 1;
+}
+
+static int test_tar_large_size(void) {
+    uint64_t size = 10ull << 30;  /* past the 8 GiB octal limit */
+    static uint8_t out[4 * ARCHIVE_TAR_BLOCK];
+    size_t written = archive_tar_header("big.bin", 7, size, 0, out);
+    TEST_ASSERT_EQ(written, 3 * ARCHIVE_TAR_BLOCK, "pax header, one record block, ustar header");
+    TEST_ASSERT(strstr((const char*)out + ARCHIVE_TAR_BLOCK, " size=10737418240\n") != NULL, "size record");
+
+    const uint8_t* ustar = out + 2 * ARCHIVE_TAR_BLOCK;
+    TEST_ASSERT_EQ(ustar[TAR_SIZE], 0x80, "base-256 size marker");
+    uint64_t decoded = 0;
+    for (size_t i = 1; i < 12; i++) decoded = (decoded << 8) | ustar[TAR_SIZE + i];
+    TEST_ASSERT(decoded == size, "base-256 size");
+    TEST_ASSERT(tar_checksum_ok(ustar), "ustar header checksum");
+
+    /* The largest octal size still fits the plain header */
+    TEST_ASSERT_EQ(archive_tar_header("edge", 4, TAR_OCTAL_SIZE_MAX, 0, out), ARCHIVE_TAR_BLOCK, "octal limit");
+    return 1;
+}
+
+static int test_tar_padding_and_capacity(void) {
+    TEST_ASSERT_EQ(archive_tar_padding(0), 0, "empty");
+    TEST_ASSERT_EQ(archive_tar_padding(1), 511, "one byte");
+    TEST_ASSERT_EQ(archive_tar_padding(512), 0, "one block");
+    TEST_ASSERT_EQ(archive_tar_padding(513), 511, "just past a block");
+
+    static char name[2001];
+    static uint8_t out[8 * ARCHIVE_TAR_BLOCK];
+    const size_t lengths[] = { 1, 100, 101, 155, 256, 257, 999, 2000 };
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        make_name(name, lengths[i], 0);
+        size_t written = archive_tar_header(name, lengths[i], 1ull << 40, 0, out);
+        TEST_ASSERT(written <= archive_tar_header_capacity(lengths[i]), "header exceeds its capacity");
+    }
+    return 1;
+}
+
+/* ========== zip ========== */
+
+static int test_zip_local_header(void) {
+    ArchiveZipEntry entry = { "a/é.txt", 8, 9, TEST_MTIME, 0xAC95738Bu, 0, false };
+    uint8_t out[128];
+    size_t written = archive_zip_local_header(&entry, out);
+    TEST_ASSERT_EQ(written, 30 + 8, "fixed fields and name");
+    TEST_ASSERT(get32(out) == 0x04034b50u, "signature");
+    TEST_ASSERT_EQ(get16(out + 4), 20, "version needed");
+    TEST_ASSERT_EQ(get16(out + 6), 0x0800, "UTF-8 names");
+    TEST_ASSERT_EQ(get16(out + 8), 0, "stored");
+    TEST_ASSERT_EQ(get16(out + 10), TEST_DOS_TIME, "DOS time");
+    TEST_ASSERT_EQ(get16(out + 12), TEST_DOS_DATE, "DOS date");
+    TEST_ASSERT(get32(out + 14) == 0xAC95738Bu, "CRC");
+    TEST_ASSERT(get32(out + 18) == 9 && get32(out + 22) == 9, "sizes");
+    TEST_ASSERT_EQ(get16(out + 26), 8, "name length");
+    TEST_ASSERT_EQ(get16(out + 28), 0, "no extra field");
+    TEST_ASSERT(memcmp(out + 30, "a/é.txt", 8) == 0, "name");
+
+    entry.descriptor = true;
+    archive_zip_local_header(&entry, out);
+    TEST_ASSERT_EQ(get16(out + 6), 0x0808, "descriptor flag");
+    TEST_ASSERT(get32(out + 14) == 0, "CRC deferred to the descriptor");
+    TEST_ASSERT_EQ(archive_zip_descriptor(&entry, out), 16, "32-bit descriptor");
+    TEST_ASSERT(get32(out) == 0x08074b50u && get32(out + 4) == 0xAC95738Bu && get32(out + 8) == 9, "descriptor fields");
+
+    /* Before 1980 clamps to the DOS epoch */
+    entry.mtime = 0;
+    archive_zip_local_header(&entry, out);
+    TEST_ASSERT_EQ(get16(out + 12), (1u << 5) | 1u, "1980-01-01");
+    TEST_ASSERT_EQ(get16(out + 10), 0, "midnight");
+    return 1;
+}
+
+static int test_zip64_entry(void) {
+    uint64_t size = 5ull << 30;
+    ArchiveZipEntry entry = { "big.bin", 7, size, TEST_MTIME, 0x12345678u, 6ull << 30, true };
+    uint8_t out[256];
+
+    size_t written = archive_zip_local_header(&entry, out);
+    TEST_ASSERT(written <= archive_zip_header_capacity(7), "local header within capacity");
+    TEST_ASSERT_EQ(get16(out + 4), 45, "zip64 version needed");
+    TEST_ASSERT(get32(out + 18) == 0xFFFFFFFFu && get32(out + 22) == 0xFFFFFFFFu, "sizes deferred to zip64");
+    TEST_ASSERT_EQ(get16(out + 28), 20, "zip64 extra field");
+    TEST_ASSERT_EQ(get16(out + 37), 1, "zip64 extra id");
+    TEST_ASSERT(get64(out + 41) == size && get64(out + 49) == size, "64-bit sizes");
+
+    TEST_ASSERT_EQ(archive_zip_descriptor(&entry, out), ARCHIVE_ZIP_DESCRIPTOR_MAX, "64-bit descriptor");
+    TEST_ASSERT(get64(out + 8) == size && get64(out + 16) == size, "descriptor sizes");
+
+    written = archive_zip_central_header(&entry, out);
+    TEST_ASSERT(written <= archive_zip_header_capacity(7), "central header within capacity");
+    TEST_ASSERT(get32(out) == 0x02014b50u, "central signature");
+    TEST_ASSERT_EQ(get16(out + 4), (3u << 8) | 45, "made by Unix, zip64");
+    TEST_ASSERT(get32(out + 16) == 0x12345678u, "CRC is known by the directory");
+    TEST_ASSERT(get32(out + 42) == 0xFFFFFFFFu, "offset deferred to zip64");
+    TEST_ASSERT(get32(out + 38) == 0100644u << 16, "regular file, 0644");
+    const uint8_t* extra = out + 46 + 7;
+    TEST_ASSERT_EQ(get16(out + 30), 4 + 24, "extra length");
+    TEST_ASSERT(get16(extra) == 1 && get16(extra + 2) == 24, "zip64 extra header");
+    TEST_ASSERT(get64(extra + 4) == size && get64(extra + 12) == size, "64-bit sizes");
+    TEST_ASSERT(get64(extra + 20) == 6ull << 30, "64-bit offset");
+    return 1;
+}
+
+static int test_zip_end_records(void) {
+    uint8_t out[ARCHIVE_ZIP_END_MAX];
+    size_t written = archive_zip_end(3, 1000, 200, out);
+    TEST_ASSERT_EQ(written, 22, "classic end record only");
+    TEST_ASSERT(get32(out) == 0x06054b50u, "end signature");
+    TEST_ASSERT(get16(out + 8) == 3 && get16(out + 10) == 3, "entry counts");
+    TEST_ASSERT(get32(out + 12) == 200 && get32(out + 16) == 1000, "directory size and offset");
+
+    written = archive_zip_end(70000, 5ull << 30, 300, out);
+    TEST_ASSERT_EQ(written, ARCHIVE_ZIP_END_MAX, "zip64 end record, locator, end record");
+    TEST_ASSERT(get32(out) == 0x06064b50u, "zip64 end signature");
+    TEST_ASSERT(get64(out + 4) == 44, "zip64 record size");
+    TEST_ASSERT(get64(out + 24) == 70000 && get64(out + 40) == 300 && get64(out + 48) == 5ull << 30, "zip64 fields");
+    TEST_ASSERT(get32(out + 56) == 0x07064b50u, "locator signature");
+    TEST_ASSERT(get64(out + 64) == (5ull << 30) + 300, "locator points at the zip64 record");
+    const uint8_t* end = out + 76;
+    TEST_ASSERT(get32(end) == 0x06054b50u, "classic end record last");
+    TEST_ASSERT(get16(end + 10) == 0xFFFF && get32(end + 16) == 0xFFFFFFFFu, "classic fields defer to zip64");
+    return 1;
+}
+
+static int test_zip_archive_walks(void) {
+    /* Two entries, the second with a descriptor, then the directory */
+    static uint8_t zip[4096];
+    ArchiveZipEntry entries[2] = {
+        { "a.txt", 5, 9, TEST_MTIME, 0, 0, false },
+        { "dir/b.txt", 9, 9, TEST_MTIME, 0, 0, true },
+    };
+    const char* data = "hello zip";
+    size_t at = 0;
+    for (int i = 0; i < 2; i++) {
+        entries[i].offset = at;
+        entries[i].crc = archive_crc32(0, (const uint8_t*)data, 9);
+        at += archive_zip_local_header(&entries[i], zip + at);
+        memcpy(zip + at, data, 9);
+        at += 9;
+        if (entries[i].descriptor) {
+            at += archive_zip_descriptor(&entries[i], zip + at);
+        }
+    }
+    size_t directory = at;
+    for (int i = 0; i < 2; i++) {
+        at += archive_zip_central_header(&entries[i], zip + at);
+    }
+    at += archive_zip_end(2, directory, at - directory, zip + at);
+
+    /* Walk it the way an unzipper does: from the end record back to each entry */
+    const uint8_t* end = zip + at - 22;
+    TEST_ASSERT(get32(end) == 0x06054b50u, "end record at the tail");
+    const uint8_t* central = zip + get32(end + 16);
+    for (uint32_t i = 0; i < get16(end + 10); i++) {
+        TEST_ASSERT(get32(central) == 0x02014b50u, "central header");
+        size_t name_length = get16(central + 28);
+        const uint8_t* local = zip + get32(central + 42);
+        TEST_ASSERT(get32(local) == 0x04034b50u, "offset leads to a local header");
+        TEST_ASSERT(memcmp(local + 30, central + 46, name_length) == 0, "names agree");
+        const uint8_t* body = local + 30 + get16(local + 26) + get16(local + 28);
+        TEST_ASSERT(archive_crc32(0, body, get32(central + 24)) == get32(central + 16), "data matches the CRC");
+        central += 46 + name_length + get16(central + 30) + get16(central + 32);
+    }
+    TEST_ASSERT(central == zip + directory + get32(end + 12), "directory size covers the headers");
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Archive Format Tests");
+
+    RUN_TEST(test_crc32);
+    RUN_TEST(test_tar_short_name);
+    RUN_TEST(test_tar_prefix_split);
+    RUN_TEST(test_tar_long_name_uses_pax);
+    RUN_TEST(test_tar_large_size);
+    RUN_TEST(test_tar_padding_and_capacity);
+    RUN_TEST(test_zip_local_header);
+    RUN_TEST(test_zip64_entry);
+    RUN_TEST(test_zip_end_records);
+    RUN_TEST(test_zip_archive_walks);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,252 @@
+/**
+ * @file native/test/test_bandwidth.c
+ * @brief Unit tests for bandwidth.c: token bucket arithmetic, grant
+ *        sizes, the rate held over time, refunds, cancellation, and
+ *        weighted sharing of the process-wide limit
+ */
+
+#include "test_runtime.h"
+#include "../src/common/bandwidth.c"
+
+#define KIB 1024u
+#define MS 1000000ull
+
+static double seconds_since(uint64_t start) {
+    return (double)(uv_hrtime() - start) / 1e9;
+}
+
+/** Drop every limit so tests start from an unlimited process */
+static void reset_limits(void) {
+    bandwidth_set_global(0, 0);
+    for (size_t handle = 1; handle <= 8; handle++) {
+        bandwidth_remove(handle);
+    }
+}
+
+static int test_bucket_slice_and_capacity(void) {
+    BandwidthBucket bucket = { 0, 0, 0 };
+    TEST_ASSERT_EQ(bucket_slice(&bucket), BANDWIDTH_MIN_SLICE, "slice never below the minimum");
+    bucket.rate = 32 * KIB;
+    TEST_ASSERT_EQ(bucket_slice(&bucket), BANDWIDTH_MIN_SLICE, "slow links still get the minimum slice");
+    bucket.rate = 1024 * KIB;
+    TEST_ASSERT_EQ(bucket_slice(&bucket), 64 * KIB, "a sixteenth of a second of traffic");
+    bucket.rate = 1024ull * 1024 * KIB;
+    TEST_ASSERT_EQ(bucket_slice(&bucket), BANDWIDTH_MAX_SLICE, "slice never above the maximum");
+
+    bucket.rate = 1024 * KIB;
+    TEST_ASSERT(bucket_capacity(&bucket) == 256.0 * KIB, "a quarter second of burst");
+    bucket.rate = 8 * KIB;
+    TEST_ASSERT(bucket_capacity(&bucket) == (double)BANDWIDTH_MIN_SLICE, "capacity holds at least one slice");
+    return 1;
+}
+
+static int test_bucket_refill_and_give(void) {
+    BandwidthBucket bucket;
+    bucket_set_rate(&bucket, 1024 * KIB);
+    TEST_ASSERT(bucket.tokens == 256.0 * KIB, "a new rate starts with a full bucket");
+
+    bucket.tokens = 0;
+    bucket.refilled = 1000 * MS;
+    bucket_refill(&bucket, 1100 * MS);
+    TEST_ASSERT(bucket.tokens > 102.3 * KIB && bucket.tokens < 102.5 * KIB, "100 ms of tokens accrue");
+    bucket_refill(&bucket, 1050 * MS);
+    TEST_ASSERT(bucket.tokens > 102.3 * KIB && bucket.tokens < 102.5 * KIB, "a clock step back adds nothing");
+    bucket_refill(&bucket, 60000 * MS);
+    TEST_ASSERT(bucket.tokens == 256.0 * KIB, "an idle bucket banks no more than its capacity");
+
+    bucket.tokens = 0;
+    bucket_give(&bucket, 4 * KIB);
+    TEST_ASSERT(bucket.tokens == 4.0 * KIB, "refund returns tokens");
+    bucket_give(&bucket, 1024 * KIB);
+    TEST_ASSERT(bucket.tokens == 256.0 * KIB, "refunds are capped too");
+
+    BandwidthBucket unlimited;
+    bucket_set_rate(&unlimited, 0);
+    bucket_give(&unlimited, 4 * KIB);
+    TEST_ASSERT(unlimited.tokens == 0, "an unlimited bucket keeps no tokens");
+    return 1;
+}
+
+static int test_bucket_waits(void) {
+    BandwidthBucket bucket;
+    bucket_set_rate(&bucket, 1024 * KIB);
+    TEST_ASSERT(bucket_need(&bucket, 4 * KIB) == 4.0 * KIB, "need the grant");
+    TEST_ASSERT(bucket_need(&bucket, 1024 * KIB) == 256.0 * KIB, "never more than the bucket can hold");
+
+    bucket.tokens = 0;
+    uint64_t wait = bucket_wait_ns(&bucket, 1.0 * KIB);
+    TEST_ASSERT(wait > 976 * 1000 && wait < 978 * 1000, "sleep for exactly the missing tokens");
+    TEST_ASSERT(bucket_wait_ns(&bucket, 200.0 * KIB) == BANDWIDTH_POLL_NS, "long waits are polled");
+    bucket.tokens = 2.0 * KIB;
+    TEST_ASSERT(bucket_wait_ns(&bucket, 1.0 * KIB) == 1, "no wait with tokens to spare");
+    return 1;
+}
+
+static int test_fair_queue_order(void) {
+    BandwidthLink link = { { 0, 0, 0 }, 0, NULL };
+    BandwidthWaiter a = { NULL, 3 }, b = { NULL, 1 }, c = { NULL, 2 }, d = { NULL, 2 };
+    queue_insert(&link, &a);
+    queue_insert(&link, &b);
+    queue_insert(&link, &c);
+    queue_insert(&link, &d);
+    TEST_ASSERT(link.queue == &b && b.next == &c && c.next == &d && d.next == &a && a.next == NULL,
+                "sorted by tag, first come first among equals");
+    queue_remove(&link, &c);
+    TEST_ASSERT(link.queue == &b && b.next == &d, "removed from the middle");
+    queue_remove(&link, &b);
+    TEST_ASSERT(link.queue == &d, "head removed");
+    queue_remove(&link, &c);
+    TEST_ASSERT(link.queue == &d && d.next == &a, "removing a stranger changes nothing");
+    return 1;
+}
+
+static int test_unlimited_grants_everything(void) {
+    reset_limits();
+    TEST_ASSERT_EQ(bandwidth_acquire(0, BANDWIDTH_UPLOAD, 64 * 1024 * KIB, NULL), 64 * 1024 * KIB, "whole request");
+    TEST_ASSERT_EQ(bandwidth_acquire(1, BANDWIDTH_DOWNLOAD, 1, NULL), 1, "unknown project");
+    TEST_ASSERT_EQ(bandwidth_acquire(0, BANDWIDTH_UPLOAD, 0, NULL), 0, "nothing asked, nothing granted");
+    return 1;
+}
+
+static int test_global_rate_holds(void) {
+    reset_limits();
+    bandwidth_set_global(256 * KIB, 0);
+    TEST_ASSERT_EQ(bandwidth_acquire(0, BANDWIDTH_UPLOAD, 1024 * KIB, NULL), 16 * KIB, "grant capped at a slice");
+    TEST_ASSERT_EQ(bandwidth_acquire(0, BANDWIDTH_DOWNLOAD, 1024 * KIB, NULL), 1024 * KIB, "other direction is free");
+
+    /* The rest of the burst, then half a second of traffic */
+    size_t moved = 16 * KIB;
+    uint64_t start = uv_hrtime();
+    while (moved < 64 * KIB + 128 * KIB) {
+        moved += bandwidth_acquire(0, BANDWIDTH_UPLOAD, 1024 * KIB, NULL);
+    }
+    double elapsed = seconds_since(start);
+    TEST_ASSERT(elapsed > 0.4 && elapsed < 0.8, "256 KiB/s holds past the burst");
+    reset_limits();
+    return 1;
+}
+
+static int test_project_limit(void) {
+    reset_limits();
+    TEST_ASSERT_EQ(bandwidth_configure(1, 128 * KIB, 0, 1), 0, "configure");
+    TEST_ASSERT_EQ(bandwidth_acquire(1, BANDWIDTH_UPLOAD, 1024 * KIB, NULL), 8 * KIB, "project slice");
+    TEST_ASSERT_EQ(bandwidth_acquire(2, BANDWIDTH_UPLOAD, 1024 * KIB, NULL), 1024 * KIB, "other projects are free");
+
+    size_t moved = 8 * KIB;
+    uint64_t start = uv_hrtime();
+    while (moved < 32 * KIB + 64 * KIB) {
+        moved += bandwidth_acquire(1, BANDWIDTH_UPLOAD, 1024 * KIB, NULL);
+    }
+    double elapsed = seconds_since(start);
+    TEST_ASSERT(elapsed > 0.4 && elapsed < 0.8, "128 KiB/s holds past the burst");
+
+    bandwidth_remove(1);
+    TEST_ASSERT_EQ(bandwidth_acquire(1, BANDWIDTH_UPLOAD, 1024 * KIB, NULL), 1024 * KIB, "removed project is free");
+    return 1;
+}
+
+static int test_refund_returns_tokens(void) {
+    reset_limits();
+    bandwidth_set_global(64 * KIB, 0);
+    /* Drain the burst */
+    for (size_t moved = 0; moved < 16 * KIB;) {
+        moved += bandwidth_acquire(0, BANDWIDTH_UPLOAD, 4 * KIB, NULL);
+    }
+    bandwidth_refund(0, BANDWIDTH_UPLOAD, 4 * KIB);
+    uint64_t start = uv_hrtime();
+    TEST_ASSERT_EQ(bandwidth_acquire(0, BANDWIDTH_UPLOAD, 4 * KIB, NULL), 4 * KIB, "refunded slice");
+    TEST_ASSERT(seconds_since(start) < 0.02, "granted from the refund without waiting");
+    reset_limits();
+    return 1;
+}
+
+static void cancel_later(void* arg) {
+    uv_sleep(60);
+    __atomic_store_n(&((CancelToken*)arg)->cancelled, true, __ATOMIC_RELEASE);
+}
+
+static int test_cancel_stops_the_wait(void) {
+    reset_limits();
+    /* One byte a second: after the first slice every grant waits */
+    bandwidth_set_global(1, 0);
+    TEST_ASSERT_EQ(bandwidth_acquire(0, BANDWIDTH_UPLOAD, 1024 * KIB, NULL), BANDWIDTH_MIN_SLICE, "first slice");
+
+    CancelToken token = { false };
+    uv_thread_t thread;
+    TEST_ASSERT_EQ(uv_thread_create(&thread, cancel_later, &token), 0, "start canceller");
+    uint64_t start = uv_hrtime();
+    size_t granted = bandwidth_acquire(0, BANDWIDTH_UPLOAD, 1024 * KIB, &token);
+    double elapsed = seconds_since(start);
+    uv_thread_join(&thread);
+    TEST_ASSERT_EQ(granted, 0, "a cancelled wait grants nothing");
+    TEST_ASSERT(elapsed < 0.06 + 2 * (double)BANDWIDTH_POLL_NS / 1e9, "cancellation seen within a poll");
+    TEST_ASSERT(links[BANDWIDTH_UPLOAD].queue == NULL, "the waiter left the queue");
+    reset_limits();
+    return 1;
+}
+
+typedef struct {
+    size_t project_handle;
+    uint64_t deadline;
+    size_t moved;
+} Sender;
+
+static void send_until(void* arg) {
+    Sender* sender = (Sender*)arg;
+    while (uv_hrtime() < sender->deadline) {
+        size_t granted = bandwidth_acquire(sender->project_handle, BANDWIDTH_DOWNLOAD, 1024 * KIB, NULL);
+        /* A grant that lands after the deadline belongs to the next second */
+        if (uv_hrtime() < sender->deadline) {
+            sender->moved += granted;
+        }
+    }
+}
+
+static int test_weights_share_the_link(void) {
+    reset_limits();
+    bandwidth_set_global(0, 512 * KIB);
+    bandwidth_configure(1, 0, 0, 1);
+    bandwidth_configure(2, 0, 0, 3);
+    /* Spend the burst first so whoever starts first gets no head start */
+    for (size_t moved = 0; moved < 128 * KIB;) {
+        moved += bandwidth_acquire(0, BANDWIDTH_DOWNLOAD, 1024 * KIB, NULL);
+    }
+
+    /* Two senders per project: the share follows weight, not transfer count */
+    uint64_t deadline = uv_hrtime() + 1000 * MS;
+    Sender senders[4] = { { 1, deadline, 0 }, { 1, deadline, 0 }, { 2, deadline, 0 }, { 2, deadline, 0 } };
+    uv_thread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQ(uv_thread_create(&threads[i], send_until, &senders[i]), 0, "start sender");
+    }
+    for (int i = 0; i < 4; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    double light = (double)(senders[0].moved + senders[1].moved);
+    double heavy = (double)(senders[2].moved + senders[3].moved);
+    double total = light + heavy;
+    printf("  (weight 1: %.0f KiB, weight 3: %.0f KiB)\n", light / KIB, heavy / KIB);
+    TEST_ASSERT(heavy > 2.0 * light && heavy < 4.5 * light, "weight 3 gets about three times weight 1");
+    TEST_ASSERT(total > 384 * KIB && total < (512 + 2 * 32) * KIB, "together they fill the link and no more");
+    reset_limits();
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Bandwidth Tests");
+
+    RUN_TEST(test_bucket_slice_and_capacity);
+    RUN_TEST(test_bucket_refill_and_give);
+    RUN_TEST(test_bucket_waits);
+    RUN_TEST(test_fair_queue_order);
+    RUN_TEST(test_unlimited_grants_everything);
+    RUN_TEST(test_global_rate_holds);
+    RUN_TEST(test_project_limit);
+    RUN_TEST(test_refund_returns_tokens);
+    RUN_TEST(test_cancel_stops_the_wait);
+    RUN_TEST(test_weights_share_the_link);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
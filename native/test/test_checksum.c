@@ -0,0 +1,173 @@
+/**
+ * @file native/test/test_checksum.c
+ * @brief Unit tests for checksum.c: known vectors, incremental updates,
+ *        and agreement between the hardware and portable paths
+ */
+
+#include "test_runtime.h"
+#include "../src/common/checksum.c"
+
+static const char* digest_of(ChecksumType type, const void* data, size_t length, char* hex) {
+    ChecksumState state;
+    checksum_init(&state, type);
+    checksum_update(&state, data, length);
+    checksum_hex(&state, hex, CHECKSUM_HEX_MAX);
+    return hex;
+}
+
+/** Deterministic bytes that are not a repeating pattern */
+static void fill_pattern(uint8_t* data, size_t length) {
+    uint32_t x = 2463534242u;
+    for (size_t i = 0; i < length; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        data[i] = (uint8_t)x;
+    }
+}
+
+static int test_crc32c_vectors(void) {
+    char hex[CHECKSUM_HEX_MAX];
+    TEST_ASSERT_STR_EQ(digest_of(CHECKSUM_CRC32C, "", 0, hex), "00000000", "CRC32C of nothing");
+    TEST_ASSERT_STR_EQ(digest_of(CHECKSUM_CRC32C, "123456789", 9, hex), "e3069283", "CRC32C check value");
+
+    /* RFC 3720 B.4: 32 bytes of zeros, 32 bytes of ones */
+    uint8_t block[32];
+    memset(block, 0, sizeof(block));
+    TEST_ASSERT_STR_EQ(digest_of(CHECKSUM_CRC32C, block, sizeof(block), hex), "8a9136aa", "CRC32C of zeros");
+    memset(block, 0xFF, sizeof(block));
+    TEST_ASSERT_STR_EQ(digest_of(CHECKSUM_CRC32C, block, sizeof(block), hex), "62a8ab43", "CRC32C of ones");
+    return 1;
+}
+
+static int test_sha256_vectors(void) {
+    char hex[CHECKSUM_HEX_MAX];
+    TEST_ASSERT_STR_EQ(digest_of(CHECKSUM_SHA256, "", 0, hex),
+                       "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", "SHA-256 of nothing");
+    TEST_ASSERT_STR_EQ(digest_of(CHECKSUM_SHA256, "abc", 3, hex),
+                       "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", "SHA-256 of abc");
+
+    /* 56 bytes: the padding spills into a second block */
+    const char* two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    TEST_ASSERT_STR_EQ(digest_of(CHECKSUM_SHA256, two_blocks, strlen(two_blocks), hex),
+                       "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", "SHA-256 of 448 bits");
+
+    static uint8_t million[1000000];
+    memset(million, 'a', sizeof(million));
+    TEST_ASSERT_STR_EQ(digest_of(CHECKSUM_SHA256, million, sizeof(million), hex),
+                       "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", "SHA-256 of a million a");
+    return 1;
+}
+
+static int test_incremental_matches_one_shot(void) {
+    static uint8_t data[10007];
+    fill_pattern(data, sizeof(data));
+    const ChecksumType types[] = { CHECKSUM_CRC32C, CHECKSUM_SHA256 };
+    /* Split points around the 64-byte block and 8-byte word boundaries */
+    const size_t steps[] = { 1, 7, 63, 64, 65, 1000 };
+
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        char expected[CHECKSUM_HEX_MAX];
+        digest_of(types[t], data, sizeof(data), expected);
+        for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+            ChecksumState state;
+            checksum_init(&state, types[t]);
+            for (size_t at = 0; at < sizeof(data); at += steps[s]) {
+                size_t take = sizeof(data) - at < steps[s] ? sizeof(data) - at : steps[s];
+                checksum_update(&state, data + at, take);
+            }
+            char hex[CHECKSUM_HEX_MAX];
+            checksum_hex(&state, hex, sizeof(hex));
+            TEST_ASSERT_STR_EQ(hex, expected, "incremental digest differs from one-shot");
+        }
+    }
+    return 1;
+}
+
+static int test_hex_leaves_state_usable(void) {
+    ChecksumState state;
+    checksum_init(&state, CHECKSUM_SHA256);
+    checksum_update(&state, "ab", 2);
+    char hex[CHECKSUM_HEX_MAX];
+    checksum_hex(&state, hex, sizeof(hex));
+    checksum_update(&state, "c", 1);
+    checksum_hex(&state, hex, sizeof(hex));
+    TEST_ASSERT_STR_EQ(hex, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+                       "hashing continues after a digest");
+    TEST_ASSERT_EQ(checksum_hex(&state, hex, CHECKSUM_HEX_MAX - 1), 0, "short output buffer is refused");
+    return 1;
+}
+
+static int test_hardware_matches_portable(void) {
+    static uint8_t data[65536 + 13];
+    fill_pattern(data, sizeof(data));
+    /* Unaligned starts and lengths exercise the byte-wise tails */
+    const size_t offsets[] = { 0, 1, 3, 7 };
+    const size_t lengths[] = { 0, 1, 8, 63, 64, 65, 4096, 65536 };
+
+#ifdef CHECKSUM_X86
+    probe_cpu();
+    int has_sse42 = cpu_has_sse42;
+    int has_sha = cpu_has_sha;
+    printf("  (sse4.2: %s, sha-ni: %s)\n", has_sse42 ? "yes" : "no", has_sha ? "yes" : "no");
+#endif
+    for (size_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            const uint8_t* p = data + offsets[o];
+            size_t n = lengths[l];
+            TEST_ASSERT(crc32c_update(0xFFFFFFFFu, p, n) == crc32c_sw(0xFFFFFFFFu, p, n),
+                        "CRC32C differs between the selected and portable paths");
+
+            uint32_t selected[8], portable[8];
+            memcpy(selected, (uint32_t[8]){ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 }, sizeof(selected));
+            memcpy(portable, selected, sizeof(portable));
+            sha256_compress(selected, p, n / 64);
+            sha256_compress_sw(portable, p, n / 64);
+            TEST_ASSERT(memcmp(selected, portable, sizeof(selected)) == 0,
+                        "SHA-256 differs between the selected and portable paths");
+        }
+    }
+
+#ifdef CHECKSUM_X86
+    /* With the CPU features masked, the public API takes the portable path */
+    char hw_crc[CHECKSUM_HEX_MAX], hw_sha[CHECKSUM_HEX_MAX], sw_crc[CHECKSUM_HEX_MAX], sw_sha[CHECKSUM_HEX_MAX];
+    digest_of(CHECKSUM_CRC32C, data, sizeof(data), hw_crc);
+    digest_of(CHECKSUM_SHA256, data, sizeof(data), hw_sha);
+    cpu_has_sse42 = 0;
+    cpu_has_sha = 0;
+    digest_of(CHECKSUM_CRC32C, data, sizeof(data), sw_crc);
+    digest_of(CHECKSUM_SHA256, data, sizeof(data), sw_sha);
+    cpu_has_sse42 = has_sse42;
+    cpu_has_sha = has_sha;
+    TEST_ASSERT_STR_EQ(sw_crc, hw_crc, "CRC32C digest depends on the CPU path");
+    TEST_ASSERT_STR_EQ(sw_sha, hw_sha, "SHA-256 digest depends on the CPU path");
+#endif
+    return 1;
+}
+
+static int test_names(void) {
+    TEST_ASSERT_EQ(checksum_type_from_name("crc32c"), CHECKSUM_CRC32C, "crc32c parses");
+    TEST_ASSERT_EQ(checksum_type_from_name("sha256"), CHECKSUM_SHA256, "sha256 parses");
+    TEST_ASSERT_EQ(checksum_type_from_name("md5"), CHECKSUM_NONE, "unknown name is NONE");
+    TEST_ASSERT_EQ(checksum_type_from_name(NULL), CHECKSUM_NONE, "NULL is NONE");
+    TEST_ASSERT_EQ(checksum_hex_length(CHECKSUM_CRC32C), 8, "CRC32C hex length");
+    TEST_ASSERT_EQ(checksum_hex_length(CHECKSUM_SHA256), 64, "SHA-256 hex length");
+    TEST_ASSERT_STR_EQ(checksum_type_name(CHECKSUM_SHA256), "sha256", "canonical name");
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Checksum Tests");
+
+    RUN_TEST(test_crc32c_vectors);
+    RUN_TEST(test_sha256_vectors);
+    RUN_TEST(test_incremental_matches_one_shot);
+    RUN_TEST(test_hex_leaves_state_usable);
+    RUN_TEST(test_hardware_matches_portable);
+    RUN_TEST(test_names);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
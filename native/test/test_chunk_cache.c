@@ -0,0 +1,299 @@
+/**
+ * @file native/test/test_chunk_cache.c
+ * @brief Unit tests for chunk_cache.c: chunks written and read back, the
+ *        on-disk header and flags, rejection of corrupt or short files,
+ *        file modes, and eviction against the byte cap
+ *
+ * Builds with file_helpers.c as a second translation unit; both files
+ * have a static path_join.
+ */
+
+#include "test_runtime.h"
+#include "../src/common/chunk_cache.c"
+
+#include <stdio.h>
+
+static char base[] = "/tmp/chunk_cache_test.XXXXXX";
+static char directory[sizeof(base) + 16];
+
+static ChunkCacheStats stats_now(void) {
+    ChunkCacheStats stats;
+    memset(&stats, 0, sizeof(stats));
+    chunk_cache_stats(&stats, NULL);
+    return stats;
+}
+
+/** Path chunk_cache_open uses for this version of bucket/key */
+static void cache_path(const char* key, int64_t created, uint64_t content_length, size_t chunk_size, char* out,
+                       size_t out_length) {
+    snprintf(out, out_length, "%s/%016llx-%llx-%llx-%zx" CHUNK_CACHE_SUFFIX, directory,
+             (unsigned long long)hash_id("bucket", key), (unsigned long long)created,
+             (unsigned long long)content_length, chunk_size);
+}
+
+static void fill(uint8_t* data, size_t length, uint8_t seed) {
+    for (size_t i = 0; i < length; i++) {
+        data[i] = (uint8_t)(i * 13 + seed);
+    }
+}
+
+/** Disk usage of all files in the cache directory, and how many there are */
+static uint64_t directory_usage(int* files) {
+    uv_fs_t req;
+    int count = uv_fs_scandir(NULL, &req, directory, 0, NULL);
+    uint64_t total = 0;
+    *files = 0;
+    uv_dirent_t entry;
+    while (count >= 0 && uv_fs_scandir_next(&req, &entry) != UV_EOF) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", directory, entry.name);
+        struct stat st;
+        if (stat(path, &st) == 0) {
+            uv_stat_t uv_st;
+            uv_st.st_blocks = (uint64_t)st.st_blocks;
+            uv_st.st_size = (uint64_t)st.st_size;
+            total += file_usage(&uv_st);
+            (*files)++;
+        }
+    }
+    uv_fs_req_cleanup(&req);
+    return total;
+}
+
+static void clear_directory(void) {
+    uv_fs_t req;
+    int count = uv_fs_scandir(NULL, &req, directory, 0, NULL);
+    uv_dirent_t entry;
+    while (count >= 0 && uv_fs_scandir_next(&req, &entry) != UV_EOF) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", directory, entry.name);
+        unlink(path);
+    }
+    uv_fs_req_cleanup(&req);
+}
+
+static int test_chunks_round_trip(void) {
+    TEST_ASSERT_EQ(chunk_cache_enable(directory, 1 << 20, 1000), 0, "enable creates the directory");
+    TEST_ASSERT_EQ(chunk_cache_chunk_size(), 1000, "chunk size kept");
+
+    ChunkCacheFile* file = chunk_cache_open("bucket", "key", 7, 3500, 1000);
+    TEST_ASSERT_NOT_NULL(file, "open creates the file");
+    TEST_ASSERT_NULL(chunk_cache_get(file, 0), "nothing stored yet");
+
+    uint8_t full[1000];
+    uint8_t tail[500];
+    fill(full, sizeof(full), 1);
+    fill(tail, sizeof(tail), 2);
+    chunk_cache_put(file, 1, full, sizeof(full));
+    chunk_cache_put(file, 3, tail, sizeof(tail));
+    chunk_cache_put(file, 4, full, sizeof(full));
+
+    const uint8_t* got = chunk_cache_get(file, 1);
+    TEST_ASSERT(got != NULL && memcmp(got, full, sizeof(full)) == 0, "full chunk read back");
+    got = chunk_cache_get(file, 3);
+    TEST_ASSERT(got != NULL && memcmp(got, tail, sizeof(tail)) == 0, "short last chunk read back");
+    TEST_ASSERT_NULL(chunk_cache_get(file, 0), "unwritten chunk still missing");
+    TEST_ASSERT_NULL(chunk_cache_get(file, 4), "past the last chunk");
+
+    ChunkCacheStats stats = stats_now();
+    TEST_ASSERT_EQ(stats.chunks_stored, 2, "chunks past the end are not stored");
+    TEST_ASSERT_EQ(stats.write_errors, 0, "no write errors");
+    chunk_cache_close(file);
+
+    /* A later open of the same version sees the chunks; another version starts empty */
+    file = chunk_cache_open("bucket", "key", 7, 3500, 1000);
+    got = chunk_cache_get(file, 1);
+    TEST_ASSERT(got != NULL && memcmp(got, full, sizeof(full)) == 0, "chunks persist across opens");
+    chunk_cache_close(file);
+    file = chunk_cache_open("bucket", "key", 8, 3500, 1000);
+    TEST_ASSERT(file != NULL && chunk_cache_get(file, 1) == NULL, "a new version has its own file");
+    chunk_cache_close(file);
+    file = chunk_cache_open("bucket", "other", 7, 3500, 1000);
+    TEST_ASSERT(file != NULL && chunk_cache_get(file, 1) == NULL, "another key has its own file");
+    chunk_cache_close(file);
+
+    TEST_ASSERT_NULL(chunk_cache_open("bucket", "key", 7, 0, 1000), "empty objects are not cached");
+    return 1;
+}
+
+static int test_header_and_flags_on_disk(void) {
+    char path[512];
+    cache_path("key", 7, 3500, 1000, path, sizeof(path));
+    int fd = open(path, O_RDONLY);
+    TEST_ASSERT(fd >= 0, "file named by hash, version, size and chunk size");
+
+    ChunkCacheHeader header;
+    TEST_ASSERT(pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header), "header read");
+    TEST_ASSERT(memcmp(header.magic, "UPLKCHK1", 8) == 0, "magic");
+    TEST_ASSERT_EQ(header.version, 1, "version");
+    TEST_ASSERT_EQ(header.id_length, 10, "bucket '\\0' key");
+    TEST_ASSERT(header.chunk_size == 1000 && header.content_length == 3500 && header.created == 7, "version fields");
+    TEST_ASSERT_EQ(header.chunk_count, 4, "chunks rounded up");
+    TEST_ASSERT(header.flags_offset == sizeof(header) + 10, "flags follow the id");
+    TEST_ASSERT(header.data_offset == CHUNK_CACHE_PAGE, "data starts on the next page");
+
+    char id[10];
+    TEST_ASSERT(pread(fd, id, sizeof(id), sizeof(header)) == (ssize_t)sizeof(id), "id read");
+    TEST_ASSERT(memcmp(id, "bucket\0key", 10) == 0, "id bytes");
+
+    uint8_t flags[4];
+    TEST_ASSERT(pread(fd, flags, sizeof(flags), (off_t)header.flags_offset) == 4, "flags read");
+    TEST_ASSERT(flags[0] == 0 && flags[1] == 1 && flags[2] == 0 && flags[3] == 1, "one flag byte per stored chunk");
+
+    uint8_t chunk[1000];
+    uint8_t want[1000];
+    fill(want, sizeof(want), 1);
+    TEST_ASSERT(pread(fd, chunk, sizeof(chunk), (off_t)(header.data_offset + 1000)) == 1000, "chunk read");
+    TEST_ASSERT(memcmp(chunk, want, sizeof(want)) == 0, "chunk at data_offset + index * chunk_size");
+
+    struct stat st;
+    TEST_ASSERT(fstat(fd, &st) == 0 && (uint64_t)st.st_size == header.data_offset + 3500, "sized to the object");
+    TEST_ASSERT_EQ(st.st_mode & 0777, 0600, "file readable by this user only");
+    close(fd);
+
+    TEST_ASSERT(stat(directory, &st) == 0 && (st.st_mode & 0777) == 0700, "directory private to this user");
+
+    int files = 0;
+    directory_usage(&files);
+    TEST_ASSERT_EQ(files, 3, "temporary files removed after linking");
+    return 1;
+}
+
+/** Store chunk 0 of @p key, close, and return the file's path */
+static int store_one(const char* key, char* path, size_t path_length) {
+    uint8_t data[1000];
+    fill(data, sizeof(data), 3);
+    ChunkCacheFile* file = chunk_cache_open("bucket", key, 1, 2000, 1000);
+    TEST_ASSERT_NOT_NULL(file, "open");
+    chunk_cache_put(file, 0, data, sizeof(data));
+    chunk_cache_close(file);
+    cache_path(key, 1, 2000, 1000, path, path_length);
+    return 1;
+}
+
+static int test_corrupt_and_short_files_are_rejected(void) {
+    char path[512];
+    int fd;
+
+    TEST_ASSERT(store_one("magic", path, sizeof(path)), "stored");
+    fd = open(path, O_WRONLY);
+    TEST_ASSERT(pwrite(fd, "X", 1, 0) == 1, "corrupt magic");
+    close(fd);
+    TEST_ASSERT_NULL(chunk_cache_open("bucket", "magic", 1, 2000, 1000), "bad magic rejected");
+
+    TEST_ASSERT(store_one("version", path, sizeof(path)), "stored");
+    uint32_t version = 2;
+    fd = open(path, O_WRONLY);
+    TEST_ASSERT(pwrite(fd, &version, sizeof(version), offsetof(ChunkCacheHeader, version)) == 4, "bump version");
+    close(fd);
+    TEST_ASSERT_NULL(chunk_cache_open("bucket", "version", 1, 2000, 1000), "other format version rejected");
+
+    TEST_ASSERT(store_one("short", path, sizeof(path)), "stored");
+    TEST_ASSERT(truncate(path, CHUNK_CACHE_PAGE + 1999) == 0, "cut one byte");
+    TEST_ASSERT_NULL(chunk_cache_open("bucket", "short", 1, 2000, 1000), "short file rejected");
+
+    TEST_ASSERT(store_one("id", path, sizeof(path)), "stored");
+    fd = open(path, O_WRONLY);
+    TEST_ASSERT(pwrite(fd, "B", 1, sizeof(ChunkCacheHeader)) == 1, "collide on the hash");
+    close(fd);
+    TEST_ASSERT_NULL(chunk_cache_open("bucket", "id", 1, 2000, 1000), "another object's file rejected");
+
+    /* A flag byte that is not exactly 1 (a torn write) is a missing chunk */
+    TEST_ASSERT(store_one("flag", path, sizeof(path)), "stored");
+    fd = open(path, O_WRONLY);
+    TEST_ASSERT(pwrite(fd, "\x02", 1, (off_t)(sizeof(ChunkCacheHeader) + 11)) == 1, "garble the flag");
+    close(fd);
+    ChunkCacheFile* file = chunk_cache_open("bucket", "flag", 1, 2000, 1000);
+    TEST_ASSERT(file != NULL && chunk_cache_get(file, 0) == NULL, "garbled flag reads as missing");
+    chunk_cache_close(file);
+
+    TEST_ASSERT(store_one("intact", path, sizeof(path)), "stored");
+    file = chunk_cache_open("bucket", "intact", 1, 2000, 1000);
+    TEST_ASSERT(file != NULL && chunk_cache_get(file, 0) != NULL, "untouched file still served");
+    chunk_cache_close(file);
+    return 1;
+}
+
+static int test_eviction_keeps_the_byte_cap(void) {
+    enum { CHUNK = 64 * 1024, OBJECTS = 10 };
+    clear_directory();
+    uint64_t per_file = CHUNK_CACHE_PAGE + CHUNK;
+    uint64_t max_bytes = 4 * per_file + per_file / 2;
+    TEST_ASSERT_EQ(chunk_cache_enable(directory, max_bytes, CHUNK), 0, "enable");
+
+    static uint8_t data[CHUNK];
+    fill(data, sizeof(data), 4);
+    for (int i = 0; i < OBJECTS; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "object-%d", i);
+        ChunkCacheFile* file = chunk_cache_open("bucket", key, 1, CHUNK, CHUNK);
+        TEST_ASSERT_NOT_NULL(file, "open");
+        chunk_cache_put(file, 0, data, sizeof(data));
+        chunk_cache_close(file);
+        uv_sleep(5);    /* Distinct modification times */
+    }
+
+    ChunkCacheStats stats = stats_now();
+    TEST_ASSERT(stats.evictions > 0, "writes past the cap evict");
+    int files = 0;
+    uint64_t usage = directory_usage(&files);
+    TEST_ASSERT(files < OBJECTS, "old files removed");
+    TEST_ASSERT(usage <= max_bytes + per_file, "within one unscanned file of the cap");
+
+    ChunkCacheFile* newest = chunk_cache_open("bucket", "object-9", 1, CHUNK, CHUNK);
+    TEST_ASSERT(newest != NULL && chunk_cache_get(newest, 0) != NULL, "the newest object survives");
+    chunk_cache_close(newest);
+    uv_sleep(5);
+    ChunkCacheFile* oldest = chunk_cache_open("bucket", "object-0", 1, CHUNK, CHUNK);
+    TEST_ASSERT(oldest != NULL && chunk_cache_get(oldest, 0) == NULL, "the oldest object went first");
+    chunk_cache_close(oldest);
+
+    /* Enabling with a smaller cap scans and evicts least recently used first */
+    uint64_t smaller = 2 * per_file;
+    TEST_ASSERT_EQ(chunk_cache_enable(directory, smaller, CHUNK), 0, "re-enable");
+    usage = directory_usage(&files);
+    stats = stats_now();
+    TEST_ASSERT(usage <= CHUNK_CACHE_EVICT_TARGET(smaller), "evicted down to the target");
+    TEST_ASSERT(stats.bytes == usage, "stats report the scanned usage");
+    TEST_ASSERT(stats.evictions > 0 && stats.max_bytes == smaller, "evictions at enable counted");
+    newest = chunk_cache_open("bucket", "object-9", 1, CHUNK, CHUNK);
+    TEST_ASSERT(newest != NULL && chunk_cache_get(newest, 0) != NULL, "the file opened last survives");
+    chunk_cache_close(newest);
+    ChunkCacheFile* older = chunk_cache_open("bucket", "object-8", 1, CHUNK, CHUNK);
+    TEST_ASSERT(older != NULL && chunk_cache_get(older, 0) == NULL, "files not opened since went first");
+    chunk_cache_close(older);
+    return 1;
+}
+
+static int test_disabled_cache_opens_nothing(void) {
+    chunk_cache_disable();
+    ChunkCacheStats stats;
+    TEST_ASSERT_EQ(chunk_cache_stats(&stats, NULL), -1, "no stats while disabled");
+    TEST_ASSERT_EQ(chunk_cache_chunk_size(), 0, "no chunk size while disabled");
+    TEST_ASSERT_NULL(chunk_cache_open("bucket", "key", 7, 3500, 1000), "no files while disabled");
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Chunk Cache Tests");
+
+    if (mkdtemp(base) == NULL) {
+        fprintf(stderr, "mkdtemp failed\n");
+        return 1;
+    }
+    snprintf(directory, sizeof(directory), "%s/cache", base);
+
+    RUN_TEST(test_chunks_round_trip);
+    RUN_TEST(test_header_and_flags_on_disk);
+    RUN_TEST(test_corrupt_and_short_files_are_rejected);
+    RUN_TEST(test_eviction_keeps_the_byte_cap);
+    RUN_TEST(test_disabled_cache_opens_nothing);
+
+    clear_directory();
+    rmdir(directory);
+    rmdir(base);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
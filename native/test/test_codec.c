@@ -0,0 +1,257 @@
+/**
+ * @file native/test/test_codec.c
+ * @brief Unit tests for codec.c: LZ4 round trips, the frame and index
+ *        layout uploads write, and rejection of corrupt frames
+ */
+
+#include "test_framework.h"
+#include "../src/common/codec.c"
+
+#define TEST_CHUNK_SIZE CODEC_DEFAULT_CHUNK_SIZE
+
+/** Deterministic bytes that do not compress */
+static void fill_random(uint8_t* data, size_t length, uint32_t seed) {
+    uint32_t x = seed;
+    for (size_t i = 0; i < length; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        data[i] = (uint8_t)x;
+    }
+}
+
+/** Text-like bytes that compress well */
+static void fill_text(uint8_t* data, size_t length) {
+    static const char* words[] = { "storj ", "uplink ", "segment ", "piece ", "node ", "bucket " };
+    size_t at = 0;
+    for (unsigned i = 0; at < length; i = i * 7 + 3) {
+        const char* word = words[i % 6];
+        size_t n = strlen(word);
+        if (n > length - at) n = length - at;
+        memcpy(data + at, word, n);
+        at += n;
+    }
+}
+
+static int round_trips(const uint8_t* src, size_t length, size_t* compressed_length) {
+    size_t capacity = length + length / 255 + 16;
+    uint8_t* packed = (uint8_t*)malloc(capacity);
+    uint8_t* unpacked = (uint8_t*)malloc(length + 1);
+    size_t packed_length = codec_compress(CODEC_LZ4, src, length, packed, capacity);
+    int ok = packed_length > 0 && codec_decompress(CODEC_LZ4, packed, packed_length, unpacked, length) == 0 &&
+             memcmp(unpacked, src, length) == 0;
+    if (compressed_length != NULL) *compressed_length = packed_length;
+    free(packed);
+    free(unpacked);
+    return ok;
+}
+
+/* ========== frames, as upload_codec_write_frame lays them out ========== */
+
+typedef struct {
+    uint8_t* stored;
+    size_t stored_size;
+    uint32_t index[16];
+    size_t frames;
+} TestObject;
+
+static void object_write(TestObject* object, const uint8_t* raw, size_t raw_size) {
+    object->stored = (uint8_t*)malloc(raw_size + 16 * CODEC_FRAME_HEADER_SIZE);
+    object->stored_size = 0;
+    object->frames = 0;
+    for (size_t at = 0; at < raw_size; at += TEST_CHUNK_SIZE) {
+        size_t length = raw_size - at < TEST_CHUNK_SIZE ? raw_size - at : TEST_CHUNK_SIZE;
+        uint8_t* frame = object->stored + object->stored_size;
+        uint8_t* payload = frame + CODEC_FRAME_HEADER_SIZE;
+        size_t payload_length = codec_compress(CODEC_LZ4, raw + at, length, payload, length - 1);
+        if (payload_length == 0) {
+            memcpy(payload, raw + at, length);
+            payload_length = length;
+            codec_put_u32(frame, CODEC_FRAME_STORED | (uint32_t)length);
+        } else {
+            codec_put_u32(frame, (uint32_t)payload_length);
+        }
+        object->index[object->frames++] = (uint32_t)(CODEC_FRAME_HEADER_SIZE + payload_length);
+        object->stored_size += CODEC_FRAME_HEADER_SIZE + payload_length;
+    }
+}
+
+/** Seek to chunk @p k through the index and decode it, as ranged reads do */
+static int object_read_chunk(const TestObject* object, size_t k, size_t raw_size, uint8_t* out, size_t* out_length) {
+    size_t offset = 0;
+    for (size_t i = 0; i < k; i++) offset += object->index[i];
+    uint32_t header = codec_get_u32(object->stored + offset);
+    size_t payload_length = header & ~CODEC_FRAME_STORED;
+    const uint8_t* payload = object->stored + offset + CODEC_FRAME_HEADER_SIZE;
+    size_t raw_length = raw_size - k * TEST_CHUNK_SIZE < TEST_CHUNK_SIZE ? raw_size - k * TEST_CHUNK_SIZE : TEST_CHUNK_SIZE;
+    *out_length = raw_length;
+    if (CODEC_FRAME_HEADER_SIZE + payload_length != object->index[k]) {
+        return -1;
+    }
+    if (header & CODEC_FRAME_STORED) {
+        if (payload_length != raw_length) return -1;
+        memcpy(out, payload, raw_length);
+        return 0;
+    }
+    return codec_decompress(CODEC_LZ4, payload, payload_length, out, raw_length);
+}
+
+/* ========== tests ========== */
+
+static int test_round_trip_sizes(void) {
+    /* Around the minimum match, the 15-length nibble, and a full chunk */
+    const size_t sizes[] = { 1, 4, 5, 12, 13, 14, 15, 19, 64, 270, 1000, 65536 + 7, TEST_CHUNK_SIZE };
+    static uint8_t data[TEST_CHUNK_SIZE];
+    fill_text(data, sizeof(data));
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        TEST_ASSERT(round_trips(data, sizes[i], NULL), "text does not round trip");
+    }
+    fill_random(data, sizeof(data), 1);
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        TEST_ASSERT(round_trips(data, sizes[i], NULL), "random bytes do not round trip");
+    }
+    return 1;
+}
+
+static int test_compression_ratio(void) {
+    static uint8_t data[TEST_CHUNK_SIZE];
+    size_t packed;
+
+    fill_text(data, sizeof(data));
+    TEST_ASSERT(round_trips(data, sizeof(data), &packed), "text round trip");
+    TEST_ASSERT(packed < sizeof(data) / 2, "text compresses to under half");
+
+    /* Offset 1 matches copy overlapping bytes */
+    memset(data, 'z', sizeof(data));
+    TEST_ASSERT(round_trips(data, sizeof(data), &packed), "run round trip");
+    TEST_ASSERT(packed < sizeof(data) / 100, "a run compresses to almost nothing");
+    return 1;
+}
+
+static int test_incompressible_does_not_fit(void) {
+    static uint8_t data[TEST_CHUNK_SIZE];
+    static uint8_t packed[TEST_CHUNK_SIZE];
+    fill_random(data, sizeof(data), 7);
+    TEST_ASSERT_EQ(codec_compress(CODEC_LZ4, data, sizeof(data), packed, sizeof(data) - 1), 0,
+                   "random bytes are not squeezed under their own size");
+    TEST_ASSERT_EQ(codec_compress(CODEC_LZ4, data, 1, packed, 0), 0, "no room is refused");
+    TEST_ASSERT_EQ(codec_compress(CODEC_NONE, data, 64, packed, sizeof(packed)), 0, "NONE never compresses");
+    return 1;
+}
+
+static int test_frames_and_index(void) {
+    /* Text, random (stored), zeros, then a partial text tail */
+    size_t raw_size = 3 * TEST_CHUNK_SIZE + TEST_CHUNK_SIZE / 2 + 17;
+    uint8_t* raw = (uint8_t*)malloc(raw_size);
+    fill_text(raw, TEST_CHUNK_SIZE);
+    fill_random(raw + TEST_CHUNK_SIZE, TEST_CHUNK_SIZE, 3);
+    memset(raw + 2 * TEST_CHUNK_SIZE, 0, TEST_CHUNK_SIZE);
+    fill_text(raw + 3 * TEST_CHUNK_SIZE, raw_size - 3 * TEST_CHUNK_SIZE);
+
+    TestObject object;
+    object_write(&object, raw, raw_size);
+    TEST_ASSERT_EQ(object.frames, 4, "one frame per chunk");
+
+    size_t total = 0;
+    for (size_t k = 0; k < object.frames; k++) total += object.index[k];
+    TEST_ASSERT(total == object.stored_size, "index sizes add up to the stored size");
+    TEST_ASSERT(object.stored_size < raw_size, "the object got smaller");
+
+    size_t second = object.index[0];
+    TEST_ASSERT(codec_get_u32(object.stored + second) & CODEC_FRAME_STORED, "random chunk is stored");
+    TEST_ASSERT(!(codec_get_u32(object.stored) & CODEC_FRAME_STORED), "text chunk is compressed");
+    TEST_ASSERT_EQ(object.index[1], CODEC_FRAME_HEADER_SIZE + TEST_CHUNK_SIZE, "stored frame is header + chunk");
+
+    /* Random access, last chunk first */
+    static uint8_t chunk[TEST_CHUNK_SIZE];
+    for (size_t k = object.frames; k-- > 0;) {
+        size_t length;
+        TEST_ASSERT_EQ(object_read_chunk(&object, k, raw_size, chunk, &length), 0, "chunk decodes");
+        TEST_ASSERT(memcmp(chunk, raw + k * TEST_CHUNK_SIZE, length) == 0, "chunk matches the original");
+    }
+
+    free(object.stored);
+    free(raw);
+    return 1;
+}
+
+static int test_corrupt_frames_rejected(void) {
+    static uint8_t raw[4096];
+    static uint8_t packed[4096 + 64];
+    static uint8_t out[4096 + 16];
+    fill_text(raw, sizeof(raw));
+    size_t packed_length = codec_compress(CODEC_LZ4, raw, sizeof(raw), packed, sizeof(packed));
+    TEST_ASSERT(packed_length > 0, "setup compresses");
+
+    TEST_ASSERT_EQ(codec_decompress(CODEC_LZ4, packed, packed_length - 1, out, sizeof(raw)), -1, "truncated payload");
+    TEST_ASSERT_EQ(codec_decompress(CODEC_LZ4, packed, packed_length, out, sizeof(raw) - 1), -1, "raw size too small");
+    TEST_ASSERT_EQ(codec_decompress(CODEC_LZ4, packed, packed_length, out, sizeof(raw) + 1), -1, "raw size too large");
+    TEST_ASSERT_EQ(codec_decompress(CODEC_NONE, packed, packed_length, out, sizeof(raw)), -1, "unknown codec");
+
+    /* Hand-built sequences: one literal 'a', then a match of four */
+    const uint8_t good[] = { 0x10, 'a', 0x01, 0x00 };
+    TEST_ASSERT_EQ(codec_decompress(CODEC_LZ4, good, sizeof(good), out, 5), 0, "overlapping match decodes");
+    TEST_ASSERT(memcmp(out, "aaaaa", 5) == 0, "overlapping match repeats the byte");
+    const uint8_t zero_offset[] = { 0x10, 'a', 0x00, 0x00 };
+    TEST_ASSERT_EQ(codec_decompress(CODEC_LZ4, zero_offset, sizeof(zero_offset), out, 5), -1, "offset 0");
+    const uint8_t far_offset[] = { 0x10, 'a', 0x02, 0x00 };
+    TEST_ASSERT_EQ(codec_decompress(CODEC_LZ4, far_offset, sizeof(far_offset), out, 5), -1, "offset before the start");
+    const uint8_t short_offset[] = { 0x10, 'a', 0x01 };
+    TEST_ASSERT_EQ(codec_decompress(CODEC_LZ4, short_offset, sizeof(short_offset), out, 5), -1, "cut-off offset");
+    const uint8_t endless_length[] = { 0xF0, 0xFF, 0xFF };
+    TEST_ASSERT_EQ(codec_decompress(CODEC_LZ4, endless_length, sizeof(endless_length), out, 5), -1,
+                   "length runs past the end");
+    return 1;
+}
+
+static int test_damaged_frames_stay_in_bounds(void) {
+    static uint8_t raw[4096];
+    static uint8_t packed[4096 + 64];
+    static uint8_t damaged[sizeof(packed)];
+    static uint8_t out[4096 + 16];
+    fill_text(raw, sizeof(raw));
+    size_t packed_length = codec_compress(CODEC_LZ4, raw, sizeof(raw), packed, sizeof(packed));
+
+    /* Whatever the damage, decoding fails or succeeds without writing past the chunk */
+    uint32_t x = 99;
+    for (int round = 0; round < 2000; round++) {
+        memcpy(damaged, packed, packed_length);
+        for (int flips = 0; flips < 1 + round % 4; flips++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            damaged[x % packed_length] ^= (uint8_t)(1u << (x >> 29));
+        }
+        memset(out + sizeof(raw), 0xA5, 16);
+        int status = codec_decompress(CODEC_LZ4, damaged, packed_length, out, sizeof(raw));
+        TEST_ASSERT(status == 0 || status == -1, "decode status");
+        for (size_t i = sizeof(raw); i < sizeof(out); i++) {
+            TEST_ASSERT_EQ(out[i], 0xA5, "decode wrote past the chunk");
+        }
+    }
+    return 1;
+}
+
+static int test_names(void) {
+    TEST_ASSERT_EQ(codec_type_from_name("lz4"), CODEC_LZ4, "lz4 parses");
+    TEST_ASSERT_EQ(codec_type_from_name("zstd"), CODEC_NONE, "unknown name is NONE");
+    TEST_ASSERT_EQ(codec_type_from_name(NULL), CODEC_NONE, "NULL is NONE");
+    TEST_ASSERT_STR_EQ(codec_type_name(CODEC_LZ4), "lz4", "canonical name");
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Codec Tests");
+
+    RUN_TEST(test_round_trip_sizes);
+    RUN_TEST(test_compression_ratio);
+    RUN_TEST(test_incompressible_does_not_fit);
+    RUN_TEST(test_frames_and_index);
+    RUN_TEST(test_corrupt_frames_rejected);
+    RUN_TEST(test_damaged_frames_stay_in_bounds);
+    RUN_TEST(test_names);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
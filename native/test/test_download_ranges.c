@@ -0,0 +1,181 @@
+/**
+ * @file native/test/test_download_ranges.c
+ * @brief Unit tests for download_ranges.c: offsets from the end, clipping
+ *        at the object end, coalescing by gap, and range views
+ */
+
+#include "test_framework.h"
+#include "../src/download/download_ranges.c"
+
+#include <stdint.h>
+
+typedef struct {
+    DownloadSpan* spans;
+    uint32_t span_count;
+    uint64_t arena_length;
+} Plan;
+
+static bool plan(DownloadRange* ranges, uint32_t count, uint64_t gap, bool sized, uint64_t size, Plan* out) {
+    return download_ranges_plan(ranges, count, gap, sized, size, &out->spans, &out->span_count, &out->arena_length);
+}
+
+static int test_close_ranges_share_a_request(void) {
+    DownloadRange ranges[] = { { 0, 100, 0 }, { 150, 50, 0 }, { 251, 10, 0 } };
+    Plan p;
+    TEST_ASSERT(plan(ranges, 3, 50, false, 0, &p), "plan");
+    TEST_ASSERT_EQ(p.span_count, 2, "a gap of exactly coalesceGap merges, one byte more does not");
+    TEST_ASSERT(p.spans[0].offset == 0 && p.spans[0].length == 200, "first two merged with the gap");
+    TEST_ASSERT(p.spans[1].offset == 251 && p.spans[1].length == 10, "third on its own");
+    TEST_ASSERT(ranges[0].span == 0 && ranges[1].span == 0 && ranges[2].span == 1, "each range knows its span");
+    free(p.spans);
+
+    DownloadRange touching[] = { { 0, 10, 0 }, { 10, 10, 0 }, { 21, 10, 0 } };
+    TEST_ASSERT(plan(touching, 3, 0, false, 0, &p), "plan");
+    TEST_ASSERT_EQ(p.span_count, 2, "a zero gap still merges adjacent ranges");
+    TEST_ASSERT(p.spans[0].length == 20, "adjacent ranges joined");
+    free(p.spans);
+    return 1;
+}
+
+static int test_ranges_are_sorted_and_overlaps_kept(void) {
+    DownloadRange ranges[] = { { 5000, 100, 0 }, { 0, 1000, 0 }, { 100, 50, 0 }, { 900, 400, 0 } };
+    Plan p;
+    TEST_ASSERT(plan(ranges, 4, 0, false, 0, &p), "plan");
+    TEST_ASSERT_EQ(p.span_count, 2, "two requests");
+    TEST_ASSERT(p.spans[0].offset == 0 && p.spans[0].length == 1300, "overlaps extend, contained ranges do not shrink");
+    TEST_ASSERT(p.spans[1].offset == 5000 && p.spans[1].length == 100, "the far range is last");
+    TEST_ASSERT(ranges[0].span == 1 && ranges[1].span == 0 && ranges[2].span == 0 && ranges[3].span == 0,
+                "spans follow sorted order, ranges keep theirs");
+    TEST_ASSERT(p.spans[1].arena_offset == 1300 && p.arena_length == 1400, "spans back to back in the arena");
+    free(p.spans);
+    return 1;
+}
+
+static int test_offsets_from_the_end(void) {
+    DownloadRange ranges[] = { { -100, 100, 0 }, { -5000, 10, 0 }, { 0, 10, 0 } };
+    Plan p;
+    TEST_ASSERT(plan(ranges, 3, 0, true, 1000, &p), "plan");
+    TEST_ASSERT(ranges[0].offset == 900 && ranges[0].length == 100, "the last hundred bytes");
+    TEST_ASSERT(ranges[1].offset == 0 && ranges[1].length == 10, "past the start clamps to zero");
+    TEST_ASSERT_EQ(p.span_count, 2, "the clamped range merges with the one at zero");
+    TEST_ASSERT(ranges[1].span == ranges[2].span, "same request");
+    free(p.spans);
+    return 1;
+}
+
+static int test_ranges_are_clipped_at_the_end(void) {
+    DownloadRange ranges[] = { { 900, 500, 0 }, { 1000, 10, 0 }, { 4000, 10, 0 }, { 950, 0, 0 } };
+    Plan p;
+    TEST_ASSERT(plan(ranges, 4, 1 << 20, true, 1000, &p), "plan");
+    TEST_ASSERT(ranges[0].length == 100, "cut at the last byte");
+    TEST_ASSERT(ranges[1].length == 0 && ranges[2].length == 0, "ranges past the end are empty");
+    TEST_ASSERT(ranges[1].span == DOWNLOAD_RANGES_NO_SPAN && ranges[2].span == DOWNLOAD_RANGES_NO_SPAN &&
+                ranges[3].span == DOWNLOAD_RANGES_NO_SPAN, "empty ranges get no request");
+    TEST_ASSERT_EQ(p.span_count, 1, "and do not stretch one within the gap");
+    TEST_ASSERT(p.spans[0].offset == 900 && p.spans[0].length == 100, "one request for the real bytes");
+    free(p.spans);
+
+    /* Without a size the ranges are taken as given; the read comes back short */
+    DownloadRange unsized[] = { { 900, 500, 0 } };
+    TEST_ASSERT(plan(unsized, 1, 0, false, 0, &p), "plan");
+    TEST_ASSERT(unsized[0].length == 500 && p.arena_length == 500, "not clipped without a size");
+    free(p.spans);
+    return 1;
+}
+
+static int test_views_follow_short_reads(void) {
+    DownloadRange ranges[] = { { 100, 50, 0 }, { 0, 50, 0 }, { 180, 40, 0 }, { 5, 10, 0 } };
+    Plan p;
+    TEST_ASSERT(plan(ranges, 4, 100, false, 0, &p), "plan");
+    TEST_ASSERT_EQ(p.span_count, 1, "one request");
+    p.spans[0].bytes_read = 200;    /* The object ends at 200 */
+
+    uint64_t at, length;
+    download_ranges_view(&ranges[0], p.spans, &at, &length);
+    TEST_ASSERT(at == 100 && length == 50, "whole range");
+    download_ranges_view(&ranges[3], p.spans, &at, &length);
+    TEST_ASSERT(at == 5 && length == 10, "ranges inside others share bytes");
+    download_ranges_view(&ranges[2], p.spans, &at, &length);
+    TEST_ASSERT(at == 180 && length == 20, "cut where the read stopped");
+
+    p.spans[0].bytes_read = 90;
+    download_ranges_view(&ranges[0], p.spans, &at, &length);
+    TEST_ASSERT(length == 0, "nothing read for a range past the end");
+
+    DownloadRange empty = { 7, 0, DOWNLOAD_RANGES_NO_SPAN };
+    download_ranges_view(&empty, p.spans, &at, &length);
+    TEST_ASSERT(at == 0 && length == 0, "an empty range is empty");
+    free(p.spans);
+    return 1;
+}
+
+static uint32_t rng_state = 12345;
+
+static uint32_t next_random(uint32_t bound) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return (rng_state >> 8) % bound;
+}
+
+/* Read each span from a fake object and check every view against the object */
+static int test_views_match_the_object(void) {
+    enum { SIZE = 4096, RANGES = 32 };
+    uint8_t object[SIZE];
+    for (int i = 0; i < SIZE; i++) {
+        object[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    for (int round = 0; round < 200; round++) {
+        DownloadRange ranges[RANGES];
+        int64_t want_offset[RANGES];
+        uint64_t want_length[RANGES];
+        bool sized = next_random(2) == 0;
+        for (int i = 0; i < RANGES; i++) {
+            int64_t offset = (int64_t)next_random(SIZE + 512);
+            if (sized && next_random(4) == 0) {
+                offset = -(int64_t)(next_random(SIZE + 512) + 1);
+            }
+            ranges[i].offset = offset;
+            ranges[i].length = next_random(300);
+            int64_t start = offset < 0 ? (offset + SIZE > 0 ? offset + SIZE : 0) : offset;
+            uint64_t left = start < SIZE ? (uint64_t)(SIZE - start) : 0;
+            want_offset[i] = start;
+            want_length[i] = ranges[i].length < left ? ranges[i].length : left;
+        }
+
+        Plan p;
+        TEST_ASSERT(plan(ranges, RANGES, next_random(400), sized, SIZE, &p), "plan");
+        uint8_t* arena = (uint8_t*)malloc(p.arena_length + 1);
+        for (uint32_t s = 0; s < p.span_count; s++) {
+            DownloadSpan* span = &p.spans[s];
+            uint64_t left = span->offset < SIZE ? SIZE - span->offset : 0;
+            span->bytes_read = span->length < left ? span->length : left;
+            memcpy(arena + span->arena_offset, object + (span->offset < SIZE ? span->offset : 0),
+                   (size_t)span->bytes_read);
+        }
+        for (int i = 0; i < RANGES; i++) {
+            uint64_t at, length;
+            download_ranges_view(&ranges[i], p.spans, &at, &length);
+            TEST_ASSERT(length == want_length[i], "view length matches the object");
+            TEST_ASSERT(length == 0 || memcmp(arena + at, object + want_offset[i], (size_t)length) == 0,
+                        "view bytes match the object");
+        }
+        free(arena);
+        free(p.spans);
+    }
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Download Ranges Tests");
+
+    RUN_TEST(test_close_ranges_share_a_request);
+    RUN_TEST(test_ranges_are_sorted_and_overlaps_kept);
+    RUN_TEST(test_offsets_from_the_end);
+    RUN_TEST(test_ranges_are_clipped_at_the_end);
+    RUN_TEST(test_views_follow_short_reads);
+    RUN_TEST(test_views_match_the_object);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,360 @@
+/**
+ * @file native/test/test_error_registry.c
+ * @brief Unit tests for error_registry.c: class lookup by code and name,
+ *        the stackless flags set by setStacklessErrors, and construction
+ *        of stackless errors with Error.stackTraceLimit at 0
+ *
+ * Fakes the slice of N-API the registry uses: values live in a static
+ * arena, a reference is the value itself, and the env records the
+ * stackTraceLimit each error was constructed with and what was thrown.
+ */
+
+#define TEST_RUNTIME_FAKE_NAPI
+#include "test_runtime.h"
+#include "../src/common/error_registry.c"
+
+/* ========== fake N-API ========== */
+
+typedef enum {
+    FAKE_UNDEFINED,
+    FAKE_NUMBER,
+    FAKE_STRING,
+    FAKE_ARRAY,
+    FAKE_CONSTRUCTOR,
+    FAKE_ERROR,
+    FAKE_PLAIN_ERROR,
+} FakeKind;
+
+struct napi_value__ {
+    FakeKind kind;
+    int32_t number;                 /* number, or the registry index of a constructor or error */
+    napi_value* items;
+    uint32_t length;
+    int32_t stack_trace_limit;      /* errors: Error.stackTraceLimit when constructed */
+};
+
+struct napi_env__ {
+    AddonInstance instance;
+    struct napi_value__ error_base;
+    int32_t stack_trace_limit;
+    const char* thrown;
+};
+
+struct napi_callback_info__ {
+    napi_value arg;
+};
+
+#define FAKE_VALUES 512
+static struct napi_value__ arena[FAKE_VALUES];
+static size_t arena_used;
+static struct napi_value__ undefined_value = { FAKE_UNDEFINED, 0, NULL, 0, 0 };
+
+static napi_value fake_value(FakeKind kind, int32_t number) {
+    if (arena_used == FAKE_VALUES) {
+        abort();
+    }
+    napi_value value = &arena[arena_used++];
+    memset(value, 0, sizeof(*value));
+    value->kind = kind;
+    value->number = number;
+    return value;
+}
+
+AddonInstance* addon_instance(napi_env env) {
+    return &env->instance;
+}
+
+napi_value uplink_error_to_js(napi_env env, UplinkErrorSimple* error) {
+    (void)env;
+    return fake_value(FAKE_PLAIN_ERROR, error->code);
+}
+
+napi_status napi_get_cb_info(napi_env env, napi_callback_info cbinfo, size_t* argc, napi_value* argv,
+                             napi_value* this_arg, void** data) {
+    (void)env, (void)this_arg, (void)data;
+    *argc = cbinfo->arg != NULL ? 1 : 0;
+    argv[0] = cbinfo->arg;
+    return napi_ok;
+}
+
+napi_status napi_get_undefined(napi_env env, napi_value* result) {
+    (void)env;
+    *result = &undefined_value;
+    return napi_ok;
+}
+
+napi_status napi_is_array(napi_env env, napi_value value, bool* result) {
+    (void)env;
+    *result = value->kind == FAKE_ARRAY;
+    return napi_ok;
+}
+
+napi_status napi_get_array_length(napi_env env, napi_value value, uint32_t* result) {
+    (void)env;
+    *result = value->length;
+    return napi_ok;
+}
+
+napi_status napi_get_element(napi_env env, napi_value object, uint32_t index, napi_value* result) {
+    (void)env;
+    *result = object->items[index];
+    return napi_ok;
+}
+
+napi_status napi_get_value_int32(napi_env env, napi_value value, int32_t* result) {
+    (void)env;
+    if (value->kind != FAKE_NUMBER) {
+        return napi_number_expected;
+    }
+    *result = value->number;
+    return napi_ok;
+}
+
+napi_status napi_create_int32(napi_env env, int32_t value, napi_value* result) {
+    (void)env;
+    *result = fake_value(FAKE_NUMBER, value);
+    return napi_ok;
+}
+
+napi_status napi_create_string_utf8(napi_env env, const char* str, size_t length, napi_value* result) {
+    (void)env, (void)str, (void)length;
+    *result = fake_value(FAKE_STRING, 0);
+    return napi_ok;
+}
+
+/** Only Error.stackTraceLimit is read and written */
+napi_status napi_get_named_property(napi_env env, napi_value object, const char* utf8name, napi_value* result) {
+    if (object != &env->error_base || strcmp(utf8name, "stackTraceLimit") != 0) {
+        return napi_generic_failure;
+    }
+    *result = fake_value(FAKE_NUMBER, env->stack_trace_limit);
+    return napi_ok;
+}
+
+napi_status napi_set_named_property(napi_env env, napi_value object, const char* utf8name, napi_value value) {
+    if (object != &env->error_base || strcmp(utf8name, "stackTraceLimit") != 0) {
+        return napi_generic_failure;
+    }
+    env->stack_trace_limit = value->number;
+    return napi_ok;
+}
+
+napi_status napi_create_reference(napi_env env, napi_value value, uint32_t initial_refcount, napi_ref* result) {
+    (void)env, (void)initial_refcount;
+    *result = (napi_ref)value;
+    return napi_ok;
+}
+
+napi_status napi_get_reference_value(napi_env env, napi_ref ref, napi_value* result) {
+    (void)env;
+    *result = (napi_value)ref;
+    return napi_ok;
+}
+
+napi_status napi_delete_reference(napi_env env, napi_ref ref) {
+    (void)env, (void)ref;
+    return napi_ok;
+}
+
+napi_status napi_new_instance(napi_env env, napi_value constructor, size_t argc, const napi_value* argv,
+                              napi_value* result) {
+    (void)argc, (void)argv;
+    if (constructor->kind != FAKE_CONSTRUCTOR) {
+        return napi_function_expected;
+    }
+    *result = fake_value(FAKE_ERROR, constructor->number);
+    (*result)->stack_trace_limit = env->stack_trace_limit;
+    return napi_ok;
+}
+
+napi_status napi_throw_error(napi_env env, const char* code, const char* msg) {
+    (void)code, (void)msg;
+    env->thrown = "Error";
+    return napi_ok;
+}
+
+napi_status napi_throw_type_error(napi_env env, const char* code, const char* msg) {
+    (void)code, (void)msg;
+    env->thrown = "TypeError";
+    return napi_ok;
+}
+
+napi_status napi_throw_range_error(napi_env env, const char* code, const char* msg) {
+    (void)code, (void)msg;
+    env->thrown = "RangeError";
+    return napi_ok;
+}
+
+/* initErrorClasses runs script; these tests register fake constructors instead */
+
+napi_status napi_typeof(napi_env env, napi_value value, napi_valuetype* result) {
+    (void)env, (void)value, (void)result;
+    return napi_generic_failure;
+}
+
+napi_status napi_get_global(napi_env env, napi_value* result) {
+    (void)env, (void)result;
+    return napi_generic_failure;
+}
+
+napi_status napi_run_script(napi_env env, napi_value script, napi_value* result) {
+    (void)env, (void)script, (void)result;
+    return napi_generic_failure;
+}
+
+napi_status napi_call_function(napi_env env, napi_value recv, napi_value func, size_t argc, const napi_value* argv,
+                               napi_value* result) {
+    (void)env, (void)recv, (void)func, (void)argc, (void)argv, (void)result;
+    return napi_generic_failure;
+}
+
+/* ========== helpers ========== */
+
+/** Fresh env with one fake constructor per class, as initErrorClasses leaves it */
+static void env_init(struct napi_env__* env) {
+    memset(env, 0, sizeof(*env));
+    env->stack_trace_limit = 10;
+    env->instance.error_base = (napi_ref)&env->error_base;
+    for (size_t i = 0; i < ERROR_CLASS_COUNT; i++) {
+        env->instance.error_constructors[i] = (napi_ref)fake_value(FAKE_CONSTRUCTOR, (int32_t)i);
+    }
+    env->instance.errors_registered = 1;
+}
+
+static napi_value codes_array(size_t count, const int32_t* codes) {
+    napi_value array = fake_value(FAKE_ARRAY, 0);
+    array->items = (napi_value*)calloc(count + 1, sizeof(napi_value));
+    array->length = (uint32_t)count;
+    for (size_t i = 0; i < count; i++) {
+        array->items[i] = fake_value(FAKE_NUMBER, codes[i]);
+    }
+    return array;
+}
+
+static void set_stackless(struct napi_env__* env, napi_value arg) {
+    struct napi_callback_info__ info = { arg };
+    env->thrown = NULL;
+    napi_set_stackless_errors(env, &info);
+    if (arg != NULL && arg->kind == FAKE_ARRAY) {
+        free(arg->items);
+    }
+}
+
+static int stackless_count(const struct napi_env__* env) {
+    int count = 0;
+    for (size_t i = 0; i < ERROR_CLASS_COUNT; i++) {
+        count += env->instance.stackless_errors[i];
+    }
+    return count;
+}
+
+/* ========== tests ========== */
+
+static int test_codes_map_to_classes(void) {
+    for (size_t i = 1; i < ERROR_REGISTRY_SIZE; i++) {
+        TEST_ASSERT(error_class_index(error_registry[i].code) == (int)i, "each code finds its class");
+    }
+    TEST_ASSERT_EQ(error_class_index(0), 0, "code 0 is StorjError");
+    TEST_ASSERT_EQ(error_class_index(0x01), -1, "unused code");
+    TEST_ASSERT_EQ(error_class_index(-1), -1, "negative code");
+    TEST_ASSERT_EQ(error_class_index(0x100), -1, "past the table");
+
+    TEST_ASSERT_EQ(error_code_by_class_name("BucketNotFoundError"), UPLINK_ERROR_BUCKET_NOT_FOUND, "by name");
+    TEST_ASSERT_EQ(error_code_by_class_name("EdgeAuthDialFailedError"), 0x30, "edge codes too");
+    TEST_ASSERT_EQ(error_code_by_class_name("NoSuchError"), -1, "unknown name");
+    return 1;
+}
+
+static int test_set_stackless_marks_exactly_the_codes(void) {
+    struct napi_env__ env;
+    env_init(&env);
+
+    const int32_t not_found[] = { UPLINK_ERROR_BUCKET_NOT_FOUND, UPLINK_ERROR_OBJECT_NOT_FOUND };
+    set_stackless(&env, codes_array(2, not_found));
+    TEST_ASSERT_NULL(env.thrown, "accepted");
+    TEST_ASSERT_EQ(stackless_count(&env), 2, "two classes marked");
+    TEST_ASSERT(env.instance.stackless_errors[error_class_index(UPLINK_ERROR_BUCKET_NOT_FOUND)] &&
+                env.instance.stackless_errors[error_class_index(UPLINK_ERROR_OBJECT_NOT_FOUND)], "the not-found ones");
+
+    const int32_t timeout[] = { UPLINK_ERROR_TIMEOUT };
+    set_stackless(&env, codes_array(1, timeout));
+    TEST_ASSERT_EQ(stackless_count(&env), 1, "a new set replaces the old one");
+    TEST_ASSERT(env.instance.stackless_errors[error_class_index(UPLINK_ERROR_TIMEOUT)], "timeout marked");
+
+    set_stackless(&env, codes_array(0, NULL));
+    TEST_ASSERT_EQ(stackless_count(&env), 0, "an empty array clears them");
+    return 1;
+}
+
+static int test_bad_codes_leave_the_flags_alone(void) {
+    struct napi_env__ env;
+    env_init(&env);
+    const int32_t timeout[] = { UPLINK_ERROR_TIMEOUT };
+    set_stackless(&env, codes_array(1, timeout));
+
+    const int32_t mixed[] = { UPLINK_ERROR_BUCKET_NOT_FOUND, 0x99 };
+    set_stackless(&env, codes_array(2, mixed));
+    TEST_ASSERT_STR_EQ(env.thrown, "RangeError", "unknown code refused");
+    TEST_ASSERT(stackless_count(&env) == 1 && env.instance.stackless_errors[error_class_index(UPLINK_ERROR_TIMEOUT)],
+                "all or nothing");
+
+    set_stackless(&env, fake_value(FAKE_NUMBER, UPLINK_ERROR_TIMEOUT));
+    TEST_ASSERT_STR_EQ(env.thrown, "TypeError", "not an array");
+    set_stackless(&env, NULL);
+    TEST_ASSERT_STR_EQ(env.thrown, "TypeError", "no argument");
+    TEST_ASSERT_EQ(stackless_count(&env), 1, "still untouched");
+    return 1;
+}
+
+static int test_stackless_errors_skip_the_stack(void) {
+    struct napi_env__ env;
+    env_init(&env);
+    const int32_t not_found[] = { UPLINK_ERROR_OBJECT_NOT_FOUND };
+    set_stackless(&env, codes_array(1, not_found));
+
+    napi_value error = create_typed_error(&env, UPLINK_ERROR_OBJECT_NOT_FOUND, "missing");
+    TEST_ASSERT(error->kind == FAKE_ERROR && error->number == error_class_index(UPLINK_ERROR_OBJECT_NOT_FOUND),
+                "ObjectNotFoundError");
+    TEST_ASSERT_EQ(error->stack_trace_limit, 0, "constructed with stackTraceLimit 0");
+    TEST_ASSERT_EQ(env.stack_trace_limit, 10, "and the limit restored");
+
+    error = create_typed_error(&env, UPLINK_ERROR_BUCKET_NOT_FOUND, NULL);
+    TEST_ASSERT(error->kind == FAKE_ERROR && error->stack_trace_limit == 10, "other codes keep their stack");
+
+    /* Without the Error base the flag cannot apply; the error is still typed */
+    env.instance.error_base = NULL;
+    error = create_typed_error(&env, UPLINK_ERROR_OBJECT_NOT_FOUND, "missing");
+    TEST_ASSERT(error->kind == FAKE_ERROR && error->stack_trace_limit == 10, "falls back to a normal construct");
+
+    env.instance.errors_registered = 0;
+    error = create_typed_error(&env, UPLINK_ERROR_OBJECT_NOT_FOUND, "missing");
+    TEST_ASSERT(error->kind == FAKE_PLAIN_ERROR && error->number == UPLINK_ERROR_OBJECT_NOT_FOUND,
+                "plain error before the classes exist");
+    return 1;
+}
+
+static int test_flags_are_per_env(void) {
+    struct napi_env__ env_a;
+    struct napi_env__ env_b;
+    env_init(&env_a);
+    env_init(&env_b);
+    const int32_t timeout[] = { UPLINK_ERROR_TIMEOUT };
+    set_stackless(&env_a, codes_array(1, timeout));
+    TEST_ASSERT_EQ(stackless_count(&env_a), 1, "set in one env");
+    TEST_ASSERT_EQ(stackless_count(&env_b), 0, "not in the other");
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Error Registry Tests");
+
+    RUN_TEST(test_codes_map_to_classes);
+    RUN_TEST(test_set_stackless_marks_exactly_the_codes);
+    RUN_TEST(test_bad_codes_leave_the_flags_alone);
+    RUN_TEST(test_stackless_errors_skip_the_stack);
+    RUN_TEST(test_flags_are_per_env);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
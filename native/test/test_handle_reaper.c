@@ -0,0 +1,190 @@
+/**
+ * @file native/test/test_handle_reaper.c
+ * @brief Unit tests for handle_reaper.c: deferred frees run off the
+ *        calling thread, in order, exactly once, with the pending count
+ *        covering queued and in-flight resources
+ *
+ * handle_free_native_resource() is defined here; it records each free
+ * and can be held at a gate to keep a batch in flight.
+ */
+
+#include "test_runtime.h"
+#include "../src/common/handle_reaper.c"
+
+/* ========== recorded frees ========== */
+
+#define MAX_FREES 4096
+
+static pthread_mutex_t frees_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t frees_cond = PTHREAD_COND_INITIALIZER;
+static struct {
+    HandleType type;
+    void* native_ptr;
+} frees[MAX_FREES];
+static size_t free_count;
+static bool freed_off_main = true;
+static pthread_t main_thread;
+static bool hold;                   /* the next free waits until released */
+static bool holding;
+
+void handle_free_native_resource(HandleType type, void* native_ptr) {
+    pthread_mutex_lock(&frees_lock);
+    if (hold) {
+        holding = true;
+        pthread_cond_broadcast(&frees_cond);
+        while (hold) {
+            pthread_cond_wait(&frees_cond, &frees_lock);
+        }
+        holding = false;
+    }
+    if (free_count < MAX_FREES) {
+        frees[free_count].type = type;
+        frees[free_count].native_ptr = native_ptr;
+    }
+    free_count++;
+    freed_off_main = freed_off_main && !pthread_equal(pthread_self(), main_thread);
+    pthread_mutex_unlock(&frees_lock);
+}
+
+static void frees_reset(void) {
+    pthread_mutex_lock(&frees_lock);
+    free_count = 0;
+    pthread_mutex_unlock(&frees_lock);
+}
+
+static size_t frees_now(void) {
+    pthread_mutex_lock(&frees_lock);
+    size_t count = free_count;
+    pthread_mutex_unlock(&frees_lock);
+    return count;
+}
+
+/** Hold the reaper in its next free until release_reaper() */
+static void hold_reaper(void) {
+    pthread_mutex_lock(&frees_lock);
+    hold = true;
+    pthread_mutex_unlock(&frees_lock);
+}
+
+static bool wait_held(void) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += 5;
+    pthread_mutex_lock(&frees_lock);
+    while (!holding) {
+        if (pthread_cond_timedwait(&frees_cond, &frees_lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    bool held = holding;
+    pthread_mutex_unlock(&frees_lock);
+    return held;
+}
+
+static void release_reaper(void) {
+    pthread_mutex_lock(&frees_lock);
+    hold = false;
+    pthread_cond_broadcast(&frees_cond);
+    pthread_mutex_unlock(&frees_lock);
+}
+
+/** Wait until nothing is pending; false after 5 s */
+static bool wait_drained(void) {
+    for (int i = 0; i < 5000; i++) {
+        if (handle_reaper_pending() == 0) {
+            return true;
+        }
+        uv_sleep(1);
+    }
+    return false;
+}
+
+/* A distinct fake native pointer per index */
+static char resources[MAX_FREES];
+
+/* ========== tests ========== */
+
+static int test_frees_run_on_the_reaper_thread(void) {
+    enum { COUNT = 100 };
+    frees_reset();
+    for (int i = 0; i < COUNT; i++) {
+        HandleType type = (HandleType)(i % HANDLE_TYPE_COUNT);
+        TEST_ASSERT(handle_reaper_defer(type, &resources[i]), "queued");
+    }
+    TEST_ASSERT(wait_drained(), "drained");
+    TEST_ASSERT_EQ(frees_now(), COUNT, "every resource freed once");
+    for (int i = 0; i < COUNT; i++) {
+        TEST_ASSERT(frees[i].native_ptr == &resources[i] && frees[i].type == (HandleType)(i % HANDLE_TYPE_COUNT),
+                    "in queue order, with its type");
+    }
+    TEST_ASSERT(freed_off_main, "never on the calling thread");
+    return 1;
+}
+
+static int test_pending_counts_queued_and_in_flight(void) {
+    enum { LATER = 3 * REAPER_INITIAL_CAPACITY };
+    frees_reset();
+    hold_reaper();
+    TEST_ASSERT(handle_reaper_defer(HANDLE_TYPE_PROJECT, &resources[0]), "queued");
+    TEST_ASSERT(wait_held(), "the reaper took it");
+    TEST_ASSERT_EQ(handle_reaper_pending(), 1, "in flight counts as pending");
+
+    /* Queued while the reaper is busy: the pending array grows past its initial size */
+    for (int i = 1; i <= LATER; i++) {
+        TEST_ASSERT(handle_reaper_defer(HANDLE_TYPE_DOWNLOAD, &resources[i]), "queued behind");
+    }
+    TEST_ASSERT_EQ(handle_reaper_pending(), LATER + 1, "in flight plus queued");
+    TEST_ASSERT_EQ(frees_now(), 0, "nothing freed while held");
+
+    release_reaper();
+    TEST_ASSERT(wait_drained(), "drained");
+    TEST_ASSERT_EQ(frees_now(), LATER + 1, "all freed");
+    for (int i = 0; i <= LATER; i++) {
+        TEST_ASSERT(frees[i].native_ptr == &resources[i], "in queue order");
+    }
+    return 1;
+}
+
+#define DEFER_THREADS 4
+#define DEFER_PER_THREAD 500
+
+static void defer_worker(void* arg) {
+    char* base = (char*)arg;
+    for (int i = 0; i < DEFER_PER_THREAD; i++) {
+        handle_reaper_defer(HANDLE_TYPE_UPLOAD, base + i);
+    }
+}
+
+static int test_concurrent_defers_free_each_once(void) {
+    frees_reset();
+    uv_thread_t threads[DEFER_THREADS];
+    for (int t = 0; t < DEFER_THREADS; t++) {
+        uv_thread_create(&threads[t], defer_worker, &resources[t * DEFER_PER_THREAD]);
+    }
+    for (int t = 0; t < DEFER_THREADS; t++) {
+        uv_thread_join(&threads[t]);
+    }
+    TEST_ASSERT(wait_drained(), "drained");
+    TEST_ASSERT_EQ(frees_now(), DEFER_THREADS * DEFER_PER_THREAD, "no resource lost");
+
+    static bool seen[DEFER_THREADS * DEFER_PER_THREAD];
+    for (size_t i = 0; i < free_count; i++) {
+        size_t index = (size_t)((char*)frees[i].native_ptr - resources);
+        TEST_ASSERT(index < DEFER_THREADS * DEFER_PER_THREAD && !seen[index], "none freed twice");
+        seen[index] = true;
+    }
+    return 1;
+}
+
+int main(void) {
+    main_thread = pthread_self();
+    TEST_SUITE_BEGIN("Handle Reaper Tests");
+
+    RUN_TEST(test_frees_run_on_the_reaper_thread);
+    RUN_TEST(test_pending_counts_queued_and_in_flight);
+    RUN_TEST(test_concurrent_defers_free_each_once);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,416 @@
+/**
+ * @file native/test/test_handle_slabs.c
+ * @brief Unit tests for the handle slabs of handle_helpers.c and the
+ *        per-env instances of addon_instance.c: tokens, slot reuse,
+ *        stale and foreign handles, close counters, and env teardown
+ *
+ * Builds against native/include/uplink.h (installed by make install); the
+ * uplink_free_*_result functions are defined here and count frees. A
+ * napi_env is a fake holding its instance data and finalizer, which the
+ * tests run to tear the env down, and externals are heap records that the
+ * tests "collect" by running their finalizer.
+ */
+
+#include "test_runtime.h"
+#include "../src/common/handle_helpers.c"
+#include "../src/common/addon_instance.c"
+#include "../src/common/string_helpers.c"
+#include "../src/common/library_loader.c"
+
+/* ========== fake env ========== */
+
+struct napi_env__ {
+    void* data;
+    napi_finalize finalize;
+    void* hint;
+};
+
+napi_status napi_set_instance_data(node_api_basic_env env, void* data, napi_finalize finalize_cb, void* finalize_hint) {
+    env->data = data;
+    env->finalize = finalize_cb;
+    env->hint = finalize_hint;
+    return napi_ok;
+}
+
+napi_status napi_get_instance_data(node_api_basic_env env, void** data) {
+    *data = env->data;
+    return napi_ok;
+}
+
+static void env_open(napi_env env) {
+    memset(env, 0, sizeof(*env));
+    addon_instance_init(env);
+}
+
+/** Tear the env down, as Node does when its thread exits */
+static void env_teardown(napi_env env) {
+    void* data = env->data;
+    env->data = NULL;
+    env->finalize(env, data, env->hint);
+}
+
+typedef struct {
+    void* data;
+    napi_finalize finalize;
+    void* hint;
+} TestExternal;
+
+napi_status napi_create_external(napi_env env, void* data, napi_finalize finalize_cb, void* finalize_hint,
+                                 napi_value* result) {
+    (void)env;
+    TestExternal* external = (TestExternal*)malloc(sizeof(TestExternal));
+    if (external == NULL) {
+        return napi_generic_failure;
+    }
+    external->data = data;
+    external->finalize = finalize_cb;
+    external->hint = finalize_hint;
+    *result = (napi_value)external;
+    return napi_ok;
+}
+
+napi_status napi_get_value_external(napi_env env, napi_value value, void** result) {
+    (void)env;
+    *result = ((TestExternal*)value)->data;
+    return napi_ok;
+}
+
+napi_status napi_throw_error(napi_env env, const char* code, const char* msg) {
+    (void)env, (void)code, (void)msg;
+    return napi_ok;
+}
+
+/** Run the external's finalizer, as the GC would */
+static void collect(napi_env env, napi_value value) {
+    TestExternal* external = (TestExternal*)value;
+    external->finalize(env, external->data, external->hint);
+    free(external);
+}
+
+napi_status napi_get_null(napi_env env, napi_value* result) {
+    (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_create_string_utf8(napi_env env, const char* str, size_t length, napi_value* result) {
+    (void)str, (void)length, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+/* ========== modules the slabs and instances call ========== */
+
+void admission_release(AdmissionSlot* slot) {
+    (void)slot;
+}
+
+bool handle_reaper_defer(HandleType type, void* native_ptr) {
+    (void)type, (void)native_ptr;
+    return false;
+}
+
+/* Per-env caches and registries: count what teardown releases */
+static int access_caches_destroyed;
+static int key_caches_destroyed;
+static int op_metrics_destroyed;
+static const AddonInstance* registry_cleaned;
+static const AddonInstance* object_keys_cleaned;
+
+void access_cache_destroy(AccessCache* cache) {
+    access_caches_destroyed += cache != NULL;
+}
+
+void key_cache_destroy(KeyCache* cache) {
+    key_caches_destroyed += cache != NULL;
+}
+
+void op_metrics_destroy(OpMetricsRegistry* registry) {
+    op_metrics_destroyed += registry != NULL;
+}
+
+void error_registry_cleanup(napi_env env, AddonInstance* instance) {
+    (void)env;
+    registry_cleaned = instance;
+}
+
+void object_keys_cleanup(napi_env env, AddonInstance* instance) {
+    (void)env;
+    object_keys_cleaned = instance;
+}
+
+static int freed[HANDLE_TYPE_COUNT];
+
+void uplink_free_access_result(UplinkAccessResult result) {
+    freed[HANDLE_TYPE_ACCESS] += result.access != NULL;
+}
+
+void uplink_free_project_result(UplinkProjectResult result) {
+    freed[HANDLE_TYPE_PROJECT] += result.project != NULL;
+}
+
+void uplink_free_download_result(UplinkDownloadResult result) {
+    freed[HANDLE_TYPE_DOWNLOAD] += result.download != NULL;
+}
+
+void uplink_free_upload_result(UplinkUploadResult result) {
+    freed[HANDLE_TYPE_UPLOAD] += result.upload != NULL;
+}
+
+void uplink_free_encryption_key_result(UplinkEncryptionKeyResult result) {
+    freed[HANDLE_TYPE_ENCRYPTION_KEY] += result.encryption_key != NULL;
+}
+
+void uplink_free_part_upload_result(UplinkPartUploadResult result) {
+    freed[HANDLE_TYPE_PART_UPLOAD] += result.part_upload != NULL;
+}
+
+/* ========== tests ========== */
+
+static uintptr_t token_of(napi_value value) {
+    return (uintptr_t)((TestExternal*)value)->data;
+}
+
+static bool extracts(napi_env env, napi_value value, HandleType type, size_t want) {
+    size_t handle = 0;
+    return extract_handle(env, value, type, &handle) == napi_ok && handle == want;
+}
+
+static int test_stale_generation_rejected_after_reuse(void) {
+    struct napi_env__ env;
+    env_open(&env);
+    static UplinkProject project;
+    memset(freed, 0, sizeof(freed));
+
+    napi_value first = create_handle_external(&env, 11, HANDLE_TYPE_PROJECT, &project, NULL);
+    TEST_ASSERT_NOT_NULL(first, "created");
+    TEST_ASSERT(extracts(&env, first, HANDLE_TYPE_PROJECT, 11), "live handle extracts");
+    uintptr_t stale = token_of(first);
+    TEST_ASSERT(stale != 0, "tokens are never 0");
+
+    collect(&env, first);
+    TEST_ASSERT_EQ(handle_live_count(&env, HANDLE_TYPE_PROJECT), 0, "slot returned");
+    TEST_ASSERT_EQ(freed[HANDLE_TYPE_PROJECT], 1, "uplink-c project freed");
+
+    napi_value second = create_handle_external(&env, 22, HANDLE_TYPE_PROJECT, NULL, NULL);
+    uintptr_t fresh = token_of(second);
+    uintptr_t generation_mask = ~(uintptr_t)0 << TOKEN_GENERATION_SHIFT;
+    TEST_ASSERT((fresh & ~generation_mask) == (stale & ~generation_mask), "same slot reused");
+    TEST_ASSERT(fresh != stale, "with a new generation");
+
+    /* A copy of the collected external still carries the old token */
+    TestExternal copy = { (void*)stale, handle_finalize, NULL };
+    TEST_ASSERT(!extracts(&env, (napi_value)&copy, HANDLE_TYPE_PROJECT, 22), "stale token rejected");
+    TEST_ASSERT_NULL(get_handle_wrapper(&env, (napi_value)&copy, HANDLE_TYPE_PROJECT), "no wrapper for it");
+    TEST_ASSERT(extracts(&env, second, HANDLE_TYPE_PROJECT, 22), "the new handle still works");
+
+    /* A late finalizer for the stale token must not free the new handle */
+    handle_finalize(&env, (void*)stale, NULL);
+    TEST_ASSERT_EQ(handle_live_count(&env, HANDLE_TYPE_PROJECT), 1, "stale finalizer ignored");
+    TEST_ASSERT(extracts(&env, second, HANDLE_TYPE_PROJECT, 22), "new handle untouched");
+
+    collect(&env, second);
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_generations_skip_zero(void) {
+    struct napi_env__ env;
+    env_open(&env);
+    napi_value value = create_handle_external(&env, 1, HANDLE_TYPE_DOWNLOAD, NULL, NULL);
+    HandleSlab* slab = &addon_instance(&env)->handle_slabs[HANDLE_TYPE_DOWNLOAD];
+    HandleSlot* slot = slab_slot(slab, 0);
+    slot->generation = TOKEN_GENERATION_MASK;
+    slot_free(slab, slot, 0);
+    TEST_ASSERT_EQ(slot->generation, 1, "wraps to 1, never to 0");
+    free((TestExternal*)value);
+
+    napi_value again = create_handle_external(&env, 2, HANDLE_TYPE_DOWNLOAD, NULL, NULL);
+    TEST_ASSERT((token_of(again) >> TOKEN_GENERATION_SHIFT) == 1, "reused with generation 1");
+    collect(&env, again);
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_wrong_type_and_foreign_env_rejected(void) {
+    struct napi_env__ env_a;
+    struct napi_env__ env_b;
+    env_open(&env_a);
+    env_open(&env_b);
+    napi_value upload = create_handle_external(&env_a, 5, HANDLE_TYPE_UPLOAD, NULL, NULL);
+
+    TEST_ASSERT(!extracts(&env_a, upload, HANDLE_TYPE_DOWNLOAD, 5), "type checked");
+    TEST_ASSERT(!extracts(&env_b, upload, HANDLE_TYPE_UPLOAD, 5), "another env has no such slot");
+
+    napi_value other = create_handle_external(&env_b, 6, HANDLE_TYPE_UPLOAD, NULL, NULL);
+    TEST_ASSERT(token_of(other) == token_of(upload), "envs hand out the same first token");
+    TEST_ASSERT(extracts(&env_b, upload, HANDLE_TYPE_UPLOAD, 6), "which names each env's own wrapper");
+
+    TestExternal zero = { 0, handle_finalize, NULL };
+    TEST_ASSERT(!extracts(&env_a, (napi_value)&zero, HANDLE_TYPE_ACCESS, 0), "null token rejected");
+
+    collect(&env_a, upload);
+    collect(&env_b, other);
+    env_teardown(&env_a);
+    env_teardown(&env_b);
+    return 1;
+}
+
+static int test_slabs_grow_without_moving_wrappers(void) {
+    enum { COUNT = HANDLE_SLAB_CHUNK * 2 + 10 };
+    struct napi_env__ env;
+    env_open(&env);
+    static napi_value values[COUNT];
+    static HandleWrapper* wrappers[COUNT];
+    for (size_t i = 0; i < COUNT; i++) {
+        values[i] = create_handle_external(&env, i + 1, HANDLE_TYPE_OBJECT_ITERATOR, NULL, NULL);
+        wrappers[i] = get_handle_wrapper(&env, values[i], HANDLE_TYPE_OBJECT_ITERATOR);
+    }
+    TEST_ASSERT_EQ(addon_instance(&env)->handle_slabs[HANDLE_TYPE_OBJECT_ITERATOR].chunk_count, 3, "grew by chunks");
+    TEST_ASSERT_EQ(handle_live_count(&env, HANDLE_TYPE_OBJECT_ITERATOR), COUNT, "all live");
+    for (size_t i = 0; i < COUNT; i++) {
+        TEST_ASSERT(get_handle_wrapper(&env, values[i], HANDLE_TYPE_OBJECT_ITERATOR) == wrappers[i],
+                    "wrappers stay put");
+        TEST_ASSERT(wrappers[i]->handle == i + 1, "and keep their handle");
+    }
+    for (size_t i = 0; i < COUNT; i++) {
+        collect(&env, values[i]);
+    }
+    TEST_ASSERT_EQ(handle_live_count(&env, HANDLE_TYPE_OBJECT_ITERATOR), 0, "all returned");
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_close_counters(void) {
+    struct napi_env__ env;
+    env_open(&env);
+    napi_value closed = create_handle_external(&env, 1, HANDLE_TYPE_ACCESS, NULL, NULL);
+    napi_value dropped = create_handle_external(&env, 2, HANDLE_TYPE_ACCESS, NULL, NULL);
+
+    mark_handle_closed(&env, closed, HANDLE_TYPE_ACCESS);
+    mark_handle_closed(&env, closed, HANDLE_TYPE_ACCESS);
+    mark_handle_closed(&env, dropped, HANDLE_TYPE_PROJECT);
+    const HandleSlab* slab = handle_slab(&env, HANDLE_TYPE_ACCESS);
+    TEST_ASSERT_EQ(slab->explicit_closes, 1, "a close counts once, and only for the right type");
+
+    collect(&env, closed);
+    collect(&env, dropped);
+    TEST_ASSERT_EQ(slab->finalizer_frees, 1, "only the unclosed handle counts as a finalizer free");
+    TEST_ASSERT_EQ(slab->live, 0, "both returned");
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_teardown_releases_the_env(void) {
+    static int project;
+    static int download;
+    struct napi_env__ env;
+    env_open(&env);
+    AddonInstance* instance = addon_instance(&env);
+    TEST_ASSERT_NOT_NULL(instance, "instance created at init");
+    TEST_ASSERT_EQ(instance->holds_library, 1, "holding a library reference");
+
+    napi_value live = create_handle_external(&env, 1, HANDLE_TYPE_PROJECT, &project, NULL);
+    napi_value other = create_handle_external(&env, 2, HANDLE_TYPE_DOWNLOAD, &download, NULL);
+    char* held = intern_name(&instance->bucket_names, "photos", 6);
+    TEST_ASSERT_NOT_NULL(held, "name interned");
+
+    /* Any non-NULL pointer will do: the destroy stubs only count */
+    instance->access_cache = (AccessCache*)&project;
+    instance->key_cache = (KeyCache*)&project;
+    instance->op_metrics = (OpMetricsRegistry*)&project;
+
+    int before[HANDLE_TYPE_COUNT];
+    memcpy(before, freed, sizeof(freed));
+    int access_before = access_caches_destroyed;
+    int keys_before = key_caches_destroyed;
+    int metrics_before = op_metrics_destroyed;
+    env_teardown(&env);
+
+    TEST_ASSERT_EQ(freed[HANDLE_TYPE_PROJECT] - before[HANDLE_TYPE_PROJECT], 1, "live project freed");
+    TEST_ASSERT_EQ(freed[HANDLE_TYPE_DOWNLOAD] - before[HANDLE_TYPE_DOWNLOAD], 1, "live download freed");
+    TEST_ASSERT_EQ(access_caches_destroyed - access_before, 1, "access cache destroyed");
+    TEST_ASSERT_EQ(key_caches_destroyed - keys_before, 1, "key cache destroyed");
+    TEST_ASSERT_EQ(op_metrics_destroyed - metrics_before, 1, "op metrics destroyed");
+    TEST_ASSERT(registry_cleaned == instance && object_keys_cleaned == instance, "registries cleaned up");
+    TEST_ASSERT_NULL(addon_instance(&env), "instance gone");
+
+    /* The GC may still collect a wrapper after its env is gone */
+    collect(&env, live);
+    collect(&env, other);
+    TEST_ASSERT_EQ(freed[HANDLE_TYPE_PROJECT] - before[HANDLE_TYPE_PROJECT], 1, "late finalizers ignored");
+    TEST_ASSERT_EQ(freed[HANDLE_TYPE_DOWNLOAD] - before[HANDLE_TYPE_DOWNLOAD], 1, "nothing freed twice");
+
+    TEST_ASSERT_STR_EQ(held, "photos", "a held bucket name outlives its env");
+    bucket_name_release(held);      /* Frees it; ASan catches a leak or double free */
+    return 1;
+}
+
+static int test_teardown_leaves_other_envs_alone(void) {
+    static int project;
+    struct napi_env__ env_a;
+    struct napi_env__ env_b;
+    env_open(&env_a);
+    env_open(&env_b);
+    napi_value a = create_handle_external(&env_a, 1, HANDLE_TYPE_PROJECT, &project, NULL);
+    napi_value b = create_handle_external(&env_b, 2, HANDLE_TYPE_PROJECT, &project, NULL);
+    TEST_ASSERT_EQ(token_of(a), token_of(b), "same slot and generation in each env");
+
+    int before = freed[HANDLE_TYPE_PROJECT];
+    env_teardown(&env_a);
+    TEST_ASSERT_EQ(freed[HANDLE_TYPE_PROJECT] - before, 1, "only the torn-down env's handle freed");
+    TEST_ASSERT(extracts(&env_b, b, HANDLE_TYPE_PROJECT, 2), "the other env's handle still works");
+    TEST_ASSERT_EQ(handle_live_count(&env_b, HANDLE_TYPE_PROJECT), 1, "and still counts as live");
+
+    collect(&env_a, a);
+    TEST_ASSERT(extracts(&env_b, b, HANDLE_TYPE_PROJECT, 2), "a late finalizer does not reach it");
+    collect(&env_b, b);
+    TEST_ASSERT_EQ(freed[HANDLE_TYPE_PROJECT] - before, 2, "freed by its own finalizer");
+    env_teardown(&env_b);
+    return 1;
+}
+
+static int test_last_env_closes_the_library(void) {
+    unsigned int refs = lib_refs;
+    struct napi_env__ env_a;
+    struct napi_env__ env_b;
+    env_open(&env_a);
+    env_open(&env_b);
+    TEST_ASSERT_EQ(lib_refs - refs, 2, "a reference per env");
+    TEST_ASSERT_NOT_NULL(get_uplink_function("cos"), "first lookup loads the library");
+    TEST_ASSERT(get_loaded_library_path()[0] != '\0', "path recorded");
+
+    env_teardown(&env_a);
+    TEST_ASSERT_EQ(lib_refs - refs, 1, "one reference left");
+    TEST_ASSERT_NOT_NULL(uplink_lib_handle, "still open for the other env");
+
+    env_teardown(&env_b);
+    TEST_ASSERT_EQ(lib_refs, refs, "all references returned");
+    if (refs == 0) {
+        TEST_ASSERT_NULL(uplink_lib_handle, "closed with the last env");
+        TEST_ASSERT_EQ(loaded_path[0], '\0', "path cleared");
+    }
+    return 1;
+}
+
+int main(void) {
+    /* Any library with a known symbol stands in for libuplink */
+#ifdef __APPLE__
+    setenv("UPLINK_LIBRARY_PATH", "/usr/lib/libSystem.B.dylib", 1);
+#else
+    setenv("UPLINK_LIBRARY_PATH", "libm.so.6", 1);
+#endif
+
+    TEST_SUITE_BEGIN("Handle Slab Tests");
+
+    RUN_TEST(test_stale_generation_rejected_after_reuse);
+    RUN_TEST(test_generations_skip_zero);
+    RUN_TEST(test_wrong_type_and_foreign_env_rejected);
+    RUN_TEST(test_slabs_grow_without_moving_wrappers);
+    RUN_TEST(test_close_counters);
+    RUN_TEST(test_teardown_releases_the_env);
+    RUN_TEST(test_teardown_leaves_other_envs_alone);
+    RUN_TEST(test_last_env_closes_the_library);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file native/test/test_hedge.c
+ * @brief Unit tests for hedge.c: when the backup starts, which attempt
+ *        wins, and that the loser is always released
+ */
+
+#include "test_runtime.h"
+#include "../src/common/hedge.c"
+
+#define MS 1000000ull
+
+typedef struct {
+    unsigned delay_ms;      /* How long the attempt takes */
+    int status;             /* What it returns, 0 = success */
+    int ran;
+    int freed;
+} TestAttempt;
+
+static pthread_mutex_t attempts_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int attempt_run(void* arg) {
+    TestAttempt* attempt = (TestAttempt*)arg;
+    uv_sleep(attempt->delay_ms);
+    pthread_mutex_lock(&attempts_lock);
+    attempt->ran = 1;
+    pthread_mutex_unlock(&attempts_lock);
+    return attempt->status;
+}
+
+static void attempt_free(void* arg) {
+    TestAttempt* attempt = (TestAttempt*)arg;
+    pthread_mutex_lock(&attempts_lock);
+    attempt->freed++;
+    pthread_mutex_unlock(&attempts_lock);
+}
+
+/** Wait up to two seconds for an abandoned attempt to be released */
+static int freed_eventually(TestAttempt* attempt) {
+    for (int i = 0; i < 200; i++) {
+        pthread_mutex_lock(&attempts_lock);
+        int freed = attempt->freed;
+        pthread_mutex_unlock(&attempts_lock);
+        if (freed > 0) {
+            return freed;
+        }
+        uv_sleep(10);
+    }
+    return 0;
+}
+
+static void counters(uint64_t* hedged, uint64_t* wins) {
+    uv_mutex_lock(&hedge_lock);
+    *hedged = hedged_count;
+    *wins = backup_wins;
+    uv_mutex_unlock(&hedge_lock);
+}
+
+static int test_fast_primary_is_not_hedged(void) {
+    TestAttempt primary = { 0, 0, 0, 0 }, backup = { 0, 0, 0, 0 };
+    bool hedged = true;
+    void* result = hedge_run(attempt_run, attempt_free, &primary, &backup, 500 * MS, &hedged);
+    TEST_ASSERT(result == &primary, "primary is used");
+    TEST_ASSERT(!hedged, "no backup started");
+    TEST_ASSERT(!backup.ran, "backup never ran");
+    TEST_ASSERT_EQ(backup.freed, 1, "unused backup is released at once");
+    TEST_ASSERT_EQ(primary.freed, 0, "the caller owns the result");
+    return 1;
+}
+
+static int test_slow_primary_loses_to_backup(void) {
+    uint64_t hedged_before, wins_before, hedged_after, wins_after;
+    counters(&hedged_before, &wins_before);
+    TestAttempt primary = { 300, 0, 0, 0 }, backup = { 0, 0, 0, 0 };
+    bool hedged = false;
+    uint64_t start = uv_hrtime();
+    void* result = hedge_run(attempt_run, attempt_free, &primary, &backup, 20 * MS, &hedged);
+    uint64_t elapsed = uv_hrtime() - start;
+    TEST_ASSERT(result == &backup, "backup wins");
+    TEST_ASSERT(hedged, "backup started");
+    TEST_ASSERT(elapsed >= 20 * MS, "backup waited for the delay");
+    TEST_ASSERT(elapsed < 250 * MS, "caller did not wait for the slow primary");
+    TEST_ASSERT_EQ(freed_eventually(&primary), 1, "abandoned primary is released once it finishes");
+    TEST_ASSERT_EQ(backup.freed, 0, "the caller owns the result");
+    counters(&hedged_after, &wins_after);
+    TEST_ASSERT_EQ(hedged_after - hedged_before, 1, "race counted");
+    TEST_ASSERT_EQ(wins_after - wins_before, 1, "backup win counted");
+    return 1;
+}
+
+static int test_slow_primary_can_still_win(void) {
+    uint64_t hedged_before, wins_before, hedged_after, wins_after;
+    counters(&hedged_before, &wins_before);
+    TestAttempt primary = { 100, 0, 0, 0 }, backup = { 600, 0, 0, 0 };
+    bool hedged = false;
+    void* result = hedge_run(attempt_run, attempt_free, &primary, &backup, 10 * MS, &hedged);
+    TEST_ASSERT(result == &primary, "primary finished first");
+    TEST_ASSERT(hedged, "backup started");
+    TEST_ASSERT_EQ(freed_eventually(&backup), 1, "abandoned backup is released once it finishes");
+    counters(&hedged_after, &wins_after);
+    TEST_ASSERT_EQ(hedged_after - hedged_before, 1, "race counted");
+    TEST_ASSERT_EQ(wins_after - wins_before, 0, "no backup win");
+    return 1;
+}
+
+static int test_early_failure_is_not_hedged(void) {
+    TestAttempt primary = { 0, 5, 0, 0 }, backup = { 0, 0, 0, 0 };
+    bool hedged = true;
+    void* result = hedge_run(attempt_run, attempt_free, &primary, &backup, 500 * MS, &hedged);
+    TEST_ASSERT(result == &primary, "the failed primary is returned");
+    TEST_ASSERT(!hedged, "a fast failure is not retried as a hedge");
+    TEST_ASSERT(!backup.ran, "backup never ran");
+    TEST_ASSERT_EQ(backup.freed, 1, "unused backup is released");
+    return 1;
+}
+
+static int test_failed_backup_does_not_win(void) {
+    TestAttempt primary = { 150, 0, 0, 0 }, backup = { 0, 7, 0, 0 };
+    bool hedged = false;
+    void* result = hedge_run(attempt_run, attempt_free, &primary, &backup, 10 * MS, &hedged);
+    TEST_ASSERT(result == &primary, "the slower success beats a fast failure");
+    TEST_ASSERT(hedged, "backup started");
+    TEST_ASSERT_EQ(freed_eventually(&backup), 1, "failed backup is released");
+    return 1;
+}
+
+static int test_both_failing_uses_primary(void) {
+    TestAttempt primary = { 100, 3, 0, 0 }, backup = { 0, 4, 0, 0 };
+    bool hedged = false;
+    void* result = hedge_run(attempt_run, attempt_free, &primary, &backup, 10 * MS, &hedged);
+    TEST_ASSERT(result == &primary, "the primary's outcome is used");
+    TEST_ASSERT(hedged, "backup started");
+    TEST_ASSERT(primary.ran && backup.ran, "both ran to completion");
+    TEST_ASSERT_EQ(backup.freed, 1, "backup is released");
+    TEST_ASSERT_EQ(primary.freed, 0, "the caller owns the result");
+    return 1;
+}
+
+static int test_hedged_out_is_optional(void) {
+    TestAttempt primary = { 0, 0, 0, 0 }, backup = { 0, 0, 0, 0 };
+    TEST_ASSERT(hedge_run(attempt_run, attempt_free, &primary, &backup, 500 * MS, NULL) == &primary,
+                "NULL hedged is accepted");
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Hedge Tests");
+
+    RUN_TEST(test_fast_primary_is_not_hedged);
+    RUN_TEST(test_slow_primary_loses_to_backup);
+    RUN_TEST(test_slow_primary_can_still_win);
+    RUN_TEST(test_early_failure_is_not_hedged);
+    RUN_TEST(test_failed_backup_does_not_win);
+    RUN_TEST(test_both_failing_uses_primary);
+    RUN_TEST(test_hedged_out_is_optional);
+
+    /* Join the attempt threads still on the reap list */
+    reap_threads();
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
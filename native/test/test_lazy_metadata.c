@@ -0,0 +1,509 @@
+/**
+ * @file native/test/test_lazy_metadata.c
+ * @brief Unit tests for the lazy `custom` metadata of object_converter.c:
+ *        the latin1 packing, the decoder behind the accessor, and the
+ *        fallbacks to eager conversion
+ *
+ * Fakes the slice of N-API the converter uses: values live in a static
+ * arena reset by each test, objects keep their properties in order, and
+ * makeObject is a fake function that records the arguments it was
+ * called with.
+ */
+
+#define TEST_RUNTIME_FAKE_NAPI
+#include "test_runtime.h"
+#include "../src/common/object_converter.c"
+
+/* ========== fake N-API ========== */
+
+typedef enum {
+    FAKE_UNDEFINED,
+    FAKE_NULL,
+    FAKE_BOOLEAN,
+    FAKE_NUMBER,
+    FAKE_STRING,
+    FAKE_OBJECT,
+    FAKE_FUNCTION,
+} FakeKind;
+
+#define FAKE_PROPERTIES 16
+
+struct napi_value__ {
+    FakeKind kind;
+    int64_t number;
+    char* bytes;                    /* strings: owned, NUL-terminated */
+    size_t length;
+    bool latin1;                    /* strings: created one byte per character */
+    const char* names[FAKE_PROPERTIES];
+    napi_value values[FAKE_PROPERTIES];
+    size_t count;
+};
+
+struct napi_env__ {
+    bool call_fails;                /* makeObject throws */
+    size_t call_argc;
+    napi_value call_argv[4];
+    int calls;
+    int exceptions_cleared;
+    const char* thrown;
+};
+
+struct napi_callback_info__ {
+    size_t argc;
+    napi_value arg;
+};
+
+#define FAKE_VALUES 256
+static struct napi_value__ arena[FAKE_VALUES];
+static size_t arena_used;
+
+static napi_value fake_value(FakeKind kind) {
+    if (arena_used == FAKE_VALUES) {
+        abort();
+    }
+    napi_value value = &arena[arena_used++];
+    memset(value, 0, sizeof(*value));
+    value->kind = kind;
+    return value;
+}
+
+static napi_value fake_string(const char* bytes, size_t length, bool latin1) {
+    napi_value value = fake_value(FAKE_STRING);
+    value->bytes = (char*)malloc(length + 1);
+    memcpy(value->bytes, bytes, length);
+    value->bytes[length] = '\0';
+    value->length = length;
+    value->latin1 = latin1;
+    return value;
+}
+
+static void arena_reset(void) {
+    for (size_t i = 0; i < arena_used; i++) {
+        free(arena[i].bytes);
+    }
+    arena_used = 0;
+}
+
+static void fake_set(napi_value object, const char* name, napi_value value) {
+    if (object->count == FAKE_PROPERTIES) {
+        abort();
+    }
+    object->names[object->count] = name;
+    object->values[object->count++] = value;
+}
+
+AddonInstance* addon_instance(napi_env env) {
+    (void)env;
+    return NULL;
+}
+
+napi_status napi_create_string_latin1(napi_env env, const char* str, size_t length, napi_value* result) {
+    (void)env;
+    *result = fake_string(str, length, true);
+    return napi_ok;
+}
+
+napi_status napi_create_string_utf8(napi_env env, const char* str, size_t length, napi_value* result) {
+    (void)env;
+    *result = fake_string(str, length == NAPI_AUTO_LENGTH ? strlen(str) : length, false);
+    return napi_ok;
+}
+
+napi_status napi_get_value_string_latin1(napi_env env, napi_value value, char* buf, size_t bufsize, size_t* result) {
+    (void)env;
+    if (value->kind != FAKE_STRING) {
+        return napi_string_expected;
+    }
+    if (buf == NULL) {
+        *result = value->length;
+        return napi_ok;
+    }
+    size_t copy = value->length < bufsize - 1 ? value->length : bufsize - 1;
+    memcpy(buf, value->bytes, copy);
+    buf[copy] = '\0';
+    if (result != NULL) {
+        *result = copy;
+    }
+    return napi_ok;
+}
+
+napi_status napi_get_cb_info(napi_env env, napi_callback_info cbinfo, size_t* argc, napi_value* argv,
+                             napi_value* this_arg, void** data) {
+    (void)env, (void)this_arg, (void)data;
+    if (*argc > 0 && cbinfo->argc > 0) {
+        argv[0] = cbinfo->arg;
+    }
+    *argc = cbinfo->argc;
+    return napi_ok;
+}
+
+napi_status napi_get_undefined(napi_env env, napi_value* result) {
+    (void)env;
+    *result = fake_value(FAKE_UNDEFINED);
+    return napi_ok;
+}
+
+napi_status napi_get_null(napi_env env, napi_value* result) {
+    (void)env;
+    *result = fake_value(FAKE_NULL);
+    return napi_ok;
+}
+
+napi_status napi_get_boolean(napi_env env, bool value, napi_value* result) {
+    (void)env;
+    *result = fake_value(FAKE_BOOLEAN);
+    (*result)->number = value;
+    return napi_ok;
+}
+
+napi_status napi_create_int64(napi_env env, int64_t value, napi_value* result) {
+    (void)env;
+    *result = fake_value(FAKE_NUMBER);
+    (*result)->number = value;
+    return napi_ok;
+}
+
+napi_status napi_create_object(napi_env env, napi_value* result) {
+    (void)env;
+    *result = fake_value(FAKE_OBJECT);
+    return napi_ok;
+}
+
+napi_status napi_set_named_property(napi_env env, napi_value object, const char* utf8name, napi_value value) {
+    (void)env;
+    fake_set(object, fake_string(utf8name, strlen(utf8name), false)->bytes, value);
+    return napi_ok;
+}
+
+napi_status napi_set_property(napi_env env, napi_value object, napi_value key, napi_value value) {
+    (void)env;
+    fake_set(object, key->bytes, value);
+    return napi_ok;
+}
+
+napi_status napi_define_properties(napi_env env, napi_value object, size_t property_count,
+                                   const napi_property_descriptor* properties) {
+    (void)env;
+    for (size_t i = 0; i < property_count; i++) {
+        fake_set(object, properties[i].name->bytes, properties[i].value);
+    }
+    return napi_ok;
+}
+
+/** makeObject: records its arguments; the result stands in for the lazy object */
+napi_status napi_call_function(napi_env env, napi_value recv, napi_value func, size_t argc, const napi_value* argv,
+                               napi_value* result) {
+    (void)recv;
+    if (func->kind != FAKE_FUNCTION) {
+        return napi_function_expected;
+    }
+    env->calls++;
+    if (env->call_fails) {
+        return napi_pending_exception;
+    }
+    env->call_argc = argc;
+    for (size_t i = 0; i < argc && i < 4; i++) {
+        env->call_argv[i] = argv[i];
+    }
+    *result = fake_value(FAKE_OBJECT);
+    return napi_ok;
+}
+
+napi_status napi_get_and_clear_last_exception(napi_env env, napi_value* result) {
+    env->exceptions_cleared++;
+    *result = fake_value(FAKE_UNDEFINED);
+    return napi_ok;
+}
+
+napi_status napi_throw_error(napi_env env, const char* code, const char* msg) {
+    (void)code, (void)msg;
+    env->thrown = "Error";
+    return napi_ok;
+}
+
+napi_status napi_throw_type_error(napi_env env, const char* code, const char* msg) {
+    (void)code;
+    env->thrown = msg;
+    return napi_ok;
+}
+
+/* Object keys are built by script and listing fields come from JS; the tests pass ObjectKeys directly */
+
+#define FAKE_UNREACHED(...) \
+    do { \
+        (void)env, __VA_ARGS__; \
+        return napi_generic_failure; \
+    } while (0)
+
+napi_status napi_create_function(napi_env env, const char* utf8name, size_t length, napi_callback cb, void* data,
+                                 napi_value* result) {
+    FAKE_UNREACHED((void)utf8name, (void)length, (void)cb, (void)data, (void)result);
+}
+
+napi_status napi_run_script(napi_env env, napi_value script, napi_value* result) {
+    FAKE_UNREACHED((void)script, (void)result);
+}
+
+napi_status napi_create_reference(napi_env env, napi_value value, uint32_t initial_refcount, napi_ref* result) {
+    FAKE_UNREACHED((void)value, (void)initial_refcount, (void)result);
+}
+
+napi_status napi_get_reference_value(napi_env env, napi_ref ref, napi_value* result) {
+    FAKE_UNREACHED((void)ref, (void)result);
+}
+
+napi_status napi_delete_reference(napi_env env, napi_ref ref) {
+    FAKE_UNREACHED((void)ref);
+}
+
+napi_status napi_get_property_names(napi_env env, napi_value object, napi_value* result) {
+    FAKE_UNREACHED((void)object, (void)result);
+}
+
+napi_status napi_get_property(napi_env env, napi_value object, napi_value key, napi_value* result) {
+    FAKE_UNREACHED((void)object, (void)key, (void)result);
+}
+
+napi_status napi_get_array_length(napi_env env, napi_value value, uint32_t* result) {
+    FAKE_UNREACHED((void)value, (void)result);
+}
+
+napi_status napi_get_element(napi_env env, napi_value object, uint32_t index, napi_value* result) {
+    FAKE_UNREACHED((void)object, (void)index, (void)result);
+}
+
+napi_status napi_set_element(napi_env env, napi_value object, uint32_t index, napi_value value) {
+    FAKE_UNREACHED((void)object, (void)index, (void)value);
+}
+
+napi_status napi_is_array(napi_env env, napi_value value, bool* result) {
+    FAKE_UNREACHED((void)value, (void)result);
+}
+
+napi_status napi_is_buffer(napi_env env, napi_value value, bool* result) {
+    FAKE_UNREACHED((void)value, (void)result);
+}
+
+napi_status napi_get_buffer_info(napi_env env, napi_value value, void** data, size_t* length) {
+    FAKE_UNREACHED((void)value, (void)data, (void)length);
+}
+
+napi_status napi_typeof(napi_env env, napi_value value, napi_valuetype* result) {
+    FAKE_UNREACHED((void)value, (void)result);
+}
+
+napi_status napi_get_value_string_utf8(napi_env env, napi_value value, char* buf, size_t bufsize, size_t* result) {
+    FAKE_UNREACHED((void)value, (void)buf, (void)bufsize, (void)result);
+}
+
+/* ========== helpers ========== */
+
+static UplinkCustomMetadataEntry entry(const char* key, const char* value, size_t value_length) {
+    UplinkCustomMetadataEntry e = { (char*)key, strlen(key), (char*)value, value_length };
+    return e;
+}
+
+static ObjectKeys fake_keys(bool lazy) {
+    static const char* const names[] = { "key", "isPrefix", "system", "created", "expires", "contentLength", "custom" };
+    ObjectKeys keys;
+    napi_value* out = (napi_value*)&keys;
+    for (size_t i = 0; i < OBJECT_KEY_COUNT; i++) {
+        out[i] = fake_string(names[i], strlen(names[i]), false);
+    }
+    keys.make_lazy = lazy ? fake_value(FAKE_FUNCTION) : NULL;
+    return keys;
+}
+
+static napi_value decode(napi_env env, napi_value packed) {
+    struct napi_callback_info__ info = { packed != NULL ? 1 : 0, packed };
+    env->thrown = NULL;
+    return custom_decode(env, &info);
+}
+
+static napi_value property(napi_value object, const char* name) {
+    for (size_t i = 0; object != NULL && i < object->count; i++) {
+        if (strcmp(object->names[i], name) == 0) {
+            return object->values[i];
+        }
+    }
+    return NULL;
+}
+
+/** @p object holds exactly the entries of @p custom, as strings, in order */
+static bool holds_entries(napi_value object, const UplinkCustomMetadata* custom) {
+    if (object == NULL || object->kind != FAKE_OBJECT || object->count != custom->count) {
+        return false;
+    }
+    for (size_t i = 0; i < custom->count; i++) {
+        const UplinkCustomMetadataEntry* e = &custom->entries[i];
+        napi_value value = object->values[i];
+        if (strcmp(object->names[i], e->key) != 0 || value->kind != FAKE_STRING ||
+            value->length != e->value_length || memcmp(value->bytes, e->value, e->value_length) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* ========== tests ========== */
+
+static int test_packed_metadata_round_trips(void) {
+    struct napi_env__ env = { 0 };
+    UplinkCustomMetadataEntry entries[] = {
+        entry("color", "blue", 4),
+        entry("empty", "", 0),
+        entry("caf\xc3\xa9", "na\xc3\xafve \xe2\x98\x83", 11),     /* UTF-8 bytes stay bytes */
+        entry("raw", "a\0\xff", 3),
+    };
+    UplinkCustomMetadata custom = { entries, 4 };
+
+    napi_value packed = custom_pack(&env, &custom);
+    TEST_ASSERT(packed != NULL && packed->kind == FAKE_STRING && packed->latin1, "packed into a one-byte string");
+    napi_value object = decode(&env, packed);
+    TEST_ASSERT_NULL(env.thrown, "decoded without error");
+    TEST_ASSERT(holds_entries(object, &custom), "same entries, same order");
+    arena_reset();
+    return 1;
+}
+
+static int test_packed_layout(void) {
+    struct napi_env__ env = { 0 };
+    UplinkCustomMetadataEntry entries[] = { entry("ab", "xyz", 3), entry("k", "", 0) };
+    UplinkCustomMetadata custom = { entries, 2 };
+    napi_value packed = custom_pack(&env, &custom);
+    TEST_ASSERT_NOT_NULL(packed, "packed");
+    TEST_ASSERT_EQ(packed->length, 4 + 2 * 8 + 6, "header, length table, then text");
+
+    uint32_t words[5];
+    memcpy(words, packed->bytes, sizeof(words));
+    TEST_ASSERT_EQ(words[0], 2, "entry count");
+    TEST_ASSERT(words[1] == 2 && words[2] == 3 && words[3] == 1 && words[4] == 0, "key and value lengths");
+    TEST_ASSERT(memcmp(packed->bytes + 20, "abxyzk", 6) == 0, "keys and values, unterminated, in order");
+
+    UplinkCustomMetadata none = { NULL, 0 };
+    packed = custom_pack(&env, &none);
+    TEST_ASSERT(packed != NULL && packed->length == 4, "no entries: just the count");
+    napi_value object = decode(&env, packed);
+    TEST_ASSERT(object != NULL && object->count == 0, "decodes to an empty object");
+    arena_reset();
+    return 1;
+}
+
+static int test_large_metadata_packs_on_the_heap(void) {
+    struct napi_env__ env = { 0 };
+    size_t length = CUSTOM_PACK_STACK * 4;
+    char* big = (char*)malloc(length);
+    for (size_t i = 0; i < length; i++) {
+        big[i] = (char)(0x80 + i % 0x80);   /* every byte above ASCII */
+    }
+    UplinkCustomMetadataEntry entries[] = { entry("small", "s", 1), entry("big", big, length) };
+    UplinkCustomMetadata custom = { entries, 2 };
+
+    napi_value packed = custom_pack(&env, &custom);
+    TEST_ASSERT(packed != NULL && packed->length > CUSTOM_PACK_STACK, "larger than the stack buffer");
+    TEST_ASSERT(holds_entries(decode(&env, packed), &custom), "round trips");
+    free(big);
+    arena_reset();
+    return 1;
+}
+
+static int test_corrupt_packing_rejected(void) {
+    struct napi_env__ env = { 0 };
+    static const struct {
+        const char* bytes;
+        size_t length;
+        const char* what;
+    } cases[] = {
+        { "", 0, "empty" },
+        { "\1\0\0", 3, "shorter than the count" },
+        { "\1\0\0\0", 4, "count without a length table" },
+        { "\1\0\0\0\2\0\0\0\2\0\0\0abc", 15, "lengths past the text" },
+        { "\xff\xff\xff\x0f", 4, "count past the data" },
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        napi_value packed = fake_string(cases[i].bytes, cases[i].length, true);
+        TEST_ASSERT_NULL(decode(&env, packed), cases[i].what);
+        TEST_ASSERT(env.thrown != NULL && strcmp(env.thrown, "Corrupt lazy metadata") == 0, "with a TypeError");
+    }
+
+    TEST_ASSERT_NULL(decode(&env, NULL), "no argument");
+    TEST_ASSERT_STR_EQ(env.thrown, "Corrupt lazy metadata", "with a TypeError");
+    TEST_ASSERT_NULL(decode(&env, fake_value(FAKE_NUMBER)), "not a string");
+    TEST_ASSERT_STR_EQ(env.thrown, "Corrupt lazy metadata", "with a TypeError");
+    arena_reset();
+    return 1;
+}
+
+static int test_full_objects_get_packed_metadata(void) {
+    struct napi_env__ env = { 0 };
+    UplinkCustomMetadataEntry entries[] = { entry("color", "blue", 4), entry("size", "xl", 2) };
+    UplinkObject object = { (char*)"photos/a.jpg", false, { 1700000000, 0, 42 }, { entries, 2 } };
+    ObjectKeys keys = fake_keys(true);
+
+    napi_value result = uplink_object_to_js_keys(&env, &keys, &object, OBJECT_FIELDS_ALL | OBJECT_CONVERT_LAZY_CUSTOM);
+    TEST_ASSERT_EQ(env.calls, 1, "built by makeObject");
+    TEST_ASSERT_EQ(env.call_argc, 4, "key, isPrefix, system, data");
+    TEST_ASSERT(result != NULL && result->count == 0, "the lazy object is makeObject's result");
+    TEST_ASSERT_STR_EQ(env.call_argv[0]->bytes, "photos/a.jpg", "key passed on");
+    TEST_ASSERT(env.call_argv[1]->kind == FAKE_BOOLEAN && env.call_argv[1]->number == 0, "isPrefix passed on");
+    napi_value system = env.call_argv[2];
+    TEST_ASSERT(property(system, "created")->number == 1700000000 && property(system, "expires")->kind == FAKE_NULL &&
+                property(system, "contentLength")->number == 42, "system passed on");
+    TEST_ASSERT(env.call_argv[3]->latin1, "metadata passed packed");
+    TEST_ASSERT(holds_entries(decode(&env, env.call_argv[3]), &object.custom), "and decodes to the entries");
+    arena_reset();
+    return 1;
+}
+
+static int test_eager_fallbacks(void) {
+    UplinkCustomMetadataEntry entries[] = { entry("color", "blue", 4) };
+    UplinkObject object = { (char*)"a", true, { 1, 2, 3 }, { entries, 1 } };
+    const uint32_t lazy = OBJECT_FIELDS_ALL | OBJECT_CONVERT_LAZY_CUSTOM;
+
+    /* Not asked for */
+    struct napi_env__ env = { 0 };
+    ObjectKeys keys = fake_keys(true);
+    napi_value result = uplink_object_to_js_keys(&env, &keys, &object, OBJECT_FIELDS_ALL);
+    TEST_ASSERT(env.calls == 0 && holds_entries(property(result, "custom"), &object.custom), "eager by default");
+
+    /* A projection */
+    result = uplink_object_to_js_keys(&env, &keys, &object, (lazy & ~OBJECT_FIELD_EXPIRES));
+    TEST_ASSERT(env.calls == 0 && holds_entries(property(result, "custom"), &object.custom), "projections are eager");
+
+    /* No metadata */
+    UplinkObject bare = object;
+    bare.custom.count = 0;
+    result = uplink_object_to_js_keys(&env, &keys, &bare, lazy);
+    napi_value custom = property(result, "custom");
+    TEST_ASSERT(env.calls == 0 && custom != NULL && custom->count == 0, "empty metadata is an eager {}");
+
+    /* The factory could not be built */
+    ObjectKeys eager_keys = fake_keys(false);
+    result = uplink_object_to_js_keys(&env, &eager_keys, &object, lazy);
+    TEST_ASSERT(env.calls == 0 && holds_entries(property(result, "custom"), &object.custom), "no factory: eager");
+
+    /* makeObject threw */
+    env.call_fails = true;
+    result = uplink_object_to_js_keys(&env, &keys, &object, lazy);
+    TEST_ASSERT_EQ(env.calls, 1, "makeObject tried");
+    TEST_ASSERT_EQ(env.exceptions_cleared, 1, "its exception cleared");
+    TEST_ASSERT(holds_entries(property(result, "custom"), &object.custom), "converted eagerly instead");
+    TEST_ASSERT(property(result, "key") != NULL && property(result, "system") != NULL, "with the other fields");
+    arena_reset();
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Lazy Metadata Tests");
+
+    RUN_TEST(test_packed_metadata_round_trips);
+    RUN_TEST(test_packed_layout);
+    RUN_TEST(test_large_metadata_packs_on_the_heap);
+    RUN_TEST(test_corrupt_packing_rejected);
+    RUN_TEST(test_full_objects_get_packed_metadata);
+    RUN_TEST(test_eager_fallbacks);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file native/test/test_native_alloc.c
+ * @brief Unit tests for native_alloc.c: the allocation, free, live and
+ *        peak byte counters behind nativeStats
+ *
+ * Counters are process-wide and the test binary allocates too, so every
+ * check compares snapshots around the calls under test.
+ */
+
+#include "test_framework.h"
+#include "../src/common/native_alloc.c"
+
+#include <pthread.h>
+
+static NativeAllocStats stats_now(void) {
+    NativeAllocStats stats;
+    native_alloc_stats(&stats);
+    return stats;
+}
+
+static int test_malloc_and_free_are_counted(void) {
+    NativeAllocStats before = stats_now();
+    void* block = native_malloc(100);
+    TEST_ASSERT_NOT_NULL(block, "allocated");
+    int64_t size = (int64_t)block_size(block);
+    TEST_ASSERT(size >= 100, "usable size covers the request");
+
+    NativeAllocStats during = stats_now();
+    TEST_ASSERT_EQ(during.allocations - before.allocations, 1, "one allocation");
+    TEST_ASSERT(during.live_bytes - before.live_bytes == size, "live bytes grow by the usable size");
+
+    native_free(block);
+    NativeAllocStats after = stats_now();
+    TEST_ASSERT_EQ(after.frees - before.frees, 1, "one free");
+    TEST_ASSERT(after.live_bytes == before.live_bytes, "live bytes back where they were");
+
+    native_free(NULL);
+    TEST_ASSERT_EQ(stats_now().frees, after.frees, "free(NULL) is not counted");
+    return 1;
+}
+
+static int test_calloc_and_strdup_are_counted(void) {
+    NativeAllocStats before = stats_now();
+    uint8_t* zeroed = (uint8_t*)native_calloc(16, 8);
+    char* copy = native_strdup("bucket-name");
+    TEST_ASSERT(zeroed != NULL && copy != NULL, "allocated");
+    TEST_ASSERT(zeroed[0] == 0 && zeroed[127] == 0, "calloc zeroes");
+    TEST_ASSERT_STR_EQ(copy, "bucket-name", "strdup copies");
+
+    NativeAllocStats during = stats_now();
+    TEST_ASSERT_EQ(during.allocations - before.allocations, 2, "both counted");
+    TEST_ASSERT(during.live_bytes - before.live_bytes == (int64_t)(block_size(zeroed) + block_size(copy)),
+                "both sized");
+
+    native_free(zeroed);
+    native_free(copy);
+    TEST_ASSERT(stats_now().live_bytes == before.live_bytes, "both released");
+    return 1;
+}
+
+static int test_realloc_moves_the_accounting(void) {
+    NativeAllocStats before = stats_now();
+    void* block = native_realloc(NULL, 64);
+    NativeAllocStats grown = stats_now();
+    TEST_ASSERT_EQ(grown.allocations - before.allocations, 1, "realloc(NULL) allocates");
+    TEST_ASSERT_EQ(grown.frees - before.frees, 0, "and frees nothing");
+
+    block = native_realloc(block, 64 * 1024);
+    NativeAllocStats after = stats_now();
+    TEST_ASSERT_EQ(after.allocations - before.allocations, 2, "a resize counts as an allocation");
+    TEST_ASSERT_EQ(after.frees - before.frees, 1, "and a free of the old block");
+    TEST_ASSERT(after.live_bytes - before.live_bytes == (int64_t)block_size(block), "only the new size is live");
+
+    /* realloc(ptr, 0) frees, or returns a minimal block, depending on the C library */
+    void* rest = native_realloc(block, 0);
+    native_free(rest);
+    after = stats_now();
+    TEST_ASSERT(after.live_bytes == before.live_bytes, "nothing left live");
+    TEST_ASSERT(after.allocations - before.allocations == after.frees - before.frees, "every allocation freed");
+    return 1;
+}
+
+static int test_peak_keeps_the_high_mark(void) {
+    NativeAllocStats before = stats_now();
+    void* big = native_malloc(4 * 1024 * 1024);
+    int64_t size = (int64_t)block_size(big);
+    native_free(big);
+    NativeAllocStats after = stats_now();
+    TEST_ASSERT(after.peak_bytes >= before.live_bytes + size, "peak saw the large block");
+    TEST_ASSERT(after.peak_bytes >= before.peak_bytes, "peak never drops");
+    TEST_ASSERT(after.live_bytes < after.peak_bytes, "live bytes fell back below it");
+    return 1;
+}
+
+#define WORKER_ROUNDS 20000
+
+static void* alloc_worker(void* arg) {
+    (void)arg;
+    for (int i = 0; i < WORKER_ROUNDS; i++) {
+        char* a = (char*)native_malloc((size_t)(i % 200) + 1);
+        char* b = native_strdup("key");
+        a = (char*)native_realloc(a, (size_t)(i % 300) + 1);
+        native_free(b);
+        native_free(a);
+    }
+    return NULL;
+}
+
+static int test_counters_under_threads(void) {
+    enum { THREADS = 4 };
+    NativeAllocStats before = stats_now();
+    pthread_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        TEST_ASSERT_EQ(pthread_create(&threads[i], NULL, alloc_worker, NULL), 0, "thread started");
+    }
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    NativeAllocStats after = stats_now();
+    uint64_t allocations = after.allocations - before.allocations;
+    TEST_ASSERT(allocations == (uint64_t)THREADS * WORKER_ROUNDS * 3, "no allocation lost");
+    TEST_ASSERT(after.frees - before.frees == allocations, "no free lost");
+    TEST_ASSERT(after.live_bytes == before.live_bytes, "live bytes balance");
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Native Alloc Tests");
+
+    RUN_TEST(test_malloc_and_free_are_counted);
+    RUN_TEST(test_calloc_and_strdup_are_counted);
+    RUN_TEST(test_realloc_moves_the_accounting);
+    RUN_TEST(test_peak_keeps_the_high_mark);
+    RUN_TEST(test_counters_under_threads);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file native/test/test_part_tuner.c
+ * @brief Unit tests for part_tuner.c: starting point, the hill climb on
+ *        parts in flight, part size from latency, and slot accounting
+ */
+
+#include "test_runtime.h"
+#include "../src/common/part_tuner.c"
+
+#define MIB (1024ULL * 1024)
+#define SEC 1000000000ULL
+
+/** Close a window of @p parts parts that moved @p mib_per_second with the given mean part latency */
+static void close_window(PartTuner* tuner, uint64_t mib_per_second, uint64_t mean_latency_ns, uint32_t parts) {
+    uint64_t now = tuner->window_start + SEC;
+    tuner->window_bytes = mib_per_second * MIB;
+    tuner->window_busy_ns = mean_latency_ns * parts;
+    tuner->window_parts = parts;
+    part_tuner_adjust(tuner, now);
+}
+
+static int test_start_size_and_limit(void) {
+    const uint64_t starts[] = { 0, 8 * MIB, 12 * MIB, 16 * MIB, 100 * MIB, 256 * MIB, 4096 * MIB };
+    const uint64_t sizes[] = { 8 * MIB, 8 * MIB, 8 * MIB, 16 * MIB, 64 * MIB, 256 * MIB, 256 * MIB };
+    PartTuner tuner;
+    for (size_t i = 0; i < sizeof(starts) / sizeof(starts[0]); i++) {
+        TEST_ASSERT_EQ(part_tuner_init(&tuner, starts[i], 16), 0, "init");
+        TEST_ASSERT(tuner.part_size == sizes[i], "start size rounds down to a power of two in bounds");
+        part_tuner_destroy(&tuner);
+    }
+
+    part_tuner_init(&tuner, 0, 16);
+    TEST_ASSERT_EQ(tuner.limit, 2, "starts with two parts in flight");
+    part_tuner_destroy(&tuner);
+    part_tuner_init(&tuner, 0, 1);
+    TEST_ASSERT_EQ(tuner.limit, 1, "start limit respects the maximum");
+    part_tuner_destroy(&tuner);
+    part_tuner_init(&tuner, 0, 0);
+    TEST_ASSERT(tuner.max_limit == 1 && tuner.limit == 1, "a zero maximum means one part");
+    part_tuner_destroy(&tuner);
+    return 1;
+}
+
+static int test_limit_climbs_while_goodput_improves(void) {
+    PartTuner tuner;
+    part_tuner_init(&tuner, 64 * MIB, 16);
+    /* Latency in the dead band keeps the part size out of it */
+    close_window(&tuner, 100, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 3, "first window steps up");
+    close_window(&tuner, 150, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 4, "better goodput keeps climbing");
+    close_window(&tuner, 146, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 5, "a drop within the noise keeps climbing");
+    TEST_ASSERT(tuner.part_size == 64 * MIB, "part size unchanged in the dead band");
+    part_tuner_destroy(&tuner);
+    return 1;
+}
+
+static int test_limit_reverses_on_a_drop(void) {
+    PartTuner tuner;
+    part_tuner_init(&tuner, 64 * MIB, 16);
+    close_window(&tuner, 100, 10 * SEC, tuner.limit);
+    close_window(&tuner, 150, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 4, "climbed");
+    close_window(&tuner, 120, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 3, "a real drop steps back");
+    close_window(&tuner, 140, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 2, "improving after the reversal keeps going down");
+    close_window(&tuner, 100, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 3, "a drop turns it around again");
+    part_tuner_destroy(&tuner);
+    return 1;
+}
+
+static int test_limit_bounces_off_its_bounds(void) {
+    PartTuner tuner;
+    part_tuner_init(&tuner, 64 * MIB, 3);
+    close_window(&tuner, 100, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 3, "reached the maximum");
+    close_window(&tuner, 200, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 3, "never past the maximum");
+    close_window(&tuner, 300, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 2, "then steps back down");
+    close_window(&tuner, 400, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 1, "down to one");
+    close_window(&tuner, 500, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 1, "never below one");
+    close_window(&tuner, 600, 10 * SEC, tuner.limit);
+    TEST_ASSERT_EQ(tuner.limit, 2, "and climbs again");
+    part_tuner_destroy(&tuner);
+    return 1;
+}
+
+static int test_part_size_follows_latency(void) {
+    PartTuner tuner;
+    part_tuner_init(&tuner, 32 * MIB, 16);
+    close_window(&tuner, 100, SEC, tuner.limit);
+    TEST_ASSERT(tuner.part_size == 64 * MIB, "fast parts double");
+    for (int i = 0; i < 5; i++) close_window(&tuner, 100, SEC, tuner.limit);
+    TEST_ASSERT(tuner.part_size == PART_TUNER_MAX_SIZE, "doubling stops at the maximum");
+
+    close_window(&tuner, 100, 40 * SEC, tuner.limit);
+    TEST_ASSERT(tuner.part_size == 128 * MIB, "slow parts halve");
+    for (int i = 0; i < 6; i++) close_window(&tuner, 100, 40 * SEC, tuner.limit);
+    TEST_ASSERT(tuner.part_size == PART_TUNER_MIN_SIZE, "halving stops at the minimum");
+
+    close_window(&tuner, 100, PART_TUNER_FAST_NS, tuner.limit);
+    close_window(&tuner, 100, PART_TUNER_SLOW_NS, tuner.limit);
+    TEST_ASSERT(tuner.part_size == PART_TUNER_MIN_SIZE, "the thresholds themselves change nothing");
+    part_tuner_destroy(&tuner);
+    return 1;
+}
+
+static int test_windows_close_on_finished_parts(void) {
+    PartTuner tuner;
+    part_tuner_init(&tuner, 64 * MIB, 16);
+    TEST_ASSERT(part_tuner_acquire(&tuner) == 64 * MIB, "slot carries the part size");
+    TEST_ASSERT(part_tuner_acquire(&tuner) == 64 * MIB, "second slot");
+    TEST_ASSERT_EQ(tuner.in_flight, 2, "two in flight");
+
+    part_tuner_finish(&tuner, 0, SEC);
+    TEST_ASSERT_EQ(tuner.window_parts, 0, "a failed or unclaimed part is not counted");
+    TEST_ASSERT_EQ(tuner.in_flight, 1, "but its slot is returned");
+    part_tuner_acquire(&tuner);
+    part_tuner_finish(&tuner, 64 * MIB, SEC);
+    TEST_ASSERT_EQ(tuner.window_parts, 1, "one part in the window");
+    part_tuner_finish(&tuner, 64 * MIB, SEC);
+    TEST_ASSERT_EQ(tuner.window_parts, 0, "the window closed after limit parts");
+    TEST_ASSERT(tuner.goodput > 0, "goodput measured");
+    TEST_ASSERT_EQ(tuner.limit, 3, "limit stepped");
+    TEST_ASSERT(tuner.part_size == 128 * MIB, "fast parts doubled the size");
+
+    uint64_t part_size;
+    uint32_t concurrency;
+    double goodput;
+    part_tuner_result(&tuner, &part_size, &concurrency, &goodput);
+    TEST_ASSERT(part_size == 128 * MIB && concurrency == 3 && goodput == tuner.goodput, "result reports the settings");
+    part_tuner_destroy(&tuner);
+    return 1;
+}
+
+typedef struct {
+    PartTuner* tuner;
+    int acquired;
+} Waiter;
+
+static void acquire_later(void* arg) {
+    Waiter* waiter = (Waiter*)arg;
+    part_tuner_acquire(waiter->tuner);
+    __atomic_store_n(&waiter->acquired, 1, __ATOMIC_RELEASE);
+}
+
+static int test_acquire_waits_for_a_slot(void) {
+    PartTuner tuner;
+    part_tuner_init(&tuner, 0, 16);
+    part_tuner_acquire(&tuner);
+    part_tuner_acquire(&tuner);
+
+    Waiter waiter = { &tuner, 0 };
+    uv_thread_t thread;
+    TEST_ASSERT_EQ(uv_thread_create(&thread, acquire_later, &waiter), 0, "start waiter");
+    uv_sleep(50);
+    TEST_ASSERT_EQ(__atomic_load_n(&waiter.acquired, __ATOMIC_ACQUIRE), 0, "a third part waits at the limit");
+    part_tuner_finish(&tuner, 0, 0);
+    uv_thread_join(&thread);
+    TEST_ASSERT_EQ(waiter.acquired, 1, "a returned slot lets it in");
+    TEST_ASSERT_EQ(tuner.in_flight, 2, "still at the limit");
+    part_tuner_destroy(&tuner);
+    return 1;
+}
+
+static int test_null_tuner(void) {
+    TEST_ASSERT(part_tuner_acquire(NULL) == 0, "no tuner, no part size");
+    part_tuner_finish(NULL, 1, 1);
+    uint64_t part_size = 7;
+    uint32_t concurrency = 7;
+    double goodput = 7;
+    part_tuner_result(NULL, &part_size, &concurrency, &goodput);
+    TEST_ASSERT(part_size == 7 && concurrency == 7 && goodput == 7, "result leaves outputs alone");
+    part_tuner_destroy(NULL);
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Part Tuner Tests");
+
+    RUN_TEST(test_start_size_and_limit);
+    RUN_TEST(test_limit_climbs_while_goodput_improves);
+    RUN_TEST(test_limit_reverses_on_a_drop);
+    RUN_TEST(test_limit_bounces_off_its_bounds);
+    RUN_TEST(test_part_size_follows_latency);
+    RUN_TEST(test_windows_close_on_finished_parts);
+    RUN_TEST(test_acquire_waits_for_a_slot);
+    RUN_TEST(test_null_tuner);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+/**
+ * @file native/test/test_readahead.c
+ * @brief Unit tests for download_readahead.c: classification, seek
+ *        counting, window growth, counters, and history kept per env
+ */
+
+#include "test_runtime.h"
+#include "../src/download/download_readahead.c"
+
+#define KIB 1024u
+
+/* Stand-ins for two envs' AddonInstance pointers */
+static int env_a;
+static int env_b;
+
+static ReadAheadStats stats_now(void) {
+    ReadAheadStats stats;
+    memset(&stats, 0, sizeof(stats));
+    read_ahead_stats(&stats);
+    return stats;
+}
+
+/** Open bucket/key at @p offset, read @p length bytes and free the stage */
+static ReadAheadMode read_at(const void* owner, const char* key, uint64_t offset, uint64_t length) {
+    ReadAheadStage* stage = read_ahead_open(owner, 1, "bucket", key, offset);
+    if (stage == NULL) {
+        return (ReadAheadMode)-1;
+    }
+    ReadAheadMode mode = stage->mode;
+    stage->offset += length;
+    read_ahead_stage_free(stage);
+    return mode;
+}
+
+static int test_policies_classify(void) {
+    ReadAheadHistory history = { 0, 5, 0 };
+    TEST_ASSERT(adaptive_classify(&history) == READ_AHEAD_SEQUENTIAL, "no seeks reads ahead");
+    history.seeks = READ_AHEAD_RANDOM_AFTER_SEEKS - 1;
+    TEST_ASSERT(adaptive_classify(&history) == READ_AHEAD_SEQUENTIAL, "one seek short still reads ahead");
+    history.seeks = READ_AHEAD_RANDOM_AFTER_SEEKS;
+    TEST_ASSERT(adaptive_classify(&history) == READ_AHEAD_RANDOM, "enough seeks read randomly");
+    history.seeks = 1000;
+    TEST_ASSERT(sequential_classify(&history) == READ_AHEAD_SEQUENTIAL, "the sequential policy never stops");
+    return 1;
+}
+
+static int test_window_doubles_to_the_cap(void) {
+    size_t window = READ_AHEAD_DEFAULT_INITIAL_WINDOW;
+    size_t expected = READ_AHEAD_DEFAULT_INITIAL_WINDOW;
+    for (int i = 0; i < 10; i++) {
+        window = double_window(window, READ_AHEAD_DEFAULT_MAX_WINDOW);
+        expected = expected * 2 < READ_AHEAD_DEFAULT_MAX_WINDOW ? expected * 2 : READ_AHEAD_DEFAULT_MAX_WINDOW;
+        TEST_ASSERT(window == expected, "doubles until the ceiling");
+    }
+    TEST_ASSERT(window == READ_AHEAD_DEFAULT_MAX_WINDOW, "stops at the ceiling");
+
+    /* A ceiling that is not a power of two is reached exactly, never passed */
+    TEST_ASSERT(double_window(128 * KIB, 300 * KIB) == 256 * KIB, "doubles below the ceiling");
+    TEST_ASSERT(double_window(256 * KIB, 300 * KIB) == 300 * KIB, "clamped to the ceiling");
+    TEST_ASSERT(double_window(300 * KIB, 300 * KIB) == 300 * KIB, "stays at the ceiling");
+    TEST_ASSERT(double_window(64 * KIB, 64 * KIB) == 64 * KIB, "equal bounds never grow");
+    return 1;
+}
+
+static int test_stage_takes_the_configured_windows(void) {
+    TEST_ASSERT_EQ(read_ahead_enable("adaptive", 64 * KIB, 1024 * KIB), 0, "enable");
+    ReadAheadStage* stage = read_ahead_open(&env_a, 1, "bucket", "key", 0);
+    TEST_ASSERT_NOT_NULL(stage, "stage");
+    TEST_ASSERT(stage->window == 64 * KIB && stage->max_window == 1024 * KIB, "windows from enable");
+
+    /* The growth the read path applies each time a window drains */
+    int growths = 0;
+    for (size_t next; (next = stage->policy->next_window(stage->window, stage->max_window)) > stage->window;) {
+        stage->window = next;
+        growths++;
+    }
+    TEST_ASSERT_EQ(growths, 4, "64 KiB to 1 MiB in four doublings");
+    TEST_ASSERT(stage->window == 1024 * KIB, "capped at maxWindow");
+    read_ahead_stage_free(stage);
+
+    TEST_ASSERT_EQ(read_ahead_enable("nonsense", 64 * KIB, 1024 * KIB), -1, "unknown policy");
+    TEST_ASSERT(strcmp(stats_now().policy, "adaptive") == 0, "an unknown policy leaves the old one");
+    return 1;
+}
+
+static int test_opens_are_classified_against_history(void) {
+    read_ahead_enable("adaptive", 128 * KIB, 8192 * KIB);
+    TEST_ASSERT(read_at(&env_a, "movie", 4096 * KIB, 1024 * KIB) == READ_AHEAD_SEQUENTIAL, "first open anywhere");
+    TEST_ASSERT(read_at(&env_a, "movie", 5120 * KIB, 1024 * KIB) == READ_AHEAD_SEQUENTIAL, "where the last read stopped");
+    TEST_ASSERT(read_at(&env_a, "movie", 6144 * KIB + 128 * KIB, KIB) == READ_AHEAD_SEQUENTIAL,
+                "a skip of up to one initial window continues the pass");
+    TEST_ASSERT_EQ(stats_now().seeks, 0, "no seeks yet");
+
+    read_at(&env_a, "movie", 0, KIB);
+    TEST_ASSERT_EQ(stats_now().seeks, 1, "going back is a seek");
+    read_at(&env_a, "movie", 1 * KIB + 128 * KIB + 1, KIB);
+    TEST_ASSERT_EQ(stats_now().seeks, 2, "skipping past the window is a seek");
+
+    ReadAheadStats stats = stats_now();
+    TEST_ASSERT_EQ(stats.objects, 1, "one history");
+    TEST_ASSERT_EQ(stats.sequential_opens + stats.random_opens, 5, "every open counted");
+    return 1;
+}
+
+static int test_seeks_switch_to_random_and_back(void) {
+    read_ahead_enable("adaptive", 128 * KIB, 8192 * KIB);
+    TEST_ASSERT(read_at(&env_a, "index", 0, KIB) == READ_AHEAD_SEQUENTIAL, "first open");
+    TEST_ASSERT(read_at(&env_a, "index", 900 * KIB, KIB) == READ_AHEAD_SEQUENTIAL, "one seek keeps the window");
+    TEST_ASSERT(read_at(&env_a, "index", 300 * KIB, KIB) == READ_AHEAD_RANDOM, "the second seek in a row is random");
+    TEST_ASSERT(read_at(&env_a, "index", 2000 * KIB, KIB) == READ_AHEAD_RANDOM, "and stays random while seeking");
+    TEST_ASSERT(read_at(&env_a, "index", 2001 * KIB, KIB) == READ_AHEAD_SEQUENTIAL, "continuing resets the count");
+    TEST_ASSERT(read_at(&env_a, "index", 0, KIB) == READ_AHEAD_SEQUENTIAL, "a single seek after that is forgiven");
+
+    ReadAheadStats stats = stats_now();
+    TEST_ASSERT_EQ(stats.seeks, 4, "seeks counted");
+    TEST_ASSERT_EQ(stats.random_opens, 2, "random opens counted");
+    TEST_ASSERT_EQ(stats.sequential_opens, 4, "sequential opens counted");
+
+    read_ahead_enable("sequential", 128 * KIB, 8192 * KIB);
+    for (uint64_t offset = 8192; offset > 0; offset -= 1024) {
+        TEST_ASSERT(read_at(&env_a, "index", offset * KIB, KIB) == READ_AHEAD_SEQUENTIAL, "sequential never gives up");
+    }
+    TEST_ASSERT_EQ(stats_now().seeks, 7, "but still counts the seeks");
+    return 1;
+}
+
+static int test_counters_fold_in_on_note(void) {
+    read_ahead_enable("adaptive", 128 * KIB, 8192 * KIB);
+    ReadAheadStage* stage = read_ahead_open(&env_a, 1, "bucket", "key", 0);
+    stage->served = 3;
+    stage->prefetched = 256 * KIB;
+    stage->growths = 1;
+    stage->offset = 256 * KIB;
+    read_ahead_note(stage);
+    ReadAheadStats stats = stats_now();
+    TEST_ASSERT(stats.reads_served == 3 && stats.bytes_prefetched == 256 * KIB && stats.window_growths == 1,
+                "counters folded in");
+    TEST_ASSERT(stage->served == 0 && stage->prefetched == 0 && stage->growths == 0, "and cleared on the stage");
+    TEST_ASSERT(stage->object->history.next_offset == 256 * KIB, "history moved to where reads stopped");
+
+    stage->served = 2;
+    read_ahead_stage_free(stage);
+    TEST_ASSERT_EQ(stats_now().reads_served, 5, "freeing folds in the rest");
+    return 1;
+}
+
+static int test_disable_detaches_histories_in_use(void) {
+    read_ahead_enable("adaptive", 128 * KIB, 8192 * KIB);
+    ReadAheadStage* stage = read_ahead_open(&env_a, 1, "bucket", "open", 0);
+    read_at(&env_a, "idle", 0, KIB);
+
+    read_ahead_disable();
+    ReadAheadStats stats;
+    TEST_ASSERT_EQ(read_ahead_stats(&stats), -1, "no stats while disabled");
+    TEST_ASSERT(read_ahead_open(&env_a, 1, "bucket", "open", 0) == NULL, "no stages while disabled");
+    TEST_ASSERT(stage->object->detached, "the history in use is detached, not freed");
+
+    read_ahead_enable("adaptive", 128 * KIB, 8192 * KIB);
+    stage->served = 9;
+    read_ahead_note(stage);
+    TEST_ASSERT_EQ(stats_now().reads_served, 0, "an old stage does not count towards new totals");
+    read_ahead_stage_free(stage);
+    TEST_ASSERT_EQ(stats_now().objects, 0, "histories were dropped");
+    return 1;
+}
+
+static int test_histories_are_kept_per_env(void) {
+    read_ahead_enable("adaptive", 128 * KIB, 8192 * KIB);
+    /* Same project token, bucket and key in two envs */
+    read_at(&env_a, "shared", 0, KIB);
+    read_at(&env_a, "shared", 5000 * KIB, KIB);
+    TEST_ASSERT(read_at(&env_b, "shared", 3000 * KIB, KIB) == READ_AHEAD_SEQUENTIAL, "another env starts afresh");
+    TEST_ASSERT(read_at(&env_a, "shared", 100 * KIB, KIB) == READ_AHEAD_RANDOM, "its own seeks are kept");
+
+    ReadAheadStage* stage = read_ahead_open(&env_a, 2, "bucket", "shared", 0);
+    TEST_ASSERT(stage->object->history.opens == 1 && stage->mode == READ_AHEAD_SEQUENTIAL,
+                "and so are other projects");
+    read_ahead_stage_free(stage);
+    TEST_ASSERT_EQ(stats_now().objects, 3, "three histories");
+    return 1;
+}
+
+static int test_eviction_keeps_histories_in_use(void) {
+    read_ahead_enable("adaptive", 128 * KIB, 8192 * KIB);
+    ReadAheadStage* held = read_ahead_open(&env_a, 1, "bucket", "held", 0);
+    char key[32];
+    for (int i = 0; i < 2 * READ_AHEAD_MAX_OBJECTS; i++) {
+        snprintf(key, sizeof(key), "key-%d", i);
+        read_at(&env_a, key, 0, KIB);
+    }
+    TEST_ASSERT_EQ(stats_now().objects, READ_AHEAD_MAX_OBJECTS, "history capped");
+    int found = 0;
+    for (ReadAheadObject* object = objects; object != NULL; object = object->next) {
+        found += object == held->object;
+    }
+    TEST_ASSERT_EQ(found, 1, "the history in use was not evicted");
+    TEST_ASSERT(strcmp(objects->name + objects->bucket_length + 1, key) == 0, "most recently opened first");
+    read_ahead_stage_free(held);
+    return 1;
+}
+
+typedef struct {
+    const void* owner;
+    int opens;
+} Opener;
+
+static void open_many(void* arg) {
+    Opener* opener = (Opener*)arg;
+    char key[32];
+    for (int i = 0; i < 2000; i++) {
+        snprintf(key, sizeof(key), "key-%d", i % (READ_AHEAD_MAX_OBJECTS + 50));
+        ReadAheadStage* stage = read_ahead_open(opener->owner, 1, "bucket", key, (uint64_t)(i % 7) * 1024 * KIB);
+        if (stage != NULL) {
+            opener->opens++;
+            stage->served = 1;
+            stage->offset += KIB;
+            read_ahead_note(stage);
+            read_ahead_stage_free(stage);
+        }
+    }
+}
+
+static int test_envs_share_the_totals_safely(void) {
+    read_ahead_enable("adaptive", 128 * KIB, 8192 * KIB);
+    Opener openers[2] = { { &env_a, 0 }, { &env_b, 0 } };
+    uv_thread_t threads[2];
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQ(uv_thread_create(&threads[i], open_many, &openers[i]), 0, "start env thread");
+    }
+    for (int i = 0; i < 2; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    ReadAheadStats stats = stats_now();
+    TEST_ASSERT_EQ(openers[0].opens + openers[1].opens, 4000, "every open got a stage");
+    TEST_ASSERT_EQ(stats.sequential_opens + stats.random_opens, 4000, "every open counted");
+    TEST_ASSERT_EQ(stats.reads_served, 4000, "every read folded in");
+    TEST_ASSERT_EQ(stats.objects, READ_AHEAD_MAX_OBJECTS, "history capped across envs");
+    read_ahead_disable();
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Read-Ahead Tests");
+
+    RUN_TEST(test_policies_classify);
+    RUN_TEST(test_window_doubles_to_the_cap);
+    RUN_TEST(test_stage_takes_the_configured_windows);
+    RUN_TEST(test_opens_are_classified_against_history);
+    RUN_TEST(test_seeks_switch_to_random_and_back);
+    RUN_TEST(test_counters_fold_in_on_note);
+    RUN_TEST(test_disable_detaches_histories_in_use);
+    RUN_TEST(test_histories_are_kept_per_env);
+    RUN_TEST(test_eviction_keeps_histories_in_use);
+    RUN_TEST(test_envs_share_the_totals_safely);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file native/test/test_retry.c
+ * @brief Unit tests for retry.c: backoff bounds, jitter, and when another
+ *        attempt is made
+ */
+
+#include "test_runtime.h"
+#include "../src/common/retry.c"
+
+static RetryPolicy policy_of(uint32_t attempts, uint32_t base_ms, uint32_t max_ms) {
+    RetryPolicy policy;
+    memset(&policy, 0, sizeof(policy));
+    policy.max_attempts = attempts;
+    policy.base_delay_ms = base_ms;
+    policy.max_delay_ms = max_ms;
+    policy_add_code(&policy, UPLINK_ERROR_INTERNAL);
+    policy_add_code(&policy, UPLINK_ERROR_TOO_MANY_REQUESTS);
+    return policy;
+}
+
+static int test_backoff_cap_doubles_to_the_max(void) {
+    RetryPolicy policy = policy_of(RETRY_MAX_ATTEMPTS, RETRY_DEFAULT_BASE_DELAY_MS, RETRY_DEFAULT_MAX_DELAY_MS);
+    const uint64_t expected[] = { 100, 200, 400, 800, 1600, 2000, 2000 };
+    for (uint32_t attempt = 1; attempt <= 7; attempt++) {
+        TEST_ASSERT(backoff_cap(&policy, attempt) == expected[attempt - 1], "cap doubles per attempt up to the max");
+    }
+
+    /* Far past the shift limit the cap neither overflows nor wraps */
+    policy.max_delay_ms = UINT32_MAX;
+    TEST_ASSERT(backoff_cap(&policy, 21) == 100ull << 20, "shift stops at 20");
+    TEST_ASSERT(backoff_cap(&policy, UINT32_MAX) == 100ull << 20, "huge attempt numbers stay bounded");
+
+    policy.base_delay_ms = 0;
+    TEST_ASSERT(backoff_cap(&policy, 5) == 0, "zero base means no wait");
+    return 1;
+}
+
+static int test_jitter_stays_in_bounds(void) {
+    TEST_ASSERT(jitter(0) == 0, "zero bound");
+    int seen[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 10000; i++) {
+        uint64_t value = jitter(3);
+        TEST_ASSERT(value <= 3, "value within [0, bound]");
+        seen[value]++;
+    }
+    /* Full jitter: every value up to the cap, ends included, comes up */
+    for (int v = 0; v < 4; v++) {
+        TEST_ASSERT(seen[v] > 2000, "values spread over the whole range");
+    }
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT(jitter(2000) <= 2000, "value within the default cap");
+    }
+    return 1;
+}
+
+static int test_retryable_codes(void) {
+    RetryPolicy policy;
+    memset(&policy, 0, sizeof(policy));
+    const int32_t codes[] = { 0, 63, 64, 255 };
+    for (size_t i = 0; i < sizeof(codes) / sizeof(codes[0]); i++) {
+        policy_add_code(&policy, codes[i]);
+        TEST_ASSERT(policy_has_code(&policy, codes[i]), "added code is retryable");
+    }
+    TEST_ASSERT(!policy_has_code(&policy, 1), "other codes are not");
+    TEST_ASSERT(!policy_has_code(&policy, 65), "other words are untouched");
+    policy_add_code(&policy, 256);
+    policy_add_code(&policy, -1);
+    TEST_ASSERT(!policy_has_code(&policy, 256) && !policy_has_code(&policy, -1), "out of range codes are ignored");
+    return 1;
+}
+
+static int test_retry_decisions(void) {
+    /* A zero base keeps the backoff from sleeping */
+    RetryPolicy policy = policy_of(3, 0, 0);
+    TEST_ASSERT(retry_backoff(&policy, 1, UPLINK_ERROR_INTERNAL, NULL, "test"), "first failure retries");
+    TEST_ASSERT(retry_backoff(&policy, 2, UPLINK_ERROR_TOO_MANY_REQUESTS, NULL, "test"), "second failure retries");
+    TEST_ASSERT(!retry_backoff(&policy, 3, UPLINK_ERROR_INTERNAL, NULL, "test"), "attempts exhausted");
+    TEST_ASSERT(!retry_backoff(&policy, 1, UPLINK_ERROR_OBJECT_NOT_FOUND, NULL, "test"), "permanent error");
+    TEST_ASSERT(!retry_backoff(&policy, 1, UPLINK_ERROR_CANCELED, NULL, "test"), "cancellation is not retried");
+
+    CancelToken cancelled = { true };
+    TEST_ASSERT(!retry_backoff(&policy, 1, UPLINK_ERROR_INTERNAL, &cancelled, "test"), "cancelled call");
+
+    RetryPolicy none;
+    memset(&none, 0, sizeof(none));
+    TEST_ASSERT(!retry_backoff(&none, 1, UPLINK_ERROR_INTERNAL, NULL, "test"), "zeroed policy never retries");
+    policy.max_attempts = 1;
+    TEST_ASSERT(!retry_backoff(&policy, 1, UPLINK_ERROR_INTERNAL, NULL, "test"), "one attempt never retries");
+    return 1;
+}
+
+/** Seed the jitter so the next backoff waits at least @p at_least_ms of @p cap_ms */
+static void seed_long_wait(uint64_t cap_ms, uint64_t at_least_ms) {
+    for (uint64_t seed = 1;; seed++) {
+        jitter_state = seed;
+        if (jitter(cap_ms) >= at_least_ms) {
+            jitter_state = seed;
+            return;
+        }
+    }
+}
+
+static int test_backoff_sleeps_within_the_cap(void) {
+    RetryPolicy policy = policy_of(3, 40, 1000);
+    for (int i = 0; i < 5; i++) {
+        uint64_t start = uv_hrtime();
+        TEST_ASSERT(retry_backoff(&policy, 1, UPLINK_ERROR_INTERNAL, NULL, "test"), "retries");
+        TEST_ASSERT(uv_hrtime() - start < 40 * 1000000ull + 30 * 1000000ull, "wait stays under the first cap");
+    }
+
+    seed_long_wait(80, 60);
+    uint64_t start = uv_hrtime();
+    TEST_ASSERT(retry_backoff(&policy, 2, UPLINK_ERROR_INTERNAL, NULL, "test"), "retries");
+    uint64_t waited = uv_hrtime() - start;
+    TEST_ASSERT(waited >= 60 * 1000000ull, "the jittered delay is slept out");
+    TEST_ASSERT(waited < 80 * 1000000ull + 30 * 1000000ull, "wait stays under the second cap");
+    return 1;
+}
+
+static void cancel_later(void* arg) {
+    uv_sleep(60);
+    __atomic_store_n(&((CancelToken*)arg)->cancelled, true, __ATOMIC_RELEASE);
+}
+
+static int test_cancel_ends_the_wait(void) {
+    RetryPolicy policy = policy_of(3, 5000, 5000);
+    CancelToken token = { false };
+    uv_thread_t thread;
+    TEST_ASSERT_EQ(uv_thread_create(&thread, cancel_later, &token), 0, "start canceller");
+
+    seed_long_wait(5000, 2000);
+    uint64_t start = uv_hrtime();
+    bool again = retry_backoff(&policy, 1, UPLINK_ERROR_INTERNAL, &token, "test");
+    uint64_t waited = uv_hrtime() - start;
+    uv_thread_join(&thread);
+    TEST_ASSERT(!again, "a cancelled wait does not retry");
+    TEST_ASSERT(waited < (60 + 2 * RETRY_POLL_MS + 50) * 1000000ull, "cancellation is seen within a poll slice");
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Retry Tests");
+
+    RUN_TEST(test_backoff_cap_doubles_to_the_max);
+    RUN_TEST(test_jitter_stays_in_bounds);
+    RUN_TEST(test_retryable_codes);
+    RUN_TEST(test_retry_decisions);
+    RUN_TEST(test_backoff_sleeps_within_the_cap);
+    RUN_TEST(test_cancel_ends_the_wait);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,392 @@
+/**
+ * @file test_runtime.h
+ * @brief Stand-ins for the Node runtime so native sources run in test binaries
+ *
+ * Tests of real modules include this header first, then the module's .c
+ * file, and build with Node's headers on the include path (see
+ * scripts/test-c). libuv lives inside the node binary, so the libuv calls
+ * the modules make are backed by pthreads here, and the synchronous file
+ * calls (no loop, no callback) by POSIX; the logger is silent and
+ * the N-API entry points and cross-module helpers the modules reference
+ * fail if reached, which the tests never do. Tests that fake N-API
+ * themselves define TEST_RUNTIME_FAKE_NAPI first and leave those out.
+ */
+
+#ifndef TEST_RUNTIME_H
+#define TEST_RUNTIME_H
+
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+#ifndef _DARWIN_C_SOURCE
+#define _DARWIN_C_SOURCE
+#endif
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include <uv.h>
+#include <node_api.h>
+
+#include "test_framework.h"
+#include "../src/common/logger.h"
+#include "../src/common/cancel_token.h"
+#include "../src/common/error_registry.h"
+#include "../src/common/op_metrics.h"
+#include "../src/common/result_helpers.h"
+#include "../src/common/type_converters.h"
+
+/* ========== logger ========== */
+
+LogLevel logger_current_level = LOG_LEVEL_NONE;
+
+void logger_log(LogLevel level, const char* file, int line, const char* func, const char* fmt, ...) {
+    (void)level;
+    (void)file;
+    (void)line;
+    (void)func;
+    (void)fmt;
+}
+
+/* ========== libuv ========== */
+
+void uv_once(uv_once_t* guard, void (*callback)(void)) {
+    pthread_once(guard, callback);
+}
+
+int uv_mutex_init(uv_mutex_t* mutex) {
+    return pthread_mutex_init(mutex, NULL) == 0 ? 0 : UV_ENOMEM;
+}
+
+void uv_mutex_destroy(uv_mutex_t* mutex) {
+    pthread_mutex_destroy(mutex);
+}
+
+void uv_mutex_lock(uv_mutex_t* mutex) {
+    pthread_mutex_lock(mutex);
+}
+
+void uv_mutex_unlock(uv_mutex_t* mutex) {
+    pthread_mutex_unlock(mutex);
+}
+
+int uv_cond_init(uv_cond_t* cond) {
+    return pthread_cond_init(cond, NULL) == 0 ? 0 : UV_ENOMEM;
+}
+
+void uv_cond_destroy(uv_cond_t* cond) {
+    pthread_cond_destroy(cond);
+}
+
+void uv_cond_signal(uv_cond_t* cond) {
+    pthread_cond_signal(cond);
+}
+
+void uv_cond_broadcast(uv_cond_t* cond) {
+    pthread_cond_broadcast(cond);
+}
+
+void uv_cond_wait(uv_cond_t* cond, uv_mutex_t* mutex) {
+    pthread_cond_wait(cond, mutex);
+}
+
+int uv_cond_timedwait(uv_cond_t* cond, uv_mutex_t* mutex, uint64_t timeout) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    uint64_t nsec = (uint64_t)deadline.tv_nsec + timeout;
+    deadline.tv_sec += (time_t)(nsec / 1000000000u);
+    deadline.tv_nsec = (long)(nsec % 1000000000u);
+    return pthread_cond_timedwait(cond, mutex, &deadline) == ETIMEDOUT ? UV_ETIMEDOUT : 0;
+}
+
+uint64_t uv_hrtime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+void uv_sleep(unsigned int msec) {
+    struct timespec delay = { (time_t)(msec / 1000), (long)(msec % 1000) * 1000000L };
+    while (nanosleep(&delay, &delay) != 0 && errno == EINTR) {
+    }
+}
+
+typedef struct {
+    uv_thread_cb entry;
+    void* arg;
+} TestThreadStart;
+
+static void* test_thread_main(void* arg) {
+    TestThreadStart start = *(TestThreadStart*)arg;
+    free(arg);
+    start.entry(start.arg);
+    return NULL;
+}
+
+int uv_thread_create(uv_thread_t* tid, uv_thread_cb entry, void* arg) {
+    TestThreadStart* start = (TestThreadStart*)malloc(sizeof(TestThreadStart));
+    if (start == NULL) {
+        return UV_ENOMEM;
+    }
+    start->entry = entry;
+    start->arg = arg;
+    if (pthread_create(tid, NULL, test_thread_main, start) != 0) {
+        free(start);
+        return UV_EAGAIN;
+    }
+    return 0;
+}
+
+int uv_thread_join(uv_thread_t* tid) {
+    return pthread_join(*tid, NULL) == 0 ? 0 : UV_EINVAL;
+}
+
+int uv_gettimeofday(uv_timeval64_t* tv) {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    tv->tv_sec = now.tv_sec;
+    tv->tv_usec = (int32_t)now.tv_usec;
+    return 0;
+}
+
+uv_pid_t uv_os_getpid(void) {
+    return getpid();
+}
+
+/* ========== libuv file system (synchronous calls) ========== */
+
+static int test_fs_result(uv_fs_t* req, uv_fs_type type, int rc) {
+    req->fs_type = type;
+    req->ptr = NULL;
+    req->result = rc < 0 ? -errno : rc;
+    return (int)req->result;
+}
+
+int uv_fs_open(uv_loop_t* loop, uv_fs_t* req, const char* path, int flags, int mode, uv_fs_cb cb) {
+    (void)loop, (void)cb;
+    return test_fs_result(req, UV_FS_OPEN, open(path, flags, mode));
+}
+
+int uv_fs_mkdir(uv_loop_t* loop, uv_fs_t* req, const char* path, int mode, uv_fs_cb cb) {
+    (void)loop, (void)cb;
+    return test_fs_result(req, UV_FS_MKDIR, mkdir(path, (mode_t)mode));
+}
+
+int uv_fs_unlink(uv_loop_t* loop, uv_fs_t* req, const char* path, uv_fs_cb cb) {
+    (void)loop, (void)cb;
+    return test_fs_result(req, UV_FS_UNLINK, unlink(path));
+}
+
+int uv_fs_link(uv_loop_t* loop, uv_fs_t* req, const char* path, const char* new_path, uv_fs_cb cb) {
+    (void)loop, (void)cb;
+    return test_fs_result(req, UV_FS_LINK, link(path, new_path));
+}
+
+int uv_fs_ftruncate(uv_loop_t* loop, uv_fs_t* req, uv_file file, int64_t offset, uv_fs_cb cb) {
+    (void)loop, (void)cb;
+    return test_fs_result(req, UV_FS_FTRUNCATE, ftruncate(file, (off_t)offset));
+}
+
+int uv_fs_futime(uv_loop_t* loop, uv_fs_t* req, uv_file file, double atime, double mtime, uv_fs_cb cb) {
+    (void)loop, (void)cb;
+    struct timespec times[2] = {
+        { (time_t)atime, (long)((atime - (double)(time_t)atime) * 1e9) },
+        { (time_t)mtime, (long)((mtime - (double)(time_t)mtime) * 1e9) },
+    };
+    return test_fs_result(req, UV_FS_FUTIME, futimens(file, times));
+}
+
+int uv_fs_stat(uv_loop_t* loop, uv_fs_t* req, const char* path, uv_fs_cb cb) {
+    (void)loop, (void)cb;
+    struct stat st;
+    int rc = test_fs_result(req, UV_FS_STAT, stat(path, &st));
+    if (rc == 0) {
+        memset(&req->statbuf, 0, sizeof(req->statbuf));
+        req->statbuf.st_mode = (uint64_t)st.st_mode;
+        req->statbuf.st_size = (uint64_t)st.st_size;
+        req->statbuf.st_blocks = (uint64_t)st.st_blocks;
+#ifdef __APPLE__
+        req->statbuf.st_mtim.tv_sec = st.st_mtimespec.tv_sec;
+        req->statbuf.st_mtim.tv_nsec = st.st_mtimespec.tv_nsec;
+#else
+        req->statbuf.st_mtim.tv_sec = st.st_mtim.tv_sec;
+        req->statbuf.st_mtim.tv_nsec = st.st_mtim.tv_nsec;
+#endif
+    }
+    return rc;
+}
+
+static int test_scandir_filter(const struct dirent* entry) {
+    return strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0;
+}
+
+/** Entries are kept in req->ptr and walked with req->nbufs, as libuv does */
+int uv_fs_scandir(uv_loop_t* loop, uv_fs_t* req, const char* path, int flags, uv_fs_cb cb) {
+    (void)loop, (void)flags, (void)cb;
+    struct dirent** entries = NULL;
+    int rc = test_fs_result(req, UV_FS_SCANDIR, scandir(path, &entries, test_scandir_filter, NULL));
+    req->ptr = entries;
+    req->nbufs = 0;
+    return rc;
+}
+
+int uv_fs_scandir_next(uv_fs_t* req, uv_dirent_t* ent) {
+    struct dirent** entries = (struct dirent**)req->ptr;
+    if (entries == NULL || req->result < 0 || req->nbufs >= (unsigned int)req->result) {
+        return UV_EOF;
+    }
+    ent->name = entries[req->nbufs++]->d_name;
+    ent->type = UV_DIRENT_UNKNOWN;
+    return 0;
+}
+
+void uv_fs_req_cleanup(uv_fs_t* req) {
+    if (req->fs_type == UV_FS_SCANDIR && req->ptr != NULL) {
+        struct dirent** entries = (struct dirent**)req->ptr;
+        for (ssize_t i = 0; i < req->result; i++) {
+            free(entries[i]);
+        }
+        free(entries);
+    }
+    req->ptr = NULL;
+}
+
+const char* uv_strerror(int err) {
+    (void)err;
+    return "test runtime error";
+}
+
+/* ========== cancel tokens ========== */
+
+/** Tests set cancelled directly, from any thread; the real token also carries a timer */
+struct CancelToken {
+    bool cancelled;
+};
+
+bool cancel_token_is_cancelled(CancelToken* token) {
+    return token != NULL && __atomic_load_n(&token->cancelled, __ATOMIC_ACQUIRE);
+}
+
+#ifndef TEST_RUNTIME_FAKE_NAPI
+
+/* ========== referenced, never reached ========== */
+
+napi_value throw_type_error(napi_env env, const char* message) {
+    (void)env;
+    (void)message;
+    return NULL;
+}
+
+int32_t error_code_by_class_name(const char* name) {
+    (void)name;
+    return -1;
+}
+
+int64_t get_int64_property(napi_env env, napi_value obj, const char* name, int64_t default_val) {
+    (void)env;
+    (void)obj;
+    (void)name;
+    return default_val;
+}
+
+uint64_t op_metrics_quantile(napi_env env, const char* name, double q, uint64_t* count) {
+    (void)env;
+    (void)name;
+    (void)q;
+    *count = 0;
+    return 0;
+}
+
+#define TEST_NAPI_UNREACHED() \
+    do { \
+        (void)env; \
+        return napi_generic_failure; \
+    } while (0)
+
+napi_status napi_get_cb_info(napi_env env, napi_callback_info cbinfo, size_t* argc, napi_value* argv,
+                             napi_value* this_arg, void** data) {
+    (void)cbinfo, (void)argc, (void)argv, (void)this_arg, (void)data;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_get_undefined(napi_env env, napi_value* result) {
+    (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_typeof(napi_env env, napi_value value, napi_valuetype* result) {
+    (void)value, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_is_array(napi_env env, napi_value value, bool* result) {
+    (void)value, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_get_array_length(napi_env env, napi_value value, uint32_t* result) {
+    (void)value, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_get_element(napi_env env, napi_value object, uint32_t index, napi_value* result) {
+    (void)object, (void)index, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_get_named_property(napi_env env, napi_value object, const char* utf8name, napi_value* result) {
+    (void)object, (void)utf8name, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_set_named_property(napi_env env, napi_value object, const char* utf8name, napi_value value) {
+    (void)object, (void)utf8name, (void)value;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_get_value_bool(napi_env env, napi_value value, bool* result) {
+    (void)value, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_get_value_double(napi_env env, napi_value value, double* result) {
+    (void)value, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_get_value_string_utf8(napi_env env, napi_value value, char* buf, size_t bufsize, size_t* result) {
+    (void)value, (void)buf, (void)bufsize, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_create_double(napi_env env, double value, napi_value* result) {
+    (void)value, (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_create_object(napi_env env, napi_value* result) {
+    (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_throw_type_error(napi_env env, const char* code, const char* msg) {
+    (void)code, (void)msg;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_throw_range_error(napi_env env, const char* code, const char* msg) {
+    (void)code, (void)msg;
+    TEST_NAPI_UNREACHED();
+}
+
+#endif /* TEST_RUNTIME_FAKE_NAPI */
+
+#endif /* TEST_RUNTIME_H */
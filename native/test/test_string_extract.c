@@ -0,0 +1,278 @@
+/**
+ * @file native/test/test_string_extract.c
+ * @brief Unit tests for the extraction paths of string_helpers.c: the
+ *        one-call scratch path, strings longer than the scratch buffer,
+ *        and the retain, release and destroy lifecycle of interned
+ *        bucket names
+ *
+ * A napi_value is a fake holding a C string; the fake string copy stops
+ * short of a UTF-8 sequence it cannot fit, as V8 does, and counts calls.
+ */
+
+#define TEST_RUNTIME_FAKE_NAPI
+#include "test_runtime.h"
+#include "../src/common/string_helpers.c"
+
+/* ========== fake N-API ========== */
+
+struct napi_value__ {
+    napi_valuetype type;
+    const char* text;
+};
+
+struct napi_env__ {
+    AddonInstance instance;
+    bool no_instance;
+    int string_calls;
+    char thrown[256];               /* message of the last TypeError */
+};
+
+AddonInstance* addon_instance(napi_env env) {
+    return env->no_instance ? NULL : &env->instance;
+}
+
+napi_status napi_typeof(napi_env env, napi_value value, napi_valuetype* result) {
+    (void)env;
+    *result = value->type;
+    return napi_ok;
+}
+
+napi_status napi_get_value_string_utf8(napi_env env, napi_value value, char* buf, size_t bufsize, size_t* result) {
+    env->string_calls++;
+    if (value->type != napi_string) {
+        return napi_string_expected;
+    }
+    size_t length = strlen(value->text);
+    if (buf == NULL) {
+        *result = length;
+        return napi_ok;
+    }
+    size_t copy = length < bufsize - 1 ? length : bufsize - 1;
+    while (copy < length && copy > 0 && ((uint8_t)value->text[copy] & 0xC0) == 0x80) {
+        copy--;     /* Back off to the start of the cut sequence */
+    }
+    memcpy(buf, value->text, copy);
+    buf[copy] = '\0';
+    *result = copy;
+    return napi_ok;
+}
+
+napi_status napi_throw_type_error(napi_env env, const char* code, const char* msg) {
+    (void)code;
+    snprintf(env->thrown, sizeof(env->thrown), "%s", msg);
+    return napi_ok;
+}
+
+napi_status napi_get_null(napi_env env, napi_value* result) {
+    (void)env, (void)result;
+    return napi_generic_failure;
+}
+
+napi_status napi_create_string_utf8(napi_env env, const char* str, size_t length, napi_value* result) {
+    (void)env, (void)str, (void)length, (void)result;
+    return napi_generic_failure;
+}
+
+/* ========== helpers ========== */
+
+static char* repeat(const char* unit, size_t count) {
+    size_t unit_length = strlen(unit);
+    char* text = (char*)malloc(unit_length * count + 1);
+    for (size_t i = 0; i < count; i++) {
+        memcpy(text + i * unit_length, unit, unit_length);
+    }
+    text[unit_length * count] = '\0';
+    return text;
+}
+
+static char* extract(struct napi_env__* env, const char* text, int* calls) {
+    struct napi_value__ value = { napi_string, text };
+    char* out = NULL;
+    env->string_calls = 0;
+    napi_status status = extract_string(env, &value, &out);
+    *calls = env->string_calls;
+    return status == napi_ok ? out : NULL;
+}
+
+static char* bucket(struct napi_env__* env, const char* text) {
+    struct napi_value__ value = { napi_string, text };
+    char* out = NULL;
+    env->thrown[0] = '\0';
+    return extract_bucket_name(env, &value, "bucket", &out) == napi_ok ? out : NULL;
+}
+
+static InternedName* entry_of(char* name) {
+    return interned_from_name(name);
+}
+
+/* ========== tests ========== */
+
+static int test_short_strings_take_one_call(void) {
+    struct napi_env__ env = { 0 };
+    int calls;
+    char* out = extract(&env, "photos/2024/a.jpg", &calls);
+    TEST_ASSERT(out != NULL && strcmp(out, "photos/2024/a.jpg") == 0, "copied");
+    TEST_ASSERT_EQ(calls, 1, "one N-API call");
+    free(out);
+
+    char* edge = repeat("k", STRING_SCRATCH_BYTES - 5);
+    out = extract(&env, edge, &calls);
+    TEST_ASSERT(out != NULL && strcmp(out, edge) == 0, "longest string the scratch settles");
+    TEST_ASSERT_EQ(calls, 1, "still one call");
+    free(out);
+    free(edge);
+    return 1;
+}
+
+static int test_long_strings_are_copied_whole(void) {
+    struct napi_env__ env = { 0 };
+    int calls;
+    const size_t lengths[] = { STRING_SCRATCH_BYTES - 4, STRING_SCRATCH_BYTES - 1, STRING_SCRATCH_BYTES,
+                               STRING_SCRATCH_BYTES + 1, 4 * STRING_SCRATCH_BYTES + 3 };
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        char* text = repeat("x", lengths[i]);
+        char* out = extract(&env, text, &calls);
+        TEST_ASSERT(out != NULL && strlen(out) == lengths[i] && strcmp(out, text) == 0, "copied whole");
+        TEST_ASSERT_EQ(calls, 3, "scratch, length, then copy");
+        free(out);
+        free(text);
+    }
+
+    /* Two-byte characters straddling the end of the scratch buffer */
+    char* text = repeat("\xc3\xa9", STRING_SCRATCH_BYTES / 2 + 7);
+    char* out = extract(&env, text, &calls);
+    TEST_ASSERT(out != NULL && strcmp(out, text) == 0, "multi-byte string copied whole");
+    TEST_ASSERT_EQ(calls, 3, "through the long path");
+    free(out);
+    free(text);
+    return 1;
+}
+
+static int test_names_are_shared_and_counted(void) {
+    struct napi_env__ env = { 0 };
+    char* a = bucket(&env, "photos");
+    char* b = bucket(&env, "photos");
+    char* c = bucket(&env, "videos");
+    TEST_ASSERT(a != NULL && a == b, "one copy per name");
+    TEST_ASSERT(c != NULL && c != a, "another name, another entry");
+    TEST_ASSERT_STR_EQ(a, "photos", "the name");
+    TEST_ASSERT_EQ(entry_of(a)->refs, 2, "two references");
+    TEST_ASSERT_EQ(env.instance.bucket_names.count, 2, "two entries");
+
+    TEST_ASSERT(bucket_name_retain(a) == a, "retain returns the name");
+    TEST_ASSERT_EQ(entry_of(a)->refs, 3, "three references");
+    TEST_ASSERT_NULL(bucket_name_retain(NULL), "NULL passes through");
+
+    bucket_name_release(a);
+    bucket_name_release(b);
+    bucket_name_release(a);
+    TEST_ASSERT_EQ(entry_of(a)->refs, 0, "unreferenced");
+    TEST_ASSERT_EQ(env.instance.bucket_names.count, 2, "but kept while under the cache cap");
+    TEST_ASSERT(bucket(&env, "photos") == a, "the next operation reuses it");
+    bucket_name_release(a);
+    bucket_name_release(c);
+    bucket_name_release(NULL);
+
+    bucket_names_destroy(&env.instance.bucket_names);
+    TEST_ASSERT_EQ(env.instance.bucket_names.count, 0, "destroy empties the table");
+    return 1;
+}
+
+static int test_names_past_the_cap_are_freed(void) {
+    enum { NAMES = BUCKET_NAME_CACHE_MAX + 2 };
+    struct napi_env__ env = { 0 };
+    static char* names[NAMES];
+    for (int i = 0; i < NAMES; i++) {
+        char text[32];
+        snprintf(text, sizeof(text), "bucket-%d", i);
+        names[i] = bucket(&env, text);
+        TEST_ASSERT_NOT_NULL(names[i], "interned");
+    }
+    BucketNameTable* table = &env.instance.bucket_names;
+    TEST_ASSERT_EQ(table->count, NAMES, "all held");
+
+    bucket_name_release(names[0]);
+    TEST_ASSERT_EQ(table->count, NAMES - 1, "over the cap: freed on last release");
+    bucket_name_release(names[1]);
+    TEST_ASSERT_EQ(table->count, BUCKET_NAME_CACHE_MAX, "down to the cap");
+    bucket_name_release(names[2]);
+    TEST_ASSERT_EQ(table->count, BUCKET_NAME_CACHE_MAX, "at the cap: kept");
+
+    char* again = bucket(&env, "bucket-0");
+    TEST_ASSERT(again != NULL && strcmp(again, "bucket-0") == 0 && entry_of(again)->refs == 1,
+                "a freed name is interned afresh");
+    TEST_ASSERT(bucket(&env, "bucket-2") == names[2], "a kept one is reused");
+    bucket_name_release(again);
+    bucket_name_release(names[2]);
+    for (int i = 3; i < NAMES; i++) {
+        bucket_name_release(names[i]);
+    }
+    bucket_names_destroy(table);
+    return 1;
+}
+
+static int test_names_outlive_their_table(void) {
+    struct napi_env__ env = { 0 };
+    char* held = bucket(&env, "held");
+    char* idle = bucket(&env, "idle");
+    bucket_name_release(idle);
+    char* shared = bucket_name_retain(held);
+
+    bucket_names_destroy(&env.instance.bucket_names);
+    TEST_ASSERT_NULL(entry_of(held)->table, "detached from the table");
+    TEST_ASSERT_STR_EQ(held, "held", "still readable after env teardown");
+    bucket_name_release(held);
+    TEST_ASSERT_STR_EQ(shared, "held", "until the last reference");
+    bucket_name_release(shared);    /* Frees it; ASan catches a leak or double free */
+    return 1;
+}
+
+static int test_names_without_an_instance_are_unshared(void) {
+    struct napi_env__ env = { 0 };
+    env.no_instance = true;
+    char* a = bucket(&env, "photos");
+    char* b = bucket(&env, "photos");
+    TEST_ASSERT(a != NULL && b != NULL && a != b, "a private copy each");
+    bucket_name_release(a);
+    bucket_name_release(b);
+    return 1;
+}
+
+static int test_bucket_name_checks(void) {
+    struct napi_env__ env = { 0 };
+    TEST_ASSERT_NULL(bucket(&env, ""), "empty refused");
+    TEST_ASSERT_STR_EQ(env.thrown, "Parameter 'bucket' cannot be empty", "with a TypeError");
+
+    struct napi_value__ number = { napi_number, NULL };
+    char* out = (char*)"unset";
+    TEST_ASSERT_EQ(extract_bucket_name(&env, &number, "bucket", &out), napi_invalid_arg, "not a string");
+    TEST_ASSERT_NULL(out, "no name");
+    TEST_ASSERT_STR_EQ(env.thrown, "Parameter 'bucket' must be a string", "with a TypeError");
+
+    /* Too long to be valid, but interned whole for uplink-c to report */
+    char* text = repeat("b", STRING_SCRATCH_BYTES * 2);
+    char* name = bucket(&env, text);
+    TEST_ASSERT(name != NULL && strcmp(name, text) == 0, "long names interned whole");
+    TEST_ASSERT(bucket(&env, text) == name, "and shared");
+    bucket_name_release(name);
+    bucket_name_release(name);
+    free(text);
+    bucket_names_destroy(&env.instance.bucket_names);
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("String Extraction Tests");
+
+    RUN_TEST(test_short_strings_take_one_call);
+    RUN_TEST(test_long_strings_are_copied_whole);
+    RUN_TEST(test_names_are_shared_and_counted);
+    RUN_TEST(test_names_past_the_cap_are_freed);
+    RUN_TEST(test_names_outlive_their_table);
+    RUN_TEST(test_names_without_an_instance_are_unshared);
+    RUN_TEST(test_bucket_name_checks);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,575 @@
+/**
+ * @file native/test/test_thread_pool.c
+ * @brief Unit tests for thread_pool.c: lane budgets, the metadata lane
+ *        running past a busy bulk lane, a burst fanning out to the full
+ *        budget, cancellation, the libuv fallback, batched completions
+ *        and environment teardown
+ *
+ * A napi_env is a fake whose threadsafe function counts calls; the tests
+ * play the event loop by waiting for one and running the pool's callback.
+ * Async work is a heap record that napi_queue_async_work runs inline, as
+ * the libuv pool would, only sooner.
+ */
+
+#include "test_runtime.h"
+#include "../src/common/thread_pool.c"
+#include "../src/common/work_pool.c"
+
+/* ========== fake env ========== */
+
+struct napi_env__ {
+    AddonInstance instance;
+    pthread_mutex_t lock;
+    pthread_cond_t notified;
+    int notifications;              /* threadsafe function calls not yet pumped */
+    napi_threadsafe_function_call_js call_js;
+    void* context;
+    int tsfn_refs;
+    void (*cleanup)(void* arg);
+    void* cleanup_arg;
+    int libuv_jobs;
+};
+
+typedef struct {
+    napi_async_execute_callback execute;
+    napi_async_complete_callback complete;
+    void* data;
+} FakeWork;
+
+AddonInstance* addon_instance(napi_env env) {
+    return &env->instance;
+}
+
+napi_status napi_create_threadsafe_function(napi_env env, napi_value func, napi_value async_resource,
+                                            napi_value async_resource_name, size_t max_queue_size,
+                                            size_t initial_thread_count, void* thread_finalize_data,
+                                            napi_finalize thread_finalize_cb, void* context,
+                                            napi_threadsafe_function_call_js call_js_cb,
+                                            napi_threadsafe_function* result) {
+    (void)func, (void)async_resource, (void)async_resource_name, (void)max_queue_size;
+    (void)initial_thread_count, (void)thread_finalize_data, (void)thread_finalize_cb;
+    env->call_js = call_js_cb;
+    env->context = context;
+    env->tsfn_refs = 1;
+    *result = (napi_threadsafe_function)env;
+    return napi_ok;
+}
+
+napi_status napi_call_threadsafe_function(napi_threadsafe_function func, void* data,
+                                          napi_threadsafe_function_call_mode is_blocking) {
+    (void)data, (void)is_blocking;
+    napi_env env = (napi_env)func;
+    pthread_mutex_lock(&env->lock);
+    env->notifications++;
+    pthread_cond_broadcast(&env->notified);
+    pthread_mutex_unlock(&env->lock);
+    return napi_ok;
+}
+
+napi_status napi_ref_threadsafe_function(node_api_basic_env env, napi_threadsafe_function func) {
+    (void)func;
+    env->tsfn_refs++;
+    return napi_ok;
+}
+
+napi_status napi_unref_threadsafe_function(node_api_basic_env env, napi_threadsafe_function func) {
+    (void)func;
+    env->tsfn_refs--;
+    return napi_ok;
+}
+
+napi_status napi_add_env_cleanup_hook(node_api_basic_env env, napi_cleanup_hook fun, void* arg) {
+    env->cleanup = fun;
+    env->cleanup_arg = arg;
+    return napi_ok;
+}
+
+napi_status napi_create_async_work(napi_env env, napi_value async_resource, napi_value async_resource_name,
+                                   napi_async_execute_callback execute, napi_async_complete_callback complete,
+                                   void* data, napi_async_work* result) {
+    (void)env, (void)async_resource, (void)async_resource_name;
+    FakeWork* work = (FakeWork*)malloc(sizeof(FakeWork));
+    work->execute = execute;
+    work->complete = complete;
+    work->data = data;
+    *result = (napi_async_work)work;
+    return napi_ok;
+}
+
+napi_status napi_queue_async_work(node_api_basic_env env, napi_async_work work) {
+    FakeWork* fake = (FakeWork*)work;
+    env->libuv_jobs++;
+    fake->execute(env, fake->data);
+    fake->complete(env, napi_ok, fake->data);
+    return napi_ok;
+}
+
+napi_status napi_delete_async_work(napi_env env, napi_async_work work) {
+    (void)env;
+    free(work);
+    return napi_ok;
+}
+
+napi_status napi_create_string_utf8(napi_env env, const char* str, size_t length, napi_value* result) {
+    (void)env, (void)str, (void)length;
+    *result = NULL;
+    return napi_ok;
+}
+
+napi_status napi_open_handle_scope(napi_env env, napi_handle_scope* result) {
+    (void)env;
+    *result = NULL;
+    return napi_ok;
+}
+
+napi_status napi_close_handle_scope(napi_env env, napi_handle_scope scope) {
+    (void)env, (void)scope;
+    return napi_ok;
+}
+
+napi_status napi_is_exception_pending(napi_env env, bool* result) {
+    (void)env;
+    *result = false;
+    return napi_ok;
+}
+
+napi_status napi_get_and_clear_last_exception(napi_env env, napi_value* result) {
+    (void)result;
+    TEST_NAPI_UNREACHED();
+}
+
+napi_status napi_fatal_exception(napi_env env, napi_value err) {
+    (void)err;
+    TEST_NAPI_UNREACHED();
+}
+
+char* get_string_property(napi_env env, napi_value obj, const char* name) {
+    (void)env, (void)obj, (void)name;
+    return NULL;
+}
+
+OpTimer op_metrics_start(napi_env env, napi_value name) {
+    (void)env, (void)name;
+    return (OpTimer){ NULL, 0 };
+}
+
+OpTimer op_metrics_start_named(napi_env env, const char* name) {
+    (void)env, (void)name;
+    return (OpTimer){ NULL, 0 };
+}
+
+void op_metrics_begin_complete(napi_env env, const OpTimer* timer) {
+    (void)env, (void)timer;
+}
+
+void op_metrics_finish(napi_env env, const OpTimer* timer, uint64_t started_at, uint64_t finished_at,
+                       uint64_t complete_at) {
+    (void)env, (void)timer, (void)started_at, (void)finished_at, (void)complete_at;
+}
+
+static void env_open(struct napi_env__* env) {
+    memset(env, 0, sizeof(*env));
+    pthread_mutex_init(&env->lock, NULL);
+    pthread_cond_init(&env->notified, NULL);
+}
+
+/** Run the env's cleanup hook, as Node does at teardown */
+static void env_teardown(struct napi_env__* env) {
+    if (env->cleanup != NULL) {
+        env->cleanup(env->cleanup_arg);
+    }
+    pthread_cond_destroy(&env->notified);
+    pthread_mutex_destroy(&env->lock);
+}
+
+/* ========== jobs ========== */
+
+/** Jobs given a gate wait on it until it opens */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t opened_cond;
+    bool opened;
+    int running;
+    int max_running;
+} Gate;
+
+typedef struct {
+    Gate* gate;
+    napi_async_work work;
+    napi_status status;
+    bool completed;
+} Job;
+
+static int completed_jobs;          /* main thread only */
+
+static void gate_init(Gate* gate) {
+    memset(gate, 0, sizeof(*gate));
+    pthread_mutex_init(&gate->lock, NULL);
+    pthread_cond_init(&gate->opened_cond, NULL);
+}
+
+static void gate_open(Gate* gate) {
+    pthread_mutex_lock(&gate->lock);
+    gate->opened = true;
+    pthread_cond_broadcast(&gate->opened_cond);
+    pthread_mutex_unlock(&gate->lock);
+}
+
+static void gate_destroy(Gate* gate) {
+    pthread_cond_destroy(&gate->opened_cond);
+    pthread_mutex_destroy(&gate->lock);
+}
+
+static int gate_running(Gate* gate) {
+    pthread_mutex_lock(&gate->lock);
+    int running = gate->running;
+    pthread_mutex_unlock(&gate->lock);
+    return running;
+}
+
+static void job_execute(napi_env env, void* data) {
+    (void)env;
+    Gate* gate = ((Job*)data)->gate;
+    if (gate == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&gate->lock);
+    if (++gate->running > gate->max_running) {
+        gate->max_running = gate->running;
+    }
+    while (!gate->opened) {
+        pthread_cond_wait(&gate->opened_cond, &gate->lock);
+    }
+    gate->running--;
+    pthread_mutex_unlock(&gate->lock);
+}
+
+static void job_complete(napi_env env, napi_status status, void* data) {
+    Job* job = (Job*)data;
+    job->status = status;
+    job->completed = true;
+    completed_jobs++;
+    if (job->work != NULL) {
+        napi_delete_async_work(env, job->work);
+    }
+}
+
+/** Queue @p job without an async work handle */
+static void queue_job(napi_env env, ThreadPoolLane lane, Job* job) {
+    job->work = NULL;
+    thread_pool_queue_job(env, lane, "test", job_execute, job_complete, job);
+}
+
+/** Queue @p job with its own async work handle, so it can be cancelled */
+static void submit_job(napi_env env, ThreadPoolLane lane, Job* job) {
+    napi_create_async_work(env, NULL, NULL, job_execute, job_complete, job, &job->work);
+    thread_pool_submit(env, lane, job->work, job_execute, job_complete, job, NULL);
+}
+
+/** Play the event loop until @p count jobs have completed in all; false after 5 s without progress */
+static bool pump(napi_env env, int count) {
+    while (completed_jobs < count) {
+        pthread_mutex_lock(&env->lock);
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += 5;
+        while (env->notifications == 0) {
+            if (pthread_cond_timedwait(&env->notified, &env->lock, &deadline) == ETIMEDOUT) {
+                pthread_mutex_unlock(&env->lock);
+                return false;
+            }
+        }
+        env->notifications = 0;
+        pthread_mutex_unlock(&env->lock);
+        env->call_js(env, NULL, env->context, NULL);
+    }
+    return true;
+}
+
+/** Wait until @p running jobs are inside @p gate; false after 5 s */
+static bool wait_running(Gate* gate, int running) {
+    for (int i = 0; i < 5000; i++) {
+        if (gate_running(gate) == running) {
+            return true;
+        }
+        uv_sleep(1);
+    }
+    return false;
+}
+
+static ThreadPoolGauges gauges_now(void) {
+    ThreadPoolGauges gauges;
+    thread_pool_gauges(&gauges);
+    return gauges;
+}
+
+/* ========== tests ========== */
+
+static int test_jobs_run_and_complete(void) {
+    enum { JOBS = 20 };
+    struct napi_env__ env;
+    env_open(&env);
+    thread_pool_configure(2, 4, THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS);
+    ThreadPoolGauges before = gauges_now();
+    static Job jobs[JOBS];
+    completed_jobs = 0;
+    for (int i = 0; i < JOBS; i++) {
+        jobs[i] = (Job){ NULL, NULL, napi_generic_failure, false };
+        queue_job(&env, THREAD_POOL_LANE_BULK, &jobs[i]);
+    }
+    TEST_ASSERT_EQ(env.tsfn_refs, 1, "threadsafe function ref'd while jobs are in flight");
+    TEST_ASSERT(pump(&env, JOBS), "all completed");
+    for (int i = 0; i < JOBS; i++) {
+        TEST_ASSERT(jobs[i].completed && jobs[i].status == napi_ok, "completed with napi_ok");
+    }
+    TEST_ASSERT_EQ(env.tsfn_refs, 0, "and unref'd once they are settled");
+    TEST_ASSERT_EQ(env.libuv_jobs, 0, "none went to libuv");
+
+    ThreadPoolGauges after = gauges_now();
+    TEST_ASSERT(after.completions - before.completions == JOBS, "every completion counted");
+    TEST_ASSERT(after.completion_wakeups - before.completion_wakeups <= JOBS, "no more wake-ups than jobs");
+    TEST_ASSERT(after.threads <= 6, "no more threads than the lane budgets");
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_lane_budget_bounds_concurrency(void) {
+    enum { JOBS = 10 };
+    struct napi_env__ env;
+    env_open(&env);
+    thread_pool_configure(1, 3, THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS);
+    Gate gate;
+    gate_init(&gate);
+    static Job jobs[JOBS];
+    completed_jobs = 0;
+    for (int i = 0; i < JOBS; i++) {
+        jobs[i] = (Job){ &gate, NULL, napi_generic_failure, false };
+        queue_job(&env, THREAD_POOL_LANE_BULK, &jobs[i]);
+    }
+    TEST_ASSERT(wait_running(&gate, 3), "the budget's worth running");
+    uv_sleep(20);
+    ThreadPoolGauges gauges = gauges_now();
+    TEST_ASSERT_EQ(gauges.lanes[THREAD_POOL_LANE_BULK].running, 3, "at the budget");
+    TEST_ASSERT_EQ(gauges.lanes[THREAD_POOL_LANE_BULK].queued, JOBS - 3, "the rest wait");
+    TEST_ASSERT_EQ(gauges.lanes[THREAD_POOL_LANE_BULK].budget, 3, "budget reported");
+
+    gate_open(&gate);
+    TEST_ASSERT(pump(&env, JOBS), "all completed");
+    TEST_ASSERT_EQ(gate.max_running, 3, "never more than the budget at once");
+    gate_destroy(&gate);
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_metadata_lane_runs_past_busy_bulk(void) {
+    struct napi_env__ env;
+    env_open(&env);
+    thread_pool_configure(2, 2, THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS);
+    Gate gate;
+    gate_init(&gate);
+    static Job bulk[4];
+    completed_jobs = 0;
+    for (int i = 0; i < 4; i++) {
+        bulk[i] = (Job){ &gate, NULL, napi_generic_failure, false };
+        queue_job(&env, THREAD_POOL_LANE_BULK, &bulk[i]);
+    }
+    TEST_ASSERT(wait_running(&gate, 2), "bulk lane at its budget");
+
+    Job stat = { NULL, NULL, napi_generic_failure, false };
+    queue_job(&env, THREAD_POOL_LANE_METADATA, &stat);
+    TEST_ASSERT(pump(&env, 1), "a metadata job completes");
+    TEST_ASSERT(stat.completed && stat.status == napi_ok, "the metadata job");
+    ThreadPoolGauges gauges = gauges_now();
+    TEST_ASSERT_EQ(gauges.lanes[THREAD_POOL_LANE_BULK].running, 2, "while bulk is still blocked");
+    TEST_ASSERT_EQ(gauges.lanes[THREAD_POOL_LANE_BULK].queued, 2, "with its queue untouched");
+
+    gate_open(&gate);
+    TEST_ASSERT(pump(&env, 5), "bulk completes once released");
+    gate_destroy(&gate);
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_burst_fans_out_to_the_budget(void) {
+    enum { JOBS = 8 };
+    struct napi_env__ env;
+    env_open(&env);
+    thread_pool_configure(1, JOBS, THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS);
+
+    /* Twice: once growing the pool, once with its threads idle */
+    for (int round = 0; round < 2; round++) {
+        Gate gate;
+        gate_init(&gate);
+        static Job jobs[JOBS];
+        completed_jobs = 0;
+        for (int i = 0; i < JOBS; i++) {
+            jobs[i] = (Job){ &gate, NULL, napi_generic_failure, false };
+            queue_job(&env, THREAD_POOL_LANE_BULK, &jobs[i]);
+        }
+        TEST_ASSERT(wait_running(&gate, JOBS), "every blocking job got a thread");
+        ThreadPoolGauges gauges = gauges_now();
+        TEST_ASSERT(gauges.threads <= JOBS + 1, "within the pool capacity");
+        gate_open(&gate);
+        TEST_ASSERT(pump(&env, JOBS), "all completed");
+        gate_destroy(&gate);
+    }
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_cancel_takes_back_queued_jobs(void) {
+    struct napi_env__ env;
+    env_open(&env);
+    thread_pool_configure(1, 1, THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS);
+    Gate gate;
+    gate_init(&gate);
+    completed_jobs = 0;
+    Job running = { &gate, NULL, napi_generic_failure, false };
+    Job waiting = { NULL, NULL, napi_generic_failure, false };
+    submit_job(&env, THREAD_POOL_LANE_BULK, &running);
+    TEST_ASSERT(wait_running(&gate, 1), "first job running");
+    submit_job(&env, THREAD_POOL_LANE_BULK, &waiting);
+
+    TEST_ASSERT_EQ(thread_pool_cancel(running.work), -1, "a running job cannot be taken back");
+    TEST_ASSERT_EQ(thread_pool_cancel(NULL), -1, "nor a job without a handle");
+    TEST_ASSERT_EQ(thread_pool_cancel(waiting.work), 0, "a queued job can");
+    TEST_ASSERT_EQ(thread_pool_cancel(waiting.work), -1, "once");
+    TEST_ASSERT(pump(&env, 1), "the cancelled job completes");
+    TEST_ASSERT(waiting.completed && waiting.status == napi_cancelled, "with napi_cancelled");
+    TEST_ASSERT(!running.completed, "ahead of the running one");
+
+    gate_open(&gate);
+    TEST_ASSERT(pump(&env, 2), "the running job completes");
+    TEST_ASSERT_EQ(running.status, napi_ok, "with napi_ok");
+    gate_destroy(&gate);
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_budget_zero_falls_back_to_libuv(void) {
+    struct napi_env__ env;
+    env_open(&env);
+    thread_pool_configure(1, 0, THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS);
+    completed_jobs = 0;
+    Job job = { NULL, NULL, napi_generic_failure, false };
+    queue_job(&env, THREAD_POOL_LANE_BULK, &job);
+    TEST_ASSERT(job.completed && job.status == napi_ok, "a handle-free job runs as async work");
+    Job work = { NULL, NULL, napi_generic_failure, false };
+    submit_job(&env, THREAD_POOL_LANE_BULK, &work);
+    TEST_ASSERT(work.completed && work.status == napi_ok, "async work is queued with libuv");
+    TEST_ASSERT_EQ(env.libuv_jobs, 2, "both on the libuv pool");
+    TEST_ASSERT_EQ(gauges_now().lanes[THREAD_POOL_LANE_BULK].budget, 0, "bulk budget 0");
+
+    Job stat = { NULL, NULL, napi_generic_failure, false };
+    queue_job(&env, THREAD_POOL_LANE_METADATA, &stat);
+    TEST_ASSERT(pump(&env, 3), "the other lane still uses the pool");
+    TEST_ASSERT_EQ(env.libuv_jobs, 2, "not libuv");
+    env_teardown(&env);
+    return 1;
+}
+
+static int test_completions_are_batched(void) {
+    enum { JOBS = 4 };
+    struct napi_env__ env;
+    env_open(&env);
+    thread_pool_configure(1, JOBS, THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS);
+    /* A delay far longer than the jobs take: only the batch size ends it */
+    thread_pool_configure_completions(THREAD_POOL_MAX_COMPLETION_DELAY_US, JOBS);
+    ThreadPoolGauges before = gauges_now();
+    static Job jobs[JOBS];
+    completed_jobs = 0;
+    for (int i = 0; i < JOBS; i++) {
+        jobs[i] = (Job){ NULL, NULL, napi_generic_failure, false };
+        queue_job(&env, THREAD_POOL_LANE_BULK, &jobs[i]);
+    }
+    TEST_ASSERT(pump(&env, JOBS), "all completed");
+    ThreadPoolGauges after = gauges_now();
+    TEST_ASSERT(after.completions - before.completions == JOBS, "every completion counted");
+    TEST_ASSERT(after.completion_wakeups - before.completion_wakeups == 1, "in a single wake-up");
+    thread_pool_configure_completions(0, THREAD_POOL_DEFAULT_COMPLETION_BATCH);
+    env_teardown(&env);
+    return 1;
+}
+
+typedef struct {
+    Gate* gate;
+    unsigned int delay_ms;
+} Opener;
+
+static void open_later(void* arg) {
+    Opener* opener = (Opener*)arg;
+    uv_sleep(opener->delay_ms);
+    gate_open(opener->gate);
+}
+
+static int test_teardown_settles_every_job(void) {
+    struct napi_env__ env;
+    env_open(&env);
+    thread_pool_configure(1, 1, THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS);
+    Gate gate;
+    gate_init(&gate);
+    completed_jobs = 0;
+    Job running = { &gate, NULL, napi_generic_failure, false };
+    Job queued[2] = { { NULL, NULL, napi_generic_failure, false }, { NULL, NULL, napi_generic_failure, false } };
+    queue_job(&env, THREAD_POOL_LANE_BULK, &running);
+    TEST_ASSERT(wait_running(&gate, 1), "first job running");
+    queue_job(&env, THREAD_POOL_LANE_BULK, &queued[0]);
+    submit_job(&env, THREAD_POOL_LANE_BULK, &queued[1]);
+
+    /* Teardown waits for the running job; release it from another thread */
+    Opener opener = { &gate, 50 };
+    uv_thread_t thread;
+    uv_thread_create(&thread, open_later, &opener);
+    env_teardown(&env);
+    uv_thread_join(&thread);
+
+    TEST_ASSERT_EQ(completed_jobs, 3, "every job settled during teardown");
+    TEST_ASSERT_EQ(running.status, napi_ok, "the running one finished");
+    TEST_ASSERT(queued[0].status == napi_cancelled && queued[1].status == napi_cancelled,
+                "the queued ones were cancelled");
+    TEST_ASSERT_NULL(env.instance.pool_env, "the env's channel is gone");
+    ThreadPoolGauges gauges = gauges_now();
+    TEST_ASSERT(gauges.lanes[THREAD_POOL_LANE_BULK].queued == 0 && gauges.lanes[THREAD_POOL_LANE_BULK].running == 0,
+                "nothing left on the lane");
+    gate_destroy(&gate);
+    return 1;
+}
+
+static int test_idle_threads_exit(void) {
+    struct napi_env__ env;
+    env_open(&env);
+    thread_pool_configure(1, 2, 10);
+    completed_jobs = 0;
+    Job job = { NULL, NULL, napi_generic_failure, false };
+    queue_job(&env, THREAD_POOL_LANE_BULK, &job);
+    TEST_ASSERT(pump(&env, 1), "completed");
+
+    bool drained = false;
+    for (int i = 0; i < 500 && !drained; i++) {
+        uv_sleep(10);
+        drained = gauges_now().threads == 0;
+    }
+    TEST_ASSERT(drained, "threads exit after the idle timeout");
+    thread_pool_configure(THREAD_POOL_DEFAULT_METADATA_SIZE, THREAD_POOL_DEFAULT_SIZE,
+                          THREAD_POOL_DEFAULT_IDLE_TIMEOUT_MS);     /* Joins them */
+    env_teardown(&env);
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Thread Pool Tests");
+
+    RUN_TEST(test_jobs_run_and_complete);
+    RUN_TEST(test_lane_budget_bounds_concurrency);
+    RUN_TEST(test_metadata_lane_runs_past_busy_bulk);
+    RUN_TEST(test_burst_fans_out_to_the_budget);
+    RUN_TEST(test_cancel_takes_back_queued_jobs);
+    RUN_TEST(test_budget_zero_falls_back_to_libuv);
+    RUN_TEST(test_completions_are_batched);
+    RUN_TEST(test_teardown_settles_every_job);
+    RUN_TEST(test_idle_threads_exit);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
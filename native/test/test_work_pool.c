@@ -0,0 +1,141 @@
+/**
+ * @file native/test/test_work_pool.c
+ * @brief Unit tests for work_pool.c: size classes, reuse, per-class caps,
+ *        oversize requests and the counters behind workPoolStats
+ */
+
+#include "test_runtime.h"
+#include "../src/common/work_pool.c"
+
+static WorkPoolStats stats_now(void) {
+    WorkPoolStats stats;
+    work_pool_stats(&stats);
+    return stats;
+}
+
+static int test_freed_blocks_are_reused_zeroed(void) {
+    WorkPoolStats before = stats_now();
+    uint8_t* first = (uint8_t*)work_pool_calloc(1, 48);
+    TEST_ASSERT_NOT_NULL(first, "allocated");
+    WorkPoolStats after = stats_now();
+    TEST_ASSERT_EQ(after.misses - before.misses, 1, "a cold class misses");
+    TEST_ASSERT_EQ(((uintptr_t)first) % 16, 0, "16-byte aligned");
+
+    memset(first, 0xAB, 64);
+    work_pool_free(first);
+    TEST_ASSERT_EQ(stats_now().cached - before.cached, 1, "freed block cached");
+
+    uint8_t* second = (uint8_t*)work_pool_calloc(8, 8);
+    after = stats_now();
+    TEST_ASSERT(second == first, "same class hands the block back");
+    TEST_ASSERT_EQ(after.hits - before.hits, 1, "a hit");
+    TEST_ASSERT_EQ(after.cached - before.cached, 0, "off the free list");
+    for (int i = 0; i < 64; i++) {
+        TEST_ASSERT(second[i] == 0, "zeroed like calloc");
+    }
+    work_pool_free(second);
+    return 1;
+}
+
+static int test_classes_are_kept_apart(void) {
+    void* small = work_pool_calloc(1, 64);
+    void* larger = work_pool_calloc(1, 65);
+    WorkHeader* small_header = (WorkHeader*)small - 1;
+    WorkHeader* larger_header = (WorkHeader*)larger - 1;
+    TEST_ASSERT_EQ(small_header->info.size_class, 0, "64 bytes fits the first class");
+    TEST_ASSERT_EQ(larger_header->info.size_class, 1, "65 bytes takes the next");
+    work_pool_free(larger);
+
+    void* again = work_pool_calloc(1, 10);
+    TEST_ASSERT(again != larger, "a small request does not take a larger class's block");
+    work_pool_free(again);
+    work_pool_free(small);
+    return 1;
+}
+
+static int test_oversize_falls_through(void) {
+    WorkPoolStats before = stats_now();
+    void* big = work_pool_calloc(1, 1025);
+    TEST_ASSERT_NOT_NULL(big, "allocated");
+    TEST_ASSERT_EQ(((WorkHeader*)big - 1)->info.size_class, WORK_POOL_UNPOOLED, "no class");
+    work_pool_free(big);
+    WorkPoolStats after = stats_now();
+    TEST_ASSERT_EQ(after.oversize - before.oversize, 1, "counted as oversize");
+    TEST_ASSERT(after.hits == before.hits && after.misses == before.misses, "not a hit or a miss");
+    TEST_ASSERT_EQ(after.cached, before.cached, "never cached");
+
+    TEST_ASSERT_NULL(work_pool_calloc(SIZE_MAX / 2, 4), "overflow refused");
+    work_pool_free(NULL);
+    return 1;
+}
+
+static int test_free_lists_are_capped(void) {
+    enum { COUNT = 40 };
+    WorkClass* cls = &work_classes[4];
+    void* blocks[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        blocks[i] = work_pool_calloc(1, 1024);
+    }
+    WorkPoolStats before = stats_now();
+    for (int i = 0; i < COUNT; i++) {
+        work_pool_free(blocks[i]);
+    }
+    TEST_ASSERT_EQ(cls->cached, cls->max_cached, "the class keeps at most its cap");
+    TEST_ASSERT_EQ(stats_now().cached - before.cached, cls->max_cached, "the rest went back to the heap");
+    return 1;
+}
+
+#define WORKER_ROUNDS 5000
+
+static void pool_worker(void* arg) {
+    (void)arg;
+    void* held[4];
+    for (int round = 0; round < WORKER_ROUNDS; round++) {
+        for (int i = 0; i < 4; i++) {
+            held[i] = work_pool_calloc(1, (size_t)(32 << i));
+        }
+        for (int i = 0; i < 4; i++) {
+            work_pool_free(held[i]);
+        }
+    }
+}
+
+static int test_counters_under_threads(void) {
+    enum { THREADS = 4 };
+    WorkPoolStats before = stats_now();
+    uv_thread_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        TEST_ASSERT_EQ(uv_thread_create(&threads[i], pool_worker, NULL), 0, "thread started");
+    }
+    for (int i = 0; i < THREADS; i++) {
+        uv_thread_join(&threads[i]);
+    }
+    WorkPoolStats after = stats_now();
+    uint64_t calls = (after.hits - before.hits) + (after.misses - before.misses);
+    TEST_ASSERT(calls == (uint64_t)THREADS * WORKER_ROUNDS * 4, "every allocation is a hit or a miss");
+    TEST_ASSERT(after.hits - before.hits > calls / 2, "a warm pool mostly hits");
+
+    uint32_t cached = 0;
+    uint32_t cap = 0;
+    for (size_t i = 0; i < WORK_CLASS_COUNT; i++) {
+        cached += work_classes[i].cached;
+        cap += work_classes[i].max_cached;
+    }
+    TEST_ASSERT_EQ(after.cached, cached, "cached matches the free lists");
+    TEST_ASSERT(cached <= cap, "within the caps");
+    return 1;
+}
+
+int main(void) {
+    TEST_SUITE_BEGIN("Work Pool Tests");
+
+    RUN_TEST(test_freed_blocks_are_reused_zeroed);
+    RUN_TEST(test_classes_are_kept_apart);
+    RUN_TEST(test_oversize_falls_through);
+    RUN_TEST(test_free_lists_are_capped);
+    RUN_TEST(test_counters_under_threads);
+
+    TEST_SUITE_END();
+
+    return tests_failed > 0 ? 1 : 0;
+}
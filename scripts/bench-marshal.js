@@ -0,0 +1,155 @@
+#!/usr/bin/env node
+/**
+ * Run the N-API marshalling microbenchmarks (native/bench).
+ *
+ * Builds the fake libuplink with `make fake-uplink` (the common helpers
+ * link against libuplink) and the bench addon with node-gyp, then times
+ * each case: a warmup run, then BENCH_ROUNDS rounds of BENCH_ITERATIONS
+ * calls, reporting the median round. The submission cases (bench.asyncCases)
+ * queue no-op jobs and are timed until the last one has completed.
+ *
+ * Results are written as JSON to build/bench/marshal-<commit>.json, or to
+ * --out <file>. With --baseline <file> each case is also compared with an
+ * earlier results file.
+ *
+ * Usage: npm run bench:marshal [-- --out file] [-- --baseline file] [case...]
+ * Tuning: BENCH_ITERATIONS (default 200000), BENCH_ROUNDS (default 5)
+ */
+
+'use strict';
+
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+
+const projectDir = path.resolve(__dirname, '..');
+const benchDir = path.join(projectDir, 'native', 'bench');
+
+const METADATA = {
+  'content-type': 'image/jpeg',
+  'cache-control': 'max-age=3600',
+  'x-owner': 'photos-service',
+  'x-checksum': '9f86d081884c7d659a2feaa0c55ad015',
+};
+
+/** Same layout as packMetadata() in src/native/metadata.ts */
+function packMetadata(metadata) {
+  const entries = Object.entries(metadata).map(([k, v]) => [Buffer.from(k), Buffer.from(v)]);
+  const table = Buffer.alloc(4 + entries.length * 8);
+  table.writeUInt32LE(entries.length, 0);
+  entries.forEach(([k, v], i) => {
+    table.writeUInt32LE(k.length, 4 + i * 8);
+    table.writeUInt32LE(v.length, 8 + i * 8);
+  });
+  return Buffer.concat([table, ...entries.flat()]);
+}
+
+/** Inputs for the cases that parse a JS value */
+const INPUTS = {
+  extract_metadata_entries_from_js: METADATA,
+  extract_metadata_entries_packed: packMetadata(METADATA),
+  extract_string_required: 'photos/2024/summer/IMG_0001.jpg',
+};
+
+function parseArgs(argv) {
+  const options = { out: null, baseline: null, cases: [] };
+  for (let i = 0; i < argv.length; i++) {
+    if (argv[i] === '--out' || argv[i] === '--baseline') {
+      options[argv[i].slice(2)] = argv[++i];
+    } else {
+      options.cases.push(argv[i]);
+    }
+  }
+  return options;
+}
+
+function run(command, args, cwd) {
+  const result = spawnSync(command, args, { cwd, stdio: 'inherit' });
+  if (result.status !== 0) {
+    process.exit(result.status || 1);
+  }
+}
+
+function commitOf() {
+  const result = spawnSync('git', ['rev-parse', '--short', 'HEAD'], { cwd: projectDir, encoding: 'utf8' });
+  return result.status === 0 ? result.stdout.trim() : 'unknown';
+}
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+if (process.platform === 'win32') {
+  console.error('[bench:marshal] the fake libuplink is POSIX only');
+  process.exit(1);
+}
+
+const options = parseArgs(process.argv.slice(2));
+run('make', ['fake-uplink'], projectDir);
+run(path.join(projectDir, 'node_modules', '.bin', 'node-gyp'), ['rebuild'], benchDir);
+
+process.env.UPLINK_LOG_LEVEL = process.env.UPLINK_LOG_LEVEL || 'error';
+const bench = require(path.join(benchDir, 'build', 'Release', 'bench_marshal.node'));
+bench.initErrorClasses();
+
+const iterations = Number(process.env.BENCH_ITERATIONS || 200000);
+const rounds = Number(process.env.BENCH_ROUNDS || 5);
+const cases = options.cases.length > 0 ? options.cases : [...bench.cases, ...bench.asyncCases];
+
+async function runCase(name) {
+  const input = INPUTS[name];
+  const runOnce = bench.asyncCases.includes(name)
+    ? (count) => bench.runAsync(name, count)
+    : (count) => bench.run(name, count, input);
+  await runOnce(Math.max(1, Math.floor(iterations / 10)));
+  const samples = [];
+  for (let i = 0; i < rounds; i++) {
+    samples.push(await runOnce(iterations));
+  }
+  return {
+    nsPerOp: median(samples.map((s) => s.nsPerOp)),
+    allocsPerOp: median(samples.map((s) => s.allocsPerOp)),
+  };
+}
+
+async function main() {
+  const results = {};
+  for (const name of cases) {
+    results[name] = await runCase(name);
+  }
+
+  const commit = commitOf();
+  const report = {
+    commit,
+    date: new Date().toISOString(),
+    node: process.version,
+    platform: `${process.platform}-${process.arch}`,
+    iterations,
+    rounds,
+    results,
+  };
+
+  const out = options.out || path.join(projectDir, 'build', 'bench', `marshal-${commit}.json`);
+  fs.mkdirSync(path.dirname(out), { recursive: true });
+  fs.writeFileSync(out, JSON.stringify(report, null, 2) + '\n');
+
+  const baseline = options.baseline ? JSON.parse(fs.readFileSync(options.baseline, 'utf8')).results : {};
+  for (const [name, result] of Object.entries(results)) {
+    let line = `${name.padEnd(36)} ${result.nsPerOp.toFixed(1).padStart(10)} ns/op ${result.allocsPerOp
+      .toFixed(2)
+      .padStart(8)} allocs/op`;
+    const before = baseline[name];
+    if (before) {
+      const change = ((result.nsPerOp - before.nsPerOp) / before.nsPerOp) * 100;
+      line += `  ${change >= 0 ? '+' : ''}${change.toFixed(1)}% ns, ${before.allocsPerOp.toFixed(2)} allocs before`;
+    }
+    console.log(line);
+  }
+  console.log(`\nResults written to ${path.relative(projectDir, out)}`);
+}
+
+main().catch((err) => {
+  console.error(err);
+  process.exit(1);
+});
@@ -0,0 +1,59 @@
+#!/usr/bin/env node
+/**
+ * Run the offline benchmark suite against the in-memory fake libuplink.
+ *
+ * Builds the fake with `make fake-uplink`, then starts the suite with the
+ * fake in front of the real library, so only the binding is measured:
+ *   Linux: LD_PRELOAD (the addon is linked against libuplink by soname)
+ *   macOS: DYLD_LIBRARY_PATH (the addon loads @rpath/libuplink.dylib)
+ * UPLINK_LIBRARY_PATH points the addon's own loader at the same file.
+ *
+ * Usage: npm run bench [-- transfer|metadata]
+ *        npm run bench:load [-- uplink-bench options]
+ * `--load` runs the `uplink-bench` load generator (src/bench/cli.ts)
+ * instead of the suite, with a fake access grant unless one is given.
+ * Tuning: FAKE_UPLINK_LATENCY_MS, FAKE_UPLINK_BANDWIDTH_MBPS,
+ *         FAKE_UPLINK_PAGE_SIZE, BENCH_SECONDS, BENCH_JSON=1
+ */
+
+'use strict';
+
+const { spawnSync } = require('child_process');
+const path = require('path');
+
+const projectDir = path.resolve(__dirname, '..');
+
+if (process.platform === 'win32') {
+  console.error('[bench] the fake libuplink is POSIX only');
+  process.exit(1);
+}
+
+const build = spawnSync('make', ['fake-uplink'], { cwd: projectDir, stdio: 'inherit' });
+if (build.status !== 0) {
+  process.exit(build.status || 1);
+}
+
+const libName = process.platform === 'darwin' ? 'libuplink.dylib' : 'libuplink.so';
+const fakeDir = path.join(projectDir, 'build', 'fake');
+const env = {
+  ...process.env,
+  UPLINK_LIBRARY_PATH: path.join(fakeDir, libName),
+  UPLINK_LOG_LEVEL: process.env.UPLINK_LOG_LEVEL || 'error',
+};
+if (process.platform === 'darwin') {
+  env.DYLD_LIBRARY_PATH = [fakeDir, process.env.DYLD_LIBRARY_PATH].filter(Boolean).join(':');
+} else {
+  env.LD_PRELOAD = [path.join(fakeDir, libName), process.env.LD_PRELOAD].filter(Boolean).join(' ');
+}
+
+let args = [path.join('test', 'benchmarks', 'index.ts'), ...process.argv.slice(2)];
+if (process.argv[2] === '--load') {
+  const loadArgs = process.argv.slice(3);
+  if (!loadArgs.some((arg) => arg === '--access' || arg.startsWith('--access='))) {
+    loadArgs.unshift('--access', 'fake:bench.satellite:7777');
+  }
+  args = [path.join('src', 'bench', 'cli.ts'), ...loadArgs];
+}
+
+const run = spawnSync('npx', ['ts-node', ...args], { cwd: projectDir, env, stdio: 'inherit' });
+process.exit(run.status === null ? 1 : run.status);
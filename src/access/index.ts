@@ -5,7 +5,16 @@
  * Provides TypeScript wrapper for access operations.
  */
 
-import type { Permission, SharePrefix, UplinkConfig, EncryptionKey } from '../types';
+import type {
+  Permission,
+  SharePrefix,
+  ShareSpec,
+  ShareManyOptions,
+  AccessSerializeOptions,
+  SerializedAccess,
+  ProjectConfig,
+  EncryptionKey,
+} from '../types';
 import { ProjectResultStruct } from '../project';
 import { native } from '../native';
 
@@ -28,6 +37,44 @@ interface NativeSharePrefix {
   prefix?: string;
 }
 
+/** Convert a permission to native format */
+function toNativePermission(permission: Permission): NativePermission {
+  return {
+    allowDownload: permission.allowDownload ?? false,
+    allowUpload: permission.allowUpload ?? false,
+    allowList: permission.allowList ?? false,
+    allowDelete: permission.allowDelete ?? false,
+    notBefore: permission.notBefore ? Math.floor(permission.notBefore.getTime() / 1000) : undefined,
+    notAfter: permission.notAfter ? Math.floor(permission.notAfter.getTime() / 1000) : undefined,
+  };
+}
+
+/** Convert share prefixes to native format */
+function toNativePrefixes(prefixes: SharePrefix[]): NativeSharePrefix[] {
+  return prefixes.map((p) => ({
+    bucket: p.bucket,
+    prefix: p.prefix,
+  }));
+}
+
+/**
+ * Wrap what a native request or share resolved to, per `serialize`
+ * @internal
+ */
+export function toAccessResult(
+  value: unknown,
+  serialize: AccessSerializeOptions['serialize']
+): AccessResultStruct | SerializedAccess | string {
+  if (serialize === 'only') {
+    return value as string;
+  }
+  if (serialize === true) {
+    const result = value as { access: unknown; serialized: string };
+    return { access: new AccessResultStruct(result.access), serialized: result.serialized };
+  }
+  return new AccessResultStruct(value);
+}
+
 /**
  * Represents an access grant to Storj.
  *
@@ -80,11 +127,42 @@ export class AccessResultStruct {
     return native.accessSerialize(this._handle);
   }
 
+  /**
+   * Get the satellite address synchronously.
+   *
+   * Reads the parsed grant without network I/O, so it runs inline instead
+   * of on the thread pool. Errors are as for `satelliteAddress()`, thrown.
+   *
+   * @returns The satellite address URL
+   */
+  satelliteAddressSync(): string {
+    this.validateNotClosed();
+    return native.accessSatelliteAddressSync(this._handle);
+  }
+
+  /**
+   * Serialize the access grant synchronously.
+   *
+   * Encoding needs no network I/O, so it runs inline instead of on the
+   * thread pool. Errors are as for `serialize()`, thrown.
+   *
+   * @returns The serialized access grant string
+   */
+  serializeSync(): string {
+    this.validateNotClosed();
+    return native.accessSerializeSync(this._handle);
+  }
+
   /**
    * Create a new access grant with restricted permissions.
    *
+   * With `{ serialize: true }` the grant is also serialized in the same
+   * native call, and `{ serialize: 'only' }` returns just the serialized
+   * grant without creating an access handle.
+   *
    * @param permission - The permissions to grant
    * @param prefixes - The bucket/prefix combinations to restrict to
+   * @param options - Whether to serialize the new grant
    * @returns Promise resolving to a new restricted AccessResultStruct
    *
    * @example
@@ -93,31 +171,84 @@ export class AccessResultStruct {
    *   { allowDownload: true, allowList: true },
    *   [{ bucket: 'my-bucket', prefix: 'public/' }]
    * );
+   *
+   * const grant = await access.share(
+   *   { allowDownload: true },
+   *   [{ bucket: 'my-bucket', prefix: 'public/' }],
+   *   { serialize: 'only' }
+   * );
    * ```
    */
-  async share(permission: Permission, prefixes: SharePrefix[]): Promise<AccessResultStruct> {
+  share(permission: Permission, prefixes: SharePrefix[]): Promise<AccessResultStruct>;
+  share(
+    permission: Permission,
+    prefixes: SharePrefix[],
+    options: { serialize: true }
+  ): Promise<SerializedAccess>;
+  share(permission: Permission, prefixes: SharePrefix[], options: { serialize: 'only' }): Promise<string>;
+  share(
+    permission: Permission,
+    prefixes: SharePrefix[],
+    options?: AccessSerializeOptions
+  ): Promise<AccessResultStruct | SerializedAccess | string>;
+  async share(
+    permission: Permission,
+    prefixes: SharePrefix[],
+    options?: AccessSerializeOptions
+  ): Promise<AccessResultStruct | SerializedAccess | string> {
     this.validateNotClosed();
 
-    // Convert permission to native format
-    const nativePermission: NativePermission = {
-      allowDownload: permission.allowDownload ?? false,
-      allowUpload: permission.allowUpload ?? false,
-      allowList: permission.allowList ?? false,
-      allowDelete: permission.allowDelete ?? false,
-      notBefore: permission.notBefore
-        ? Math.floor(permission.notBefore.getTime() / 1000)
-        : undefined,
-      notAfter: permission.notAfter ? Math.floor(permission.notAfter.getTime() / 1000) : undefined,
-    };
-
-    // Convert prefixes to native format
-    const nativePrefixes: NativeSharePrefix[] = prefixes.map((p) => ({
-      bucket: p.bucket,
-      prefix: p.prefix,
-    }));
-
-    const newHandle = await native.accessShare(this._handle, nativePermission, nativePrefixes);
-    return new AccessResultStruct(newHandle);
+    const result = await native.accessShare(
+      this._handle,
+      toNativePermission(permission),
+      toNativePrefixes(prefixes),
+      options
+    );
+    return toAccessResult(result, options?.serialize);
+  }
+
+  /**
+   * Create many restricted access grants and serialize them.
+   *
+   * All specs are marshalled in one native call and derived on a bounded
+   * number of native threads; each result is already serialized, so no
+   * handle or `serialize()` round trip is needed per grant. The first
+   * spec that fails rejects the whole call.
+   *
+   * @param specs - Permission and prefixes of each grant
+   * @param options - Derivation concurrency (default 4, at most 16)
+   * @returns Promise resolving to the serialized grants, in spec order
+   *
+   * @example
+   * ```typescript
+   * const grants = await access.shareMany(
+   *   tenants.map((t) => ({
+   *     permission: { allowDownload: true, allowUpload: true, allowList: true },
+   *     prefixes: [{ bucket: 'tenants', prefix: `${t.id}/` }],
+   *   }))
+   * );
+   * ```
+   */
+  async shareMany(specs: ShareSpec[], options?: ShareManyOptions): Promise<string[]> {
+    this.validateNotClosed();
+
+    if (!Array.isArray(specs)) {
+      throw new TypeError('specs must be an array');
+    }
+    const nativeSpecs = specs.map((spec) => {
+      if (spec == null || typeof spec !== 'object' || spec.permission == null) {
+        throw new TypeError('each spec needs a permission');
+      }
+      if (!Array.isArray(spec.prefixes)) {
+        throw new TypeError('prefixes must be an array');
+      }
+      return {
+        permission: toNativePermission(spec.permission),
+        prefixes: toNativePrefixes(spec.prefixes),
+      };
+    });
+
+    return native.accessShareMany(this._handle, nativeSpecs, options);
   }
 
   /**
@@ -174,10 +305,24 @@ export class AccessResultStruct {
   /**
    * Open a project with custom configuration.
    *
+   * `maxConcurrentTransfers` and `maxConcurrentMetadataOps` bound how many
+   * calls of the project run at once; the rest wait in the binding.
+   * `maxUploadBytesPerSecond` and `maxDownloadBytesPerSecond` cap its
+   * throughput, and `bandwidthWeight` sets its share of the process-wide
+   * limits.
+   *
    * @param config - Configuration options
    * @returns Promise resolving to a ProjectResultStruct
+   * @throws RangeError if a concurrency limit is negative or above 65536, a bandwidth
+   *   limit is negative, or the weight is above 1000
+   *
+   * @example
+   * ```typescript
+   * const project = await access.configOpenProject({ maxConcurrentTransfers: 8 });
+   * await Promise.all(keys.map((key) => project.uploadFile('my-bucket', key, `./out/${key}`)));
+   * ```
    */
-  async configOpenProject(config: UplinkConfig): Promise<ProjectResultStruct> {
+  async configOpenProject(config: ProjectConfig): Promise<ProjectResultStruct> {
     this.validateNotClosed();
 
     if (config == null || typeof config !== 'object') {
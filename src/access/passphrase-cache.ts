@@ -0,0 +1,246 @@
+/**
+ * @file access/passphrase-cache.ts
+ * @description Cache of serialized grants from passphrase access requests
+ *
+ * Requesting an access with a passphrase dials the satellite and runs
+ * the key derivation, so a worker that restarts often rebuilds the same
+ * root access again and again. The cache keeps the serialized grant
+ * under an HMAC-SHA256 tag of satellite, API key, passphrase and config,
+ * bounded by entry count and TTL; none of the inputs is stored.
+ *
+ * With `file` set, entries also survive restarts in that file, encrypted
+ * with AES-256-GCM under a key derived from `fileKey`. The tag key is
+ * derived from `fileKey` too, so tags stay stable across runs; without a
+ * file it is random per cache.
+ */
+
+import * as crypto from 'crypto';
+import { promises as fs } from 'fs';
+import type { PassphraseAccessCacheOptions, PassphraseAccessCacheStats } from '../types';
+
+/** Default bound on cached grants */
+const DEFAULT_MAX_ENTRIES = 256;
+
+/** Default time a grant stays cached */
+const DEFAULT_TTL_MS = 60 * 60 * 1000;
+
+/** Leading byte of the cache file, bumped on format changes */
+const FILE_VERSION = 1;
+
+const IV_LENGTH = 12;
+const AUTH_TAG_LENGTH = 16;
+
+interface CacheEntry {
+  readonly serialized: string;
+  readonly expiresAt: number;
+}
+
+function deriveKey(fileKey: Buffer, info: string): Buffer {
+  return Buffer.from(crypto.hkdfSync('sha256', fileKey, Buffer.alloc(0), info, 32));
+}
+
+/**
+ * Bounded cache of serialized grants keyed by request inputs.
+ */
+export class PassphraseAccessCache {
+  private readonly _maxEntries: number;
+  private readonly _ttlMs: number;
+  private readonly _file: string | undefined;
+  private readonly _tagKey: Buffer;
+  private readonly _fileKey: Buffer | undefined;
+  /** Insertion order is LRU order, oldest first */
+  private readonly _entries = new Map<string, CacheEntry>();
+  private _loading: Promise<void> | null = null;
+  private _saving: Promise<void> = Promise.resolve();
+  private _hits: number = 0;
+  private _misses: number = 0;
+  private _evictions: number = 0;
+  private _expirations: number = 0;
+  private _fileErrors: number = 0;
+
+  /**
+   * @param options - Bounds, and the optional encrypted file
+   * @throws TypeError if a bound is invalid, or `file` is set without a
+   *   32-byte `fileKey`
+   */
+  constructor(options: PassphraseAccessCacheOptions = {}) {
+    const { maxEntries = DEFAULT_MAX_ENTRIES, ttlMs = DEFAULT_TTL_MS, file, fileKey } = options;
+    if (!Number.isInteger(maxEntries) || maxEntries < 1) {
+      throw new TypeError('maxEntries must be a positive integer');
+    }
+    if (!(ttlMs >= 0)) {
+      throw new TypeError('ttlMs must not be negative');
+    }
+    if (file !== undefined) {
+      if (typeof file !== 'string' || file === '') {
+        throw new TypeError('file must be a non-empty string');
+      }
+      if (!Buffer.isBuffer(fileKey) || fileKey.length !== 32) {
+        throw new TypeError('fileKey must be a 32-byte Buffer when file is set');
+      }
+    }
+    this._maxEntries = maxEntries;
+    this._ttlMs = ttlMs;
+    this._file = file;
+    if (file !== undefined && fileKey !== undefined) {
+      this._tagKey = deriveKey(fileKey, 'uplink-nodejs passphrase access cache tag');
+      this._fileKey = deriveKey(fileKey, 'uplink-nodejs passphrase access cache file');
+    } else {
+      this._tagKey = crypto.randomBytes(32);
+    }
+  }
+
+  /**
+   * Tag of a request; each part is length-prefixed so parts cannot run
+   * into each other.
+   */
+  tag(parts: readonly string[]): string {
+    const hmac = crypto.createHmac('sha256', this._tagKey);
+    for (const part of parts) {
+      const bytes = Buffer.from(part, 'utf8');
+      const length = Buffer.alloc(4);
+      length.writeUInt32BE(bytes.length);
+      hmac.update(length);
+      hmac.update(bytes);
+    }
+    return hmac.digest('hex');
+  }
+
+  /**
+   * Look up the grant of @p tag, counting a hit or a miss.
+   *
+   * @returns The serialized grant, or undefined
+   */
+  async get(tag: string): Promise<string | undefined> {
+    await this.load();
+    const entry = this._entries.get(tag);
+    if (entry !== undefined && this.isExpired(entry, Date.now())) {
+      this._entries.delete(tag);
+      this._expirations++;
+    } else if (entry !== undefined) {
+      this._entries.delete(tag);
+      this._entries.set(tag, entry);
+      this._hits++;
+      return entry.serialized;
+    }
+    this._misses++;
+    return undefined;
+  }
+
+  /**
+   * Cache @p serialized under @p tag, persisting when a file is set.
+   * File errors are counted, not thrown.
+   */
+  async set(tag: string, serialized: string): Promise<void> {
+    await this.load();
+    this._entries.delete(tag);
+    this._entries.set(tag, {
+      serialized,
+      expiresAt: this._ttlMs === 0 ? Infinity : Date.now() + this._ttlMs,
+    });
+    while (this._entries.size > this._maxEntries) {
+      const oldest = this._entries.keys().next().value as string;
+      this._entries.delete(oldest);
+      this._evictions++;
+    }
+    await this.save();
+  }
+
+  /** Drop the grant of @p tag, e.g. after it failed to parse */
+  async delete(tag: string): Promise<void> {
+    if (this._entries.delete(tag)) {
+      await this.save();
+    }
+  }
+
+  /**
+   * Get the cache counters.
+   *
+   * @returns Hit, miss, eviction, expiry and file error counts
+   */
+  stats(): PassphraseAccessCacheStats {
+    return {
+      hits: this._hits,
+      misses: this._misses,
+      evictions: this._evictions,
+      expirations: this._expirations,
+      entries: this._entries.size,
+      maxEntries: this._maxEntries,
+      ttlMs: this._ttlMs,
+      fileErrors: this._fileErrors,
+    };
+  }
+
+  private isExpired(entry: CacheEntry, now: number): boolean {
+    return now >= entry.expiresAt;
+  }
+
+  /** Read the file once; a missing or unreadable file starts empty */
+  private load(): Promise<void> {
+    if (this._loading === null) {
+      this._loading = this._file === undefined ? Promise.resolve() : this.readFile(this._file);
+    }
+    return this._loading;
+  }
+
+  private async readFile(file: string): Promise<void> {
+    let data: Buffer;
+    try {
+      data = await fs.readFile(file);
+    } catch (err) {
+      if ((err as NodeJS.ErrnoException).code !== 'ENOENT') {
+        this._fileErrors++;
+      }
+      return;
+    }
+    try {
+      if (data[0] !== FILE_VERSION || data.length < 1 + IV_LENGTH + AUTH_TAG_LENGTH) {
+        throw new Error('unknown cache file format');
+      }
+      const iv = data.subarray(1, 1 + IV_LENGTH);
+      const authTag = data.subarray(1 + IV_LENGTH, 1 + IV_LENGTH + AUTH_TAG_LENGTH);
+      const decipher = crypto.createDecipheriv('aes-256-gcm', this._fileKey as Buffer, iv);
+      decipher.setAuthTag(authTag);
+      const plain = Buffer.concat([decipher.update(data.subarray(1 + IV_LENGTH + AUTH_TAG_LENGTH)), decipher.final()]);
+      const rows = JSON.parse(plain.toString('utf8')) as Array<[string, number, string]>;
+      const now = Date.now();
+      for (const [tag, expiresAt, serialized] of rows) {
+        const entry = { serialized, expiresAt: expiresAt ?? Infinity };
+        if (!this.isExpired(entry, now)) {
+          this._entries.set(tag, entry);
+        }
+      }
+    } catch {
+      // Wrong key, corrupt or foreign file: start empty and overwrite it
+      this._fileErrors++;
+    }
+  }
+
+  /** Write all entries, one write at a time, replacing the file atomically */
+  private save(): Promise<void> {
+    const file = this._file;
+    if (file === undefined) {
+      return Promise.resolve();
+    }
+    this._saving = this._saving.then(async () => {
+      const rows = [...this._entries].map(([tag, entry]) => [
+        tag,
+        entry.expiresAt === Infinity ? null : entry.expiresAt,
+        entry.serialized,
+      ]);
+      const iv = crypto.randomBytes(IV_LENGTH);
+      const cipher = crypto.createCipheriv('aes-256-gcm', this._fileKey as Buffer, iv);
+      const encrypted = Buffer.concat([cipher.update(JSON.stringify(rows), 'utf8'), cipher.final()]);
+      const data = Buffer.concat([Buffer.from([FILE_VERSION]), iv, cipher.getAuthTag(), encrypted]);
+      const temp = `${file}.${process.pid}.tmp`;
+      try {
+        await fs.writeFile(temp, data, { mode: 0o600 });
+        await fs.rename(temp, file);
+      } catch {
+        this._fileErrors++;
+        await fs.unlink(temp).catch(() => undefined);
+      }
+    });
+    return this._saving;
+  }
+}
@@ -0,0 +1,192 @@
+#!/usr/bin/env node
+/**
+ * @file bench/cli.ts
+ * @description `uplink-bench`: mixed-workload load generator
+ *
+ * Usage: npx uplink-bench --access <grant> [options]
+ *
+ * Runs `runLoad()` against a real satellite, or against the fake
+ * libuplink when the addon is loaded with it (`npm run bench:load`), and
+ * prints throughput, per-operation latency percentiles and the native
+ * gauges of each step. `--sweep` doubles the concurrency each step and
+ * reports the knee, where more concurrency stopped adding throughput.
+ */
+
+/* eslint-disable no-console */
+
+import { Uplink } from '../uplink';
+import { runLoad, parseLoadMix, findKnee, LOAD_OPS, LoadOptions, LoadStepResult } from './load';
+
+const USAGE = `Usage: uplink-bench --access <grant> [options]
+
+  --access <grant>      Serialized access grant (default: $UPLINK_ACCESS)
+  --bucket <name>       Bucket to run in, created if missing (default: uplink-bench)
+  --mix <ops>           Operation weights (default: put=20,get=50,stat=20,list=5,delete=5)
+  --size <bytes>        Object size, e.g. 4k, 1m, or a range 1k-64k (default: 4k)
+  --preload <n>         Objects written before the first step (default: 1000)
+  --concurrency <list>  Operations in flight, one step per value, e.g. 8,32,128 (default: 16)
+  --sweep <max>         Steps of 1, 2, 4, ... up to max in flight; reports the knee
+  --rate <ops/s>        Open loop: start operations at this rate, at most --concurrency in flight
+  --duration <s>        Measured seconds per step (default: 10)
+  --warmup <s>          Unmeasured seconds before each step (default: 2)
+  --keep                Leave the objects written by the run in place
+  --json                Print one JSON document with every step
+  --help                Show this help
+`;
+
+const FLAGS = new Set(['keep', 'json', 'help']);
+
+function parseArgs(argv: readonly string[]): Map<string, string> {
+  const args = new Map<string, string>();
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (!arg.startsWith('--')) {
+      throw new TypeError(`unexpected argument '${arg}'`);
+    }
+    const eq = arg.indexOf('=');
+    const name = arg.slice(2, eq === -1 ? undefined : eq);
+    if (FLAGS.has(name)) {
+      args.set(name, 'true');
+    } else if (eq !== -1) {
+      args.set(name, arg.slice(eq + 1));
+    } else if (i + 1 < argv.length) {
+      args.set(name, argv[++i]);
+    } else {
+      throw new TypeError(`--${name} needs a value`);
+    }
+  }
+  return args;
+}
+
+/** Parse `4096`, `4k`, `1m` or `1g` */
+function parseBytes(text: string): number {
+  const match = /^(\d+(?:\.\d+)?)([kmg]?)$/i.exec(text.trim());
+  if (match === null) {
+    throw new TypeError(`invalid size '${text}'`);
+  }
+  const scale = { '': 1, k: 1024, m: 1024 ** 2, g: 1024 ** 3 }[match[2].toLowerCase() as '' | 'k' | 'm' | 'g'];
+  return Math.round(Number(match[1]) * scale);
+}
+
+function parsePositive(text: string, name: string): number {
+  const value = Number(text);
+  if (!(value > 0)) {
+    throw new TypeError(`--${name} must be a positive number`);
+  }
+  return value;
+}
+
+function parseCount(text: string, name: string): number {
+  const value = Number(text);
+  if (!Number.isInteger(value) || value < 0) {
+    throw new TypeError(`--${name} must be a non-negative integer`);
+  }
+  return value;
+}
+
+function buildOptions(args: Map<string, string>): Omit<LoadOptions, 'bucket' | 'prefix'> {
+  const size = args.get('size') ?? '4k';
+  const range = size.split('-');
+  let concurrency = (args.get('concurrency') ?? '16').split(',').map((c) => parsePositive(c, 'concurrency'));
+  const sweep = args.get('sweep');
+  if (sweep !== undefined) {
+    const max = parsePositive(sweep, 'sweep');
+    concurrency = [];
+    for (let c = 1; c < max; c *= 2) {
+      concurrency.push(c);
+    }
+    concurrency.push(max);
+  }
+  const rate = args.get('rate');
+  return {
+    mix: parseLoadMix(args.get('mix') ?? 'put=20,get=50,stat=20,list=5,delete=5'),
+    objectSize: range.length === 2 ? [parseBytes(range[0]), parseBytes(range[1])] : parseBytes(size),
+    preload: parseCount(args.get('preload') ?? '1000', 'preload'),
+    concurrency,
+    rate: rate === undefined ? undefined : parsePositive(rate, 'rate'),
+    durationMs: parsePositive(args.get('duration') ?? '10', 'duration') * 1000,
+    warmupMs: parseCount(args.get('warmup') ?? '2', 'warmup') * 1000,
+  };
+}
+
+const ms = (value: number): string => value.toFixed(2).padStart(9);
+
+function printStep(step: LoadStepResult): void {
+  const mbps = step.bytesPerSecond / 1e6;
+  const target = step.rate === undefined ? '' : ` (target ${step.rate} ops/s)`;
+  console.log(
+    `\nconcurrency ${step.concurrency}${target}: ${step.opsPerSecond.toFixed(1)} ops/s, ${mbps.toFixed(1)} MB/s, ${step.errors} errors`
+  );
+  console.log('  op           ops  skipped   errors   p50 ms   p90 ms   p99 ms   max ms');
+  for (const op of LOAD_OPS) {
+    const stats = step.operations[op];
+    if (stats === undefined) {
+      continue;
+    }
+    console.log(
+      `  ${op.padEnd(8)}${String(stats.ops).padStart(8)}${String(stats.skipped).padStart(9)}${String(stats.errors).padStart(9)}` +
+        `${ms(stats.p50Ms)}${ms(stats.p90Ms)}${ms(stats.p99Ms)}${ms(stats.maxMs)}` +
+        (stats.firstError === undefined ? '' : `  first error: ${stats.firstError}`)
+    );
+  }
+  const { peaks } = step;
+  console.log(
+    `  native peaks: ${peaks.threads} threads, bulk ${peaks.bulkRunning} running / ${peaks.bulkQueued} queued, ` +
+      `metadata ${peaks.metadataRunning} running / ${peaks.metadataQueued} queued, ` +
+      `${(peaks.pinnedBytes / 1e6).toFixed(1)} MB pinned`
+  );
+  const native = Object.entries(step.metrics.operations)
+    .filter(([, op]) => op.calls > 0)
+    .sort(([, a], [, b]) => b.calls - a.calls)
+    .map(([name, op]) => `${name} ${op.calls} calls, queued p99 ${op.queued.p99Ms.toFixed(2)} ms, execute p99 ${op.execute.p99Ms.toFixed(2)} ms`);
+  for (const line of native) {
+    console.log(`  native ${line}`);
+  }
+}
+
+async function main(): Promise<void> {
+  const args = parseArgs(process.argv.slice(2));
+  if (args.has('help')) {
+    console.log(USAGE);
+    return;
+  }
+  const grant = args.get('access') ?? process.env.UPLINK_ACCESS;
+  if (grant === undefined || grant === '') {
+    throw new TypeError('an access grant is required: pass --access or set UPLINK_ACCESS');
+  }
+  const options = buildOptions(args);
+  const json = args.has('json');
+  const bucket = args.get('bucket') ?? 'uplink-bench';
+  const prefix = `run-${Date.now().toString(36)}-${process.pid}/`;
+
+  const uplink = new Uplink();
+  const access = await uplink.parseAccess(grant);
+  const project = await access.openProject();
+  try {
+    await project.ensureBucket(bucket);
+    if (!json) {
+      console.log(`uplink-bench: ${bucket}/${prefix}, ${options.concurrency.length} step(s) of ${options.durationMs / 1000} s`);
+    }
+    const steps = await runLoad(project, { ...options, bucket, prefix, onStep: json ? undefined : printStep });
+    const knee = options.concurrency.length > 1 ? findKnee(steps) : -1;
+    if (json) {
+      console.log(JSON.stringify({ bucket, prefix, steps, knee: knee === -1 ? null : steps[knee].concurrency }));
+    } else if (options.concurrency.length > 1) {
+      console.log(
+        knee === -1
+          ? '\nthroughput still scaling at the last step; extend the sweep'
+          : `\nknee: concurrency ${steps[knee].concurrency} (${steps[knee].opsPerSecond.toFixed(1)} ops/s)`
+      );
+    }
+    if (!args.has('keep')) {
+      await project.deletePrefix(bucket, prefix);
+    }
+  } finally {
+    await project.close();
+  }
+}
+
+main().catch((err: unknown) => {
+  console.error(err instanceof Error ? err.message : err);
+  process.exit(1);
+});
@@ -0,0 +1,462 @@
+/**
+ * @file bench/load.ts
+ * @description Mixed-workload load generator behind `uplink-bench`
+ *
+ * Drives a weighted mix of putObject, getObject, statObject, listObjects
+ * and deleteObject against one project, either closed loop (a fixed
+ * number of operations in flight) or open loop (a target arrival rate).
+ * In open loop each operation's latency is measured from when it was
+ * due, not when a worker got to it, so a saturated binding shows up as
+ * latency instead of being hidden by a slower arrival rate.
+ */
+
+import type { MetricsGauges, MetricsSnapshot } from '../types';
+import type { ProjectResultStruct } from '../project';
+import { native } from '../native';
+
+/** Operations of a load mix */
+export type LoadOp = 'put' | 'get' | 'stat' | 'list' | 'delete';
+
+/** Relative weight of each operation; missing operations are not run */
+export type LoadMix = Partial<Record<LoadOp, number>>;
+
+/** Every operation, in report order */
+export const LOAD_OPS: readonly LoadOp[] = ['put', 'get', 'stat', 'list', 'delete'];
+
+/** Objects are spread over this many sub-prefixes so a list reads one short page */
+const LOAD_SHARDS = 64;
+
+/** Interval between native gauge samples during a step */
+const GAUGE_SAMPLE_MS = 100;
+
+/**
+ * Options of `runLoad()`
+ */
+export interface LoadOptions {
+  /** Bucket to run against; it must exist */
+  bucket: string;
+  /** Prefix all objects are written below */
+  prefix: string;
+  /** Operation weights */
+  mix: LoadMix;
+  /** Object size in bytes, or `[min, max]` for uniformly random sizes */
+  objectSize: number | [number, number];
+  /** Objects written before the first step for get, stat and delete to find */
+  preload: number;
+  /** Operations in flight, one step per value */
+  concurrency: number[];
+  /** Target operations per second for every step (open loop); unset runs closed loop */
+  rate?: number;
+  /** Measured time per step */
+  durationMs: number;
+  /** Unmeasured time before each step */
+  warmupMs: number;
+  /** Called after each step */
+  onStep?: (step: LoadStepResult) => void;
+}
+
+/**
+ * Latency summary of one operation in one step
+ */
+export interface LoadOpStats {
+  /** Operations completed */
+  ops: number;
+  /** Gets, stats and deletes not run because no object was left */
+  skipped: number;
+  /** Operations that failed; not counted in `ops` or the latencies */
+  errors: number;
+  /** First error seen, if any */
+  firstError?: string;
+  meanMs: number;
+  p50Ms: number;
+  p90Ms: number;
+  p99Ms: number;
+  maxMs: number;
+}
+
+/**
+ * Peaks of the native gauges sampled during a step
+ */
+export interface LoadGaugePeaks {
+  threads: number;
+  metadataQueued: number;
+  metadataRunning: number;
+  bulkQueued: number;
+  bulkRunning: number;
+  pinnedBytes: number;
+}
+
+/**
+ * Result of one load step
+ */
+export interface LoadStepResult {
+  concurrency: number;
+  /** Target rate of an open-loop step */
+  rate?: number;
+  seconds: number;
+  ops: number;
+  errors: number;
+  opsPerSecond: number;
+  /** Object bytes written and read per second */
+  bytesPerSecond: number;
+  operations: Partial<Record<LoadOp, LoadOpStats>>;
+  /** Native metrics of the step (`getMetrics()` reset at the step's start) */
+  metrics: MetricsSnapshot;
+  /** Highest gauge values sampled while the step ran */
+  peaks: LoadGaugePeaks;
+}
+
+/** Keys written by the run that have not been deleted */
+class KeyPool {
+  private readonly _prefix: string;
+  private readonly _keys: string[] = [];
+  private _next: number = 0;
+
+  constructor(prefix: string) {
+    this._prefix = prefix;
+  }
+
+  /** A fresh key, spread over the shards */
+  fresh(): string {
+    const seq = this._next++;
+    return `${this._prefix}${seq % LOAD_SHARDS}/${seq}`;
+  }
+
+  add(key: string): void {
+    this._keys.push(key);
+  }
+
+  pick(): string | undefined {
+    return this._keys.length === 0 ? undefined : this._keys[Math.floor(Math.random() * this._keys.length)];
+  }
+
+  /** Remove and return a random key */
+  take(): string | undefined {
+    if (this._keys.length === 0) {
+      return undefined;
+    }
+    const index = Math.floor(Math.random() * this._keys.length);
+    const key = this._keys[index];
+    this._keys[index] = this._keys[this._keys.length - 1];
+    this._keys.pop();
+    return key;
+  }
+}
+
+/** Latency samples of one operation in one step */
+class OpSamples {
+  private readonly _latencies: number[] = [];
+  private _skipped: number = 0;
+  private _errors: number = 0;
+  private _firstError: string | undefined;
+
+  /** Record a completed operation, or one skipped (null) for want of an object */
+  record(latencyMs: number | null): void {
+    if (latencyMs === null) {
+      this._skipped++;
+    } else {
+      this._latencies.push(latencyMs);
+    }
+  }
+
+  fail(err: Error): void {
+    this._errors++;
+    this._firstError ??= err.message;
+  }
+
+  summarize(): LoadOpStats {
+    const sorted = Float64Array.from(this._latencies).sort();
+    const at = (q: number): number => (sorted.length === 0 ? 0 : sorted[Math.min(sorted.length - 1, Math.floor(q * sorted.length))]);
+    const sum = sorted.reduce((total, value) => total + value, 0);
+    return {
+      ops: sorted.length,
+      skipped: this._skipped,
+      errors: this._errors,
+      firstError: this._firstError,
+      meanMs: sorted.length === 0 ? 0 : sum / sorted.length,
+      p50Ms: at(0.5),
+      p90Ms: at(0.9),
+      p99Ms: at(0.99),
+      maxMs: sorted.length === 0 ? 0 : sorted[sorted.length - 1],
+    };
+  }
+}
+
+/**
+ * Parse a mix such as `put=20,get=60,stat=15,list=5`.
+ *
+ * @throws TypeError on unknown operations or weights that are not positive
+ */
+export function parseLoadMix(text: string): LoadMix {
+  const mix: LoadMix = {};
+  for (const part of text.split(',')) {
+    const [name, weight] = part.split('=');
+    const op = name.trim() as LoadOp;
+    if (!LOAD_OPS.includes(op)) {
+      throw new TypeError(`unknown operation '${name}' in mix; expected ${LOAD_OPS.join(', ')}`);
+    }
+    const value = weight === undefined ? 1 : Number(weight);
+    if (!(value > 0)) {
+      throw new TypeError(`weight of ${op} must be a positive number`);
+    }
+    mix[op] = value;
+  }
+  return mix;
+}
+
+/** Weighted picker over a mix */
+function mixPicker(mix: LoadMix): () => LoadOp {
+  const ops = LOAD_OPS.filter((op) => (mix[op] ?? 0) > 0);
+  if (ops.length === 0) {
+    throw new TypeError('mix must give at least one operation a positive weight');
+  }
+  const cumulative: number[] = [];
+  let total = 0;
+  for (const op of ops) {
+    total += mix[op] ?? 0;
+    cumulative.push(total);
+  }
+  return () => {
+    const roll = Math.random() * total;
+    const index = cumulative.findIndex((bound) => roll < bound);
+    return ops[index === -1 ? ops.length - 1 : index];
+  };
+}
+
+function sizePicker(size: LoadOptions['objectSize']): () => number {
+  const [min, max] = Array.isArray(size) ? size : [size, size];
+  if (!Number.isInteger(min) || !Number.isInteger(max) || min < 0 || max < min) {
+    throw new RangeError('objectSize must be a non-negative integer or an ascending [min, max] pair');
+  }
+  return () => min + Math.floor(Math.random() * (max - min + 1));
+}
+
+const sleep = (ms: number): Promise<void> => new Promise((resolve) => setTimeout(resolve, ms));
+
+/** State of one `runLoad()` call */
+class LoadRun {
+  private readonly _project: ProjectResultStruct;
+  private readonly _options: LoadOptions;
+  private readonly _pickOp: () => LoadOp;
+  private readonly _pickSize: () => number;
+  private readonly _payload: Buffer;
+  private readonly _keys: KeyPool;
+
+  constructor(project: ProjectResultStruct, options: LoadOptions) {
+    if (options.rate !== undefined && !(options.rate > 0)) {
+      throw new RangeError('rate must be positive');
+    }
+    if (options.concurrency.length === 0 || options.concurrency.some((c) => !Number.isInteger(c) || c < 1)) {
+      throw new RangeError('concurrency must be a list of positive integers');
+    }
+    this._project = project;
+    this._options = options;
+    this._pickOp = mixPicker(options.mix);
+    this._pickSize = sizePicker(options.objectSize);
+    const maxSize = Array.isArray(options.objectSize) ? options.objectSize[1] : options.objectSize;
+    this._payload = Buffer.alloc(maxSize, 0x5a);
+    this._keys = new KeyPool(options.prefix);
+  }
+
+  /** Write the preload objects, at the width of the widest step */
+  async preload(): Promise<void> {
+    const { preload } = this._options;
+    let started = 0;
+    const width = Math.min(Math.max(...this._options.concurrency), preload);
+    await Promise.all(
+      Array.from({ length: width }, async () => {
+        while (started < preload) {
+          started++;
+          await this.runOp('put');
+        }
+      })
+    );
+  }
+
+  /** Warm up, then measure one step */
+  async step(concurrency: number): Promise<LoadStepResult> {
+    if (this._options.warmupMs > 0) {
+      await this.drive(concurrency, this._options.warmupMs, null);
+    }
+    native.getMetrics({ reset: true });
+    const samples = new Map<LoadOp, OpSamples>();
+    const peaks: LoadGaugePeaks = {
+      threads: 0,
+      metadataQueued: 0,
+      metadataRunning: 0,
+      bulkQueued: 0,
+      bulkRunning: 0,
+      pinnedBytes: 0,
+    };
+    const sampler = setInterval(() => samplePeaks(peaks, (native.getMetrics() as MetricsSnapshot).gauges), GAUGE_SAMPLE_MS);
+    const started = process.hrtime.bigint();
+    let bytes: number;
+    try {
+      bytes = await this.drive(concurrency, this._options.durationMs, samples);
+    } finally {
+      clearInterval(sampler);
+    }
+    const seconds = Number(process.hrtime.bigint() - started) / 1e9;
+    const metrics = native.getMetrics() as MetricsSnapshot;
+    samplePeaks(peaks, metrics.gauges);
+
+    const operations: Partial<Record<LoadOp, LoadOpStats>> = {};
+    let ops = 0;
+    let errors = 0;
+    for (const op of LOAD_OPS) {
+      const stats = samples.get(op)?.summarize();
+      if (stats !== undefined) {
+        operations[op] = stats;
+        ops += stats.ops;
+        errors += stats.errors;
+      }
+    }
+    return {
+      concurrency,
+      rate: this._options.rate,
+      seconds,
+      ops,
+      errors,
+      opsPerSecond: ops / seconds,
+      bytesPerSecond: bytes / seconds,
+      operations,
+      metrics,
+      peaks,
+    };
+  }
+
+  /**
+   * Keep @p concurrency workers busy for @p durationMs. Each takes the
+   * next arrival slot, waits for it in open loop, and runs one operation.
+   * Latencies go to @p samples when given.
+   *
+   * @returns Object bytes moved
+   */
+  private async drive(concurrency: number, durationMs: number, samples: Map<LoadOp, OpSamples> | null): Promise<number> {
+    const interval = this._options.rate === undefined ? 0 : 1000 / this._options.rate;
+    const start = performance.now();
+    const end = start + durationMs;
+    let slot = 0;
+    let bytes = 0;
+    const worker = async (): Promise<void> => {
+      for (;;) {
+        const now = performance.now();
+        const due = interval > 0 ? start + slot++ * interval : now;
+        if (due >= end || now >= end) {
+          return;
+        }
+        if (due - now >= 1) {
+          await sleep(due - now);
+        }
+        const op = this._pickOp();
+        // Open loop measures from the arrival slot, unless the op starts just ahead of it
+        const from = Math.min(due, performance.now());
+        try {
+          const moved = await this.runOp(op);
+          bytes += moved ?? 0;
+          if (samples !== null) {
+            opSamples(samples, op).record(moved === null ? null : performance.now() - from);
+          }
+        } catch (err) {
+          if (samples !== null) {
+            opSamples(samples, op).fail(err as Error);
+          }
+        }
+      }
+    };
+    await Promise.all(Array.from({ length: concurrency }, worker));
+    return bytes;
+  }
+
+  /**
+   * Run one operation
+   *
+   * @returns Object bytes moved, or null when there was no object to work on
+   */
+  private async runOp(op: LoadOp): Promise<number | null> {
+    const project = this._project;
+    const { bucket, prefix } = this._options;
+    if (op === 'put') {
+      const key = this._keys.fresh();
+      const size = this._pickSize();
+      await project.putObject(bucket, key, this._payload.subarray(0, size));
+      this._keys.add(key);
+      return size;
+    }
+    if (op === 'list') {
+      const shard = Math.floor(Math.random() * LOAD_SHARDS);
+      await project.listObjects(bucket, { prefix: `${prefix}${shard}/`, recursive: true, fields: ['key'] });
+      return 0;
+    }
+    const key = op === 'delete' ? this._keys.take() : this._keys.pick();
+    if (key === undefined) {
+      return null;
+    }
+    if (op === 'get') {
+      return (await project.getObject(bucket, key)).data.length;
+    }
+    if (op === 'stat') {
+      await project.statObject(bucket, key);
+    } else {
+      await project.deleteObject(bucket, key);
+    }
+    return 0;
+  }
+}
+
+/**
+ * Run one load step per concurrency value and report each.
+ *
+ * Objects are written below `options.prefix`; callers remove them
+ * afterwards, e.g. with `deletePrefix()`. Native metrics are reset at the
+ * start of every step, so do not run this beside other work whose
+ * metrics matter.
+ *
+ * @param project - Open project
+ * @param options - Mix, sizes, concurrency steps, rate and durations
+ * @returns One result per step, in order
+ */
+export async function runLoad(project: ProjectResultStruct, options: LoadOptions): Promise<LoadStepResult[]> {
+  const run = new LoadRun(project, options);
+  await run.preload();
+  const results: LoadStepResult[] = [];
+  for (const concurrency of options.concurrency) {
+    const step = await run.step(concurrency);
+    results.push(step);
+    options.onStep?.(step);
+  }
+  return results;
+}
+
+function opSamples(samples: Map<LoadOp, OpSamples>, op: LoadOp): OpSamples {
+  let entry = samples.get(op);
+  if (entry === undefined) {
+    entry = new OpSamples();
+    samples.set(op, entry);
+  }
+  return entry;
+}
+
+function samplePeaks(peaks: LoadGaugePeaks, gauges: MetricsGauges): void {
+  peaks.threads = Math.max(peaks.threads, gauges.threads);
+  peaks.metadataQueued = Math.max(peaks.metadataQueued, gauges.lanes.metadata.queued);
+  peaks.metadataRunning = Math.max(peaks.metadataRunning, gauges.lanes.metadata.running);
+  peaks.bulkQueued = Math.max(peaks.bulkQueued, gauges.lanes.bulk.queued);
+  peaks.bulkRunning = Math.max(peaks.bulkRunning, gauges.lanes.bulk.running);
+  peaks.pinnedBytes = Math.max(peaks.pinnedBytes, gauges.pinnedBytes);
+}
+
+/**
+ * The step after which more concurrency stopped paying: the last step
+ * before the first one that added less than 10% throughput.
+ *
+ * @returns Index into @p steps, or -1 when throughput kept scaling
+ */
+export function findKnee(steps: readonly LoadStepResult[]): number {
+  for (let i = 1; i < steps.length; i++) {
+    if (steps[i].opsPerSecond < steps[i - 1].opsPerSecond * 1.1) {
+      return i - 1;
+    }
+  }
+  return -1;
+}
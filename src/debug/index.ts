@@ -6,6 +6,7 @@
  */
 
 import { native } from '../native';
+import type { HandleStats, NativeStats, WorkPoolStats } from '../types';
 
 /**
  * Check if the internal handle universe is empty.
@@ -83,3 +84,57 @@ export const uplinkInternalUniverseIsEmpty = internalUniverseIsEmpty;
 export async function testThrowTypedError(code: number, message: string): Promise<never> {
   return native.testThrowTypedError(code, message);
 }
+
+/**
+ * Count live native handles in this thread, by type.
+ *
+ * A handle is counted from creation until its JS object is garbage
+ * collected. Sampling this periodically gives a cheap leak gauge: a
+ * count that keeps growing means handles are retained somewhere.
+ *
+ * @returns Live counts per handle type, and their total
+ *
+ * @example
+ * ```typescript
+ * import { handleStats } from 'uplink-nodejs';
+ *
+ * setInterval(() => metrics.gauge('uplink.handles', handleStats().total), 10000);
+ * ```
+ */
+export function handleStats(): HandleStats {
+  return native.handleStats() as HandleStats;
+}
+
+/**
+ * Counters of the native pool that backs stream read and write calls.
+ *
+ * Each `read()`/`write()` borrows its native work data from this pool, so
+ * once a stream is warm `misses` stops growing and every call is a hit.
+ *
+ * @returns Pool counters since process start
+ */
+export function workPoolStats(): WorkPoolStats {
+  return native.workPoolStats() as WorkPoolStats;
+}
+
+/**
+ * Snapshot native memory: the addon's heap accounting plus whether
+ * uplink-c still holds any Go-side handles.
+ *
+ * Every malloc in the addon is counted, so `liveBytes` sampled around a
+ * batch of operations gives native bytes per operation, and charted over
+ * time shows native growth the V8 heap never sees.
+ *
+ * @returns Allocation counters since process start and the universe check
+ *
+ * @example
+ * ```typescript
+ * import { nativeStats } from 'uplink-nodejs';
+ *
+ * setInterval(async () => metrics.gauge('uplink.native_bytes', (await nativeStats()).liveBytes), 10000);
+ * ```
+ */
+export async function nativeStats(): Promise<NativeStats> {
+  const universeEmpty = await native.internalUniverseIsEmpty();
+  return { ...(native.nativeAllocStats() as Omit<NativeStats, 'universeEmpty'>), universeEmpty };
+}
@@ -0,0 +1,122 @@
+/**
+ * @file download/archive.ts
+ * @description Readable tar or zip stream over many objects
+ *
+ * Provides ArchiveReadStream, returned by `ProjectResultStruct.createArchiveStream()`.
+ */
+
+import { Readable } from 'stream';
+import { ArchiveStreamOptions } from '../types';
+import { native } from '../native';
+
+/** Default size of each native read (1 MiB) */
+const DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+/** Default number of chunks buffered ahead of the consumer */
+const DEFAULT_READ_AHEAD = 4;
+
+/**
+ * Readable stream of a tar or zip archive of many objects.
+ *
+ * Objects are fetched ahead on native threads, `concurrency` at a time,
+ * while entries are emitted strictly in order. Small objects are held in
+ * memory up to `maxBufferedBytes`; larger ones are streamed straight
+ * into the archive as their turn comes. An object that cannot be read
+ * destroys the stream with its error once the archive reaches it.
+ * Destroying the stream, or aborting `options.signal`, stops the fetches
+ * and closes the downloads.
+ *
+ * @example
+ * ```typescript
+ * project.createArchiveStream('photos', '2024/', { format: 'zip' }).pipe(res);
+ * ```
+ */
+export class ArchiveReadStream extends Readable {
+  private readonly _chunkSize: number;
+  private _archiveHandle: unknown;
+  private _reading: boolean = false;
+  private _wantMore: boolean = false;
+
+  /**
+   * Creates a new ArchiveReadStream; fetching starts at once.
+   *
+   * @param projectHandle - Native project handle
+   * @param bucket - Bucket name
+   * @param keysOrPrefix - Object keys, or a prefix whose objects are archived
+   * @param options - Format, concurrency, memory budget and chunk size
+   * @internal
+   */
+  constructor(
+    projectHandle: unknown,
+    bucket: string,
+    keysOrPrefix: string[] | string,
+    options: ArchiveStreamOptions = {}
+  ) {
+    const chunkSize = options.chunkSize ?? DEFAULT_CHUNK_SIZE;
+    if (!Number.isInteger(chunkSize) || chunkSize <= 0) {
+      throw new TypeError('chunkSize must be a positive integer');
+    }
+    const { format, concurrency, maxBufferedBytes } = options;
+    const handle = native.archiveOpen(projectHandle, bucket, keysOrPrefix, { format, concurrency, maxBufferedBytes });
+
+    super({ highWaterMark: options.highWaterMark ?? chunkSize * DEFAULT_READ_AHEAD, signal: options.signal });
+    this._chunkSize = chunkSize;
+    this._archiveHandle = handle;
+  }
+
+  /** @internal */
+  override _read(_size: number): void {
+    if (this._reading) {
+      this._wantMore = true;
+      return;
+    }
+    this._pump();
+  }
+
+  /** @internal */
+  override _destroy(error: Error | null, callback: (error?: Error | null) => void): void {
+    const handle = this._archiveHandle;
+    this._archiveHandle = null;
+    if (handle !== null) {
+      // A read in flight still completes; its bytes are dropped
+      native.archiveClose(handle);
+    }
+    callback(error);
+  }
+
+  /** Read chunks until the archive ends or push() reports the buffer is full */
+  private _pump(): void {
+    const handle = this._archiveHandle;
+    if (handle === null) {
+      return;
+    }
+    this._reading = true;
+    this._wantMore = false;
+    // Pooled native slab; it returns to the pool when the consumer drops the chunk
+    const chunk = native.allocReadBuffer(this._chunkSize);
+    native.archiveRead(handle, chunk).then(
+      ({ bytesRead, eof }) => {
+        if (this.destroyed) {
+          this._reading = false;
+          return;
+        }
+        let more = true;
+        if (bytesRead > 0) {
+          more = this.push(bytesRead === chunk.length ? chunk : chunk.subarray(0, bytesRead));
+        }
+        this._reading = false;
+        if (eof) {
+          this.push(null);
+        } else if (more || this._wantMore) {
+          this._pump();
+        }
+      },
+      (err: Error) => {
+        this._reading = false;
+        if (!this.destroyed) {
+          this.destroy(err);
+        }
+      }
+    );
+  }
+}
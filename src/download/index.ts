@@ -5,8 +5,18 @@
  * Provides the DownloadResultStruct class for downloading objects from Storj buckets.
  */
 
-import { ObjectInfo, ReadResult } from '../types';
+import {
+  DownloadParallelOptions,
+  DownloadParallelResult,
+  DownloadTeeResult,
+  ObjectInfo,
+  ReadIntoOptions,
+  ReadOptions,
+  ReadResult,
+  SignalOptions,
+} from '../types';
 import { native } from '../native';
+import { withSignal } from '../native/cancel';
 
 /**
  * Represents an active download operation.
@@ -51,11 +61,14 @@ export class DownloadResultStruct {
    *
    * On EOF the promise rejects with an error that has `bytesRead` attached.
    * The caller should catch this, copy any partial data, then stop reading.
+   * With `{ eofAsValue: true }` the final read instead resolves with
+   * `eof: true`, and the promise only rejects on real errors.
    *
    * @param buffer - Buffer to read data into
    * @param length - Maximum number of bytes to read
+   * @param options - Optional read options
    * @returns Promise resolving to the number of bytes read
-   * @throws Error if download is closed, read fails, or EOF is reached
+   * @throws Error if download is closed, read fails, or EOF is reached (without `eofAsValue`)
    *
    * @example
    * ```typescript
@@ -76,9 +89,16 @@ export class DownloadResultStruct {
    *     break;
    *   }
    * }
+   *
+   * // EOF as a value: no exception at the end of every object
+   * for (;;) {
+   *   const { bytesRead, eof } = await download.read(chunk, chunk.length, { eofAsValue: true });
+   *   sink.write(chunk.subarray(0, bytesRead));
+   *   if (eof) break;
+   * }
    * ```
    */
-  async read(buffer: Buffer, length: number): Promise<ReadResult> {
+  async read(buffer: Buffer, length: number, options?: ReadOptions): Promise<ReadResult> {
     if (this._closed) {
       throw new Error('Download is closed');
     }
@@ -96,14 +116,123 @@ export class DownloadResultStruct {
     }
 
     // Native makes a single uplink_download_read call.
-    // On success: resolves with { bytesRead: number }
+    // On success: resolves with { bytesRead: number } (plus eof with eofAsValue)
     // On EOF/error: rejects with error (error.bytesRead has partial bytes read)
-    const result = (await native.downloadRead(this._downloadHandle, buffer, length)) as {
-      bytesRead: number;
-    };
+    if (options?.eofAsValue) {
+      const result = await native.downloadRead(this._downloadHandle, buffer, length, {
+        eofAsValue: true,
+      });
+      return { bytesRead: result.bytesRead, eof: result.eof === true };
+    }
+
+    const result = await native.downloadRead(this._downloadHandle, buffer, length);
     return { bytesRead: result.bytesRead };
   }
 
+  /**
+   * Fills a buffer from the download.
+   *
+   * Unlike `read()`, partial reads are looped over natively, so the promise
+   * resolves once `length` bytes have been read or the object ends. EOF is
+   * reported as `eof: true` instead of a rejection. An aborted `signal`
+   * stops the loop between partial reads; the `CanceledError` carries
+   * `bytesRead`.
+   *
+   * @param buffer - Buffer to read data into
+   * @param length - Number of bytes to read
+   * @param options - Optional abort signal
+   * @returns Promise resolving to bytes read and whether EOF was reached
+   * @throws Error if download is closed or the read fails
+   *
+   * @example
+   * ```typescript
+   * const chunk = Buffer.alloc(4 * 1024 * 1024);
+   * for (;;) {
+   *   const { bytesRead, eof } = await download.readFull(chunk, chunk.length);
+   *   sink.write(chunk.subarray(0, bytesRead));
+   *   if (eof) break;
+   * }
+   * ```
+   */
+  async readFull(buffer: Buffer, length: number, options?: SignalOptions): Promise<ReadResult> {
+    if (this._closed) {
+      throw new Error('Download is closed');
+    }
+
+    if (!Buffer.isBuffer(buffer)) {
+      throw new TypeError('First argument must be a Buffer');
+    }
+
+    if (typeof length !== 'number' || length < 0) {
+      throw new TypeError('Length must be a non-negative number');
+    }
+
+    if (length > buffer.length) {
+      throw new RangeError('Length exceeds buffer size');
+    }
+
+    const result = await withSignal(options, (o) => native.downloadReadFull(this._downloadHandle, buffer, length, o));
+    return { bytesRead: result.bytesRead, eof: result.eof };
+  }
+
+  /**
+   * Reads into a region of a caller-owned buffer.
+   *
+   * Native code writes straight into `buffer` at `offset`, so reusing one
+   * large buffer needs no `subarray()` view per read. Any Buffer,
+   * TypedArray or DataView works. EOF is reported as `eof: true`; with
+   * `fill: true` partial reads are looped over natively like `readFull()`.
+   *
+   * @param buffer - Buffer or typed array to read into
+   * @param offset - Byte offset into `buffer`
+   * @param length - Maximum number of bytes to read
+   * @param options - Optional fill flag and abort signal
+   * @returns Promise resolving to bytes read and whether EOF was reached
+   * @throws Error if download is closed or the read fails
+   *
+   * @example
+   * ```typescript
+   * const slab = new Uint8Array(size);
+   * let filled = 0;
+   * for (;;) {
+   *   const { bytesRead, eof } = await download.readInto(slab, filled, slab.length - filled);
+   *   filled += bytesRead;
+   *   if (eof) break;
+   * }
+   * ```
+   */
+  async readInto(
+    buffer: ArrayBufferView,
+    offset: number,
+    length: number,
+    options?: ReadIntoOptions
+  ): Promise<ReadResult> {
+    if (this._closed) {
+      throw new Error('Download is closed');
+    }
+
+    if (!ArrayBuffer.isView(buffer)) {
+      throw new TypeError('First argument must be a Buffer or TypedArray');
+    }
+
+    if (!Number.isInteger(offset) || offset < 0) {
+      throw new TypeError('Offset must be a non-negative integer');
+    }
+
+    if (typeof length !== 'number' || length < 0) {
+      throw new TypeError('Length must be a non-negative number');
+    }
+
+    if (offset + length > buffer.byteLength) {
+      throw new RangeError('Length exceeds buffer size');
+    }
+
+    const result = await withSignal(options, (o) =>
+      native.downloadReadInto(this._downloadHandle, buffer, offset, length, o)
+    );
+    return { bytesRead: result.bytesRead, eof: result.eof };
+  }
+
   /**
    * Gets information about the downloaded object.
    *
@@ -122,23 +251,30 @@ export class DownloadResultStruct {
       throw new Error('Download is closed');
     }
 
-    const result = (await native.downloadInfo(this._downloadHandle)) as {
-      key: string;
-      isPrefix: boolean;
-      system: { created: number; expires: number; contentLength: number };
-      custom: Record<string, string>;
-    };
-
-    return {
-      key: result.key,
-      isPrefix: result.isPrefix,
-      system: {
-        created: result.system.created,
-        expires: result.system.expires > 0 ? result.system.expires : null,
-        contentLength: result.system.contentLength,
-      },
-      custom: (result.custom as Record<string, string> | null) ?? {},
-    };
+    // Returned as converted: `expires` is already null without an expiry,
+    // and copying `custom` would decode metadata the caller may never read
+    return (await native.downloadInfo(this._downloadHandle)) as ObjectInfo;
+  }
+
+  /**
+   * Per-sink outcome of a download opened with `tee`, in sink order.
+   *
+   * Digests cover the bytes read so far; call it after `close()` for the
+   * final state of file sinks. Empty without `tee`.
+   *
+   * @example
+   * ```typescript
+   * const download = await project.downloadObject('my-bucket', 'video.mp4', {
+   *   tee: [{ path: '/backup/video.mp4' }, { hash: 'sha256' }],
+   * });
+   * // ... read to EOF ...
+   * await download.close();
+   * const [, hash] = download.teeResults();
+   * console.log('sha256', hash.digest);
+   * ```
+   */
+  teeResults(): DownloadTeeResult[] {
+    return native.downloadTeeResults(this._downloadHandle) as DownloadTeeResult[];
   }
 
   /**
@@ -168,3 +304,42 @@ export class DownloadResultStruct {
     this._closed = true;
   }
 }
+
+/**
+ * Download an object as concurrent ranged streams into a Buffer or file.
+ *
+ * Stats the object, splits it into `rangeSize` ranges, and downloads up
+ * to `concurrency` of them at once on native threads, each written into
+ * its own slot of the sink (retrying failed ranges), all behind a single
+ * promise. A Buffer sink must be at least as large as the object; a file
+ * sink is created or truncated. With `auto`, range size and ranges in
+ * flight are tuned as ranges finish and the chosen values are returned
+ * as `tuning`.
+ *
+ * @param projectHandle - Native project handle (`project._nativeHandle`)
+ * @param bucket - Bucket name
+ * @param key - Object key
+ * @param sink - Destination buffer or path of a local file
+ * @param options - Optional range size, concurrency, auto mode, retries, fsync flag, and abort signal
+ * @returns Promise resolving to the number of bytes written
+ *
+ * @example
+ * ```typescript
+ * await downloadParallel(project._nativeHandle, 'my-bucket', 'disk.img', '/restore/disk.img', {
+ *   rangeSize: 64 * 1024 * 1024,
+ *   concurrency: 8,
+ * });
+ * ```
+ */
+export async function downloadParallel(
+  projectHandle: unknown,
+  bucket: string,
+  key: string,
+  sink: Buffer | string,
+  options?: DownloadParallelOptions
+): Promise<DownloadParallelResult> {
+  if (!Buffer.isBuffer(sink) && (typeof sink !== 'string' || sink.length === 0)) {
+    throw new TypeError('sink must be a Buffer or a non-empty file path');
+  }
+  return withSignal(options, (o) => native.downloadParallel(projectHandle, bucket, key, sink, o));
+}
@@ -0,0 +1,201 @@
+/**
+ * @file download/stream.ts
+ * @description Readable stream over a Storj download
+ *
+ * Provides DownloadReadStream, returned by `ProjectResultStruct.createReadStream()`.
+ */
+
+import { Readable } from 'stream';
+import { ObjectInfo, ReadStreamOptions } from '../types';
+import { native } from '../native';
+import { signalToken, SignalToken, validateTimeout } from '../native/cancel';
+import { ProgressMeter } from '../native/progress';
+
+/** Default size of each native read (1 MiB) */
+const DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+/** Default number of chunks read ahead of the consumer */
+const DEFAULT_READ_AHEAD = 4;
+
+/**
+ * Readable stream that downloads an object with native read-ahead.
+ *
+ * Filling reads are issued back to back while the consumer
+ * handles earlier chunks, until `highWaterMark` bytes are buffered
+ * (`chunkSize * readAhead` by default). Reading resumes when the consumer
+ * drains the buffer, so backpressure propagates to the network. Reads on
+ * one download stay sequential, as uplink requires. Aborting
+ * `options.signal` stops the read in flight and destroys the stream;
+ * `options.timeoutMs` bounds the open and each read. `options.onProgress`
+ * is called as chunks arrive, coalesced like the native engines.
+ *
+ * @example
+ * ```typescript
+ * const stream = project.createReadStream('my-bucket', 'video.mp4', { readAhead: 8 });
+ * stream.pipe(res);
+ * ```
+ */
+export class DownloadReadStream extends Readable {
+  private readonly _projectHandle: unknown;
+  private readonly _bucket: string;
+  private readonly _key: string;
+  private readonly _options: ReadStreamOptions;
+  private readonly _chunkSize: number;
+  private _downloadHandle: unknown = null;
+  private _reading: Promise<void> | null = null;
+  private _wantMore: boolean = false;
+  private _token: SignalToken | null = null;
+  private readonly _progress: ProgressMeter | null;
+
+  /**
+   * Creates a new DownloadReadStream. The download is opened lazily.
+   *
+   * @param projectHandle - Native project handle
+   * @param bucket - Bucket name
+   * @param key - Object key
+   * @param options - Range, chunk size, and read-ahead options
+   * @internal
+   */
+  constructor(projectHandle: unknown, bucket: string, key: string, options: ReadStreamOptions = {}) {
+    const chunkSize = options.chunkSize ?? DEFAULT_CHUNK_SIZE;
+    const readAhead = options.readAhead ?? DEFAULT_READ_AHEAD;
+    if (!Number.isInteger(chunkSize) || chunkSize <= 0) {
+      throw new TypeError('chunkSize must be a positive integer');
+    }
+    if (!Number.isInteger(readAhead) || readAhead < 1) {
+      throw new TypeError('readAhead must be a positive integer');
+    }
+    validateTimeout(options.timeoutMs);
+    const progress = ProgressMeter.from(options);
+
+    super({ highWaterMark: options.highWaterMark ?? chunkSize * readAhead, signal: options.signal });
+    this._projectHandle = projectHandle;
+    this._bucket = bucket;
+    this._key = key;
+    this._options = options;
+    this._chunkSize = chunkSize;
+    this._progress = progress;
+  }
+
+  /** @internal */
+  override _construct(callback: (error?: Error | null) => void): void {
+    const { offset, length, verify, decompress, chunkCache, nativeReadAhead, hedge, retry, signal, timeoutMs } = this._options;
+    if (signal !== undefined && !signal.aborted) {
+      this._token = signalToken(signal);
+    }
+    const cancelToken = this._token?.cancelToken;
+    native
+      .downloadObject(this._projectHandle, this._bucket, this._key, { offset, length, verify, decompress, chunkCache, nativeReadAhead, hedge, retry, cancelToken, timeoutMs })
+      .then(async (result) => {
+        this._downloadHandle = (result as { downloadHandle: unknown }).downloadHandle;
+        if (this._progress !== null) {
+          // The requested range, clipped to the object, is the total. Decoded
+          // reads count original bytes, not the stored frames.
+          const info = (await native.downloadInfo(this._downloadHandle)) as ObjectInfo;
+          const rawSize = decompress !== false && info.custom?.codec ? Number(info.custom['codec-raw-size']) : NaN;
+          const size = Number.isFinite(rawSize) ? rawSize : info.system.contentLength;
+          const rest = Math.max(0, size - (offset ?? 0));
+          this._progress.setTotal(length !== undefined && length >= 0 ? Math.min(length, rest) : rest);
+        }
+      })
+      .then(
+        () => callback(),
+        (err: Error) => callback(err)
+      );
+  }
+
+  /** @internal */
+  override _read(_size: number): void {
+    if (this._reading) {
+      this._wantMore = true;
+      return;
+    }
+    this._pump();
+  }
+
+  /** @internal */
+  override _destroy(error: Error | null, callback: (error?: Error | null) => void): void {
+    const handle = this._downloadHandle;
+    this._downloadHandle = null;
+    if (this._token !== null) {
+      // Node may run this before our abort listener; stop the read in flight either way
+      native.cancelToken(this._token.cancelToken);
+      this._token.dispose();
+    }
+    if (handle === null) {
+      callback(error);
+      return;
+    }
+    // Close only once the read in flight, if any, has returned
+    (this._reading ?? Promise.resolve())
+      .then(() => native.closeDownload(handle))
+      .then(
+        () => callback(error),
+        (closeError: Error) => callback(error ?? closeError)
+      );
+  }
+
+  /**
+   * Read chunks until EOF or until push() reports the buffer is full.
+   * Reads go through the callback-style native read, which settles
+   * without a promise or result object per chunk.
+   */
+  private _pump(): void {
+    const handle = this._downloadHandle;
+    const cancelToken = this._token?.cancelToken;
+    const options = { fill: true, cancelToken, timeoutMs: this._options.timeoutMs };
+    let done!: () => void;
+    this._reading = new Promise((resolve) => (done = resolve));
+    const finish = (err?: Error): void => {
+      this._reading = null;
+      done();
+      if (err !== undefined) {
+        this.destroy(err);
+      }
+    };
+
+    const next = (): void => {
+      this._wantMore = false;
+      // Pooled native slab; it returns to the pool when the consumer drops the chunk
+      const chunk = native.allocReadBuffer(this._chunkSize);
+      const onRead = (err: Error | null, bytesRead: number, eof: boolean): void => {
+        if (err !== null) {
+          finish(err);
+          return;
+        }
+        if (this.destroyed) {
+          finish();
+          return;
+        }
+
+        let more = true;
+        if (bytesRead > 0) {
+          this._progress?.add(bytesRead);
+          more = this.push(bytesRead === chunk.length ? chunk : chunk.subarray(0, bytesRead));
+        }
+        if (eof) {
+          this._progress?.finish();
+          this.push(null);
+          finish();
+          return;
+        }
+        if (!more && !this._wantMore) {
+          finish();
+          return;
+        }
+        try {
+          next();
+        } catch (nextErr) {
+          finish(nextErr as Error);
+        }
+      };
+      native.downloadReadCb(handle, chunk, chunk.length, onRead, options);
+    };
+
+    try {
+      next();
+    } catch (err) {
+      finish(err as Error);
+    }
+  }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file download/web-stream.ts
+ * @description WHATWG byte stream over a Storj download
+ *
+ * Provides createWebReadStream, returned by `ProjectResultStruct.createWebReadStream()`.
+ */
+
+import { ReadableStream, ReadableByteStreamController } from 'stream/web';
+import { WebReadStreamOptions } from '../types';
+import { native } from '../native';
+import { signalToken, SignalToken, throwIfAborted, validateTimeout } from '../native/cancel';
+
+/** Default size of each native read without a consumer buffer (1 MiB) */
+const DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+/**
+ * Create a `ReadableStream` of type `'bytes'` over an object.
+ *
+ * With a BYOB reader each native read fills the consumer's view directly
+ * through `readInto()`, with no intermediate copy. Default readers
+ * get chunks of `chunkSize` bytes allocated by the stream. The download
+ * is opened when the stream starts and closed at EOF, on cancel, or on
+ * error. Aborting `options.signal` stops the read in flight and errors
+ * the stream; `options.timeoutMs` bounds the open and each read.
+ *
+ * @param projectHandle - Native project handle
+ * @param bucket - Bucket name
+ * @param key - Object key
+ * @param options - Range, chunk size, signal and timeout options
+ * @returns A byte stream of the object's bytes
+ * @throws TypeError if `chunkSize` or `timeoutMs` is invalid
+ * @internal
+ *
+ * @example
+ * ```typescript
+ * const reader = project.createWebReadStream('my-bucket', 'video.mp4').getReader({ mode: 'byob' });
+ * let view = new Uint8Array(1 << 20);
+ * for (;;) {
+ *   const { value, done } = await reader.read(view);
+ *   if (done) break;
+ *   sink.write(value);
+ *   view = new Uint8Array(value.buffer);
+ * }
+ * ```
+ */
+export function createWebReadStream(
+  projectHandle: unknown,
+  bucket: string,
+  key: string,
+  options: WebReadStreamOptions = {}
+): ReadableStream<Uint8Array> {
+  const chunkSize = options.chunkSize ?? DEFAULT_CHUNK_SIZE;
+  if (!Number.isInteger(chunkSize) || chunkSize <= 0) {
+    throw new TypeError('chunkSize must be a positive integer');
+  }
+  validateTimeout(options.timeoutMs);
+
+  const { offset, length, verify, decompress, chunkCache, nativeReadAhead, hedge, retry, signal, timeoutMs } = options;
+  let token: SignalToken | null = null;
+  let handle: unknown = null;
+  let reading: Promise<unknown> | null = null;
+
+  const release = async (): Promise<void> => {
+    const download = handle;
+    handle = null;
+    token?.dispose();
+    token = null;
+    if (download !== null) {
+      // Close only once the read in flight, if any, has returned
+      await (reading ?? Promise.resolve()).catch(() => undefined);
+      await native.closeDownload(download);
+    }
+  };
+
+  return new ReadableStream({
+    type: 'bytes',
+    autoAllocateChunkSize: chunkSize,
+
+    async start(): Promise<void> {
+      throwIfAborted(signal);
+      if (signal !== undefined) {
+        token = signalToken(signal);
+      }
+      try {
+        const result = await native.downloadObject(projectHandle, bucket, key, {
+          offset,
+          length,
+          verify,
+          decompress,
+          chunkCache,
+          nativeReadAhead,
+          hedge,
+          retry,
+          cancelToken: token?.cancelToken,
+          timeoutMs,
+        });
+        handle = (result as { downloadHandle: unknown }).downloadHandle;
+      } catch (err) {
+        await release();
+        throw err;
+      }
+    },
+
+    async pull(controller: ReadableByteStreamController): Promise<void> {
+      // autoAllocateChunkSize guarantees a request for default readers too
+      const request = controller.byobRequest!;
+      const view = request.view!;
+      let result: { bytesRead: number; eof: boolean };
+      try {
+        reading = native.downloadReadInto(handle, view, 0, view.byteLength, {
+          fill: true,
+          cancelToken: token?.cancelToken,
+          timeoutMs,
+        });
+        result = (await reading) as { bytesRead: number; eof: boolean };
+      } catch (err) {
+        reading = null;
+        await release().catch(() => undefined);
+        throw err;
+      }
+      reading = null;
+
+      if (result.bytesRead > 0) {
+        request.respond(result.bytesRead);
+      }
+      if (result.eof) {
+        await release();
+        controller.close();
+        // A BYOB read pending at close, whether this pull's unfilled request
+        // or one issued while the download was closing, must still be answered
+        controller.byobRequest?.respond(0);
+      }
+    },
+
+    async cancel(): Promise<void> {
+      if (token !== null) {
+        native.cancelToken(token.cancelToken);
+      }
+      await release();
+    },
+  });
+}
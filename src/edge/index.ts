@@ -10,6 +10,9 @@ import type {
   EdgeRegisterAccessOptions,
   EdgeCredentials,
   EdgeShareURLOptions,
+  EdgeShareURLEntry,
+  EdgeCacheOptions,
+  EdgeCacheStats,
 } from '../types';
 import { native } from '../native';
 
@@ -63,6 +66,42 @@ export async function edgeRegisterAccess(
   return native.edgeRegisterAccess(config, accessHandle, options) as Promise<EdgeCredentials>;
 }
 
+/**
+ * Reuse edgeRegisterAccess() credentials across calls.
+ *
+ * Registrations are keyed by the serialized access, the auth service
+ * address and `isPublic`, so registering the same access again (from any
+ * handle) resolves from memory instead of a round trip to the auth
+ * service until `ttlMs` elapses. The cache is process-wide; calling this
+ * again reconfigures it and drops all entries.
+ *
+ * @param options - Entry limit and lifetime
+ *
+ * @example
+ * ```typescript
+ * enableEdgeCache({ ttlMs: 15 * 60 * 1000 });
+ * ```
+ */
+export function enableEdgeCache(options?: EdgeCacheOptions): void {
+  native.enableEdgeCache(options);
+}
+
+/**
+ * Stop caching edgeRegisterAccess() credentials and drop the cached ones.
+ */
+export function disableEdgeCache(): void {
+  native.disableEdgeCache();
+}
+
+/**
+ * Edge credential cache counters.
+ *
+ * @returns The counters, or null when the cache is disabled
+ */
+export function edgeCacheStats(): EdgeCacheStats | null {
+  return native.edgeCacheStats() as EdgeCacheStats | null;
+}
+
 /**
  * Create a shareable linkshare URL for an object.
  *
@@ -111,6 +150,42 @@ export async function edgeJoinShareUrl(
   key: string,
   options?: EdgeShareURLOptions
 ): Promise<string> {
+  validateShareUrlArgs(baseUrl, accessKeyId, bucket, key);
+  return native.edgeJoinShareUrl(baseUrl, accessKeyId, bucket, key, options);
+}
+
+/**
+ * Create a shareable linkshare URL for an object, synchronously.
+ *
+ * Joining a URL is string work with no network round trip, so this runs
+ * inline rather than paying a promise and a thread pool hop, which suits
+ * request handlers that build a URL per response. Arguments and errors
+ * are as for `edgeJoinShareUrl()`, thrown instead of rejected.
+ *
+ * @param baseUrl - Linkshare service URL (e.g., https://link.us1.storjshare.io)
+ * @param accessKeyId - Access key ID from edgeRegisterAccess (must be public)
+ * @param bucket - Bucket name (empty string to share entire project)
+ * @param key - Object key or prefix (empty string to share entire bucket)
+ * @param options - Optional share URL options
+ * @returns The share URL
+ *
+ * @example
+ * ```typescript
+ * res.redirect(edgeJoinShareUrlSync(linkshareUrl, credentials.accessKeyId, 'gallery', key, { raw: true }));
+ * ```
+ */
+export function edgeJoinShareUrlSync(
+  baseUrl: string,
+  accessKeyId: string,
+  bucket: string,
+  key: string,
+  options?: EdgeShareURLOptions
+): string {
+  validateShareUrlArgs(baseUrl, accessKeyId, bucket, key);
+  return native.edgeJoinShareUrlSync(baseUrl, accessKeyId, bucket, key, options);
+}
+
+function validateShareUrlArgs(baseUrl: string, accessKeyId: string, bucket: string, key: string): void {
   if (!baseUrl || typeof baseUrl !== 'string') {
     throw new TypeError('baseUrl must be a non-empty string');
   }
@@ -126,8 +201,64 @@ export async function edgeJoinShareUrl(
   if (typeof key !== 'string') {
     throw new TypeError('key must be a string');
   }
+}
 
-  return native.edgeJoinShareUrl(baseUrl, accessKeyId, bucket, key, options);
+/**
+ * Create linkshare URLs for many objects in one call.
+ *
+ * Joining a URL is string work with no network round trip, so the whole
+ * batch runs synchronously in a single native call rather than paying a
+ * promise and a thread pool hop per URL.
+ *
+ * @param baseUrl - Linkshare service URL (e.g., https://link.us1.storjshare.io)
+ * @param accessKeyId - Access key ID from edgeRegisterAccess (must be public)
+ * @param entries - Bucket, key and options of each URL
+ * @returns The share URLs, in the order of entries
+ * @throws The typed error of the first entry that fails
+ *
+ * @example
+ * ```typescript
+ * const urls = edgeJoinShareUrls(
+ *   'https://link.us1.storjshare.io',
+ *   credentials.accessKeyId,
+ *   photos.map((key) => ({ bucket: 'gallery', key, raw: true }))
+ * );
+ * ```
+ */
+export function edgeJoinShareUrls(
+  baseUrl: string,
+  accessKeyId: string,
+  entries: EdgeShareURLEntry[]
+): string[] {
+  if (!baseUrl || typeof baseUrl !== 'string') {
+    throw new TypeError('baseUrl must be a non-empty string');
+  }
+
+  if (!accessKeyId || typeof accessKeyId !== 'string') {
+    throw new TypeError('accessKeyId must be a non-empty string');
+  }
+
+  if (!Array.isArray(entries)) {
+    throw new TypeError('entries must be an array');
+  }
+
+  for (const entry of entries) {
+    if (entry == null || typeof entry !== 'object') {
+      throw new TypeError('entries must contain objects');
+    }
+    if (typeof entry.bucket !== 'string') {
+      throw new TypeError('entry.bucket must be a string');
+    }
+    if (typeof entry.key !== 'string') {
+      throw new TypeError('entry.key must be a string');
+    }
+  }
+
+  if (entries.length === 0) {
+    return [];
+  }
+
+  return native.edgeJoinShareUrls(baseUrl, accessKeyId, entries);
 }
 
 /**
@@ -32,6 +32,11 @@ export const ErrorCodes = {
   // Edge errors
   EDGE_AUTH_DIAL_FAILED: 0x30,
   EDGE_REGISTER_ACCESS_FAILED: 0x31,
+
+  // Binding errors
+  TIMEOUT: 0x40,
+  INTEGRITY: 0x41,
+  COMPRESSED_OBJECT: 0x42,
 } as const;
 
 export type ErrorCode = (typeof ErrorCodes)[keyof typeof ErrorCodes];
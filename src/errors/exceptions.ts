@@ -159,3 +159,23 @@ export const EdgeRegisterAccessFailedError = errorClasses.EdgeRegisterAccessFail
   readonly prototype: IStorjError;
 };
 export type EdgeRegisterAccessFailedError = InstanceType<typeof EdgeRegisterAccessFailedError>;
+
+/* --- Binding errors --- */
+
+export const TimeoutError = errorClasses.TimeoutError as {
+  new (details?: string): IStorjError;
+  readonly prototype: IStorjError;
+};
+export type TimeoutError = InstanceType<typeof TimeoutError>;
+
+export const IntegrityError = errorClasses.IntegrityError as {
+  new (details?: string): IStorjError;
+  readonly prototype: IStorjError;
+};
+export type IntegrityError = InstanceType<typeof IntegrityError>;
+
+export const CompressedObjectError = errorClasses.CompressedObjectError as {
+  new (details?: string): IStorjError;
+  readonly prototype: IStorjError;
+};
+export type CompressedObjectError = InstanceType<typeof CompressedObjectError>;
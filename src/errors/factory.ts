@@ -23,7 +23,11 @@ import {
   UploadDoneError,
   EdgeAuthDialFailedError,
   EdgeRegisterAccessFailedError,
+  TimeoutError,
+  IntegrityError,
+  CompressedObjectError,
 } from './exceptions';
+import { native } from '../native';
 
 /**
  * Error structure returned from native module
@@ -57,6 +61,9 @@ const errorConstructors: ReadonlyMap<ErrorCode, ErrorConstructor> = new Map<
   [ErrorCodes.UPLOAD_DONE, UploadDoneError],
   [ErrorCodes.EDGE_AUTH_DIAL_FAILED, EdgeAuthDialFailedError],
   [ErrorCodes.EDGE_REGISTER_ACCESS_FAILED, EdgeRegisterAccessFailedError],
+  [ErrorCodes.TIMEOUT, TimeoutError],
+  [ErrorCodes.INTEGRITY, IntegrityError],
+  [ErrorCodes.COMPRESSED_OBJECT, CompressedObjectError],
 ]);
 
 /**
@@ -132,3 +139,31 @@ export function isStorjError(error: unknown): error is StorjError {
 export function hasErrorCode(error: unknown, code: ErrorCode): boolean {
   return isStorjError(error) && error.code === code;
 }
+
+/** Expected outcomes of existence checks */
+const NOT_FOUND_CODES: readonly ErrorCode[] = [ErrorCodes.BUCKET_NOT_FOUND, ErrorCodes.OBJECT_NOT_FOUND];
+
+/**
+ * Create errors of some codes without a stack trace.
+ *
+ * Capturing the stack is most of the cost of an error. Workloads that
+ * expect many of them, such as existence checks that mostly miss, can
+ * turn it off for those codes; the errors keep their class, code and
+ * message. Applies to errors created by this thread's addon instance.
+ *
+ * @param codes - `true` for BucketNotFoundError and ObjectNotFoundError,
+ *   `false` for none, or the exact codes
+ * @throws RangeError if a code has no error class
+ *
+ * @example
+ * ```typescript
+ * setStacklessErrors(true);
+ * const exists = await project.statObject('bucket', key).then(() => true, (e) => {
+ *   if (e instanceof ObjectNotFoundError) return false;
+ *   throw e;
+ * });
+ * ```
+ */
+export function setStacklessErrors(codes: boolean | readonly ErrorCode[]): void {
+  native.setStacklessErrors(codes === true ? [...NOT_FOUND_CODES] : codes === false ? [] : [...codes]);
+}
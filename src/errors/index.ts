@@ -57,6 +57,10 @@ export {
   // Edge errors
   EdgeAuthDialFailedError,
   EdgeRegisterAccessFailedError,
+  // Binding errors
+  TimeoutError,
+  IntegrityError,
+  CompressedObjectError,
 } from './exceptions';
 
 // Export factory functions and utilities
@@ -67,4 +71,5 @@ export {
   fromNativeError,
   isStorjError,
   hasErrorCode,
+  setStacklessErrors,
 } from './factory';
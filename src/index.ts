@@ -17,8 +17,14 @@ export * from './errors';
 export { Uplink } from './uplink';
 export { AccessResultStruct } from './access';
 export { ProjectResultStruct } from './project';
+export { ProjectPool, ProjectLease } from './project/pool';
+export { columnKey, columnIsPrefix } from './project/columns';
+export { PackUpload, PackReader } from './project/pack';
 export { UploadResultStruct } from './upload';
-export { DownloadResultStruct } from './download';
+export { UploadWriteStream } from './upload/stream';
+export { DownloadResultStruct, downloadParallel } from './download';
+export { DownloadReadStream } from './download/stream';
+export { ArchiveReadStream } from './download/archive';
 
 // Export multipart upload classes and functions
 export {
@@ -26,20 +32,38 @@ export {
   PartUploadResultStruct,
   beginMultipartUpload,
   listMultipartUploads,
+  collectUploadParts,
+  collectUploads,
+  uploadParallel,
+  uploadPartFromFile,
+  resumeUpload,
 } from './multipart';
 
 // Export edge/linkshare functions
-export { edgeRegisterAccess, edgeJoinShareUrl, EdgeRegions } from './edge';
+export {
+  edgeRegisterAccess,
+  edgeJoinShareUrl,
+  edgeJoinShareUrlSync,
+  edgeJoinShareUrls,
+  enableEdgeCache,
+  disableEdgeCache,
+  edgeCacheStats,
+  EdgeRegions,
+} from './edge';
 
 // Export debug utilities
 export {
   internalUniverseIsEmpty,
   uplinkInternalUniverseIsEmpty,
   testThrowTypedError,
+  handleStats,
+  workPoolStats,
+  nativeStats,
 } from './debug';
 
 // Export centralized native module for internal use
 export { native as _native, NativeModule } from './native';
+export { NATIVE_TRACING_CHANNEL, NativeCallContext } from './native/tracing';
 
 /** Package version */
 export const VERSION = '0.1.0';
@@ -13,8 +13,15 @@ import type {
   CommitUploadOptions,
   ListUploadPartsOptions,
   ListUploadsOptions,
+  UploadParallelOptions,
+  UploadParallelResult,
+  UploadPartFromFileOptions,
+  ResumeUploadOptions,
+  CollectUploadPartsOptions,
+  CollectUploadsOptions,
 } from '../types';
 import { native } from '../native';
+import { withSignal } from '../native/cancel';
 
 /** Native handle types */
 type ProjectHandle = unknown;
@@ -218,6 +225,41 @@ export class MultipartUpload {
     return new PartUploadResultStruct(handle);
   }
 
+  /**
+   * Upload a byte range of a local file as one part.
+   *
+   * See {@link uploadPartFromFile}.
+   *
+   * @param partNumber - Part number (1-based, max 10000)
+   * @param path - Path of the local file
+   * @param offset - First byte of the range
+   * @param length - Bytes in the range
+   * @param options - Optional ETag, mmap, progress, and abort signal
+   * @returns Promise resolving to the committed part's info
+   */
+  async uploadPartFromFile(
+    partNumber: number,
+    path: string,
+    offset: number,
+    length: number,
+    options?: UploadPartFromFileOptions
+  ): Promise<PartInfo> {
+    if (!this.isActive) {
+      throw new Error(ERR_MULTIPART_NOT_ACTIVE);
+    }
+    return uploadPartFromFile(
+      this._projectHandle,
+      this._bucket,
+      this._key,
+      this._uploadId,
+      partNumber,
+      path,
+      offset,
+      length,
+      options
+    );
+  }
+
   /**
    * Commit the multipart upload.
    *
@@ -269,27 +311,7 @@ export class MultipartUpload {
       throw new Error(ERR_MULTIPART_NOT_ACTIVE);
     }
 
-    const iterator = await native.listUploadPartsCreate(
-      this._projectHandle,
-      this._bucket,
-      this._key,
-      this._uploadId,
-      options
-    );
-    const parts: PartInfo[] = [];
-    try {
-      while (await native.partIteratorNext(iterator)) {
-        const part = await native.partIteratorItem(iterator);
-        parts.push(part as PartInfo);
-      }
-      const err = await native.partIteratorErr(iterator);
-      if (err) {
-        throw err;
-      }
-    } finally {
-      await native.freePartIterator(iterator);
-    }
-    return parts;
+    return collectUploadParts(this._projectHandle, this._bucket, this._key, this._uploadId, options);
   }
 }
 
@@ -325,19 +347,170 @@ export async function listMultipartUploads(
   bucket: string,
   options?: ListUploadsOptions
 ): Promise<UploadInfo[]> {
-  const iterator = await native.listUploadsCreate(projectHandle, bucket, options);
-  const uploads: UploadInfo[] = [];
-  try {
-    while (await native.uploadIteratorNext(iterator)) {
-      const upload = await native.uploadIteratorItem(iterator);
-      uploads.push(upload as UploadInfo);
-    }
-    const err = await native.uploadIteratorErr(iterator);
-    if (err) {
-      throw err;
-    }
-  } finally {
-    await native.freeUploadIterator(iterator);
+  return collectUploads(projectHandle, bucket, options);
+}
+
+/**
+ * List an upload's committed parts in one native call.
+ *
+ * The part iterator is drained on a worker thread and the parts are
+ * converted in one pass, instead of one round trip per part.
+ *
+ * @param projectHandle - Native project handle
+ * @param bucket - Bucket name
+ * @param key - Object key
+ * @param uploadId - Upload ID
+ * @param options - Optional cursor, item cap, and abort signal
+ * @returns Promise resolving to the parts; `maxItems` entries means there may be more after the last part number
+ */
+export async function collectUploadParts(
+  projectHandle: ProjectHandle,
+  bucket: string,
+  key: string,
+  uploadId: string,
+  options?: CollectUploadPartsOptions
+): Promise<PartInfo[]> {
+  return withSignal(
+    options,
+    (o) => native.collectUploadParts(projectHandle, bucket, key, uploadId, o) as Promise<PartInfo[]>
+  );
+}
+
+/**
+ * List pending multipart uploads in one native call.
+ *
+ * The upload iterator is drained on a worker thread and the uploads are
+ * converted in one pass, instead of one round trip per upload.
+ *
+ * @param projectHandle - Native project handle
+ * @param bucket - Bucket name
+ * @param options - Optional listing options, item cap, and abort signal
+ * @returns Promise resolving to the uploads; `maxItems` entries means there may be more after the last key
+ */
+export async function collectUploads(
+  projectHandle: ProjectHandle,
+  bucket: string,
+  options?: CollectUploadsOptions
+): Promise<UploadInfo[]> {
+  return withSignal(options, (o) => native.collectUploads(projectHandle, bucket, o) as Promise<UploadInfo[]>);
+}
+
+/**
+ * Upload a Buffer or local file as a multipart upload with parallel parts.
+ *
+ * Begins the upload, streams parts concurrently on native threads
+ * (retrying failed parts), and commits, all behind a single promise.
+ * On a permanent part failure the multipart upload is aborted. With
+ * `auto`, part size and parts in flight are tuned as parts finish and the
+ * chosen values are returned as `tuning`.
+ *
+ * @param projectHandle - Native project handle
+ * @param bucket - Bucket name
+ * @param key - Object key
+ * @param source - Data buffer or path of a local file
+ * @param options - Optional part size, concurrency, auto mode, retries, expiration, metadata, and abort signal
+ * @returns Promise resolving to the committed object info
+ */
+export async function uploadParallel(
+  projectHandle: ProjectHandle,
+  bucket: string,
+  key: string,
+  source: Buffer | string,
+  options?: UploadParallelOptions
+): Promise<UploadParallelResult> {
+  if (!Buffer.isBuffer(source) && (typeof source !== 'string' || source.length === 0)) {
+    throw new TypeError('source must be a Buffer or a non-empty file path');
+  }
+  return withSignal(options, (o) => native.uploadParallel(projectHandle, bucket, key, source, o) as Promise<UploadParallelResult>);
+}
+
+/**
+ * Finish an interrupted multipart upload, sending only the missing parts.
+ *
+ * Lists the upload's committed parts natively, then runs the parallel
+ * engine over the parts that are absent or whose size does not match
+ * `partSize`, and commits. On a permanent part failure the upload is
+ * left pending so it can be resumed again.
+ *
+ * @param projectHandle - Native project handle
+ * @param bucket - Bucket name
+ * @param key - Object key
+ * @param uploadId - Upload ID of the pending upload
+ * @param source - The same data buffer or local file the upload started with
+ * @param options - Part size used for the upload, concurrency, retries, metadata, and abort signal
+ * @returns Promise resolving to the committed object info
+ */
+export async function resumeUpload(
+  projectHandle: ProjectHandle,
+  bucket: string,
+  key: string,
+  uploadId: string,
+  source: Buffer | string,
+  options?: ResumeUploadOptions
+): Promise<ObjectInfo> {
+  if (typeof uploadId !== 'string' || uploadId.length === 0) {
+    throw new TypeError('uploadId must be a non-empty string');
+  }
+  if (!Buffer.isBuffer(source) && (typeof source !== 'string' || source.length === 0)) {
+    throw new TypeError('source must be a Buffer or a non-empty file path');
+  }
+  return withSignal(
+    options,
+    (o) => native.resumeUpload(projectHandle, bucket, key, uploadId, source, o) as Promise<ObjectInfo>
+  );
+}
+
+/**
+ * Upload a byte range of a local file as one part of a multipart upload.
+ *
+ * Opens the part, reads the range on a native thread (or maps it with
+ * `mmap`), writes it, sets the ETag when given and commits the part, all
+ * behind a single promise. The part is aborted if any step fails.
+ *
+ * @param projectHandle - Native project handle
+ * @param bucket - Bucket name
+ * @param key - Object key
+ * @param uploadId - Upload ID from beginMultipartUpload()
+ * @param partNumber - Part number (1-based, max 10000)
+ * @param path - Path of the local file
+ * @param offset - First byte of the range
+ * @param length - Bytes in the range
+ * @param options - Optional ETag, mmap, progress, and abort signal
+ * @returns Promise resolving to the committed part's info
+ */
+export async function uploadPartFromFile(
+  projectHandle: ProjectHandle,
+  bucket: string,
+  key: string,
+  uploadId: string,
+  partNumber: number,
+  path: string,
+  offset: number,
+  length: number,
+  options?: UploadPartFromFileOptions
+): Promise<PartInfo> {
+  if (typeof partNumber !== 'number' || partNumber < 1 || partNumber > 10000) {
+    throw new RangeError('partNumber must be between 1 and 10000');
+  }
+  if (typeof path !== 'string' || path.length === 0) {
+    throw new TypeError('path must be a non-empty file path');
+  }
+  if (!Number.isInteger(offset) || offset < 0 || !Number.isInteger(length) || length < 0) {
+    throw new RangeError('offset and length must be non-negative integers');
   }
-  return uploads;
+  return withSignal(
+    options,
+    (o) =>
+      native.uploadPartFromFile(
+        projectHandle,
+        bucket,
+        key,
+        uploadId,
+        partNumber,
+        path,
+        offset,
+        length,
+        o
+      ) as Promise<PartInfo>
+  );
 }
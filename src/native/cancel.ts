@@ -0,0 +1,95 @@
+/**
+ * @file native/cancel.ts
+ * @description AbortSignal support for native calls
+ *
+ * An AbortSignal is mapped to a native cancel token passed as
+ * `options.cancelToken`. Aborting the signal takes queued work off the
+ * addon's queues at once and stops running transfers at their next chunk,
+ * part or batch, so their uplink handles are released early.
+ *
+ * `options.timeoutMs` is passed through untouched; the addon gives the
+ * call a deadline timer of its own that aborts it the same way.
+ */
+
+import { native } from './index';
+import { CanceledError } from '../errors';
+
+/**
+ * A native cancel token tied to an AbortSignal until disposed.
+ */
+export interface SignalToken {
+  /** Native token to pass as `options.cancelToken` */
+  readonly cancelToken: unknown;
+  /** Stop listening to the signal */
+  dispose(): void;
+}
+
+/**
+ * Throw a CanceledError if @p signal has been aborted.
+ *
+ * @param signal - Optional abort signal
+ * @throws CanceledError when aborted
+ */
+export function throwIfAborted(signal: AbortSignal | undefined): void {
+  if (signal?.aborted) {
+    throw new CanceledError('aborted by signal');
+  }
+}
+
+/**
+ * Create a native cancel token that is aborted along with @p signal.
+ *
+ * @param signal - Abort signal, not yet aborted
+ * @returns The token and a dispose function to call once the work settles
+ */
+export function signalToken(signal: AbortSignal): SignalToken {
+  const cancelToken = native.createCancelToken();
+  const onAbort = (): void => native.cancelToken(cancelToken);
+  signal.addEventListener('abort', onAbort, { once: true });
+  return {
+    cancelToken,
+    dispose: () => signal.removeEventListener('abort', onAbort),
+  };
+}
+
+/**
+ * Check `options.timeoutMs`.
+ *
+ * @param timeoutMs - Optional deadline in milliseconds
+ * @throws TypeError unless absent or a positive finite number
+ */
+export function validateTimeout(timeoutMs: number | undefined): void {
+  if (timeoutMs !== undefined && !(typeof timeoutMs === 'number' && Number.isFinite(timeoutMs) && timeoutMs > 0)) {
+    throw new TypeError('timeoutMs must be a positive number');
+  }
+}
+
+/**
+ * Run a native call with `options.signal` mapped to `options.cancelToken`.
+ *
+ * Without a signal @p run gets the options unchanged.
+ *
+ * @param options - Call options, possibly carrying a signal and a timeout
+ * @param run - Issues the native call with the given options
+ * @returns The native call's result
+ * @throws TypeError if `options.timeoutMs` is invalid
+ * @throws CanceledError if the signal is already aborted or aborts the call
+ * @throws TimeoutError if `options.timeoutMs` passes first
+ */
+export async function withSignal<O extends { signal?: AbortSignal; timeoutMs?: number }, T>(
+  options: O | undefined,
+  run: (options: O | undefined) => Promise<T>
+): Promise<T> {
+  validateTimeout(options?.timeoutMs);
+  const signal = options?.signal;
+  if (signal === undefined) {
+    return run(options);
+  }
+  throwIfAborted(signal);
+  const token = signalToken(signal);
+  try {
+    return await run({ ...options, cancelToken: token.cancelToken } as O);
+  } finally {
+    token.dispose();
+  }
+}
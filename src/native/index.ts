@@ -9,6 +9,7 @@
 
 import * as path from 'path';
 import * as os from 'os';
+import { traceNativeModule } from './tracing';
 
 /**
  * Instance type for errors created by native error classes.
@@ -45,29 +46,52 @@ export interface NativeModule {
   requestAccessWithPassphrase(
     satellite: string,
     apiKey: string,
-    passphrase: string
+    passphrase: string,
+    options?: unknown
   ): Promise<unknown>;
   configRequestAccessWithPassphrase(
     config: unknown,
     satellite: string,
     apiKey: string,
-    passphrase: string
+    passphrase: string,
+    options?: unknown
   ): Promise<unknown>;
   accessSatelliteAddress(access: unknown): Promise<string>;
   accessSerialize(access: unknown): Promise<string>;
-  accessShare(access: unknown, permission: unknown, prefixes: unknown[]): Promise<unknown>;
+  accessSatelliteAddressSync(access: unknown): string;
+  accessSerializeSync(access: unknown): string;
+  accessShare(
+    access: unknown,
+    permission: unknown,
+    prefixes: unknown[],
+    options?: unknown
+  ): Promise<unknown>;
+  accessShareMany(access: unknown, specs: unknown[], options?: unknown): Promise<string[]>;
   accessOverrideEncryptionKey(
     access: unknown,
     bucket: string,
     prefix: string,
     key: unknown
   ): Promise<void>;
+  enableAccessCache(options?: unknown): void;
+  disableAccessCache(): void;
+  accessCacheStats(): unknown;
 
   // Project operations
   openProject(access: unknown): Promise<unknown>;
   configOpenProject(config: unknown, access: unknown): Promise<unknown>;
   closeProject(project: unknown): Promise<void>;
   revokeAccess(project: unknown, access: unknown): Promise<void>;
+  projectEnableStatCache(project: unknown, options?: unknown): void;
+  projectDisableStatCache(project: unknown): void;
+  projectStatCacheStats(project: unknown): unknown;
+  projectEnableObjectCache(project: unknown, options?: unknown): void;
+  projectDisableObjectCache(project: unknown): void;
+  projectObjectCacheStats(project: unknown): unknown;
+  projectEnableKnownBuckets(project: unknown, options?: unknown): void;
+  projectDisableKnownBuckets(project: unknown): void;
+  projectKnownBucketsStats(project: unknown): unknown;
+  projectAdmissionStats(project: unknown): unknown;
 
   // Bucket operations
   createBucket(project: unknown, bucketName: string): Promise<unknown>;
@@ -80,16 +104,25 @@ export interface NativeModule {
   bucketIteratorNext(iterator: unknown): Promise<boolean>;
   bucketIteratorItem(iterator: unknown): Promise<unknown>;
   bucketIteratorErr(iterator: unknown): Promise<unknown>;
+  bucketIteratorNextBatch(iterator: unknown, maxItems: number): Promise<unknown[]>;
+  collectBuckets(project: unknown, options?: unknown): Promise<unknown[]>;
   freeBucketIterator(iterator: unknown): Promise<void>;
 
   // Object operations
-  statObject(project: unknown, bucket: string, key: string): Promise<unknown>;
+  statObject(project: unknown, bucket: string, key: string, options?: unknown): Promise<unknown>;
+  statObjects(project: unknown, bucket: string, keys: readonly string[], options?: unknown): Promise<unknown>;
   deleteObject(project: unknown, bucket: string, key: string): Promise<void>;
+  deleteObjects(project: unknown, bucket: string, keys: readonly string[], options?: unknown): Promise<unknown>;
+  deletePrefix(project: unknown, bucket: string, prefix: string, options?: unknown): Promise<unknown>;
+  exportListing(project: unknown, bucket: string, path: string, options?: unknown): Promise<unknown>;
   // Object iterator operations
   listObjectsCreate(project: unknown, bucket: string, options?: unknown): Promise<unknown>;
   objectIteratorNext(iterator: unknown): Promise<boolean>;
+  objectIteratorNextBatch(iterator: unknown, maxItems: number): Promise<unknown[]>;
+  objectIteratorNextColumns(iterator: unknown, maxItems: number): Promise<unknown>;
   objectIteratorItem(iterator: unknown): Promise<unknown>;
   objectIteratorErr(iterator: unknown): Promise<unknown>;
+  objectIteratorCheckpoint(iterator: unknown): string | null;
   freeObjectIterator(iterator: unknown): Promise<void>;
   copyObject(
     project: unknown,
@@ -107,20 +140,56 @@ export interface NativeModule {
     dstKey: string,
     options?: unknown
   ): Promise<void>;
+  copyObjects(project: unknown, pairs: readonly unknown[], options?: unknown): Promise<unknown>;
+  moveObjects(project: unknown, pairs: readonly unknown[], options?: unknown): Promise<unknown>;
   updateObjectMetadata(
     project: unknown,
     bucket: string,
     key: string,
-    metadata: Record<string, string>
+    metadata: Record<string, string> | Buffer
   ): Promise<void>;
+  updateObjectsMetadata(
+    project: unknown,
+    bucket: string,
+    keys: readonly string[],
+    sets: ReadonlyArray<Record<string, string> | Buffer>,
+    setIndex: Uint32Array | null,
+    options?: unknown
+  ): Promise<unknown>;
 
   // Upload operations
   uploadObject(project: unknown, bucket: string, key: string, options?: unknown): Promise<unknown>;
   uploadWrite(upload: unknown, buffer: Buffer, length: number): Promise<number>;
+  uploadWritev(upload: unknown, buffers: Buffer[]): Promise<number>;
+  uploadWritevCb(
+    upload: unknown,
+    buffers: Buffer[],
+    callback: (error: Error | null, bytesWritten: number) => void
+  ): void;
   uploadCommit(upload: unknown): Promise<void>;
   uploadAbort(upload: unknown): Promise<void>;
-  uploadSetCustomMetadata(upload: unknown, metadata: Record<string, string>): Promise<void>;
+  uploadSetCustomMetadata(upload: unknown, metadata: Record<string, string> | Buffer): Promise<void>;
   uploadInfo(upload: unknown): Promise<unknown>;
+  uploadFile(
+    project: unknown,
+    bucket: string,
+    key: string,
+    path: string,
+    options?: unknown
+  ): Promise<unknown>;
+  putObject(project: unknown, bucket: string, key: string, data: Buffer, options?: unknown): Promise<unknown>;
+  putObjectDedup(
+    project: unknown,
+    bucket: string,
+    keyTemplate: string,
+    source: Buffer | string,
+    options?: unknown
+  ): Promise<unknown>;
+  uploadReplicated(
+    source: Buffer | string,
+    targets: { project: unknown; bucket: string; key: string }[],
+    options?: unknown
+  ): Promise<unknown>;
 
   // Download operations
   downloadObject(
@@ -129,12 +198,71 @@ export interface NativeModule {
     key: string,
     options?: unknown
   ): Promise<unknown>;
-  downloadRead(download: unknown, buffer: Buffer, length: number): Promise<{ bytesRead: number }>;
+  downloadRead(
+    download: unknown,
+    buffer: Buffer,
+    length: number,
+    options?: unknown
+  ): Promise<{ bytesRead: number; eof?: boolean }>;
+  downloadReadFull(
+    download: unknown,
+    buffer: Buffer,
+    length: number,
+    options?: unknown
+  ): Promise<{ bytesRead: number; eof: boolean }>;
+  downloadReadInto(
+    download: unknown,
+    buffer: ArrayBufferView,
+    offset: number,
+    length: number,
+    options?: unknown
+  ): Promise<{ bytesRead: number; eof: boolean }>;
+  downloadReadCb(
+    download: unknown,
+    buffer: Buffer,
+    length: number,
+    callback: (error: Error | null, bytesRead: number, eof: boolean) => void,
+    options?: unknown
+  ): void;
+  downloadToFile(
+    project: unknown,
+    bucket: string,
+    key: string,
+    path: string,
+    options?: unknown
+  ): Promise<{ bytesWritten: number }>;
+  downloadParallel(
+    project: unknown,
+    bucket: string,
+    key: string,
+    sink: Buffer | string,
+    options?: unknown
+  ): Promise<{ bytesWritten: number }>;
+  downloadRanges(
+    project: unknown,
+    bucket: string,
+    key: string,
+    ranges: unknown[],
+    options?: unknown
+  ): Promise<{ data: Buffer; offsets: number[]; lengths: number[]; requests: number }>;
+  getObject(project: unknown, bucket: string, key: string, options?: unknown): Promise<unknown>;
+  allocReadBuffer(size: number): Buffer;
   downloadInfo(download: unknown): Promise<unknown>;
   closeDownload(download: unknown): Promise<void>;
+  downloadTeeResults(download: unknown): unknown[];
+  enableChunkCache(options: unknown): void;
+  disableChunkCache(): void;
+  chunkCacheStats(): unknown;
+  enableReadAhead(options?: unknown): void;
+  disableReadAhead(): void;
+  readAheadStats(): unknown;
 
   // Encryption operations
   deriveEncryptionKey(passphrase: string, salt: Buffer): Promise<unknown>;
+  deriveEncryptionKeys(items: unknown[], options?: unknown): Promise<unknown[]>;
+  enableEncryptionKeyCache(options?: unknown): void;
+  disableEncryptionKeyCache(): void;
+  encryptionKeyCacheStats(): unknown;
 
   // Multipart operations
   beginUpload(project: unknown, bucket: string, key: string, options?: unknown): Promise<unknown>;
@@ -178,6 +306,63 @@ export interface NativeModule {
   uploadIteratorErr(iterator: unknown): Promise<unknown>;
   freeUploadIterator(iterator: unknown): Promise<void>;
 
+  // Parallel multipart engine
+  uploadParallel(
+    project: unknown,
+    bucket: string,
+    key: string,
+    source: Buffer | string,
+    options?: unknown
+  ): Promise<unknown>;
+  collectUploadParts(
+    project: unknown,
+    bucket: string,
+    key: string,
+    uploadId: string,
+    options?: unknown
+  ): Promise<unknown>;
+  collectUploads(project: unknown, bucket: string, options?: unknown): Promise<unknown>;
+  resumeUpload(
+    project: unknown,
+    bucket: string,
+    key: string,
+    uploadId: string,
+    source: Buffer | string,
+    options?: unknown
+  ): Promise<unknown>;
+  uploadPartFromFile(
+    project: unknown,
+    bucket: string,
+    key: string,
+    uploadId: string,
+    partNumber: number,
+    path: string,
+    offset: number,
+    length: number,
+    options?: unknown
+  ): Promise<unknown>;
+
+  // Directory operations
+  uploadDirectory(
+    project: unknown,
+    localDir: string,
+    bucket: string,
+    prefix: string,
+    options?: unknown
+  ): Promise<unknown>;
+  diffDirectory(
+    project: unknown,
+    localDir: string,
+    bucket: string,
+    prefix: string,
+    options?: unknown
+  ): Promise<unknown>;
+
+  // Archive operations
+  archiveOpen(project: unknown, bucket: string, keysOrPrefix: string[] | string, options?: unknown): unknown;
+  archiveRead(archive: unknown, buffer: Buffer): Promise<{ bytesRead: number; eof: boolean }>;
+  archiveClose(archive: unknown): void;
+
   // Edge operations
   edgeRegisterAccess(config: unknown, access: unknown, options?: unknown): Promise<unknown>;
   edgeJoinShareUrl(
@@ -187,16 +372,41 @@ export interface NativeModule {
     key: string,
     options?: unknown
   ): Promise<string>;
+  edgeJoinShareUrlSync(
+    baseUrl: string,
+    accessKeyId: string,
+    bucket: string,
+    key: string,
+    options?: unknown
+  ): string;
+  edgeJoinShareUrls(baseUrl: string, accessKeyId: string, entries: unknown[]): string[];
+  enableEdgeCache(options?: unknown): void;
+  disableEdgeCache(): void;
+  edgeCacheStats(): unknown;
 
   // Debug operations
   internalUniverseIsEmpty(): Promise<boolean>;
   testThrowTypedError(code: number, message: string): Promise<never>;
+  handleStats(): unknown;
+  workPoolStats(): unknown;
+  nativeAllocStats(): unknown;
 
   // Error class initialization (defined entirely in native via embedded JS).
   // Call once after module load. Optionally pass the caller's Error constructor
   // to ensure instanceof Error works in VM sandboxes (e.g. Jest).
   // Returns an object of constructor functions.
   initErrorClasses(errorBase?: ErrorConstructor): ErrorClassesMap;
+  setStacklessErrors(codes: number[]): void;
+
+  // Thread pool and bandwidth configuration (process-wide)
+  configureThreadPool(options: unknown): void;
+  configureBandwidth(options: unknown): void;
+  getMetrics(options?: unknown): unknown;
+  hedgeStats(): unknown;
+
+  // Cancellation tokens behind AbortSignal support
+  createCancelToken(): unknown;
+  cancelToken(token: unknown): void;
 }
 
 /**
@@ -222,6 +432,9 @@ export interface ErrorClassesMap {
   UploadDoneError: StorjErrorSubclassConstructor;
   EdgeAuthDialFailedError: StorjErrorSubclassConstructor;
   EdgeRegisterAccessFailedError: StorjErrorSubclassConstructor;
+  TimeoutError: StorjErrorSubclassConstructor;
+  IntegrityError: StorjErrorSubclassConstructor;
+  CompressedObjectError: StorjErrorSubclassConstructor;
 }
 
 /**
@@ -275,9 +488,9 @@ function loadNativeModule(): NativeModule {
 }
 
 /**
- * Singleton instance of the native module
+ * Singleton instance of the native module, traced on diagnostics_channel
  */
-export const native: NativeModule = loadNativeModule();
+export const native: NativeModule = traceNativeModule(loadNativeModule());
 
 /**
  * Initialize error classes from native embedded JS.
@@ -0,0 +1,51 @@
+/**
+ * @file native/metadata.ts
+ * @description Packed custom metadata for native calls
+ *
+ * The addon reads a metadata object with several N-API calls and copies
+ * per entry. A packed Buffer is parsed in one pass instead, which adds up
+ * for objects carrying dozens of entries. Layout (see object_converter.h):
+ * uint32 count, then count x { uint32 keyLength, uint32 valueLength },
+ * then each key and value in entry order; integers little-endian,
+ * strings UTF-8.
+ */
+
+import type { CustomMetadata } from '../types';
+
+/**
+ * Pack @p metadata for the addon.
+ *
+ * @param metadata - Object with string key-value pairs
+ * @param message - TypeError message when a value is not a string
+ * @returns The packed metadata
+ * @throws TypeError if a value is not a string
+ */
+export function packMetadata(
+  metadata: CustomMetadata,
+  message = 'metadata values must be strings'
+): Buffer {
+  const keys = Object.keys(metadata);
+  const count = keys.length;
+  let length = 4 + count * 8;
+  const lengths = new Array<number>(count * 2);
+  for (let i = 0; i < count; i++) {
+    const value = metadata[keys[i]];
+    if (typeof value !== 'string') {
+      throw new TypeError(message);
+    }
+    lengths[2 * i] = Buffer.byteLength(keys[i], 'utf8');
+    lengths[2 * i + 1] = Buffer.byteLength(value, 'utf8');
+    length += lengths[2 * i] + lengths[2 * i + 1];
+  }
+
+  const packed = Buffer.allocUnsafe(length);
+  packed.writeUInt32LE(count, 0);
+  let offset = 4 + count * 8;
+  for (let i = 0; i < count; i++) {
+    packed.writeUInt32LE(lengths[2 * i], 4 + i * 8);
+    packed.writeUInt32LE(lengths[2 * i + 1], 8 + i * 8);
+    offset += packed.write(keys[i], offset, 'utf8');
+    offset += packed.write(metadata[keys[i]], offset, 'utf8');
+  }
+  return packed;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file native/progress.ts
+ * @description Coalesced onProgress calls for the stream engines
+ *
+ * The one-shot transfer engines count bytes natively and pass
+ * `options.onProgress` through untouched. Streams already return to JS
+ * once per chunk, so they count here instead, with the same rule: at
+ * most one call every `progressIntervalMs` (or `progressBytes` bytes,
+ * when set), plus one with the final state.
+ */
+
+import type { ProgressOptions, TransferProgress } from '../types';
+
+/** Default minimum time between two onProgress calls, as natively */
+const DEFAULT_INTERVAL_MS = 100;
+
+/**
+ * Byte counter that reports to `options.onProgress`.
+ */
+export class ProgressMeter {
+  private readonly _onProgress: (progress: TransferProgress) => void;
+  private readonly _intervalMs: number;
+  private readonly _stepBytes: number;
+  private _total: number = -1;
+  private _bytes: number = 0;
+  private _postedBytes: number = 0;
+  private _postedAt: number = performance.now();
+  private _posted: boolean = false;
+
+  private constructor(onProgress: (progress: TransferProgress) => void, intervalMs: number, stepBytes: number) {
+    this._onProgress = onProgress;
+    this._intervalMs = intervalMs;
+    this._stepBytes = stepBytes;
+  }
+
+  /**
+   * Create a meter from `options.onProgress`.
+   *
+   * @param options - Transfer options
+   * @returns The meter, or null without an `onProgress`
+   * @throws TypeError if `onProgress` is not a function
+   * @throws RangeError if `progressIntervalMs` or `progressBytes` is negative
+   */
+  static from(options: ProgressOptions): ProgressMeter | null {
+    const { onProgress, progressIntervalMs = DEFAULT_INTERVAL_MS, progressBytes = 0 } = options;
+    if (onProgress === undefined) {
+      return null;
+    }
+    if (typeof onProgress !== 'function') {
+      throw new TypeError('onProgress must be a function');
+    }
+    if (!(progressIntervalMs >= 0) || !(progressBytes >= 0)) {
+      throw new RangeError('progressIntervalMs and progressBytes must not be negative');
+    }
+    return new ProgressMeter(onProgress, progressIntervalMs, progressBytes);
+  }
+
+  /** Set the number of bytes the transfer will move */
+  setTotal(total: number): void {
+    this._total = total;
+  }
+
+  /** Count @p bytes, calling onProgress when a call is due */
+  add(bytes: number): void {
+    this._bytes += bytes;
+    const now = performance.now();
+    const moved = this._bytes - this._postedBytes;
+    if (now - this._postedAt >= this._intervalMs || (this._stepBytes > 0 && moved >= this._stepBytes)) {
+      this._post(now);
+    }
+  }
+
+  /** Report the final state unless it was the last one reported */
+  finish(): void {
+    if (!this._posted || this._bytes !== this._postedBytes) {
+      this._post(performance.now());
+    }
+  }
+
+  private _post(now: number): void {
+    const elapsed = now - this._postedAt;
+    const progress: TransferProgress = {
+      bytesTransferred: this._bytes,
+      totalBytes: this._total,
+      bytesPerSecond: elapsed > 0 ? ((this._bytes - this._postedBytes) * 1000) / elapsed : 0,
+    };
+    this._posted = true;
+    this._postedBytes = this._bytes;
+    this._postedAt = now;
+    try {
+      this._onProgress(progress);
+    } catch {
+      // A throwing listener must not fail the transfer, as natively
+    }
+  }
+}
@@ -0,0 +1,220 @@
+/**
+ * @file native/tracing.ts
+ * @description diagnostics_channel spans around native calls
+ *
+ * Every native function is published on the `uplink:native` tracing
+ * channel (`tracing:uplink:native:start`, `:end`, `:asyncStart`,
+ * `:asyncEnd` and `:error`) with a context carrying the operation name,
+ * the bucket, the bytes moved and the outcome code. Subscribers that bind
+ * an AsyncLocalStorage to the start channel, as OpenTelemetry does, see
+ * the span's store in everything the call's promise (or callback, for the
+ * callback-style reads and writes) continues with.
+ *
+ * With no subscriber a call costs one `hasSubscribers` branch in front of
+ * the native function. On runtimes without `tracingChannel` (Node before
+ * 18.19) the module is returned untouched.
+ */
+
+import * as diagnosticsChannel from 'diagnostics_channel';
+
+/** Name of the tracing channel native calls are published on */
+export const NATIVE_TRACING_CHANNEL = 'uplink:native';
+
+/** Introspection and setup calls, which would only be noise in traces */
+const UNTRACED = new Set([
+  'initErrorClasses',
+  'setStacklessErrors',
+  'configureThreadPool',
+  'configureBandwidth',
+  'getMetrics',
+  'hedgeStats',
+  'handleStats',
+  'workPoolStats',
+  'nativeAllocStats',
+  'accessCacheStats',
+  'edgeCacheStats',
+  'chunkCacheStats',
+  'readAheadStats',
+  'encryptionKeyCacheStats',
+  'projectStatCacheStats',
+  'projectObjectCacheStats',
+  'projectKnownBucketsStats',
+  'projectAdmissionStats',
+  'objectIteratorCheckpoint',
+  'downloadTeeResults',
+]);
+
+/** Callback-style calls, by the index of their (error, ...results) callback */
+const CALLBACK_ARG: Record<string, number> = { downloadReadCb: 3, uploadWritevCb: 2 };
+
+/** Calls whose second string argument is not a bucket */
+const NO_BUCKET = new Set(['configRequestAccessWithPassphrase', 'partUploadSetEtag', 'uploadDirectory']);
+
+/**
+ * Context published with each event of a native call
+ */
+export interface NativeCallContext {
+  /** Native function name, e.g. `uploadWrite`, `statObject` */
+  op: string;
+  /** Bucket of calls taking (handle, bucket, ...) */
+  bucket?: string;
+  /** Bytes moved, once a transfer call has settled */
+  bytes?: number;
+  /** 0 on success, the error's code on failure (-1 without one) */
+  code?: number;
+  /** Settled value, on asyncEnd */
+  result?: unknown;
+  /** Thrown or rejected error, on error */
+  error?: unknown;
+}
+
+interface TracingChannel {
+  readonly start: diagnosticsChannel.Channel;
+  readonly end: diagnosticsChannel.Channel;
+  readonly asyncStart: diagnosticsChannel.Channel;
+  readonly asyncEnd: diagnosticsChannel.Channel;
+  readonly error: diagnosticsChannel.Channel;
+}
+
+type RunStores = <T>(context: NativeCallContext, fn: () => T) => T;
+
+function bytesOf(result: unknown): number | undefined {
+  if (typeof result === 'number') {
+    return result;
+  }
+  if (result !== null && typeof result === 'object') {
+    const { bytesRead, bytesWritten } = result as { bytesRead?: unknown; bytesWritten?: unknown };
+    if (typeof bytesRead === 'number') return bytesRead;
+    if (typeof bytesWritten === 'number') return bytesWritten;
+  }
+  return undefined;
+}
+
+function codeOf(error: unknown): number {
+  const code = (error as { code?: unknown } | null)?.code;
+  return typeof code === 'number' ? code : -1;
+}
+
+/** Settle the span of a callback-style call when its callback runs */
+function traceCallback(
+  channel: TracingChannel,
+  context: NativeCallContext,
+  callback: (...results: unknown[]) => void
+): (...results: unknown[]) => void {
+  return (error: unknown, ...results: unknown[]) => {
+    if (error !== null && error !== undefined) {
+      context.code = codeOf(error);
+      context.error = error;
+      channel.error.publish(context);
+    } else {
+      context.code = 0;
+      context.bytes = bytesOf(results[0]);
+      context.result = results[0];
+    }
+    channel.asyncStart.publish(context);
+    try {
+      callback(error, ...results);
+    } finally {
+      channel.asyncEnd.publish(context);
+    }
+  };
+}
+
+function traceCall(
+  channel: TracingChannel,
+  context: NativeCallContext,
+  fn: (...args: unknown[]) => unknown,
+  self: unknown,
+  args: unknown[]
+): unknown {
+  const runStores = (channel.start as unknown as { runStores: RunStores }).runStores.bind(channel.start);
+  return runStores(context, () => {
+    try {
+      const callbackArg = CALLBACK_ARG[context.op];
+      if (callbackArg !== undefined && typeof args[callbackArg] === 'function') {
+        const callback = args[callbackArg] as (...results: unknown[]) => void;
+        args[callbackArg] = traceCallback(channel, context, callback);
+        return fn.apply(self, args);
+      }
+      const result = fn.apply(self, args);
+      if (result === null || typeof (result as Promise<unknown>)?.then !== 'function') {
+        context.code = 0;
+        context.result = result;
+        return result;
+      }
+      return (result as Promise<unknown>).then(
+        (value) => {
+          context.code = 0;
+          context.bytes = bytesOf(value);
+          context.result = value;
+          channel.asyncStart.publish(context);
+          channel.asyncEnd.publish(context);
+          return value;
+        },
+        (error: unknown) => {
+          context.code = codeOf(error);
+          context.error = error;
+          channel.error.publish(context);
+          channel.asyncStart.publish(context);
+          channel.asyncEnd.publish(context);
+          throw error;
+        }
+      );
+    } catch (error) {
+      context.code = codeOf(error);
+      context.error = error;
+      channel.error.publish(context);
+      throw error;
+    } finally {
+      channel.end.publish(context);
+    }
+  });
+}
+
+function hasSubscribersOf(channel: TracingChannel): () => boolean {
+  if (typeof (channel as { hasSubscribers?: unknown }).hasSubscribers === 'boolean') {
+    return () => (channel as unknown as { hasSubscribers: boolean }).hasSubscribers;
+  }
+  return () =>
+    channel.start.hasSubscribers ||
+    channel.end.hasSubscribers ||
+    channel.asyncStart.hasSubscribers ||
+    channel.asyncEnd.hasSubscribers ||
+    channel.error.hasSubscribers;
+}
+
+/**
+ * Wrap the functions of @p module so their calls are published on the
+ * native tracing channel.
+ *
+ * @param module - The loaded addon
+ * @returns A module with the same functions, or @p module itself when the
+ *   runtime has no tracing channels
+ */
+export function traceNativeModule<T extends object>(module: T): T {
+  const factory = (diagnosticsChannel as { tracingChannel?: (name: string) => TracingChannel }).tracingChannel;
+  if (typeof factory !== 'function') {
+    return module;
+  }
+  const channel = factory(NATIVE_TRACING_CHANNEL);
+  const active = hasSubscribersOf(channel);
+  const traced: Record<string, unknown> = { ...module };
+
+  for (const [op, value] of Object.entries(module)) {
+    if (typeof value !== 'function' || UNTRACED.has(op)) {
+      continue;
+    }
+    const fn = value as (...args: unknown[]) => unknown;
+    traced[op] = function (this: unknown, ...args: unknown[]): unknown {
+      if (!active()) {
+        return fn.apply(this, args);
+      }
+      const context: NativeCallContext = { op };
+      if (typeof args[0] !== 'string' && typeof args[1] === 'string' && !NO_BUCKET.has(op)) {
+        context.bucket = args[1];
+      }
+      return traceCall(channel, context, fn, this, args);
+    };
+  }
+  return traced as T;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file project/columns.ts
+ * @description Accessors for columnar listing pages
+ *
+ * Helpers for reading entries of an `ObjectColumns` page returned by
+ * `ProjectResultStruct.iterateObjectColumns()`.
+ */
+
+import type { ObjectColumns } from '../types';
+
+/**
+ * Decode the key of entry @p index of a columnar page.
+ *
+ * @param page - Columnar listing page
+ * @param index - Entry index, `0 <= index < page.count`
+ * @returns The object key
+ */
+export function columnKey(page: ObjectColumns, index: number): string {
+  const start = page.keyOffsets[index];
+  const end = page.keyOffsets[index + 1];
+  return Buffer.from(page.keyBytes.buffer, page.keyBytes.byteOffset + start, end - start).toString('utf8');
+}
+
+/**
+ * Whether entry @p index of a columnar page is a prefix.
+ *
+ * @param page - Columnar listing page
+ * @param index - Entry index, `0 <= index < page.count`
+ * @returns True for a prefix (directory) entry
+ */
+export function columnIsPrefix(page: ObjectColumns, index: number): boolean {
+  return (page.isPrefix[index >> 3] & (1 << (index & 7))) !== 0;
+}
@@ -5,23 +5,96 @@
  * Provides TypeScript wrapper for project operations.
  */
 
+import type { ReadableStream } from 'stream/web';
 import type {
   BucketInfo,
   ListBucketsOptions,
   ObjectInfo,
   ListObjectsOptions,
+  IterateObjectsOptions,
+  ListingCheckpoint,
+  StatCacheOptions,
+  StatCacheStats,
+  ObjectCacheOptions,
+  ObjectCacheStats,
+  KnownBucketsOptions,
+  KnownBucketsStats,
+  AdmissionStats,
+  LaneOptions,
+  SignalOptions,
+  RetryableOptions,
+  StatObjectsOptions,
+  StatObjectsResult,
+  WarmupOptions,
+  WarmupResult,
+  DeleteObjectsOptions,
+  DeleteObjectsResult,
+  DeletePrefixOptions,
+  DeletePrefixResult,
+  ExportListingOptions,
+  ExportListingResult,
+  ObjectPair,
+  ObjectPairsOptions,
+  ObjectPairsResult,
+  UpdateObjectsMetadataOptions,
+  UpdateObjectsMetadataResult,
+  ListObjectsParallelOptions,
+  ObjectField,
+  ObjectColumns,
   CopyObjectOptions,
   MoveObjectOptions,
   UploadOptions,
-  DownloadOptions,
+  UploadFileOptions,
+  UploadDirectoryOptions,
+  UploadDirectoryResult,
+  DiffOptions,
+  DiffResult,
+  SyncOptions,
+  SyncResult,
+  PutObjectOptions,
+  PutObjectDedupOptions,
+  PutObjectDedupResult,
+  ReplicaTarget,
+  UploadReplicatedOptions,
+  UploadReplicatedResult,
+  DownloadObjectOptions,
+  DownloadToFileOptions,
+  DownloadToFileResult,
+  DownloadRange,
+  DownloadRangesOptions,
+  ArchiveStreamOptions,
+  OpenPackOptions,
+  ReadStreamOptions,
+  WebReadStreamOptions,
+  WriteStreamOptions,
+  GetObjectOptions,
+  GetObjectResult,
 } from '../types';
 import { UploadResultStruct } from '../upload';
+import { UploadWriteStream } from '../upload/stream';
 import { DownloadResultStruct } from '../download';
+import { DownloadReadStream } from '../download/stream';
+import { ArchiveReadStream } from '../download/archive';
+import { PackUpload, PackReader, openPackReader, DEFAULT_PACK_WRITE_BUFFER } from './pack';
+import { createWebReadStream } from '../download/web-stream';
 import { native } from '../native';
+import { withSignal, throwIfAborted } from '../native/cancel';
+import { packMetadata } from '../native/metadata';
 
 /** Native handle type */
 type ProjectHandle = unknown;
 
+/** Objects fetched per native hop when listing */
+const LIST_OBJECTS_BATCH_SIZE = 1000;
+
+/** Default number of shards listed at once by listObjectsParallel */
+const LIST_OBJECTS_DEFAULT_CONCURRENCY = 4;
+
+/** Order keys by code unit, matching a plain string sort */
+function compareKeys(a: string, b: string): number {
+  return a < b ? -1 : a > b ? 1 : 0;
+}
+
 /**
  * Represents an open project on Storj.
  *
@@ -31,6 +104,7 @@ type ProjectHandle = unknown;
 export class ProjectResultStruct {
   private readonly _handle: ProjectHandle;
   private _isOpen: boolean = true;
+  private _isWarm: boolean = false;
 
   /**
    * Create a new ProjectResultStruct from a native handle
@@ -59,6 +133,13 @@ export class ProjectResultStruct {
     return this._isOpen;
   }
 
+  /**
+   * Check if a `warmup()` completed without errors
+   */
+  get isWarm(): boolean {
+    return this._isOpen && this._isWarm;
+  }
+
   /**
    * Close the project and release resources.
    *
@@ -115,6 +196,224 @@ export class ProjectResultStruct {
     await native.revokeAccess(this._handle, access._nativeHandle);
   }
 
+  /**
+   * Enable the statObject metadata cache for this project.
+   *
+   * `statObject()` results are kept in a bounded LRU for `ttlMs` and served
+   * without a satellite round trip. Writes through this binding (uploads,
+   * deletes, copies, moves, metadata updates) drop the affected entry;
+   * changes made by other clients are seen once the entry expires.
+   * Calling again reconfigures the cache and clears it.
+   *
+   * @param options - Entry limit (default 1024) and TTL (default 5000 ms)
+   * @throws TypeError if an option is not positive
+   *
+   * @example
+   * ```typescript
+   * project.enableStatCache({ ttlMs: 5000 });
+   * await project.statObject('my-bucket', 'a.txt'); // miss
+   * await project.statObject('my-bucket', 'a.txt'); // hit
+   * console.log(project.statCacheStats());
+   * ```
+   */
+  enableStatCache(options?: StatCacheOptions): void {
+    this.validateOpen();
+    native.projectEnableStatCache(this._handle, options);
+  }
+
+  /**
+   * Disable the statObject metadata cache and drop its entries.
+   */
+  disableStatCache(): void {
+    this.validateOpen();
+    native.projectDisableStatCache(this._handle);
+  }
+
+  /**
+   * Get the statObject metadata cache counters.
+   *
+   * @returns Hit, miss, and invalidation counts, or null when the cache is disabled
+   */
+  statCacheStats(): StatCacheStats | null {
+    this.validateOpen();
+    return native.projectStatCacheStats(this._handle) as StatCacheStats | null;
+  }
+
+  /**
+   * Enable the getObject contents cache for this project.
+   *
+   * Objects up to `maxObjectSize` read by `getObject()` are kept in an LRU
+   * capped at `maxBytes` for `ttlMs`. A hit returns an external Buffer over
+   * the cached memory with no copy and no network call, so treat `data` as
+   * read-only. Entries are keyed by bucket/key and remember the object's
+   * `created` time: writes through this binding drop them, as does a
+   * `statObject()` result (with the stat cache enabled) showing a different
+   * `created`; other changes by other clients are seen once the entry
+   * expires. Calling again reconfigures the cache and clears it.
+   *
+   * @param options - Byte limit (default 64 MiB), object size limit (default 1 MiB) and TTL (default 60000 ms)
+   * @throws TypeError if an option is not positive
+   *
+   * @example
+   * ```typescript
+   * project.enableObjectCache({ maxBytes: 256 << 20, maxObjectSize: 256 << 10 });
+   * const { data } = await project.getObject('config', 'flags.json'); // miss
+   * await project.getObject('config', 'flags.json'); // hit, same memory
+   * console.log(project.objectCacheStats());
+   * ```
+   */
+  enableObjectCache(options?: ObjectCacheOptions): void {
+    this.validateOpen();
+    native.projectEnableObjectCache(this._handle, options);
+  }
+
+  /**
+   * Disable the getObject contents cache and drop its entries.
+   *
+   * Buffers already handed out stay valid.
+   */
+  disableObjectCache(): void {
+    this.validateOpen();
+    native.projectDisableObjectCache(this._handle);
+  }
+
+  /**
+   * Get the getObject contents cache counters.
+   *
+   * @returns Hit, miss, invalidation, eviction and size counters, or null when the cache is disabled
+   */
+  objectCacheStats(): ObjectCacheStats | null {
+    this.validateOpen();
+    return native.projectObjectCacheStats(this._handle) as ObjectCacheStats | null;
+  }
+
+  /**
+   * Remember which buckets exist so repeat `ensureBucket()` calls are free.
+   *
+   * Buckets returned by `ensureBucket()` and `createBucket()` are recorded
+   * for `ttlMs`; while recorded, `ensureBucket()` resolves without a
+   * satellite round trip. `deleteBucket()` and `deleteBucketWithObjects()`
+   * drop the name; deletions by other clients are seen once the entry
+   * expires. Calling again reconfigures the set and clears it.
+   *
+   * @param options - TTL (default 300000 ms)
+   * @throws TypeError if ttlMs is not positive
+   *
+   * @example
+   * ```typescript
+   * project.enableKnownBuckets();
+   * await project.ensureBucket('uploads'); // satellite round trip
+   * await project.ensureBucket('uploads'); // resolved from the set
+   * ```
+   */
+  enableKnownBuckets(options?: KnownBucketsOptions): void {
+    this.validateOpen();
+    native.projectEnableKnownBuckets(this._handle, options);
+  }
+
+  /**
+   * Disable the known bucket set and drop its names.
+   */
+  disableKnownBuckets(): void {
+    this.validateOpen();
+    native.projectDisableKnownBuckets(this._handle);
+  }
+
+  /**
+   * Get the known bucket set counters.
+   *
+   * @returns Hit, miss, and invalidation counts, or null when the set is disabled
+   */
+  knownBucketsStats(): KnownBucketsStats | null {
+    this.validateOpen();
+    return native.projectKnownBucketsStats(this._handle) as KnownBucketsStats | null;
+  }
+
+  /**
+   * Get the admission queue depths of a project opened with concurrency limits.
+   *
+   * @returns Active and queued call counts, or null when the project has no limits
+   */
+  admissionStats(): AdmissionStats | null {
+    this.validateOpen();
+    return native.projectAdmissionStats(this._handle) as AdmissionStats | null;
+  }
+
+  /**
+   * Pay connection setup before the first real request.
+   *
+   * Opening a project does not dial; the first call does. Warm-up stats
+   * the listed buckets concurrently, or fetches one bucket listing page
+   * when none are given, so the satellite connection is up afterwards.
+   * Listed objects are stat'ed too, which seeds the stat cache when it is
+   * enabled. Per-bucket failures are reported rather than thrown, so a
+   * readiness probe can check `errors` or `isWarm`.
+   *
+   * @param options - Buckets and objects to stat, and a signal for the object stats
+   * @returns Stat'ed buckets, failures, and the time taken
+   * @throws TypeError if a bucket name or object key is invalid
+   * @throws Error if dialing without buckets fails
+   *
+   * @example
+   * ```typescript
+   * const project = await access.openProject();
+   * const { errors } = await project.warmup({ buckets: ['media', 'thumbs'] });
+   * if (errors.length === 0) markReady();
+   * ```
+   */
+  async warmup(options: WarmupOptions = {}): Promise<WarmupResult> {
+    this.validateOpen();
+    const { buckets = [], objects = [], ...signalOptions } = options;
+    buckets.forEach((name) => this.validateBucketName(name));
+    objects.forEach(({ bucket, keys }) => {
+      this.validateBucketName(bucket);
+      if (!Array.isArray(keys)) {
+        throw new TypeError('objects[].keys must be an array');
+      }
+      keys.forEach((key) => this.validateObjectKey(key));
+    });
+
+    const started = performance.now();
+    const errors: WarmupResult['errors'] = [];
+    let infos: Array<BucketInfo | null> = [];
+    if (buckets.length === 0) {
+      const iterator = await native.listBucketsCreate(this._handle, undefined);
+      try {
+        await native.bucketIteratorNext(iterator);
+        const err = await native.bucketIteratorErr(iterator);
+        if (err) {
+          throw err;
+        }
+      } finally {
+        await native.freeBucketIterator(iterator);
+      }
+    } else {
+      infos = await Promise.all(
+        buckets.map((name) =>
+          this.statBucket(name).catch((error: Error) => {
+            errors.push({ bucket: name, error });
+            return null;
+          })
+        )
+      );
+    }
+
+    await Promise.all(
+      objects.map(({ bucket, keys }) =>
+        this.statObjects(bucket, keys, signalOptions).catch((error: Error) => {
+          errors.push({ bucket, error });
+        })
+      )
+    );
+
+    this._isWarm = errors.length === 0;
+    return {
+      buckets: infos.filter((info): info is BucketInfo => info !== null),
+      errors,
+      elapsedMs: performance.now() - started,
+    };
+  }
+
   /**
    * Validate that the project is still open
    * @throws Error if project is closed
@@ -175,7 +474,8 @@ export class ProjectResultStruct {
    * Ensure a bucket exists, creating it if necessary.
    *
    * This is idempotent - calling it multiple times has the same effect
-   * as calling it once.
+   * as calling it once. With `enableKnownBuckets()`, a bucket ensured or
+   * created recently resolves without a satellite round trip.
    *
    * @param name - Bucket name (3-63 lowercase alphanumeric chars or hyphens)
    * @returns Promise resolving to the bucket info
@@ -260,6 +560,9 @@ export class ProjectResultStruct {
   /**
    * List all buckets in the project.
    *
+   * The listing is drained natively in one call, however many buckets
+   * the project has.
+   *
    * @param options - Optional listing options
    * @returns Promise resolving to an array of bucket info
    *
@@ -273,21 +576,7 @@ export class ProjectResultStruct {
    */
   async listBuckets(options?: ListBucketsOptions): Promise<BucketInfo[]> {
     this.validateOpen();
-    const iterator = await native.listBucketsCreate(this._handle, options);
-    const buckets: BucketInfo[] = [];
-    try {
-      while (await native.bucketIteratorNext(iterator)) {
-        const bucket = await native.bucketIteratorItem(iterator);
-        buckets.push(bucket as BucketInfo);
-      }
-      const err = await native.bucketIteratorErr(iterator);
-      if (err) {
-        throw err;
-      }
-    } finally {
-      await native.freeBucketIterator(iterator);
-    }
-    return buckets;
+    return withSignal(options, (o) => native.collectBuckets(this._handle, o) as Promise<BucketInfo[]>);
   }
 
   // ========== Object Operations ==========
@@ -308,6 +597,7 @@ export class ProjectResultStruct {
    *
    * @param bucketName - Name of the bucket containing the object
    * @param objectKey - Object key (path)
+   * @param options - Optional lane override (default `'metadata'`) and abort signal
    * @returns Promise resolving to the object info
    * @throws TypeError if bucket name or object key is invalid
    * @throws Error if object does not exist
@@ -319,11 +609,50 @@ export class ProjectResultStruct {
    * console.log(`Created: ${info.system.created}`);
    * ```
    */
-  async statObject(bucketName: string, objectKey: string): Promise<ObjectInfo> {
+  async statObject(
+    bucketName: string,
+    objectKey: string,
+    options?: LaneOptions & SignalOptions & RetryableOptions
+  ): Promise<ObjectInfo> {
     this.validateOpen();
     this.validateBucketName(bucketName);
     this.validateObjectKey(objectKey);
-    return native.statObject(this._handle, bucketName, objectKey) as Promise<ObjectInfo>;
+    return withSignal(options, (o) => native.statObject(this._handle, bucketName, objectKey, o) as Promise<ObjectInfo>);
+  }
+
+  /**
+   * Get information about many objects of one bucket in a single native call.
+   *
+   * The stats run concurrently on native threads. A missing key yields
+   * `null`; any other per-key failure also yields `null` and is listed in
+   * `errors`, so one bad key does not reject the whole batch.
+   *
+   * @param bucketName - Name of the bucket containing the objects
+   * @param objectKeys - Object keys (paths)
+   * @param options - Concurrency options and abort signal
+   * @returns Promise resolving to per-key objects and errors
+   * @throws TypeError if the bucket name or any object key is invalid
+   *
+   * @example
+   * ```typescript
+   * const { objects, errors } = await project.statObjects('my-bucket', ['a.txt', 'b.txt']);
+   * ```
+   */
+  async statObjects(
+    bucketName: string,
+    objectKeys: readonly string[],
+    options?: StatObjectsOptions
+  ): Promise<StatObjectsResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    if (!Array.isArray(objectKeys)) {
+      throw new TypeError('objectKeys must be an array');
+    }
+    objectKeys.forEach((key) => this.validateObjectKey(key));
+    return withSignal(
+      options,
+      (o) => native.statObjects(this._handle, bucketName, objectKeys, o) as Promise<StatObjectsResult>
+    );
   }
 
   /**
@@ -347,6 +676,107 @@ export class ProjectResultStruct {
     return native.deleteObject(this._handle, bucketName, objectKey);
   }
 
+  /**
+   * Delete many objects of one bucket in a single native call.
+   *
+   * The deletions run concurrently on native threads and settle one
+   * promise with a summary; per-key failures do not reject it.
+   *
+   * @param bucketName - Name of the bucket containing the objects
+   * @param objectKeys - Object keys (paths)
+   * @param options - Concurrency options and abort signal
+   * @returns Promise resolving to deleted and missing counts and the failed keys
+   * @throws TypeError if the bucket name or any object key is invalid
+   *
+   * @example
+   * ```typescript
+   * const { deleted, failed } = await project.deleteObjects('my-bucket', keys, { concurrency: 16 });
+   * ```
+   */
+  async deleteObjects(
+    bucketName: string,
+    objectKeys: readonly string[],
+    options?: DeleteObjectsOptions
+  ): Promise<DeleteObjectsResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    if (!Array.isArray(objectKeys)) {
+      throw new TypeError('objectKeys must be an array');
+    }
+    objectKeys.forEach((key) => this.validateObjectKey(key));
+    return withSignal(
+      options,
+      (o) => native.deleteObjects(this._handle, bucketName, objectKeys, o) as Promise<DeleteObjectsResult>
+    );
+  }
+
+  /**
+   * Delete every object under a prefix in a single native call.
+   *
+   * A native listing feeds a bounded queue of deletion threads, so listing
+   * and deleting overlap and keys are never collected in JavaScript.
+   * Per-object failures are counted; a listing failure rejects.
+   *
+   * @param bucketName - Name of the bucket containing the objects
+   * @param prefix - Key prefix; must be non-empty and end with `/`
+   * @param options - Concurrency, dry-run, and abort signal options
+   * @returns Promise resolving to listing and deletion totals
+   * @throws TypeError if the bucket name or prefix is invalid
+   *
+   * @example
+   * ```typescript
+   * const { deleted } = await project.deletePrefix('my-bucket', 'tenants/42/', { concurrency: 16 });
+   * ```
+   */
+  async deletePrefix(bucketName: string, prefix: string, options?: DeletePrefixOptions): Promise<DeletePrefixResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    if (typeof prefix !== 'string' || !prefix.endsWith('/')) {
+      throw new TypeError('prefix must be a non-empty string ending with "/"');
+    }
+    return withSignal(
+      options,
+      (o) => native.deletePrefix(this._handle, bucketName, prefix, o) as Promise<DeletePrefixResult>
+    );
+  }
+
+  /**
+   * Write a bucket listing straight to a file.
+   *
+   * The listing is iterated and serialized on a native thread into a
+   * buffered file writer; no per-object JavaScript values are created, so
+   * memory stays constant however large the bucket. `'ndjson'` writes one
+   * `ObjectInfo`-shaped JSON object per line; `'binary'` writes the compact
+   * record format described in the API docs. The file is truncated first
+   * and keeps what was written if the export fails.
+   *
+   * @param bucketName - Name of the bucket to list
+   * @param filePath - Destination file, created or truncated
+   * @param options - Listing, format, and abort signal options
+   * @returns Promise resolving to record and byte totals
+   * @throws TypeError if the bucket name or format is invalid
+   *
+   * @example
+   * ```typescript
+   * const { objects } = await project.exportListing('archive', '/exports/archive.ndjson', {
+   *   recursive: true,
+   *   includeCustom: true,
+   * });
+   * ```
+   */
+  async exportListing(
+    bucketName: string,
+    filePath: string,
+    options?: ExportListingOptions
+  ): Promise<ExportListingResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    return withSignal(
+      options,
+      (o) => native.exportListing(this._handle, bucketName, filePath, o) as Promise<ExportListingResult>
+    );
+  }
+
   /**
    * List objects in a bucket.
    *
@@ -375,17 +805,26 @@ export class ProjectResultStruct {
    *     console.log(`${obj.key} (${obj.system.contentLength} bytes)`);
    *   }
    * }
+   *
+   * // Keys only: plain strings, no per-object conversion
+   * const keys = await project.listObjects('my-bucket', { recursive: true, fields: ['key'] });
    * ```
    */
-  async listObjects(bucketName: string, options?: ListObjectsOptions): Promise<ObjectInfo[]> {
+  listObjects(bucketName: string, options: ListObjectsOptions & { fields: readonly ['key'] }): Promise<string[]>;
+  listObjects(bucketName: string, options?: ListObjectsOptions): Promise<ObjectInfo[]>;
+  async listObjects(bucketName: string, options?: ListObjectsOptions): Promise<ObjectInfo[] | string[]> {
     this.validateOpen();
     this.validateBucketName(bucketName);
-    const iterator = await native.listObjectsCreate(this._handle, bucketName, options);
+    const iterator = await withSignal(options, (o) => native.listObjectsCreate(this._handle, bucketName, o));
     const objects: ObjectInfo[] = [];
     try {
-      while (await native.objectIteratorNext(iterator)) {
-        const obj = await native.objectIteratorItem(iterator);
-        objects.push(obj as ObjectInfo);
+      for (;;) {
+        throwIfAborted(options?.signal);
+        const batch = (await native.objectIteratorNextBatch(iterator, LIST_OBJECTS_BATCH_SIZE)) as ObjectInfo[];
+        objects.push(...batch);
+        if (batch.length < LIST_OBJECTS_BATCH_SIZE) {
+          break;
+        }
       }
       const err = await native.objectIteratorErr(iterator);
       if (err) {
@@ -397,6 +836,215 @@ export class ProjectResultStruct {
     return objects;
   }
 
+  /**
+   * List a bucket as several independent prefix shards at once.
+   *
+   * Each shard gets its own native iterator, listed recursively, and up to
+   * `concurrency` shards run together on the native thread pool. With
+   * `shardBy: 'delimiter'` the top level under `prefix` is listed first:
+   * its prefixes become shards and its objects are returned directly.
+   * Shards cover disjoint key ranges, so with the default 'lexicographic'
+   * order sorting each shard and the shards themselves gives a sorted
+   * result; 'unordered' skips the sort and returns shards as they finish.
+   *
+   * @param bucketName - Name of the bucket to list objects from
+   * @param options - Shards, concurrency, merge order, and listing options
+   * @returns Promise resolving to the merged listing
+   * @throws TypeError if bucket name or options are invalid
+   *
+   * @example
+   * ```typescript
+   * const objects = await project.listObjectsParallel('my-bucket', {
+   *   shardBy: 'delimiter',
+   *   concurrency: 16,
+   * });
+   * ```
+   */
+  listObjectsParallel(
+    bucketName: string,
+    options: ListObjectsParallelOptions & { fields: readonly ['key'] }
+  ): Promise<string[]>;
+  listObjectsParallel(bucketName: string, options: ListObjectsParallelOptions): Promise<ObjectInfo[]>;
+  async listObjectsParallel(bucketName: string, options: ListObjectsParallelOptions): Promise<ObjectInfo[] | string[]> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    const {
+      prefixes,
+      shardBy,
+      concurrency = LIST_OBJECTS_DEFAULT_CONCURRENCY,
+      order = 'lexicographic',
+      ...listOptions
+    } = options ?? {};
+    if ((prefixes === undefined) === (shardBy === undefined)) {
+      throw new TypeError("exactly one of prefixes or shardBy: 'delimiter' is required");
+    }
+    if (shardBy !== undefined && shardBy !== 'delimiter') {
+      throw new TypeError("shardBy must be 'delimiter'");
+    }
+    if (!Number.isInteger(concurrency) || concurrency < 1) {
+      throw new TypeError('concurrency must be a positive integer');
+    }
+    if (order !== 'lexicographic' && order !== 'unordered') {
+      throw new TypeError("order must be 'lexicographic' or 'unordered'");
+    }
+    const { fields } = listOptions;
+    if (order === 'lexicographic' && fields && !fields.includes('key')) {
+      throw new TypeError("fields must include 'key' for lexicographic order");
+    }
+
+    // Each run is one shard's listing, or a top-level object on its own
+    const runs: Array<{ start: string; objects: ObjectInfo[] }> = [];
+    let shards: string[];
+    if (prefixes !== undefined) {
+      shards = [...prefixes];
+    } else {
+      const keysOnly = fields?.length === 1 && fields[0] === 'key';
+      const topFields = fields ? Array.from(new Set<ObjectField>([...fields, 'key', 'isPrefix'])) : undefined;
+      const top = await this.listObjects(bucketName, { ...listOptions, recursive: false, fields: topFields });
+      shards = top.filter((obj) => obj.isPrefix).map((obj) => obj.key);
+      for (const obj of top) {
+        if (!obj.isPrefix) {
+          runs.push({ start: obj.key, objects: [keysOnly ? (obj.key as unknown as ObjectInfo) : obj] });
+        }
+      }
+    }
+
+    const keyOf = (obj: ObjectInfo | string): string => (typeof obj === 'string' ? obj : obj.key);
+    let next = 0;
+    const worker = async (): Promise<void> => {
+      while (next < shards.length) {
+        const prefix = shards[next++];
+        const objects = await this.listObjects(bucketName, { ...listOptions, prefix, recursive: true });
+        if (order === 'lexicographic') {
+          objects.sort((a, b) => compareKeys(keyOf(a), keyOf(b)));
+        }
+        runs.push({ start: prefix, objects });
+      }
+    };
+    await Promise.all(Array.from({ length: Math.min(concurrency, shards.length) }, worker));
+
+    if (order === 'lexicographic') {
+      runs.sort((a, b) => compareKeys(a.start, b.start));
+    }
+    return runs.flatMap((run) => run.objects);
+  }
+
+  /**
+   * Stream the objects in a bucket without materializing the listing.
+   *
+   * Objects are fetched a page at a time with one native call per page.
+   * While the caller consumes page N, page N+1 is already being fetched,
+   * so at most two pages are held in memory however large the bucket is.
+   * Breaking out of the loop frees the native iterator.
+   *
+   * `onCheckpoint` receives a checkpoint after each page has been
+   * consumed; after a failure, passing the last one as `checkpoint`
+   * resumes the scan instead of starting over.
+   *
+   * @param bucketName - Name of the bucket to list objects from
+   * @param options - Listing options and page size
+   * @returns Async iterator over object info
+   * @throws TypeError if bucket name or page size is invalid
+   *
+   * @example
+   * ```typescript
+   * for await (const obj of project.iterateObjects('my-bucket', { recursive: true })) {
+   *   console.log(obj.key);
+   * }
+   * ```
+   */
+  iterateObjects(
+    bucketName: string,
+    options: IterateObjectsOptions & { fields: readonly ['key'] }
+  ): AsyncGenerator<string>;
+  iterateObjects(bucketName: string, options?: IterateObjectsOptions): AsyncGenerator<ObjectInfo>;
+  async *iterateObjects(bucketName: string, options?: IterateObjectsOptions): AsyncGenerator<ObjectInfo | string> {
+    for await (const page of this.iteratePages(
+      bucketName,
+      options,
+      (iterator, pageSize) => native.objectIteratorNextBatch(iterator, pageSize) as Promise<ObjectInfo[]>,
+      (page) => page.length
+    )) {
+      yield* page;
+    }
+  }
+
+  /**
+   * Stream a listing as packed columnar pages.
+   *
+   * Each page is one ArrayBuffer viewed as typed-array columns instead of
+   * one JS object per entry, which keeps per-page cost low for analytics
+   * such as per-prefix size totals. Keys are UTF-8 bytes in `keyBytes`;
+   * key `i` spans `keyOffsets[i]` to `keyOffsets[i + 1]` (see
+   * `columnKey()`). Like `iterateObjects()`, the next page is fetched in
+   * the background.
+   *
+   * @param bucketName - Name of the bucket to list objects from
+   * @param options - Listing options and page size (`fields` is ignored)
+   * @returns Async iterator over columnar pages
+   * @throws TypeError if bucket name or page size is invalid
+   *
+   * @example
+   * ```typescript
+   * let total = 0n;
+   * for await (const page of project.iterateObjectColumns('my-bucket', { recursive: true })) {
+   *   for (let i = 0; i < page.count; i++) total += page.contentLength[i];
+   * }
+   * ```
+   */
+  async *iterateObjectColumns(bucketName: string, options?: IterateObjectsOptions): AsyncGenerator<ObjectColumns> {
+    yield* this.iteratePages(
+      bucketName,
+      { ...options, fields: undefined },
+      (iterator, pageSize) => native.objectIteratorNextColumns(iterator, pageSize) as Promise<ObjectColumns>,
+      (page) => page.count
+    );
+  }
+
+  /**
+   * Drive a native object iterator page by page, fetching page N+1 while
+   * the caller consumes page N, and free it however iteration ends.
+   */
+  private async *iteratePages<T>(
+    bucketName: string,
+    options: IterateObjectsOptions | undefined,
+    fetch: (iterator: unknown, pageSize: number) => Promise<T>,
+    sizeOf: (page: T) => number
+  ): AsyncGenerator<T> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    const { pageSize = LIST_OBJECTS_BATCH_SIZE, onCheckpoint, ...listOptions } = options ?? {};
+    if (!Number.isInteger(pageSize) || pageSize <= 0) {
+      throw new TypeError('pageSize must be a positive integer');
+    }
+
+    const iterator = await withSignal(listOptions, (o) => native.listObjectsCreate(this._handle, bucketName, o));
+    let pending: Promise<T> | null = fetch(iterator, pageSize);
+    try {
+      while (pending !== null) {
+        const page: T = await pending;
+        throwIfAborted(listOptions.signal);
+        // Read before the prefetch moves the checkpoint past this page
+        const checkpoint = onCheckpoint ? native.objectIteratorCheckpoint(iterator) : null;
+        pending = sizeOf(page) < pageSize ? null : fetch(iterator, pageSize);
+        yield page;
+        if (checkpoint !== null) {
+          onCheckpoint?.(checkpoint as ListingCheckpoint);
+        }
+      }
+      const err = await native.objectIteratorErr(iterator);
+      if (err) {
+        throw err;
+      }
+    } finally {
+      // The iterator must not be freed while a prefetch is still running on it
+      if (pending !== null) {
+        await pending.catch(() => undefined);
+      }
+      await native.freeObjectIterator(iterator);
+    }
+  }
+
   /**
    * Copy an object to a new location.
    *
@@ -489,24 +1137,78 @@ export class ProjectResultStruct {
   }
 
   /**
-   * Update object custom metadata.
+   * Copy many objects in a single native call.
    *
-   * Replaces the existing custom metadata with new metadata.
-   * System metadata (created, expires, contentLength) cannot be modified.
+   * The copies run concurrently on native threads; one pair failing does
+   * not affect the others and is reported in the packed status array.
    *
-   * @param bucketName - Bucket name containing the object
-   * @param objectKey - Object key to update
-   * @param metadata - New custom metadata (replaces existing)
-   * @returns Promise resolving when metadata is updated
-   * @throws TypeError if bucket name or object key is invalid
-   * @throws Error if object does not exist
+   * @param pairs - Source and destination of each copy
+   * @param options - Concurrency options and abort signal
+   * @returns Promise resolving to the per-pair status
+   * @throws TypeError if any bucket name or object key is invalid
    *
    * @example
    * ```typescript
-   * // Update custom metadata
-   * await project.updateObjectMetadata('my-bucket', 'file.txt', {
-   *   'Content-Type': 'text/plain',
-   *   'X-Author': 'John Doe',
+   * const { status } = await project.copyObjects([
+   *   { oldBucket: 'b', oldKey: 'v1/a', newBucket: 'b', newKey: 'v2/a' },
+   * ]);
+   * ```
+   */
+  async copyObjects(pairs: readonly ObjectPair[], options?: ObjectPairsOptions): Promise<ObjectPairsResult> {
+    this.validatePairs(pairs);
+    return withSignal(options, (o) => native.copyObjects(this._handle, pairs, o) as Promise<ObjectPairsResult>);
+  }
+
+  /**
+   * Move (rename) many objects in a single native call.
+   *
+   * Same behaviour and result as `copyObjects()`.
+   *
+   * @param pairs - Source and destination of each move
+   * @param options - Concurrency options and abort signal
+   * @returns Promise resolving to the per-pair status
+   * @throws TypeError if any bucket name or object key is invalid
+   */
+  async moveObjects(pairs: readonly ObjectPair[], options?: ObjectPairsOptions): Promise<ObjectPairsResult> {
+    this.validatePairs(pairs);
+    return withSignal(options, (o) => native.moveObjects(this._handle, pairs, o) as Promise<ObjectPairsResult>);
+  }
+
+  /**
+   * Validate the pairs of a batched copy or move.
+   */
+  private validatePairs(pairs: readonly ObjectPair[]): void {
+    this.validateOpen();
+    if (!Array.isArray(pairs)) {
+      throw new TypeError('pairs must be an array');
+    }
+    for (const pair of pairs) {
+      this.validateBucketName(pair.oldBucket);
+      this.validateObjectKey(pair.oldKey);
+      this.validateBucketName(pair.newBucket);
+      this.validateObjectKey(pair.newKey);
+    }
+  }
+
+  /**
+   * Update object custom metadata.
+   *
+   * Replaces the existing custom metadata with new metadata.
+   * System metadata (created, expires, contentLength) cannot be modified.
+   *
+   * @param bucketName - Bucket name containing the object
+   * @param objectKey - Object key to update
+   * @param metadata - New custom metadata (replaces existing)
+   * @returns Promise resolving when metadata is updated
+   * @throws TypeError if bucket name or object key is invalid
+   * @throws Error if object does not exist
+   *
+   * @example
+   * ```typescript
+   * // Update custom metadata
+   * await project.updateObjectMetadata('my-bucket', 'file.txt', {
+   *   'Content-Type': 'text/plain',
+   *   'X-Author': 'John Doe',
    *   'X-Version': '2'
    * });
    *
@@ -527,7 +1229,88 @@ export class ProjectResultStruct {
       throw new TypeError('metadata must be an object');
     }
 
-    return native.updateObjectMetadata(this._handle, bucketName, objectKey, metadata);
+    return native.updateObjectMetadata(this._handle, bucketName, objectKey, packMetadata(metadata));
+  }
+
+  /**
+   * Replace the custom metadata of many objects of one bucket in a single
+   * native call.
+   *
+   * Pass one metadata object to apply it to every key, or an array with
+   * one entry per key. Each distinct metadata object is encoded once, so
+   * reusing the same object for many keys costs no more than one. The
+   * updates run concurrently on native threads; one key failing does not
+   * affect the others and is reported in the packed status array.
+   *
+   * @param bucketName - Bucket name containing the objects
+   * @param objectKeys - Object keys to update
+   * @param metadata - New custom metadata for every key, or per key
+   * @param options - Concurrency, retry options and abort signal
+   * @returns Promise resolving to the per-key status
+   * @throws TypeError if the bucket name, any key or any metadata is invalid
+   *
+   * @example
+   * ```typescript
+   * const { succeeded, errors } = await project.updateObjectsMetadata('photos', keys, { reviewed: 'yes' }, {
+   *   concurrency: 32,
+   * });
+   * ```
+   */
+  async updateObjectsMetadata(
+    bucketName: string,
+    objectKeys: readonly string[],
+    metadata: Record<string, string> | readonly Record<string, string>[],
+    options?: UpdateObjectsMetadataOptions
+  ): Promise<UpdateObjectsMetadataResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    if (!Array.isArray(objectKeys)) {
+      throw new TypeError('objectKeys must be an array');
+    }
+    objectKeys.forEach((key) => this.validateObjectKey(key));
+
+    const sets: Buffer[] = [];
+    let setIndex: Uint32Array | null = null;
+    if (Array.isArray(metadata)) {
+      if (metadata.length !== objectKeys.length) {
+        throw new TypeError('metadata must have one entry per key');
+      }
+      const seen = new Map<Record<string, string>, number>();
+      setIndex = new Uint32Array(metadata.length);
+      for (let i = 0; i < metadata.length; i++) {
+        const entry = metadata[i];
+        let index = seen.get(entry);
+        if (index === undefined) {
+          if (entry == null || typeof entry !== 'object') {
+            throw new TypeError('metadata must be an object');
+          }
+          index = sets.push(packMetadata(entry)) - 1;
+          seen.set(entry, index);
+        }
+        setIndex[i] = index;
+      }
+      if (sets.length === 0) {
+        sets.push(packMetadata({}));
+      }
+    } else {
+      if (metadata == null || typeof metadata !== 'object') {
+        throw new TypeError('metadata must be an object');
+      }
+      sets.push(packMetadata(metadata as Record<string, string>));
+    }
+
+    return withSignal(
+      options,
+      (o) =>
+        native.updateObjectsMetadata(
+          this._handle,
+          bucketName,
+          objectKeys,
+          sets,
+          setIndex,
+          o
+        ) as Promise<UpdateObjectsMetadataResult>
+    );
   }
 
   // ========== Upload Operations ==========
@@ -557,6 +1340,20 @@ export class ProjectResultStruct {
    * await upload.write(data, data.length);
    * await upload.commit();
    *
+   * // Coalesce many small writes in a 4 MiB native buffer
+   * const upload = await project.uploadObject('my-bucket', 'app.log', {
+   *   writeBufferSize: 4 << 20
+   * });
+   * for (const line of lines) await upload.write(line);
+   * await upload.commit();
+   *
+   * // Store a SHA-256 of the content as custom metadata 'checksum-sha256'
+   * const upload = await project.uploadObject('my-bucket', 'backup.tar', {
+   *   checksum: 'sha256'
+   * });
+   * await upload.write(data, data.length);
+   * await upload.commit();
+   *
    * // Upload with custom metadata
    * const upload = await project.uploadObject('my-bucket', 'photo.jpg');
    * await upload.setCustomMetadata({
@@ -576,8 +1373,365 @@ export class ProjectResultStruct {
     this.validateBucketName(bucketName);
     this.validateObjectKey(objectKey);
 
-    const handle = await native.uploadObject(this._handle, bucketName, objectKey, options);
-    return new UploadResultStruct(handle);
+    const handle = await withSignal(options, (o) => native.uploadObject(this._handle, bucketName, objectKey, o));
+    const upload = new UploadResultStruct(handle);
+    if (options?.signal?.aborted) {
+      // Aborted while opening: release the upload and its admission slot now
+      await upload.abort().catch(() => undefined);
+      throwIfAborted(options.signal);
+    }
+    return upload;
+  }
+
+  /**
+   * Create a Writable stream that uploads to an object.
+   *
+   * Writes are pipelined into the native upload in order, with up to
+   * `maxInFlight` queued ahead of the producer, and backpressure applied
+   * through `highWaterMark`. `end()` commits the upload and `destroy()`
+   * aborts it.
+   *
+   * @param bucketName - Name of the bucket to upload to
+   * @param objectKey - Object key (path) for the uploaded object
+   * @param options - Optional upload, metadata, and pipelining options
+   * @returns A Writable stream; 'finish' fires after the commit
+   * @throws TypeError if bucket name or object key is invalid
+   *
+   * @example
+   * ```typescript
+   * req.pipe(project.createWriteStream('my-bucket', 'upload.bin', { maxInFlight: 8 }));
+   * ```
+   */
+  createWriteStream(
+    bucketName: string,
+    objectKey: string,
+    options?: WriteStreamOptions
+  ): UploadWriteStream {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    this.validateObjectKey(objectKey);
+
+    return new UploadWriteStream(this._handle, bucketName, objectKey, options);
+  }
+
+  /**
+   * Upload a local file in a single native operation.
+   *
+   * The file is opened and read on a worker thread into a reusable
+   * native buffer, written to the upload, and committed, without any
+   * chunk ever passing through the JS heap.
+   *
+   * @param bucketName - Name of the bucket to upload to
+   * @param objectKey - Object key (path) for the uploaded object
+   * @param filePath - Path of the local file to upload
+   * @param options - Optional chunk size, expiration, and custom metadata
+   * @returns Promise resolving to the committed object info
+   * @throws TypeError if bucket name, object key, or path is invalid
+   *
+   * @example
+   * ```typescript
+   * const info = await project.uploadFile('my-bucket', 'backup.tar', '/var/backups/backup.tar', {
+   *   chunkSize: 4 * 1024 * 1024,
+   *   metadata: { 'Content-Type': 'application/x-tar' },
+   * });
+   * console.log(`Uploaded ${info.system.contentLength} bytes`);
+   * ```
+   */
+  async uploadFile(
+    bucketName: string,
+    objectKey: string,
+    filePath: string,
+    options?: UploadFileOptions
+  ): Promise<ObjectInfo> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    this.validateObjectKey(objectKey);
+
+    if (!filePath || typeof filePath !== 'string') {
+      throw new TypeError('filePath must be a non-empty string');
+    }
+
+    return withSignal(
+      options,
+      (o) => native.uploadFile(this._handle, bucketName, objectKey, filePath, o) as Promise<ObjectInfo>
+    );
+  }
+
+  /**
+   * Upload every file below a local directory in a single native call.
+   *
+   * The tree is walked on a worker thread and the files are uploaded by a
+   * native thread pool, largest first; files over `largeFileThreshold` go
+   * through the parallel multipart engine. Each object key is `prefix`
+   * followed by the file's '/'-separated path below `localDir`. A file that
+   * fails is counted and reported without stopping the others.
+   *
+   * @param localDir - Local directory to upload
+   * @param bucketName - Name of the bucket to upload to
+   * @param prefix - Key prefix; empty or ending with '/'
+   * @param options - Concurrency, include filters, and progress callback
+   * @returns Promise resolving to upload totals
+   * @throws TypeError if the directory, bucket name, or prefix is invalid
+   *
+   * @example
+   * ```typescript
+   * const { uploaded, failed } = await project.uploadDirectory('./site', 'www', 'v2/', {
+   *   include: ['*.html', 'assets/**'],
+   *   onProgress: (p) => console.log(`${p.bytesDone}/${p.bytesTotal}`),
+   * });
+   * ```
+   */
+  async uploadDirectory(
+    localDir: string,
+    bucketName: string,
+    prefix = '',
+    options?: UploadDirectoryOptions
+  ): Promise<UploadDirectoryResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+
+    if (!localDir || typeof localDir !== 'string') {
+      throw new TypeError('localDir must be a non-empty string');
+    }
+    if (typeof prefix !== 'string' || (prefix !== '' && !prefix.endsWith('/'))) {
+      throw new TypeError("prefix must be empty or end with '/'");
+    }
+
+    return withSignal(
+      options,
+      (o) => native.uploadDirectory(this._handle, localDir, bucketName, prefix, o) as Promise<UploadDirectoryResult>
+    );
+  }
+
+  /**
+   * Compare a local directory with a bucket prefix and plan the uploads
+   * and deletes that would make the prefix mirror it.
+   *
+   * A worker thread walks the directory in key order and merges it with
+   * the recursive listing of `prefix` as both stream by, so memory grows
+   * with the plan, not with the tree. Keys map to files as in
+   * `uploadDirectory()`. Nothing is changed; see `sync()` to run the plan.
+   *
+   * @param localDir - Local directory to compare
+   * @param bucketName - Name of the bucket
+   * @param prefix - Key prefix; empty or ending with '/'
+   * @param options - Comparison mode and include filters
+   * @returns Promise resolving to the plan
+   * @throws TypeError if the directory, bucket name, or prefix is invalid
+   *
+   * @example
+   * ```typescript
+   * const plan = await project.diff('./site', 'www', 'v2/', { compare: 'checksum' });
+   * console.log(`${plan.upload.length} to upload, ${plan.delete.length} to delete`);
+   * ```
+   */
+  async diff(localDir: string, bucketName: string, prefix = '', options?: DiffOptions): Promise<DiffResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+
+    if (!localDir || typeof localDir !== 'string') {
+      throw new TypeError('localDir must be a non-empty string');
+    }
+    if (typeof prefix !== 'string' || (prefix !== '' && !prefix.endsWith('/'))) {
+      throw new TypeError("prefix must be empty or end with '/'");
+    }
+
+    return withSignal(
+      options,
+      (o) => native.diffDirectory(this._handle, localDir, bucketName, prefix, o) as Promise<DiffResult>
+    );
+  }
+
+  /**
+   * Make a bucket prefix mirror a local directory.
+   *
+   * Runs `diff()`, uploads the new and changed files through the
+   * `uploadDirectory()` engine, and then, with `delete: true`, removes the
+   * objects that have no local file through `deleteObjects()`.
+   *
+   * @param localDir - Local directory to mirror
+   * @param bucketName - Name of the bucket
+   * @param prefix - Key prefix; empty or ending with '/'
+   * @param options - Comparison mode, deletion, and upload tuning
+   * @returns Promise resolving to the plan and the upload and delete totals
+   * @throws TypeError if the directory, bucket name, or prefix is invalid
+   *
+   * @example
+   * ```typescript
+   * const { plan, upload } = await project.sync('./site', 'www', 'v2/', { delete: true });
+   * console.log(`${upload?.uploaded ?? 0} uploaded, ${plan.unchanged} unchanged`);
+   * ```
+   */
+  async sync(localDir: string, bucketName: string, prefix = '', options: SyncOptions = {}): Promise<SyncResult> {
+    const {
+      delete: deleteExtra = false,
+      concurrency,
+      largeFileThreshold,
+      partConcurrency,
+      onProgress,
+      ...diffOptions
+    } = options;
+    const plan = await this.diff(localDir, bucketName, prefix, diffOptions);
+
+    const upload =
+      plan.upload.length > 0
+        ? await this.uploadDirectory(localDir, bucketName, prefix, {
+            files: plan.upload.map((entry) => entry.path as string),
+            concurrency,
+            largeFileThreshold,
+            partConcurrency,
+            onProgress,
+            lane: options.lane,
+            signal: options.signal,
+          })
+        : null;
+    const deleted =
+      deleteExtra && plan.delete.length > 0
+        ? await this.deleteObjects(
+            bucketName,
+            plan.delete.map((entry) => entry.key),
+            { lane: options.lane, signal: options.signal }
+          )
+        : null;
+    return { plan, upload, delete: deleted };
+  }
+
+  /**
+   * Upload a whole buffer as one object in a single native call.
+   *
+   * Opening the upload, setting metadata, writing, and committing all run
+   * in one async operation, straight from the buffer's memory, which
+   * avoids the per-step round trips of `uploadObject()` for small objects.
+   *
+   * @param bucketName - Name of the bucket to upload to
+   * @param objectKey - Object key (path) for the uploaded object
+   * @param data - Object contents
+   * @param options - Optional expiration and custom metadata
+   * @returns Promise resolving to the committed object info
+   * @throws TypeError if bucket name, object key, or data is invalid
+   *
+   * @example
+   * ```typescript
+   * const info = await project.putObject('thumbs', 'a1b2.jpg', jpeg, {
+   *   metadata: { 'Content-Type': 'image/jpeg' },
+   * });
+   * ```
+   */
+  async putObject(
+    bucketName: string,
+    objectKey: string,
+    data: Buffer,
+    options?: PutObjectOptions
+  ): Promise<ObjectInfo> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    this.validateObjectKey(objectKey);
+
+    if (!Buffer.isBuffer(data)) {
+      throw new TypeError('data must be a Buffer');
+    }
+
+    return withSignal(
+      options,
+      (o) => native.putObject(this._handle, bucketName, objectKey, data, o) as Promise<ObjectInfo>
+    );
+  }
+
+  /**
+   * Store content under a key derived from its digest, uploading it only
+   * when that key does not exist yet.
+   *
+   * The source is hashed natively (one streaming pass for files), each
+   * `{hash}` in `keyTemplate` is replaced by the hex digest, and the key
+   * is checked through the project's stat cache when enabled, then with a
+   * stat. Only a miss opens an upload, which also records the digest as
+   * `checksum-<algorithm>` metadata.
+   *
+   * @param bucketName - Name of the bucket to upload to
+   * @param keyTemplate - Object key containing `{hash}`
+   * @param source - Object contents, or the path of a local file
+   * @param options - Digest algorithm, read size, expiration and metadata
+   * @returns Promise resolving to the derived key, whether it was uploaded, and the object info
+   * @throws TypeError if bucket name, key template, or source is invalid
+   *
+   * @example
+   * ```typescript
+   * const { key, uploaded } = await project.putObjectDedup('artifacts', 'cas/{hash}', 'dist/app.tar.gz');
+   * ```
+   */
+  async putObjectDedup(
+    bucketName: string,
+    keyTemplate: string,
+    source: Buffer | string,
+    options?: PutObjectDedupOptions
+  ): Promise<PutObjectDedupResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+
+    if (typeof keyTemplate !== 'string' || !keyTemplate.includes('{hash}')) {
+      throw new TypeError('keyTemplate must contain {hash}');
+    }
+    if (!Buffer.isBuffer(source) && (typeof source !== 'string' || source === '')) {
+      throw new TypeError('source must be a Buffer or a non-empty file path');
+    }
+
+    return withSignal(
+      options,
+      (o) =>
+        native.putObjectDedup(this._handle, bucketName, keyTemplate, source, o) as Promise<PutObjectDedupResult>
+    );
+  }
+
+  /**
+   * Upload one source to several targets, reading it only once.
+   *
+   * Each chunk of the source is read into a pooled native buffer and
+   * written to every target's upload stream by its own native thread, so
+   * the whole upload runs at the speed of the slowest target. A target
+   * that fails is dropped; the rest are committed once at least `quorum`
+   * of them took every byte. If fewer than `quorum` commits succeed, the
+   * ones that did are deleted again and the promise rejects.
+   *
+   * @param source - Object contents, or the path of a local file
+   * @param targets - Destinations; `project` defaults to this project
+   * @param options - Quorum, read size, expiration and metadata
+   * @returns Promise resolving to bytes read and the outcome of each target
+   * @throws TypeError if the source or a target is invalid
+   *
+   * @example
+   * ```typescript
+   * await primary.uploadReplicated('backup.tar', [
+   *   { bucket: 'backups', key: 'backup.tar' },
+   *   { project: mirror, bucket: 'backups', key: 'backup.tar' },
+   * ]);
+   * ```
+   */
+  async uploadReplicated(
+    source: Buffer | string,
+    targets: readonly ReplicaTarget[],
+    options?: UploadReplicatedOptions
+  ): Promise<UploadReplicatedResult> {
+    this.validateOpen();
+    if (!Buffer.isBuffer(source) && (typeof source !== 'string' || source === '')) {
+      throw new TypeError('source must be a Buffer or a non-empty file path');
+    }
+    if (!Array.isArray(targets) || targets.length === 0) {
+      throw new TypeError('targets must be a non-empty array');
+    }
+    const nativeTargets = targets.map((target) => {
+      const project = target.project ?? this;
+      project.validateOpen();
+      this.validateBucketName(target.bucket);
+      if (typeof target.key !== 'string' || target.key === '') {
+        throw new TypeError('each target needs a non-empty key');
+      }
+      return { project: project._handle, bucket: target.bucket, key: target.key };
+    });
+
+    return withSignal(
+      options,
+      (o) => native.uploadReplicated(source, nativeTargets, o) as Promise<UploadReplicatedResult>
+    );
   }
 
   /**
@@ -588,7 +1742,7 @@ export class ProjectResultStruct {
    *
    * @param bucketName - Name of the bucket to download from
    * @param objectKey - Object key (path) to download
-   * @param options - Optional download options (offset, length)
+   * @param options - Optional download options (offset, length, verify)
    * @returns Promise resolving to a DownloadResultStruct
    * @throws TypeError if bucket name or object key is invalid
    *
@@ -613,20 +1767,323 @@ export class ProjectResultStruct {
    * const chunk = Buffer.alloc(500);
    * await download.read(chunk, chunk.length);
    * await download.close();
+   *
+   * // Verify against the checksum stored by an inline upload checksum
+   * const verified = await project.downloadObject('my-bucket', 'backup.tar', {
+   *   verify: { algorithm: 'sha256' },
+   * });
    * ```
    */
   async downloadObject(
     bucketName: string,
     objectKey: string,
-    options?: DownloadOptions
+    options?: DownloadObjectOptions
   ): Promise<DownloadResultStruct> {
     this.validateOpen();
     this.validateBucketName(bucketName);
     this.validateObjectKey(objectKey);
 
-    const result = (await native.downloadObject(this._handle, bucketName, objectKey, options)) as {
+    const result = (await withSignal(options, (o) =>
+      native.downloadObject(this._handle, bucketName, objectKey, o)
+    )) as {
       downloadHandle: unknown;
     };
-    return new DownloadResultStruct(result.downloadHandle);
+    const download = new DownloadResultStruct(result.downloadHandle);
+    if (options?.signal?.aborted) {
+      // Aborted while opening: release the download and its admission slot now
+      await download.close().catch(() => undefined);
+      throwIfAborted(options.signal);
+    }
+    return download;
+  }
+
+  /**
+   * Download a whole object into a Buffer in a single native operation.
+   *
+   * Opening the download, reading its content length, reading to EOF into
+   * one exactly-sized buffer, and closing all happen in one async work,
+   * which suits small and medium objects. With `enableObjectCache()`,
+   * cached objects resolve without any native work.
+   *
+   * @param bucketName - Name of the bucket to download from
+   * @param objectKey - Object key (path) to download
+   * @param options - Optional maxSize guard and hedging policy
+   * @returns Promise resolving to the object data and info
+   * @throws TypeError if bucket name or object key is invalid
+   *
+   * @example
+   * ```typescript
+   * const { data, info } = await project.getObject('thumbs', 'a1b2.jpg', { maxSize: 1 << 20 });
+   * res.setHeader('Content-Length', info.system.contentLength);
+   * res.end(data);
+   * ```
+   */
+  async getObject(
+    bucketName: string,
+    objectKey: string,
+    options?: GetObjectOptions
+  ): Promise<GetObjectResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    this.validateObjectKey(objectKey);
+
+    return withSignal(
+      options,
+      (o) => native.getObject(this._handle, bucketName, objectKey, o) as Promise<GetObjectResult>
+    );
+  }
+
+  /**
+   * Read many byte ranges of one object in a single native operation.
+   *
+   * Ranges are sorted, and ranges whose gap is at most `coalesceGap` are
+   * merged into one ranged request, so scattered small reads (file
+   * footers, index blocks, tiles) cost a handful of round trips. The
+   * merged requests run concurrently on native threads into one arena,
+   * and each returned Buffer is a view of it in request order. A negative
+   * `offset` counts from the end of the object; ranges past the end come
+   * back short or empty.
+   *
+   * @param bucketName - Name of the bucket to download from
+   * @param objectKey - Object key (path) to download
+   * @param ranges - Byte ranges to read
+   * @param options - Optional coalescing gap, concurrency, retries, and abort signal
+   * @returns Promise resolving to one Buffer per range, in the order given
+   * @throws TypeError if bucket name, object key, or ranges are invalid
+   *
+   * @example
+   * ```typescript
+   * const [footer] = await project.downloadRanges('tables', 'part-0.parquet', [{ offset: -8, length: 8 }]);
+   * const columns = await project.downloadRanges('tables', 'part-0.parquet', chunks, { coalesceGap: 256 * 1024 });
+   * ```
+   */
+  async downloadRanges(
+    bucketName: string,
+    objectKey: string,
+    ranges: DownloadRange[],
+    options?: DownloadRangesOptions
+  ): Promise<Buffer[]> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    this.validateObjectKey(objectKey);
+
+    if (!Array.isArray(ranges)) {
+      throw new TypeError('ranges must be an array');
+    }
+
+    const { data, offsets, lengths } = await withSignal(options, (o) =>
+      native.downloadRanges(this._handle, bucketName, objectKey, ranges, o)
+    );
+    return offsets.map((offset, i) => data.subarray(offset, offset + lengths[i]));
+  }
+
+  /**
+   * Download an object into a local file in a single native operation.
+   *
+   * The object is read on a worker thread into a reusable native buffer
+   * and written to the file with positional writes, without any chunk
+   * passing through the JS heap. The file is created or truncated. If the
+   * download fails the rejection carries `bytesWritten`.
+   *
+   * @param bucketName - Name of the bucket to download from
+   * @param objectKey - Object key (path) to download
+   * @param filePath - Destination file path
+   * @param options - Optional range, chunk size, and fsync flag
+   * @returns Promise resolving to the number of bytes written
+   * @throws TypeError if bucket name, object key, or path is invalid
+   *
+   * @example
+   * ```typescript
+   * const { bytesWritten } = await project.downloadToFile('my-bucket', 'backup.tar', '/restore/backup.tar', {
+   *   chunkSize: 4 * 1024 * 1024,
+   *   fsync: true,
+   * });
+   * ```
+   */
+  async downloadToFile(
+    bucketName: string,
+    objectKey: string,
+    filePath: string,
+    options?: DownloadToFileOptions
+  ): Promise<DownloadToFileResult> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    this.validateObjectKey(objectKey);
+
+    if (!filePath || typeof filePath !== 'string') {
+      throw new TypeError('filePath must be a non-empty string');
+    }
+
+    return withSignal(options, (o) => native.downloadToFile(this._handle, bucketName, objectKey, filePath, o));
+  }
+
+  /**
+   * Create a Readable stream over an object.
+   *
+   * The stream keeps reading ahead natively while the consumer handles
+   * earlier chunks, and pauses once `highWaterMark` bytes are buffered.
+   * The download is opened on first read and closed when the stream ends
+   * or is destroyed.
+   *
+   * @param bucketName - Name of the bucket to download from
+   * @param objectKey - Object key (path) to download
+   * @param options - Optional range, chunk size, read-ahead and highWaterMark
+   * @returns A Readable stream of the object's bytes
+   * @throws TypeError if bucket name or object key is invalid
+   *
+   * @example
+   * ```typescript
+   * project.createReadStream('my-bucket', 'video.mp4', { chunkSize: 4 << 20 }).pipe(res);
+   * ```
+   */
+  createReadStream(
+    bucketName: string,
+    objectKey: string,
+    options?: ReadStreamOptions
+  ): DownloadReadStream {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    this.validateObjectKey(objectKey);
+
+    return new DownloadReadStream(this._handle, bucketName, objectKey, options);
+  }
+
+  /**
+   * Create a WHATWG `ReadableStream` of type `'bytes'` over an object.
+   *
+   * BYOB readers (`getReader({ mode: 'byob' })`) have each native read
+   * fill their view in place; default readers get `chunkSize` chunks. The
+   * download is opened when the stream starts and closed at EOF, on
+   * cancel, or on error.
+   *
+   * @param bucketName - Name of the bucket to download from
+   * @param objectKey - Object key (path) to download
+   * @param options - Optional range, chunk size, signal and timeout
+   * @returns A byte stream of the object's bytes
+   * @throws TypeError if bucket name or object key is invalid
+   *
+   * @example
+   * ```typescript
+   * const response = new Response(project.createWebReadStream('my-bucket', 'video.mp4'));
+   * ```
+   */
+  createWebReadStream(
+    bucketName: string,
+    objectKey: string,
+    options?: WebReadStreamOptions
+  ): ReadableStream<Uint8Array> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    this.validateObjectKey(objectKey);
+
+    return createWebReadStream(this._handle, bucketName, objectKey, options);
+  }
+
+  /**
+   * Create a Readable tar or zip stream of many objects.
+   *
+   * Given an array, the archive holds those objects in order, named by
+   * key. Given a prefix, it holds every object below it in listing order,
+   * named by key minus the prefix. Objects are fetched ahead on native
+   * threads, `concurrency` at a time, within `maxBufferedBytes` of
+   * memory; objects too large to buffer are streamed into the archive as
+   * their turn comes. Entries are stored uncompressed.
+   *
+   * @param bucketName - Name of the bucket to archive from
+   * @param keysOrPrefix - Object keys, or a prefix whose objects are archived
+   * @param options - Optional format, concurrency, memory budget, chunk size and signal
+   * @returns A Readable stream of the archive's bytes
+   * @throws TypeError if the bucket name, keys or options are invalid
+   *
+   * @example
+   * ```typescript
+   * project.createArchiveStream('photos', '2024/', { format: 'zip' }).pipe(res);
+   * project.createArchiveStream('logs', ['a.log', 'b.log']).pipe(fs.createWriteStream('logs.tar'));
+   * ```
+   */
+  createArchiveStream(
+    bucketName: string,
+    keysOrPrefix: string[] | string,
+    options?: ArchiveStreamOptions
+  ): ArchiveReadStream {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    if (Array.isArray(keysOrPrefix)) {
+      keysOrPrefix.forEach((key) => this.validateObjectKey(key));
+    } else if (typeof keysOrPrefix !== 'string') {
+      throw new TypeError('keysOrPrefix must be an array of object keys or a prefix string');
+    }
+
+    return new ArchiveReadStream(this._handle, bucketName, keysOrPrefix, options);
+  }
+
+  /**
+   * Start a pack upload: many small files stored as members of one object.
+   *
+   * Members are appended to a single upload through a native write
+   * buffer (`writeBufferSize`, default 4 MiB), so each costs a copy
+   * rather than an upload and commit of its own. `commit()` appends an
+   * index of member name to offset and length; read members back with
+   * `openPack()`.
+   *
+   * @param bucketName - Name of the bucket to upload to
+   * @param objectKey - Object key of the pack
+   * @param options - Optional upload options
+   * @returns Promise resolving to a PackUpload
+   * @throws TypeError if bucket name or object key is invalid, or `compress`
+   *   is set (members are read back with ranged downloads)
+   *
+   * @example
+   * ```typescript
+   * const pack = await project.createPackUpload('thumbs', 'batch-0001.pack');
+   * await pack.add('a1b2.jpg', jpeg);
+   * await pack.commit();
+   * ```
+   */
+  async createPackUpload(
+    bucketName: string,
+    objectKey: string,
+    options?: UploadOptions
+  ): Promise<PackUpload> {
+    if (options?.compress !== undefined) {
+      throw new TypeError('compress is not supported for pack uploads');
+    }
+    const upload = await this.uploadObject(bucketName, objectKey, {
+      ...options,
+      writeBufferSize: options?.writeBufferSize ?? DEFAULT_PACK_WRITE_BUFFER,
+    });
+    return new PackUpload(upload);
+  }
+
+  /**
+   * Open a pack object written by `createPackUpload()`.
+   *
+   * The member index is fetched once with a ranged read of the end of the
+   * object. Members are then read with ranged downloads, which go through
+   * the chunk cache when `Uplink.enableChunkCache()` is on.
+   *
+   * @param bucketName - Name of the bucket holding the pack
+   * @param objectKey - Object key of the pack
+   * @param options - Optional index read size and abort signal
+   * @returns Promise resolving to a PackReader
+   * @throws TypeError if bucket name or object key is invalid
+   * @throws Error if the object is not a pack
+   *
+   * @example
+   * ```typescript
+   * const pack = await project.openPack('thumbs', 'batch-0001.pack');
+   * res.end(await pack.read('a1b2.jpg'));
+   * ```
+   */
+  async openPack(
+    bucketName: string,
+    objectKey: string,
+    options?: OpenPackOptions
+  ): Promise<PackReader> {
+    this.validateOpen();
+    this.validateBucketName(bucketName);
+    this.validateObjectKey(objectKey);
+
+    return openPackReader(this, bucketName, objectKey, options);
   }
 }
@@ -0,0 +1,422 @@
+/**
+ * @file project/pack.ts
+ * @description Many small files stored as members of one object
+ *
+ * Provides PackUpload, returned by `ProjectResultStruct.createPackUpload()`,
+ * and PackReader, returned by `ProjectResultStruct.openPack()`.
+ *
+ * A pack object is laid out as
+ *
+ *   member bytes, back to back, in the order they were added
+ *   index: per member, u16 name length, UTF-8 name, u64 offset, u64 length
+ *   footer (32 bytes): u32 version, u32 member count, u64 index offset,
+ *                      u64 index length, magic "UPLKPACK"
+ *
+ * with all integers little-endian. Members are plain bytes of the object,
+ * so any ranged read can serve them.
+ */
+
+import type {
+  DownloadRangesOptions,
+  OpenPackOptions,
+  PackMember,
+  SignalOptions,
+} from '../types';
+import type { UploadResultStruct } from '../upload';
+import type { ProjectResultStruct } from './index';
+
+/** Trailing magic of a pack object */
+const PACK_MAGIC = Buffer.from('UPLKPACK', 'ascii');
+
+/** Pack layout version */
+const PACK_VERSION = 1;
+
+/** Size of the fixed footer */
+const PACK_FOOTER_SIZE = 32;
+
+/** Longest member name in UTF-8 bytes */
+const MAX_NAME_BYTES = 0xffff;
+
+/** Default native write-coalescing buffer of a pack upload (4 MiB) */
+export const DEFAULT_PACK_WRITE_BUFFER = 4 * 1024 * 1024;
+
+/** Default tail read of `openPack()`; larger indexes cost a second read (64 KiB) */
+const DEFAULT_INDEX_READ_SIZE = 64 * 1024;
+
+function toBuffer(data: Buffer | Uint8Array | string): Buffer {
+  if (Buffer.isBuffer(data)) {
+    return data;
+  }
+  if (typeof data === 'string') {
+    return Buffer.from(data, 'utf8');
+  }
+  if (data instanceof Uint8Array) {
+    return Buffer.from(data.buffer, data.byteOffset, data.byteLength);
+  }
+  throw new TypeError('data must be a Buffer, Uint8Array or string');
+}
+
+/**
+ * Pack upload: appends members to one object and commits it with its index.
+ *
+ * Members are written in the order `add()` is called, even when calls
+ * are not awaited, through the upload's native write buffer, so adding a
+ * small member costs a copy instead of a round trip. `commit()` writes
+ * the index and footer and commits the object; `abort()` discards it.
+ * If a write fails, later calls reject with its error.
+ *
+ * @example
+ * ```typescript
+ * const pack = await project.createPackUpload('thumbs', 'batch-0001.pack');
+ * for (const file of files) {
+ *   await pack.add(file.name, await fs.promises.readFile(file.path));
+ * }
+ * await pack.commit();
+ * ```
+ */
+export class PackUpload {
+  private readonly _upload: UploadResultStruct;
+  private readonly _members: PackMember[] = [];
+  private readonly _names: Set<string> = new Set();
+  private _size: number = 0;
+  private _tail: Promise<void> = Promise.resolve();
+  private _failure: Error | null = null;
+  private _finished: boolean = false;
+
+  /**
+   * Creates a new PackUpload over an open upload.
+   *
+   * @param upload - Upload the pack is written to
+   * @internal
+   */
+  constructor(upload: UploadResultStruct) {
+    this._upload = upload;
+  }
+
+  /** Number of members added so far */
+  get memberCount(): number {
+    return this._members.length;
+  }
+
+  /** Bytes of member data added so far */
+  get size(): number {
+    return this._size;
+  }
+
+  /**
+   * Append a member.
+   *
+   * @param name - Member name, unique within the pack (at most 65535 UTF-8 bytes)
+   * @param data - Member content
+   * @returns Promise resolving to the member's place in the pack once its bytes are written
+   * @throws TypeError if the name or data is invalid
+   * @throws Error if the name is already used, the pack is finished, or a write failed
+   */
+  async add(name: string, data: Buffer | Uint8Array | string): Promise<PackMember> {
+    this.validateActive();
+    if (typeof name !== 'string' || name.length === 0) {
+      throw new TypeError('name must be a non-empty string');
+    }
+    if (Buffer.byteLength(name, 'utf8') > MAX_NAME_BYTES) {
+      throw new TypeError('name must be at most 65535 bytes in UTF-8');
+    }
+    if (this._names.has(name)) {
+      throw new Error(`Pack member already added: ${name}`);
+    }
+    const bytes = toBuffer(data);
+
+    const member: PackMember = { name, offset: this._size, length: bytes.length };
+    this._names.add(name);
+    this._members.push(member);
+    this._size += bytes.length;
+    if (bytes.length > 0) {
+      await this.enqueue(bytes);
+    }
+    return member;
+  }
+
+  /**
+   * Write the index and footer and commit the pack object.
+   *
+   * @returns Promise resolving once the object is committed
+   * @throws Error if the pack is finished or a write failed
+   */
+  async commit(): Promise<void> {
+    this.validateActive();
+    this._finished = true;
+    await this.enqueue(this.encodeIndex());
+    await this._upload.commit();
+  }
+
+  /**
+   * Abort the pack upload; nothing is stored.
+   *
+   * @returns Promise resolving when the upload is aborted
+   * @throws Error if the pack is already finished
+   */
+  async abort(): Promise<void> {
+    if (this._finished) {
+      throw new Error('Pack upload already finished');
+    }
+    this._finished = true;
+    await this._tail;
+    await this._upload.abort();
+  }
+
+  private validateActive(): void {
+    if (this._failure !== null) {
+      throw this._failure;
+    }
+    if (this._finished) {
+      throw new Error('Pack upload already finished');
+    }
+  }
+
+  /** Queue a write behind the previous ones and wait for it */
+  private async enqueue(bytes: Buffer): Promise<void> {
+    this._tail = this._tail.then(async () => {
+      if (this._failure !== null) {
+        return;
+      }
+      try {
+        await this._upload.write(bytes);
+      } catch (err) {
+        this._failure = err as Error;
+      }
+    });
+    await this._tail;
+    if (this._failure !== null) {
+      throw this._failure;
+    }
+  }
+
+  private encodeIndex(): Buffer {
+    const names = this._members.map((member) => Buffer.from(member.name, 'utf8'));
+    const indexLength = names.reduce((sum, name) => sum + 2 + name.length + 16, 0);
+    const out = Buffer.allocUnsafe(indexLength + PACK_FOOTER_SIZE);
+    let pos = 0;
+    this._members.forEach((member, i) => {
+      pos = out.writeUInt16LE(names[i].length, pos);
+      pos += names[i].copy(out, pos);
+      pos = out.writeBigUInt64LE(BigInt(member.offset), pos);
+      pos = out.writeBigUInt64LE(BigInt(member.length), pos);
+    });
+    pos = out.writeUInt32LE(PACK_VERSION, pos);
+    pos = out.writeUInt32LE(this._members.length, pos);
+    pos = out.writeBigUInt64LE(BigInt(this._size), pos);
+    pos = out.writeBigUInt64LE(BigInt(indexLength), pos);
+    PACK_MAGIC.copy(out, pos);
+    return out;
+  }
+}
+
+/**
+ * Reader of a pack object's members.
+ *
+ * The index is read once by `openPack()`; members are then served by
+ * ranged downloads of the pack, through the chunk cache when it is
+ * enabled. A pack is immutable once committed; replacing the object
+ * while a reader is open leaves the reader's index stale.
+ *
+ * @example
+ * ```typescript
+ * const pack = await project.openPack('thumbs', 'batch-0001.pack');
+ * const jpeg = await pack.read('a1b2.jpg');
+ * ```
+ */
+export class PackReader {
+  private readonly _project: ProjectResultStruct;
+  private readonly _bucket: string;
+  private readonly _key: string;
+  private readonly _members: Map<string, PackMember>;
+
+  /**
+   * Creates a new PackReader over a parsed index.
+   *
+   * @param project - Project the pack is read through
+   * @param bucket - Bucket name
+   * @param key - Pack object key
+   * @param members - Members in pack order
+   * @internal
+   */
+  constructor(project: ProjectResultStruct, bucket: string, key: string, members: PackMember[]) {
+    this._project = project;
+    this._bucket = bucket;
+    this._key = key;
+    this._members = new Map(members.map((member) => [member.name, member]));
+  }
+
+  /** Number of members */
+  get memberCount(): number {
+    return this._members.size;
+  }
+
+  /** Member names in pack order */
+  names(): string[] {
+    return [...this._members.keys()];
+  }
+
+  /** Whether the pack holds a member named @p name */
+  has(name: string): boolean {
+    return this._members.has(name);
+  }
+
+  /** Offset and length of a member, or undefined when absent */
+  stat(name: string): PackMember | undefined {
+    return this._members.get(name);
+  }
+
+  /**
+   * Read one member with a ranged download.
+   *
+   * @param name - Member name
+   * @param options - Optional abort signal
+   * @returns Promise resolving to the member's bytes
+   * @throws Error if the pack has no such member or the read fails
+   */
+  async read(name: string, options?: SignalOptions): Promise<Buffer> {
+    const member = this.lookup(name);
+    const data = Buffer.allocUnsafe(member.length);
+    if (member.length === 0) {
+      return data;
+    }
+    const download = await this._project.downloadObject(this._bucket, this._key, {
+      offset: member.offset,
+      length: member.length,
+      signal: options?.signal,
+    });
+    try {
+      const { bytesRead } = await download.readFull(data, member.length, options);
+      if (bytesRead !== member.length) {
+        throw new Error(`Pack member ${name} is truncated: read ${bytesRead} of ${member.length} bytes`);
+      }
+    } finally {
+      await download.close();
+    }
+    return data;
+  }
+
+  /**
+   * Read several members in one `downloadRanges()` call.
+   *
+   * Members stored near each other share a ranged request, which suits
+   * reading a batch of small members. These reads bypass the chunk cache.
+   *
+   * @param names - Member names
+   * @param options - Optional coalescing gap, concurrency, retries and abort signal
+   * @returns Promise resolving to one Buffer per name, in the order given
+   * @throws Error if the pack has no such member or the read fails
+   */
+  async readMany(names: string[], options?: DownloadRangesOptions): Promise<Buffer[]> {
+    const members = names.map((name) => this.lookup(name));
+    const parts = await this._project.downloadRanges(
+      this._bucket,
+      this._key,
+      members.map((member) => ({ offset: member.offset, length: member.length })),
+      options
+    );
+    parts.forEach((part, i) => {
+      if (part.length !== members[i].length) {
+        throw new Error(`Pack member ${members[i].name} is truncated: read ${part.length} of ${members[i].length} bytes`);
+      }
+    });
+    return parts;
+  }
+
+  private lookup(name: string): PackMember {
+    const member = this._members.get(name);
+    if (member === undefined) {
+      throw new Error(`No such pack member: ${name}`);
+    }
+    return member;
+  }
+}
+
+/**
+ * Parse a pack index from the end of the object.
+ *
+ * @param tail - Last bytes of the pack object, at least the footer
+ * @param key - Pack object key, for error messages
+ * @returns The index location, and its members when the tail holds it
+ */
+function parsePackTail(
+  tail: Buffer,
+  key: string
+): { indexOffset: number; indexLength: number; count: number; members: PackMember[] | null } {
+  const footer = tail.length - PACK_FOOTER_SIZE;
+  if (footer < 0 || !tail.subarray(tail.length - PACK_MAGIC.length).equals(PACK_MAGIC)) {
+    throw new Error(`Not a pack object: ${key}`);
+  }
+  const version = tail.readUInt32LE(footer);
+  if (version !== PACK_VERSION) {
+    throw new Error(`Unsupported pack version ${version}: ${key}`);
+  }
+  const count = tail.readUInt32LE(footer + 4);
+  const indexOffset = Number(tail.readBigUInt64LE(footer + 8));
+  const indexLength = Number(tail.readBigUInt64LE(footer + 16));
+  const start = footer - indexLength;
+  const members = start >= 0 ? parsePackIndex(tail.subarray(start, footer), count, indexOffset, key) : null;
+  return { indexOffset, indexLength, count, members };
+}
+
+function parsePackIndex(index: Buffer, count: number, dataLength: number, key: string): PackMember[] {
+  const members: PackMember[] = [];
+  let pos = 0;
+  for (let i = 0; i < count; i++) {
+    if (pos + 2 > index.length) {
+      throw new Error(`Corrupt pack index: ${key}`);
+    }
+    const nameLength = index.readUInt16LE(pos);
+    pos += 2;
+    if (pos + nameLength + 16 > index.length) {
+      throw new Error(`Corrupt pack index: ${key}`);
+    }
+    const name = index.toString('utf8', pos, pos + nameLength);
+    pos += nameLength;
+    const offset = Number(index.readBigUInt64LE(pos));
+    const length = Number(index.readBigUInt64LE(pos + 8));
+    pos += 16;
+    if (offset + length > dataLength) {
+      throw new Error(`Corrupt pack index: ${key}`);
+    }
+    members.push({ name, offset, length });
+  }
+  if (pos !== index.length) {
+    throw new Error(`Corrupt pack index: ${key}`);
+  }
+  return members;
+}
+
+/**
+ * Read a pack's index: one tail read, and a second when the index is
+ * larger than `indexReadSize`.
+ *
+ * @internal
+ */
+export async function openPackReader(
+  project: ProjectResultStruct,
+  bucket: string,
+  key: string,
+  options: OpenPackOptions = {}
+): Promise<PackReader> {
+  const indexReadSize = options.indexReadSize ?? DEFAULT_INDEX_READ_SIZE;
+  if (!Number.isInteger(indexReadSize) || indexReadSize < PACK_FOOTER_SIZE) {
+    throw new RangeError(`indexReadSize must be an integer of at least ${PACK_FOOTER_SIZE}`);
+  }
+  const { signal } = options;
+  const [tail] = await project.downloadRanges(bucket, key, [{ offset: -indexReadSize, length: indexReadSize }], {
+    signal,
+  });
+  const { indexOffset, indexLength, count, members } = parsePackTail(tail, key);
+  if (members !== null) {
+    return new PackReader(project, bucket, key, members);
+  }
+
+  const [index] = await project.downloadRanges(bucket, key, [{ offset: indexOffset, length: indexLength }], {
+    signal,
+  });
+  if (index.length !== indexLength) {
+    throw new Error(`Corrupt pack index: ${key}`);
+  }
+  return new PackReader(project, bucket, key, parsePackIndex(index, count, indexOffset, key));
+}
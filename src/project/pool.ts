@@ -0,0 +1,417 @@
+/**
+ * @file project/pool.ts
+ * @description Pool of open projects keyed by access grant and config
+ *
+ * Opening a project dials the satellite, so services that serve many
+ * tenants keep projects open between requests instead. A pooled project
+ * is leased to one caller at a time and handed back with `release()`;
+ * the next `acquire()` for the same access and config reuses it. The
+ * pool holds at most `maxProjects` projects, closes ones idle longer
+ * than `idleTimeoutMs`, and when full evicts the least recently used
+ * idle project or waits for a lease to come back.
+ */
+
+import type { UplinkConfig, ProjectConfig, ProjectPoolOptions, ProjectPoolStats } from '../types';
+import type { AccessResultStruct } from '../access';
+import type { ProjectResultStruct } from './index';
+
+/** Default bound on open projects */
+const DEFAULT_MAX_PROJECTS = 16;
+
+/** Default idle time after which a project is closed */
+const DEFAULT_IDLE_TIMEOUT_MS = 60000;
+
+/** Default idle time after which a project is health checked before reuse */
+const DEFAULT_HEALTH_CHECK_IDLE_MS = 30000;
+
+/** Shortest interval of the idle sweep */
+const MIN_SWEEP_INTERVAL_MS = 1000;
+
+interface PoolEntry {
+  readonly key: string;
+  readonly project: ProjectResultStruct;
+  idleSince: number;
+}
+
+/** Serialized grants, so repeated leases skip the native call */
+const serializedAccess = new WeakMap<AccessResultStruct, Promise<string>>();
+
+function accessKey(access: AccessResultStruct): Promise<string> {
+  let serialized = serializedAccess.get(access);
+  if (serialized === undefined) {
+    serialized = access.serialize();
+    serializedAccess.set(access, serialized);
+    serialized.catch(() => serializedAccess.delete(access));
+  }
+  return serialized;
+}
+
+/** Config as JSON with sorted keys, so equal configs share projects */
+export function configKey(config: UplinkConfig | undefined): string {
+  if (config == null) {
+    return '';
+  }
+  const entries = Object.entries(config)
+    .filter(([, value]) => value !== undefined)
+    .sort(([a], [b]) => (a < b ? -1 : a > b ? 1 : 0));
+  return JSON.stringify(entries);
+}
+
+function closeQuietly(project: ProjectResultStruct): Promise<void> {
+  return project.isOpen ? project.close().catch(() => undefined) : Promise.resolve();
+}
+
+/**
+ * A project leased from a `ProjectPool`.
+ *
+ * Use `project` until the lease is released; do not close it yourself.
+ */
+export class ProjectLease {
+  private readonly _pool: ProjectPool;
+  private readonly _entry: PoolEntry;
+  private _released: boolean = false;
+
+  /** @internal */
+  constructor(pool: ProjectPool, entry: PoolEntry) {
+    this._pool = pool;
+    this._entry = entry;
+  }
+
+  /** The leased project */
+  get project(): ProjectResultStruct {
+    return this._entry.project;
+  }
+
+  /**
+   * Hand the project back to the pool. Later calls are no-ops.
+   *
+   * @param options - `discard: true` closes the project instead, e.g.
+   *   after an error that suggests its connection is broken
+   */
+  async release(options?: { discard?: boolean }): Promise<void> {
+    if (this._released) {
+      return;
+    }
+    this._released = true;
+    await this._pool._return(this._entry, options?.discard === true);
+  }
+}
+
+/**
+ * Bounded pool of open projects, keyed by serialized access plus config.
+ *
+ * @example
+ * ```typescript
+ * const pool = new ProjectPool({ maxProjects: 32 });
+ *
+ * async function handle(tenantAccess: AccessResultStruct) {
+ *   const lease = await pool.acquire(tenantAccess);
+ *   try {
+ *     return await lease.project.statObject('my-bucket', 'a.txt');
+ *   } finally {
+ *     await lease.release();
+ *   }
+ * }
+ * ```
+ */
+export class ProjectPool {
+  private readonly _maxProjects: number;
+  private readonly _idleTimeoutMs: number;
+  private readonly _healthCheckIdleMs: number;
+  private readonly _healthCheck: ((project: ProjectResultStruct) => unknown) | undefined;
+  private readonly _idle = new Map<string, PoolEntry[]>();
+  private readonly _waiters: Array<() => void> = [];
+  private _open: number = 0;
+  private _leased: number = 0;
+  private _hits: number = 0;
+  private _misses: number = 0;
+  private _evictions: number = 0;
+  private _sweep: ReturnType<typeof setInterval> | null = null;
+  private _closed: boolean = false;
+
+  /**
+   * @param options - Pool bounds, idle timeout, and health check
+   * @throws TypeError if an option is not a non-negative number, or
+   *   `healthCheck` is not a function
+   */
+  constructor(options: ProjectPoolOptions = {}) {
+    const {
+      maxProjects = DEFAULT_MAX_PROJECTS,
+      idleTimeoutMs = DEFAULT_IDLE_TIMEOUT_MS,
+      healthCheckIdleMs = DEFAULT_HEALTH_CHECK_IDLE_MS,
+      healthCheck,
+    } = options;
+    if (!Number.isInteger(maxProjects) || maxProjects < 1) {
+      throw new TypeError('maxProjects must be a positive integer');
+    }
+    if (!(idleTimeoutMs >= 0) || !(healthCheckIdleMs >= 0)) {
+      throw new TypeError('idleTimeoutMs and healthCheckIdleMs must not be negative');
+    }
+    if (healthCheck !== undefined && typeof healthCheck !== 'function') {
+      throw new TypeError('healthCheck must be a function');
+    }
+    this._maxProjects = maxProjects;
+    this._idleTimeoutMs = idleTimeoutMs;
+    this._healthCheckIdleMs = healthCheckIdleMs;
+    this._healthCheck = healthCheck;
+  }
+
+  /**
+   * Lease an open project for @p access and @p config.
+   *
+   * Reuses an idle project opened with the same grant and config; an idle
+   * project is health checked first when it sat longer than
+   * `healthCheckIdleMs`. Opens a new one otherwise, evicting the least
+   * recently used idle project or waiting for a release when the pool is
+   * full.
+   *
+   * @param access - Access grant of the tenant
+   * @param config - Project config, as for `configOpenProject()`
+   * @returns The lease; call `release()` when done
+   * @throws Error if the pool is closed, or what opening the project threw
+   */
+  async acquire(access: AccessResultStruct, config?: ProjectConfig): Promise<ProjectLease> {
+    this.validateOpen();
+    const key = `${await accessKey(access)}\n${configKey(config)}`;
+
+    for (;;) {
+      this.validateOpen();
+      const entry = this.takeIdle(key);
+      if (entry !== undefined) {
+        if (await this.isHealthy(entry)) {
+          this._hits++;
+          this._leased++;
+          return new ProjectLease(this, entry);
+        }
+        this.drop(entry);
+        continue;
+      }
+
+      if (this._open < this._maxProjects) {
+        return this.openEntry(key, access, config);
+      }
+      if (this.evictOldest()) {
+        continue;
+      }
+      await new Promise<void>((resolve) => this._waiters.push(resolve));
+    }
+  }
+
+  /**
+   * Lease a project for the duration of @p fn.
+   *
+   * @param access - Access grant of the tenant
+   * @param fn - Work to run with the project
+   * @param config - Project config, as for `configOpenProject()`
+   * @returns What @p fn resolved to
+   */
+  async use<T>(
+    access: AccessResultStruct,
+    fn: (project: ProjectResultStruct) => Promise<T>,
+    config?: ProjectConfig
+  ): Promise<T> {
+    const lease = await this.acquire(access, config);
+    try {
+      return await fn(lease.project);
+    } finally {
+      await lease.release();
+    }
+  }
+
+  /**
+   * Get the pool counters.
+   *
+   * @returns Open, idle, leased and waiting gauges, and reuse counters
+   */
+  stats(): ProjectPoolStats {
+    return {
+      open: this._open,
+      idle: this._open - this._leased,
+      leased: this._leased,
+      waiting: this._waiters.length,
+      hits: this._hits,
+      misses: this._misses,
+      evictions: this._evictions,
+    };
+  }
+
+  /**
+   * Close all idle projects and refuse new leases. Leased projects are
+   * closed when they are released.
+   */
+  async close(): Promise<void> {
+    if (this._closed) {
+      return;
+    }
+    this._closed = true;
+    this.stopSweep();
+    const closing: Promise<void>[] = [];
+    for (const entries of this._idle.values()) {
+      for (const entry of entries) {
+        this._open--;
+        closing.push(closeQuietly(entry.project));
+      }
+    }
+    this._idle.clear();
+    this.wakeAll();
+    await Promise.all(closing);
+  }
+
+  /** @internal */
+  async _return(entry: PoolEntry, discard: boolean): Promise<void> {
+    this._leased--;
+    if (this._closed || discard || !entry.project.isOpen) {
+      this._open--;
+      this.wakeOne();
+      await closeQuietly(entry.project);
+      return;
+    }
+    entry.idleSince = Date.now();
+    let entries = this._idle.get(entry.key);
+    if (entries === undefined) {
+      entries = [];
+      this._idle.set(entry.key, entries);
+    }
+    entries.push(entry);
+    this.startSweep();
+    this.wakeOne();
+  }
+
+  private async openEntry(key: string, access: AccessResultStruct, config: ProjectConfig | undefined): Promise<ProjectLease> {
+    this._open++;
+    this._misses++;
+    let project: ProjectResultStruct;
+    try {
+      project = config == null ? await access.openProject() : await access.configOpenProject(config);
+    } catch (err) {
+      this._open--;
+      this.wakeOne();
+      throw err;
+    }
+    if (this._closed) {
+      this._open--;
+      await closeQuietly(project);
+      this.validateOpen();
+    }
+    this._leased++;
+    return new ProjectLease(this, { key, project, idleSince: 0 });
+  }
+
+  /** Most recently returned idle project of @p key */
+  private takeIdle(key: string): PoolEntry | undefined {
+    const entries = this._idle.get(key);
+    const entry = entries?.pop();
+    if (entries !== undefined && entries.length === 0) {
+      this._idle.delete(key);
+      if (this._idle.size === 0) {
+        this.stopSweep();
+      }
+    }
+    return entry;
+  }
+
+  private async isHealthy(entry: PoolEntry): Promise<boolean> {
+    if (!entry.project.isOpen) {
+      return false;
+    }
+    if (this._healthCheck === undefined || Date.now() - entry.idleSince < this._healthCheckIdleMs) {
+      return true;
+    }
+    try {
+      return (await this._healthCheck(entry.project)) !== false;
+    } catch {
+      return false;
+    }
+  }
+
+  /** Close an entry taken off the idle lists */
+  private drop(entry: PoolEntry): void {
+    this._open--;
+    void closeQuietly(entry.project);
+    this.wakeOne();
+  }
+
+  /** Close the least recently used idle project; false if none */
+  private evictOldest(): boolean {
+    let oldest: PoolEntry | undefined;
+    for (const entries of this._idle.values()) {
+      if (entries.length > 0 && (oldest === undefined || entries[0].idleSince < oldest.idleSince)) {
+        oldest = entries[0];
+      }
+    }
+    if (oldest === undefined) {
+      return false;
+    }
+    this.removeIdle(oldest);
+    this._evictions++;
+    this._open--;
+    void closeQuietly(oldest.project);
+    return true;
+  }
+
+  private removeIdle(entry: PoolEntry): void {
+    const entries = this._idle.get(entry.key);
+    if (entries === undefined) {
+      return;
+    }
+    const index = entries.indexOf(entry);
+    if (index >= 0) {
+      entries.splice(index, 1);
+    }
+    if (entries.length === 0) {
+      this._idle.delete(entry.key);
+    }
+  }
+
+  /** Close projects idle longer than idleTimeoutMs */
+  private sweep(): void {
+    const now = Date.now();
+    const expired: PoolEntry[] = [];
+    for (const entries of this._idle.values()) {
+      for (const entry of entries) {
+        if (now - entry.idleSince >= this._idleTimeoutMs) {
+          expired.push(entry);
+        }
+      }
+    }
+    for (const entry of expired) {
+      this.removeIdle(entry);
+      this._evictions++;
+      this.drop(entry);
+    }
+    if (this._idle.size === 0) {
+      this.stopSweep();
+    }
+  }
+
+  private startSweep(): void {
+    if (this._sweep !== null || this._idleTimeoutMs === 0) {
+      return;
+    }
+    this._sweep = setInterval(() => this.sweep(), Math.max(MIN_SWEEP_INTERVAL_MS, this._idleTimeoutMs / 2));
+    this._sweep.unref?.();
+  }
+
+  private stopSweep(): void {
+    if (this._sweep !== null) {
+      clearInterval(this._sweep);
+      this._sweep = null;
+    }
+  }
+
+  private wakeOne(): void {
+    this._waiters.shift()?.();
+  }
+
+  private wakeAll(): void {
+    for (const wake of this._waiters.splice(0)) {
+      wake();
+    }
+  }
+
+  private validateOpen(): void {
+    if (this._closed) {
+      throw new Error('Project pool is closed');
+    }
+  }
+}
@@ -4,6 +4,9 @@
  * @packageDocumentation
  */
 
+import type { ProjectResultStruct } from '../project';
+import type { AccessResultStruct } from '../access';
+
 /**
  * Configuration options for the Uplink client
  */
@@ -16,6 +19,168 @@ export interface UplinkConfig {
   tempDirectory?: string;
 }
 
+/**
+ * Configuration for `configOpenProject`
+ *
+ * Calls over a limit wait in a queue inside the binding and start, in
+ * order, as earlier ones finish. A streaming `uploadObject`,
+ * `downloadObject` or `uploadPart` holds its transfer slot until it is
+ * committed, aborted or closed.
+ *
+ * Bandwidth limits are token buckets in the binding that every write and
+ * read of the project's transfers draws from, on top of the process-wide
+ * limits set with `new Uplink({ maxUploadBytesPerSecond })`.
+ */
+export interface ProjectConfig extends UplinkConfig {
+  /** Transfers of this project that may run at once (default 0 = unlimited) */
+  maxConcurrentTransfers?: number;
+  /** Stat, list, delete, bucket and multipart calls that may run at once (default 0 = unlimited) */
+  maxConcurrentMetadataOps?: number;
+  /** Upload bytes per second across this project's transfers (default 0 = unlimited) */
+  maxUploadBytesPerSecond?: number;
+  /** Download bytes per second across this project's transfers (default 0 = unlimited) */
+  maxDownloadBytesPerSecond?: number;
+  /**
+   * Share of the process-wide bandwidth limits relative to other
+   * projects while they contend for it, 1-1000 (default 1)
+   */
+  bandwidthWeight?: number;
+}
+
+/**
+ * Options for the `ProjectPool` constructor
+ */
+export interface ProjectPoolOptions {
+  /** Projects open at once across all keys, leased or idle (default 16) */
+  maxProjects?: number;
+  /** Close projects idle this long (default 60000; 0 = keep them open) */
+  idleTimeoutMs?: number;
+  /** Run `healthCheck` on projects idle this long before reuse (default 30000) */
+  healthCheckIdleMs?: number;
+  /**
+   * Check an idle project before it is leased again; throwing or
+   * returning false closes it and opens a fresh one
+   */
+  healthCheck?: (project: ProjectResultStruct) => unknown;
+}
+
+/**
+ * Counters from `ProjectPool.stats()`
+ */
+export interface ProjectPoolStats {
+  /** Projects open, leased or idle */
+  open: number;
+  /** Open projects waiting to be leased */
+  idle: number;
+  /** Projects currently leased */
+  leased: number;
+  /** `acquire()` calls waiting for room in the pool */
+  waiting: number;
+  /** Leases served by an idle project */
+  hits: number;
+  /** Leases that opened a project */
+  misses: number;
+  /** Idle projects closed to make room or after idleTimeoutMs */
+  evictions: number;
+}
+
+/**
+ * Options for the `Uplink` constructor
+ */
+export interface UplinkOptions {
+  /**
+   * Threads the addon may run blocking uploads and downloads on
+   * (default 16, or `UPLINK_THREAD_POOL_SIZE`). `0` runs them on the
+   * libuv pool instead. The pool is shared by the whole process.
+   */
+  threadPoolSize?: number;
+  /**
+   * Threads reserved for metadata calls such as stat, list and open
+   * (default 8, or `UPLINK_METADATA_THREAD_POOL_SIZE`), so they never
+   * queue behind transfers. `0` runs them on the libuv pool instead.
+   */
+  metadataThreadPoolSize?: number;
+  /** Idle time after which a pool thread exits (default 30000) */
+  threadPoolIdleTimeoutMs?: number;
+  /**
+   * Microseconds a finished call may wait for others before the main
+   * thread is woken to settle them together (default 0, or
+   * `UPLINK_COMPLETION_DELAY_US`; at most 1000000). Trades that much
+   * latency per call for fewer event loop wake-ups under high fan-out.
+   */
+  completionDelayUs?: number;
+  /** Finished calls that wake the main thread before the delay passes (default 256) */
+  completionBatch?: number;
+  /**
+   * Upload bytes per second across all transfers of the process
+   * (default 0 = unlimited). Projects share it by `bandwidthWeight`.
+   */
+  maxUploadBytesPerSecond?: number;
+  /** Download bytes per second across all transfers of the process (default 0 = unlimited) */
+  maxDownloadBytesPerSecond?: number;
+}
+
+/**
+ * Thread pool lane a native call runs on: `'metadata'` for short
+ * interactive calls, `'bulk'` for transfers and batch operations
+ */
+export type ThreadPoolLane = 'metadata' | 'bulk';
+
+/**
+ * Per-call override of the thread pool lane
+ */
+export interface LaneOptions {
+  /** Run this call on the given lane instead of its default */
+  lane?: ThreadPoolLane;
+}
+
+/**
+ * Per-call cancellation and deadline
+ */
+export interface SignalOptions {
+  /**
+   * Abort the call: queued native work is dropped at once and running
+   * transfers stop at their next chunk, part, or batch. The promise
+   * rejects with `CanceledError`.
+   */
+  signal?: AbortSignal;
+  /**
+   * Deadline in milliseconds, counted from the call and covering time
+   * spent queued as well as running. Enforced natively like `signal`;
+   * the promise rejects with `TimeoutError`.
+   */
+  timeoutMs?: number;
+}
+
+/**
+ * Progress of a transfer, passed to `onProgress`
+ */
+export interface TransferProgress {
+  /** Bytes moved so far */
+  bytesTransferred: number;
+  /** Bytes the transfer will move, or -1 while unknown */
+  totalBytes: number;
+  /** Rate since the previous call */
+  bytesPerSecond: number;
+}
+
+/**
+ * Coalesced progress callbacks for a transfer
+ */
+export interface ProgressOptions {
+  /**
+   * Called as bytes move, at most once per `progressIntervalMs` (or
+   * `progressBytes`), and once with the final state before the call
+   * settles. Bytes of a retried part or range are taken back, so
+   * `bytesTransferred` can step down.
+   */
+  onProgress?: (progress: TransferProgress) => void;
+  /** Minimum milliseconds between calls (default 100) */
+  progressIntervalMs?: number;
+  /** Also call once this many bytes moved since the last call (default 0: by time only) */
+  progressBytes?: number;
+}
+
 /**
  * Permission settings for access grants
  */
@@ -44,6 +209,47 @@ export interface SharePrefix {
   prefix?: string;
 }
 
+/**
+ * Options for `Uplink.requestAccessWithPassphrase()`,
+ * `Uplink.configRequestAccessWithPassphrase()` and `AccessResultStruct.share()`
+ */
+export interface AccessSerializeOptions {
+  /**
+   * Serialize the new grant in the same native call: `true` resolves
+   * `{ access, serialized }`, `'only'` resolves just the serialized grant
+   * without creating an access handle
+   */
+  serialize?: boolean | 'only';
+}
+
+/**
+ * Result of a request or share with `{ serialize: true }`
+ */
+export interface SerializedAccess {
+  /** The new access grant */
+  access: AccessResultStruct;
+  /** The same grant, serialized */
+  serialized: string;
+}
+
+/**
+ * One restricted grant for `AccessResultStruct.shareMany()`
+ */
+export interface ShareSpec {
+  /** The permissions to grant */
+  permission: Permission;
+  /** The bucket/prefix combinations to restrict to */
+  prefixes: SharePrefix[];
+}
+
+/**
+ * Options for `AccessResultStruct.shareMany()`
+ */
+export interface ShareManyOptions {
+  /** Grants derived at once, at most 16 (default 4) */
+  concurrency?: number;
+}
+
 /**
  * Bucket information returned from bucket operations
  */
@@ -66,6 +272,12 @@ export interface ObjectInfo {
   system: SystemMetadata;
   /** Custom metadata key-value pairs */
   custom: CustomMetadata;
+  /** Running checksum of written bytes (upload `info()` with `checksum` option only) */
+  checksum?: {
+    algorithm: ChecksumAlgorithm;
+    /** Lowercase hex digest */
+    value: string;
+  };
 }
 
 /**
@@ -91,45 +303,1229 @@ export interface CustomMetadata {
 /**
  * Options for listing buckets
  */
-export interface ListBucketsOptions {
+export interface ListBucketsOptions extends SignalOptions {
   /** Cursor for pagination */
   cursor?: string;
+  /** Stop after this many buckets (0 or unset: no limit) */
+  maxItems?: number;
 }
 
+/**
+ * Opaque position in an object listing, reported by `onCheckpoint`; pass
+ * it back as `checkpoint` to continue after it
+ */
+export type ListingCheckpoint = string & { readonly __listingCheckpoint: never };
+
 /**
  * Options for listing objects
  */
-export interface ListObjectsOptions {
+export interface ListObjectsOptions extends LaneOptions, SignalOptions {
   /** Object key prefix filter */
   prefix?: string;
   /** Cursor for pagination */
   cursor?: string;
+  /** Resume after this checkpoint (takes precedence over `cursor`) */
+  checkpoint?: ListingCheckpoint;
+  /**
+   * Last key to list (inclusive). With `cursor` it selects one key range,
+   * so a scan can be split across workers by known boundary keys.
+   */
+  endKey?: string;
   /** Include system metadata in results */
   system?: boolean;
   /** Include custom metadata in results */
   custom?: boolean;
   /** Treat '/' as a directory separator */
   recursive?: boolean;
+  /**
+   * Return only these fields of each object; others are left out of the
+   * result and `system`/`custom` metadata is fetched only when a field
+   * needs it. `['key']` alone returns plain key strings.
+   */
+  fields?: readonly ObjectField[];
+}
+
+/**
+ * Options for sharded listing with `listObjectsParallel()`
+ *
+ * Give either explicit `prefixes` or `shardBy: 'delimiter'`, which lists
+ * the top level under `prefix` and shards by each of its prefixes.
+ */
+export interface ListObjectsParallelOptions extends Omit<
+  ListObjectsOptions,
+  'cursor' | 'checkpoint' | 'endKey' | 'recursive'
+> {
+  /** Shard prefixes, each listed recursively and independently */
+  prefixes?: readonly string[];
+  /** Derive the shards from the top-level prefixes under `prefix` */
+  shardBy?: 'delimiter';
+  /** Shards listed at once (default 4) */
+  concurrency?: number;
+  /** Merge order: 'lexicographic' (default) sorts by key; 'unordered' keeps arrival order */
+  order?: 'lexicographic' | 'unordered';
+}
+
+/**
+ * One page of a columnar listing from `iterateObjectColumns()`
+ *
+ * All columns are views over a single ArrayBuffer and are indexed by
+ * entry, `0 <= i < count`.
+ */
+export interface ObjectColumns {
+  /** Number of entries in the page */
+  count: number;
+  /** Concatenated UTF-8 keys */
+  keyBytes: Uint8Array;
+  /** Key `i` is `keyBytes[keyOffsets[i], keyOffsets[i + 1])`; `count + 1` entries */
+  keyOffsets: Uint32Array;
+  /** Content length in bytes */
+  contentLength: BigInt64Array;
+  /** Creation time (Unix seconds) */
+  created: Float64Array;
+  /** Expiration time (Unix seconds), 0 if the object never expires */
+  expires: Float64Array;
+  /** Bitmap; entry `i` is a prefix when bit `i % 8` of byte `i >> 3` is set */
+  isPrefix: Uint8Array;
+}
+
+/**
+ * Selectable object fields for a projected listing
+ */
+export type ObjectField = 'key' | 'isPrefix' | 'created' | 'expires' | 'contentLength' | 'custom';
+
+/**
+ * Options for streaming a listing with `iterateObjects()`
+ */
+export interface IterateObjectsOptions extends ListObjectsOptions {
+  /** Objects fetched per native call (default 1000) */
+  pageSize?: number;
+  /**
+   * Called with the listing's checkpoint once each page has been
+   * consumed; a listing resumed from it starts with the next page
+   */
+  onCheckpoint?: (checkpoint: ListingCheckpoint) => void;
+}
+
+/**
+ * Options for `statObjects()`
+ */
+export interface StatObjectsOptions extends LaneOptions, SignalOptions, RetryableOptions {
+  /** Keys stat'ed at once on native threads (default 8, at most 64) */
+  concurrency?: number;
+}
+
+/**
+ * A key that `statObjects()` could not stat for a reason other than not found
+ */
+export interface StatObjectsError {
+  /** Position of the key in the request */
+  index: number;
+  /** Object key */
+  key: string;
+  /** Typed error for this key */
+  error: Error;
+}
+
+/**
+ * Result of `statObjects()`
+ */
+export interface StatObjectsResult {
+  /** `objects[i]` is the info for `keys[i]`, or null if it is missing or failed */
+  objects: Array<ObjectInfo | null>;
+  /** Keys that failed, in request order */
+  errors: StatObjectsError[];
+}
+
+/**
+ * Options for `ProjectResultStruct.warmup()`
+ */
+export interface WarmupOptions extends SignalOptions {
+  /** Buckets to stat; without any, one bucket listing page is fetched to dial */
+  buckets?: string[];
+  /** Objects to stat, seeding the stat cache when it is enabled */
+  objects?: Array<{ bucket: string; keys: string[] }>;
+}
+
+/**
+ * Outcome of `ProjectResultStruct.warmup()`
+ */
+export interface WarmupResult {
+  /** Info of the buckets that could be stat'ed, in request order */
+  buckets: BucketInfo[];
+  /** Buckets or object batches that failed */
+  errors: Array<{ bucket: string; error: Error }>;
+  /** Time the warm-up took */
+  elapsedMs: number;
+}
+
+/**
+ * Options for `deleteObjects()`
+ */
+export interface DeleteObjectsOptions extends LaneOptions, SignalOptions, RetryableOptions {
+  /** Keys deleted at once on native threads (default 8, at most 64) */
+  concurrency?: number;
+}
+
+/**
+ * A key that `deleteObjects()` failed to delete
+ */
+export interface DeleteObjectsFailure {
+  /** Position of the key in the request */
+  index: number;
+  /** Object key */
+  key: string;
+  /** Uplink error code (see `ErrorCodes`) */
+  code: number;
+  /** Uplink error message */
+  message: string;
+}
+
+/**
+ * Summary returned by `deleteObjects()`
+ */
+export interface DeleteObjectsResult {
+  /** Objects that existed and were deleted */
+  deleted: number;
+  /** Keys that did not exist */
+  missing: number;
+  /** Keys that failed, in request order */
+  failed: DeleteObjectsFailure[];
+}
+
+/**
+ * Options for `deletePrefix()`
+ */
+export interface DeletePrefixOptions extends LaneOptions, SignalOptions {
+  /** Native deletion threads fed by the listing (default 8, at most 64) */
+  concurrency?: number;
+  /** List and count the objects without deleting them */
+  dryRun?: boolean;
+}
+
+/**
+ * Totals returned by `deletePrefix()`
+ */
+export interface DeletePrefixResult {
+  /** Objects found under the prefix */
+  listed: number;
+  /** Objects deleted */
+  deleted: number;
+  /** Objects already gone when their deletion ran */
+  missing: number;
+  /** Objects that failed to delete */
+  failed: number;
+  /** The first 100 failures with their codes */
+  failures: Array<Omit<DeleteObjectsFailure, 'index'>>;
+}
+
+/**
+ * One source/destination pair for `copyObjects()` or `moveObjects()`
+ */
+export interface ObjectPair {
+  /** Source bucket name */
+  oldBucket: string;
+  /** Source object key */
+  oldKey: string;
+  /** Destination bucket name */
+  newBucket: string;
+  /** Destination object key */
+  newKey: string;
+}
+
+/**
+ * Options for `copyObjects()` and `moveObjects()`
+ */
+export interface ObjectPairsOptions extends LaneOptions, SignalOptions {
+  /** Pairs processed at once on native threads (default 8, at most 64) */
+  concurrency?: number;
+}
+
+/**
+ * Per-pair status returned by `copyObjects()` and `moveObjects()`
+ */
+export interface ObjectPairsResult {
+  /** Pairs that succeeded */
+  succeeded: number;
+  /** `status[i]` is 0 if pair `i` succeeded, else its error code (see `ErrorCodes`) */
+  status: Int32Array;
+  /** Failed pairs, in request order */
+  errors: Array<{ index: number; code: number; message: string }>;
+}
+
+/**
+ * Options for `updateObjectsMetadata()`
+ */
+export interface UpdateObjectsMetadataOptions extends LaneOptions, SignalOptions, RetryableOptions {
+  /** Keys updated at once on native threads (default 8, at most 64) */
+  concurrency?: number;
+}
+
+/**
+ * Per-key status returned by `updateObjectsMetadata()`
+ */
+export interface UpdateObjectsMetadataResult {
+  /** Keys whose metadata was replaced */
+  succeeded: number;
+  /** `status[i]` is 0 if key `i` was updated, else its error code (see `ErrorCodes`) */
+  status: Int32Array;
+  /** Failed keys, in request order */
+  errors: Array<{ index: number; code: number; message: string }>;
+}
+
+/**
+ * Options for `exportListing()`
+ */
+export interface ExportListingOptions extends LaneOptions, SignalOptions {
+  /** Object key prefix filter */
+  prefix?: string;
+  /** List every key below the prefix instead of one level */
+  recursive?: boolean;
+  /** Record format (default `'ndjson'`) */
+  format?: 'ndjson' | 'binary';
+  /** Fetch and write system metadata (default true) */
+  includeSystem?: boolean;
+  /** Fetch and write custom metadata (default false) */
+  includeCustom?: boolean;
+  /** fsync the file before resolving (default false) */
+  fsync?: boolean;
+}
+
+/**
+ * Totals returned by `exportListing()`
+ */
+export interface ExportListingResult {
+  /** Object records written */
+  objects: number;
+  /** Prefix records written (non-recursive listings) */
+  prefixes: number;
+  /** Sum of the objects' content lengths */
+  contentLength: number;
+  /** Size of the file */
+  bytesWritten: number;
+}
+
+/**
+ * Options for `enableStatCache()`
+ */
+export interface StatCacheOptions {
+  /** Entry limit; least recently used entries are evicted (default 1024) */
+  maxEntries?: number;
+  /** How long an entry stays valid in milliseconds (default 5000) */
+  ttlMs?: number;
+}
+
+/**
+ * Options for `enableObjectCache()`
+ */
+export interface ObjectCacheOptions {
+  /** Total bytes of object contents kept; least recently used entries are evicted (default 64 MiB) */
+  maxBytes?: number;
+  /** Larger objects are never cached (default 1 MiB) */
+  maxObjectSize?: number;
+  /** How long an entry stays valid in milliseconds (default 60000) */
+  ttlMs?: number;
+}
+
+/**
+ * Options for `enableKnownBuckets()`
+ */
+export interface KnownBucketsOptions {
+  /** How long a bucket stays known in milliseconds (default 300000) */
+  ttlMs?: number;
+}
+
+/**
+ * Options for `Uplink.enableChunkCache()`
+ */
+export interface ChunkCacheOptions {
+  /** Directory holding the cache files, created if missing; processes may share it */
+  directory: string;
+  /** Disk budget; least recently used files are removed beyond it (default 1 GiB) */
+  maxBytes?: number;
+  /** Chunk size, a power of two from 64 KiB to 64 MiB (default 1 MiB) */
+  chunkSize?: number;
+}
+
+/**
+ * Counters returned by `Uplink.chunkCacheStats()`
+ */
+export interface ChunkCacheStats {
+  /** Cache directory */
+  directory: string;
+  /** Bytes read from cache files */
+  hitBytes: number;
+  /** Bytes downloaded because their chunk was not cached */
+  missBytes: number;
+  /** Chunks written to cache files */
+  chunksStored: number;
+  /** Chunk writes that failed (the read still succeeds) */
+  writeErrors: number;
+  /** Cache files removed to stay under maxBytes */
+  evictions: number;
+  /** Disk usage of the directory as of the last scan, plus this process's writes since */
+  bytes: number;
+  /** Configured disk budget */
+  maxBytes: number;
+  /** Configured chunk size */
+  chunkSize: number;
+}
+
+/**
+ * Options for `Uplink.enableReadAhead()`
+ */
+export interface ReadAheadOptions {
+  /**
+   * `adaptive` (default) stops reading ahead on an object after repeated
+   * seeks; `sequential` always reads ahead
+   */
+  policy?: 'adaptive' | 'sequential';
+  /** First window of a sequential download, at least 4 KiB (default 128 KiB) */
+  initialWindow?: number;
+  /** Window ceiling, at most 64 MiB (default 8 MiB) */
+  maxWindow?: number;
+}
+
+/**
+ * Counters returned by `Uplink.readAheadStats()`
+ */
+export interface ReadAheadStats {
+  /** Active policy */
+  policy: 'adaptive' | 'sequential';
+  /** Downloads opened with a read-ahead window */
+  sequentialOpens: number;
+  /** Downloads opened without one, after repeated seeks on their object */
+  randomOpens: number;
+  /** Opens away from where the object was last read */
+  seeks: number;
+  /** Reads answered from a window without reading further */
+  readsServed: number;
+  /** Bytes read into windows */
+  bytesPrefetched: number;
+  /** Times a window doubled */
+  windowGrowths: number;
+  /** Objects whose access history is kept */
+  objects: number;
+  /** Configured first window */
+  initialWindow: number;
+  /** Configured window ceiling */
+  maxWindow: number;
+}
+
+/**
+ * Options for `Uplink.enableAccessCache()`
+ */
+export interface AccessCacheOptions {
+  /** Grants kept; least recently used ones are evicted (default 4096) */
+  maxEntries?: number;
+}
+
+/**
+ * Counters returned by `Uplink.accessCacheStats()`
+ */
+export interface AccessCacheStats {
+  /** parseAccess calls served from the cache */
+  hits: number;
+  /** parseAccess calls that parsed the grant */
+  misses: number;
+  /** Grants dropped to stay under maxEntries */
+  evictions: number;
+  /** Grants currently cached */
+  entries: number;
+  /** Configured entry limit */
+  maxEntries: number;
+}
+
+/**
+ * Options for `Uplink.enablePassphraseAccessCache()`
+ */
+export interface PassphraseAccessCacheOptions {
+  /** Grants kept; least recently used ones are evicted (default 256) */
+  maxEntries?: number;
+  /** Time a grant stays cached, 0 for no expiry (default 3600000) */
+  ttlMs?: number;
+  /** Also keep grants in this file, encrypted, so restarts reuse them */
+  file?: string;
+  /** 32-byte secret the file is encrypted with; required with `file` */
+  fileKey?: Buffer;
+}
+
+/**
+ * Counters returned by `Uplink.passphraseAccessCacheStats()`
+ */
+export interface PassphraseAccessCacheStats {
+  /** Requests served from the cache */
+  hits: number;
+  /** Requests that went to the satellite */
+  misses: number;
+  /** Grants dropped to stay under maxEntries */
+  evictions: number;
+  /** Grants dropped after ttlMs */
+  expirations: number;
+  /** Grants currently cached */
+  entries: number;
+  /** Configured entry limit */
+  maxEntries: number;
+  /** Configured time to live */
+  ttlMs: number;
+  /** Cache file reads or writes that failed */
+  fileErrors: number;
+}
+
+/**
+ * Counters returned by `statCacheStats()`
+ */
+export interface StatCacheStats {
+  /** statObject calls served from the cache */
+  hits: number;
+  /** statObject calls that went to the satellite */
+  misses: number;
+  /** Entries dropped by writes through this binding */
+  invalidations: number;
+  /** Entries currently cached */
+  entries: number;
+  /** Configured entry limit */
+  maxEntries: number;
+  /** Configured TTL in milliseconds */
+  ttlMs: number;
+}
+
+/**
+ * Counters returned by `objectCacheStats()`
+ */
+export interface ObjectCacheStats {
+  /** getObject calls served from the cache */
+  hits: number;
+  /** getObject calls that downloaded the object */
+  misses: number;
+  /** Entries dropped by writes through this binding or a newer `created` seen by statObject */
+  invalidations: number;
+  /** Entries dropped to stay under maxBytes */
+  evictions: number;
+  /** Entries currently cached */
+  entries: number;
+  /** Content bytes currently cached */
+  bytes: number;
+  /** Configured byte limit */
+  maxBytes: number;
+  /** Configured object size limit */
+  maxObjectSize: number;
+  /** Configured TTL in milliseconds */
+  ttlMs: number;
+}
+
+/**
+ * Counters returned by `knownBucketsStats()`
+ */
+export interface KnownBucketsStats {
+  /** ensureBucket calls resolved from the set */
+  hits: number;
+  /** ensureBucket calls that went to the satellite */
+  misses: number;
+  /** Names dropped by bucket deletes through this binding */
+  invalidations: number;
+  /** Buckets currently known */
+  entries: number;
+  /** Configured TTL in milliseconds */
+  ttlMs: number;
+}
+
+/**
+ * Queue depth gauges returned by `admissionStats()`
+ */
+export interface AdmissionStats {
+  /** Transfers running or holding an open upload/download */
+  transfersActive: number;
+  /** Transfers waiting for a slot */
+  transfersQueued: number;
+  /** Configured transfer limit (0 = unlimited) */
+  maxConcurrentTransfers: number;
+  /** Metadata calls running */
+  metadataActive: number;
+  /** Metadata calls waiting for a slot */
+  metadataQueued: number;
+  /** Configured metadata limit (0 = unlimited) */
+  maxConcurrentMetadataOps: number;
+}
+
+/**
+ * Live native handles by type, returned by `handleStats()`
+ */
+export interface HandleStats {
+  access: number;
+  project: number;
+  download: number;
+  upload: number;
+  encryptionKey: number;
+  partUpload: number;
+  objectIterator: number;
+  bucketIterator: number;
+  uploadIterator: number;
+  partIterator: number;
+  cancelToken: number;
+  archive: number;
+  /** Sum of all types */
+  total: number;
+}
+
+/**
+ * Work data pool counters since process start, returned by `workPoolStats()`
+ */
+export interface WorkPoolStats {
+  /** Allocations served from the pool */
+  hits: number;
+  /** Allocations that needed a fresh block */
+  misses: number;
+  /** Allocations too large to pool */
+  oversize: number;
+  /** Blocks currently kept for reuse */
+  cached: number;
+}
+
+/**
+ * Native memory snapshot, returned by `nativeStats()`
+ */
+export interface NativeStats {
+  /** Native allocator calls since process start, realloc included */
+  allocations: number;
+  /** Native blocks freed since process start */
+  frees: number;
+  /** Bytes in native blocks not yet freed */
+  liveBytes: number;
+  /** Highest `liveBytes` seen */
+  peakBytes: number;
+  /** Whether uplink-c's Go side holds no handles */
+  universeEmpty: boolean;
 }
 
 /**
  * Options for uploading objects
  */
-export interface UploadOptions {
+export interface UploadOptions extends SignalOptions {
+  /** When the object should expire */
+  expires?: Date;
+  /**
+   * Size in bytes of a native write-coalescing buffer (0 or unset disables it).
+   * Writes that fit are copied into the buffer and resolve immediately; the
+   * buffer is flushed when it would overflow and on `commit()`.
+   */
+  writeBufferSize?: number;
+  /**
+   * Let `write()` and `writev()` resolve once their bytes are queued, as
+   * long as the bytes queued natively stay within this many (0 or unset:
+   * they resolve when written). Writes always run in call order, so
+   * callers may issue several without awaiting and then `commit()`; if a
+   * queued write fails, later writes and `commit()` reject with its error.
+   * A write that resolves early has had its bytes copied natively, so its
+   * buffer may be reused at once; the cap bounds the memory those copies
+   * take.
+   */
+  maxQueuedBytes?: number;
+  /**
+   * Compute a checksum of the uploaded bytes natively while writing. The
+   * hex digest is stored as custom metadata `checksum-<algorithm>` on
+   * commit and reported by `info()` as `checksum`.
+   */
+  checksum?: ChecksumAlgorithm;
+  /**
+   * Compress the object natively in 256 KiB chunks as it is written. The
+   * codec and a frame index are recorded in custom metadata, so
+   * `downloadObject()` and the download streams decode it transparently,
+   * ranged reads included. Incompressible chunks are stored as is.
+   * Calls that hand out the stored bytes (`getObject()`, `downloadToFile()`,
+   * `downloadParallel()`, `downloadRanges()`, archive streams and packs)
+   * reject such objects with `CompressedObjectError`. `putObject()`,
+   * `uploadFile()`, `uploadParallel()` and `createPackUpload()` reject
+   * this option.
+   */
+  compress?: CompressionCodec;
+}
+
+/**
+ * Compression codecs for `UploadOptions.compress`
+ */
+export type CompressionCodec = 'lz4';
+
+/**
+ * Options for `createWriteStream()`
+ */
+export interface WriteStreamOptions extends UploadOptions, ProgressOptions {
+  /** Custom metadata set before the first write */
+  customMetadata?: CustomMetadata;
+  /** Native writes queued ahead of the producer before it is paused (default 4) */
+  maxInFlight?: number;
+  /** Bytes buffered in the stream before write() returns false (default 4 MiB) */
+  highWaterMark?: number;
+}
+
+/**
+ * Inline upload checksum and download verification algorithms
+ */
+export type ChecksumAlgorithm = 'crc32c' | 'sha256';
+
+/**
+ * Options for uploading a local file with `uploadFile()`
+ */
+export interface UploadFileOptions extends LaneOptions, SignalOptions, ProgressOptions {
+  /** Size of the native read buffer in bytes (default 1 MiB) */
+  chunkSize?: number;
+  /**
+   * Memory-map the file and hand pages straight to uplink instead of
+   * copying through a read buffer. Falls back to buffered reads where
+   * mmap is unsupported.
+   */
+  mmap?: boolean;
+  /** When the object should expire */
+  expires?: Date;
+  /** Custom metadata to attach to the object */
+  metadata?: CustomMetadata;
+}
+
+/**
+ * Aggregated progress reported by `uploadDirectory()`
+ */
+export interface UploadDirectoryProgress {
+  /** Files finished, successfully or not */
+  filesDone: number;
+  /** Files selected for upload */
+  filesTotal: number;
+  /** Bytes of successfully uploaded files */
+  bytesDone: number;
+  /** Bytes of all selected files */
+  bytesTotal: number;
+  /** Files that failed */
+  failed: number;
+}
+
+/**
+ * Options for `uploadDirectory()`
+ */
+export interface UploadDirectoryOptions extends LaneOptions, SignalOptions {
+  /** Files uploaded at once (default 8, max 256) */
+  concurrency?: number;
+  /**
+   * Glob patterns matched against the path below the directory; only
+   * matching files are uploaded. `*` stays within one segment, `**` crosses
+   * segments. Default: every file.
+   */
+  include?: readonly string[];
+  /**
+   * Upload exactly these paths below the directory instead of walking it,
+   * e.g. the `upload` entries of a `diff()` plan. `include` is not applied.
+   */
+  files?: readonly string[];
+  /** Files of at least this many bytes use the parallel multipart engine (default 64 MiB) */
+  largeFileThreshold?: number;
+  /** Parts in flight per large file (default 4) */
+  partConcurrency?: number;
+  /** Called with aggregated totals, at most every 100 ms and once at the end */
+  onProgress?: (progress: UploadDirectoryProgress) => void;
+}
+
+/**
+ * Totals of `uploadDirectory()`
+ */
+export interface UploadDirectoryResult {
+  /** Files selected for upload */
+  files: number;
+  /** Bytes uploaded */
+  bytes: number;
+  /** Files uploaded successfully */
+  uploaded: number;
+  /** Files that failed */
+  failed: number;
+  /** The first 100 failures, with paths relative to the directory */
+  failures: Array<{ path: string; code: number; message: string }>;
+}
+
+/**
+ * How `diff()` decides that a local file matches its object. Sizes must
+ * always match. `'size+mtime'` also requires that the object was not
+ * created before the file was last modified. `'checksum'` hashes the file
+ * and compares it with the object's `checksum-<algorithm>` metadata (as
+ * written by an inline upload checksum), falling back to `'size+mtime'`
+ * for objects without one.
+ */
+export type DiffCompareMode = 'size' | 'size+mtime' | 'checksum';
+
+/**
+ * Options for `diff()`
+ */
+export interface DiffOptions extends LaneOptions, SignalOptions {
+  /** Comparison of files with their objects (default `'size+mtime'`) */
+  compare?: DiffCompareMode;
+  /**
+   * Glob patterns matched against the path below the directory (and the
+   * key below the prefix); only matching files and objects are compared.
+   */
+  include?: readonly string[];
+}
+
+/**
+ * One planned upload or delete of `diff()`
+ */
+export interface DiffPlanEntry {
+  /** Object key */
+  key: string;
+  /** Uploads: path below the local directory */
+  path?: string;
+  /** Local size for uploads, object size for deletes */
+  size: number;
+  /** Uploads: `'new'` without an object, `'changed'` when it differs */
+  reason?: 'new' | 'changed';
+}
+
+/**
+ * Plan returned by `diff()`, in key order
+ */
+export interface DiffResult {
+  /** Files to upload */
+  upload: DiffPlanEntry[];
+  /** Objects with no local file */
+  delete: DiffPlanEntry[];
+  /** Files that match their objects */
+  unchanged: number;
+  /** Bytes to upload */
+  uploadBytes: number;
+  /** Bytes held by the objects to delete */
+  deleteBytes: number;
+  /** Local files compared */
+  localFiles: number;
+  /** Objects compared */
+  remoteObjects: number;
+}
+
+/**
+ * Options for `sync()`
+ */
+export interface SyncOptions extends DiffOptions {
+  /** Delete objects that have no local file (default `false`) */
+  delete?: boolean;
+  /** Files uploaded at once (default 8, max 256) */
+  concurrency?: number;
+  /** Files of at least this many bytes use the parallel multipart engine (default 64 MiB) */
+  largeFileThreshold?: number;
+  /** Parts in flight per large file (default 4) */
+  partConcurrency?: number;
+  /** Called with the upload totals, as for `uploadDirectory()` */
+  onProgress?: (progress: UploadDirectoryProgress) => void;
+}
+
+/**
+ * Outcome of `sync()`
+ */
+export interface SyncResult {
+  /** The plan that was run */
+  plan: DiffResult;
+  /** Upload totals, or null when nothing needed uploading */
+  upload: UploadDirectoryResult | null;
+  /** Delete totals, or null without `delete` or when nothing needed deleting */
+  delete: DeleteObjectsResult | null;
+}
+
+/**
+ * Options for uploading a buffer with `putObject()`
+ */
+export interface PutObjectOptions extends LaneOptions, SignalOptions, ProgressOptions {
   /** When the object should expire */
   expires?: Date;
+  /** Custom metadata to attach to the object */
+  metadata?: CustomMetadata;
+}
+
+/**
+ * Options for `putObjectDedup()`
+ */
+export interface PutObjectDedupOptions extends LaneOptions, SignalOptions {
+  /** Digest the key is derived from (default `'sha256'`) */
+  algorithm?: ChecksumAlgorithm;
+  /** Size of the native read buffer for file sources in bytes (default 1 MiB) */
+  chunkSize?: number;
+  /** When the object should expire (uploads only) */
+  expires?: Date;
+  /** Custom metadata to attach to the object (uploads only) */
+  metadata?: CustomMetadata;
+}
+
+/**
+ * Result of `putObjectDedup()`
+ */
+export interface PutObjectDedupResult {
+  /** Key derived from the content digest */
+  key: string;
+  /** Whether the content was uploaded (`false` when the key already existed) */
+  uploaded: boolean;
+  /** Info of the existing or newly uploaded object */
+  object: ObjectInfo;
+}
+
+/**
+ * One destination of `uploadReplicated()`
+ */
+export interface ReplicaTarget {
+  /** Project to upload through (default: the project `uploadReplicated()` is called on) */
+  project?: ProjectResultStruct;
+  /** Bucket to upload to */
+  bucket: string;
+  /** Object key */
+  key: string;
+}
+
+/**
+ * Options for `uploadReplicated()`
+ */
+export interface UploadReplicatedOptions extends LaneOptions, SignalOptions {
+  /**
+   * Targets that must commit for the upload to succeed (default: all).
+   * When fewer commit, the committed ones are deleted again.
+   */
+  quorum?: number;
+  /** Bytes read from the source and written to each target per step (default 1 MiB) */
+  chunkSize?: number;
+  /** When the objects should expire */
+  expires?: Date;
+  /** Custom metadata to attach to every object */
+  metadata?: CustomMetadata;
+}
+
+/**
+ * Outcome of one target of `uploadReplicated()`
+ */
+export interface ReplicaResult {
+  bucket: string;
+  key: string;
+  /** Info of the committed object */
+  object?: ObjectInfo;
+  /** Why the target was not committed (only when quorum is below the target count) */
+  error?: Error;
+}
+
+/**
+ * Result of `uploadReplicated()`
+ */
+export interface UploadReplicatedResult {
+  /** Bytes read from the source, once for all targets */
+  bytesRead: number;
+  /** Number of targets committed */
+  committed: number;
+  /** Per-target outcome, in target order */
+  targets: ReplicaResult[];
 }
 
 /**
  * Options for downloading objects
  */
-export interface DownloadOptions {
+export interface DownloadOptions extends SignalOptions {
   /** Starting byte offset */
   offset?: number;
   /** Number of bytes to download (-1 for all) */
   length?: number;
 }
 
+/**
+ * Content check for a whole-object download, computed natively as bytes
+ * are read. Without `expected` or `fromMetadataKey` the digest is taken
+ * from the `checksum-<algorithm>` metadata an inline upload checksum writes.
+ */
+export interface DownloadVerifyOptions {
+  /** Checksum algorithm */
+  algorithm: ChecksumAlgorithm;
+  /** Expected hex digest */
+  expected?: string;
+  /** Custom metadata key holding the expected hex digest */
+  fromMetadataKey?: string;
+}
+
+/**
+ * Options for `downloadObject()` and the download streams
+ */
+export interface DownloadObjectOptions extends DownloadOptions, RetryableOptions {
+  /**
+   * Verify the content as it is read. The read that completes the object
+   * (or `close()` if EOF was never read) rejects with `IntegrityError` on
+   * a mismatch. Cannot be combined with `offset` or `length`.
+   */
+  verify?: DownloadVerifyOptions;
+  /**
+   * Decode objects uploaded with `compress` (default `true`). With `false`
+   * the stored frames are read as is. `offset` and `length` address the
+   * original bytes when decoding.
+   */
+  decompress?: boolean;
+  /**
+   * Read through the disk chunk cache when `Uplink.enableChunkCache()` is
+   * on (default `true`). Set `false` for one-off reads that should not
+   * displace cached chunks. Not used for compressed objects being decoded.
+   */
+  chunkCache?: boolean;
+  /**
+   * Classify the open and read small sequential reads through a growing
+   * window when `Uplink.enableReadAhead()` is on (default `true`).
+   */
+  nativeReadAhead?: boolean;
+  /** Race a second open when the first is slow; see `HedgeOptions` */
+  hedge?: boolean | HedgeOptions;
+  /**
+   * Hand every byte read to native sinks as well (at most 8); see
+   * `DownloadTeeSink`. Outcomes are read with `download.teeResults()`.
+   */
+  tee?: DownloadTeeSink[];
+}
+
+/**
+ * A native sink of a teed download.
+ *
+ * Each read of the download also writes its bytes to every sink, without
+ * a copy per sink, and settles once all sinks took them, so the reader
+ * runs at the pace of the slowest sink. The buffer passed to `read()` is
+ * the JS side of the tee. A file sink is created (or truncated) on the
+ * first read and closed by `close()`, after an fsync with `fsync: true`.
+ * When a `required` sink (the default) fails, the read or `close()`
+ * rejects; an optional sink is dropped and reports its error.
+ */
+export type DownloadTeeSink =
+  | { path: string; fsync?: boolean; required?: boolean }
+  | { hash: ChecksumAlgorithm; required?: boolean };
+
+/**
+ * Outcome of one sink, from `download.teeResults()`
+ */
+export interface DownloadTeeResult {
+  /** Bytes the sink took */
+  bytes: number;
+  /** File sinks: the path written */
+  path?: string;
+  /** Hash sinks: the algorithm */
+  algorithm?: ChecksumAlgorithm;
+  /** Hash sinks: hex digest of the bytes read so far */
+  digest?: string;
+  /** Set once the sink failed */
+  error?: Error;
+}
+
+/**
+ * Hedging policy for `downloadObject()` and `getObject()`.
+ *
+ * If the request has not finished after a percentile of recent latency,
+ * an identical request is started and whichever succeeds first is used;
+ * the other is closed once it returns. `true` uses the defaults. Latency
+ * comes from `getMetrics()`: the `downloadObject` execute time for
+ * downloads (the open), and `getObjectFirstByte`, the time to the first
+ * bytes, for `getObject()`. Costs an extra request for the slowest calls.
+ */
+export interface HedgeOptions {
+  /** Percentile of recent latency after which the duplicate starts (default 95) */
+  percentile?: number;
+  /** Lower bound of the delay in milliseconds (default 10) */
+  minDelayMs?: number;
+  /** Upper bound of the delay in milliseconds, used until 20 calls were timed (default 1000) */
+  maxDelayMs?: number;
+}
+
+/**
+ * Counters returned by `Uplink.hedgeStats()`
+ */
+export interface HedgeStats {
+  /** Requests for which a duplicate was started */
+  hedged: number;
+  /** Of those, requests the duplicate answered first */
+  backupWins: number;
+}
+
+/**
+ * Retry policy for idempotent calls.
+ *
+ * Transient failures are retried inside the native call, spaced by
+ * exponential backoff with full jitter (a random delay up to
+ * `baseDelayMs * 2^(attempt - 1)`, capped at `maxDelayMs`). Aborting the
+ * call's signal ends the wait. `true` uses the defaults. A part upload is
+ * retried as a whole part; a download is retried only while opening.
+ */
+export interface RetryOptions {
+  /** Attempts including the first, 1 to 20 (default 3) */
+  attempts?: number;
+  /** Delay cap of the first retry in milliseconds (default 100) */
+  baseDelayMs?: number;
+  /** Delay cap of any retry in milliseconds (default 2000) */
+  maxDelayMs?: number;
+  /** Error class names to retry (default `['InternalError', 'TooManyRequestsError']`) */
+  retryOn?: string[];
+}
+
+/**
+ * Options of calls that accept a retry policy
+ */
+export interface RetryableOptions {
+  /** Retry transient failures natively; see `RetryOptions` */
+  retry?: boolean | RetryOptions;
+}
+
+/**
+ * Options for downloading an object to a local file with `downloadToFile()`
+ */
+export interface DownloadToFileOptions extends DownloadOptions, LaneOptions, ProgressOptions {
+  /** Size of the native read buffer in bytes (default 1 MiB) */
+  chunkSize?: number;
+  /** fsync the file before resolving (default false) */
+  fsync?: boolean;
+}
+
+/**
+ * Result of `downloadToFile()` and `downloadParallel()`
+ */
+export interface DownloadToFileResult {
+  /** Number of bytes written to the sink */
+  bytesWritten: number;
+}
+
+/**
+ * Parameters a parallel transfer settled on in `auto` mode
+ */
+export interface TransferTuning {
+  /** Part size (range size for downloads) in bytes */
+  partSize: number;
+  /** Parts in flight */
+  concurrency: number;
+  /** Goodput over the tuner's last measurement window */
+  bytesPerSecond: number;
+}
+
+/**
+ * Result of `downloadParallel()`
+ */
+export interface DownloadParallelResult extends DownloadToFileResult {
+  /** Chosen parameters, present when `auto` was set */
+  tuning?: TransferTuning;
+}
+
+/**
+ * Options for `getObject()`
+ */
+export interface GetObjectOptions extends LaneOptions, SignalOptions, ProgressOptions, RetryableOptions {
+  /** Reject objects larger than this many bytes instead of buffering them */
+  maxSize?: number;
+  /** Race a second request when the first bytes are slow; see `HedgeOptions` */
+  hedge?: boolean | HedgeOptions;
+}
+
+/**
+ * Result of `getObject()`
+ */
+export interface GetObjectResult {
+  /** The object's content */
+  data: Buffer;
+  /** Object information */
+  info: ObjectInfo;
+}
+
+/**
+ * Options for `createReadStream()`
+ */
+export interface ReadStreamOptions extends DownloadObjectOptions, ProgressOptions {
+  /** Size of each native read in bytes (default 1 MiB) */
+  chunkSize?: number;
+  /** Number of chunks read ahead of the consumer (default 4) */
+  readAhead?: number;
+  /** Bytes buffered before reads pause (default chunkSize * readAhead) */
+  highWaterMark?: number;
+}
+
+/**
+ * Options for `createWebReadStream()`
+ */
+export interface WebReadStreamOptions extends DownloadObjectOptions {
+  /** Size of each native read when the consumer brings no buffer (default 1 MiB) */
+  chunkSize?: number;
+}
+
+/**
+ * Options for `DownloadResultStruct.readInto()`
+ */
+export interface ReadIntoOptions extends SignalOptions {
+  /** Loop over partial reads until `length` bytes or EOF, like `readFull()` */
+  fill?: boolean;
+}
+
+/**
+ * Options for `downloadParallel()`
+ */
+export interface DownloadParallelOptions extends LaneOptions, SignalOptions, ProgressOptions {
+  /** Size of each ranged stream in bytes (default 64 MiB; the starting size with `auto`) */
+  rangeSize?: number;
+  /** Number of ranges downloaded at once on native threads (default 4; the ceiling with `auto`, default 16) */
+  concurrency?: number;
+  /** Tune range size and ranges in flight to the measured goodput while the download runs */
+  auto?: boolean;
+  /** Retries per failed range before the download fails (default 3) */
+  retries?: number;
+  /** fsync file sinks before resolving (default false) */
+  fsync?: boolean;
+}
+
+/**
+ * One byte range for `downloadRanges()`
+ */
+export interface DownloadRange {
+  /** First byte; negative counts from the end of the object (-8 is the last 8 bytes) */
+  offset: number;
+  /** Number of bytes */
+  length: number;
+}
+
+/**
+ * Options for `downloadRanges()`
+ */
+export interface DownloadRangesOptions extends LaneOptions, SignalOptions {
+  /** Ranges at most this many bytes apart share one request (default 1 MiB; 0 merges only touching ranges) */
+  coalesceGap?: number;
+  /** Merged requests downloaded at once on native threads (default 4) */
+  concurrency?: number;
+  /** Retries per failed request before the call fails (default 3) */
+  retries?: number;
+}
+
+/**
+ * Archive format written by `createArchiveStream()`
+ */
+export type ArchiveFormat = 'tar' | 'zip';
+
+/**
+ * Options for `createArchiveStream()`
+ */
+export interface ArchiveStreamOptions {
+  /** Archive format (default 'tar'); entries are stored uncompressed either way */
+  format?: ArchiveFormat;
+  /** Objects fetched at once on native threads (default 8, at most 64) */
+  concurrency?: number;
+  /** Memory for objects fetched ahead of the reader (default 64 MiB, at least 1 MiB); larger objects are streamed */
+  maxBufferedBytes?: number;
+  /** Size of each native read in bytes (default 1 MiB) */
+  chunkSize?: number;
+  /** Bytes buffered before reads pause (default chunkSize * 4) */
+  highWaterMark?: number;
+  /** Destroys the stream when aborted */
+  signal?: AbortSignal;
+}
+
+/**
+ * A member of a pack object, as added by `PackUpload.add()`
+ */
+export interface PackMember {
+  /** Member name */
+  name: string;
+  /** Byte offset of the member in the pack object */
+  offset: number;
+  /** Member size in bytes */
+  length: number;
+}
+
+/**
+ * Options for `openPack()`
+ */
+export interface OpenPackOptions extends SignalOptions {
+  /** Bytes read from the end of the pack to find the index (default 64 KiB); larger indexes cost a second read */
+  indexReadSize?: number;
+}
+
 /**
  * Result from a write operation
  */
@@ -144,6 +1540,19 @@ export interface WriteResult {
 export interface ReadResult {
   /** Number of bytes read */
   bytesRead: number;
+  /** Whether the end of the object was reached (`readFull()`, or `read()` with `eofAsValue`) */
+  eof?: boolean;
+}
+
+/**
+ * Options for `download.read()`
+ */
+export interface ReadOptions {
+  /**
+   * Resolve the final read with `eof: true` instead of rejecting with an
+   * EOF error. Avoids building an Error for every object read to the end.
+   */
+  eofAsValue?: boolean;
 }
 
 /**
@@ -221,6 +1630,165 @@ export interface EncryptionKey {
   _handle: number;
 }
 
+/**
+ * One passphrase and salt for `Uplink.deriveEncryptionKeys()`
+ */
+export interface EncryptionKeyInput {
+  /** The passphrase to derive the key from */
+  passphrase: string;
+  /** A unique salt value */
+  salt: Buffer;
+}
+
+/**
+ * Options for `Uplink.deriveEncryptionKeys()`
+ */
+export interface DeriveEncryptionKeysOptions {
+  /** Keys derived at once, at most 16 (default 4) */
+  concurrency?: number;
+}
+
+/**
+ * Options for `Uplink.enableEncryptionKeyCache()`
+ */
+export interface EncryptionKeyCacheOptions {
+  /** Keys kept; least recently used ones are evicted (default 1024) */
+  maxEntries?: number;
+  /** Time a key stays cached after derivation, 0 for no expiry (default 900000) */
+  ttlMs?: number;
+}
+
+/**
+ * Counters returned by `Uplink.encryptionKeyCacheStats()`
+ */
+export interface EncryptionKeyCacheStats {
+  /** Derivations served from the cache */
+  hits: number;
+  /** Derivations that ran the key derivation function */
+  misses: number;
+  /** Keys dropped to stay under maxEntries */
+  evictions: number;
+  /** Keys dropped after ttlMs */
+  expirations: number;
+  /** Keys currently cached */
+  entries: number;
+  /** Configured entry limit */
+  maxEntries: number;
+  /** Configured time to live */
+  ttlMs: number;
+}
+
+/**
+ * Options for `Uplink.getMetrics()`
+ */
+export interface GetMetricsOptions {
+  /** Include cumulative histogram buckets (default false) */
+  buckets?: boolean;
+  /** Clear the counters after taking the snapshot (default false) */
+  reset?: boolean;
+}
+
+/**
+ * Latency distribution of one phase of an operation
+ *
+ * Quantiles are accurate to within 12.5%.
+ */
+export interface LatencyHistogram {
+  count: number;
+  sumMs: number;
+  minMs: number;
+  maxMs: number;
+  p50Ms: number;
+  p90Ms: number;
+  p99Ms: number;
+  p999Ms: number;
+  /** Cumulative `[upperBoundMs, count]` pairs, with `buckets: true` */
+  buckets?: Array<[number, number]>;
+}
+
+/**
+ * Timings of one native operation
+ */
+export interface OperationMetrics {
+  /** Calls completed, including cancelled ones */
+  calls: number;
+  /** Calls dequeued before they started */
+  cancelled: number;
+  /** Bytes moved by transfer calls */
+  bytes: number;
+  /** From the call until a pool thread picked it up, including admission wait */
+  queued: LatencyHistogram;
+  /** Native execution on the pool thread */
+  execute: LatencyHistogram;
+  /** Result conversion on the JS thread */
+  complete: LatencyHistogram;
+}
+
+/**
+ * Jobs of one thread pool lane
+ */
+export interface LaneGauges {
+  /** Jobs waiting for a pool thread */
+  queued: number;
+  /** Jobs running on a pool thread */
+  running: number;
+  /** Threads the lane may use at once */
+  budget: number;
+}
+
+/**
+ * Open handles of one type
+ */
+export interface HandleGauges {
+  open: number;
+  /** Handles closed, committed, aborted or freed by call */
+  explicitCloses: number;
+  /** Handles released by the garbage collector without a close */
+  finalizerFrees: number;
+}
+
+/**
+ * Point-in-time resource counts, never reset
+ */
+export interface MetricsGauges {
+  /** Pool threads alive, shared by the whole process */
+  threads: number;
+  /** Pool threads waiting for work */
+  idleThreads: number;
+  /** Calls settled by pool threads since start */
+  completions: number;
+  /** Main-thread wake-ups that settled them; the ratio is the mean batch */
+  completionWakeups: number;
+  /** Per-lane jobs, shared by the whole process */
+  lanes: { metadata: LaneGauges; bulk: LaneGauges };
+  /** JS buffers held by native work in flight */
+  pinnedBuffers: number;
+  pinnedBytes: number;
+  /** Keyed by handle type, e.g. `project`, `upload`, `objectIterator` */
+  handles: Record<string, HandleGauges>;
+  /** Collected handles whose native resources the background reaper has yet to free */
+  pendingFrees: number;
+}
+
+/**
+ * Snapshot returned by `Uplink.getMetrics()`
+ */
+export interface MetricsSnapshot {
+  /** Keyed by native operation name, e.g. `uploadWrite`, `statObject` */
+  operations: Record<string, OperationMetrics>;
+  gauges: MetricsGauges;
+  /** Read-ahead decisions since it was enabled, null while disabled; not cleared by `reset` */
+  readAhead: ReadAheadStats | null;
+}
+
+/**
+ * Options for `Uplink.startMetricsReporting()`
+ */
+export interface MetricsReportingOptions extends GetMetricsOptions {
+  /** Time between snapshots (default: 10000) */
+  intervalMs?: number;
+}
+
 // ========== Multipart Upload Types ==========
 
 /**
@@ -269,6 +1837,50 @@ export interface CommitUploadOptions {
   customMetadata?: CustomMetadata;
 }
 
+/**
+ * Options for the native parallel multipart upload engine
+ */
+export interface UploadParallelOptions extends LaneOptions, SignalOptions, ProgressOptions {
+  /** Size of each part in bytes (default 64 MiB; the starting size with `auto`) */
+  partSize?: number;
+  /** Number of parts uploaded at once on native threads (default 4; the ceiling with `auto`, default 16) */
+  concurrency?: number;
+  /** Tune part size and parts in flight to the measured goodput while the upload runs */
+  auto?: boolean;
+  /** Retries per failed part before the upload is aborted (default 3) */
+  retries?: number;
+  /** Memory-map file sources per part (ignored for Buffer sources) */
+  mmap?: boolean;
+  /** When the object should expire */
+  expires?: Date;
+  /** Custom metadata to attach to the object */
+  customMetadata?: CustomMetadata;
+}
+
+/**
+ * Result of `uploadParallel()`
+ */
+export interface UploadParallelResult extends ObjectInfo {
+  /** Chosen parameters, present when `auto` was set */
+  tuning?: TransferTuning;
+}
+
+/**
+ * Options for resuming a pending multipart upload. `partSize` must match
+ * the size the upload was started with, or committed parts are sent again.
+ */
+export type ResumeUploadOptions = Omit<UploadParallelOptions, 'expires' | 'auto'>;
+
+/**
+ * Options for uploading a part from a byte range of a local file
+ */
+export interface UploadPartFromFileOptions extends LaneOptions, SignalOptions, ProgressOptions, RetryableOptions {
+  /** ETag to set on the part before it is committed */
+  etag?: string;
+  /** Memory-map the range instead of reading it */
+  mmap?: boolean;
+}
+
 /**
  * Options for listing uploaded parts
  */
@@ -293,6 +1905,22 @@ export interface ListUploadsOptions {
   recursive?: boolean;
 }
 
+/**
+ * Options for collecting an upload's parts in one native call
+ */
+export interface CollectUploadPartsOptions extends ListUploadPartsOptions, LaneOptions, SignalOptions {
+  /** Stop after this many parts (default: no cap) */
+  maxItems?: number;
+}
+
+/**
+ * Options for collecting pending uploads in one native call
+ */
+export interface CollectUploadsOptions extends ListUploadsOptions, LaneOptions, SignalOptions {
+  /** Stop after this many uploads (default: no cap) */
+  maxItems?: number;
+}
+
 // ========== Edge/Linkshare Types ==========
 
 /**
@@ -334,3 +1962,44 @@ export interface EdgeShareURLOptions {
   /** Serve file directly without landing page */
   raw?: boolean;
 }
+
+/**
+ * Options for enableEdgeCache()
+ */
+export interface EdgeCacheOptions {
+  /** Registrations kept; least recently used ones are evicted (default 256) */
+  maxEntries?: number;
+  /**
+   * How long registered credentials are reused in milliseconds (default
+   * 3600000); keep it below the remaining lifetime of the accesses
+   */
+  ttlMs?: number;
+}
+
+/**
+ * Counters returned by edgeCacheStats()
+ */
+export interface EdgeCacheStats {
+  /** edgeRegisterAccess calls served from the cache */
+  hits: number;
+  /** edgeRegisterAccess calls that went to the auth service */
+  misses: number;
+  /** Registrations dropped to stay under maxEntries */
+  evictions: number;
+  /** Registrations currently cached */
+  entries: number;
+  /** Configured entry limit */
+  maxEntries: number;
+  /** Configured lifetime in milliseconds */
+  ttlMs: number;
+}
+
+/**
+ * One URL to create with edgeJoinShareUrls()
+ */
+export interface EdgeShareURLEntry extends EdgeShareURLOptions {
+  /** Bucket name (empty string to share entire project) */
+  bucket: string;
+  /** Object key or prefix (empty string to share entire bucket) */
+  key: string;
+}
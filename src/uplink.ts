@@ -5,8 +5,32 @@
  * Entry point for all Storj operations.
  */
 
-import type { UplinkConfig, EncryptionKey } from './types';
-import { AccessResultStruct } from './access';
+import type {
+  UplinkConfig,
+  UplinkOptions,
+  EncryptionKey,
+  EncryptionKeyInput,
+  DeriveEncryptionKeysOptions,
+  EncryptionKeyCacheOptions,
+  EncryptionKeyCacheStats,
+  GetMetricsOptions,
+  MetricsSnapshot,
+  MetricsReportingOptions,
+  AccessCacheOptions,
+  AccessCacheStats,
+  ChunkCacheOptions,
+  ChunkCacheStats,
+  ReadAheadOptions,
+  ReadAheadStats,
+  HedgeStats,
+  PassphraseAccessCacheOptions,
+  PassphraseAccessCacheStats,
+  AccessSerializeOptions,
+  SerializedAccess,
+} from './types';
+import { AccessResultStruct, toAccessResult } from './access';
+import { PassphraseAccessCache } from './access/passphrase-cache';
+import { configKey } from './project/pool';
 import { native } from './native';
 
 /** Validation helper for required non-empty string parameters */
@@ -34,6 +58,68 @@ function requireString(value: unknown, name: string): void {
  * ```
  */
 export class Uplink {
+  private _passphraseCache: PassphraseAccessCache | null = null;
+
+  /**
+   * Create an Uplink.
+   *
+   * Uplink calls run on a thread pool owned by the addon, so they do not
+   * tie up libuv's pool used by `fs`, `dns.lookup` and zlib. Metadata
+   * calls and transfers have separate budgets within it. The pool is
+   * process-wide; the most recent configuration applies.
+   * `completionDelayUs` lets finished calls wait briefly so that one
+   * event loop wake-up settles many of them.
+   *
+   * `maxUploadBytesPerSecond` and `maxDownloadBytesPerSecond` cap the
+   * whole process, also process-wide. Projects opened with
+   * `configOpenProject` share them in proportion to `bandwidthWeight`
+   * and may have limits of their own.
+   *
+   * @param options - Optional lane budgets, idle timeout, completion batching and bandwidth limits
+   * @throws TypeError if options is not an object
+   * @throws RangeError if a pool size is outside 0-1024, the idle timeout is negative, the
+   *   completion delay or batch is out of range, or a bandwidth limit is negative
+   *
+   * @example
+   * ```typescript
+   * const uplink = new Uplink({ threadPoolSize: 32 });
+   * ```
+   */
+  constructor(options?: UplinkOptions) {
+    if (options === undefined) {
+      return;
+    }
+    if (options === null || typeof options !== 'object') {
+      throw new TypeError('options must be an object');
+    }
+    const {
+      threadPoolSize,
+      metadataThreadPoolSize,
+      threadPoolIdleTimeoutMs,
+      completionDelayUs,
+      completionBatch,
+    } = options;
+    if (
+      threadPoolSize !== undefined ||
+      metadataThreadPoolSize !== undefined ||
+      threadPoolIdleTimeoutMs !== undefined ||
+      completionDelayUs !== undefined ||
+      completionBatch !== undefined
+    ) {
+      native.configureThreadPool({
+        size: threadPoolSize,
+        metadataSize: metadataThreadPoolSize,
+        idleTimeoutMs: threadPoolIdleTimeoutMs,
+        completionDelayUs,
+        completionBatch,
+      });
+    }
+    const { maxUploadBytesPerSecond, maxDownloadBytesPerSecond } = options;
+    if (maxUploadBytesPerSecond !== undefined || maxDownloadBytesPerSecond !== undefined) {
+      native.configureBandwidth({ maxUploadBytesPerSecond, maxDownloadBytesPerSecond });
+    }
+  }
+
   /**
    * Parse a serialized access grant string.
    *
@@ -52,6 +138,135 @@ export class Uplink {
     return new AccessResultStruct(handle);
   }
 
+  /**
+   * Cache parsed access grants for `parseAccess()`.
+   *
+   * While enabled, parsing a grant seen before resolves at once with an
+   * access sharing the earlier parse, from a bounded LRU keyed by the
+   * serialized grant. The cache belongs to this thread's addon instance
+   * and is shared by all Uplink objects on it; calling again reconfigures
+   * it and clears it. Shared accesses cannot `overrideEncryptionKey()`,
+   * since that would change them for every holder.
+   *
+   * @param options - Entry limit (default 4096)
+   * @throws TypeError if maxEntries is not positive
+   *
+   * @example
+   * ```typescript
+   * uplink.enableAccessCache({ maxEntries: 10000 });
+   * const access = await uplink.parseAccess(req.headers['x-storj-access']);
+   * ```
+   */
+  enableAccessCache(options?: AccessCacheOptions): void {
+    native.enableAccessCache(options);
+  }
+
+  /**
+   * Stop caching parsed grants. Accesses already handed out keep working.
+   */
+  disableAccessCache(): void {
+    native.disableAccessCache();
+  }
+
+  /**
+   * Get the parseAccess cache counters.
+   *
+   * @returns Hit, miss and eviction counts, or null when the cache is disabled
+   */
+  accessCacheStats(): AccessCacheStats | null {
+    return native.accessCacheStats() as AccessCacheStats | null;
+  }
+
+  /**
+   * Cache downloaded chunks on disk for repeated ranged reads.
+   *
+   * `downloadObject()` handles (and the read streams built on them) then
+   * read in fixed-size aligned chunks. Chunks already in the cache are
+   * copied from a memory-mapped cache file; missing ones are downloaded,
+   * stored and handed out, so only those cost egress. Each object version
+   * (bucket, key, `created`, `contentLength`) has its own file, so a
+   * replaced object is never served stale. Processes on a host can share
+   * the directory; the least recently used files are removed once it
+   * grows past `maxBytes`. The cache holds decrypted bytes, so a missing
+   * directory is created with mode 0700 and files with mode 0600; an
+   * existing directory keeps its permissions. Process-wide; calling again
+   * reconfigures it.
+   *
+   * @param options - Directory, disk budget (default 1 GiB) and chunk size (default 1 MiB)
+   * @throws TypeError if the directory is missing or an option is out of range
+   * @throws Error if the directory cannot be created or listed
+   *
+   * @example
+   * ```typescript
+   * uplink.enableChunkCache({ directory: '/var/cache/uplink', maxBytes: 20 * 2 ** 30 });
+   * const download = await project.downloadObject('media', 'movie.mp4', { offset: 2 ** 30, length: 2 ** 20 });
+   * ```
+   */
+  enableChunkCache(options: ChunkCacheOptions): void {
+    if (options === null || typeof options !== 'object') {
+      throw new TypeError('options must be an object');
+    }
+    requireString(options.directory, 'directory');
+    native.enableChunkCache(options);
+  }
+
+  /**
+   * Stop using the chunk cache. Open downloads finish with it; files stay on disk.
+   */
+  disableChunkCache(): void {
+    native.disableChunkCache();
+  }
+
+  /**
+   * Get the chunk cache counters of this process.
+   *
+   * @returns Hit and miss bytes, stores, evictions and disk usage, or null when the cache is disabled
+   */
+  chunkCacheStats(): ChunkCacheStats | null {
+    return native.chunkCacheStats() as ChunkCacheStats | null;
+  }
+
+  /**
+   * Read ahead on downloads according to their access pattern.
+   *
+   * Each `downloadObject()` opened afterwards is compared with where the
+   * last read of the same object stopped. A download that continues there
+   * reads through a window that starts at `initialWindow` and doubles each
+   * time the reader drains it, up to `maxWindow`, so many small reads cost
+   * one native read. Reads at least as large as the window skip it. With
+   * the `adaptive` policy, an object that sees repeated seeks is read
+   * without a window, leaving ranged reads to the chunk cache when it is
+   * on. Process-wide; calling again reconfigures it and forgets history.
+   *
+   * @param options - Policy and window bounds
+   * @throws TypeError for an unknown policy or out-of-range windows
+   *
+   * @example
+   * ```typescript
+   * uplink.enableReadAhead({ maxWindow: 4 * 1024 * 1024 });
+   * const { readsServed, randomOpens } = uplink.readAheadStats()!;
+   * ```
+   */
+  enableReadAhead(options?: ReadAheadOptions): void {
+    native.enableReadAhead(options);
+  }
+
+  /**
+   * Stop reading ahead on new downloads; open downloads keep their windows.
+   */
+  disableReadAhead(): void {
+    native.disableReadAhead();
+  }
+
+  /**
+   * Get the read-ahead decisions and counters of this process.
+   *
+   * @returns Opens per mode, seeks, reads served from windows and bytes prefetched, or null when disabled
+   */
+  readAheadStats(): ReadAheadStats | null {
+    return native.readAheadStats() as ReadAheadStats | null;
+  }
+
   /**
    * Request a new access grant using satellite address, API key, and passphrase.
    *
@@ -60,7 +275,14 @@ export class Uplink {
    *
    * @param satellite - The satellite address (e.g., 'us1.storj.io:7777')
    * @param apiKey - Your API key from the Storj console
+   * With `{ serialize: true }` the grant is also serialized in the same
+   * native call, and `{ serialize: 'only' }` returns just the serialized
+   * grant without creating an access handle.
+   *
+   * @param satellite - The satellite address (e.g., 'us1.storj.io:7777')
+   * @param apiKey - Your API key from the Storj console
    * @param passphrase - Your encryption passphrase (keep this secret!)
+   * @param options - Whether to serialize the new grant
    * @returns Promise resolving to an AccessResultStruct
    *
    * @example
@@ -70,19 +292,47 @@ export class Uplink {
    *   'your-api-key',
    *   'your-secret-passphrase'
    * );
+   *
+   * const grant = await uplink.requestAccessWithPassphrase(
+   *   'us1.storj.io:7777',
+   *   'your-api-key',
+   *   'your-secret-passphrase',
+   *   { serialize: 'only' }
+   * );
    * ```
    */
+  requestAccessWithPassphrase(satellite: string, apiKey: string, passphrase: string): Promise<AccessResultStruct>;
+  requestAccessWithPassphrase(
+    satellite: string,
+    apiKey: string,
+    passphrase: string,
+    options: { serialize: true }
+  ): Promise<SerializedAccess>;
+  requestAccessWithPassphrase(
+    satellite: string,
+    apiKey: string,
+    passphrase: string,
+    options: { serialize: 'only' }
+  ): Promise<string>;
+  requestAccessWithPassphrase(
+    satellite: string,
+    apiKey: string,
+    passphrase: string,
+    options?: AccessSerializeOptions
+  ): Promise<AccessResultStruct | SerializedAccess | string>;
   async requestAccessWithPassphrase(
     satellite: string,
     apiKey: string,
-    passphrase: string
-  ): Promise<AccessResultStruct> {
+    passphrase: string,
+    options?: AccessSerializeOptions
+  ): Promise<AccessResultStruct | SerializedAccess | string> {
     requireString(satellite, 'satellite');
     requireString(apiKey, 'apiKey');
     requireString(passphrase, 'passphrase');
 
-    const handle = await native.requestAccessWithPassphrase(satellite, apiKey, passphrase);
-    return new AccessResultStruct(handle);
+    return this.cachedAccess([satellite, apiKey, passphrase, ''], options?.serialize, (nativeOptions) =>
+      native.requestAccessWithPassphrase(satellite, apiKey, passphrase, nativeOptions)
+    );
   }
 
   /**
@@ -92,6 +342,8 @@ export class Uplink {
    * @param satellite - The satellite address
    * @param apiKey - Your API key
    * @param passphrase - Your encryption passphrase
+   * @param options - Whether to serialize the new grant, as for
+   *   `requestAccessWithPassphrase()`
    * @returns Promise resolving to an AccessResultStruct
    *
    * @example
@@ -104,12 +356,40 @@ export class Uplink {
    * );
    * ```
    */
-  async configRequestAccessWithPassphrase(
+  configRequestAccessWithPassphrase(
     config: UplinkConfig,
     satellite: string,
     apiKey: string,
     passphrase: string
-  ): Promise<AccessResultStruct> {
+  ): Promise<AccessResultStruct>;
+  configRequestAccessWithPassphrase(
+    config: UplinkConfig,
+    satellite: string,
+    apiKey: string,
+    passphrase: string,
+    options: { serialize: true }
+  ): Promise<SerializedAccess>;
+  configRequestAccessWithPassphrase(
+    config: UplinkConfig,
+    satellite: string,
+    apiKey: string,
+    passphrase: string,
+    options: { serialize: 'only' }
+  ): Promise<string>;
+  configRequestAccessWithPassphrase(
+    config: UplinkConfig,
+    satellite: string,
+    apiKey: string,
+    passphrase: string,
+    options?: AccessSerializeOptions
+  ): Promise<AccessResultStruct | SerializedAccess | string>;
+  async configRequestAccessWithPassphrase(
+    config: UplinkConfig,
+    satellite: string,
+    apiKey: string,
+    passphrase: string,
+    options?: AccessSerializeOptions
+  ): Promise<AccessResultStruct | SerializedAccess | string> {
     if (config == null || typeof config !== 'object') {
       throw new TypeError('config must be an object');
     }
@@ -117,13 +397,93 @@ export class Uplink {
     requireString(apiKey, 'apiKey');
     requireString(passphrase, 'passphrase');
 
-    const handle = await native.configRequestAccessWithPassphrase(
-      config,
-      satellite,
-      apiKey,
-      passphrase
+    return this.cachedAccess(
+      [satellite, apiKey, passphrase, configKey(config)],
+      options?.serialize,
+      (nativeOptions) =>
+        native.configRequestAccessWithPassphrase(config, satellite, apiKey, passphrase, nativeOptions)
     );
-    return new AccessResultStruct(handle);
+  }
+
+  /**
+   * Cache grants from `requestAccessWithPassphrase()` and
+   * `configRequestAccessWithPassphrase()`.
+   *
+   * While enabled, a request with the same satellite, API key, passphrase
+   * and config parses the grant serialized on the first request instead
+   * of dialing the satellite and deriving keys again. Entries are keyed
+   * by an HMAC of the inputs, bounded by `maxEntries` and `ttlMs`. With
+   * `file` and `fileKey`, grants are also kept in that file, encrypted
+   * with AES-256-GCM, so a restarted worker skips the derivation too.
+   * Anyone holding `fileKey` and the file can read the grants.
+   *
+   * The cache belongs to this Uplink; calling again replaces it.
+   *
+   * @param options - Entry limit (default 256), time to live (default 1 hour), and optional file
+   * @throws TypeError if a bound is invalid, or `file` is set without a 32-byte `fileKey`
+   *
+   * @example
+   * ```typescript
+   * uplink.enablePassphraseAccessCache({
+   *   file: '/var/cache/app/access.bin',
+   *   fileKey: Buffer.from(process.env.ACCESS_CACHE_KEY!, 'hex'),
+   * });
+   * ```
+   */
+  enablePassphraseAccessCache(options?: PassphraseAccessCacheOptions): void {
+    this._passphraseCache = new PassphraseAccessCache(options);
+  }
+
+  /**
+   * Stop caching passphrase grants. A cache file is left in place.
+   */
+  disablePassphraseAccessCache(): void {
+    this._passphraseCache = null;
+  }
+
+  /**
+   * Get the passphrase grant cache counters.
+   *
+   * @returns Hit, miss, eviction, expiry and file error counts, or null when the cache is disabled
+   */
+  passphraseAccessCacheStats(): PassphraseAccessCacheStats | null {
+    return this._passphraseCache?.stats() ?? null;
+  }
+
+  /** Serve a passphrase request from the cache, or make it and cache the grant */
+  private async cachedAccess(
+    parts: string[],
+    serialize: AccessSerializeOptions['serialize'],
+    request: (options?: AccessSerializeOptions) => Promise<unknown>
+  ): Promise<AccessResultStruct | SerializedAccess | string> {
+    const cache = this._passphraseCache;
+    if (cache === null) {
+      return toAccessResult(await request(serialize ? { serialize } : undefined), serialize);
+    }
+
+    const tag = cache.tag(parts);
+    const cached = await cache.get(tag);
+    if (cached !== undefined) {
+      if (serialize === 'only') {
+        return cached;
+      }
+      try {
+        const access = new AccessResultStruct(await native.parseAccess(cached));
+        return serialize ? { access, serialized: cached } : access;
+      } catch {
+        await cache.delete(tag);
+      }
+    }
+
+    // The grant to cache is serialized by the request itself
+    if (serialize === 'only') {
+      const serialized = (await request({ serialize: 'only' })) as string;
+      await cache.set(tag, serialized);
+      return serialized;
+    }
+    const result = toAccessResult(await request({ serialize: true }), true) as SerializedAccess;
+    await cache.set(tag, result.serialized);
+    return serialize ? result : result.access;
   }
 
   /**
@@ -152,4 +512,152 @@ export class Uplink {
     const handle = await native.deriveEncryptionKey(passphrase, salt);
     return { _handle: handle as number };
   }
+
+  /**
+   * Derive many encryption keys in one call.
+   *
+   * Keys are derived on at most `concurrency` native threads while the
+   * call takes a single slot of the addon's bulk lane, so a tenant
+   * warm-up does not occupy the whole pool. With the key cache enabled,
+   * cached pairs and repeats within the call are not derived again.
+   *
+   * @param items - Passphrase and salt pairs
+   * @param options - Derivation concurrency (default 4, at most 16)
+   * @returns Promise resolving to the keys, in item order
+   * @throws TypeError if an item has no passphrase or its salt is not a Buffer
+   *
+   * @example
+   * ```typescript
+   * const keys = await uplink.deriveEncryptionKeys(
+   *   tenants.map((t) => ({ passphrase: t.passphrase, salt: Buffer.from(t.id) }))
+   * );
+   * ```
+   */
+  async deriveEncryptionKeys(
+    items: EncryptionKeyInput[],
+    options?: DeriveEncryptionKeysOptions
+  ): Promise<EncryptionKey[]> {
+    if (!Array.isArray(items)) {
+      throw new TypeError('items must be an array');
+    }
+    for (const item of items) {
+      requireString(item?.passphrase, 'passphrase');
+      if (!Buffer.isBuffer(item.salt)) {
+        throw new TypeError('salt must be a Buffer');
+      }
+    }
+
+    const handles = await native.deriveEncryptionKeys(items, options);
+    return handles.map((handle) => ({ _handle: handle as number }));
+  }
+
+  /**
+   * Cache keys derived by `uplinkDeriveEncryptionKey()` and
+   * `deriveEncryptionKeys()`.
+   *
+   * Entries are keyed by an HMAC of the passphrase and salt under a
+   * random per-process key, so neither is kept in memory. A key expires
+   * `ttlMs` after derivation. The cache belongs to this thread's addon
+   * instance; calling again reconfigures and clears it.
+   *
+   * @param options - Entry limit (default 1024) and time to live (default 15 minutes)
+   * @throws TypeError if maxEntries is not positive or ttlMs is negative
+   */
+  enableEncryptionKeyCache(options?: EncryptionKeyCacheOptions): void {
+    native.enableEncryptionKeyCache(options);
+  }
+
+  /**
+   * Stop caching derived keys. Keys already handed out keep working.
+   */
+  disableEncryptionKeyCache(): void {
+    native.disableEncryptionKeyCache();
+  }
+
+  /**
+   * Get the derived key cache counters.
+   *
+   * @returns Hit, miss, eviction and expiry counts, or null when the cache is disabled
+   */
+  encryptionKeyCacheStats(): EncryptionKeyCacheStats | null {
+    return native.encryptionKeyCacheStats() as EncryptionKeyCacheStats | null;
+  }
+
+  /**
+   * Snapshot the latency histograms and live gauges of native operations.
+   *
+   * Every call run on the addon thread pool is timed under its native
+   * operation name, split into time queued, time executing natively and
+   * time converting the result on the JS thread; transfer calls also
+   * count bytes. The counters belong to this thread's addon instance and
+   * are shared by all Uplink objects on it. Taking a snapshot is cheap
+   * enough to scrape on every Prometheus pull.
+   *
+   * `gauges` tells a saturated queue from a slow satellite: pool threads
+   * and queued or running jobs per lane, JS buffers pinned by native work,
+   * and open handles per type with how many were closed explicitly versus
+   * freed by the garbage collector (a growing `finalizerFrees` means a
+   * missing close). Collected handles are released on a background thread;
+   * `pendingFrees` counts those it has not reached yet. `readAhead` holds
+   * the read-ahead policy's decisions, as from `readAheadStats()`.
+   *
+   * @param options - Include buckets, or reset the operations after the
+   *   snapshot
+   * @returns The operations seen since start or the last reset, the
+   *   current gauges and the read-ahead counters
+   *
+   * @example
+   * ```typescript
+   * const { operations } = uplink.getMetrics();
+   * console.log(operations.uploadWrite?.execute.p99Ms);
+   * ```
+   */
+  getMetrics(options?: GetMetricsOptions): MetricsSnapshot {
+    return native.getMetrics(options) as MetricsSnapshot;
+  }
+
+  /**
+   * Get the hedging counters of this process.
+   *
+   * Compare `backupWins` with `hedged` to tune `hedge.percentile`: a
+   * backup that rarely wins means the delay is too short.
+   *
+   * @returns Requests that started a duplicate, and how many the duplicate won
+   */
+  hedgeStats(): HedgeStats {
+    return native.hedgeStats() as HedgeStats;
+  }
+
+  /**
+   * Push a metrics snapshot to @p callback every `intervalMs`.
+   *
+   * The timer is unref'd, so it does not keep the process alive. A
+   * callback that throws does not stop later reports.
+   *
+   * @param callback - Receives each snapshot
+   * @param options - `getMetrics()` options and the interval
+   * @returns A function that stops reporting
+   * @throws TypeError if callback is not a function or intervalMs is not positive
+   */
+  startMetricsReporting(
+    callback: (snapshot: MetricsSnapshot) => void,
+    options: MetricsReportingOptions = {}
+  ): () => void {
+    const { intervalMs = 10000, ...metricsOptions } = options;
+    if (typeof callback !== 'function') {
+      throw new TypeError('callback must be a function');
+    }
+    if (!(intervalMs > 0)) {
+      throw new TypeError('intervalMs must be positive');
+    }
+    const timer = setInterval(() => {
+      try {
+        callback(this.getMetrics(metricsOptions));
+      } catch {
+        // A failing reporter must not take the timer down with it
+      }
+    }, intervalMs);
+    timer.unref();
+    return () => clearInterval(timer);
+  }
 }
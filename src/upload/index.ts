@@ -7,6 +7,7 @@
 
 import type { ObjectInfo, CustomMetadata } from '../types';
 import { native } from '../native';
+import { packMetadata } from '../native/metadata';
 
 /** Native handle type */
 type UploadHandle = unknown;
@@ -72,7 +73,10 @@ export class UploadResultStruct {
   /**
    * Write data to the upload.
    *
-   * Can be called multiple times to upload data in chunks.
+   * Can be called multiple times to upload data in chunks. Writes, like
+   * `setCustomMetadata()` and `commit()`, run natively in call order, so
+   * they need not be awaited one by one; the buffer must then stay
+   * unmodified until the write settles (see `UploadOptions.maxQueuedBytes`).
    *
    * @param buffer - Data buffer to write
    * @param length - Optional number of bytes to write (defaults to buffer length)
@@ -109,6 +113,39 @@ export class UploadResultStruct {
     return bytesWritten as number;
   }
 
+  /**
+   * Write several buffers to the upload in one native call.
+   *
+   * All buffers are written back to back on a single worker thread,
+   * so a batch of small chunks costs one thread hop and one promise
+   * instead of one per chunk.
+   *
+   * @param buffers - Data buffers to write, in order
+   * @returns Promise resolving to the total number of bytes written
+   * @throws TypeError if buffers is not an array of Buffers
+   * @throws Error if upload is finalized
+   *
+   * @example
+   * ```typescript
+   * const upload = await project.uploadObject('my-bucket', 'file.txt');
+   * await upload.writev([Buffer.from('Hello, '), Buffer.from('World!')]);
+   * await upload.commit();
+   * ```
+   */
+  async writev(buffers: Buffer[]): Promise<number> {
+    this.validateActive();
+
+    if (!Array.isArray(buffers)) {
+      throw new TypeError('buffers must be an array of Buffers');
+    }
+    for (const buffer of buffers) {
+      this.validateBuffer(buffer);
+    }
+
+    const bytesWritten = await native.uploadWritev(this._handle, buffers);
+    return bytesWritten as number;
+  }
+
   /**
    * Set custom metadata on the upload.
    *
@@ -138,14 +175,8 @@ export class UploadResultStruct {
       throw new TypeError('customMetadata must be an object');
     }
 
-    // Validate all values are strings
-    for (const [key, value] of Object.entries(customMetadata)) {
-      if (typeof key !== 'string' || typeof value !== 'string') {
-        throw new TypeError('All metadata keys and values must be strings');
-      }
-    }
-
-    return native.uploadSetCustomMetadata(this._handle, customMetadata);
+    const packed = packMetadata(customMetadata, 'All metadata keys and values must be strings');
+    return native.uploadSetCustomMetadata(this._handle, packed);
   }
 
   /**
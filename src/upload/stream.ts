@@ -0,0 +1,228 @@
+/**
+ * @file upload/stream.ts
+ * @brief Writable stream over a Storj upload
+ *
+ * Provides UploadWriteStream, returned by `ProjectResultStruct.createWriteStream()`.
+ */
+
+import { Writable } from 'stream';
+import type { WriteStreamOptions } from '../types';
+import { UploadResultStruct } from './index';
+import { native } from '../native';
+import { validateTimeout } from '../native/cancel';
+import { ProgressMeter } from '../native/progress';
+
+/** Default number of native writes queued ahead of the producer */
+const DEFAULT_MAX_IN_FLIGHT = 4;
+
+/** Default stream buffer size (4 MiB) */
+const DEFAULT_HIGH_WATER_MARK = 4 * 1024 * 1024;
+
+/**
+ * Writable stream that pipelines writes into an upload.
+ *
+ * Each write (or batch of buffered writes, via `writev()`) is queued
+ * behind the previous one, so bytes reach uplink in order, and the
+ * producer is released as soon as it is queued while fewer than
+ * `maxInFlight` writes are pending. Beyond that, and beyond
+ * `highWaterMark` buffered bytes, the stream applies backpressure.
+ * `end()` commits the upload; `destroy()`, or aborting `options.signal`,
+ * aborts it. `options.timeoutMs` bounds starting the upload.
+ * `options.onProgress` is called as writes complete, coalesced like the
+ * native engines; the final call comes after the commit.
+ *
+ * @example
+ * ```typescript
+ * const stream = project.createWriteStream('my-bucket', 'video.mp4');
+ * req.pipe(stream).on('finish', () => console.log('committed'));
+ * ```
+ */
+export class UploadWriteStream extends Writable {
+  private readonly _projectHandle: unknown;
+  private readonly _bucket: string;
+  private readonly _key: string;
+  private readonly _options: WriteStreamOptions;
+  private readonly _maxInFlight: number;
+  private _upload: UploadResultStruct | null = null;
+  private _queue: Buffer[][] = [];
+  private _writing: boolean = false;
+  private _idle: Array<() => void> = [];
+  private _inFlight: number = 0;
+  private _held: Array<() => void> = [];
+  private _failure: Error | null = null;
+  private readonly _progress: ProgressMeter | null;
+
+  /**
+   * Creates a new UploadWriteStream. The upload is started lazily.
+   *
+   * @param projectHandle - Native project handle
+   * @param bucket - Bucket name
+   * @param key - Object key
+   * @param options - Upload, pipelining, and buffering options
+   * @internal
+   */
+  constructor(projectHandle: unknown, bucket: string, key: string, options: WriteStreamOptions = {}) {
+    const maxInFlight = options.maxInFlight ?? DEFAULT_MAX_IN_FLIGHT;
+    if (!Number.isInteger(maxInFlight) || maxInFlight < 1) {
+      throw new TypeError('maxInFlight must be a positive integer');
+    }
+    validateTimeout(options.timeoutMs);
+    const progress = ProgressMeter.from(options);
+
+    super({ highWaterMark: options.highWaterMark ?? DEFAULT_HIGH_WATER_MARK, signal: options.signal });
+    this._projectHandle = projectHandle;
+    this._bucket = bucket;
+    this._key = key;
+    this._options = options;
+    this._maxInFlight = maxInFlight;
+    this._progress = progress;
+  }
+
+  /** @internal */
+  override _construct(callback: (error?: Error | null) => void): void {
+    const { expires, writeBufferSize, checksum, compress, customMetadata, timeoutMs } = this._options;
+    native
+      .uploadObject(this._projectHandle, this._bucket, this._key, { expires, writeBufferSize, checksum, compress, timeoutMs })
+      .then(async (handle) => {
+        this._upload = new UploadResultStruct(handle);
+        if (customMetadata) {
+          await this._upload.setCustomMetadata(customMetadata);
+        }
+      })
+      .then(
+        () => callback(),
+        (err: Error) => callback(err)
+      );
+  }
+
+  /** @internal */
+  override _write(chunk: Buffer, _encoding: BufferEncoding, callback: (error?: Error | null) => void): void {
+    this._enqueue([chunk], callback);
+  }
+
+  /** @internal */
+  override _writev(
+    chunks: Array<{ chunk: Buffer; encoding: BufferEncoding }>,
+    callback: (error?: Error | null) => void
+  ): void {
+    this._enqueue(
+      chunks.map((c) => c.chunk),
+      callback
+    );
+  }
+
+  /** @internal */
+  override _final(callback: (error?: Error | null) => void): void {
+    this._whenIdle()
+      .then(() => {
+        if (this._failure) {
+          throw this._failure;
+        }
+        return (this._upload as UploadResultStruct).commit();
+      })
+      .then(
+        () => {
+          this._progress?.finish();
+          callback();
+        },
+        (err: Error) => callback(err)
+      );
+  }
+
+  /** @internal */
+  override _destroy(error: Error | null, callback: (error?: Error | null) => void): void {
+    const upload = this._upload;
+    this._held.splice(0).forEach((release) => release());
+    if (upload === null) {
+      callback(error);
+      return;
+    }
+    this._whenIdle()
+      .then(() => (upload.isActive ? upload.abort() : undefined))
+      .then(
+        () => callback(error),
+        () => callback(error)
+      );
+  }
+
+  /**
+   * Queue a native write behind the previous one. The producer's callback
+   * runs immediately while the pipeline has room, or when a write ahead of
+   * it completes.
+   */
+  private _enqueue(buffers: Buffer[], callback: (error?: Error | null) => void): void {
+    if (this._failure) {
+      callback(this._failure);
+      return;
+    }
+
+    this._inFlight++;
+    this._queue.push(buffers);
+    if (!this._writing) {
+      this._next();
+    }
+
+    if (this._inFlight <= this._maxInFlight) {
+      callback();
+    } else {
+      this._held.push(() => callback(this._failure));
+    }
+  }
+
+  /**
+   * Write the oldest queued batch, then the next, until the queue is empty.
+   * Writes go through the callback-style native writev, which settles
+   * without a promise per batch.
+   */
+  private _next(): void {
+    const buffers = this._queue.shift();
+    if (buffers === undefined) {
+      this._writing = false;
+      this._idle.splice(0).forEach((resolve) => resolve());
+      return;
+    }
+    this._writing = true;
+
+    const upload = this._upload as UploadResultStruct;
+    if (this._failure !== null || this.destroyed) {
+      this._written();
+      return;
+    }
+    try {
+      native.uploadWritevCb(upload._nativeHandle, buffers, (err, bytesWritten) => {
+        if (err !== null) {
+          this._fail(err);
+        } else {
+          this._progress?.add(bytesWritten);
+        }
+        this._written();
+      });
+    } catch (err) {
+      this._fail(err as Error);
+      this._written();
+    }
+  }
+
+  /** Account for a finished write and start the next one */
+  private _written(): void {
+    this._inFlight--;
+    const release = this._held.shift();
+    if (release) {
+      release();
+    }
+    this._next();
+  }
+
+  private _fail(err: Error): void {
+    this._failure = this._failure ?? err;
+    this.destroy(err);
+  }
+
+  /** Resolve once every queued write has returned */
+  private _whenIdle(): Promise<void> {
+    if (!this._writing) {
+      return Promise.resolve();
+    }
+    return new Promise((resolve) => this._idle.push(resolve));
+  }
+}
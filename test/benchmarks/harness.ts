@@ -0,0 +1,71 @@
+/**
+ * @file test/benchmarks/harness.ts
+ * @brief Timing and reporting helpers for the offline benchmark suite
+ *
+ * Benchmarks run against the in-memory fake libuplink (native/fake), so
+ * the numbers are binding overhead plus whatever latency and bandwidth
+ * the fake is told to inject, never network variance. Run them through
+ * `npm run bench`, which builds the fake and preloads it.
+ */
+
+import { Uplink, ProjectResultStruct } from '../../src';
+
+export const BENCH_BUCKET = 'bench';
+
+/** One result row */
+export interface BenchResult {
+  name: string;
+  /** Operations, or bytes for throughput rows */
+  ops: number;
+  seconds: number;
+  unit: 'ops/s' | 'MB/s';
+}
+
+/** Open a project on the fake and make sure the bench bucket exists */
+export async function openBenchProject(): Promise<ProjectResultStruct> {
+  const uplink = new Uplink();
+  const access = await uplink.parseAccess('fake:bench.satellite:7777');
+  const project = await access.openProject();
+  await project.ensureBucket(BENCH_BUCKET);
+  return project;
+}
+
+/**
+ * Run @p fn until it has taken at least @p minSeconds, after one warmup
+ * call, and report how often it ran.
+ *
+ * @param fn - Returns how many operations (or bytes) one call did
+ */
+export async function measure(
+  name: string,
+  unit: BenchResult['unit'],
+  fn: () => Promise<number>,
+  minSeconds: number = Number(process.env.BENCH_SECONDS ?? 2)
+): Promise<BenchResult> {
+  await fn();
+  let ops = 0;
+  const start = process.hrtime.bigint();
+  let seconds = 0;
+  do {
+    ops += await fn();
+    seconds = Number(process.hrtime.bigint() - start) / 1e9;
+  } while (seconds < minSeconds);
+  return { name, ops, seconds, unit };
+}
+
+/** Print results as an aligned table, or JSON with BENCH_JSON=1 */
+export function report(results: readonly BenchResult[]): void {
+  if (process.env.BENCH_JSON === '1') {
+    console.log(JSON.stringify(results.map((r) => ({ ...r, rate: rate(r) }))));
+    return;
+  }
+  const width = Math.max(...results.map((r) => r.name.length));
+  for (const result of results) {
+    console.log(`${result.name.padEnd(width)}  ${rate(result).toFixed(1).padStart(12)} ${result.unit}`);
+  }
+}
+
+function rate(result: BenchResult): number {
+  const perSecond = result.ops / result.seconds;
+  return result.unit === 'MB/s' ? perSecond / 1e6 : perSecond;
+}
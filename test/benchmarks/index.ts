@@ -0,0 +1,40 @@
+/**
+ * @file test/benchmarks/index.ts
+ * @brief Entry point of `npm run bench`
+ *
+ * Usage: npm run bench [-- transfer|metadata]
+ */
+
+import { openBenchProject, report, BenchResult } from './harness';
+import { benchTransfer } from './transfer.bench';
+import { benchMetadata } from './metadata.bench';
+
+const SUITES: Record<string, typeof benchTransfer> = {
+  transfer: benchTransfer,
+  metadata: benchMetadata,
+};
+
+async function main(): Promise<void> {
+  const selected = process.argv.slice(2);
+  const unknown = selected.filter((name) => !(name in SUITES));
+  if (unknown.length > 0) {
+    throw new Error(`unknown suite ${unknown.join(', ')}; expected ${Object.keys(SUITES).join(', ')}`);
+  }
+  const project = await openBenchProject();
+  const results: BenchResult[] = [];
+  try {
+    for (const [name, suite] of Object.entries(SUITES)) {
+      if (selected.length === 0 || selected.includes(name)) {
+        results.push(...(await suite(project)));
+      }
+    }
+  } finally {
+    await project.close();
+  }
+  report(results);
+}
+
+main().catch((err: unknown) => {
+  console.error(err);
+  process.exit(1);
+});
@@ -0,0 +1,65 @@
+/**
+ * @file test/benchmarks/metadata.bench.ts
+ * @brief Listing rate and stat ops/sec
+ */
+
+import { ProjectResultStruct } from '../../src';
+import { BENCH_BUCKET, BenchResult, measure } from './harness';
+
+const OBJECT_COUNT = 5000;
+const STAT_CONCURRENCY = 64;
+
+export async function benchMetadata(project: ProjectResultStruct): Promise<BenchResult[]> {
+  const keys = Array.from({ length: OBJECT_COUNT }, (_, i) => `list/${String(i).padStart(6, '0')}`);
+  const empty = Buffer.alloc(0);
+  for (let i = 0; i < keys.length; i += 256) {
+    await Promise.all(keys.slice(i, i + 256).map((key) => project.putObject(BENCH_BUCKET, key, empty)));
+  }
+
+  const results: BenchResult[] = [];
+  results.push(
+    await measure(`listObjects ${OBJECT_COUNT} keys (items)`, 'ops/s', async () => {
+      const objects = await project.listObjects(BENCH_BUCKET, { prefix: 'list/', recursive: true });
+      return objects.length;
+    })
+  );
+  results.push(
+    await measure(`iterateObjects ${OBJECT_COUNT} keys (items)`, 'ops/s', async () => {
+      let count = 0;
+      for await (const _ of project.iterateObjects(BENCH_BUCKET, { prefix: 'list/', recursive: true })) {
+        count++;
+      }
+      return count;
+    })
+  );
+  results.push(
+    await measure(`iterateObjectColumns ${OBJECT_COUNT} keys (items)`, 'ops/s', async () => {
+      let count = 0;
+      for await (const page of project.iterateObjectColumns(BENCH_BUCKET, { prefix: 'list/', recursive: true })) {
+        count += page.count;
+      }
+      return count;
+    })
+  );
+  results.push(
+    await measure('statObject, one at a time', 'ops/s', async () => {
+      for (let i = 0; i < 100; i++) {
+        await project.statObject(BENCH_BUCKET, keys[i]!);
+      }
+      return 100;
+    })
+  );
+  results.push(
+    await measure(`statObject, ${STAT_CONCURRENCY} in flight`, 'ops/s', async () => {
+      await Promise.all(keys.slice(0, STAT_CONCURRENCY * 4).map((key) => project.statObject(BENCH_BUCKET, key)));
+      return STAT_CONCURRENCY * 4;
+    })
+  );
+  results.push(
+    await measure('statObjects batch of 1000', 'ops/s', async () => {
+      await project.statObjects(BENCH_BUCKET, keys.slice(0, 1000));
+      return 1000;
+    })
+  );
+  return results;
+}
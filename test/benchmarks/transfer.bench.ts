@@ -0,0 +1,64 @@
+/**
+ * @file test/benchmarks/transfer.bench.ts
+ * @brief Upload and download throughput against chunk size
+ */
+
+import { ProjectResultStruct } from '../../src';
+import { BENCH_BUCKET, BenchResult, measure } from './harness';
+
+const OBJECT_SIZE = 16 * 1024 * 1024;
+const CHUNK_SIZES = [4 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024, 4 * 1024 * 1024];
+
+function label(bytes: number): string {
+  return bytes >= 1024 * 1024 ? `${bytes / (1024 * 1024)}MiB` : `${bytes / 1024}KiB`;
+}
+
+export async function benchTransfer(project: ProjectResultStruct): Promise<BenchResult[]> {
+  const results: BenchResult[] = [];
+  const data = Buffer.alloc(OBJECT_SIZE, 7);
+
+  for (const chunk of CHUNK_SIZES) {
+    results.push(
+      await measure(`upload ${label(OBJECT_SIZE)} in ${label(chunk)} writes`, 'MB/s', async () => {
+        const upload = await project.uploadObject(BENCH_BUCKET, 'transfer/object');
+        for (let offset = 0; offset < OBJECT_SIZE; offset += chunk) {
+          const slice = data.subarray(offset, offset + chunk);
+          await upload.write(slice, slice.length);
+        }
+        await upload.commit();
+        return OBJECT_SIZE;
+      })
+    );
+  }
+
+  const buffer = Buffer.alloc(CHUNK_SIZES[CHUNK_SIZES.length - 1]!);
+  for (const chunk of CHUNK_SIZES) {
+    results.push(
+      await measure(`download ${label(OBJECT_SIZE)} in ${label(chunk)} reads`, 'MB/s', async () => {
+        const download = await project.downloadObject(BENCH_BUCKET, 'transfer/object');
+        let total = 0;
+        for (;;) {
+          const { bytesRead, eof } = await download.read(buffer, chunk, { eofAsValue: true });
+          total += bytesRead;
+          if (eof) break;
+        }
+        await download.close();
+        return total;
+      })
+    );
+  }
+
+  results.push(
+    await measure(`putObject ${label(OBJECT_SIZE)}`, 'MB/s', async () => {
+      await project.putObject(BENCH_BUCKET, 'transfer/put', data);
+      return OBJECT_SIZE;
+    })
+  );
+  results.push(
+    await measure(`getObject ${label(OBJECT_SIZE)}`, 'MB/s', async () => {
+      const { data: body } = await project.getObject(BENCH_BUCKET, 'transfer/put');
+      return body.length;
+    })
+  );
+  return results;
+}
@@ -34,6 +34,9 @@ import {
     // Edge errors
     EdgeAuthDialFailedError,
     EdgeRegisterAccessFailedError,
+    TimeoutError,
+    IntegrityError,
+    CompressedObjectError,
     
     // Factory functions
     createStorjError,
@@ -65,6 +68,9 @@ describe('Error Handling Module', () => {
             
             expect(ErrorCodes.EDGE_AUTH_DIAL_FAILED).toBe(0x30);
             expect(ErrorCodes.EDGE_REGISTER_ACCESS_FAILED).toBe(0x31);
+            
+            expect(ErrorCodes.TIMEOUT).toBe(0x40);
+            expect(ErrorCodes.INTEGRITY).toBe(0x41);
         });
     });
 
@@ -199,6 +205,26 @@ describe('Error Handling Module', () => {
                 expect(error.code).toBe(ErrorCodes.EDGE_REGISTER_ACCESS_FAILED);
             });
         });
+
+        describe('Binding errors', () => {
+            it('should create TimeoutError', () => {
+                const error = new TimeoutError();
+                expect(error).toBeInstanceOf(TimeoutError);
+                expect(error.code).toBe(ErrorCodes.TIMEOUT);
+            });
+
+            it('should create IntegrityError', () => {
+                const error = new IntegrityError();
+                expect(error).toBeInstanceOf(IntegrityError);
+                expect(error.code).toBe(ErrorCodes.INTEGRITY);
+            });
+
+            it('should create CompressedObjectError', () => {
+                const error = new CompressedObjectError();
+                expect(error).toBeInstanceOf(CompressedObjectError);
+                expect(error.code).toBe(ErrorCodes.COMPRESSED_OBJECT);
+            });
+        });
     });
 
     describe('createStorjError factory', () => {
@@ -223,6 +249,10 @@ describe('Error Handling Module', () => {
             
             expect(createStorjError(ErrorCodes.EDGE_AUTH_DIAL_FAILED)).toBeInstanceOf(EdgeAuthDialFailedError);
             expect(createStorjError(ErrorCodes.EDGE_REGISTER_ACCESS_FAILED)).toBeInstanceOf(EdgeRegisterAccessFailedError);
+            
+            expect(createStorjError(ErrorCodes.TIMEOUT)).toBeInstanceOf(TimeoutError);
+            expect(createStorjError(ErrorCodes.INTEGRITY)).toBeInstanceOf(IntegrityError);
+            expect(createStorjError(ErrorCodes.COMPRESSED_OBJECT)).toBeInstanceOf(CompressedObjectError);
         });
 
         it('should return InternalError for unknown codes', () => {
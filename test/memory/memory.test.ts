@@ -3,7 +3,8 @@
  * @brief Comprehensive memory leak detection tests
  *
  * Each function is tested INDIVIDUALLY with configurable iterations to ensure
- * no memory growth. Functions are NOT tested collectively to produce
+ * no memory growth, both in the V8 heap and in the addon's own native
+ * allocations (nativeStats()). Functions are NOT tested collectively to produce
  * accurate, isolated results per function.
  *
  * Run with: npm run test:memory
@@ -16,7 +17,7 @@
 
 import * as fs from 'fs';
 import * as path from 'path';
-import { Uplink, AccessResultStruct } from '../../src';
+import { Uplink, AccessResultStruct, nativeStats } from '../../src';
 
 // ============================================================================
 // Configuration
@@ -24,6 +25,7 @@ import { Uplink, AccessResultStruct } from '../../src';
 
 const ITERATIONS = 3000;
 const ALLOWED_GROWTH_MB = 50; // Max allowed heap growth across 3000 iterations
+const ALLOWED_NATIVE_BYTES_PER_OP = 16; // Below the smallest malloc block, so one leaked block per iteration fails
 const GC_SETTLE_MS = 200; // Time to allow GC to settle
 const TEST_DESC = `should not leak memory after ${ITERATIONS} iterations`;
 
@@ -133,13 +135,14 @@ function writeMemoryCSV(
 /**
  * Run a memory test for a single function in isolation.
  * Warmup phase + measured phase with 100 iterations.
- * Writes per-iteration heap snapshots to CSV for graphing.
+ * Writes per-iteration heap snapshots to CSV for graphing. Native growth
+ * is the addon's live malloc'd bytes after minus before, per iteration.
  */
 async function measureMemoryGrowth(
   name: string,
   fn: (iteration: number) => Promise<void>,
   iterations: number = ITERATIONS
-): Promise<{ baselineMB: number; finalMB: number; growthMB: number }> {
+): Promise<{ baselineMB: number; finalMB: number; growthMB: number; nativeBytesPerOp: number }> {
   // Warmup: run a few iterations to stabilize JIT and caches
   for (let i = 0; i < 10; i++) {
     await fn(i);
@@ -147,6 +150,7 @@ async function measureMemoryGrowth(
 
   await settleMemory();
   const baselineMB = getHeapUsedMB();
+  const nativeBaseline = (await nativeStats()).liveBytes;
 
   // Collect per-iteration memory snapshots
   const snapshots: Array<{ iteration: number; heapUsedMB: number }> = [];
@@ -170,17 +174,19 @@ async function measureMemoryGrowth(
   await settleMemory();
   const finalMB = getHeapUsedMB();
   const growthMB = finalMB - baselineMB;
+  const nativeBytesPerOp = ((await nativeStats()).liveBytes - nativeBaseline) / iterations;
 
   // Write CSV for graphing
   writeMemoryCSV(name, baselineMB, snapshots);
 
   console.log(
     `    ${name}: baseline=${baselineMB.toFixed(2)}MB, ` +
-      `final=${finalMB.toFixed(2)}MB, growth=${growthMB.toFixed(2)}MB ` +
+      `final=${finalMB.toFixed(2)}MB, growth=${growthMB.toFixed(2)}MB, ` +
+      `native=${nativeBytesPerOp.toFixed(1)}B/op ` +
       `(${iterations} iterations) → ${toFileName(name)}.csv`
   );
 
-  return { baselineMB, finalMB, growthMB };
+  return { baselineMB, finalMB, growthMB, nativeBytesPerOp };
 }
 
 // ============================================================================
@@ -208,7 +214,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
     serializedGrant = await access.serialize();
 
     console.log(`\n  Running memory tests with ${ITERATIONS} iterations each...`);
-    console.log(`  Allowed growth: ${ALLOWED_GROWTH_MB}MB per function\n`);
+    console.log(`  Allowed growth: ${ALLOWED_GROWTH_MB}MB per function, ${ALLOWED_NATIVE_BYTES_PER_OP}B native per iteration\n`);
   });
 
   // ==========================================================================
@@ -218,13 +224,15 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
     runTest(
       TEST_DESC,
       async () => {
-        const { growthMB } = await measureMemoryGrowth('parseAccess', async () => {
+        const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('parseAccess', async () => {
           const a = await uplink.parseAccess(serializedGrant);
           // Let access go out of scope
           _unused(a);
         });
 
         expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+        expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
       },
       300000
     );
@@ -248,12 +256,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           return;
         }
 
-        const { growthMB } = await measureMemoryGrowth('requestAccessWithPassphrase', async () => {
+        const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('requestAccessWithPassphrase', async () => {
           const a = await uplink.requestAccessWithPassphrase(satellite, apiKey, passphrase);
           _unused(a);
         });
 
         expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+        expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
       },
       600000
     );
@@ -266,12 +276,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
     runTest(
       TEST_DESC,
       async () => {
-        const { growthMB } = await measureMemoryGrowth('access.serialize', async () => {
+        const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('access.serialize', async () => {
           const s = await access.serialize();
           _unused(s);
         });
 
         expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+        expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
       },
       300000
     );
@@ -284,12 +296,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
     runTest(
       TEST_DESC,
       async () => {
-        const { growthMB } = await measureMemoryGrowth('access.satelliteAddress', async () => {
+        const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('access.satelliteAddress', async () => {
           const addr = await access.satelliteAddress();
           _unused(addr);
         });
 
         expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+        expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
       },
       300000
     );
@@ -302,7 +316,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
     runTest(
       TEST_DESC,
       async () => {
-        const { growthMB } = await measureMemoryGrowth('access.share', async () => {
+        const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('access.share', async () => {
           const shared = await access.share({ allowDownload: true, allowList: true }, [
             { bucket: 'test-bucket' },
           ]);
@@ -310,6 +324,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         });
 
         expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+        expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
       },
       300000
     );
@@ -324,12 +340,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
       async () => {
         const salt = Buffer.from('test-salt-for-memory-testing');
 
-        const { growthMB } = await measureMemoryGrowth('uplinkDeriveEncryptionKey', async () => {
+        const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('uplinkDeriveEncryptionKey', async () => {
           const key = await uplink.uplinkDeriveEncryptionKey('test-passphrase', salt);
           _unused(key);
         });
 
         expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+        expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
       },
       300000
     );
@@ -342,12 +360,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
     runTest(
       TEST_DESC,
       async () => {
-        const { growthMB } = await measureMemoryGrowth('openProject/close', async () => {
+        const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('openProject/close', async () => {
           const project = await access.openProject();
           await project.close();
         });
 
         expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+        expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
       },
       600000
     );
@@ -364,12 +384,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         const bucketName = `mem-test-ensure-${Date.now()}`;
 
         try {
-          const { growthMB } = await measureMemoryGrowth('ensureBucket', async () => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('ensureBucket', async () => {
             const result = await project.ensureBucket(bucketName);
             _unused(result);
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucket(bucketName);
@@ -396,12 +418,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         try {
           await project.ensureBucket(bucketName);
 
-          const { growthMB } = await measureMemoryGrowth('statBucket', async () => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('statBucket', async () => {
             const result = await project.statBucket(bucketName);
             _unused(result);
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucket(bucketName);
@@ -425,12 +449,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         const project = await access.openProject();
 
         try {
-          const { growthMB } = await measureMemoryGrowth('listBuckets', async () => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('listBuckets', async () => {
             const buckets = await project.listBuckets();
             _unused(buckets);
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           await project.close();
         }
@@ -449,13 +475,15 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         const project = await access.openProject();
 
         try {
-          const { growthMB } = await measureMemoryGrowth('createBucket/deleteBucket', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('createBucket/deleteBucket', async (i) => {
             const name = `mem-test-cd-${Date.now()}-${i}`;
             await project.createBucket(name);
             await project.deleteBucket(name);
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           await project.close();
         }
@@ -478,13 +506,15 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           await project.ensureBucket(bucketName);
           const testData = Buffer.from('memory-test-data-payload-for-upload');
 
-          const { growthMB } = await measureMemoryGrowth('upload/write/commit', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('upload/write/commit', async (i) => {
             const upload = await project.uploadObject(bucketName, `mem-obj-${i}`);
             await upload.write(testData, testData.length);
             await upload.commit();
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -512,13 +542,15 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           await project.ensureBucket(bucketName);
           const testData = Buffer.from('abort-test-data');
 
-          const { growthMB } = await measureMemoryGrowth('upload/write/abort', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('upload/write/abort', async (i) => {
             const upload = await project.uploadObject(bucketName, `mem-abort-${i}`);
             await upload.write(testData, testData.length);
             await upload.abort();
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -554,7 +586,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
 
           const readBuffer = Buffer.alloc(1024);
 
-          const { growthMB } = await measureMemoryGrowth('download/read/close', async () => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('download/read/close', async () => {
             const download = await project.downloadObject(bucketName, objectKey);
             try {
               await download.read(readBuffer, readBuffer.length);
@@ -565,6 +597,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -597,7 +631,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           await upload.write(testData, testData.length);
           await upload.commit();
 
-          const { growthMB } = await measureMemoryGrowth('download.info', async () => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('download.info', async () => {
             const download = await project.downloadObject(bucketName, objectKey);
             const info = await download.info();
             _unused(info);
@@ -605,6 +639,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -637,12 +673,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           await upload.write(testData, testData.length);
           await upload.commit();
 
-          const { growthMB } = await measureMemoryGrowth('statObject', async () => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('statObject', async () => {
             const info = await project.statObject(bucketName, objectKey);
             _unused(info);
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -677,12 +715,14 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
             await upload.commit();
           }
 
-          const { growthMB } = await measureMemoryGrowth('listObjects', async () => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('listObjects', async () => {
             const objects = await project.listObjects(bucketName);
             _unused(objects);
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -709,7 +749,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         try {
           await project.ensureBucket(bucketName);
 
-          const { growthMB } = await measureMemoryGrowth('upload+deleteObject', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('upload+deleteObject', async (i) => {
             // Upload then delete in each iteration
             const data = Buffer.from('del-test');
             const upload = await project.uploadObject(bucketName, `del-obj-${i}`);
@@ -719,6 +759,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -752,13 +794,15 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           await upload.write(data, data.length);
           await upload.commit();
 
-          const { growthMB } = await measureMemoryGrowth('copyObject', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('copyObject', async (i) => {
             const destKey = `mem-copy-dest-${i}`;
             const result = await project.copyObject(bucketName, srcKey, bucketName, destKey);
             _unused(result);
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -785,7 +829,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         try {
           await project.ensureBucket(bucketName);
 
-          const { growthMB } = await measureMemoryGrowth('moveObject', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('moveObject', async (i) => {
             // Upload then move in each iteration
             const data = Buffer.from('move-test-data');
             const upload = await project.uploadObject(bucketName, `move-src-${i}`);
@@ -795,6 +839,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -827,7 +873,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           await upload.write(data, data.length);
           await upload.commit();
 
-          const { growthMB } = await measureMemoryGrowth('updateObjectMetadata', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('updateObjectMetadata', async (i) => {
             await project.updateObjectMetadata(bucketName, objectKey, {
               'x-test-key': `value-${i}`,
               'x-iteration': String(i),
@@ -835,6 +881,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -861,7 +909,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         try {
           await project.ensureBucket(bucketName);
 
-          const { growthMB } = await measureMemoryGrowth('upload.info', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('upload.info', async (i) => {
             const upload = await project.uploadObject(bucketName, `upinfo-${i}`);
             const data = Buffer.from('info-test');
             await upload.write(data, data.length);
@@ -871,6 +919,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -897,7 +947,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         try {
           await project.ensureBucket(bucketName);
 
-          const { growthMB } = await measureMemoryGrowth('upload.setCustomMetadata', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('upload.setCustomMetadata', async (i) => {
             const upload = await project.uploadObject(bucketName, `custmeta-${i}`);
             await upload.setCustomMetadata({
               'Content-Type': 'application/octet-stream',
@@ -909,6 +959,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           try {
             await project.deleteBucketWithObjects(bucketName);
@@ -932,7 +984,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         const project = await access.openProject();
 
         try {
-          const { growthMB } = await measureMemoryGrowth('deleteBucketWithObjects', async (i) => {
+          const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('deleteBucketWithObjects', async (i) => {
             const name = `mem-test-dbwo-${Date.now()}-${i}`;
             await project.ensureBucket(name);
             // Upload a small object to make it non-empty
@@ -944,6 +996,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
           });
 
           expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+          expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
         } finally {
           await project.close();
         }
@@ -959,25 +1013,29 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
     it(`should not leak memory on repeated 1KB buffer allocations over ${ITERATIONS} iterations`, async () => {
       const bufferSize = 1024; // 1KB
 
-      const { growthMB } = await measureMemoryGrowth('Buffer.alloc(1KB)', async (i) => {
+      const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('Buffer.alloc(1KB)', async (i) => {
         const buffer = Buffer.alloc(bufferSize);
         buffer.fill(i % 256);
         _unused(buffer);
       });
 
       expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+      expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
     }, 60000);
 
     it(`should not leak memory on repeated 1MB buffer allocations over ${ITERATIONS} iterations`, async () => {
       const bufferSize = 1024 * 1024; // 1MB
 
-      const { growthMB } = await measureMemoryGrowth('Buffer.alloc(1MB)', async (i) => {
+      const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('Buffer.alloc(1MB)', async (i) => {
         const buffer = Buffer.alloc(bufferSize);
         buffer.fill(i % 256);
         _unused(buffer);
       });
 
       expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+      expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
     }, 120000);
   });
 
@@ -990,7 +1048,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
       async () => {
         const salt = Buffer.from('override-enc-key-salt');
 
-        const { growthMB } = await measureMemoryGrowth('overrideEncryptionKey', async (i) => {
+        const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('overrideEncryptionKey', async (i) => {
           // Create fresh access each time since override mutates state
           const freshAccess = await uplink.parseAccess(serializedGrant);
           const encKey = await uplink.uplinkDeriveEncryptionKey(`passphrase-${i}`, salt);
@@ -999,6 +1057,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         });
 
         expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+        expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
       },
       600000
     );
@@ -1011,7 +1071,7 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
     runTest(
       TEST_DESC,
       async () => {
-        const { growthMB } = await measureMemoryGrowth('configOpenProject/close', async () => {
+        const { growthMB, nativeBytesPerOp } = await measureMemoryGrowth('configOpenProject/close', async () => {
           const project = await access.configOpenProject({
             dialTimeoutMilliseconds: 30000,
           });
@@ -1019,6 +1079,8 @@ describe(`Memory Leak Tests - Individual Function Isolation (${ITERATIONS} itera
         });
 
         expect(growthMB).toBeLessThan(ALLOWED_GROWTH_MB);
+
+        expect(nativeBytesPerOp).toBeLessThan(ALLOWED_NATIVE_BYTES_PER_OP);
       },
       600000
     );
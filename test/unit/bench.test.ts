@@ -0,0 +1,121 @@
+/**
+ * @file bench.test.ts
+ * @brief Unit tests for the uplink-bench load generator
+ */
+
+import { runLoad, parseLoadMix, findKnee, LoadStepResult } from '../../src/bench/load';
+import { ProjectResultStruct } from '../../src/project';
+import { native } from '../../src/native';
+
+const GAUGES = {
+    threads: 4,
+    idleThreads: 0,
+    completions: 0,
+    completionWakeups: 0,
+    lanes: { metadata: { queued: 0, running: 1, budget: 4 }, bulk: { queued: 3, running: 2, budget: 4 } },
+    pinnedBytes: 0,
+    pinnedBuffers: 0,
+    handles: {},
+    pendingFrees: 0,
+};
+
+describe('parseLoadMix', () => {
+    it('should read weights, defaulting a bare operation to 1', () => {
+        expect(parseLoadMix('put=20,get=70.5,stat')).toEqual({ put: 20, get: 70.5, stat: 1 });
+    });
+
+    it('should reject unknown operations and weights that are not positive', () => {
+        expect(() => parseLoadMix('put=1,copy=2')).toThrow(TypeError);
+        expect(() => parseLoadMix('get=0')).toThrow(TypeError);
+    });
+});
+
+describe('findKnee', () => {
+    const step = (concurrency: number, opsPerSecond: number): LoadStepResult =>
+        ({ concurrency, opsPerSecond } as LoadStepResult);
+
+    it('should pick the last step before throughput stopped growing by 10%', () => {
+        expect(findKnee([step(1, 100), step(2, 190), step(4, 350), step(8, 370), step(16, 360)])).toBe(2);
+    });
+
+    it('should report -1 while throughput keeps scaling', () => {
+        expect(findKnee([step(1, 100), step(2, 200)])).toBe(-1);
+    });
+});
+
+describe('runLoad', () => {
+    it('should preload, run the mix per step, and attach native metrics', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const getMetrics = jest.fn(() => ({ operations: {}, gauges: GAUGES }));
+        Object.assign(mocked, { getMetrics });
+        const stored = new Map<string, Buffer>();
+        const project = new ProjectResultStruct({ _handle: 1 });
+        const fake = project as unknown as Record<string, unknown>;
+        Object.assign(fake, {
+            putObject: jest.fn(async (_b: string, key: string, data: Buffer) => {
+                stored.set(key, data);
+            }),
+            getObject: jest.fn(async (_b: string, key: string) => ({ data: stored.get(key) })),
+            statObject: jest.fn(async () => ({})),
+            listObjects: jest.fn(async () => []),
+            deleteObject: jest.fn(async (_b: string, key: string) => {
+                stored.delete(key);
+            }),
+        });
+        try {
+            const steps = await runLoad(project, {
+                bucket: 'bench',
+                prefix: 'run/',
+                mix: { put: 1, get: 1, list: 1 },
+                objectSize: 100,
+                preload: 10,
+                concurrency: [1, 2],
+                durationMs: 30,
+                warmupMs: 0,
+            });
+            expect(steps.map((s) => s.concurrency)).toEqual([1, 2]);
+            expect(stored.size).toBeGreaterThanOrEqual(10);
+            expect([...stored.keys()].every((key) => /^run\/\d+\/\d+$/.test(key))).toBe(true);
+            for (const s of steps) {
+                expect(s.ops).toBeGreaterThan(0);
+                expect(s.errors).toBe(0);
+                expect(Object.keys(s.operations).every((op) => ['put', 'get', 'list'].includes(op))).toBe(true);
+                expect(s.peaks.bulkQueued).toBe(3);
+                expect(s.operations.get?.p99Ms).toBeGreaterThanOrEqual(s.operations.get?.p50Ms ?? 0);
+            }
+            expect(getMetrics).toHaveBeenCalledWith({ reset: true });
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should count failures per operation with the first error', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        Object.assign(mocked, { getMetrics: () => ({ operations: {}, gauges: GAUGES }) });
+        const project = new ProjectResultStruct({ _handle: 1 });
+        Object.assign(project as unknown as Record<string, unknown>, {
+            putObject: jest.fn(async () => {
+                throw new Error('bucket not found');
+            }),
+        });
+        try {
+            const [step] = await runLoad(project, {
+                bucket: 'bench',
+                prefix: 'run/',
+                mix: { put: 1 },
+                objectSize: [0, 10],
+                preload: 0,
+                concurrency: [1],
+                durationMs: 20,
+                warmupMs: 0,
+            });
+            expect(step.ops).toBe(0);
+            expect(step.errors).toBeGreaterThan(0);
+            expect(step.operations.put?.firstError).toBe('bucket not found');
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+});
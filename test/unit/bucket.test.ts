@@ -4,6 +4,7 @@
  */
 
 import { ProjectResultStruct } from '../../src';
+import { native } from '../../src/native';
 
 describe('ProjectResultStruct Bucket Operations', () => {
     describe('class structure', () => {
@@ -35,6 +36,95 @@ describe('ProjectResultStruct Bucket Operations', () => {
             expect(project.isOpen).toBe(true);
         });
     });
+
+    describe('warmup', () => {
+        it('should stat buckets and report failures without throwing', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const statBucket = jest.fn(async (_handle: unknown, name: string) => {
+                if (name === 'missing') {
+                    throw new Error('bucket not found');
+                }
+                return { name, created: 0 };
+            });
+            Object.assign(mocked, { statBucket });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const result = await project.warmup({ buckets: ['media', 'missing'] });
+                expect(result.buckets).toEqual([{ name: 'media', created: 0 }]);
+                expect(result.errors.map((e) => e.bucket)).toEqual(['missing']);
+                expect(project.isWarm).toBe(false);
+
+                await project.warmup({ buckets: ['media'] });
+                expect(project.isWarm).toBe(true);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should dial with one bucket listing page without buckets', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const bucketIteratorNext = jest.fn(async () => false);
+            const freeBucketIterator = jest.fn(async () => undefined);
+            Object.assign(mocked, {
+                listBucketsCreate: jest.fn(async () => 'iterator'),
+                bucketIteratorNext,
+                bucketIteratorErr: jest.fn(async () => null),
+                freeBucketIterator,
+            });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await project.warmup();
+                expect(bucketIteratorNext).toHaveBeenCalledTimes(1);
+                expect(freeBucketIterator).toHaveBeenCalledWith('iterator');
+                expect(project.isWarm).toBe(true);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
+    describe('listBuckets', () => {
+        it('should list every bucket with one native call', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const buckets = [{ name: 'alpha', created: 1 }, { name: 'beta', created: 2 }];
+            const collectBuckets = jest.fn(async () => buckets);
+            const bucketIteratorNext = jest.fn();
+            Object.assign(mocked, { collectBuckets, bucketIteratorNext });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await expect(project.listBuckets({ cursor: 'alpha' })).resolves.toBe(buckets);
+                expect(collectBuckets).toHaveBeenCalledWith({ _handle: 1 }, expect.objectContaining({ cursor: 'alpha' }));
+                expect(bucketIteratorNext).not.toHaveBeenCalled();
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
+    describe('knownBuckets', () => {
+        it('should pass options through and return native stats', () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const stats = { hits: 1, misses: 1, invalidations: 0, entries: 1, ttlMs: 1000 };
+            const projectEnableKnownBuckets = jest.fn();
+            const projectDisableKnownBuckets = jest.fn();
+            const projectKnownBucketsStats = jest.fn(() => stats);
+            Object.assign(mocked, { projectEnableKnownBuckets, projectDisableKnownBuckets, projectKnownBucketsStats });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                project.enableKnownBuckets({ ttlMs: 1000 });
+                expect(projectEnableKnownBuckets).toHaveBeenCalledWith({ _handle: 1 }, { ttlMs: 1000 });
+                expect(project.knownBucketsStats()).toBe(stats);
+                project.disableKnownBuckets();
+                expect(projectDisableKnownBuckets).toHaveBeenCalledWith({ _handle: 1 });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
 });
 
 describe('Bucket Name Validation Rules', () => {
@@ -6,9 +6,17 @@
  * Tests download class structure, method signatures, and input validation
  */
 
-import { DownloadResultStruct } from '../../src/download';
-import { DownloadOptions, ObjectInfo, ReadResult } from '../../src/types';
+import { Readable } from 'stream';
+import { DownloadResultStruct, downloadParallel } from '../../src/download';
+import { DownloadReadStream } from '../../src/download/stream';
+import { createWebReadStream } from '../../src/download/web-stream';
+import { ArchiveReadStream } from '../../src/download/archive';
+import { DownloadOptions, DownloadToFileOptions, ObjectInfo, ReadOptions, ReadResult, ReadStreamOptions } from '../../src/types';
 import { ProjectResultStruct } from '../../src/project';
+import { native } from '../../src/native';
+import { IntegrityError } from '../../src/errors';
+
+type ReadCallback = (error: Error | null, bytesRead: number, eof: boolean) => void;
 
 // We can't fully test downloads without a real Storj connection,
 // but we can test the class structure and input validation
@@ -22,17 +30,497 @@ describe('DownloadResultStruct', () => {
         it('should have expected methods', () => {
             // Check prototype methods exist
             expect(typeof DownloadResultStruct.prototype.read).toBe('function');
+            expect(typeof DownloadResultStruct.prototype.readFull).toBe('function');
+            expect(typeof DownloadResultStruct.prototype.readInto).toBe('function');
             expect(typeof DownloadResultStruct.prototype.info).toBe('function');
+            expect(typeof DownloadResultStruct.prototype.teeResults).toBe('function');
             expect(typeof DownloadResultStruct.prototype.close).toBe('function');
         });
     });
 });
 
+describe('downloadParallel function', () => {
+    it('should be a function', () => {
+        expect(typeof downloadParallel).toBe('function');
+    });
+
+    it('should reject an invalid sink', async () => {
+        await expect(downloadParallel({ _handle: 1 }, 'bucket', 'key', 42 as unknown as string))
+            .rejects.toThrow(TypeError);
+    });
+});
+
+describe('DownloadReadStream', () => {
+    it('should be a Readable', () => {
+        expect(DownloadReadStream.prototype).toBeInstanceOf(Readable);
+    });
+
+    it('should reject an invalid readAhead', () => {
+        expect(() => new DownloadReadStream({ _handle: 1 }, 'bucket', 'key', { readAhead: 0 }))
+            .toThrow(TypeError);
+    });
+
+    it('should surface a failed open as a stream error', async () => {
+        const stream = new DownloadReadStream({ _handle: 1 }, 'bucket', 'key');
+        await expect(new Promise((_, reject) => stream.on('error', reject))).rejects.toThrow();
+    });
+
+    it('should reject a non-function onProgress', () => {
+        expect(() => new DownloadReadStream({ _handle: 1 }, 'bucket', 'key', {
+            onProgress: 42 as unknown as () => void,
+        })).toThrow(TypeError);
+    });
+
+    it('should coalesce progress by bytes and report the final state at EOF', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        let remaining = 10;
+        Object.assign(mocked, {
+            downloadObject: jest.fn(async () => ({ downloadHandle: { _handle: 2 } })),
+            downloadInfo: jest.fn(async () => ({ system: { contentLength: 10 } })),
+            allocReadBuffer: jest.fn((size: number) => Buffer.alloc(size)),
+            downloadReadCb: jest.fn((_handle: unknown, chunk: Buffer, _n: number, cb: ReadCallback) => {
+                const bytesRead = Math.min(chunk.length, remaining);
+                remaining -= bytesRead;
+                setImmediate(() => cb(null, bytesRead, remaining === 0));
+            }),
+            closeDownload: jest.fn(async () => undefined),
+        });
+        try {
+            const onProgress = jest.fn();
+            const stream = new DownloadReadStream({ _handle: 1 }, 'bucket', 'key', {
+                chunkSize: 4, onProgress, progressIntervalMs: 60000, progressBytes: 8,
+            });
+            await new Promise((resolve, reject) => stream.on('end', resolve).on('error', reject).resume());
+            expect(onProgress.mock.calls.map(([p]) => [p.bytesTransferred, p.totalBytes]))
+                .toEqual([[8, 10], [10, 10]]);
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should read through the callback-style native read', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const data = Buffer.from('hello world');
+        let offset = 0;
+        const downloadReadCb = jest.fn((_h: unknown, chunk: Buffer, n: number, cb: ReadCallback) => {
+            const bytesRead = data.copy(chunk, 0, offset, offset + n);
+            offset += bytesRead;
+            setImmediate(() => cb(null, bytesRead, offset === data.length));
+        });
+        Object.assign(mocked, {
+            downloadObject: jest.fn(async () => ({ downloadHandle: { _handle: 2 } })),
+            allocReadBuffer: jest.fn((size: number) => Buffer.alloc(size)),
+            downloadReadCb,
+            closeDownload: jest.fn(async () => undefined),
+        });
+        try {
+            const stream = new DownloadReadStream({ _handle: 1 }, 'bucket', 'key', { chunkSize: 4 });
+            const chunks: Buffer[] = [];
+            for await (const chunk of stream) {
+                chunks.push(chunk as Buffer);
+            }
+            expect(Buffer.concat(chunks).toString()).toBe('hello world');
+            expect(downloadReadCb).toHaveBeenCalledWith(
+                { _handle: 2 }, expect.any(Buffer), 4, expect.any(Function), expect.objectContaining({ fill: true })
+            );
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should destroy the stream with a failed read', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const failure = Object.assign(new Error('read failed'), { bytesRead: 0 });
+        const closeDownload = jest.fn(async () => undefined);
+        Object.assign(mocked, {
+            downloadObject: jest.fn(async () => ({ downloadHandle: { _handle: 2 } })),
+            downloadReadCb: jest.fn((_h: unknown, _b: Buffer, _n: number, cb: ReadCallback) =>
+                setImmediate(() => cb(failure, 0, false))),
+            closeDownload,
+        });
+        try {
+            const stream = new DownloadReadStream({ _handle: 1 }, 'bucket', 'key');
+            await expect(new Promise((_, reject) => stream.on('error', reject).resume())).rejects.toBe(failure);
+            expect(closeDownload).toHaveBeenCalledWith({ _handle: 2 });
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+});
+
+describe('download verification', () => {
+    it('should fail the stream instead of ending it when the last read does not verify', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const data = Buffer.from('hello world');
+        let offset = 0;
+        const closeDownload = jest.fn(async () => undefined);
+        Object.assign(mocked, {
+            downloadObject: jest.fn(async () => ({ downloadHandle: { _handle: 2 } })),
+            allocReadBuffer: jest.fn((size: number) => Buffer.alloc(size)),
+            // Native compares the digest on the read that reaches the end of the object
+            downloadReadCb: jest.fn((_h: unknown, chunk: Buffer, n: number, cb: ReadCallback) => {
+                const bytesRead = data.copy(chunk, 0, offset, offset + n);
+                offset += bytesRead;
+                const mismatch = offset === data.length ? new IntegrityError('sha256 mismatch') : null;
+                setImmediate(() => cb(mismatch, mismatch === null ? bytesRead : 0, false));
+            }),
+            closeDownload,
+        });
+        try {
+            const stream = new DownloadReadStream({ _handle: 1 }, 'bucket', 'key', {
+                chunkSize: 4,
+                verify: { algorithm: 'sha256' },
+            });
+            const chunks: Buffer[] = [];
+            const ended = jest.fn();
+            const failure = await new Promise<Error>((resolve) => {
+                stream.on('data', (chunk: Buffer) => chunks.push(chunk)).on('end', ended).on('error', resolve);
+            });
+            expect(failure).toBeInstanceOf(IntegrityError);
+            expect(Buffer.concat(chunks).toString()).toBe('hello wo');
+            expect(ended).not.toHaveBeenCalled();
+            expect(closeDownload).toHaveBeenCalledWith({ _handle: 2 });
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+});
+
+describe('download decompression', () => {
+    const stored = {
+        system: { contentLength: 60 },
+        custom: { codec: 'lz4', 'codec-chunk-size': '262144', 'codec-raw-size': '100', 'codec-index-offset': '56' },
+    };
+
+    async function progressTotals(options: ReadStreamOptions): Promise<{ totals: number[]; downloadObject: jest.Mock }> {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const downloadObject = jest.fn(async () => ({ downloadHandle: { _handle: 2 } }));
+        Object.assign(mocked, {
+            downloadObject,
+            downloadInfo: jest.fn(async () => stored),
+            allocReadBuffer: jest.fn((size: number) => Buffer.alloc(size)),
+            downloadReadCb: jest.fn((_h: unknown, _b: Buffer, n: number, cb: ReadCallback) =>
+                setImmediate(() => cb(null, n, true))),
+            closeDownload: jest.fn(async () => undefined),
+        });
+        try {
+            const onProgress = jest.fn();
+            const stream = new DownloadReadStream({ _handle: 1 }, 'bucket', 'key', { ...options, onProgress });
+            await new Promise((resolve, reject) => stream.on('end', resolve).on('error', reject).resume());
+            return { totals: onProgress.mock.calls.map(([p]) => p.totalBytes), downloadObject };
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    }
+
+    it('should count progress against the original size when decoding', async () => {
+        const { totals } = await progressTotals({ chunkSize: 100 });
+        expect(totals[totals.length - 1]).toBe(100);
+        expect((await progressTotals({ chunkSize: 30, offset: 80 })).totals.pop()).toBe(20);
+    });
+
+    it('should count progress against the stored size with decompress false', async () => {
+        const { totals, downloadObject } = await progressTotals({ chunkSize: 60, decompress: false });
+        expect(totals[totals.length - 1]).toBe(60);
+        expect(downloadObject).toHaveBeenCalledWith(
+            { _handle: 1 }, 'bucket', 'key', expect.objectContaining({ decompress: false })
+        );
+    });
+});
+
+describe('download tee', () => {
+    it('should pass tee sinks through and read back their results', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const downloadObject = jest.fn(async () => ({ downloadHandle: { _handle: 2 } }));
+        const results = [
+            { bytes: 10, path: '/tmp/copy.bin' },
+            { bytes: 10, algorithm: 'sha256', digest: 'ab' },
+        ];
+        const downloadTeeResults = jest.fn(() => results);
+        Object.assign(mocked, { downloadObject, downloadTeeResults });
+        try {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            const tee = [{ path: '/tmp/copy.bin', fsync: true }, { hash: 'sha256' as const }];
+            const download = await project.downloadObject('bucket', 'key', { tee });
+            expect(downloadObject).toHaveBeenCalledWith(
+                { _handle: 1 }, 'bucket', 'key', expect.objectContaining({ tee })
+            );
+            expect(download.teeResults()).toEqual(results);
+            expect(downloadTeeResults).toHaveBeenCalledWith({ _handle: 2 });
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+});
+
+describe('downloadRanges', () => {
+    it('should slice the shared buffer into one view per range, in request order', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const data = Buffer.from('abcdefghij');
+        const downloadRanges = jest.fn(async () => ({ data, offsets: [6, 0, 3], lengths: [4, 2, 0], requests: 1 }));
+        Object.assign(mocked, { downloadRanges });
+        try {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            const ranges = [{ offset: -4, length: 4 }, { offset: 0, length: 2 }, { offset: 99, length: 5 }];
+            const parts = await project.downloadRanges('bucket', 'key', ranges, { coalesceGap: 0 });
+            expect(downloadRanges).toHaveBeenCalledWith(
+                { _handle: 1 }, 'bucket', 'key', ranges, expect.objectContaining({ coalesceGap: 0 })
+            );
+            expect(parts.map((part) => part.toString())).toEqual(['ghij', 'ab', '']);
+            expect(parts[0].buffer).toBe(data.buffer);
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should reject ranges that are not an array', async () => {
+        const project = new ProjectResultStruct({ _handle: 1 });
+        await expect(project.downloadRanges('bucket', 'key', {} as never)).rejects.toThrow(TypeError);
+    });
+});
+
+describe('createArchiveStream', () => {
+    it('should pass the source and options to archiveOpen and stream reads until eof', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const data = Buffer.from('archive bytes');
+        let position = 0;
+        const archiveOpen = jest.fn(() => ({ _handle: 3 }));
+        const archiveClose = jest.fn();
+        Object.assign(mocked, {
+            archiveOpen,
+            archiveClose,
+            allocReadBuffer: (size: number) => Buffer.alloc(size),
+            archiveRead: jest.fn(async (_handle: unknown, buffer: Buffer) => {
+                const bytesRead = data.copy(buffer, 0, position);
+                position += bytesRead;
+                return { bytesRead, eof: position === data.length };
+            }),
+        });
+        try {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            const stream = project.createArchiveStream('bucket', 'photos/', { format: 'zip', concurrency: 4, chunkSize: 5 });
+            expect(stream).toBeInstanceOf(ArchiveReadStream);
+            expect(archiveOpen).toHaveBeenCalledWith(
+                { _handle: 1 }, 'bucket', 'photos/', { format: 'zip', concurrency: 4, maxBufferedBytes: undefined }
+            );
+            const chunks: Buffer[] = [];
+            for await (const chunk of stream) {
+                chunks.push(chunk as Buffer);
+            }
+            expect(Buffer.concat(chunks).equals(data)).toBe(true);
+            expect(archiveClose).toHaveBeenCalledTimes(1);
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should destroy the stream with the error of an object that cannot be read', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const archiveClose = jest.fn();
+        Object.assign(mocked, {
+            archiveOpen: jest.fn(() => ({ _handle: 3 })),
+            archiveClose,
+            allocReadBuffer: (size: number) => Buffer.alloc(size),
+            archiveRead: jest.fn(async () => {
+                throw new Error('missing: object not found');
+            }),
+        });
+        try {
+            const stream = new ArchiveReadStream({ _handle: 1 }, 'bucket', ['a', 'missing']);
+            await expect(stream[Symbol.asyncIterator]().next()).rejects.toThrow('object not found');
+            expect(archiveClose).toHaveBeenCalledTimes(1);
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should reject invalid keys before opening the archive', () => {
+        const project = new ProjectResultStruct({ _handle: 1 });
+        expect(() => project.createArchiveStream('bucket', [''])).toThrow(TypeError);
+        expect(() => project.createArchiveStream('bucket', 42 as never)).toThrow(TypeError);
+    });
+});
+
+describe('pack objects', () => {
+    it('should round-trip members through the trailing index', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const written: Buffer[] = [];
+        let stored = Buffer.alloc(0);
+        const uploadObject = jest.fn(async () => ({ _handle: 2 }));
+        const downloadObject = jest.fn(async () => ({ downloadHandle: { _handle: 3 } }));
+        const downloadRanges = jest.fn(async (_p: unknown, _b: string, _k: string, ranges: { offset: number; length: number }[]) => {
+            const { offset, length } = ranges[0];
+            const start = offset < 0 ? Math.max(stored.length + offset, 0) : offset;
+            const data = stored.subarray(start, start + length);
+            return { data, offsets: [0], lengths: [data.length], requests: 1 };
+        });
+        Object.assign(mocked, {
+            uploadObject,
+            uploadWrite: jest.fn(async (_h: unknown, buffer: Buffer) => {
+                written.push(Buffer.from(buffer));
+                return buffer.length;
+            }),
+            uploadCommit: jest.fn(async () => {
+                stored = Buffer.concat(written);
+            }),
+            downloadObject,
+            downloadRanges,
+            downloadReadFull: jest.fn(async (_h: unknown, buffer: Buffer, length: number) => {
+                const { offset } = (downloadObject.mock.calls[downloadObject.mock.calls.length - 1] as unknown[])[3] as { offset: number };
+                const bytesRead = stored.copy(buffer, 0, offset, offset + length);
+                return { bytesRead, eof: false };
+            }),
+            closeDownload: jest.fn(async () => undefined),
+        });
+        try {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            const pack = await project.createPackUpload('bucket', 'batch.pack');
+            expect(uploadObject).toHaveBeenCalledWith(
+                { _handle: 1 }, 'bucket', 'batch.pack', expect.objectContaining({ writeBufferSize: 4 * 1024 * 1024 })
+            );
+            await Promise.all([pack.add('a.txt', 'alpha'), pack.add('empty', ''), pack.add('b/ü.bin', Buffer.from([1, 2, 3]))]);
+            await expect(pack.add('a.txt', 'again')).rejects.toThrow('already added');
+            await pack.commit();
+
+            const reader = await project.openPack('bucket', 'batch.pack');
+            expect(downloadRanges).toHaveBeenCalledTimes(1);
+            expect(reader.names()).toEqual(['a.txt', 'empty', 'b/ü.bin']);
+            expect(reader.stat('b/ü.bin')).toEqual({ name: 'b/ü.bin', offset: 5, length: 3 });
+            expect((await reader.read('a.txt')).toString()).toBe('alpha');
+            expect(downloadObject).toHaveBeenLastCalledWith(
+                { _handle: 1 }, 'bucket', 'batch.pack', expect.objectContaining({ offset: 0, length: 5 })
+            );
+            expect((await reader.read('empty')).length).toBe(0);
+            await expect(reader.read('missing')).rejects.toThrow('No such pack member');
+
+            // An index larger than the tail read costs a second ranged read
+            const small = await project.openPack('bucket', 'batch.pack', { indexReadSize: 40 });
+            expect(downloadRanges).toHaveBeenCalledTimes(3);
+            expect([...(await small.read('b/ü.bin'))]).toEqual([1, 2, 3]);
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should reject objects without a pack footer', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const data = Buffer.from('just an ordinary object with no pack footer');
+        Object.assign(mocked, {
+            downloadRanges: jest.fn(async () => ({ data, offsets: [0], lengths: [data.length], requests: 1 })),
+        });
+        try {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            await expect(project.openPack('bucket', 'plain.txt')).rejects.toThrow('Not a pack object');
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+});
+
+describe('createWebReadStream', () => {
+    it('should reject an invalid chunkSize', () => {
+        expect(() => createWebReadStream({ _handle: 1 }, 'bucket', 'key', { chunkSize: 0 }))
+            .toThrow(TypeError);
+    });
+
+    it('should fill BYOB views in place and close the download at EOF', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const data = Buffer.from('0123456789');
+        let position = 0;
+        const closeDownload = jest.fn(async () => undefined);
+        Object.assign(mocked, {
+            downloadObject: jest.fn(async () => ({ downloadHandle: { _handle: 2 } })),
+            downloadReadInto: jest.fn(async (_handle: unknown, view: Uint8Array, offset: number, length: number) => {
+                const bytesRead = Math.min(length, data.length - position);
+                view.set(data.subarray(position, position + bytesRead), offset);
+                position += bytesRead;
+                return { bytesRead, eof: bytesRead < length };
+            }),
+            closeDownload,
+        });
+        try {
+            const reader = createWebReadStream({ _handle: 1 }, 'bucket', 'key').getReader({ mode: 'byob' });
+            const chunks: Buffer[] = [];
+            let view = new Uint8Array(4);
+            for (;;) {
+                const { value, done } = await reader.read(view);
+                if (done) break;
+                chunks.push(Buffer.from(value!));
+                view = new Uint8Array(value!.buffer);
+            }
+            expect(Buffer.concat(chunks).toString()).toBe('0123456789');
+            expect(closeDownload).toHaveBeenCalledTimes(1);
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+});
+
 describe('ProjectResultStruct Download Method', () => {
     describe('class structure', () => {
         it('should have downloadObject method', () => {
             expect(typeof ProjectResultStruct.prototype.downloadObject).toBe('function');
         });
+
+        it('should have getObject method', () => {
+            expect(typeof ProjectResultStruct.prototype.getObject).toBe('function');
+        });
+
+        it('should have createReadStream method', () => {
+            expect(typeof ProjectResultStruct.prototype.createReadStream).toBe('function');
+        });
+
+        it('should have createWebReadStream method', () => {
+            expect(typeof ProjectResultStruct.prototype.createWebReadStream).toBe('function');
+        });
+
+        it('should have downloadToFile method', () => {
+            expect(typeof ProjectResultStruct.prototype.downloadToFile).toBe('function');
+        });
+
+        it('should have object cache methods', () => {
+            expect(typeof ProjectResultStruct.prototype.enableObjectCache).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.disableObjectCache).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.objectCacheStats).toBe('function');
+        });
+    });
+
+    describe('object cache', () => {
+        it('should forward options and stats to the native cache', () => {
+            const enable = jest.fn();
+            const disable = jest.fn();
+            const stats = { hits: 2, misses: 1, invalidations: 0, evictions: 0, entries: 1, bytes: 42,
+                maxBytes: 1 << 20, maxObjectSize: 1024, ttlMs: 1000 };
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            Object.assign(mocked, {
+                projectEnableObjectCache: enable,
+                projectDisableObjectCache: disable,
+                projectObjectCacheStats: () => stats,
+            });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                project.enableObjectCache({ maxBytes: 1 << 20, maxObjectSize: 1024, ttlMs: 1000 });
+                expect(enable).toHaveBeenCalledWith({ _handle: 1 }, { maxBytes: 1 << 20, maxObjectSize: 1024, ttlMs: 1000 });
+                expect(project.objectCacheStats()).toEqual(stats);
+                project.disableObjectCache();
+                expect(disable).toHaveBeenCalledWith({ _handle: 1 });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
     });
 });
 
@@ -76,6 +564,19 @@ describe('DownloadOptions Interface', () => {
     });
 });
 
+describe('DownloadToFileOptions Interface', () => {
+    it('should accept range, chunkSize and fsync', () => {
+        const options: DownloadToFileOptions = {
+            offset: 0,
+            length: -1,
+            chunkSize: 4 * 1024 * 1024,
+            fsync: true
+        };
+        expect(options.chunkSize).toBe(4 * 1024 * 1024);
+        expect(options.fsync).toBe(true);
+    });
+});
+
 describe('Download Parameter Validation', () => {
     describe('bucket name validation', () => {
         it('should require valid bucket name format', () => {
@@ -130,6 +631,16 @@ describe('ReadResult Interface', () => {
             expect(result.bytesRead).toBe(0);
         });
 
+        it('should carry an eof flag', () => {
+            const result: ReadResult = { bytesRead: 12, eof: true };
+            expect(result.eof).toBe(true);
+        });
+
+        it('should accept eofAsValue read option', () => {
+            const options: ReadOptions = { eofAsValue: true };
+            expect(options.eofAsValue).toBe(true);
+        });
+
         it('should support large read results', () => {
             const result: ReadResult = { bytesRead: 1024 * 1024 * 100 }; // 100MB
             expect(result.bytesRead).toBe(104857600);
@@ -6,8 +6,14 @@
 import { 
   edgeRegisterAccess, 
   edgeJoinShareUrl, 
+  edgeJoinShareUrlSync,
+  edgeJoinShareUrls,
+  enableEdgeCache,
+  disableEdgeCache,
+  edgeCacheStats,
   EdgeRegions 
 } from '../../src/edge';
+import { native } from '../../src/native';
 import type {
   EdgeConfig,
   EdgeCredentials,
@@ -79,6 +85,77 @@ describe('Edge Operations', () => {
     });
   });
 
+  describe('edgeJoinShareUrlSync function', () => {
+    it('should throw TypeError synchronously for invalid arguments', () => {
+      expect(() => edgeJoinShareUrlSync('', 'access-key', 'bucket', 'key')).toThrow(TypeError);
+      expect(() => edgeJoinShareUrlSync('https://link.storj.io', '', 'bucket', 'key')).toThrow(TypeError);
+      expect(() => edgeJoinShareUrlSync('https://link.storj.io', 'access-key', 123 as unknown as string, 'key'))
+        .toThrow(TypeError);
+      expect(() => edgeJoinShareUrlSync('https://link.storj.io', 'access-key', 'bucket', 123 as unknown as string))
+        .toThrow(TypeError);
+    });
+
+    it('should return the native result without a promise', () => {
+      const mocked = native as unknown as Record<string, unknown>;
+      const saved = { ...mocked };
+      const calls: unknown[][] = [];
+      Object.assign(mocked, {
+        edgeJoinShareUrlSync: (...args: unknown[]) => {
+          calls.push(args);
+          return 'https://link.storj.io/s/access-key/bucket/key';
+        },
+      });
+      try {
+        const url = edgeJoinShareUrlSync('https://link.storj.io', 'access-key', 'bucket', 'key', { raw: true });
+        expect(url).toBe('https://link.storj.io/s/access-key/bucket/key');
+        expect(calls).toEqual([['https://link.storj.io', 'access-key', 'bucket', 'key', { raw: true }]]);
+      } finally {
+        Object.assign(mocked, saved);
+      }
+    });
+  });
+
+  describe('edgeJoinShareUrls function', () => {
+    it('should throw TypeError for invalid arguments', () => {
+      expect(() => edgeJoinShareUrls('', 'access-key', [])).toThrow(TypeError);
+      expect(() => edgeJoinShareUrls('https://link.storj.io', '', [])).toThrow(TypeError);
+      expect(() => edgeJoinShareUrls('https://link.storj.io', 'access-key', null as unknown as []))
+        .toThrow(TypeError);
+      expect(() => edgeJoinShareUrls('https://link.storj.io', 'access-key', [
+        { bucket: 'bucket', key: 123 as unknown as string },
+      ])).toThrow(TypeError);
+    });
+
+    it('should return an empty array for no entries', () => {
+      expect(edgeJoinShareUrls('https://link.storj.io', 'access-key', [])).toEqual([]);
+    });
+  });
+
+  describe('edge credential cache', () => {
+    it('should forward configuration and stats to the native cache', () => {
+      const mocked = native as unknown as Record<string, unknown>;
+      const saved = { ...mocked };
+      const stats = { hits: 3, misses: 1, evictions: 0, entries: 1, maxEntries: 16, ttlMs: 60000 };
+      const enable = jest.fn();
+      const disable = jest.fn();
+      Object.assign(mocked, {
+        enableEdgeCache: enable,
+        disableEdgeCache: disable,
+        edgeCacheStats: jest.fn(() => stats),
+      });
+      try {
+        enableEdgeCache({ maxEntries: 16, ttlMs: 60000 });
+        expect(enable).toHaveBeenCalledWith({ maxEntries: 16, ttlMs: 60000 });
+        expect(edgeCacheStats()).toEqual(stats);
+
+        disableEdgeCache();
+        expect(disable).toHaveBeenCalled();
+      } finally {
+        Object.assign(mocked, saved);
+      }
+    });
+  });
+
   describe('EdgeRegions constant', () => {
     it('should export region configurations', () => {
       expect(EdgeRegions).toBeDefined();
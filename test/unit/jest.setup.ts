@@ -28,10 +28,13 @@ jest.mock('../../src/native', () => {
     parseAccess: throwTypeErrorSync,
     accessSerialize: throwTypeErrorSync,
     uploadWrite: throwTypeErrorSync,
+    allocReadBuffer: (size: number) => Buffer.allocUnsafe(size),
     // Add more if needed for sync throws
 
     // Async functions (reject with TypeError)
     downloadRead: rejectTypeErrorAsync,
+    downloadReadFull: rejectTypeErrorAsync,
+    downloadReadInto: rejectTypeErrorAsync,
     accessShare: rejectTypeErrorAsync,
     uploadSetCustomMetadata: rejectTypeErrorAsync,
     updateObjectMetadata: rejectTypeErrorAsync,
@@ -51,12 +54,28 @@ jest.mock('../../src/native', () => {
     'configRequestAccessWithPassphrase',
     'accessSatelliteAddress',
     'accessSerialize',
+    'accessSatelliteAddressSync',
+    'accessSerializeSync',
     'accessShare',
+    'accessShareMany',
     'accessOverrideEncryptionKey',
+    'enableAccessCache',
+    'disableAccessCache',
+    'accessCacheStats',
     'openProject',
     'configOpenProject',
     'closeProject',
     'revokeAccess',
+    'projectEnableStatCache',
+    'projectDisableStatCache',
+    'projectStatCacheStats',
+    'projectEnableObjectCache',
+    'projectDisableObjectCache',
+    'projectObjectCacheStats',
+    'projectEnableKnownBuckets',
+    'projectDisableKnownBuckets',
+    'projectKnownBucketsStats',
+    'projectAdmissionStats',
     'createBucket',
     'ensureBucket',
     'statBucket',
@@ -66,28 +85,65 @@ jest.mock('../../src/native', () => {
     'bucketIteratorNext',
     'bucketIteratorItem',
     'bucketIteratorErr',
+    'bucketIteratorNextBatch',
+    'collectBuckets',
     'freeBucketIterator',
     'statObject',
+    'statObjects',
     'deleteObject',
+    'deleteObjects',
+    'deletePrefix',
+    'exportListing',
     'listObjectsCreate',
     'objectIteratorNext',
+    'objectIteratorNextBatch',
+    'objectIteratorNextColumns',
     'objectIteratorItem',
     'objectIteratorErr',
+    'objectIteratorCheckpoint',
     'freeObjectIterator',
     'copyObject',
     'moveObject',
+    'copyObjects',
+    'moveObjects',
     'updateObjectMetadata',
+    'updateObjectsMetadata',
     'uploadObject',
     'uploadWrite',
+    'uploadWritev',
+    'uploadWritevCb',
     'uploadCommit',
     'uploadAbort',
     'uploadSetCustomMetadata',
     'uploadInfo',
+    'uploadFile',
+    'putObject',
+    'putObjectDedup',
+    'uploadReplicated',
     'downloadObject',
     'downloadRead',
+    'downloadReadFull',
+    'downloadReadInto',
+    'downloadReadCb',
+    'downloadToFile',
+    'downloadParallel',
+    'downloadRanges',
+    'getObject',
+    'allocReadBuffer',
     'downloadInfo',
     'closeDownload',
+    'downloadTeeResults',
+    'enableChunkCache',
+    'disableChunkCache',
+    'chunkCacheStats',
+    'enableReadAhead',
+    'disableReadAhead',
+    'readAheadStats',
     'deriveEncryptionKey',
+    'deriveEncryptionKeys',
+    'enableEncryptionKeyCache',
+    'disableEncryptionKeyCache',
+    'encryptionKeyCacheStats',
     'beginUpload',
     'commitUpload',
     'abortUpload',
@@ -107,11 +163,36 @@ jest.mock('../../src/native', () => {
     'uploadIteratorItem',
     'uploadIteratorErr',
     'freeUploadIterator',
+    'collectUploadParts',
+    'collectUploads',
+    'uploadParallel',
+    'uploadPartFromFile',
+    'resumeUpload',
+    'uploadDirectory',
+    'diffDirectory',
+    'archiveOpen',
+    'archiveRead',
+    'archiveClose',
     'edgeRegisterAccess',
     'edgeJoinShareUrl',
+    'edgeJoinShareUrlSync',
+    'edgeJoinShareUrls',
+    'enableEdgeCache',
+    'disableEdgeCache',
+    'edgeCacheStats',
     'internalUniverseIsEmpty',
     'testThrowTypedError',
+    'handleStats',
+    'workPoolStats',
+    'nativeAllocStats',
     'initErrorClasses',
+    'setStacklessErrors',
+    'configureThreadPool',
+    'configureBandwidth',
+    'getMetrics',
+    'hedgeStats',
+    'createCancelToken',
+    'cancelToken',
   ];
   for (const fn of allNativeMethods) {
     if (!(fn in native)) native[fn] = stub;
@@ -140,6 +221,9 @@ jest.mock('../../src/native', () => {
     UploadDoneError: errors.UploadDoneError,
     EdgeAuthDialFailedError: errors.EdgeAuthDialFailedError,
     EdgeRegisterAccessFailedError: errors.EdgeRegisterAccessFailedError,
+    TimeoutError: errors.TimeoutError,
+    IntegrityError: errors.IntegrityError,
+    CompressedObjectError: errors.CompressedObjectError,
   };
 
   return {
@@ -7,7 +7,12 @@ import {
   MultipartUpload, 
   PartUploadResultStruct, 
   beginMultipartUpload, 
-  listMultipartUploads 
+  listMultipartUploads,
+  collectUploadParts,
+  collectUploads,
+  uploadParallel,
+  uploadPartFromFile,
+  resumeUpload
 } from '../../src/multipart';
 import { ProjectResultStruct } from '../../src/project';
 
@@ -74,6 +79,53 @@ describe('Multipart Upload Operations', () => {
     });
   });
 
+  describe('collector functions', () => {
+    it('should be functions', () => {
+      expect(typeof collectUploadParts).toBe('function');
+      expect(typeof collectUploads).toBe('function');
+    });
+  });
+
+  describe('uploadParallel function', () => {
+    it('should be a function', () => {
+      expect(typeof uploadParallel).toBe('function');
+    });
+
+    it('should reject an invalid source', async () => {
+      await expect(uploadParallel({ _handle: 1 }, 'bucket', 'key', 42 as unknown as string))
+        .rejects.toThrow(TypeError);
+    });
+  });
+
+  describe('uploadPartFromFile function', () => {
+    it('should be a function', () => {
+      expect(typeof uploadPartFromFile).toBe('function');
+      expect(typeof MultipartUpload.prototype.uploadPartFromFile).toBe('function');
+    });
+
+    it('should reject an invalid part number or range', async () => {
+      await expect(uploadPartFromFile({ _handle: 1 }, 'bucket', 'key', 'id', 0, '/tmp/f', 0, 1))
+        .rejects.toThrow(RangeError);
+      await expect(uploadPartFromFile({ _handle: 1 }, 'bucket', 'key', 'id', 1, '/tmp/f', -1, 1))
+        .rejects.toThrow(RangeError);
+      await expect(uploadPartFromFile({ _handle: 1 }, 'bucket', 'key', 'id', 1, '', 0, 1))
+        .rejects.toThrow(TypeError);
+    });
+  });
+
+  describe('resumeUpload function', () => {
+    it('should be a function', () => {
+      expect(typeof resumeUpload).toBe('function');
+    });
+
+    it('should reject a missing upload ID or source', async () => {
+      await expect(resumeUpload({ _handle: 1 }, 'bucket', 'key', '', Buffer.alloc(1)))
+        .rejects.toThrow(TypeError);
+      await expect(resumeUpload({ _handle: 1 }, 'bucket', 'key', 'id', ''))
+        .rejects.toThrow(TypeError);
+    });
+  });
+
   describe('ProjectResultStruct multipart methods', () => {
     it('should have updateObjectMetadata method', () => {
       expect(typeof ProjectResultStruct.prototype.updateObjectMetadata).toBe('function');
@@ -3,16 +3,29 @@
  * @brief Unit tests for object operations
  */
 
-import { ProjectResultStruct } from '../../src';
+import { ProjectResultStruct, columnKey, columnIsPrefix, CanceledError } from '../../src';
+import { native } from '../../src/native';
+import { packMetadata } from '../../src/native/metadata';
 
 describe('ProjectResultStruct Object Operations', () => {
     describe('class structure', () => {
         it('should have object methods', () => {
             expect(typeof ProjectResultStruct.prototype.statObject).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.statObjects).toBe('function');
             expect(typeof ProjectResultStruct.prototype.deleteObject).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.deleteObjects).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.deletePrefix).toBe('function');
             expect(typeof ProjectResultStruct.prototype.listObjects).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.iterateObjects).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.iterateObjectColumns).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.listObjectsParallel).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.enableStatCache).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.disableStatCache).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.statCacheStats).toBe('function');
             expect(typeof ProjectResultStruct.prototype.copyObject).toBe('function');
             expect(typeof ProjectResultStruct.prototype.moveObject).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.copyObjects).toBe('function');
+            expect(typeof ProjectResultStruct.prototype.moveObjects).toBe('function');
         });
     });
 
@@ -23,6 +36,213 @@ describe('ProjectResultStruct Object Operations', () => {
             expect(project.isOpen).toBe(true);
         });
     });
+
+    describe('listObjects batching', () => {
+        it('should drain the iterator in batches until a short batch', async () => {
+            const keys = Array.from({ length: 2500 }, (_, i) => ({ key: `k${i}`, isPrefix: false }));
+            let offset = 0;
+            const nextBatch = jest.fn(async (_iterator: unknown, maxItems: number) => {
+                const batch = keys.slice(offset, offset + maxItems);
+                offset += batch.length;
+                return batch;
+            });
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            Object.assign(mocked, {
+                listObjectsCreate: async () => ({}),
+                objectIteratorNextBatch: nextBatch,
+                objectIteratorErr: async () => null,
+                freeObjectIterator: jest.fn(async () => undefined),
+            });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const objects = await project.listObjects('my-bucket', { recursive: true });
+                expect(objects).toHaveLength(2500);
+                expect(objects[2499].key).toBe('k2499');
+                expect(nextBatch).toHaveBeenCalledTimes(3);
+                expect(mocked.freeObjectIterator).toHaveBeenCalledTimes(1);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should pass a fields projection through to the native iterator', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const create = jest.fn(async () => ({}));
+            Object.assign(mocked, {
+                listObjectsCreate: create,
+                objectIteratorNextBatch: async () => ['a.txt', 'b.txt'],
+                objectIteratorErr: async () => null,
+                freeObjectIterator: async () => undefined,
+            });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const keys: string[] = await project.listObjects('my-bucket', { fields: ['key'] });
+                expect(keys).toEqual(['a.txt', 'b.txt']);
+                expect(create).toHaveBeenCalledWith({ _handle: 1 }, 'my-bucket', { fields: ['key'] });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
+    describe('listObjectsParallel', () => {
+        const tree: Record<string, Array<{ key: string; isPrefix: boolean }>> = {
+            '': [
+                { key: 'b/', isPrefix: true },
+                { key: 'a/', isPrefix: true },
+                { key: 'a-top', isPrefix: false },
+            ],
+            'a/': [{ key: 'a/2', isPrefix: false }, { key: 'a/1', isPrefix: false }],
+            'b/': [{ key: 'b/x/1', isPrefix: false }],
+        };
+
+        async function withTree(run: () => Promise<void>): Promise<void> {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            Object.assign(mocked, {
+                listObjectsCreate: async (_p: unknown, _b: string, opts: { prefix?: string }) => ({
+                    items: [...(tree[opts.prefix ?? ''] ?? [])],
+                }),
+                objectIteratorNextBatch: async (iterator: { items: unknown[] }) => iterator.items.splice(0),
+                objectIteratorErr: async () => null,
+                freeObjectIterator: async () => undefined,
+            });
+            try {
+                await run();
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        }
+
+        it('should shard by top-level prefix and merge in key order', async () => {
+            await withTree(async () => {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const objects = await project.listObjectsParallel('my-bucket', { shardBy: 'delimiter', concurrency: 2 });
+                expect(objects.map((o) => o.key)).toEqual(['a-top', 'a/1', 'a/2', 'b/x/1']);
+            });
+        });
+
+        it('should list explicit prefixes', async () => {
+            await withTree(async () => {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const objects = await project.listObjectsParallel('my-bucket', {
+                    prefixes: ['b/', 'a/'],
+                    order: 'unordered',
+                });
+                expect(objects.map((o) => o.key).sort()).toEqual(['a/1', 'a/2', 'b/x/1']);
+            });
+        });
+
+        it('should require prefixes or shardBy', async () => {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            await expect(project.listObjectsParallel('my-bucket', {})).rejects.toThrow(TypeError);
+        });
+    });
+
+    describe('iterateObjects', () => {
+        const keys = Array.from({ length: 25 }, (_, i) => ({ key: `k${i}`, isPrefix: false }));
+
+        async function withListing(run: (free: jest.Mock) => Promise<void>): Promise<void> {
+            let offset = 0;
+            const free = jest.fn(async () => undefined);
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            Object.assign(mocked, {
+                listObjectsCreate: async () => ({}),
+                objectIteratorNextBatch: async (_iterator: unknown, maxItems: number) => {
+                    const batch = keys.slice(offset, offset + maxItems);
+                    offset += batch.length;
+                    return batch;
+                },
+                objectIteratorErr: async () => null,
+                freeObjectIterator: free,
+            });
+            try {
+                await run(free);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        }
+
+        it('should yield every object across pages', async () => {
+            await withListing(async (free) => {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const seen: string[] = [];
+                for await (const obj of project.iterateObjects('my-bucket', { pageSize: 10 })) {
+                    seen.push(obj.key);
+                }
+                expect(seen).toEqual(keys.map((k) => k.key));
+                expect(free).toHaveBeenCalledTimes(1);
+            });
+        });
+
+        it('should free the iterator on early break', async () => {
+            await withListing(async (free) => {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                for await (const obj of project.iterateObjects('my-bucket', { pageSize: 10 })) {
+                    if (obj.key === 'k3') break;
+                }
+                expect(free).toHaveBeenCalledTimes(1);
+            });
+        });
+
+        it('should report a checkpoint after each consumed page', async () => {
+            await withListing(async () => {
+                const mocked = native as unknown as Record<string, unknown>;
+                let returned = 0;
+                const next = mocked.objectIteratorNextBatch as (it: unknown, n: number) => Promise<unknown[]>;
+                Object.assign(mocked, {
+                    objectIteratorNextBatch: async (iterator: unknown, maxItems: number) => {
+                        const batch = await next(iterator, maxItems);
+                        returned += batch.length;
+                        return batch;
+                    },
+                    objectIteratorCheckpoint: () => (returned > 0 ? `k${returned - 1}` : null),
+                });
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const checkpoints: string[] = [];
+                const seen: string[] = [];
+                for await (const obj of project.iterateObjects('my-bucket', {
+                    pageSize: 10,
+                    onCheckpoint: (checkpoint) => checkpoints.push(checkpoint),
+                })) {
+                    seen.push(obj.key);
+                    // A page's checkpoint is reported only once the page is consumed
+                    expect(checkpoints.length).toBe(Math.floor((seen.length - 1) / 10));
+                }
+                expect(checkpoints).toEqual(['k9', 'k19', 'k24']);
+            });
+        });
+
+        it('should yield columnar pages from the native iterator', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const page = { count: 0 };
+            Object.assign(mocked, {
+                listObjectsCreate: async () => ({}),
+                objectIteratorNextColumns: async () => page,
+                objectIteratorErr: async () => null,
+                freeObjectIterator: async () => undefined,
+            });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const pages = [];
+                for await (const p of project.iterateObjectColumns('my-bucket')) {
+                    pages.push(p);
+                }
+                expect(pages).toEqual([page]);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should reject a non-positive pageSize', async () => {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            await expect(project.iterateObjects('my-bucket', { pageSize: 0 }).next()).rejects.toThrow(TypeError);
+        });
+    });
 });
 
 describe('Object Key Validation Rules', () => {
@@ -208,10 +428,103 @@ describe('Object Method Signatures', () => {
     
     describe('statObject', () => {
         it('should accept bucket name and object key', () => {
-            // Method signature: statObject(bucketName: string, objectKey: string)
+            // Method signature: statObject(bucketName: string, objectKey: string, options?)
             const methodExists = typeof ProjectResultStruct.prototype.statObject === 'function';
             expect(methodExists).toBe(true);
         });
+
+        it('should pass a per-call lane override to native', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const info = { key: 'a' };
+            const statObject = jest.fn(async () => info);
+            Object.assign(mocked, { statObject });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await expect(project.statObject('bucket', 'a', { lane: 'bulk' })).resolves.toBe(info);
+                expect(statObject).toHaveBeenCalledWith({ _handle: 1 }, 'bucket', 'a', { lane: 'bulk' });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should reject an already aborted signal before calling native', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const statObject = jest.fn(async () => ({ key: 'a' }));
+            Object.assign(mocked, { statObject });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const controller = new AbortController();
+                controller.abort();
+                await expect(project.statObject('bucket', 'a', { signal: controller.signal }))
+                    .rejects.toBeInstanceOf(CanceledError);
+                expect(statObject).not.toHaveBeenCalled();
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should cancel the native token when the signal aborts', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const token = { _token: 1 };
+            let release: (() => void) | undefined;
+            const statObject = jest.fn(() => new Promise((resolve) => { release = () => resolve({ key: 'a' }); }));
+            const createCancelToken = jest.fn(() => token);
+            const cancelToken = jest.fn(() => release?.());
+            Object.assign(mocked, { statObject, createCancelToken, cancelToken });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const controller = new AbortController();
+                const pending = project.statObject('bucket', 'a', { signal: controller.signal });
+                controller.abort();
+                await pending;
+                expect(statObject).toHaveBeenCalledWith({ _handle: 1 }, 'bucket', 'a',
+                    expect.objectContaining({ cancelToken: token }));
+                expect(cancelToken).toHaveBeenCalledWith(token);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should pass timeoutMs through to native and reject a bad one', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const statObject = jest.fn(async () => ({ key: 'a' }));
+            Object.assign(mocked, { statObject });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await project.statObject('bucket', 'a', { timeoutMs: 250 });
+                expect(statObject).toHaveBeenCalledWith({ _handle: 1 }, 'bucket', 'a', { timeoutMs: 250 });
+                await expect(project.statObject('bucket', 'a', { timeoutMs: 0 })).rejects.toThrow(TypeError);
+                expect(statObject).toHaveBeenCalledTimes(1);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
+    describe('statObjects', () => {
+        it('should pass keys and options to the native batch', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const result = { objects: [{ key: 'a', isPrefix: false }, null], errors: [] };
+            const statObjects = jest.fn(async () => result);
+            Object.assign(mocked, { statObjects });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await expect(project.statObjects('bucket', ['a', 'b'], { concurrency: 2 })).resolves.toBe(result);
+                expect(statObjects).toHaveBeenCalledWith({ _handle: 1 }, 'bucket', ['a', 'b'], { concurrency: 2 });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should reject an invalid key before calling native', async () => {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            await expect(project.statObjects('bucket', ['a', ''])).rejects.toThrow(TypeError);
+        });
     });
 
     describe('deleteObject', () => {
@@ -222,6 +535,64 @@ describe('Object Method Signatures', () => {
         });
     });
 
+    describe('deleteObjects', () => {
+        it('should settle one promise with the native summary', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const summary = { deleted: 1, missing: 1, failed: [] };
+            const deleteObjects = jest.fn(async () => summary);
+            Object.assign(mocked, { deleteObjects });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await expect(project.deleteObjects('bucket', ['a', 'b'])).resolves.toBe(summary);
+                expect(deleteObjects).toHaveBeenCalledTimes(1);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
+    describe('deletePrefix', () => {
+        it('should require a prefix ending with a slash', async () => {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            await expect(project.deletePrefix('bucket', '')).rejects.toThrow(TypeError);
+            await expect(project.deletePrefix('bucket', 'tenant')).rejects.toThrow(TypeError);
+        });
+
+        it('should pass options to native', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const totals = { listed: 3, deleted: 0, missing: 0, failed: 0, failures: [] };
+            const deletePrefix = jest.fn(async () => totals);
+            Object.assign(mocked, { deletePrefix });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await expect(project.deletePrefix('bucket', 'tenant/', { dryRun: true })).resolves.toBe(totals);
+                expect(deletePrefix).toHaveBeenCalledWith({ _handle: 1 }, 'bucket', 'tenant/', { dryRun: true });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
+    describe('exportListing', () => {
+        it('should pass the path and options to native', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const totals = { objects: 2, prefixes: 0, contentLength: 10, bytesWritten: 200 };
+            const exportListing = jest.fn(async () => totals);
+            Object.assign(mocked, { exportListing });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const options = { recursive: true, format: 'binary' as const };
+                await expect(project.exportListing('bucket', '/tmp/list.bin', options)).resolves.toBe(totals);
+                expect(exportListing).toHaveBeenCalledWith({ _handle: 1 }, 'bucket', '/tmp/list.bin', options);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
     describe('listObjects', () => {
         it('should accept bucket name and optional options', () => {
             // Method signature: listObjects(bucketName: string, options?: ListObjectsOptions)
@@ -238,6 +609,77 @@ describe('Object Method Signatures', () => {
         });
     });
 
+    describe('copyObjects / moveObjects', () => {
+        const pairs = [{ oldBucket: 'my-bucket', oldKey: 'v1/a', newBucket: 'my-bucket', newKey: 'v2/a' }];
+
+        it('should send all pairs in one native call', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const result = { succeeded: 1, status: new Int32Array([0]), errors: [] };
+            const moveObjects = jest.fn(async () => result);
+            Object.assign(mocked, { moveObjects });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await expect(project.moveObjects(pairs, { concurrency: 4 })).resolves.toBe(result);
+                expect(moveObjects).toHaveBeenCalledWith({ _handle: 1 }, pairs, { concurrency: 4 });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should reject a pair with an empty key', async () => {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            await expect(project.copyObjects([{ ...pairs[0], newKey: '' }])).rejects.toThrow(TypeError);
+        });
+    });
+
+    describe('updateObjectsMetadata', () => {
+        const keys = ['a', 'b', 'c'];
+
+        it('should encode shared metadata once for every key', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const result = { succeeded: 3, status: new Int32Array(3), errors: [] };
+            const updateObjectsMetadata = jest.fn(async () => result);
+            Object.assign(mocked, { updateObjectsMetadata });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await expect(project.updateObjectsMetadata('my-bucket', keys, { tag: 'x' }, { concurrency: 4 })).resolves.toBe(result);
+                expect(updateObjectsMetadata).toHaveBeenCalledWith(
+                    { _handle: 1 }, 'my-bucket', keys, [packMetadata({ tag: 'x' })], null, { concurrency: 4 }
+                );
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should encode each distinct per-key object once', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const updateObjectsMetadata = jest.fn(async () => ({ succeeded: 3, status: new Int32Array(3), errors: [] }));
+            Object.assign(mocked, { updateObjectsMetadata });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const even = { tag: 'even' };
+                await project.updateObjectsMetadata('my-bucket', keys, [even, { tag: 'odd' }, even]);
+                const [, , , sets, setIndex] = updateObjectsMetadata.mock.calls[0] as unknown as [
+                    unknown, string, string[], Buffer[], Uint32Array
+                ];
+                expect(sets).toEqual([packMetadata(even), packMetadata({ tag: 'odd' })]);
+                expect(Array.from(setIndex)).toEqual([0, 1, 0]);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should reject per-key metadata of the wrong length', async () => {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            await expect(project.updateObjectsMetadata('my-bucket', keys, [{}])).rejects.toThrow(TypeError);
+            await expect(project.updateObjectsMetadata('my-bucket', keys, null as unknown as Record<string, string>))
+                .rejects.toThrow(TypeError);
+        });
+    });
+
     describe('moveObject', () => {
         it('should accept source and destination parameters', () => {
             // Method signature: moveObject(oldBucket, oldKey, newBucket, newKey, options?)
@@ -246,3 +688,28 @@ describe('Object Method Signatures', () => {
         });
     });
 });
+
+describe('Columnar listing accessors', () => {
+    const keys = Buffer.from('photos/a.jpgдок.txt', 'utf8');
+    const page = {
+        count: 3,
+        keyBytes: new Uint8Array(keys),
+        keyOffsets: new Uint32Array([0, 7, 12, keys.length]),
+        contentLength: new BigInt64Array([0n, 10n, 20n]),
+        created: new Float64Array(3),
+        expires: new Float64Array(3),
+        isPrefix: new Uint8Array([0b001]),
+    };
+
+    it('should decode UTF-8 keys by offset', () => {
+        expect(columnKey(page, 0)).toBe('photos/');
+        expect(columnKey(page, 1)).toBe('a.jpg');
+        expect(columnKey(page, 2)).toBe('док.txt');
+    });
+
+    it('should read the isPrefix bitmap', () => {
+        expect(columnIsPrefix(page, 0)).toBe(true);
+        expect(columnIsPrefix(page, 1)).toBe(false);
+        expect(columnIsPrefix(page, 2)).toBe(false);
+    });
+});
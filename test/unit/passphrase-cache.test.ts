@@ -0,0 +1,95 @@
+/**
+ * @file passphrase-cache.test.ts
+ * @brief Unit tests for the passphrase grant cache and its encrypted file
+ */
+
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { Uplink } from '../../src';
+import { PassphraseAccessCache } from '../../src/access/passphrase-cache';
+import { native } from '../../src/native';
+
+describe('PassphraseAccessCache', () => {
+    it('should serve repeated requests without dialing the satellite', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const requestAccessWithPassphrase = jest.fn(async () => ({ access: 'handle', serialized: 'serialized-grant' }));
+        const parseAccess = jest.fn(async () => 'parsed');
+        const accessSerialize = jest.fn(async () => 'unused');
+        Object.assign(mocked, { requestAccessWithPassphrase, parseAccess, accessSerialize });
+        try {
+            const uplink = new Uplink();
+            uplink.enablePassphraseAccessCache({ maxEntries: 4 });
+            await uplink.requestAccessWithPassphrase('sat:7777', 'key', 'secret');
+            await uplink.requestAccessWithPassphrase('sat:7777', 'key', 'secret');
+            await uplink.requestAccessWithPassphrase('sat:7777', 'key', 'other');
+
+            expect(requestAccessWithPassphrase).toHaveBeenCalledTimes(2);
+            expect(requestAccessWithPassphrase).toHaveBeenCalledWith('sat:7777', 'key', 'secret', { serialize: true });
+            expect(accessSerialize).not.toHaveBeenCalled();
+            expect(parseAccess).toHaveBeenCalledWith('serialized-grant');
+            expect(uplink.passphraseAccessCacheStats()).toMatchObject({ hits: 1, misses: 2, entries: 2 });
+            uplink.disablePassphraseAccessCache();
+            expect(uplink.passphraseAccessCacheStats()).toBeNull();
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should return cached grants for serialize only without parsing', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const requestAccessWithPassphrase = jest.fn(async () => 'serialized-grant');
+        const parseAccess = jest.fn(async () => 'parsed');
+        Object.assign(mocked, { requestAccessWithPassphrase, parseAccess });
+        try {
+            const uplink = new Uplink();
+            uplink.enablePassphraseAccessCache();
+            const options = { serialize: 'only' } as const;
+            await expect(uplink.requestAccessWithPassphrase('sat:7777', 'key', 'secret', options))
+                .resolves.toBe('serialized-grant');
+            await expect(uplink.requestAccessWithPassphrase('sat:7777', 'key', 'secret', options))
+                .resolves.toBe('serialized-grant');
+
+            expect(requestAccessWithPassphrase).toHaveBeenCalledTimes(1);
+            expect(parseAccess).not.toHaveBeenCalled();
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should expire entries after ttlMs', async () => {
+        const cache = new PassphraseAccessCache({ ttlMs: 1 });
+        const tag = cache.tag(['sat', 'key', 'secret', '']);
+        await cache.set(tag, 'grant');
+        await new Promise((resolve) => setTimeout(resolve, 5));
+        await expect(cache.get(tag)).resolves.toBeUndefined();
+        expect(cache.stats().expirations).toBe(1);
+    });
+
+    it('should persist grants encrypted and reload them with the same key', async () => {
+        const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'uplink-cache-'));
+        const file = path.join(dir, 'access.bin');
+        const fileKey = Buffer.alloc(32, 7);
+        try {
+            const first = new PassphraseAccessCache({ file, fileKey });
+            const tag = first.tag(['sat', 'key', 'secret', '']);
+            await first.set(tag, 'grant-1');
+            expect(fs.readFileSync(file).includes('grant-1')).toBe(false);
+
+            const second = new PassphraseAccessCache({ file, fileKey });
+            await expect(second.get(second.tag(['sat', 'key', 'secret', '']))).resolves.toBe('grant-1');
+
+            const wrongKey = new PassphraseAccessCache({ file, fileKey: Buffer.alloc(32, 8) });
+            await expect(wrongKey.get(tag)).resolves.toBeUndefined();
+            expect(wrongKey.stats().fileErrors).toBe(1);
+        } finally {
+            fs.rmSync(dir, { recursive: true, force: true });
+        }
+    });
+
+    it('should require a 32-byte fileKey with file', () => {
+        expect(() => new PassphraseAccessCache({ file: '/tmp/x' })).toThrow(TypeError);
+    });
+});
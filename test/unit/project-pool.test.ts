@@ -0,0 +1,147 @@
+/**
+ * @file project-pool.test.ts
+ * @brief Unit tests for ProjectPool leasing, bounds and eviction
+ */
+
+import { ProjectPool, AccessResultStruct, ProjectResultStruct } from '../../src';
+
+interface FakeProject {
+  isOpen: boolean;
+  close: jest.Mock;
+}
+
+function fakeProject(): FakeProject {
+  const project: FakeProject = {
+    isOpen: true,
+    close: jest.fn(async () => {
+      project.isOpen = false;
+    }),
+  };
+  return project;
+}
+
+function fakeAccess(grant: string): { access: AccessResultStruct; opened: FakeProject[] } {
+  const opened: FakeProject[] = [];
+  const open = jest.fn(async () => {
+    const project = fakeProject();
+    opened.push(project);
+    return project;
+  });
+  const access = {
+    serialize: jest.fn(async () => grant),
+    openProject: open,
+    configOpenProject: open,
+  } as unknown as AccessResultStruct;
+  return { access, opened };
+}
+
+describe('ProjectPool', () => {
+  it('should reuse a released project for the same access and config', async () => {
+    const pool = new ProjectPool();
+    const { access, opened } = fakeAccess('grant-a');
+
+    const first = await pool.acquire(access);
+    const project = first.project;
+    await first.release();
+    const second = await pool.acquire(access);
+
+    expect(second.project).toBe(project);
+    expect(opened).toHaveLength(1);
+    expect(pool.stats()).toMatchObject({ open: 1, leased: 1, hits: 1, misses: 1 });
+    await second.release();
+    await pool.close();
+    expect(opened[0].close).toHaveBeenCalled();
+  });
+
+  it('should key projects by config', async () => {
+    const pool = new ProjectPool();
+    const { access, opened } = fakeAccess('grant-a');
+
+    await (await pool.acquire(access, { maxConcurrentTransfers: 4 })).release();
+    await (await pool.acquire(access, { maxConcurrentTransfers: 8 })).release();
+    await (await pool.acquire(access, { maxConcurrentTransfers: 4 })).release();
+
+    expect(opened).toHaveLength(2);
+    await pool.close();
+  });
+
+  it('should evict the oldest idle project when full', async () => {
+    const pool = new ProjectPool({ maxProjects: 1 });
+    const a = fakeAccess('grant-a');
+    const b = fakeAccess('grant-b');
+
+    await (await pool.acquire(a.access)).release();
+    const lease = await pool.acquire(b.access);
+
+    expect(a.opened[0].close).toHaveBeenCalled();
+    expect(pool.stats()).toMatchObject({ open: 1, evictions: 1 });
+    await lease.release();
+    await pool.close();
+  });
+
+  it('should wait for a release when every project is leased', async () => {
+    const pool = new ProjectPool({ maxProjects: 1 });
+    const { access, opened } = fakeAccess('grant-a');
+
+    const first = await pool.acquire(access);
+    const pending = pool.acquire(access);
+    await new Promise((resolve) => setImmediate(resolve));
+    expect(pool.stats().waiting).toBe(1);
+
+    await first.release();
+    const second = await pending;
+    expect(second.project).toBe(first.project);
+    expect(opened).toHaveLength(1);
+    await second.release();
+    await pool.close();
+  });
+
+  it('should replace a project that fails its health check', async () => {
+    const healthCheck = jest.fn(async (_project: ProjectResultStruct) => false);
+    const pool = new ProjectPool({ healthCheck, healthCheckIdleMs: 0 });
+    const { access, opened } = fakeAccess('grant-a');
+
+    await (await pool.acquire(access)).release();
+    const lease = await pool.acquire(access);
+
+    expect(healthCheck).toHaveBeenCalledTimes(1);
+    expect(opened).toHaveLength(2);
+    expect(lease.project).toBe(opened[1]);
+    await lease.release();
+    await pool.close();
+  });
+
+  it('should close projects after idleTimeoutMs', async () => {
+    jest.useFakeTimers();
+    try {
+      const pool = new ProjectPool({ idleTimeoutMs: 2000 });
+      const { access, opened } = fakeAccess('grant-a');
+
+      await (await pool.acquire(access)).release();
+      jest.advanceTimersByTime(3000);
+
+      expect(opened[0].close).toHaveBeenCalled();
+      expect(pool.stats()).toMatchObject({ open: 0, evictions: 1 });
+      await pool.close();
+    } finally {
+      jest.useRealTimers();
+    }
+  });
+
+  it('should close a discarded project and refuse leases once closed', async () => {
+    const pool = new ProjectPool();
+    const { access, opened } = fakeAccess('grant-a');
+
+    await (await pool.acquire(access)).release({ discard: true });
+    expect(opened[0].close).toHaveBeenCalled();
+    expect(pool.stats().open).toBe(0);
+
+    await pool.close();
+    await expect(pool.acquire(access)).rejects.toThrow('Project pool is closed');
+  });
+
+  it('should reject invalid options', () => {
+    expect(() => new ProjectPool({ maxProjects: 0 })).toThrow(TypeError);
+    expect(() => new ProjectPool({ idleTimeoutMs: -1 })).toThrow(TypeError);
+  });
+});
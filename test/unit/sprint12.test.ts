@@ -7,7 +7,12 @@
  * - internalUniverseIsEmpty() / uplinkInternalUniverseIsEmpty()
  */
 
-import { Uplink, ProjectResultStruct, internalUniverseIsEmpty, uplinkInternalUniverseIsEmpty } from '../../src';
+import {
+  Uplink,
+  ProjectResultStruct,
+  internalUniverseIsEmpty,
+  uplinkInternalUniverseIsEmpty,
+} from '../../src';
 
 describe('Sprint 12: API Completeness', () => {
   describe('ProjectResultStruct.revokeAccess', () => {
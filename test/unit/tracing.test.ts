@@ -0,0 +1,95 @@
+/**
+ * @file tracing.test.ts
+ * @brief Unit tests for diagnostics_channel spans around native calls
+ */
+
+import * as diagnosticsChannel from 'diagnostics_channel';
+import { AsyncLocalStorage } from 'async_hooks';
+import { NATIVE_TRACING_CHANNEL, NativeCallContext, traceNativeModule } from '../../src/native/tracing';
+
+describe('traceNativeModule', () => {
+    const channel = diagnosticsChannel.tracingChannel(NATIVE_TRACING_CHANNEL);
+
+    it('should call through untouched without subscribers', async () => {
+        const module = { statObject: jest.fn(async () => 'info') };
+        const traced = traceNativeModule(module);
+        await expect(traced.statObject('project', 'bucket', 'key')).resolves.toBe('info');
+        expect(module.statObject).toHaveBeenCalledWith('project', 'bucket', 'key');
+    });
+
+    it('should publish op, bucket, bytes and outcome code', async () => {
+        const events: Array<[string, NativeCallContext]> = [];
+        const handlers = {
+            start: (ctx: unknown) => events.push(['start', { ...(ctx as NativeCallContext) }]),
+            end: () => undefined,
+            asyncStart: () => undefined,
+            asyncEnd: (ctx: unknown) => events.push(['asyncEnd', { ...(ctx as NativeCallContext) }]),
+            error: (ctx: unknown) => events.push(['error', { ...(ctx as NativeCallContext) }]),
+        };
+        const failure = Object.assign(new Error('not found'), { code: 0x21 });
+        const traced = traceNativeModule({
+            downloadRead: async () => ({ bytesRead: 42, eof: false }),
+            statObject: async () => {
+                throw failure;
+            },
+        });
+        channel.subscribe(handlers);
+        try {
+            await traced.downloadRead({ _handle: 1 }, Buffer.alloc(64), 64);
+            await expect(traced.statObject({ _handle: 2 }, 'photos', 'a.jpg')).rejects.toBe(failure);
+        } finally {
+            channel.unsubscribe(handlers);
+        }
+
+        expect(events.map(([name, ctx]) => [name, ctx.op])).toEqual([
+            ['start', 'downloadRead'],
+            ['asyncEnd', 'downloadRead'],
+            ['start', 'statObject'],
+            ['error', 'statObject'],
+            ['asyncEnd', 'statObject'],
+        ]);
+        expect(events[1]![1]).toMatchObject({ bytes: 42, code: 0 });
+        expect(events[2]![1].bucket).toBe('photos');
+        expect(events[4]![1]).toMatchObject({ bucket: 'photos', code: 0x21 });
+    });
+
+    it('should settle the span of a callback-style call when its callback runs', async () => {
+        const events: Array<[string, NativeCallContext]> = [];
+        const handlers = {
+            start: () => undefined,
+            end: (ctx: unknown) => events.push(['end', { ...(ctx as NativeCallContext) }]),
+            asyncStart: () => undefined,
+            asyncEnd: (ctx: unknown) => events.push(['asyncEnd', { ...(ctx as NativeCallContext) }]),
+            error: () => undefined,
+        };
+        type ReadCallback = (error: Error | null, bytesRead: number, eof: boolean) => void;
+        const traced = traceNativeModule({
+            downloadReadCb: (_h: unknown, _b: Buffer, _n: number, cb: ReadCallback) => {
+                setImmediate(() => cb(null, 16, true));
+            },
+        });
+        channel.subscribe(handlers);
+        try {
+            const result = await new Promise((resolve) =>
+                traced.downloadReadCb({ _handle: 1 }, Buffer.alloc(16), 16, (_err, bytesRead, eof) =>
+                    resolve([bytesRead, eof])));
+            expect(result).toEqual([16, true]);
+        } finally {
+            channel.unsubscribe(handlers);
+        }
+
+        expect(events.map(([name]) => name)).toEqual(['end', 'asyncEnd']);
+        expect(events[1]![1]).toMatchObject({ op: 'downloadReadCb', bytes: 16, code: 0 });
+    });
+
+    it('should carry a store bound to the start channel through the call', async () => {
+        const store = new AsyncLocalStorage<string>();
+        channel.start.bindStore(store, (ctx) => `span:${(ctx as NativeCallContext).op}`);
+        const traced = traceNativeModule({ listBucketsCreate: async () => store.getStore() });
+        try {
+            await expect(traced.listBucketsCreate({ _handle: 1 })).resolves.toBe('span:listBucketsCreate');
+        } finally {
+            channel.start.unbindStore(store);
+        }
+    });
+});
@@ -4,6 +4,7 @@
  */
 
 import { Uplink, AccessResultStruct } from '../../src';
+import { native } from '../../src/native';
 
 describe('Uplink Class', () => {
     describe('constructor', () => {
@@ -11,6 +12,65 @@ describe('Uplink Class', () => {
             const uplink = new Uplink();
             expect(uplink).toBeInstanceOf(Uplink);
         });
+
+        it('should configure the native thread pool from options', () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const configureThreadPool = jest.fn();
+            Object.assign(mocked, { configureThreadPool });
+            try {
+                new Uplink();
+                expect(configureThreadPool).not.toHaveBeenCalled();
+                new Uplink({ threadPoolSize: 32 });
+                expect(configureThreadPool).toHaveBeenCalledWith({
+                    size: 32,
+                    metadataSize: undefined,
+                    idleTimeoutMs: undefined,
+                });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should pass completion batching options to the native thread pool', () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const configureThreadPool = jest.fn();
+            Object.assign(mocked, { configureThreadPool });
+            try {
+                new Uplink({ completionDelayUs: 200, completionBatch: 64 });
+                expect(configureThreadPool).toHaveBeenCalledWith(
+                    expect.objectContaining({ completionDelayUs: 200, completionBatch: 64 })
+                );
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should configure process-wide bandwidth limits from options', () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const configureThreadPool = jest.fn();
+            const configureBandwidth = jest.fn();
+            Object.assign(mocked, { configureThreadPool, configureBandwidth });
+            try {
+                new Uplink({ threadPoolSize: 8 });
+                expect(configureBandwidth).not.toHaveBeenCalled();
+                new Uplink({ maxDownloadBytesPerSecond: 50_000_000 });
+                expect(configureBandwidth).toHaveBeenCalledWith({
+                    maxUploadBytesPerSecond: undefined,
+                    maxDownloadBytesPerSecond: 50_000_000,
+                });
+                expect(configureThreadPool).toHaveBeenCalledTimes(1);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should throw TypeError for non-object options', () => {
+            // @ts-expect-error - Testing runtime type checking
+            expect(() => new Uplink(8)).toThrow(TypeError);
+        });
     });
 
     describe('parseAccess input validation', () => {
@@ -26,6 +86,85 @@ describe('Uplink Class', () => {
         });
     });
 
+    describe('access cache', () => {
+        it('should require a directory', () => {
+            const uplink = new Uplink();
+            expect(() => uplink.enableChunkCache({ directory: '' })).toThrow(TypeError);
+            expect(() => uplink.enableChunkCache(undefined as never)).toThrow(TypeError);
+        });
+    });
+
+    describe('deriveEncryptionKeys', () => {
+        it('should reject an item without a Buffer salt', async () => {
+            const uplink = new Uplink();
+            await expect(
+                // @ts-expect-error - Testing runtime type checking
+                uplink.deriveEncryptionKeys([{ passphrase: 'p', salt: 'not-a-buffer' }])
+            ).rejects.toThrow(TypeError);
+        });
+
+        it('should map native handles to keys in item order', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const deriveEncryptionKeys = jest.fn(async () => [11, 12]);
+            Object.assign(mocked, { deriveEncryptionKeys });
+            try {
+                const uplink = new Uplink();
+                const items = [
+                    { passphrase: 'a', salt: Buffer.from('s1') },
+                    { passphrase: 'b', salt: Buffer.from('s2') },
+                ];
+                const keys = await uplink.deriveEncryptionKeys(items, { concurrency: 2 });
+                expect(deriveEncryptionKeys).toHaveBeenCalledWith(items, { concurrency: 2 });
+                expect(keys).toEqual([{ _handle: 11 }, { _handle: 12 }]);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
+    describe('getMetrics', () => {
+        it('should forward options to the native snapshot', () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const snapshot = { operations: {} };
+            const getMetrics = jest.fn(() => snapshot);
+            Object.assign(mocked, { getMetrics });
+            try {
+                const uplink = new Uplink();
+                expect(uplink.getMetrics({ buckets: true })).toBe(snapshot);
+                expect(getMetrics).toHaveBeenCalledWith({ buckets: true });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should push snapshots until stopped', () => {
+            jest.useFakeTimers();
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const getMetrics = jest.fn(() => ({ operations: {} }));
+            Object.assign(mocked, { getMetrics });
+            try {
+                const uplink = new Uplink();
+                const callback = jest.fn(() => {
+                    throw new Error('reporter failed');
+                });
+                const stop = uplink.startMetricsReporting(callback, { intervalMs: 1000, reset: true });
+                jest.advanceTimersByTime(2500);
+                expect(callback).toHaveBeenCalledTimes(2);
+                expect(getMetrics).toHaveBeenCalledWith({ reset: true });
+                stop();
+                jest.advanceTimersByTime(5000);
+                expect(callback).toHaveBeenCalledTimes(2);
+                expect(() => uplink.startMetricsReporting(callback, { intervalMs: 0 })).toThrow(TypeError);
+            } finally {
+                Object.assign(mocked, saved);
+                jest.useRealTimers();
+            }
+        });
+    });
+
     describe('requestAccessWithPassphrase input validation', () => {
         it('should throw TypeError for empty satellite address', async () => {
             const uplink = new Uplink();
@@ -62,8 +201,71 @@ describe('AccessResultStruct Class', () => {
             expect(typeof AccessResultStruct.prototype.configOpenProject).toBe('function');
             expect(typeof AccessResultStruct.prototype.serialize).toBe('function');
             expect(typeof AccessResultStruct.prototype.satelliteAddress).toBe('function');
+            expect(typeof AccessResultStruct.prototype.serializeSync).toBe('function');
+            expect(typeof AccessResultStruct.prototype.satelliteAddressSync).toBe('function');
             expect(typeof AccessResultStruct.prototype.share).toBe('function');
+            expect(typeof AccessResultStruct.prototype.shareMany).toBe('function');
             expect(typeof AccessResultStruct.prototype.overrideEncryptionKey).toBe('function');
         });
     });
+
+    describe('configOpenProject concurrency limits', () => {
+        it('should pass limits to the native layer and expose the admission gauges', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const stats = {
+                transfersActive: 2,
+                transfersQueued: 5,
+                maxConcurrentTransfers: 2,
+                metadataActive: 0,
+                metadataQueued: 0,
+                maxConcurrentMetadataOps: 16,
+            };
+            const configOpenProject = jest.fn().mockResolvedValue({ _handle: 7 });
+            const projectAdmissionStats = jest.fn().mockReturnValue(stats);
+            Object.assign(mocked, { configOpenProject, projectAdmissionStats });
+            try {
+                const access = new AccessResultStruct({ _handle: 1 });
+                const config = { maxConcurrentTransfers: 2, maxConcurrentMetadataOps: 16 };
+                const project = await access.configOpenProject(config);
+                expect(configOpenProject).toHaveBeenCalledWith(config, { _handle: 1 });
+                expect(project.admissionStats()).toEqual(stats);
+                expect(projectAdmissionStats).toHaveBeenCalledWith({ _handle: 7 });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
+    describe('shareMany', () => {
+        it('should send every spec in one native call and return the grants', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const accessShareMany = jest.fn().mockResolvedValue(['grant-a', 'grant-b']);
+            Object.assign(mocked, { accessShareMany });
+            try {
+                const access = new AccessResultStruct({ _handle: 1 });
+                const grants = await access.shareMany(
+                    [
+                        { permission: { allowDownload: true }, prefixes: [{ bucket: 'tenants', prefix: 'a/' }] },
+                        { permission: { allowList: true, notAfter: new Date(2000) }, prefixes: [] },
+                    ],
+                    { concurrency: 8 }
+                );
+                expect(grants).toEqual(['grant-a', 'grant-b']);
+                expect(accessShareMany).toHaveBeenCalledTimes(1);
+                const [, specs, options] = accessShareMany.mock.calls[0];
+                expect(specs[0].prefixes).toEqual([{ bucket: 'tenants', prefix: 'a/' }]);
+                expect(specs[1].permission).toMatchObject({ allowList: true, allowDownload: false, notAfter: 2 });
+                expect(options).toEqual({ concurrency: 8 });
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should reject specs without prefixes', async () => {
+            const access = new AccessResultStruct({ _handle: 1 });
+            await expect(access.shareMany([{ permission: {} } as never])).rejects.toThrow(TypeError);
+        });
+    });
 });
@@ -6,9 +6,13 @@
  * Tests upload class structure, method signatures, and input validation
  */
 
+import { Writable } from 'stream';
 import { UploadResultStruct } from '../../src/upload';
+import { UploadWriteStream } from '../../src/upload/stream';
 import { UploadOptions, ObjectInfo, CustomMetadata } from '../../src/types';
 import { ProjectResultStruct } from '../../src/project';
+import { native } from '../../src/native';
+import { packMetadata } from '../../src/native/metadata';
 
 // We can't fully test uploads without a real Storj connection,
 // but we can test the class structure and input validation
@@ -22,12 +26,37 @@ describe('UploadResultStruct', () => {
         it('should have expected methods', () => {
             // Check prototype methods exist
             expect(typeof UploadResultStruct.prototype.write).toBe('function');
+            expect(typeof UploadResultStruct.prototype.writev).toBe('function');
             expect(typeof UploadResultStruct.prototype.commit).toBe('function');
             expect(typeof UploadResultStruct.prototype.abort).toBe('function');
             expect(typeof UploadResultStruct.prototype.setCustomMetadata).toBe('function');
             expect(typeof UploadResultStruct.prototype.info).toBe('function');
         });
     });
+
+    describe('queued writes', () => {
+        it('should hand un-awaited writes and the commit to native in call order', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const calls: string[] = [];
+            Object.assign(mocked, {
+                uploadWrite: jest.fn(async (_h: unknown, data: Buffer) => { calls.push(data.toString()); return data.length; }),
+                uploadWritev: jest.fn(async (_h: unknown, buffers: Buffer[]) => { calls.push(buffers.join('')); return 2; }),
+                uploadCommit: jest.fn(async () => { calls.push('commit'); }),
+            });
+            try {
+                const upload = new UploadResultStruct({ _handle: 1 });
+                const writes = [upload.write(Buffer.from('a')), upload.writev([Buffer.from('b'), Buffer.from('c')]), upload.write(Buffer.from('d'))];
+                const commit = upload.commit();
+                expect(calls).toEqual(['a', 'bc', 'd', 'commit']);
+                await expect(Promise.all(writes)).resolves.toEqual([1, 2, 1]);
+                await commit;
+                expect(upload.isActive).toBe(false);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
 });
 
 describe('ProjectResultStruct Upload Method', () => {
@@ -35,6 +64,175 @@ describe('ProjectResultStruct Upload Method', () => {
         it('should have uploadObject method', () => {
             expect(typeof ProjectResultStruct.prototype.uploadObject).toBe('function');
         });
+
+        it('should have uploadFile method', () => {
+            expect(typeof ProjectResultStruct.prototype.uploadFile).toBe('function');
+        });
+
+        it('should have putObject method', () => {
+            expect(typeof ProjectResultStruct.prototype.putObject).toBe('function');
+        });
+
+        it('should have putObjectDedup method', () => {
+            expect(typeof ProjectResultStruct.prototype.putObjectDedup).toBe('function');
+        });
+
+        it('should have createWriteStream method', () => {
+            expect(typeof ProjectResultStruct.prototype.createWriteStream).toBe('function');
+        });
+
+        it('should have uploadDirectory method', () => {
+            expect(typeof ProjectResultStruct.prototype.uploadDirectory).toBe('function');
+        });
+    });
+
+    describe('uploadDirectory', () => {
+        it('should pass the directory, prefix, and options to one native call', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const result = { files: 2, bytes: 10, uploaded: 2, failed: 0, failures: [] };
+            const uploadDirectory = jest.fn(async () => result);
+            Object.assign(mocked, { uploadDirectory });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const options = { concurrency: 4, include: ['*.txt'] };
+                await expect(project.uploadDirectory('./site', 'my-bucket', 'v2/', options)).resolves.toBe(result);
+                expect(uploadDirectory).toHaveBeenCalledWith({ _handle: 1 }, './site', 'my-bucket', 'v2/', options);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it("should reject a prefix that does not end with '/'", async () => {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            await expect(project.uploadDirectory('./site', 'my-bucket', 'v2')).rejects.toThrow(TypeError);
+        });
+    });
+
+    describe('diff and sync', () => {
+        const plan = {
+            upload: [{ key: 'v2/a.txt', path: 'a.txt', size: 3, reason: 'new' }],
+            delete: [{ key: 'v2/old.txt', size: 5 }],
+            unchanged: 4,
+            uploadBytes: 3,
+            deleteBytes: 5,
+            localFiles: 5,
+            remoteObjects: 5,
+        };
+
+        it('should pass the comparison options to one native diff', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const diffDirectory = jest.fn(async () => plan);
+            Object.assign(mocked, { diffDirectory });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                const options = { compare: 'checksum' as const, include: ['*.txt'] };
+                await expect(project.diff('./site', 'my-bucket', 'v2/', options)).resolves.toBe(plan);
+                expect(diffDirectory).toHaveBeenCalledWith({ _handle: 1 }, './site', 'my-bucket', 'v2/', options);
+                await expect(project.diff('./site', 'my-bucket', 'v2')).rejects.toThrow(TypeError);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+
+        it('should upload the planned files and delete only when asked', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const uploaded = { files: 1, bytes: 3, uploaded: 1, failed: 0, failures: [] };
+            const deleted = { deleted: 1, missing: 0, failed: [] };
+            const uploadDirectory = jest.fn(async () => uploaded);
+            const deleteObjects = jest.fn(async () => deleted);
+            Object.assign(mocked, { diffDirectory: jest.fn(async () => plan), uploadDirectory, deleteObjects });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await expect(project.sync('./site', 'my-bucket', 'v2/', { concurrency: 2 })).resolves.toEqual({
+                    plan,
+                    upload: uploaded,
+                    delete: null,
+                });
+                expect(uploadDirectory).toHaveBeenCalledWith(
+                    { _handle: 1 }, './site', 'my-bucket', 'v2/', expect.objectContaining({ files: ['a.txt'], concurrency: 2 })
+                );
+                expect(deleteObjects).not.toHaveBeenCalled();
+
+                const result = await project.sync('./site', 'my-bucket', 'v2/', { delete: true });
+                expect(result.delete).toBe(deleted);
+                expect(deleteObjects).toHaveBeenCalledWith({ _handle: 1 }, 'my-bucket', ['v2/old.txt'], expect.anything());
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+
+    describe('compress', () => {
+        it('should open compressed uploads but refuse compressed packs before opening one', async () => {
+            const mocked = native as unknown as Record<string, unknown>;
+            const saved = { ...mocked };
+            const uploadObject = jest.fn(async () => ({ _handle: 2 }));
+            Object.assign(mocked, { uploadObject });
+            try {
+                const project = new ProjectResultStruct({ _handle: 1 });
+                await project.uploadObject('my-bucket', 'notes.txt', { compress: 'lz4' });
+                expect(uploadObject).toHaveBeenCalledWith(
+                    { _handle: 1 }, 'my-bucket', 'notes.txt', expect.objectContaining({ compress: 'lz4' })
+                );
+
+                // Pack members are read by stored offset, which frames would break
+                await expect(project.createPackUpload('my-bucket', 'batch.pack', { compress: 'lz4' }))
+                    .rejects.toThrow('compress is not supported for pack uploads');
+                expect(uploadObject).toHaveBeenCalledTimes(1);
+            } finally {
+                Object.assign(mocked, saved);
+            }
+        });
+    });
+});
+
+describe('UploadWriteStream', () => {
+    it('should be a Writable', () => {
+        expect(UploadWriteStream.prototype).toBeInstanceOf(Writable);
+    });
+
+    it('should reject an invalid maxInFlight', () => {
+        expect(() => new UploadWriteStream({ _handle: 1 }, 'bucket', 'key', { maxInFlight: 0 }))
+            .toThrow(TypeError);
+    });
+
+    it('should surface a failed start as a stream error', async () => {
+        const stream = new UploadWriteStream({ _handle: 1 }, 'bucket', 'key');
+        await expect(new Promise((_, reject) => stream.on('error', reject))).rejects.toThrow();
+    });
+
+    it('should write in order through the callback-style native writev and commit', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const written: string[] = [];
+        const uploadCommit = jest.fn(async () => undefined);
+        type WriteCallback = (error: Error | null, bytesWritten: number) => void;
+        Object.assign(mocked, {
+            uploadObject: jest.fn(async () => ({ _handle: 2 })),
+            uploadWritevCb: jest.fn((_h: unknown, buffers: Buffer[], cb: WriteCallback) => {
+                const data = Buffer.concat(buffers);
+                setImmediate(() => {
+                    written.push(data.toString());
+                    cb(null, data.length);
+                });
+            }),
+            uploadCommit,
+        });
+        try {
+            const stream = new UploadWriteStream({ _handle: 1 }, 'bucket', 'key', { maxInFlight: 1 });
+            await new Promise((resolve, reject) => {
+                stream.on('finish', resolve).on('error', reject);
+                ['a', 'b', 'c'].forEach((part) => stream.write(Buffer.from(part)));
+                stream.end();
+            });
+            expect(written.join('')).toBe('abc');
+            expect(uploadCommit).toHaveBeenCalledTimes(1);
+        } finally {
+            Object.assign(mocked, saved);
+        }
     });
 });
 
@@ -52,6 +250,27 @@ describe('UploadOptions Interface', () => {
             expect(options.expires).toBeInstanceOf(Date);
         });
 
+        it('should accept writeBufferSize option', () => {
+            const options: UploadOptions = {
+                writeBufferSize: 4 << 20
+            };
+            expect(options.writeBufferSize).toBe(4 * 1024 * 1024);
+        });
+
+        it('should accept maxQueuedBytes option', () => {
+            const options: UploadOptions = {
+                maxQueuedBytes: 8 << 20
+            };
+            expect(options.maxQueuedBytes).toBe(8 * 1024 * 1024);
+        });
+
+        it('should accept checksum option', () => {
+            const options: UploadOptions = {
+                checksum: 'crc32c'
+            };
+            expect(options.checksum).toBe('crc32c');
+        });
+
         it('should accept undefined expires', () => {
             const options: UploadOptions = {
                 expires: undefined
@@ -126,6 +345,26 @@ describe('CustomMetadata Interface', () => {
             expect(typeof metadata['key']).toBe('string');
         });
     });
+
+    describe('packMetadata', () => {
+        it('should pack length-prefixed UTF-8 pairs after the length table', () => {
+            const packed = packMetadata({ 'content-type': 'text/plain', 'x-名前': 'é' });
+            expect(packed.readUInt32LE(0)).toBe(2);
+            expect(packed.readUInt32LE(4)).toBe(12);
+            expect(packed.readUInt32LE(8)).toBe(10);
+            expect(packed.readUInt32LE(12)).toBe(8);
+            expect(packed.readUInt32LE(16)).toBe(2);
+            expect(packed.subarray(20).toString('utf8')).toBe('content-typetext/plainx-名前é');
+        });
+
+        it('should pack empty metadata as a zero count', () => {
+            expect(packMetadata({})).toEqual(Buffer.from([0, 0, 0, 0]));
+        });
+
+        it('should reject non-string values', () => {
+            expect(() => packMetadata({ size: 1 as unknown as string })).toThrow(TypeError);
+        });
+    });
 });
 
 describe('Upload Write Buffer', () => {
@@ -253,3 +492,63 @@ describe('Upload Method Return Types', () => {
         });
     });
 });
+
+describe('putObjectDedup', () => {
+    it('should require {hash} in the key template', async () => {
+        const project = new ProjectResultStruct({ _handle: 1 });
+        await expect(project.putObjectDedup('bucket', 'cas/fixed', Buffer.from('x')))
+            .rejects.toThrow(TypeError);
+    });
+
+    it('should pass the source and options through to the native call', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const result = { key: 'cas/abc', uploaded: false, object: { key: 'cas/abc' } };
+        const putObjectDedup = jest.fn(async () => result);
+        Object.assign(mocked, { putObjectDedup });
+        try {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            await expect(project.putObjectDedup('bucket', 'cas/{hash}', 'dist/app.tar', { algorithm: 'crc32c' }))
+                .resolves.toBe(result);
+            expect(putObjectDedup).toHaveBeenCalledWith(
+                { _handle: 1 }, 'bucket', 'cas/{hash}', 'dist/app.tar', expect.objectContaining({ algorithm: 'crc32c' })
+            );
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+});
+
+describe('uploadReplicated', () => {
+    it('should default each target project to the calling project', async () => {
+        const mocked = native as unknown as Record<string, unknown>;
+        const saved = { ...mocked };
+        const result = { bytesRead: 1, committed: 2, targets: [] };
+        const uploadReplicated = jest.fn(async () => result);
+        Object.assign(mocked, { uploadReplicated });
+        try {
+            const project = new ProjectResultStruct({ _handle: 1 });
+            const mirror = new ProjectResultStruct({ _handle: 2 });
+            const source = Buffer.from('x');
+            await expect(project.uploadReplicated(source, [
+                { bucket: 'primary', key: 'a' },
+                { project: mirror, bucket: 'mirror', key: 'a' },
+            ], { quorum: 1 })).resolves.toBe(result);
+            expect(uploadReplicated).toHaveBeenCalledWith(
+                source,
+                [
+                    { project: { _handle: 1 }, bucket: 'primary', key: 'a' },
+                    { project: { _handle: 2 }, bucket: 'mirror', key: 'a' },
+                ],
+                expect.objectContaining({ quorum: 1 })
+            );
+        } finally {
+            Object.assign(mocked, saved);
+        }
+    });
+
+    it('should reject an empty target list', async () => {
+        const project = new ProjectResultStruct({ _handle: 1 });
+        await expect(project.uploadReplicated(Buffer.from('x'), [])).rejects.toThrow(TypeError);
+    });
+});